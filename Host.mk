@@ -0,0 +1,89 @@
+include config.mk
+
+CC				:= gcc
+
+#---------------------------------------------------------------------------------------------
+# Headless native build of the client core for profiling (perf, valgrind).
+# Everything under src/ except the platform edge — main.c, the browser
+# WebSocket and emscripten_fetch — which host/platform_null.c replaces;
+# host/include shims the emscripten headers. raylib is built for
+# PLATFORM_MEMORY: software renderer, no window, no input.
+#
+#   make -f Host.mk BUILD_MODE=RELEASE && bin/host/aoi_bench --help
+#   bin/host/micro_bench --json        # per-primitive ns/op, one JSON line each
+target_build_dir	:= $(BUILD_DIR)/host/$(BUILD_MODE)
+HOST_DIR			?= host
+
+CFLAGS += -I$(HOST_DIR)/include
+CFLAGS += -fno-omit-frame-pointer
+# Per-entity INFO lines would land on stdout inside the timed stages.
+CFLAGS += -UCYBERIA_LOG_LEVEL -DCYBERIA_LOG_LEVEL=2
+
+ifeq ($(BUILD_MODE),RELEASE)
+CFLAGS += -g
+else
+CFLAGS += -O1
+endif
+
+#---------------------------------------------------------------------------------------------
+# Linking flags
+LDFLAGS = -lm -lpthread -ldl
+
+#---------------------------------------------------------------------------------------------
+# Util variables
+host_src_files := $(filter-out $(SRC_DIR)/main.c $(SRC_DIR)/network/socket.c $(SRC_DIR)/network/engine_client.c, \
+                               $(src_files))
+
+OBJS	:= $(host_src_files:$(SRC_DIR)/%=$(target_build_dir)/%.o)
+OBJS	+= $(target_build_dir)/$(HOST_DIR)/platform_null.c.o
+OBJS	+= $(target_build_dir)/$(HOST_DIR)/bench_wire.c.o
+MAINS	:= $(target_build_dir)/$(HOST_DIR)/aoi_bench.c.o $(target_build_dir)/$(HOST_DIR)/micro_bench.c.o
+DEPS	:= $(OBJS:%.o=%.d) $(MAINS:%.o=%.d)
+# The dependency files carry rules of their own; keep `all` the default.
+.DEFAULT_GOAL := all
+-include $(DEPS)
+OBJS	+= $(target_build_dir)/cJSON.o
+OBJS	+= $(target_build_dir)/libraylib.a
+
+BENCH	:= $(OUTPUT_DIR)/host/aoi_bench
+MICRO	:= $(OUTPUT_DIR)/host/micro_bench
+
+#---------------------------------------------------------------------------------------------
+# Platform Specific targets
+
+.PHONY: all clean
+
+all: $(BENCH) $(MICRO)
+
+$(BENCH): $(target_build_dir)/$(HOST_DIR)/aoi_bench.c.o $(OBJS)
+	@mkdir -p $(@D)
+	$(CC) -o $@ $^ $(LDFLAGS)
+
+$(MICRO): $(target_build_dir)/$(HOST_DIR)/micro_bench.c.o $(OBJS)
+	@mkdir -p $(@D)
+	$(CC) -o $@ $^ $(LDFLAGS)
+
+$(target_build_dir)/%.c.o: $(SRC_DIR)/%.c
+	@mkdir -p $(@D)
+	$(CC) -c $< -o $@ $(CFLAGS) -MMD -MP
+
+$(target_build_dir)/$(HOST_DIR)/%.c.o: $(HOST_DIR)/%.c
+	@mkdir -p $(@D)
+	$(CC) -c $< -o $@ $(CFLAGS) -MMD -MP
+
+$(target_build_dir)/cJSON.o: $(CJSON_PATH)/cJSON.c
+	@mkdir -p $(@D)
+	$(CC) -c $< -o $@ $(CFLAGS)
+
+# Raylib dep
+$(target_build_dir)/libraylib.a:
+	@mkdir -p $(target_build_dir)
+	make -j 8 -C $(RAYLIB_PATH)/src raylib \
+		PLATFORM=PLATFORM_MEMORY \
+		RAYLIB_BUILD_MODE=$(BUILD_MODE) \
+		RAYLIB_LIBTYPE=STATIC \
+		RAYLIB_RELEASE_PATH=$(CURDIR)/$(target_build_dir)
+	make -C $(RAYLIB_PATH)/src clean
+
+clean:
+	-rm -rf $(BUILD_DIR)/host $(OUTPUT_DIR)/host
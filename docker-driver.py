@@ -2,8 +2,8 @@
 """
 Static HTTP server for the Cyberia WASM client.
 
-Silent per-request logging.  Strong no-cache headers so browsers never serve
-stale WASM/JS.
+Silent per-request logging.  The HTML shell is never cached; the bundle it
+loads is served under content-hashed names that are cached forever.
 
 Usage
 -----
@@ -30,6 +30,39 @@ Multi-instance routing
   Unset vars are simply not injected and the client falls back to the values
   compiled into the WASM.
 
+Content-hashed bundle
+---------------------
+  At startup the driver hashes index.wasm / index.data, rewrites their names
+  inside index.js, hashes the result and rewrites index.js inside the HTML
+  pages, so each deploy gets new URLs (index.<sha>.wasm, ...) and nothing on
+  disk changes.  Hashed URLs are sent "public, max-age=31536000, immutable";
+  the HTML shell stays no-store; any other file is no-cache (revalidated via
+  Last-Modified).
+
+  A release bundle may add index.simd.wasm (see release-build.sh); its hashed
+  name is injected as window.CYBERIA_SIMD_WASM and shell.html loads it in
+  place of index.wasm where the browser supports wasm SIMD.
+
+  Each hashed asset is held in memory precompressed: brotli when the
+  `brotli` module is installed (or a prebuilt <file>.br sits next to it),
+  gzip always (or a prebuilt <file>.gz).  The variant is picked from
+  Accept-Encoding and sent with Content-Encoding and Vary: Accept-Encoding.
+
+Service worker
+--------------
+  /sw.js (under any instance path) is generated at startup: it precaches the
+  hashed loader, index.wasm and index.data under a cache named after their
+  hashes, so a deploy gets a fresh cache and the old one is dropped.  While it
+  controls the page:
+    - hashed bundle files are answered cache-first (they never change);
+    - navigations go to the network, falling back to the last shell after
+      SW_NAVIGATION_TIMEOUT_MS, so a repeat visit boots offline;
+    - engine GETs under /api/ are stale-while-revalidate: answered from the
+      runtime cache at once and refreshed behind it.  File blobs (by id) are
+      cache-first.  Per-player or live data (SW_LIVE_API) always hits the network.
+  CYBERIA_SERVICE_WORKER=0 serves a worker that clears its caches and
+  unregisters itself instead.  The script itself is sent no-cache.
+
 Container status reporting
 --------------------------
   Set CONTAINER_DEPLOY_ID in the instance env file (e.g.
@@ -48,6 +81,8 @@ Container status reporting
 import sys
 import os
 import io
+import gzip
+import hashlib
 import json
 import posixpath
 import subprocess
@@ -63,6 +98,132 @@ RUNTIME_CONFIG_ENV_KEYS = (
     "CYBERIA_BASE_PATH",
 )
 
+SERVICE_WORKER_PATH = "sw.js"
+SW_NAVIGATION_TIMEOUT_MS = 3000
+SW_RUNTIME_MAX_ENTRIES = 512
+# Engine GET paths whose responses are never replayed from the cache.
+SW_LIVE_API = ("/dynamic", "playerId=", "/api/cyberia-client-hints")
+SW_IMMUTABLE_API = ("/api/file/blob/",)
+
+SERVICE_WORKER_TEMPLATE = """"use strict";
+const CACHE = "cyberia-bundle-" + VERSION;
+const RUNTIME = "cyberia-api-" + VERSION;
+
+self.addEventListener("install", function (event) {
+    event.waitUntil(
+        caches.open(CACHE).then(function (cache) {
+            return cache.addAll(PRECACHE);
+        }).then(function () { return self.skipWaiting(); }),
+    );
+});
+
+self.addEventListener("activate", function (event) {
+    event.waitUntil(
+        caches.keys().then(function (names) {
+            return Promise.all(names.filter(function (name) {
+                return name !== CACHE && name !== RUNTIME && 0 === name.indexOf("cyberia-");
+            }).map(function (name) { return caches.delete(name); }));
+        }).then(function () { return self.clients.claim(); }),
+    );
+});
+
+function bundleFile(url) {
+    if (url.origin !== self.location.origin) return false;
+    const name = url.pathname.slice(url.pathname.lastIndexOf("/") + 1);
+    return -1 !== HASHED.indexOf(name);
+}
+
+function apiMode(url) {
+    if (-1 === url.pathname.indexOf("/api/")) return null;
+    const path = url.pathname + url.search;
+    if (LIVE.some(function (part) { return -1 !== path.indexOf(part); })) return null;
+    if (IMMUTABLE.some(function (part) { return 0 === url.pathname.indexOf(part); })) return "immutable";
+    return "swr";
+}
+
+function keep(cacheName, request, response) {
+    if (!response || 200 !== response.status || "opaque" === response.type) return response;
+    const copy = response.clone();
+    caches.open(cacheName).then(function (cache) {
+        return cache.put(request, copy).then(function () { return cache.keys(); });
+    }).then(function (keys) {
+        if (cacheName !== RUNTIME || keys.length <= RUNTIME_MAX) return;
+        return caches.open(RUNTIME).then(function (cache) {
+            return Promise.all(keys.slice(0, keys.length - RUNTIME_MAX).map(function (key) {
+                return cache.delete(key);
+            }));
+        });
+    });
+    return response;
+}
+
+function cacheFirst(cacheName, request) {
+    return caches.match(request).then(function (hit) {
+        return hit || fetch(request).then(function (response) { return keep(cacheName, request, response); });
+    });
+}
+
+/* Answer from the cache when it can, and refresh the entry either way. */
+function staleWhileRevalidate(request) {
+    const network = fetch(request).then(function (response) { return keep(RUNTIME, request, response); });
+    return caches.match(request).then(function (hit) {
+        if (!hit) return network;
+        network.catch(function () {});
+        return hit;
+    });
+}
+
+/* The network, or the last shell once it is slow or gone. */
+function navigation(request) {
+    const shell = new URL("./", self.registration.scope).href;
+    const network = fetch(request).then(function (response) {
+        if (200 === response.status) {
+            const copy = response.clone();
+            caches.open(CACHE).then(function (cache) { return cache.put(shell, copy); });
+        }
+        return response;
+    });
+    const cached = caches.match(shell);
+    const slow = new Promise(function (resolve) {
+        setTimeout(resolve, NAV_TIMEOUT_MS);
+    }).then(function () { return cached; });
+    return Promise.race([network, slow.then(function (hit) { return hit || network; })])
+        .catch(function () {
+            return cached.then(function (hit) { return hit || Response.error(); });
+        });
+}
+
+self.addEventListener("fetch", function (event) {
+    const request = event.request;
+    if ("GET" !== request.method) return;
+    const url = new URL(request.url);
+    if ("navigate" === request.mode) {
+        event.respondWith(navigation(request));
+        return;
+    }
+    if (bundleFile(url)) {
+        event.respondWith(cacheFirst(CACHE, request));
+        return;
+    }
+    const mode = apiMode(url);
+    if ("immutable" === mode) event.respondWith(cacheFirst(RUNTIME, request));
+    else if ("swr" === mode) event.respondWith(staleWhileRevalidate(request));
+});
+"""
+
+SERVICE_WORKER_RETIRE = """"use strict";
+self.addEventListener("install", function () { self.skipWaiting(); });
+self.addEventListener("activate", function (event) {
+    event.waitUntil(
+        caches.keys().then(function (names) {
+            return Promise.all(names.filter(function (name) {
+                return 0 === name.indexOf("cyberia-");
+            }).map(function (name) { return caches.delete(name); }));
+        }).then(function () { return self.registration.unregister(); }),
+    );
+});
+"""
+
 
 def runtime_config_script() -> bytes:
     """<script> assigning the configured env vars to window.*, or b'' if none."""
@@ -77,6 +238,135 @@ def runtime_config_script() -> bytes:
     return f"<script>{assignments}</script>".encode("utf-8")
 
 
+try:
+    import brotli
+except ImportError:
+    brotli = None
+
+# Leaves first: index.js names the wasm and data files, the HTML names index.js.
+HASHED_LEAVES = (
+    ("index.wasm", "application/wasm"),
+    ("index.data", "application/octet-stream"),
+    # Optional SIMD build of index.wasm (release-build.sh); shares index.js.
+    ("index.simd.wasm", "application/wasm"),
+)
+SIMD_WASM = "index.simd.wasm"
+HASHED_LOADER = ("index.js", "text/javascript")
+
+CACHE_IMMUTABLE = "public, max-age=31536000, immutable"
+CACHE_HTML = "no-store, no-cache, must-revalidate"
+CACHE_REVALIDATE = "no-cache"
+
+
+class HashedAsset:
+    """One bundle file kept in memory under its hashed name, with each
+    Content-Encoding it can be served in ("" is identity)."""
+
+    def __init__(self, body: bytes, content_type: str, stem=None):
+        """`stem` is the file on disk whose prebuilt .br/.gz may be reused;
+        None when `body` was rewritten and no longer matches them."""
+        self.content_type = content_type
+        self.encodings = {"": body}
+        for suffix, encoding in ((".br", "br"), (".gz", "gzip")):
+            prebuilt = (stem or "") + suffix
+            if stem and os.path.isfile(prebuilt) and os.path.getmtime(prebuilt) >= os.path.getmtime(stem):
+                with open(prebuilt, "rb") as handle:
+                    self.encodings[encoding] = handle.read()
+        if "br" not in self.encodings and brotli is not None:
+            self.encodings["br"] = brotli.compress(body, quality=11)
+        if "gzip" not in self.encodings:
+            self.encodings["gzip"] = gzip.compress(body, compresslevel=9, mtime=0)
+
+    def pick(self, accept_encoding: str):
+        """(encoding, body) for the smallest variant the client accepts."""
+
+        accepted = {
+            token.split(";", 1)[0].strip().lower()
+            for token in accept_encoding.split(",")
+            if token.strip() and not token.replace(" ", "").endswith(";q=0")
+        }
+        best = ""
+        for encoding in ("br", "gzip"):
+            if encoding in accepted and encoding in self.encodings:
+                if len(self.encodings[encoding]) < len(self.encodings[best]):
+                    best = encoding
+        return best, self.encodings[best]
+
+
+def hashed_name(name: str, body: bytes) -> str:
+    root, ext = posixpath.splitext(name)
+    return f"{root}.{hashlib.sha256(body).hexdigest()[:16]}{ext}"
+
+
+def build_hashed_bundle(directory: str):
+    """Hash the bundle under `directory`. Returns ({hashed name: HashedAsset},
+    {plain name: hashed name}); both empty when index.js is missing, in which
+    case everything is served as-is."""
+
+    loader, loader_type = HASHED_LOADER
+    if not os.path.isfile(os.path.join(directory, loader)):
+        return {}, {}
+
+    assets, renames = {}, {}
+    for name, content_type in HASHED_LEAVES:
+        path = os.path.join(directory, name)
+        if not os.path.isfile(path):
+            continue
+        with open(path, "rb") as handle:
+            body = handle.read()
+        renames[name] = hashed_name(name, body)
+        assets[renames[name]] = HashedAsset(body, content_type, path)
+
+    path = os.path.join(directory, loader)
+    with open(path, "rb") as handle:
+        original = handle.read()
+    body = rewrite_names(original, renames)
+    renames[loader] = hashed_name(loader, body)
+    assets[renames[loader]] = HashedAsset(body, loader_type, path if body == original else None)
+    return assets, renames
+
+
+def rewrite_names(body: bytes, renames: dict) -> bytes:
+    """Swap quoted references to bundle files for their hashed names."""
+
+    for name, hashed in renames.items():
+        for quote in (b'"', b"'", b"`"):
+            body = body.replace(quote + name.encode() + quote, quote + hashed.encode() + quote)
+    return body
+
+
+def bundle_config_script(renames: dict) -> bytes:
+    """<script> naming the SIMD module for shell.html, or b'' without one."""
+
+    if SIMD_WASM not in renames:
+        return b""
+    return f"<script>window.CYBERIA_SIMD_WASM={json.dumps(renames[SIMD_WASM])};</script>".encode("utf-8")
+
+
+def service_worker_script(renames: dict) -> bytes:
+    """The /sw.js body for this bundle (see "Service worker" above)."""
+
+    if "0" == os.environ.get("CYBERIA_SERVICE_WORKER", "1"):
+        return SERVICE_WORKER_RETIRE.encode("utf-8")
+    hashed = sorted(renames.values())
+    # The SIMD module replaces index.wasm on some browsers only, so it is
+    # cached the first time it is used rather than downloaded up front.
+    precache = sorted(hashed_name for plain, hashed_name in renames.items() if SIMD_WASM != plain)
+    version = hashlib.sha256("\n".join(hashed).encode("utf-8")).hexdigest()[:16]
+    constants = {
+        "VERSION": version,
+        "PRECACHE": ["./"] + precache,
+        "HASHED": hashed,
+        "LIVE": list(SW_LIVE_API),
+        "IMMUTABLE": list(SW_IMMUTABLE_API),
+        "NAV_TIMEOUT_MS": SW_NAVIGATION_TIMEOUT_MS,
+        "RUNTIME_MAX": SW_RUNTIME_MAX_ENTRIES,
+    }
+    header = "".join(f"const {name} = {json.dumps(value)};\n" for name, value in constants.items())
+    strict = '"use strict";\n'
+    return SERVICE_WORKER_TEMPLATE.replace(strict, strict + header, 1).encode("utf-8")
+
+
 def call_underpost(key: str, value: str) -> None:
     try:
         r = subprocess.run(
@@ -108,10 +398,20 @@ def report_container_status(container_id: str, status: str) -> None:
 class CyberiaHandler(SimpleHTTPRequestHandler):
     """Serves the flat bundle under any /<instance>/ prefix. Silent logging."""
 
+    hashed_assets = {}
+    hashed_renames = {}
+    service_worker = b""
+
+    def send_response(self, code, message=None):
+        self._cache_control = CACHE_REVALIDATE
+        super().send_response(code, message)
+
     def end_headers(self):
-        self.send_header("Cache-Control", "no-store, no-cache, must-revalidate")
-        self.send_header("Pragma", "no-cache")
-        self.send_header("Expires", "0")
+        cache = getattr(self, "_cache_control", CACHE_REVALIDATE)
+        self.send_header("Cache-Control", cache)
+        if CACHE_HTML == cache:
+            self.send_header("Pragma", "no-cache")
+            self.send_header("Expires", "0")
         super().end_headers()
 
     def log_message(self, fmt, *args):
@@ -132,18 +432,40 @@ class CyberiaHandler(SimpleHTTPRequestHandler):
 
     def _serve_html(self, filepath, status):
         """Serve an HTML file at `status` with the runtime config injected."""
-        script = runtime_config_script()
+        script = runtime_config_script() + bundle_config_script(self.hashed_renames)
         with open(filepath, "rb") as handle:
             body = handle.read()
         if script:
             marker = b"</head>"
             body = body.replace(marker, script + marker, 1) if marker in body else script + body
+        body = rewrite_names(body, self.hashed_renames)
         self.send_response(status)
+        self._cache_control = CACHE_HTML
         self.send_header("Content-type", "text/html; charset=utf-8")
         self.send_header("Content-Length", str(len(body)))
         self.end_headers()
         return io.BytesIO(body)
 
+    def _serve_hashed(self, asset):
+        """Serve a hashed asset in the best encoding the client accepts."""
+        encoding, body = asset.pick(self.headers.get("Accept-Encoding", ""))
+        self.send_response(200)
+        self._cache_control = CACHE_IMMUTABLE
+        self.send_header("Content-type", asset.content_type)
+        self.send_header("Content-Length", str(len(body)))
+        self.send_header("Vary", "Accept-Encoding")
+        if encoding:
+            self.send_header("Content-Encoding", encoding)
+        self.end_headers()
+        return io.BytesIO(body)
+
+    def _serve_service_worker(self):
+        self.send_response(200)
+        self.send_header("Content-type", "text/javascript")
+        self.send_header("Content-Length", str(len(self.service_worker)))
+        self.end_headers()
+        return io.BytesIO(self.service_worker)
+
     def send_head(self):
         """Serve the bundle. HTML gets the runtime config injected; an unmatched
         path serves the instance's 404 page (404.html) with a 404 status, so
@@ -151,6 +473,12 @@ class CyberiaHandler(SimpleHTTPRequestHandler):
         sub-path is already stripped by translate_path)."""
 
         served = self.translate_path(self.path)
+        relative = os.path.relpath(served, os.getcwd())
+        if SERVICE_WORKER_PATH == relative:
+            return self._serve_service_worker()
+        asset = self.hashed_assets.get(relative)
+        if asset is not None:
+            return self._serve_hashed(asset)
         if os.path.isdir(served):
             served = os.path.join(served, "index.html")
         if os.path.isfile(served):
@@ -176,6 +504,11 @@ if __name__ == "__main__":
     container_id = os.environ.get("CONTAINER_DEPLOY_ID", "")
 
     os.chdir(directory)
+    CyberiaHandler.hashed_assets, CyberiaHandler.hashed_renames = build_hashed_bundle(".")
+    for plain, hashed in CyberiaHandler.hashed_renames.items():
+        encodings = "/".join(e or "identity" for e in CyberiaHandler.hashed_assets[hashed].encodings)
+        print(f"[bundle] {plain} -> {hashed} ({encodings})", flush=True)
+    CyberiaHandler.service_worker = service_worker_script(CyberiaHandler.hashed_renames)
 
     try:
         server = HTTPServer(("", port), CyberiaHandler)
@@ -0,0 +1,344 @@
+#include "bench_wire.h"
+#include "platform_null.h"
+
+#include "binary_aoi_decoder.h"
+#include "frame_tasks.h"
+#include "game_render.h"
+#include "game_state.h"
+#include "image_decoder.h"
+#include "message_parser.h"
+#include "network/engine_client.h"
+#include "network/game_client.h"
+#include "network/replication.h"
+#include "network/session_recorder.h"
+#include "render.h"
+#include "render_queue.h"
+
+#include <emscripten/emscripten.h>
+#include <raylib.h>
+
+#include <assert.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/*
+ * Headless decode → interpolate → render benchmark.
+ *
+ * Frames are synthesized in the server's wire format (binary_aoi_decoder.h):
+ * one BIN_MSG_INIT_DATA, then a BIN_MSG_FULL_AOI every --full-every frames
+ * and BIN_MSG_AOI_DELTA position patches in between, with bots and players
+ * circling the self player. Each frame runs through the same entry points
+ * the game loop uses, and every stage is timed separately.
+ *
+ *   aoi_bench [--frames N] [--bots N] [--players N] [--objects N]
+ *             [--full-every N] [--no-render]
+ *
+ * With --replay, a capture from network/session_recorder.h is fed through
+ * game_client's message handler instead, fetch bodies included, as fast as
+ * it decodes or, with --realtime, at the recorded pace. Every AOI snapshot
+ * closes a frame (fetch pump, interpolate, render), and the report adds
+ * decode throughput, entity churn and the renderer's depth-sort and draw
+ * submission counts.
+ *
+ *   aoi_bench --replay FILE [--realtime] [--no-render]
+ */
+
+#define BENCH_SCREEN_W  1280
+#define BENCH_SCREEN_H  720
+
+typedef struct {
+    int  frames;
+    int  bots;
+    int  players;
+    int  objects;
+    int  full_every;
+    bool render;
+    const char* replay;
+    bool realtime;
+} BenchConfig;
+
+/* ── Timing ──────────────────────────────────────────────────────────── */
+
+enum { STAGE_DECODE, STAGE_INTERPOLATE, STAGE_RENDER, STAGE_COUNT };
+
+static const char* const kStageNames[STAGE_COUNT] = {
+    [STAGE_DECODE]      = "decode",
+    [STAGE_INTERPOLATE] = "interpolate",
+    [STAGE_RENDER]      = "render",
+};
+
+static int compare_doubles(const void* a, const void* b) {
+    double da = *(const double*)a, db = *(const double*)b;
+    return (da > db) - (da < db);
+}
+
+static void report(const char* name, double* us, int n) {
+    if (0 == n) return;
+    double sum = 0.0;
+    for (int i = 0; i < n; i++) sum += us[i];
+    qsort(us, (size_t)n, sizeof(double), compare_doubles);
+    printf("%-12s mean %9.1f  p50 %9.1f  p95 %9.1f  p99 %9.1f  max %9.1f us\n", name,
+           sum / n, us[n / 2], us[(int)(0.95 * (n - 1))], us[(int)(0.99 * (n - 1))], us[n - 1]);
+}
+
+static int arg_int(int argc, char** argv, int* i) {
+    if (*i + 1 >= argc) {
+        fprintf(stderr, "%s needs a value\n", argv[*i]);
+        exit(2);
+    }
+    return atoi(argv[++*i]);
+}
+
+static void report_counts(const char* name, const int* v, int n) {
+    if (0 == n) return;
+    long sum = 0;
+    int  max = 0;
+    for (int i = 0; i < n; i++) {
+        sum += v[i];
+        if (v[i] > max) max = v[i];
+    }
+    printf("%-16s mean %9.1f  max %7d\n", name, (double)sum / n, max);
+}
+
+static void sleep_until(double at_ms) {
+    double wait = at_ms - emscripten_get_now();
+    if (wait <= 0.0) return;
+    struct timespec ts = { .tv_sec = (time_t)(wait / 1000.0),
+                           .tv_nsec = (long)(fmod(wait, 1000.0) * 1.0e6) };
+    nanosleep(&ts, NULL);
+}
+
+static uint8_t* read_file(const char* path, size_t* size) {
+    FILE* f = fopen(path, "rb");
+    if (!f) return NULL;
+    fseek(f, 0, SEEK_END);
+    long n = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    uint8_t* data = (0 < n) ? malloc((size_t)n) : NULL;
+    if (data && 1 != fread(data, (size_t)n, 1, f)) {
+        free(data);
+        data = NULL;
+    }
+    fclose(f);
+    *size = data ? (size_t)n : 0;
+    return data;
+}
+
+static bool is_snapshot(const uint8_t* data, bool is_text) {
+    if (is_text) return MSG_TYPE_AOI_UPDATE == message_parser_last_type();
+    return BIN_MSG_AOI_UPDATE == data[0] || BIN_MSG_FULL_AOI == data[0] || BIN_MSG_AOI_DELTA == data[0];
+}
+
+/* Per-frame series of a replay, one entry per AOI snapshot. */
+enum {
+    SERIES_ENTERED, SERIES_LEFT, SERIES_DEPTH_ENTRIES, SERIES_DEPTH_NEWCOMERS,
+    SERIES_QUADS, SERIES_DRAW_CALLS, SERIES_COUNT
+};
+
+static const char* const kSeriesNames[SERIES_COUNT] = {
+    [SERIES_ENTERED]         = "entered",
+    [SERIES_LEFT]            = "left",
+    [SERIES_DEPTH_ENTRIES]   = "depth entries",
+    [SERIES_DEPTH_NEWCOMERS] = "depth newcomers",
+    [SERIES_QUADS]           = "quads",
+    [SERIES_DRAW_CALLS]      = "draw calls",
+};
+
+static int run_replay(const BenchConfig* cfg) {
+    size_t size;
+    uint8_t* capture = read_file(cfg->replay, &size);
+    SessionReader reader;
+    if (!capture || !session_reader_init(&reader, capture, size)) {
+        fprintf(stderr, "%s: not a session capture\n", cfg->replay);
+        return 1;
+    }
+
+    /* Size the series from a first pass. */
+    SessionRecord rec;
+    int ws_count = 0, fetch_count = 0;
+    double span_ms = 0.0;
+    while (session_reader_next(&reader, &rec)) {
+        if (SESSION_RECORD_WS_BINARY == rec.kind || SESSION_RECORD_WS_TEXT == rec.kind) ws_count++;
+        else                                                                           fetch_count++;
+        span_ms = rec.t_ms;
+    }
+    if (reader.pos != reader.size) fprintf(stderr, "capture cut short at byte %zu\n", reader.pos);
+
+    double* decode_us = calloc((size_t)(ws_count ? ws_count : 1), sizeof(double));
+    double* stage_us[STAGE_COUNT];
+    int*    series[SERIES_COUNT];
+    for (int s = 0; s < STAGE_COUNT; s++) stage_us[s] = calloc((size_t)(ws_count ? ws_count : 1), sizeof(double));
+    for (int s = 0; s < SERIES_COUNT; s++) series[s] = calloc((size_t)(ws_count ? ws_count : 1), sizeof(int));
+
+    host_fetch_hold_unanswered(true);
+    session_reader_init(&reader, capture, size);
+    int    messages = 0, frames = 0, full_sorts = 0, static_rebuilds = 0;
+    size_t ws_bytes = 0;
+    double decode_total_us = 0.0;
+    double start = emscripten_get_now();
+    GameStateChurn churn = game_state_churn();
+    uint32_t world_revision = g_game_state.world_revision, world_rebuilds = 0;
+
+    while (session_reader_next(&reader, &rec)) {
+        if (cfg->realtime) sleep_until(start + rec.t_ms);
+        if (SESSION_RECORD_FETCH == rec.kind || SESSION_RECORD_FETCH_BULK == rec.kind) {
+            char id[512];
+            snprintf(id, sizeof(id), "%.*s", (int)rec.id_len, rec.asset_id);
+            if (SESSION_RECORD_FETCH == rec.kind) host_fetch_deliver(id, rec.data, rec.length);
+            else                                  host_fetch_deliver_bulk(id, rec.data, rec.length);
+            continue;
+        }
+        if (0 == rec.length) continue;
+
+        bool is_text = SESSION_RECORD_WS_TEXT == rec.kind;
+        double t0 = emscripten_get_now();
+        game_client_inject_message(rec.data, rec.length, is_text);
+        double us = (emscripten_get_now() - t0) * 1000.0;
+        decode_us[messages++] = us;
+        decode_total_us += us;
+        ws_bytes += rec.length;
+        if (!is_snapshot(rec.data, is_text)) continue;
+
+        double t1 = emscripten_get_now();
+        fetch_batch_pump();
+        image_decoder_pump();
+        interpolation_compute_view();
+        double t2 = emscripten_get_now();
+        if (cfg->render) render_on_tick(1.0f / 60.0f);
+        double t3 = emscripten_get_now();
+        frame_tasks_run(FRAME_TASKS_BUDGET_MS);
+
+        GameStateChurn now = game_state_churn();
+        series[SERIES_ENTERED][frames] = (int)(now.entered - churn.entered);
+        series[SERIES_LEFT][frames]    = (int)(now.left - churn.left);
+        churn = now;
+        if (g_game_state.world_revision != world_revision) world_rebuilds++;
+        world_revision = g_game_state.world_revision;
+        if (cfg->render) {
+            GameRenderDepthStats depth = game_render_depth_stats();
+            RenderQueueStats     queue = render_queue_stats();
+            series[SERIES_DEPTH_ENTRIES][frames]   = depth.entries;
+            series[SERIES_DEPTH_NEWCOMERS][frames] = depth.newcomers;
+            series[SERIES_QUADS][frames]           = queue.quads;
+            series[SERIES_DRAW_CALLS][frames]      = queue.draw_calls;
+            full_sorts      += depth.full_sort ? 1 : 0;
+            static_rebuilds += depth.statics_rebuilt ? 1 : 0;
+        }
+        stage_us[STAGE_DECODE][frames]      = us;
+        stage_us[STAGE_INTERPOLATE][frames] = (t2 - t1) * 1000.0;
+        stage_us[STAGE_RENDER][frames]      = (t3 - t2) * 1000.0;
+        frames++;
+    }
+    double wall_ms = emscripten_get_now() - start;
+
+    printf("%s: %d messages, %d fetch bodies, %.1f KB, recorded over %.1f s, replayed in %.1f s\n",
+           cfg->replay, ws_count, fetch_count, (double)size / 1024.0, span_ms / 1000.0, wall_ms / 1000.0);
+    printf("decode throughput %.1f MB/s, %.0f messages/s over %d snapshots\n",
+           decode_total_us > 0.0 ? (double)ws_bytes / decode_total_us : 0.0,
+           decode_total_us > 0.0 ? (double)messages * 1.0e6 / decode_total_us : 0.0, frames);
+    report("message", decode_us, messages);
+    for (int s = 0; s < STAGE_COUNT; s++) {
+        if (STAGE_RENDER == s && !cfg->render) continue;
+        report(kStageNames[s], stage_us[s], frames);
+    }
+    printf("churn: %d players, %d bots at end, %u world rebuilds\n",
+           g_game_state.other_player_count, g_game_state.bot_count, (unsigned)world_rebuilds);
+    for (int s = 0; s < SERIES_COUNT; s++) {
+        if (SERIES_DEPTH_ENTRIES <= s && !cfg->render) continue;
+        report_counts(kSeriesNames[s], series[s], frames);
+    }
+    if (cfg->render) printf("depth full sorts %d, static run rebuilds %d\n", full_sorts, static_rebuilds);
+
+    for (int s = 0; s < STAGE_COUNT; s++) free(stage_us[s]);
+    for (int s = 0; s < SERIES_COUNT; s++) free(series[s]);
+    free(decode_us);
+    free(capture);
+    return 0;
+}
+
+static int run_synthetic(const BenchConfig* cfg) {
+    const BenchWorld world = { .bots = cfg->bots, .players = cfg->players, .objects = cfg->objects };
+    Wire w = { 0 };
+    bench_wire_init_data(&w);
+    if (0 != binary_aoi_process(w.data, w.len)) {
+        fprintf(stderr, "init_data rejected\n");
+        return 1;
+    }
+
+    double* us[STAGE_COUNT];
+    for (int s = 0; s < STAGE_COUNT; s++) {
+        us[s] = calloc((size_t)cfg->frames, sizeof(double));
+        assert(us[s]);
+    }
+    size_t bytes = 0;
+
+    for (int f = 0; f < cfg->frames; f++) {
+        if (0 == f % cfg->full_every) bench_wire_full_aoi(&w, &world, f);
+        else                          bench_wire_aoi_delta(&w, &world, f);
+        bytes += w.len;
+
+        double t0 = emscripten_get_now();
+        if (0 != binary_aoi_process(w.data, w.len)) {
+            fprintf(stderr, "frame %d rejected\n", f);
+            return 1;
+        }
+        double t1 = emscripten_get_now();
+        interpolation_compute_view();
+        double t2 = emscripten_get_now();
+        if (cfg->render) render_on_tick(1.0f / 60.0f);
+        double t3 = emscripten_get_now();
+
+        us[STAGE_DECODE][f]      = (t1 - t0) * 1000.0;
+        us[STAGE_INTERPOLATE][f] = (t2 - t1) * 1000.0;
+        us[STAGE_RENDER][f]      = (t3 - t2) * 1000.0;
+    }
+
+    printf("%d frames, %d bots, %d players, %d objects, full every %d, %.1f KB/frame\n",
+           cfg->frames, g_game_state.bot_count, g_game_state.other_player_count,
+           game_state_world_object_count(), cfg->full_every,
+           (double)bytes / 1024.0 / (double)cfg->frames);
+    for (int s = 0; s < STAGE_COUNT; s++) {
+        if (STAGE_RENDER == s && !cfg->render) continue;
+        report(kStageNames[s], us[s], cfg->frames);
+    }
+    for (int s = 0; s < STAGE_COUNT; s++) free(us[s]);
+    bench_wire_free(&w);
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    BenchConfig cfg = { .frames = 600, .bots = 200, .players = 50, .objects = 2000,
+                        .full_every = 60, .render = true };
+    for (int i = 1; i < argc; i++) {
+        if      (0 == strcmp(argv[i], "--frames"))     cfg.frames     = arg_int(argc, argv, &i);
+        else if (0 == strcmp(argv[i], "--bots"))       cfg.bots       = arg_int(argc, argv, &i);
+        else if (0 == strcmp(argv[i], "--players"))    cfg.players    = arg_int(argc, argv, &i);
+        else if (0 == strcmp(argv[i], "--objects"))    cfg.objects    = arg_int(argc, argv, &i);
+        else if (0 == strcmp(argv[i], "--full-every")) cfg.full_every = arg_int(argc, argv, &i);
+        else if (0 == strcmp(argv[i], "--no-render"))  cfg.render     = false;
+        else if (0 == strcmp(argv[i], "--realtime"))   cfg.realtime   = true;
+        else if (0 == strcmp(argv[i], "--replay") && i + 1 < argc) cfg.replay = argv[++i];
+        else {
+            fprintf(stderr, "usage: %s [--frames N] [--bots N] [--players N] [--objects N] "
+                            "[--full-every N] [--no-render]\n"
+                            "       %s --replay FILE [--realtime] [--no-render]\n", argv[0], argv[0]);
+            return 2;
+        }
+    }
+    if (cfg.full_every < 1) cfg.full_every = 1;
+
+    SetTraceLogLevel(LOG_WARNING);
+    InitWindow(BENCH_SCREEN_W, BENCH_SCREEN_H, "aoi_bench");
+    prediction_init();
+    render_init(BENCH_SCREEN_W, BENCH_SCREEN_H);
+
+    int rc = cfg.replay ? run_replay(&cfg) : run_synthetic(&cfg);
+
+    render_cleanup();
+    CloseWindow();
+    return rc;
+}
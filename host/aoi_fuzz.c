@@ -0,0 +1,131 @@
+#include "bench_wire.h"
+
+#include "binary_aoi_decoder.h"
+#include "network/replication.h"
+
+#include <raylib.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Fuzz target for the binary AOI decoder, after libs/cJSON/fuzzing.
+ *
+ * Each input is one server message. The first byte picks the entry point —
+ * odd: binary_aoi_decode_static_world, even: binary_aoi_process — and the
+ * rest is the message, so the world-object decoders are reached both
+ * through AOI frames and through the static-world blob. State carries
+ * across inputs the way it does across a session; the decoder is primed
+ * with the bench init_data so grid extents are real.
+ *
+ * Not part of Host.mk's default targets. libFuzzer (clang):
+ *
+ *   make -f Host.mk BUILD_MODE=RELEASE
+ *   clang -fsanitize=fuzzer,address -g -O1 -DNDEBUG -DCYBERIA_LIBFUZZER \
+ *         -std=gnu11 -Isrc -Ihost/include -Ilibs/raylib/src -Ilibs/cJSON \
+ *         -DCYBERIA_LOG_LEVEL=0 host/aoi_fuzz.c host/bench_wire.c host/platform_null.c \
+ *         $(ls src/*.c src/{js,network,ui,input,domain}/*.c \
+ *           | grep -v -e src/main.c -e network/socket.c -e network/engine_client.c) \
+ *         libs/cJSON/cJSON.c build/host/RELEASE/libraylib.a -lm -lpthread -ldl \
+ *         -o bin/host/aoi_fuzz
+ *   bin/host/aoi_fuzz corpus
+ *
+ * Without -DCYBERIA_LIBFUZZER (and -fsanitize=address alone, gcc works) the
+ * same sources build a replay driver, which also writes the seed corpus and
+ * which AFL can run as `aoi_fuzz @@`:
+ *
+ *   aoi_fuzz FILE...       decode each file as one input
+ *   aoi_fuzz --seed DIR    write the bench frames as a starting corpus
+ */
+
+#define FUZZ_SCREEN_W 64
+#define FUZZ_SCREEN_H 64
+
+int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size);
+
+static void fuzz_init(void) {
+    static bool s_ready;
+    if (s_ready) return;
+    s_ready = true;
+    SetTraceLogLevel(LOG_NONE);
+    InitWindow(FUZZ_SCREEN_W, FUZZ_SCREEN_H, "aoi_fuzz");
+    prediction_init();
+    Wire init = { 0 };
+    bench_wire_init_data(&init);
+    binary_aoi_process(init.data, init.len);
+    bench_wire_free(&init);
+}
+
+int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    fuzz_init();
+    if (2 > size) return 0;
+    /* A private copy of exactly the message, so any read past it lands
+     * outside the allocation where the sanitizer sees it. */
+    size_t   len = size - 1;
+    uint8_t* msg = malloc(len);
+    if (NULL == msg) return 0;
+    memcpy(msg, data + 1, len);
+    if (data[0] & 1) binary_aoi_decode_static_world(msg, len);
+    else             binary_aoi_process(msg, len);
+    free(msg);
+    return 0;
+}
+
+#ifndef CYBERIA_LIBFUZZER
+
+static bool write_seed(const char* dir, const char* name, uint8_t entry, const Wire* w) {
+    char path[512];
+    snprintf(path, sizeof(path), "%s/%s", dir, name);
+    FILE* f = fopen(path, "wb");
+    if (NULL == f) { fprintf(stderr, "cannot write %s\n", path); return false; }
+    bool ok = 1 == fwrite(&entry, 1, 1, f) && w->len == fwrite(w->data, 1, w->len, f);
+    fclose(f);
+    return ok;
+}
+
+/* A small world keeps the seeds short enough for the fuzzer to mutate
+ * every block kind. */
+static int seed_corpus(const char* dir) {
+    const BenchWorld world = { .bots = 3, .players = 2, .objects = 4 };
+    Wire w = { 0 };
+    bool ok = true;
+    bench_wire_init_data(&w);
+    ok = ok && write_seed(dir, "init_data", 0, &w);
+    bench_wire_full_aoi(&w, &world, 0);
+    ok = ok && write_seed(dir, "full_aoi", 0, &w);
+    bench_wire_aoi_delta(&w, &world, 1);
+    ok = ok && write_seed(dir, "aoi_delta", 0, &w);
+    bench_wire_free(&w);
+    return ok ? 0 : 1;
+}
+
+static int replay_file(const char* path) {
+    FILE* f = fopen(path, "rb");
+    if (NULL == f) { fprintf(stderr, "cannot open %s\n", path); return 1; }
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    rewind(f);
+    uint8_t* buf = 0 < size ? malloc((size_t)size) : NULL;
+    if (buf && 1 == fread(buf, (size_t)size, 1, f)) {
+        LLVMFuzzerTestOneInput(buf, (size_t)size);
+    }
+    free(buf);
+    fclose(f);
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    if (3 == argc && 0 == strcmp(argv[1], "--seed")) return seed_corpus(argv[2]);
+    if (2 > argc) {
+        fprintf(stderr, "usage: %s FILE... | --seed DIR\n", argv[0]);
+        return 2;
+    }
+    int rc = 0;
+    for (int i = 1; i < argc; i++) rc |= replay_file(argv[i]);
+    return rc;
+}
+
+#endif /* CYBERIA_LIBFUZZER */
@@ -0,0 +1,237 @@
+#include "bench_wire.h"
+
+#include "binary_aoi_decoder.h"
+
+#include <raylib.h>
+
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ── Wire writer ─────────────────────────────────────────────────────── */
+
+static void wire_reserve(Wire* w, size_t n) {
+    if (w->len + n <= w->cap) return;
+    while (w->len + n > w->cap) w->cap = w->cap ? w->cap * 2 : 4096;
+    w->data = realloc(w->data, w->cap);
+    assert(w->data);
+}
+
+static void put_u8(Wire* w, uint8_t v) {
+    wire_reserve(w, 1);
+    w->data[w->len++] = v;
+}
+
+static void put_u16(Wire* w, uint16_t v) {
+    put_u8(w, (uint8_t)v);
+    put_u8(w, (uint8_t)(v >> 8));
+}
+
+static void put_u32(Wire* w, uint32_t v) {
+    put_u16(w, (uint16_t)v);
+    put_u16(w, (uint16_t)(v >> 16));
+}
+
+static void put_f32(Wire* w, float f) {
+    uint32_t bits;
+    memcpy(&bits, &f, sizeof(bits));
+    put_u32(w, bits);
+}
+
+static void put_str(Wire* w, const char* s) {
+    size_t n = strlen(s);
+    assert(n <= UINT8_MAX);
+    put_u8(w, (uint8_t)n);
+    wire_reserve(w, n);
+    memcpy(w->data + w->len, s, n);
+    w->len += n;
+}
+
+/* Fixed 36-byte, zero-padded id field. */
+static void put_id(Wire* w, const char* kind, int i) {
+    char id[37] = { 0 };
+    snprintf(id, sizeof(id), "bench-%s-%08d", kind, i);
+    wire_reserve(w, 36);
+    memcpy(w->data + w->len, id, 36);
+    w->len += 36;
+}
+
+static void put_qpos(Wire* w, Vector2 pos) {
+    put_u16(w, (uint16_t)(pos.x * 65536.0f / (float)BENCH_GRID));
+    put_u16(w, (uint16_t)(pos.y * 65536.0f / (float)BENCH_GRID));
+}
+
+static void put_layers(Wire* w, const char* item) {
+    put_u8(w, 1);
+    put_str(w, item);
+    put_u16(w, 1);
+}
+
+static void put_entity_layers(Wire* w, const EntityState* e) {
+    put_u8(w, (uint8_t)e->object_layer_count);
+    for (int i = 0; i < e->object_layer_count; i++) {
+        put_str(w, e->object_layers[i].item_id);
+        put_u16(w, (uint16_t)e->object_layers[i].quantity);
+    }
+}
+
+static void put_bot_quests(Wire* w, const BotState* b) {
+    put_u8(w, (uint8_t)b->quest_code_count);
+    for (int i = 0; i < b->quest_code_count; i++) put_str(w, b->quest_codes[i]);
+    put_u8(w, (uint8_t)b->quest_code_count);
+    for (int i = 0; i < b->quest_code_count; i++) put_str(w, b->quest_talk_dialog_codes[i]);
+}
+
+/* The decoder's block schemas (AOI_SCHEMA_*) run backwards: `rec` is
+ * written under `flags`, field for field in the order it is read. */
+#define AOI_ENCODE_LIFE(m, a)                                           \
+    if (flags & BIN_FLAG_HAS_LIFE) { put_f32(w, rec->m); put_f32(w, rec->a); }
+#define AOI_ENCODE_RESPAWN(m, a)  if (flags & BIN_FLAG_HAS_RESPAWN) put_f32(w, rec->m);
+#define AOI_ENCODE_BEHAVIOR(m, a) if (flags & BIN_FLAG_HAS_BEHAVIOR) put_str(w, rec->m);
+#define AOI_ENCODE_LAYERS(m, a)   put_entity_layers(w, &rec->m);
+#define AOI_ENCODE_CASTER(m, a)   put_str(w, rec->m);
+#define AOI_ENCODE_STRING(m, a)   put_str(w, rec->m);
+#define AOI_ENCODE_U16(m, a)      put_u16(w, (uint16_t)rec->m);
+#define AOI_ENCODE_U8(m, a)       put_u8(w, rec->m);
+#define AOI_ENCODE_QUESTS(m, a)   put_bot_quests(w, rec);
+#define AOI_ENCODE_FIELD(op, m, a) AOI_ENCODE_##op(m, a)
+
+static void put_player_tail(Wire* w, uint8_t flags, const PlayerState* rec) {
+    AOI_SCHEMA_PLAYER(AOI_ENCODE_FIELD)
+}
+
+static void put_bot_tail(Wire* w, uint8_t flags, const BotState* rec) {
+    AOI_SCHEMA_BOT(AOI_ENCODE_FIELD)
+}
+
+/* ── Frames ──────────────────────────────────────────────────────────── */
+
+static const Vector2 kCenter = { BENCH_GRID / 2.0f, BENCH_GRID / 2.0f };
+
+/* Entity i orbits the center; the phase advances one step per frame. */
+static Vector2 orbit(int i, int count, int frame) {
+    float a = 6.2831853f * (float)i / (float)(count ? count : 1) + 0.02f * (float)frame;
+    float r = BENCH_RADIUS * (0.3f + 0.7f * (float)((i * 7919) % 97) / 97.0f);
+    return (Vector2){ kCenter.x + r * cosf(a), kCenter.y + r * sinf(a) };
+}
+
+void bench_wire_init_data(Wire* w) {
+    w->len = 0;
+    put_u8(w, BIN_MSG_INIT_DATA);
+    put_u16(w, BENCH_GRID);
+    put_u16(w, BENCH_GRID);
+    put_f32(w, BENCH_RADIUS + 4.0f);
+    put_u32(w, 100);   /* sumStatsLimit */
+    put_u8(w, 0);      /* entity defaults */
+    put_u8(w, 0);      /* dead item ids */
+    put_u16(w, 0);     /* skills */
+    put_u32(w, 0);     /* quests */
+}
+
+static void put_self(Wire* w) {
+    put_u8(w, BIN_FLAG_HAS_LIFE);
+    put_id(w, "self", 0);
+    put_f32(w, kCenter.x);
+    put_f32(w, kCenter.y);
+    put_f32(w, 1.0f);
+    put_f32(w, 1.0f);
+    put_u8(w, 0);      /* direction */
+    put_u8(w, 0);      /* mode */
+    put_f32(w, 100.0f);
+    put_f32(w, 100.0f);
+    put_layers(w, "anon");
+    for (int i = 0; i < 4; i++) put_f32(w, 0.0f);   /* AOI rect */
+    put_u8(w, 0);      /* onPortal */
+    put_u16(w, 100);   /* sumStatsLimit */
+    put_u16(w, 0);     /* activeStatsSum */
+    put_str(w, "bench");
+    put_u8(w, 0);      /* path length */
+    put_u16(w, 0);     /* target x, y */
+    put_u16(w, 0);
+    put_str(w, "");    /* active portal */
+    put_u32(w, 0);     /* coins */
+    put_u8(w, 0);      /* inventory */
+    put_u8(w, 0);      /* frozen */
+    put_u8(w, 0);      /* status icon */
+    put_f32(w, 0.0f);  /* move speed: keep the default */
+    put_f32(w, 0.0f);  /* portal hold */
+}
+
+static void put_kinematics(Wire* w, Vector2 pos) {
+    put_qpos(w, pos);
+    put_u8(w, BIN_QPACK_HAS_DIMS | (1 << 4));   /* walking, direction 0 */
+    put_u16(w, 256);
+    put_u16(w, 256);
+}
+
+void bench_wire_full_aoi(Wire* w, const BenchWorld* world, int frame) {
+    w->len = 0;
+    put_u8(w, BIN_MSG_FULL_AOI);
+    put_u32(w, (uint32_t)frame + 1);
+    put_u32(w, 0);
+    put_u16(w, (uint16_t)(world->bots + world->players + world->objects));
+
+    for (int i = 0; i < world->objects; i++) {
+        static const uint8_t kTypes[] = { BIN_ENTITY_FLOOR, BIN_ENTITY_OBSTACLE,
+                                          BIN_ENTITY_FOREGROUND, BIN_ENTITY_STATIC };
+        put_u8(w, kTypes[i % 4]);
+        put_id(w, "obj", i);
+        put_f32(w, (float)(i % BENCH_GRID));
+        put_f32(w, (float)((i / BENCH_GRID) % BENCH_GRID));
+        put_f32(w, 1.0f);
+        put_f32(w, 1.0f);
+        put_u8(w, 0);
+        put_u8(w, 0);
+        put_layers(w, "floor-grass");
+    }
+    static const PlayerState kPlayer = {
+        .base = { .life = 100.0f, .max_life = 100.0f, .object_layer_count = 1,
+                  .object_layers = { { .item_id = "anon", .quantity = 1 } } },
+    };
+    static const BotState kBot = {
+        .base = { .life = 50.0f, .max_life = 50.0f, .object_layer_count = 1,
+                  .object_layers = { { .item_id = "purple", .quantity = 1 } } },
+    };
+    const uint8_t flags = BIN_FLAG_QUANTIZED | BIN_FLAG_HAS_LIFE;
+    for (int i = 0; i < world->players; i++) {
+        put_u8(w, BIN_ENTITY_PLAYER | flags);
+        put_id(w, "player", i);
+        put_kinematics(w, orbit(i, world->players, frame));
+        put_player_tail(w, flags, &kPlayer);
+    }
+    for (int i = 0; i < world->bots; i++) {
+        put_u8(w, BIN_ENTITY_BOT | flags);
+        put_id(w, "bot", i);
+        put_kinematics(w, orbit(i, world->bots, frame));
+        put_bot_tail(w, flags, &kBot);
+    }
+    put_self(w);
+}
+
+void bench_wire_aoi_delta(Wire* w, const BenchWorld* world, int frame) {
+    w->len = 0;
+    put_u8(w, BIN_MSG_AOI_DELTA);
+    put_u32(w, (uint32_t)frame + 1);
+    put_u32(w, 0);
+    put_u16(w, (uint16_t)(world->bots + world->players));
+    for (int i = 0; i < world->players; i++) {
+        put_u8(w, BIN_ENTITY_PLAYER | BIN_FLAG_QUANTIZED);
+        put_id(w, "player", i);
+        put_u8(w, BIN_DELTA_POS);
+        put_qpos(w, orbit(i, world->players, frame));
+    }
+    for (int i = 0; i < world->bots; i++) {
+        put_u8(w, BIN_ENTITY_BOT | BIN_FLAG_QUANTIZED);
+        put_id(w, "bot", i);
+        put_u8(w, BIN_DELTA_POS);
+        put_qpos(w, orbit(i, world->bots, frame));
+    }
+    put_self(w);
+}
+
+void bench_wire_free(Wire* w) {
+    free(w->data);
+    *w = (Wire){ 0 };
+}
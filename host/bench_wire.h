@@ -0,0 +1,37 @@
+#ifndef CYBERIA_HOST_BENCH_WIRE_H
+#define CYBERIA_HOST_BENCH_WIRE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Synthetic server frames in the binary wire format (binary_aoi_decoder.h),
+ * shared by the host benches. Bots and players circle the self player at
+ * the center of a BENCH_GRID square map; world objects tile it row by row.
+ * Every builder overwrites the frame already in `w`. */
+
+#define BENCH_GRID   128
+#define BENCH_RADIUS 18.0f
+
+typedef struct {
+    uint8_t* data;
+    size_t   len;
+    size_t   cap;
+} Wire;
+
+typedef struct {
+    int bots;
+    int players;
+    int objects;
+} BenchWorld;
+
+void bench_wire_init_data(Wire* w);
+
+/* BIN_MSG_FULL_AOI: every entity of `world` at the positions of `frame`. */
+void bench_wire_full_aoi(Wire* w, const BenchWorld* world, int frame);
+
+/* BIN_MSG_AOI_DELTA: position patches for the bots and players. */
+void bench_wire_aoi_delta(Wire* w, const BenchWorld* world, int frame);
+
+void bench_wire_free(Wire* w);
+
+#endif /* CYBERIA_HOST_BENCH_WIRE_H */
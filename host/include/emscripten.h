@@ -0,0 +1,6 @@
+#ifndef CYBERIA_HOST_EMSCRIPTEN_TOP_H
+#define CYBERIA_HOST_EMSCRIPTEN_TOP_H
+
+#include "emscripten/emscripten.h"
+
+#endif /* CYBERIA_HOST_EMSCRIPTEN_TOP_H */
@@ -0,0 +1,35 @@
+#ifndef CYBERIA_HOST_EMSCRIPTEN_H
+#define CYBERIA_HOST_EMSCRIPTEN_H
+
+/* Host stand-in for <emscripten/emscripten.h>: inline JS compiles away (ints
+ * read 0, pointers NULL) and the runtime calls land in host/platform_null.c. */
+
+#define EMSCRIPTEN_KEEPALIVE
+#define EM_ASM(...)        ((void)0)
+#define EM_ASM_INT(...)    0
+#define EM_ASM_PTR(...)    ((void*)0)
+#define EM_ASM_DOUBLE(...) 0.0
+
+typedef int EM_BOOL;
+#define EM_TRUE  1
+#define EM_FALSE 0
+
+typedef int EMSCRIPTEN_RESULT;
+#define EMSCRIPTEN_RESULT_SUCCESS 0
+
+typedef void (*em_callback_func)(void);
+
+/* Runs `func` until emscripten_cancel_main_loop(); fps is ignored. */
+void   emscripten_set_main_loop(em_callback_func func, int fps, int simulate_infinite_loop);
+void   emscripten_cancel_main_loop(void);
+
+/* Pacing and pause requests have no loop to act on; they are ignored. */
+#define EM_TIMING_RAF 1
+int    emscripten_set_main_loop_timing(int mode, int value);
+void   emscripten_pause_main_loop(void);
+void   emscripten_resume_main_loop(void);
+
+/* Milliseconds on a monotonic clock. */
+double emscripten_get_now(void);
+
+#endif /* CYBERIA_HOST_EMSCRIPTEN_H */
@@ -0,0 +1,36 @@
+#ifndef CYBERIA_HOST_EMSCRIPTEN_HTML5_H
+#define CYBERIA_HOST_EMSCRIPTEN_HTML5_H
+
+#include "emscripten/emscripten.h"
+
+/* Host stand-in for <emscripten/html5.h>: there is no window to resize,
+ * no document to hide and no timer to fire. */
+
+#define EMSCRIPTEN_EVENT_TARGET_WINDOW ((const char*)2)
+
+typedef struct {
+    int windowInnerWidth;
+    int windowInnerHeight;
+} EmscriptenUiEvent;
+
+typedef EM_BOOL (*em_ui_callback_func)(int event_type, const EmscriptenUiEvent* event, void* user_data);
+
+EMSCRIPTEN_RESULT emscripten_set_resize_callback(const char* target, void* user_data,
+                                                 EM_BOOL use_capture, em_ui_callback_func callback);
+
+typedef struct {
+    EM_BOOL hidden;
+    int     visibilityState;
+} EmscriptenVisibilityChangeEvent;
+
+typedef EM_BOOL (*em_visibilitychange_callback_func)(int event_type,
+                                                     const EmscriptenVisibilityChangeEvent* event,
+                                                     void* user_data);
+
+EMSCRIPTEN_RESULT emscripten_set_visibilitychange_callback(void* user_data, EM_BOOL use_capture,
+                                                           em_visibilitychange_callback_func callback);
+
+long emscripten_set_interval(void (*cb)(void* user_data), double interval_ms, void* user_data);
+void emscripten_clear_interval(long id);
+
+#endif /* CYBERIA_HOST_EMSCRIPTEN_HTML5_H */
@@ -0,0 +1,8 @@
+#ifndef CYBERIA_HOST_EMSCRIPTEN_WEBSOCKET_H
+#define CYBERIA_HOST_EMSCRIPTEN_WEBSOCKET_H
+
+/* Host stand-in for <emscripten/websocket.h>: only the handle type that
+ * network/socket.h stores; host/platform_null.c never opens a socket. */
+typedef int EMSCRIPTEN_WEBSOCKET_T;
+
+#endif /* CYBERIA_HOST_EMSCRIPTEN_WEBSOCKET_H */
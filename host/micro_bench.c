@@ -0,0 +1,430 @@
+#include "bench_wire.h"
+
+#include "binary_aoi_decoder.h"
+#include "entity_depth.h"
+#include "frame_arena.h"
+#include "game_state.h"
+#include "hash_table.h"
+#include "network/replication.h"
+#include "ui/text.h"
+
+#include <emscripten/emscripten.h>
+#include <raylib.h>
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Microbenchmarks for the client's hot primitives:
+ *
+ *   hash_table.*    put / grow / get / miss / remove+put churn over "<uuid>_<item>"
+ *                   keys, the shape of the object-layer and atlas caches
+ *   aoi.*           binary_aoi_process on synthetic full and delta snapshots
+ *   depth.*         entity_depth_compare under qsort, the key radix sort
+ *                   and the per-frame insertion-sort repair
+ *   text.*          text_measure_compat / text_wrap over dialogue strings
+ *
+ * Each case calibrates an iteration count that runs for --min-ms, then takes
+ * --samples timed runs of it and reports the median and fastest ns per
+ * operation. --json prints one JSON object per case instead of the table so
+ * a CI job can append results per commit and diff them.
+ *
+ *   micro_bench [--filter SUBSTR] [--min-ms N] [--samples N] [--json]
+ */
+
+#define MICRO_SCREEN_W 1280
+#define MICRO_SCREEN_H 720
+#define MICRO_MAX_SAMPLES 31
+
+typedef struct {
+    const char* filter;
+    double      min_ms;
+    int         samples;
+    bool        json;
+} MicroConfig;
+
+static MicroConfig g_cfg = { .min_ms = 50.0, .samples = 7 };
+
+/* Results land here so the optimizer cannot drop the measured work. */
+static volatile uintptr_t g_sink;
+
+/* Runs the measured operation `iters` times. */
+typedef void (*MicroFn)(void* ctx, int iters);
+
+static double time_ms(MicroFn fn, void* ctx, int iters) {
+    double t0 = emscripten_get_now();
+    fn(ctx, iters);
+    return emscripten_get_now() - t0;
+}
+
+static int compare_doubles(const void* a, const void* b) {
+    double da = *(const double*)a, db = *(const double*)b;
+    return (da > db) - (da < db);
+}
+
+/* One case: `ops` operations per iteration, `n` its size parameter. */
+static void run_case(const char* name, int n, int ops, MicroFn fn, void* ctx) {
+    if (g_cfg.filter && !strstr(name, g_cfg.filter)) return;
+
+    int iters = 1;
+    while (time_ms(fn, ctx, iters) < g_cfg.min_ms && iters < (1 << 24)) iters *= 2;
+
+    double ns[MICRO_MAX_SAMPLES];
+    for (int s = 0; s < g_cfg.samples; s++) {
+        ns[s] = time_ms(fn, ctx, iters) * 1.0e6 / ((double)iters * (double)ops);
+    }
+    qsort(ns, (size_t)g_cfg.samples, sizeof(double), compare_doubles);
+    double median = ns[g_cfg.samples / 2], best = ns[0];
+
+    if (g_cfg.json) {
+        printf("{\"case\":\"%s\",\"n\":%d,\"ns_per_op\":%.2f,\"min_ns_per_op\":%.2f,"
+               "\"iters\":%d,\"ops_per_iter\":%d,\"samples\":%d}\n",
+               name, n, median, best, iters, ops, g_cfg.samples);
+    } else {
+        printf("%-24s n=%-6d %12.1f ns/op  (min %10.1f)  %8d x %d\n",
+               name, n, median, best, iters, ops);
+    }
+    fflush(stdout);
+}
+
+/* Deterministic xorshift: every run benches the same data. */
+static uint32_t g_rng = 0x9e3779b9u;
+
+static uint32_t rng(void) {
+    g_rng ^= g_rng << 13;
+    g_rng ^= g_rng >> 17;
+    g_rng ^= g_rng << 5;
+    return g_rng;
+}
+
+/* ── hash_table ──────────────────────────────────────────────────────── */
+
+static const char* const kItemIds[] = {
+    "anon", "purple", "hatchet", "sword-basic", "floor-grass", "floor-water", "tree-oak",
+    "rock-small", "coin", "potion-red", "helmet-iron", "boots-leather", "ghost", "eiri",
+    "wason", "kishins", "scp-2040", "lain", "atlas-default", "skin-blue",
+};
+
+typedef struct {
+    HashTable table;
+    char**    keys;
+    char**    misses;
+    int       n;
+    int       cursor;
+} HashCtx;
+
+/* "<uuid v4>_<item id>", as the object-layer caches key their entries. */
+static char* make_key(void) {
+    char* key = malloc(96);
+    assert(key);
+    uint32_t a = rng(), b = rng(), c = rng(), d = rng();
+    snprintf(key, 96, "%08x-%04x-4%03x-%04x-%04x%08x_%s", a, b >> 16, b & 0xfff,
+             0x8000 | (c & 0x3fff), c >> 16, d,
+             kItemIds[rng() % (sizeof(kItemIds) / sizeof(kItemIds[0]))]);
+    return key;
+}
+
+static void hash_ctx_init(HashCtx* h, int n) {
+    *h = (HashCtx){ .n = n };
+    h->keys   = malloc((size_t)n * sizeof(char*));
+    h->misses = malloc((size_t)n * sizeof(char*));
+    assert(h->keys && h->misses);
+    for (int i = 0; i < n; i++) {
+        h->keys[i]   = make_key();
+        h->misses[i] = make_key();
+    }
+    hash_table_init(&h->table, (size_t)n * 2, NULL, "micro_bench");
+    for (int i = 0; i < n; i++) hash_table_put(&h->table, h->keys[i], h->keys[i]);
+}
+
+static void hash_ctx_free(HashCtx* h) {
+    hash_table_destroy(&h->table);
+    for (int i = 0; i < h->n; i++) {
+        free(h->keys[i]);
+        free(h->misses[i]);
+    }
+    free(h->keys);
+    free(h->misses);
+}
+
+/* Fill an empty table sized for n, so growth stays out of the loop (the
+ * count is PROF_COUNT_HASH_RESIZES in-game). */
+static void bench_hash_put(void* ctx, int iters) {
+    HashCtx* h = ctx;
+    for (int it = 0; it < iters; it++) {
+        HashTable t;
+        hash_table_init(&t, (size_t)h->n * 2, NULL, "micro_bench");
+        for (int i = 0; i < h->n; i++) hash_table_put(&t, h->keys[i], h->keys[i]);
+        g_sink += t.count;
+        hash_table_destroy(&t);
+    }
+}
+
+/* Fill from the minimum capacity, growing on the way; against .put this
+ * is what the incremental moves cost. */
+static void bench_hash_grow(void* ctx, int iters) {
+    HashCtx* h = ctx;
+    for (int it = 0; it < iters; it++) {
+        HashTable t;
+        hash_table_init(&t, 1, NULL, "micro_bench");
+        for (int i = 0; i < h->n; i++) hash_table_put(&t, h->keys[i], h->keys[i]);
+        g_sink += t.count;
+        hash_table_destroy(&t);
+    }
+}
+
+/* Hits in a scattered order (stride coprime to n). */
+static void bench_hash_get(void* ctx, int iters) {
+    HashCtx* h = ctx;
+    uintptr_t acc = 0;
+    for (int it = 0; it < iters; it++) {
+        for (int i = 0, k = 0; i < h->n; i++, k = (k + 7919) % h->n) {
+            acc += (uintptr_t)hash_table_get(&h->table, h->keys[k]);
+        }
+    }
+    g_sink += acc;
+}
+
+static void bench_hash_miss(void* ctx, int iters) {
+    HashCtx* h = ctx;
+    uintptr_t acc = 0;
+    for (int it = 0; it < iters; it++) {
+        for (int i = 0; i < h->n; i++) acc += (uintptr_t)hash_table_get(&h->table, h->misses[i]);
+    }
+    g_sink += acc;
+}
+
+/* Entity churn: one key leaves, another arrives, table size steady. */
+static void bench_hash_churn(void* ctx, int iters) {
+    HashCtx* h = ctx;
+    for (int it = 0; it < iters; it++) {
+        int i = h->cursor;
+        h->cursor = (h->cursor + 1) % h->n;
+        hash_table_remove(&h->table, h->keys[i]);
+        hash_table_put(&h->table, h->misses[i], h->misses[i]);
+        char* swap = h->keys[i];
+        h->keys[i]   = h->misses[i];
+        h->misses[i] = swap;
+    }
+    g_sink += h->table.count;
+}
+
+static void run_hash_table(void) {
+    static const int kSizes[] = { 256, 4096, 32768 };
+    for (size_t s = 0; s < sizeof(kSizes) / sizeof(kSizes[0]); s++) {
+        HashCtx h;
+        hash_ctx_init(&h, kSizes[s]);
+        run_case("hash_table.put",   h.n, h.n, bench_hash_put, &h);
+        run_case("hash_table.grow",  h.n, h.n, bench_hash_grow, &h);
+        run_case("hash_table.get",   h.n, h.n, bench_hash_get, &h);
+        run_case("hash_table.miss",  h.n, h.n, bench_hash_miss, &h);
+        run_case("hash_table.churn", h.n, 1,   bench_hash_churn, &h);
+        hash_ctx_free(&h);
+    }
+}
+
+/* ── binary_aoi_process ──────────────────────────────────────────────── */
+
+typedef struct {
+    Wire full;
+    Wire delta;
+} AoiCtx;
+
+static void bench_aoi_full(void* ctx, int iters) {
+    AoiCtx* a = ctx;
+    int rc = 0;
+    for (int it = 0; it < iters; it++) rc |= binary_aoi_process(a->full.data, a->full.len);
+    g_sink += (uintptr_t)(g_game_state.bot_count + rc);
+}
+
+static void bench_aoi_delta(void* ctx, int iters) {
+    AoiCtx* a = ctx;
+    int rc = 0;
+    for (int it = 0; it < iters; it++) rc |= binary_aoi_process(a->delta.data, a->delta.len);
+    g_sink += (uintptr_t)(g_game_state.bot_count + rc);
+}
+
+static void run_aoi(void) {
+    Wire init = { 0 };
+    bench_wire_init_data(&init);
+    if (0 != binary_aoi_process(init.data, init.len)) {
+        fprintf(stderr, "init_data rejected\n");
+        exit(1);
+    }
+    bench_wire_free(&init);
+
+    static const int kEntities[] = { 100, 500, 1000 };
+    for (size_t s = 0; s < sizeof(kEntities) / sizeof(kEntities[0]); s++) {
+        int n = kEntities[s];
+        const BenchWorld world = { .players = n / 5, .bots = n - n / 5 };
+        AoiCtx a = { 0 };
+        bench_wire_full_aoi(&a.full, &world, 0);
+        bench_wire_aoi_delta(&a.delta, &world, 1);
+        if (0 != binary_aoi_process(a.full.data, a.full.len)) {
+            fprintf(stderr, "%d-entity snapshot rejected\n", n);
+            exit(1);
+        }
+        run_case("aoi.full", n, 1, bench_aoi_full, &a);
+        /* The delta patches the entities the full frame left in state. */
+        run_case("aoi.delta", n, 1, bench_aoi_delta, &a);
+        bench_wire_free(&a.full);
+        bench_wire_free(&a.delta);
+    }
+}
+
+/* ── depth sort ──────────────────────────────────────────────────────── */
+
+typedef struct {
+    EntitySortEntry* source;   /* shuffled, or sorted then jittered */
+    EntitySortEntry* work;
+    int              n;
+} DepthCtx;
+
+static void depth_ctx_init(DepthCtx* d, int n) {
+    *d = (DepthCtx){ .n = n };
+    d->source = malloc((size_t)n * sizeof(EntitySortEntry));
+    d->work   = malloc((size_t)n * sizeof(EntitySortEntry));
+    assert(d->source && d->work);
+    for (int i = 0; i < n; i++) {
+        /* Coarse rows so many entries tie on depth, as tiles and crowds do. */
+        d->source[i] = (EntitySortEntry){
+            .type        = (EntitySortType)(rng() % (ENTITY_TYPE_RESOURCE + 1)),
+            .bottom_y    = (float)(rng() % 256) * 0.5f,
+            .sort_handle = rng() % 65536,
+            .slot        = i,
+        };
+        d->source[i].key = entity_depth_key(d->source[i].bottom_y, d->source[i].sort_handle);
+    }
+}
+
+static void bench_depth_qsort(void* ctx, int iters) {
+    DepthCtx* d = ctx;
+    for (int it = 0; it < iters; it++) {
+        memcpy(d->work, d->source, (size_t)d->n * sizeof(EntitySortEntry));
+        qsort(d->work, (size_t)d->n, sizeof(EntitySortEntry), entity_depth_compare);
+    }
+    g_sink += (uintptr_t)d->work[0].slot;
+}
+
+/* A coherent frame: last frame's order with ~2% of the actors moved a row. */
+static void jitter_sorted(DepthCtx* d) {
+    qsort(d->source, (size_t)d->n, sizeof(EntitySortEntry), entity_depth_compare);
+    for (int k = 0; k < d->n / 50 + 1; k++) {
+        EntitySortEntry* e = &d->source[rng() % (uint32_t)d->n];
+        entity_depth_set_bottom(e, e->bottom_y + ((rng() & 1) ? 0.5f : -0.5f));
+    }
+}
+
+static void bench_depth_radix(void* ctx, int iters) {
+    DepthCtx* d = ctx;
+    for (int it = 0; it < iters; it++) {
+        memcpy(d->work, d->source, (size_t)d->n * sizeof(EntitySortEntry));
+        entity_depth_radix_sort(d->work, d->n);
+        frame_arena_reset();
+    }
+    g_sink += (uintptr_t)d->work[0].slot;
+}
+
+static void bench_depth_repair(void* ctx, int iters) {
+    DepthCtx* d = ctx;
+    for (int it = 0; it < iters; it++) {
+        memcpy(d->work, d->source, (size_t)d->n * sizeof(EntitySortEntry));
+        entity_depth_insertion_sort(d->work, d->n);
+    }
+    g_sink += (uintptr_t)d->work[0].slot;
+}
+
+static void run_depth(void) {
+    static const int kSizes[] = { 500, 2000, 8000 };
+    for (size_t s = 0; s < sizeof(kSizes) / sizeof(kSizes[0]); s++) {
+        DepthCtx d;
+        depth_ctx_init(&d, kSizes[s]);
+        run_case("depth.qsort", d.n, d.n, bench_depth_qsort, &d);
+        run_case("depth.radix", d.n, d.n, bench_depth_radix, &d);
+        jitter_sorted(&d);
+        run_case("depth.repair", d.n, d.n, bench_depth_repair, &d);
+        free(d.source);
+        free(d.work);
+    }
+}
+
+/* ── text layout ─────────────────────────────────────────────────────── */
+
+static const char kDialogueShort[] =
+    "The gate keeper looks you over. \"Papers, traveler. Nobody walks into the "
+    "lower city without a stamp from the archive.\"";
+
+static const char kDialogueLong[] =
+    "You found the old transmitter under the market, buried beneath a decade of "
+    "rusted signage and vending machines nobody remembers stocking. When the "
+    "power comes back the screen flickers through a thousand dead channels "
+    "before settling on one that still answers. A voice, patient and tired, "
+    "asks for your name, then for the names of everyone who came down the "
+    "stairs with you, then for the one thing you would trade to see the surface "
+    "again. It waits. Behind you the market lights hum; somewhere a drone is "
+    "still counting the coins it was never told to stop collecting.";
+
+typedef struct {
+    const char* text;
+    int         maxw;
+} TextCtx;
+
+static void bench_text_measure(void* ctx, int iters) {
+    const TextCtx* t = ctx;
+    int acc = 0;
+    for (int it = 0; it < iters; it++) acc += text_measure_compat(t->text, 16);
+    g_sink += (uintptr_t)acc;
+}
+
+static void bench_text_wrap(void* ctx, int iters) {
+    const TextCtx* t = ctx;
+    int acc = 0;
+    for (int it = 0; it < iters; it++) acc += text_wrap(t->text, 0, 0, t->maxw, 16, WHITE, false, false);
+    g_sink += (uintptr_t)acc;
+}
+
+static void run_text(void) {
+    const TextCtx cases[] = {
+        { .text = kDialogueShort, .maxw = 320 },
+        { .text = kDialogueLong,  .maxw = 320 },
+    };
+    for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+        int len = (int)strlen(cases[c].text);
+        run_case("text.measure", len, 1, bench_text_measure, (void*)&cases[c]);
+        run_case("text.wrap",    len, 1, bench_text_wrap,    (void*)&cases[c]);
+    }
+}
+
+int main(int argc, char** argv) {
+    for (int i = 1; i < argc; i++) {
+        bool has_value = i + 1 < argc;
+        if      (0 == strcmp(argv[i], "--json"))                  g_cfg.json    = true;
+        else if (0 == strcmp(argv[i], "--filter") && has_value)   g_cfg.filter  = argv[++i];
+        else if (0 == strcmp(argv[i], "--min-ms") && has_value)   g_cfg.min_ms  = atof(argv[++i]);
+        else if (0 == strcmp(argv[i], "--samples") && has_value)  g_cfg.samples = atoi(argv[++i]);
+        else {
+            fprintf(stderr, "usage: %s [--filter SUBSTR] [--min-ms N] [--samples N] [--json]\n",
+                    argv[0]);
+            return 2;
+        }
+    }
+    if (g_cfg.samples < 1)                 g_cfg.samples = 1;
+    if (g_cfg.samples > MICRO_MAX_SAMPLES) g_cfg.samples = MICRO_MAX_SAMPLES;
+
+    SetTraceLogLevel(LOG_WARNING);
+    InitWindow(MICRO_SCREEN_W, MICRO_SCREEN_H, "micro_bench");
+    prediction_init();
+    text_font_init();
+
+    run_hash_table();
+    run_aoi();
+    run_depth();
+    run_text();
+
+    CloseWindow();
+    return 0;
+}
@@ -0,0 +1,280 @@
+#include <emscripten/emscripten.h>
+#include <emscripten/html5.h>
+
+#include "platform_null.h"
+
+#include "js/interact_bridge.h"
+#include "network/engine_client.h"
+#include "network/socket.h"
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/*
+ * Null platform for host builds: what the web build gets from the
+ * emscripten runtime, the browser WebSocket, emscripten_fetch and the
+ * --js-library overlay. Nothing connects and nothing downloads; a bench
+ * feeds server frames straight into the decoders instead.
+ */
+
+/* ── emscripten runtime ──────────────────────────────────────────────── */
+
+static bool s_loop_cancelled = false;
+
+double emscripten_get_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1000.0 + (double)ts.tv_nsec / 1.0e6;
+}
+
+void emscripten_set_main_loop(em_callback_func func, int fps, int simulate_infinite_loop) {
+    assert(func);
+    s_loop_cancelled = false;
+    while (!s_loop_cancelled) func();
+}
+
+void emscripten_cancel_main_loop(void) {
+    s_loop_cancelled = true;
+}
+
+EMSCRIPTEN_RESULT emscripten_set_resize_callback(const char* target, void* user_data,
+                                                 EM_BOOL use_capture, em_ui_callback_func callback) {
+    return EMSCRIPTEN_RESULT_SUCCESS;
+}
+
+int emscripten_set_main_loop_timing(int mode, int value) { return 0; }
+
+void emscripten_pause_main_loop(void) {}
+
+void emscripten_resume_main_loop(void) {}
+
+EMSCRIPTEN_RESULT emscripten_set_visibilitychange_callback(void* user_data, EM_BOOL use_capture,
+                                                           em_visibilitychange_callback_func callback) {
+    return EMSCRIPTEN_RESULT_SUCCESS;
+}
+
+long emscripten_set_interval(void (*cb)(void* user_data), double interval_ms, void* user_data) { return 0; }
+
+void emscripten_clear_interval(long id) {}
+
+/* ── network/socket.h: never connected ───────────────────────────────── */
+
+bool ws_open(WebSocketClient* ws_client, const char* url, void* user_ctx, WebSocketHandlers handlers) {
+    assert(ws_client);
+    *ws_client = (WebSocketClient){ .connected = false, .callbacks = handlers, .user_ctx = user_ctx };
+    return false;
+}
+
+void ws_close(WebSocketClient* ws_client) {
+    assert(ws_client);
+    ws_client->connected = false;
+}
+
+bool ws_is_open(const WebSocketClient* ws_client) {
+    assert(ws_client);
+    return ws_client->connected;
+}
+
+bool ws_send_str(const WebSocketClient* ws_client, const char* data) { return false; }
+
+bool ws_send_binary(const WebSocketClient* ws_client, const void* data, size_t len) { return false; }
+
+size_t ws_buffered_amount(const WebSocketClient* ws_client) { return 0; }
+
+/* ── network/engine_client.h: an engine that answers 404 ─────────────── */
+
+/* Requests complete on the next fetch_batch_pump(), never inside the call
+ * that started them, as a real round trip would. Unless a replay provided
+ * a body (host_fetch_deliver) they fail, or wait while unanswered requests
+ * are held. */
+typedef struct {
+    char*            asset_id;
+    FetchClass       cls;
+    FetchCompletedCb on_completed;
+} NullFetch;
+
+typedef struct {
+    char*  asset_id;
+    void*  data;
+    size_t size;
+} NullBody;
+
+struct FetchBatch {
+    FetchBatchConfig cfg;
+};
+
+static struct {
+    NullFetch*      pending;
+    int             count;
+    int             capacity;
+    int             started;
+    bool            hold;
+    NullBody*       bodies;
+    int             body_count;
+    int             body_capacity;
+    FetchBatch**    batches;
+    int             batch_count;
+    FetchClassStats stats[FETCH_CLASS_COUNT];
+    char            last_completed[128];
+} g_null_fetch;
+
+static void* grow(void* array, int* capacity, int count, size_t elem_size) {
+    if (count < *capacity) return array;
+    *capacity = *capacity ? *capacity * 2 : 64;
+    array = realloc(array, (size_t)*capacity * elem_size);
+    assert(array);
+    return array;
+}
+
+static const NullBody* find_body(const char* asset_id) {
+    for (int i = 0; i < g_null_fetch.body_count; i++) {
+        if (0 == strcmp(g_null_fetch.bodies[i].asset_id, asset_id)) return &g_null_fetch.bodies[i];
+    }
+    return NULL;
+}
+
+static void complete(const NullFetch* req, const NullBody* body) {
+    FetchResponse response = {
+        .asset_id = req->asset_id,
+        .success  = NULL != body,
+        .data     = body ? body->data : NULL,
+        .size     = body ? body->size : 0,
+    };
+    if (body) g_null_fetch.stats[req->cls].completed++;
+    else      g_null_fetch.stats[req->cls].failed++;
+    strncpy(g_null_fetch.last_completed, req->asset_id, sizeof(g_null_fetch.last_completed) - 1);
+    req->on_completed(&response);
+}
+
+void fetch_request_start(const char* asset_id, const char* url, FetchClass cls,
+                         FetchCompletedCb on_completed) {
+    assert(asset_id && on_completed);
+    assert(0 <= cls && FETCH_CLASS_COUNT > cls);
+    g_null_fetch.pending = grow(g_null_fetch.pending, &g_null_fetch.capacity, g_null_fetch.count,
+                                sizeof(NullFetch));
+    char* id = strdup(asset_id);
+    assert(id);
+    g_null_fetch.pending[g_null_fetch.count++] = (NullFetch){
+        .asset_id = id, .cls = cls, .on_completed = on_completed,
+    };
+    g_null_fetch.started++;
+}
+
+void fetch_request_start_persistent(const char* asset_id, const char* url, const char* version,
+                                    FetchClass cls, FetchCompletedCb on_completed) {
+    fetch_request_start(asset_id, url, cls, on_completed);
+}
+
+void fetch_persist_store(const char* url, const char* version, const void* data, size_t size) {}
+
+bool fetch_cancel(const char* asset_id) { return false; }
+
+bool fetch_reprioritize(const char* asset_id, FetchClass cls) { return false; }
+
+FetchClassStats fetch_class_stats(FetchClass cls) {
+    assert(0 <= cls && FETCH_CLASS_COUNT > cls);
+    return g_null_fetch.stats[cls];
+}
+
+FetchBatch* fetch_batch_create(const FetchBatchConfig* cfg) {
+    assert(cfg);
+    FetchBatch* batch = malloc(sizeof(FetchBatch));
+    assert(batch);
+    *batch = (FetchBatch){ .cfg = *cfg };
+    g_null_fetch.batches = realloc(g_null_fetch.batches,
+                                   (size_t)(g_null_fetch.batch_count + 1) * sizeof(FetchBatch*));
+    assert(g_null_fetch.batches);
+    g_null_fetch.batches[g_null_fetch.batch_count++] = batch;
+    return batch;
+}
+
+void fetch_batch_request(FetchBatch* batch, const char* key, const char* version) {
+    assert(batch && key);
+    fetch_request_start(key, batch->cfg.single_url, batch->cfg.fetch_class, batch->cfg.on_item);
+}
+
+/* Take the pending requests `keep` rejects out of the queue into `out`;
+ * callbacks may start new requests, so they run only after this. */
+static int take_pending(NullFetch** out, bool (*keep)(const NullFetch*, const void*), const void* arg) {
+    int n = 0, kept = 0;
+    *out = malloc((size_t)(g_null_fetch.count ? g_null_fetch.count : 1) * sizeof(NullFetch));
+    assert(*out);
+    for (int i = 0; i < g_null_fetch.count; i++) {
+        if (keep(&g_null_fetch.pending[i], arg)) g_null_fetch.pending[kept++] = g_null_fetch.pending[i];
+        else                                     (*out)[n++] = g_null_fetch.pending[i];
+    }
+    g_null_fetch.count = kept;
+    return n;
+}
+
+static bool keep_unanswered(const NullFetch* req, const void* arg) {
+    return g_null_fetch.hold && !find_body(req->asset_id);
+}
+
+static bool keep_other_ids(const NullFetch* req, const void* asset_id) {
+    return 0 != strcmp(req->asset_id, asset_id);
+}
+
+static void complete_all(NullFetch* due, int n) {
+    for (int i = 0; i < n; i++) {
+        complete(&due[i], find_body(due[i].asset_id));
+        free(due[i].asset_id);
+    }
+    free(due);
+}
+
+void fetch_batch_pump(void) {
+    NullFetch* due;
+    int n = take_pending(&due, keep_unanswered, NULL);
+    complete_all(due, n);
+}
+
+int fetch_pending_count(void) { return g_null_fetch.count; }
+
+int fetch_total_started(void) { return g_null_fetch.started; }
+
+const char* fetch_last_completed_id(void) { return g_null_fetch.last_completed; }
+
+/* ── host/platform_null.h ────────────────────────────────────────────── */
+
+void host_fetch_hold_unanswered(bool hold) { g_null_fetch.hold = hold; }
+
+void host_fetch_deliver(const char* asset_id, const void* data, size_t size) {
+    assert(asset_id && (data || 0 == size));
+    if (!find_body(asset_id)) {
+        g_null_fetch.bodies = grow(g_null_fetch.bodies, &g_null_fetch.body_capacity,
+                                   g_null_fetch.body_count, sizeof(NullBody));
+        NullBody body = { .asset_id = strdup(asset_id), .data = malloc(size ? size : 1), .size = size };
+        assert(body.asset_id && body.data);
+        if (size) memcpy(body.data, data, size);
+        g_null_fetch.bodies[g_null_fetch.body_count++] = body;
+    }
+    NullFetch* due;
+    int n = take_pending(&due, keep_other_ids, asset_id);
+    complete_all(due, n);
+}
+
+void host_fetch_deliver_bulk(const char* batch_name, const void* data, size_t size) {
+    assert(batch_name && data);
+    for (int i = 0; i < g_null_fetch.batch_count; i++) {
+        FetchBatch* b = g_null_fetch.batches[i];
+        if (0 != strcmp(b->cfg.name, batch_name)) continue;
+        FetchResponse response = { .asset_id = b->cfg.name, .success = true, .data = data, .size = size };
+        b->cfg.on_bulk(&response);
+        return;
+    }
+}
+
+/* ── js/interact_overlay.js ──────────────────────────────────────────── */
+
+void js_interact_overlay_close(void) {}
+
+int js_interact_overlay_is_open(void) { return 0; }
+
+void js_overlay_commands_drain(const uint8_t* buf, int len) {}
+
+void js_init_engine_api(const char* api_base_url) {}
@@ -0,0 +1,21 @@
+#ifndef CYBERIA_HOST_PLATFORM_NULL_H
+#define CYBERIA_HOST_PLATFORM_NULL_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/* Bench-side controls of the null engine client (host/platform_null.c). */
+
+/* Hold requests that have no answer yet instead of failing them on the
+ * next pump, so a replay can answer them when the recorded body arrives. */
+void host_fetch_hold_unanswered(bool hold);
+
+/* A recorded response body: completes every pending request for
+ * `asset_id`; with none pending it is kept for the next request of it. */
+void host_fetch_deliver(const char* asset_id, const void* data, size_t size);
+
+/* A recorded bulk response: handed to the on_bulk of the batch named
+ * `batch_name`, if one exists. */
+void host_fetch_deliver_bulk(const char* batch_name, const void* data, size_t size);
+
+#endif /* CYBERIA_HOST_PLATFORM_NULL_H */
@@ -0,0 +1,275 @@
+#include "ws_native.h"
+
+#include "binary_aoi_decoder.h"
+#include "game_state.h"
+#include "serial.h"
+#include "network/game_client.h"
+#include "network/net_telemetry.h"
+#include "network/replication.h"
+
+#include <emscripten/emscripten.h>
+#include <raylib.h>
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+/*
+ * Load-test swarm: N protocol-accurate clients against a live server.
+ *
+ * Each client runs in its own forked process, so it owns a whole copy of
+ * the client core's state (g_game_state, prediction, session, decoder
+ * caches) without sharing anything with its siblings. A client connects
+ * over host/ws_native.c, sends uplink_handshake, and decodes every downlink
+ * frame through game_client_inject_message — decompression, binary_aoi_process
+ * and the session/ack bookkeeping included — exactly as the browser does.
+ * Once INIT_DATA has arrived it taps a random cell at --tap-hz with
+ * uplink_player_action, stamped with session_server_tick_estimate() and
+ * session_next_input_sequence(), so the server's ack path is exercised.
+ *
+ *   swarm --url ws://HOST:PORT/ws [--clients N] [--seconds S] [--tap-hz H]
+ *         [--stagger-ms MS] [--json]
+ *
+ * Prints one line per client — messages and bytes per second, snapshots,
+ * decode cost per snapshot, taps sent and acked, entities in its AOI — and
+ * a total. ws:// only; there is no TLS on the host build.
+ *
+ * Not part of Host.mk's default targets:
+ *
+ *   make -f Host.mk BUILD_MODE=RELEASE
+ *   gcc -O2 -g -std=gnu11 -Isrc -Ihost/include -Ilibs/raylib/src -Ilibs/cJSON \
+ *       -DCYBERIA_LOG_LEVEL=1 host/swarm.c host/ws_native.c host/platform_null.c \
+ *       $(ls src/*.c src/{js,network,ui,input,domain,util}/*.c 2>/dev/null \
+ *         | grep -v -e src/main.c -e network/socket.c -e network/engine_client.c) \
+ *       libs/cJSON/cJSON.c build/host/RELEASE/libraylib.a -lm -lpthread -ldl \
+ *       -o bin/host/swarm
+ */
+
+#define SWARM_MAX_CLIENTS 1024
+#define SWARM_WIRE_CAPS (WIRE_CAP_QUANTIZED_POS | WIRE_CAP_BINARY_INIT | WIRE_CAP_EVENT_BATCH | \
+                         WIRE_CAP_LZ4 | WIRE_CAP_ITEM_DICT)
+
+typedef struct {
+    const char* url;
+    int         clients;
+    double      seconds;
+    double      tap_hz;
+    int         stagger_ms;
+    bool        json;
+} SwarmConfig;
+
+/* What a client process reports back over its pipe. */
+typedef struct {
+    int      client;
+    bool     connected;
+    bool     dropped;          /* the server closed before --seconds */
+    bool     init;             /* INIT_DATA arrived */
+    double   seconds;
+    uint32_t messages;
+    uint64_t bytes;
+    uint32_t snapshots;
+    double   snapshot_decode_us;
+    float    max_decode_us;
+    uint32_t taps;
+    uint32_t acked;            /* last sequence the server acked */
+    int      players, bots, world_objects;
+} SwarmClientStats;
+
+static int arg_int(int argc, char** argv, int* i) {
+    if (*i + 1 >= argc) {
+        fprintf(stderr, "%s needs a value\n", argv[*i]);
+        exit(2);
+    }
+    return atoi(argv[++*i]);
+}
+
+static void send_tap(WsNative* ws, SwarmClientStats* st) {
+    const GameState* gs = &g_game_state;
+    if (0 >= gs->grid_w || 0 >= gs->grid_h) return;
+    BinWriter w;
+    uplink_player_action(&w, (float)(rand() % gs->grid_w), (float)(rand() % gs->grid_h),
+                         (uint32_t)session_server_tick_estimate(),
+                         (uint32_t)session_next_input_sequence());
+    if (ws_native_send(ws, w.buf, w.pos, false)) st->taps++;
+}
+
+/* Snapshot decode totals from the client's own telemetry. */
+static void collect_snapshot_cost(SwarmClientStats* st) {
+    const int kinds[] = { BIN_MSG_AOI_UPDATE, BIN_MSG_FULL_AOI, BIN_MSG_AOI_DELTA };
+    for (size_t k = 0; k < sizeof(kinds) / sizeof(kinds[0]); k++) {
+        const NetMsgStats* m = net_telemetry_binary(kinds[k]);
+        st->snapshot_decode_us += m->decode_us;
+        if (st->max_decode_us < m->max_decode_us) st->max_decode_us = m->max_decode_us;
+    }
+    const NetSnapshotStats* snap = net_telemetry_snapshots();
+    st->snapshots     = snap->snapshots;
+    st->players       = snap->players;
+    st->bots          = snap->bots;
+    st->world_objects = snap->world_objects;
+}
+
+static SwarmClientStats run_client(const SwarmConfig* cfg, int index) {
+    SwarmClientStats st = { .client = index };
+    srand((unsigned)getpid() ^ (unsigned)index * 2654435761u);
+    SetTraceLogLevel(LOG_NONE);
+    InitWindow(16, 16, "swarm");
+    prediction_init();
+
+    WsNative ws;
+    if (!ws_native_connect(&ws, cfg->url)) return st;
+    st.connected = true;
+    BinWriter w;
+    uplink_handshake(&w, "cyberia-swarm", "1.0.0", SWARM_WIRE_CAPS, 0);
+    ws_native_send(&ws, w.buf, w.pos, false);
+
+    const double start    = GetTime();
+    const double tap_step = 0.0 < cfg->tap_hz ? 1.0 / cfg->tap_hz : 0.0;
+    double next_tap = start + tap_step * (double)rand() / RAND_MAX;
+    for (double now = start; now - start < cfg->seconds; now = GetTime()) {
+        double until = 0.0 < tap_step ? next_tap : start + cfg->seconds;
+        int wait_ms = (int)((until - now) * 1000.0);
+        wait_ms = wait_ms < 0 ? 0 : (wait_ms > 100 ? 100 : wait_ms);
+
+        const uint8_t* data;
+        size_t len;
+        bool is_text;
+        int rc = ws_native_poll(&ws, wait_ms, &data, &len, &is_text);
+        if (0 > rc) {
+            st.dropped = true;
+            break;
+        }
+        if (0 < rc && 0 < len) {
+            st.messages++;
+            st.bytes += len;
+            game_client_inject_message(data, (uint32_t)len, is_text);
+        }
+
+        now = GetTime();
+        if (0.0 < tap_step && g_game_state.init_received && now >= next_tap) {
+            send_tap(&ws, &st);
+            next_tap += tap_step;
+            if (next_tap < now) next_tap = now + tap_step;
+        }
+    }
+    ws_native_close(&ws);
+
+    st.seconds = GetTime() - start;
+    st.init    = g_game_state.init_received;
+    st.acked   = (uint32_t)session_last_acked_input_sequence();
+    collect_snapshot_cost(&st);
+    return st;
+}
+
+static void print_client(const SwarmConfig* cfg, const SwarmClientStats* st) {
+    double secs = 0.0 < st->seconds ? st->seconds : 1.0;
+    double per_snap = st->snapshots ? st->snapshot_decode_us / st->snapshots : 0.0;
+    if (cfg->json) {
+        printf("{\"client\":%d,\"connected\":%s,\"dropped\":%s,\"init\":%s,\"seconds\":%.2f,"
+               "\"msgPerS\":%.1f,\"kbPerS\":%.1f,\"snapshots\":%u,\"decodeUsPerSnapshot\":%.1f,"
+               "\"maxDecodeUs\":%.1f,\"taps\":%u,\"acked\":%u,\"players\":%d,\"bots\":%d,"
+               "\"objects\":%d}\n",
+               st->client, st->connected ? "true" : "false", st->dropped ? "true" : "false",
+               st->init ? "true" : "false", st->seconds, st->messages / secs,
+               (double)st->bytes / 1024.0 / secs, st->snapshots, per_snap, st->max_decode_us,
+               st->taps, st->acked, st->players, st->bots, st->world_objects);
+        return;
+    }
+    if (0 > st->client) printf("total       ");
+    else                printf("client %4d ", st->client);
+    printf("%-9s %7.1f msg/s %8.1f KB/s %6u snaps %8.1f us/snap (max %8.1f) "
+           "taps %5u acked %5u  aoi %4d players %4d bots %5d objects\n",
+           !st->connected ? "refused" : (st->dropped ? "dropped" : "ok"),
+           st->messages / secs, (double)st->bytes / 1024.0 / secs, st->snapshots, per_snap,
+           st->max_decode_us, st->taps, st->acked, st->players, st->bots, st->world_objects);
+}
+
+static bool read_all(int fd, void* out, size_t size) {
+    uint8_t* p = out;
+    while (0 < size) {
+        ssize_t n = read(fd, p, size);
+        if (0 > n && EINTR == errno) continue;
+        if (0 >= n) return false;
+        p    += n;
+        size -= (size_t)n;
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    SwarmConfig cfg = { .clients = 10, .seconds = 30.0, .tap_hz = 0.5, .stagger_ms = 20 };
+    for (int i = 1; i < argc; i++) {
+        if      (0 == strcmp(argv[i], "--url") && i + 1 < argc) cfg.url = argv[++i];
+        else if (0 == strcmp(argv[i], "--clients"))    cfg.clients    = arg_int(argc, argv, &i);
+        else if (0 == strcmp(argv[i], "--seconds"))    cfg.seconds    = arg_int(argc, argv, &i);
+        else if (0 == strcmp(argv[i], "--tap-hz") && i + 1 < argc) cfg.tap_hz = atof(argv[++i]);
+        else if (0 == strcmp(argv[i], "--stagger-ms")) cfg.stagger_ms = arg_int(argc, argv, &i);
+        else if (0 == strcmp(argv[i], "--json"))       cfg.json       = true;
+        else {
+            cfg.url = NULL;
+            break;
+        }
+    }
+    if (!cfg.url || 1 > cfg.clients || SWARM_MAX_CLIENTS < cfg.clients) {
+        fprintf(stderr, "usage: %s --url ws://HOST:PORT/ws [--clients 1..%d] [--seconds S] "
+                        "[--tap-hz H] [--stagger-ms MS] [--json]\n", argv[0], SWARM_MAX_CLIENTS);
+        return 2;
+    }
+
+    static pid_t pids[SWARM_MAX_CLIENTS];
+    static int   pipes[SWARM_MAX_CLIENTS];
+    for (int i = 0; i < cfg.clients; i++) {
+        int fds[2];
+        if (0 != pipe(fds)) {
+            perror("pipe");
+            return 1;
+        }
+        fflush(stdout);
+        pid_t pid = fork();
+        if (0 > pid) {
+            perror("fork");
+            return 1;
+        }
+        if (0 == pid) {
+            close(fds[0]);
+            SwarmClientStats st = run_client(&cfg, i);
+            ssize_t n = write(fds[1], &st, sizeof(st));
+            _exit(sizeof(st) == (size_t)n ? 0 : 1);
+        }
+        close(fds[1]);
+        pids[i]  = pid;
+        pipes[i] = fds[0];
+        if (0 < cfg.stagger_ms) usleep((useconds_t)cfg.stagger_ms * 1000u);
+    }
+
+    SwarmClientStats total = { .client = -1 };
+    int ok = 0;
+    for (int i = 0; i < cfg.clients; i++) {
+        SwarmClientStats st = { .client = i };
+        bool got = read_all(pipes[i], &st, sizeof(st));
+        close(pipes[i]);
+        waitpid(pids[i], NULL, 0);
+        if (!got) {
+            fprintf(stderr, "client %d exited without a report\n", i);
+            continue;
+        }
+        print_client(&cfg, &st);
+        ok += st.connected && !st.dropped;
+        total.seconds             = total.seconds > st.seconds ? total.seconds : st.seconds;
+        total.messages           += st.messages;
+        total.bytes              += st.bytes;
+        total.snapshots          += st.snapshots;
+        total.snapshot_decode_us += st.snapshot_decode_us;
+        total.taps               += st.taps;
+        total.acked              += st.acked;
+        if (total.max_decode_us < st.max_decode_us) total.max_decode_us = st.max_decode_us;
+    }
+    total.connected = 0 < ok;
+    print_client(&cfg, &total);
+    if (!cfg.json) printf("%d/%d clients stayed connected\n", ok, cfg.clients);
+    return ok == cfg.clients ? 0 : 1;
+}
@@ -0,0 +1,286 @@
+#include "ws_native.h"
+
+#include <assert.h>
+#include <errno.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#define WS_OP_CONT   0x0
+#define WS_OP_TEXT   0x1
+#define WS_OP_BINARY 0x2
+#define WS_OP_CLOSE  0x8
+#define WS_OP_PING   0x9
+#define WS_OP_PONG   0xA
+
+#define WS_HANDSHAKE_MAX 4096
+
+static void grow(uint8_t** buf, size_t* cap, size_t need) {
+    if (need <= *cap) return;
+    while (need > *cap) *cap = *cap ? *cap * 2 : 16 * 1024;
+    *buf = realloc(*buf, *cap);
+    assert(*buf);
+}
+
+static bool send_all(int fd, const void* data, size_t len) {
+    const uint8_t* p = data;
+    while (0 < len) {
+        ssize_t n = send(fd, p, len, MSG_NOSIGNAL);
+        if (0 > n && EINTR == errno) continue;
+        if (0 >= n) return false;
+        p   += n;
+        len -= (size_t)n;
+    }
+    return true;
+}
+
+static void base64(const uint8_t* in, size_t len, char* out) {
+    static const char kAlphabet[] =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    size_t o = 0;
+    for (size_t i = 0; i < len; i += 3) {
+        uint32_t v = (uint32_t)in[i] << 16;
+        if (i + 1 < len) v |= (uint32_t)in[i + 1] << 8;
+        if (i + 2 < len) v |= in[i + 2];
+        out[o++] = kAlphabet[(v >> 18) & 63];
+        out[o++] = kAlphabet[(v >> 12) & 63];
+        out[o++] = i + 1 < len ? kAlphabet[(v >> 6) & 63] : '=';
+        out[o++] = i + 2 < len ? kAlphabet[v & 63] : '=';
+    }
+    out[o] = '\0';
+}
+
+/* ws://host[:port][/path] */
+static bool parse_url(const char* url, char* host, size_t host_size, char* port,
+                      size_t port_size, const char** path) {
+    if (0 != strncmp(url, "ws://", 5)) return false;
+    const char* h     = url + 5;
+    const char* slash = strchr(h, '/');
+    size_t hlen       = slash ? (size_t)(slash - h) : strlen(h);
+    *path             = slash ? slash : "/";
+    const char* colon = memchr(h, ':', hlen);
+    size_t name_len   = colon ? (size_t)(colon - h) : hlen;
+    if (0 == name_len || host_size <= name_len) return false;
+    memcpy(host, h, name_len);
+    host[name_len] = '\0';
+    if (colon) snprintf(port, port_size, "%.*s", (int)(hlen - name_len - 1), colon + 1);
+    else       snprintf(port, port_size, "80");
+    return true;
+}
+
+static int dial(const char* host, const char* port) {
+    struct addrinfo hints = { .ai_family = AF_UNSPEC, .ai_socktype = SOCK_STREAM };
+    struct addrinfo* res = NULL;
+    int rc = getaddrinfo(host, port, &hints, &res);
+    if (0 != rc) {
+        fprintf(stderr, "ws: resolve %s: %s\n", host, gai_strerror(rc));
+        return -1;
+    }
+    int fd = -1;
+    for (struct addrinfo* a = res; a && 0 > fd; a = a->ai_next) {
+        fd = socket(a->ai_family, a->ai_socktype, a->ai_protocol);
+        if (0 > fd) continue;
+        if (0 != connect(fd, a->ai_addr, a->ai_addrlen)) {
+            close(fd);
+            fd = -1;
+        }
+    }
+    freeaddrinfo(res);
+    if (0 > fd) {
+        fprintf(stderr, "ws: connect %s:%s: %s\n", host, port, strerror(errno));
+        return -1;
+    }
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    return fd;
+}
+
+bool ws_native_connect(WsNative* ws, const char* url) {
+    assert(ws && url);
+    *ws = (WsNative){ .fd = -1 };
+    char host[256], port[16];
+    const char* path;
+    if (!parse_url(url, host, sizeof(host), port, sizeof(port), &path)) {
+        fprintf(stderr, "ws: unsupported url %s (ws://host[:port]/path)\n", url);
+        return false;
+    }
+    ws->fd = dial(host, port);
+    if (0 > ws->fd) return false;
+
+    uint8_t nonce[16];
+    for (size_t i = 0; i < sizeof(nonce); i++) nonce[i] = (uint8_t)rand();
+    char key[32];
+    base64(nonce, sizeof(nonce), key);
+    char request[1024];
+    int n = snprintf(request, sizeof(request),
+                     "GET %s HTTP/1.1\r\nHost: %s:%s\r\nUpgrade: websocket\r\n"
+                     "Connection: Upgrade\r\nSec-WebSocket-Key: %s\r\n"
+                     "Sec-WebSocket-Version: 13\r\n\r\n",
+                     path, host, port, key);
+    if (!send_all(ws->fd, request, (size_t)n)) {
+        ws_native_close(ws);
+        return false;
+    }
+
+    /* Response headers; bytes past them are the first frames. */
+    grow(&ws->in, &ws->in_cap, WS_HANDSHAKE_MAX);
+    char* end = NULL;
+    while (!end) {
+        if (WS_HANDSHAKE_MAX - 1 <= ws->in_len) break;
+        ssize_t got = recv(ws->fd, ws->in + ws->in_len, WS_HANDSHAKE_MAX - 1 - ws->in_len, 0);
+        if (0 >= got) break;
+        ws->in_len += (size_t)got;
+        ws->in[ws->in_len] = '\0';
+        end = strstr((char*)ws->in, "\r\n\r\n");
+    }
+    if (!end || 0 != strncmp((char*)ws->in, "HTTP/1.1 101", 12)) {
+        fprintf(stderr, "ws: upgrade refused by %s:%s%s\n", host, port, path);
+        ws_native_close(ws);
+        return false;
+    }
+    size_t header = (size_t)(end + 4 - (char*)ws->in);
+    memmove(ws->in, ws->in + header, ws->in_len - header);
+    ws->in_len -= header;
+    return true;
+}
+
+static bool send_frame(WsNative* ws, uint8_t opcode, const void* data, size_t len) {
+    if (0 > ws->fd) return false;
+    uint8_t head[14];
+    size_t h = 0;
+    head[h++] = 0x80 | opcode;
+    if (126 > len) {
+        head[h++] = 0x80 | (uint8_t)len;
+    } else if (0xffff >= len) {
+        head[h++] = 0x80 | 126;
+        head[h++] = (uint8_t)(len >> 8);
+        head[h++] = (uint8_t)len;
+    } else {
+        head[h++] = 0x80 | 127;
+        for (int i = 7; i >= 0; i--) head[h++] = (uint8_t)((uint64_t)len >> (8 * i));
+    }
+    uint8_t mask[4];
+    for (int i = 0; i < 4; i++) head[h++] = mask[i] = (uint8_t)rand();
+
+    uint8_t  stack[512];
+    uint8_t* body = len <= sizeof(stack) ? stack : malloc(len);
+    assert(body);
+    for (size_t i = 0; i < len; i++) body[i] = ((const uint8_t*)data)[i] ^ mask[i & 3];
+    bool ok = send_all(ws->fd, head, h) && send_all(ws->fd, body, len);
+    if (body != stack) free(body);
+    return ok;
+}
+
+bool ws_native_send(WsNative* ws, const void* data, size_t len, bool is_text) {
+    assert(ws && (data || 0 == len));
+    return send_frame(ws, is_text ? WS_OP_TEXT : WS_OP_BINARY, data, len);
+}
+
+/* One frame off the front of `in`: 1 with its fields set, 0 while it is
+ * still incomplete. */
+static int parse_frame(WsNative* ws, size_t at, uint8_t* b0, const uint8_t** payload,
+                       size_t* len, size_t* frame_len) {
+    const uint8_t* p = ws->in + at;
+    size_t avail = ws->in_len - at;
+    if (2 > avail) return 0;
+    size_t h = 2;
+    uint64_t n = p[1] & 0x7f;
+    if (126 == n) {
+        if (4 > avail) return 0;
+        n = (uint64_t)p[2] << 8 | p[3];
+        h = 4;
+    } else if (127 == n) {
+        if (10 > avail) return 0;
+        n = 0;
+        for (int i = 0; i < 8; i++) n = n << 8 | p[2 + i];
+        h = 10;
+    }
+    bool masked = 0 != (p[1] & 0x80);
+    if (masked) h += 4;
+    if (avail < h || avail - h < n) return 0;
+    if (masked) {
+        uint8_t* body = ws->in + at + h;
+        for (uint64_t i = 0; i < n; i++) body[i] ^= p[h - 4 + (i & 3)];
+    }
+    *b0        = p[0];
+    *payload   = p + h;
+    *len       = (size_t)n;
+    *frame_len = h + (size_t)n;
+    return 1;
+}
+
+int ws_native_poll(WsNative* ws, int timeout_ms, const uint8_t** data, size_t* len, bool* is_text) {
+    assert(ws && data && len && is_text);
+    if (0 > ws->fd) return -1;
+    if (0 < ws->consumed) {
+        memmove(ws->in, ws->in + ws->consumed, ws->in_len - ws->consumed);
+        ws->in_len  -= ws->consumed;
+        ws->consumed = 0;
+    }
+    for (;;) {
+        uint8_t b0;
+        const uint8_t* payload;
+        size_t n, frame_len;
+        while (parse_frame(ws, ws->consumed, &b0, &payload, &n, &frame_len)) {
+            size_t at = ws->consumed;
+            ws->consumed += frame_len;
+            uint8_t opcode = b0 & 0x0f;
+            bool    fin    = 0 != (b0 & 0x80);
+            if (WS_OP_PING == opcode) {
+                send_frame(ws, WS_OP_PONG, payload, n);
+                continue;
+            }
+            if (WS_OP_PONG == opcode) continue;
+            if (WS_OP_CLOSE == opcode) {
+                send_frame(ws, WS_OP_CLOSE, payload, 2 <= n ? 2 : 0);
+                ws_native_close(ws);
+                return -1;
+            }
+            if (fin && WS_OP_CONT != opcode) {
+                *data    = ws->in + at + (frame_len - n);
+                *len     = n;
+                *is_text = WS_OP_TEXT == opcode;
+                return 1;
+            }
+            if (WS_OP_CONT != opcode) {
+                ws->msg_opcode = opcode;
+                ws->msg_len    = 0;
+            }
+            grow(&ws->msg, &ws->msg_cap, ws->msg_len + n);
+            memcpy(ws->msg + ws->msg_len, payload, n);
+            ws->msg_len += n;
+            if (fin) {
+                *data    = ws->msg;
+                *len     = ws->msg_len;
+                *is_text = WS_OP_TEXT == ws->msg_opcode;
+                return 1;
+            }
+        }
+
+        struct pollfd pfd = { .fd = ws->fd, .events = POLLIN };
+        int ready = poll(&pfd, 1, timeout_ms);
+        if (0 > ready && EINTR == errno) continue;
+        if (0 > ready) return -1;
+        if (0 == ready) return 0;
+        grow(&ws->in, &ws->in_cap, ws->in_len + 64 * 1024);
+        ssize_t got = recv(ws->fd, ws->in + ws->in_len, ws->in_cap - ws->in_len, 0);
+        if (0 >= got) {
+            ws_native_close(ws);
+            return -1;
+        }
+        ws->in_len += (size_t)got;
+        timeout_ms = 0;   /* parse what arrived; wait no further */
+    }
+}
+
+void ws_native_close(WsNative* ws) {
+    assert(ws);
+    if (0 <= ws->fd) close(ws->fd);
+    ws->fd = -1;
+}
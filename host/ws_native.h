@@ -0,0 +1,38 @@
+#ifndef CYBERIA_HOST_WS_NATIVE_H
+#define CYBERIA_HOST_WS_NATIVE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* Minimal blocking RFC 6455 client over a POSIX socket, for host tools that
+ * talk to a real server (host/swarm.c). ws:// only — there is no TLS on the
+ * host build, so point it at the game server directly rather than at the
+ * wss:// proxy. Pings are answered inside ws_native_poll(); fragmented
+ * messages are reassembled. */
+
+typedef struct {
+    int      fd;
+    uint8_t* in;          /* received bytes not yet parsed */
+    size_t   in_len, in_cap;
+    size_t   consumed;    /* of `in`, by the message last returned */
+    uint8_t* msg;         /* fragments of the message being reassembled */
+    size_t   msg_len, msg_cap;
+    uint8_t  msg_opcode;
+} WsNative;
+
+/* Connect and upgrade `url` (ws://host[:port][/path]); false on failure
+ * with the reason on stderr. */
+bool ws_native_connect(WsNative* ws, const char* url);
+
+/* One masked frame; false once the socket failed. */
+bool ws_native_send(WsNative* ws, const void* data, size_t len, bool is_text);
+
+/* Wait up to `timeout_ms` for the next complete data message: 1 with
+ * `*data` valid until the next poll, 0 on timeout, -1 once the server
+ * closed or the socket failed. */
+int ws_native_poll(WsNative* ws, int timeout_ms, const uint8_t** data, size_t* len, bool* is_text);
+
+void ws_native_close(WsNative* ws);
+
+#endif /* CYBERIA_HOST_WS_NATIVE_H */
@@ -0,0 +1,72 @@
+#!/usr/bin/env python3
+"""
+Build the boot asset pack read by src/asset_pack.c.
+
+Usage
+-----
+  python3 pack-assets.py <out.pack> <root> [<root> ...]
+
+  Every file under each <root> is stored under its URL on the engine API,
+  "/assets/" + its path relative to the root's parent — pass the engine's
+  assets/ui-icons and assets/fonts directories to pack the status icons and
+  fonts.  Publish the result as /assets/boot.pack (ASSET_PACK_URL).
+
+Layout (little-endian)
+----------------------
+  header  b"CYPK", u32 version, u32 entry count, u32 reserved
+  entries count x { u32 offset, u32 size, char path[120] NUL-padded }
+  data    each file at its offset, 16-byte aligned
+"""
+
+import os
+import struct
+import sys
+
+MAGIC = b"CYPK"
+VERSION = 1
+PATH_MAX = 120
+ALIGN = 16
+URL_PREFIX = "/assets/"
+
+
+def collect(roots):
+    """[(url, path)] for every file under roots, sorted by URL."""
+
+    files = {}
+    for root in roots:
+        root = os.path.normpath(root)
+        parent = os.path.dirname(root)
+        for dirpath, _, names in os.walk(root):
+            for name in names:
+                path = os.path.join(dirpath, name)
+                url = URL_PREFIX + os.path.relpath(path, parent).replace(os.sep, "/")
+                if len(url.encode("utf-8")) >= PATH_MAX:
+                    sys.exit(f"pack-assets: path too long for the pack: {url}")
+                files[url] = path
+    return sorted(files.items())
+
+
+def build(entries):
+    header_size = 16 + len(entries) * (8 + PATH_MAX)
+    offset = (header_size + ALIGN - 1) // ALIGN * ALIGN
+    toc, blobs = [], []
+    for url, path in entries:
+        with open(path, "rb") as handle:
+            body = handle.read()
+        toc.append(struct.pack(f"<II{PATH_MAX}s", offset, len(body), url.encode("utf-8")))
+        padding = (-len(body)) % ALIGN
+        blobs.append(body + b"\0" * padding)
+        offset += len(body) + padding
+    head = MAGIC + struct.pack("<III", VERSION, len(entries), 0) + b"".join(toc)
+    head += b"\0" * ((-len(head)) % ALIGN)
+    return head + b"".join(blobs)
+
+
+if __name__ == "__main__":
+    if len(sys.argv) < 3:
+        sys.exit(__doc__)
+    entries = collect(sys.argv[2:])
+    pack = build(entries)
+    with open(sys.argv[1], "wb") as handle:
+        handle.write(pack)
+    print(f"[pack] {len(entries)} files, {len(pack)} bytes -> {sys.argv[1]}")
@@ -0,0 +1,79 @@
+#!/usr/bin/env sh
+# Profile-guided release build driven by a recorded session.
+#
+#   ./pgo-build.sh busy-session.cyrec [make args...]
+#
+# 1. Host.mk builds the headless client with emsdk's own clang and
+#    -fprofile-instr-generate, so the profile format matches the emcc that
+#    consumes it.
+# 2. aoi_bench replays the session (decode, interpolation, depth sort, draw)
+#    and micro_bench runs its hash_table / aoi / sort / text cases; both write
+#    raw profiles, merged into build/pgo/cyberia.profdata.
+# 3. release-build.sh builds the wasm bundle with -fprofile-instr-use.
+#
+# The report compares micro_bench medians and the replay summary between a
+# plain and a profile-guided host build of the same sources. Functions whose
+# body differs between host and wasm (the __EMSCRIPTEN__ edge) are left
+# unprofiled; the core modules share one body and take the profile.
+set -eu
+
+if [ $# -lt 1 ]; then
+    echo "usage: $0 <session.cyrec> [make args...]" >&2
+    exit 2
+fi
+REPLAY=$1
+shift
+
+WORK=build/pgo
+LLVM=${LLVM_ROOT:-$(em-config LLVM_ROOT)}
+CLANG="$LLVM/clang"
+PROFDATA="$LLVM/llvm-profdata"
+[ -x "$PROFDATA" ] || PROFDATA=llvm-profdata
+PROFILE="$(pwd)/$WORK/cyberia.profdata"
+PGO_WARN="-Wno-profile-instr-unprofiled -Wno-profile-instr-out-of-date"
+
+host_build() {
+    name=$1
+    cc=$2
+    make -f Host.mk BUILD_MODE=RELEASE CC="$cc" \
+        BUILD_DIR="$WORK/$name/obj" OUTPUT_DIR="$WORK/$name/out"
+}
+
+rm -rf "$WORK"
+mkdir -p "$WORK/raw"
+
+host_build instr "$CLANG -fprofile-instr-generate"
+LLVM_PROFILE_FILE="$WORK/raw/replay-%p.profraw" "$WORK/instr/out/host/aoi_bench" --replay "$REPLAY" >/dev/null
+LLVM_PROFILE_FILE="$WORK/raw/micro-%p.profraw" "$WORK/instr/out/host/micro_bench" >/dev/null
+"$PROFDATA" merge -output="$PROFILE" "$WORK"/raw/*.profraw
+
+host_build plain "$CLANG"
+host_build pgo "$CLANG -fprofile-instr-use=$PROFILE $PGO_WARN"
+
+for name in plain pgo; do
+    "$WORK/$name/out/host/micro_bench" --json | grep '^{' >"$WORK/$name.jsonl"
+    "$WORK/$name/out/host/aoi_bench" --replay "$REPLAY" >"$WORK/$name.replay.txt" 2>&1
+done
+
+RELEASE_CFLAGS="-fprofile-instr-use=$PROFILE $PGO_WARN" ./release-build.sh "$@"
+
+echo
+echo "micro_bench median ns/op, plain -> pgo"
+python3 - "$WORK/plain.jsonl" "$WORK/pgo.jsonl" <<'PY'
+import json, sys
+
+def load(path):
+    with open(path) as handle:
+        return {(r["case"], r["n"]): r["ns_per_op"] for r in map(json.loads, handle)}
+
+plain, pgo = load(sys.argv[1]), load(sys.argv[2])
+for key in sorted(plain, key=lambda k: (pgo.get(k, plain[k]) - plain[k]) / plain[k]):
+    if key in pgo:
+        gain = 100.0 * (plain[key] - pgo[key]) / plain[key]
+        print(f"  {key[0]:<28} n={key[1]:<6} {plain[key]:>10.2f} {pgo[key]:>10.2f}  {gain:+6.1f}%")
+PY
+echo
+echo "replay, plain:"
+tail -n 12 "$WORK/plain.replay.txt"
+echo "replay, pgo:"
+tail -n 12 "$WORK/pgo.replay.txt"
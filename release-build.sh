@@ -0,0 +1,67 @@
+#!/usr/bin/env sh
+# Release profile: LTO across src/, raylib and cJSON, wasm-opt, and a SIMD
+# variant of index.wasm next to the baseline one.
+#
+#   ./release-build.sh [make args...]     e.g. WS_URL=wss://… API_BASE=https://…
+#
+# Web.mk builds twice into separate trees; EMCC_CFLAGS reaches every emcc call
+# (including raylib's sub-make), LDFLAGS_RELEASE the final link. The baseline
+# bundle lands in bin/ and the SIMD build contributes only bin/index.simd.wasm:
+# both share one index.js, which is checked to be identical. shell.html loads
+# the SIMD module where the browser validates wasm SIMD (docker-driver.py tells
+# it the hashed name) and the baseline one everywhere else.
+#
+# RELEASE_CFLAGS, when set, is appended to both variants' compile flags
+# (pgo-build.sh passes the profile through it).
+#
+# Prints raw / gzip / brotli sizes of each index.wasm before and after
+# wasm-opt. For frame time, compare CyberiaProfiler captures of the two.
+set -eu
+
+OUT=bin
+WORK=build/release-profile
+LTO_LDFLAGS="-flto -O3"
+OPT_FLAGS="-O3 --converge --strip-debug"
+
+size_row() {
+    raw=$(wc -c <"$2")
+    gz=$(gzip -9 -c "$2" | wc -c)
+    if command -v brotli >/dev/null 2>&1; then
+        br=$(brotli -q 11 -c "$2" | wc -c)
+    else
+        br=-
+    fi
+    printf '%-22s %10s %10s %10s\n' "$1" "$raw" "$gz" "$br"
+}
+
+build_variant() {
+    name=$1
+    cflags=$2
+    shift 2
+    EMCC_CFLAGS="$cflags ${RELEASE_CFLAGS:-}" make -f Web.mk clean all BUILD_MODE=RELEASE \
+        BUILD_DIR="$WORK/$name/obj" OUTPUT_DIR="$WORK/$name/out" \
+        LDFLAGS_RELEASE="$LTO_LDFLAGS" "$@"
+    cp "$WORK/$name/out/index.wasm" "$WORK/$name/index.preopt.wasm"
+}
+
+mkdir -p "$WORK"
+build_variant base "-flto" "$@"
+build_variant simd "-flto -msimd128" "$@"
+
+if ! cmp -s "$WORK/base/out/index.js" "$WORK/simd/out/index.js"; then
+    echo "release-build: base and SIMD builds produced different index.js" >&2
+    exit 1
+fi
+
+wasm-opt $OPT_FLAGS "$WORK/base/out/index.wasm" -o "$WORK/base/out/index.wasm"
+wasm-opt $OPT_FLAGS --enable-simd "$WORK/simd/out/index.wasm" -o "$WORK/simd/out/index.wasm"
+
+rm -rf "$OUT"
+cp -R "$WORK/base/out" "$OUT"
+cp "$WORK/simd/out/index.wasm" "$OUT/index.simd.wasm"
+
+printf '\n%-22s %10s %10s %10s\n' "module" "raw" "gzip" "brotli"
+size_row "base (pre wasm-opt)" "$WORK/base/index.preopt.wasm"
+size_row "base" "$OUT/index.wasm"
+size_row "simd (pre wasm-opt)" "$WORK/simd/index.preopt.wasm"
+size_row "simd" "$OUT/index.simd.wasm"
@@ -0,0 +1,59 @@
+#include "asset_pack.h"
+
+#include <assert.h>
+#include <string.h>
+
+#define HEADER_BYTES 16u
+
+typedef struct {
+    uint32_t offset;
+    uint32_t size;
+    char     path[ASSET_PACK_PATH_MAX];
+} PackEntry;
+
+static_assert(128 == sizeof(PackEntry), "entry layout is fixed by the pack format");
+
+static uint32_t read_u32(const uint8_t* p) {
+    return (uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+}
+
+static PackEntry read_entry(const AssetPack* pack, uint32_t i) {
+    const uint8_t* p = pack->data + HEADER_BYTES + (size_t)i * sizeof(PackEntry);
+    PackEntry e = { .offset = read_u32(p), .size = read_u32(p + 4) };
+    memcpy(e.path, p + 8, sizeof(e.path));
+    return e;
+}
+
+bool asset_pack_open(AssetPack* pack, const void* data, size_t size) {
+    assert(pack);
+    *pack = (AssetPack){ 0 };
+    const uint8_t* bytes = data;
+    if (!bytes || HEADER_BYTES > size) return false;
+    if (0 != memcmp(bytes, ASSET_PACK_MAGIC, 4)) return false;
+    if (ASSET_PACK_VERSION != read_u32(bytes + 4)) return false;
+
+    uint32_t count = read_u32(bytes + 8);
+    if ((size - HEADER_BYTES) / sizeof(PackEntry) < count) return false;
+    *pack = (AssetPack){ .data = bytes, .size = size, .count = count };
+    for (uint32_t i = 0; i < count; i++) {
+        PackEntry e = read_entry(pack, i);
+        if (NULL == memchr(e.path, '\0', sizeof(e.path)) ||
+            e.offset > size || e.size > size - e.offset) {
+            *pack = (AssetPack){ 0 };
+            return false;
+        }
+    }
+    return true;
+}
+
+const void* asset_pack_find(const AssetPack* pack, const char* path, size_t* size) {
+    assert(pack);
+    assert(path);
+    for (uint32_t i = 0; i < pack->count; i++) {
+        PackEntry e = read_entry(pack, i);
+        if (0 != strcmp(e.path, path)) continue;
+        if (size) *size = e.size;
+        return pack->data + e.offset;
+    }
+    return NULL;
+}
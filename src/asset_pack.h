@@ -0,0 +1,37 @@
+#ifndef CYBERIA_ASSET_PACK_H
+#define CYBERIA_ASSET_PACK_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* Boot asset pack: the first-party files the client asks for at startup
+ * (status icons, fonts) concatenated into one blob with a table of contents,
+ * so they arrive in one request. Lookups return pointers into the blob.
+ *
+ * Layout, little-endian (written by pack-assets.py):
+ *   header  "CYPK", u32 version, u32 entry count, u32 reserved
+ *   entries count x { u32 offset, u32 size, char path[ASSET_PACK_PATH_MAX] }
+ *   data    each file at its offset, ASSET_PACK_ALIGN-aligned
+ * `path` is the URL the client fetches ("/assets/ui-icons/skull.png"),
+ * NUL-padded. */
+
+#define ASSET_PACK_MAGIC    "CYPK"
+#define ASSET_PACK_VERSION  1u
+#define ASSET_PACK_PATH_MAX 120
+#define ASSET_PACK_ALIGN    16u
+
+typedef struct {
+    const uint8_t* data;   /* whole pack; owned by the caller */
+    size_t         size;
+    uint32_t       count;
+} AssetPack;
+
+/* Validate `data` as a pack: header, every entry inside the blob, every
+ * path terminated. The pack borrows `data`. */
+bool asset_pack_open(AssetPack* pack, const void* data, size_t size);
+
+/* The file stored under `path`, or NULL. Points into pack->data. */
+const void* asset_pack_find(const AssetPack* pack, const char* path, size_t* size);
+
+#endif /* CYBERIA_ASSET_PACK_H */
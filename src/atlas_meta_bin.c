@@ -0,0 +1,91 @@
+#include "atlas_meta_bin.h"
+
+#include <assert.h>
+#include <string.h>
+
+#define HEADER_BYTES 20u
+#define TABLE_BYTES  (2u * ATLAS_ANIM_COUNT)
+#define FRAME_BYTES  8u
+
+static const uint8_t kPngSignature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n' };
+
+static uint16_t read_u16(const uint8_t* p) {
+    return (uint16_t)(p[0] | p[1] << 8);
+}
+
+static uint32_t read_u32_be(const uint8_t* p) {
+    return (uint32_t)p[0] << 24 | (uint32_t)p[1] << 16 | (uint32_t)p[2] << 8 | (uint32_t)p[3];
+}
+
+bool atlas_meta_bin_is(const void* data, size_t size) {
+    return data && 4 <= size && 0 == memcmp(data, ATLAS_META_BIN_MAGIC, 4);
+}
+
+AtlasSpriteSheetData* atlas_meta_bin_parse(const void* data, size_t size) {
+    const uint8_t* p = data;
+    if (!atlas_meta_bin_is(data, size) || HEADER_BYTES + TABLE_BYTES > size) return NULL;
+    if (ATLAS_META_BIN_VERSION != read_u16(p + 4)) return NULL;
+
+    uint16_t frame_count = read_u16(p + 16);
+    size_t   key_len     = p[18];
+    if (MAX_ITEM_ID_LENGTH <= key_len) return NULL;
+    if ((size - HEADER_BYTES - TABLE_BYTES - key_len) / FRAME_BYTES < frame_count) return NULL;
+
+    const uint8_t* table = p + HEADER_BYTES;
+    unsigned total = 0;
+    for (int i = 0; i < ATLAS_ANIM_COUNT; i++) {
+        uint16_t n = read_u16(table + 2 * i);
+        if (MAX_FRAMES_PER_DIRECTION < n) return NULL;
+        total += n;
+    }
+    if (frame_count != total) return NULL;
+
+    AtlasSpriteSheetData* atlas = create_atlas_sprite_sheet_data(frame_count);
+    if (!atlas) return NULL;
+    atlas->texture_variants = read_u16(p + 6);
+    atlas->atlas_width      = read_u16(p + 8);
+    atlas->atlas_height     = read_u16(p + 10);
+    atlas->cell_pixel_dim   = read_u16(p + 12);
+    atlas->frame_duration   = read_u16(p + 14);
+    memcpy(atlas->item_key, table + TABLE_BYTES, key_len);
+
+    uint16_t offset = 0;
+    for (int i = 0; i < ATLAS_ANIM_COUNT; i++) {
+        uint16_t n = read_u16(table + 2 * i);
+        atlas->anims[i] = (AtlasAnimSpan){ .offset = offset, .count = n };
+        offset += n;
+    }
+    const uint8_t* f = table + TABLE_BYTES + key_len;
+    for (int i = 0; i < frame_count; i++, f += FRAME_BYTES) {
+        atlas->frame_pool[i] = (FrameMetadata){
+            .x      = read_u16(f),
+            .y      = read_u16(f + 2),
+            .width  = read_u16(f + 4),
+            .height = read_u16(f + 6),
+        };
+    }
+    atlas_build_frame_table(atlas);
+    return atlas;
+}
+
+const void* atlas_meta_png_chunk(const void* png, size_t size, size_t* out_size) {
+    assert(out_size);
+    const uint8_t* p = png;
+    if (!p || sizeof(kPngSignature) > size || 0 != memcmp(p, kPngSignature, sizeof(kPngSignature))) {
+        return NULL;
+    }
+    /* Each chunk: u32 length (big-endian), type, data, u32 CRC. */
+    size_t at = sizeof(kPngSignature);
+    while (12 <= size - at) {
+        uint32_t len  = read_u32_be(p + at);
+        const uint8_t* type = p + at + 4;
+        if (len > size - at - 12) return NULL;
+        if (0 == memcmp(type, ATLAS_META_PNG_CHUNK, 4)) {
+            *out_size = len;
+            return p + at + 8;
+        }
+        if (0 == memcmp(type, "IEND", 4)) return NULL;
+        at += 12 + (size_t)len;
+    }
+    return NULL;
+}
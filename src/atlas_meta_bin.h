@@ -0,0 +1,46 @@
+#ifndef CYBERIA_ATLAS_META_BIN_H
+#define CYBERIA_ATLAS_META_BIN_H
+
+#include "object_layer.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* Compact atlas descriptor: what the JSON metadata route says about an
+ * atlas (AtlasSpriteSheetModel), parsed straight into the packed
+ * AtlasSpriteSheetData without building a cJSON tree.
+ *
+ * Layout, little-endian:
+ *   header  "CYAT", u16 version, u16 texture variants (ATLAS_VARIANT_*),
+ *           u16 atlas width, u16 atlas height, u16 cell pixel dim,
+ *           u16 frame duration (ms), u16 frame count, u8 key length,
+ *           u8 reserved
+ *   table   ATLAS_ANIM_COUNT x u16 frames per animation, in AtlasAnim
+ *           (DirectionFramesSchema) order, each ≤ MAX_FRAMES_PER_DIRECTION
+ *   key     the item key, key length bytes, no terminator
+ *   frames  frame count x { u16 x, u16 y, u16 width, u16 height }, every
+ *           animation's frames back to back in table order
+ *
+ * The engine serves it from the metadata route in place of the JSON
+ * document, or embeds it in the atlas PNG as a private ancillary
+ * ATLAS_META_PNG_CHUNK chunk so the blob alone describes itself. */
+
+#define ATLAS_META_BIN_MAGIC   "CYAT"
+#define ATLAS_META_BIN_VERSION 1u
+#define ATLAS_META_PNG_CHUNK   "cyAt"
+
+/* True when `data` starts like a descriptor (magic only). */
+bool atlas_meta_bin_is(const void* data, size_t size);
+
+/* A new atlas from a descriptor, or NULL when it is malformed: wrong
+ * version, counts that do not add up, or fewer bytes than they need. The
+ * caller owns it (free_atlas_sprite_sheet_data). */
+AtlasSpriteSheetData* atlas_meta_bin_parse(const void* data, size_t size);
+
+/* The descriptor carried in a PNG's ATLAS_META_PNG_CHUNK chunk, pointing
+ * into `png`, or NULL when there is none. Walks the chunk headers only;
+ * CRCs are left to the image decoder. */
+const void* atlas_meta_png_chunk(const void* png, size_t size, size_t* out_size);
+
+#endif /* CYBERIA_ATLAS_META_BIN_H */
@@ -0,0 +1,336 @@
+#include "atlas_pages.h"
+
+#include "gpu_memory.h"
+#include "hash_table.h"
+#include "util/log.h"
+
+#include <rlgl.h>
+
+#include <assert.h>
+#include <stdlib.h>
+
+#define ATLAS_PAGE_MAX_SHELVES  128
+#define ATLAS_PAGE_REGION_HINT  256
+
+typedef struct {
+    int y;
+    int height;
+    int x;          /* next free column */
+} Shelf;
+
+typedef struct {
+    bool      used;
+    Texture2D texture;
+    int       top;          /* first row below the last shelf */
+    int       shelf_count;
+    Shelf     shelves[ATLAS_PAGE_MAX_SHELVES];
+    long      dead_area;    /* padded area of evicted regions */
+    bool      mips_stale;   /* level 0 changed since the chain was built */
+} AtlasPage;
+
+struct PageRegion {
+    int    page;
+    int    x;
+    int    y;
+    int    w;
+    int    h;
+    double last_access_time;
+    bool   pinned;          /* never evicted for being idle */
+};
+typedef struct PageRegion PageRegion;
+
+static struct {
+    AtlasPage        pages[ATLAS_PAGE_MAX];
+    HashTable        regions;   /* key → PageRegion* */
+    AtlasPageEvictFn on_evict;
+    unsigned         epoch;     /* bumped whenever a region appears, moves or goes */
+} g_atlas_pages;
+
+void atlas_pages_init(AtlasPageEvictFn on_evict) {
+    assert(on_evict);
+    hash_table_init(&g_atlas_pages.regions, ATLAS_PAGE_REGION_HINT, free, "atlas_pages");
+    g_atlas_pages.on_evict = on_evict;
+}
+
+void atlas_pages_release(void) {
+    for (int i = 0; i < ATLAS_PAGE_MAX; i++) {
+        if (g_atlas_pages.pages[i].used) {
+            gpu_memory_sub(GPU_MEM_ATLAS_PAGES, gpu_memory_texture_bytes(g_atlas_pages.pages[i].texture));
+            UnloadTexture(g_atlas_pages.pages[i].texture);
+        }
+        g_atlas_pages.pages[i] = (AtlasPage){ 0 };
+    }
+    hash_table_destroy(&g_atlas_pages.regions);
+    g_atlas_pages.epoch++;
+}
+
+/* One side of a region's box: itself plus the gutter, rounded up to the
+ * padding so every box starts aligned. */
+static int padded(int side) {
+    return (side + 2 * ATLAS_PAGE_PADDING - 1) / ATLAS_PAGE_PADDING * ATLAS_PAGE_PADDING;
+}
+
+static long padded_area(int w, int h) {
+    return (long)padded(w) * padded(h);
+}
+
+/* Place a padded w × h box: the shortest shelf it fits, else a new shelf. */
+static bool shelf_alloc(AtlasPage* p, int w, int h, int* out_x, int* out_y) {
+    int pw = padded(w), ph = padded(h);
+    Shelf* best = NULL;
+    for (int i = 0; i < p->shelf_count; i++) {
+        Shelf* s = &p->shelves[i];
+        if (s->height < ph || s->x + pw > ATLAS_PAGE_SIZE) { continue; }
+        if (!best || s->height < best->height) { best = s; }
+    }
+    /* Don't bury a short item in a tall shelf while fresh rows remain. */
+    if (best && best->height > 2 * ph && p->top + ph <= ATLAS_PAGE_SIZE &&
+        p->shelf_count < ATLAS_PAGE_MAX_SHELVES) {
+        best = NULL;
+    }
+    if (!best) {
+        if (p->top + ph > ATLAS_PAGE_SIZE || p->shelf_count == ATLAS_PAGE_MAX_SHELVES) {
+            return false;
+        }
+        best  = &p->shelves[p->shelf_count++];
+        *best = (Shelf){ .y = p->top, .height = ph, .x = 0 };
+        p->top += ph;
+    }
+    *out_x = best->x;
+    *out_y = best->y;
+    best->x += pw;
+    return true;
+}
+
+static void page_open(AtlasPage* p) {
+    Image blank = GenImageColor(ATLAS_PAGE_SIZE, ATLAS_PAGE_SIZE, BLANK);
+    *p = (AtlasPage){ .used = true, .texture = LoadTextureFromImage(blank) };
+    UnloadImage(blank);
+#if ATLAS_PAGE_MIPMAPS
+    /* Only where the backend builds the chain; a page without one keeps
+     * raylib's default (non-mip) filter, or it would sample as incomplete. */
+    GenTextureMipmaps(&p->texture);
+    if (1 < p->texture.mipmaps) {
+        rlTextureParameters(p->texture.id, RL_TEXTURE_MIN_FILTER, RL_TEXTURE_FILTER_NEAREST_MIP_LINEAR);
+        rlTextureParameters(p->texture.id, RL_TEXTURE_MAG_FILTER, RL_TEXTURE_FILTER_NEAREST);
+    }
+#endif
+    gpu_memory_add(GPU_MEM_ATLAS_PAGES, gpu_memory_texture_bytes(p->texture));
+}
+
+static bool evict_if_idle(const char* key, void* value, void* user_data) {
+    const PageRegion* r = value;
+    double now = *(const double*)user_data;
+    if (r->pinned) { return false; }
+    if (now - r->last_access_time < ATLAS_PAGE_IDLE_EVICT_SECONDS) { return false; }
+    g_atlas_pages.pages[r->page].dead_area +=
+        padded_area(r->w, r->h);
+    g_atlas_pages.on_evict(key);
+    g_atlas_pages.epoch++;
+    return true;
+}
+
+/* Pinned regions first, so a repack that runs out of room drops others. */
+static int compare_regions_by_height(const void* a, const void* b) {
+    const PageRegion* ra = *(PageRegion* const*)a;
+    const PageRegion* rb = *(PageRegion* const*)b;
+    if (ra->pinned != rb->pinned) { return ra->pinned ? -1 : 1; }
+    return rb->h - ra->h;
+}
+
+typedef struct {
+    int           page;
+    PageRegion**  regions;
+    const char**  keys;
+    int           n;
+} PageScan;
+
+static void scan_page(const char* key, void* value, void* user_data) {
+    PageScan*   scan = user_data;
+    PageRegion* r    = value;
+    if (scan->page != r->page) { return; }
+    scan->regions[scan->n] = r;
+    scan->keys[scan->n]    = key;
+    scan->n++;
+}
+
+/* Repack page `index` tallest-first (pinned ones before the rest) from a
+ * GPU read-back, dropping its dead space. A region that no longer fits (rare: shelf order changed) is
+ * evicted like an idle one. */
+static void page_compact(int index) {
+    AtlasPage* p = &g_atlas_pages.pages[index];
+    HashTable* t = &g_atlas_pages.regions;
+
+    PageRegion** live = malloc(sizeof(PageRegion*) * (t->count + 1));
+    const char** keys = malloc(sizeof(char*) * (t->count + 1));
+    assert(live && keys);
+    PageScan scan = { .page = index, .regions = live, .keys = keys };
+    hash_table_foreach(t, scan_page, &scan);
+    int n = scan.n;
+    qsort(live, (size_t)n, sizeof(PageRegion*), compare_regions_by_height);
+
+    Image old   = LoadImageFromTexture(p->texture);
+    Image fresh = GenImageColor(ATLAS_PAGE_SIZE, ATLAS_PAGE_SIZE, BLANK);
+    p->top         = 0;
+    p->shelf_count = 0;
+    p->dead_area   = 0;
+
+    int lost = 0;
+    for (int i = 0; i < n; i++) {
+        PageRegion* r = live[i];
+        int x = 0, y = 0;
+        if (!shelf_alloc(p, r->w, r->h, &x, &y)) {
+            r->page = -1;
+            lost++;
+            continue;
+        }
+        Rectangle src = { (float)r->x, (float)r->y, (float)r->w, (float)r->h };
+        Rectangle dst = { (float)x, (float)y, (float)r->w, (float)r->h };
+        ImageDraw(&fresh, old, src, dst, WHITE);
+        r->x = x;
+        r->y = y;
+    }
+    UpdateTexture(p->texture, fresh.data);
+    p->mips_stale = true;
+    g_atlas_pages.epoch++;
+    UnloadImage(fresh);
+    UnloadImage(old);
+
+    /* Regions that did not fit go the way of evicted ones. */
+    scan = (PageScan){ .page = -1, .regions = live, .keys = keys };
+    if (0 < lost) { hash_table_foreach(t, scan_page, &scan); }
+    for (int i = 0; i < scan.n; i++) {
+        g_atlas_pages.on_evict(keys[i]);
+        hash_table_remove(t, keys[i]);
+    }
+    free(keys);
+    free(live);
+    LOG_INFO("[ATLAS PAGES] compacted page %d: %d regions kept, %d dropped", index, n - lost, lost);
+}
+
+static bool place(int w, int h, int* out_page, int* out_x, int* out_y) {
+    for (int i = 0; i < ATLAS_PAGE_MAX; i++) {
+        if (g_atlas_pages.pages[i].used &&
+            shelf_alloc(&g_atlas_pages.pages[i], w, h, out_x, out_y)) {
+            *out_page = i;
+            return true;
+        }
+    }
+    for (int i = 0; i < ATLAS_PAGE_MAX; i++) {
+        if (g_atlas_pages.pages[i].used) { continue; }
+        page_open(&g_atlas_pages.pages[i]);
+        LOG_INFO("[ATLAS PAGES] opened page %d", i);
+        *out_page = i;
+        return shelf_alloc(&g_atlas_pages.pages[i], w, h, out_x, out_y);
+    }
+    return false;
+}
+
+bool atlas_pages_insert(const char* key, DecodedImage* decoded) {
+    assert(key);
+    assert(decoded && image_decoder_ok(decoded));
+    assert(g_atlas_pages.on_evict);
+    const Image* image = &decoded->image;
+    if (image->width > ATLAS_PAGE_MAX_ITEM || image->height > ATLAS_PAGE_MAX_ITEM) { return false; }
+    /* Compressed blocks can't be blitted into an RGBA page. */
+    if (image->format >= PIXELFORMAT_COMPRESSED_DXT1_RGB) { return false; }
+
+    /* A refetch of a paged key: its old region turns dead space. */
+    PageRegion* prev = hash_table_get(&g_atlas_pages.regions, key);
+    bool pinned = prev && prev->pinned;
+    if (prev) {
+        g_atlas_pages.pages[prev->page].dead_area +=
+            padded_area(prev->w, prev->h);
+        hash_table_remove(&g_atlas_pages.regions, key);
+        g_atlas_pages.epoch++;
+    }
+
+    int page = -1, x = 0, y = 0;
+    if (!place(image->width, image->height, &page, &x, &y)) {
+        /* Every page is full: evict the idle, compact what that freed. */
+        double now = GetTime();
+        hash_table_remove_if(&g_atlas_pages.regions, evict_if_idle, &now);
+        for (int i = 0; i < ATLAS_PAGE_MAX; i++) {
+            if (g_atlas_pages.pages[i].dead_area > 0) { page_compact(i); }
+        }
+        if (!place(image->width, image->height, &page, &x, &y)) { return false; }
+    }
+
+    if (!image_decoder_upload_rect(decoded, g_atlas_pages.pages[page].texture, x, y)) {
+        g_atlas_pages.pages[page].dead_area +=
+            padded_area(image->width, image->height);
+        return false;
+    }
+    g_atlas_pages.pages[page].mips_stale = true;
+
+    PageRegion* r = malloc(sizeof(PageRegion));
+    assert(r);
+    *r = (PageRegion){
+        .page             = page,
+        .x                = x,
+        .y                = y,
+        .w                = image->width,
+        .h                = image->height,
+        .last_access_time = GetTime(),
+        .pinned           = pinned,
+    };
+    hash_table_put(&g_atlas_pages.regions, key, r);
+    g_atlas_pages.epoch++;
+    return true;
+}
+
+bool atlas_pages_lookup(const char* key, AtlasRegion* out) {
+    assert(key);
+    assert(out);
+    PageRegion* r = hash_table_get(&g_atlas_pages.regions, key);
+    if (!r) { return false; }
+    r->last_access_time = GetTime();
+    *out = (AtlasRegion){
+        .texture = g_atlas_pages.pages[r->page].texture,
+        .x       = r->x,
+        .y       = r->y,
+    };
+    return true;
+}
+
+unsigned atlas_pages_epoch(void) {
+    return g_atlas_pages.epoch;
+}
+
+AtlasPageHandle atlas_pages_find(const char* key) {
+    assert(key);
+    return hash_table_get(&g_atlas_pages.regions, key);
+}
+
+AtlasRegion atlas_pages_region(AtlasPageHandle h) {
+    assert(h);
+    return (AtlasRegion){
+        .texture = g_atlas_pages.pages[h->page].texture,
+        .x       = h->x,
+        .y       = h->y,
+    };
+}
+
+void atlas_pages_touch(AtlasPageHandle h) {
+    assert(h);
+    h->last_access_time = GetTime();
+}
+
+bool atlas_pages_set_pinned(const char* key, bool pinned) {
+    assert(key);
+    PageRegion* r = hash_table_get(&g_atlas_pages.regions, key);
+    if (!r) { return false; }
+    r->pinned = pinned;
+    return true;
+}
+
+void atlas_pages_update_mipmaps(void) {
+#if ATLAS_PAGE_MIPMAPS
+    for (int i = 0; i < ATLAS_PAGE_MAX; i++) {
+        AtlasPage* p = &g_atlas_pages.pages[i];
+        if (!p->used || !p->mips_stale) { continue; }
+        p->mips_stale = false;
+        if (1 < p->texture.mipmaps) { GenTextureMipmaps(&p->texture); }
+    }
+#endif
+}
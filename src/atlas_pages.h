@@ -0,0 +1,101 @@
+#ifndef CYBERIA_ATLAS_PAGES_H
+#define CYBERIA_ATLAS_PAGES_H
+
+#include <raylib.h>
+#include <stdbool.h>
+
+#include "image_decoder.h"
+
+/*
+ * Shared GPU pages for item atlases.
+ *
+ * Each decoded item atlas is copied into a region of one of a few large
+ * ATLAS_PAGE_SIZE² textures, so most of a scene samples the same handful of
+ * textures and batches instead of binding one texture per layer. Regions
+ * are placed by a shelf packer: rows as tall as their tallest item, filled
+ * left to right, best-fitting height first.
+ *
+ * Freed regions are not reused in place. When no page can fit a new item
+ * and every page is in use, unpinned regions idle for
+ * ATLAS_PAGE_IDLE_EVICT_SECONDS are evicted (the owner hears about each
+ * through the evict callback, so it can refetch on next use) and pages
+ * holding dead space are compacted:
+ * read back, repacked tallest-first, re-uploaded. Regions move when that
+ * happens, so callers that keep a region (or its handle) re-resolve it
+ * whenever atlas_pages_epoch() moves.
+ *
+ * With ATLAS_PAGE_MIPMAPS, pages carry a mip chain (they are square powers
+ * of two, which WebGL 1 needs for it) sampled nearest-within-level and
+ * linear-between-levels: crisp when magnified, filtered rather than
+ * aliased when a zoomed-out view minifies them. Regions then start on, and
+ * are padded to, multiples of ATLAS_PAGE_PADDING, so the first
+ * log2(ATLAS_PAGE_PADDING) levels never mix neighbouring items. Chains are
+ * rebuilt by atlas_pages_update_mipmaps(), at most once a frame per page
+ * that changed.
+ *
+ * Standalone: depends only on raylib, hash_table and the image decoder's
+ * uploads. Keys are opaque strings chosen by the owner.
+ */
+
+#define ATLAS_PAGE_SIZE      2048
+#define ATLAS_PAGE_MAX       4
+/* Larger items keep a texture of their own. */
+#define ATLAS_PAGE_MAX_ITEM  1024
+#ifndef ATLAS_PAGE_MIPMAPS
+#define ATLAS_PAGE_MIPMAPS   1
+#endif
+/* Transparent gutter around each region so filtering never bleeds; with
+ * mipmaps also the alignment of every region. */
+#if ATLAS_PAGE_MIPMAPS
+#define ATLAS_PAGE_PADDING   4
+#else
+#define ATLAS_PAGE_PADDING   1
+#endif
+#define ATLAS_PAGE_IDLE_EVICT_SECONDS 10.0
+
+/* Where an atlas lives on the GPU: item frame rects are offset by (x, y)
+ * into `texture`. A standalone texture is a region at (0, 0). */
+typedef struct {
+    Texture2D texture;
+    int       x;
+    int       y;
+} AtlasRegion;
+
+typedef void (*AtlasPageEvictFn)(const char* key);
+
+void atlas_pages_init(AtlasPageEvictFn on_evict);
+
+/* Unload every page and forget every region. */
+void atlas_pages_release(void);
+
+/* Upload `image` into a page under `key` (image_decoder_upload_rect).
+ * False when it is too large, block-compressed, or no page can make room — the caller keeps
+ * a texture of its own for it. */
+bool atlas_pages_insert(const char* key, DecodedImage* image);
+
+/* Region of `key`, refreshing its idle timer. False when not paged. */
+bool atlas_pages_lookup(const char* key, AtlasRegion* out);
+
+/* Direct reference to a paged region, valid while atlas_pages_epoch() is
+ * unchanged: every insert, eviction and compaction moves the epoch. */
+typedef struct PageRegion* AtlasPageHandle;
+
+unsigned        atlas_pages_epoch(void);
+
+/* Handle of `key`'s region, or NULL. Does not touch its idle timer. */
+AtlasPageHandle atlas_pages_find(const char* key);
+AtlasRegion     atlas_pages_region(AtlasPageHandle h);
+
+/* Refresh the region's idle timer, as atlas_pages_lookup() does. */
+void            atlas_pages_touch(AtlasPageHandle h);
+
+/* Exempt `key`'s region from idle eviction (and place it first when its
+ * page is repacked), or lift that. The flag survives a re-insert of the
+ * same key. False when not paged. */
+bool            atlas_pages_set_pinned(const char* key, bool pinned);
+
+/* Rebuild the mip chain of every page written since the last call. Call
+ * once a frame, before drawing. No-op without ATLAS_PAGE_MIPMAPS. */
+void            atlas_pages_update_mipmaps(void);
+
+#endif /* CYBERIA_ATLAS_PAGES_H */
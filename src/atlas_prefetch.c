@@ -0,0 +1,103 @@
+#include "atlas_prefetch.h"
+
+#include "config.h"
+#include "game_state.h"
+#include "object_layers_management.h"
+
+#include <raylib.h>
+
+static struct {
+    double   last_scan;
+    uint32_t world_revision;
+    bool     pinned;
+    uint32_t pinned_layers_version;
+    uint32_t pinned_inventory_version;
+} g_atlas_prefetch;
+
+static void prefetch_layers(const ObjectLayerState* layers, int count) {
+    for (int i = 0; i < count; i++) {
+        if (layers[i].active) obj_layers_mgr_prefetch_atlas(layers[i].item_id, TEX_RES_WARM);
+    }
+}
+
+static void prefetch_ids(const char ids[][128], int count) {
+    for (int i = 0; i < count; i++) obj_layers_mgr_prefetch_atlas(ids[i], TEX_RES_COLD);
+}
+
+static bool in_range(Vector2 pos, Vector2 dims, Vector2 center, float radius) {
+    float dx = pos.x + dims.x * 0.5f - center.x;
+    float dy = pos.y + dims.y * 0.5f - center.y;
+    return dx * dx + dy * dy <= radius * radius;
+}
+
+static void prefetch_entities(const EntityState* e, Vector2 center, float radius) {
+    if (in_range(e->interp_pos, e->dims, center, radius)) {
+        prefetch_layers(e->object_layers, e->object_layer_count);
+    }
+}
+
+static void prefetch_objects(const WorldObject* objects, int count, Vector2 center, float radius) {
+    for (int i = 0; i < count; i++) {
+        if (in_range(objects[i].pos, objects[i].dims, center, radius)) {
+            prefetch_layers(objects[i].object_layers, objects[i].object_layer_count);
+        }
+    }
+}
+
+/* Pin the self player's active layers and inventory when either changed. */
+static void pin_own_items(const GameState* gs) {
+    const EntityState* self = &gs->player.base;
+    if (g_atlas_prefetch.pinned && self->layers_version == g_atlas_prefetch.pinned_layers_version &&
+        gs->inventory_version == g_atlas_prefetch.pinned_inventory_version) {
+        return;
+    }
+    g_atlas_prefetch.pinned                   = true;
+    g_atlas_prefetch.pinned_layers_version    = self->layers_version;
+    g_atlas_prefetch.pinned_inventory_version = gs->inventory_version;
+
+    const char* keys[MAX_OBJECT_LAYERS * 2];
+    int count = 0;
+    for (int i = 0; i < self->object_layer_count; i++) {
+        if (self->object_layers[i].active) keys[count++] = self->object_layers[i].item_id;
+    }
+    for (int i = 0; i < gs->full_inventory_count; i++) keys[count++] = gs->full_inventory[i].item_id;
+    obj_layers_mgr_pin_atlases(keys, count);
+}
+
+void atlas_prefetch_update(void) {
+    const GameState* gs = &g_game_state;
+    pin_own_items(gs);
+
+    double now = GetTime();
+    if (gs->world_revision == g_atlas_prefetch.world_revision &&
+        now - g_atlas_prefetch.last_scan < ATLAS_PREFETCH_SCAN_SECONDS) {
+        return;
+    }
+    g_atlas_prefetch.last_scan      = now;
+    g_atlas_prefetch.world_revision = gs->world_revision;
+
+    /* Anything spawning nearby wears these before its own layers arrive. */
+    for (int i = 0; i < gs->entity_defaults_count; i++) {
+        const EntityTypeDefault* d = &gs->entity_defaults[i];
+        prefetch_ids(d->live_item_ids, d->live_item_id_count);
+        prefetch_ids(d->dead_item_ids, d->dead_item_id_count);
+        prefetch_ids(d->drop_item_ids, d->drop_item_id_count);
+    }
+
+    /* Positions and aoi_radius are both in cells. The player's own layers
+     * are pinned above. */
+    const EntityState* self = &gs->player.base;
+    Vector2 center = {
+        self->interp_pos.x + self->dims.x * 0.5f,
+        self->interp_pos.y + self->dims.y * 0.5f,
+    };
+    float radius = gs->aoi_radius;
+
+    for (int i = 0; i < gs->other_player_count; i++) prefetch_entities(&gs->other_players[i].base, center, radius);
+    for (int i = 0; i < gs->bot_count; i++)          prefetch_entities(&gs->bots[i].base, center, radius);
+    for (int i = 0; i < gs->resource_count; i++)     prefetch_entities(&gs->resources[i].base, center, radius);
+    prefetch_objects(gs->portals,     gs->portal_count,     center, radius);
+    prefetch_objects(gs->statics,     gs->static_count,     center, radius);
+    prefetch_objects(gs->obstacles,   gs->obstacle_count,   center, radius);
+    prefetch_objects(gs->foregrounds, gs->foreground_count, center, radius);
+}
@@ -0,0 +1,30 @@
+#ifndef CYBERIA_ATLAS_PREFETCH_H
+#define CYBERIA_ATLAS_PREFETCH_H
+
+/*
+ * Predictive atlas prefetch.
+ *
+ * Atlases are otherwise fetched the first time draw_entity_layers meets an
+ * item, so entities walking into view show their fallback colour until
+ * the blob lands. Everything the server sends is already inside the AOI,
+ * most of it off screen; every ATLAS_PREFETCH_SCAN_SECONDS this sweeps the
+ * entity-type defaults and the active layers of every decoded entity and
+ * object within aoi_radius of the player, and asks the object layers
+ * manager to prefetch them at FETCH_CLASS_PREFETCH. They queue behind
+ * anything visible, and keep being asked for while in range, so the
+ * cancel scan only drops those that left the AOI. In the texture cache
+ * they are warm (AOI) and the defaults cold (speculative).
+ *
+ * The local player's own items — active layers and every inventory slot —
+ * are pinned (obj_layers_mgr_pin_atlases) whenever their layer stack or the
+ * inventory changes, so pressure never evicts them for a passer-by.
+ *
+ * Portals are swept like any object. Their destination maps are known
+ * only by code here, not by item sets, so nothing beyond them is warmed.
+ */
+
+/* Run the sweep when due; also right away when the world arrays were
+ * rebuilt. Call once per frame after obj_layers_mgr_begin_frame(). */
+void atlas_prefetch_update(void);
+
+#endif /* CYBERIA_ATLAS_PREFETCH_H */
@@ -0,0 +1,709 @@
+#include "bench_scene.h"
+
+#include "binary_aoi_decoder.h"
+#include "crowd_gen.h"
+#include "game_state.h"
+#include "gpu_memory.h"
+#include "heap_memory.h"
+#include "object_layer.h"
+#include "profiler.h"
+#include "render_queue.h"
+#include "render_stats.h"
+#include "domain/camera.h"
+#include "js/bench_bridge.h"
+#include "network/engine_client.h"
+#include "network/game_client.h"
+#include "network/replication.h"
+#include "network/session_recorder.h"
+#include "ui/inventory_modal.h"
+#include "ui/modal_instance_map.h"
+#include "util/log.h"
+
+#include <cJSON.h>
+#include <raylib.h>
+
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BENCH_ITEM_POOL       16
+#define BENCH_FLOOR_TILE      8
+#define BENCH_AOI_RADIUS      24.0f
+#define BENCH_SELF_ID         "bench-self"
+#define BENCH_DROP_MAX        128
+#define BENCH_LOOT_PERIOD_S   2.0
+#define BENCH_LOOT_LINGER_S   1.2
+#define BENCH_LOOT_LAUNCH_MS  600
+#define BENCH_INVENTORY_STEP_S 0.5
+#define BENCH_IMAP_STEP_S     0.25
+#define BENCH_DROP_MASK (BIN_DELTA_POS | BIN_DELTA_DIMS | BIN_DELTA_DIR_MODE | \
+                         BIN_DELTA_LIFE | BIN_DELTA_LAYERS | BIN_DELTA_STATUS | BIN_DELTA_BOT_META)
+
+typedef enum {
+    BENCH_LOADING,   /* preload stages running on the injected world */
+    BENCH_WARMUP,
+    BENCH_RUN,
+    BENCH_DONE,
+} BenchPhase;
+
+typedef struct {
+    const char* name;
+    int         default_count;
+    bool        inventory;      /* n sizes the player's inventory */
+    bool        capture;        /* world comes from ?capture= */
+    void (*start)(void);
+    bool (*tick)(double t);   /* t: seconds into the run; false once exhausted */
+    void (*stop)(void);
+} BenchScenario;
+
+typedef struct {
+    char    id[MAX_ID_LENGTH];
+    Vector2 landing;
+    int     item;
+} BenchDrop;
+
+static struct {
+    const BenchScenario* scenario;
+    RuntimeBenchConfig   config;
+    BenchPhase           phase;
+    bool                 world_ready;
+    double               phase_at;
+    int                  count;
+    char                 items[BENCH_ITEM_POOL][MAX_ITEM_ID_LENGTH];
+    int                  item_count;
+    uint8_t*             buf;
+    size_t               len;
+    size_t               cap;
+    int                  frames;
+    int                  long_frames;
+} g_bench;
+
+static float s_frame_ms[BENCH_SCENE_MAX_FRAMES];
+static float s_cpu_ms[BENCH_SCENE_MAX_FRAMES];
+static float s_draw_calls[BENCH_SCENE_MAX_FRAMES];
+
+/* ── Frame writer ────────────────────────────────────────────────────── */
+
+static void reserve(size_t n) {
+    if (g_bench.len + n <= g_bench.cap) return;
+    while (g_bench.len + n > g_bench.cap) g_bench.cap = g_bench.cap ? g_bench.cap * 2 : 4096;
+    g_bench.buf = realloc(g_bench.buf, g_bench.cap);
+    assert(g_bench.buf);
+}
+
+static void put_u8(uint8_t v) {
+    reserve(1);
+    g_bench.buf[g_bench.len++] = v;
+}
+
+static void put_u16(uint16_t v) {
+    put_u8((uint8_t)v);
+    put_u8((uint8_t)(v >> 8));
+}
+
+static void put_u32(uint32_t v) {
+    put_u16((uint16_t)v);
+    put_u16((uint16_t)(v >> 16));
+}
+
+static void put_f32(float f) {
+    uint32_t bits;
+    memcpy(&bits, &f, sizeof(bits));
+    put_u32(bits);
+}
+
+static void put_str(const char* s) {
+    size_t n = strlen(s);
+    assert(UINT8_MAX >= n);
+    put_u8((uint8_t)n);
+    reserve(n);
+    memcpy(g_bench.buf + g_bench.len, s, n);
+    g_bench.len += n;
+}
+
+/* Fixed 36-byte, zero-padded id field. */
+static void put_id(const char* id) {
+    char field[36] = { 0 };
+    strncpy(field, id, sizeof(field));
+    reserve(sizeof(field));
+    memcpy(g_bench.buf + g_bench.len, field, sizeof(field));
+    g_bench.len += sizeof(field);
+}
+
+static void put_item_layer(const char* item) {
+    put_u8(1);
+    put_str(item);
+    put_u16(1);
+}
+
+static void inject(void) {
+    game_client_inject_message(g_bench.buf, (uint32_t)g_bench.len, false);
+    g_bench.len = 0;
+}
+
+/* ── Synthetic world ─────────────────────────────────────────────────── */
+
+static Vector2 world_center(void) {
+    return (Vector2){ BENCH_SCENE_GRID / 2.0f, BENCH_SCENE_GRID / 2.0f };
+}
+
+static const char* pool_item(int i) {
+    return g_bench.items[(unsigned)i % (unsigned)g_bench.item_count];
+}
+
+static void parse_items(const char* list) {
+    g_bench.item_count = 0;
+    const char* p = list;
+    while ('\0' != *p && BENCH_ITEM_POOL > g_bench.item_count) {
+        size_t n = strcspn(p, ",");
+        if (0 < n && MAX_ITEM_ID_LENGTH > n) {
+            memcpy(g_bench.items[g_bench.item_count], p, n);
+            g_bench.items[g_bench.item_count++][n] = '\0';
+        }
+        p += n;
+        if (',' == *p) p++;
+    }
+}
+
+/* One entity default listing the pool, so crowd_gen dresses its agents
+ * from it. */
+static void put_init_data(void) {
+    put_u8(BIN_MSG_INIT_DATA);
+    put_u16(BENCH_SCENE_GRID);
+    put_u16(BENCH_SCENE_GRID);
+    put_f32(BENCH_AOI_RADIUS);
+    put_u32(100);      /* sumStatsLimit */
+    put_u8(1);         /* entity defaults */
+    put_str("bench");
+    put_u8((uint8_t)g_bench.item_count);
+    for (int i = 0; i < g_bench.item_count; i++) put_str(g_bench.items[i]);
+    put_u8(0);         /* its dead item ids */
+    put_u8(0);         /* its drop item ids */
+    put_u8(0);         /* dead item ids */
+    put_u16(0);        /* skills */
+    put_u32(0);        /* quests */
+}
+
+static void put_self(int inventory_slots) {
+    Vector2 c = world_center();
+    put_u8(BIN_FLAG_HAS_LIFE);
+    put_id(BENCH_SELF_ID);
+    put_f32(c.x);
+    put_f32(c.y);
+    put_f32(1.0f);
+    put_f32(1.0f);
+    put_u8(0);         /* direction */
+    put_u8(0);         /* mode */
+    put_f32(100.0f);
+    put_f32(100.0f);
+    put_item_layer(pool_item(0));
+    for (int i = 0; i < 4; i++) put_f32(0.0f);   /* AOI rect */
+    put_u8(0);         /* onPortal */
+    put_u16(100);      /* sumStatsLimit */
+    put_u16(0);        /* activeStatsSum */
+    put_str("bench");
+    put_u8(0);         /* path length */
+    put_u16(0);        /* target x, y */
+    put_u16(0);
+    put_str("");       /* active portal */
+    put_u32(0);        /* coins */
+    put_u8((uint8_t)inventory_slots);
+    for (int i = 0; i < inventory_slots; i++) {
+        put_str(pool_item(i));
+        put_u8(0 == i ? 1 : 0);
+        put_u16((uint16_t)(1 + i));
+    }
+    put_u8(0);         /* frozen */
+    put_u8(0);         /* status icon */
+    put_f32(0.0f);     /* move speed: keep the default */
+    put_f32(0.0f);     /* portal hold */
+}
+
+/* Floor tiles over the whole grid, then the local player. */
+static void put_full_aoi(int inventory_slots) {
+    const int side = BENCH_SCENE_GRID / BENCH_FLOOR_TILE;
+    put_u8(BIN_MSG_FULL_AOI);
+    put_u32(1);
+    put_u32(0);
+    put_u16((uint16_t)(side * side));
+    for (int i = 0; i < side * side; i++) {
+        char id[MAX_ID_LENGTH];
+        snprintf(id, sizeof(id), "bench-floor-%04d", i);
+        put_u8(BIN_ENTITY_FLOOR);
+        put_id(id);
+        put_f32((float)(i % side * BENCH_FLOOR_TILE));
+        put_f32((float)(i / side * BENCH_FLOOR_TILE));
+        put_f32((float)BENCH_FLOOR_TILE);
+        put_f32((float)BENCH_FLOOR_TILE);
+        put_u8(0);
+        put_u8(0);
+        put_item_layer(BENCH_SCENE_FLOOR_ITEM);
+    }
+    put_self(inventory_slots);
+}
+
+static void begin_delta(uint16_t count) {
+    put_u8(BIN_MSG_AOI_DELTA);
+    put_u32((uint32_t)session_last_server_tick());
+    put_u32((uint32_t)session_last_acked_input_sequence());
+    put_u16(count);
+}
+
+/* Orbit of `radius` cells around the world centre, one lap per `period`. */
+static Vector2 orbit(double t, float radius, double period) {
+    float a = (float)(6.283185307 * t / period);
+    Vector2 c = world_center();
+    return (Vector2){ c.x + radius * cosf(a), c.y + radius * 0.6f * sinf(a) };
+}
+
+/* ── Scenario: crowd ─────────────────────────────────────────────────── */
+
+static void crowd_start(void) {
+    CrowdGenConfig config = CROWD_GEN_DEFAULTS;
+    config.bots    = g_bench.count * 3 / 4;
+    config.players = g_bench.count - config.bots;
+    crowd_gen_start(&config);
+}
+
+static bool crowd_tick(double t) {
+    camera_set_override(orbit(t, 8.0f, 10.0));
+    return true;
+}
+
+static void crowd_stop(void) { crowd_gen_stop(); }
+
+/* ── Scenario: loot ──────────────────────────────────────────────────── */
+
+static struct {
+    BenchDrop drops[BENCH_DROP_MAX];
+    int       count;
+    uint32_t  serial;
+    uint32_t  rng;
+    double    next_burst;
+    double    collect_at;
+} s_loot;
+
+static float loot_unit(void) {
+    uint32_t x = s_loot.rng;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    s_loot.rng = x;
+    return (float)(x >> 8) / 16777216.0f;
+}
+
+/* Drop tokens enter as bots with the "drop" behavior, then each launches
+ * from a corpse next to the player to its rest cell. */
+static void loot_burst(void) {
+    Vector2 origin = world_center();
+    origin.x += 2.0f;
+    s_loot.count = g_bench.count < BENCH_DROP_MAX ? g_bench.count : BENCH_DROP_MAX;
+    for (int i = 0; i < s_loot.count; i++) {
+        BenchDrop* d = &s_loot.drops[i];
+        snprintf(d->id, sizeof(d->id), "bench-drop-%08u", (unsigned)++s_loot.serial);
+        float a = 6.2831853f * loot_unit();
+        float r = 1.0f + 5.0f * sqrtf(loot_unit());
+        d->landing = (Vector2){ origin.x + r * cosf(a), origin.y + r * sinf(a) };
+        d->item    = (int)s_loot.serial;
+    }
+
+    begin_delta((uint16_t)s_loot.count);
+    for (int i = 0; i < s_loot.count; i++) {
+        const BenchDrop* d = &s_loot.drops[i];
+        put_u8(BIN_ENTITY_BOT);
+        put_id(d->id);
+        put_u8(BENCH_DROP_MASK);
+        put_f32(d->landing.x - 0.5f);
+        put_f32(d->landing.y - 0.5f);
+        put_f32(1.0f);
+        put_f32(1.0f);
+        put_u8(0);
+        put_u8(MODE_IDLE);
+        put_f32(1.0f);
+        put_f32(1.0f);
+        put_item_layer(pool_item(d->item));
+        put_u16(0);    /* stats sum */
+        put_u8(0);     /* status icon */
+        put_str("drop");
+        put_str("");   /* caster */
+        put_u8(0);     /* interaction flags */
+        put_str("");   /* action code */
+        put_u8(0);     /* quest codes */
+        put_u8(0);     /* talk codes */
+    }
+    inject();
+
+    for (int i = 0; i < s_loot.count; i++) {
+        const BenchDrop* d = &s_loot.drops[i];
+        put_u8(BIN_MSG_DROP_SPAWN);
+        put_id(d->id);
+        put_f32(origin.x);
+        put_f32(origin.y);
+        put_f32(d->landing.x);
+        put_f32(d->landing.y);
+        put_u16(BENCH_LOOT_LAUNCH_MS);
+        put_str(pool_item(d->item));
+        inject();
+    }
+}
+
+/* The player collects every token, which then leaves the AOI. */
+static void loot_collect(void) {
+    for (int i = 0; i < s_loot.count; i++) {
+        const BenchDrop* d = &s_loot.drops[i];
+        put_u8(BIN_MSG_DROP_COLLECT);
+        put_id(d->id);
+        put_id(BENCH_SELF_ID);
+        put_f32(d->landing.x);
+        put_f32(d->landing.y);
+        put_str(pool_item(d->item));
+        inject();
+    }
+    begin_delta((uint16_t)s_loot.count);
+    for (int i = 0; i < s_loot.count; i++) {
+        put_u8(BIN_ENTITY_BOT | BIN_FLAG_REMOVED);
+        put_id(s_loot.drops[i].id);
+    }
+    inject();
+    s_loot.count = 0;
+}
+
+static void loot_start(void) {
+    s_loot.count      = 0;
+    s_loot.rng        = 0x9E3779B9u;
+    s_loot.next_burst = GetTime();
+}
+
+static bool loot_tick(double t) {
+    double now = GetTime();
+    if (0 < s_loot.count && now >= s_loot.collect_at) loot_collect();
+    if (0 == s_loot.count && now >= s_loot.next_burst) {
+        loot_burst();
+        s_loot.collect_at = now + BENCH_LOOT_LINGER_S;
+        s_loot.next_burst = now + BENCH_LOOT_PERIOD_S;
+    }
+    camera_set_override(orbit(t, 1.5f, 6.0));
+    return true;
+}
+
+static void loot_stop(void) {
+    if (0 < s_loot.count) loot_collect();
+}
+
+/* ── Scenario: inventory ─────────────────────────────────────────────── */
+
+static struct {
+    int    slot;
+    double next_step;
+} s_inventory;
+
+static void inventory_start(void) {
+    s_inventory.slot      = 0;
+    s_inventory.next_step = GetTime() + BENCH_INVENTORY_STEP_S;
+    inventory_modal_open(0);
+}
+
+static bool inventory_tick(double t) {
+    double now = GetTime();
+    int slots  = g_game_state.full_inventory_count;
+    if (0 < slots && now >= s_inventory.next_step) {
+        s_inventory.slot      = (s_inventory.slot + 1) % slots;
+        s_inventory.next_step = now + BENCH_INVENTORY_STEP_S;
+        if (inventory_modal_is_open()) inventory_modal_switch_slot(s_inventory.slot);
+        else                           inventory_modal_open(s_inventory.slot);
+    }
+    camera_set_override(orbit(t, 4.0f, 12.0));
+    return true;
+}
+
+static void inventory_stop(void) { inventory_modal_close(); }
+
+/* ── Scenario: instance map ──────────────────────────────────────────── */
+
+static double s_imap_next_step;
+
+static void imap_start(void) {
+    if (!modal_instance_map_is_open()) modal_instance_map_toggle();
+    s_imap_next_step = GetTime();
+}
+
+/* Zoom in for two seconds, out for two, panning along a circle. */
+static bool imap_tick(double t) {
+    double now = GetTime();
+    if (now >= s_imap_next_step) {
+        s_imap_next_step = now + BENCH_IMAP_STEP_S;
+        float a = (float)(t * 1.5);
+        float zoom = 2.0 > fmod(t, 4.0) ? 1.1f : 1.0f / 1.1f;
+        modal_instance_map_nudge((Vector2){ 24.0f * cosf(a), 24.0f * sinf(a) }, zoom);
+    }
+    camera_set_override(world_center());
+    return true;
+}
+
+static void imap_stop(void) { modal_instance_map_close(); }
+
+/* ── Scenario: replay ────────────────────────────────────────────────── */
+
+typedef struct {
+    uint8_t*      data;
+    uint32_t      size;
+    SessionReader reader;
+    SessionRecord next;
+    bool          has_next;
+    double        origin_ms;   /* capture time replayed at the run start; <0 before */
+} BenchReplay;
+
+static BenchReplay s_replay;
+
+static bool replay_pull(void) {
+    while ((s_replay.has_next = session_reader_next(&s_replay.reader, &s_replay.next))) {
+        SessionRecordKind kind = s_replay.next.kind;
+        if (SESSION_RECORD_WS_BINARY == kind || SESSION_RECORD_WS_TEXT == kind) return true;
+    }
+    return false;
+}
+
+static void replay_inject_next(void) {
+    game_client_inject_message(s_replay.next.data, s_replay.next.length,
+                               SESSION_RECORD_WS_TEXT == s_replay.next.kind);
+}
+
+uint8_t* bench_scene_capture_buffer(uint32_t size) {
+    free(s_replay.data);
+    s_replay.data = malloc(size ? size : 1);
+    s_replay.size = s_replay.data ? size : 0;
+    return s_replay.data;
+}
+
+static void publish_failure(const char* reason);
+
+/* Everything up to the first full frame goes in at once, so the preload
+ * sees a world; the rest follows the capture clock once the run starts. */
+void bench_scene_capture_loaded(int size) {
+    if (0 > size || !s_replay.data ||
+        !session_reader_init(&s_replay.reader, s_replay.data, (size_t)size)) {
+        LOG_ERROR("[BENCH] capture %s unreadable", g_bench.config.capture_url);
+        publish_failure("capture unreadable");
+        return;
+    }
+    while (replay_pull()) {
+        bool full = SESSION_RECORD_WS_BINARY == s_replay.next.kind && 0 < s_replay.next.length &&
+                    BIN_MSG_FULL_AOI == s_replay.next.data[0];
+        replay_inject_next();
+        if (full && g_game_state.init_received) break;
+    }
+    replay_pull();
+    g_bench.world_ready = true;
+    LOG_INFO("[BENCH] capture loaded: %d bytes", size);
+}
+
+static void replay_start(void) {
+    s_replay.origin_ms = -1.0;
+}
+
+static bool replay_tick(double t) {
+    if (0.0 > s_replay.origin_ms) {
+        s_replay.origin_ms = (s_replay.has_next ? s_replay.next.t_ms : 0.0) - t * 1000.0;
+    }
+    double until = s_replay.origin_ms + t * 1000.0;
+    while (s_replay.has_next && s_replay.next.t_ms <= until) {
+        replay_inject_next();
+        replay_pull();
+    }
+    return s_replay.has_next;
+}
+
+static void replay_stop(void) {
+    free(s_replay.data);
+    s_replay = (BenchReplay){ 0 };
+}
+
+static const BenchScenario kScenarios[] = {
+    { "crowd",     200, false, false, crowd_start,     crowd_tick,     crowd_stop     },
+    { "loot",      40,  false, false, loot_start,      loot_tick,      loot_stop      },
+    { "inventory", 12,  true,  false, inventory_start, inventory_tick, inventory_stop },
+    { "imap",      1,   false, false, imap_start,      imap_tick,      imap_stop      },
+    { "replay",    0,   false, true,  replay_start,    replay_tick,    replay_stop    },
+};
+
+/* ── Report ──────────────────────────────────────────────────────────── */
+
+static int cmp_float(const void* a, const void* b) {
+    float x = *(const float*)a, y = *(const float*)b;
+    return (x > y) - (x < y);
+}
+
+/* Sorts `v` in place. */
+static void add_distribution(cJSON* parent, const char* key, float* v, int n) {
+    cJSON* o = cJSON_AddObjectToObject(parent, key);
+    if (0 >= n) return;
+    qsort(v, (size_t)n, sizeof(*v), cmp_float);
+    double sum = 0.0;
+    for (int i = 0; i < n; i++) sum += v[i];
+    cJSON_AddNumberToObject(o, "mean", sum / n);
+    cJSON_AddNumberToObject(o, "p50", v[(n - 1) * 50 / 100]);
+    cJSON_AddNumberToObject(o, "p95", v[(n - 1) * 95 / 100]);
+    cJSON_AddNumberToObject(o, "p99", v[(n - 1) * 99 / 100]);
+    cJSON_AddNumberToObject(o, "max", v[n - 1]);
+}
+
+static void publish(cJSON* report) {
+    char* json = cJSON_PrintUnformatted(report);
+    if (json) bench_bridge_publish(json, g_bench.config.report_url);
+    free(json);
+    cJSON_Delete(report);
+    g_bench.phase = BENCH_DONE;
+}
+
+static cJSON* report_begin(void) {
+    cJSON* report = cJSON_CreateObject();
+    cJSON_AddStringToObject(report, "scenario", g_bench.scenario ? g_bench.scenario->name
+                                                                 : g_bench.config.scenario);
+    cJSON_AddNumberToObject(report, "n", g_bench.count);
+    cJSON_AddNumberToObject(report, "width", GetScreenWidth());
+    cJSON_AddNumberToObject(report, "height", GetScreenHeight());
+    return report;
+}
+
+static void publish_failure(const char* reason) {
+    cJSON* report = report_begin();
+    cJSON_AddStringToObject(report, "error", reason);
+    publish(report);
+}
+
+static void publish_report(double seconds) {
+    cJSON* report = report_begin();
+    cJSON_AddNumberToObject(report, "frames", g_bench.frames);
+    cJSON_AddNumberToObject(report, "seconds", seconds);
+    cJSON_AddNumberToObject(report, "longFrames", g_bench.long_frames);
+    add_distribution(report, "frameMs", s_frame_ms, g_bench.frames);
+    add_distribution(report, "cpuMs", s_cpu_ms, g_bench.frames);
+    add_distribution(report, "drawCalls", s_draw_calls, g_bench.frames);
+
+    cJSON* gl = cJSON_AddObjectToObject(report, "webgl");
+    const char* pass_names[] = { "world", "ui", "other" };
+    for (int p = 0; p < RENDER_PASS_COUNT; p++) {
+        RenderPassStats pass = render_stats_pass((RenderPass)p);
+        cJSON* o = cJSON_AddObjectToObject(gl, pass_names[p]);
+        cJSON_AddNumberToObject(o, "drawCalls", pass.gpu[RENDER_GPU_DRAW_CALLS]);
+        cJSON_AddNumberToObject(o, "textureSwitches", pass.gpu[RENDER_GPU_TEXTURE_SWITCHES]);
+        cJSON_AddNumberToObject(o, "vertices", pass.gpu[RENDER_GPU_VERTICES]);
+    }
+
+    cJSON* mem = cJSON_AddObjectToObject(report, "memory");
+    cJSON_AddNumberToObject(mem, "heapLive", (double)heap_memory_live_total());
+    cJSON_AddNumberToObject(mem, "heapPeak", (double)heap_memory_peak_total());
+    cJSON_AddNumberToObject(mem, "gpu", (double)gpu_memory_used());
+
+    cJSON* world = cJSON_AddObjectToObject(report, "world");
+    cJSON_AddNumberToObject(world, "players", g_game_state.other_player_count);
+    cJSON_AddNumberToObject(world, "bots", g_game_state.bot_count);
+
+#if CYBERIA_PROFILE
+    cJSON* zones = cJSON_AddObjectToObject(report, "zones");
+    for (int z = 0; z < PROF_ZONE_COUNT; z++) {
+        ProfilerZoneStats st = profiler_zone_stats((ProfilerZone)z);
+        cJSON* o = cJSON_AddObjectToObject(zones, profiler_zone_name((ProfilerZone)z));
+        cJSON_AddNumberToObject(o, "p50", st.p50_ms);
+        cJSON_AddNumberToObject(o, "p95", st.p95_ms);
+        cJSON_AddNumberToObject(o, "p99", st.p99_ms);
+    }
+#endif
+    publish(report);
+    LOG_INFO("[BENCH] %s done: %d frames in %.1fs", g_bench.scenario->name, g_bench.frames, seconds);
+}
+
+/* ── Run ─────────────────────────────────────────────────────────────── */
+
+bool bench_scene_start(const RuntimeBenchConfig* config) {
+    assert(config);
+    const BenchScenario* scenario = NULL;
+    for (size_t i = 0; i < sizeof(kScenarios) / sizeof(kScenarios[0]); i++) {
+        if (0 == strcmp(kScenarios[i].name, config->scenario)) scenario = &kScenarios[i];
+    }
+    if (!scenario) {
+        if ('\0' != config->scenario[0]) LOG_ERROR("[BENCH] unknown scenario '%s'", config->scenario);
+        return false;
+    }
+    if (scenario->capture && '\0' == config->capture_url[0]) {
+        LOG_ERROR("[BENCH] replay needs ?capture=<url>");
+        return false;
+    }
+
+    g_bench.scenario = scenario;
+    g_bench.config   = *config;
+    g_bench.count    = 0 < config->count ? config->count : scenario->default_count;
+    if (scenario->inventory && MAX_OBJECT_LAYERS < g_bench.count) {
+        g_bench.count = MAX_OBJECT_LAYERS;
+    }
+    if (0.0f >= g_bench.config.seconds) g_bench.config.seconds = BENCH_SCENE_SECONDS;
+    parse_items(config->items);
+    if (0 == g_bench.item_count) parse_items(BENCH_SCENE_DEFAULT_ITEMS);
+    g_bench.phase = BENCH_LOADING;
+    game_client_set_offline(true);
+
+    if (scenario->capture) {
+        bench_bridge_fetch_capture(config->capture_url);
+    } else {
+        put_init_data();
+        inject();
+        put_full_aoi(scenario->inventory ? g_bench.count : g_bench.item_count);
+        inject();
+        g_bench.world_ready = true;
+    }
+    LOG_INFO("[BENCH] %s n=%d for %.1fs, %d item ids", scenario->name, g_bench.count,
+             g_bench.config.seconds, g_bench.item_count);
+    return true;
+}
+
+bool bench_scene_active(void) { return NULL != g_bench.scenario; }
+
+bool bench_scene_world_ready(void) { return g_bench.world_ready; }
+
+static void finish(void) {
+    double seconds = GetTime() - g_bench.phase_at;
+    g_bench.scenario->stop();
+    camera_clear_override();
+    publish_report(seconds);
+}
+
+void bench_scene_tick(void) {
+    if (!g_bench.scenario || BENCH_DONE == g_bench.phase) return;
+    double now = GetTime();
+    switch (g_bench.phase) {
+        case BENCH_LOADING:
+            g_bench.phase    = BENCH_WARMUP;
+            g_bench.phase_at = now;
+            g_bench.scenario->start();
+            break;
+        case BENCH_WARMUP: {
+            double waited = now - g_bench.phase_at;
+            if ((BENCH_SCENE_WARMUP_S <= waited && 0 == fetch_pending_count()) ||
+                BENCH_SCENE_WARMUP_MAX_S <= waited) {
+                g_bench.phase    = BENCH_RUN;
+                g_bench.phase_at = now;
+            }
+            break;
+        }
+        case BENCH_RUN: {
+            double t = now - g_bench.phase_at;
+            bool more = g_bench.scenario->tick(t);
+            if (!more || t >= (double)g_bench.config.seconds) finish();
+            break;
+        }
+        case BENCH_DONE:
+            break;
+    }
+}
+
+void bench_scene_frame_end(double cpu_ms) {
+    if (!g_bench.scenario || BENCH_RUN != g_bench.phase) return;
+    int i = g_bench.frames++;
+    s_frame_ms[i]   = GetFrameTime() * 1000.0f;
+    s_cpu_ms[i]     = (float)cpu_ms;
+    s_draw_calls[i] = (float)render_queue_stats().draw_calls;
+    if (BENCH_SCENE_LONG_FRAME_MS < s_frame_ms[i]) g_bench.long_frames++;
+    if (BENCH_SCENE_MAX_FRAMES <= g_bench.frames) finish();
+}
@@ -0,0 +1,89 @@
+#ifndef CYBERIA_BENCH_SCENE_H
+#define CYBERIA_BENCH_SCENE_H
+
+#include "runtime_config.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* bench_scene — scripted, server-less benchmark runs.
+ *
+ * Opening the page with ?bench=<scenario> replaces the session: no socket
+ * is opened (game_client_set_offline), and a synthetic INIT_DATA plus one
+ * FULL_AOI (BENCH_SCENE_GRID² cells of floor tiles, the local player at the
+ * centre) go through game_client_inject_message() as if a server had sent
+ * them, so the preload stages and every decode path run unchanged. Assets
+ * still come from the engine API.
+ *
+ * Scenarios (?n= sizes each; the default is in brackets):
+ *   crowd      crowd_gen.h players + bots around the player [200]
+ *   loot       bursts of drop tokens launched, idled and collected [40]
+ *   inventory  the inventory modal open, stepping through n slots [24]
+ *   imap       the instance map open, panning and zooming [1]
+ *   replay     a session capture (?capture=<url>, session_recorder.h)
+ *              re-injected on its own timeline; fetch records are skipped
+ * Items worn by the synthetic world come from ?items= (comma separated),
+ * else BENCH_SCENE_DEFAULT_ITEMS.
+ *
+ * Once gameplay starts the scenario warms up until the fetch queue is idle
+ * (at most BENCH_SCENE_WARMUP_MAX_S), then drives its camera path for
+ * ?seconds= and samples every frame: frame interval, main-loop CPU time and
+ * render-queue draw calls. The report — their percentiles, long frames,
+ * heap and GPU high-water, WebGL counters and (profile builds) zone
+ * percentiles — is a JSON object published by bench_bridge.h. */
+
+#ifndef BENCH_SCENE_GRID
+#define BENCH_SCENE_GRID 64
+#endif
+
+#ifndef BENCH_SCENE_DEFAULT_ITEMS
+#define BENCH_SCENE_DEFAULT_ITEMS "anon,purple"
+#endif
+
+#ifndef BENCH_SCENE_FLOOR_ITEM
+#define BENCH_SCENE_FLOOR_ITEM "floor-grass"
+#endif
+
+#ifndef BENCH_SCENE_SECONDS
+#define BENCH_SCENE_SECONDS 20.0f
+#endif
+
+#ifndef BENCH_SCENE_WARMUP_S
+#define BENCH_SCENE_WARMUP_S 2.0
+#endif
+
+#ifndef BENCH_SCENE_WARMUP_MAX_S
+#define BENCH_SCENE_WARMUP_MAX_S 15.0
+#endif
+
+#ifndef BENCH_SCENE_MAX_FRAMES
+#define BENCH_SCENE_MAX_FRAMES 4096
+#endif
+
+#ifndef BENCH_SCENE_LONG_FRAME_MS
+#define BENCH_SCENE_LONG_FRAME_MS 50.0f
+#endif
+
+/* Start the scenario `config` names, before the main loop is installed;
+ * false (and nothing started) when it names none. */
+bool bench_scene_start(const RuntimeBenchConfig* config);
+
+bool bench_scene_active(void);
+
+/* True once the synthetic (or captured) world has been injected, i.e. the
+ * preload may treat the connection stage as done. */
+bool bench_scene_world_ready(void);
+
+/* Drive the scenario: world frames, UI and camera path. Call once per
+ * main-loop iteration after game_client_on_tick(). */
+void bench_scene_tick(void);
+
+/* Sample the frame just rendered; `cpu_ms` is the main-loop body's wall
+ * time. Publishes the report when the run ends. */
+void bench_scene_frame_end(double cpu_ms);
+
+/* Capture download for "replay" (bench_bridge.h). */
+uint8_t* bench_scene_capture_buffer(uint32_t size);
+void     bench_scene_capture_loaded(int size);
+
+#endif /* CYBERIA_BENCH_SCENE_H */
@@ -8,10 +8,27 @@
 
 #include "binary_aoi_decoder.h"
 
+#include "client_context.h"
+#include "domain/equip_txn.h"
 #include "domain/local_player.h"
+#include "domain/presentation_runtime.h"
+#include "entity_index.h"
 #include "game_state.h"
+#include "hash_table.h"
+#include "id_intern.h"
+#include "js/interact_bridge.h"
+#include "layer_stack.h"
+#include "message_parser.h"
 #include "network/game_client.h"
+#include "network/replication.h"
+#include "network/wire_compress.h"
+#include "object_layers_management.h"
+#include "serial.h"
+#include "spatial_grid.h"
+#include "static_world.h"
+#include "ui/instance_map_data.h"
 #include "ui/loot_fx.h"
+#include "ui/ui_state.h"
 #include "util/log.h"
 
 #include <assert.h>
@@ -32,17 +49,58 @@ static inline int br_remaining(const BinReader* r) {
     return (r->pos < r->len) ? (int)(r->len - r->pos) : 0;
 }
 
+/* True when the next `n` bytes are inside the message. */
+static inline bool br_has(const BinReader* r, size_t n) {
+    return r->pos <= r->len && n <= r->len - r->pos;
+}
+
+/* Step over `n` bytes; a skip past the end parks the reader at it. */
+static inline void br_skip(BinReader* r, size_t n) {
+    r->pos = br_has(r, n) ? r->pos + n : r->len;
+}
+
+/* Validated-span readers: no bounds check, for fields a br_has() over the
+ * whole fixed-size run has already covered. The memcpy loads compile to
+ * plain unaligned loads on wasm32 and x86-64, both little-endian like the
+ * wire. */
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+#error "binary AOI readers assume a little-endian target"
+#endif
+
+static inline uint8_t brx_u8(BinReader* r) {
+    return r->data[r->pos++];
+}
+
+static inline uint16_t brx_u16(BinReader* r) {
+    uint16_t v;
+    memcpy(&v, r->data + r->pos, sizeof(v));
+    r->pos += sizeof(v);
+    return v;
+}
+
+static inline uint32_t brx_u32(BinReader* r) {
+    uint32_t v;
+    memcpy(&v, r->data + r->pos, sizeof(v));
+    r->pos += sizeof(v);
+    return v;
+}
+
+static inline float brx_f32(BinReader* r) {
+    float f;
+    memcpy(&f, r->data + r->pos, sizeof(f));
+    r->pos += sizeof(f);
+    return f;
+}
+
+/* Checked readers: a short read yields 0 and parks the reader at the end. */
 static inline uint8_t br_u8(BinReader* r) {
     if (r->pos >= r->len) return 0;
-    return r->data[r->pos++];
+    return brx_u8(r);
 }
 
 static inline uint16_t br_u16(BinReader* r) {
-    if (r->pos + 2 > r->len) { r->pos = r->len; return 0; }
-    uint16_t v = (uint16_t)r->data[r->pos]
-               | ((uint16_t)r->data[r->pos + 1] << 8);
-    r->pos += 2;
-    return v;
+    if (!br_has(r, 2)) { r->pos = r->len; return 0; }
+    return brx_u16(r);
 }
 
 static inline int16_t br_i16(BinReader* r) {
@@ -50,31 +108,19 @@ static inline int16_t br_i16(BinReader* r) {
 }
 
 static inline uint32_t br_u32(BinReader* r) {
-    if (r->pos + 4 > r->len) { r->pos = r->len; return 0; }
-    uint32_t v = (uint32_t)r->data[r->pos]
-               | ((uint32_t)r->data[r->pos + 1] << 8)
-               | ((uint32_t)r->data[r->pos + 2] << 16)
-               | ((uint32_t)r->data[r->pos + 3] << 24);
-    r->pos += 4;
-    return v;
+    if (!br_has(r, 4)) { r->pos = r->len; return 0; }
+    return brx_u32(r);
 }
 
 static inline float br_f32(BinReader* r) {
-    if (r->pos + 4 > r->len) { r->pos = r->len; return 0.0f; }
-    uint32_t bits = (uint32_t)r->data[r->pos]
-                  | ((uint32_t)r->data[r->pos + 1] << 8)
-                  | ((uint32_t)r->data[r->pos + 2] << 16)
-                  | ((uint32_t)r->data[r->pos + 3] << 24);
-    r->pos += 4;
-    float f;
-    memcpy(&f, &bits, sizeof(f));
-    return f;
+    if (!br_has(r, 4)) { r->pos = r->len; return 0.0f; }
+    return brx_f32(r);
 }
 
 /* Read a fixed 36-byte ID field into dst (null-terminated). */
 static inline void br_id(BinReader* r, char* dst, size_t dst_size) {
     size_t copy_len = 36;
-    if (r->pos + copy_len > r->len) { r->pos = r->len; dst[0] = '\0'; return; }
+    if (!br_has(r, copy_len)) { r->pos = r->len; dst[0] = '\0'; return; }
     if (copy_len >= dst_size) copy_len = dst_size - 1;
     memcpy(dst, r->data + r->pos, copy_len);
     dst[copy_len] = '\0';
@@ -85,202 +131,331 @@ static inline void br_id(BinReader* r, char* dst, size_t dst_size) {
     r->pos += 36;
 }
 
+/* br_id + intern: entity ids become session handles as they come off the wire. */
+static inline IdHandle br_id_interned(BinReader* r, char* dst, size_t dst_size) {
+    br_id(r, dst, dst_size);
+    return id_intern(dst);
+}
+
 /* Read a length-prefixed string (1-byte len). */
 static inline void br_string(BinReader* r, char* dst, size_t dst_size) {
     uint8_t slen = br_u8(r);
-    if (r->pos + slen > r->len) { r->pos = r->len; dst[0] = '\0'; return; }
+    if (!br_has(r, slen)) { r->pos = r->len; dst[0] = '\0'; return; }
     size_t copy_len = (slen < dst_size - 1) ? slen : dst_size - 1;
     memcpy(dst, r->data + r->pos, copy_len);
     dst[copy_len] = '\0';
     r->pos += slen;
 }
 
-/* ── Previous-position snapshot — preserves interpolation across AOI resets ──
- *
- * binary_aoi_process() snapshots gs->bots / gs->other_players into these
- * static buffers BEFORE resetting the gs counters, so each decoded entity
- * can recover its prior server position for smooth interpolation.
+/* Read a length-prefixed string (2-byte len), for item descriptions. */
+static inline void br_string16(BinReader* r, char* dst, size_t dst_size) {
+    uint16_t slen = br_u16(r);
+    if (!br_has(r, slen)) { r->pos = r->len; dst[0] = '\0'; return; }
+    size_t copy_len = (slen < dst_size - 1) ? slen : dst_size - 1;
+    memcpy(dst, r->data + r->pos, copy_len);
+    dst[copy_len] = '\0';
+    r->pos += slen;
+}
+
+/* Compact kinematics (BIN_FLAG_QUANTIZED): u16 fixed point over the grid
+ * extent for positions, 8.8 cells for dims. */
+static inline float q_coord(uint16_t v, float grid_extent) {
+    return (float)v * (grid_extent * (1.0f / 65536.0f));
+}
+
+static inline float q_dim(uint16_t v) {
+    return (float)v * (1.0f / 256.0f);
+}
+
+#define BIN_KINEMATICS_FULL_SIZE  18   /* f32 × 4, u8 dir, u8 mode */
+#define BIN_KINEMATICS_QHEAD_SIZE 5    /* u16 × 2, u8 packed */
+#define BIN_KINEMATICS_QDIMS_SIZE 4    /* u16 × 2 */
+
+/* Kinematics prefix of an entity block. Checked once for its fixed size,
+ * then read unchecked; a truncated block reads as zeros, like the checked
+ * readers would give. */
+static AoiKinematics read_kinematics(BinReader* r, uint8_t flags) {
+    AoiKinematics k = { .has_dims = true };
+    if (0 == (flags & BIN_FLAG_QUANTIZED)) {
+        if (!br_has(r, BIN_KINEMATICS_FULL_SIZE)) { r->pos = r->len; return k; }
+        k.pos.x     = brx_f32(r);
+        k.pos.y     = brx_f32(r);
+        k.dims.x    = brx_f32(r);
+        k.dims.y    = brx_f32(r);
+        k.direction = brx_u8(r);
+        k.mode      = brx_u8(r);
+        return k;
+    }
+    if (!br_has(r, BIN_KINEMATICS_QHEAD_SIZE)) { r->pos = r->len; return k; }
+    k.pos.x = q_coord(brx_u16(r), (float)g_game_state.grid_w);
+    k.pos.y = q_coord(brx_u16(r), (float)g_game_state.grid_h);
+    uint8_t packed = brx_u8(r);
+    k.direction = packed & 0x0F;
+    k.mode      = (packed >> 4) & 0x03;
+    k.has_dims  = 0 != (packed & BIN_QPACK_HAS_DIMS);
+    if (k.has_dims) {
+        if (!br_has(r, BIN_KINEMATICS_QDIMS_SIZE)) { r->pos = r->len; return k; }
+        k.dims.x = q_dim(brx_u16(r));
+        k.dims.y = q_dim(brx_u16(r));
+    }
+    return k;
+}
+
+/* ── Carried state across full frames ─────────────────────────────
  *
- * Reset on init_data so a server restart never carries a stale UUID into
- * a new session (which would otherwise resolve to the sentinel and cause
- * the entity to fly in from origin).
+ * A full frame updates each listed player/bot in its existing slot. Its
+ * block schema rewrites every wire-owned field in place, while the prior
+ * server position, dims and snapshot history carry interpolation across;
+ * game_state_end_entity_sweep() then drops the slots the frame did not
+ * list.
  */
 
-typedef struct { char id[MAX_ID_LENGTH]; Vector2 pos_server; bool found; } PrevPos;
+typedef struct {
+    Vector2         pos_server;
+    Vector2         dims;
+    SnapshotHistory history;
+} PrevPos;
+
+/* Generation of the full frame being decoded (game_state_begin_entity_sweep). */
+static uint32_t s_frame_generation;
+
+/* Apply decoded kinematics to a freshly acquired slot. Dims omitted by a
+ * quantized block carry over from the prior snapshot, else the hinted default. */
+static void apply_kinematics(EntityState* e, const AoiKinematics* k, const PrevPos* prev) {
+    /* Skip interpolation when the entity is TELEPORTING — that mode is a
+     * one-snapshot signal from the server that the entity just jumped
+     * position (portal), so lerping from the old position would produce a
+     * visible cross-map sweep. */
+    bool jump = (k->mode == MODE_TELEPORTING || NULL == prev);
+    e->pos_prev = jump ? k->pos : prev->pos_server;
+    e->pos_server = k->pos;
+    if (prev) e->history = prev->history;
+    interpolation_record_snapshot(e, jump);
+    if (k->has_dims)   e->dims = k->dims;
+    else if (prev)     e->dims = prev->dims;
+    else               e->dims = (Vector2){ presentation_runtime_default_obj_width(),
+                                            presentation_runtime_default_obj_height() };
+    e->direction = (Direction)k->direction;
+    e->mode = (ObjectLayerMode)k->mode;
+}
 
-static PrevPos s_prev_bots[MAX_ENTITIES];
-static int     s_prev_bot_count = 0;
-static PrevPos s_prev_players[MAX_ENTITIES];
-static int     s_prev_player_count = 0;
+/* Stamp a slot for this frame's block. A slot touched before (last_update
+ * set) hands its carried state over to apply_kinematics. Nothing else is
+ * cleared: the block's schema rewrites every field it owns, and the rest
+ * (ref, interp_pos, layers_version) must survive the frame. */
+static void place_entity(EntityState* e, const AoiKinematics* k) {
+    bool    had  = 0.0 != e->last_update;
+    PrevPos prev = {
+        .pos_server = e->pos_server,
+        .dims       = e->dims,
+        .history    = e->history,
+    };
+
+    const GameState* gs = &g_game_state;
+    e->handle          = id_intern(e->id);
+    e->seen_generation = s_frame_generation;
+    apply_kinematics(e, k, had ? &prev : NULL);
+    e->last_update   = gs->last_update_time;
+    e->snapshot_time = gs->last_update_time;
+}
 
-/* lookup_prev_server_pos — return the previous server position for `id`
- * if it appeared in the prior snapshot; otherwise return `fallback` so the
- * caller can keep pos_prev == pos_server (no interpolation jump on first
- * appearance / post-reconnect / AOI entry). */
-static Vector2 lookup_prev_server_pos(const PrevPos* arr, int n,
-                                      const char* id, Vector2 fallback) {
-    for (int k = 0; k < n; k++) {
-        if (strcmp(arr[k].id, id) == 0) return arr[k].pos_server;
-    }
-    return fallback;
+PlayerState* binary_aoi_place_player(const char* id, const AoiKinematics* k) {
+    assert(id && k);
+    PlayerState* p = game_state_acquire_player(id, entity_index_hash(id));
+    if (NULL == p) return NULL;
+    place_entity(&p->base, k);
+    return p;
+}
+
+BotState* binary_aoi_place_bot(const char* id, const AoiKinematics* k) {
+    assert(id && k);
+    BotState* b = game_state_acquire_bot(id, entity_index_hash(id));
+    if (NULL == b) return NULL;
+    place_entity(&b->base, k);
+    return b;
 }
 
+/* Session item dictionary (BIN_MSG_ITEM_DICT): index → id, interned handle
+ * and hash, filled as the server announces ids. Cleared with the previous
+ * snapshots, i.e. with the interner whose handles it holds. */
+typedef struct {
+    IdHandle handle;
+    uint64_t hash;
+    char     id[MAX_ITEM_ID_LENGTH];
+} DictItem;
+
+static struct {
+    int      count;   /* indices [0, count) have been announced */
+    DictItem items[BIN_ITEM_DICT_MAX];
+} s_item_dict;
+
+/* Rarely-changing self-player sections are fingerprinted over their wire
+ * bytes (FNV-1a); a section whose bytes match the previous snapshot's is
+ * stepped over instead of decoded. 0 means "none yet". */
+static struct {
+    uint64_t layers;
+    uint64_t path;
+    uint64_t inventory;
+} s_self_hash;
+
 /* Called from message_parser when init_data arrives (handshake or
  * reconnect).  Ensures we never carry pre-restart entity UUIDs into the
  * fresh session. */
 void binary_aoi_reset_prev_snapshots(void) {
-    s_prev_bot_count = 0;
-    s_prev_player_count = 0;
+    memset(&s_self_hash, 0, sizeof(s_self_hash));
+    s_item_dict.count = 0;
+    game_state_clear_remote_entities();
 }
 
 /* ── Item ID list reader (IDs only — no active/quantity) ───────── */
 
+/* Layer lists carry u16 dictionary indices once the server acked the cap. */
+static bool item_dict_on(void) {
+    return 0 != (g_game_state.wire_ack_caps & WIRE_CAP_ITEM_DICT);
+}
+
+static int decode_item_dict(BinReader* r) {
+    uint16_t first = br_u16(r);
+    uint16_t count = br_u16(r);
+    for (uint16_t i = 0; i < count; i++) {
+        char id[MAX_ITEM_ID_LENGTH];
+        br_string(r, id, sizeof(id));
+        int idx = (int)first + i;
+        if (BIN_ITEM_DICT_MAX <= idx) continue;
+        DictItem* e = &s_item_dict.items[idx];
+        memcpy(e->id, id, sizeof(id));
+        e->handle = id_intern(id);
+        e->hash   = hash_table_hash(id);
+        if (s_item_dict.count <= idx) s_item_dict.count = idx + 1;
+    }
+    if ((int)first + count > BIN_ITEM_DICT_MAX) {
+        LOG_WARN("[BINARY_AOI] ItemDict: indices past %d dropped", BIN_ITEM_DICT_MAX);
+    }
+    return 0;
+}
+
+static const DictItem* dict_item(uint16_t idx) {
+    return (idx < s_item_dict.count) ? &s_item_dict.items[idx] : NULL;
+}
+
 static void skip_item_ids(BinReader* r) {
     uint8_t count = br_u8(r);
+    if (item_dict_on()) {
+        br_skip(r, (size_t)count * 4); /* u16 index, u16 qty */
+        return;
+    }
     for (int i = 0; i < (int)count; i++) {
-        uint8_t slen = br_u8(r);
-        r->pos += slen;
-        r->pos += 2; /* qty u16 */
+        br_skip(r, (size_t)br_u8(r) + 2); /* itemId, qty u16 */
     }
 }
 
-static int read_item_ids(BinReader* r, ObjectLayerState* layers, int max_layers) {
-    uint8_t count = br_u8(r);
-    int n = (count < max_layers) ? count : max_layers;
-    for (int i = 0; i < n; i++) {
-        br_string(r, layers[i].item_id, MAX_ITEM_ID_LENGTH);
-        layers[i].active = true;
-        layers[i].quantity = (int)br_u16(r); /* quantity now carried on wire */
+static uint64_t wire_hash(const BinReader* r, size_t start) {
+    size_t end = (r->pos < r->len) ? r->pos : r->len;
+    uint64_t h = 14695981039346656037ull;
+    for (size_t i = start; i < end; i++) {
+        h ^= r->data[i];
+        h *= 1099511628211ull;
     }
-    /* Skip any excess items we couldn't store */
-    for (int i = n; i < (int)count; i++) {
-        uint8_t slen = br_u8(r);
-        r->pos += slen; /* skip itemId */
-        r->pos += 2;    /* skip quantity u16 */
-    }
-    return n;
+    return h ? h : 1;
 }
 
-/* ── Entity block readers ──────────────────────────────────────── */
+/* Step over a section with `skip`. True when its bytes hash to *last, with
+ * the reader left past it; otherwise the reader is rewound for a full
+ * decode and *last takes the new hash. */
+static bool section_unchanged(BinReader* r, void (*skip)(BinReader*), uint64_t* last) {
+    size_t start = r->pos;
+    skip(r);
+    uint64_t h = wire_hash(r, start);
+    if (h == *last) return true;
+    *last = h;
+    r->pos = start;
+    return false;
+}
 
-static void decode_player_entity(BinReader* r, uint8_t flags) {
-    GameState* gs = &g_game_state;
-    char id[MAX_ID_LENGTH];
-    br_id(r, id, sizeof(id));
+/* layers_version is the stack's layer_stack id: never 0, so a zeroed record
+ * never matches a cached render recipe by accident, and shared by every
+ * record wearing the same stack. */
+
+/* Read an item-id list into layers[0..MAX_OBJECT_LAYERS); re-interns
+ * *version when the active item set differs from what the record held. */
+void binary_aoi_store_layers(ObjectLayerState* layers, int* count, uint32_t* version,
+                             const ObjectLayerState* src, int n) {
+    assert(layers && count && version);
+    assert(src || 0 == n);
+    if (n > MAX_OBJECT_LAYERS) n = MAX_OBJECT_LAYERS;
+    bool changed = (n != *count);
+    for (int i = 0; i < n; i++) {
+        changed = changed || src[i].item_handle != layers[i].item_handle ||
+                  src[i].active != layers[i].active;
+        layers[i] = src[i];
+    }
+    *count = n;
+    if (changed) { *version = layer_stack_intern(layers, *count); }
+}
 
-    float px = br_f32(r);
-    float py = br_f32(r);
-    float dw = br_f32(r);
-    float dh = br_f32(r);
-    uint8_t dir = br_u8(r);
-    uint8_t mode = br_u8(r);
-
-    /* Find or allocate slot */
-    int idx = -1;
-    for (int i = 0; i < gs->other_player_count; i++) {
-        if (strcmp(gs->other_players[i].base.id, id) == 0) {
-            idx = i;
-            break;
+static void read_layer_list(BinReader* r, uint8_t wire_count, ObjectLayerState* layers,
+                            int* count, uint32_t* version) {
+    int n = (wire_count < MAX_OBJECT_LAYERS) ? wire_count : MAX_OBJECT_LAYERS;
+    bool changed = (n != *count);
+    if (item_dict_on()) {
+        /* Fixed 4 bytes per entry: one check covers the whole list, and a
+         * truncated one leaves the record as it was. */
+        if (!br_has(r, (size_t)wire_count * 4)) { r->pos = r->len; return; }
+        for (int i = 0; i < n; i++) {
+            const DictItem* e = dict_item(brx_u16(r));
+            IdHandle item = e ? e->handle : ID_HANDLE_NONE;
+            changed = changed || item != layers[i].item_handle || !layers[i].active;
+            if (item != layers[i].item_handle) {
+                memcpy(layers[i].item_id, e ? e->id : "", e ? sizeof(e->id) : 1);
+                layers[i].item_hash = e ? e->hash : 0;
+            }
+            layers[i].item_handle = item;
+            layers[i].active = true;
+            layers[i].quantity = (int)brx_u16(r);
         }
+        br_skip(r, (size_t)(wire_count - n) * 4);
+        *count = n;
+        if (changed) { *version = layer_stack_intern(layers, *count); }
+        return;
     }
-    if (idx < 0) {
-        if (gs->other_player_count >= MAX_ENTITIES) return;
-        idx = gs->other_player_count++;
-        memset(&gs->other_players[idx], 0, sizeof(PlayerState));
-        strncpy(gs->other_players[idx].base.id, id, MAX_ID_LENGTH - 1);
-    }
-
-    PlayerState* p = &gs->other_players[idx];
-    /* Fall back to the *new* server position so first-seen / post-reconnect
-     * entities don't lerp from origin.  Also skip interpolation when the
-     * entity is TELEPORTING — that mode is a one-snapshot signal from the
-     * server that the entity just jumped position (portal), so lerping from
-     * the old position would produce a visible cross-map sweep. */
-    Vector2 incoming = (Vector2){ px, py };
-    p->base.pos_prev = (mode == MODE_TELEPORTING)
-        ? incoming
-        : lookup_prev_server_pos(s_prev_players, s_prev_player_count, id, incoming);
-    p->base.pos_server = incoming;
-    p->base.dims = (Vector2){ dw, dh };
-    p->base.direction = (Direction)dir;
-    p->base.mode = (ObjectLayerMode)mode;
-    p->base.last_update = gs->last_update_time;
-    p->base.snapshot_time = gs->last_update_time;
-
-    if (flags & BIN_FLAG_HAS_LIFE) {
-        p->base.life = br_f32(r);
-        p->base.max_life = br_f32(r);
+    for (int i = 0; i < n; i++) {
+        br_string(r, layers[i].item_id, MAX_ITEM_ID_LENGTH);
+        IdHandle item = id_intern(layers[i].item_id);
+        changed = changed || item != layers[i].item_handle || !layers[i].active;
+        if (item != layers[i].item_handle || 0 == layers[i].item_hash) {
+            layers[i].item_hash = hash_table_hash(layers[i].item_id);
+        }
+        layers[i].item_handle = item;
+        layers[i].active = true;
+        layers[i].quantity = (int)br_u16(r); /* quantity now carried on wire */
     }
-    if (flags & BIN_FLAG_HAS_RESPAWN) {
-        p->base.respawn_in = br_f32(r);
-    } else {
-        p->base.respawn_in = 0.0f;
+    /* Skip any excess items we couldn't store */
+    for (int i = n; i < (int)wire_count; i++) {
+        br_skip(r, (size_t)br_u8(r) + 2); /* skip itemId, quantity u16 */
     }
-    p->base.object_layer_count = read_item_ids(
-        r, p->base.object_layers, MAX_OBJECT_LAYERS);
-    p->base.stats_sum = (int)br_u16(r);
-    p->base.status_icon = br_u8(r);  /* Entity Status Indicator */
+    *count = n;
+    if (changed) { *version = layer_stack_intern(layers, *count); }
 }
 
-static void decode_bot_entity(BinReader* r, uint8_t flags) {
-    GameState* gs = &g_game_state;
-    char id[MAX_ID_LENGTH];
-    br_id(r, id, sizeof(id));
+static void read_layers(BinReader* r, ObjectLayerState* layers, int* count, uint32_t* version) {
+    read_layer_list(r, br_u8(r), layers, count, version);
+}
 
-    float px = br_f32(r);
-    float py = br_f32(r);
-    float dw = br_f32(r);
-    float dh = br_f32(r);
-    uint8_t dir = br_u8(r);
-    uint8_t mode = br_u8(r);
-
-    int idx = -1;
-    for (int i = 0; i < gs->bot_count; i++) {
-        if (strcmp(gs->bots[i].base.id, id) == 0) {
-            idx = i;
-            break;
-        }
-    }
-    if (idx < 0) {
-        if (gs->bot_count >= MAX_ENTITIES) return;
-        idx = gs->bot_count++;
-        memset(&gs->bots[idx], 0, sizeof(BotState));
-        strncpy(gs->bots[idx].base.id, id, MAX_ID_LENGTH - 1);
-    }
-
-    BotState* b = &gs->bots[idx];
-    Vector2 incoming = (Vector2){ px, py };
-    /* Same TELEPORTING guard as decode_player_entity — bots don't use portals
-     * today but the protocol allows it, so handle it defensively. */
-    b->base.pos_prev = (mode == MODE_TELEPORTING)
-        ? incoming
-        : lookup_prev_server_pos(s_prev_bots, s_prev_bot_count, id, incoming);
-    b->base.pos_server = incoming;
-    b->base.dims = (Vector2){ dw, dh };
-    b->base.direction = (Direction)dir;
-    b->base.mode = (ObjectLayerMode)mode;
-    b->base.last_update   = gs->last_update_time;
-    b->base.snapshot_time = gs->last_update_time;
+/* World objects take their stack from the shared layer pool, sized to the
+ * wire count. */
+static void read_object_layers(BinReader* r, WorldObject* o) {
+    uint8_t wire_count = br_u8(r);
+    int n = (wire_count < MAX_OBJECT_LAYERS) ? wire_count : MAX_OBJECT_LAYERS;
+    o->object_layers = game_state_alloc_layers(n);
+    read_layer_list(r, wire_count, o->object_layers, &o->object_layer_count, &o->layers_version);
+}
 
-    if (flags & BIN_FLAG_HAS_LIFE) {
-        b->base.life = br_f32(r);
-        b->base.max_life = br_f32(r);
-    }
-    if (flags & BIN_FLAG_HAS_RESPAWN) {
-        b->base.respawn_in = br_f32(r);
-    } else {
-        b->base.respawn_in = 0.0f;
-    }
-    if (flags & BIN_FLAG_HAS_BEHAVIOR) {
-        br_string(r, b->behavior, MAX_BEHAVIOR_LENGTH);
-    }
-    b->base.object_layer_count = read_item_ids(
-        r, b->base.object_layers, MAX_OBJECT_LAYERS);
-    br_string(r, b->caster_id, MAX_ID_LENGTH);
-    b->base.stats_sum = (int)br_u16(r);
-    b->base.status_icon = br_u8(r);       /* presence lifecycle icon */
-    b->interaction_flags = br_u8(r);      /* INTERACTION_FLAG_* capability bits */
-    br_string(r, b->action_code, MAX_ID_LENGTH);
+/* ── Entity block readers ──────────────────────────────────────── */
+
+/* Quest codes this NPC provides, then the pending quest-talk dialogue codes
+ * parallel to them: entry i is non-empty when quest_codes[i] has an
+ * incomplete talk objective mapped by this NPC's action. */
+static void read_bot_quests(BinReader* r, BotState* b) {
     uint8_t qn = br_u8(r);
     b->quest_code_count = 0;
     for (uint8_t i = 0; i < qn; i++) {
@@ -290,9 +465,6 @@ static void decode_bot_entity(BinReader* r, uint8_t flags) {
             memcpy(b->quest_codes[b->quest_code_count++], code, MAX_ID_LENGTH);
         }
     }
-    /* Pending quest-talk dialogue codes, parallel to quest_codes: entry i is
-     * non-empty when quest_codes[i] has an incomplete talk objective mapped by
-     * this NPC's action. */
     uint8_t tn = br_u8(r);
     for (uint8_t i = 0; i < tn; i++) {
         char code[MAX_ID_LENGTH];
@@ -306,70 +478,96 @@ static void decode_bot_entity(BinReader* r, uint8_t flags) {
     }
 }
 
-static void decode_floor_entity(BinReader* r, uint8_t flags) {
-    GameState* gs = &g_game_state;
+/* Schema rows (AOI_SCHEMA_*) as straight-line reads into `rec`. Flag-gated
+ * fields fall back to zero / "" when absent, so a reused slot never keeps
+ * last frame's value. */
+#define AOI_DECODE_LIFE(m, a)                                           \
+    if (flags & BIN_FLAG_HAS_LIFE) { rec->m = br_f32(r); rec->a = br_f32(r); } \
+    else                           { rec->m = 0.0f;      rec->a = 0.0f; }
+#define AOI_DECODE_RESPAWN(m, a)                                        \
+    rec->m = (flags & BIN_FLAG_HAS_RESPAWN) ? br_f32(r) : 0.0f;
+#define AOI_DECODE_BEHAVIOR(m, a)                                       \
+    if (flags & BIN_FLAG_HAS_BEHAVIOR) br_string(r, rec->m, a);         \
+    else                               rec->m[0] = '\0';
+#define AOI_DECODE_LAYERS(m, a)                                         \
+    read_layers(r, rec->m.object_layers, &rec->m.object_layer_count, &rec->m.layers_version);
+#define AOI_DECODE_CASTER(m, a)                                         \
+    br_string(r, rec->m, sizeof(rec->m));                               \
+    rec->a = id_intern(rec->m);
+#define AOI_DECODE_STRING(m, a) br_string(r, rec->m, a);
+#define AOI_DECODE_U16(m, a)    rec->m = (int)br_u16(r);
+#define AOI_DECODE_U8(m, a)     rec->m = br_u8(r);
+#define AOI_DECODE_QUESTS(m, a) read_bot_quests(r, rec);
+#define AOI_DECODE_FIELD(op, m, a) AOI_DECODE_##op(m, a)
+
+static void decode_player_entity(BinReader* r, uint8_t flags) {
     char id[MAX_ID_LENGTH];
     br_id(r, id, sizeof(id));
 
-    float px = br_f32(r);
-    float py = br_f32(r);
-    float dw = br_f32(r);
-    float dh = br_f32(r);
-    br_u8(r); /* direction — unused for floors */
-    br_u8(r); /* mode      — unused for floors */
+    AoiKinematics k = read_kinematics(r, flags);
+    PlayerState* rec = binary_aoi_place_player(id, &k);
+    if (NULL == rec) return;
+    AOI_SCHEMA_PLAYER(AOI_DECODE_FIELD)
+}
 
+static void decode_bot_entity(BinReader* r, uint8_t flags) {
+    char id[MAX_ID_LENGTH];
+    br_id(r, id, sizeof(id));
+
+    AoiKinematics k = read_kinematics(r, flags);
+    BotState* rec = binary_aoi_place_bot(id, &k);
+    if (NULL == rec) return;
+    AOI_SCHEMA_BOT(AOI_DECODE_FIELD)
+}
+
+static void decode_floor_entity(BinReader* r, uint8_t flags) {
+    GameState* gs = &g_game_state;
+    char id[MAX_ID_LENGTH];
+    IdHandle handle = br_id_interned(r, id, sizeof(id));
+
+    AoiKinematics k = read_kinematics(r, 0);   /* world objects: full floats */
+    float px = k.pos.x, py = k.pos.y, dw = k.dims.x, dh = k.dims.y;
 
-    if (gs->floor_count >= MAX_OBJECTS) { skip_item_ids(r); return; }
-    int idx = gs->floor_count++;
-    WorldObject* f = &gs->floors[idx];
-    memset(f, 0, sizeof(WorldObject));
+    int idx;
+    WorldObject* f = game_state_append_world_object(OBJECT_LAYER_TYPE_FLOOR, &idx);
+    if (NULL == f) { skip_item_ids(r); return; }
     strncpy(f->id, id, MAX_ID_LENGTH - 1);
+    f->handle = handle;
     f->pos  = (Vector2){ px, py };
     f->dims = (Vector2){ dw, dh };
-    f->type_kind = OBJECT_LAYER_TYPE_FLOOR;
     strncpy(f->type, "floor", MAX_TYPE_LENGTH - 1);
+    spatial_grid_insert(&gs->floor_grid, idx, (Rectangle){ px, py, dw, dh });
 
-    f->object_layer_count = read_item_ids(
-        r, f->object_layers, MAX_OBJECT_LAYERS);
+    read_object_layers(r, f);
 }
 
 static void decode_obstacle_entity(BinReader* r, uint8_t flags) {
     GameState* gs = &g_game_state;
     char id[MAX_ID_LENGTH];
-    br_id(r, id, sizeof(id));
-
-    float px = br_f32(r);
-    float py = br_f32(r);
-    float dw = br_f32(r);
-    float dh = br_f32(r);
-    br_u8(r); /* direction */
-    br_u8(r); /* mode */
+    IdHandle handle = br_id_interned(r, id, sizeof(id));
 
+    AoiKinematics k = read_kinematics(r, 0);   /* world objects: full floats */
+    float px = k.pos.x, py = k.pos.y, dw = k.dims.x, dh = k.dims.y;
 
-    if (gs->obstacle_count >= MAX_OBJECTS) { skip_item_ids(r); return; }
-    int idx = gs->obstacle_count++;
-    WorldObject* o = &gs->obstacles[idx];
-    memset(o, 0, sizeof(WorldObject));
+    int idx;
+    WorldObject* o = game_state_append_world_object(OBJECT_LAYER_TYPE_OBSTACLE, &idx);
+    if (NULL == o) { skip_item_ids(r); return; }
     strncpy(o->id, id, MAX_ID_LENGTH - 1);
+    o->handle = handle;
     o->pos  = (Vector2){ px, py };
     o->dims = (Vector2){ dw, dh };
-    o->type_kind = OBJECT_LAYER_TYPE_OBSTACLE;
     strncpy(o->type, "obstacle", MAX_TYPE_LENGTH - 1);
-    o->object_layer_count = read_item_ids(
-        r, o->object_layers, MAX_OBJECT_LAYERS);
+    spatial_grid_insert(&gs->obstacle_grid, idx, (Rectangle){ px, py, dw, dh });
+    read_object_layers(r, o);
 }
 
 static void decode_portal_entity(BinReader* r, uint8_t flags) {
     GameState* gs = &g_game_state;
     char id[MAX_ID_LENGTH];
-    br_id(r, id, sizeof(id));
+    IdHandle handle = br_id_interned(r, id, sizeof(id));
 
-    float px = br_f32(r);
-    float py = br_f32(r);
-    float dw = br_f32(r);
-    float dh = br_f32(r);
-    br_u8(r); /* direction */
-    br_u8(r); /* mode */
+    AoiKinematics k = read_kinematics(r, 0);   /* world objects: full floats */
+    float px = k.pos.x, py = k.pos.y, dw = k.dims.x, dh = k.dims.y;
 
     uint8_t status_icon = br_u8(r);     /* presence icon (ESI 10 for portals) */
     char target_map[MAX_ID_LENGTH];
@@ -377,47 +575,40 @@ static void decode_portal_entity(BinReader* r, uint8_t flags) {
     int16_t target_cell_x = br_i16(r);
     int16_t target_cell_y = br_i16(r);
 
-    if (gs->portal_count >= MAX_OBJECTS) { skip_item_ids(r); return; }
-    int idx = gs->portal_count++;
-    WorldObject* p = &gs->portals[idx];
-    memset(p, 0, sizeof(WorldObject));
+    int idx;
+    WorldObject* p = game_state_append_world_object(OBJECT_LAYER_TYPE_PORTAL, &idx);
+    if (NULL == p) { skip_item_ids(r); return; }
     strncpy(p->id, id, MAX_ID_LENGTH - 1);
+    p->handle = handle;
     p->pos  = (Vector2){ px, py };
     p->dims = (Vector2){ dw, dh };
-    p->type_kind = OBJECT_LAYER_TYPE_PORTAL;
     strncpy(p->type, "portal", MAX_TYPE_LENGTH - 1);
+    spatial_grid_insert(&gs->portal_grid, idx, (Rectangle){ px, py, dw, dh });
     p->status_icon = status_icon;
     strncpy(p->target_map_code, target_map, MAX_ID_LENGTH - 1);
     p->target_cell_x = (int)target_cell_x;
     p->target_cell_y = (int)target_cell_y;
-    p->object_layer_count = read_item_ids(
-        r, p->object_layers, MAX_OBJECT_LAYERS);
+    read_object_layers(r, p);
 }
 
 static void decode_foreground_entity(BinReader* r, uint8_t flags) {
     GameState* gs = &g_game_state;
     char id[MAX_ID_LENGTH];
-    br_id(r, id, sizeof(id));
-
-    float px = br_f32(r);
-    float py = br_f32(r);
-    float dw = br_f32(r);
-    float dh = br_f32(r);
-    br_u8(r); /* direction */
-    br_u8(r); /* mode */
+    IdHandle handle = br_id_interned(r, id, sizeof(id));
 
+    AoiKinematics k = read_kinematics(r, 0);   /* world objects: full floats */
+    float px = k.pos.x, py = k.pos.y, dw = k.dims.x, dh = k.dims.y;
 
-    if (gs->foreground_count >= MAX_OBJECTS) { skip_item_ids(r); return; }
-    int idx = gs->foreground_count++;
-    WorldObject* fg = &gs->foregrounds[idx];
-    memset(fg, 0, sizeof(WorldObject));
+    int idx;
+    WorldObject* fg = game_state_append_world_object(OBJECT_LAYER_TYPE_FOREGROUND, &idx);
+    if (NULL == fg) { skip_item_ids(r); return; }
     strncpy(fg->id, id, MAX_ID_LENGTH - 1);
+    fg->handle = handle;
     fg->pos  = (Vector2){ px, py };
     fg->dims = (Vector2){ dw, dh };
-    fg->type_kind = OBJECT_LAYER_TYPE_FOREGROUND;
     strncpy(fg->type, "foreground", MAX_TYPE_LENGTH - 1);
-    fg->object_layer_count = read_item_ids(
-        r, fg->object_layers, MAX_OBJECT_LAYERS);
+    spatial_grid_insert(&gs->foreground_grid, idx, (Rectangle){ px, py, dw, dh });
+    read_object_layers(r, fg);
 }
 
 /* ── Static decorator decoder ──────────────────────────────────── */
@@ -425,26 +616,21 @@ static void decode_foreground_entity(BinReader* r, uint8_t flags) {
 static void decode_static_entity(BinReader* r, uint8_t flags) {
     GameState* gs = &g_game_state;
     char id[MAX_ID_LENGTH];
-    br_id(r, id, sizeof(id));
+    IdHandle handle = br_id_interned(r, id, sizeof(id));
+
+    AoiKinematics k = read_kinematics(r, 0);   /* world objects: full floats */
+    float px = k.pos.x, py = k.pos.y, dw = k.dims.x, dh = k.dims.y;
 
-    float px = br_f32(r);
-    float py = br_f32(r);
-    float dw = br_f32(r);
-    float dh = br_f32(r);
-    br_u8(r); /* direction — unused for statics */
-    br_u8(r); /* mode      — unused for statics */
-
-    if (gs->static_count >= MAX_ENTITIES) { skip_item_ids(r); return; }
-    int idx = gs->static_count++;
-    WorldObject* st = &gs->statics[idx];
-    memset(st, 0, sizeof(WorldObject));
+    int idx;
+    WorldObject* st = game_state_append_world_object(OBJECT_LAYER_TYPE_STATIC, &idx);
+    if (NULL == st) { skip_item_ids(r); return; }
     strncpy(st->id, id, MAX_ID_LENGTH - 1);
+    st->handle = handle;
     st->pos  = (Vector2){ px, py };
     st->dims = (Vector2){ dw, dh };
-    st->type_kind = OBJECT_LAYER_TYPE_STATIC;
     strncpy(st->type, "static", MAX_TYPE_LENGTH - 1);
-    st->object_layer_count = read_item_ids(
-        r, st->object_layers, MAX_OBJECT_LAYERS);
+    spatial_grid_insert(&gs->static_grid, idx, (Rectangle){ px, py, dw, dh });
+    read_object_layers(r, st);
 }
 
 /* ── Resource entity decoder ───────────────────────────────────── */
@@ -452,53 +638,50 @@ static void decode_static_entity(BinReader* r, uint8_t flags) {
 static void decode_resource_entity(BinReader* r, uint8_t flags) {
     GameState* gs = &g_game_state;
     char id[MAX_ID_LENGTH];
-    br_id(r, id, sizeof(id));
+    IdHandle handle = br_id_interned(r, id, sizeof(id));
+
+    AoiKinematics k = read_kinematics(r, 0);   /* resources: full floats */
+    float px = k.pos.x, py = k.pos.y, dw = k.dims.x, dh = k.dims.y;
+
+    int idx;
+    BotState* rec = game_state_append_resource(&idx);
+    if (NULL == rec) return;
+    strncpy(rec->base.id, id, MAX_ID_LENGTH - 1);
+    rec->base.handle = handle;
+
+    rec->base.pos_server = (Vector2){ px, py };
+    rec->base.pos_prev = rec->base.pos_server;
+    rec->base.interp_pos = rec->base.pos_server; /* static — no interpolation */
+    rec->base.dims = (Vector2){ dw, dh };
+    spatial_grid_insert(&gs->resource_grid, idx, (Rectangle){ px, py, dw, dh });
+    rec->base.direction = (Direction)k.direction;
+    rec->base.mode = (ObjectLayerMode)k.mode;
+    rec->base.last_update   = gs->last_update_time;
+    rec->base.snapshot_time = gs->last_update_time;
+
+    AOI_SCHEMA_RESOURCE(AOI_DECODE_FIELD)
+    strncpy(rec->behavior, "resource", MAX_BEHAVIOR_LENGTH - 1);
+}
 
-    float px = br_f32(r);
-    float py = br_f32(r);
-    float dw = br_f32(r);
-    float dh = br_f32(r);
-    uint8_t dir = br_u8(r);
-    uint8_t mode = br_u8(r);
-
-    if (gs->resource_count >= MAX_ENTITIES) return;
-    int idx = gs->resource_count++;
-    BotState* res = &gs->resources[idx];
-    memset(res, 0, sizeof(BotState));
-    strncpy(res->base.id, id, MAX_ID_LENGTH - 1);
-
-    res->base.pos_server = (Vector2){ px, py };
-    res->base.pos_prev = res->base.pos_server;
-    res->base.interp_pos = res->base.pos_server; /* static — no interpolation */
-    res->base.dims = (Vector2){ dw, dh };
-    res->base.direction = (Direction)dir;
-    res->base.mode = (ObjectLayerMode)mode;
-    res->base.last_update   = gs->last_update_time;
-    res->base.snapshot_time = gs->last_update_time;
+/* ── Self-player decoder ───────────────────────────────────────── */
 
-    if (flags & BIN_FLAG_HAS_LIFE) {
-        res->base.life = br_f32(r);
-        res->base.max_life = br_f32(r);
-    }
-    if (flags & BIN_FLAG_HAS_RESPAWN) {
-        res->base.respawn_in = br_f32(r);
-    } else {
-        res->base.respawn_in = 0.0f;
-    }
-    res->base.object_layer_count = read_item_ids(
-        r, res->base.object_layers, MAX_OBJECT_LAYERS);
-    res->base.stats_sum = (int)br_u16(r);  /* sum of active-layer stats */
-    res->base.status_icon = br_u8(r);
-    strncpy(res->behavior, "resource", MAX_BEHAVIOR_LENGTH - 1);
+static void skip_self_path(BinReader* r) {
+    uint8_t path_len = br_u8(r);
+    br_skip(r, ((size_t)path_len + 1) * 4); /* i16 pairs, + the targetPos pair */
 }
 
-/* ── Self-player decoder ───────────────────────────────────────── */
+static void skip_inventory(BinReader* r) {
+    uint8_t count = br_u8(r);
+    for (int i = 0; i < (int)count; i++) {
+        br_skip(r, (size_t)br_u8(r) + 3); /* itemId, active u8, quantity u16 */
+    }
+}
 
 static void decode_self_player(BinReader* r, uint8_t flags) {
     GameState* gs = &g_game_state;
     PlayerState* p = &gs->player;
 
-    br_id(r, p->base.id, MAX_ID_LENGTH);
+    p->base.handle = br_id_interned(r, p->base.id, MAX_ID_LENGTH);
     strncpy(gs->player_id, p->base.id, MAX_ID_LENGTH - 1);
 
     p->base.pos_prev = p->base.pos_server;
@@ -520,8 +703,9 @@ static void decode_self_player(BinReader* r, uint8_t flags) {
     } else {
         p->base.respawn_in = 0.0f;
     }
-    p->base.object_layer_count = read_item_ids(
-        r, p->base.object_layers, MAX_OBJECT_LAYERS);
+    if (!section_unchanged(r, skip_item_ids, &s_self_hash.layers)) {
+        read_layers(r, p->base.object_layers, &p->base.object_layer_count, &p->base.layers_version);
+    }
 
     /* Extended self-player fields */
     /* AOI rect — for debug rendering */
@@ -533,34 +717,49 @@ static void decode_self_player(BinReader* r, uint8_t flags) {
     /* onPortal — authoritative portal-occupancy flag for the local player. */
     bool on_portal = (br_u8(r) != 0);
 
-    /* sumStatsLimit */
-    gs->sum_stats_limit = (int)br_u16(r);
-
-    /* activeStatsSum */
-    gs->active_stats_sum = (int)br_u16(r);
+    /* sumStatsLimit, activeStatsSum */
+    int stats_limit = (int)br_u16(r);
+    int stats_sum   = (int)br_u16(r);
+    if (stats_limit != gs->sum_stats_limit || stats_sum != gs->active_stats_sum) {
+        gs->sum_stats_limit  = stats_limit;
+        gs->active_stats_sum = stats_sum;
+        gs->stats_version++;
+    }
     /* Mirror to self-entity for uniform overhead UI access */
     p->base.stats_sum = (gs->active_stats_sum < gs->sum_stats_limit)
         ? gs->active_stats_sum : gs->sum_stats_limit;
 
     /* mapCode — length-prefixed string */
-    br_string(r, p->map_code, MAX_ID_LENGTH);
-
-    /* path */
-    uint8_t path_len = br_u8(r);
-    p->path_count = (path_len > MAX_PATH_POINTS) ? MAX_PATH_POINTS : path_len;
-    for (int i = 0; i < p->path_count; i++) {
-        p->path[i].x = (float)br_i16(r);
-        p->path[i].y = (float)br_i16(r);
-    }
-    /* Skip excess path points if any */
-    for (int i = p->path_count; i < (int)path_len; i++) {
-        br_i16(r);
-        br_i16(r);
+    char map_code[MAX_ID_LENGTH];
+    br_string(r, map_code, sizeof(map_code));
+    if (0 != strcmp(map_code, p->map_code)) {
+        memcpy(p->map_code, map_code, sizeof(map_code));
+        gs->map_version++;
     }
 
-    /* targetPos */
-    p->target_pos.x = (float)br_i16(r);
-    p->target_pos.y = (float)br_i16(r);
+    /* path + targetPos — kept only for the dev overlay, skipped otherwise */
+    if (!presentation_runtime_dev_ui()) {
+        skip_self_path(r);
+        s_self_hash.path = 0;
+    } else if (!section_unchanged(r, skip_self_path, &s_self_hash.path)) {
+        uint8_t path_len = br_u8(r);
+        Vector2 path[MAX_PATH_POINTS];
+        int n = (path_len > MAX_PATH_POINTS) ? MAX_PATH_POINTS : path_len;
+        for (int i = 0; i < n; i++) {
+            path[i].x = (float)br_i16(r);
+            path[i].y = (float)br_i16(r);
+        }
+        /* Skip excess path points if any */
+        for (int i = n; i < (int)path_len; i++) {
+            br_i16(r);
+            br_i16(r);
+        }
+        Vector2 target;
+        target.x = (float)br_i16(r);
+        target.y = (float)br_i16(r);
+        local_player_set_debug_path(path, n, target);
+        gs->path_version++;
+    }
 
     /* activePortalID — skip (not used by client renderer) */
     char portal_id_buf[MAX_ID_LENGTH];
@@ -570,24 +769,37 @@ static void decode_self_player(BinReader* r, uint8_t flags) {
     gs->player_coins = (int)br_u32(r);
 
     /* Full inventory — ALL ObjectLayers (active + inactive) with quantities.
-     * Powered by writeFullInventory on the server; used by inventory_bar. */
-    {
+     * Powered by writeFullInventory on the server; used by inventory_bar.
+     * inventory_version moves only when a slot actually changed, so the
+     * inventory view model rebuilds on real edits, not on every snapshot.
+     * Slots of an equip transaction in flight keep their optimistic flag
+     * (equip_txn.h). */
+    if (!section_unchanged(r, skip_inventory, &s_self_hash.inventory)) {
         uint8_t inv_count = br_u8(r);
         int ni = (inv_count < MAX_OBJECT_LAYERS) ? (int)inv_count : MAX_OBJECT_LAYERS;
+        bool changed = ni != gs->full_inventory_count;
         for (int i = 0; i < ni; i++) {
-            br_string(r, gs->full_inventory[i].item_id, MAX_ITEM_ID_LENGTH);
-            gs->full_inventory[i].active   = (br_u8(r) != 0);
-            gs->full_inventory[i].quantity = (int)br_u16(r);
+            ObjectLayerState* slot = &gs->full_inventory[i];
+            char item_id[MAX_ITEM_ID_LENGTH];
+            br_string(r, item_id, MAX_ITEM_ID_LENGTH);
+            bool active  = equip_txn_overlay(item_id, br_u8(r) != 0);
+            int quantity = (int)br_u16(r);
+            if (0 != strcmp(slot->item_id, item_id) || slot->active != active ||
+                slot->quantity != quantity) {
+                memcpy(slot->item_id, item_id, strlen(item_id) + 1);
+                slot->active   = active;
+                slot->quantity = quantity;
+                changed = true;
+            }
         }
         /* Skip excess slots we couldn't store */
         for (int i = ni; i < (int)inv_count; i++) {
-            uint8_t slen = br_u8(r);
-            r->pos += slen; /* skip itemId  */
-            r->pos += 1;    /* skip active  */
-            r->pos += 2;    /* skip quantity */
+            br_skip(r, (size_t)br_u8(r) + 3); /* skip itemId, active, quantity */
         }
         gs->full_inventory_count = ni;
+        if (changed) gs->inventory_version++;
     }
+    equip_txn_settle(GetTime());
 
     /* FrozenInteractionState — u8 (0 = normal, 1 = frozen).
      * Authoritative flag from the Go server. */
@@ -611,8 +823,515 @@ static void decode_self_player(BinReader* r, uint8_t flags) {
     local_player_set_portal_hold(on_portal, portal_hold);
 }
 
+/* ── Delta patch decoder ───────────────────────────────────────── */
+
+/* Patch one remote player/bot in place. Only the fields named in the mask are
+ * read; pos_prev comes straight from the slot's own pos_server, so delta
+ * frames need no prev-position snapshot. */
+static int decode_delta_entity(BinReader* r, uint8_t flags) {
+    GameState* gs = &g_game_state;
+    uint8_t etype = flags & 0x07;
+    char id[MAX_ID_LENGTH];
+    IdHandle handle = br_id_interned(r, id, sizeof(id));
+
+    if (etype != BIN_ENTITY_PLAYER && etype != BIN_ENTITY_BOT) {
+        LOG_ERROR("[BINARY_AOI] Delta block for entity type %d at offset %zu", etype, r->pos);
+        return -1;
+    }
+    if (flags & BIN_FLAG_REMOVED) {
+        if (etype == BIN_ENTITY_PLAYER) game_state_remove_player(id);
+        else                            game_state_remove_bot(id);
+        return 0;
+    }
+
+    uint8_t mask = br_u8(r);
+    /* The fixed-size fields ahead of the layer list are checked as one span
+     * and read unchecked below. */
+    bool   quantized = 0 != (flags & BIN_FLAG_QUANTIZED);
+    size_t span      = ((mask & BIN_DELTA_POS)      ? (quantized ? 4u : 8u) : 0u) +
+                       ((mask & BIN_DELTA_DIMS)     ? 8u : 0u) +
+                       ((mask & BIN_DELTA_DIR_MODE) ? 2u : 0u) +
+                       ((mask & BIN_DELTA_LIFE)     ? 8u : 0u) +
+                       ((mask & BIN_DELTA_RESPAWN)  ? 4u : 0u);
+    if (!br_has(r, span)) {
+        LOG_ERROR("[BINARY_AOI] Delta block for %s truncated at offset %zu", id, r->pos);
+        return -1;
+    }
+    hash_t hash = entity_index_hash(id);
+    BotState* b = NULL;
+    EntityState* e = NULL;
+    if (etype == BIN_ENTITY_PLAYER) {
+        PlayerState* p = game_state_acquire_player(id, hash);
+        if (p) e = &p->base;
+    } else {
+        b = game_state_acquire_bot(id, hash);
+        if (b) e = &b->base;
+    }
+    /* Array full: parse into scratch so the reader stays aligned. */
+    BotState scratch = {0};
+    if (NULL == e) {
+        if (etype == BIN_ENTITY_BOT) b = &scratch;
+        e = &scratch.base;
+    }
+    e->handle = handle;
+
+    /* A freshly acquired slot has never been stamped — no lerp from origin. */
+    bool first_seen = (0.0 == e->snapshot_time);
+    if (mask & BIN_DELTA_POS) {
+        Vector2 incoming;
+        if (quantized) {
+            incoming.x = q_coord(brx_u16(r), (float)gs->grid_w);
+            incoming.y = q_coord(brx_u16(r), (float)gs->grid_h);
+        } else {
+            incoming.x = brx_f32(r);
+            incoming.y = brx_f32(r);
+        }
+        e->pos_prev   = first_seen ? incoming : e->pos_server;
+        e->pos_server = incoming;
+        if (first_seen) e->interp_pos = incoming;
+        e->snapshot_time = gs->last_update_time;
+    }
+    if (mask & BIN_DELTA_DIMS) {
+        e->dims.x = brx_f32(r);
+        e->dims.y = brx_f32(r);
+    }
+    if (mask & BIN_DELTA_DIR_MODE) {
+        e->direction = (Direction)brx_u8(r);
+        e->mode      = (ObjectLayerMode)brx_u8(r);
+        /* Same TELEPORTING guard as the full decoders: a jump never lerps. */
+        if (e->mode == MODE_TELEPORTING) e->pos_prev = e->pos_server;
+    }
+    bool jump = first_seen || ((mask & BIN_DELTA_DIR_MODE) && e->mode == MODE_TELEPORTING);
+    if ((mask & BIN_DELTA_POS) || jump) {
+        interpolation_record_snapshot(e, jump);
+    }
+    if (mask & BIN_DELTA_LIFE) {
+        e->life     = brx_f32(r);
+        e->max_life = brx_f32(r);
+    }
+    if (mask & BIN_DELTA_RESPAWN) {
+        e->respawn_in = brx_f32(r);
+    }
+    if (mask & BIN_DELTA_LAYERS) {
+        read_layers(r, e->object_layers, &e->object_layer_count, &e->layers_version);
+    }
+    if (mask & BIN_DELTA_STATUS) {
+        e->stats_sum   = (int)br_u16(r);
+        e->status_icon = br_u8(r);
+    }
+    if (mask & BIN_DELTA_BOT_META) {
+        if (NULL == b) {
+            LOG_ERROR("[BINARY_AOI] Bot meta in a player delta block at offset %zu", r->pos);
+            return -1;
+        }
+        br_string(r, b->behavior, MAX_BEHAVIOR_LENGTH);
+        br_string(r, b->caster_id, MAX_ID_LENGTH);
+        b->caster_handle = id_intern(b->caster_id);
+        b->interaction_flags = br_u8(r);
+        br_string(r, b->action_code, MAX_ID_LENGTH);
+        read_bot_quests(r, b);
+    }
+    e->last_update = gs->last_update_time;
+    return 0;
+}
+
+/* Full frame: every visible entity is listed. World objects are rebuilt
+ * from scratch; players and bots are updated in place and the unlisted ones
+ * swept at the end. */
+void binary_aoi_begin_full_frame(void) {
+    /* Clear world objects and their grids; each decoder re-indexes its
+     * object as it appends it. */
+    game_state_clear_world_objects();
+    s_frame_generation = game_state_begin_entity_sweep();
+}
+
+void binary_aoi_end_full_frame(void) {
+    game_state_end_entity_sweep();
+}
+
+static int decode_full_frame(BinReader* r, uint16_t entity_count) {
+    binary_aoi_begin_full_frame();
+
+    /* Decode entity blocks */
+    for (uint16_t i = 0; i < entity_count && br_remaining(r) > 0; i++) {
+        uint8_t flags = br_u8(r);
+        uint8_t etype = flags & 0x07;
+
+        if (flags & BIN_FLAG_REMOVED) {
+            /* Entity left AOI — skip its data block.
+               For removed entities the server only sends the ID. */
+            char skip_id[MAX_ID_LENGTH];
+            br_id(r, skip_id, sizeof(skip_id));
+            continue;
+        }
+
+        switch (etype) {
+            case BIN_ENTITY_PLAYER:     decode_player_entity(r, flags);     break;
+            case BIN_ENTITY_BOT:        decode_bot_entity(r, flags);        break;
+            case BIN_ENTITY_FLOOR:      decode_floor_entity(r, flags);      break;
+            case BIN_ENTITY_OBSTACLE:   decode_obstacle_entity(r, flags);   break;
+            case BIN_ENTITY_PORTAL:     decode_portal_entity(r, flags);     break;
+            case BIN_ENTITY_FOREGROUND: decode_foreground_entity(r, flags); break;
+            case BIN_ENTITY_RESOURCE:   decode_resource_entity(r, flags);   break;
+            case BIN_ENTITY_STATIC:     decode_static_entity(r, flags);     break;
+            default:
+                LOG_ERROR("[BINARY_AOI] Unknown entity type %d at offset %zu", etype, r->pos);
+                return -1;
+        }
+    }
+    binary_aoi_end_full_frame();
+    return 0;
+}
+
+int binary_aoi_decode_static_world(const uint8_t* data, size_t length) {
+    assert(data);
+    if (2 > length) return -1;
+    BinReader r = { .data = data, .len = length, .pos = 0 };
+    uint16_t count = br_u16(&r);
+    for (uint16_t i = 0; i < count; i++) {
+        if (0 >= br_remaining(&r)) return -1;
+        uint8_t flags = br_u8(&r);
+        switch (flags & 0x07) {
+            case BIN_ENTITY_FLOOR:      decode_floor_entity(&r, flags);      break;
+            case BIN_ENTITY_OBSTACLE:   decode_obstacle_entity(&r, flags);   break;
+            case BIN_ENTITY_PORTAL:     decode_portal_entity(&r, flags);     break;
+            case BIN_ENTITY_FOREGROUND: decode_foreground_entity(&r, flags); break;
+            default:
+                LOG_ERROR("[BINARY_AOI] StaticWorld: entity type %d at offset %zu",
+                          flags & 0x07, r.pos);
+                return -1;
+        }
+    }
+    return 0;
+}
+
+int binary_aoi_static_world_items(const uint8_t* data, size_t length,
+                                  char (*out)[MAX_ITEM_ID_LENGTH], int cap) {
+    assert(data && out);
+    if (2 > length) return -1;
+    static ObjectLayerState layers[MAX_OBJECT_LAYERS];
+    BinReader r = { .data = data, .len = length, .pos = 0 };
+    int found = 0;
+    uint16_t count = br_u16(&r);
+    for (uint16_t i = 0; i < count; i++) {
+        if (0 >= br_remaining(&r)) return -1;
+        uint8_t flags = br_u8(&r);
+        uint8_t type  = flags & 0x07;
+        if (BIN_ENTITY_FLOOR != type && BIN_ENTITY_OBSTACLE != type &&
+            BIN_ENTITY_PORTAL != type && BIN_ENTITY_FOREGROUND != type) {
+            return -1;
+        }
+        char id[MAX_ID_LENGTH];
+        br_id(&r, id, sizeof(id));
+        read_kinematics(&r, 0);
+        if (BIN_ENTITY_PORTAL == type) {
+            br_u8(&r);
+            br_string(&r, id, sizeof(id));
+            br_skip(&r, 4);   /* target cell */
+        }
+        int      n = 0;
+        uint32_t version = 0;
+        read_layers(&r, layers, &n, &version);
+        for (int j = 0; j < n && found < cap; j++) {
+            if ('\0' == layers[j].item_id[0]) continue;
+            int k = 0;
+            while (k < found && 0 != strcmp(out[k], layers[j].item_id)) k++;
+            if (k == found) memcpy(out[found++], layers[j].item_id, MAX_ITEM_ID_LENGTH);
+        }
+    }
+    return found;
+}
+
+/* Delta frame: only the listed players/bots change; see BIN_MSG_AOI_DELTA. */
+static int decode_delta_frame(BinReader* r, uint16_t entity_count) {
+    for (uint16_t i = 0; i < entity_count && br_remaining(r) > 0; i++) {
+        if (0 != decode_delta_entity(r, br_u8(r))) return -1;
+    }
+    return 0;
+}
+
+/* ── Session setup messages (JSON init_data / metadata fallback) ── */
+
+/* u8 count + count × str; entries past `cap` are read and dropped. */
+static int read_string_list(BinReader* r, char (*dst)[128], int cap) {
+    uint8_t n = br_u8(r);
+    int kept = 0;
+    char scratch[128];
+    for (uint8_t i = 0; i < n; i++) {
+        char* out = (kept < cap) ? dst[kept] : scratch;
+        br_string(r, out, 128);
+        if (out != scratch && '\0' != out[0]) kept++;
+    }
+    return kept;
+}
+
+static int decode_init_data(BinReader* r) {
+    GameState* gs = &g_game_state;
+    message_parser_begin_init_data();
+
+    gs->grid_w          = br_u16(r);
+    gs->grid_h          = br_u16(r);
+    gs->aoi_radius      = br_f32(r);
+    gs->sum_stats_limit = (int)br_u32(r);
+
+    uint8_t defaults = br_u8(r);
+    for (uint8_t i = 0; i < defaults; i++) {
+        EntityTypeDefault scratch;
+        EntityTypeDefault* d = (gs->entity_defaults_count < MAX_ENTITY_TYPES)
+            ? &gs->entity_defaults[gs->entity_defaults_count] : &scratch;
+        memset(d, 0, sizeof(EntityTypeDefault));
+        br_string(r, d->entity_type, sizeof(d->entity_type));
+        d->live_item_id_count = read_string_list(r, d->live_item_ids, MAX_DEFAULT_ITEM_IDS);
+        d->dead_item_id_count = read_string_list(r, d->dead_item_ids, MAX_DEFAULT_ITEM_IDS);
+        d->drop_item_id_count = read_string_list(r, d->drop_item_ids, MAX_DEFAULT_ITEM_IDS);
+        if (d != &scratch && '\0' != d->entity_type[0]) gs->entity_defaults_count++;
+    }
+
+    gs->dead_item_id_count = read_string_list(r, gs->dead_item_ids, MAX_DEAD_ITEM_IDS);
+
+    uint16_t skills = br_u16(r);
+    for (uint16_t i = 0; i < skills && br_remaining(r) > 0; i++) {
+        UiSkillEntry se = {0};
+        br_string(r, se.trigger_item_id, sizeof(se.trigger_item_id));
+        br_string(r, se.logic_event_id, sizeof(se.logic_event_id));
+        br_string(r, se.name, sizeof(se.name));
+        br_string16(r, se.description, sizeof(se.description));
+        br_string(r, se.summoned_entity_item_id, sizeof(se.summoned_entity_item_id));
+        ui_state_push_skill(&se);
+    }
+
+    uint32_t quests_len = br_u32(r);
+    if (quests_len > (uint32_t)br_remaining(r)) {
+        LOG_ERROR("[BINARY_AOI] init_data truncated (quests %u bytes, %d left)",
+                  quests_len, br_remaining(r));
+        return -1;
+    }
+    if (quests_len > 0 &&
+        !message_parser_parse_quests((const char*)r->data + r->pos, quests_len)) {
+        LOG_WARN("[BINARY_AOI] init_data quests section does not parse");
+    }
+    br_skip(r, quests_len);
+
+    message_parser_finish_init_data();
+    return 0;
+}
+
+static int decode_metadata(BinReader* r) {
+    GameState* gs = &g_game_state;
+    if (NULL == obj_layers_mgr_get()) {
+        LOG_ERROR("[METADATA] ObjectLayersManager not initialized yet\n");
+        return -1;
+    }
+
+    char api_url[256];
+    br_string(r, api_url, sizeof(api_url));
+    br_string(r, gs->instance_code, sizeof(gs->instance_code));
+    wire_dict_reset();
+    wire_dict_add(gs->instance_code);
+
+    uint8_t eq_flags = br_u8(r);
+    if (0 != (eq_flags & BIN_EQUIP_HAS_RULES)) {
+        EquipmentRules* er = &gs->equipment_rules;
+        er->active_item_type_count = 0;
+        uint8_t n = br_u8(r);
+        for (uint8_t i = 0; i < n; i++) {
+            char type[32];
+            br_string(r, type, sizeof(type));
+            if ('\0' != type[0] && er->active_item_type_count < MAX_ACTIVE_ITEM_TYPES) {
+                memcpy(er->active_item_types[er->active_item_type_count++], type, sizeof(type));
+            }
+        }
+        er->one_per_type = 0 != (eq_flags & BIN_EQUIP_ONE_PER_TYPE);
+        er->require_skin = 0 != (eq_flags & BIN_EQUIP_REQUIRE_SKIN);
+        game_state_index_item_rules();
+    }
+
+    uint16_t count = br_u16(r);
+    int ol_count = 0;
+    for (uint16_t i = 0; i < count && br_remaining(r) > 0; i++) {
+        char item_id[MAX_ITEM_ID_LENGTH];
+        br_string(r, item_id, sizeof(item_id));
+        wire_dict_add(item_id);
+
+        ObjectLayer* layer = create_object_layer();
+        if (!layer) return -1;
+        br_string(r, layer->sha256, sizeof(layer->sha256));
+
+        ObjectLayerData* d = &layer->data;
+        d->stats.effect       = (int)br_u32(r);
+        d->stats.resistance   = (int)br_u32(r);
+        d->stats.agility      = (int)br_u32(r);
+        d->stats.range        = (int)br_u32(r);
+        d->stats.intelligence = (int)br_u32(r);
+        d->stats.utility      = (int)br_u32(r);
+
+        br_string(r, d->item.id, sizeof(d->item.id));
+        br_string(r, d->item.type, sizeof(d->item.type));
+        br_string16(r, d->item.description, sizeof(d->item.description));
+        d->item.activable = 0 != br_u8(r);
+
+        uint8_t ledger = br_u8(r);
+        d->ledger.type = (ledger <= LEDGER_TYPE_ERC721) ? (LedgerType)ledger : LEDGER_TYPE_OFF_CHAIN;
+        br_string(r, d->ledger.address, sizeof(d->ledger.address));
+
+        br_string(r, d->render.cid, sizeof(d->render.cid));
+        br_string(r, d->render.metadata_cid, sizeof(d->render.metadata_cid));
+
+        if ('\0' == item_id[0]) {
+            free_object_layer(layer);
+            continue;
+        }
+        if ('\0' == d->item.id[0]) {
+            memcpy(d->item.id, item_id, sizeof(item_id));
+        }
+        obj_layers_mgr_put_layer(item_id, layer);
+        obj_layers_mgr_schedule_atlas_fetch(item_id);
+        ol_count++;
+    }
+
+    /* Same order as the JSON path: layers first, then the engine API. */
+    if ('\0' != api_url[0]) js_init_engine_api(api_url);
+
+    LOG_INFO("[METADATA] Cached %d ObjectLayers (binary), scheduled %d atlas REST fetches\n",
+             ol_count, ol_count);
+    return 0;
+}
+
+/* ── Instance Map presence push ─────────────────────────────────── */
+
+static int decode_imap_presence(BinReader* r) {
+    uint8_t  flags = br_u8(r);
+    uint16_t count = br_u16(r);
+    if ((size_t)count * 6 > (size_t)br_remaining(r)) {
+        LOG_ERROR("[BINARY_AOI] ImapPresence truncated (%u entries, %d bytes)",
+                  count, br_remaining(r));
+        return -1;
+    }
+    if (flags & BIN_IMAP_RESET) instance_map_data_presence_reset();
+    for (uint16_t i = 0; i < count; i++) {
+        int     node   = br_u8(r);
+        int     cell_x = br_u16(r);
+        int     cell_y = br_u16(r);
+        uint8_t state  = br_u8(r);
+        instance_map_data_presence_set(node, cell_x, cell_y,
+                                       0 != (state & BIN_IMAP_POI_ACTION),
+                                       0 != (state & BIN_IMAP_POI_QUEST),
+                                       0 != (state & BIN_IMAP_POI_ACCEPTABLE));
+    }
+    return 0;
+}
+
 /* ── Main entry point ──────────────────────────────────────────── */
 
+/* ── Events: FCT, item FCT, drop collect / spawn ───────────────── */
+
+/* Item ids of one BIN_MSG_EVENT_BATCH; NULL for a standalone event, whose
+ * ids are inline strings. */
+typedef struct {
+    int  count;
+    char ids[BIN_EVENT_DICT_MAX][MAX_ITEM_ID_LENGTH];
+} EventDict;
+
+/* Smallest body after the kind byte; an item id costs one byte either way
+ * (inline length, or dictionary index). 0 for a kind that is not an event. */
+static size_t event_body_min(uint8_t kind) {
+    switch (kind) {
+        case BIN_MSG_FCT:          return 13;
+        case BIN_MSG_ITEM_FCT:     return 14;
+        case BIN_MSG_DROP_COLLECT: return 81;
+        case BIN_MSG_DROP_SPAWN:   return 55;
+        default:                   return 0;
+    }
+}
+
+static void read_event_item_id(BinReader* r, const EventDict* dict, char* out) {
+    if (!dict) {
+        br_string(r, out, MAX_ITEM_ID_LENGTH);
+        return;
+    }
+    uint8_t idx = br_u8(r);
+    if (idx < dict->count) memcpy(out, dict->ids[idx], MAX_ITEM_ID_LENGTH);
+    else                   out[0] = '\0';
+}
+
+/* One event body of `kind` (a BIN_MSG_* event type); the caller has checked
+ * that event_body_min() bytes remain. */
+static void decode_event(BinReader* r, uint8_t kind, const EventDict* dict) {
+    switch (kind) {
+        case BIN_MSG_FCT: {
+            LocalFctEvent ev = { .type = br_u8(r) };
+            ev.world_x = br_f32(r);
+            ev.world_y = br_f32(r);
+            ev.value   = br_u32(r);
+            local_player_fct_push(&ev);
+            break;
+        }
+        case BIN_MSG_ITEM_FCT: {
+            LocalFctEvent ev = { .type = br_u8(r) };
+            ev.world_x  = br_f32(r);
+            ev.world_y  = br_f32(r);
+            ev.value    = br_u32(r);
+            ev.item_qty = ev.value;
+            read_event_item_id(r, dict, ev.item_id);
+            local_player_fct_push(&ev);
+            break;
+        }
+        case BIN_MSG_DROP_COLLECT: {
+            /* Arm the parabolic pickup flight. */
+            char drop_id[MAX_ID_LENGTH];
+            char collector_id[MAX_ID_LENGTH];
+            br_id(r, drop_id, sizeof(drop_id));
+            br_id(r, collector_id, sizeof(collector_id));
+            float world_x = br_f32(r);
+            float world_y = br_f32(r);
+            char  item_id[MAX_ITEM_ID_LENGTH];
+            read_event_item_id(r, dict, item_id);
+            loot_fx_push(drop_id, collector_id, item_id, world_x, world_y);
+            break;
+        }
+        case BIN_MSG_DROP_SPAWN: {
+            /* Arm the corpse→cell parabolic spawn launch. */
+            char drop_id[MAX_ID_LENGTH];
+            br_id(r, drop_id, sizeof(drop_id));
+            float origin_x  = br_f32(r);
+            float origin_y  = br_f32(r);
+            float landing_x = br_f32(r);
+            float landing_y = br_f32(r);
+            uint16_t launch_ms = br_u16(r);
+            char item_id[MAX_ITEM_ID_LENGTH];
+            read_event_item_id(r, dict, item_id);
+            loot_fx_note_spawn(drop_id, origin_x, origin_y, landing_x, landing_y,
+                               item_id, launch_ms);
+            break;
+        }
+        default:
+            assert(false && "not an event type");
+    }
+}
+
+static int decode_event_batch(BinReader* r) {
+    static EventDict dict;   /* ~BIN_EVENT_DICT_MAX ids; too big for the stack */
+    uint8_t dict_count = br_u8(r);
+    dict.count = (dict_count < BIN_EVENT_DICT_MAX) ? dict_count : BIN_EVENT_DICT_MAX;
+    for (int i = 0; i < (int)dict_count; i++) {
+        char id[MAX_ITEM_ID_LENGTH];
+        br_string(r, id, sizeof(id));
+        if (i < dict.count) memcpy(dict.ids[i], id, sizeof(id));
+    }
+
+    uint16_t count = br_u16(r);
+    for (uint16_t i = 0; i < count; i++) {
+        uint8_t kind = br_u8(r);
+        size_t  need = event_body_min(kind);
+        if (0 == need || (size_t)br_remaining(r) < need) {
+            LOG_ERROR("[BINARY_AOI] EventBatch: bad event %u of %u (kind 0x%02x)", i, count, kind);
+            return -1;
+        }
+        decode_event(r, kind, &dict);
+    }
+    return 0;
+}
+
 int binary_aoi_process(const uint8_t* data, size_t length) {
     if (!data || length < 2) {
         LOG_ERROR("[BINARY_AOI] Message too short (%zu bytes)", length);
@@ -624,93 +1343,64 @@ int binary_aoi_process(const uint8_t* data, size_t length) {
 
     uint8_t msg_type = br_u8(&r);
 
-    /* ── Floating Combat Text event — compact 14-byte message ──────────── */
-    if (msg_type == BIN_MSG_FCT) {
-        if (length < 14) {
-            LOG_ERROR("[BINARY_AOI] FCT message too short (%zu bytes, need 14)", length);
-            return -1;
-        }
-        uint8_t  fct_type = br_u8(&r);
-        float    world_x  = br_f32(&r);
-        float    world_y  = br_f32(&r);
-        uint32_t value    = br_u32(&r);
-        LocalFctEvent ev = {
-            .world_x  = world_x,
-            .world_y  = world_y,
-            .value    = value,
-            .type     = fct_type,
-            .item_qty = 0,
-        };
-        ev.item_id[0] = '\0';
-        local_player_fct_push(&ev);
+    if (msg_type == BIN_MSG_INIT_DATA) return decode_init_data(&r);
+    if (msg_type == BIN_MSG_METADATA)  return decode_metadata(&r);
+    if (msg_type == BIN_MSG_WIRE_ACK) {
+        gs->wire_ack_caps     = br_u8(&r);
+        gs->wire_ack_caps_ext = (0 < br_remaining(&r)) ? br_u8(&r) : 0;
+        LOG_INFO("[BINARY_AOI] Server accepted wire caps 0x%02x ext 0x%02x",
+                 gs->wire_ack_caps, gs->wire_ack_caps_ext);
+        if (0 == (gs->wire_ack_caps_ext & WIRE_CAP_EXT_STATIC_WORLD)) static_world_release();
+        return 0;
+    }
+    if (msg_type == BIN_MSG_STATIC_WORLD) {
+        char map_code[MAX_ID_LENGTH];
+        char version[STATIC_WORLD_VERSION_MAX];
+        br_string(&r, map_code, sizeof(map_code));
+        br_string(&r, version, sizeof(version));
+        static_world_on_announce(map_code, version);
         return 0;
     }
-    /* ── Item FCT event — variable-length message (≥15 bytes) ─────────────── */
-    if (msg_type == BIN_MSG_ITEM_FCT) {
-        if (length < 15) {
-            LOG_ERROR("[BINARY_AOI] ItemFCT message too short (%zu bytes)", length);
+    if (msg_type == BIN_MSG_CLOCK_PONG) {
+        if (length < 11) {
+            LOG_ERROR("[BINARY_AOI] ClockPong message too short (%zu bytes, need 11)", length);
             return -1;
         }
-        uint8_t  fct_type = br_u8(&r);
-        float    world_x  = br_f32(&r);
-        float    world_y  = br_f32(&r);
-        uint32_t qty      = br_u32(&r);
-        uint8_t  id_len   = br_u8(&r);
-        char     item_id[MAX_ITEM_ID_LENGTH];
-        memset(item_id, 0, sizeof(item_id));
-        if (id_len > 0 && id_len < MAX_ITEM_ID_LENGTH && r.pos + id_len <= r.len) {
-            memcpy(item_id, r.data + r.pos, id_len);
-        }
-        LocalFctEvent ev = {
-            .world_x  = world_x,
-            .world_y  = world_y,
-            .value    = qty,
-            .type     = fct_type,
-            .item_qty = qty,
-        };
-        strncpy(ev.item_id, item_id, MAX_ITEM_ID_LENGTH - 1);
-        local_player_fct_push(&ev);
+        uint32_t client_ms   = br_u32(&r);
+        uint32_t server_tick = br_u32(&r);
+        session_on_clock_pong(client_ms, server_tick, br_u16(&r));
         return 0;
     }
-    /* ── Drop collected — arm the parabolic pickup flight ─────────────────── */
-    if (msg_type == BIN_MSG_DROP_COLLECT) {
-        if (length < 82) {
-            LOG_ERROR("[BINARY_AOI] DropCollect message too short (%zu bytes, need 82)", length);
+    if (msg_type == BIN_MSG_IMAP_PRESENCE) {
+        if (length < 4) {
+            LOG_ERROR("[BINARY_AOI] ImapPresence message too short (%zu bytes, need 4)", length);
             return -1;
         }
-        char drop_id[MAX_ID_LENGTH];
-        char collector_id[MAX_ID_LENGTH];
-        br_id(&r, drop_id, sizeof(drop_id));
-        br_id(&r, collector_id, sizeof(collector_id));
-        float world_x = br_f32(&r);
-        float world_y = br_f32(&r);
-        char  item_id[MAX_ITEM_ID_LENGTH];
-        br_string(&r, item_id, sizeof(item_id));
-        loot_fx_push(drop_id, collector_id, item_id, world_x, world_y);
-        return 0;
+        return decode_imap_presence(&r);
     }
-    /* ── Drop launched — arm the corpse→cell parabolic spawn launch ───────── */
-    if (msg_type == BIN_MSG_DROP_SPAWN) {
-        if (length < 56) {
-            LOG_ERROR("[BINARY_AOI] DropSpawn message too short (%zu bytes, need 56)", length);
+
+    if (msg_type == BIN_MSG_FCT || msg_type == BIN_MSG_ITEM_FCT ||
+        msg_type == BIN_MSG_DROP_COLLECT || msg_type == BIN_MSG_DROP_SPAWN) {
+        if (length < 1 + event_body_min(msg_type)) {
+            LOG_ERROR("[BINARY_AOI] Event 0x%02x too short (%zu bytes)", msg_type, length);
             return -1;
         }
-        char drop_id[MAX_ID_LENGTH];
-        br_id(&r, drop_id, sizeof(drop_id));
-        float origin_x  = br_f32(&r);
-        float origin_y  = br_f32(&r);
-        float landing_x = br_f32(&r);
-        float landing_y = br_f32(&r);
-        uint16_t launch_ms = br_u16(&r);
-        char item_id[MAX_ITEM_ID_LENGTH];
-        br_string(&r, item_id, sizeof(item_id));
-        loot_fx_note_spawn(drop_id, origin_x, origin_y, landing_x, landing_y,
-                           item_id, launch_ms);
+        decode_event(&r, msg_type, NULL);
+        return 0;
+    }
+    if (msg_type == BIN_MSG_EVENT_BATCH) return decode_event_batch(&r);
+    if (msg_type == BIN_MSG_ITEM_DICT)   return decode_item_dict(&r);
+    if (msg_type == BIN_MSG_SESSION) {
+        uint8_t flags = br_u8(&r);
+        char    token[BIN_SESSION_TOKEN_MAX + 1];
+        br_string(&r, token, sizeof(token));
+        game_client_on_session(token, 0 != (flags & BIN_SESSION_RESUMED));
         return 0;
     }
     /* ── AOI update / full AOI ─────────────────────────────────────────────
      *
-     *   [0]      u8  msgType        (0x01 = aoi_update, 0x03 = full_aoi)
+     *   [0]      u8  msgType        (0x01 = aoi_update, 0x03 = full_aoi,
+     *                                 0x08 = aoi_delta)
      *   [1..4]   u32 tick           — simulation tick when produced
      *   [5..8]   u32 lastAckSeq     — highest InputCommand.Sequence the server
      *                                 has applied for this client; the
@@ -723,7 +1413,8 @@ int binary_aoi_process(const uint8_t* data, size_t length) {
         LOG_ERROR("[BINARY_AOI] AOI message too short (%zu bytes, need 11)", length);
         return -1;
     }
-    if (msg_type != BIN_MSG_AOI_UPDATE && msg_type != BIN_MSG_FULL_AOI) {
+    if (msg_type != BIN_MSG_AOI_UPDATE && msg_type != BIN_MSG_FULL_AOI
+        && msg_type != BIN_MSG_AOI_DELTA) {
         LOG_ERROR("[BINARY_AOI] Unknown message type 0x%02x", msg_type);
         return -1;
     }
@@ -742,57 +1433,16 @@ int binary_aoi_process(const uint8_t* data, size_t length) {
      * interpolator computes `t = (now - last_update_time) * 1000 /
      * interpolation_ms`; without this write t stays clamped at 1.0 and
      * entities teleport between snapshots instead of lerping. */
-    gs->last_update_time = GetTime();
-
-    /* Snapshot current entity positions before reset so decoders can recover
-     * the previous server position for smooth interpolation (pos_prev). */
-    s_prev_bot_count = gs->bot_count;
-    for (int i = 0; i < s_prev_bot_count; i++) {
-        memcpy(s_prev_bots[i].id, gs->bots[i].base.id, MAX_ID_LENGTH);
-        s_prev_bots[i].pos_server = gs->bots[i].base.pos_server;
-    }
-    s_prev_player_count = gs->other_player_count;
-    for (int i = 0; i < s_prev_player_count; i++) {
-        memcpy(s_prev_players[i].id, gs->other_players[i].base.id, MAX_ID_LENGTH);
-        s_prev_players[i].pos_server = gs->other_players[i].base.pos_server;
-    }
-
-    /* Clear world objects (same as JSON parser does each AOI frame) */
-    gs->other_player_count = 0;
-    gs->bot_count = 0;
-    gs->resource_count = 0;
-    gs->obstacle_count = 0;
-    gs->foreground_count = 0;
-    gs->static_count = 0;
-    gs->portal_count = 0;
-    gs->floor_count = 0;
-
-    /* Decode entity blocks */
-    for (uint16_t i = 0; i < entity_count && br_remaining(&r) > 0; i++) {
-        uint8_t flags = br_u8(&r);
-        uint8_t etype = flags & 0x07;
-
-        if (flags & BIN_FLAG_REMOVED) {
-            /* Entity left AOI — skip its data block.
-               For removed entities the server only sends the ID. */
-            char skip_id[MAX_ID_LENGTH];
-            br_id(&r, skip_id, sizeof(skip_id));
-            continue;
-        }
-
-        switch (etype) {
-            case BIN_ENTITY_PLAYER:     decode_player_entity(&r, flags);     break;
-            case BIN_ENTITY_BOT:        decode_bot_entity(&r, flags);        break;
-            case BIN_ENTITY_FLOOR:      decode_floor_entity(&r, flags);      break;
-            case BIN_ENTITY_OBSTACLE:   decode_obstacle_entity(&r, flags);   break;
-            case BIN_ENTITY_PORTAL:     decode_portal_entity(&r, flags);     break;
-            case BIN_ENTITY_FOREGROUND: decode_foreground_entity(&r, flags); break;
-            case BIN_ENTITY_RESOURCE:   decode_resource_entity(&r, flags);   break;
-            case BIN_ENTITY_STATIC:     decode_static_entity(&r, flags);     break;
-            default:
-                LOG_ERROR("[BINARY_AOI] Unknown entity type %d at offset %zu", etype, r.pos);
-                return -1;
-        }
+    gs->last_update_time = network_message_time();
+
+    int rc = (msg_type == BIN_MSG_AOI_DELTA)
+        ? decode_delta_frame(&r, entity_count)
+        : decode_full_frame(&r, entity_count);
+    /* Even a truncated frame may have touched slots — keep the hot sets in step. */
+    game_state_refresh_hot();
+    if (0 != rc) {
+        game_state_publish_entity_events();
+        return -1;
     }
 
     /* Self-player block comes last */
@@ -800,6 +1450,7 @@ int binary_aoi_process(const uint8_t* data, size_t length) {
         uint8_t self_flags = br_u8(&r);
         decode_self_player(&r, self_flags);
     }
+    game_state_publish_entity_events();
 
     /* Authoritative self position is now fresh — trigger prediction
      * reconciliation. session_on_snapshot was already called at the top of
@@ -809,3 +1460,9 @@ int binary_aoi_process(const uint8_t* data, size_t length) {
 
     return 0;
 }
+
+void binary_aoi_context_register(void) {
+    client_context_register(&s_frame_generation, sizeof(s_frame_generation), NULL);
+    client_context_register(&s_item_dict,        sizeof(s_item_dict),        NULL);
+    client_context_register(&s_self_hash,        sizeof(s_self_hash),        NULL);
+}
@@ -12,11 +12,30 @@
 #ifndef BINARY_AOI_DECODER_H
 #define BINARY_AOI_DECODER_H
 
+#include <raylib.h>
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 
+#include "game_state.h"
+
 /* ── Message types ─────────────────────────────────────────────── */
 #define BIN_MSG_AOI_UPDATE 0x01
+/* BIN_MSG_INIT_DATA — session config, in place of the JSON init_data when
+ * the handshake advertised WIRE_CAP_BINARY_INIT. str = u8 len + bytes,
+ * str16 = u16 len + bytes, list = u8 n + n × str.
+ *   u8    0x02
+ *   u16   gridW, u16 gridH
+ *   f32   aoiRadius
+ *   u32   sumStatsLimit
+ *   u8    entityDefaultCount, then each:
+ *           str entityType, list liveItemIds, list deadItemIds, list dropItemIds
+ *   list  deadItemIds
+ *   u16   skillCount, then each (one per skillMap definition):
+ *           str triggerItemId, str logicEventId, str name,
+ *           str16 description, str summonedEntityItemId
+ *   u32   questsLen, then questsLen bytes: the init_data "quests" JSON array
+ *         verbatim (0 when none)                                          */
 #define BIN_MSG_INIT_DATA  0x02
 #define BIN_MSG_FULL_AOI   0x03
 /* BIN_MSG_FCT — Floating Combat Text event (14 bytes, little-endian).
@@ -56,6 +75,137 @@
  *   [55]       u8   itemId length (0–63)
  *   [56..]     str  itemId bytes                                            */
 #define BIN_MSG_DROP_SPAWN   0x07
+/* BIN_MSG_AOI_DELTA — in-place patch of remote players and bots.
+ *   Header as BIN_MSG_AOI_UPDATE (tick u32, lastAckSeq u32, entityCount u16),
+ *   then entityCount blocks:
+ *     u8   flags       entity type bits (PLAYER / BOT only) | BIN_FLAG_REMOVED
+ *     36B  id          stable entity UUID, zero-padded
+ *     u8   fieldMask   BIN_DELTA_* bits (absent when REMOVED); each set bit's
+ *                      fields follow in bit order
+ *   then the self-player block exactly as in a full frame.
+ *   Entities not listed keep their state untouched; world objects (floors,
+ *   obstacles, portals, foregrounds, statics, resources) only change on full
+ *   frames. An id the client does not hold yet arrives with every field set. */
+#define BIN_MSG_AOI_DELTA    0x08
+
+#define BIN_DELTA_POS        0x01  /* f32 x, f32 y                              */
+#define BIN_DELTA_DIMS       0x02  /* f32 w, f32 h                              */
+#define BIN_DELTA_DIR_MODE   0x04  /* u8 direction, u8 mode                     */
+#define BIN_DELTA_LIFE       0x08  /* f32 life, f32 maxLife                     */
+#define BIN_DELTA_RESPAWN    0x10  /* f32 respawnIn                             */
+#define BIN_DELTA_LAYERS     0x20  /* item-id list, as in a full entity block   */
+#define BIN_DELTA_STATUS     0x40  /* u16 statsSum, u8 statusIcon               */
+#define BIN_DELTA_BOT_META   0x80  /* bots: str behavior, str casterId,
+                                    * u8 interactionFlags, str actionCode,
+                                    * quest codes + talk codes as in full frames */
+/* BIN_MSG_METADATA — ObjectLayer catalog, in place of the JSON metadata
+ * message under WIRE_CAP_BINARY_INIT. Strings as in BIN_MSG_INIT_DATA.
+ *   u8    0x09
+ *   str   apiBaseUrl, str instanceCode
+ *   u8    BIN_EQUIP_* flags; when HAS_RULES: list activeItemTypes
+ *   u16   objectLayerCount, then each:
+ *           str itemId, str sha256
+ *           6 × i32 stats (effect, resistance, agility, range,
+ *                          intelligence, utility)
+ *           str item.id, str item.type, str16 item.description,
+ *           u8 item.activable
+ *           u8 ledger.type (LedgerType), str ledger.address
+ *           str render.cid, str render.metadataCid                        */
+#define BIN_MSG_METADATA     0x09
+/* BIN_MSG_IMAP_PRESENCE — Instance Map provider state, pushed to a client
+ * that sent UPLINK_IMAP_SUBSCRIBE (see serial.h) until it unsubscribes.
+ *   u8    0x0A
+ *   u8    BIN_IMAP_* flags
+ *   u16   entryCount, then each (6 bytes):
+ *           u8  node   index into the static document's "nodes" array
+ *           u16 cellX, u16 cellY
+ *           u8  BIN_IMAP_POI_* state bits; 0 clears the POI
+ *   The first push after a subscribe carries BIN_IMAP_RESET and every live
+ *   POI; later pushes list only the POIs whose state changed.            */
+#define BIN_MSG_IMAP_PRESENCE 0x0A
+/* BIN_MSG_WIRE_ACK — the server's answer to the handshake's wireCaps, from a
+ * server that knows it; older servers never send it.
+ *   u8    0x0B
+ *   u8    WIRE_CAP_* bits it accepts, e.g. WIRE_CAP_UPLINK_BATCH
+ *   u8    WIRE_CAP_EXT_* bits it accepts; absent means none              */
+#define BIN_MSG_WIRE_ACK      0x0B
+/* BIN_MSG_EVENT_BATCH — several FCT / item FCT / drop events in one frame,
+ * sent once the server lists WIRE_CAP_EVENT_BATCH in BIN_MSG_WIRE_ACK.
+ *   u8    0x0C
+ *   u8    dictCount, then dictCount × str itemId   (the frame's item ids)
+ *   u16   eventCount, then each:
+ *           u8  kind   BIN_MSG_FCT / _ITEM_FCT / _DROP_COLLECT / _DROP_SPAWN
+ *           the standalone message's bytes after its type byte, with each
+ *           itemId string replaced by a u8 index into the dictionary
+ *   An index past the dictionary reads as an empty item id; ids past
+ *   BIN_EVENT_DICT_MAX are skipped.                                       */
+#define BIN_MSG_EVENT_BATCH   0x0C
+#define BIN_EVENT_DICT_MAX    64
+/* BIN_MSG_COMPRESSED — another downlink frame as one LZ4 block
+ * (network/wire_compress.h), sent once the server lists WIRE_CAP_LZ4 in
+ * BIN_MSG_WIRE_ACK. game_client unwraps it before decoding.
+ *   u8    0x0D
+ *   u8    BIN_COMPRESS_* flags
+ *   u32   rawLen    size of the inner frame
+ *   ...   LZ4 block                                                       */
+#define BIN_MSG_COMPRESSED    0x0D
+
+#define BIN_COMPRESS_TEXT     0x01  /* inner frame is a JSON text message    */
+#define BIN_COMPRESS_DICT     0x02  /* history primed with the session dict  */
+/* BIN_MSG_ITEM_DICT — names session item indices, sent once the server
+ * lists WIRE_CAP_ITEM_DICT in BIN_MSG_WIRE_ACK, before the first frame that
+ * uses them. From then on every entity layer list (full blocks, deltas,
+ * world objects, the self-player's equipment) is u8 count + count × {u16
+ * index, u16 qty} instead of {str itemId, u16 qty}; the self-player's full
+ * inventory keeps its strings. Indices restart with each init_data.
+ *   u8    0x0E
+ *   u16   firstIndex
+ *   u16   count, then count × str itemId   (indices firstIndex, +1, ...) */
+#define BIN_MSG_ITEM_DICT     0x0E
+#define BIN_ITEM_DICT_MAX     4096
+/* BIN_MSG_SESSION — the session's resume token, sent once the server lists
+ * WIRE_CAP_RESUME in BIN_MSG_WIRE_ACK, and again in answer to UPLINK_RESUME.
+ * With BIN_SESSION_RESUMED the server kept the session and follows with
+ * deltas against the client's lastTick; without it the resume was refused
+ * and a fresh init_data follows (see game_client_on_session).
+ *   u8    0x0F
+ *   u8    BIN_SESSION_* flags
+ *   str   resumeToken  (at most BIN_SESSION_TOKEN_MAX bytes are kept)      */
+#define BIN_MSG_SESSION       0x0F
+#define BIN_SESSION_TOKEN_MAX 64
+
+#define BIN_SESSION_RESUMED   0x01
+/* BIN_MSG_STATIC_WORLD — the static layer of the map the self-player just
+ * entered, sent once the server lists WIRE_CAP_EXT_STATIC_WORLD in
+ * BIN_MSG_WIRE_ACK; its AOI frames then carry no floor, obstacle, portal or
+ * foreground blocks.
+ *   u8    0x10
+ *   str   mapCode
+ *   str   version   content hash of the map's static layer
+ * The layer itself is a blob the client keeps per (mapCode, version) and
+ * otherwise fetches (see static_world.h):
+ *   u16   count, then count × one full-frame entity block (flags byte and
+ *         body) of type floor, obstacle, portal or foreground             */
+#define BIN_MSG_STATIC_WORLD  0x10
+/* BIN_MSG_CLOCK_PONG — the answer to UPLINK_CLOCK_PING, sent as soon as the
+ * server reads the ping, once it lists WIRE_CAP_EXT_CLOCK_SYNC in
+ * BIN_MSG_WIRE_ACK. Feeds session_on_clock_pong (network/replication.h).
+ *   u8    0x11
+ *   u32   clientMs     the ping's, echoed
+ *   u32   serverTick   the tick running when the pong was written
+ *   u16   tickPhase    how far into it, in 1/65536 of a tick           */
+#define BIN_MSG_CLOCK_PONG    0x11
+
+#define BIN_IMAP_RESET            0x01  /* clear every POI's state first  */
+
+#define BIN_IMAP_POI_ACTION       0x01  /* action provider active         */
+#define BIN_IMAP_POI_QUEST        0x02  /* quest provider active          */
+#define BIN_IMAP_POI_ACCEPTABLE   0x04  /* its quest can be accepted now  */
+
+#define BIN_EQUIP_HAS_RULES    0x01
+#define BIN_EQUIP_ONE_PER_TYPE 0x02
+#define BIN_EQUIP_REQUIRE_SKIN 0x04
+
 /* FCT event type constants are defined in floating_combat_text.h — the
  * single source of truth for the FCT subsystem.  Include it directly
  * rather than duplicating the defines here.                              */
@@ -76,6 +226,58 @@
 #define BIN_FLAG_HAS_LIFE      0x10
 #define BIN_FLAG_HAS_RESPAWN   0x20
 #define BIN_FLAG_HAS_BEHAVIOR  0x40
+/* Player/bot block uses the compact kinematics encoding (negotiated through
+ * WIRE_CAP_QUANTIZED_POS in the handshake). In place of f32 x, y, w, h and
+ * u8 direction, u8 mode the block carries:
+ *   u16 qx, u16 qy   position, fixed point over the grid: x = qx * gridW / 65536
+ *   u8  packed       bits 0-3 direction, bits 4-5 mode, bit 6 BIN_QPACK_HAS_DIMS
+ *   u16 qw, u16 qh   dims in 1/256 cells — only when BIN_QPACK_HAS_DIMS is set;
+ *                    otherwise the entity keeps the dims it had last frame.
+ * In a BIN_MSG_AOI_DELTA block it only changes BIN_DELTA_POS to u16 qx, qy. */
+#define BIN_FLAG_QUANTIZED     0x80
+#define BIN_QPACK_HAS_DIMS     0x40
+
+/* ── Entity block schemas ──────────────────────────────────────────
+ * What follows the id and kinematics of a player, bot or resource block,
+ * in wire order, one row per field: F(op, member, arg) with `member` a
+ * path into the record (PlayerState / BotState) and `arg` per op:
+ *   LIFE      f32 member, f32 arg        only with BIN_FLAG_HAS_LIFE, else 0
+ *   RESPAWN   f32 member                 only with BIN_FLAG_HAS_RESPAWN, else 0
+ *   BEHAVIOR  str into member[arg]       only with BIN_FLAG_HAS_BEHAVIOR, else ""
+ *   LAYERS    layer list into member's object_layers
+ *   CASTER    str into member, interned into arg
+ *   STRING    str into member[arg]
+ *   U16 / U8  into member (int / uint8_t)
+ *   QUESTS    u8 n + n × str quest codes, u8 m + m × str talk dialogue codes
+ * The decoder expands each schema into straight-line reads that write
+ * every member they own, flag-gated or not, so a record needs no blanket
+ * clear between frames; the host benches expand the same rows into the
+ * encoder their synthetic frames are built with. */
+#define AOI_SCHEMA_PLAYER(F)                              \
+    F(LIFE,     base.life,         base.max_life)         \
+    F(RESPAWN,  base.respawn_in,   _)                     \
+    F(LAYERS,   base,              _)                     \
+    F(U16,      base.stats_sum,    _)                     \
+    F(U8,       base.status_icon,  _)
+
+#define AOI_SCHEMA_BOT(F)                                 \
+    F(LIFE,     base.life,         base.max_life)         \
+    F(RESPAWN,  base.respawn_in,   _)                     \
+    F(BEHAVIOR, behavior,          MAX_BEHAVIOR_LENGTH)   \
+    F(LAYERS,   base,              _)                     \
+    F(CASTER,   caster_id,         caster_handle)         \
+    F(U16,      base.stats_sum,    _)                     \
+    F(U8,       base.status_icon,  _)                     \
+    F(U8,       interaction_flags, _)                     \
+    F(STRING,   action_code,       MAX_ID_LENGTH)         \
+    F(QUESTS,   quest_codes,       _)
+
+#define AOI_SCHEMA_RESOURCE(F)                            \
+    F(LIFE,     base.life,         base.max_life)         \
+    F(RESPAWN,  base.respawn_in,   _)                     \
+    F(LAYERS,   base,              _)                     \
+    F(U16,      base.stats_sum,    _)                     \
+    F(U8,       base.status_icon,  _)
 
 /**
  * @brief Process a binary AOI message from the server.
@@ -90,13 +292,65 @@
 int binary_aoi_process(const uint8_t* data, size_t length);
 
 /**
- * @brief Drop the prev-position snapshot used for interpolation.
+ * @brief Drop the state carried from the previous session's frames.
  *
  * Must be called from message_parser when init_data arrives (initial
- * handshake or reconnect after a server restart).  Without this, the
- * decoder would resolve fresh-session UUIDs against the prior session's
- * positions and interpolate everything from (0,0).
+ * handshake or reconnect after a server restart).  Clears the remote
+ * players and bots, whose slots carry interpolation across full frames,
+ * so a fresh-session UUID never resolves to the prior session's position,
+ * along with the item dictionary and self-section fingerprints.
  */
 void binary_aoi_reset_prev_snapshots(void);
 
+/**
+ * @brief Decode a static-world blob (BIN_MSG_STATIC_WORLD) into the
+ * floor, obstacle, portal and foreground arrays, appending to them.
+ * @return 0 on success, -1 on a malformed blob or another entity type.
+ */
+int binary_aoi_decode_static_world(const uint8_t* data, size_t length);
+
+/**
+ * @brief Distinct item ids the layers of a static-world blob draw, at most
+ * `cap` of them, without touching game_state (portal prewarm).
+ * @return how many were written, -1 on a malformed blob.
+ */
+int binary_aoi_static_world_items(const uint8_t* data, size_t length,
+                                  char (*out)[MAX_ITEM_ID_LENGTH], int cap);
+
+/* ── Frame building, shared with the JSON AOI fallback ─────────────
+ * json_aoi_decoder.c rebuilds frames through these so both encodings give
+ * the same interpolation, dims carry-over and layer versioning. */
+
+/* Position, dims, direction and mode of a player/bot. has_dims is false
+ * only for a quantized block that left dims out. */
+typedef struct {
+    Vector2 pos;
+    Vector2 dims;
+    bool    has_dims;
+    uint8_t direction;
+    uint8_t mode;
+} AoiKinematics;
+
+/* Clear every world object and start a player/bot sweep ahead of a full
+ * frame; binary_aoi_end_full_frame() then removes those the frame did not
+ * place, so the arrays stay dense and LEAVE is published the same frame. */
+void binary_aoi_begin_full_frame(void);
+void binary_aoi_end_full_frame(void);
+
+/* Acquire the slot for `id`, stamp it for this frame and apply `k` against
+ * what the slot held before (pos_prev, history, dims). Fields outside the
+ * kinematics keep their values for the caller to overwrite. NULL when
+ * full. */
+PlayerState* binary_aoi_place_player(const char* id, const AoiKinematics* k);
+BotState*    binary_aoi_place_bot(const char* id, const AoiKinematics* k);
+
+/* Copy n layers into a record, re-interning *version (layer_stack.h) when
+ * the item set or an active flag changed. */
+void binary_aoi_store_layers(ObjectLayerState* layers, int* count, uint32_t* version,
+                             const ObjectLayerState* src, int n);
+
+/* Hand the decoder's per-view state (item dictionary, self-section
+ * hashes) to client_context. */
+void binary_aoi_context_register(void);
+
 #endif /* BINARY_AOI_DECODER_H */
@@ -0,0 +1,112 @@
+#include "client_context.h"
+
+#include "binary_aoi_decoder.h"
+#include "game_state.h"
+#include "message_parser.h"
+#include "domain/camera.h"
+#include "network/net_telemetry.h"
+#include "network/replication.h"
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    void*  state;
+    size_t size;
+    size_t offset;    /* into the saved images */
+    void (*release)(void);
+} ContextSlot;
+
+struct ClientContext {
+    GameState* state;
+    uint8_t*   saved;  /* the registered slots while unbound, back to back */
+};
+
+static struct {
+    ContextSlot    slots[CLIENT_CONTEXT_MAX_SLOTS];
+    int            count;
+    size_t         bytes;
+    uint8_t*       initial;   /* every slot as registered */
+    bool           ready;
+    ClientContext  primary;
+    ClientContext* bound;
+} s_ctx = { .bound = &s_ctx.primary };
+
+void client_context_register(void* state, size_t size, void (*release)(void)) {
+    assert(state && 0 < size);
+    assert(!s_ctx.ready && "client_context_register() after client_context_init()");
+    assert(CLIENT_CONTEXT_MAX_SLOTS > s_ctx.count);
+    s_ctx.initial = realloc(s_ctx.initial, s_ctx.bytes + size);
+    assert(s_ctx.initial);
+    memcpy(s_ctx.initial + s_ctx.bytes, state, size);
+    s_ctx.slots[s_ctx.count++] = (ContextSlot){
+        .state   = state,
+        .size    = size,
+        .offset  = s_ctx.bytes,
+        .release = release,
+    };
+    s_ctx.bytes += size;
+}
+
+void client_context_init(void) {
+    assert(!s_ctx.ready);
+    game_state_context_register();
+    binary_aoi_context_register();
+    message_parser_context_register();
+    replication_context_register();
+    net_telemetry_context_register();
+    camera_context_register();
+    s_ctx.primary.state = g_game_state_view;
+    s_ctx.primary.saved = malloc(s_ctx.bytes);
+    assert(s_ctx.primary.saved);
+    s_ctx.ready = true;
+}
+
+ClientContext* client_context_create(void) {
+    assert(s_ctx.ready && "client_context_init() not called");
+    ClientContext* ctx = calloc(1, sizeof(*ctx));
+    assert(ctx);
+    ctx->state = malloc(sizeof(GameState));
+    ctx->saved = malloc(s_ctx.bytes);
+    assert(ctx->state && ctx->saved);
+    game_state_view_init(ctx->state);
+    memcpy(ctx->saved, s_ctx.initial, s_ctx.bytes);
+    return ctx;
+}
+
+void client_context_bind(ClientContext* ctx) {
+    ClientContext* next = ctx ? ctx : &s_ctx.primary;
+    ClientContext* prev = s_ctx.bound;
+    if (next == prev) return;
+    assert(s_ctx.ready);
+    for (int i = 0; i < s_ctx.count; i++) {
+        const ContextSlot* slot = &s_ctx.slots[i];
+        memcpy(prev->saved + slot->offset, slot->state, slot->size);
+        memcpy(slot->state, next->saved + slot->offset, slot->size);
+    }
+    g_game_state_view = next->state;
+    s_ctx.bound       = next;
+}
+
+void client_context_destroy(ClientContext* ctx) {
+    assert(ctx && &s_ctx.primary != ctx);
+    ClientContext* back = s_ctx.bound == ctx ? &s_ctx.primary : s_ctx.bound;
+    client_context_bind(ctx);
+    for (int i = s_ctx.count - 1; i >= 0; i--) {
+        if (s_ctx.slots[i].release) s_ctx.slots[i].release();
+    }
+    client_context_bind(back);
+    free(ctx->state);
+    free(ctx->saved);
+    free(ctx);
+}
+
+ClientContext* client_context_bound(void) {
+    return &s_ctx.primary == s_ctx.bound ? NULL : s_ctx.bound;
+}
+
+bool client_context_is_primary(void) {
+    return &s_ctx.primary == s_ctx.bound;
+}
@@ -0,0 +1,67 @@
+#ifndef CYBERIA_CLIENT_CONTEXT_H
+#define CYBERIA_CLIENT_CONTEXT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/* client_context — more than one world view in one process.
+ *
+ * A context is what one session's world is made of: its GameState mirror
+ * and the module state around it (entity indices and tracked sets, the
+ * decoder's item dictionary and section hashes, session clock, prediction,
+ * interpolation window, camera, net telemetry). Caches that are immutable
+ * once loaded — object layers, atlases and textures, the static-world
+ * layers, item metadata — are not part of it: every view draws from the
+ * one copy, so a second view costs its world mirror and no asset memory.
+ *
+ * Exactly one context is bound, and every existing call works on it; no
+ * call site takes a context argument. The GameState is switched by pointer
+ * (g_game_state names the bound one's); module state handed to
+ * client_context_register() is swapped in and out on bind, a memcpy of a
+ * few hundred KB. The primary context is bound at start and owns the
+ * socket, the UI and the entity listeners. Other views have no uplink;
+ * they are fed with game_client_inject_message() and drawn while bound:
+ *
+ *   client_context_bind(view);
+ *   game_client_inject_message(data, len, is_text);
+ *   ...
+ *   client_context_bind(NULL);
+ *
+ * Bind the primary back before yielding to the browser: fetch callbacks
+ * and socket events land in whichever context is bound when they run.
+ * Process-wide state (the connection, fetch queue, render caches keyed on
+ * world_revision / commit_epoch, which never repeat across views) stays
+ * outside. */
+
+#ifndef CLIENT_CONTEXT_MAX_SLOTS
+#define CLIENT_CONTEXT_MAX_SLOTS 32
+#endif
+
+typedef struct ClientContext ClientContext;
+
+/* Register every module's per-view state and keep its initial image for
+ * new contexts. Call once at startup, before any of that state changes;
+ * without it only the primary context exists. */
+void client_context_init(void);
+
+/* For the modules' *_context_register(), from client_context_init() only.
+ * `release` (may be NULL) frees the heap the bound copy owns; it runs with
+ * a context bound when that context is destroyed. */
+void client_context_register(void* state, size_t size, void (*release)(void));
+
+/* A fresh, empty world view, as the primary was at startup. */
+ClientContext* client_context_create(void);
+
+/* Free a view and everything its world holds. Never the primary; the
+ * primary is bound afterwards if `ctx` was. */
+void client_context_destroy(ClientContext* ctx);
+
+/* Make `ctx` (NULL: the primary) the view every call works on. */
+void client_context_bind(ClientContext* ctx);
+
+/* The bound context; NULL when it is the primary. */
+ClientContext* client_context_bound(void);
+
+bool client_context_is_primary(void);
+
+#endif /* CYBERIA_CLIENT_CONTEXT_H */
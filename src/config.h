@@ -2,6 +2,7 @@
 #define CONFIG_H
 
 #include <stdbool.h>
+#include <stddef.h>
 
 // --------------------------------------------------------
 // URLs
@@ -24,6 +25,25 @@ static const char* API_BASE_URL =
 // Simulation
 #define TICK_RATE_HZ          30
 #define TICK_DURATION_S       (1.0 / (double)TICK_RATE_HZ)
+/* Main loop runs on every Nth requestAnimationFrame: TICK_RATE_HZ on a
+ * 60 Hz display, paced by the browser instead of raylib's frame wait. */
+#define MAIN_LOOP_VSYNC_INTERVAL 2
+
+/* Frame pacing (frame_pacing.h): after FRAME_PACING_IDLE_SECONDS without
+ * input, motion or network deltas the loop drops to every
+ * FRAME_PACING_IDLE_INTERVAL-th frame; while the tab is hidden it stops and
+ * the network drains every FRAME_PACING_HIDDEN_TICK_MS instead. */
+#define FRAME_PACING_IDLE_SECONDS    4.0
+#define FRAME_PACING_IDLE_INTERVAL   6
+#define FRAME_PACING_HIDDEN_TICK_MS  250.0
+
+/* Progressive start: the loading screen waits only for the critical path —
+ * FETCH_CLASS_VISIBLE requests (font, hints, on-screen atlases) and their
+ * decodes — and the rest of the AOI streams in after the player starts.
+ * 0 restores waiting for the whole fetch pipeline to go idle. */
+#ifndef LOAD_PROGRESSIVE_START
+#define LOAD_PROGRESSIVE_START 1
+#endif
 
 /* Bootstrap fallback for the render-tick interpolation offset, in ticks.
  * The live value is derived from the runtime interpolation window
@@ -31,6 +51,66 @@ static const char* API_BASE_URL =
  * constant only applies before that window is hydrated. */
 #define INTERP_TICKS          2
 
+/* Adaptive interpolation window: after INTERP_ADAPT_MIN_SAMPLES snapshot
+ * arrivals the window tracks mean + INTERP_JITTER_K × stddev of the measured
+ * inter-arrival time, clamped to [MIN, MAX] ms. */
+#define INTERP_ADAPT_MIN_SAMPLES 16
+#define INTERP_JITTER_K          2.0
+#define INTERP_WINDOW_MIN_MS     34
+#define INTERP_WINDOW_MAX_MS     400
+
+/* Dead reckoning for late snapshots: once the render tick passes an
+ * entity's newest sample it keeps moving at the velocity of its last two
+ * samples for at most INTERP_EXTRAPOLATE_MS (0 holds still instead); the
+ * miss is then blended out with an INTERP_ERROR_DECAY_MS time constant. */
+#ifndef INTERP_EXTRAPOLATE_MS
+#define INTERP_EXTRAPOLATE_MS    100
+#endif
+#define INTERP_ERROR_DECAY_MS    100
+
+/* Clock sync (WIRE_CAP_EXT_CLOCK_SYNC): one UPLINK_CLOCK_PING every
+ * CLOCK_SYNC_INTERVAL_SECONDS, the first CLOCK_SYNC_BURST of a connection
+ * CLOCK_SYNC_BURST_SECONDS apart so the estimate settles quickly. The
+ * server clock offset is taken from the lowest-RTT pong of the last
+ * CLOCK_SYNC_SAMPLES; moves of more than CLOCK_SYNC_STEP_TICKS apply at
+ * once, smaller ones are eased in. Pongs slower than CLOCK_SYNC_MAX_RTT_MS
+ * are ignored. */
+#define CLOCK_SYNC_INTERVAL_SECONDS 2.0
+#define CLOCK_SYNC_BURST            5
+#define CLOCK_SYNC_BURST_SECONDS    0.2
+#define CLOCK_SYNC_SAMPLES          8
+#define CLOCK_SYNC_STEP_TICKS       2.0
+#define CLOCK_SYNC_MAX_RTT_MS       2000
+
+/* Input batching (WIRE_CAP_INPUT_BATCH): each batch carries the newest
+ * INPUT_BATCH_REDUNDANCY unacked taps, and is resent every
+ * INPUT_BATCH_RESEND_TICKS while any stay unacked. */
+#define INPUT_BATCH_REDUNDANCY   4
+#define INPUT_BATCH_RESEND_TICKS 3
+
+/* Uplink backpressure: while the socket's bufferedAmount exceeds this,
+ * network_uplink_flush() sends control frames only and keeps the rest
+ * (movement coalesced to the newest frame) for a later flush. */
+#define UPLINK_BACKPRESSURE_BYTES 1024
+
+/* Frame budget: while the smoothed snapshot decode plus render time per
+ * frame exceeds CLIENT_FRAME_BUDGET_MS (and until it falls back under
+ * CLIENT_FRAME_BUDGET_CLEAR_MS), drain_inbox drops snapshots a later queued
+ * full frame supersedes. The cost goes to the server in UPLINK_CLIENT_BUDGET
+ * every CLIENT_BUDGET_REPORT_SECONDS. */
+#define CLIENT_FRAME_BUDGET_MS        10.0f
+#define CLIENT_FRAME_BUDGET_CLEAR_MS  8.0f
+#define CLIENT_BUDGET_REPORT_SECONDS  2.0
+
+/* Reconnect backoff: the delay starts at RECONNECT_BASE_SECONDS, doubles per
+ * failed attempt up to RECONNECT_MAX_SECONDS, and each wait is jittered
+ * down to half of it so a server restart is not met by every client at once.
+ * Within RESUME_WINDOW_SECONDS of the drop the client resumes its session
+ * (UPLINK_RESUME) instead of rebuilding it. */
+#define RECONNECT_BASE_SECONDS   0.5
+#define RECONNECT_MAX_SECONDS    30.0
+#define RESUME_WINDOW_SECONDS    120.0
+
 // ============================================================================
 // Cache Configuration
 // ============================================================================
@@ -45,6 +125,22 @@ static const char* API_BASE_URL =
  */
 static const int MAX_TEXTURE_CACHE_SIZE = 512;
 
+/**
+ * @brief GPU memory budget for atlas textures kept outside the shared pages
+ *
+ * Estimated as width × height × 4 per texture; least-recently-used ones
+ * are evicted past it. Paged atlases are bounded by the pages themselves.
+ */
+static const size_t MAX_TEXTURE_CACHE_BYTES = 128u * 1024u * 1024u;
+
+/**
+ * @brief Decoded image bytes uploaded to the GPU per frame
+ *
+ * Streamed textures past this wait for the next frame; one 1024² RGBA
+ * image. The first image of a frame is uploaded regardless of size.
+ */
+#define IMAGE_UPLOAD_BYTES_PER_FRAME (4u * 1024u * 1024u)
+
 /**
  * @brief Maximum number of object layers in the cache
  *
@@ -62,6 +158,96 @@ static const int MAX_LAYER_CACHE_SIZE = 256;
  */
 static const int MAX_ATLAS_CACHE_SIZE = 256;
 
+/**
+ * @brief Coalescing of atlas metadata requests
+ *
+ * Items first drawn within the window share one bulk metadata request of
+ * up to this many keys, instead of a round-trip each.
+ */
+#define ATLAS_META_BATCH_MAX_KEYS  32
+#define ATLAS_META_BATCH_WINDOW_MS 50.0
+
+/**
+ * @brief Coalescing of quest / action / dialogue metadata prefetches
+ *
+ * Codes of NPCs entering the AOI within the window share one bulk request
+ * per kind, at FETCH_CLASS_PREFETCH.
+ */
+#define META_PREFETCH_BATCH_MAX_KEYS  32
+#define META_PREFETCH_BATCH_WINDOW_MS 100.0
+
+/**
+ * @brief Network requests the engine_client scheduler keeps in flight
+ *
+ * Roughly one browser connection pool per origin; everything else waits
+ * in priority order.
+ */
+#define FETCH_MAX_IN_FLIGHT 6
+
+/**
+ * @brief engine_client request policy
+ *
+ * Timeout per FetchClass, in enum order. A request that fails on the
+ * network, times out or is answered 408 / 429 / 5xx is tried again up to
+ * FETCH_RETRY_MAX more times, the n-th after a random delay in
+ * [½, 1] · min(FETCH_RETRY_BASE_MS · 2ⁿ, FETCH_RETRY_CAP_MS); only then
+ * does its owner see the failure.
+ */
+#define FETCH_TIMEOUT_MS     { 15000, 20000, 30000, 10000 }
+#define FETCH_RETRY_MAX      3
+#define FETCH_RETRY_BASE_MS  500.0
+#define FETCH_RETRY_CAP_MS   8000.0
+
+/* Accept header of every engine request: MessagePack metadata where the
+ * engine has it (msgpack_decode.h), JSON otherwise; blobs fall under the
+ * wildcard. CORS-safelisted, so it adds no preflight. The engine answers
+ * with Vary: Accept so ETags and caches keep the encodings apart. */
+#define FETCH_ACCEPT "application/msgpack, application/json;q=0.9, */*;q=0.8"
+
+/**
+ * @brief Boot asset pack (asset_pack.h, built by pack-assets.py)
+ *
+ * Fetched from the engine API at startup; requests whose URL starts with
+ * ASSET_PACK_SCOPE wait for it and are answered from it when it holds them.
+ * Without a pack on the engine they fall back to one fetch each.
+ */
+#define ASSET_PACK_URL   "/assets/boot.pack"
+#define ASSET_PACK_SCOPE "/assets/"
+
+/**
+ * @brief Static world layers (static_world.h)
+ *
+ * Maps whose floors, obstacles, portals and foregrounds stay in memory for
+ * portal travel back and forth, and the engine route of a map's blob (%s =
+ * mapCode), persisted in IndexedDB under the announced version.
+ * The layer is paged in STATIC_CHUNK_CELLS chunks: those within the load
+ * margin (in chunks) of the camera come in, and leave past the unload one.
+ */
+#define STATIC_WORLD_MAPS    8
+#define STATIC_WORLD_URL_FMT "/api/cyberia-map/static-world/%s"
+#define STATIC_CHUNK_CELLS          32
+#define STATIC_CHUNK_LOAD_MARGIN    1
+#define STATIC_CHUNK_UNLOAD_MARGIN  2
+
+/* Portal prewarm (portal_prewarm.h): past this hold progress the
+ * destination's static layer and up to PORTAL_PREWARM_ITEMS of the atlases
+ * it draws are fetched at prefetch priority. */
+#define PORTAL_PREWARM_PROGRESS     0.3f
+#define PORTAL_PREWARM_ITEMS        128
+
+/* Queued atlas blob fetches not asked for in this long are cancelled. */
+#define ATLAS_FETCH_CANCEL_IDLE_SECONDS 2.0
+#define ATLAS_FETCH_CANCEL_SCAN_SECONDS 1.0
+
+/* Atlas metadata that still failed after the request retries is asked for
+ * again once this long has passed, doubling per failure up to the cap. */
+#define ATLAS_META_RETRY_SECONDS     5.0
+#define ATLAS_META_RETRY_MAX_SECONDS 120.0
+
+/* Prefetch sweep over the AOI; must stay well under the cancel idle time
+ * so pending prefetches are not cancelled between sweeps. */
+#define ATLAS_PREFETCH_SCAN_SECONDS 0.5
+
 // ============================================================================
 // Animation Configuration
 // ============================================================================
@@ -0,0 +1,362 @@
+#include "crowd_gen.h"
+
+#include "binary_aoi_decoder.h"
+#include "game_state.h"
+#include "network/replication.h"
+#include "object_layer.h"
+#include "util/log.h"
+
+#include <raylib.h>
+
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CROWD_ITEM_POOL 32
+#define CROWD_FULL_MASK (BIN_DELTA_POS | BIN_DELTA_DIMS | BIN_DELTA_DIR_MODE | \
+                         BIN_DELTA_LIFE | BIN_DELTA_LAYERS | BIN_DELTA_STATUS)
+
+typedef struct {
+    char     id[MAX_ID_LENGTH];
+    Vector2  pos;
+    float    heading;     /* radians, screen axes (y down) */
+    uint8_t  direction;
+    uint8_t  item_base;   /* first pool index of its layer stack */
+    bool     bot;
+    bool     fresh;       /* next frame sends every field */
+} CrowdAgent;
+
+static struct {
+    bool           active;
+    CrowdGenConfig config;
+    CrowdAgent*    agents;
+    int            count;
+    bool           spawned;
+    uint32_t       serial;
+    uint32_t       rng;
+    double         next_due;
+    double         last_sent;
+    double         churn_acc;
+    char           items[CROWD_ITEM_POOL][MAX_ITEM_ID_LENGTH];
+    int            item_count;
+    uint8_t*       buf;
+    size_t         len;
+    size_t         cap;
+    CrowdGenStats  stats;
+} g_crowd;
+
+/* ── Frame writer ────────────────────────────────────────────────────── */
+
+static void reserve(size_t n) {
+    if (g_crowd.len + n <= g_crowd.cap) return;
+    while (g_crowd.len + n > g_crowd.cap) g_crowd.cap = g_crowd.cap ? g_crowd.cap * 2 : 16 * 1024;
+    g_crowd.buf = realloc(g_crowd.buf, g_crowd.cap);
+    assert(g_crowd.buf);
+}
+
+static void put_u8(uint8_t v) {
+    reserve(1);
+    g_crowd.buf[g_crowd.len++] = v;
+}
+
+static void put_u16(uint16_t v) {
+    put_u8((uint8_t)v);
+    put_u8((uint8_t)(v >> 8));
+}
+
+static void put_u32(uint32_t v) {
+    put_u16((uint16_t)v);
+    put_u16((uint16_t)(v >> 16));
+}
+
+static void put_f32(float f) {
+    uint32_t bits;
+    memcpy(&bits, &f, sizeof(bits));
+    put_u32(bits);
+}
+
+static void put_str(const char* s) {
+    size_t n = strlen(s);
+    assert(UINT8_MAX >= n);
+    put_u8((uint8_t)n);
+    reserve(n);
+    memcpy(g_crowd.buf + g_crowd.len, s, n);
+    g_crowd.len += n;
+}
+
+/* Fixed 36-byte, zero-padded id field. */
+static void put_id(const char* id) {
+    char field[36] = { 0 };
+    strncpy(field, id, sizeof(field));
+    reserve(sizeof(field));
+    memcpy(g_crowd.buf + g_crowd.len, field, sizeof(field));
+    g_crowd.len += sizeof(field);
+}
+
+/* ── Agents ──────────────────────────────────────────────────────────── */
+
+static uint32_t rng_next(void) {
+    uint32_t x = g_crowd.rng;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    g_crowd.rng = x;
+    return x;
+}
+
+static float rng_unit(void) {
+    return (float)(rng_next() >> 8) / 16777216.0f;
+}
+
+static float aoi_radius(void) {
+    return 0.0f < g_game_state.aoi_radius ? g_game_state.aoi_radius : 16.0f;
+}
+
+static Vector2 anchor(void) {
+    return g_game_state.player.base.pos_server;
+}
+
+static void agent_respawn(CrowdAgent* a) {
+    snprintf(a->id, sizeof(a->id), "crowd-%s-%08u", a->bot ? "bot" : "player",
+             (unsigned)++g_crowd.serial);
+    float angle = 6.2831853f * rng_unit();
+    float r     = aoi_radius() * 0.9f * sqrtf(rng_unit());
+    Vector2 c   = anchor();
+    a->pos       = (Vector2){ c.x + r * cosf(angle), c.y + r * sinf(angle) };
+    a->heading   = 6.2831853f * rng_unit();
+    a->item_base = (uint8_t)(rng_next() % CROWD_ITEM_POOL);
+    a->fresh     = true;
+    g_crowd.stats.entered++;
+}
+
+/* Eight-way facing from the heading; 0 is up. */
+static uint8_t heading_direction(float heading) {
+    int octant = (int)lroundf(atan2f(cosf(heading), -sinf(heading)) / 0.78539816f);
+    return (uint8_t)((octant + 8) % 8);
+}
+
+static void agent_walk(CrowdAgent* a, float dt) {
+    Vector2 c = anchor();
+    float dx = c.x - a->pos.x, dy = c.y - a->pos.y;
+    float reach = aoi_radius() * 0.9f;
+    /* Wander, turning back toward the player at the edge of the AOI. */
+    if (dx * dx + dy * dy > reach * reach) a->heading = atan2f(dy, dx);
+    else                                   a->heading += (rng_unit() - 0.5f) * 1.2f;
+
+    float step = g_crowd.config.speed * dt;
+    a->pos.x += step * cosf(a->heading);
+    a->pos.y += step * sinf(a->heading);
+    float max_x = (float)(g_game_state.grid_w - 1), max_y = (float)(g_game_state.grid_h - 1);
+    a->pos.x = a->pos.x < 0.0f ? 0.0f : (a->pos.x > max_x ? max_x : a->pos.x);
+    a->pos.y = a->pos.y < 0.0f ? 0.0f : (a->pos.y > max_y ? max_y : a->pos.y);
+    a->direction = heading_direction(a->heading);
+}
+
+/* Item ids the session already knows: entity defaults, then whatever the
+ * local player and the visible bots wear. */
+static void add_item(const char* item_id) {
+    if ('\0' == item_id[0] || CROWD_ITEM_POOL <= g_crowd.item_count) return;
+    for (int i = 0; i < g_crowd.item_count; i++) {
+        if (0 == strcmp(g_crowd.items[i], item_id)) return;
+    }
+    snprintf(g_crowd.items[g_crowd.item_count++], MAX_ITEM_ID_LENGTH, "%s", item_id);
+}
+
+static void collect_items(void) {
+    const GameState* gs = &g_game_state;
+    g_crowd.item_count = 0;
+    for (int i = 0; i < gs->entity_defaults_count; i++) {
+        for (int k = 0; k < gs->entity_defaults[i].live_item_id_count; k++) {
+            add_item(gs->entity_defaults[i].live_item_ids[k]);
+        }
+    }
+    for (int k = 0; k < gs->player.base.object_layer_count; k++) {
+        add_item(gs->player.base.object_layers[k].item_id);
+    }
+    for (int i = 0; i < gs->bot_count; i++) {
+        for (int k = 0; k < gs->bots[i].base.object_layer_count; k++) {
+            add_item(gs->bots[i].base.object_layers[k].item_id);
+        }
+    }
+    if (0 == g_crowd.item_count) add_item("anon");
+}
+
+/* ── Frames ──────────────────────────────────────────────────────────── */
+
+static void begin_frame(uint16_t count) {
+    g_crowd.len = 0;
+    put_u8(BIN_MSG_AOI_DELTA);
+    put_u32((uint32_t)session_last_server_tick());
+    put_u32((uint32_t)session_last_acked_input_sequence());
+    put_u16(count);
+}
+
+static void put_removed(const CrowdAgent* a) {
+    put_u8((a->bot ? BIN_ENTITY_BOT : BIN_ENTITY_PLAYER) | BIN_FLAG_REMOVED);
+    put_id(a->id);
+}
+
+static void put_agent(const CrowdAgent* a) {
+    uint8_t mask = BIN_DELTA_POS | BIN_DELTA_DIR_MODE;
+    if (a->fresh) mask = CROWD_FULL_MASK | (a->bot ? BIN_DELTA_BOT_META : 0);
+
+    put_u8(a->bot ? BIN_ENTITY_BOT : BIN_ENTITY_PLAYER);
+    put_id(a->id);
+    put_u8(mask);
+    put_f32(a->pos.x);
+    put_f32(a->pos.y);
+    if (mask & BIN_DELTA_DIMS) {
+        put_f32(1.0f);
+        put_f32(1.0f);
+    }
+    put_u8(a->direction);
+    put_u8(MODE_WALKING);
+    if (mask & BIN_DELTA_LIFE) {
+        put_f32(100.0f);
+        put_f32(100.0f);
+    }
+    if (mask & BIN_DELTA_LAYERS) {
+        int n = g_crowd.config.layers;
+        put_u8((uint8_t)n);
+        for (int k = 0; k < n; k++) {
+            put_str(g_crowd.items[(a->item_base + k) % g_crowd.item_count]);
+            put_u16(1);
+        }
+    }
+    if (mask & BIN_DELTA_STATUS) {
+        put_u16(0);
+        put_u8(0);
+    }
+    if (mask & BIN_DELTA_BOT_META) {
+        put_str("crowd");
+        put_str("");     /* caster */
+        put_u8(0);       /* interaction flags */
+        put_str("");     /* action code */
+        put_u8(0);       /* quest codes */
+        put_u8(0);       /* talk codes */
+    }
+}
+
+static void submit_frame(void) {
+    double t0 = GetTime();
+    int rc = binary_aoi_process(g_crowd.buf, g_crowd.len);
+    g_crowd.stats.last_decode_ms = (GetTime() - t0) * 1000.0;
+    g_crowd.stats.last_bytes     = (uint32_t)g_crowd.len;
+    g_crowd.stats.frames++;
+    if (0 != rc) {
+        LOG_ERROR("[CROWD] synthetic frame rejected (%zu bytes); stopping", g_crowd.len);
+        g_crowd.active = false;
+    }
+}
+
+/* A server full frame rebuilt the remote arrays without us. */
+static bool crowd_wiped(void) {
+    for (int i = 0; i < g_crowd.count; i++) {
+        const CrowdAgent* a = &g_crowd.agents[i];
+        if (a->fresh) continue;
+        if (a->bot) return NULL == game_state_find_bot(a->id);
+        return NULL == game_state_find_player(a->id);
+    }
+    return false;
+}
+
+static int clamp_int(int v, int lo, int hi) {
+    return v < lo ? lo : (v > hi ? hi : v);
+}
+
+/* Deferred to the first frame with a grid, so a crowd started from the URL
+ * spawns around the player and wears the session's items. */
+static void spawn_agents(void) {
+    collect_items();
+    const CrowdGenConfig* config = &g_crowd.config;
+    g_crowd.config.layers = clamp_int(config->layers, 1, MAX_OBJECT_LAYERS);
+    if (g_crowd.config.layers > g_crowd.item_count) g_crowd.config.layers = g_crowd.item_count;
+
+    g_crowd.count  = config->bots + config->players;
+    g_crowd.agents = realloc(g_crowd.agents, (size_t)(g_crowd.count ? g_crowd.count : 1) * sizeof(CrowdAgent));
+    assert(g_crowd.agents);
+    for (int i = 0; i < g_crowd.count; i++) {
+        g_crowd.agents[i] = (CrowdAgent){ .bot = i < config->bots };
+        agent_respawn(&g_crowd.agents[i]);
+    }
+    g_crowd.spawned = true;
+    LOG_INFO("[CROWD] %d bots, %d players, %d layers from %d item ids at %.0f Hz",
+             config->bots, config->players, config->layers,
+             g_crowd.item_count, config->snapshot_hz);
+}
+
+void crowd_gen_start(const CrowdGenConfig* config) {
+    assert(config);
+    if (g_crowd.active) crowd_gen_stop();
+
+    g_crowd.config         = *config;
+    g_crowd.config.bots    = clamp_int(config->bots, 0, MAX_ENTITIES);
+    g_crowd.config.players = clamp_int(config->players, 0, MAX_ENTITIES);
+    if (0.0f >= g_crowd.config.snapshot_hz) g_crowd.config.snapshot_hz = 30.0f;
+
+    g_crowd.rng       = 0x9E3779B9u;
+    g_crowd.stats     = (CrowdGenStats){ 0 };
+    g_crowd.churn_acc = 0.0;
+    g_crowd.count     = 0;
+    g_crowd.spawned   = false;
+    g_crowd.last_sent = g_crowd.next_due = GetTime();
+    g_crowd.active    = true;
+}
+
+void crowd_gen_stop(void) {
+    if (!g_crowd.active) return;
+    g_crowd.active = false;
+    if (g_crowd.spawned) {
+        begin_frame((uint16_t)g_crowd.count);
+        for (int i = 0; i < g_crowd.count; i++) put_removed(&g_crowd.agents[i]);
+        submit_frame();
+    }
+    g_crowd.stats.left += (uint32_t)g_crowd.count;
+    g_crowd.count   = 0;
+    g_crowd.spawned = false;
+    LOG_INFO("[CROWD] stopped after %u frames", (unsigned)g_crowd.stats.frames);
+}
+
+bool crowd_gen_active(void) { return g_crowd.active; }
+
+void crowd_gen_tick(void) {
+    if (!g_crowd.active || 0 >= g_game_state.grid_w) return;
+    double now = GetTime();
+    if (now < g_crowd.next_due) return;
+    if (!g_crowd.spawned) {
+        spawn_agents();
+        g_crowd.last_sent = now;
+    }
+    float dt = (float)(now - g_crowd.last_sent);
+    g_crowd.last_sent = now;
+    g_crowd.next_due  = now + 1.0 / (double)g_crowd.config.snapshot_hz;
+
+    if (crowd_wiped()) {
+        for (int i = 0; i < g_crowd.count; i++) g_crowd.agents[i].fresh = true;
+    }
+
+    /* Churned agents leave under their old id and enter under a new one. */
+    g_crowd.churn_acc += (double)g_crowd.config.churn_per_s * (double)g_crowd.count * (double)dt;
+    int churn = (int)g_crowd.churn_acc;
+    churn = churn < g_crowd.count ? churn : g_crowd.count;
+    g_crowd.churn_acc -= (double)churn;
+
+    begin_frame((uint16_t)(g_crowd.count + churn));
+    for (int i = 0; i < churn; i++) {
+        CrowdAgent* a = &g_crowd.agents[rng_next() % (uint32_t)g_crowd.count];
+        put_removed(a);
+        agent_respawn(a);
+        g_crowd.stats.left++;
+    }
+    for (int i = 0; i < g_crowd.count; i++) {
+        CrowdAgent* a = &g_crowd.agents[i];
+        if (!a->fresh) agent_walk(a, dt);
+        put_agent(a);
+        a->fresh = false;
+    }
+    submit_frame();
+}
+
+CrowdGenStats crowd_gen_stats(void) { return g_crowd.stats; }
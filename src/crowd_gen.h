@@ -0,0 +1,55 @@
+#ifndef CYBERIA_CROWD_GEN_H
+#define CYBERIA_CROWD_GEN_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * Synthetic crowd for client stress tests (dev builds).
+ *
+ * Fills GameState with bots and players that random-walk around the local
+ * player inside the AOI radius, each wearing a stack of item ids taken from
+ * the live session, so the atlas, depth-sort and render paths see real
+ * textures. Every snapshot is a BIN_MSG_AOI_DELTA frame fed through
+ * binary_aoi_process(), the same decode path a server frame takes; churn
+ * removes agents and admits fresh ids so AOI enter/leave costs show up too.
+ *
+ * Frames carry the last server tick and input ack, so prediction and the
+ * snapshot arrival stats are left undisturbed. Server full frames wipe
+ * remote entities; the next synthetic frame notices and re-sends every
+ * field. Needs INIT_DATA (the grid) before the first frame.
+ */
+
+typedef struct {
+    int   bots;          /* clamped to MAX_ENTITIES */
+    int   players;       /* clamped to MAX_ENTITIES */
+    int   layers;        /* item ids per agent, clamped to MAX_OBJECT_LAYERS */
+    float snapshot_hz;   /* synthetic frames per second */
+    float churn_per_s;   /* share of agents replaced per second */
+    float speed;         /* cells per second */
+} CrowdGenConfig;
+
+#define CROWD_GEN_DEFAULTS \
+    { .bots = 200, .players = 100, .layers = 3, .snapshot_hz = 30.0f, \
+      .churn_per_s = 0.05f, .speed = 3.0f }
+
+typedef struct {
+    uint32_t frames;
+    uint32_t entered;      /* agents admitted, churn included */
+    uint32_t left;         /* agents removed by churn */
+    uint32_t last_bytes;   /* size of the last frame */
+    double   last_decode_ms;
+} CrowdGenStats;
+
+/* Replaces any running crowd. */
+void crowd_gen_start(const CrowdGenConfig* config);
+/* Removes every synthetic agent through one last frame. */
+void crowd_gen_stop(void);
+bool crowd_gen_active(void);
+
+/* Emits the next frame when one is due; call once per client frame. */
+void crowd_gen_tick(void);
+
+CrowdGenStats crowd_gen_stats(void);
+
+#endif /* CYBERIA_CROWD_GEN_H */
@@ -0,0 +1,158 @@
+#include "dev_overlay.h"
+
+#include "domain/camera.h"
+#include "render_queue.h"
+#include "ui/text.h"
+#include "world_target.h"
+#include "util/log.h"
+
+#include <assert.h>
+#include <math.h>
+#include <raylib.h>
+#include <rlgl.h>
+#include <string.h>
+
+#define DEV_OVERLAY_LABEL_LEN 16
+
+/* fragTexCoord is the cell coordinate; a fragment within half a texel of a
+ * whole cell lies on a line. highp where the fragment stage has it, so
+ * fract() stays exact far from the origin. */
+static const char *const GRID_FRAGMENT_SHADER =
+    "#version 100\n"
+    "#ifdef GL_FRAGMENT_PRECISION_HIGH\n"
+    "precision highp float;\n"
+    "#else\n"
+    "precision mediump float;\n"
+    "#endif\n"
+    "varying vec2 fragTexCoord;\n"
+    "varying vec4 fragColor;\n"
+    "uniform float texelsPerCell;\n"
+    "void main() {\n"
+    "    vec2 d = abs(fract(fragTexCoord + 0.5) - 0.5) * texelsPerCell;\n"
+    "    float line = clamp(1.0 - min(d.x, d.y), 0.0, 1.0);\n"
+    "    gl_FragColor = vec4(fragColor.rgb, fragColor.a * line);\n"
+    "}\n";
+
+typedef struct {
+    Rectangle dest;
+    Color     color;
+    char      label[DEV_OVERLAY_LABEL_LEN];
+} DevBox;
+
+static struct {
+    bool      tried;
+    Shader    shader;
+    int       loc_texels_per_cell;
+    Rectangle view;        /* cells */
+    float     cell_size;
+    DevBox    boxes[DEV_OVERLAY_MAX_BOXES];
+    int       box_count;
+} g_dev;
+
+/* False when the shader does not compile here. */
+static bool grid_shader_ready(void) {
+    if (!g_dev.tried) {
+        g_dev.tried  = true;
+        g_dev.shader = LoadShaderFromMemory(NULL, GRID_FRAGMENT_SHADER);
+        if (g_dev.shader.id == rlGetShaderIdDefault()) {
+            LOG_WARN("[dev_overlay] grid shader unavailable, drawing visible lines");
+            g_dev.shader.id = 0;
+        } else {
+            g_dev.loc_texels_per_cell = GetShaderLocation(g_dev.shader, "texelsPerCell");
+        }
+    }
+    return 0 != g_dev.shader.id;
+}
+
+void dev_overlay_begin(Rectangle view, float cell_size) {
+    assert(0.0f < cell_size);
+    g_dev.view      = view;
+    g_dev.cell_size = cell_size;
+    g_dev.box_count = 0;
+}
+
+void dev_overlay_box(Rectangle dest, const char* entity_type) {
+    assert(entity_type);
+    float cs = g_dev.cell_size;
+    Rectangle view_px = { g_dev.view.x * cs, g_dev.view.y * cs,
+                          g_dev.view.width * cs, g_dev.view.height * cs };
+    /* The label sits 10 px above the box. */
+    Rectangle reach = { dest.x, dest.y - 10.0f, dest.width, dest.height + 10.0f };
+    if (!CheckCollisionRecs(reach, view_px)) return;
+    if (DEV_OVERLAY_MAX_BOXES <= g_dev.box_count) return;
+
+    Color color = RED;
+    if (0 == strcmp(entity_type, "self")) color = BLUE;
+    else if (0 == strcmp(entity_type, "other")) color = ORANGE;
+    else if (0 == strcmp(entity_type, "bot")) color = GREEN;
+
+    DevBox* box = &g_dev.boxes[g_dev.box_count++];
+    *box = (DevBox){ .dest = dest, .color = color };
+    strncpy(box->label, entity_type, sizeof(box->label) - 1);
+}
+
+void dev_overlay_draw_boxes(void) {
+    if (0 == g_dev.box_count) return;
+    if (render_queue_is_open()) render_queue_flush();
+    /* Lines and the default font share the shapes texture: one batch. */
+    for (int i = 0; i < g_dev.box_count; i++) {
+        const DevBox* box = &g_dev.boxes[i];
+        DrawRectangleLinesEx(box->dest, 1.0f, box->color);
+        DrawText(box->label, (int)box->dest.x, (int)box->dest.y - 10, 10, box->color);
+    }
+    g_dev.box_count = 0;
+}
+
+/* Cell lines one by one, only those crossing the view. */
+static void grid_lines(int x0, int y0, int x1, int y1, Color color) {
+    float cs = g_dev.cell_size;
+    for (int x = x0; x <= x1; x++) {
+        DrawLineEx((Vector2){ x * cs, y0 * cs }, (Vector2){ x * cs, y1 * cs }, 1.0f, color);
+    }
+    for (int y = y0; y <= y1; y++) {
+        DrawLineEx((Vector2){ x0 * cs, y * cs }, (Vector2){ x1 * cs, y * cs }, 1.0f, color);
+    }
+}
+
+void dev_overlay_grid(int grid_w, int grid_h) {
+    float cs = g_dev.cell_size;
+    Color line_color = (Color){ 255, 0, 0, 100 };
+
+    /* Visible cells of the map, whole cells out to the view's edges. */
+    int x0 = (int)fmaxf(floorf(g_dev.view.x), 0.0f);
+    int y0 = (int)fmaxf(floorf(g_dev.view.y), 0.0f);
+    int x1 = (int)fminf(ceilf(g_dev.view.x + g_dev.view.width), (float)grid_w);
+    int y1 = (int)fminf(ceilf(g_dev.view.y + g_dev.view.height), (float)grid_h);
+
+    if (x0 < x1 && y0 < y1) {
+        if (grid_shader_ready()) {
+            Camera2D view;
+            RenderTexture2D target;
+            float zoom = world_target_view(&view, &target) ? view.zoom : camera_get().zoom;
+            float texels_per_cell = cs * zoom;
+            SetShaderValue(g_dev.shader, g_dev.loc_texels_per_cell, &texels_per_cell,
+                           SHADER_UNIFORM_FLOAT);
+            BeginShaderMode(g_dev.shader);
+            rlSetTexture(rlGetTextureIdDefault());
+            rlBegin(RL_QUADS);
+                rlColor4ub(line_color.r, line_color.g, line_color.b, line_color.a);
+                rlTexCoord2f((float)x0, (float)y0); rlVertex2f(x0 * cs, y0 * cs);
+                rlTexCoord2f((float)x0, (float)y1); rlVertex2f(x0 * cs, y1 * cs);
+                rlTexCoord2f((float)x1, (float)y1); rlVertex2f(x1 * cs, y1 * cs);
+                rlTexCoord2f((float)x1, (float)y0); rlVertex2f(x1 * cs, y0 * cs);
+            rlEnd();
+            rlSetTexture(0);
+            EndShaderMode();
+        } else {
+            grid_lines(x0, y0, x1, y1, line_color);
+        }
+    }
+
+    DrawRectangleLinesEx((Rectangle){ 0, 0, grid_w * cs, grid_h * cs }, 2.0f, WHITE);
+}
+
+void dev_overlay_release(void) {
+    if (0 != g_dev.shader.id) UnloadShader(g_dev.shader);
+    g_dev.shader = (Shader){ 0 };
+    g_dev.tried  = false;
+}
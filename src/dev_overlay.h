@@ -0,0 +1,35 @@
+#ifndef CYBERIA_DEV_OVERLAY_H
+#define CYBERIA_DEV_OVERLAY_H
+
+#include <raylib.h>
+
+/* Dev UI debug overlays, drawn at a cost that does not depend on the map.
+ *
+ * The cell grid is one quad over the visible part of the map, its lines
+ * found per fragment from the cell coordinates the quad carries; where the
+ * shader does not compile, only the visible lines are drawn. Entity boxes
+ * are culled to the camera and queued as the passes draw, then drawn with
+ * their labels in one run per pass (dev_overlay_draw_boxes), so the queue
+ * is flushed once per pass instead of once per entity. */
+
+#ifndef DEV_OVERLAY_MAX_BOXES
+#define DEV_OVERLAY_MAX_BOXES 1024   /* per pass; further boxes are dropped */
+#endif
+
+/* Start a frame: `view` is the camera bounds in cells. */
+void dev_overlay_begin(Rectangle view, float cell_size);
+
+/* Queue the debug box of an entity drawn at `dest` (pixels); its colour and
+ * label follow `entity_type`. Boxes outside the view are skipped. */
+void dev_overlay_box(Rectangle dest, const char* entity_type);
+
+/* Draw and clear the queued boxes, flushing the open render queue first. */
+void dev_overlay_draw_boxes(void);
+
+/* Map border and cell lines over the view. */
+void dev_overlay_grid(int grid_w, int grid_h);
+
+/* Unload the grid shader. */
+void dev_overlay_release(void);
+
+#endif /* CYBERIA_DEV_OVERLAY_H */
@@ -1,26 +1,64 @@
 #include "dialogue_data.h"
-#include "hash_table.h"
+#include "config.h"
+#include "meta_cache.h"
 #include "network/engine_client.h"
+#include "serial.h"
 #include "util/log.h"
 #include <cJSON.h>
 #include <stdio.h>
-#include <stdlib.h>
 #include <string.h>
 #include <assert.h>
 
-static HashTable ht;
+static MetaCacheSlot   s_slots[DIALOGUE_DATA_CAP];
+static DialogueDataSet s_sets[DIALOGUE_DATA_CAP];
+static MetaCache       s_cache = {
+    .name        = "dialogue",
+    .slots       = s_slots,
+    .entries     = s_sets,
+    .stride      = sizeof(DialogueDataSet),
+    .capacity    = DIALOGUE_DATA_CAP,
+    .error_ttl   = DIALOGUE_DATA_ERROR_TTL,
+    .refresh_ttl = DIALOGUE_DATA_REFRESH_TTL,
+    .index       = { .records = s_slots, .stride = sizeof(MetaCacheSlot) },
+};
+
+/* Settle the pending set; a failed refresh keeps its lines and state. */
+static void fail_fetch(DialogueDataSet* d) {
+    bool refreshing = META_CACHE_READY == meta_cache_state(&s_cache, d->item_id);
+    meta_cache_settle(&s_cache, d->item_id, false);
+    if (!refreshing) d->state = DLG_DATA_ERROR;
+}
+
+static void parse_line(DialogueLine* line, const cJSON* item, int index) {
+    memset(line, 0, sizeof(DialogueLine));
+
+    const cJSON* speaker = cJSON_GetObjectItemCaseSensitive(item, "speaker");
+    if (cJSON_IsString(speaker) && speaker->valuestring)
+        strncpy(line->speaker, speaker->valuestring, DIALOGUE_MAX_SPEAKER - 1);
+
+    const cJSON* text = cJSON_GetObjectItemCaseSensitive(item, "text");
+    if (cJSON_IsString(text) && text->valuestring)
+        strncpy(line->text, text->valuestring, DIALOGUE_MAX_TEXT - 1);
+
+    const cJSON* mood = cJSON_GetObjectItemCaseSensitive(item, "mood");
+    if (cJSON_IsString(mood) && mood->valuestring)
+        strncpy(line->mood, mood->valuestring, sizeof(line->mood) - 1);
+
+    const cJSON* order = cJSON_GetObjectItemCaseSensitive(item, "order");
+    line->order = cJSON_IsNumber(order) ? order->valueint : index;
+}
 
 static void parse_response(DialogueDataSet* d, const unsigned char* data, int size) {
-    cJSON* root = cJSON_ParseWithLength((const char*)data, size);
+    cJSON* root = serial_json_parse((const char*)data, size);
     if (!root) {
-        d->state = DLG_DATA_ERROR;
+        fail_fetch(d);
         return;
     }
 
     cJSON* status = cJSON_GetObjectItemCaseSensitive(root, "status");
     if (!cJSON_IsString(status) || strcmp(status->valuestring, "success") != 0) {
-        d->state = DLG_DATA_ERROR;
-        cJSON_Delete(root);
+        fail_fetch(d);
+        serial_json_free(root);
         return;
     }
 
@@ -32,7 +70,8 @@ static void parse_response(DialogueDataSet* d, const unsigned char* data, int si
     if (!arr || !cJSON_IsArray(arr)) {
         d->state = DLG_DATA_EMPTY;
         d->line_count = 0;
-        cJSON_Delete(root);
+        meta_cache_settle(&s_cache, d->item_id, true);
+        serial_json_free(root);
         return;
     }
 
@@ -41,93 +80,139 @@ static void parse_response(DialogueDataSet* d, const unsigned char* data, int si
     cJSON_ArrayForEach(item, arr) {
         if (count >= DIALOGUE_MAX_LINES) break;
 
-        DialogueLine* line = &d->lines[count];
-        memset(line, 0, sizeof(DialogueLine));
-
-        cJSON* speaker = cJSON_GetObjectItemCaseSensitive(item, "speaker");
-        if (cJSON_IsString(speaker) && speaker->valuestring)
-            strncpy(line->speaker, speaker->valuestring, DIALOGUE_MAX_SPEAKER - 1);
-
-        cJSON* text = cJSON_GetObjectItemCaseSensitive(item, "text");
-        if (cJSON_IsString(text) && text->valuestring)
-            strncpy(line->text, text->valuestring, DIALOGUE_MAX_TEXT - 1);
-
-        cJSON* mood = cJSON_GetObjectItemCaseSensitive(item, "mood");
-        if (cJSON_IsString(mood) && mood->valuestring)
-            strncpy(line->mood, mood->valuestring, sizeof(line->mood) - 1);
-
-        cJSON* order = cJSON_GetObjectItemCaseSensitive(item, "order");
-        line->order = cJSON_IsNumber(order) ? order->valueint : count;
-
+        parse_line(&d->lines[count], item, count);
         count++;
     }
 
     d->line_count = count;
     d->state = (count > 0) ? DLG_DATA_READY : DLG_DATA_EMPTY;
+    meta_cache_settle(&s_cache, d->item_id, true);
 
-    cJSON_Delete(root);
+    serial_json_free(root);
     LOG_INFO("[DIALOGUE_DATA] Fetched %d lines for item '%s'", count, d->item_id);
 }
 
 static void on_dialogue_fetched(const FetchResponse* r) {
-    DialogueDataSet* d = hash_table_get(&ht, r->asset_id);
-    if (NULL == d) { free(r->data); return; }
+    DialogueDataSet* d = meta_cache_pending(&s_cache, r->asset_id);
+    if (NULL == d) { return; }
 
     if (!r->success) {
-        d->state = DLG_DATA_ERROR;
+        fail_fetch(d);
         LOG_ERROR("[DIALOGUE_DATA] Fetch error for '%s'", d->item_id);
-        free(r->data);
         return;
     }
 
     parse_response(d, (const unsigned char*)r->data, (int)r->size);
-    free(r->data);
+}
+
+/* Bulk envelope: `data` is one array holding the lines of every requested
+ * code, each line naming its `code`, sorted by order within a code. A code
+ * with no lines stays FETCHING until meta_cache times it out. */
+static void on_dialogue_bulk_fetched(const FetchResponse* r) {
+    if (!r->success) { return; }
+
+    cJSON* root = serial_json_parse((const char*)r->data, r->size);
+    const cJSON* arr = root ? cJSON_GetObjectItemCaseSensitive(root, "data") : NULL;
+    DialogueDataSet* touched[FETCH_BATCH_MAX_KEYS];
+    int touched_count = 0;
+    if (cJSON_IsArray(arr)) {
+        const cJSON* item = NULL;
+        cJSON_ArrayForEach(item, arr) {
+            const cJSON* code = cJSON_GetObjectItemCaseSensitive(item, "code");
+            if (!cJSON_IsString(code)) continue;
+            DialogueDataSet* d = meta_cache_pending(&s_cache, code->valuestring);
+            if (NULL == d) continue;
+
+            int t = 0;
+            while (t < touched_count && touched[t] != d) t++;
+            if (t == touched_count) {
+                if (FETCH_BATCH_MAX_KEYS == touched_count) continue;
+                touched[touched_count++] = d;
+                d->line_count = 0;
+            }
+            if (d->line_count >= DIALOGUE_MAX_LINES) continue;
+            parse_line(&d->lines[d->line_count], item, d->line_count);
+            d->line_count++;
+        }
+    }
+    serial_json_free(root);
+
+    for (int t = 0; t < touched_count; t++) {
+        DialogueDataSet* d = touched[t];
+        d->state = (d->line_count > 0) ? DLG_DATA_READY : DLG_DATA_EMPTY;
+        meta_cache_settle(&s_cache, d->item_id, true);
+    }
+}
+
+#define DIALOGUE_CODE_URL_FORMAT "/api/cyberia-dialogue/code/%s"
+
+static FetchBatch* s_prefetch_batch = NULL;
+
+/* Claim the set for `key`; false when no fetch is due (cached, in flight,
+ * or backing off). */
+static bool begin_fetch(const char* key) {
+    DialogueDataSet* d = meta_cache_begin_fetch(&s_cache, key);
+    if (NULL == d) return false;
+
+    if (META_CACHE_LOADING == meta_cache_state(&s_cache, key)) {
+        strncpy(d->item_id, key, sizeof(d->item_id) - 1);
+        d->state = DLG_DATA_FETCHING;
+    }
+    return true;
+}
+
+static void request(const char* key, const char* url) {
+    if (!begin_fetch(key)) return;
+    fetch_request_start(key, url, FETCH_CLASS_UI, on_dialogue_fetched);
+    LOG_INFO("[DIALOGUE_DATA] Fetch started for '%s'", key);
 }
 
 /* ── Public API ──────────────────────────────────────────────────────── */
 
-void dialogue_data_init(void) { hash_table_init(&ht, 128, free, "dialogue_data"); }
-void dialogue_data_cleanup(void) { hash_table_destroy(&ht); }
+void dialogue_data_init(void) { meta_cache_reset(&s_cache); }
+void dialogue_data_cleanup(void) { meta_cache_reset(&s_cache); }
 
 void dialogue_data_request(const char* item_id) {
     assert(item_id);
     assert(strlen(item_id) > 0);
-    if (hash_table_get(&ht, item_id)) return; /* already in cache or in-flight */
-
-    DialogueDataSet* d = calloc(1, sizeof(DialogueDataSet));
-
-    strncpy(d->item_id, item_id, sizeof(d->item_id) - 1);
-    d->state = DLG_DATA_FETCHING;
-
-    hash_table_put(&ht, item_id, d);
 
     char url[1024];
     snprintf(url, sizeof(url), "/api/cyberia-dialogue/code/default-%s", item_id);
-    fetch_request_start(item_id, url, on_dialogue_fetched);
-    LOG_INFO("[DIALOGUE_DATA] Fetch started for '%s'", item_id);
+    request(item_id, url);
 }
 
 void dialogue_data_request_code(const char* code) {
     assert(code);
     assert(strlen(code) > 0);
-    if (hash_table_get(&ht, code)) return; /* already in cache or in-flight */
-
-    DialogueDataSet* d = calloc(1, sizeof(DialogueDataSet));
-
-    strncpy(d->item_id, code, sizeof(d->item_id) - 1);
-    d->state = DLG_DATA_FETCHING;
-
-    hash_table_put(&ht, code, d);
 
     char url[1024];
-    snprintf(url, sizeof(url), "/api/cyberia-dialogue/code/%s", code);
-    fetch_request_start(code, url, on_dialogue_fetched);
-    LOG_INFO("[DIALOGUE_DATA] Fetch started for code '%s'", code);
+    snprintf(url, sizeof(url), DIALOGUE_CODE_URL_FORMAT, code);
+    request(code, url);
+}
+
+void dialogue_data_prefetch_code(const char* code) {
+    assert(code);
+    assert(strlen(code) > 0);
+    if (!begin_fetch(code)) return;
+
+    if (!s_prefetch_batch) {
+        s_prefetch_batch = fetch_batch_create(&(FetchBatchConfig){
+            .name        = "dialogue-bulk",
+            .bulk_url    = "/api/cyberia-dialogue/codes?codes=",
+            .single_url  = DIALOGUE_CODE_URL_FORMAT,
+            .max_keys    = META_PREFETCH_BATCH_MAX_KEYS,
+            .window_ms   = META_PREFETCH_BATCH_WINDOW_MS,
+            .fetch_class = FETCH_CLASS_PREFETCH,
+            .on_bulk     = on_dialogue_bulk_fetched,
+            .on_item     = on_dialogue_fetched,
+        });
+    }
+    fetch_batch_request(s_prefetch_batch, code, NULL);
 }
 
 const DialogueDataSet* dialogue_data_get(const char* item_id) {
     assert(item_id);
-    return hash_table_get(&ht, item_id);
+    return meta_cache_get(&s_cache, item_id);
 }
 
 bool dialogue_data_available(const char* item_id) {
@@ -135,3 +220,7 @@ bool dialogue_data_available(const char* item_id) {
     const DialogueDataSet* d = dialogue_data_get(item_id);
     return d && d->state == DLG_DATA_READY && d->line_count > 0;
 }
+
+unsigned dialogue_data_generation(void) {
+    return meta_cache_generation(&s_cache);
+}
@@ -6,6 +6,11 @@
  * engine_client fetch queue; completion arrives through a registered
  * callback (no per-frame poll required from the caller).
  *
+ * Sets live in a meta_cache of DIALOGUE_DATA_CAP entries: hashed lookup,
+ * least-recently-used eviction when full, failed fetches retried after
+ * DIALOGUE_DATA_ERROR_TTL and settled sets refreshed in the background after
+ * DIALOGUE_DATA_REFRESH_TTL (the old lines keep serving meanwhile).
+ *
  * API endpoint:
  *   GET /api/cyberia-dialogue/code/default-<itemId>
  *
@@ -26,6 +31,10 @@
 
 #include <stdbool.h>
 
+#define DIALOGUE_DATA_CAP         32
+#define DIALOGUE_DATA_ERROR_TTL   30.0   /* seconds */
+#define DIALOGUE_DATA_REFRESH_TTL 600.0  /* seconds */
+
 /* ── Fetch state ─────────────────────────────────────────────────────── */
 
 typedef enum {
@@ -54,8 +63,9 @@ void dialogue_data_cleanup(void);
 /**
  * @brief Request dialogue data for an item ID.
  *
- * If the data is already cached (any state), this is a no-op.
- * Otherwise kicks off an async HTTP fetch.
+ * A no-op while the data is cached or in flight. Otherwise — first request,
+ * an error past its retry TTL, or a set due for refresh — kicks off an async
+ * HTTP fetch.
  */
 void dialogue_data_request(const char* item_id);
 
@@ -67,10 +77,18 @@ void dialogue_data_request(const char* item_id);
  */
 void dialogue_data_request_code(const char* code);
 
+/**
+ * @brief dialogue_data_request_code() at FETCH_CLASS_PREFETCH, coalesced with
+ *        other prefetches into one GET /api/cyberia-dialogue/codes?codes=a,b,c
+ *        (per-code route on an engine without it).
+ */
+void dialogue_data_prefetch_code(const char* code);
+
 /**
  * @brief Look up cached dialogue data for an item ID.
  *
- * @return Pointer to cached data, or NULL if not yet requested.
+ * @return Pointer to cached data, or NULL if not yet requested (or evicted).
+ *         Valid at least until the next request for another ID.
  */
 const DialogueDataSet* dialogue_data_get(const char* item_id);
 
@@ -79,4 +97,10 @@ const DialogueDataSet* dialogue_data_get(const char* item_id);
  */
 bool dialogue_data_available(const char* item_id);
 
+/**
+ * @brief Bumped whenever a set is added, evicted or settles, so callers caching
+ *        dialogue_data_available() results know to re-check.
+ */
+unsigned dialogue_data_generation(void);
+
 #endif /* DIALOGUE_DATA_H */
@@ -1,8 +1,10 @@
 #include "camera.h"
 
+#include "client_context.h"
 #include "presentation_runtime.h"
 #include "viewport.h"
 #include "game_state.h"
+#include "world_target.h"
 #include "network/replication.h"
 #include "util/log.h"
 
@@ -32,6 +34,12 @@ static Camera2D g_camera = {
  * compound it across repeated camera initialization and resize calls. */
 static bool s_mobile_zoom_applied = false;
 
+/* Scripted focus (grid cells) that replaces the local player while set. */
+static struct {
+    bool    active;
+    Vector2 cells;
+} s_override;
+
 static void camera_sync_mobile_zoom(void) {
     bool mobile = viewport_is_mobile();
     if (mobile == s_mobile_zoom_applied) return;
@@ -76,11 +84,24 @@ void camera_zoom_by(float factor) {
     camera_set_zoom(g_camera.zoom * factor);
 }
 
+void camera_set_override(Vector2 cells) {
+    s_override.active = true;
+    s_override.cells  = cells;
+}
+
+void camera_clear_override(void) {
+    s_override.active = false;
+}
+
 void camera_on_tick(float frame_dt) {
     float cell = g_game_state.cell_size > 0.0f ? g_game_state.cell_size : 12.0f;
     Vector2 self = g_game_state.player.base.interp_pos;
     float dx = self.x + g_game_state.player.base.dims.x / 2.0f;
     float dy = self.y + g_game_state.player.base.dims.y / 2.0f;
+    if (s_override.active) {
+        dx = s_override.cells.x;
+        dy = s_override.cells.y;
+    }
     Vector2 desired = { dx * cell, dy * cell };
 
     float blend = 1.0f - expf(-CAMERA_FOLLOW_LAMBDA * frame_dt);
@@ -88,6 +109,15 @@ void camera_on_tick(float frame_dt) {
     g_camera.target.y += (desired.y - g_camera.target.y) * blend;
 }
 
+/* The view actually drawn: the integer-scaled world pass snaps the zoom. */
 Camera2D camera_get(void) {
-    return g_camera;
+    Camera2D cam = g_camera;
+    float cell = g_game_state.cell_size > 0.0f ? g_game_state.cell_size : 12.0f;
+    cam.zoom = world_target_snap_zoom(cam.zoom, cell);
+    return cam;
+}
+
+void camera_context_register(void) {
+    client_context_register(&g_camera,   sizeof(g_camera),   NULL);
+    client_context_register(&s_override, sizeof(s_override), NULL);
 }
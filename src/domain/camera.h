@@ -17,6 +17,13 @@ void     camera_set_zoom(float zoom);
 float    camera_zoom(void);
 void     camera_zoom_by(float factor);
 void     camera_on_tick(float frame_dt);
+/* Follow `cells` (grid units, view center) instead of the local player
+ * until camera_clear_override(); used by scripted bench paths. */
+void     camera_set_override(Vector2 cells);
+void     camera_clear_override(void);
 Camera2D camera_get(void);
 
+/* Each view has its own camera (client_context.h). */
+void     camera_context_register(void);
+
 #endif /* CYBERIA_DOMAIN_CAMERA_H */
@@ -0,0 +1,153 @@
+#include "equip_txn.h"
+
+#include "game_state.h"
+#include "network/game_client.h"
+#include "object_layer.h"
+#include "util/log.h"
+
+#include <assert.h>
+#include <raylib.h>
+#include <string.h>
+
+static_assert(2 + EQUIP_TXN_MAX * (1 + (MAX_ITEM_ID_LENGTH - 1) + 1) <= UPLINK_FRAME_MAX,
+              "a full UPLINK_ITEM_ACTIVATION_BATCH does not fit one uplink frame");
+
+typedef struct {
+    char   item_id[MAX_ITEM_ID_LENGTH];
+    bool   active;          /* wanted */
+    bool   server_active;   /* last reported by the server */
+    double sent_at;
+} EquipPair;
+
+static struct {
+    EquipPair staged[EQUIP_TXN_MAX];
+    int       staged_count;
+    EquipPair pending[EQUIP_TXN_MAX];
+    int       pending_count;
+} g_equip;
+
+static ObjectLayerState* inventory_slot(const char* item_id) {
+    for (int i = 0; i < g_game_state.full_inventory_count; i++) {
+        if (0 == strcmp(g_game_state.full_inventory[i].item_id, item_id)) {
+            return &g_game_state.full_inventory[i];
+        }
+    }
+    return NULL;
+}
+
+static EquipPair* find(EquipPair* pairs, int count, const char* item_id) {
+    for (int i = 0; i < count; i++) {
+        if (0 == strcmp(pairs[i].item_id, item_id)) return &pairs[i];
+    }
+    return NULL;
+}
+
+void equip_txn_begin(void) {
+    g_equip.staged_count = 0;
+}
+
+bool equip_txn_set(const char* item_id, bool active) {
+    if (!item_id || MAX_ITEM_ID_LENGTH <= strlen(item_id)) return false;
+    const ObjectLayerState* slot = inventory_slot(item_id);
+    if (!slot) return false;
+    EquipPair* p = find(g_equip.staged, g_equip.staged_count, item_id);
+    if (!p) {
+        if (EQUIP_TXN_MAX <= g_equip.staged_count) return false;
+        p = &g_equip.staged[g_equip.staged_count++];
+        memcpy(p->item_id, item_id, strlen(item_id) + 1);
+    }
+    p->active = active;
+    return true;
+}
+
+static void send_staged(void) {
+    if (0 != (g_game_state.wire_ack_caps_ext & WIRE_CAP_EXT_EQUIP_BATCH)) {
+        const char* ids[EQUIP_TXN_MAX];
+        bool        active[EQUIP_TXN_MAX];
+        for (int i = 0; i < g_equip.staged_count; i++) {
+            ids[i]    = g_equip.staged[i].item_id;
+            active[i] = g_equip.staged[i].active;
+        }
+        BinWriter w;
+        uplink_item_activation_batch(&w, ids, active, g_equip.staged_count);
+        network_send_binary(w.buf, w.pos);
+        return;
+    }
+    /* Queued together, so they leave in one UPLINK_BATCH where acked. */
+    for (int i = 0; i < g_equip.staged_count; i++) {
+        BinWriter w;
+        uplink_item_activation(&w, g_equip.staged[i].item_id, g_equip.staged[i].active);
+        network_send_binary(w.buf, w.pos);
+    }
+}
+
+bool equip_txn_commit(void) {
+    if (0 == g_equip.staged_count || !connection_is_open()) {
+        g_equip.staged_count = 0;
+        return false;
+    }
+    send_staged();
+
+    double now = GetTime();
+    bool changed = false;
+    for (int i = 0; i < g_equip.staged_count; i++) {
+        const EquipPair* s = &g_equip.staged[i];
+        ObjectLayerState* slot = inventory_slot(s->item_id);
+        EquipPair* p = find(g_equip.pending, g_equip.pending_count, s->item_id);
+        if (!p) {
+            if (EQUIP_TXN_MAX <= g_equip.pending_count) continue;   /* sent, not tracked */
+            p = &g_equip.pending[g_equip.pending_count++];
+            *p = (EquipPair){ .server_active = slot ? slot->active : s->active };
+            memcpy(p->item_id, s->item_id, sizeof(p->item_id));
+        }
+        p->active  = s->active;
+        p->sent_at = now;
+        if (slot && slot->active != s->active) {
+            slot->active = s->active;
+            changed = true;
+        }
+    }
+    if (changed) g_game_state.inventory_version++;
+    g_equip.staged_count = 0;
+    return true;
+}
+
+bool equip_txn_pending(void) {
+    return 0 < g_equip.pending_count;
+}
+
+bool equip_txn_overlay(const char* item_id, bool server_active) {
+    EquipPair* p = find(g_equip.pending, g_equip.pending_count, item_id);
+    if (!p) return server_active;
+    p->server_active = server_active;
+    return p->active;
+}
+
+void equip_txn_settle(double now) {
+    bool reverted = false;
+    for (int i = 0; i < g_equip.pending_count;) {
+        EquipPair* p = &g_equip.pending[i];
+        bool confirmed = p->server_active == p->active;
+        bool expired   = now - p->sent_at >= EQUIP_TXN_TIMEOUT_SECONDS;
+        if (!confirmed && !expired) {
+            i++;
+            continue;
+        }
+        if (!confirmed) {
+            ObjectLayerState* slot = inventory_slot(p->item_id);
+            if (slot && slot->active != p->server_active) {
+                slot->active = p->server_active;
+                reverted = true;
+            }
+            LOG_WARN("[equip_txn] %s %s not confirmed; reverted", p->item_id,
+                     p->active ? "activation" : "deactivation");
+        }
+        g_equip.pending[i] = g_equip.pending[--g_equip.pending_count];
+    }
+    if (reverted) g_game_state.inventory_version++;
+}
+
+void equip_txn_reset(void) {
+    g_equip.staged_count  = 0;
+    g_equip.pending_count = 0;
+}
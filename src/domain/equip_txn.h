@@ -0,0 +1,49 @@
+#ifndef CYBERIA_DOMAIN_EQUIP_TXN_H
+#define CYBERIA_DOMAIN_EQUIP_TXN_H
+
+#include <stdbool.h>
+
+#include "serial.h"
+
+/* Equip transactions: several item activations sent and shown as one.
+ *
+ * equip_txn_set() stages (item_id, active) pairs between equip_txn_begin()
+ * and equip_txn_commit(). The commit sends them as one
+ * UPLINK_ITEM_ACTIVATION_BATCH frame (one item_activation frame each,
+ * queued together, until the server acks WIRE_CAP_EXT_EQUIP_BATCH) and
+ * applies them to full_inventory at once, so the inventory UI updates a
+ * single time. While pairs are in flight the AOI decoder shows them over
+ * the server's inventory (equip_txn_overlay), so snapshots taken before
+ * the server applied them do not flip slots back and forth; each pair is
+ * settled when the server reports it. A pair still unconfirmed after
+ * EQUIP_TXN_TIMEOUT_SECONDS (the server refused it) reverts to what the
+ * server last reported, in one more inventory update. */
+
+#define EQUIP_TXN_MAX             UPLINK_ITEM_ACTIVATION_BATCH_MAX
+#define EQUIP_TXN_TIMEOUT_SECONDS 3.0
+
+void equip_txn_begin(void);
+
+/* Stage `item_id` → `active`; a repeat replaces the earlier value. False
+ * when the item is not in full_inventory or EQUIP_TXN_MAX are staged. */
+bool equip_txn_set(const char* item_id, bool active);
+
+/* Send and apply what is staged. False (nothing applied) when nothing was
+ * staged or the connection is down. */
+bool equip_txn_commit(void);
+
+/* True while a committed pair waits for the server. */
+bool equip_txn_pending(void);
+
+/* Decoder hook, per inventory slot: the active flag to show for `item_id`
+ * given the server's `server_active`. */
+bool equip_txn_overlay(const char* item_id, bool server_active);
+
+/* Decoder hook, once per self-player block: settle confirmed pairs and
+ * revert timed-out ones. */
+void equip_txn_settle(double now);
+
+/* Forget every staged and pending pair (disconnect). */
+void equip_txn_reset(void);
+
+#endif /* CYBERIA_DOMAIN_EQUIP_TXN_H */
@@ -19,12 +19,14 @@ static struct {
     float         portal_hold_progress;
     LocalFctEvent fct[LOCAL_FCT_PENDING_MAX];
     int           fct_count;
+    LocalDebugPath path;
 
     bool          freeze_pending;
     double        freeze_deadline;
     char          freeze_reason[LOCAL_FREEZE_REASON_MAX];
 } g_local = {
     .move_speed = LOCAL_PLAYER_DEFAULT_MOVE_SPEED,
+    .path       = { .target = { -1.0f, -1.0f } },
 };
 
 static void send_freeze_frame(bool start, const char* reason) {
@@ -43,6 +45,8 @@ void local_player_reset(void) {
     g_local.on_portal            = false;
     g_local.portal_hold_progress = 0.0f;
     g_local.fct_count            = 0;
+    g_local.path.count           = 0;
+    g_local.path.target          = (Vector2){ -1.0f, -1.0f };
     g_local.freeze_pending  = false;
     g_local.freeze_deadline = 0.0;
     g_local.freeze_reason[0] = '\0';
@@ -130,6 +134,15 @@ void local_player_set_portal_hold(bool on_portal, float progress) {
 bool  local_player_on_portal(void)             { return g_local.on_portal; }
 float local_player_portal_hold_progress(void)  { return g_local.portal_hold_progress; }
 
+void local_player_set_debug_path(const Vector2* points, int count, Vector2 target) {
+    if (count > MAX_PATH_POINTS) count = MAX_PATH_POINTS;
+    if (count < 0 || !points)    count = 0;
+    if (count > 0) memcpy(g_local.path.points, points, sizeof(Vector2) * (size_t)count);
+    g_local.path.count  = count;
+    g_local.path.target = target;
+}
+const LocalDebugPath* local_player_debug_path(void) { return &g_local.path; }
+
 bool local_player_fct_push(const LocalFctEvent* ev) {
     if (!ev || g_local.fct_count >= LOCAL_FCT_PENDING_MAX) return false;
     g_local.fct[g_local.fct_count++] = *ev;
@@ -1,10 +1,12 @@
 #ifndef CYBERIA_DOMAIN_LOCAL_PLAYER_H
 #define CYBERIA_DOMAIN_LOCAL_PLAYER_H
 
+#include <raylib.h>
 #include <stdbool.h>
 #include <stdint.h>
 
 #include "object_layer.h"
+#include "world_types.h"
 
 /* Local-player state.
  *
@@ -15,6 +17,7 @@
  *   - status icon ID (overhead UI hint)
  *   - authoritative move speed (cells/second) for the prediction integrator
  *   - per-frame FCT event queue drained by the floating combat text module
+ *   - server path and target cell, for the dev overlay only
  *
  * These are render-only flags / per-tick view models, not world state, so
  * they live outside the simulation-shaped GameState.
@@ -31,6 +34,15 @@ typedef struct {
     uint32_t item_qty;
 } LocalFctEvent;
 
+/* Server-planned path and target cell of the local player, in grid cells.
+ * Debug-overlay data: the decoders fill it only while dev_ui is enabled,
+ * so it may be stale after the overlay was off. */
+typedef struct {
+    Vector2 points[MAX_PATH_POINTS];
+    int     count;
+    Vector2 target;   /* (-1, -1) until the server reports one */
+} LocalDebugPath;
+
 /* Reset all local-player flags to their post-disconnect defaults. */
 void  local_player_reset(void);
 
@@ -82,6 +94,12 @@ void   local_player_set_portal_hold(bool on_portal, float progress);
 bool   local_player_on_portal(void);
 float  local_player_portal_hold_progress(void);
 
+/* Debug path — written by the AOI decoders, read by the dev overlay.
+ * set copies at most MAX_PATH_POINTS points. */
+void                   local_player_set_debug_path(const Vector2* points, int count,
+                                                   Vector2 target);
+const LocalDebugPath*  local_player_debug_path(void);
+
 /* FCT event queue — single-producer (binary_aoi_decoder) /
  * single-consumer (floating_combat_text). */
 bool                   local_player_fct_push(const LocalFctEvent* ev);
@@ -6,6 +6,7 @@
 
 #include "local_player.h"
 #include "object_layer.h"
+#include "util/fixed_step.h"
 
 /* ── Presentation tuning ─────────────────────────────────────────────────────
  * SPRING_OMEGA — stiffness (rad/s) of the critically damped spring. Settles a
@@ -27,7 +28,13 @@
  *                away exponentially with the bleed speed capped at this
  *                fraction of the move speed: bleeding a backward correction
  *                can slow the walk slightly but can never reverse it. Offsets
- *                beyond MAX_CELLS pass the excess straight to the spring. */
+ *                beyond MAX_CELLS pass the excess straight to the spring.
+ * STEP_HZ / MAX_STEPS — the state advances in fixed substeps at this rate
+ *                (util/fixed_step.h, the scheduler prediction_step runs on)
+ *                and the rendered position interpolates between the last
+ *                two, so the spring converges identically at 30 Hz and at
+ *                144 Hz. A frame longer than MAX_STEPS substeps drops the
+ *                rest; the snap distance covers anything that leaves behind. */
 #define LOCAL_PLAYER_VIEW_SPRING_OMEGA 18.0f
 #define LOCAL_PLAYER_VIEW_SNAP_CELLS 6.0f
 #define LOCAL_PLAYER_VIEW_WALK_START_FRACTION 0.25f
@@ -36,6 +43,10 @@
 #define LOCAL_PLAYER_VIEW_CORRECTION_BLEED_LAMBDA 8.0f
 #define LOCAL_PLAYER_VIEW_CORRECTION_MAX_BLEED_FRACTION 0.35f
 #define LOCAL_PLAYER_VIEW_CORRECTION_MAX_CELLS 1.0f
+#define LOCAL_PLAYER_VIEW_STEP_HZ 120
+#define LOCAL_PLAYER_VIEW_MAX_STEPS 16
+
+#define LOCAL_PLAYER_VIEW_STEP_S (1.0f / (float)LOCAL_PLAYER_VIEW_STEP_HZ)
 
 /* Local player's draw footprint bump, a clean +10% so the character stands
  * out without breaking the grid. */
@@ -50,6 +61,8 @@ static const Direction OCTANT_TO_DIRECTION[8] = {
 
 typedef struct {
     Vector2         pos;
+    Vector2         prev_pos;   /* pos one substep ago */
+    Vector2         render_pos; /* between prev_pos and pos by the clock's alpha */
     Vector2         vel;
     Vector2         correction; /* un-bled visual offset absorbing reconciliation */
     Direction       direction;
@@ -60,6 +73,23 @@ typedef struct {
 
 static LocalPlayerView s_view = { .direction = DIRECTION_DOWN, .mode = MODE_IDLE };
 
+static FixedStep s_clock = { .step       = 1.0 / (double)LOCAL_PLAYER_VIEW_STEP_HZ,
+                             .max_steps  = LOCAL_PLAYER_VIEW_MAX_STEPS };
+
+/* Per-substep decay factors; the step never changes, so neither do they. */
+static struct {
+    float spring;
+    float bleed;
+    bool  ready;
+} s_decay;
+
+static void decay_ensure(void) {
+    if (s_decay.ready) return;
+    s_decay.spring = expf(-LOCAL_PLAYER_VIEW_SPRING_OMEGA * LOCAL_PLAYER_VIEW_STEP_S);
+    s_decay.bleed  = 1.0f - expf(-LOCAL_PLAYER_VIEW_CORRECTION_BLEED_LAMBDA * LOCAL_PLAYER_VIEW_STEP_S);
+    s_decay.ready  = true;
+}
+
 /* Quantizes a motion vector to the nearest of the 8 compass directions. */
 static Direction quantize_direction(float dx, float dy) {
     float angle = atan2f(dy, dx);
@@ -70,6 +100,8 @@ static Direction quantize_direction(float dx, float dy) {
 
 static void snap_to(Vector2 sim_pos, Direction sim_direction) {
     s_view.pos = sim_pos;
+    s_view.prev_pos = sim_pos;
+    s_view.render_pos = sim_pos;
     s_view.vel = (Vector2){ 0.0f, 0.0f };
     s_view.correction = (Vector2){ 0.0f, 0.0f };
     s_view.mode = MODE_IDLE;
@@ -79,13 +111,13 @@ static void snap_to(Vector2 sim_pos, Direction sim_direction) {
     s_view.initialized = true;
 }
 
-/* Exact closed-form step of a critically damped spring toward `target`:
- * position AND velocity stay continuous for any dt, so behaviour is identical
- * at any frame rate, and a retarget (reconciliation correction) bends the
- * trajectory instead of restarting it. */
-static void spring_step(Vector2 target, float dt) {
+/* Exact closed-form substep of a critically damped spring toward `target`:
+ * position AND velocity stay continuous, and a retarget (reconciliation
+ * correction) bends the trajectory instead of restarting it. */
+static void spring_step(Vector2 target) {
     const float omega = LOCAL_PLAYER_VIEW_SPRING_OMEGA;
-    float decay = expf(-omega * dt);
+    const float dt    = LOCAL_PLAYER_VIEW_STEP_S;
+    const float decay = s_decay.spring;
     float ex = s_view.pos.x - target.x;
     float ey = s_view.pos.y - target.y;
     float bx = s_view.vel.x + omega * ex;
@@ -96,12 +128,11 @@ static void spring_step(Vector2 target, float dt) {
     s_view.vel.y = (s_view.vel.y - omega * by * dt) * decay;
 }
 
-/* Absorb this frame's reconciliation displacement and bleed the held offset.
- * Absorbing negates the displacement exactly, so the spring target does not
- * move when a correction lands; the offset then decays exponentially with its
- * speed capped below the walk speed, keeping the visible trajectory monotone.
- * Anything beyond the offset cap passes straight to the spring. */
-static void absorb_correction(Vector2 sim_correction, float dt) {
+/* Absorb this frame's reconciliation displacement. Absorbing negates the
+ * displacement exactly, so the spring target does not move when a correction
+ * lands — even on a frame that runs no substep. Anything beyond the offset
+ * cap passes straight to the spring. */
+static void absorb_correction(Vector2 sim_correction) {
     s_view.correction.x -= sim_correction.x;
     s_view.correction.y -= sim_correction.y;
 
@@ -111,14 +142,19 @@ static void absorb_correction(Vector2 sim_correction, float dt) {
         float k = LOCAL_PLAYER_VIEW_CORRECTION_MAX_CELLS / len;
         s_view.correction.x *= k;
         s_view.correction.y *= k;
-        len = LOCAL_PLAYER_VIEW_CORRECTION_MAX_CELLS;
     }
+}
+
+/* Bleed the held offset one substep: exponential decay with its speed capped
+ * below the walk speed, keeping the visible trajectory monotone. */
+static void bleed_correction(void) {
+    float len = sqrtf(s_view.correction.x * s_view.correction.x +
+                      s_view.correction.y * s_view.correction.y);
     if (0.0f == len) return;
 
-    float decay = 1.0f - expf(-LOCAL_PLAYER_VIEW_CORRECTION_BLEED_LAMBDA * dt);
-    float step_len = len * decay;
+    float step_len = len * s_decay.bleed;
     float max_step = local_player_move_speed() *
-                     LOCAL_PLAYER_VIEW_CORRECTION_MAX_BLEED_FRACTION * dt;
+                     LOCAL_PLAYER_VIEW_CORRECTION_MAX_BLEED_FRACTION * LOCAL_PLAYER_VIEW_STEP_S;
     if (max_step < step_len) step_len = max_step;
 
     float k = 1.0f - step_len / len;
@@ -138,7 +174,7 @@ static void update_mode(float speed) {
     }
 }
 
-static void update_direction(float dt) {
+static void update_direction(void) {
     if (MODE_WALKING != s_view.mode) {
         s_view.direction_hold_s = 0.0f;
         return;
@@ -148,7 +184,7 @@ static void update_direction(float dt) {
         s_view.direction_hold_s = 0.0f;
         return;
     }
-    s_view.direction_hold_s += dt;
+    s_view.direction_hold_s += LOCAL_PLAYER_VIEW_STEP_S;
     if (LOCAL_PLAYER_VIEW_DIRECTION_HOLD_S <= s_view.direction_hold_s) {
         s_view.direction = candidate;
         s_view.direction_hold_s = 0.0f;
@@ -164,21 +200,32 @@ void local_player_view_update(Vector2 sim_pos, Vector2 sim_correction,
                       MODE_TELEPORTING == sim_mode ||
                       (LOCAL_PLAYER_VIEW_SNAP_CELLS * LOCAL_PLAYER_VIEW_SNAP_CELLS) <
                           (ex * ex + ey * ey);
+    int steps = fixed_step_advance(&s_clock, (double)dt);
     if (teleported) {
         snap_to(sim_pos, sim_direction);
         return;
     }
 
-    absorb_correction(sim_correction, dt);
-    Vector2 target = { sim_pos.x + s_view.correction.x,
-                       sim_pos.y + s_view.correction.y };
-    spring_step(target, dt);
-    update_mode(sqrtf(s_view.vel.x * s_view.vel.x + s_view.vel.y * s_view.vel.y));
-    update_direction(dt);
+    decay_ensure();
+    absorb_correction(sim_correction);
+    for (; 0 < steps; steps--) {
+        bleed_correction();
+        Vector2 target = { sim_pos.x + s_view.correction.x,
+                           sim_pos.y + s_view.correction.y };
+        s_view.prev_pos = s_view.pos;
+        spring_step(target);
+        update_mode(sqrtf(s_view.vel.x * s_view.vel.x + s_view.vel.y * s_view.vel.y));
+        update_direction();
+    }
+    float alpha = fixed_step_alpha(&s_clock);
+    s_view.render_pos = (Vector2){
+        s_view.prev_pos.x + (s_view.pos.x - s_view.prev_pos.x) * alpha,
+        s_view.prev_pos.y + (s_view.pos.y - s_view.prev_pos.y) * alpha,
+    };
 }
 
 Vector2 local_player_view_position(void) {
-    return s_view.pos;
+    return s_view.render_pos;
 }
 
 Direction local_player_view_direction(void) {
@@ -10,8 +10,10 @@
  * or any gameplay/simulation code — only by the renderer/camera.
  *
  * It owns an independent presentation state (position, velocity, facing,
- * walk/idle mode) advanced each render frame toward the simulation's
- * predicted/reconciled position by a critically damped spring. Reconciliation
+ * walk/idle mode) advanced in fixed substeps, decoupled from the render rate,
+ * toward the simulation's predicted/reconciled position by a critically
+ * damped spring; the rendered position interpolates between the last two
+ * substeps. Reconciliation
  * displacements are absorbed into a correction offset the instant they land —
  * the spring target never jumps — and the offset bleeds away with its speed
  * capped below the walk speed, so a correction can slightly slow the walk but
@@ -26,8 +28,8 @@
  * rendered trajectory. `sim_direction` and `sim_mode` are the authoritative
  * snapshot values; they are consumed only on snaps (a teleport has no organic
  * motion vector to derive facing from) and to detect MODE_TELEPORTING. Call
- * once per render frame, then read the accessors below. Frame-rate
- * independent. */
+ * once per render frame, then read the accessors below. `dt` only feeds
+ * the substep clock, so results do not depend on the frame rate. */
 void local_player_view_update(Vector2 sim_pos, Vector2 sim_correction,
                               Direction sim_direction, ObjectLayerMode sim_mode,
                               float dt);
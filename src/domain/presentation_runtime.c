@@ -1,10 +1,11 @@
 #include "presentation_runtime.h"
 #include "network/engine_client.h"
 #include "game_state.h"
+#include "serial.h"
 #include "util/log.h"
+#include <assert.h>
 #include <cJSON.h>
 #include <stdio.h>
-#include <stdlib.h>
 #include <string.h>
 
 #define MAX_PALETTE_ENTRIES     64
@@ -13,6 +14,8 @@
 #define ENTITY_TYPE_MAX         32
 #define COLOR_KEY_MAX           32
 #define ICON_ID_MAX             64
+#define MAX_PALETTE_HANDLES     64
+#define HINTS_VERSION_MAX       64
 
 typedef struct {
     char  key[COLOR_KEY_MAX];
@@ -43,9 +46,39 @@ typedef struct {
  * response. */
 static const Color kBootstrapNeutral = { 100, 100, 100, 200 };
 
-static struct {
+/* Handles below PALETTE_SLOT_COUNT are the built-in slots. */
+static const char* const kPaletteSlotKeys[PALETTE_SLOT_COUNT] = {
+    [PALETTE_BACKGROUND]       = "BACKGROUND",
+    [PALETTE_FLOOR]            = "FLOOR",
+    [PALETTE_FLOOR_BACKGROUND] = "FLOOR_BACKGROUND",
+    [PALETTE_PORTAL]           = "PORTAL",
+    [PALETTE_FOREGROUND]       = "FOREGROUND",
+    [PALETTE_PLAYER]           = "PLAYER",
+    [PALETTE_OTHER_PLAYER]     = "OTHER_PLAYER",
+    [PALETTE_SELF_BORDER]      = "SELF_BORDER",
+};
+
+static const char* const kEntityColorTypes[ENTITY_COLOR_COUNT] = {
+    [ENTITY_COLOR_OBSTACLE] = "obstacle",
+    [ENTITY_COLOR_STATIC]   = "static",
+    [ENTITY_COLOR_SELF]     = "self",
+    [ENTITY_COLOR_OTHER]    = "other",
+    [ENTITY_COLOR_PLAYER]   = "player",
+    [ENTITY_COLOR_BOT]      = "bot",
+    [ENTITY_COLOR_SKILL]    = "skill",
+    [ENTITY_COLOR_COIN]     = "coin",
+    [ENTITY_COLOR_DROP]     = "drop",
+    [ENTITY_COLOR_RESOURCE] = "resource",
+};
+
+typedef struct {
     bool             started;
     bool             ready;
+    bool             refetching;   /* a poll or push refetch is in flight */
+    double           next_poll;    /* GetTime() of the next refetch */
+    char             version[HINTS_VERSION_MAX];   /* of the applied hints, "" if none */
+    char             url[512];
+    uint32_t         palette_revision;
 
     PaletteEntry     palette[MAX_PALETTE_ENTRIES];
     int              palette_count;
@@ -56,6 +89,13 @@ static struct {
     StatusIconEntry  status[MAX_STATUS_ENTRIES];
     int              status_count;
 
+    /* Resolved colours: handle keys → palette, entity kinds → palette. */
+    bool             colors_resolved;
+    char             handle_keys[MAX_PALETTE_HANDLES][COLOR_KEY_MAX];
+    Color            handle_colors[MAX_PALETTE_HANDLES];
+    int              handle_count;
+    Color            entity_colors[ENTITY_COLOR_COUNT];
+
     float            cell_size;
     float            camera_zoom;
     float            camera_smoothing;
@@ -64,8 +104,18 @@ static struct {
     float            default_obj_height;
     bool             dev_ui;
     char             font_family[128];
+    char             font_subset[128];
     float            font_factor_size;
-} g_rt = {
+    bool             font_sdf;
+    PresentationLodHints lod;
+    float            gpu_budget_mb;
+    float            gpu_downsample_idle_s;
+    float            world_texels_per_cell;
+    bool             dynamic_resolution;
+    bool             atlas_embedded_meta;
+} Runtime;
+
+static Runtime g_rt = {
     .cell_size          = 45.0f,
     .camera_zoom        = 1.0f,
     .camera_smoothing   = 0.1f,
@@ -75,6 +125,17 @@ static struct {
     .dev_ui             = false,
     .font_family        = "",
     .font_factor_size   = 1.0f,
+    .lod = {
+        .skin_zoom   = 0.5f,
+        .quad_zoom   = 0.25f,
+        .skin_actors = 150,
+        .quad_actors = 400,
+        .focus_cells  = 16.0f,
+        .detail_cells = 32.0f,
+    },
+    .gpu_budget_mb         = 256.0f,
+    .gpu_downsample_idle_s = 0.0f,
+    .dynamic_resolution    = true,
 };
 
 /* ── JSON parsing helpers ──────────────────────────────────────────── */
@@ -92,13 +153,36 @@ static bool parse_color_object(const cJSON* obj, Color* out) {
     return true;
 }
 
-static void parse_response(const char* body, int len) {
-    cJSON* root = cJSON_ParseWithLength(body, (size_t)len);
-    if (!root) return;
+/* "version" as text: a string as is, a number printed. "" when absent. */
+static void version_of(const cJSON* data, char* out, size_t cap) {
+    out[0] = '\0';
+    cJSON* v = cJSON_GetObjectItem(data, "version");
+    if (v && cJSON_IsString(v)) {
+        strncpy(out, v->valuestring, cap - 1);
+        out[cap - 1] = '\0';
+    } else if (v && cJSON_IsNumber(v)) {
+        snprintf(out, cap, "%.17g", v->valuedouble);
+    }
+}
+
+/* Apply the hints in `body` over the current values; a hint missing from
+ * the body keeps its value. False when the body does not parse or carries
+ * the version already applied. */
+static bool parse_response(const char* body, int len) {
+    cJSON* root = serial_json_parse(body, (size_t)len);
+    if (!root) return false;
 
     cJSON* data = cJSON_GetObjectItem(root, "data");
     if (!data || !cJSON_IsObject(data)) data = root;
 
+    char version[HINTS_VERSION_MAX];
+    version_of(data, version, sizeof(version));
+    if (g_rt.ready && '\0' != version[0] && 0 == strcmp(version, g_rt.version)) {
+        serial_json_free(root);
+        return false;
+    }
+    memcpy(g_rt.version, version, sizeof(g_rt.version));
+
     /* Palette */
     cJSON* palette = cJSON_GetObjectItem(data, "palette");
     if (palette && cJSON_IsArray(palette)) {
@@ -109,6 +193,7 @@ static void parse_response(const char* body, int len) {
             cJSON* k = cJSON_GetObjectItem(item, "key");
             if (!k || !cJSON_IsString(k)) continue;
             PaletteEntry* p = &g_rt.palette[g_rt.palette_count++];
+            *p = (PaletteEntry){ 0 };
             strncpy(p->key, k->valuestring, sizeof(p->key) - 1);
             p->key[sizeof(p->key) - 1] = '\0';
             parse_color_object(item, &p->color);
@@ -126,6 +211,7 @@ static void parse_response(const char* body, int len) {
             cJSON* c = cJSON_GetObjectItem(item, "colorKey");
             if (!t || !c || !cJSON_IsString(t) || !cJSON_IsString(c)) continue;
             EntityColorKey* e = &g_rt.entity_keys[g_rt.entity_key_count++];
+            *e = (EntityColorKey){ 0 };
             strncpy(e->entity_type, t->valuestring, sizeof(e->entity_type) - 1);
             e->entity_type[sizeof(e->entity_type) - 1] = '\0';
             strncpy(e->color_key, c->valuestring, sizeof(e->color_key) - 1);
@@ -143,7 +229,7 @@ static void parse_response(const char* body, int len) {
             cJSON* id = cJSON_GetObjectItem(item, "id");
             if (!id || !cJSON_IsNumber(id)) continue;
             StatusIconEntry* s = &g_rt.status[g_rt.status_count++];
-            s->id = (uint8_t)id->valueint;
+            *s = (StatusIconEntry){ .id = (uint8_t)id->valueint };
             cJSON* icon = cJSON_GetObjectItem(item, "iconId");
             if (icon && cJSON_IsString(icon) && icon->valuestring[0] != '\0') {
                 strncpy(s->icon_id, icon->valuestring, sizeof(s->icon_id) - 1);
@@ -165,18 +251,62 @@ static void parse_response(const char* body, int len) {
     if ((n = cJSON_GetObjectItem(data, "defaultObjHeight")) && cJSON_IsNumber(n))   g_rt.default_obj_height = (float)n->valuedouble;
     if ((n = cJSON_GetObjectItem(data, "devUi")) && cJSON_IsBool(n))                g_rt.dev_ui = cJSON_IsTrue(n);
 
+    /* Level-of-detail thresholds */
+    if ((n = cJSON_GetObjectItem(data, "lodSkinZoom")) && cJSON_IsNumber(n))        g_rt.lod.skin_zoom = (float)n->valuedouble;
+    if ((n = cJSON_GetObjectItem(data, "lodQuadZoom")) && cJSON_IsNumber(n))        g_rt.lod.quad_zoom = (float)n->valuedouble;
+    if ((n = cJSON_GetObjectItem(data, "lodSkinActors")) && cJSON_IsNumber(n))      g_rt.lod.skin_actors = n->valueint;
+    if ((n = cJSON_GetObjectItem(data, "lodQuadActors")) && cJSON_IsNumber(n))      g_rt.lod.quad_actors = n->valueint;
+    if ((n = cJSON_GetObjectItem(data, "lodFocusCells")) && cJSON_IsNumber(n))      g_rt.lod.focus_cells = (float)n->valuedouble;
+    if ((n = cJSON_GetObjectItem(data, "lodDetailCells")) && cJSON_IsNumber(n))     g_rt.lod.detail_cells = (float)n->valuedouble;
+
+    /* Texture memory (gpu_memory.h) */
+    if ((n = cJSON_GetObjectItem(data, "gpuBudgetMb")) && cJSON_IsNumber(n))        g_rt.gpu_budget_mb = (float)n->valuedouble;
+    if ((n = cJSON_GetObjectItem(data, "gpuDownsampleIdle")) && cJSON_IsNumber(n))  g_rt.gpu_downsample_idle_s = (float)n->valuedouble;
+
+    /* Integer-scaled world pass (world_target.h) */
+    if ((n = cJSON_GetObjectItem(data, "worldTexelsPerCell")) && cJSON_IsNumber(n)) g_rt.world_texels_per_cell = (float)n->valuedouble;
+    if ((n = cJSON_GetObjectItem(data, "dynamicResolution")) && cJSON_IsBool(n))    g_rt.dynamic_resolution = cJSON_IsTrue(n);
+
+    /* Atlas PNGs carrying their own descriptor (atlas_meta_bin.h) */
+    if ((n = cJSON_GetObjectItem(data, "atlasEmbeddedMeta")) && cJSON_IsBool(n))    g_rt.atlas_embedded_meta = cJSON_IsTrue(n);
+
     /* Main UI font (text.c fetches assets/fonts/<fontFamily> and applies the factor). */
     cJSON* ff = cJSON_GetObjectItem(data, "fontFamily");
     if (ff && cJSON_IsString(ff) && ff->valuestring[0] != '\0') {
         strncpy(g_rt.font_family, ff->valuestring, sizeof(g_rt.font_family) - 1);
         g_rt.font_family[sizeof(g_rt.font_family) - 1] = '\0';
     }
+    cJSON* fs = cJSON_GetObjectItem(data, "fontSubset");
+    if (fs && cJSON_IsString(fs)) {
+        strncpy(g_rt.font_subset, fs->valuestring, sizeof(g_rt.font_subset) - 1);
+        g_rt.font_subset[sizeof(g_rt.font_subset) - 1] = '\0';
+    }
     if ((n = cJSON_GetObjectItem(data, "fontFactorSize")) && cJSON_IsNumber(n))     g_rt.font_factor_size = (float)n->valuedouble;
+    if ((n = cJSON_GetObjectItem(data, "fontSdf")) && cJSON_IsBool(n))              g_rt.font_sdf = cJSON_IsTrue(n);
 
-    cJSON_Delete(root);
-    LOG_INFO("[presentation_runtime] hydrated %d palette / %d entity-keys / %d status-icons; cellSize=%.1f interp=%dms",
+    serial_json_free(root);
+    LOG_INFO("[presentation_runtime] hydrated %d palette / %d entity-keys / %d status-icons; cellSize=%.1f interp=%dms version='%s'",
            g_rt.palette_count, g_rt.entity_key_count, g_rt.status_count,
-           g_rt.cell_size, g_rt.interpolation_ms);
+           g_rt.cell_size, g_rt.interpolation_ms, g_rt.version);
+    return true;
+}
+
+/* Palette handles and entity kinds → colours. Runs on first use (the
+ * bootstrap colours) and again once the hints land. */
+static void resolve_colors(void) {
+    if (0 == g_rt.handle_count) {
+        for (int i = 0; i < PALETTE_SLOT_COUNT; i++) {
+            strncpy(g_rt.handle_keys[i], kPaletteSlotKeys[i], COLOR_KEY_MAX - 1);
+        }
+        g_rt.handle_count = PALETTE_SLOT_COUNT;
+    }
+    for (int i = 0; i < g_rt.handle_count; i++) {
+        g_rt.handle_colors[i] = presentation_runtime_palette(g_rt.handle_keys[i]);
+    }
+    for (int i = 0; i < ENTITY_COLOR_COUNT; i++) {
+        g_rt.entity_colors[i] = presentation_runtime_entity_fallback_color(kEntityColorTypes[i]);
+    }
+    g_rt.colors_resolved = true;
 }
 
 /* One-shot hydration of GameState with the simulation-relevant subset
@@ -187,15 +317,56 @@ static void hydrate_game_state(void) {
     g_game_state.interpolation_ms = g_rt.interpolation_ms;
 }
 
+static bool colors_differ(const Runtime* a, const Runtime* b) {
+    return a->palette_count != b->palette_count ||
+           a->entity_key_count != b->entity_key_count ||
+           a->status_count != b->status_count ||
+           0 != memcmp(a->palette, b->palette, sizeof(PaletteEntry) * (size_t)a->palette_count) ||
+           0 != memcmp(a->entity_keys, b->entity_keys, sizeof(EntityColorKey) * (size_t)a->entity_key_count) ||
+           0 != memcmp(a->status, b->status, sizeof(StatusIconEntry) * (size_t)a->status_count);
+}
+
 static void on_hints_fetched(const FetchResponse* r) {
-    if (r->success && r->data && r->size > 0) {
-        parse_response((const char*)r->data, (int)r->size);
-    } else {
-        LOG_ERROR("[presentation_runtime] fetch unavailable — using bootstrap fallback");
+    bool first = !g_rt.ready;
+    g_rt.refetching = false;
+    g_rt.next_poll  = GetTime() + PRESENTATION_HINTS_POLL_SECONDS;
+    if (!r->success || !r->data || 0 == r->size) {
+        if (first) LOG_ERROR("[presentation_runtime] fetch unavailable — using bootstrap fallback");
+        else       LOG_WARN("[presentation_runtime] hints refetch failed; keeping version '%s'", g_rt.version);
+    }
+    if (first) {
+        if (r->success && r->data && r->size > 0) parse_response((const char*)r->data, (int)r->size);
+        g_rt.ready = true;
+        resolve_colors();
+        hydrate_game_state();
+        return;
+    }
+    if (!r->success || !r->data || 0 == r->size) return;
+
+    /* Hot reload: apply only what moved. Cell size and interpolation reach
+     * GameState, where the renderers and floor_cache pick the change up next
+     * frame; colours re-resolve and bump the palette revision. */
+    static Runtime before;
+    before = g_rt;
+    if (!parse_response((const char*)r->data, (int)r->size)) return;
+    bool colors = colors_differ(&before, &g_rt);
+    if (colors) {
+        resolve_colors();
+        g_rt.palette_revision++;
     }
-    free(r->data);
-    g_rt.ready = true;
-    hydrate_game_state();
+    if (before.cell_size != g_rt.cell_size || before.interpolation_ms != g_rt.interpolation_ms) {
+        hydrate_game_state();
+    }
+    LOG_INFO("[presentation_runtime] hints '%s' applied:%s%s%s%s",
+             g_rt.version, colors ? " colours" : "",
+             before.cell_size != g_rt.cell_size ? " cellSize" : "",
+             before.interpolation_ms != g_rt.interpolation_ms ? " interpolation" : "",
+             0 != strcmp(before.font_family, g_rt.font_family) ? " font" : "");
+}
+
+static void refetch(void) {
+    g_rt.refetching = true;
+    fetch_request_start("cyberia-client-hints", g_rt.url, FETCH_CLASS_PREFETCH, on_hints_fetched);
 }
 
 /* ── Public lifecycle ──────────────────────────────────────────────── */
@@ -203,12 +374,27 @@ static void on_hints_fetched(const FetchResponse* r) {
 void presentation_runtime_start_fetch(const char* client_hints_code) {
     if (g_rt.started) return;
     if (!client_hints_code) return;
-    char url[512];
-    int n = snprintf(url, sizeof(url), "/api/cyberia-client-hints/%s", client_hints_code);
-    if (n <= 0 || n >= (int)sizeof(url)) return;
+    int n = snprintf(g_rt.url, sizeof(g_rt.url), "/api/cyberia-client-hints/%s", client_hints_code);
+    if (n <= 0 || n >= (int)sizeof(g_rt.url)) return;
     g_rt.started = true;
-    fetch_request_start("cyberia-client-hints", url, on_hints_fetched);
-    LOG_INFO("[presentation_runtime] fetching %s", url);
+    fetch_request_start("cyberia-client-hints", g_rt.url, FETCH_CLASS_VISIBLE, on_hints_fetched);
+    LOG_INFO("[presentation_runtime] fetching %s", g_rt.url);
+}
+
+void presentation_runtime_poll(double now) {
+    if (!g_rt.ready || g_rt.refetching || '\0' == g_rt.url[0]) return;
+    if (now < g_rt.next_poll) return;
+    refetch();
+}
+
+void presentation_runtime_notify_version(const char* version) {
+    if (!version || '\0' == version[0] || 0 == strcmp(version, g_rt.version)) return;
+    LOG_INFO("[presentation_runtime] hints version '%s' announced (have '%s')", version, g_rt.version);
+    g_rt.next_poll = 0.0;
+}
+
+uint32_t presentation_runtime_palette_revision(void) {
+    return g_rt.palette_revision;
 }
 
 bool presentation_runtime_is_ready(void) {
@@ -237,6 +423,42 @@ Color presentation_runtime_entity_fallback_color(const char* entity_type) {
     return kBootstrapNeutral;
 }
 
+Color presentation_runtime_palette_slot(PaletteSlot slot) {
+    assert(0 <= slot && PALETTE_SLOT_COUNT > slot);
+    if (!g_rt.colors_resolved) resolve_colors();
+    return g_rt.handle_colors[slot];
+}
+
+PaletteHandle presentation_runtime_palette_handle(const char* key) {
+    if (!key || '\0' == key[0]) return PALETTE_HANDLE_NONE;
+    if (!g_rt.colors_resolved) resolve_colors();
+    for (int i = 0; i < g_rt.handle_count; i++) {
+        if (0 == strcmp(g_rt.handle_keys[i], key)) return i;
+    }
+    if (MAX_PALETTE_HANDLES <= g_rt.handle_count) return PALETTE_HANDLE_NONE;
+    int h = g_rt.handle_count++;
+    strncpy(g_rt.handle_keys[h], key, COLOR_KEY_MAX - 1);
+    g_rt.handle_keys[h][COLOR_KEY_MAX - 1] = '\0';
+    g_rt.handle_colors[h] = presentation_runtime_palette(g_rt.handle_keys[h]);
+    return h;
+}
+
+Color presentation_runtime_palette_color(PaletteHandle handle) {
+    if (0 > handle || g_rt.handle_count <= handle) return kBootstrapNeutral;
+    return g_rt.handle_colors[handle];
+}
+
+Color presentation_runtime_entity_color(EntityColorKind kind) {
+    assert(0 <= kind && ENTITY_COLOR_COUNT > kind);
+    if (!g_rt.colors_resolved) resolve_colors();
+    return g_rt.entity_colors[kind];
+}
+
+const char* presentation_runtime_entity_type_name(EntityColorKind kind) {
+    assert(0 <= kind && ENTITY_COLOR_COUNT > kind);
+    return kEntityColorTypes[kind];
+}
+
 const char* presentation_runtime_status_icon(uint8_t status_id) {
     for (int i = 0; i < g_rt.status_count; i++) {
         if (g_rt.status[i].id == status_id && g_rt.status[i].icon_id_set) {
@@ -263,7 +485,15 @@ float presentation_runtime_default_obj_width(void) { return g_rt.default_obj_wid
 float presentation_runtime_default_obj_height(void){ return g_rt.default_obj_height; }
 bool  presentation_runtime_dev_ui(void)            { return g_rt.dev_ui; }
 const char* presentation_runtime_font_family(void) { return g_rt.font_family; }
+const char* presentation_runtime_font_subset(void) { return g_rt.font_subset; }
 float presentation_runtime_font_factor_size(void)  { return g_rt.font_factor_size; }
+bool presentation_runtime_font_sdf(void)           { return g_rt.font_sdf; }
+PresentationLodHints presentation_runtime_lod(void) { return g_rt.lod; }
+float presentation_runtime_gpu_budget_mb(void) { return g_rt.gpu_budget_mb; }
+float presentation_runtime_gpu_downsample_idle(void) { return g_rt.gpu_downsample_idle_s; }
+float presentation_runtime_world_texels_per_cell(void) { return g_rt.world_texels_per_cell; }
+bool  presentation_runtime_dynamic_resolution(void) { return g_rt.dynamic_resolution; }
+bool  presentation_runtime_atlas_embedded_meta(void) { return g_rt.atlas_embedded_meta; }
 
 void  presentation_runtime_set_dev_ui(bool enabled) { g_rt.dev_ui = enabled; }
 void  presentation_runtime_toggle_dev_ui(void)     { g_rt.dev_ui = !g_rt.dev_ui; }
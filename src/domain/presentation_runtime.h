@@ -20,6 +20,13 @@
  *      hydrated into GameState; camera zoom is read on demand by
  *      domain/camera.c from the same runtime.
  *   3. Renderers / UI code consult the runtime accessors below.
+ *   4. Every PRESENTATION_HINTS_POLL_SECONDS (or at once, when the server
+ *      announces a new version with a client_hints message) the hints are
+ *      re-fetched. A response carrying the applied "version" is dropped;
+ *      otherwise only what moved is applied: colours re-resolve (and
+ *      presentation_runtime_palette_revision() moves), a new cell size or
+ *      interpolation window goes to GameState, the rest is read live.
+ *      Hints missing from a response keep their value.
  *
  * Bootstrap fallback
  * ------------------
@@ -45,6 +52,8 @@
 extern "C" {
 #endif
 
+#define PRESENTATION_HINTS_POLL_SECONDS 60.0
+
 /** Kick off the asynchronous fetch. Safe to call exactly once at startup
  *  after js_init_engine_api has run. Subsequent calls are no-ops. */
 void presentation_runtime_start_fetch(const char* client_hints_code);
@@ -54,6 +63,18 @@ void presentation_runtime_start_fetch(const char* client_hints_code);
  *  return the inline bootstrap values. */
 bool presentation_runtime_is_ready(void);
 
+/** Per frame, with GetTime(): re-fetch the hints once the poll interval
+ *  is up (see Lifecycle 4). */
+void presentation_runtime_poll(double now);
+
+/** The server announced hints `version`: re-fetch on the next poll unless
+ *  it is the one applied. */
+void presentation_runtime_notify_version(const char* version);
+
+/** Moves whenever a hot reload changes any resolved colour, so caches that
+ *  baked palette colours (floor_cache) know to re-bake. */
+uint32_t presentation_runtime_palette_revision(void);
+
 /* ── Presentation accessors ────────────────────────────────────────── */
 
 /** Palette colour for `key`, or a neutral grey when unknown. */
@@ -63,6 +84,53 @@ Color presentation_runtime_palette(const char* key);
  *  palette. Falls back to neutral grey when nothing matches. */
 Color presentation_runtime_entity_fallback_color(const char* entity_type);
 
+/** Built-in palette keys, resolved to colours once when hints hydrate so
+ *  per-object draw loops never compare strings. */
+typedef enum {
+    PALETTE_BACKGROUND = 0,     /* "BACKGROUND" */
+    PALETTE_FLOOR,              /* "FLOOR" */
+    PALETTE_FLOOR_BACKGROUND,   /* "FLOOR_BACKGROUND" */
+    PALETTE_PORTAL,             /* "PORTAL" */
+    PALETTE_FOREGROUND,         /* "FOREGROUND" */
+    PALETTE_PLAYER,             /* "PLAYER" */
+    PALETTE_OTHER_PLAYER,       /* "OTHER_PLAYER" */
+    PALETTE_SELF_BORDER,        /* "SELF_BORDER" */
+    PALETTE_SLOT_COUNT
+} PaletteSlot;
+
+Color presentation_runtime_palette_slot(PaletteSlot slot);
+
+/** Handle for any other palette key: look it up once (a linear scan),
+ *  then read its colour in O(1). Stays valid across hydration — the colour
+ *  follows the hints once they land. PALETTE_HANDLE_NONE (empty key or
+ *  handle table full) reads as neutral grey. Built-in slots are handles. */
+typedef int PaletteHandle;
+#define PALETTE_HANDLE_NONE (-1)
+
+PaletteHandle presentation_runtime_palette_handle(const char* key);
+Color         presentation_runtime_palette_color(PaletteHandle handle);
+
+/** Entity types the renderer asks fallback colours for, resolved through
+ *  entity_type → color_key → palette once when hints hydrate. */
+typedef enum {
+    ENTITY_COLOR_OBSTACLE = 0,  /* "obstacle" */
+    ENTITY_COLOR_STATIC,        /* "static" */
+    ENTITY_COLOR_SELF,          /* "self" */
+    ENTITY_COLOR_OTHER,         /* "other" */
+    ENTITY_COLOR_PLAYER,        /* "player" */
+    ENTITY_COLOR_BOT,           /* "bot" */
+    ENTITY_COLOR_SKILL,         /* "skill" */
+    ENTITY_COLOR_COIN,          /* "coin" */
+    ENTITY_COLOR_DROP,          /* "drop" */
+    ENTITY_COLOR_RESOURCE,      /* "resource" */
+    ENTITY_COLOR_COUNT
+} EntityColorKind;
+
+Color       presentation_runtime_entity_color(EntityColorKind kind);
+
+/** Entity-type string of `kind` ("obstacle", "self", ...). */
+const char* presentation_runtime_entity_type_name(EntityColorKind kind);
+
 /** Icon stem (e.g. "skull") for a u8 status ID, or NULL when no icon. */
 const char* presentation_runtime_status_icon(uint8_t status_id);
 
@@ -81,10 +149,53 @@ bool     presentation_runtime_dev_ui(void);
 void     presentation_runtime_set_dev_ui(bool enabled);
 void     presentation_runtime_toggle_dev_ui(void);
 
-/** Main UI font: TTF file name under engine assets/fonts/ ("" = built-in font)
- *  and a uniform multiplier applied to every text size. */
+/** Level-of-detail thresholds for actors (players, bots, resources).
+ *  Below `skin_zoom` camera zoom, or with more than `skin_actors` actors in
+ *  the AOI, actors draw only their skin layer and lose their shadow and
+ *  overhead UI; below `quad_zoom` / above `quad_actors` they draw as one
+ *  coloured quad. Actors farther than `focus_cells` from the local player
+ *  advance their animation at a throttled rate; beyond `detail_cells` they
+ *  also drop their overhead UI and interpolate on alternate frames. Both
+ *  radii shrink under frame-time pressure (fidelity.h). The local player
+ *  always draws in full. */
+typedef struct {
+    float skin_zoom;
+    float quad_zoom;
+    int   skin_actors;
+    int   quad_actors;
+    float focus_cells;
+    float detail_cells;
+} PresentationLodHints;
+
+PresentationLodHints presentation_runtime_lod(void);
+
+/** Texture memory budget in MB (0: unlimited) and the idle seconds after
+ *  which textures drop to half resolution (0: never). See gpu_memory.h. */
+float    presentation_runtime_gpu_budget_mb(void);
+float    presentation_runtime_gpu_downsample_idle(void);
+
+/** Target texels per world cell for the integer-scaled world pass
+ *  (worldTexelsPerCell, see world_target.h); 0 draws the world directly. */
+float    presentation_runtime_world_texels_per_cell(void);
+
+/** Frame-time driven world resolution (dynamicResolution, default on; see
+ *  dynamic_resolution.h). */
+bool     presentation_runtime_dynamic_resolution(void);
+
+/** Atlas blobs embed their descriptor as a PNG chunk (atlasEmbeddedMeta,
+ *  default off; see atlas_meta_bin.h): an atlas is fetched as the blob
+ *  alone, the metadata route only when the chunk is missing. */
+bool     presentation_runtime_atlas_embedded_meta(void);
+
+/** Main UI font: TTF file name under engine assets/fonts/ ("" = built-in font),
+ *  a uniform multiplier applied to every text size, and whether the font loads
+ *  as signed distance fields (fontSdf, see ui/text.c). fontSubset names a
+ *  small subset of the same face (e.g. Latin only) under assets/fonts/ that
+ *  is drawn until the full file arrives ("" = none). */
 const char* presentation_runtime_font_family(void);
+const char* presentation_runtime_font_subset(void);
 float       presentation_runtime_font_factor_size(void);
+bool        presentation_runtime_font_sdf(void);
 
 #ifdef __cplusplus
 }
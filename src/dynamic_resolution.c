@@ -0,0 +1,52 @@
+#include "dynamic_resolution.h"
+
+#include "domain/presentation_runtime.h"
+#include "util/log.h"
+#include "world_target.h"
+
+#include <raylib.h>
+
+static const float STEPS[] = DYNRES_STEPS;
+#define STEP_COUNT ((int)(sizeof(STEPS) / sizeof(STEPS[0])))
+
+static struct {
+    int    step;
+    float  frame_ms;       /* smoothed interval, 1/16 per frame */
+    double lower_at;       /* earliest GetTime() of the next step down */
+    double raise_at;       /* ... and up; both restart on any change */
+} g_dynres;
+
+static void set_step(int step, double now) {
+    world_target_set_resolution(STEPS[step]);
+    LOG_INFO("[dynres] step %d -> %d (%.2fx, %.1f ms)", g_dynres.step, step, (double)STEPS[step],
+             (double)g_dynres.frame_ms);
+    g_dynres.step     = step;
+    g_dynres.lower_at = now + DYNRES_LOWER_HOLD_SECONDS;
+    g_dynres.raise_at = now + DYNRES_RAISE_HOLD_SECONDS;
+}
+
+void dynamic_resolution_on_frame(float frame_ms) {
+    double now = GetTime();
+    if (!presentation_runtime_dynamic_resolution()) {
+        if (0 != g_dynres.step) set_step(0, now);
+        return;
+    }
+    if (0.0f >= frame_ms || DYNRES_SPIKE_MS < frame_ms) return;
+
+    if (0.0f == g_dynres.frame_ms) g_dynres.frame_ms = frame_ms;
+    g_dynres.frame_ms += (frame_ms - g_dynres.frame_ms) / 16.0f;
+
+    if (DYNRES_LOWER_MS < g_dynres.frame_ms && STEP_COUNT - 1 > g_dynres.step) {
+        if (now >= g_dynres.lower_at) set_step(g_dynres.step + 1, now);
+    } else if (DYNRES_RAISE_MS > g_dynres.frame_ms && 0 < g_dynres.step) {
+        if (now >= g_dynres.raise_at) set_step(g_dynres.step - 1, now);
+    }
+}
+
+int dynamic_resolution_step(void) {
+    return g_dynres.step;
+}
+
+float dynamic_resolution_factor(void) {
+    return STEPS[g_dynres.step];
+}
@@ -0,0 +1,31 @@
+#ifndef CYBERIA_DYNAMIC_RESOLUTION_H
+#define CYBERIA_DYNAMIC_RESOLUTION_H
+
+/* Frame-time feedback on the world pass resolution (world_target.h).
+ *
+ * The loop feeds every frame interval in, divided by the animation frames
+ * it was paced to (frame_pacing.h), so a loop keeping up reads one display
+ * refresh whatever its rate and a slow one reads more. The smoothed value
+ * steps the world target down one entry of DYNRES_STEPS while it stays
+ * above DYNRES_LOWER_MS and back up while under DYNRES_RAISE_MS. The gap
+ * between the two, and the hold after each step (short going down, long
+ * going up), keep it from oscillating on a scene at the edge. Intervals over
+ * DYNRES_SPIKE_MS (tab switches, loading hitches) are ignored. UI stays at
+ * native resolution throughout. The dynamicResolution presentation hint
+ * turns it off. */
+
+#define DYNRES_STEPS              { 1.0f, 0.85f, 0.72f, 0.6f, 0.5f }
+#define DYNRES_LOWER_MS           20.0f   /* per refresh: a 60 Hz loop missing its slot often */
+#define DYNRES_RAISE_MS           17.5f
+#define DYNRES_LOWER_HOLD_SECONDS 1.0
+#define DYNRES_RAISE_HOLD_SECONDS 4.0
+#define DYNRES_SPIKE_MS           250.0f
+
+/* Once per frame, with the last frame interval per animation frame. */
+void  dynamic_resolution_on_frame(float frame_ms);
+
+/* Current step, 0 at full resolution, and its factor. */
+int   dynamic_resolution_step(void);
+float dynamic_resolution_factor(void);
+
+#endif /* CYBERIA_DYNAMIC_RESOLUTION_H */
@@ -0,0 +1,64 @@
+#include "entity_depth.h"
+
+#include "frame_arena.h"
+
+#include <string.h>
+
+int entity_depth_compare(const void* a, const void* b) {
+    const EntitySortEntry* ea = (const EntitySortEntry*)a;
+    const EntitySortEntry* eb = (const EntitySortEntry*)b;
+    if (ea->key != eb->key) return (ea->key < eb->key) ? -1 : 1;
+
+    if (ea->type != eb->type) {
+        return (int)ea->type - (int)eb->type;
+    }
+
+    return ea->slot - eb->slot;
+}
+
+typedef struct {
+    uint64_t key;
+    int      index;
+} DepthSortItem;
+
+void entity_depth_radix_sort(EntitySortEntry* a, int n) {
+    if (2 > n) return;
+    DepthSortItem* src = frame_alloc(sizeof(DepthSortItem) * (size_t)n);
+    DepthSortItem* dst = frame_alloc(sizeof(DepthSortItem) * (size_t)n);
+    for (int i = 0; i < n; i++) src[i] = (DepthSortItem){ .key = a[i].key, .index = i };
+
+    /* A byte per pass; a pass where every key shares the byte is skipped,
+     * which takes out the handle's high bytes and most of the depth. */
+    for (int shift = 0; shift < 64; shift += 8) {
+        int count[256] = { 0 };
+        for (int i = 0; i < n; i++) count[(src[i].key >> shift) & 0xff]++;
+        if (n == count[(src[0].key >> shift) & 0xff]) continue;
+        int offset = 0;
+        for (int b = 0; b < 256; b++) {
+            int c    = count[b];
+            count[b] = offset;
+            offset  += c;
+        }
+        for (int i = 0; i < n; i++) dst[count[(src[i].key >> shift) & 0xff]++] = src[i];
+        DepthSortItem* t = src;
+        src = dst;
+        dst = t;
+    }
+
+    EntitySortEntry* sorted = frame_alloc(sizeof(EntitySortEntry) * (size_t)n);
+    for (int i = 0; i < n; i++) sorted[i] = a[src[i].index];
+    memcpy(a, sorted, sizeof(EntitySortEntry) * (size_t)n);
+}
+
+void entity_depth_insertion_sort(EntitySortEntry* a, int n) {
+    for (int i = 1; i < n; i++) {
+        if (a[i - 1].key <= a[i].key) continue;
+        EntitySortEntry key = a[i];
+        int j = i - 1;
+        while (j >= 0 && a[j].key > key.key) {
+            a[j + 1] = a[j];
+            j--;
+        }
+        a[j + 1] = key;
+    }
+}
@@ -0,0 +1,71 @@
+#ifndef ENTITY_DEPTH_H
+#define ENTITY_DEPTH_H
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "game_state.h"
+#include "world_types.h"
+
+/* Draw-order keys for the world pass. Entities with a lower bottom edge
+ * draw first (appear behind). The order is one 64-bit key per entry:
+ *
+ *     depth:32 | sort_handle:32
+ *
+ * with the bottom edge quantised to 1/ENTITY_DEPTH_SCALE of a cell, so
+ * entries within that of each other tie on depth and fall back to the
+ * interned id handle, which is stable for the session: equal-depth
+ * neighbours never swap between frames. Set bottom_y through
+ * entity_depth_set_bottom() so the key follows. */
+
+#define ENTITY_DEPTH_SCALE 1024.0f
+
+typedef enum {
+    ENTITY_TYPE_OBSTACLE,
+    ENTITY_TYPE_STATIC,
+    ENTITY_TYPE_PLAYER,
+    ENTITY_TYPE_OTHER_PLAYER,
+    ENTITY_TYPE_BOT,
+    ENTITY_TYPE_RESOURCE,
+} EntitySortType;
+
+typedef struct {
+    EntitySortType type;
+    float    bottom_y;     /* Y of the entity's bottom edge */
+    IdHandle sort_handle;
+    uint64_t key;          /* entity_depth_key(bottom_y, sort_handle) */
+    int      slot;         /* index into the entry's source array */
+    union {
+        WorldObject* object;
+        PlayerState* player;
+        BotState*    bot;
+    } data;
+    bool is_main_player;
+} EntitySortEntry;
+
+static inline uint64_t entity_depth_key(float bottom_y, IdHandle handle) {
+    float q = floorf(bottom_y * ENTITY_DEPTH_SCALE);
+    if (q < (float)INT32_MIN) q = (float)INT32_MIN;
+    if (q > (float)INT32_MAX) q = (float)INT32_MAX;
+    uint32_t depth = (uint32_t)((int64_t)q - INT32_MIN);   /* biased: order-preserving */
+    return ((uint64_t)depth << 32) | handle;
+}
+
+static inline void entity_depth_set_bottom(EntitySortEntry* e, float bottom_y) {
+    e->bottom_y = bottom_y;
+    e->key      = entity_depth_key(bottom_y, e->sort_handle);
+}
+
+/* qsort comparator over EntitySortEntry: key, then type and slot. */
+int  entity_depth_compare(const void* a, const void* b);
+
+/* Sort by key with a stable LSD radix sort; its scratch comes from the
+ * frame arena (main thread). Equal keys keep their input order. */
+void entity_depth_radix_sort(EntitySortEntry* a, int n);
+
+/* Repair a nearly sorted run in place; close to one linear pass when few
+ * entries crossed since the last sort. */
+void entity_depth_insertion_sort(EntitySortEntry* a, int n);
+
+#endif /* ENTITY_DEPTH_H */
@@ -0,0 +1,201 @@
+#include "entity_fx.h"
+
+#include "util/log.h"
+
+#include <assert.h>
+#include <math.h>
+#include <rlgl.h>
+#include <string.h>
+
+#define MODE_MIX     128
+#define MODE_OUTLINE 192
+#define MODE_SHADOW  224
+#define MIX_STEPS    63
+
+static const Color FLASH_COLOR   = { 255, 255, 255, 0 };
+static const Color TINT_COLOR    = { 255, 64, 64, 0 };
+static const Color OUTLINE_COLOR = { 255, 220, 90, 0 };
+#define FLASH_AMOUNT 0.85f
+#define TINT_AMOUNT  0.5f
+
+/* The shadow branch mirrors the CPU rows in entity_render.c: four gray
+ * layers, each scaled by 1 - t²·0.3 (squared below), outer three on a
+ * checker and the innermost solid, composited over each other. */
+static const char *const FX_FRAGMENT_SHADER =
+    "#version 100\n"
+    "#extension GL_OES_standard_derivatives : enable\n"
+    "precision mediump float;\n"
+    "varying vec2 fragTexCoord;\n"
+    "varying vec4 fragColor;\n"
+    "uniform sampler2D texture0;\n"
+    "uniform vec4 colDiffuse;\n"
+    "vec4 over(vec4 dst, vec4 src) {\n"
+    "    float a = src.a + dst.a * (1.0 - src.a);\n"
+    "    if (a <= 0.0) return vec4(0.0);\n"
+    "    return vec4((src.rgb * src.a + dst.rgb * dst.a * (1.0 - src.a)) / a, a);\n"
+    "}\n"
+    "vec4 shadow_layer(vec4 acc, float d, float scale2, bool on, vec4 gray) {\n"
+    "    return (on && d <= scale2) ? over(acc, gray) : acc;\n"
+    "}\n"
+    "void main() {\n"
+    "    float code = floor(fragColor.a * 255.0 + 0.5);\n"
+    "    vec4 texel = texture2D(texture0, fragTexCoord);\n"
+    "    vec4 col;\n"
+    "    if (code < 128.0 || code > 254.0) {\n"
+    "        float a = code > 254.0 ? 1.0 : code * 2.0 / 255.0;\n"
+    "        col = texel * vec4(fragColor.rgb, a);\n"
+    "    } else if (code < 192.0) {\n"
+    "        col = vec4(mix(texel.rgb, fragColor.rgb, (code - 128.0) / 63.0), texel.a);\n"
+    "    } else if (code < 224.0) {\n"
+    "        col = texel;\n"
+    "        if (texel.a < 0.5) {\n"
+    "            vec2 px = 2.0 * fwidth(fragTexCoord);\n"
+    "            float n = max(max(texture2D(texture0, fragTexCoord + vec2(px.x, 0.0)).a,\n"
+    "                              texture2D(texture0, fragTexCoord - vec2(px.x, 0.0)).a),\n"
+    "                          max(texture2D(texture0, fragTexCoord + vec2(0.0, px.y)).a,\n"
+    "                              texture2D(texture0, fragTexCoord - vec2(0.0, px.y)).a));\n"
+    "            if (n >= 0.5) col = vec4(fragColor.rgb, 1.0);\n"
+    "        }\n"
+    "    } else {\n"
+    "        vec2 cells = floor(fragColor.rg * 255.0 + 0.5);\n"
+    "        vec2 cell = floor(fragTexCoord * cells);\n"
+    "        vec2 q = (cell + 0.5 - cells * 0.5) / (cells * 0.5);\n"
+    "        float d = dot(q, q);\n"
+    "        bool checker = mod(cell.x + cell.y, 2.0) < 0.5;\n"
+    "        col = vec4(0.0);\n"
+    "        col = shadow_layer(col, d, 1.0,      checker, vec4(70.0, 70.0, 70.0, 50.0) / 255.0);\n"
+    "        col = shadow_layer(col, d, 0.962852, checker, vec4(60.0, 60.0, 60.0, 70.0) / 255.0);\n"
+    "        col = shadow_layer(col, d, 0.855625, checker, vec4(40.0, 40.0, 20.0, 120.0) / 255.0);\n"
+    "        col = shadow_layer(col, d, 0.690977, true,    vec4(20.0, 20.0, 20.0, 140.0) / 255.0);\n"
+    "    }\n"
+    "    gl_FragColor = col * colDiffuse;\n"
+    "}\n";
+
+/* Last life seen per handle, indexed by handle (dense, so visible actors
+ * rarely share a slot; a collision only costs a missed flash). */
+typedef struct {
+    IdHandle handle;
+    float    life;
+    double   hit_at;
+} FxTrack;
+
+static struct {
+    bool    tried;
+    Shader  shader;
+    bool    active;
+    bool    paused;
+    Color   tint;
+    FxTrack tracks[ENTITY_FX_TRACKED];
+} g_fx;
+
+static_assert(0 == (ENTITY_FX_TRACKED & (ENTITY_FX_TRACKED - 1)), "track table must be a power of two");
+
+/* False when the shader does not compile here. */
+static bool fx_shader_ready(void) {
+    if (!g_fx.tried) {
+        g_fx.tried = true;
+        g_fx.shader = LoadShaderFromMemory(NULL, FX_FRAGMENT_SHADER);
+        if (g_fx.shader.id == rlGetShaderIdDefault()) {
+            LOG_WARN("[entity_fx] shader unavailable, drawing actors without effects");
+            g_fx.shader.id = 0;
+        }
+    }
+    return 0 != g_fx.shader.id;
+}
+
+static Color encode_mix(Color c, float amount) {
+    if (amount <= 0.0f) return WHITE;
+    if (amount > 1.0f) amount = 1.0f;
+    c.a = (unsigned char)(MODE_MIX + (int)lroundf(amount * MIX_STEPS));
+    return c;
+}
+
+/* Flash, then tint, after a hit; outline when selected; else untouched. */
+static Color pick_tint(IdHandle handle, float life, bool selected) {
+    double now = GetTime();
+    FxTrack* t = &g_fx.tracks[handle & (ENTITY_FX_TRACKED - 1)];
+    if (t->handle != handle) {
+        *t = (FxTrack){ .handle = handle, .life = life, .hit_at = -1.0 };
+    } else {
+        if (life < t->life) t->hit_at = now;
+        t->life = life;
+    }
+
+    if (0.0 <= t->hit_at) {
+        double since = now - t->hit_at;
+        if (since < ENTITY_FX_FLASH_SECONDS) return encode_mix(FLASH_COLOR, FLASH_AMOUNT);
+        since -= ENTITY_FX_FLASH_SECONDS;
+        if (since < ENTITY_FX_TINT_SECONDS) {
+            return encode_mix(TINT_COLOR, TINT_AMOUNT * (float)(1.0 - since / ENTITY_FX_TINT_SECONDS));
+        }
+    }
+    if (selected) {
+        Color c = OUTLINE_COLOR;
+        c.a = MODE_OUTLINE;
+        return c;
+    }
+    return WHITE;
+}
+
+bool entity_fx_begin(IdHandle handle, float life, bool selected) {
+    assert(!g_fx.active);
+    Color tint = pick_tint(handle, life, selected);
+    if (!fx_shader_ready()) return false;
+    BeginShaderMode(g_fx.shader);
+    g_fx.active = true;
+    g_fx.paused = false;
+    g_fx.tint   = tint;
+    return true;
+}
+
+void entity_fx_end(void) {
+    if (!g_fx.active) return;
+    if (!g_fx.paused) EndShaderMode();
+    g_fx.active = false;
+}
+
+bool entity_fx_active(void) {
+    return g_fx.active;
+}
+
+Color entity_fx_sprite_tint(void) {
+    return g_fx.active ? g_fx.tint : WHITE;
+}
+
+Color entity_fx_plain(Color c) {
+    if (!g_fx.active || 255 == c.a) return c;
+    c.a /= 2;
+    return c;
+}
+
+void entity_fx_shadow(Rectangle bounds, int cols, int rows) {
+    assert(g_fx.active);
+    assert(0 < cols && cols <= 255 && 0 < rows && rows <= 255);
+    Texture2D blank = {
+        .id      = rlGetTextureIdDefault(),
+        .width   = 1,
+        .height  = 1,
+        .mipmaps = 1,
+        .format  = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8,
+    };
+    Color code = { (unsigned char)cols, (unsigned char)rows, 0, MODE_SHADOW };
+    DrawTexturePro(blank, (Rectangle){ 0.0f, 0.0f, 1.0f, 1.0f }, bounds, (Vector2){ 0.0f, 0.0f }, 0.0f, code);
+}
+
+void entity_fx_pause(void) {
+    if (!g_fx.active || g_fx.paused) return;
+    EndShaderMode();
+    g_fx.paused = true;
+}
+
+void entity_fx_resume(void) {
+    if (!g_fx.active || !g_fx.paused) return;
+    BeginShaderMode(g_fx.shader);
+    g_fx.paused = false;
+}
+
+void entity_fx_release(void) {
+    assert(!g_fx.active);
+    if (0 != g_fx.shader.id) UnloadShader(g_fx.shader);
+    memset(&g_fx, 0, sizeof(g_fx));
+}
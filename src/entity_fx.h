@@ -0,0 +1,59 @@
+#ifndef CYBERIA_ENTITY_FX_H
+#define CYBERIA_ENTITY_FX_H
+
+#include "world_types.h"
+
+#include <raylib.h>
+#include <stdbool.h>
+
+/* Per-actor sprite effects in one shader block.
+ *
+ * The ground shadow, hit flash, damage tint and selection outline are all
+ * decided per fragment by one shader; what each quad gets rides in its
+ * vertex colour, so an actor's shadow and sprite layers stay in the same
+ * batch and an effect costs no extra geometry. The alpha byte selects the
+ * mode:
+ *
+ *   255      plain: texel × colour, as the default shader
+ *   0..127   plain, alpha halved (entity_fx_plain)
+ *   128..191 texel mixed toward rgb by (a - 128) / 63 — flash, damage tint
+ *   192..223 texel, with rgb on transparent texels next to opaque ones
+ *   224..254 procedural pixel-art shadow of r × g cells on a blank quad
+ *
+ * A hit is a drop in life since the actor's last draw: it flashes white
+ * for ENTITY_FX_FLASH_SECONDS, then fades through a red tint. The actor
+ * the open dialogue talks to is outlined. Where the shader does not
+ * compile (no standard derivatives) entity_fx_begin() returns false and
+ * callers draw as before, without effects. */
+
+#define ENTITY_FX_FLASH_SECONDS 0.08
+#define ENTITY_FX_TINT_SECONDS  0.35
+#define ENTITY_FX_TRACKED       1024   /* life-tracking slots, power of two */
+
+/* Enter the block for one actor and pick its effect. False when the shader
+ * is unavailable; entity_fx_end() is then a no-op. */
+bool  entity_fx_begin(IdHandle handle, float life, bool selected);
+
+/* Leave the block. Flushes the batch drawn inside it. */
+void  entity_fx_end(void);
+
+bool  entity_fx_active(void);
+
+/* Vertex colour for the actor's sprite quads; WHITE outside a block. */
+Color entity_fx_sprite_tint(void);
+
+/* `c` encoded for a plain draw inside a block (unchanged outside one). */
+Color entity_fx_plain(Color c);
+
+/* Pixel-art shadow filling `bounds`, cols × rows cells (each ≤ 255). Only
+ * inside a block. */
+void  entity_fx_shadow(Rectangle bounds, int cols, int rows);
+
+/* Step out of the shader for draws that bind their own (text), then back. */
+void  entity_fx_pause(void);
+void  entity_fx_resume(void);
+
+/* Unload the shader and forget tracked life. */
+void  entity_fx_release(void);
+
+#endif /* CYBERIA_ENTITY_FX_H */
@@ -0,0 +1,197 @@
+#include "entity_impostor.h"
+
+#include "gpu_memory.h"
+#include "object_layers_management.h"
+#include "render_stats.h"
+
+#include <assert.h>
+#include <rlgl.h>
+#include <stdint.h>
+#include <string.h>
+
+#define CELL_COLS  (ENTITY_IMPOSTOR_PAGE_PX / ENTITY_IMPOSTOR_CELL_PX)
+#define CELL_COUNT (CELL_COLS * CELL_COLS)
+
+/* w × h is the baked extent: the largest source frame of the stack, which
+ * every layer is stretched to, as they all share one dest rect on screen. */
+typedef struct {
+    uint64_t  hash;
+    int       count;
+    int       w;
+    int       h;
+    Texture2D textures[ENTITY_IMPOSTOR_MAX_LAYERS];
+    Rectangle srcs[ENTITY_IMPOSTOR_MAX_LAYERS];
+} ImpostorKey;
+
+typedef struct {
+    bool        used;
+    ImpostorKey key;
+    uint32_t    last_seen;   /* frame the stack was last drawn */
+} ImpostorCell;
+
+static struct {
+    bool            loaded;
+    RenderTexture2D page;
+    ImpostorCell    cells[CELL_COUNT];
+    ImpostorKey     queue[ENTITY_IMPOSTOR_QUEUE];
+    int             queued;
+    uint32_t        frame;
+    unsigned        atlas_generation;
+} g_impostor;
+
+static bool rect_eq(Rectangle a, Rectangle b) {
+    return a.x == b.x && a.y == b.y && a.width == b.width && a.height == b.height;
+}
+
+static bool key_eq(const ImpostorKey* a, const ImpostorKey* b) {
+    if (a->hash != b->hash || a->count != b->count) return false;
+    for (int i = 0; i < a->count; i++) {
+        if (a->textures[i].id != b->textures[i].id || !rect_eq(a->srcs[i], b->srcs[i])) return false;
+    }
+    return true;
+}
+
+/* False when the stack does not fit a cell. */
+static bool key_make(ImpostorKey* out, const Texture2D* textures, const Rectangle* srcs, int count) {
+    *out = (ImpostorKey){ .count = count };
+    uint64_t h = 14695981039346656037ull;
+    for (int i = 0; i < count; i++) {
+        out->textures[i] = textures[i];
+        out->srcs[i]     = srcs[i];
+        int w = (int)(srcs[i].width < 0.0f ? -srcs[i].width : srcs[i].width);
+        int sh = (int)(srcs[i].height < 0.0f ? -srcs[i].height : srcs[i].height);
+        if (w > out->w) out->w = w;
+        if (sh > out->h) out->h = sh;
+        uint32_t bits[4];
+        memcpy(bits, &srcs[i], sizeof(bits));
+        h = (h ^ textures[i].id) * 1099511628211ull;
+        for (int k = 0; k < 4; k++) h = (h ^ bits[k]) * 1099511628211ull;
+    }
+    out->hash = h;
+    return 0 < out->w && 0 < out->h && ENTITY_IMPOSTOR_CELL_PX >= out->w &&
+           ENTITY_IMPOSTOR_CELL_PX >= out->h;
+}
+
+static Rectangle cell_rect(int cell) {
+    return (Rectangle){
+        (float)(cell % CELL_COLS * ENTITY_IMPOSTOR_CELL_PX),
+        (float)(cell / CELL_COLS * ENTITY_IMPOSTOR_CELL_PX),
+        (float)ENTITY_IMPOSTOR_CELL_PX,
+        (float)ENTITY_IMPOSTOR_CELL_PX,
+    };
+}
+
+/* A free cell, else the one drawn longest ago and not in the last frame. */
+static int cell_claim(void) {
+    int best = -1;
+    for (int i = 0; i < CELL_COUNT; i++) {
+        const ImpostorCell* c = &g_impostor.cells[i];
+        if (!c->used) return i;
+        if (c->last_seen + 1 >= g_impostor.frame) continue;
+        if (best < 0 || c->last_seen < g_impostor.cells[best].last_seen) best = i;
+    }
+    return best;
+}
+
+static int cell_find(const ImpostorKey* key) {
+    for (int i = 0; i < CELL_COUNT; i++) {
+        const ImpostorCell* c = &g_impostor.cells[i];
+        if (c->used && key_eq(&c->key, key)) return i;
+    }
+    return -1;
+}
+
+static void cell_bake(int cell, const ImpostorKey* key) {
+    g_impostor.cells[cell] = (ImpostorCell){
+        .used      = true,
+        .key       = *key,
+        .last_seen = g_impostor.frame,
+    };
+    Rectangle r = cell_rect(cell);
+    BeginScissorMode((int)r.x, (int)r.y, (int)r.width, (int)r.height);
+    ClearBackground(BLANK);
+    EndScissorMode();
+    Rectangle dst = { r.x, r.y, (float)key->w, (float)key->h };
+    for (int i = 0; i < key->count; i++) {
+        DrawTexturePro(key->textures[i], key->srcs[i], dst, (Vector2){ 0.0f, 0.0f }, 0.0f, WHITE);
+    }
+}
+
+void entity_impostor_prepare(void) {
+    g_impostor.frame++;
+    unsigned generation = obj_layers_mgr_atlas_generation();
+    if (generation != g_impostor.atlas_generation) {
+        g_impostor.atlas_generation = generation;
+        memset(g_impostor.cells, 0, sizeof(g_impostor.cells));
+        g_impostor.queued = 0;
+        return;
+    }
+    if (0 == g_impostor.queued) return;
+    if (!g_impostor.loaded) {
+        g_impostor.page = LoadRenderTexture(ENTITY_IMPOSTOR_PAGE_PX, ENTITY_IMPOSTOR_PAGE_PX);
+        gpu_memory_add(GPU_MEM_IMPOSTORS, gpu_memory_texture_bytes(g_impostor.page.texture));
+        g_impostor.loaded = true;
+        BeginTextureMode(g_impostor.page);
+        ClearBackground(BLANK);
+        EndTextureMode();
+    }
+
+    /* As in ui/icon_atlas.c: alpha accumulates over the cleared cell and
+     * colour is left premultiplied, which only shows on partly transparent
+     * edge pixels. */
+    BeginTextureMode(g_impostor.page);
+    rlSetBlendFactorsSeparate(RL_SRC_ALPHA, RL_ONE_MINUS_SRC_ALPHA, RL_ONE, RL_ONE_MINUS_SRC_ALPHA,
+                              RL_FUNC_ADD, RL_FUNC_ADD);
+    BeginBlendMode(BLEND_CUSTOM_SEPARATE);
+    int baked = 0;
+    for (int q = 0; q < g_impostor.queued && ENTITY_IMPOSTOR_BAKES_PER_FRAME > baked; q++) {
+        const ImpostorKey* key = &g_impostor.queue[q];
+        if (0 <= cell_find(key)) continue;
+        int cell = cell_claim();
+        if (0 > cell) break;
+        cell_bake(cell, key);
+        baked++;
+    }
+    EndBlendMode();
+    EndTextureMode();
+    /* Stacks left over are queued again by their next miss. */
+    g_impostor.queued = 0;
+}
+
+int entity_impostor_find(const Texture2D* textures, const Rectangle* srcs, int count) {
+    assert((textures && srcs) || 0 == count);
+    if (0 >= count || ENTITY_IMPOSTOR_MAX_LAYERS < count) return -1;
+    ImpostorKey key;
+    if (!key_make(&key, textures, srcs, count)) return -1;
+    int cell = cell_find(&key);
+    if (0 <= cell) {
+        g_impostor.cells[cell].last_seen = g_impostor.frame;
+        return cell;
+    }
+    for (int q = 0; q < g_impostor.queued; q++) {
+        if (key_eq(&g_impostor.queue[q], &key)) return -1;
+    }
+    if (ENTITY_IMPOSTOR_QUEUE > g_impostor.queued) g_impostor.queue[g_impostor.queued++] = key;
+    return -1;
+}
+
+Texture2D entity_impostor_texture(void) {
+    return g_impostor.page.texture;
+}
+
+Rectangle entity_impostor_src(int cell) {
+    assert(0 <= cell && CELL_COUNT > cell && g_impostor.cells[cell].used);
+    const ImpostorKey* key = &g_impostor.cells[cell].key;
+    Rectangle r = cell_rect(cell);
+    /* Render textures are stored bottom-up. */
+    return (Rectangle){ r.x, (float)ENTITY_IMPOSTOR_PAGE_PX - r.y - (float)key->h, (float)key->w,
+                        -(float)key->h };
+}
+
+void entity_impostor_release(void) {
+    if (g_impostor.loaded) {
+        gpu_memory_sub(GPU_MEM_IMPOSTORS, gpu_memory_texture_bytes(g_impostor.page.texture));
+        UnloadRenderTexture(g_impostor.page);
+    }
+    memset(&g_impostor, 0, sizeof(g_impostor));
+}
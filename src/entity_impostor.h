@@ -0,0 +1,47 @@
+#ifndef CYBERIA_ENTITY_IMPOSTOR_H
+#define CYBERIA_ENTITY_IMPOSTOR_H
+
+#include <raylib.h>
+#include <stdbool.h>
+
+/* Entity layer stacks composited into one shared render-texture page.
+ *
+ * draw_entity_layers draws every equipment layer of every actor as its own
+ * quad, often from its own atlas texture. Bots of one type share a layer
+ * set, so at the same direction, mode and frame they resolve to the same
+ * source rects: that frame is composited once into a page cell and every
+ * such actor draws it as one quad (ENTITY_LOD_IMPOSTOR).
+ *
+ * Cells are keyed by the resolved layers (texture and source rect, in draw
+ * order), which covers layer set, direction, mode and frame at once. A
+ * frame not baked yet draws per layer and is queued; the queue bakes in
+ * entity_impostor_prepare(), at most ENTITY_IMPOSTOR_BAKES_PER_FRAME a
+ * frame. Cells are LRU-recycled, never while drawn in the last frame, so
+ * texture memory stays at one page however many stacks are seen. A stack
+ * whose frames exceed a cell, or with more than ENTITY_IMPOSTOR_MAX_LAYERS
+ * layers, always draws per layer. A texture landing in the atlas cache
+ * retires every cell. */
+
+#define ENTITY_IMPOSTOR_PAGE_PX         1024
+#define ENTITY_IMPOSTOR_CELL_PX         64
+#define ENTITY_IMPOSTOR_MAX_LAYERS      8
+#define ENTITY_IMPOSTOR_QUEUE           64
+#define ENTITY_IMPOSTOR_BAKES_PER_FRAME 32
+
+/* Bake the queued stacks. Must run outside BeginMode2D — baking switches
+ * the render target. */
+void      entity_impostor_prepare(void);
+
+/* Baked cell of the stack textures[i]/srcs[i], bottom layer first, or -1
+ * after queueing it for a bake. */
+int       entity_impostor_find(const Texture2D* textures, const Rectangle* srcs, int count);
+
+/* The page and the source rect of `cell` in it, flipped for a render
+ * texture: draw with DrawTexturePro or render_queue_push. */
+Texture2D entity_impostor_texture(void);
+Rectangle entity_impostor_src(int cell);
+
+/* Unload the page and forget every cell. */
+void      entity_impostor_release(void);
+
+#endif /* CYBERIA_ENTITY_IMPOSTOR_H */
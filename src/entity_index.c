@@ -0,0 +1,44 @@
+#include "entity_index.h"
+
+#include <assert.h>
+#include <string.h>
+
+#define INDEX_MASK (ENTITY_INDEX_CAPACITY - 1)
+
+static const char* record_id(const EntityIndex* ix, int slot) {
+    return (const char*)ix->records + (size_t)slot * ix->stride;
+}
+
+void entity_index_clear(EntityIndex* ix) {
+    assert(ix);
+    memset(ix->slots, 0, sizeof(ix->slots));
+}
+
+int entity_index_find(const EntityIndex* ix, const char* id, hash_t hash) {
+    assert(ix);
+    assert(id);
+    uint32_t h = (uint32_t)hash;
+    for (uint32_t i = h & INDEX_MASK; 0 != ix->slots[i]; i = (i + 1) & INDEX_MASK) {
+        if (h != ix->hashes[i]) { continue; }
+        int slot = (int)ix->slots[i] - 1;
+        if (0 == strcmp(record_id(ix, slot), id)) { return slot; }
+    }
+    return -1;
+}
+
+void entity_index_insert(EntityIndex* ix, hash_t hash, int slot) {
+    assert(ix);
+    assert(0 <= slot && ENTITY_INDEX_CAPACITY / 2 > slot);
+    uint32_t h = (uint32_t)hash;
+    uint32_t i = h & INDEX_MASK;
+    while (0 != ix->slots[i]) { i = (i + 1) & INDEX_MASK; }
+    ix->hashes[i] = h;
+    ix->slots[i]  = (uint16_t)(slot + 1);
+}
+
+void entity_index_rebuild(EntityIndex* ix, int count) {
+    entity_index_clear(ix);
+    for (int i = 0; i < count; i++) {
+        entity_index_insert(ix, entity_index_hash(record_id(ix, i)), i);
+    }
+}
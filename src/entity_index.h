@@ -0,0 +1,43 @@
+#ifndef ENTITY_INDEX_H
+#define ENTITY_INDEX_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "hash_table.h"
+
+/* Fixed-capacity id → slot index over an array of records whose first member
+ * is a NUL-terminated id (EntityState, PrevPos). Open addressing with linear
+ * probing; each probe compares the stored hash first, so strcmp only runs on
+ * a genuine candidate. The index never owns the records: whoever reorders or
+ * truncates the array clears or rebuilds the index in the same step.
+ *
+ * Zero-initialised storage is a valid empty index, so an EntityIndex can be a
+ * static with only .records and .stride set. */
+
+/* Power of two, at least 2 × MAX_ENTITIES so probes stay short at full AOI. */
+#define ENTITY_INDEX_CAPACITY 2048
+
+typedef struct {
+    const void* records;
+    size_t      stride;
+    uint32_t    hashes[ENTITY_INDEX_CAPACITY];
+    uint16_t    slots[ENTITY_INDEX_CAPACITY]; /* record slot + 1; 0 = empty */
+} EntityIndex;
+
+static inline hash_t entity_index_hash(const char* id) {
+    return hash_string(id);
+}
+
+void entity_index_clear(EntityIndex* ix);
+
+/* Record slot holding `id` (hash = entity_index_hash(id)), or -1. */
+int  entity_index_find(const EntityIndex* ix, const char* id, hash_t hash);
+
+/* Map `slot` under `hash`; the caller has checked the id is not present. */
+void entity_index_insert(EntityIndex* ix, hash_t hash, int slot);
+
+/* Clear and re-insert records [0, count). */
+void entity_index_rebuild(EntityIndex* ix, int count);
+
+#endif /* ENTITY_INDEX_H */
@@ -1,18 +1,27 @@
 #include "entity_render.h"
-#include "ui/text.h"
+#include "entity_fx.h"
+#include "dev_overlay.h"
+#include "entity_impostor.h"
 #include "object_layers_management.h"
+#include "layer_stack.h"
 #include "layer_z_order.h"
-#include "hash_table.h"
+#include "id_intern.h"
+#include "heap_memory.h"
+#include "render_queue.h"
+#include "render_stats.h"
 #include <raylib.h>
 #include <math.h>
 #include <stdlib.h>
 #include <string.h>
-#include <stdio.h>
 #include <assert.h>
 
-#define ANIM_TABLE_INITIAL_CAPACITY 4096
+#define ANIM_TABLE_INITIAL_CAPACITY 4096   /* power of two */
+#define OWNER_TABLE_INITIAL_CAPACITY 1024 /* power of two */
+#define RECIPE_TABLE_INITIAL_CAPACITY 256 /* power of two */
 #define MAX_LAYERS_PER_ENTITY 20
 #define DEFAULT_FRAME_DURATION_MS 100
+/* Draws between animation advances of a throttled (off-focus) entity. */
+#define ENTITY_LOD_THROTTLE_DRAWS 4
 
 /* Ground-shadow tuning — a small flat ellipse under the feet, not a puddle.
  * Pixel-art style: drawn as stacked horizontal pixel rows with multiple gray
@@ -22,7 +31,8 @@
 #define ENTITY_SHADOW_PIXEL_SIZE 3.0f   /* size of each "pixel" in the shadow */
 
 /* Gray shades for pixel-art shadow gradient (outer → inner).
- * Grayish undertones with soft transparency for a subtle pixel-art shadow. */
+ * Grayish undertones with soft transparency for a subtle pixel-art shadow.
+ * The shader path (entity_fx.c) carries the same shades and layer falloff. */
 static const Color ENTITY_SHADOW_GRAYS[4] = {
     { 70, 70, 70, 50 },   /* outermost — dark gray */
     { 60, 60, 60, 70 },   /* mid-outer — darker gray */
@@ -33,32 +43,83 @@ static const Color ENTITY_SHADOW_GRAYS[4] = {
 /* Animation states untouched for this long are assumed to belong to entities
  * that left the AOI and are evicted by entity_render_gc(). */
 #define ANIM_IDLE_EVICT_SECONDS 4.0
+/* Owner slots entity_render_gc() visits per call; a full sweep of the
+ * initial table takes OWNER_TABLE_INITIAL_CAPACITY / this many frames. */
+#define GC_SLOTS_PER_FRAME 64
 
 // --- Data Structures ---
 
-typedef struct {
+typedef struct AnimationState {
+    uint64_t key;                /* (entity, item) in the animations map */
+    struct AnimationState* next_owned;  /* the owning entity's next layer */
     int   last_direction_enum;   /* Direction cast to int; -1 = unset */
     int   last_mode_enum;        /* ObjectLayerMode cast to int; -1 = unset */
-    float time_acc;              /* delta accumulator in seconds */
+    double clip_start_time;      /* when the current (direction, mode) clip began */
     double last_access_time;     /* GC sentinel — set on every get/create */
-    int   frame_index;
+    int   frame_index;           /* last frame resolved from the clip clock */
     Direction last_facing_direction;
     bool  textures_ready;
     int   failed_texture_attempts;
+    int   throttle_draws;        /* draws since the last throttled advance */
 } AnimationState;
 
+/* Integer-keyed map, open addressing with linear probing. Keys pack two
+ * handles into one integer (entity << 32 | item); 0 marks an empty slot,
+ * so at least one half of every key is a real handle. `free_value` drops an
+ * evicted value. */
+typedef struct {
+    uint64_t* keys;
+    void**    values;
+    size_t    capacity;    /* power of two */
+    size_t    count;
+    void    (*free_value)(void* value);
+} HandleMap;
+
+/* Draw order of one entity's layers, resolved once per layer-set change
+ * rather than per frame: the ObjectLayer / atlas metadata of each active
+ * layer and its z-sorted position for both facings (layer_z_priority
+ * differs when facing up). Valid while the entity's layers_version, layer
+ * count and the catalog generation all match. A shared layer_stack id names
+ * the same stack on every record, so its recipe is built once and used by
+ * all of them. */
+typedef struct {
+    int                   layers_slot;   /* index into the caller's layers_state */
+    ObjectLayer*          layer;
+    AtlasSpriteSheetData* atlas;
+} RecipeEntry;
+
+typedef struct {
+    uint32_t    layers_version;
+    int         layers_count;
+    unsigned    catalog_generation;
+    bool        has_associated_item_id;
+    int         count;
+    RecipeEntry entries[MAX_LAYERS_PER_ENTITY];
+    uint8_t     order[2][MAX_LAYERS_PER_ENTITY];   /* [facing up] → entries index */
+} RenderRecipe;
+
+/* Everything cached for one entity handle: its recipe and its layers'
+ * animation states, linked through next_owned, so an entity is freed in
+ * O(layers) with no table scan. */
+typedef struct {
+    uint64_t        key;         /* (entity, NONE) in the owners map */
+    double          last_access_time;
+    RenderRecipe*   recipe;      /* NULL until first drawn */
+    AnimationState* anims;
+} EntityOwner;
+
 struct EntityRender {
     ObjectLayersManager* obj_layers_mgr;
-    HashTable animations;  // "<entity_id>_<item_id>" → AnimationState*
+    HandleMap animations;  /* (entity, item) → AnimationState* */
+    HandleMap owners;      /* (entity, NONE) → EntityOwner* */
+    HandleMap recipes;     /* shared layer_stack id → RenderRecipe* */
+    unsigned  stack_generation;
+    EntityOwner unowned;   /* layers of entities drawn without a handle */
+    size_t    gc_cursor;   /* next owners slot the sweep visits */
+    EntityLodTier lod;
+    bool      lod_throttle;
 };
 
-typedef struct {
-    ObjectLayerState* state;
-    ObjectLayer* layer;
-    AtlasSpriteSheetData* atlas;
-    int priority;
-} LayerRenderInfo;
-
 // --- Helper Functions ---
 
 /* Pool allocator for AnimationState. With 200+ entities × up to 20 layers,
@@ -82,7 +143,7 @@ static AnimNode*  s_anim_free   = NULL;
 
 static AnimationState* anim_pool_alloc(void) {
     if (!s_anim_free) {
-        AnimBlock* b = malloc(sizeof(AnimBlock));
+        AnimBlock* b = heap_malloc(HEAP_MEM_ANIM_POOL, sizeof(AnimBlock));
         assert(b);
         b->next = s_anim_blocks;
         s_anim_blocks = b;
@@ -102,141 +163,277 @@ static void anim_pool_free(AnimationState* a) {
     s_anim_free  = n;
 }
 
+static uint64_t handle_key(IdHandle entity_handle, IdHandle item_handle) {
+    return ((uint64_t)entity_handle << 32) | item_handle;
+}
+
+static size_t handle_slot_of(uint64_t key, size_t capacity) {
+    /* Fibonacci hashing spreads the sequential handles over the table. */
+    return (size_t)((key * 0x9E3779B97F4A7C15ull) >> 32) & (capacity - 1);
+}
+
+static void handle_map_init(HandleMap* m, size_t capacity, void (*free_value)(void*)) {
+    m->keys       = calloc(capacity, sizeof(uint64_t));
+    m->values     = calloc(capacity, sizeof(void*));
+    assert(m->keys && m->values);
+    m->capacity   = capacity;
+    m->count      = 0;
+    m->free_value = free_value;
+}
+
+static void* handle_map_get(const HandleMap* m, uint64_t key) {
+    for (size_t i = handle_slot_of(key, m->capacity); 0 != m->keys[i]; i = (i + 1) & (m->capacity - 1)) {
+        if (key == m->keys[i]) return m->values[i];
+    }
+    return NULL;
+}
+
+static void handle_map_insert(HandleMap* m, uint64_t key, void* value) {
+    size_t i = handle_slot_of(key, m->capacity);
+    while (0 != m->keys[i]) { i = (i + 1) & (m->capacity - 1); }
+    m->keys[i]   = key;
+    m->values[i] = value;
+    m->count++;
+}
+
+/* Rehash into `capacity` slots. */
+static void handle_map_rebuild(HandleMap* m, size_t capacity) {
+    HandleMap old = *m;
+    handle_map_init(m, capacity, old.free_value);
+    for (size_t i = 0; i < old.capacity; i++) {
+        if (0 != old.keys[i]) handle_map_insert(m, old.keys[i], old.values[i]);
+    }
+    free(old.keys);
+    free(old.values);
+}
+
+/* Insert a key known to be absent, growing at half load. */
+static void handle_map_add(HandleMap* m, uint64_t key, void* value) {
+    if (2 * (m->count + 1) > m->capacity) {
+        handle_map_rebuild(m, 2 * m->capacity);
+    }
+    handle_map_insert(m, key, value);
+}
+
+/* Unlink `key` and return its value (not freed), or NULL. Later entries of
+ * the probe run shift back into the hole, so no tombstones build up. */
+static void* handle_map_take(HandleMap* m, uint64_t key) {
+    size_t mask = m->capacity - 1;
+    size_t hole = handle_slot_of(key, m->capacity);
+    for (; key != m->keys[hole]; hole = (hole + 1) & mask) {
+        if (0 == m->keys[hole]) return NULL;
+    }
+    void* value = m->values[hole];
+    for (size_t j = (hole + 1) & mask; 0 != m->keys[j]; j = (j + 1) & mask) {
+        size_t home = handle_slot_of(m->keys[j], m->capacity);
+        /* An entry whose home lies cyclically in (hole, j] cannot move. */
+        bool stays = hole < j ? (hole < home && home <= j) : (hole < home || home <= j);
+        if (stays) continue;
+        m->keys[hole]   = m->keys[j];
+        m->values[hole] = m->values[j];
+        hole = j;
+    }
+    m->keys[hole]   = 0;
+    m->values[hole] = NULL;
+    m->count--;
+    return value;
+}
+
+static void handle_map_destroy(HandleMap* m) {
+    for (size_t i = 0; i < m->capacity; i++) {
+        if (0 != m->keys[i]) m->free_value(m->values[i]);
+    }
+    free(m->keys);
+    free(m->values);
+}
+
 static void free_anim_state(void* p) {
-    anim_pool_free((AnimationState*)p);
+    anim_pool_free(p);
+}
+
+static void free_owner(void* p) {
+    EntityOwner* owner = p;
+    free(owner->recipe);
+    free(owner);
 }
 
-static AnimationState* get_animation_state(EntityRender* render, const char* entity_id, const char* item_id) {
-    assert(render && entity_id && item_id);
+/* The entity's owner record, created on first use. */
+static EntityOwner* get_entity_owner(EntityRender* render, IdHandle entity_handle, double now) {
+    if (ID_HANDLE_NONE == entity_handle) return &render->unowned;
+    uint64_t key = handle_key(entity_handle, ID_HANDLE_NONE);
+    EntityOwner* owner = handle_map_get(&render->owners, key);
+    if (!owner) {
+        owner = calloc(1, sizeof(EntityOwner));
+        assert(owner);
+        owner->key = key;
+        handle_map_add(&render->owners, key, owner);
+    }
+    owner->last_access_time = now;
+    return owner;
+}
 
-    char key[256];
-    snprintf(key, sizeof(key), "%s_%s", entity_id, item_id);
+static AnimationState* get_animation_state(EntityRender* render, EntityOwner* owner,
+                                           IdHandle item_handle, double now) {
+    assert(render && owner);
+    assert(ID_HANDLE_NONE != item_handle);
+    uint64_t key = (owner->key & ~(uint64_t)UINT32_MAX) | item_handle;
 
-    AnimationState* anim = (AnimationState*)hash_table_get(&render->animations, key);
+    AnimationState* anim = handle_map_get(&render->animations, key);
     if (anim) {
-        anim->last_access_time = GetTime();
+        anim->last_access_time = now;
         return anim;
     }
 
     anim = anim_pool_alloc();
     *anim = (AnimationState){
+        .key                  = key,
+        .next_owned           = owner->anims,
         .last_direction_enum  = -1,
         .last_mode_enum       = -1,
-        .time_acc             = 0.0f,
+        .clip_start_time      = now,
         .last_facing_direction = DIRECTION_DOWN,
-        .last_access_time     = GetTime(),
+        .last_access_time     = now,
     };
-    hash_table_put(&render->animations, key, anim);
+    owner->anims = anim;
+    handle_map_add(&render->animations, key, anim);
     return anim;
 }
 
-static bool anim_is_stale(const char* key, void* value, void* user_data) {
-    const AnimationState* anim = value;
-    double now = *(const double*)user_data;
-    return (now - anim->last_access_time) > ANIM_IDLE_EVICT_SECONDS;
+/* Free the owner's layers idle past ANIM_IDLE_EVICT_SECONDS at `now`, or all
+ * of them when `all`. O(layers). */
+static void owner_drop_anims(EntityRender* render, EntityOwner* owner, double now, bool all) {
+    for (AnimationState** link = &owner->anims; *link;) {
+        AnimationState* anim = *link;
+        if (!all && now - anim->last_access_time <= ANIM_IDLE_EVICT_SECONDS) {
+            link = &anim->next_owned;
+            continue;
+        }
+        *link = anim->next_owned;
+        handle_map_take(&render->animations, anim->key);
+        anim_pool_free(anim);
+    }
 }
 
-static bool anim_key_has_prefix(const char* key, void* value, void* user_data) {
-    const char* prefix = user_data;
-    return 0 == strncmp(key, prefix, strlen(prefix));
+static void owner_evict(EntityRender* render, EntityOwner* owner) {
+    owner_drop_anims(render, owner, 0.0, true);
+    handle_map_take(&render->owners, owner->key);
+    free_owner(owner);
 }
 
-static int compare_layer_priority(const void* a, const void* b) {
-    LayerRenderInfo* info_a = (LayerRenderInfo*)a;
-    LayerRenderInfo* info_b = (LayerRenderInfo*)b;
-    return info_a->priority - info_b->priority;
+/* Stable insertion sort of the recipe entries by z-priority for one facing. */
+static void recipe_sort(RenderRecipe* recipe, bool facing_up) {
+    int priority[MAX_LAYERS_PER_ENTITY];
+    uint8_t* order = recipe->order[facing_up];
+    for (int i = 0; i < recipe->count; i++) {
+        const ObjectLayer* layer = recipe->entries[i].layer;
+        // Default priority if no ObjectLayer metadata yet
+        priority[i] = layer ? layer_z_priority(layer->data.item.type, facing_up) : 50;
+        int j = i;
+        for (; j > 0 && priority[order[j - 1]] > priority[i]; j--) {
+            order[j] = order[j - 1];
+        }
+        order[j] = (uint8_t)i;
+    }
 }
 
-/**
- * @brief Determine the direction string and frame count for the current animation state.
- *
- * Frame counts are resolved exclusively from AtlasSpriteSheetData metadata.
- * The render path picks the first available animation in a small fallback
- * chain.
- */
-static int pick_available_direction(
-    const AtlasSpriteSheetData* atlas,
-    const char* requested_dir,
-    const char* secondary_dir,
-    const char** out_dir_string
-) {
-    const char* candidates[5] = {
-        requested_dir,
-        secondary_dir,
-        "down_idle",
-        "none_idle",
-        "default_idle"
-    };
+static void recipe_build(RenderRecipe* recipe, ObjectLayerState** layers_state, int layers_count,
+                         uint32_t layers_version, unsigned catalog_generation) {
+    recipe->layers_version         = layers_version;
+    recipe->layers_count           = layers_count;
+    recipe->catalog_generation     = catalog_generation;
+    recipe->has_associated_item_id = false;
+    recipe->count                  = 0;
 
-    for (int i = 0; i < 5; i++) {
-        const char* dir_str = candidates[i];
-        if (!dir_str || dir_str[0] == '\0') {
+    for (int i = 0; i < layers_count && recipe->count < MAX_LAYERS_PER_ENTITY; i++) {
+        ObjectLayerState* state = layers_state[i];
+        if (!state || !state->active || state->item_id[0] == '\0') {
             continue;
         }
-        const DirectionFrameData* dfd = atlas_get_direction_frames(atlas, dir_str);
-        if (dfd && dfd->count > 0) {
-            *out_dir_string = dir_str;
-            return dfd->count;
+
+        recipe->has_associated_item_id = true;
+
+        // Fetch object layer metadata (for item type, ledger, render CIDs)
+        HashKey      key   = object_layer_state_key(state);
+        ObjectLayer* layer = lookup_cached_layer_h(key);
+
+        // Fetch atlas sprite sheet data (for frame metadata + atlas texture
+        // reference); schedules the metadata fetch on a miss
+        AtlasSpriteSheetData* atlas = get_or_fetch_atlas_data_h(key);
+
+        if (!layer && !atlas) {
+            // Neither data source available yet — still loading
+            continue;
         }
+
+        // atlas may be NULL if only ObjectLayer is available
+        recipe->entries[recipe->count++] = (RecipeEntry){
+            .layers_slot = i,
+            .layer       = layer,
+            .atlas       = atlas,
+        };
     }
 
-    *out_dir_string = requested_dir && requested_dir[0] != '\0' ? requested_dir : "down_idle";
-    return 0;
+    recipe_sort(recipe, false);
+    recipe_sort(recipe, true);
 }
 
-static int get_frame_count_and_direction(
-    const AtlasSpriteSheetData* atlas,
-    Direction dir,
-    ObjectLayerMode mode,
-    const char** out_dir_string
-) {
-    // Build the direction string based on direction + mode
-    const char* dir_str = "down_idle";
-    const char* fallback_dir = NULL;
-
-    if (mode == MODE_WALKING) {
-        switch (dir) {
-            case DIRECTION_UP:         dir_str = "up_walking"; fallback_dir = "up_idle"; break;
-            case DIRECTION_DOWN:       dir_str = "down_walking"; fallback_dir = "down_idle"; break;
-            case DIRECTION_LEFT:       dir_str = "left_walking"; fallback_dir = "left_idle"; break;
-            case DIRECTION_RIGHT:      dir_str = "right_walking"; fallback_dir = "right_idle"; break;
-            case DIRECTION_UP_RIGHT:   dir_str = "up_right_walking"; fallback_dir = "up_right_idle"; break;
-            case DIRECTION_UP_LEFT:    dir_str = "up_left_walking"; fallback_dir = "up_left_idle"; break;
-            case DIRECTION_DOWN_RIGHT: dir_str = "down_right_walking"; fallback_dir = "down_right_idle"; break;
-            case DIRECTION_DOWN_LEFT:  dir_str = "down_left_walking"; fallback_dir = "down_left_idle"; break;
-            default:                   dir_str = "down_walking"; fallback_dir = "down_idle"; break;
-        }
-    } else {
-        switch (dir) {
-            case DIRECTION_UP:         dir_str = "up_idle"; break;
-            case DIRECTION_DOWN:       dir_str = "down_idle"; break;
-            case DIRECTION_LEFT:       dir_str = "left_idle"; break;
-            case DIRECTION_RIGHT:      dir_str = "right_idle"; break;
-            case DIRECTION_UP_RIGHT:   dir_str = "up_right_idle"; break;
-            case DIRECTION_UP_LEFT:    dir_str = "up_left_idle"; break;
-            case DIRECTION_DOWN_RIGHT: dir_str = "down_right_idle"; break;
-            case DIRECTION_DOWN_LEFT:  dir_str = "down_left_idle"; break;
-            case DIRECTION_NONE:       dir_str = "down_idle"; break;
-            default:                   dir_str = "down_idle"; break;
-        }
+/* The recipe of shared stack `stack`, built on first use and rebuilt when
+ * the catalog moved. A new session's stacks start a fresh table. */
+static const RenderRecipe* shared_recipe(EntityRender* render, ObjectLayerState** layers_state,
+                                         int layers_count, uint32_t stack, unsigned generation) {
+    if (render->stack_generation != layer_stack_generation()) {
+        render->stack_generation = layer_stack_generation();
+        handle_map_destroy(&render->recipes);
+        handle_map_init(&render->recipes, RECIPE_TABLE_INITIAL_CAPACITY, free);
     }
+    RenderRecipe* recipe = handle_map_get(&render->recipes, stack);
+    if (!recipe) {
+        recipe = malloc(sizeof(RenderRecipe));
+        assert(recipe);
+        recipe_build(recipe, layers_state, layers_count, stack, generation);
+        handle_map_add(&render->recipes, stack, recipe);
+    } else if (recipe->catalog_generation != generation) {
+        recipe_build(recipe, layers_state, layers_count, stack, generation);
+    }
+    return recipe;
+}
 
-    if (!atlas) {
-        *out_dir_string = dir_str;
-        return 0;
+/* The entity's recipe, rebuilt when its layer set or the catalog moved.
+ * Entities without a handle get a one-frame recipe in `scratch`, unless
+ * their stack is shared. */
+static const RenderRecipe* get_render_recipe(EntityRender* render, EntityOwner* owner,
+                                             ObjectLayerState** layers_state, int layers_count,
+                                             uint32_t layers_version, RenderRecipe* scratch) {
+    unsigned generation = obj_layers_mgr_catalog_generation();
+    if (layer_stack_shared(layers_version)) {
+        return shared_recipe(render, layers_state, layers_count, layers_version, generation);
+    }
+    if (&render->unowned == owner) {
+        recipe_build(scratch, layers_state, layers_count, layers_version, generation);
+        return scratch;
     }
 
-    return pick_available_direction(atlas, dir_str, fallback_dir, out_dir_string);
+    RenderRecipe* recipe = owner->recipe;
+    if (!recipe) {
+        recipe = malloc(sizeof(RenderRecipe));
+        assert(recipe);
+        recipe_build(recipe, layers_state, layers_count, layers_version, generation);
+        owner->recipe = recipe;
+    } else if (recipe->layers_version != layers_version ||
+               recipe->layers_count   != layers_count ||
+               recipe->catalog_generation != generation) {
+        recipe_build(recipe, layers_state, layers_count, layers_version, generation);
+    }
+    return recipe;
 }
 
-static void draw_dev_ui_box(Rectangle dest_rec, const char* entity_type) {
-    Color color = RED;
-    if (strcmp(entity_type, "self") == 0) color = BLUE;
-    else if (strcmp(entity_type, "other") == 0) color = ORANGE;
-    else if (strcmp(entity_type, "bot") == 0) color = GREEN;
-
-    DrawRectangleLinesEx(dest_rec, 1.0f, color);
-    DrawText(entity_type, (int)dest_rec.x, (int)dest_rec.y - 10, 10, color);
+static void draw_fallback_rect(Rectangle dest_rec, Color color) {
+    color = entity_fx_plain(color);
+    if (render_queue_is_open()) {
+        render_queue_push_rect(dest_rec, color, 0);
+    } else {
+        DrawRectangleRec(dest_rec, color);
+    }
 }
 
 // ============================================================================
@@ -248,37 +445,83 @@ EntityRender* create_entity_render(ObjectLayersManager* object_layers_manager) {
     if (!render) return NULL;
 
     render->obj_layers_mgr = object_layers_manager;
-    hash_table_init(&render->animations, ANIM_TABLE_INITIAL_CAPACITY, free_anim_state, "entity_animations");
+    handle_map_init(&render->animations, ANIM_TABLE_INITIAL_CAPACITY, free_anim_state);
+    handle_map_init(&render->owners, OWNER_TABLE_INITIAL_CAPACITY, free_owner);
+    handle_map_init(&render->recipes, RECIPE_TABLE_INITIAL_CAPACITY, free);
+    render->stack_generation = layer_stack_generation();
+    render->unowned      = (EntityOwner){ 0 };
+    render->gc_cursor    = 0;
+    render->lod          = ENTITY_LOD_FULL;
+    render->lod_throttle = false;
 
     return render;
 }
 
 void destroy_entity_render(EntityRender* render) {
     if (!render) return;
-    hash_table_destroy(&render->animations);
+    handle_map_destroy(&render->animations);
+    handle_map_destroy(&render->owners);
+    handle_map_destroy(&render->recipes);
     free(render);
 }
 
 void entity_render_gc(EntityRender* render) {
     assert(render);
     double now = GetTime();
-    hash_table_remove_if(&render->animations, anim_is_stale, &now);
+    HandleMap* owners = &render->owners;
+    /* Clock sweep: a bounded run of owner slots per frame. An evicted owner
+     * may shift a later entry into its slot, so the cursor stays put. */
+    for (int visited = 0; visited < GC_SLOTS_PER_FRAME; visited++) {
+        render->gc_cursor &= owners->capacity - 1;
+        if (0 == render->gc_cursor) owner_drop_anims(render, &render->unowned, now, false);
+        EntityOwner* owner = 0 != owners->keys[render->gc_cursor] ? owners->values[render->gc_cursor] : NULL;
+        if (owner && now - owner->last_access_time > ANIM_IDLE_EVICT_SECONDS) {
+            owner_evict(render, owner);
+            continue;
+        }
+        if (owner) owner_drop_anims(render, owner, now, false);
+        render->gc_cursor++;
+    }
 }
 
 void entity_render_forget_entity(EntityRender* render, const char* entity_id) {
     assert(render && entity_id);
-    char prefix[256];
-    snprintf(prefix, sizeof(prefix), "%s_", entity_id);
-    hash_table_remove_if(&render->animations, anim_key_has_prefix, prefix);
+    IdHandle handle = id_intern_find(entity_id);
+    if (ID_HANDLE_NONE == handle) return;
+    EntityOwner* owner = handle_map_get(&render->owners, handle_key(handle, ID_HANDLE_NONE));
+    if (owner) owner_evict(render, owner);
+}
+
+void entity_render_forget_all_but(EntityRender* render, const char* keep_id) {
+    assert(render && keep_id);
+    IdHandle keep = id_intern_find(keep_id);
+    uint64_t keep_key = ID_HANDLE_NONE == keep ? 0 : handle_key(keep, ID_HANDLE_NONE);
+    HandleMap* owners = &render->owners;
+    /* An evicted owner may shift a later entry into its slot: revisit it. */
+    for (size_t i = 0; i < owners->capacity;) {
+        if (0 != owners->keys[i] && keep_key != owners->keys[i]) {
+            owner_evict(render, owners->values[i]);
+            continue;
+        }
+        i++;
+    }
+    owner_drop_anims(render, &render->unowned, 0.0, true);
+    render->gc_cursor = 0;
 }
 
 // ============================================================================
 // Public API - Rendering
 // ============================================================================
 
+void entity_render_set_lod(EntityRender* render, EntityLodTier tier, bool throttle_animation) {
+    assert(render);
+    render->lod          = tier;
+    render->lod_throttle = throttle_animation;
+}
+
 void draw_entity_layers(
     EntityRender* render,
-    const char* entity_id,
+    IdHandle entity_handle,
     float pos_x,
     float pos_y,
     float width,
@@ -287,12 +530,13 @@ void draw_entity_layers(
     ObjectLayerMode mode,
     ObjectLayerState** layers_state,
     int layers_count,
+    uint32_t layers_version,
     const char* entity_type,
     bool dev_ui,
     float cell_size,
     Color fallback_color
 ) {
-    assert(render && entity_id);
+    assert(render);
 
     if (cell_size <= 0.0f) cell_size = 12.0f;
 
@@ -310,96 +554,62 @@ void draw_entity_layers(
 
     // Draw dev UI debug box if enabled
     if (dev_ui && entity_type) {
-        draw_dev_ui_box(dest_rec, entity_type);
+        dev_overlay_box(dest_rec, entity_type);
     }
 
     if (!layers_state || layers_count <= 0) {
         return;
     }
 
+    if (ENTITY_LOD_QUAD == render->lod) {
+        draw_fallback_rect(dest_rec, fallback_color);
+        return;
+    }
+
     // ========================================================================
-    // Layer Collection and Sorting
+    // Layer Collection and Sorting — cached per entity until its layers change
     // ========================================================================
 
-    LayerRenderInfo layers_to_render[MAX_LAYERS_PER_ENTITY];
-    int render_count = 0;
-    bool has_associated_item_id = false;
-
-    for (int i = 0; i < layers_count && render_count < MAX_LAYERS_PER_ENTITY; i++) {
-        ObjectLayerState* state = layers_state[i];
-        if (!state || !state->active || state->item_id[0] == '\0') {
-            continue;
-        }
-
-        has_associated_item_id = true;
-
-        // Fetch object layer metadata (for item type, ledger, render CIDs)
-        ObjectLayer* layer = lookup_cached_layer(state->item_id);
-
-        // Fetch atlas sprite sheet data (for frame metadata + atlas texture reference)
-        AtlasSpriteSheetData* atlas = get_or_fetch_atlas_data(state->item_id);
-
-        // If atlas metadata not yet cached, pump the async REST fetch state
-        // machine each frame. On first call: schedules
-        // GET /api/atlas-sprite-sheet/metadata/:itemKey. On subsequent calls:
-        // polls the in-flight request and caches the JSON when it arrives,
-        // then automatically kicks off the PNG blob fetch.
-        if (!atlas) {
-            get_atlas_texture(state->item_id);
-        }
-
-        if (!layer && !atlas) {
-            // Neither data source available yet — still loading
-            continue;
-        }
-
-        // Add to render list (atlas may be NULL if only ObjectLayer is available)
-        layers_to_render[render_count].state = state;
-        layers_to_render[render_count].layer = layer;
-        layers_to_render[render_count].atlas = atlas;
-        layers_to_render[render_count].priority = layer
-            ? layer_z_priority(layer->data.item.type, direction == DIRECTION_UP)
-            : 50; // Default priority if no ObjectLayer metadata yet
-        render_count++;
-    }
-
-    if (!has_associated_item_id) {
-        DrawRectangleRec(dest_rec, fallback_color);
+    double now = GetTime();
+    EntityOwner* owner = get_entity_owner(render, entity_handle, now);
+    RenderRecipe scratch;
+    const RenderRecipe* recipe = get_render_recipe(render, owner, layers_state, layers_count,
+                                                   layers_version, &scratch);
+    int render_count = recipe->count;
+
+    if (!recipe->has_associated_item_id) {
+        draw_fallback_rect(dest_rec, fallback_color);
         return;
     }
 
     if (render_count == 0) {
         // Entity has active item IDs but no atlas data loaded yet —
         // draw the fallback color so the entity is visible while textures load.
-        DrawRectangleRec(dest_rec, fallback_color);
+        draw_fallback_rect(dest_rec, fallback_color);
         return;
     }
 
-    // Sort layers by priority (lower z-order first)
-    qsort(layers_to_render, render_count, sizeof(LayerRenderInfo), compare_layer_priority);
+    // Lower z-order first
+    const uint8_t* order = recipe->order[direction == DIRECTION_UP];
 
     // ========================================================================
     // Texture Availability Check & Animation Update
     // ========================================================================
 
-    float frame_dt = GetFrameTime();
     // Per-layer rendering data
     Texture2D layer_textures[MAX_LAYERS_PER_ENTITY] = { 0 };
     Rectangle layer_source_rects[MAX_LAYERS_PER_ENTITY] = { 0 };
 
     for (int i = 0; i < render_count; i++) {
-        ObjectLayerState* state = layers_to_render[i].state;
-        AtlasSpriteSheetData* atlas = layers_to_render[i].atlas;
-
-        // Get or create animation state
-        AnimationState* anim = get_animation_state(
-            render,
-            entity_id,
-            state->item_id
-        );
-        if (!anim) {
-            continue;
+        const RecipeEntry* entry = &recipe->entries[order[i]];
+        ObjectLayerState* state = layers_state[entry->layers_slot];
+        AtlasSpriteSheetData* atlas = entry->atlas;
+
+        // Layers built outside the decoder intern on first draw
+        if (ID_HANDLE_NONE == state->item_handle) {
+            state->item_handle = id_intern(state->item_id);
         }
+        AnimationState* anim = get_animation_state(render, owner, state->item_handle, now);
 
         // Update last_facing_direction
         if (direction != DIRECTION_NONE) {
@@ -425,13 +635,9 @@ void draw_entity_layers(
         }
 
         // Frame Selection — resolved exclusively from atlas metadata
-        const char* dir_string = NULL;
-        int num_frames = get_frame_count_and_direction(
-            atlas,
-            render_direction,
-            render_mode,
-            &dir_string
-        );
+        DirectionFrameData dfd = atlas
+            ? atlas_frames_for(atlas, render_direction, render_mode) : (DirectionFrameData){ 0 };
+        int num_frames = dfd.count;
 
         if (num_frames <= 0) {
             // No frames for this state — skip this layer
@@ -443,17 +649,22 @@ void draw_entity_layers(
             (int)render_mode     != anim->last_mode_enum) {
             anim->last_direction_enum = (int)render_direction;
             anim->last_mode_enum      = (int)render_mode;
+            anim->clip_start_time     = now;
             anim->frame_index         = 0;
-            anim->time_acc            = 0.0f;
         }
 
-        // Animation Advancement — delta accumulator; catches skipped frames
-        // under load (e.g. 300 ms frame at 125 ms/frame advances by 2).
-        float frame_sec = frame_duration_ms / 1000.0f;
-        anim->time_acc += frame_dt;
-        while (anim->time_acc >= frame_sec) {
-            anim->time_acc -= frame_sec;
-            anim->frame_index = (anim->frame_index + 1) % num_frames;
+        // Frame from the clip clock — O(1) however long since the last draw,
+        // so entities that went undrawn (culled, offscreen) cost nothing and
+        // catch up to where a continuous animation would be. Throttled
+        // entities re-resolve only every few draws.
+        bool advance = true;
+        if (render->lod_throttle) {
+            advance = ++anim->throttle_draws >= ENTITY_LOD_THROTTLE_DRAWS;
+            if (advance) anim->throttle_draws = 0;
+        }
+        if (advance) {
+            double elapsed_ms = (now - anim->clip_start_time) * 1000.0;
+            anim->frame_index = (int)((long long)(elapsed_ms / frame_duration_ms) % num_frames);
         }
         if (anim->frame_index >= num_frames) anim->frame_index = 0;
 
@@ -463,20 +674,18 @@ void draw_entity_layers(
 
         if (atlas && atlas->item_key[0] != '\0') {
             // Get or poll the atlas texture (async loading)
-            Texture2D atlas_texture = get_atlas_texture(atlas->item_key);
+            AtlasRegion atlas_region = obj_layers_mgr_atlas_region(atlas);
 
-            if (atlas_texture.id > 0) {
+            if (atlas_region.texture.id > 0) {
                 // Atlas texture is ready — look up the source rectangle
                 // from the FrameMetadata for the current direction and frame
-                const DirectionFrameData* dfd = atlas_get_direction_frames(atlas, dir_string);
-
-                if (dfd && anim->frame_index < dfd->count) {
-                    const FrameMetadata* fm = &dfd->frames[anim->frame_index];
+                if (anim->frame_index < dfd.count) {
+                    const FrameMetadata* fm = &dfd.frames[anim->frame_index];
 
-                    layer_textures[i] = atlas_texture;
+                    layer_textures[i] = atlas_region.texture;
                     layer_source_rects[i] = (Rectangle){
-                        (float)fm->x,
-                        (float)fm->y,
+                        (float)(atlas_region.x + fm->x),
+                        (float)(atlas_region.y + fm->y),
                         (float)fm->width,
                         (float)fm->height
                     };
@@ -485,6 +694,12 @@ void draw_entity_layers(
                         anim->textures_ready = true;
                         anim->failed_texture_attempts = 0;
                     }
+
+                    // Skin tier: the lowest drawable layer stands for the rest
+                    if (ENTITY_LOD_SKIN == render->lod) {
+                        render_count = i + 1;
+                        break;
+                    }
                 } else {
                     // Frame metadata missing for this direction/frame
                     anim->failed_texture_attempts++;
@@ -503,20 +718,107 @@ void draw_entity_layers(
     // Final Rendering
     // ========================================================================
 
+    // Deferred into the render queue when a pass has it open, so equal-depth
+    // quads sharing an atlas batch together
+    bool queued = render_queue_is_open();
+    // Flash, tint or outline of the actor's effect block; WHITE outside one
+    Color tint = entity_fx_sprite_tint();
+
+    // Impostor tier: a stack of two or more layers draws as its baked
+    // composite once the page has it
+    if (ENTITY_LOD_IMPOSTOR == render->lod) {
+        Texture2D textures[MAX_LAYERS_PER_ENTITY];
+        Rectangle srcs[MAX_LAYERS_PER_ENTITY];
+        int drawn = 0;
+        for (int i = 0; i < render_count; i++) {
+            if (0 == layer_textures[i].id) continue;
+            textures[drawn] = layer_textures[i];
+            srcs[drawn]     = layer_source_rects[i];
+            drawn++;
+        }
+        int cell = 1 < drawn ? entity_impostor_find(textures, srcs, drawn) : -1;
+        if (0 <= cell) {
+            Texture2D page = entity_impostor_texture();
+            Rectangle src  = entity_impostor_src(cell);
+            if (queued) render_queue_push(page, src, dest_rec, tint, 0);
+            else        DrawTexturePro(page, src, dest_rec, (Vector2){0.0f, 0.0f}, 0.0f, tint);
+            return;
+        }
+    }
+
     for (int i = 0; i < render_count; i++) {
-        if (layer_textures[i].id > 0) {
+        if (0 == layer_textures[i].id) continue;
+        if (queued) {
+            render_queue_push(layer_textures[i], layer_source_rects[i], dest_rec, tint, i);
+        } else {
             DrawTexturePro(
                 layer_textures[i],
                 layer_source_rects[i],
                 dest_rec,
                 (Vector2){0.0f, 0.0f},
                 0.0f,
-                WHITE
+                tint
             );
         }
     }
 }
 
+bool entity_layers_are_static(
+    ObjectLayerState** layers_state,
+    int layers_count,
+    Direction direction,
+    ObjectLayerMode mode
+) {
+    for (int i = 0; i < layers_count; i++) {
+        const ObjectLayerState* state = layers_state[i];
+        if (!state || !state->active || state->item_id[0] == '\0') {
+            continue;
+        }
+
+        AtlasSpriteSheetData* atlas = get_or_fetch_atlas_data_h(object_layer_state_key(state));
+        if (!atlas || atlas->item_key[0] == '\0') return false;
+        if (0 == obj_layers_mgr_atlas_region(atlas).texture.id) return false;
+
+        if (1 != atlas_frames_for(atlas, direction, mode).count) return false;
+    }
+    return true;
+}
+
+int entity_layers_static_frames(
+    EntityRender* render,
+    IdHandle entity_handle,
+    ObjectLayerState** layers_state,
+    int layers_count,
+    uint32_t layers_version,
+    Texture2D* textures,
+    Rectangle* source_rects
+) {
+    assert(render && textures && source_rects);
+    EntityOwner* owner = get_entity_owner(render, entity_handle, GetTime());
+    RenderRecipe scratch;
+    const RenderRecipe* recipe = get_render_recipe(render, owner, layers_state, layers_count,
+                                                   layers_version, &scratch);
+    if (!recipe->has_associated_item_id) return 0;
+
+    int n = 0;
+    for (int i = 0; i < recipe->count; i++) {
+        AtlasSpriteSheetData* atlas = recipe->entries[recipe->order[0][i]].atlas;
+        if (!atlas || '\0' == atlas->item_key[0]) continue;
+        DirectionFrameData dfd = atlas_frames_for(atlas, DIRECTION_NONE, MODE_IDLE);
+        AtlasRegion region = obj_layers_mgr_atlas_region(atlas);
+        if (0 >= dfd.count || 0 == region.texture.id) continue;
+        textures[n]     = region.texture;
+        source_rects[n] = (Rectangle){
+            (float)(region.x + dfd.frames[0].x),
+            (float)(region.y + dfd.frames[0].y),
+            (float)dfd.frames[0].width,
+            (float)dfd.frames[0].height
+        };
+        n++;
+    }
+    return n;
+}
+
 void draw_entity_shadow(float pos_x, float pos_y, float width, float height, float cell_size) {
     if (cell_size <= 0.0f) cell_size = 12.0f;
 
@@ -526,6 +828,25 @@ void draw_entity_shadow(float pos_x, float pos_y, float width, float height, flo
     float ry = rx * ENTITY_SHADOW_SQUASH;
     float ps = ENTITY_SHADOW_PIXEL_SIZE;  /* pixel size */
 
+    /* Inside an effect block the whole oval is one quad, shaded per cell;
+     * its centre snaps to the pixel grid like the rows below. */
+    if (entity_fx_active()) {
+        int cols = 2 * (int)ceilf(rx / ps);
+        int rows = 2 * (int)ceilf(ry / ps);
+        if (cols < 2) cols = 2;
+        if (rows < 2) rows = 2;
+        if (cols > 254) cols = 254;
+        if (rows > 254) rows = 254;
+        Rectangle bounds = {
+            roundf(center_x / ps) * ps - (float)(cols / 2) * ps,
+            feet_y - (float)(rows / 2) * ps,
+            (float)cols * ps,
+            (float)rows * ps,
+        };
+        entity_fx_shadow(bounds, cols, rows);
+        return;
+    }
+
     /* Draw a pixel-art oval shadow using stacked horizontal pixel rows.
      * For each row (y offset from center), compute the half-width of the
      * ellipse at that row, then snap to pixel grid and draw rectangles
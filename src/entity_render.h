@@ -3,6 +3,7 @@
 
 #include "object_layers_management.h"
 #include "object_layer.h"
+#include "world_types.h"
 #include <stdbool.h>
 
 /**
@@ -80,13 +81,37 @@ EntityRender* create_entity_render(ObjectLayersManager* object_layers_manager);
 void destroy_entity_render(EntityRender* render);
 
 /* Evict animation states for entities that have left the AOI (not drawn
- * recently). Call periodically from the render loop to bound memory. */
+ * recently). Each call advances an incremental sweep over a bounded number
+ * of entities; an evicted entity frees its recipe and layers in
+ * O(layers). Call once per frame from the render loop to bound memory. */
 void entity_render_gc(EntityRender* render);
 
 /* Synchronously evict all animation states for a single entity (all its
- * item layers). Call when an entity is removed from the world snapshot. */
+ * item layers), O(layers). Call when an entity is removed from the world
+ * snapshot. */
 void entity_render_forget_entity(EntityRender* render, const char* entity_id);
 
+/* Evict every entity's animation states and recipe except `keep_id`'s,
+ * and the unowned layers. Call on map change, when nothing else drawn so
+ * far will be drawn again. */
+void entity_render_forget_all_but(EntityRender* render, const char* keep_id);
+
+/* Level of detail for draw_entity_layers: every layer, every layer as one
+ * composited quad from the shared impostor page (entity_impostor.h), the
+ * lowest drawable layer only (the skin), or one quad in the fallback
+ * colour. */
+typedef enum {
+    ENTITY_LOD_FULL,
+    ENTITY_LOD_IMPOSTOR,
+    ENTITY_LOD_SKIN,
+    ENTITY_LOD_QUAD,
+} EntityLodTier;
+
+/* Detail for the draw_entity_layers calls that follow, until changed.
+ * `throttle_animation` advances animation frames only every few draws of
+ * an entity (off-focus actors); time still accumulates, so none is lost. */
+void entity_render_set_lod(EntityRender* render, EntityLodTier tier, bool throttle_animation);
+
 // ============================================================================
 // Public API - Rendering
 // ============================================================================
@@ -95,7 +120,7 @@ void entity_render_forget_entity(EntityRender* render, const char* entity_id);
  * @brief Renders all animated object layers for a single entity
  *
  * This is the main entry point for entity rendering. It:
- * 1. Draws a debug box if dev_ui is enabled (shows entity boundaries)
+ * 1. Queues a debug box (dev_overlay.h) if dev_ui is enabled (shows entity boundaries)
  * 2. Skips object layer rendering if dev_ui is enabled
  * 3. If dev_ui is disabled, renders all active layers with animations
  *
@@ -105,7 +130,7 @@ void entity_render_forget_entity(EntityRender* render, const char* entity_id);
  * - This ensures proper visual layering (z-order)
  *
  * Animation Behavior:
- * - Each unique (entity_id, item_id) pair has persistent animation state
+ * - Each unique (entity handle, item handle) pair has persistent animation state
  * - Frame advances automatically based on frame_duration inferred from atlas metadata
  * - Animation resets when state string (direction_mode combo) changes
  * - When idle with no direction, uses last known facing direction
@@ -121,7 +146,7 @@ void entity_render_forget_entity(EntityRender* render, const char* entity_id);
  * - When dev_ui=false: ONLY renders object layers
  *
  * @param render Pointer to EntityRender system
- * @param entity_id Unique identifier for this entity (e.g., "player123", "bot456")
+ * @param entity_handle Interned id of this entity (EntityState/WorldObject .handle)
  * @param pos_x World X position in grid coordinates (will be scaled by cell_size)
  * @param pos_y World Y position in grid coordinates (will be scaled by cell_size)
  * @param width Entity width in grid units (will be scaled by cell_size)
@@ -130,6 +155,8 @@ void entity_render_forget_entity(EntityRender* render, const char* entity_id);
  * @param mode Current animation mode (from ObjectLayerMode enum)
  * @param layers_state Array of ObjectLayerState pointers (may be NULL if layers_count=0)
  * @param layers_count Number of layers in the array (0 is valid, means no layers)
+ * @param layers_version The entity's layers_version; a change re-resolves
+ *                    and re-sorts its cached layer order
  * @param entity_type String type identifier:
  *                    - "self": local player
  *                    - "other": another player
@@ -162,13 +189,14 @@ void entity_render_forget_entity(EntityRender* render, const char* entity_id);
  *   // Render entity at grid position (10, 15), size 1x2, facing right, walking
  *   draw_entity_layers(
  *       render_system,
- *       "player123",          // entity_id
+ *       player->base.handle,  // entity_handle
  *       10.0f, 15.0f,         // pos_x, pos_y in grid cells
  *       1.0f, 2.0f,           // width, height in grid cells
  *       DIRECTION_RIGHT,      // facing right
  *       MODE_WALKING,         // walking animation
  *       layers,               // array of layer states
  *       2,                    // 2 layers
+ *       player->base.layers_version,
  *       "self",               // it's the player
  *       false,                // dev_ui disabled (render normally)
  *       32.0f                 // 32 pixels per grid cell
@@ -176,7 +204,7 @@ void entity_render_forget_entity(EntityRender* render, const char* entity_id);
  * @endcode
  *
  * Implementation Notes:
- * - Animation state is cached per (entity_id, item_id) pair
+ * - Animation state is cached per (entity_handle, item_handle) pair
  * - Direction memory persists so idle entities retain facing direction
  * - Frame index is automatically clamped to valid range
  * - Missing layers are silently skipped (no error messages)
@@ -184,8 +212,8 @@ void entity_render_forget_entity(EntityRender* render, const char* entity_id);
  * - All rendering uses raylib's DrawTexturePro for flexible positioning
  *
  * Performance Considerations:
- * - Hash table lookup for animation state: O(1) average, O(n) worst case
- * - Layer sorting: O(n log n) where n = number of active layers
+ * - Animation state lookup: one integer-keyed probe, no string formatting
+ * - Layer metadata lookups and sorting run once per layer-set change, not per frame
  * - Typical entity has 1-4 layers, so sorting is negligible
  * - Texture loading uses cache (hit = immediate, miss = network request)
  *
@@ -196,7 +224,7 @@ void entity_render_forget_entity(EntityRender* render, const char* entity_id);
  */
 void draw_entity_layers(
     EntityRender* render,
-    const char* entity_id,
+    IdHandle entity_handle,
     float pos_x,
     float pos_y,
     float width,
@@ -205,19 +233,47 @@ void draw_entity_layers(
     ObjectLayerMode mode,
     ObjectLayerState** layers_state,
     int layers_count,
+    uint32_t layers_version,
     const char* entity_type,
     bool dev_ui,
     float cell_size,
     Color fallback_color
 );
 
+/* True when draw_entity_layers would draw the same pixels every frame for
+ * these layers: each active layer has its atlas texture loaded and a single
+ * frame for (direction, mode). Pumps the atlas fetches like a draw does.
+ * Layer sets with no active item are static (the fallback fill). */
+bool entity_layers_are_static(
+    ObjectLayerState** layers_state,
+    int layers_count,
+    Direction direction,
+    ObjectLayerMode mode
+);
+
+/* The one frame each layer of a static stack (entity_layers_are_static,
+ * DIRECTION_NONE / MODE_IDLE) draws, lowest z first: its atlas page and
+ * source rect, as draw_entity_layers would resolve them at full detail.
+ * Returns how many, at most layers_count; 0 when the stack draws as its
+ * fallback fill. */
+int entity_layers_static_frames(
+    EntityRender* render,
+    IdHandle entity_handle,
+    ObjectLayerState** layers_state,
+    int layers_count,
+    uint32_t layers_version,
+    Texture2D* textures,
+    Rectangle* source_rects
+);
+
 /* Draws a flat, squashed dark ellipse under an entity's feet — a ground
  * shadow shared by every living entity (players, other players, bots,
  * resources). `pos_x`/`pos_y`/`width`/`height` are the same grid-unit
  * footprint passed to draw_entity_layers; scaled internally by `cell_size`.
  * Stateless. Call once per frame, immediately before drawing the entity's
  * sprite layers, so the shadow sits beneath it. Not used for obstacles,
- * statics, or non-combat bots (skill/coin/drop projectiles). */
+ * statics, or non-combat bots (skill/coin/drop projectiles). Inside an
+ * entity_fx block it is one shader-shaded quad rather than pixel rows. */
 void draw_entity_shadow(float pos_x, float pos_y, float width, float height, float cell_size);
 
 #endif // ENTITY_RENDER_H
@@ -0,0 +1,199 @@
+#include "fg_occlusion.h"
+
+#include "game_state.h"
+#include "gpu_memory.h"
+#include "render_queue.h"
+#include "world_target.h"
+#include "util/log.h"
+
+#include <assert.h>
+#include <math.h>
+#include <raylib.h>
+#include <rlgl.h>
+#include <string.h>
+
+#define FG_STR_(x) #x
+#define FG_STR(x)  FG_STR_(x)
+
+/* occluders[i] is centre (xy) and radii (zw) in mask texture coordinates. */
+static const char *const FG_FRAGMENT_SHADER =
+    "#version 100\n"
+    "precision mediump float;\n"
+    "varying vec2 fragTexCoord;\n"
+    "varying vec4 fragColor;\n"
+    "uniform sampler2D texture0;\n"
+    "uniform vec4 colDiffuse;\n"
+    "uniform vec4 occluders[" FG_STR(FG_OCCLUSION_MAX) "];\n"
+    "uniform float occluderCount;\n"
+    "uniform float minAlpha;\n"
+    "void main() {\n"
+    "    vec4 texel = texture2D(texture0, fragTexCoord);\n"
+    "    float keep = 1.0;\n"
+    "    for (int i = 0; i < " FG_STR(FG_OCCLUSION_MAX) "; i++) {\n"
+    "        if (float(i) >= occluderCount) break;\n"
+    "        vec2 d = (fragTexCoord - occluders[i].xy) / occluders[i].zw;\n"
+    "        keep = min(keep, mix(minAlpha, 1.0, smoothstep(0.6, 1.0, length(d))));\n"
+    "    }\n"
+    "    gl_FragColor = texel * keep * fragColor * colDiffuse;\n"
+    "}\n";
+
+static struct {
+    bool            tried;
+    Shader          shader;
+    int             loc_occluders;
+    int             loc_count;
+    int             loc_min_alpha;
+    bool            loaded;
+    RenderTexture2D mask;
+    bool            open;
+    Camera2D        view;     /* the world pass's camera */
+    RenderTexture2D target;   /* the world pass's texture, id 0 for the screen */
+} g_fg;
+
+/* False when the shader does not compile here. */
+static bool fg_shader_ready(void) {
+    if (!g_fg.tried) {
+        g_fg.tried  = true;
+        g_fg.shader = LoadShaderFromMemory(NULL, FG_FRAGMENT_SHADER);
+        if (g_fg.shader.id == rlGetShaderIdDefault()) {
+            LOG_WARN("[fg_occlusion] shader unavailable, drawing foregrounds opaque");
+            g_fg.shader.id = 0;
+        } else {
+            g_fg.loc_occluders = GetShaderLocation(g_fg.shader, "occluders");
+            g_fg.loc_count     = GetShaderLocation(g_fg.shader, "occluderCount");
+            g_fg.loc_min_alpha = GetShaderLocation(g_fg.shader, "minAlpha");
+        }
+    }
+    return 0 != g_fg.shader.id;
+}
+
+static void mask_unload(void) {
+    if (g_fg.loaded) {
+        gpu_memory_sub(GPU_MEM_FG_MASK, gpu_memory_texture_bytes(g_fg.mask.texture));
+        UnloadRenderTexture(g_fg.mask);
+    }
+    g_fg.loaded = false;
+    g_fg.mask   = (RenderTexture2D){ 0 };
+}
+
+static bool mask_ensure(int w, int h) {
+    if (g_fg.loaded && g_fg.mask.texture.width == w && g_fg.mask.texture.height == h) return true;
+    mask_unload();
+    g_fg.mask = LoadRenderTexture(w, h);
+    if (0 == g_fg.mask.id) return false;
+    gpu_memory_add(GPU_MEM_FG_MASK, gpu_memory_texture_bytes(g_fg.mask.texture));
+    g_fg.loaded = true;
+    return true;
+}
+
+bool fg_occlusion_begin(void) {
+    assert(!g_fg.open);
+    if (!fg_shader_ready()) return false;
+    if (!world_target_view(&g_fg.view, &g_fg.target)) return false;
+    int w = g_fg.target.id ? g_fg.target.texture.width  : GetScreenWidth();
+    int h = g_fg.target.id ? g_fg.target.texture.height : GetScreenHeight();
+    if (0 >= w || 0 >= h || !mask_ensure(w, h)) return false;
+
+    if (render_queue_is_open()) render_queue_flush();
+    EndMode2D();
+    BeginTextureMode(g_fg.mask);
+    ClearBackground(BLANK);
+    BeginMode2D(g_fg.view);
+    /* Premultiplied colour, alpha accumulated over the cleared mask. */
+    rlSetBlendFactorsSeparate(RL_SRC_ALPHA, RL_ONE_MINUS_SRC_ALPHA, RL_ONE, RL_ONE_MINUS_SRC_ALPHA,
+                              RL_FUNC_ADD, RL_FUNC_ADD);
+    BeginBlendMode(BLEND_CUSTOM_SEPARATE);
+    g_fg.open = true;
+    return true;
+}
+
+/* Actor bounds in cells as an ellipse in mask texture coordinates (v up:
+ * render textures are stored bottom-up). */
+static Vector4 occluder_uv(float x, float y, float w, float h, float cell_size) {
+    Vector2 a = GetWorldToScreen2D((Vector2){ x * cell_size, y * cell_size }, g_fg.view);
+    Vector2 b = GetWorldToScreen2D((Vector2){ (x + w) * cell_size, (y + h) * cell_size }, g_fg.view);
+    float mw = (float)g_fg.mask.texture.width;
+    float mh = (float)g_fg.mask.texture.height;
+    float rx = fmaxf((b.x - a.x) * 0.5f * FG_OCCLUSION_REACH, 1.0f);
+    float ry = fmaxf((b.y - a.y) * 0.5f * FG_OCCLUSION_REACH, 1.0f);
+    return (Vector4){ (a.x + b.x) * 0.5f / mw, 1.0f - (a.y + b.y) * 0.5f / mh, rx / mw, ry / mh };
+}
+
+typedef struct {
+    const EntityHotSet* set;
+    int                 slot;
+    float               d2;
+} NearActor;
+
+/* Keep the `cap` actors of `set` nearest to (cx, cy), sorted by distance. */
+static int nearest_actors(const EntityHotSet* set, float cx, float cy,
+                          NearActor* near, int n, int cap) {
+    const float reach2 = FG_OCCLUSION_NEAR_CELLS * FG_OCCLUSION_NEAR_CELLS;
+    for (int i = 0; i < set->count; i++) {
+        float dx = set->x[i] + set->w[i] * 0.5f - cx;
+        float dy = set->y[i] + set->h[i] * 0.5f - cy;
+        float d2 = dx * dx + dy * dy;
+        if (d2 > reach2 || (n == cap && d2 >= near[n - 1].d2)) continue;
+        int j = (n < cap) ? n++ : n - 1;
+        while (0 < j && near[j - 1].d2 > d2) {
+            near[j] = near[j - 1];
+            j--;
+        }
+        near[j] = (NearActor){ .set = set, .slot = i, .d2 = d2 };
+    }
+    return n;
+}
+
+static int gather_occluders(float cell_size, Vector4* out) {
+    const EntityState* self = &g_game_state.player.base;
+    float cx = self->interp_pos.x + self->dims.x * 0.5f;
+    float cy = self->interp_pos.y + self->dims.y * 0.5f;
+    int n = 0;
+    out[n++] = occluder_uv(self->interp_pos.x, self->interp_pos.y, self->dims.x, self->dims.y, cell_size);
+
+    NearActor near[FG_OCCLUSION_MAX - 1];
+    int k = nearest_actors(&g_game_state.player_hot, cx, cy, near, 0, FG_OCCLUSION_MAX - 1);
+    k = nearest_actors(&g_game_state.bot_hot, cx, cy, near, k, FG_OCCLUSION_MAX - 1);
+    for (int i = 0; i < k; i++) {
+        const EntityHotSet* s = near[i].set;
+        int j = near[i].slot;
+        out[n++] = occluder_uv(s->x[j], s->y[j], s->w[j], s->h[j], cell_size);
+    }
+    return n;
+}
+
+void fg_occlusion_end(float cell_size) {
+    assert(g_fg.open);
+    g_fg.open = false;
+    if (render_queue_is_open()) render_queue_flush();
+    EndBlendMode();
+    EndMode2D();
+    EndTextureMode();
+    if (g_fg.target.id) BeginTextureMode(g_fg.target);
+
+    Vector4 occluders[FG_OCCLUSION_MAX];
+    int   n         = gather_occluders(cell_size, occluders);
+    float count     = (float)n;
+    float min_alpha = FG_OCCLUSION_MIN_ALPHA;
+    float w = (float)g_fg.mask.texture.width;
+    float h = (float)g_fg.mask.texture.height;
+
+    BeginShaderMode(g_fg.shader);
+    SetShaderValueV(g_fg.shader, g_fg.loc_occluders, occluders, SHADER_UNIFORM_VEC4, n);
+    SetShaderValue(g_fg.shader, g_fg.loc_count, &count, SHADER_UNIFORM_FLOAT);
+    SetShaderValue(g_fg.shader, g_fg.loc_min_alpha, &min_alpha, SHADER_UNIFORM_FLOAT);
+    BeginBlendMode(BLEND_ALPHA_PREMULTIPLY);
+    DrawTexturePro(g_fg.mask.texture, (Rectangle){ 0.0f, 0.0f, w, -h }, (Rectangle){ 0.0f, 0.0f, w, h },
+                   (Vector2){ 0.0f, 0.0f }, 0.0f, WHITE);
+    EndBlendMode();
+    EndShaderMode();
+
+    BeginMode2D(g_fg.view);
+}
+
+void fg_occlusion_release(void) {
+    assert(!g_fg.open);
+    mask_unload();
+    if (0 != g_fg.shader.id) UnloadShader(g_fg.shader);
+    memset(&g_fg, 0, sizeof(g_fg));
+}
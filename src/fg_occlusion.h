@@ -0,0 +1,41 @@
+#ifndef CYBERIA_FG_OCCLUSION_H
+#define CYBERIA_FG_OCCLUSION_H
+
+#include <stdbool.h>
+
+/* See-through foregrounds in one masked pass.
+ *
+ * Foregrounds always draw over the actors, so a tree or roof hides
+ * whoever walks behind it. Instead of testing each foreground against the
+ * player, the foreground pass is drawn into a mask target the size of the
+ * world pass, then composited back as one quad through a shader that
+ * fades mask pixels near the local player and the FG_OCCLUSION_MAX - 1
+ * nearest actors within FG_OCCLUSION_NEAR_CELLS of it:
+ *
+ *     alpha × mix(FG_OCCLUSION_MIN_ALPHA, 1, smoothstep(0.6, 1, d))
+ *
+ * with d the distance from the actor's centre over an ellipse
+ * FG_OCCLUSION_REACH times its half-extent. Only foreground pixels are
+ * faded — open ground around the actor is untouched. The mask holds
+ * premultiplied colour, as the impostor page does. Where the shader does
+ * not compile, or outside world_target_begin/end, fg_occlusion_begin()
+ * returns false and callers draw the foregrounds directly. */
+
+#define FG_OCCLUSION_MAX        8       /* occluders per frame, shader array size */
+#define FG_OCCLUSION_NEAR_CELLS 10.0f
+#define FG_OCCLUSION_REACH      1.6f
+#define FG_OCCLUSION_MIN_ALPHA  0.3f
+
+/* Redirect the open world pass into the mask, cleared, under the same
+ * camera. Flushes the open render queue first. False when unavailable;
+ * nothing changed then and fg_occlusion_end() must not be called. */
+bool fg_occlusion_begin(void);
+
+/* Flush what was queued into the mask, return to the world pass and
+ * composite the mask faded around the actors. */
+void fg_occlusion_end(float cell_size);
+
+/* Unload the mask and the shader. */
+void fg_occlusion_release(void);
+
+#endif /* CYBERIA_FG_OCCLUSION_H */
@@ -0,0 +1,56 @@
+#include "fidelity.h"
+
+#include "domain/camera.h"
+#include "domain/presentation_runtime.h"
+#include "game_state.h"
+#include "util/log.h"
+
+static const float STEPS[] = FIDELITY_SCALE_STEPS;
+#define STEP_COUNT ((int)(sizeof(STEPS) / sizeof(STEPS[0])))
+
+static struct {
+    int    step;
+    float  frame_ms;       /* smoothed interval, 1/16 per frame */
+    double lower_at;
+    double raise_at;
+} g_fid;
+
+static void set_step(int step, double now) {
+    LOG_DEBUG("[fidelity] step %d -> %d (%.2fx, %.1f ms)", g_fid.step, step,
+              (double)STEPS[step], (double)g_fid.frame_ms);
+    g_fid.step     = step;
+    g_fid.lower_at = now + FIDELITY_LOWER_HOLD_SECONDS;
+    g_fid.raise_at = now + FIDELITY_RAISE_HOLD_SECONDS;
+}
+
+void fidelity_on_frame(float frame_ms) {
+    if (0.0f >= frame_ms || FIDELITY_SPIKE_MS < frame_ms) return;
+    double now = GetTime();
+    if (0.0f == g_fid.frame_ms) g_fid.frame_ms = frame_ms;
+    g_fid.frame_ms += (frame_ms - g_fid.frame_ms) / 16.0f;
+
+    if (FIDELITY_LOWER_MS < g_fid.frame_ms && STEP_COUNT - 1 > g_fid.step) {
+        if (now >= g_fid.lower_at) set_step(g_fid.step + 1, now);
+    } else if (FIDELITY_RAISE_MS > g_fid.frame_ms && 0 < g_fid.step) {
+        if (now >= g_fid.raise_at) set_step(g_fid.step - 1, now);
+    }
+}
+
+FidelityTier fidelity_tier(Vector2 pos, Vector2 dims) {
+    const float cell_size = 0 < g_game_state.cell_size ? g_game_state.cell_size : 12.0f;
+    if (dims.y * cell_size * camera_zoom() < FIDELITY_FAR_PX) return FIDELITY_FAR;
+
+    const PresentationLodHints lod = presentation_runtime_lod();
+    const Vector2 focus = g_game_state.player.base.interp_pos;
+    float scale = STEPS[g_fid.step];
+    float dx = pos.x - focus.x, dy = pos.y - focus.y;
+    float d2 = dx * dx + dy * dy;
+    float far = lod.detail_cells * scale;
+    if (d2 > far * far) return FIDELITY_FAR;
+    float mid = lod.focus_cells * scale;
+    return d2 > mid * mid ? FIDELITY_MID : FIDELITY_NEAR;
+}
+
+float fidelity_scale(void) {
+    return STEPS[g_fid.step];
+}
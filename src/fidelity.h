@@ -0,0 +1,45 @@
+#ifndef CYBERIA_FIDELITY_H
+#define CYBERIA_FIDELITY_H
+
+#include <raylib.h>
+
+/* Per-actor fidelity tiers from distance to the local player and size on
+ * screen, so the work spent on an AOI actor follows how much of it shows.
+ *
+ *   FIDELITY_NEAR   everything, every frame
+ *   FIDELITY_MID    animation advanced at a throttled rate
+ *   FIDELITY_FAR    that, no overhead UI, and interpolation recomputed on
+ *                   alternate frames
+ *
+ * The radii are the lodFocusCells / lodDetailCells hints times a scale fed
+ * back from frame time the way dynamic_resolution.h steps the world pass:
+ * the smoothed interval steps down one entry of FIDELITY_SCALE_STEPS while
+ * it stays above FIDELITY_LOWER_MS and back up while under
+ * FIDELITY_RAISE_MS, with a hold after each step. Actors drawn shorter
+ * than FIDELITY_FAR_PX are far wherever they stand. The local player is
+ * always near; callers do not ask for it. */
+
+#define FIDELITY_SCALE_STEPS         { 1.0f, 0.75f, 0.5f, 0.35f }
+#define FIDELITY_LOWER_MS            20.0f
+#define FIDELITY_RAISE_MS            17.0f
+#define FIDELITY_LOWER_HOLD_SECONDS  0.5
+#define FIDELITY_RAISE_HOLD_SECONDS  3.0
+#define FIDELITY_SPIKE_MS            250.0f
+#define FIDELITY_FAR_PX              10.0f
+
+typedef enum {
+    FIDELITY_NEAR,
+    FIDELITY_MID,
+    FIDELITY_FAR,
+} FidelityTier;
+
+/* Once per frame, with the same interval dynamic_resolution_on_frame gets. */
+void  fidelity_on_frame(float frame_ms);
+
+/* Tier of an actor at `pos` (top-left, cells) sized `dims` (cells). */
+FidelityTier fidelity_tier(Vector2 pos, Vector2 dims);
+
+/* Current radius scale, 1 with no frame-time pressure. */
+float fidelity_scale(void);
+
+#endif /* CYBERIA_FIDELITY_H */
@@ -0,0 +1,483 @@
+#include "floor_cache.h"
+
+#include "domain/presentation_runtime.h"
+#include "hash_table.h"
+#include "map_arena.h"
+#include "object_layers_management.h"
+#include "render_queue.h"
+#include "spatial_grid.h"
+#include "render_stats.h"
+
+#include <assert.h>
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+typedef struct {
+    bool            used;       /* rt is loaded */
+    bool            baked;      /* rt holds chunk (cx, cy) as of `signature` */
+    int             cx;
+    int             cy;
+    hash_t          signature;  /* of the floors (and their static bits) baked */
+    uint32_t        last_seen;  /* frame the chunk was last in view */
+    RenderTexture2D rt;
+} FloorChunk;
+
+/* Adjacent floor tiles sharing one static layer stack, drawn as a block:
+ * one layer resolve for the whole block, then one quad per tile and layer
+ * from the resolved atlas frames. */
+typedef struct {
+    int   floor;        /* the top-left tile; its stack stands for the rest */
+    float x;            /* grid cells */
+    float y;
+    float tile_w;
+    float tile_h;
+    int   cols;
+    int   rows;
+} FloorRun;
+
+static struct {
+    FloorChunk chunks[FLOOR_CACHE_MAX_CHUNKS];
+    float      cell_size;
+    int        chunk_cells;     /* grid cells per chunk edge */
+    uint32_t   world_revision;
+    unsigned   atlas_generation;
+    uint32_t   palette_revision;   /* presentation_runtime_palette_revision() */
+    uint32_t   frame;
+    /* Chunks in view this frame and the slot baked for each (-1: none). */
+    int        view_cx;
+    int        view_cy;
+    int        view_cols;
+    int        view_rows;
+    int        view_slot[FLOOR_CACHE_MAX_CHUNKS];
+    bool       live[MAX_OBJECTS];   /* floor left out of bakes: drawn per tile */
+    /* Runs of the current world and atlas generation; off under dev UI,
+     * which draws every tile for its debug box. */
+    bool       runs_on;
+    int        run_count;
+    int        run_of[MAX_OBJECTS];    /* floor → its run, -1: drawn alone */
+    FloorRun   runs[MAX_OBJECTS / 2];
+    int*       cell_floor;             /* grid cell → floor whose top-left it is; map arena */
+    size_t     cell_cap;
+} g_floor_cache;
+
+static int s_hits[SPATIAL_GRID_MAX_ITEMS];
+
+void floor_cache_draw_tile(EntityRender* render, WorldObject* floor,
+                           float cell_size, bool dev_ui) {
+    if (floor->object_layer_count > 0) {
+        ObjectLayerState* layers[MAX_OBJECT_LAYERS];
+        for (int j = 0; j < floor->object_layer_count; j++) {
+            layers[j] = &floor->object_layers[j];
+        }
+
+        draw_entity_layers(
+            render,
+            floor->handle,
+            floor->pos.x,
+            floor->pos.y,
+            floor->dims.x,
+            floor->dims.y,
+            DIRECTION_NONE,
+            MODE_IDLE,
+            layers,
+            floor->object_layer_count,
+            floor->layers_version,
+            "floor",
+            dev_ui,
+            cell_size,
+            presentation_runtime_palette_slot(PALETTE_FLOOR)
+        );
+    } else {
+        Rectangle rect = {
+            floor->pos.x * cell_size,
+            floor->pos.y * cell_size,
+            floor->dims.x * cell_size,
+            floor->dims.y * cell_size
+        };
+        Color color = presentation_runtime_palette_slot(PALETTE_FLOOR_BACKGROUND);
+        if (render_queue_is_open()) {
+            render_queue_push_rect(rect, color, 0);
+        } else {
+            DrawRectangleRec(rect, color);
+        }
+    }
+}
+
+static hash_t mix(hash_t h, const void* p, size_t n) {
+    const unsigned char* b = p;
+    for (size_t i = 0; i < n; i++) { h = ((h << 5) + h) + b[i]; }
+    return h;
+}
+
+/* Floors overlapping chunk (cx, cy) into s_hits; refreshes their live bits
+ * and returns the signature of what a bake would draw. */
+static hash_t chunk_survey(int cx, int cy, int* out_count) {
+    float cc = (float)g_floor_cache.chunk_cells;
+    Rectangle r = { cx * cc, cy * cc, cc, cc };
+    int n = spatial_grid_query_rect(&g_game_state.floor_grid, r, s_hits, SPATIAL_GRID_MAX_ITEMS);
+
+    hash_t h = 5381;
+    for (int k = 0; k < n; k++) {
+        WorldObject* floor = &g_game_state.floors[s_hits[k]];
+        ObjectLayerState* layers[MAX_OBJECT_LAYERS];
+        for (int j = 0; j < floor->object_layer_count; j++) {
+            layers[j] = &floor->object_layers[j];
+        }
+        bool live = !entity_layers_are_static(layers, floor->object_layer_count,
+                                              DIRECTION_NONE, MODE_IDLE);
+        g_floor_cache.live[s_hits[k]] = live;
+
+        h = mix(h, &live, sizeof(live));
+        h = mix(h, &floor->pos, sizeof(floor->pos));
+        h = mix(h, &floor->dims, sizeof(floor->dims));
+        for (int j = 0; j < floor->object_layer_count; j++) {
+            h = mix(h, &floor->object_layers[j].active, sizeof(bool));
+            h = ((h << 5) + h) + hash_string(floor->object_layers[j].item_id);
+        }
+    }
+    *out_count = n;
+    return h;
+}
+
+static bool floor_is_static(WorldObject* floor) {
+    ObjectLayerState* layers[MAX_OBJECT_LAYERS];
+    for (int j = 0; j < floor->object_layer_count; j++) {
+        layers[j] = &floor->object_layers[j];
+    }
+    return entity_layers_are_static(layers, floor->object_layer_count, DIRECTION_NONE, MODE_IDLE);
+}
+
+static bool same_stack(const WorldObject* a, const WorldObject* b) {
+    if (a->dims.x != b->dims.x || a->dims.y != b->dims.y ||
+        a->object_layer_count != b->object_layer_count) {
+        return false;
+    }
+    for (int j = 0; j < a->object_layer_count; j++) {
+        const ObjectLayerState* la = &a->object_layers[j];
+        const ObjectLayerState* lb = &b->object_layers[j];
+        if (la->active != lb->active || 0 != strcmp(la->item_id, lb->item_id)) return false;
+    }
+    return true;
+}
+
+/* Floor topping cell (x, y) if it has the stack of `like` and is in no run
+ * yet, else -1. */
+static int run_candidate(int x, int y, const WorldObject* like) {
+    const GameState* gs = &g_game_state;
+    if (x >= gs->grid_w || y >= gs->grid_h) return -1;
+    int i = g_floor_cache.cell_floor[(size_t)y * gs->grid_w + x];
+    if (0 > i || 0 <= g_floor_cache.run_of[i] || !same_stack(&gs->floors[i], like)) return -1;
+    return i;
+}
+
+/* Greedy merge, row-major from the top-left: each unclaimed static tile
+ * grows right while the next tile has its stack, then down while every
+ * tile of the next row does. Tiles off the integer grid or animated stay
+ * single. */
+/* Map change: the cell grid went back with the map arena. */
+static void cells_forget(void) {
+    g_floor_cache.cell_floor = NULL;
+    g_floor_cache.cell_cap   = 0;
+}
+
+static void runs_rebuild(void) {
+    GameState* gs = &g_game_state;
+    g_floor_cache.run_count = 0;
+    for (int i = 0; i < gs->floor_count; i++) g_floor_cache.run_of[i] = -1;
+
+    size_t cells = (size_t)gs->grid_w * (size_t)gs->grid_h;
+    if (0 == cells) return;
+    if (cells > g_floor_cache.cell_cap) {
+        map_arena_on_reset(cells_forget);
+        g_floor_cache.cell_floor = map_alloc(cells * sizeof(int));
+        g_floor_cache.cell_cap   = cells;
+    }
+    for (size_t c = 0; c < cells; c++) g_floor_cache.cell_floor[c] = -1;
+    for (int i = 0; i < gs->floor_count; i++) {
+        WorldObject* f = &gs->floors[i];
+        int x = (int)f->pos.x, y = (int)f->pos.y;
+        if ((float)x != f->pos.x || (float)y != f->pos.y || 0 > x || 0 > y ||
+            x >= gs->grid_w || y >= gs->grid_h || 1.0f > f->dims.x || 1.0f > f->dims.y ||
+            (float)(int)f->dims.x != f->dims.x || (float)(int)f->dims.y != f->dims.y ||
+            !floor_is_static(f)) {
+            continue;
+        }
+        g_floor_cache.cell_floor[(size_t)y * gs->grid_w + x] = i;
+    }
+
+    for (int y = 0; y < gs->grid_h; y++) {
+        for (int x = 0; x < gs->grid_w; x++) {
+            int first = g_floor_cache.cell_floor[(size_t)y * gs->grid_w + x];
+            if (0 > first || 0 <= g_floor_cache.run_of[first]) continue;
+            const WorldObject* like = &gs->floors[first];
+            int tw = (int)like->dims.x, th = (int)like->dims.y;
+
+            int cols = 1;
+            while (0 <= run_candidate(x + cols * tw, y, like)) cols++;
+            int rows = 1;
+            for (bool whole = true; whole; ) {
+                for (int c = 0; c < cols && whole; c++) {
+                    whole = 0 <= run_candidate(x + c * tw, y + rows * th, like);
+                }
+                if (whole) rows++;
+            }
+            if (2 > cols * rows || (int)(sizeof(g_floor_cache.runs) / sizeof(g_floor_cache.runs[0])) <=
+                                   g_floor_cache.run_count) {
+                continue;
+            }
+
+            int r = g_floor_cache.run_count++;
+            g_floor_cache.runs[r] = (FloorRun){
+                .floor = first, .x = (float)x, .y = (float)y,
+                .tile_w = (float)tw, .tile_h = (float)th, .cols = cols, .rows = rows,
+            };
+            for (int ry = 0; ry < rows; ry++) {
+                for (int rx = 0; rx < cols; rx++) {
+                    int i = g_floor_cache.cell_floor[(size_t)(y + ry * th) * gs->grid_w + x + rx * tw];
+                    g_floor_cache.run_of[i] = r;
+                }
+            }
+        }
+    }
+}
+
+/* True when every chunk under `r` (grid cells) is baked this frame. */
+static bool rect_baked(Rectangle r) {
+    if (0 == g_floor_cache.view_cols) return false;
+    float cc = (float)g_floor_cache.chunk_cells;
+    int cx0 = (int)floorf(r.x / cc) - g_floor_cache.view_cx;
+    int cy0 = (int)floorf(r.y / cc) - g_floor_cache.view_cy;
+    int cx1 = (int)floorf((r.x + r.width) / cc) - g_floor_cache.view_cx;
+    int cy1 = (int)floorf((r.y + r.height) / cc) - g_floor_cache.view_cy;
+    if (cx0 < 0 || cy0 < 0 || cx1 >= g_floor_cache.view_cols || cy1 >= g_floor_cache.view_rows) {
+        return false;
+    }
+    for (int y = cy0; y <= cy1; y++) {
+        for (int x = cx0; x <= cx1; x++) {
+            if (g_floor_cache.view_slot[y * g_floor_cache.view_cols + x] < 0) return false;
+        }
+    }
+    return true;
+}
+
+/* The tiles of `run` overlapping `clip` (grid cells), skipping those already
+ * in a baked chunk when `skip_baked`. Pushes into the open render queue. */
+static void run_draw(EntityRender* render, const FloorRun* run, Rectangle clip, bool skip_baked) {
+    assert(render_queue_is_open());
+    int c0 = (int)floorf((clip.x - run->x) / run->tile_w);
+    int c1 = (int)floorf((clip.x + clip.width - run->x) / run->tile_w);
+    int r0 = (int)floorf((clip.y - run->y) / run->tile_h);
+    int r1 = (int)floorf((clip.y + clip.height - run->y) / run->tile_h);
+    if (c0 < 0) c0 = 0;
+    if (r0 < 0) r0 = 0;
+    if (c1 >= run->cols) c1 = run->cols - 1;
+    if (r1 >= run->rows) r1 = run->rows - 1;
+    if (c0 > c1 || r0 > r1) return;
+
+    WorldObject* floor = &g_game_state.floors[run->floor];
+    ObjectLayerState* layers[MAX_OBJECT_LAYERS];
+    for (int j = 0; j < floor->object_layer_count; j++) {
+        layers[j] = &floor->object_layers[j];
+    }
+    Texture2D textures[MAX_OBJECT_LAYERS];
+    Rectangle srcs[MAX_OBJECT_LAYERS];
+    int n = entity_layers_static_frames(render, floor->handle, layers, floor->object_layer_count,
+                                        floor->layers_version, textures, srcs);
+    Color fill = presentation_runtime_palette_slot(0 < floor->object_layer_count
+                                                   ? PALETTE_FLOOR : PALETTE_FLOOR_BACKGROUND);
+
+    float cs = g_floor_cache.cell_size;
+    for (int ry = r0; ry <= r1; ry++) {
+        for (int rx = c0; rx <= c1; rx++) {
+            Rectangle tile = { run->x + rx * run->tile_w, run->y + ry * run->tile_h,
+                               run->tile_w, run->tile_h };
+            if (skip_baked && rect_baked(tile)) continue;
+            Rectangle dst = { tile.x * cs, tile.y * cs, tile.width * cs, tile.height * cs };
+            if (0 == n) render_queue_push_rect(dst, fill, 0);
+            for (int j = 0; j < n; j++) render_queue_push(textures[j], srcs[j], dst, WHITE, j);
+        }
+    }
+}
+
+static void chunk_bake(FloorChunk* c, EntityRender* render) {
+    int n = 0;
+    c->signature = chunk_survey(c->cx, c->cy, &n);
+    c->baked     = true;
+
+    float px = g_floor_cache.chunk_cells * g_floor_cache.cell_size;
+    BeginTextureMode(c->rt);
+    ClearBackground(BLANK);
+    BeginMode2D((Camera2D){ .target = { c->cx * px, c->cy * px }, .zoom = 1.0f });
+    render_queue_begin();
+    for (int k = 0; k < n; k++) {
+        int i = s_hits[k];
+        if (g_floor_cache.live[i]) continue;
+        if (0 > g_floor_cache.run_of[i]) {
+            floor_cache_draw_tile(render, &g_game_state.floors[i], g_floor_cache.cell_size, false);
+        }
+    }
+    float cc = (float)g_floor_cache.chunk_cells;
+    Rectangle area = { c->cx * cc, c->cy * cc, cc, cc };
+    for (int r = 0; r < g_floor_cache.run_count; r++) {
+        run_draw(render, &g_floor_cache.runs[r], area, false);
+    }
+    render_queue_end();
+    EndMode2D();
+    EndTextureMode();
+}
+
+static int chunk_find(int cx, int cy) {
+    for (int i = 0; i < FLOOR_CACHE_MAX_CHUNKS; i++) {
+        const FloorChunk* c = &g_floor_cache.chunks[i];
+        if (c->used && c->cx == cx && c->cy == cy) return i;
+    }
+    return -1;
+}
+
+/* A free slot, else the one out of view the longest. */
+static int chunk_claim(int cx, int cy) {
+    int best = -1;
+    for (int i = 0; i < FLOOR_CACHE_MAX_CHUNKS; i++) {
+        const FloorChunk* c = &g_floor_cache.chunks[i];
+        if (!c->used) { best = i; break; }
+        if (c->last_seen == g_floor_cache.frame) continue;
+        if (best < 0 || c->last_seen < g_floor_cache.chunks[best].last_seen) best = i;
+    }
+    if (best < 0) return -1;
+
+    FloorChunk* c = &g_floor_cache.chunks[best];
+    if (!c->used) {
+        int px = (int)ceilf(g_floor_cache.chunk_cells * g_floor_cache.cell_size);
+        c->rt   = LoadRenderTexture(px, px);
+        c->used = true;
+    }
+    c->cx        = cx;
+    c->cy        = cy;
+    c->baked     = false;
+    c->last_seen = g_floor_cache.frame;
+    return best;
+}
+
+void floor_cache_prepare(EntityRender* render, Rectangle view) {
+    assert(render);
+    const GameState* gs = &g_game_state;
+    g_floor_cache.frame++;
+    g_floor_cache.view_cols = 0;
+    g_floor_cache.view_rows = 0;
+    if (presentation_runtime_dev_ui() || 0 == gs->floor_count) {
+        g_floor_cache.runs_on = false;
+        return;
+    }
+
+    float cell_size = gs->cell_size > 0 ? gs->cell_size : 12.0f;
+    if (cell_size != g_floor_cache.cell_size) {
+        floor_cache_release();
+        g_floor_cache.cell_size   = cell_size;
+        g_floor_cache.chunk_cells = (int)(FLOOR_CHUNK_PX / cell_size);
+        if (g_floor_cache.chunk_cells < 1) g_floor_cache.chunk_cells = 1;
+    }
+
+    /* Hot-reloaded colours: every bake may hold the old FLOOR_BACKGROUND
+     * fill. The chunk textures are kept and re-baked in place. */
+    uint32_t palette = presentation_runtime_palette_revision();
+    if (palette != g_floor_cache.palette_revision) {
+        g_floor_cache.palette_revision = palette;
+        for (int i = 0; i < FLOOR_CACHE_MAX_CHUNKS; i++) g_floor_cache.chunks[i].baked = false;
+    }
+
+    /* World rebuilt or a texture landed: drop the bakes whose floors no
+     * longer match. Live bits are rebuilt by the surveys. */
+    unsigned generation = obj_layers_mgr_atlas_generation();
+    if (gs->world_revision != g_floor_cache.world_revision ||
+        generation != g_floor_cache.atlas_generation || !g_floor_cache.runs_on) {
+        g_floor_cache.world_revision   = gs->world_revision;
+        g_floor_cache.atlas_generation = generation;
+        memset(g_floor_cache.live, 0, sizeof(g_floor_cache.live));
+        runs_rebuild();
+        g_floor_cache.runs_on = true;
+        for (int i = 0; i < FLOOR_CACHE_MAX_CHUNKS; i++) {
+            FloorChunk* c = &g_floor_cache.chunks[i];
+            int n = 0;
+            if (c->baked && chunk_survey(c->cx, c->cy, &n) != c->signature) c->baked = false;
+        }
+    }
+
+    float cc = (float)g_floor_cache.chunk_cells;
+    int last_cx = (gs->grid_w - 1) / g_floor_cache.chunk_cells;
+    int last_cy = (gs->grid_h - 1) / g_floor_cache.chunk_cells;
+    int cx0 = (int)floorf(view.x / cc), cx1 = (int)floorf((view.x + view.width) / cc);
+    int cy0 = (int)floorf(view.y / cc), cy1 = (int)floorf((view.y + view.height) / cc);
+    if (cx0 < 0) cx0 = 0;
+    if (cy0 < 0) cy0 = 0;
+    if (cx1 > last_cx) cx1 = last_cx;
+    if (cy1 > last_cy) cy1 = last_cy;
+    int cols = cx1 - cx0 + 1, rows = cy1 - cy0 + 1;
+    /* Zoomed out past what the cache holds: every tile draws live. */
+    if (cols <= 0 || rows <= 0 || cols * rows > FLOOR_CACHE_MAX_CHUNKS) return;
+
+    g_floor_cache.view_cx   = cx0;
+    g_floor_cache.view_cy   = cy0;
+    g_floor_cache.view_cols = cols;
+    g_floor_cache.view_rows = rows;
+
+    /* Stamp what is already held before claiming, so no in-view chunk is
+     * recycled for another. */
+    for (int k = 0; k < cols * rows; k++) {
+        int slot = chunk_find(cx0 + k % cols, cy0 + k / cols);
+        if (slot >= 0) g_floor_cache.chunks[slot].last_seen = g_floor_cache.frame;
+        g_floor_cache.view_slot[k] = slot;
+    }
+
+    int bakes = 0;
+    for (int k = 0; k < cols * rows; k++) {
+        int slot = g_floor_cache.view_slot[k];
+        if ((slot < 0 || !g_floor_cache.chunks[slot].baked) && bakes < FLOOR_BAKES_PER_FRAME) {
+            if (slot < 0) slot = chunk_claim(cx0 + k % cols, cy0 + k / cols);
+            if (slot >= 0) {
+                chunk_bake(&g_floor_cache.chunks[slot], render);
+                bakes++;
+            }
+        }
+        g_floor_cache.view_slot[k] = (slot >= 0 && g_floor_cache.chunks[slot].baked) ? slot : -1;
+    }
+}
+
+void floor_cache_draw(void) {
+    float px = g_floor_cache.chunk_cells * g_floor_cache.cell_size;
+    for (int k = 0; k < g_floor_cache.view_cols * g_floor_cache.view_rows; k++) {
+        if (g_floor_cache.view_slot[k] < 0) continue;
+        const FloorChunk* c = &g_floor_cache.chunks[g_floor_cache.view_slot[k]];
+        Texture2D tex = c->rt.texture;
+        /* Render textures are stored bottom-up. */
+        DrawTextureRec(tex, (Rectangle){ 0, 0, (float)tex.width, -(float)tex.height },
+                       (Vector2){ c->cx * px, c->cy * px }, WHITE);
+    }
+}
+
+void floor_cache_draw_runs(EntityRender* render, Rectangle view) {
+    assert(render);
+    if (!g_floor_cache.runs_on) return;
+    for (int r = 0; r < g_floor_cache.run_count; r++) {
+        const FloorRun* run = &g_floor_cache.runs[r];
+        Rectangle bounds = { run->x, run->y, run->cols * run->tile_w, run->rows * run->tile_h };
+        if (CheckCollisionRecs(bounds, view)) run_draw(render, run, view, true);
+    }
+}
+
+bool floor_cache_covers(int floor_index) {
+    assert(0 <= floor_index && MAX_OBJECTS > floor_index);
+    if (g_floor_cache.runs_on && 0 <= g_floor_cache.run_of[floor_index]) return true;
+    if (g_floor_cache.live[floor_index]) return false;
+    const WorldObject* floor = &g_game_state.floors[floor_index];
+    return rect_baked((Rectangle){ floor->pos.x, floor->pos.y, floor->dims.x, floor->dims.y });
+}
+
+void floor_cache_release(void) {
+    for (int i = 0; i < FLOOR_CACHE_MAX_CHUNKS; i++) {
+        if (g_floor_cache.chunks[i].used) UnloadRenderTexture(g_floor_cache.chunks[i].rt);
+    }
+    memset(g_floor_cache.chunks, 0, sizeof(g_floor_cache.chunks));
+    g_floor_cache.view_cols = 0;
+    g_floor_cache.view_rows = 0;
+}
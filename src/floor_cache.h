@@ -0,0 +1,66 @@
+#ifndef FLOOR_CACHE_H
+#define FLOOR_CACHE_H
+
+#include <raylib.h>
+#include <stdbool.h>
+
+#include "entity_render.h"
+#include "game_state.h"
+
+/* Floor tiles baked into cached render-texture chunks.
+ *
+ * The map is cut into square chunks of about FLOOR_CHUNK_PX pixels. Each
+ * chunk in view is baked once into a RenderTexture2D from the floors that
+ * overlap it, then drawn as one quad per frame instead of one
+ * draw_entity_layers call per tile. Only static tiles go into a bake
+ * (entity_layers_are_static); animated or still-loading tiles stay live and
+ * are drawn per tile on top.
+ *
+ * A chunk re-bakes when the floors under it change (checked whenever the
+ * world arrays are rebuilt, GameState.world_revision) or when a new atlas
+ * texture lands and a tile may have turned static. Every chunk re-bakes
+ * when hot-reloaded hints change the palette, and a new cell size drops
+ * them all. Chunks are LRU-recycled once more than FLOOR_CACHE_MAX_CHUNKS
+ * have been in view; dev UI bypasses the cache so the per-tile debug boxes
+ * keep drawing.
+ *
+ * With the same revalidation, adjacent static tiles sharing a layer stack
+ * (same items, same size, on the integer grid) are greedily merged into
+ * rectangular runs. A run resolves its stack once and pushes one quad per
+ * tile and layer from the resolved atlas frames, instead of a
+ * draw_entity_layers call per tile. Atlas frames are sub-rects of a shared
+ * page, so a run cannot be one wrapped quad. Runs feed the bakes and draw
+ * whatever no baked chunk covers, which is everything once zoomed out past
+ * the cache. */
+
+#define FLOOR_CHUNK_PX         512
+#define FLOOR_CACHE_MAX_CHUNKS 32
+/* Bakes per frame, so a freshly loaded view fills in over a few frames
+ * instead of hitching one. */
+#define FLOOR_BAKES_PER_FRAME  2
+
+/* Revalidate and bake the chunks overlapping `view` (grid cells). Must run
+ * outside BeginMode2D — baking switches the render target. */
+void floor_cache_prepare(EntityRender* render, Rectangle view);
+
+/* Draw the baked chunks in view. Call inside the world camera, before the
+ * live tiles. */
+void floor_cache_draw(void);
+
+/* Draw the tiles of the runs in `view` (grid cells) that no baked chunk
+ * covers. Call inside the world camera with the render queue open. */
+void floor_cache_draw_runs(EntityRender* render, Rectangle view);
+
+/* True when floors[floor_index] is fully covered by baked chunks this frame
+ * or belongs to a run, i.e. the per-tile draw can be skipped. */
+bool floor_cache_covers(int floor_index);
+
+/* Draw one floor tile as the world pass does: its object layers, or the
+ * FLOOR_BACKGROUND fill when it has none. */
+void floor_cache_draw_tile(EntityRender* render, WorldObject* floor,
+                           float cell_size, bool dev_ui);
+
+/* Unload every chunk texture. */
+void floor_cache_release(void);
+
+#endif /* FLOOR_CACHE_H */
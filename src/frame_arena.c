@@ -0,0 +1,96 @@
+#include "frame_arena.h"
+
+#include "heap_memory.h"
+
+#include <assert.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+typedef struct FrameChunk {
+    struct FrameChunk* next;
+    size_t             size;
+    size_t             used;
+    max_align_t        data[];
+} FrameChunk;
+
+static struct {
+    FrameChunk* head;
+    FrameChunk* cur;
+    size_t      used;       /* open frame */
+    size_t      reserved;
+    FrameArenaStats last;
+} g_frame_arena;
+
+void* frame_alloc(size_t size) {
+    const size_t align = _Alignof(max_align_t);
+    size = (size + align - 1) & ~(align - 1);
+
+    FrameChunk* c = g_frame_arena.cur;
+    while (c && c->used + size > c->size) c = c->next;
+    if (!c) {
+        size_t cap = (size > FRAME_ARENA_CHUNK) ? size : FRAME_ARENA_CHUNK;
+        c = heap_malloc(HEAP_MEM_FRAME_ARENA, sizeof(FrameChunk) + cap);
+        assert(c);
+        *c = (FrameChunk){ .size = cap };
+        FrameChunk** tail = &g_frame_arena.head;
+        while (*tail) tail = &(*tail)->next;
+        *tail = c;
+        g_frame_arena.reserved += cap;
+    }
+    g_frame_arena.cur = c;
+    void* p = (char*)c->data + c->used;
+    c->used += size;
+    g_frame_arena.used += size;
+    return p;
+}
+
+void* frame_calloc(size_t count, size_t size) {
+    assert(0 == size || SIZE_MAX / size >= count);
+    void* p = frame_alloc(count * size);
+    memset(p, 0, count * size);
+    return p;
+}
+
+char* frame_printf(const char* fmt, ...) {
+    va_list ap;
+    va_start(ap, fmt);
+    int n = vsnprintf(NULL, 0, fmt, ap);
+    va_end(ap);
+    assert(0 <= n);
+
+    char* s = frame_alloc((size_t)n + 1);
+    va_start(ap, fmt);
+    vsnprintf(s, (size_t)n + 1, fmt, ap);
+    va_end(ap);
+    return s;
+}
+
+void frame_arena_reset(void) {
+    g_frame_arena.last.used = g_frame_arena.used;
+    if (g_frame_arena.used > g_frame_arena.last.peak) g_frame_arena.last.peak = g_frame_arena.used;
+    g_frame_arena.used = 0;
+
+    size_t kept = 0;
+    FrameChunk** link = &g_frame_arena.head;
+    while (*link) {
+        FrameChunk* c = *link;
+        if (kept + c->size > FRAME_ARENA_KEEP) {
+            *link = c->next;
+            g_frame_arena.reserved -= c->size;
+            heap_free(c);
+            continue;
+        }
+        kept   += c->size;
+        c->used = 0;
+        link    = &c->next;
+    }
+    g_frame_arena.cur = g_frame_arena.head;
+}
+
+FrameArenaStats frame_arena_stats(void) {
+    FrameArenaStats s = g_frame_arena.last;
+    s.reserved = g_frame_arena.reserved;
+    return s;
+}
@@ -0,0 +1,42 @@
+#ifndef CYBERIA_FRAME_ARENA_H
+#define CYBERIA_FRAME_ARENA_H
+
+#include <stddef.h>
+
+/*
+ * Per-frame linear scratch for the render and UI passes.
+ *
+ * Transient arrays, formatted strings and layout results that only live
+ * until the frame is drawn bump-allocate from here instead of sitting in
+ * large stack buffers or permanently sized statics. frame_arena_reset() at
+ * the top of the loop hands everything back at once; nothing is freed
+ * individually. Chunks (HEAP_MEM_FRAME_ARENA) are kept across resets up to
+ * FRAME_ARENA_KEEP, so a steady frame mallocs nothing; a one-off spike gives
+ * the excess back on the next reset.
+ *
+ * Main thread only. Pointers die with the next reset: never keep one
+ * across frames or hand one to a job.
+ */
+
+#define FRAME_ARENA_CHUNK (256u * 1024u)
+#define FRAME_ARENA_KEEP  (1024u * 1024u)
+
+typedef struct {
+    size_t used;       /* bytes handed out in the last closed frame */
+    size_t peak;       /* high-water mark of used */
+    size_t reserved;   /* chunk bytes held */
+} FrameArenaStats;
+
+/* `size` bytes aligned for any type. Never NULL. */
+void* frame_alloc(size_t size);
+void* frame_calloc(size_t count, size_t size);
+
+/* printf into the arena. */
+char* frame_printf(const char* fmt, ...);
+
+/* Close the frame: everything allocated since the last reset is gone. */
+void frame_arena_reset(void);
+
+FrameArenaStats frame_arena_stats(void);
+
+#endif /* CYBERIA_FRAME_ARENA_H */
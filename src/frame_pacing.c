@@ -0,0 +1,94 @@
+#include "frame_pacing.h"
+
+#include "config.h"
+#include "game_state.h"
+#include "util/log.h"
+
+#include <assert.h>
+#include <emscripten/emscripten.h>
+#include <emscripten/html5.h>
+#include <raylib.h>
+
+static struct {
+    FramePacingTick hidden_tick;
+    bool            hidden;
+    long            hidden_timer;
+    int             interval;       /* animation frames per loop frame */
+    int             applied;        /* last value handed to emscripten */
+    double          active_at;      /* GetTime() of the last activity */
+    uint32_t        commit_epoch;
+    Vector2         player_pos;
+} g_pacing = {
+    .interval = MAIN_LOOP_VSYNC_INTERVAL,
+    .applied  = MAIN_LOOP_VSYNC_INTERVAL,
+};
+
+static void apply_interval(void) {
+    if (g_pacing.applied == g_pacing.interval) return;
+    g_pacing.applied = g_pacing.interval;
+    emscripten_set_main_loop_timing(EM_TIMING_RAF, g_pacing.interval);
+}
+
+static void on_hidden_timer(void* user_data) {
+    g_pacing.hidden_tick();
+}
+
+static EM_BOOL on_visibility(int event_type, const EmscriptenVisibilityChangeEvent* event,
+                             void* user_data) {
+    bool hidden = event->hidden;
+    if (hidden == g_pacing.hidden) return EM_TRUE;
+    g_pacing.hidden = hidden;
+    if (hidden) {
+        emscripten_pause_main_loop();
+        g_pacing.hidden_timer = emscripten_set_interval(on_hidden_timer, FRAME_PACING_HIDDEN_TICK_MS, NULL);
+    } else {
+        emscripten_clear_interval(g_pacing.hidden_timer);
+        g_pacing.interval  = MAIN_LOOP_VSYNC_INTERVAL;
+        g_pacing.active_at = GetTime();
+        apply_interval();
+        emscripten_resume_main_loop();
+    }
+    LOG_INFO("[pacing] document %s", hidden ? "hidden: loop paused" : "visible: loop resumed");
+    return EM_TRUE;
+}
+
+void frame_pacing_install(FramePacingTick hidden_tick) {
+    assert(hidden_tick);
+    g_pacing.hidden_tick = hidden_tick;
+    g_pacing.active_at   = GetTime();
+    emscripten_set_visibilitychange_callback(NULL, EM_FALSE, on_visibility);
+}
+
+void frame_pacing_on_frame(int input_events) {
+    double now = GetTime();
+
+    bool input = 0 < input_events
+        || IsMouseButtonDown(MOUSE_BUTTON_LEFT)
+        || 0 < GetTouchPointCount()
+        || 0.0f != GetMouseDelta().x || 0.0f != GetMouseDelta().y;
+
+    Vector2 pos = g_game_state.player.base.interp_pos;
+    bool motion = g_game_state.commit_epoch != g_pacing.commit_epoch
+        || pos.x != g_pacing.player_pos.x || pos.y != g_pacing.player_pos.y;
+    g_pacing.commit_epoch = g_game_state.commit_epoch;
+    g_pacing.player_pos   = pos;
+
+    if (input) {
+        g_pacing.interval  = MAIN_LOOP_VSYNC_INTERVAL;
+        g_pacing.active_at = now;
+    } else if (motion) {
+        if (MAIN_LOOP_VSYNC_INTERVAL < g_pacing.interval) g_pacing.interval--;
+        g_pacing.active_at = now;
+    } else if (FRAME_PACING_IDLE_SECONDS <= now - g_pacing.active_at) {
+        g_pacing.interval = FRAME_PACING_IDLE_INTERVAL;
+    }
+    apply_interval();
+}
+
+int frame_pacing_interval(void) {
+    return g_pacing.interval;
+}
+
+bool frame_pacing_hidden(void) {
+    return g_pacing.hidden;
+}
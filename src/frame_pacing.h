@@ -0,0 +1,35 @@
+#ifndef CYBERIA_FRAME_PACING_H
+#define CYBERIA_FRAME_PACING_H
+
+#include <stdbool.h>
+
+/* Main loop pacing policy.
+ *
+ * The loop runs every MAIN_LOOP_VSYNC_INTERVAL-th animation frame while
+ * anything moves. Once FRAME_PACING_IDLE_SECONDS pass with no input, no
+ * pointer held or moving, no committed network delta and no local motion,
+ * it drops to every FRAME_PACING_IDLE_INTERVAL-th frame: sprites keep
+ * animating, at a lower rate. Input restores the full rate on the next
+ * frame; motion steps it back one animation frame per loop frame so the
+ * catch-up is smooth.
+ *
+ * While the document is hidden the browser stops animation frames anyway;
+ * the main loop is paused and `hidden_tick` runs on a timer instead, so the
+ * socket keeps draining, heartbeats and reconnects continue and the inbox
+ * never backs up. Becoming visible resumes the loop at the full rate. */
+
+typedef void (*FramePacingTick)(void);
+
+/* Hook visibilitychange. Call once the game loop is installed. */
+void frame_pacing_install(FramePacingTick hidden_tick);
+
+/* Once per loop frame, after input capture: `input_events` raw events
+ * were queued this frame. Applies the rate for the next frame. */
+void frame_pacing_on_frame(int input_events);
+
+/* Animation frames per loop frame currently requested. */
+int  frame_pacing_interval(void);
+
+bool frame_pacing_hidden(void);
+
+#endif /* CYBERIA_FRAME_PACING_H */
@@ -0,0 +1,72 @@
+#include "frame_tasks.h"
+
+#include "util/log.h"
+
+#include <assert.h>
+#include <emscripten/emscripten.h>
+
+typedef struct {
+    FrameTaskFn fn;
+    void*       ctx;
+} FrameTask;
+
+typedef struct {
+    FrameTask tasks[FRAME_TASKS_CAP];
+    int       head;
+    int       count;
+} FrameTaskQueue;
+
+static struct {
+    FrameTaskQueue queues[FRAME_TASK_PRIORITY_COUNT];
+    FrameTaskStats stats;
+} g_tasks;
+
+void frame_tasks_submit(FrameTaskPriority priority, FrameTaskFn fn, void* ctx) {
+    assert(0 <= priority && FRAME_TASK_PRIORITY_COUNT > priority);
+    assert(fn);
+    FrameTaskQueue* q = &g_tasks.queues[priority];
+    if (FRAME_TASKS_CAP == q->count) {
+        LOG_WARN("frame task queue %d full, running inline", (int)priority);
+        while (!fn(ctx)) {}
+        return;
+    }
+    q->tasks[(q->head + q->count) % FRAME_TASKS_CAP] = (FrameTask){ .fn = fn, .ctx = ctx };
+    q->count++;
+}
+
+/* Highest-priority queue with work, or NULL. */
+static FrameTaskQueue* next_queue(void) {
+    for (int p = 0; p < FRAME_TASK_PRIORITY_COUNT; p++) {
+        if (0 < g_tasks.queues[p].count) return &g_tasks.queues[p];
+    }
+    return NULL;
+}
+
+void frame_tasks_run(double budget_ms) {
+    double start = emscripten_get_now();
+    int slices = 0;
+    FrameTaskQueue* q;
+    while ((q = next_queue())) {
+        if (0 < slices && budget_ms <= emscripten_get_now() - start) break;
+        /* Copied out: the slice may submit to its own queue. */
+        FrameTask task = q->tasks[q->head];
+        bool done = task.fn(task.ctx);
+        slices++;
+        if (done) {
+            q->head = (q->head + 1) % FRAME_TASKS_CAP;
+            q->count--;
+        }
+    }
+
+    int pending = 0;
+    for (int p = 0; p < FRAME_TASK_PRIORITY_COUNT; p++) pending += g_tasks.queues[p].count;
+    g_tasks.stats = (FrameTaskStats){
+        .pending = pending,
+        .slices  = slices,
+        .ms      = emscripten_get_now() - start,
+    };
+}
+
+FrameTaskStats frame_tasks_stats(void) {
+    return g_tasks.stats;
+}
@@ -0,0 +1,53 @@
+#ifndef CYBERIA_FRAME_TASKS_H
+#define CYBERIA_FRAME_TASKS_H
+
+#include <stdbool.h>
+
+/* Deferred main-thread work, run in slices under a per-frame budget.
+ *
+ * Work that need not land on the frame it arrives (a bulk REST envelope,
+ * say) is submitted as a task instead of done inline. The loop calls
+ * frame_tasks_run() once per frame after rendering; it runs task slices,
+ * highest priority first and FIFO within a priority, until the budget
+ * (timed with emscripten_get_now) is spent, and carries the rest over.
+ * A task that is not finished after a slice stays at the head of its
+ * queue and resumes on the next. The first slice of a frame always runs,
+ * so a slice longer than the budget still makes progress.
+ *
+ * Priorities are strict: a LOW task waits while HIGH or NORMAL work is
+ * queued. A task submitted to a full queue runs to completion on the
+ * spot, as it would have without the scheduler. */
+
+#ifndef FRAME_TASKS_BUDGET_MS
+#define FRAME_TASKS_BUDGET_MS 2.0
+#endif
+
+#ifndef FRAME_TASKS_CAP
+#define FRAME_TASKS_CAP 64   /* queued tasks per priority */
+#endif
+
+typedef enum {
+    FRAME_TASK_HIGH,
+    FRAME_TASK_NORMAL,
+    FRAME_TASK_LOW,
+    FRAME_TASK_PRIORITY_COUNT
+} FrameTaskPriority;
+
+/* One slice of the task's work: true once it is finished (and has freed
+ * whatever `ctx` holds), false to be called again. */
+typedef bool (*FrameTaskFn)(void* ctx);
+
+typedef struct {
+    int    pending;   /* tasks queued after the last run */
+    int    slices;    /* slices the last run took */
+    double ms;        /* time the last run took */
+} FrameTaskStats;
+
+void frame_tasks_submit(FrameTaskPriority priority, FrameTaskFn fn, void* ctx);
+
+/* Run slices for up to `budget_ms`. Once per frame. */
+void frame_tasks_run(double budget_ms);
+
+FrameTaskStats frame_tasks_stats(void);
+
+#endif /* CYBERIA_FRAME_TASKS_H */
@@ -1,4 +1,5 @@
 #include "game_render.h"
+#include "atlas_prefetch.h"
 #include "ui/text.h"
 #include "domain/camera.h"
 #include "domain/local_player.h"
@@ -6,15 +7,31 @@
 
 #include "dialogue_data.h"
 #include "domain/presentation_runtime.h"
+#include "dev_overlay.h"
+#include "entity_depth.h"
+#include "entity_fx.h"
+#include "entity_impostor.h"
 #include "entity_render.h"
+#include "fg_occlusion.h"
+#include "fidelity.h"
+#include "floor_cache.h"
+#include "portal_prewarm.h"
+#include "frame_arena.h"
 #include "game_state.h"
+#include "id_intern.h"
+#include "map_arena.h"
+#include "spatial_grid.h"
+#include "sprite_instancing.h"
 #include "ui/toolbar.h"
 #include "object_layers_management.h"
+#include "profiler.h"
+#include "render_queue.h"
+#include "render_stats.h"
 #include "ol_as_animated_ico.h"
 #include "ui/dev_ui.h"
 #include "ui/entity_overhead_ui.h"
 #include "ui/floating_combat_text.h"
-#include "ui/fx_shapes.h"
+#include "ui/fx_particles.h"
 #include "ui/interaction_bubble.h"
 #include "ui/inventory_bar.h"
 #include "ui/loot_fx.h"
@@ -24,14 +41,22 @@
 #include "ui/modal_instance_map.h"
 #include "ui/modal_interact.h"
 #include "ui/modal_map.h"
+#include "ui/meta_prefetch.h"
 #include "ui/nameplate.h"
+#include "ui/icon_atlas.h"
+#include "ui/overhead_labels.h"
 #include "ui/quest_journal.h"
 #include "ui/modal_notification.h"
 #include "ui/fx_tap.h"
+#include "ui/ui_hit.h"
 #include "ui/ui_icon.h"
+#include "ui/ui_skin.h"
 #include "util/log.h"
+#include "util/vec_kernels.h"
+#include "world_target.h"
 
 #include <assert.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -78,8 +103,14 @@ GameRenderer g_renderer = {0};
 // ObjectLayersManager is owned by its module — access via obj_layers_mgr_get().
 static EntityRender* g_entity_render = NULL;
 
-static void on_entity_removed(const char* id) {
-    if (g_entity_render) { entity_render_forget_entity(g_entity_render, id); }
+static void on_entity_event(const GameStateEntityEvent* ev) {
+    if (GAME_STATE_ENTITY_LEAVE != ev->type) return;
+    if (g_entity_render) { entity_render_forget_entity(g_entity_render, ev->id); }
+}
+
+/* Map change: only the self player carries over. */
+static void on_map_change(void) {
+    if (g_entity_render) { entity_render_forget_all_but(g_entity_render, g_game_state.player_id); }
 }
 
 int game_render_init(int screen_width, int screen_height) {
@@ -116,13 +147,15 @@ int game_render_init(int screen_width, int screen_height) {
         game_render_cleanup();
         return -1;
     }
-    game_state_set_entity_removed_cb(on_entity_removed);
+    game_state_add_entity_listener(on_entity_event);
+    map_arena_on_reset(on_map_change);
 
     inventory_bar_init(olm);
     inventory_modal_init(olm);
     modal_dialogue_init();
     modal_interact_init();
     dialogue_data_init();
+    meta_prefetch_init();
     interaction_bubble_init();
     quest_journal_init();
     modal_notification_init();
@@ -148,8 +181,11 @@ void game_render_frame(void) {
         g_game_state.pending_error[0] = '\0';
     }
 
-    // Atlas textures are loaded on-demand via get_atlas_texture() during rendering.
-    // No pre-caching queue processing is needed.
+    // Atlas textures are loaded on-demand during rendering; each atlas
+    // remembers where its texture lives and touches it once per frame.
+    obj_layers_mgr_begin_frame(camera_zoom() * g_game_state.cell_size / world_target_upscale());
+    atlas_prefetch_update();
+    portal_prewarm_update();
 
     // CRITICAL: Wrap entire rendering in try-catch style error handling
     // This prevents partial rendering that can cause black screens
@@ -157,22 +193,38 @@ void game_render_frame(void) {
     BeginDrawing();
 
     // Clear background - this ensures we always have SOME color on screen
-    ClearBackground(presentation_runtime_palette("BACKGROUND"));
+    ClearBackground(presentation_runtime_palette_slot(PALETTE_BACKGROUND));
 
     // Begin camera mode for world rendering
     // CRITICAL: Always update camera offset before BeginMode2D to prevent flickering
     // This ensures the camera is properly centered even if screen dimensions changed
     camera_resize(g_renderer.screen_width, g_renderer.screen_height);
 
-    BeginMode2D(camera_get());
+    // Bake any floor chunks that came into view, the overhead labels and UI
+    // icons missed last frame and the combat text digit strip (all swap
+    // render targets, so they run outside the world camera)
+    render_queue_begin_frame();
+    floor_cache_prepare(g_entity_render, game_render_get_camera_bounds());
+    overhead_labels_prepare();
+    icon_atlas_prepare();
+    entity_impostor_prepare();
+    fct_prepare();
+
+    const float cell_size = g_game_state.cell_size > 0 ? g_game_state.cell_size : 12.0f;
+    world_target_begin(camera_get(), g_renderer.screen_width, g_renderer.screen_height, cell_size,
+                       presentation_runtime_palette_slot(PALETTE_BACKGROUND));
+        render_stats_pass_begin(RENDER_PASS_WORLD);
         game_render_world();
-    EndMode2D();
+        render_stats_pass_end();
+    world_target_end();
 
     // FCT screen-space overlay: damage red flash / regen green pulse
     fct_draw_overlay();
 
     // Render UI (screen space)
+    render_stats_pass_begin(RENDER_PASS_UI);
     game_render_ui();
+    render_stats_pass_end();
 
     // Tap effects are rendered in screen space so input systems can spawn
     // them directly from screen coordinates without camera conversions.
@@ -189,6 +241,7 @@ void game_render_frame(void) {
 
     // CRITICAL: Always call EndDrawing() even if errors occurred above
     EndDrawing();
+    render_stats_frame_end();
 }
 
 /* Draw the on-grid quantity counter centered above a drop token. Discreet
@@ -203,12 +256,7 @@ static void draw_drop_count(float top_x, float top_y, float dims_w, float cell_s
     int nx = (int)((top_x + dims_w * 0.5f) * cell_size) - tw / 2;
     int ny = (int)(top_y * cell_size) - fs - 3;
 
-    for (int o = 1; o <= 2; o++)
-        for (int dy = -1; dy <= 1; dy++)
-            for (int dx = -1; dx <= 1; dx++)
-                if (dx || dy)
-                    DrawText(buf, nx + dx * o, ny + dy * o, fs, (Color){ 0, 0, 0, 255 });
-    DrawText(buf, nx, ny, fs, (Color){ 255, 255, 255, 245 });
+    text_draw_outlined(buf, nx, ny, fs, (Color){ 255, 255, 255, 245 }, (Color){ 0, 0, 0, 255 }, 2);
 }
 
 /* Draw the loot collection stage: the treasure-burst / ambient sparks at each
@@ -221,14 +269,7 @@ static void game_render_loot_fx(void) {
     const float cell_size = g_game_state.cell_size > 0 ? g_game_state.cell_size : 12.0f;
 
     /* Bordered-square particles (ambient float + collection burst). */
-    int pslots = loot_fx_particle_slot_count();
-    for (int i = 0; i < pslots; i++) {
-        LootFxParticle pt;
-        if (!loot_fx_particle_at(i, &pt)) continue;
-        Color body = (LOOT_FX_TINT_GRAY == pt.tint) ? FX_SPARK_GRAY : FX_SPARK_GOLD;
-        fx_shape_spark(pt.x * cell_size, pt.y * cell_size,
-                       pt.size * cell_size, body, 1.0f);
-    }
+    fx_particles_draw(FX_SPACE_WORLD, cell_size);
 
     /* Vacuum flight tokens. */
     int slots = loot_fx_slot_count();
@@ -244,7 +285,7 @@ static void game_render_loot_fx(void) {
 
         draw_entity_layers(
             g_entity_render,
-            fx.item_id,            /* per-item animation key */
+            id_intern(fx.item_id), /* per-item animation key */
             fx.x - half,
             fx.y - half,
             fx.size,
@@ -253,6 +294,7 @@ static void game_render_loot_fx(void) {
             MODE_IDLE,
             layers,
             1,
+            0,                     /* one fixed item per loot key */
             "loot",
             false,
             cell_size,
@@ -261,87 +303,109 @@ static void game_render_loot_fx(void) {
     }
 }
 
+/* Culling stage: game_render_world() takes the camera bounds once per frame
+ * (padded so sprites and overhead UI drawn past their footprint never clip
+ * at the screen edge), and every object pass feeds draw_entity_layers only
+ * the grid hits inside them. */
+#define CULL_MARGIN_CELLS 4.0f
+
+static struct {
+    Rectangle           view;       /* grid cells */
+    GameRenderCullStats stats;
+} s_cull;
+
+/* Indices of the visible slots, ascending; shared by the passes below,
+ * each of which consumes it before the next query. */
+static int s_visible[SPATIAL_GRID_MAX_ITEMS];
+
+static void cull_begin_frame(void) {
+    Rectangle b = game_render_get_camera_bounds();
+    s_cull.view = (Rectangle){
+        .x      = b.x - CULL_MARGIN_CELLS,
+        .y      = b.y - CULL_MARGIN_CELLS,
+        .width  = b.width + 2.0f * CULL_MARGIN_CELLS,
+        .height = b.height + 2.0f * CULL_MARGIN_CELLS,
+    };
+    s_cull.stats = (GameRenderCullStats){ 0 };
+    float cell_size = g_game_state.cell_size > 0 ? g_game_state.cell_size : 12.0f;
+    dev_overlay_begin(b, cell_size);
+}
+
+/* Visible slots of one object array into s_visible; tallies the frame stats. */
+static int cull_query(const SpatialGrid* grid, int total) {
+    int visible = spatial_grid_query_rect(grid, s_cull.view, s_visible, SPATIAL_GRID_MAX_ITEMS);
+    s_cull.stats.drawn  += visible;
+    s_cull.stats.culled += total - visible;
+    return visible;
+}
+
+GameRenderCullStats game_render_cull_stats(void) {
+    return s_cull.stats;
+}
+
+/* Passes that push into the world queue open their own when called
+ * outside game_render_world; true when the caller must end it. */
+static bool layer_begin(RenderLayer layer) {
+    bool own = !render_queue_is_open();
+    if (own) render_queue_begin();
+    render_queue_set_layer(layer);
+    return own;
+}
+
+static void layer_end(bool own) {
+    if (own) render_queue_end();
+}
+
 void game_render_world(void) {
+    cull_begin_frame();
 
-    // Render world components in correct z-order
-    // Note: Order is critical - each layer builds on the previous
+    // One queue from the floors to the foregrounds: each pass tags its quads
+    // with its RenderLayer and the queue's sort key does the z-ordering.
+    // Whatever a pass draws immediately (overhead UI, debug lines) flushes
+    // what is queued first, so it still lands above the layers before it
+    render_queue_begin();
 
-    // 1. Floors (bottom layer) - provides base background
+    // Floors, then world objects (portals - but NOT foregrounds)
+    // Debug boxes (dev_ui) draw as one run after the pass that queued them
     game_render_floors();
-
-    // 2. World objects (obstacles, portals - but NOT foregrounds)
+    dev_overlay_draw_boxes();
     game_render_world_objects();
+    dev_overlay_draw_boxes();
 
-    // 3. Entities (sorted by depth) - players and bots
+    // Entities (sorted by depth) - players and bots
+    PROFILE_BEGIN(PROF_ZONE_RENDER_ENTITIES);
     game_render_entities();
+    PROFILE_END(PROF_ZONE_RENDER_ENTITIES);
     if (g_entity_render) { entity_render_gc(g_entity_render); }
+    dev_overlay_draw_boxes();
 
-    // 4. Player path (if dev_ui enabled) - visual debug aid
+    // Player path and AOI circle (if dev_ui enabled) - visual debug aids
     if (presentation_runtime_dev_ui()) {
+        render_queue_flush();
         game_render_player_path();
-    }
-
-    // 5. AOI circle (if dev_ui enabled) - visual debug aid
-    if (presentation_runtime_dev_ui()) {
         game_render_aoi_circle();
     }
 
-    // 6. Foregrounds (always on top of entities) - creates depth
+    // Foregrounds (always on top of entities) - creates depth
     game_render_foregrounds();
+    dev_overlay_draw_boxes();
+    render_queue_end();
 
-    // 7. Effects — click effects, floating text, FCT pop-ups, loot flights
+    // Effects — click effects, floating text, FCT pop-ups, loot flights
     game_render_click_effects();
     game_render_floating_texts();
     fct_draw();
     game_render_loot_fx();
 
-    // 8. Grid overlay (if dev_ui enabled - renders on top of everything)
+    // Grid overlay (if dev_ui enabled - renders on top of everything)
     if (presentation_runtime_dev_ui()) {
         game_render_grid();
     }
 }
 
 void game_render_grid(void) {
-    // Only render grid overlay when dev_ui is enabled
-    // Grid is transparent with red lines and white border on top of everything
-
-    float cell_size = g_game_state.cell_size > 0 ? g_game_state.cell_size : 12.0f;
-    int grid_w = g_game_state.grid_w;
-    int grid_h = g_game_state.grid_h;
-    float map_w = grid_w * cell_size;
-    float map_h = grid_h * cell_size;
-
-    // Draw white map boundary (outline)
-    DrawRectangleLinesEx(
-        (Rectangle){0, 0, map_w, map_h},
-        2.0f,
-        WHITE
-    );
-
-    // Draw red grid lines (semi-transparent)
-    Color grid_line_color = (Color){255, 0, 0, 100};
-
-    // Draw vertical grid lines
-    for (int x = 1; x < grid_w; x++) {
-        float x_pos = x * cell_size;
-        DrawLineEx(
-            (Vector2){x_pos, 0},
-            (Vector2){x_pos, map_h},
-            1.0f,
-            grid_line_color
-        );
-    }
-
-    // Draw horizontal grid lines
-    for (int y = 1; y < grid_h; y++) {
-        float y_pos = y * cell_size;
-        DrawLineEx(
-            (Vector2){0, y_pos},
-            (Vector2){map_w, y_pos},
-            1.0f,
-            grid_line_color
-        );
-    }
+    // Map border and cell lines over the camera view, on top of everything
+    dev_overlay_grid(g_game_state.grid_w, g_game_state.grid_h);
 }
 
 
@@ -358,52 +422,35 @@ void game_render_floors(void) {
         }
     }
 
-    for (int i = 0; i < g_game_state.floor_count; i++) {
-        WorldObject* floor = &g_game_state.floors[i];
-        Color floor_color = presentation_runtime_palette("FLOOR");
-
-        if (floor->object_layer_count > 0) {
-            ObjectLayerState* layers[MAX_OBJECT_LAYERS];
-            for (int j = 0; j < floor->object_layer_count; j++) {
-                layers[j] = &floor->object_layers[j];
-            }
-
-            draw_entity_layers(
-                g_entity_render,
-                floor->id,
-                floor->pos.x,
-                floor->pos.y,
-                floor->dims.x,
-                floor->dims.y,
-                DIRECTION_NONE,
-                MODE_IDLE,
-                layers,
-                floor->object_layer_count,
-                "floor",
-                presentation_runtime_dev_ui(),
-                cell_size,
-                floor_color
-            );
-        } else {
-            Color fallback = presentation_runtime_palette("FLOOR_BACKGROUND");
-            Rectangle rect = {
-                floor->pos.x * cell_size,
-                floor->pos.y * cell_size,
-                floor->dims.x * cell_size,
-                floor->dims.y * cell_size
-            };
-            DrawRectangleRec(rect, fallback);
-        }
+    // Baked chunks first, while nothing is queued yet; merged runs and the
+    // tiles neither covers (animated, still loading, or with dev UI on)
+    // draw on top
+    floor_cache_draw();
+
+    // Floor tiles are flat and side by side, so they all tie on depth and
+    // the queue is free to group them by atlas
+    bool dev_ui = presentation_runtime_dev_ui();
+    bool own = layer_begin(RENDER_LAYER_FLOOR);
+    floor_cache_draw_runs(g_entity_render, game_render_get_camera_bounds());
+    int visible = cull_query(&g_game_state.floor_grid, g_game_state.floor_count);
+    for (int v = 0; v < visible; v++) {
+        if (floor_cache_covers(s_visible[v])) continue;
+        floor_cache_draw_tile(g_entity_render, &g_game_state.floors[s_visible[v]], cell_size, dev_ui);
     }
+    layer_end(own);
 }
 
 void game_render_world_objects(void) {
     const float cell_size = g_game_state.cell_size > 0 ? g_game_state.cell_size : 12.0f;
 
-    // Render portals
-    for (int i = 0; i < g_game_state.portal_count; i++) {
-        WorldObject* portal = &g_game_state.portals[i];
-        Color portal_color = presentation_runtime_palette("PORTAL");
+    // Render portals, queued at their bottom edge like obstacles so a row of
+    // them batches by atlas
+    bool own = layer_begin(RENDER_LAYER_WORLD_OBJECT);
+    int visible = cull_query(&g_game_state.portal_grid, g_game_state.portal_count);
+    for (int v = 0; v < visible; v++) {
+        WorldObject* portal = &g_game_state.portals[s_visible[v]];
+        Color portal_color = presentation_runtime_palette_slot(PALETTE_PORTAL);
+        render_queue_set_depth(portal->pos.y + portal->dims.y);
 
         if (portal->object_layer_count > 0) {
             ObjectLayerState* layers[MAX_OBJECT_LAYERS];
@@ -413,7 +460,7 @@ void game_render_world_objects(void) {
 
             draw_entity_layers(
                 g_entity_render,
-                portal->id,
+                portal->handle,
                 portal->pos.x,
                 portal->pos.y,
                 portal->dims.x,
@@ -422,6 +469,7 @@ void game_render_world_objects(void) {
                 MODE_IDLE,
                 layers,
                 portal->object_layer_count,
+                portal->layers_version,
                 "portal",
                 presentation_runtime_dev_ui(),
                 cell_size,
@@ -434,17 +482,25 @@ void game_render_world_objects(void) {
                 portal->dims.x * cell_size,
                 portal->dims.y * cell_size
             };
-            DrawRectangleRec(rect, portal_color);
+            render_queue_push_rect(rect, portal_color, 0);
         }
+    }
+
+    // Overheads draw immediately, above every queued portal
+    render_queue_flush();
+    for (int v = 0; v < visible; v++) {
+        WorldObject* portal = &g_game_state.portals[s_visible[v]];
 
         /* Overhead: portals carry only the 'portal' presence icon (transport)
          * plus a "<targetMapCode> <x>,<y>" destination nameplate. */
-        char portal_name[80];
-        nameplate_resolve_portal(portal->target_map_code, portal->target_cell_x,
-                                 portal->target_cell_y, portal_name, (int)sizeof(portal_name));
+        TextValue portal_name = nameplate_resolve_portal(portal->target_map_code,
+                                                         portal->target_cell_x,
+                                                         portal->target_cell_y,
+                                                         EOHUD_NAME_FONT_SIZE);
         EntityOverheadParams ohp = {
-            .name              = portal_name,
-            .show_name         = portal_name[0] != '\0',
+            .name              = portal_name.text,
+            .name_width        = portal_name.width,
+            .show_name         = portal_name.text[0] != '\0',
             .show_stats        = false,
             .show_hp           = false,
             .status_icon       = portal->status_icon,
@@ -453,15 +509,22 @@ void game_render_world_objects(void) {
         entity_overhead_ui_draw(&ohp, portal->pos.x, portal->pos.y,
                                 portal->dims.x, portal->dims.y, cell_size);
     }
+    layer_end(own);
 }
 
 void game_render_foregrounds(void) {
     const float cell_size = g_game_state.cell_size > 0 ? g_game_state.cell_size : 12.0f;
 
-    // Render foregrounds (always on top of entities)
-    for (int i = 0; i < g_game_state.foreground_count; i++) {
-        WorldObject* fg = &g_game_state.foregrounds[i];
-        Color fg_color = presentation_runtime_palette("FOREGROUND");
+    // Render foregrounds (always on top of entities), ordered among
+    // themselves by bottom edge. Inside the world pass they go through the
+    // occlusion mask, faded where they cover the player and nearby actors
+    bool own = layer_begin(RENDER_LAYER_FOREGROUND);
+    int visible = cull_query(&g_game_state.foreground_grid, g_game_state.foreground_count);
+    bool masked = 0 < visible && fg_occlusion_begin();
+    for (int v = 0; v < visible; v++) {
+        WorldObject* fg = &g_game_state.foregrounds[s_visible[v]];
+        Color fg_color = presentation_runtime_palette_slot(PALETTE_FOREGROUND);
+        render_queue_set_depth(fg->pos.y + fg->dims.y);
 
         if (fg->object_layer_count > 0) {
             ObjectLayerState* layers[MAX_OBJECT_LAYERS];
@@ -471,7 +534,7 @@ void game_render_foregrounds(void) {
 
             draw_entity_layers(
                 g_entity_render,
-                fg->id,
+                fg->handle,
                 fg->pos.x,
                 fg->pos.y,
                 fg->dims.x,
@@ -480,6 +543,7 @@ void game_render_foregrounds(void) {
                 MODE_IDLE,
                 layers,
                 fg->object_layer_count,
+                fg->layers_version,
                 "foreground",
                 presentation_runtime_dev_ui(),
                 cell_size,
@@ -492,56 +556,250 @@ void game_render_foregrounds(void) {
                 fg->dims.x * cell_size,
                 fg->dims.y * cell_size
             };
-            DrawRectangleRec(rect, fg_color);
+            render_queue_push_rect(rect, fg_color, 0);
         }
     }
+    if (masked) fg_occlusion_end(cell_size);
+    layer_end(own);
 }
 
-// Helper structure for depth sorting entities.
-// Capacity covers obstacles (≤ MAX_OBJECTS) plus the main player, other players,
-// bots, resources, and statics (each ≤ MAX_ENTITIES).
-#define MAX_DEPTH_SORT_ENTRIES (MAX_OBJECTS + (MAX_ENTITIES * 4) + 1)
+/* Depth order carried across frames. Obstacles and statics only change
+ * when the world arrays are rebuilt, so they are sorted once per
+ * GameState.world_revision and merely filtered by the cull each frame.
+ * Actors keep last frame's order: their depth keys are refreshed in place
+ * and an insertion sort repairs the few that crossed, close to one linear
+ * pass on a coherent frame. When too many actors arrived at once the
+ * appended tail would make that quadratic, so the run is re-sorted. */
+#define DEPTH_MAX_STATIC  (MAX_OBJECTS + MAX_ENTITIES)
+#define DEPTH_MAX_ACTORS  (MAX_ENTITIES * 3 + 1)
+#define DEPTH_RESORT_DIVISOR 8
+
+static struct {
+    uint32_t        world_revision;
+    bool            static_ready;
+    int             static_count;
+    EntitySortEntry statics[DEPTH_MAX_STATIC];    /* obstacles + statics */
+    int             actor_count;
+    EntitySortEntry actors[DEPTH_MAX_ACTORS];     /* last frame's actor order */
+    uint32_t        frame;
+    /* Frame stamps: visible this frame (obstacles, statics, resources) or
+     * already carried over into actors (players, bots, resources). */
+    uint32_t        obstacle_visible[MAX_OBJECTS];
+    uint32_t        static_visible[MAX_ENTITIES];
+    uint32_t        resource_visible[MAX_ENTITIES];
+    uint32_t        player_kept[MAX_ENTITIES];
+    uint32_t        bot_kept[MAX_ENTITIES];
+    uint32_t        resource_kept[MAX_ENTITIES];
+    bool            self_kept;
+    GameRenderDepthStats stats;
+} s_depth;
+
+static void depth_rebuild_statics(void) {
+    const GameState* gs = &g_game_state;
+    int n = 0;
+    for (int i = 0; i < gs->obstacle_count; i++) {
+        WorldObject* obj = &g_game_state.obstacles[i];
+        s_depth.statics[n++] = (EntitySortEntry){
+            .type        = ENTITY_TYPE_OBSTACLE,
+            .bottom_y    = obj->pos.y + obj->dims.y,
+            .sort_handle = obj->handle,
+            .slot        = i,
+            .data.object = obj,
+        };
+    }
+    for (int i = 0; i < gs->static_count; i++) {
+        WorldObject* st = &g_game_state.statics[i];
+        s_depth.statics[n++] = (EntitySortEntry){
+            .type        = ENTITY_TYPE_STATIC,
+            .bottom_y    = st->pos.y + st->dims.y,
+            .sort_handle = st->handle,
+            .slot        = i,
+            .data.object = st,
+        };
+    }
+    for (int i = 0; i < n; i++) {
+        s_depth.statics[i].key = entity_depth_key(s_depth.statics[i].bottom_y,
+                                                  s_depth.statics[i].sort_handle);
+    }
+    entity_depth_radix_sort(s_depth.statics, n);
+    s_depth.static_count   = n;
+    s_depth.world_revision = gs->world_revision;
+    s_depth.static_ready   = true;
+}
 
-typedef struct {
-    enum { ENTITY_TYPE_OBSTACLE, ENTITY_TYPE_STATIC, ENTITY_TYPE_PLAYER, ENTITY_TYPE_OTHER_PLAYER, ENTITY_TYPE_BOT, ENTITY_TYPE_RESOURCE } type;
-    float bottom_y;  // Y position of entity's bottom edge (for depth sorting)
-    const char* sort_id;
-    int source_order;
-    union {
-        WorldObject* object;
-        PlayerState* player;
-        BotState* bot;
-    } data;
-    bool is_main_player;
-} EntitySortEntry;
-
-// Comparison function for qsort - entities with lower Y render first (appear behind)
-#define ENTITY_DEPTH_EPSILON 0.001f
-
-static int compare_entities_by_depth(const void* a, const void* b) {
-    const EntitySortEntry* ea = (const EntitySortEntry*)a;
-    const EntitySortEntry* eb = (const EntitySortEntry*)b;
-    float depth_delta = ea->bottom_y - eb->bottom_y;
-
-    if (depth_delta < -ENTITY_DEPTH_EPSILON) return -1;
-    if (depth_delta > ENTITY_DEPTH_EPSILON) return 1;
-
-    if (ea->sort_id && eb->sort_id) {
-        int id_cmp = strcmp(ea->sort_id, eb->sort_id);
-        if (id_cmp != 0) return id_cmp;
+/* Refresh a carried-over actor against the live arrays. False when its
+ * slot no longer holds the same entity (it left, or the array shifted). */
+static bool depth_refresh_actor(EntitySortEntry* e, const float* player_bottom,
+                                const float* bot_bottom) {
+    GameState* gs = &g_game_state;
+    switch (e->type) {
+        case ENTITY_TYPE_PLAYER:
+            if (e->sort_handle != gs->player.base.handle) return false;
+            entity_depth_set_bottom(e, gs->player.base.interp_pos.y + gs->player.base.dims.y);
+            s_depth.self_kept = true;
+            return true;
+
+        case ENTITY_TYPE_OTHER_PLAYER:
+            if (e->slot >= gs->other_player_count ||
+                e->sort_handle != gs->other_players[e->slot].base.handle) return false;
+            entity_depth_set_bottom(e, player_bottom[e->slot]);
+            e->data.player = &gs->other_players[e->slot];
+            s_depth.player_kept[e->slot] = s_depth.frame;
+            return true;
+
+        case ENTITY_TYPE_BOT:
+            if (e->slot >= gs->bot_count ||
+                e->sort_handle != gs->bots[e->slot].base.handle) return false;
+            entity_depth_set_bottom(e, bot_bottom[e->slot]);
+            e->data.bot = &gs->bots[e->slot];
+            s_depth.bot_kept[e->slot] = s_depth.frame;
+            return true;
+
+        case ENTITY_TYPE_RESOURCE: {
+            if (e->slot >= gs->resource_count ||
+                s_depth.resource_visible[e->slot] != s_depth.frame ||
+                e->sort_handle != gs->resources[e->slot].base.handle) return false;
+            BotState* res = &gs->resources[e->slot];
+            entity_depth_set_bottom(e, res->base.interp_pos.y + res->base.dims.y);
+            e->data.bot = res;
+            s_depth.resource_kept[e->slot] = s_depth.frame;
+            return true;
+        }
+
+        default:
+            return false;
+    }
+}
+
+/* Every entity to draw this frame, in depth order, in frame_arena scratch. */
+static int depth_collect(EntitySortEntry** out_entries) {
+    GameState* gs = &g_game_state;
+    s_depth.frame++;
+    s_depth.stats = (GameRenderDepthStats){ 0 };
+    if (!s_depth.static_ready || gs->world_revision != s_depth.world_revision) {
+        depth_rebuild_statics();
+        s_depth.stats.statics_rebuilt = true;
+    }
+
+    /* Stamp what the cull keeps; the pre-sorted run is filtered by it. */
+    int visible = cull_query(&gs->obstacle_grid, gs->obstacle_count);
+    for (int v = 0; v < visible; v++) s_depth.obstacle_visible[s_visible[v]] = s_depth.frame;
+    visible = cull_query(&gs->static_grid, gs->static_count);
+    for (int v = 0; v < visible; v++) s_depth.static_visible[s_visible[v]] = s_depth.frame;
+    visible = cull_query(&gs->resource_grid, gs->resource_count);
+    for (int v = 0; v < visible; v++) s_depth.resource_visible[s_visible[v]] = s_depth.frame;
+
+    /* Depth keys (bottom edge) for every remote player and bot in one
+     * vectorised pass over the packed hot sets. */
+    float* player_bottom = frame_alloc(sizeof(float) * (size_t)gs->player_hot.count);
+    float* bot_bottom    = frame_alloc(sizeof(float) * (size_t)gs->bot_hot.count);
+    vk_add(player_bottom, gs->player_hot.y, gs->player_hot.h, gs->player_hot.count);
+    vk_add(bot_bottom, gs->bot_hot.y, gs->bot_hot.h, gs->bot_hot.count);
+
+    /* Carry over last frame's actors in their order, dropping the gone. */
+    s_depth.self_kept = false;
+    int kept = 0;
+    for (int i = 0; i < s_depth.actor_count; i++) {
+        EntitySortEntry* e = &s_depth.actors[i];
+        if (depth_refresh_actor(e, player_bottom, bot_bottom)) s_depth.actors[kept++] = *e;
+    }
+
+    /* Append the newcomers. */
+    int n = kept;
+    if (!s_depth.self_kept) {
+        s_depth.actors[n++] = (EntitySortEntry){
+            .type           = ENTITY_TYPE_PLAYER,
+            .bottom_y       = gs->player.base.interp_pos.y + gs->player.base.dims.y,
+            .sort_handle    = gs->player.base.handle,
+            .data.player    = &gs->player,
+            .is_main_player = true,
+        };
+    }
+    for (int i = 0; i < gs->other_player_count; i++) {
+        if (s_depth.player_kept[i] == s_depth.frame) continue;
+        s_depth.actors[n++] = (EntitySortEntry){
+            .type        = ENTITY_TYPE_OTHER_PLAYER,
+            .bottom_y    = player_bottom[i],
+            .sort_handle = gs->other_players[i].base.handle,
+            .slot        = i,
+            .data.player = &gs->other_players[i],
+        };
+    }
+    for (int i = 0; i < gs->bot_count; i++) {
+        if (s_depth.bot_kept[i] == s_depth.frame) continue;
+        s_depth.actors[n++] = (EntitySortEntry){
+            .type        = ENTITY_TYPE_BOT,
+            .bottom_y    = bot_bottom[i],
+            .sort_handle = gs->bots[i].base.handle,
+            .slot        = i,
+            .data.bot    = &gs->bots[i],
+        };
+    }
+    for (int i = 0; i < gs->resource_count; i++) {
+        if (s_depth.resource_visible[i] != s_depth.frame ||
+            s_depth.resource_kept[i] == s_depth.frame) continue;
+        BotState* res = &gs->resources[i];
+        s_depth.actors[n++] = (EntitySortEntry){
+            .type        = ENTITY_TYPE_RESOURCE,
+            .bottom_y    = res->base.interp_pos.y + res->base.dims.y,
+            .sort_handle = res->base.handle,
+            .slot        = i,
+            .data.bot    = res,
+        };
+    }
+    assert(DEPTH_MAX_ACTORS >= n);
+    for (int i = kept; i < n; i++) {
+        s_depth.actors[i].key = entity_depth_key(s_depth.actors[i].bottom_y,
+                                                 s_depth.actors[i].sort_handle);
     }
 
-    if (ea->type != eb->type) {
-        return (int)ea->type - (int)eb->type;
+    s_depth.stats.full_sort = n - kept > n / DEPTH_RESORT_DIVISOR + 16;
+    if (s_depth.stats.full_sort) {
+        entity_depth_radix_sort(s_depth.actors, n);
+    } else {
+        entity_depth_insertion_sort(s_depth.actors, n);
+    }
+    s_depth.actor_count     = n;
+    s_depth.stats.actors    = n;
+    s_depth.stats.newcomers = n - kept;
+
+    /* Merge the visible statics with the actors. */
+    EntitySortEntry* out = frame_alloc(sizeof(EntitySortEntry) * (size_t)(s_depth.static_count + n));
+    int count = 0, a = 0;
+    for (int i = 0; i < s_depth.static_count; i++) {
+        const EntitySortEntry* st = &s_depth.statics[i];
+        const uint32_t* seen = (ENTITY_TYPE_OBSTACLE == st->type)
+                             ? s_depth.obstacle_visible : s_depth.static_visible;
+        if (seen[st->slot] != s_depth.frame) continue;
+        while (a < n && entity_depth_compare(&s_depth.actors[a], st) < 0) {
+            out[count++] = s_depth.actors[a++];
+        }
+        out[count++] = *st;
     }
+    while (a < n) out[count++] = s_depth.actors[a++];
+    s_depth.stats.entries = count;
+    *out_entries = out;
+    return count;
+}
+
+GameRenderDepthStats game_render_depth_stats(void) {
+    return s_depth.stats;
+}
 
-    return ea->source_order - eb->source_order;
+/* Detail tier for this frame's actors, from camera zoom and crowd size. */
+static EntityLodTier lod_tier_for_frame(const PresentationLodHints* hints, int actor_count) {
+    float zoom = camera_zoom();
+    if (zoom < hints->quad_zoom || actor_count > hints->quad_actors) return ENTITY_LOD_QUAD;
+    if (zoom < hints->skin_zoom || actor_count > hints->skin_actors) return ENTITY_LOD_SKIN;
+    return ENTITY_LOD_FULL;
 }
 
 void game_render_entities(void) {
     // Safety check - ensure entity render system is initialized
     if (!g_entity_render) {
-        // Fallback to simple rendering if entity render system not initialized
+        // Fallback to simple rendering if entity render system not initialized,
+        // immediately and so above whatever is queued
+        render_queue_flush();
         const float cell_size = g_game_state.cell_size > 0 ? g_game_state.cell_size : 12.0f;
 
         // Draw simple rectangles as fallback to ensure entities are visible
@@ -551,7 +809,7 @@ void game_render_entities(void) {
             .width = g_game_state.player.base.dims.x * cell_size,
             .height = g_game_state.player.base.dims.y * cell_size
         };
-        DrawRectangleRec(rect, presentation_runtime_palette("PLAYER"));
+        DrawRectangleRec(rect, presentation_runtime_palette_slot(PALETTE_PLAYER));
 
         // Also draw other players as rectangles
         for (int i = 0; i < g_game_state.other_player_count; i++) {
@@ -562,7 +820,7 @@ void game_render_entities(void) {
                 player->base.dims.x * cell_size,
                 player->base.dims.y * cell_size
             };
-            DrawRectangleRec(other_rect, presentation_runtime_palette("OTHER_PLAYER"));
+            DrawRectangleRec(other_rect, presentation_runtime_palette_slot(PALETTE_OTHER_PLAYER));
         }
 
         // Draw bots as rectangles
@@ -582,93 +840,20 @@ void game_render_entities(void) {
     const float cell_size = g_game_state.cell_size > 0 ? g_game_state.cell_size : 12.0f;
     const bool dev_ui = presentation_runtime_dev_ui();
 
-    // Create array to hold all depth-sorted actors
-    static EntitySortEntry sort_entries[MAX_DEPTH_SORT_ENTRIES];
-    int entry_count = 0;
-
-    // Add obstacles to sort list so they share the same depth rules as entities.
-    for (int i = 0; i < g_game_state.obstacle_count; i++) {
-        WorldObject* obj = &g_game_state.obstacles[i];
-        float bottom_y = obj->pos.y + obj->dims.y;
-
-        sort_entries[entry_count].type = ENTITY_TYPE_OBSTACLE;
-        sort_entries[entry_count].bottom_y = bottom_y;
-        sort_entries[entry_count].sort_id = obj->id;
-        sort_entries[entry_count].source_order = entry_count;
-        sort_entries[entry_count].data.object = obj;
-        sort_entries[entry_count].is_main_player = false;
-        entry_count++;
-    }
-
-    // Add static decorators to sort list — passable, but share the same depth
-    // rules as entities so the player can pass behind / in front of them.
-    for (int i = 0; i < g_game_state.static_count; i++) {
-        WorldObject* st = &g_game_state.statics[i];
-        float bottom_y = st->pos.y + st->dims.y;
-
-        sort_entries[entry_count].type = ENTITY_TYPE_STATIC;
-        sort_entries[entry_count].bottom_y = bottom_y;
-        sort_entries[entry_count].sort_id = st->id;
-        sort_entries[entry_count].source_order = entry_count;
-        sort_entries[entry_count].data.object = st;
-        sort_entries[entry_count].is_main_player = false;
-        entry_count++;
-    }
-
-    // Add main player to sort list
-    float player_bottom_y = g_game_state.player.base.interp_pos.y + g_game_state.player.base.dims.y;
-    sort_entries[entry_count].type = ENTITY_TYPE_PLAYER;
-    sort_entries[entry_count].bottom_y = player_bottom_y;
-    sort_entries[entry_count].sort_id = g_game_state.player.base.id;
-    sort_entries[entry_count].source_order = entry_count;
-    sort_entries[entry_count].data.player = &g_game_state.player;
-    sort_entries[entry_count].is_main_player = true;
-    entry_count++;
-
-    // Add other players to sort list
-    for (int i = 0; i < g_game_state.other_player_count; i++) {
-        PlayerState* player = &g_game_state.other_players[i];
-        float bottom_y = player->base.interp_pos.y + player->base.dims.y;
-
-        sort_entries[entry_count].type = ENTITY_TYPE_OTHER_PLAYER;
-        sort_entries[entry_count].bottom_y = bottom_y;
-        sort_entries[entry_count].sort_id = player->base.id;
-        sort_entries[entry_count].source_order = entry_count;
-        sort_entries[entry_count].data.player = player;
-        sort_entries[entry_count].is_main_player = false;
-        entry_count++;
-    }
-
-    // Add bots to sort list
-    for (int i = 0; i < g_game_state.bot_count; i++) {
-        BotState* bot = &g_game_state.bots[i];
-        float bottom_y = bot->base.interp_pos.y + bot->base.dims.y;
-
-        sort_entries[entry_count].type = ENTITY_TYPE_BOT;
-        sort_entries[entry_count].bottom_y = bottom_y;
-        sort_entries[entry_count].sort_id = bot->base.id;
-        sort_entries[entry_count].source_order = entry_count;
-        sort_entries[entry_count].data.bot = bot;
-        sort_entries[entry_count].is_main_player = false;
-        entry_count++;
-    }
+    // Gather all depth-sorted actors
+    EntitySortEntry* sort_entries = NULL;
+    int entry_count = depth_collect(&sort_entries);
 
-    // Add resources to sort list
-    for (int i = 0; i < g_game_state.resource_count; i++) {
-        BotState* res = &g_game_state.resources[i];
-        float bottom_y = res->base.interp_pos.y + res->base.dims.y;
-
-        sort_entries[entry_count].type = ENTITY_TYPE_RESOURCE;
-        sort_entries[entry_count].bottom_y = bottom_y;
-        sort_entries[entry_count].sort_id = res->base.id;
-        sort_entries[entry_count].source_order = entry_count;
-        sort_entries[entry_count].data.bot = res;
-        sort_entries[entry_count].is_main_player = false;
-        entry_count++;
-    }
+    // Obstacles and statics queue at their depth, so a row of them sharing
+    // a bottom edge batches by atlas; actors flush around the shadow and
+    // overhead UI they draw immediately
+    bool own = layer_begin(RENDER_LAYER_ENTITY);
 
-    // Sort entities by depth (bottom Y coordinate) - no lock needed
-    qsort(sort_entries, entry_count, sizeof(EntitySortEntry), compare_entities_by_depth);
+    const PresentationLodHints lod = presentation_runtime_lod();
+    const EntityLodTier actor_tier = lod_tier_for_frame(&lod, s_depth.actor_count);
+    /* The actor the open dialogue talks to draws outlined. */
+    IdHandle selected = modal_dialogue_is_open() ? id_intern_find(modal_dialogue_entity_id())
+                                                : ID_HANDLE_NONE;
 
     // Allocate temporary layer pointer array for all entities
     ObjectLayerState* temp_layers[MAX_OBJECT_LAYERS];
@@ -678,7 +863,7 @@ void game_render_entities(void) {
     for (int i = 0; i < entry_count; i++) {
         EntitySortEntry* entry = &sort_entries[i];
 
-        const char* entity_type_str = NULL;
+        EntityColorKind color_kind = ENTITY_COLOR_BOT;
         const char* entity_id = NULL;
         EntityState* entity_base = NULL;
         WorldObject* obstacle = NULL;
@@ -687,62 +872,65 @@ void game_render_entities(void) {
         switch (entry->type) {
             case ENTITY_TYPE_OBSTACLE:
                 obstacle = entry->data.object;
-                entity_type_str = "obstacle";
+                color_kind = ENTITY_COLOR_OBSTACLE;
                 entity_id = obstacle->id;
                 layers_count = obstacle->object_layer_count;
                 break;
 
             case ENTITY_TYPE_STATIC:
                 obstacle = entry->data.object;
-                entity_type_str = "static";
+                color_kind = ENTITY_COLOR_STATIC;
                 entity_id = obstacle->id;
                 layers_count = obstacle->object_layer_count;
                 break;
 
             case ENTITY_TYPE_PLAYER:
                 entity_base = &entry->data.player->base;
-                entity_type_str = entry->is_main_player ? "self" : "other";
+                color_kind = entry->is_main_player ? ENTITY_COLOR_SELF : ENTITY_COLOR_OTHER;
                 entity_id = entity_base->id;
                 layers_count = entity_base->object_layer_count;
                 break;
 
             case ENTITY_TYPE_OTHER_PLAYER:
                 entity_base = &entry->data.player->base;
-                entity_type_str = "other";
+                color_kind = ENTITY_COLOR_OTHER;
                 entity_id = entity_base->id;
                 layers_count = entity_base->object_layer_count;
                 break;
 
             case ENTITY_TYPE_BOT:
                 entity_base = &entry->data.bot->base;
-                // Map bot behavior to the entity_type_str used for entity defaults lookup.
+                // Map bot behavior to the entity type used for entity defaults lookup.
                 // Skills and coins are spawned as bots server-side; their behavior
                 // string distinguishes them so the correct color / item defaults apply.
                 if (strcmp(entry->data.bot->behavior, "skill") == 0)
-                    entity_type_str = "skill";
+                    color_kind = ENTITY_COLOR_SKILL;
                 else if (strcmp(entry->data.bot->behavior, "coin") == 0)
-                    entity_type_str = "coin";
+                    color_kind = ENTITY_COLOR_COIN;
                 else if (strcmp(entry->data.bot->behavior, "drop") == 0)
-                    entity_type_str = "drop";
+                    color_kind = ENTITY_COLOR_DROP;
                 else
-                    entity_type_str = "bot";
+                    color_kind = ENTITY_COLOR_BOT;
                 entity_id = entity_base->id;
                 layers_count = entity_base->object_layer_count;
                 break;
 
             case ENTITY_TYPE_RESOURCE:
                 entity_base = &entry->data.bot->base;
-                entity_type_str = "resource";
+                color_kind = ENTITY_COLOR_RESOURCE;
                 entity_id = entity_base->id;
                 layers_count = entity_base->object_layer_count;
                 break;
         }
+        const char* entity_type_str = presentation_runtime_entity_type_name(color_kind);
+
+        render_queue_set_depth(entry->bottom_y);
+        entity_render_set_lod(g_entity_render, ENTITY_LOD_FULL, false);
 
         if (obstacle && entity_id) {
-            // entity_type_str is "obstacle" or "static"; resolve the solid-colour
-            // fallback from the entity-colour table so each renders its own palette
-            // key when no object-layer texture is present.
-            Color obstacle_color = presentation_runtime_entity_fallback_color(entity_type_str);
+            // Obstacles and statics each render their own palette key when no
+            // object-layer texture is present.
+            Color obstacle_color = presentation_runtime_entity_color(color_kind);
 
             if (layers_count == 0) {
                 Rectangle rect = {
@@ -751,7 +939,7 @@ void game_render_entities(void) {
                     obstacle->dims.x * cell_size,
                     obstacle->dims.y * cell_size
                 };
-                DrawRectangleRec(rect, obstacle_color);
+                render_queue_push_rect(rect, obstacle_color, 0);
             } else {
                 for (int j = 0; j < layers_count && j < MAX_OBJECT_LAYERS; j++) {
                     temp_layers[j] = &obstacle->object_layers[j];
@@ -759,7 +947,7 @@ void game_render_entities(void) {
 
                 draw_entity_layers(
                     g_entity_render,
-                    entity_id,
+                    obstacle->handle,
                     obstacle->pos.x,
                     obstacle->pos.y,
                     obstacle->dims.x,
@@ -768,6 +956,7 @@ void game_render_entities(void) {
                     MODE_IDLE,
                     temp_layers,
                     layers_count,
+                    obstacle->layers_version,
                     entity_type_str,
                     dev_ui,
                     cell_size,
@@ -779,29 +968,39 @@ void game_render_entities(void) {
         }
 
         if (entity_base && entity_id) {
+            render_queue_flush();
+
+            /* The local player is the focus and always draws in full; other
+             * actors at full detail draw as composited impostors. */
+            EntityLodTier tier = entry->is_main_player ? ENTITY_LOD_FULL : actor_tier;
+            bool full_detail = ENTITY_LOD_FULL == tier;
+            if (!entry->is_main_player && full_detail) tier = ENTITY_LOD_IMPOSTOR;
+            FidelityTier fidelity = entry->is_main_player
+                ? FIDELITY_NEAR : fidelity_tier(entity_base->interp_pos, entity_base->dims);
+            entity_render_set_lod(g_entity_render, tier, FIDELITY_NEAR != fidelity);
+
             // Compute the solid-colour fallback once — used both when layers_count==0
             // and passed into draw_entity_layers so it can use the same colour when
             // a texture fails to load instead of a generic gray rectangle.
-            Color entity_fallback_color = presentation_runtime_entity_fallback_color(entity_type_str);
+            Color entity_fallback_color = presentation_runtime_entity_color(color_kind);
 
             /* Skill/coin projectiles and inert loot drops carry no ground
              * shadow or combat/identity overhead — only players, other
              * players, combat bots (passive/hostile), and resources do. */
-            bool is_non_combat_bot = (entry->type == ENTITY_TYPE_BOT)
-                && (strcmp(entity_type_str, "skill") == 0
-                    || strcmp(entity_type_str, "coin")  == 0
-                    || strcmp(entity_type_str, "drop")  == 0);
+            bool is_non_combat_bot = ENTITY_COLOR_SKILL == color_kind
+                || ENTITY_COLOR_COIN == color_kind
+                || ENTITY_COLOR_DROP == color_kind;
 
             /* Draw position — authoritative interpolation, except loot drops,
              * whose top-left is driven by the launch/idle-float FX timeline.
              * A collected drop yields entirely to its detached vacuum flight. */
             float draw_x = entity_base->interp_pos.x;
             float draw_y = entity_base->interp_pos.y;
-            if (entry->type == ENTITY_TYPE_BOT && strcmp(entity_type_str, "drop") == 0) {
+            if (ENTITY_COLOR_DROP == color_kind) {
                 /* Per-viewer loot eligibility (AOI bot flag) picks the drop's
                  * particle tint: gold = collectable by us, gray = another
                  * player's loot. */
-                const BotState* drop_bot = game_state_find_bot(entity_id);
+                const BotState* drop_bot = entry->data.bot;
                 bool loot_eligible = (NULL != drop_bot)
                     && 0 != (drop_bot->interaction_flags & INTERACTION_FLAG_LOOT_ELIGIBLE);
                 if (!loot_fx_drop_render_pos(entity_id,
@@ -822,7 +1021,11 @@ void game_render_entities(void) {
              * sprite so it sits beneath it). Overhead UI below keeps using
              * the unscaled interp_pos/dims so the nameplate/HP bar never
              * shifts. */
-            if (!is_non_combat_bot) {
+            /* Shadow and sprite share one effect block (hit flash, damage
+             * tint, selection outline), closed by the flush below. */
+            if (!is_non_combat_bot && full_detail) {
+                entity_fx_begin(entity_base->handle, entity_base->life,
+                                ID_HANDLE_NONE != selected && selected == entity_base->handle);
                 draw_entity_shadow(draw_x, draw_y, render_width, render_height, cell_size);
             }
 
@@ -844,7 +1047,7 @@ void game_render_entities(void) {
                     render_width * cell_size,
                     render_height * cell_size
                 };
-                DrawRectangleRec(rect, entity_fallback_color);
+                DrawRectangleRec(rect, entity_fx_plain(entity_fallback_color));
             } else {
                 // Convert object layers to pointer array
                 for (int j = 0; j < layers_count && j < MAX_OBJECT_LAYERS; j++) {
@@ -855,7 +1058,7 @@ void game_render_entities(void) {
                 // This may load textures which can take time - that's why we unlocked earlier
                 draw_entity_layers(
                     g_entity_render,
-                    entity_id,
+                    entity_base->handle,
                     draw_x,
                     draw_y,
                     render_width,
@@ -864,15 +1067,18 @@ void game_render_entities(void) {
                     entity_base->mode,
                     temp_layers,
                     layers_count,
+                    entity_base->layers_version,
                     entity_type_str,
                     dev_ui,
                     cell_size,
                     entity_fallback_color
                 );
             }
+            render_queue_flush();
+            entity_fx_end();
 
             /* On-grid quantity counter above a stacked drop (coins, bundles). */
-            if (entry->type == ENTITY_TYPE_BOT && strcmp(entity_type_str, "drop") == 0
+            if (ENTITY_COLOR_DROP == color_kind
                 && entity_base->object_layer_count > 0
                 && entity_base->object_layers[0].quantity > 1) {
                 draw_drop_count(draw_x, draw_y, entity_base->dims.x, cell_size,
@@ -882,8 +1088,9 @@ void game_render_entities(void) {
             /* ── Overhead UI — nameplate, capacity bar, HP bar ─────────── */
             /* Skip for skill/coin projectiles and inert loot drops — none of
              * them carry combat/identity overhead (is_non_combat_bot computed
-             * above, shared with the ground-shadow gate). */
-            if (!is_non_combat_bot) {
+             * above, shared with the ground-shadow gate) — and for actors
+             * drawn below full detail or in the far fidelity tier. */
+            if (!is_non_combat_bot && full_detail && FIDELITY_FAR != fidelity) {
                 /* Every entity carries a stats_sum (server-clamped sum of its
                  * active stats) used by the overhead capability bar.  */
                 bool np_is_player = (entry->type == ENTITY_TYPE_PLAYER
@@ -915,7 +1122,7 @@ void game_render_entities(void) {
                  * capability icons still show. */
                 bool np_is_provider = false;
                 if (!np_is_player) {
-                    const BotState* np_bot = game_state_find_bot(entity_base->id);
+                    const BotState* np_bot = (ENTITY_TYPE_BOT == entry->type) ? entry->data.bot : NULL;
                     if (np_bot) {
                         np_flags = np_bot->interaction_flags;
                         np_is_provider = (0 == strcmp(np_bot->behavior, "provider"))
@@ -961,16 +1168,20 @@ void game_render_entities(void) {
 
         }
     }
+    layer_end(own);
+    entity_render_set_lod(g_entity_render, ENTITY_LOD_FULL, false);
 }
 
 void game_render_player_path(void) {
     const float cell_size = g_game_state.cell_size > 0 ? g_game_state.cell_size : 12.0f;
 
+    const LocalDebugPath* path = local_player_debug_path();
+
     // Render target position
-    if (g_game_state.player.target_pos.x >= 0 && g_game_state.player.target_pos.y >= 0) {
+    if (path->target.x >= 0 && path->target.y >= 0) {
         Rectangle target_rect = {
-            g_game_state.player.target_pos.x * cell_size,
-            g_game_state.player.target_pos.y * cell_size,
+            path->target.x * cell_size,
+            path->target.y * cell_size,
             cell_size,
             cell_size
         };
@@ -979,9 +1190,11 @@ void game_render_player_path(void) {
         DrawRectangleRec(target_rect, (Color){ 220, 220, 80, 180 });
     }
 
-    // Render path
-    for (int i = 0; i < g_game_state.player.path_count; i++) {
-        Vector2 path_point = g_game_state.player.path[i];
+    // Render path, the steps on screen
+    Rectangle view = game_render_get_camera_bounds();
+    for (int i = 0; i < path->count; i++) {
+        Vector2 path_point = path->points[i];
+        if (!CheckCollisionRecs((Rectangle){ path_point.x, path_point.y, 1.0f, 1.0f }, view)) continue;
 
         Rectangle path_rect = {
             path_point.x * cell_size,
@@ -1013,12 +1226,7 @@ void game_render_aoi_circle(void) {
  * so both the pickup delivery and the outward reduction parabola read clearly;
  * the notification toast still draws after this, staying top-most. */
 static void draw_loot_screen_fx(void) {
-    int loot_scr = loot_fx_screen_particle_slot_count();
-    for (int i = 0; i < loot_scr; i++) {
-        LootFxScreenParticle sp;
-        if (!loot_fx_screen_particle_at(i, &sp)) continue;
-        fx_shape_spark(sp.x, sp.y, sp.size, FX_SPARK_GOLD, sp.alpha);
-    }
+    fx_particles_draw(FX_SPACE_SCREEN, 1.0f);
 
     int loot_tok = loot_fx_delivery_token_slot_count();
     for (int i = 0; i < loot_tok; i++) {
@@ -1033,6 +1241,9 @@ static void draw_loot_screen_fx(void) {
 
 void game_render_ui(void) {
 
+    // Tap targets register as they draw below; next frame's input hits them
+    ui_hit_begin_frame(g_renderer.screen_width, g_renderer.screen_height);
+
     // Render error messages (always visible)
     game_render_error_messages();
 
@@ -1269,6 +1480,18 @@ void game_render_update_effects(float delta_time) {
 
 void game_render_cleanup(void) {
 
+    floor_cache_release();
+    overhead_labels_release();
+    icon_atlas_release();
+    ui_skin_release();
+    entity_impostor_release();
+    entity_fx_release();
+    fg_occlusion_release();
+    dev_overlay_release();
+    sprite_instancing_release();
+    world_target_release();
+    fct_release();
+
     // Cleanup entity rendering system
     destroy_entity_render(g_entity_render);
     g_entity_render = NULL;
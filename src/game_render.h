@@ -114,7 +114,10 @@ void game_render_cleanup(void);
  * @brief Render the game world (grid, objects, entities)
  *
  * This function handles all world-space rendering that should be
- * affected by camera transforms.
+ * affected by camera transforms. Floors, world objects, entities and
+ * foregrounds share one render queue, each tagging its quads with its
+ * RenderLayer; the passes below also draw standalone, through a queue of
+ * their own, when called outside it.
  */
 void game_render_world(void);
 
@@ -135,6 +138,9 @@ void game_render_world_objects(void);
 
 /**
  * @brief Render foreground objects (always on top of entities)
+ *
+ * Within the world pass they are drawn through the occlusion mask
+ * (fg_occlusion.h), so the local player and nearby actors show through.
  */
 void game_render_foregrounds(void);
 
@@ -284,6 +290,27 @@ bool game_render_is_visible(Vector2 world_pos, float margin);
  */
 Rectangle game_render_get_camera_bounds(void);
 
+/* World objects the culling stage kept vs skipped in the last frame. */
+typedef struct {
+    int drawn;
+    int culled;
+} GameRenderCullStats;
+
+GameRenderCullStats game_render_cull_stats(void);
+
+/* Depth ordering work of the last entity pass: entries drawn, actors
+ * carried in the sorted run, how many of those were newcomers, and whether
+ * the run was fully re-sorted or the static run rebuilt. */
+typedef struct {
+    int  entries;
+    int  actors;
+    int  newcomers;
+    bool full_sort;
+    bool statics_rebuilt;
+} GameRenderDepthStats;
+
+GameRenderDepthStats game_render_depth_stats(void);
+
 /**
  * @brief Draw text with shadow effect
  * @param text Text to draw
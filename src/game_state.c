@@ -7,34 +7,559 @@
 
 #include <raylib.h>
 
+#include "client_context.h"
 #include "domain/presentation_runtime.h"
+#include "entity_index.h"
+#include "profiler.h"
+#include "spatial_grid.h"
 #include "util/log.h"
+#include "util/slot_map.h"
 
 /* Authoritative world-state mirror. Camera, dev-UI, frozen flag, and
  * per-frame UI bookkeeping have been moved to their owning modules; what
  * remains here is strictly gameplay/world data. */
-GameState g_game_state = {0};
+static GameState s_primary_view;
+GameState*       g_game_state_view = &s_primary_view;
+
+/* world_revision and commit_epoch values come from one process-wide clock,
+ * so a cache keyed on them never mistakes one view's world for another's. */
+static uint32_t s_revision_clock;
+
+static uint32_t next_revision(void) {
+    return ++s_revision_clock;
+}
+
+/* id → slot over other_players / bots; every write to those arrays below
+ * keeps the matching index in step. .records follows the pool whenever it
+ * grows. */
+static EntityIndex s_player_index = {
+    .stride  = sizeof(PlayerState),
+};
+static EntityIndex s_bot_index = {
+    .stride  = sizeof(BotState),
+};
+/* EntityHandle → current slot of the record. Records carry their handle
+ * (base.ref); whatever moves a record re-points its entry, whatever drops
+ * one removes it, so the generation makes every old handle miss. */
+typedef struct {
+    bool bot;
+    int  slot;
+} EntityRef;
+
+SLOT_MAP_DEFINE(entity_ref_map, EntityRef, 2 * MAX_ENTITIES)
+
+static entity_ref_map s_refs;
+
+static GameStateChurn s_churn;
+static bool           s_static_held;
+static uint32_t       s_sweep_generation;
+
+/* Frame phases: `reading` from game_state_commit() to game_state_frame_end();
+ * `dirty` once a structural write landed since the last commit. */
+static struct {
+    bool reading;
+    bool dirty;
+} s_frame;
+
+/* Every write that adds, removes or moves records goes through here. */
+static void structural_write(void) {
+    assert(!s_frame.reading && "world mirror written after game_state_commit()");
+    s_frame.dirty = true;
+}
+
+void game_state_commit(void) {
+    if (s_frame.dirty) g_game_state.commit_epoch = next_revision();
+    s_frame.dirty   = false;
+    s_frame.reading = true;
+}
+
+void game_state_frame_end(void) {
+    s_frame.reading = false;
+}
+
+/* First allocation of an element pool; later growth doubles. */
+#define POOL_INITIAL_CAPACITY 64
+
+/* Layer-stack pool: fixed chunks so handed-out stacks never move, bump
+ * allocated and rewound with the world objects (chunks are kept). A stack
+ * never straddles chunks, and MAX_OBJECT_LAYERS fits any chunk. */
+#define LAYER_POOL_CHUNK 4096
+
+typedef struct LayerChunk {
+    struct LayerChunk* next;
+    int                used;
+    ObjectLayerState   layers[LAYER_POOL_CHUNK];
+} LayerChunk;
+
+static struct {
+    LayerChunk* head;
+    LayerChunk* cur;
+} s_layer_pool;
+
+/* Grow `*items` to hold `need` elements, up to `max`. False at the bound. */
+static bool pool_reserve(void** items, int* capacity, int need, int max, size_t elem_size) {
+    if (need <= *capacity) return true;
+    if (need > max) return false;
+    int cap = *capacity ? *capacity * 2 : POOL_INITIAL_CAPACITY;
+    if (cap < need) cap = need;
+    if (cap > max)  cap = max;
+    void* grown = realloc(*items, (size_t)cap * elem_size);
+    assert(grown);
+    LOG_DEBUG("[GAME_STATE] pool %zu-byte records -> %d", elem_size, cap);
+    *items    = grown;
+    *capacity = cap;
+    return true;
+}
+
+static void* pool_append(void** items, int* count, int* capacity, int max, size_t elem_size,
+                         int* out_slot) {
+    if (!pool_reserve(items, capacity, *count + 1, max, elem_size)) return NULL;
+    int slot = (*count)++;
+    void* e = (char*)*items + (size_t)slot * elem_size;
+    memset(e, 0, elem_size);
+    if (out_slot) *out_slot = slot;
+    return e;
+}
+
+static void ref_bind(EntityState* e, bool bot, int slot) {
+    e->ref = entity_ref_map_insert(&s_refs, (EntityRef){ .bot = bot, .slot = slot });
+    assert(ENTITY_HANDLE_NONE != e->ref);
+}
+
+static void ref_move(const EntityState* e, int slot) {
+    EntityRef* r = entity_ref_map_get(&s_refs, e->ref);
+    assert(r);
+    r->slot = slot;
+}
+
+static void refs_drop(void* array, size_t elem_size, int from, int count) {
+    for (int i = from; i < count; i++) {
+        EntityState* e = (EntityState*)((char*)array + (size_t)i * elem_size);
+        entity_ref_map_remove(&s_refs, e->ref);
+        e->ref = ENTITY_HANDLE_NONE;
+    }
+}
+
+static void refs_drop_remote(void) {
+    refs_drop(g_game_state.other_players, sizeof(PlayerState), 0, g_game_state.other_player_count);
+    refs_drop(g_game_state.bots, sizeof(BotState), 0, g_game_state.bot_count);
+}
 
 void game_state_reset(void) {
     g_game_state.init_received        = false;
+    g_game_state.wire_ack_caps        = 0;
+    g_game_state.wire_ack_caps_ext    = 0;
     g_game_state.player_id[0]         = '\0';
     g_game_state.instance_code[0]     = '\0';
+    refs_drop_remote();
     g_game_state.other_player_count   = 0;
     g_game_state.bot_count            = 0;
-    g_game_state.resource_count       = 0;
-    g_game_state.obstacle_count       = 0;
-    g_game_state.foreground_count     = 0;
-    g_game_state.static_count         = 0;
-    g_game_state.portal_count         = 0;
-    g_game_state.floor_count          = 0;
+    g_game_state.player_hot.count     = 0;
+    g_game_state.bot_hot.count        = 0;
     g_game_state.full_inventory_count = 0;
+    g_game_state.inventory_version++;
     g_game_state.dead_item_id_count   = 0;
+    g_game_state.id_index_size        = 0;
+    s_static_held                     = false;
+    entity_index_clear(&s_player_index);
+    entity_index_clear(&s_bot_index);
+    game_state_clear_world_objects();
+    spatial_grid_reset(&g_game_state.bot_grid, g_game_state.grid_w, g_game_state.grid_h);
+    game_state_publish_entity_events();
+}
+
+void game_state_clear_static_layer(void) {
+    structural_write();
+    GameState* gs = &g_game_state;
+    gs->obstacle_count   = 0;
+    gs->foreground_count = 0;
+    gs->portal_count     = 0;
+    gs->floor_count      = 0;
+    spatial_grid_reset(&gs->obstacle_grid,   gs->grid_w, gs->grid_h);
+    spatial_grid_reset(&gs->foreground_grid, gs->grid_w, gs->grid_h);
+    spatial_grid_reset(&gs->portal_grid,     gs->grid_w, gs->grid_h);
+    spatial_grid_reset(&gs->floor_grid,      gs->grid_w, gs->grid_h);
+    gs->world_revision = next_revision();
+}
+
+void game_state_hold_static_layer(bool held) {
+    s_static_held = held;
+}
+
+/* A held static layer keeps its stacks outside the pool, so the rewind
+ * below never frees them. */
+void game_state_clear_world_objects(void) {
+    structural_write();
+    GameState* gs = &g_game_state;
+    if (!s_static_held) game_state_clear_static_layer();
+    gs->static_count     = 0;
+    gs->resource_count   = 0;
+    spatial_grid_reset(&gs->static_grid,     gs->grid_w, gs->grid_h);
+    spatial_grid_reset(&gs->resource_grid,   gs->grid_w, gs->grid_h);
+    for (LayerChunk* c = s_layer_pool.head; c; c = c->next) c->used = 0;
+    s_layer_pool.cur = s_layer_pool.head;
+    gs->world_revision = next_revision();
+}
+
+WorldObject* game_state_append_world_object(ObjectLayerType kind, int* out_slot) {
+    structural_write();
+    GameState* gs = &g_game_state;
+    WorldObject** items;
+    int* count;
+    int* capacity;
+    int  max = MAX_OBJECTS;
+    switch (kind) {
+        case OBJECT_LAYER_TYPE_OBSTACLE:
+            items = &gs->obstacles;   count = &gs->obstacle_count;   capacity = &gs->obstacle_capacity;   break;
+        case OBJECT_LAYER_TYPE_FOREGROUND:
+            items = &gs->foregrounds; count = &gs->foreground_count; capacity = &gs->foreground_capacity; break;
+        case OBJECT_LAYER_TYPE_PORTAL:
+            items = &gs->portals;     count = &gs->portal_count;     capacity = &gs->portal_capacity;     break;
+        case OBJECT_LAYER_TYPE_FLOOR:
+            items = &gs->floors;      count = &gs->floor_count;      capacity = &gs->floor_capacity;      break;
+        case OBJECT_LAYER_TYPE_STATIC:
+            /* AOI-bounded like bots, see the statics field. */
+            items = &gs->statics;     count = &gs->static_count;     capacity = &gs->static_capacity;
+            max   = MAX_ENTITIES;
+            break;
+        default:
+            return NULL;
+    }
+    if (s_static_held && OBJECT_LAYER_TYPE_STATIC != kind) return NULL;
+    void* raw = *items;
+    WorldObject* o = pool_append(&raw, count, capacity, max, sizeof(WorldObject), out_slot);
+    *items = raw;
+    if (o) o->type_kind = kind;
+    return o;
+}
+
+BotState* game_state_append_resource(int* out_slot) {
+    structural_write();
+    GameState* gs = &g_game_state;
+    void* raw = gs->resources;
+    BotState* b = pool_append(&raw, &gs->resource_count, &gs->resource_capacity, MAX_ENTITIES,
+                              sizeof(BotState), out_slot);
+    gs->resources = raw;
+    return b;
+}
+
+ObjectLayerState* game_state_alloc_layers(int count) {
+    assert(0 <= count && MAX_OBJECT_LAYERS >= count);
+    structural_write();
+    /* Chunks past `cur` are untouched since the rewind, so the next one
+     * always fits; only the tail needs a fresh chunk. */
+    LayerChunk* c = s_layer_pool.cur;
+    if (c && c->used + count > LAYER_POOL_CHUNK) c = c->next;
+    if (NULL == c) {
+        c = calloc(1, sizeof(LayerChunk));
+        assert(c);
+        if (s_layer_pool.cur) s_layer_pool.cur->next = c;
+        else                  s_layer_pool.head      = c;
+    }
+    s_layer_pool.cur = c;
+    ObjectLayerState* block = &c->layers[c->used];
+    c->used += count;
+    return block;
+}
+
+static void reindex_objects(SpatialGrid* g, const WorldObject* objs, int count) {
+    spatial_grid_reset(g, g_game_state.grid_w, g_game_state.grid_h);
+    for (int i = 0; i < count; i++) {
+        spatial_grid_insert(g, i, (Rectangle){ objs[i].pos.x, objs[i].pos.y,
+                                                objs[i].dims.x, objs[i].dims.y });
+    }
+}
+
+void game_state_reindex_world_objects(void) {
+    structural_write();
+    GameState* gs = &g_game_state;
+    reindex_objects(&gs->obstacle_grid,   gs->obstacles,   gs->obstacle_count);
+    reindex_objects(&gs->foreground_grid, gs->foregrounds, gs->foreground_count);
+    reindex_objects(&gs->static_grid,     gs->statics,     gs->static_count);
+    reindex_objects(&gs->portal_grid,     gs->portals,     gs->portal_count);
+    reindex_objects(&gs->floor_grid,      gs->floors,      gs->floor_count);
+    gs->world_revision = next_revision();
+    spatial_grid_reset(&gs->resource_grid, gs->grid_w, gs->grid_h);
+    for (int i = 0; i < gs->resource_count; i++) {
+        const EntityState* e = &gs->resources[i].base;
+        spatial_grid_insert(&gs->resource_grid, i, (Rectangle){ e->pos_server.x, e->pos_server.y,
+                                                                e->dims.x, e->dims.y });
+    }
+}
+
+void game_state_clear_remote_entities(void) {
+    structural_write();
+    s_churn.left += (uint32_t)(g_game_state.other_player_count + g_game_state.bot_count);
+    refs_drop_remote();
+    g_game_state.other_player_count = 0;
+    g_game_state.bot_count          = 0;
+    entity_index_clear(&s_player_index);
+    entity_index_clear(&s_bot_index);
+}
+
+/* Intern an index key; wire ids longer than the interner holds can't be
+ * looked up by handle, so they stay unindexed. */
+static IdHandle index_key(const char* s) {
+    return (strlen(s) < MAX_ID_LENGTH) ? id_intern(s) : ID_HANDLE_NONE;
+}
+
+void game_state_index_item_rules(void) {
+    GameState* gs = &g_game_state;
+    const EquipmentRules* er = &gs->equipment_rules;
+
+    /* Intern first so the index can be sized to the largest handle. */
+    IdHandle types[MAX_ENTITY_TYPES];
+    IdHandle dead[MAX_DEAD_ITEM_IDS];
+    IdHandle active[MAX_ACTIVE_ITEM_TYPES];
+    IdHandle top = ID_HANDLE_NONE;
+    for (int i = 0; i < gs->entity_defaults_count; i++) {
+        types[i] = index_key(gs->entity_defaults[i].entity_type);
+        if (types[i] > top) top = types[i];
+    }
+    for (int i = 0; i < gs->dead_item_id_count; i++) {
+        dead[i] = index_key(gs->dead_item_ids[i]);
+        if (dead[i] > top) top = dead[i];
+    }
+    for (int i = 0; i < er->active_item_type_count; i++) {
+        active[i] = index_key(er->active_item_types[i]);
+        if (active[i] > top) top = active[i];
+    }
+
+    uint32_t size = top + 1;
+    if (size > gs->id_index_size) {
+        gs->id_flags        = realloc(gs->id_flags, size);
+        gs->id_default_slot = realloc(gs->id_default_slot, size);
+        assert(gs->id_flags && gs->id_default_slot);
+    }
+    gs->id_index_size = size;
+    memset(gs->id_flags, 0, size);
+    memset(gs->id_default_slot, 0, size);
+
+    /* Slot 0 stays unset: ID_HANDLE_NONE never matches. First entry wins,
+     * as the linear scans this replaces did. */
+    for (int i = gs->entity_defaults_count - 1; i >= 0; i--) {
+        if (ID_HANDLE_NONE != types[i]) gs->id_default_slot[types[i]] = (uint8_t)(i + 1);
+    }
+    for (int i = 0; i < gs->dead_item_id_count; i++) {
+        if (ID_HANDLE_NONE != dead[i]) gs->id_flags[dead[i]] |= ITEM_FLAG_DEAD;
+    }
+    for (int i = 0; i < er->active_item_type_count; i++) {
+        if (ID_HANDLE_NONE != active[i]) gs->id_flags[active[i]] |= ITEM_FLAG_ACTIVE_TYPE;
+    }
+}
+
+static void hot_gather(EntityHotSet* hot, const void* array, size_t elem_size, int count) {
+    for (int i = 0; i < count; i++) {
+        const EntityState* e = (const EntityState*)((const char*)array + (size_t)i * elem_size);
+        hot->x[i]             = e->interp_pos.x;
+        hot->y[i]             = e->interp_pos.y;
+        hot->w[i]             = e->dims.x;
+        hot->h[i]             = e->dims.y;
+        hot->prev_x[i]        = e->pos_prev.x;
+        hot->prev_y[i]        = e->pos_prev.y;
+        hot->server_x[i]      = e->pos_server.x;
+        hot->server_y[i]      = e->pos_server.y;
+        hot->snapshot_time[i] = e->snapshot_time;
+        hot->history[i]       = e->history;
+    }
+    hot->count = count;
+}
+
+void game_state_refresh_hot(void) {
+    structural_write();
+    hot_gather(&g_game_state.player_hot, g_game_state.other_players, sizeof(PlayerState),
+               g_game_state.other_player_count);
+    hot_gather(&g_game_state.bot_hot, g_game_state.bots, sizeof(BotState),
+               g_game_state.bot_count);
+
+    const EntityHotSet* bots = &g_game_state.bot_hot;
+    spatial_grid_reset(&g_game_state.bot_grid, g_game_state.grid_w, g_game_state.grid_h);
+    for (int i = 0; i < bots->count; i++) {
+        spatial_grid_insert(&g_game_state.bot_grid, i,
+                            (Rectangle){ bots->x[i], bots->y[i], bots->w[i], bots->h[i] });
+    }
+
+    /* Called once per applied snapshot, so this is also the AOI frame count. */
+    PROFILE_COUNT(PROF_COUNT_AOI_FRAMES, 1);
+    PROFILE_GAUGE(PROF_GAUGE_PLAYERS, g_game_state.other_player_count);
+    PROFILE_GAUGE(PROF_GAUGE_BOTS, g_game_state.bot_count);
+    PROFILE_GAUGE(PROF_GAUGE_WORLD_OBJECTS, game_state_world_object_count());
+}
+
+int game_state_world_object_count(void) {
+    const GameState* gs = &g_game_state;
+    return gs->obstacle_count + gs->foreground_count + gs->static_count +
+           gs->resource_count + gs->portal_count + gs->floor_count;
 }
 
-static GameStateEntityRemovedFn s_entity_removed_cb = NULL;
+/* ── Entity lifecycle events ──────────────────────────────────────────
+ *
+ * What the listeners last saw of each entity, keyed by id. Each publish
+ * walks the live arrays once: unknown ids enter, known ids compare their
+ * layer signature and flags, and ids no longer present leave. */
+
+typedef struct {
+    char     id[MAX_ID_LENGTH];  /* first member: EntityIndex key */
+    uint64_t layers_sig;
+    uint8_t  interaction_flags;
+    uint8_t  status_icon;
+    bool     dead;
+    bool     seen;
+} TrackedEntity;
+
+typedef struct {
+    TrackedEntity records[MAX_ENTITIES];
+    int           count;
+    EntityIndex   index;
+} TrackedSet;
+
+static TrackedSet s_tracked_players = {
+    .index = { .records = s_tracked_players.records, .stride = sizeof(TrackedEntity) },
+};
+static TrackedSet s_tracked_bots = {
+    .index = { .records = s_tracked_bots.records, .stride = sizeof(TrackedEntity) },
+};
+static TrackedEntity s_tracked_self;
+static bool          s_tracked_self_present;
+
+static GameStateEntityEventFn s_entity_listeners[GAME_STATE_MAX_ENTITY_LISTENERS];
+static int                    s_entity_listener_count;
+
+void game_state_add_entity_listener(GameStateEntityEventFn fn) {
+    assert(fn);
+    for (int i = 0; i < s_entity_listener_count; i++) {
+        if (s_entity_listeners[i] == fn) return;
+    }
+    assert(GAME_STATE_MAX_ENTITY_LISTENERS > s_entity_listener_count);
+    s_entity_listeners[s_entity_listener_count++] = fn;
+}
 
-void game_state_set_entity_removed_cb(GameStateEntityRemovedFn cb) {
-    s_entity_removed_cb = cb;
+/* Listeners are the primary view's UI; other views only track. */
+static void entity_event_emit(GameStateEntityEvent ev) {
+    if (!client_context_is_primary()) return;
+    for (int i = 0; i < s_entity_listener_count; i++) s_entity_listeners[i](&ev);
+}
+
+/* FNV-1a over the active item handles, in stack order. */
+static uint64_t layers_signature(const EntityState* e) {
+    uint64_t sig = 14695981039346656037ull;
+    for (int i = 0; i < e->object_layer_count; i++) {
+        if (!e->object_layers[i].active) continue;
+        sig ^= e->object_layers[i].item_handle;
+        sig *= 1099511628211ull;
+    }
+    return sig;
+}
+
+/* Refresh `t` from the live record, emitting the changes a listener has not
+ * seen yet; a fresh record (`entered`) emits ENTER alone. */
+static void tracked_refresh(TrackedEntity* t, bool entered, GameStateEntityEvent ev) {
+    uint64_t sig   = layers_signature(ev.base);
+    uint8_t  flags = ev.bot ? ev.bot->interaction_flags : 0;
+    uint8_t  icon  = ev.base->status_icon;
+    bool     dead  = 0.0f < ev.base->respawn_in;
+    bool layers_changed = sig != t->layers_sig;
+    bool flags_changed  = flags != t->interaction_flags || icon != t->status_icon ||
+                          dead != t->dead;
+    t->layers_sig        = sig;
+    t->interaction_flags = flags;
+    t->status_icon       = icon;
+    t->dead              = dead;
+    t->seen              = true;
+
+    if (entered) {
+        ev.type = GAME_STATE_ENTITY_ENTER;
+        entity_event_emit(ev);
+        return;
+    }
+    if (layers_changed) {
+        ev.type = GAME_STATE_ENTITY_LAYERS;
+        entity_event_emit(ev);
+    }
+    if (flags_changed) {
+        ev.type = GAME_STATE_ENTITY_FLAGS;
+        entity_event_emit(ev);
+    }
+}
+
+static void tracked_publish(TrackedSet* set, const void* array, size_t elem_size, int count,
+                            bool is_player) {
+    for (int i = 0; i < set->count; i++) set->records[i].seen = false;
+
+    for (int i = 0; i < count; i++) {
+        const EntityState* e = (const EntityState*)((const char*)array + (size_t)i * elem_size);
+        hash_t hash = entity_index_hash(e->id);
+        int k = entity_index_find(&set->index, e->id, hash);
+        bool entered = 0 > k;
+        if (entered) {
+            assert(MAX_ENTITIES > set->count);
+            k = set->count++;
+            set->records[k] = (TrackedEntity){ 0 };
+            memcpy(set->records[k].id, e->id, MAX_ID_LENGTH);
+            entity_index_insert(&set->index, hash, k);
+        }
+        tracked_refresh(&set->records[k], entered, (GameStateEntityEvent){
+            .id        = e->id,
+            .base      = e,
+            .bot       = is_player ? NULL : (const BotState*)e,
+            .is_player = is_player,
+        });
+    }
+
+    int write = 0;
+    for (int read = 0; read < set->count; read++) {
+        if (!set->records[read].seen) {
+            entity_event_emit((GameStateEntityEvent){
+                .type      = GAME_STATE_ENTITY_LEAVE,
+                .id        = set->records[read].id,
+                .is_player = is_player,
+            });
+            continue;
+        }
+        if (write != read) set->records[write] = set->records[read];
+        write++;
+    }
+    if (write != set->count) {
+        set->count = write;
+        entity_index_rebuild(&set->index, write);
+    }
+}
+
+static void tracked_publish_self(void) {
+    const GameState* gs = &g_game_state;
+    bool present = '\0' != gs->player_id[0];
+    if (s_tracked_self_present &&
+        (!present || 0 != strcmp(s_tracked_self.id, gs->player_id))) {
+        entity_event_emit((GameStateEntityEvent){
+            .type      = GAME_STATE_ENTITY_LEAVE,
+            .id        = s_tracked_self.id,
+            .is_player = true,
+            .is_self   = true,
+        });
+        s_tracked_self_present = false;
+    }
+    if (!present) return;
+
+    bool entered = !s_tracked_self_present;
+    if (entered) {
+        s_tracked_self = (TrackedEntity){ 0 };
+        strncpy(s_tracked_self.id, gs->player_id, MAX_ID_LENGTH - 1);
+        s_tracked_self_present = true;
+    }
+    tracked_refresh(&s_tracked_self, entered, (GameStateEntityEvent){
+        .id        = gs->player_id,
+        .base      = &gs->player.base,
+        .is_player = true,
+        .is_self   = true,
+    });
+}
+
+void game_state_publish_entity_events(void) {
+    tracked_publish_self();
+    tracked_publish(&s_tracked_players, g_game_state.other_players, sizeof(PlayerState),
+                    g_game_state.other_player_count, true);
+    tracked_publish(&s_tracked_bots, g_game_state.bots, sizeof(BotState),
+                    g_game_state.bot_count, false);
 }
 
 /* Generic entity-slot ops over a parallel array of fixed-size records whose
@@ -44,86 +569,239 @@ static void* slot_at(void* array, size_t elem_size, int i) {
     return (char*)array + (size_t)i * elem_size;
 }
 
-static int entity_slot_update(void* array, size_t elem_size, int* count, int max,
-                              const void* incoming, const char* dbg_name) {
+/* Make room for one more record, re-pointing the index at a moved pool. */
+static bool entity_slot_reserve(EntityIndex* ix, void** array, int* capacity, int count,
+                                int max, size_t elem_size) {
+    if (!pool_reserve(array, capacity, count + 1, max, elem_size)) return false;
+    ix->records = *array;
+    return true;
+}
+
+static int entity_slot_update(EntityIndex* ix, bool bot, void** pool, int* capacity,
+                              size_t elem_size, int* count, int max, const void* incoming,
+                              const char* dbg_name) {
     const EntityState* in = incoming;
-    for (int i = 0; i < *count; i++) {
-        EntityState* e = slot_at(array, elem_size, i);
-        if (0 == strcmp(e->id, in->id)) {
-            Vector2 prev = e->interp_pos;
-            memcpy(e, incoming, elem_size);
-            e->pos_prev   = prev;
-            e->interp_pos = prev;
-            return 0;
-        }
+    hash_t hash = entity_index_hash(in->id);
+    int i = entity_index_find(ix, in->id, hash);
+    if (0 <= i) {
+        EntityState* e = slot_at(*pool, elem_size, i);
+        Vector2 prev = e->interp_pos;
+        EntityHandle ref = e->ref;
+        memcpy(e, incoming, elem_size);
+        e->pos_prev   = prev;
+        e->interp_pos = prev;
+        e->ref        = ref;
+        return 0;
     }
-    if (*count >= max) {
-        LOG_WARN("%s full — dropping update for %s", dbg_name, in->id);
+    if (!entity_slot_reserve(ix, pool, capacity, *count, max, elem_size)) {
+        LOG_WARN_HOT("%s full — dropping update for %s", dbg_name, in->id);
         return -1;
     }
-    memcpy(slot_at(array, elem_size, *count), incoming, elem_size);
+    EntityState* e = slot_at(*pool, elem_size, *count);
+    memcpy(e, incoming, elem_size);
+    ref_bind(e, bot, *count);
+    entity_index_insert(ix, hash, *count);
     (*count)++;
+    s_churn.entered++;
     return 0;
 }
 
-static void entity_slot_remove(void* array, size_t elem_size, int* count, const char* id) {
-    for (int i = 0; i < *count; i++) {
-        EntityState* e = slot_at(array, elem_size, i);
-        if (0 == strcmp(e->id, id)) {
-            memmove(slot_at(array, elem_size, i),
-                    slot_at(array, elem_size, i + 1),
-                    (size_t)(*count - 1 - i) * elem_size);
-            (*count)--;
-            if (s_entity_removed_cb) { s_entity_removed_cb(id); }
-            return;
-        }
-    }
+static void* entity_slot_acquire(EntityIndex* ix, bool bot, void** pool, int* capacity,
+                                 size_t elem_size, int* count, int max, const char* id,
+                                 hash_t hash) {
+    int i = entity_index_find(ix, id, hash);
+    if (0 <= i) { return slot_at(*pool, elem_size, i); }
+    if (!entity_slot_reserve(ix, pool, capacity, *count, max, elem_size)) { return NULL; }
+    EntityState* e = slot_at(*pool, elem_size, *count);
+    memset(e, 0, elem_size);
+    strncpy(e->id, id, MAX_ID_LENGTH - 1);
+    ref_bind(e, bot, *count);
+    entity_index_insert(ix, hash, *count);
+    (*count)++;
+    s_churn.entered++;
+    return e;
+}
+
+static void entity_slot_remove(EntityIndex* ix, void* array, size_t elem_size, int* count,
+                               const char* id) {
+    int i = entity_index_find(ix, id, entity_index_hash(id));
+    if (0 > i) { return; }
+    refs_drop(array, elem_size, i, i + 1);
+    memmove(slot_at(array, elem_size, i),
+            slot_at(array, elem_size, i + 1),
+            (size_t)(*count - 1 - i) * elem_size);
+    (*count)--;
+    for (int j = i; j < *count; j++) ref_move(slot_at(array, elem_size, j), j);
+    entity_index_rebuild(ix, *count);
+    s_churn.left++;
+}
+
+GameStateChurn game_state_churn(void) {
+    return s_churn;
 }
 
 PlayerState* game_state_find_player(const char* id) {
     assert(id);
-    for (int i = 0; i < g_game_state.other_player_count; i++) {
-        if (strcmp(g_game_state.other_players[i].base.id, id) == 0)
-            return &g_game_state.other_players[i];
-    }
-    return NULL;
+    int i = entity_index_find(&s_player_index, id, entity_index_hash(id));
+    return (0 <= i) ? &g_game_state.other_players[i] : NULL;
 }
 
 BotState* game_state_find_bot(const char* id) {
     assert(id);
-    for (int i = 0; i < g_game_state.bot_count; i++) {
-        if (strcmp(g_game_state.bots[i].base.id, id) == 0)
-            return &g_game_state.bots[i];
-    }
-    return NULL;
+    int i = entity_index_find(&s_bot_index, id, entity_index_hash(id));
+    return (0 <= i) ? &g_game_state.bots[i] : NULL;
+}
+
+PlayerState* game_state_player_by_handle(EntityHandle h) {
+    const EntityRef* r = entity_ref_map_get(&s_refs, h);
+    if (!r || r->bot) return NULL;
+    assert(r->slot < g_game_state.other_player_count);
+    return &g_game_state.other_players[r->slot];
+}
+
+BotState* game_state_bot_by_handle(EntityHandle h) {
+    const EntityRef* r = entity_ref_map_get(&s_refs, h);
+    if (!r || !r->bot) return NULL;
+    assert(r->slot < g_game_state.bot_count);
+    return &g_game_state.bots[r->slot];
+}
+
+PlayerState* game_state_acquire_player(const char* id, hash_t hash) {
+    assert(id);
+    structural_write();
+    void* pool = g_game_state.other_players;
+    PlayerState* p = entity_slot_acquire(&s_player_index, false, &pool,
+                                         &g_game_state.other_player_capacity, sizeof(PlayerState),
+                                         &g_game_state.other_player_count, MAX_ENTITIES, id, hash);
+    g_game_state.other_players = pool;
+    return p;
+}
+
+BotState* game_state_acquire_bot(const char* id, hash_t hash) {
+    assert(id);
+    structural_write();
+    void* pool = g_game_state.bots;
+    BotState* b = entity_slot_acquire(&s_bot_index, true, &pool, &g_game_state.bot_capacity,
+                                      sizeof(BotState), &g_game_state.bot_count, MAX_ENTITIES,
+                                      id, hash);
+    g_game_state.bots = pool;
+    return b;
 }
 
 int game_state_update_player(const PlayerState* player) {
     assert(player);
-    return entity_slot_update(g_game_state.other_players, sizeof(PlayerState),
-                              &g_game_state.other_player_count, MAX_ENTITIES,
-                              player, "other_players");
+    structural_write();
+    void* pool = g_game_state.other_players;
+    int rc = entity_slot_update(&s_player_index, false, &pool, &g_game_state.other_player_capacity,
+                                sizeof(PlayerState), &g_game_state.other_player_count,
+                                MAX_ENTITIES, player, "other_players");
+    g_game_state.other_players = pool;
+    return rc;
 }
 
 int game_state_update_bot(const BotState* bot) {
     assert(bot);
-    return entity_slot_update(g_game_state.bots, sizeof(BotState),
-                              &g_game_state.bot_count, MAX_ENTITIES,
-                              bot, "bots");
+    structural_write();
+    void* pool = g_game_state.bots;
+    int rc = entity_slot_update(&s_bot_index, true, &pool, &g_game_state.bot_capacity,
+                                sizeof(BotState), &g_game_state.bot_count, MAX_ENTITIES,
+                                bot, "bots");
+    g_game_state.bots = pool;
+    return rc;
+}
+
+uint32_t game_state_begin_entity_sweep(void) {
+    if (0 == ++s_sweep_generation) s_sweep_generation = 1;   /* 0 = never stamped */
+    return s_sweep_generation;
+}
+
+/* Keep the records stamped with `generation`, in order. */
+static void entity_slot_sweep(EntityIndex* ix, void* array, size_t elem_size, int* count,
+                              uint32_t generation) {
+    int write = 0;
+    for (int read = 0; read < *count; read++) {
+        const EntityState* e = slot_at(array, elem_size, read);
+        if (generation != e->seen_generation) {
+            refs_drop(array, elem_size, read, read + 1);
+            s_churn.left++;
+            continue;
+        }
+        if (write != read) {
+            memcpy(slot_at(array, elem_size, write), e, elem_size);
+            ref_move(e, write);
+        }
+        write++;
+    }
+    if (write != *count) {
+        *count = write;
+        entity_index_rebuild(ix, write);
+    }
+}
+
+void game_state_end_entity_sweep(void) {
+    structural_write();
+    entity_slot_sweep(&s_player_index, g_game_state.other_players, sizeof(PlayerState),
+                      &g_game_state.other_player_count, s_sweep_generation);
+    entity_slot_sweep(&s_bot_index, g_game_state.bots, sizeof(BotState),
+                      &g_game_state.bot_count, s_sweep_generation);
 }
 
 void game_state_remove_player(const char* id) {
     assert(id);
-    entity_slot_remove(g_game_state.other_players, sizeof(PlayerState),
+    structural_write();
+    entity_slot_remove(&s_player_index, g_game_state.other_players, sizeof(PlayerState),
                        &g_game_state.other_player_count, id);
 }
 
 void game_state_remove_bot(const char* id) {
     assert(id);
-    entity_slot_remove(g_game_state.bots, sizeof(BotState),
+    structural_write();
+    entity_slot_remove(&s_bot_index, g_game_state.bots, sizeof(BotState),
                        &g_game_state.bot_count, id);
 }
 
 void game_state_toggle_dev_ui(void) {
     presentation_runtime_toggle_dev_ui();
 }
+
+void game_state_view_init(GameState* gs) {
+    assert(gs);
+    memset(gs, 0, sizeof(*gs));
+    gs->world_revision = next_revision();
+    gs->commit_epoch   = next_revision();
+}
+
+/* Heap of the bound view's world, when its context is destroyed. */
+static void release_view(void) {
+    GameState* gs = &g_game_state;
+    free(gs->other_players);
+    free(gs->bots);
+    free(gs->obstacles);
+    free(gs->foregrounds);
+    free(gs->statics);
+    free(gs->resources);
+    free(gs->portals);
+    free(gs->floors);
+    free(gs->id_flags);
+    free(gs->id_default_slot);
+    for (LayerChunk* c = s_layer_pool.head; c;) {
+        LayerChunk* next = c->next;
+        free(c);
+        c = next;
+    }
+}
+
+void game_state_context_register(void) {
+    client_context_register(&s_player_index,         sizeof(s_player_index),         NULL);
+    client_context_register(&s_bot_index,            sizeof(s_bot_index),            NULL);
+    client_context_register(&s_refs,                 sizeof(s_refs),                 NULL);
+    client_context_register(&s_churn,                sizeof(s_churn),                NULL);
+    client_context_register(&s_static_held,          sizeof(s_static_held),          NULL);
+    client_context_register(&s_sweep_generation,     sizeof(s_sweep_generation),     NULL);
+    client_context_register(&s_frame,                sizeof(s_frame),                NULL);
+    client_context_register(&s_layer_pool,           sizeof(s_layer_pool),           release_view);
+    client_context_register(&s_tracked_players,      sizeof(s_tracked_players),      NULL);
+    client_context_register(&s_tracked_bots,         sizeof(s_tracked_bots),         NULL);
+    client_context_register(&s_tracked_self,         sizeof(s_tracked_self),         NULL);
+    client_context_register(&s_tracked_self_present, sizeof(s_tracked_self_present), NULL);
+}
@@ -8,7 +8,10 @@
 #include <stddef.h>
 #include <string.h>
 
+#include "hash_table.h"
+#include "id_intern.h"
 #include "object_layer.h"
+#include "spatial_grid.h"
 #include "world_types.h"
 
 /**
@@ -44,6 +47,32 @@
 
 typedef struct GameState GameState;
 
+/* Bits of g_game_state.id_flags, set on the interned id they describe by
+ * game_state_index_item_rules(). */
+#define ITEM_FLAG_DEAD        0x01u   /* item id is in dead_item_ids */
+#define ITEM_FLAG_ACTIVE_TYPE 0x02u   /* item type is in equipment_rules */
+
+/* Packed per-slot copy of the fields the per-frame loops stream over —
+ * interpolation, depth keys, hit tests — parallel to other_players / bots.
+ * PlayerState and BotState run to kilobytes each, so walking the records
+ * costs a cache miss per entity; these arrays keep each field contiguous.
+ * game_state_refresh_hot() gathers them from the records after every AOI
+ * frame. x/y is the interpolated position: interpolation_compute_view
+ * writes it here and mirrors it into the record's interp_pos. */
+typedef struct {
+    int             count;
+    float           x[MAX_ENTITIES];
+    float           y[MAX_ENTITIES];
+    float           w[MAX_ENTITIES];
+    float           h[MAX_ENTITIES];
+    float           prev_x[MAX_ENTITIES];
+    float           prev_y[MAX_ENTITIES];
+    float           server_x[MAX_ENTITIES];
+    float           server_y[MAX_ENTITIES];
+    double          snapshot_time[MAX_ENTITIES];
+    SnapshotHistory history[MAX_ENTITIES];
+} EntityHotSet;
+
 typedef struct {
     char active_item_types[MAX_ACTIVE_ITEM_TYPES][32];
     int  active_item_type_count;
@@ -79,35 +108,76 @@ struct GameState {
 
     PlayerState player;
 
-    PlayerState other_players[MAX_ENTITIES];
+    /* Entity and world-object arrays are heap pools that grow (doubling,
+     * capped at the MAX_* bound) as a frame needs slots, so memory follows
+     * the instance actually loaded rather than the worst case. Records may
+     * move when a pool grows: keep indices, not pointers, across appends. */
+    PlayerState* other_players;
     int other_player_count;
+    int other_player_capacity;
 
-    BotState bots[MAX_ENTITIES];
+    BotState* bots;
     int bot_count;
+    int bot_capacity;
 
-    WorldObject obstacles[MAX_OBJECTS];
+    EntityHotSet player_hot;       /* parallel to other_players */
+    EntityHotSet bot_hot;          /* parallel to bots */
+    SpatialGrid  bot_grid;         /* over bot_hot, rebuilt with it */
+
+    WorldObject* obstacles;
     int obstacle_count;
+    int obstacle_capacity;
 
-    WorldObject foregrounds[MAX_OBJECTS];
+    WorldObject* foregrounds;
     int foreground_count;
+    int foreground_capacity;
 
     /* Static decorators — non-moving, passable; depth-sorted with entities.
      * AOI-bounded like bots/resources, so sized MAX_ENTITIES (not MAX_OBJECTS,
      * which is reserved for full-map-tiling objects like floors). */
-    WorldObject statics[MAX_ENTITIES];
+    WorldObject* statics;
     int static_count;
+    int static_capacity;
 
-    BotState resources[MAX_ENTITIES];
+    BotState* resources;
     int resource_count;
+    int resource_capacity;
 
-    WorldObject portals[MAX_OBJECTS];
+    WorldObject* portals;
     int portal_count;
+    int portal_capacity;
 
-    WorldObject floors[MAX_OBJECTS];
+    WorldObject* floors;
     int floor_count;
+    int floor_capacity;
+
+    /* Spatial indexes over the world-object arrays (slot = array index),
+     * filled by the decoder as objects are appended and emptied with them
+     * by game_state_clear_world_objects(). */
+    SpatialGrid obstacle_grid;
+    SpatialGrid foreground_grid;
+    SpatialGrid static_grid;
+    SpatialGrid resource_grid;
+    SpatialGrid portal_grid;
+    SpatialGrid floor_grid;
+    /* Bumped whenever the world-object arrays are cleared or reindexed;
+     * caches derived from them compare it to spot a rebuild. */
+    uint32_t    world_revision;
+    /* Bumped by game_state_commit() when the frame's decode added, removed
+     * or moved entity or world-object records. A pointer or slot index into
+     * any pool stays valid while it is unchanged, so readers may cache them
+     * across frames keyed on it. */
+    uint32_t    commit_epoch;
 
     int sum_stats_limit;
     int active_stats_sum;
+    /* Bumped by the self-player decode when that section actually changed:
+     * the two stats above, player.map_code, the dev-overlay path. Cheap
+     * invalidation keys for UI caches (equipment has player.base.layers_version,
+     * the inventory inventory_version). */
+    uint32_t stats_version;
+    uint32_t map_version;
+    uint32_t path_version;
 
     int player_coins;
 
@@ -115,20 +185,43 @@ struct GameState {
 
     ObjectLayerState full_inventory[MAX_OBJECT_LAYERS];
     int full_inventory_count;
+    /* Bumped whenever full_inventory changes; the inventory view model
+     * rebuilds when it moves. */
+    uint32_t inventory_version;
 
     /* Dead-state (Fragmentation) item ids from init_data. Visible in the
      * inventory but never equippable; the default id is server-filtered. */
     char dead_item_ids[MAX_DEAD_ITEM_IDS][128];
     int  dead_item_id_count;
 
+    /* Lookup index over the init_data / metadata tables above, keyed by
+     * IdHandle: id_flags[h] holds ITEM_FLAG_* bits and id_default_slot[h]
+     * the entity_defaults slot + 1 (0 = none). Handles past id_index_size
+     * were interned later and carry neither. */
+    uint8_t* id_flags;
+    uint8_t* id_default_slot;
+    uint32_t id_index_size;
+
     bool init_received;
+    uint8_t wire_ack_caps;         /* WIRE_CAP_* the server accepted (BIN_MSG_WIRE_ACK) */
+    uint8_t wire_ack_caps_ext;     /* WIRE_CAP_EXT_* it accepted */
     double last_update_time;       /* wall-clock arrival of the latest snapshot */
     uint32_t last_snapshot_tick;   /* mirror of session_server_tick_estimate() */
 
     char pending_error[256];
 };
 
-extern GameState g_game_state;
+/* The bound view's mirror (client_context.h): the primary one unless a
+ * secondary view is bound. */
+extern GameState* g_game_state_view;
+#define g_game_state (*g_game_state_view)
+
+/* Empty mirror for a new view, its revisions fresh so no cache built for
+ * another view matches them. For client_context.c. */
+void         game_state_view_init(GameState* gs);
+
+/* Hand the per-view statics of game_state.c to client_context. */
+void         game_state_context_register(void);
 
 /** Clear the world mirror to its post-disconnect defaults: drops init flag,
  *  player id, and all entity/object counts. The single entry point for
@@ -136,29 +229,151 @@ extern GameState g_game_state;
  *  count fields directly. */
 void         game_state_reset(void);
 
+/** Frame phases of the world mirror. Decoding (and every structural
+ *  writer below) runs before game_state_commit(); from there until
+ *  game_state_frame_end() the mirror is a read-only view that no count,
+ *  pool or index changes under, so render recipes and UI may hold record
+ *  pointers for the rest of the frame. Structural writes in the read phase
+ *  assert. Callers that never commit (host benches) are unaffected. */
+void         game_state_commit(void);
+void         game_state_frame_end(void);
+
+/** Id lookups and writes over other_players / bots go through a hashed
+ *  id → slot index, so each is O(1) regardless of AOI population. */
 PlayerState* game_state_find_player(const char* id);
 BotState*    game_state_find_bot(const char* id);
+
+/** Records behind handles taken from base.ref: O(1), NULL once the record
+ *  left (or for a handle of the other kind). Unlike a pointer or slot
+ *  index, a handle survives removals and sweeps, so caches may key on it
+ *  across frames. */
+PlayerState* game_state_player_by_handle(EntityHandle h);
+BotState*    game_state_bot_by_handle(EntityHandle h);
+
+/** Find-or-append the slot for `id` (hash = entity_index_hash(id)). A new
+ *  slot comes back zeroed with only the id set; NULL when the array is full. */
+PlayerState* game_state_acquire_player(const char* id, hash_t hash);
+BotState*    game_state_acquire_bot(const char* id, hash_t hash);
+
+/** Drop every remote player and bot. */
+void         game_state_clear_remote_entities(void);
+
+/** Full AOI frames update players and bots in place: begin hands out a new
+ *  generation, the decoder stamps each listed record's base.seen_generation
+ *  with it, and end removes every unstamped record in one compaction pass.
+ *  The next game_state_publish_entity_events() reports them as LEAVE. */
+uint32_t     game_state_begin_entity_sweep(void);
+void         game_state_end_entity_sweep(void);
+
+/** Drop every world object (obstacles, foregrounds, statics, resources,
+ *  portals, floors) and empty their spatial grids, sized for the current
+ *  grid_w × grid_h. While the static layer is held, floors, obstacles,
+ *  portals and foregrounds stay. */
+void         game_state_clear_world_objects(void);
+
+/** The static layer — floors, obstacles, portals, foregrounds — owned by
+ *  static_world.h. While held, game_state_clear_world_objects() keeps it
+ *  and appends of those kinds come back NULL, so AOI decoders skip any such
+ *  block. game_state_reset() releases it. */
+void         game_state_hold_static_layer(bool held);
+
+/** Drop the static layer alone, held or not. */
+void         game_state_clear_static_layer(void);
+
+/** Append a zeroed world object of `kind` (obstacle, foreground, static,
+ *  portal or floor) with type_kind set, growing its pool as needed. Writes
+ *  the slot index to *out_slot when non-NULL. NULL when the pool is at its
+ *  MAX_* bound or `kind` has no world-object array. */
+WorldObject* game_state_append_world_object(ObjectLayerType kind, int* out_slot);
+
+/** Append a zeroed resource record; same contract as above. */
+BotState*    game_state_append_resource(int* out_slot);
+
+/** Layer stack for a world object appended this frame: `count` contiguous
+ *  entries from a pool shared by every world object and rewound by
+ *  game_state_clear_world_objects(). Entries are not zeroed; blocks never
+ *  move until the rewind. */
+ObjectLayerState* game_state_alloc_layers(int count);
+
+/** Rebuild every world-object grid from the arrays, for writers that fill
+ *  the arrays without indexing as they go. */
+void         game_state_reindex_world_objects(void);
+
+/** Re-gather player_hot / bot_hot (and bot_grid) from the records. Called once a whole AOI
+ *  frame has been applied; the hot sets are stale in between. */
+void         game_state_refresh_hot(void);
+
+/** Obstacles, foregrounds, statics, resources, portals and floors together. */
+int          game_state_world_object_count(void);
+
 int          game_state_update_player(const PlayerState* player);
 int          game_state_update_bot(const BotState* bot);
 void         game_state_remove_player(const char* id);
 void         game_state_remove_bot(const char* id);
 
-/** Observer fired when an entity is removed from the world mirror (left AOI).
- *  Lets the presentation layer release per-entity resources (e.g. animation
- *  states) without game_state depending on render modules. */
-typedef void (*GameStateEntityRemovedFn)(const char* id);
-void         game_state_set_entity_removed_cb(GameStateEntityRemovedFn cb);
+/** Remote players and bots that entered / left the mirror since startup
+ *  (monotonic; replay benches diff it per frame). */
+typedef struct {
+    uint32_t entered;
+    uint32_t left;
+} GameStateChurn;
+GameStateChurn game_state_churn(void);
+
+/** Entity lifecycle events: remote players, bots and the self-player as
+ *  they enter or leave the world mirror, or change their active layer set,
+ *  interaction flags, status icon or dead/alive state. Published once per applied AOI
+ *  frame by diffing the mirror against the previous frame, so a full-frame
+ *  rebuild only reports what actually changed. Lets the presentation layer
+ *  keep per-entity caches in step without game_state depending on render
+ *  modules or polling the whole world every frame. */
+typedef enum {
+    GAME_STATE_ENTITY_ENTER,
+    GAME_STATE_ENTITY_LEAVE,
+    GAME_STATE_ENTITY_LAYERS,   /* active layer set changed  */
+    GAME_STATE_ENTITY_FLAGS,    /* interaction_flags, status_icon or death */
+} GameStateEntityEventType;
+
+typedef struct {
+    GameStateEntityEventType type;
+    const char*              id;
+    const EntityState*       base;      /* NULL on LEAVE                    */
+    const BotState*          bot;       /* NULL for players and on LEAVE    */
+    bool                     is_player; /* remote player or the self-player */
+    bool                     is_self;
+} GameStateEntityEvent;
+
+/** Pointers in the event are valid for the duration of the call only. */
+typedef void (*GameStateEntityEventFn)(const GameStateEntityEvent* ev);
+
+/** Register a listener (idempotent); at most GAME_STATE_MAX_ENTITY_LISTENERS. */
+#define GAME_STATE_MAX_ENTITY_LISTENERS 4
+void         game_state_add_entity_listener(GameStateEntityEventFn fn);
+
+/** Diff the mirror against the last publish and notify listeners: the
+ *  self-player first, then remote players, then bots. Decoders call it once
+ *  a whole frame (self block included) has been applied. */
+void         game_state_publish_entity_events(void);
 
 /** Toggle the client-owned dev-overlay flag. The toggle delegates to
  *  presentation_runtime so the value stays a single source of truth. */
 void game_state_toggle_dev_ui(void);
 
+/** Rebuild the id_flags / id_default_slot index from entity_defaults,
+ *  dead_item_ids and equipment_rules. Every writer of those tables calls it
+ *  once they are filled (init_data, metadata), so the lookups below never
+ *  scan them. */
+void game_state_index_item_rules(void);
+
+/* ITEM_FLAG_* bits of an interned item id or item type. */
+static inline uint8_t game_state_item_flags(IdHandle h) {
+    return (h < g_game_state.id_index_size) ? g_game_state.id_flags[h] : 0;
+}
+
 static inline const EntityTypeDefault* game_state_get_entity_default(const char* entity_type) {
-    for (int i = 0; i < g_game_state.entity_defaults_count; i++) {
-        if (strcmp(g_game_state.entity_defaults[i].entity_type, entity_type) == 0)
-            return &g_game_state.entity_defaults[i];
-    }
-    return NULL;
+    if (NULL == entity_type || '\0' == entity_type[0]) return NULL;
+    IdHandle h = id_intern_find(entity_type);
+    if (h >= g_game_state.id_index_size || 0 == g_game_state.id_default_slot[h]) return NULL;
+    return &g_game_state.entity_defaults[g_game_state.id_default_slot[h] - 1];
 }
 
 static inline int game_state_get_player_coins(void) {
@@ -169,19 +384,12 @@ static inline int game_state_get_player_coins(void) {
  * manifestation the player can hold but never equip. */
 static inline bool game_state_is_dead_item(const char* item_id) {
     if (NULL == item_id || '\0' == item_id[0]) return false;
-    for (int i = 0; i < g_game_state.dead_item_id_count; i++) {
-        if (0 == strcmp(g_game_state.dead_item_ids[i], item_id)) return true;
-    }
-    return false;
+    return 0 != (game_state_item_flags(id_intern_find(item_id)) & ITEM_FLAG_DEAD);
 }
 
 static inline bool game_state_is_active_item_type(const char* item_type) {
     if (!item_type || item_type[0] == '\0') return false;
-    for (int i = 0; i < g_game_state.equipment_rules.active_item_type_count; i++) {
-        if (strcmp(g_game_state.equipment_rules.active_item_types[i], item_type) == 0)
-            return true;
-    }
-    return false;
+    return 0 != (game_state_item_flags(id_intern_find(item_type)) & ITEM_FLAG_ACTIVE_TYPE);
 }
 
 #endif /* GAME_STATE_H */
@@ -0,0 +1,128 @@
+#include "gpu_memory.h"
+
+#include "util/log.h"
+
+#include <assert.h>
+
+#define GPU_MEMORY_SWEEP_SECONDS 1.0
+
+/* Relief passes: idle thresholds in seconds, coldest first. The last pass
+ * takes anything, down to entries drawn this frame. */
+static const double RELIEF_IDLE_PASSES[] = { 60.0, 20.0, 5.0, 0.0 };
+
+static struct {
+    size_t       budget;
+    size_t       pools[GPU_MEM_POOL_COUNT];
+    size_t       used;
+    double       downsample_idle;
+    double       last_sweep;
+    bool         over_logged;
+    int          client_count;
+    GpuMemClient clients[GPU_MEMORY_MAX_CLIENTS];
+} g_gpu_memory;
+
+void gpu_memory_set_budget(size_t bytes) {
+    g_gpu_memory.budget = bytes;
+}
+
+size_t gpu_memory_budget(void) {
+    return g_gpu_memory.budget;
+}
+
+void gpu_memory_set_downsample_idle(double seconds) {
+    assert(0.0 <= seconds);
+    g_gpu_memory.downsample_idle = seconds;
+}
+
+size_t gpu_memory_texture_bytes(Texture2D texture) {
+    size_t bytes = 0;
+    int    w = texture.width, h = texture.height;
+    for (int level = 0; level < (texture.mipmaps > 1 ? texture.mipmaps : 1); level++) {
+        bytes += (size_t)GetPixelDataSize(w, h, texture.format);
+        w = w > 1 ? w / 2 : 1;
+        h = h > 1 ? h / 2 : 1;
+    }
+    return bytes;
+}
+
+void gpu_memory_add(GpuMemPool pool, size_t bytes) {
+    assert(0 <= pool && GPU_MEM_POOL_COUNT > pool);
+    g_gpu_memory.pools[pool] += bytes;
+    g_gpu_memory.used        += bytes;
+}
+
+void gpu_memory_sub(GpuMemPool pool, size_t bytes) {
+    assert(0 <= pool && GPU_MEM_POOL_COUNT > pool);
+    assert(g_gpu_memory.pools[pool] >= bytes);
+    g_gpu_memory.pools[pool] -= bytes;
+    g_gpu_memory.used        -= bytes;
+}
+
+size_t gpu_memory_used(void) {
+    return g_gpu_memory.used;
+}
+
+size_t gpu_memory_pool_bytes(GpuMemPool pool) {
+    assert(0 <= pool && GPU_MEM_POOL_COUNT > pool);
+    return g_gpu_memory.pools[pool];
+}
+
+void gpu_memory_add_client(GpuMemClient client) {
+    assert(client.relieve);
+    assert(GPU_MEMORY_MAX_CLIENTS > g_gpu_memory.client_count);
+    g_gpu_memory.clients[g_gpu_memory.client_count++] = client;
+}
+
+void gpu_memory_remove_client(const void* user) {
+    int kept = 0;
+    for (int i = 0; i < g_gpu_memory.client_count; i++) {
+        if (user != g_gpu_memory.clients[i].user) {
+            g_gpu_memory.clients[kept++] = g_gpu_memory.clients[i];
+        }
+    }
+    g_gpu_memory.client_count = kept;
+}
+
+static void downsample_sweep(void) {
+    double now = GetTime();
+    if (now - g_gpu_memory.last_sweep < GPU_MEMORY_SWEEP_SECONDS) return;
+    g_gpu_memory.last_sweep = now;
+
+    size_t freed = 0;
+    for (int i = 0; i < g_gpu_memory.client_count; i++) {
+        const GpuMemClient* c = &g_gpu_memory.clients[i];
+        if (c->downsample) freed += c->downsample(c->user, g_gpu_memory.downsample_idle);
+    }
+    if (freed > 0) LOG_INFO("[GPU MEM] downsampled idle textures: %zu KB freed", freed / 1024);
+}
+
+static void relieve_pressure(void) {
+    size_t freed = 0;
+    for (size_t p = 0; p < sizeof(RELIEF_IDLE_PASSES) / sizeof(RELIEF_IDLE_PASSES[0]); p++) {
+        for (int i = 0; i < g_gpu_memory.client_count; i++) {
+            if (g_gpu_memory.used <= g_gpu_memory.budget) break;
+            const GpuMemClient* c = &g_gpu_memory.clients[i];
+            freed += c->relieve(c->user, g_gpu_memory.used - g_gpu_memory.budget,
+                                RELIEF_IDLE_PASSES[p]);
+        }
+    }
+    if (freed > 0) LOG_INFO("[GPU MEM] over budget: %zu KB freed", freed / 1024);
+
+    /* What is left is in use (pages, fonts, this frame's textures). Say so
+     * once per excursion instead of every frame. */
+    bool over = g_gpu_memory.used > g_gpu_memory.budget;
+    if (over && !g_gpu_memory.over_logged) {
+        LOG_WARN("[GPU MEM] %zu KB in use exceeds the %zu KB budget",
+                 g_gpu_memory.used / 1024, g_gpu_memory.budget / 1024);
+    }
+    g_gpu_memory.over_logged = over;
+}
+
+void gpu_memory_update(void) {
+    if (g_gpu_memory.downsample_idle > 0.0) downsample_sweep();
+    if (g_gpu_memory.budget > 0 && g_gpu_memory.used > g_gpu_memory.budget) {
+        relieve_pressure();
+    } else {
+        g_gpu_memory.over_logged = false;
+    }
+}
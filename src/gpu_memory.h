@@ -0,0 +1,84 @@
+#ifndef CYBERIA_GPU_MEMORY_H
+#define CYBERIA_GPU_MEMORY_H
+
+#include <raylib.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/*
+ * Global texture-memory accountant.
+ *
+ * WebGL on phones falls over past a few hundred MB of textures, and no one
+ * cache sees the whole picture. Every long-lived texture owner reports what
+ * it uploads and frees under a pool, and caches that can give memory back
+ * register a client. Once per frame gpu_memory_update():
+ *
+ *  - when the downsample tier is on (gpu_memory_set_downsample_idle), asks
+ *    clients to swap textures not touched for that long for half-resolution
+ *    copies (a quarter of the memory);
+ *  - while over budget, asks clients to drop entries idle for a long time,
+ *    then progressively less, until the total fits. Cold entries of every
+ *    cache go before warm entries of any.
+ *
+ * Sizes are estimates: the pixel data size of the texture's format (4
+ * bytes a pixel uncompressed, ½–1 for block-compressed), mipmaps and
+ * driver padding ignored. Standalone: depends only on raylib.
+ */
+
+typedef enum {
+    GPU_MEM_ATLAS_CACHE,    /* standalone atlas textures */
+    GPU_MEM_ATLAS_PAGES,    /* shared atlas pages */
+    GPU_MEM_UI_ICONS,
+    GPU_MEM_PREVIEWS,       /* instance-map previews */
+    GPU_MEM_FONTS,
+    GPU_MEM_SPLASH,
+    GPU_MEM_LABELS,         /* overhead label atlas */
+    GPU_MEM_FCT_DIGITS,     /* floating combat text digit strip */
+    GPU_MEM_UI_PANELS,      /* retained modal panels */
+    GPU_MEM_UI_MESHES,      /* retained vector scenes */
+    GPU_MEM_IMPOSTORS,      /* composited entity layer stacks */
+    GPU_MEM_WORLD_TARGET,   /* low-resolution world pass (world_target.h) */
+    GPU_MEM_UI_SKINS,       /* nine-slice chrome page (ui/ui_skin.h) */
+    GPU_MEM_FG_MASK,        /* foreground occlusion mask (fg_occlusion.h) */
+    GPU_MEM_MINIMAP,        /* baked map overview (ui/minimap.h) */
+    GPU_MEM_POOL_COUNT
+} GpuMemPool;
+
+/* A cache that can give memory back. Both return the bytes they freed.
+ * relieve — drop entries idle for at least `min_idle` seconds, coldest
+ *           first, until `want` bytes are freed or none qualify.
+ * downsample — optional (NULL): swap textures idle for at least
+ *           `min_idle` seconds for half-resolution copies. */
+typedef struct {
+    size_t (*relieve)(void* user, size_t want, double min_idle);
+    size_t (*downsample)(void* user, double min_idle);
+    void*   user;
+} GpuMemClient;
+
+#define GPU_MEMORY_MAX_CLIENTS 8
+
+/* Budget in bytes; 0 means unlimited. */
+void   gpu_memory_set_budget(size_t bytes);
+size_t gpu_memory_budget(void);
+
+/* Idle seconds before the downsample tier applies; 0 turns it off. */
+void   gpu_memory_set_downsample_idle(double seconds);
+
+/* Estimated bytes of one texture, its mip chain included. */
+size_t gpu_memory_texture_bytes(Texture2D texture);
+
+void   gpu_memory_add(GpuMemPool pool, size_t bytes);
+void   gpu_memory_sub(GpuMemPool pool, size_t bytes);
+
+size_t gpu_memory_used(void);
+size_t gpu_memory_pool_bytes(GpuMemPool pool);
+
+void   gpu_memory_add_client(GpuMemClient client);
+/* Forget every client registered with `user`. */
+void   gpu_memory_remove_client(const void* user);
+
+/* Run the downsample sweep (at most once a second) and, while over budget,
+ * the relief passes. Call once per frame. */
+void   gpu_memory_update(void);
+
+#endif /* CYBERIA_GPU_MEMORY_H */
@@ -4,26 +4,52 @@
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
+#include "heap_memory.h"
+#include "profiler.h"
 #include "util/log.h"
 
-/* Resize when (count + tombstones) exceeds this fraction of capacity. */
+/* Resize when count exceeds this fraction of capacity. */
 #define HASH_LOAD_NUM 7
 #define HASH_LOAD_DEN 10
+#define HASH_MIN_CAPACITY 8
 
-static size_t find_occupied(const HashTable* t, const char* key);
-static size_t find_insert_slot(const HashTable* t, const char* key);
-static void   resize(HashTable* t, size_t new_capacity);
-static void   raw_insert(HashTable* t, char* key_owned, void* value);
+union HashKeyBlock {
+    HashKeyBlock* next;     /* while on the free list */
+    char          key[HASH_KEY_BLOCK];
+};
+
+struct HashKeyChunk {
+    HashKeyChunk* next;
+    HashKeyBlock  blocks[HASH_KEY_CHUNK_BLOCKS];
+};
+
+static size_t   find_occupied(const HashSlot* slots, size_t capacity, const char* key, uint64_t hash);
+static HashSlot* find_slot(const HashTable* t, const char* key, uint64_t hash);
+static void     insert_new(HashSlot* slots, size_t capacity, HashSlot carry);
+static char*    key_copy(HashTable* t, const char* key, bool* pooled);
+static void     key_release(HashTable* t, const HashSlot* s);
+static void     erase_at(HashSlot* slots, size_t capacity, size_t i);
+static size_t   remove_if_in(HashTable* t, HashSlot* slots, size_t capacity, HashPredFn pred, void* user_data);
+static void     grow(HashTable* t, size_t new_capacity);
+static void     rehash_step(HashTable* t, size_t budget);
+static void     old_release_if_empty(HashTable* t);
 
 void hash_table_init(HashTable* t, size_t initial_capacity, HashFreeFn free_fn, const char* debug_name) {
     assert(t);
     assert(initial_capacity > 0);
-    assert(free_fn);
     assert(debug_name);
-    t->slots      = calloc(initial_capacity, sizeof(HashSlot));
-    t->capacity   = initial_capacity;
+    size_t capacity = HASH_MIN_CAPACITY;
+    while (capacity < initial_capacity) { capacity *= 2; }
+    t->slots      = heap_calloc(HEAP_MEM_HASH_TABLE, capacity, sizeof(HashSlot));
+    assert(t->slots);
+    t->capacity   = capacity;
     t->count      = 0;
-    t->tombstones = 0;
+    t->old_slots    = NULL;
+    t->old_capacity = 0;
+    t->old_count    = 0;
+    t->rehash_at    = 0;
+    t->key_free   = NULL;
+    t->key_chunks = NULL;
     t->free_fn    = free_fn;
     t->debug_name = debug_name;
 }
@@ -31,66 +57,108 @@ void hash_table_init(HashTable* t, size_t initial_capacity, HashFreeFn free_fn,
 void hash_table_destroy(HashTable* t) {
     if (NULL == t || NULL == t->slots) { return; }
 
-    for (size_t i = 0; i < t->capacity; i++) {
-        HashSlot* s = &t->slots[i];
-        if (SLOT_OCCUPIED == s->state) {
-            if (t->free_fn && s->value) { t->free_fn(s->value); }
-            free(s->key);
+    HashSlot* arrays[2]     = { t->slots, t->old_slots };
+    size_t    capacities[2] = { t->capacity, t->old_capacity };
+    for (int a = 0; a < 2; a++) {
+        for (size_t i = 0; i < capacities[a]; i++) {
+            HashSlot* s = &arrays[a][i];
+            if (SLOT_OCCUPIED == s->state) {
+                if (t->free_fn && s->value) { t->free_fn(s->value); }
+                if (!s->key_pooled) { heap_free(s->key); }
+            }
         }
     }
-    free(t->slots);
+    heap_free(t->slots);
+    heap_free(t->old_slots);
+    while (t->key_chunks) {
+        HashKeyChunk* next = t->key_chunks->next;
+        heap_free(t->key_chunks);
+        t->key_chunks = next;
+    }
     t->slots      = NULL;
     t->capacity   = 0;
     t->count      = 0;
-    t->tombstones = 0;
+    t->old_slots    = NULL;
+    t->old_capacity = 0;
+    t->old_count    = 0;
+    t->key_free   = NULL;
 }
 
-void* hash_table_get(const HashTable* t, const char* key) {
+void hash_table_reserve(HashTable* t, size_t count) {
     assert(t);
+    assert(t->slots);
+    size_t capacity = t->capacity;
+    while (count * HASH_LOAD_DEN > capacity * HASH_LOAD_NUM) {
+        assert(capacity * 2 > capacity); /* size_t overflow wrap */
+        capacity *= 2;
+    }
+    if (capacity == t->capacity) { return; }
+    LOG_DEBUG("Hash Table '%s' reserving %zu -> %zu (count=%zu)",
+              t->debug_name, t->capacity, capacity, t->count);
+    PROFILE_COUNT(PROF_COUNT_HASH_RESIZES, 1);
+    grow(t, capacity);
+}
+
+void* hash_table_get(const HashTable* t, const char* key) {
     assert(key);
-    size_t i = find_occupied(t, key);
-    return (SIZE_MAX == i) ? NULL : t->slots[i].value;
+    return hash_table_get_h(t, hash_key(key));
 }
 
-bool hash_table_contains(const HashTable* t, const char* key) {
+void* hash_table_get_h(const HashTable* t, HashKey key) {
     assert(t);
+    assert(key.str);
+    const HashSlot* s = find_slot(t, key.str, key.hash);
+    return s ? s->value : NULL;
+}
+
+bool hash_table_contains(const HashTable* t, const char* key) {
     assert(key);
-    return SIZE_MAX != find_occupied(t, key);
+    return hash_table_contains_h(t, hash_key(key));
 }
 
-void hash_table_put(HashTable* t, const char* key, void* value) {
+bool hash_table_contains_h(const HashTable* t, HashKey key) {
     assert(t);
+    assert(key.str);
+    return NULL != find_slot(t, key.str, key.hash);
+}
+
+void hash_table_put(HashTable* t, const char* key, void* value) {
     assert(key);
-    assert(value);
+    hash_table_put_h(t, hash_key(key), value);
+}
 
-    /* Resize before insert if at/above load threshold. */
-    if ((t->count + t->tombstones + 1) * HASH_LOAD_DEN > t->capacity * HASH_LOAD_NUM) {
-        size_t new_cap = t->capacity * 2;
-        if (new_cap < t->capacity) { new_cap = t->capacity; } /* guard size_t overflow wrap */
-        LOG_WARN("Hash Table '%s' resizing %zu -> %zu (count=%zu tombstones=%zu)",
-                 t->debug_name, t->capacity, new_cap, t->count, t->tombstones);
-        resize(t, new_cap);
-    }
+void hash_table_put_h(HashTable* t, HashKey key, void* value) {
+    assert(t);
+    assert(key.str);
+    assert(value);
+    assert(hash_table_hash(key.str) == key.hash);
 
-    size_t i = find_insert_slot(t, key);
-    HashSlot* s = &t->slots[i];
+    if (t->old_slots) { rehash_step(t, HASH_REHASH_STEP); }
 
-    if (SLOT_OCCUPIED == s->state) {
-        if (s->value != value) {
+    uint64_t  hash = key.hash;
+    HashSlot* s    = find_slot(t, key.str, hash);
+    if (s) {
+        if (t->free_fn && s->value != value) {
             t->free_fn(s->value);
         }
         s->value = value;
         return;
     }
 
-    if (SLOT_TOMBSTONE == s->state) {
-        assert(t->tombstones > 0);
-        t->tombstones--;
+    /* Grow before insert if at/above load threshold. */
+    if ((t->count + 1) * HASH_LOAD_DEN > t->capacity * HASH_LOAD_NUM) {
+        size_t new_cap = t->capacity * 2;
+        assert(new_cap > t->capacity); /* size_t overflow wrap */
+        LOG_DEBUG("Hash Table '%s' growing %zu -> %zu (count=%zu)",
+                  t->debug_name, t->capacity, new_cap, t->count);
+        PROFILE_COUNT(PROF_COUNT_HASH_RESIZES, 1);
+        grow(t, new_cap);
     }
 
-    s->key   = strdup(key);
-    s->value = value;
-    s->state = SLOT_OCCUPIED;
+    bool  pooled = false;
+    char* owned  = key_copy(t, key.str, &pooled);
+    insert_new(t->slots, t->capacity, (HashSlot){ .hash = hash, .key = owned, .value = value,
+                              .state = SLOT_OCCUPIED, .key_pooled = pooled });
     t->count++;
 }
 
@@ -98,125 +166,262 @@ bool hash_table_remove(HashTable* t, const char* key) {
     assert(t);
     assert(key);
 
-    size_t i = find_occupied(t, key);
+    if (t->old_slots) { rehash_step(t, HASH_REHASH_STEP); }
+
+    uint64_t  hash     = hash_table_hash(key);
+    HashSlot* slots    = t->slots;
+    size_t    capacity = t->capacity;
+    size_t    i        = find_occupied(slots, capacity, key, hash);
+    if (SIZE_MAX == i && t->old_slots) {
+        slots    = t->old_slots;
+        capacity = t->old_capacity;
+        i        = find_occupied(slots, capacity, key, hash);
+    }
     if (SIZE_MAX == i) { return false; }
 
-    HashSlot* s = &t->slots[i];
+    HashSlot* s = &slots[i];
     if (t->free_fn && s->value) { t->free_fn(s->value); }
-    free(s->key);
-    s->key   = NULL;
-    s->value = NULL;
-    s->state = SLOT_TOMBSTONE;
+    key_release(t, s);
+    erase_at(slots, capacity, i);
     t->count--;
-    t->tombstones++;
+    if (t->old_slots == slots) {
+        t->old_count--;
+        old_release_if_empty(t);
+    }
     return true;
 }
 
 void* hash_table_find(const HashTable* t, HashPredFn pred, void* user_data) {
     assert(t);
     assert(pred);
-    for (size_t i = 0; i < t->capacity; i++) {
-        if (SLOT_OCCUPIED == t->slots[i].state &&
-            pred(t->slots[i].key, t->slots[i].value, user_data)) {
-            return t->slots[i].value;
+    const HashSlot* arrays[2]     = { t->slots, t->old_slots };
+    size_t          capacities[2] = { t->capacity, t->old_capacity };
+    for (int a = 0; a < 2; a++) {
+        for (size_t i = 0; i < capacities[a]; i++) {
+            const HashSlot* s = &arrays[a][i];
+            if (SLOT_OCCUPIED == s->state && pred(s->key, s->value, user_data)) {
+                return s->value;
+            }
         }
     }
     return NULL;
 }
 
+void hash_table_foreach(const HashTable* t, HashIterFn fn, void* user_data) {
+    assert(t);
+    assert(fn);
+    const HashSlot* arrays[2]     = { t->slots, t->old_slots };
+    size_t          capacities[2] = { t->capacity, t->old_capacity };
+    for (int a = 0; a < 2; a++) {
+        for (size_t i = 0; i < capacities[a]; i++) {
+            const HashSlot* s = &arrays[a][i];
+            if (SLOT_OCCUPIED == s->state) { fn(s->key, s->value, user_data); }
+        }
+    }
+}
+
 size_t hash_table_remove_if(HashTable* t, HashPredFn pred, void* user_data) {
     assert(t);
     assert(pred);
-    size_t removed = 0;
-    for (size_t i = 0; i < t->capacity; i++) {
-        HashSlot* s = &t->slots[i];
-        if (SLOT_OCCUPIED != s->state) { continue; }
-        if (!pred(s->key, s->value, user_data)) { continue; }
-        if (t->free_fn && s->value) { t->free_fn(s->value); }
-        free(s->key);
-        s->key   = NULL;
-        s->value = NULL;
-        s->state = SLOT_TOMBSTONE;
-        t->count--;
-        t->tombstones++;
-        removed++;
+    if (0 == t->count) { return 0; }
+
+    size_t removed = remove_if_in(t, t->slots, t->capacity, pred, user_data);
+    if (t->old_slots) {
+        size_t old_removed = remove_if_in(t, t->old_slots, t->old_capacity, pred, user_data);
+        t->old_count -= old_removed;
+        removed      += old_removed;
+        old_release_if_empty(t);
     }
+    t->count -= removed;
     return removed;
 }
 
 /* ── Internals ──────────────────────────────────────────────────────── */
 
-/* Probe until OCCUPIED-with-match or EMPTY. Skips tombstones.
- * Returns SIZE_MAX if not found. */
-static size_t find_occupied(const HashTable* t, const char* key) {
-    hash_t i = hash_string(key) % t->capacity;
-    for (size_t probes = 0; probes < t->capacity; probes++) {
-        HashSlot* s = &t->slots[i];
-        if (SLOT_EMPTY == s->state) { return SIZE_MAX; }
-        if (SLOT_OCCUPIED == s->state && 0 == strcmp(s->key, key)) {
-            return (size_t)i;
+/* FNV-1a, 64-bit, with the high half folded into the low bits the mask
+ * keeps. */
+uint64_t hash_table_hash(const char* key) {
+    uint64_t h = 14695981039346656037ull;
+    for (const unsigned char* p = (const unsigned char*)key; *p; p++) {
+        h ^= *p;
+        h *= 1099511628211ull;
+    }
+    return h ^ (h >> 32);
+}
+
+/* Copy of `key` in a pooled block when it fits, else on the heap. */
+static char* key_copy(HashTable* t, const char* key, bool* pooled) {
+    size_t len = strlen(key) + 1;
+    if (len > HASH_KEY_BLOCK) {
+        char* heap = heap_malloc(HEAP_MEM_HASH_TABLE, len);
+        assert(heap);
+        memcpy(heap, key, len);
+        *pooled = false;
+        return heap;
+    }
+    if (!t->key_free) {
+        HashKeyChunk* chunk = heap_malloc(HEAP_MEM_HASH_TABLE, sizeof(HashKeyChunk));
+        assert(chunk);
+        chunk->next   = t->key_chunks;
+        t->key_chunks = chunk;
+        for (int i = HASH_KEY_CHUNK_BLOCKS - 1; i >= 0; i--) {
+            chunk->blocks[i].next = t->key_free;
+            t->key_free = &chunk->blocks[i];
         }
-        i = (i + 1) % t->capacity;
     }
-    return SIZE_MAX;
+    HashKeyBlock* block = t->key_free;
+    t->key_free = block->next;
+    memcpy(block->key, key, len);
+    *pooled = true;
+    return block->key;
+}
+
+static void key_release(HashTable* t, const HashSlot* s) {
+    if (!s->key_pooled) {
+        heap_free(s->key);
+        return;
+    }
+    HashKeyBlock* block = (HashKeyBlock*)s->key;
+    block->next = t->key_free;
+    t->key_free = block;
+}
+
+/* How far slot i's entry sits from its home slot. */
+static size_t probe_distance(const HashSlot* slots, size_t capacity, size_t i) {
+    return (i - (size_t)(slots[i].hash & (capacity - 1))) & (capacity - 1);
+}
+
+/* Probe until a match, an empty slot, or an entry closer to its home than
+ * we are to ours (Robin Hood order: the key would have displaced it).
+ * Returns SIZE_MAX if not found. */
+static size_t find_occupied(const HashSlot* slots, size_t capacity, const char* key, uint64_t hash) {
+    size_t mask = capacity - 1;
+    size_t i    = (size_t)(hash & mask);
+    for (size_t dist = 0; ; dist++) {
+        const HashSlot* s = &slots[i];
+        if (SLOT_EMPTY == s->state || probe_distance(slots, capacity, i) < dist) { return SIZE_MAX; }
+        if (hash == s->hash && 0 == strcmp(s->key, key)) { return i; }
+        i = (i + 1) & mask;
+    }
 }
 
-/* Returns slot index suitable for insert:
- *   - existing OCCUPIED slot with matching key (caller does replace), OR
- *   - first TOMBSTONE encountered on the probe path, OR
- *   - first EMPTY slot.
- * Capacity invariant (load factor < 1) guarantees an EMPTY exists. */
-static size_t find_insert_slot(const HashTable* t, const char* key) {
-    hash_t i = hash_string(key) % t->capacity;
-    size_t first_tomb = SIZE_MAX;
-    for (size_t probes = 0; probes < t->capacity; probes++) {
-        HashSlot* s = &t->slots[i];
+/* The entry for `key` in either array, or NULL. */
+static HashSlot* find_slot(const HashTable* t, const char* key, uint64_t hash) {
+    size_t i = find_occupied(t->slots, t->capacity, key, hash);
+    if (SIZE_MAX != i) { return &t->slots[i]; }
+    if (!t->old_slots) { return NULL; }
+    i = find_occupied(t->old_slots, t->old_capacity, key, hash);
+    return SIZE_MAX == i ? NULL : &t->old_slots[i];
+}
+
+/* Place an entry whose key is known to be absent (key ownership
+ * transferred). Whenever the carried entry is further from home than the
+ * resident, they swap. The load factor guarantees an empty slot ends the
+ * walk. */
+static void insert_new(HashSlot* slots, size_t capacity, HashSlot carry) {
+    size_t mask = capacity - 1;
+    size_t i    = (size_t)(carry.hash & mask);
+    size_t dist = 0;
+    for (;;) {
+        HashSlot* s = &slots[i];
         if (SLOT_EMPTY == s->state) {
-            return (SIZE_MAX != first_tomb) ? first_tomb : (size_t)i;
+            *s = carry;
+            return;
         }
-        if (SLOT_TOMBSTONE == s->state) {
-            if (SIZE_MAX == first_tomb) { first_tomb = (size_t)i; }
-        } else if (0 == strcmp(s->key, key)) {
-            return (size_t)i;
+        size_t resident = probe_distance(slots, capacity, i);
+        if (resident < dist) {
+            HashSlot tmp = *s;
+            *s    = carry;
+            carry = tmp;
+            dist  = resident;
         }
-        i = (i + 1) % t->capacity;
+        i = (i + 1) & mask;
+        dist++;
     }
-    /* Unreachable when load factor maintained. */
-    LOG_ERROR("Hash Table '%s' full - no insert slot", t->debug_name);
-    assert(0 && "hash table full");
-    return SIZE_MAX;
 }
 
-/* Insert key (already strdup'd, ownership transferred) into a freshly-sized
- * table that has no tombstones and known-free space. Used only by resize. */
-static void raw_insert(HashTable* t, char* key_owned, void* value) {
-    hash_t i = hash_string(key_owned) % t->capacity;
-    while (SLOT_EMPTY != t->slots[i].state) {
-        i = (i + 1) % t->capacity;
+/* Empty slot i (key and value already released) and shift the rest of its
+ * run back one slot, stopping at an empty slot or an entry already home. */
+static void erase_at(HashSlot* slots, size_t capacity, size_t i) {
+    size_t mask = capacity - 1;
+    size_t next = (i + 1) & mask;
+    while (SLOT_OCCUPIED == slots[next].state && 0 != probe_distance(slots, capacity, next)) {
+        slots[i] = slots[next];
+        i    = next;
+        next = (next + 1) & mask;
     }
-    t->slots[i].key   = key_owned;
-    t->slots[i].value = value;
-    t->slots[i].state = SLOT_OCCUPIED;
+    slots[i] = (HashSlot){ 0 };
 }
 
-static void resize(HashTable* t, size_t new_capacity) {
+/* First slot after some empty one: a lap from there back to it visits every
+ * run whole. No run crosses an empty slot, so a backward shift only pulls
+ * not-yet-visited entries into the slot just emptied, which is then looked
+ * at again. */
+static size_t lap_start(const HashSlot* slots, size_t capacity) {
+    size_t end = 0;
+    while (SLOT_EMPTY != slots[end].state) { end++; }
+    return (end + 1) & (capacity - 1);
+}
+
+/* remove_if over one array; the caller adjusts counts. */
+static size_t remove_if_in(HashTable* t, HashSlot* slots, size_t capacity, HashPredFn pred, void* user_data) {
+    size_t mask    = capacity - 1;
+    size_t i       = lap_start(slots, capacity);
+    size_t end     = (i - 1) & mask;
+    size_t removed = 0;
+    while (end != i) {
+        HashSlot* s = &slots[i];
+        if (SLOT_OCCUPIED != s->state || !pred(s->key, s->value, user_data)) {
+            i = (i + 1) & mask;
+            continue;
+        }
+        if (t->free_fn && s->value) { t->free_fn(s->value); }
+        key_release(t, s);
+        erase_at(slots, capacity, i);
+        removed++;
+    }
+    return removed;
+}
+
+/* Start moving every entry into a new array of `new_capacity`; a move still
+ * under way is finished first. */
+static void grow(HashTable* t, size_t new_capacity) {
     assert(new_capacity > t->count);
+    assert(0 == (new_capacity & (new_capacity - 1)));
 
-    HashSlot* old_slots    = t->slots;
-    size_t    old_capacity = t->capacity;
+    if (t->old_slots) { rehash_step(t, SIZE_MAX); }
+    t->old_slots    = t->slots;
+    t->old_capacity = t->capacity;
+    t->old_count    = t->count;
+    t->rehash_at    = lap_start(t->old_slots, t->old_capacity);
 
-    t->slots      = calloc(new_capacity, sizeof(HashSlot));
+    t->slots    = heap_calloc(HEAP_MEM_HASH_TABLE, new_capacity, sizeof(HashSlot));
     assert(t->slots);
-    t->capacity   = new_capacity;
-    t->tombstones = 0;
-    /* t->count unchanged — same live entries, just rehomed */
-
-    for (size_t i = 0; i < old_capacity; i++) {
-        HashSlot* s = &old_slots[i];
-        if (SLOT_OCCUPIED == s->state) {
-            raw_insert(t, s->key, s->value);
+    t->capacity = new_capacity;
+    old_release_if_empty(t);
+}
+
+/* Move up to `budget` old slots across, lapping from rehash_at. Only old
+ * entries are ever erased from the old array, and the slots behind the
+ * cursor are all empty, so removals there never shift an entry past it. */
+static void rehash_step(HashTable* t, size_t budget) {
+    size_t mask = t->old_capacity - 1;
+    while (0 < t->old_count && 0 < budget--) {
+        HashSlot* s = &t->old_slots[t->rehash_at];
+        if (SLOT_EMPTY == s->state) {
+            t->rehash_at = (t->rehash_at + 1) & mask;
+            continue;
         }
-        /* tombstones and empties dropped on the floor */
+        insert_new(t->slots, t->capacity, *s);
+        erase_at(t->old_slots, t->old_capacity, t->rehash_at);
+        t->old_count--;
     }
-    free(old_slots);
+    old_release_if_empty(t);
+}
+
+static void old_release_if_empty(HashTable* t) {
+    if (!t->old_slots || 0 != t->old_count) { return; }
+    heap_free(t->old_slots);
+    t->old_slots    = NULL;
+    t->old_capacity = 0;
 }
@@ -3,17 +3,34 @@
 
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 
 /*
- * Generic string-keyed hash table — open addressing with linear probing.
+ * Generic string-keyed hash table — open addressing, Robin Hood probing.
  *
- * - Keys are duplicated on insert (strdup) and freed on remove/destroy.
+ * - Keys are copied on insert and released on remove/destroy. Keys shorter
+ *   than HASH_KEY_BLOCK bytes go into fixed blocks carved from per-table
+ *   chunks and recycled through a free list, so entity churn does not hit
+ *   malloc/free; longer ones are strdup'd. Either way a key's address is
+ *   stable for as long as its entry lives.
  * - Values are opaque void*; ownership is controlled by `free_fn`.
  *     - If non-NULL, hash_table_destroy / _put-replace / _remove call it on
  *       the value being dropped.
  *     - If NULL, caller retains ownership.
- * - Capacity grows automatically; entries are rehashed on resize, so
- *   pointers to internal slots are NOT stable across put/remove.
+ * - Each slot keeps its key's 64-bit hash: probes compare hashes before
+ *   strings, and resizes never rehash a key.
+ * - Capacity is a power of two (probes mask instead of dividing) and grows
+ *   automatically. Robin Hood insertion keeps probe lengths short and even;
+ *   removal shifts the following run back instead of leaving tombstones.
+ *   Entries move on put and remove, so pointers to internal slots are NOT
+ *   stable across either.
+ * - Growth is incremental: passing the load factor allocates the doubled
+ *   array and keeps the old one alongside; every put and remove then moves
+ *   HASH_REHASH_STEP old slots across, and lookups probe both until the old
+ *   array is empty. No put rehashes the whole table: growing again before
+ *   the move is done would finish it at once, which the step size rules
+ *   out for one put at a time. hash_table_reserve() sizes ahead of a known
+ *   burst.
  * - Not thread-safe.
  */
 
@@ -32,45 +49,90 @@ static inline hash_t hash_string(const char* str) {
 
 typedef enum {
     SLOT_EMPTY = 0,
-    SLOT_OCCUPIED,
-    SLOT_TOMBSTONE
+    SLOT_OCCUPIED
 } SlotState;
 
 typedef struct {
+    uint64_t  hash;           /* of key; low bits pick the home slot */
     char*     key;
     void*     value;
     SlotState state;
+    bool      key_pooled;     /* key lives in a key block, not on the heap */
 } HashSlot;
 
+/* Keys up to HASH_KEY_BLOCK - 1 chars ("<uuid>_<item_id>" fits) are pooled. */
+#define HASH_KEY_BLOCK        96
+#define HASH_KEY_CHUNK_BLOCKS 64
+
+typedef union HashKeyBlock HashKeyBlock;
+typedef struct HashKeyChunk HashKeyChunk;
+
+/* Old slots handled (one entry moved or one empty slot passed) per put /
+ * remove while growing. Emptying the old array takes at most 1.7 * its
+ * capacity steps and doubling at 0.7 load leaves 0.7 * it puts before the
+ * next growth, so any step of 3 or more finishes first. */
+#ifndef HASH_REHASH_STEP
+#define HASH_REHASH_STEP 16
+#endif
+
 typedef struct {
-    HashSlot*   slots;
-    size_t      capacity;
-    size_t      count;        /* occupied slots (excludes tombstones) */
-    size_t      tombstones;
-    HashFreeFn  free_fn;
-    const char* debug_name;   /* identifies table in error logs; not owned */
+    HashSlot*     slots;
+    size_t        capacity;   /* power of two */
+    size_t        count;      /* entries in both arrays */
+    HashSlot*     old_slots;  /* array being emptied while growing, else NULL */
+    size_t        old_capacity;
+    size_t        old_count;  /* entries still in old_slots */
+    size_t        rehash_at;  /* next old slot to move */
+    HashKeyBlock* key_free;   /* recycled key blocks */
+    HashKeyChunk* key_chunks; /* every chunk, freed on destroy */
+    HashFreeFn    free_fn;
+    const char*   debug_name; /* identifies table in error logs; not owned */
 } HashTable;
 
 /* Lifecycle */
 void hash_table_init(HashTable* t, size_t initial_capacity, HashFreeFn free_fn, const char* debug_name);
 void hash_table_destroy(HashTable* t);
 
+/* Grow now so `count` entries in all fit without another growth; the old
+ * entries still move across incrementally. No-op when they already fit. */
+void hash_table_reserve(HashTable* t, size_t count);
+
 /* Core ops */
 void* hash_table_get(const HashTable* t, const char* key);
 void  hash_table_put(HashTable* t, const char* key, void* value);
 bool  hash_table_remove(HashTable* t, const char* key);
 bool  hash_table_contains(const HashTable* t, const char* key);
 
-/* Iterate every occupied slot. Do not insert/remove during iteration. */
-// typedef void (*HashIterFn)(const char* key, void* value, void* user_data);
-// void hash_table_foreach(const HashTable* t, HashIterFn fn, void* user_data);
+/* Prehashed keys, for hot paths that look the same string up every frame:
+ * hash once when the string changes, then use the _h variants. `hash`
+ * must be hash_table_hash(str). */
+typedef struct {
+    uint64_t    hash;
+    const char* str;
+} HashKey;
+
+uint64_t hash_table_hash(const char* key);
+
+static inline HashKey hash_key(const char* str) {
+    return (HashKey){ .hash = hash_table_hash(str), .str = str };
+}
+
+void* hash_table_get_h(const HashTable* t, HashKey key);
+void  hash_table_put_h(HashTable* t, HashKey key, void* value);
+bool  hash_table_contains_h(const HashTable* t, HashKey key);
+
+/* Iterate every occupied slot, in both arrays while growing. Do not
+ * insert/remove during iteration. */
+typedef void (*HashIterFn)(const char* key, void* value, void* user_data);
+void hash_table_foreach(const HashTable* t, HashIterFn fn, void* user_data);
 
 /* Linear scan with predicate; returns first matching value or NULL. */
 typedef bool (*HashPredFn)(const char* key, void* value, void* user_data);
 void* hash_table_find(const HashTable* t, HashPredFn pred, void* user_data);
 
 /* Remove every occupied entry for which pred returns true; free_fn is applied
- * to each removed value. Safe to call mid-session. Returns count removed. */
+ * to each removed value. Safe to call mid-session; pred sees each entry
+ * once. Returns count removed. */
 size_t hash_table_remove_if(HashTable* t, HashPredFn pred, void* user_data);
 
 #endif
@@ -0,0 +1,141 @@
+#include "heap_memory.h"
+
+#include "util/log.h"
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Prefix of every tracked block; the union keeps the payload aligned as
+ * malloc's own. */
+typedef union {
+    struct {
+        size_t     size;
+        HeapMemTag tag;
+    } h;
+    max_align_t align;
+} HeapHeader;
+
+static const char* const TAG_NAMES[HEAP_MEM_TAG_COUNT] = {
+    [HEAP_MEM_HASH_TABLE]    = "hash_table",
+    [HEAP_MEM_TEXTURE_CACHE] = "texture_cache",
+    [HEAP_MEM_FETCH]         = "fetch",
+    [HEAP_MEM_ANIM_POOL]     = "anim_pool",
+    [HEAP_MEM_JSON]          = "json",
+    [HEAP_MEM_TEXT_LAYOUT]   = "text_layout",
+    [HEAP_MEM_WIRE]          = "wire",
+    [HEAP_MEM_STATIC_WORLD]  = "static_world",
+    [HEAP_MEM_FRAME_ARENA]   = "frame_arena",
+    [HEAP_MEM_MAP_ARENA]     = "map_arena",
+};
+
+static struct {
+    HeapMemStats tags[HEAP_MEM_TAG_COUNT];
+    uint32_t     frame_allocs[HEAP_MEM_TAG_COUNT];   /* open frame */
+    size_t       live;
+    size_t       peak;
+} g_heap_memory;
+
+static void* track(HeapHeader* h, HeapMemTag tag, size_t size) {
+    if (NULL == h) return NULL;
+    h->h.size = size;
+    h->h.tag  = tag;
+    HeapMemStats* s = &g_heap_memory.tags[tag];
+    s->live_bytes += size;
+    s->live_blocks++;
+    s->allocs++;
+    if (s->live_bytes > s->peak_bytes) s->peak_bytes = s->live_bytes;
+    g_heap_memory.frame_allocs[tag]++;
+    g_heap_memory.live += size;
+    if (g_heap_memory.live > g_heap_memory.peak) g_heap_memory.peak = g_heap_memory.live;
+    return h + 1;
+}
+
+void* heap_malloc(HeapMemTag tag, size_t size) {
+    assert(0 <= tag && HEAP_MEM_TAG_COUNT > tag);
+    assert(SIZE_MAX - sizeof(HeapHeader) >= size);
+    return track(malloc(sizeof(HeapHeader) + size), tag, size);
+}
+
+void* heap_calloc(HeapMemTag tag, size_t count, size_t size) {
+    assert(0 <= tag && HEAP_MEM_TAG_COUNT > tag);
+    assert(0 == size || (SIZE_MAX - sizeof(HeapHeader)) / size >= count);
+    size_t total = count * size;
+    return track(calloc(1, sizeof(HeapHeader) + total), tag, total);
+}
+
+char* heap_strdup(HeapMemTag tag, const char* s) {
+    assert(s);
+    size_t n = strlen(s) + 1;
+    char* copy = heap_malloc(tag, n);
+    if (copy) memcpy(copy, s, n);
+    return copy;
+}
+
+void heap_free(void* p) {
+    if (NULL == p) return;
+    HeapHeader* h = (HeapHeader*)p - 1;
+    assert(0 <= h->h.tag && HEAP_MEM_TAG_COUNT > h->h.tag);
+    HeapMemStats* s = &g_heap_memory.tags[h->h.tag];
+    assert(s->live_bytes >= h->h.size && 0 < s->live_blocks);
+    s->live_bytes -= h->h.size;
+    s->live_blocks--;
+    s->frees++;
+    g_heap_memory.live -= h->h.size;
+    free(h);
+}
+
+const char* heap_memory_tag_name(HeapMemTag tag) {
+    assert(0 <= tag && HEAP_MEM_TAG_COUNT > tag);
+    return TAG_NAMES[tag];
+}
+
+HeapMemStats heap_memory_stats(HeapMemTag tag) {
+    assert(0 <= tag && HEAP_MEM_TAG_COUNT > tag);
+    return g_heap_memory.tags[tag];
+}
+
+size_t heap_memory_live_total(void) {
+    return g_heap_memory.live;
+}
+
+size_t heap_memory_peak_total(void) {
+    return g_heap_memory.peak;
+}
+
+uint32_t heap_memory_frame_allocs(void) {
+    uint32_t n = 0;
+    for (int t = 0; t < HEAP_MEM_TAG_COUNT; t++) n += g_heap_memory.tags[t].frame_allocs;
+    return n;
+}
+
+void heap_memory_frame_mark(void) {
+    for (int t = 0; t < HEAP_MEM_TAG_COUNT; t++) {
+        g_heap_memory.tags[t].frame_allocs = g_heap_memory.frame_allocs[t];
+        g_heap_memory.frame_allocs[t] = 0;
+    }
+}
+
+void heap_memory_snapshot(HeapMemSnapshot* out, double now_s) {
+    assert(out);
+    out->at_s = now_s;
+    memcpy(out->tags, g_heap_memory.tags, sizeof(out->tags));
+}
+
+void heap_memory_diff(const HeapMemSnapshot* before, const HeapMemSnapshot* after) {
+    assert(before && after);
+    LOG_INFO("[HEAP] diff over %.1f s: %zu KB live now", after->at_s - before->at_s,
+             heap_memory_live_total() / 1024);
+    for (int t = 0; t < HEAP_MEM_TAG_COUNT; t++) {
+        const HeapMemStats* a = &before->tags[t];
+        const HeapMemStats* b = &after->tags[t];
+        long long dbytes  = (long long)b->live_bytes - (long long)a->live_bytes;
+        long long dblocks = (long long)b->live_blocks - (long long)a->live_blocks;
+        if (0 == dbytes && 0 == dblocks) continue;
+        LOG_INFO("[HEAP]   %-13s %+lld B in %+lld blocks (%.0f B/min) | %llu allocs %llu frees",
+                 TAG_NAMES[t], dbytes, dblocks,
+                 before->at_s < after->at_s ? dbytes * 60.0 / (after->at_s - before->at_s) : 0.0,
+                 (unsigned long long)(b->allocs - a->allocs),
+                 (unsigned long long)(b->frees - a->frees));
+    }
+}
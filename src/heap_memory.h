@@ -0,0 +1,70 @@
+#ifndef CYBERIA_HEAP_MEMORY_H
+#define CYBERIA_HEAP_MEMORY_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Heap accounting by subsystem, the malloc-side twin of gpu_memory.h.
+ *
+ * The WASM heap grows under ALLOW_MEMORY_GROWTH and never shrinks, so a
+ * cache that only ever grows shows up as a slow climb with no owner. The
+ * long-lived allocators route through these wrappers under a tag; each
+ * block carries a small header with its size and tag, so heap_free()
+ * needs neither. Blocks from a heap_* allocator must go back through
+ * heap_free() and never through free().
+ *
+ * heap_memory_frame_mark() closes a frame's allocation counts; snapshots
+ * taken minutes apart and diffed (heap_memory_diff) name the tag that kept
+ * growing. Standalone: depends only on libc and util/log.h.
+ */
+
+typedef enum {
+    HEAP_MEM_HASH_TABLE,      /* slot arrays and key chunks */
+    HEAP_MEM_TEXTURE_CACHE,   /* entries and their URLs */
+    HEAP_MEM_FETCH,           /* engine_client contexts and queued requests */
+    HEAP_MEM_ANIM_POOL,       /* entity_render AnimationState blocks */
+    HEAP_MEM_JSON,            /* serial.c arena behind the cJSON parse hooks */
+    HEAP_MEM_TEXT_LAYOUT,     /* ui/text.c wrap layouts, glyph advances, glyph cache TTF */
+    HEAP_MEM_WIRE,            /* network/wire_compress.c decompression buffer */
+    HEAP_MEM_STATIC_WORLD,    /* static_world.c per-map static layers */
+    HEAP_MEM_FRAME_ARENA,     /* frame_arena.c scratch chunks */
+    HEAP_MEM_MAP_ARENA,       /* map_arena.c map-lifetime chunks */
+    HEAP_MEM_TAG_COUNT
+} HeapMemTag;
+
+typedef struct {
+    size_t   live_bytes;     /* requested sizes, headers excluded */
+    size_t   peak_bytes;     /* high-water mark of live_bytes */
+    uint32_t live_blocks;
+    uint64_t allocs;         /* lifetime */
+    uint64_t frees;
+    uint32_t frame_allocs;   /* in the last closed frame */
+} HeapMemStats;
+
+typedef struct {
+    double       at_s;       /* GetTime()-style seconds, caller supplied */
+    HeapMemStats tags[HEAP_MEM_TAG_COUNT];
+} HeapMemSnapshot;
+
+void* heap_malloc(HeapMemTag tag, size_t size);
+void* heap_calloc(HeapMemTag tag, size_t count, size_t size);
+char* heap_strdup(HeapMemTag tag, const char* s);
+void  heap_free(void* p);   /* NULL is a no-op */
+
+const char*  heap_memory_tag_name(HeapMemTag tag);
+HeapMemStats heap_memory_stats(HeapMemTag tag);
+size_t       heap_memory_live_total(void);
+size_t       heap_memory_peak_total(void);   /* high-water mark of the sum */
+uint32_t     heap_memory_frame_allocs(void); /* every tag, last closed frame */
+
+/* Close the current frame's allocation counts. Call once per frame. */
+void heap_memory_frame_mark(void);
+
+void heap_memory_snapshot(HeapMemSnapshot* out, double now_s);
+
+/* Log one line per tag whose live bytes or blocks moved between `before`
+ * and `after`, with the growth rate per minute. */
+void heap_memory_diff(const HeapMemSnapshot* before, const HeapMemSnapshot* after);
+
+#endif /* CYBERIA_HEAP_MEMORY_H */
@@ -0,0 +1,91 @@
+#include "id_intern.h"
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "hash_table.h"
+#include "util/log.h"
+
+#define ID_INTERN_INITIAL_CAPACITY 1024 /* power of two */
+
+typedef char InternedId[MAX_ID_LENGTH];
+
+/* strings[h - 1] holds handle h. `table` is open-addressed over handles
+ * (0 = empty) at twice the string capacity, so load stays <= 0.5. */
+static struct {
+    InternedId* strings;
+    uint32_t*   hashes;
+    uint32_t    count;
+    uint32_t    capacity;
+    IdHandle*   table;
+} g_intern;
+
+static uint32_t table_mask(void) {
+    return g_intern.capacity * 2 - 1;
+}
+
+static uint32_t probe(const char* id, uint32_t h) {
+    uint32_t mask = table_mask();
+    uint32_t i = h & mask;
+    for (IdHandle e = g_intern.table[i]; ID_HANDLE_NONE != e; e = g_intern.table[i]) {
+        if (h == g_intern.hashes[e - 1] && 0 == strcmp(g_intern.strings[e - 1], id)) { break; }
+        i = (i + 1) & mask;
+    }
+    return i;
+}
+
+static void grow(void) {
+    uint32_t cap = g_intern.capacity ? g_intern.capacity * 2 : ID_INTERN_INITIAL_CAPACITY;
+    g_intern.strings  = realloc(g_intern.strings, cap * sizeof(InternedId));
+    g_intern.hashes   = realloc(g_intern.hashes, cap * sizeof(uint32_t));
+    free(g_intern.table);
+    g_intern.table    = calloc((size_t)cap * 2, sizeof(IdHandle));
+    g_intern.capacity = cap;
+    assert(g_intern.strings && g_intern.hashes && g_intern.table);
+
+    uint32_t mask = table_mask();
+    for (uint32_t n = 0; n < g_intern.count; n++) {
+        uint32_t i = g_intern.hashes[n] & mask;
+        while (ID_HANDLE_NONE != g_intern.table[i]) { i = (i + 1) & mask; }
+        g_intern.table[i] = n + 1;
+    }
+    LOG_DEBUG("[ID_INTERN] capacity -> %u", cap);
+}
+
+IdHandle id_intern(const char* id) {
+    assert(id);
+    if ('\0' == id[0]) { return ID_HANDLE_NONE; }
+    assert(strlen(id) < MAX_ID_LENGTH);
+    if (g_intern.count == g_intern.capacity) { grow(); }
+
+    uint32_t h = (uint32_t)hash_string(id);
+    uint32_t i = probe(id, h);
+    if (ID_HANDLE_NONE != g_intern.table[i]) { return g_intern.table[i]; }
+
+    uint32_t n = g_intern.count++;
+    strcpy(g_intern.strings[n], id);
+    g_intern.hashes[n] = h;
+    g_intern.table[i]  = n + 1;
+    return n + 1;
+}
+
+IdHandle id_intern_find(const char* id) {
+    assert(id);
+    if ('\0' == id[0] || 0 == g_intern.capacity) { return ID_HANDLE_NONE; }
+    return g_intern.table[probe(id, (uint32_t)hash_string(id))];
+}
+
+const char* id_intern_str(IdHandle h) {
+    if (ID_HANDLE_NONE == h) { return ""; }
+    assert(h <= g_intern.count);
+    return g_intern.strings[h - 1];
+}
+
+void id_intern_reset(void) {
+    free(g_intern.strings);
+    free(g_intern.hashes);
+    free(g_intern.table);
+    memset(&g_intern, 0, sizeof(g_intern));
+}
@@ -0,0 +1,25 @@
+#ifndef ID_INTERN_H
+#define ID_INTERN_H
+
+#include "world_types.h"
+
+/* Session-scoped string interner for wire ids (entity UUIDs, codes). Each
+ * distinct id maps to a dense IdHandle the first time it is seen; the same
+ * string keeps the same handle until id_intern_reset(), so hot-path identity
+ * checks compare integers instead of 36-byte strings. Handles are never
+ * reused within a session. Storage grows on demand and is released on reset
+ * (init_data / disconnect), which bounds it by one session's distinct ids. */
+
+/* Handle for `id`, allocating one on first sight; ID_HANDLE_NONE for "". */
+IdHandle    id_intern(const char* id);
+
+/* Handle for `id` if already interned, else ID_HANDLE_NONE. */
+IdHandle    id_intern_find(const char* id);
+
+/* String behind `h`; "" for ID_HANDLE_NONE. */
+const char* id_intern_str(IdHandle h);
+
+/* Forget every id; previously issued handles become invalid. */
+void        id_intern_reset(void);
+
+#endif /* ID_INTERN_H */
@@ -0,0 +1,291 @@
+#include "image_decoder.h"
+
+#include "config.h"
+#include "js/image_decode_bridge.h"
+#include "profiler.h"
+#include "util/log.h"
+#include "util/slot_map.h"
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef enum {
+    JOB_RAW,        /* bytes held, decoded in the pump */
+    JOB_DECODING,   /* with the browser */
+    JOB_DECODED
+} JobState;
+
+typedef struct DecodeJob {
+    int               id;       /* inflight handle while JOB_DECODING */
+    JobState          state;
+    char*             key;
+    unsigned char*    bytes;    /* JOB_RAW only */
+    size_t            size;
+    int               max_side; /* 0: full size */
+    DecodedImage      image;    /* JOB_DECODED */
+    ImageDecodedFn    done;
+    void*             user;
+    bool              forgotten;
+    struct DecodeJob* next;
+} DecodeJob;
+
+/* Jobs with the browser, keyed by the id the bridge hands back. Past this
+ * many at once a job decodes in the pump instead. */
+#define IMAGE_DECODER_INFLIGHT_MAX 256
+
+SLOT_MAP_DEFINE(inflight_map, DecodeJob*, IMAGE_DECODER_INFLIGHT_MAX)
+
+static struct {
+    DecodeJob*   head;
+    DecodeJob*   tail;
+    int          count;
+    inflight_map inflight;
+    size_t     upload_budget;
+    int        browser;     /* -1 unknown, 0 no, 1 yes */
+    int        gpu_formats; /* -1 until the GL context answered */
+} g_decoder = {
+    .upload_budget = IMAGE_UPLOAD_BYTES_PER_FRAME,
+    .browser       = -1,
+    .gpu_formats   = -1,
+};
+
+static const unsigned char KTX2_MAGIC[12] = {
+    0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n'
+};
+#define KTX2_HEADER_BYTES 80
+#define KTX2_LEVEL_BYTES  24
+
+static uint32_t read_u32(const unsigned char* p) {
+    return (uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+}
+
+static uint64_t read_u64(const unsigned char* p) {
+    return (uint64_t)read_u32(p) | (uint64_t)read_u32(p + 4) << 32;
+}
+
+/* raylib pixel format of a KTX2 vkFormat, or 0 when not supported. */
+static int ktx2_pixel_format(uint32_t vk_format) {
+    switch (vk_format) {
+        case 37: case 43:   return PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;   /* R8G8B8A8 UNORM/SRGB */
+        case 131: case 132: return PIXELFORMAT_COMPRESSED_DXT1_RGB;     /* BC1 RGB */
+        case 133: case 134: return PIXELFORMAT_COMPRESSED_DXT1_RGBA;    /* BC1 RGBA */
+        case 135: case 136: return PIXELFORMAT_COMPRESSED_DXT3_RGBA;    /* BC2 */
+        case 137: case 138: return PIXELFORMAT_COMPRESSED_DXT5_RGBA;    /* BC3 */
+        default:            return 0;
+    }
+}
+
+/* Level 0 of a 2D KTX2 texture as an Image of its block format. Basis
+ * and Zstandard supercompression are not handled: the engine transcodes. */
+static Image load_ktx2(const char* key, const unsigned char* data, size_t size) {
+    if (size < KTX2_HEADER_BYTES + KTX2_LEVEL_BYTES) return (Image){ 0 };
+    uint32_t vk_format = read_u32(data + 12);
+    uint32_t width     = read_u32(data + 20);
+    uint32_t height    = read_u32(data + 24);
+    uint32_t depth     = read_u32(data + 28);
+    uint32_t layers    = read_u32(data + 32);
+    uint32_t faces     = read_u32(data + 36);
+    uint32_t scheme    = read_u32(data + 44);
+    int      format    = ktx2_pixel_format(vk_format);
+    if (0 == format || 0 != scheme || 0 != depth || 0 != layers || 1 != faces ||
+        0 == width || 0 == height) {
+        LOG_WARN("[DECODE] unsupported KTX2 (vkFormat %u, scheme %u): %s", vk_format, scheme, key);
+        return (Image){ 0 };
+    }
+
+    uint64_t offset = read_u64(data + KTX2_HEADER_BYTES);
+    uint64_t length = read_u64(data + KTX2_HEADER_BYTES + 8);
+    if (offset > size || length > size - offset ||
+        length != (uint64_t)GetPixelDataSize((int)width, (int)height, format)) {
+        LOG_WARN("[DECODE] truncated KTX2: %s", key);
+        return (Image){ 0 };
+    }
+    void* pixels = RL_MALLOC((size_t)length);
+    assert(pixels);
+    memcpy(pixels, data + offset, (size_t)length);
+    return (Image){
+        .data    = pixels,
+        .width   = (int)width,
+        .height  = (int)height,
+        .mipmaps = 1,
+        .format  = format,
+    };
+}
+
+void image_decoder_submit(const char* key, const unsigned char* data, size_t size,
+                          ImageDecodedFn done, void* user) {
+    image_decoder_submit_fit(key, data, size, 0, done, user);
+}
+
+void image_decoder_submit_fit(const char* key, const unsigned char* data, size_t size,
+                              int max_side, ImageDecodedFn done, void* user) {
+    assert(key);
+    assert(data && size > 0);
+    assert(done);
+    if (g_decoder.browser < 0) {
+        g_decoder.browser = image_decode_bridge_available() ? 1 : 0;
+        if (!g_decoder.browser) LOG_WARN("[DECODE] no createImageBitmap; decoding on the main thread");
+    }
+
+    bool ktx2 = size >= sizeof(KTX2_MAGIC) && 0 == memcmp(data, KTX2_MAGIC, sizeof(KTX2_MAGIC));
+
+    DecodeJob* j = malloc(sizeof(DecodeJob));
+    assert(j);
+    *j = (DecodeJob){
+        .state = ktx2 ? JOB_DECODED : g_decoder.browser ? JOB_DECODING : JOB_RAW,
+        .key   = strdup(key),
+        .size  = size,
+        .max_side = 0 < max_side ? max_side : 0,
+        .done  = done,
+        .user  = user,
+    };
+    assert(j->key);
+    if (g_decoder.tail) g_decoder.tail->next = j;
+    else                g_decoder.head = j;
+    g_decoder.tail = j;
+    g_decoder.count++;
+
+    if (JOB_DECODING == j->state) {
+        j->id = inflight_map_insert(&g_decoder.inflight, j);
+        if (0 == j->id) j->state = JOB_RAW;
+    }
+
+    if (ktx2) {
+        j->image.image = load_ktx2(key, data, size);
+    } else if (JOB_DECODING == j->state) {
+        image_decode_bridge_start(j->id, data, size, j->max_side);
+    } else {
+        j->bytes = malloc(size);
+        assert(j->bytes);
+        memcpy(j->bytes, data, size);
+    }
+}
+
+bool image_decoder_ok(const DecodedImage* d) {
+    assert(d);
+    return NULL != d->image.data || 0 < d->bitmap;
+}
+
+Texture2D image_decoder_upload(DecodedImage* d) {
+    assert(d);
+    if (d->image.data) return LoadTextureFromImage(d->image);
+    if (0 >= d->bitmap) return (Texture2D){ 0 };
+    return (Texture2D){
+        .id      = image_decode_bridge_upload(d->bitmap),
+        .width   = d->image.width,
+        .height  = d->image.height,
+        .mipmaps = 1,
+        .format  = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8,
+    };
+}
+
+bool image_decoder_upload_rect(DecodedImage* d, Texture2D dst, int x, int y) {
+    assert(d);
+    if (d->image.format >= PIXELFORMAT_COMPRESSED_DXT1_RGB) return false;
+    if (0 < d->bitmap) return image_decode_bridge_upload_rect(d->bitmap, dst.id, x, y);
+    if (!d->image.data) return false;
+    ImageFormat(&d->image, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+    UpdateTextureRec(dst, (Rectangle){ (float)x, (float)y, (float)d->image.width, (float)d->image.height },
+                     d->image.data);
+    return true;
+}
+
+void image_decoder_release(DecodedImage* d) {
+    assert(d);
+    if (0 < d->bitmap) image_decode_bridge_release(d->bitmap);
+    UnloadImage(d->image);
+    *d = (DecodedImage){ 0 };
+}
+
+/* Scale `im` down so its longer side is `max_side`; no-op when it fits. */
+static void fit_image(Image* im, int max_side) {
+    int side = im->width > im->height ? im->width : im->height;
+    if (0 >= max_side || NULL == im->data || side <= max_side) return;
+    int w = (int)((long)im->width * max_side / side);
+    int h = (int)((long)im->height * max_side / side);
+    ImageResize(im, 0 < w ? w : 1, 0 < h ? h : 1);
+}
+
+static void free_job(DecodeJob* j) {
+    if (JOB_DECODED == j->state) image_decoder_release(&j->image);
+    free(j->bytes);
+    free(j->key);
+    free(j);
+}
+
+void image_decoder_forget(const void* user) {
+    for (DecodeJob* j = g_decoder.head; j; j = j->next) {
+        if (user == j->user) j->forgotten = true;
+    }
+}
+
+void image_decoder_set_upload_budget(size_t bytes) {
+    g_decoder.upload_budget = bytes;
+}
+
+void image_decoder_complete(int id, DecodedImage image) {
+    DecodeJob** slot = inflight_map_get(&g_decoder.inflight, id);
+    if (!slot) {
+        /* Jobs leave the map only once decoded, so this is a bridge bug. */
+        assert(false);
+        image_decoder_release(&image);
+        return;
+    }
+    DecodeJob* j = *slot;
+    inflight_map_remove(&g_decoder.inflight, id);
+    assert(JOB_DECODING == j->state);
+    j->image = image;
+    j->state = JOB_DECODED;
+}
+
+void image_decoder_pump(void) {
+    size_t      spent       = 0;
+    bool        decoded_one = false;
+    DecodeJob*  prev        = NULL;
+    DecodeJob** link        = &g_decoder.head;
+    while (*link) {
+        DecodeJob* j = *link;
+        bool skip = JOB_DECODING == j->state || (JOB_RAW == j->state && decoded_one && !j->forgotten);
+        if (skip) {
+            prev = j;
+            link = &j->next;
+            continue;
+        }
+        if (!j->forgotten) {
+            if (JOB_RAW == j->state) {
+                j->image.image = LoadImageFromMemory(".png", j->bytes, (int)j->size);
+                fit_image(&j->image.image, j->max_side);
+                free(j->bytes);
+                j->bytes = NULL;
+                PROFILE_COUNT(PROF_COUNT_IMAGE_DECODES, 1);
+                j->state = JOB_DECODED;
+                decoded_one = true;
+            }
+            const Image* im = &j->image.image;
+            size_t bytes = (size_t)GetPixelDataSize(im->width, im->height, im->format);
+            if (spent > 0 && g_decoder.upload_budget > 0 && spent + bytes > g_decoder.upload_budget) break;
+            spent += bytes;
+        }
+
+        *link = j->next;
+        if (g_decoder.tail == j) g_decoder.tail = prev;
+        g_decoder.count--;
+        if (!j->forgotten) {
+            DecodedImage image = j->image;
+            j->image = (DecodedImage){ 0 };
+            j->done(j->user, j->key, image);
+        }
+        free_job(j);
+    }
+}
+
+unsigned image_decoder_gpu_formats(void) {
+    if (g_decoder.gpu_formats < 0) g_decoder.gpu_formats = image_decode_bridge_gpu_formats();
+    return g_decoder.gpu_formats < 0 ? 0u : (unsigned)g_decoder.gpu_formats;
+}
+
+int image_decoder_pending(void) {
+    return g_decoder.count;
+}
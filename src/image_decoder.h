@@ -0,0 +1,88 @@
+#ifndef CYBERIA_IMAGE_DECODER_H
+#define CYBERIA_IMAGE_DECODER_H
+
+#include <raylib.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/*
+ * PNG decode away from the fetch callback, and GPU uploads paced per frame.
+ *
+ * A blob handed to image_decoder_submit() is decoded by the browser
+ * (createImageBitmap, off the main thread) when it can, else by raylib
+ * inside image_decoder_pump(), one image a frame. A browser decode stays
+ * an ImageBitmap on the JS side and is uploaded from there, so a streamed
+ * PNG costs no WASM heap beyond the fetch buffer: no copy of the blob and
+ * no RGBA image (which would otherwise grow the heap during streaming).
+ * Decoded images are
+ * delivered from image_decoder_pump(), oldest first, until the frame's
+ * upload budget is spent — the callback is where the GPU upload
+ * happens — so a burst of streamed atlases spreads over several frames
+ * instead of stalling one. The first image of a frame always goes, so an
+ * image larger than the budget still lands.
+ *
+ * KTX2 blobs (pre-transcoded GPU block formats, no supercompression) skip
+ * decoding altogether: level 0 is copied out as a compressed Image, ready
+ * for upload. Which block formats the GPU takes is
+ * image_decoder_gpu_formats().
+ *
+ * Standalone: depends only on raylib and the JS decode bridge.
+ */
+
+/* A decoded image: RGBA or block-compressed pixels in `image.data`, or a
+ * browser bitmap (`bitmap` > 0, `image.data` NULL) that `image` describes.
+ * Neither when decoding failed. Upload it with image_decoder_upload*(),
+ * free it with image_decoder_release(). */
+typedef struct {
+    Image image;
+    int   bitmap;
+} DecodedImage;
+
+bool      image_decoder_ok(const DecodedImage* d);
+
+/* New texture holding `d`; {.id = 0} when the upload fails. */
+Texture2D image_decoder_upload(DecodedImage* d);
+
+/* Copy `d` into `dst` at (x, y). `dst` is RGBA8; pixel images are
+ * converted to it in place. False when `d` is block-compressed or gone. */
+bool      image_decoder_upload_rect(DecodedImage* d, Texture2D dst, int x, int y);
+
+void      image_decoder_release(DecodedImage* d);
+
+/* The callback owns `image` and releases it. */
+typedef void (*ImageDecodedFn)(void* user, const char* key, DecodedImage image);
+
+/* Queue `size` PNG bytes (copied). `key` is handed back to `done`. */
+void image_decoder_submit(const char* key, const unsigned char* data, size_t size,
+                          ImageDecodedFn done, void* user);
+
+/* Same, scaled down (aspect kept) so neither side exceeds `max_side`
+ * pixels as part of the decode; 0 keeps the full size. The browser resizes
+ * the bitmap before it is ever uploaded, the pump path resizes the RGBA
+ * image. KTX2 blocks are never resized. */
+void image_decoder_submit_fit(const char* key, const unsigned char* data, size_t size,
+                              int max_side, ImageDecodedFn done, void* user);
+
+/* Drop every job submitted with `user`; their callbacks never run. */
+void image_decoder_forget(const void* user);
+
+/* Decoded RGBA bytes delivered per frame; 0 means no limit. */
+void image_decoder_set_upload_budget(size_t bytes);
+
+/* Deliver decoded images under the budget. Call once per frame. */
+void image_decoder_pump(void);
+
+/* Jobs submitted and not yet delivered. */
+int  image_decoder_pending(void);
+
+/* Compressed block formats the WebGL context accepts. 0 until the context
+ * exists. Only S3TC for now: rlgl recognises no other compressed-texture
+ * extension under WebGL, so ETC2/ASTC uploads would be refused. */
+#define IMAGE_GPU_S3TC (1u << 0)   /* BC1–BC3 */
+
+unsigned image_decoder_gpu_formats(void);
+
+/* Browser decode of job `id` finished (from the JS decode bridge). */
+void image_decoder_complete(int id, DecodedImage image);
+
+#endif /* CYBERIA_IMAGE_DECODER_H */
@@ -9,19 +9,30 @@
 
 void input_push(input_queue_t* q, input_event_t e) {
     assert(q);
+    assert(INPUT_NONE != e.type);
+    for (uint32_t i = 0; i < q->count; i++) {
+        input_event_t* prev = &q->evt[i];
+        if (prev->type != e.type || prev->consumed) continue;
+        if (INPUT_ZOOM == e.type) {
+            prev->wheel_delta += e.wheel_delta;
+            prev->pinch_scale *= e.pinch_scale;
+            prev->zoom_in      = prev->wheel_delta > 0.0f;
+        } else {
+            *prev = e;                 /* last tap of the frame wins */
+        }
+        return;
+    }
     assert(q->count < Q_CAP);
-    q->evt[(q->head + q->count) % Q_CAP] = e;
-    q->count++;
+    q->evt[q->count++] = e;
 }
 
-bool input_pop(input_queue_t* q, input_event_t* out) {
+input_event_t* input_next(input_queue_t* q, input_event_t* prev, input_e type) {
     assert(q);
-    assert(out);
-    if (0 == q->count) { return false; }
-    *out = q->evt[q->head];
-    q->head = (q->head + 1) % Q_CAP;
-    q->count--;
-    return true;
+    uint32_t i = prev ? (uint32_t)(prev - q->evt) + 1 : 0;
+    for (; i < q->count; i++) {
+        if (!q->evt[i].consumed && type == q->evt[i].type) return &q->evt[i];
+    }
+    return NULL;
 }
 
 /* ── Touch gestures ──────────────────────────────────────────────────────
@@ -55,12 +66,15 @@ static void emit_tap(input_queue_t* q, Vector2 screen_pos) {
     });
 }
 
-static void pinch_zoom_on_tick(void) {
+/* The pinch rides the frame's INPUT_ZOOM as a scale, so it and any wheel
+ * step reach the camera as one zoom. */
+static void pinch_zoom_on_tick(input_queue_t* q) {
     Vector2 a = GetTouchPosition(0);
     Vector2 b = GetTouchPosition(1);
     float   d = Vector2Distance(a, b);
     if (s_pinch_prev_dist > 1.0f && d > 1.0f && !s_gestures_blocked) {
-        camera_zoom_by(d / s_pinch_prev_dist);
+        input_push(q, (input_event_t){ .type = INPUT_ZOOM,
+                                       .pinch_scale = d / s_pinch_prev_dist });
     }
     s_pinch_prev_dist = d;
 }
@@ -74,7 +88,7 @@ void input_queue_on_tick(input_queue_t* q, double dt) {
         /* Pinch: cancel any held tap so the gesture never moves the player. */
         s_tap_pending  = false;
         s_pinch_active = true;
-        pinch_zoom_on_tick();
+        pinch_zoom_on_tick(q);
     } else {
         s_pinch_prev_dist = 0.0f;
         if (0 == touches) s_pinch_active = false;
@@ -111,7 +125,8 @@ void input_queue_on_tick(input_queue_t* q, double dt) {
     if (!FloatEquals(wheel, 0.0f)) {
         input_push(q, (input_event_t){ .type = INPUT_ZOOM,
                                        .zoom_in = wheel > 0,
-                                       .wheel_delta = wheel });
+                                       .wheel_delta = wheel,
+                                       .pinch_scale = 1.0f });
     }
 }
 
@@ -3,10 +3,18 @@
 
 #include <raylib.h>
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
-/* Raw per-frame input event ring. Captures OS events (tap, debug key, zoom)
- * and hands them to the UI dispatch and prediction/replication stages. The
+/* Raw per-frame input events. Captures OS events (tap, debug key, zoom) into
+ * one queue that the UI dispatch, gameplay gates, prediction/replication and
+ * tap effects walk in turn; a stage that handles an event marks it consumed
+ * in place and later stages skip it. The queue is passed by pointer and
+ * never copied or re-pushed.
+ *
+ * Capture coalesces to one event per type per frame: the last tap wins, and
+ * wheel steps and the pinch scale fold into a single INPUT_ZOOM, so the
+ * camera re-projects once and a burst of taps sends one uplink command. The
  * typed wire command lives separately in input/input_command.h. */
 
 typedef enum input_type {
@@ -19,22 +27,31 @@ typedef enum input_type {
 typedef struct input_event {
     enum input_type type;
     Vector2 screen_position; /* For INPUT_TAP */
-    bool zoom_in;            /* For INPUT_ZOOM */
-    float wheel_delta;       /* For INPUT_ZOOM */
+    bool zoom_in;            /* For INPUT_ZOOM: sign of wheel_delta */
+    float wheel_delta;       /* For INPUT_ZOOM: summed wheel, 0 for a pure pinch */
+    float pinch_scale;       /* For INPUT_ZOOM: camera scale from the pinch, 1 for none */
     Vector2 world_position;  /* For INPUT_TAP */
+    bool consumed;
 } input_event_t;
 
-#define Q_CAP 100
+#define Q_CAP 8 /* one slot per type after coalescing */
 typedef struct input_event_queue {
     struct input_event evt[Q_CAP];
-    uint32_t head;
     uint32_t count;
 } input_queue_t;
 
 void input_queue_on_tick(input_queue_t* q, double dt);
-bool input_pop(input_queue_t* q, input_event_t* out);
+
+/* Queue `e`, or fold it into the frame's event of the same type. */
 void input_push(input_queue_t* q, input_event_t e);
 
+/* Next unconsumed event of `type` after `prev` (NULL: from the start), in
+ * capture order; NULL when none is left.
+ *
+ *   for (input_event_t* e = NULL; (e = input_next(q, e, INPUT_TAP));) { ... }
+ */
+input_event_t* input_next(input_queue_t* q, input_event_t* prev, input_e type);
+
 /* While blocked, the capture layer runs no gameplay pinch zoom — a
  * full-screen UI surface (the Instance Map) owns touch gestures instead.
  * Taps, wheel, and debug-key events still flow. */
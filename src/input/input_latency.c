@@ -0,0 +1,81 @@
+#include "input/input_latency.h"
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Cells the drawn player has to leave its tap-time spot by to count as moved. */
+#define INPUT_LATENCY_MOVE_EPSILON 0.01f
+
+static struct {
+    bool    tracing;
+    double  start_ms;
+    Vector2 start_pos;
+    bool    marked[INPUT_LAT_STAGE_COUNT];
+    float   stage_ms[INPUT_LAT_STAGE_COUNT];
+
+    float   ring[INPUT_LATENCY_SAMPLES][INPUT_LAT_STAGE_COUNT];
+    int     head;
+    int     count;
+} g_lat;
+
+bool input_latency_begin(double now_ms, Vector2 view_pos) {
+    if (g_lat.tracing) return false;
+    g_lat.tracing   = true;
+    g_lat.start_ms  = now_ms;
+    g_lat.start_pos = view_pos;
+    memset(g_lat.marked, 0, sizeof(g_lat.marked));
+    return true;
+}
+
+void input_latency_cancel(void) {
+    g_lat.tracing = false;
+}
+
+void input_latency_mark(InputLatencyStage stage, double now_ms) {
+    assert(0 <= stage && INPUT_LAT_STAGE_COUNT > stage);
+    if (!g_lat.tracing || g_lat.marked[stage]) return;
+    g_lat.marked[stage]   = true;
+    g_lat.stage_ms[stage] = (float)(now_ms - g_lat.start_ms);
+}
+
+void input_latency_on_frame(double now_ms, Vector2 view_pos) {
+    if (!g_lat.tracing) return;
+    if (INPUT_LATENCY_TIMEOUT_MS < now_ms - g_lat.start_ms) {
+        g_lat.tracing = false;
+        return;
+    }
+    float dx = view_pos.x - g_lat.start_pos.x;
+    float dy = view_pos.y - g_lat.start_pos.y;
+    if (!g_lat.marked[INPUT_LAT_PREDICTED] ||
+        INPUT_LATENCY_MOVE_EPSILON * INPUT_LATENCY_MOVE_EPSILON > dx * dx + dy * dy) {
+        return;
+    }
+    input_latency_mark(INPUT_LAT_VISIBLE, now_ms);
+    /* A stage still unmarked (the uplink held back by backpressure) took
+     * at least as long as the tap took to show. */
+    for (int s = 0; s < INPUT_LAT_STAGE_COUNT; s++) {
+        g_lat.ring[g_lat.head][s] = g_lat.marked[s] ? g_lat.stage_ms[s] : g_lat.stage_ms[INPUT_LAT_VISIBLE];
+    }
+    g_lat.head = (g_lat.head + 1) % INPUT_LATENCY_SAMPLES;
+    if (INPUT_LATENCY_SAMPLES > g_lat.count) g_lat.count++;
+    g_lat.tracing = false;
+}
+
+static int compare_floats(const void* a, const void* b) {
+    float fa = *(const float*)a, fb = *(const float*)b;
+    return (fa > fb) - (fa < fb);
+}
+
+InputLatencyStats input_latency_stats(void) {
+    InputLatencyStats st = { .samples = g_lat.count };
+    if (0 == g_lat.count) return st;
+    float values[INPUT_LATENCY_SAMPLES];
+    for (int s = 0; s < INPUT_LAT_STAGE_COUNT; s++) {
+        for (int i = 0; i < g_lat.count; i++) values[i] = g_lat.ring[i][s];
+        qsort(values, (size_t)g_lat.count, sizeof(float), compare_floats);
+        st.p50_ms[s] = values[(int)(0.50f * (float)(g_lat.count - 1) + 0.5f)];
+        st.p95_ms[s] = values[(int)(0.95f * (float)(g_lat.count - 1) + 0.5f)];
+    }
+    return st;
+}
@@ -0,0 +1,64 @@
+#ifndef CYBERIA_INPUT_LATENCY_H
+#define CYBERIA_INPUT_LATENCY_H
+
+#include <raylib.h>
+#include <stdbool.h>
+
+/* Tap-to-photon latency: stage timestamps for sampled taps.
+ *
+ * One tap is traced at a time; taps captured while it is in flight are not
+ * sampled. gameloop marks each stage as the tap passes it, every time in ms
+ * from the tap's capture:
+ *
+ *   DISPATCHED  past UI dispatch and the frozen gate, so it reached the world
+ *   SENT        its uplink frame left the send queue for the socket
+ *   PREDICTED   the first prediction step walked toward it
+ *   VISIBLE     the end of the first frame that drew the local player moved
+ *
+ * Capture is raylib's poll at the top of the frame, so the wait between the
+ * browser event and that poll (up to one frame) and the compositor's present
+ * after the frame are not counted. A tap the UI took is dropped, and one
+ * that never moves the player (its own cell, a blocked target) times out
+ * after INPUT_LATENCY_TIMEOUT_MS. The last INPUT_LATENCY_SAMPLES completed
+ * traces feed the p50 / p95 dev_ui shows. */
+
+#ifndef INPUT_LATENCY_SAMPLES
+#define INPUT_LATENCY_SAMPLES 64
+#endif
+
+#ifndef INPUT_LATENCY_TIMEOUT_MS
+#define INPUT_LATENCY_TIMEOUT_MS 2000.0
+#endif
+
+typedef enum {
+    INPUT_LAT_DISPATCHED,
+    INPUT_LAT_SENT,
+    INPUT_LAT_PREDICTED,
+    INPUT_LAT_VISIBLE,
+    INPUT_LAT_STAGE_COUNT
+} InputLatencyStage;
+
+typedef struct {
+    int   samples;
+    float p50_ms[INPUT_LAT_STAGE_COUNT];
+    float p95_ms[INPUT_LAT_STAGE_COUNT];
+} InputLatencyStats;
+
+/* A tap was captured at `now_ms` (emscripten_get_now) with the local player
+ * drawn at `view_pos`. False, and not sampled, while another is traced. */
+bool input_latency_begin(double now_ms, Vector2 view_pos);
+
+/* The traced tap went to the UI or a gate and will not move the player. */
+void input_latency_cancel(void);
+
+/* The traced tap reached `stage`; only the first mark of each counts. */
+void input_latency_mark(InputLatencyStage stage, double now_ms);
+
+/* After a frame is drawn with the local player at `view_pos`: completes the
+ * trace (VISIBLE) once it is predicted and the player has moved, or drops
+ * it past the timeout. */
+void input_latency_on_frame(double now_ms, Vector2 view_pos);
+
+InputLatencyStats input_latency_stats(void);
+
+#endif /* CYBERIA_INPUT_LATENCY_H */
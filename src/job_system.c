@@ -0,0 +1,200 @@
+#include "job_system.h"
+
+#include <assert.h>
+
+#ifndef JOB_SYSTEM_THREADED
+
+void job_system_init(void) {}
+
+int job_system_worker_count(void) { return 0; }
+
+void parallel_for(int count, int grain, JobRangeFn fn, void* ctx) {
+    assert(fn);
+    if (0 < count) fn(0, count, ctx);
+}
+
+#else
+
+#include "util/log.h"
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <unistd.h>
+#ifdef __EMSCRIPTEN__
+#include <emscripten/threading.h>
+#endif
+
+typedef struct {
+    JobRangeFn  fn;
+    void*       ctx;
+    int         begin;
+    int         end;
+    atomic_int* pending;
+} Job;
+
+/* Chase–Lev deque: the owner pushes and pops at bottom, thieves take from
+ * top. Fixed capacity, so a push onto a full deque fails and the caller runs
+ * the job itself. */
+typedef struct {
+    _Atomic int64_t top;
+    _Atomic int64_t bottom;
+    Job             jobs[JOB_DEQUE_CAP];
+} JobDeque;
+
+/* deques[0] belongs to the main thread, deques[1..workers] to the pool.
+ * Idle workers sleep on `wake` until parallel_for bumps `generation`. */
+static struct {
+    bool            started;
+    int             workers;
+    JobDeque        deques[JOB_MAX_WORKERS + 1];
+    pthread_t       threads[JOB_MAX_WORKERS];
+    pthread_mutex_t lock;
+    pthread_cond_t  wake;
+    uint32_t        generation;
+} g_jobs = {
+    .lock = PTHREAD_MUTEX_INITIALIZER,
+    .wake = PTHREAD_COND_INITIALIZER,
+};
+
+static _Thread_local int s_worker;   /* index into deques; 0 on the main thread */
+
+static bool deque_push(JobDeque* d, const Job* job) {
+    int64_t b = atomic_load_explicit(&d->bottom, memory_order_relaxed);
+    int64_t t = atomic_load_explicit(&d->top, memory_order_acquire);
+    if (JOB_DEQUE_CAP <= b - t) return false;
+    d->jobs[b % JOB_DEQUE_CAP] = *job;
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&d->bottom, b + 1, memory_order_relaxed);
+    return true;
+}
+
+static bool deque_pop(JobDeque* d, Job* out) {
+    int64_t b = atomic_load_explicit(&d->bottom, memory_order_relaxed) - 1;
+    atomic_store_explicit(&d->bottom, b, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    int64_t t = atomic_load_explicit(&d->top, memory_order_relaxed);
+    if (t > b) {
+        atomic_store_explicit(&d->bottom, b + 1, memory_order_relaxed);
+        return false;
+    }
+    *out = d->jobs[b % JOB_DEQUE_CAP];
+    if (t < b) return true;
+    /* Last job: race the thieves for it. */
+    bool won = atomic_compare_exchange_strong_explicit(&d->top, &t, t + 1, memory_order_seq_cst,
+                                                       memory_order_relaxed);
+    atomic_store_explicit(&d->bottom, b + 1, memory_order_relaxed);
+    return won;
+}
+
+static bool deque_steal(JobDeque* d, Job* out) {
+    int64_t t = atomic_load_explicit(&d->top, memory_order_acquire);
+    atomic_thread_fence(memory_order_seq_cst);
+    int64_t b = atomic_load_explicit(&d->bottom, memory_order_acquire);
+    if (t >= b) return false;
+    Job job = d->jobs[t % JOB_DEQUE_CAP];
+    if (!atomic_compare_exchange_strong_explicit(&d->top, &t, t + 1, memory_order_seq_cst,
+                                                 memory_order_relaxed)) {
+        return false;
+    }
+    *out = job;
+    return true;
+}
+
+static void job_run(const Job* job) {
+    job->fn(job->begin, job->end, job->ctx);
+    atomic_fetch_sub_explicit(job->pending, 1, memory_order_release);
+}
+
+/* Own deque first, then one sweep over the others starting past our own.
+ * Deques of threads that never started stay empty. */
+static bool job_find(Job* out) {
+    if (deque_pop(&g_jobs.deques[s_worker], out)) return true;
+    int n = JOB_MAX_WORKERS + 1;
+    for (int i = 1; i < n; i++) {
+        if (deque_steal(&g_jobs.deques[(s_worker + i) % n], out)) return true;
+    }
+    return false;
+}
+
+static void* worker_main(void* arg) {
+    s_worker = (int)(intptr_t)arg;
+    uint32_t seen = 0;
+    for (;;) {
+        Job job;
+        if (job_find(&job)) {
+            job_run(&job);
+            continue;
+        }
+        pthread_mutex_lock(&g_jobs.lock);
+        while (seen == g_jobs.generation) pthread_cond_wait(&g_jobs.wake, &g_jobs.lock);
+        seen = g_jobs.generation;
+        pthread_mutex_unlock(&g_jobs.lock);
+    }
+    return NULL;
+}
+
+static int logical_cores(void) {
+#ifdef __EMSCRIPTEN__
+    return emscripten_num_logical_cores();
+#else
+    return (int)sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+}
+
+void job_system_init(void) {
+    if (g_jobs.started) return;
+    g_jobs.started = true;
+    int want = logical_cores() - 1;
+    if (want > JOB_MAX_WORKERS) want = JOB_MAX_WORKERS;
+    for (int i = 0; i < want; i++) {
+        if (0 != pthread_create(&g_jobs.threads[i], NULL, worker_main, (void*)(intptr_t)(i + 1))) {
+            LOG_WARN("[JOBS] worker %d failed to start", i + 1);
+            break;
+        }
+        g_jobs.workers++;
+    }
+    LOG_INFO("[JOBS] %d worker threads", g_jobs.workers);
+}
+
+int job_system_worker_count(void) {
+    return g_jobs.workers;
+}
+
+void parallel_for(int count, int grain, JobRangeFn fn, void* ctx) {
+    assert(fn);
+    if (0 >= count) return;
+    if (1 > grain) grain = 1;
+    int chunks = (count + grain - 1) / grain;
+    if (0 == g_jobs.workers || 1 == chunks) {
+        fn(0, count, ctx);
+        return;
+    }
+
+    atomic_int pending = chunks;
+    JobDeque* own = &g_jobs.deques[s_worker];
+    for (int c = chunks - 1; c > 0; c--) {
+        int begin = c * grain;
+        Job job = {
+            .fn      = fn,
+            .ctx     = ctx,
+            .begin   = begin,
+            .end     = begin + grain < count ? begin + grain : count,
+            .pending = &pending,
+        };
+        if (!deque_push(own, &job)) job_run(&job);
+    }
+    pthread_mutex_lock(&g_jobs.lock);
+    g_jobs.generation++;
+    pthread_cond_broadcast(&g_jobs.wake);
+    pthread_mutex_unlock(&g_jobs.lock);
+
+    job_run(&(Job){ .fn = fn, .ctx = ctx, .begin = 0, .end = grain, .pending = &pending });
+    while (0 < atomic_load_explicit(&pending, memory_order_acquire)) {
+        Job job;
+        if (job_find(&job)) job_run(&job);
+    }
+}
+
+#endif /* JOB_SYSTEM_THREADED */
@@ -0,0 +1,36 @@
+#ifndef CYBERIA_JOB_SYSTEM_H
+#define CYBERIA_JOB_SYSTEM_H
+
+/* Fixed worker pool for data-parallel frame stages.
+ *
+ * parallel_for() splits [0, count) into `grain`-sized chunks, runs the
+ * first on the calling thread and pushes the rest onto the caller's deque.
+ * Each worker owns a Chase–Lev deque: it pops its own chunks LIFO and
+ * steals others' FIFO when empty, so nested parallel_for calls from inside
+ * a chunk balance too. The call returns once every chunk has run; chunks
+ * must touch disjoint data.
+ *
+ * Threads exist only in a pthreads build (__EMSCRIPTEN_PTHREADS__, or
+ * JOB_SYSTEM_THREADED defined by the build). Otherwise the pool is empty
+ * and parallel_for runs the whole range inline as one call. */
+
+#if !defined(JOB_SYSTEM_THREADED) && defined(__EMSCRIPTEN_PTHREADS__)
+#define JOB_SYSTEM_THREADED 1
+#endif
+
+#define JOB_MAX_WORKERS 4     /* threads besides the main thread */
+#define JOB_DEQUE_CAP   256   /* chunks queued per thread; overflow runs inline */
+
+typedef void (*JobRangeFn)(int begin, int end, void* ctx);
+
+/* Start the pool, sized to the logical cores less the main thread (at most
+ * JOB_MAX_WORKERS). Main thread only; idempotent. */
+void job_system_init(void);
+
+/* Worker threads running; 0 in the single-threaded build. */
+int  job_system_worker_count(void);
+
+/* Run fn over [0, count) in chunks of at least `grain` items. */
+void parallel_for(int count, int grain, JobRangeFn fn, void* ctx);
+
+#endif /* CYBERIA_JOB_SYSTEM_H */
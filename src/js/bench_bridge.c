@@ -0,0 +1,47 @@
+#include "bench_bridge.h"
+
+#include "bench_scene.h"
+
+#include <emscripten/emscripten.h>
+
+EMSCRIPTEN_KEEPALIVE
+uint8_t* c_bench_capture_alloc(uint32_t size) {
+    return bench_scene_capture_buffer(size);
+}
+
+EMSCRIPTEN_KEEPALIVE
+void c_bench_capture_loaded(int size) {
+    bench_scene_capture_loaded(size);
+}
+
+void bench_bridge_publish(const char* json, const char* report_url) {
+    EM_ASM({
+        var json = UTF8ToString($0), url = UTF8ToString($1);
+        console.log('[BENCH] ' + json);
+        window.CyberiaBench = { report: JSON.parse(json) };
+        if (url) {
+            fetch(url, { method: 'POST', headers: { 'Content-Type': 'application/json' }, body: json })
+                .catch(function(e) { console.warn('[BENCH] report POST failed: ' + e); });
+        }
+    }, json, report_url ? report_url : "");
+}
+
+void bench_bridge_fetch_capture(const char* url) {
+    EM_ASM({
+        fetch(UTF8ToString($0))
+            .then(function(res) {
+                if (!res.ok) throw new Error('HTTP ' + res.status);
+                return res.arrayBuffer();
+            })
+            .then(function(buf) {
+                var ptr = Module._c_bench_capture_alloc(buf.byteLength);
+                if (!ptr) throw new Error('out of memory');
+                HEAPU8.set(new Uint8Array(buf), ptr);
+                Module._c_bench_capture_loaded(buf.byteLength);
+            })
+            .catch(function(e) {
+                console.warn('[BENCH] capture fetch failed: ' + e);
+                Module._c_bench_capture_loaded(-1);
+            });
+    }, url);
+}
@@ -0,0 +1,26 @@
+#ifndef CYBERIA_JS_BENCH_BRIDGE_H
+#define CYBERIA_JS_BENCH_BRIDGE_H
+
+#include <stdint.h>
+
+/* JS side of the scripted bench runs (bench_scene.h).
+ *
+ * bench_bridge_publish() logs the finished report as one "[BENCH] {...}"
+ * console line, keeps it as window.CyberiaBench.report for headless
+ * runners to poll, and POSTs it as application/json when a report URL is
+ * given. bench_bridge_fetch_capture() downloads a session capture for the
+ * "replay" scenario and hands its bytes to bench_scene_capture_loaded(). */
+
+void bench_bridge_publish(const char* json, const char* report_url);
+
+void bench_bridge_fetch_capture(const char* url);
+
+/* ── C functions (EMSCRIPTEN_KEEPALIVE, called from JS as Module._xxx) ── */
+
+/* Buffer for a capture of `size` bytes, owned by bench_scene; NULL on OOM. */
+uint8_t* c_bench_capture_alloc(uint32_t size);
+
+/* The buffer from c_bench_capture_alloc() is filled; negative on failure. */
+void c_bench_capture_loaded(int size);
+
+#endif /* CYBERIA_JS_BENCH_BRIDGE_H */
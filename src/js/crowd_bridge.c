@@ -0,0 +1,65 @@
+#include "crowd_bridge.h"
+
+#include "crowd_gen.h"
+
+#include <emscripten/emscripten.h>
+
+EMSCRIPTEN_KEEPALIVE
+void c_crowd_start(int bots, int players, int layers, float hz, float churn, float speed) {
+    CrowdGenConfig config = CROWD_GEN_DEFAULTS;
+    if (0 <= bots)     config.bots        = bots;
+    if (0 <= players)  config.players     = players;
+    if (0 < layers)    config.layers      = layers;
+    if (0.0f < hz)     config.snapshot_hz = hz;
+    if (0.0f <= churn) config.churn_per_s = churn;
+    if (0.0f < speed)  config.speed       = speed;
+    crowd_gen_start(&config);
+}
+
+EMSCRIPTEN_KEEPALIVE
+void c_crowd_stop(void) {
+    crowd_gen_stop();
+}
+
+EMSCRIPTEN_KEEPALIVE
+int c_crowd_active(void) { return crowd_gen_active() ? 1 : 0; }
+
+EMSCRIPTEN_KEEPALIVE
+uint32_t c_crowd_frames(void) { return crowd_gen_stats().frames; }
+
+EMSCRIPTEN_KEEPALIVE
+uint32_t c_crowd_entered(void) { return crowd_gen_stats().entered; }
+
+EMSCRIPTEN_KEEPALIVE
+uint32_t c_crowd_left(void) { return crowd_gen_stats().left; }
+
+EMSCRIPTEN_KEEPALIVE
+uint32_t c_crowd_last_bytes(void) { return crowd_gen_stats().last_bytes; }
+
+EMSCRIPTEN_KEEPALIVE
+double c_crowd_last_decode_ms(void) { return crowd_gen_stats().last_decode_ms; }
+
+void crowd_bridge_install(void) {
+    EM_ASM({
+        var num = function(v, fallback) { return 'number' === typeof v ? v : fallback; };
+        window.CyberiaCrowd = {
+            start: function(opts) {
+                opts = opts || {};
+                Module._c_crowd_start(num(opts.bots, -1), num(opts.players, -1),
+                                      num(opts.layers, 0), num(opts.hz, 0),
+                                      num(opts.churn, -1), num(opts.speed, 0));
+            },
+            stop: function() { Module._c_crowd_stop(); },
+            status: function() {
+                return { active: !!Module._c_crowd_active(),
+                         frames: Module._c_crowd_frames() >>> 0,
+                         entered: Module._c_crowd_entered() >>> 0,
+                         left: Module._c_crowd_left() >>> 0,
+                         bytes: Module._c_crowd_last_bytes() >>> 0,
+                         decodeMs: Module._c_crowd_last_decode_ms() };
+            },
+        };
+        var bots = new URLSearchParams(window.location.search).get('crowd');
+        if (null !== bots) window.CyberiaCrowd.start({ bots: parseInt(bots, 10) || 0 });
+    });
+}
@@ -0,0 +1,32 @@
+#ifndef CYBERIA_JS_CROWD_BRIDGE_H
+#define CYBERIA_JS_CROWD_BRIDGE_H
+
+#include <stdint.h>
+
+/* JS control of the synthetic crowd (crowd_gen.h); dev builds only.
+ *
+ * crowd_bridge_install() publishes window.CyberiaCrowd with
+ *   start({ bots, players, layers, hz, churn, speed })
+ *                   → replace any crowd; omitted keys take CROWD_GEN_DEFAULTS
+ *   stop()          → remove every synthetic agent
+ *   status()        → { active, frames, entered, left, bytes, decodeMs }
+ * and starts a default crowd when the page URL carries ?crowd=<bots>. */
+
+/* Install window.CyberiaCrowd. */
+void crowd_bridge_install(void);
+
+/* ── C functions (EMSCRIPTEN_KEEPALIVE, called from JS as Module._xxx) ── */
+
+/* Negative counts and non-positive rates take the defaults. */
+void c_crowd_start(int bots, int players, int layers, float hz, float churn, float speed);
+
+void c_crowd_stop(void);
+
+int      c_crowd_active(void);
+uint32_t c_crowd_frames(void);
+uint32_t c_crowd_entered(void);
+uint32_t c_crowd_left(void);
+uint32_t c_crowd_last_bytes(void);
+double   c_crowd_last_decode_ms(void);
+
+#endif /* CYBERIA_JS_CROWD_BRIDGE_H */
@@ -0,0 +1,116 @@
+#include "image_decode_bridge.h"
+
+#include "image_decoder.h"
+
+#include <emscripten/emscripten.h>
+#include <raylib.h>
+
+bool image_decode_bridge_available(void) {
+    return 0 != EM_ASM_INT({ return typeof createImageBitmap === 'function' ? 1 : 0; });
+}
+
+/* Wrapped in a call so the JS commas stay inside parentheses of the macro
+ * argument. The Blob copies the bytes, so a heap view is enough. Bitmaps
+ * stay un-premultiplied; uploads keep them that way. */
+void image_decode_bridge_start(int id, const unsigned char* data, size_t size, int max_side) {
+    EM_ASM({
+        (function(id, bytes, maxSide) {
+            Module.cyberiaBitmaps = Module.cyberiaBitmaps || {};
+            var opts = { premultiplyAlpha: 'none', colorSpaceConversion: 'none' };
+            createImageBitmap(new Blob([bytes], { type: 'image/png' }), opts)
+                .then(function(bitmap) {
+                    var side = Math.max(bitmap.width, bitmap.height);
+                    if (0 >= maxSide || side <= maxSide) return bitmap;
+                    var k = maxSide / side;
+                    return createImageBitmap(bitmap, {
+                        premultiplyAlpha: 'none', colorSpaceConversion: 'none',
+                        resizeWidth: Math.max(1, Math.floor(bitmap.width * k)),
+                        resizeHeight: Math.max(1, Math.floor(bitmap.height * k)),
+                        resizeQuality: 'medium',
+                    }).then(function(small) { bitmap.close(); return small; },
+                            function() { return bitmap; });
+                })
+                .then(function(bitmap) {
+                    Module.cyberiaBitmaps[id] = bitmap;
+                    Module._c_image_bitmap_decoded(id, bitmap.width, bitmap.height);
+                })
+                .catch(function() { Module._c_image_bitmap_decoded(id, 0, 0); });
+        })($0, HEAPU8.subarray($1, $1 + $2), $3);
+    }, id, data, size, max_side);
+}
+
+unsigned image_decode_bridge_upload(int id) {
+    return (unsigned)EM_ASM_INT({
+        return (function(id) {
+            var bitmap = Module.cyberiaBitmaps && Module.cyberiaBitmaps[id];
+            if (!bitmap || typeof GLctx === 'undefined' || !GLctx) return 0;
+            var gl  = GLctx;
+            var tex = gl.createTexture();
+            gl.bindTexture(gl.TEXTURE_2D, tex);
+            gl.pixelStorei(gl.UNPACK_PREMULTIPLY_ALPHA_WEBGL, false);
+            gl.pixelStorei(gl.UNPACK_COLORSPACE_CONVERSION_WEBGL, gl.NONE);
+            gl.texImage2D(gl.TEXTURE_2D, 0, gl.RGBA, gl.RGBA, gl.UNSIGNED_BYTE, bitmap);
+            gl.texParameteri(gl.TEXTURE_2D, gl.TEXTURE_WRAP_S, gl.CLAMP_TO_EDGE);
+            gl.texParameteri(gl.TEXTURE_2D, gl.TEXTURE_WRAP_T, gl.CLAMP_TO_EDGE);
+            gl.texParameteri(gl.TEXTURE_2D, gl.TEXTURE_MIN_FILTER, gl.NEAREST);
+            gl.texParameteri(gl.TEXTURE_2D, gl.TEXTURE_MAG_FILTER, gl.NEAREST);
+            gl.bindTexture(gl.TEXTURE_2D, null);
+            var name = GL.getNewId(GL.textures);
+            tex.name = name;
+            GL.textures[name] = tex;
+            return name;
+        })($0);
+    }, id);
+}
+
+bool image_decode_bridge_upload_rect(int id, unsigned texture, int x, int y) {
+    return 0 != EM_ASM_INT({
+        return (function(id, name, x, y) {
+            var bitmap = Module.cyberiaBitmaps && Module.cyberiaBitmaps[id];
+            var tex    = GL.textures[name];
+            if (!bitmap || !tex || typeof GLctx === 'undefined' || !GLctx) return 0;
+            var gl = GLctx;
+            gl.bindTexture(gl.TEXTURE_2D, tex);
+            gl.pixelStorei(gl.UNPACK_PREMULTIPLY_ALPHA_WEBGL, false);
+            gl.pixelStorei(gl.UNPACK_COLORSPACE_CONVERSION_WEBGL, gl.NONE);
+            gl.texSubImage2D(gl.TEXTURE_2D, 0, x, y, gl.RGBA, gl.UNSIGNED_BYTE, bitmap);
+            gl.bindTexture(gl.TEXTURE_2D, null);
+            return 1;
+        })($0, $1, $2, $3);
+    }, id, texture, x, y);
+}
+
+void image_decode_bridge_release(int id) {
+    EM_ASM({
+        (function(id) {
+            var bitmap = Module.cyberiaBitmaps && Module.cyberiaBitmaps[id];
+            if (!bitmap) return;
+            bitmap.close();
+            delete Module.cyberiaBitmaps[id];
+        })($0);
+    }, id);
+}
+
+int image_decode_bridge_gpu_formats(void) {
+    return EM_ASM_INT({
+        if (typeof GLctx === 'undefined' || !GLctx) return -1;
+        return GLctx.getExtension('WEBGL_compressed_texture_s3tc') ? $0 : 0;
+    }, IMAGE_GPU_S3TC);
+}
+
+EMSCRIPTEN_KEEPALIVE
+void c_image_bitmap_decoded(int id, int w, int h) {
+    DecodedImage decoded = { 0 };
+    if (0 < w && 0 < h) {
+        decoded = (DecodedImage){
+            .image  = {
+                .width   = w,
+                .height  = h,
+                .mipmaps = 1,
+                .format  = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8,
+            },
+            .bitmap = id,
+        };
+    }
+    image_decoder_complete(id, decoded);
+}
@@ -0,0 +1,45 @@
+#ifndef CYBERIA_JS_IMAGE_DECODE_BRIDGE_H
+#define CYBERIA_JS_IMAGE_DECODE_BRIDGE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/* Browser image decode bridge (Web only, via inline EM_ASM). Hands PNG
+ * bytes to createImageBitmap, which decodes off the main thread, and keeps
+ * the ImageBitmap on the JS side under the job id: its pixels never enter
+ * the WASM heap, they go from the bitmap straight to texImage2D.
+ * Completion comes back through image_decoder_complete() (image_decoder.h)
+ * on a later event-loop turn. */
+
+/* True when the browser has createImageBitmap. */
+bool image_decode_bridge_available(void);
+
+/* Start decoding `size` bytes at `data` as job `id`. The bytes are copied
+ * (into a Blob, off the heap) before this returns. With `max_side` > 0 a
+ * larger bitmap is resized (aspect kept) to fit it and the full-size one
+ * closed, so only the small one is ever uploaded. */
+void image_decode_bridge_start(int id, const unsigned char* data, size_t size, int max_side);
+
+/* Upload bitmap `id` as a new RGBA8 texture, nearest-filtered and clamped
+ * as raylib loads NPOT textures under WebGL 1. Returns the GL texture id,
+ * registered with emscripten's GL table so UnloadTexture can delete it;
+ * 0 when the bitmap or the context is gone. */
+unsigned image_decode_bridge_upload(int id);
+
+/* texSubImage2D bitmap `id` into GL texture `texture` at (x, y). */
+bool image_decode_bridge_upload_rect(int id, unsigned texture, int x, int y);
+
+/* Close bitmap `id` and forget it. */
+void image_decode_bridge_release(int id);
+
+/* IMAGE_GPU_* bits of the compressed-texture extensions the WebGL
+ * context offers (enabling them), or -1 before the context exists. */
+int  image_decode_bridge_gpu_formats(void);
+
+/* ── C functions (EMSCRIPTEN_KEEPALIVE, called from JS as Module._xxx) ── */
+
+/* Decode `id` finished: a w × h bitmap held under `id`, or 0 × 0 on
+ * failure. */
+void c_image_bitmap_decoded(int id, int w, int h);
+
+#endif /* CYBERIA_JS_IMAGE_DECODE_BRIDGE_H */
@@ -14,9 +14,12 @@
  * The C interaction modal opens this overlay directly on the requested tab.
  *
  * Architecture:
- *   C interaction_bubble click  →  js_interact_overlay_open()         → JS panel
+ *   C interaction_bubble click  →  OVERLAY_CMD_OPEN / _OL_STACK       → JS panel
  *   JS chat send                →  c_send_chat_binary()               → C binary uplink
- *   C incoming chat             →  js_interact_overlay_receive_chat() → JS update
+ *   C incoming chat             →  OVERLAY_CMD_CHAT                   → JS update
+ *
+ * C → JS records arrive batched, once per frame, via
+ * js_overlay_commands_drain() (see js/overlay_commands.h).
  *
  * DOM is built once and reused (hide/show) to avoid expensive rebuilds.
  */
@@ -72,6 +75,12 @@ mergeInto(LibraryManager.library, {
     activeTab: 'chat',
     initialTab: 'chat',
     chatHistory: [],
+    /* Incremental chat list: the history array the rows were drawn from,
+     * how many of its entries are drawn, and detached rows kept for reuse. */
+    chatSource: null,
+    chatRendered: 0,
+    chatRows: 0,
+    chatPool: [],
     dom: {},
   },
 
@@ -106,6 +115,9 @@ mergeInto(LibraryManager.library, {
     qcBg: 'rgba(22,26,48,0.85)',
   },
 
+  /* Rows kept in the chat list; older ones are recycled as new ones arrive. */
+  $IP_CHAT_WINDOW: 50,
+
   $IP_QC: ['Hello!', 'GG', 'Help!', 'Trade?', 'Follow me', 'Thanks!'],
 
   /* ================================================================
@@ -214,6 +226,31 @@ mergeInto(LibraryManager.library, {
       document.head.appendChild(sheet);
     }
 
+    /* chat rows share classes instead of per-node inline styles */
+    if (!document.getElementById('ip-chat-css')) {
+      var chatSheet = document.createElement('style');
+      chatSheet.id = 'ip-chat-css';
+      chatSheet.textContent =
+        '.ip-chat-list{flex:1;background:' +
+        S.chatBg +
+        ';border-radius:4px;padding:6px;min-height:60px;overflow-y:auto;font-size:13px;' +
+        'line-height:1.35;margin-bottom:6px;-webkit-overflow-scrolling:touch}' +
+        '.ip-chat-row{margin-bottom:2px}' +
+        '.ip-chat-who{font-weight:bold;color:' +
+        S.chatThem +
+        '}' +
+        '.ip-chat-me .ip-chat-who{color:' +
+        S.chatMe +
+        '}' +
+        '.ip-chat-txt{color:' +
+        S.textCol +
+        '}' +
+        '.ip-chat-hint{color:' +
+        S.hintCol +
+        ';font-size:12px;font-style:italic}';
+      document.head.appendChild(chatSheet);
+    }
+
     /* No backdrop — panel fills the whole screen so there's no
      * "outside" area to tap. Only the X button closes the overlay. */
 
@@ -335,6 +372,7 @@ mergeInto(LibraryManager.library, {
     '$ipEl',
     '$ipBtn',
     '$ipRenderChat',
+    '$ipRecycleChat',
     '$ipBuildIntegrationTab',
     '$ipBuildChatTab',
   ],
@@ -344,7 +382,10 @@ mergeInto(LibraryManager.library, {
 
     P.activeTab = tabId;
 
-    /* Rebuild body for the selected tab */
+    /* Rebuild body for the selected tab; chat rows go back to the pool
+     * so the new list reuses them. */
+    ipRecycleChat();
+    D.chatList = null;
     D.tabBody.innerHTML = '';
 
     switch (tabId) {
@@ -531,22 +572,9 @@ mergeInto(LibraryManager.library, {
       D = P.dom;
 
     /* message list — flex-fill to use available height */
-    D.chatList = ipEl(
-      'div',
-      {
-        flex: '1',
-        background: S.chatBg,
-        borderRadius: '4px',
-        padding: '6px',
-        minHeight: '60px',
-        overflowY: 'auto',
-        fontSize: '13px',
-        lineHeight: '1.35',
-        marginBottom: '6px',
-        WebkitOverflowScrolling: 'touch',
-      },
-      container,
-    );
+    D.chatList = ipEl('div', null, container);
+    D.chatList.className = 'ip-chat-list';
+    P.chatSource = null;
 
     ipRenderChat();
 
@@ -623,34 +651,69 @@ mergeInto(LibraryManager.library, {
   },
 
   /* ================================================================
-   * Render chat messages
+   * Render chat messages — append-only; rows past the window and rows
+   * of a replaced list are recycled rather than rebuilt.
    * ================================================================ */
 
-  $ipRenderChat__deps: ['$IP', '$IPS', '$ipEl'],
-  $ipRenderChat: function () {
+  $ipRecycleChat__deps: ['$IP', '$IP_CHAT_WINDOW'],
+  $ipRecycleChat: function () {
     var P = IP,
-      S = IPS,
       box = P.dom.chatList;
     if (!box) return;
+    while (box.lastChild) {
+      var node = box.removeChild(box.lastChild);
+      if (node.className !== 'ip-chat-hint' && P.chatPool.length < IP_CHAT_WINDOW) P.chatPool.push(node);
+    }
+    P.chatRows = 0;
+    P.chatRendered = 0;
+    P.chatSource = null;
+  },
+
+  $ipChatRow__deps: ['$IP', '$IP_CHAT_WINDOW', '$ipEl'],
+  $ipChatRow: function (box) {
+    var P = IP;
+    if (P.chatRows >= IP_CHAT_WINDOW) return box.appendChild(box.firstChild);
+    P.chatRows++;
+    if (P.chatPool.length) return box.appendChild(P.chatPool.pop());
+    var row = ipEl('div', null, box);
+    ipEl('span', null, row).className = 'ip-chat-who';
+    ipEl('span', null, row).className = 'ip-chat-txt';
+    return row;
+  },
+
+  $ipRenderChat__deps: ['$IP', '$IP_CHAT_WINDOW', '$ipEl', '$ipRecycleChat', '$ipChatRow'],
+  $ipRenderChat: function () {
+    var P = IP,
+      D = P.dom,
+      box = D.chatList;
+    if (!box) return;
 
-    box.innerHTML = '';
+    var history = P.chatHistory;
+    if (P.chatSource !== history || P.chatRendered > history.length) {
+      ipRecycleChat();
+      P.chatSource = history;
+    }
 
-    if (P.chatHistory.length === 0) {
-      var hint = ipEl('div', { color: S.hintCol, fontSize: '12px', fontStyle: 'italic' }, box);
-      hint.textContent = 'No messages yet\u2026';
+    if (history.length === 0) {
+      if (!D.chatHint) {
+        D.chatHint = ipEl('div', null, null);
+        D.chatHint.className = 'ip-chat-hint';
+        D.chatHint.textContent = 'No messages yet\u2026';
+      }
+      if (D.chatHint.parentNode !== box) box.appendChild(D.chatHint);
       return;
     }
+    if (D.chatHint && D.chatHint.parentNode === box) box.removeChild(D.chatHint);
 
-    var history = P.chatHistory;
-    var start = history.length > 50 ? history.length - 50 : 0;
+    var start = Math.max(P.chatRendered, history.length - IP_CHAT_WINDOW);
     for (var i = start; i < history.length; i++) {
       var m = history[i];
-      var row = ipEl('div', { marginBottom: '2px' }, box);
-      var who = ipEl('span', { color: m.isMe ? S.chatMe : S.chatThem, fontWeight: 'bold' }, row);
-      who.textContent = m.sender + ': ';
-      var txt = ipEl('span', { color: S.textCol }, row);
-      txt.textContent = m.text;
+      var row = ipChatRow(box);
+      row.className = m.isMe ? 'ip-chat-row ip-chat-me' : 'ip-chat-row';
+      row.firstChild.textContent = m.sender + ': ';
+      row.lastChild.textContent = m.text;
     }
+    P.chatRendered = history.length;
 
     box.scrollTop = box.scrollHeight;
   },
@@ -687,11 +750,11 @@ mergeInto(LibraryManager.library, {
    * Public API — called from C via extern declarations
    * ================================================================ */
 
-  js_interact_overlay_open__deps: ['$IP', '$IPStore', '$ipStoreEnsure', '$ipBuild', '$ipPopulate'],
-  js_interact_overlay_open: function (
-    entity_id_ptr,
-    display_name_ptr,
-    dlg_item_id_ptr,
+  $ipOpen__deps: ['$IP', '$IPStore', '$ipStoreEnsure', '$ipBuild', '$ipPopulate'],
+  $ipOpen: function (
+    entityId,
+    displayName,
+    dlgItemId,
     interact_flags,
     is_player,
     is_self,
@@ -703,9 +766,9 @@ mergeInto(LibraryManager.library, {
   ) {
     var P = IP;
 
-    P.entityId = UTF8ToString(entity_id_ptr);
-    P.displayName = UTF8ToString(display_name_ptr);
-    P.dlgItemId = UTF8ToString(dlg_item_id_ptr);
+    P.entityId = entityId;
+    P.displayName = displayName;
+    P.dlgItemId = dlgItemId;
     P.interactFlags = interact_flags;
     P.isPlayer = !!is_player;
     P.isSelf = !!is_self;
@@ -731,15 +794,10 @@ mergeInto(LibraryManager.library, {
     P.el.style.display = 'flex';
   },
 
-  js_interact_overlay_set_ol_stack__deps: ['$IP', '$ipPopulate'],
-  js_interact_overlay_set_ol_stack: function (json_ptr) {
+  $ipSetOlStack__deps: ['$IP', '$ipPopulate'],
+  $ipSetOlStack: function (stack) {
     var P = IP;
-    var json = UTF8ToString(json_ptr);
-    try {
-      P.olStack = JSON.parse(json);
-    } catch (e) {
-      P.olStack = [];
-    }
+    P.olStack = stack;
     /* Re-populate so the dialog tab picks up the OL data. */
     if (P.open && P.el) ipPopulate();
   },
@@ -787,12 +845,9 @@ mergeInto(LibraryManager.library, {
     _free(textPtr);
   },
 
-  js_interact_overlay_receive_chat__deps: ['$IP', '$IPStore', '$ipStoreEnsure', '$ipRenderChat'],
-  js_interact_overlay_receive_chat: function (from_id_ptr, from_name_ptr, text_ptr) {
+  $ipReceiveChat__deps: ['$IP', '$IPStore', '$ipStoreEnsure', '$ipRenderChat'],
+  $ipReceiveChat: function (fromId, fromName, text) {
     var P = IP;
-    var fromId = UTF8ToString(from_id_ptr);
-    var fromName = UTF8ToString(from_name_ptr);
-    var text = UTF8ToString(text_ptr);
 
     /* Persist history so the chat tab survives overlay open/close. The
      * unread badge is owned by the C interaction modal's Chat button. */
@@ -805,4 +860,83 @@ mergeInto(LibraryManager.library, {
       if (P.activeTab === 'chat') ipRenderChat();
     }
   },
+
+  /* ================================================================
+   * Batched command buffer (js/overlay_commands.h) — one call per frame
+   * walks the records C wrote on the heap, in order.
+   * Record: u8 type, u8 reserved, u16 payload bytes, payload; 4-aligned.
+   * String: u16 byte length + UTF-8 bytes.
+   * ================================================================ */
+
+  js_overlay_commands_drain__deps: ['$UTF8ArrayToString', '$ipOpen', '$ipSetOlStack', '$ipReceiveChat'],
+  js_overlay_commands_drain: function (buf, len) {
+    var end = buf + len;
+    var at = buf;
+    var u8 = function () {
+      return HEAPU8[at++];
+    };
+    var u16 = function () {
+      var v = HEAPU8[at] | (HEAPU8[at + 1] << 8);
+      at += 2;
+      return v;
+    };
+    var u32 = function () {
+      var lo = u16();
+      return (lo | (u16() << 16)) >>> 0;
+    };
+    var str = function () {
+      var n = u16();
+      var v = n ? UTF8ArrayToString(HEAPU8, at, n) : '';
+      at += n;
+      return v;
+    };
+
+    while (at + 4 <= end) {
+      var type = HEAPU8[at];
+      var size = HEAPU8[at + 2] | (HEAPU8[at + 3] << 8);
+      var next = at + ((4 + size + 3) & ~3);
+      at += 4;
+      switch (type) {
+        case 1: /* OVERLAY_CMD_OPEN */ {
+          var flags = u32();
+          var isPlayer = u8();
+          var isSelf = u8();
+          var r = u8(),
+            g = u8(),
+            b = u8(),
+            a = u8();
+          var tab = u8();
+          var entityId = str();
+          var displayName = str();
+          ipOpen(entityId, displayName, str(), flags, isPlayer, isSelf, r, g, b, a, tab);
+          break;
+        }
+        case 2: /* OVERLAY_CMD_OL_STACK */ {
+          var count = u16();
+          var stack = [];
+          for (var i = 0; i < count; i++) {
+            var itemId = str();
+            var itemType = str();
+            stack.push({ itemId: itemId, type: itemType, hasDialogue: !!u8() });
+          }
+          ipSetOlStack(stack);
+          break;
+        }
+        case 3: /* OVERLAY_CMD_CHAT */ {
+          var fromId = str();
+          var fromName = str();
+          ipReceiveChat(fromId, fromName, str());
+          break;
+        }
+        case 4: /* OVERLAY_CMD_PROGRESS */ {
+          var pct = u16() / 100;
+          var hasLabel = u8();
+          var label = str();
+          if (window.CyberiaLoading) CyberiaLoading.progress(pct, hasLabel ? label : null);
+          break;
+        }
+      }
+      at = next;
+    }
+  },
 });
@@ -1,18 +1,32 @@
 #include "loading_bridge.h"
 
+#include "overlay_commands.h"
+
 #include <emscripten/emscripten.h>
+#include <string.h>
+
+/* Last values sent, so unchanged frames never cross into JS. */
+static struct {
+    int  pct;
+    char label[128];
+    bool ghost;
+} g_loading_sent = { .pct = -1 };
 
 void loading_bridge_progress(float pct, const char* label) {
-    EM_ASM(
-        {
-            if (window.CyberiaLoading) {
-                CyberiaLoading.progress($0, $1 ? UTF8ToString($1) : null);
-            }
-        },
-        pct, label);
+    int whole = (int)pct;
+    bool same_label = NULL == label || 0 == strncmp(label, g_loading_sent.label,
+                                                    sizeof(g_loading_sent.label) - 1);
+    if (whole == g_loading_sent.pct && same_label) return;
+    g_loading_sent.pct = whole;
+    if (label) {
+        strncpy(g_loading_sent.label, label, sizeof(g_loading_sent.label) - 1);
+    }
+    overlay_commands_progress(pct, label);
 }
 
+/* Queued progress records must land before the state change. */
 void loading_bridge_ready(void) {
+    overlay_commands_flush();
     EM_ASM({
         if (window.CyberiaLoading) CyberiaLoading.setReady();
     });
@@ -25,7 +39,16 @@ bool loading_bridge_start_requested(void) {
            });
 }
 
+void loading_bridge_ghost(bool on) {
+    if (on == g_loading_sent.ghost) return;
+    g_loading_sent.ghost = on;
+    EM_ASM({
+        if (window.CyberiaLoading) CyberiaLoading.ghost(!!$0);
+    }, on);
+}
+
 void loading_bridge_hide(void) {
+    overlay_commands_flush();
     EM_ASM({
         if (window.CyberiaLoading) CyberiaLoading.hide();
     });
@@ -13,7 +13,10 @@
 
 /* Report live progress: `pct` is 0..100 from real stage/fetch accounting
  * (the overlay clamps it monotonic) and `label` names the stage or asset
- * currently loading (NULL keeps the current text). */
+ * currently loading (NULL keeps the current text). Called every preload
+ * frame; only a change of whole percent or label is queued, and it reaches
+ * the DOM with the frame's overlay_commands_flush(), so the overlay does
+ * not restyle and relayout under the render loop each frame. */
 void loading_bridge_progress(float pct, const char* label);
 
 /* All stages done: stop the progress state and show "TAP TO START". */
@@ -22,6 +25,11 @@ void loading_bridge_ready(void);
 /* True once the player tapped/keyed the ready overlay. */
 bool loading_bridge_start_requested(void);
 
+/* While `on`, the overlay turns translucent over the ghost world restored
+ * from a session snapshot (network/session_snapshot.h). Called every
+ * preload frame; only a change reaches the DOM. */
+void loading_bridge_ghost(bool on);
+
 /* Fade the overlay out and remove it from the DOM. */
 void loading_bridge_hide(void);
 
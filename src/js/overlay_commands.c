@@ -0,0 +1,140 @@
+#include "overlay_commands.h"
+
+#include "util/log.h"
+
+#include <assert.h>
+#include <stdalign.h>
+#include <string.h>
+
+#define RECORD_ALIGN  4u
+#define HEADER_BYTES  4u
+#define STRING_MAX    0xffffu
+
+/* Implemented in interact_overlay.js. */
+extern void js_overlay_commands_drain(const uint8_t* buf, int len);
+
+static_assert(0 == (OVERLAY_COMMANDS_BYTES % RECORD_ALIGN), "buffer holds whole records");
+
+static struct {
+    alignas(RECORD_ALIGN) uint8_t buf[OVERLAY_COMMANDS_BYTES];
+    uint32_t len;
+    bool     draining;
+} g_overlay_cmds;
+
+static uint32_t str_len(const char* s) {
+    size_t n = s ? strlen(s) : 0;
+    return STRING_MAX < n ? STRING_MAX : (uint32_t)n;
+}
+
+static uint32_t str_bytes(const char* s) { return 2u + str_len(s); }
+
+/* Payload cursor for the record just reserved; NULL when it is larger than
+ * the buffer, or the buffer is still full because a drain is running. */
+static uint8_t* reserve(OverlayCommandType type, uint32_t payload) {
+    uint32_t size = (HEADER_BYTES + payload + RECORD_ALIGN - 1) & ~(RECORD_ALIGN - 1);
+    if (OVERLAY_COMMANDS_BYTES < size || 0xffffu < payload) {
+        LOG_WARN("overlay command %d dropped: %u bytes", (int)type, payload);
+        return NULL;
+    }
+    if (OVERLAY_COMMANDS_BYTES - g_overlay_cmds.len < size) overlay_commands_flush();
+    if (OVERLAY_COMMANDS_BYTES - g_overlay_cmds.len < size) {
+        LOG_WARN("overlay command %d dropped: buffer full while draining", (int)type);
+        return NULL;
+    }
+
+    uint8_t* p = &g_overlay_cmds.buf[g_overlay_cmds.len];
+    memset(p, 0, size);
+    p[0] = (uint8_t)type;
+    p[2] = (uint8_t)(payload & 0xff);
+    p[3] = (uint8_t)(payload >> 8);
+    g_overlay_cmds.len += size;
+    return p + HEADER_BYTES;
+}
+
+static uint8_t* put_u8(uint8_t* p, uint32_t v) {
+    *p = (uint8_t)v;
+    return p + 1;
+}
+
+static uint8_t* put_u16(uint8_t* p, uint32_t v) {
+    p[0] = (uint8_t)(v & 0xff);
+    p[1] = (uint8_t)(v >> 8);
+    return p + 2;
+}
+
+static uint8_t* put_u32(uint8_t* p, uint32_t v) {
+    return put_u16(put_u16(p, v & 0xffff), v >> 16);
+}
+
+static uint8_t* put_str(uint8_t* p, const char* s) {
+    uint32_t n = str_len(s);
+    p = put_u16(p, n);
+    if (0 < n) memcpy(p, s, n);
+    return p + n;
+}
+
+void overlay_commands_open(const OverlayOpenCommand* cmd) {
+    assert(cmd);
+    uint32_t payload = 4 + 1 + 1 + 4 + 1 + str_bytes(cmd->entity_id) +
+                       str_bytes(cmd->display_name) + str_bytes(cmd->dialogue_item_id);
+    uint8_t* p = reserve(OVERLAY_CMD_OPEN, payload);
+    if (NULL == p) return;
+    p = put_u32(p, cmd->interact_flags);
+    p = put_u8(p, cmd->is_player ? 1 : 0);
+    p = put_u8(p, cmd->is_self ? 1 : 0);
+    for (int i = 0; i < 4; i++) p = put_u8(p, cmd->border[i]);
+    p = put_u8(p, (uint32_t)cmd->initial_tab);
+    p = put_str(p, cmd->entity_id);
+    p = put_str(p, cmd->display_name);
+    put_str(p, cmd->dialogue_item_id);
+}
+
+void overlay_commands_ol_stack(const OverlayStackItem* items, int count) {
+    assert(items || 0 == count);
+    uint32_t payload = 2;
+    for (int i = 0; i < count; i++) {
+        payload += str_bytes(items[i].item_id) + str_bytes(items[i].type) + 1;
+    }
+    uint8_t* p = reserve(OVERLAY_CMD_OL_STACK, payload);
+    if (NULL == p) return;
+    p = put_u16(p, (uint32_t)count);
+    for (int i = 0; i < count; i++) {
+        p = put_str(p, items[i].item_id);
+        p = put_str(p, items[i].type);
+        p = put_u8(p, items[i].has_dialogue ? 1 : 0);
+    }
+}
+
+void overlay_commands_chat(const char* from_id, const char* from_name, const char* text) {
+    uint32_t payload = str_bytes(from_id) + str_bytes(from_name) + str_bytes(text);
+    uint8_t* p = reserve(OVERLAY_CMD_CHAT, payload);
+    if (NULL == p) return;
+    p = put_str(p, from_id);
+    p = put_str(p, from_name);
+    put_str(p, text);
+}
+
+void overlay_commands_progress(float pct, const char* label) {
+    /* Percent in hundredths; flag 0 keeps the current label. */
+    float clamped = 0.0f > pct ? 0.0f : (100.0f < pct ? 100.0f : pct);
+    uint8_t* p = reserve(OVERLAY_CMD_PROGRESS, 2 + 1 + str_bytes(label));
+    if (NULL == p) return;
+    p = put_u16(p, (uint32_t)(clamped * 100.0f + 0.5f));
+    p = put_u8(p, label ? 1 : 0);
+    put_str(p, label);
+}
+
+/* A JS handler may call back into C and queue more records while the
+ * buffer is being walked: those land after the drained bytes and are moved
+ * to the front for the next flush. */
+void overlay_commands_flush(void) {
+    if (0 == g_overlay_cmds.len || g_overlay_cmds.draining) return;
+    uint32_t len = g_overlay_cmds.len;
+    g_overlay_cmds.draining = true;
+    js_overlay_commands_drain(g_overlay_cmds.buf, (int)len);
+    g_overlay_cmds.draining = false;
+    g_overlay_cmds.len -= len;
+    if (0 < g_overlay_cmds.len) {
+        memmove(g_overlay_cmds.buf, &g_overlay_cmds.buf[len], g_overlay_cmds.len);
+    }
+}
@@ -0,0 +1,66 @@
+#ifndef CYBERIA_JS_OVERLAY_COMMANDS_H
+#define CYBERIA_JS_OVERLAY_COMMANDS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Batched C → JS command buffer for the DOM overlays.
+ *
+ * State pushes that used to be one bridge call each — overlay open with a
+ * dozen marshalled arguments, the OL stack as a JSON string, every chat
+ * message, every loading progress tick — are appended as typed binary
+ * records to a buffer on the WASM heap. overlay_commands_flush() hands the
+ * whole buffer to JS in one call (js_overlay_commands_drain in
+ * interact_overlay.js), which walks it straight off HEAPU8: no JSON, no
+ * per-field UTF8ToString round trips.
+ *
+ * Record layout, little endian, each record 4-byte aligned:
+ *   u8 type, u8 reserved, u16 payload bytes, payload
+ * Strings inside a payload are u16 byte length + UTF-8 bytes, no NUL.
+ *
+ * Records are applied in the order they were written. Synchronous bridge
+ * calls that must observe them (loading_bridge_ready/hide) flush first. A
+ * record that does not fit flushes early rather than being dropped. */
+
+#ifndef OVERLAY_COMMANDS_BYTES
+#define OVERLAY_COMMANDS_BYTES 16384
+#endif
+
+typedef enum {
+    OVERLAY_CMD_OPEN     = 1, /* interact overlay open for one entity */
+    OVERLAY_CMD_OL_STACK = 2, /* z-sorted item layers of the open entity */
+    OVERLAY_CMD_CHAT     = 3, /* incoming chat message */
+    OVERLAY_CMD_PROGRESS = 4, /* loading screen percent + optional label */
+} OverlayCommandType;
+
+typedef struct {
+    const char* entity_id;
+    const char* display_name;
+    const char* dialogue_item_id;
+    uint32_t    interact_flags;
+    bool        is_player;
+    bool        is_self;
+    uint8_t     border[4]; /* r, g, b, a */
+    int         initial_tab;
+} OverlayOpenCommand;
+
+typedef struct {
+    const char* item_id;
+    const char* type;
+    bool        has_dialogue;
+} OverlayStackItem;
+
+void overlay_commands_open(const OverlayOpenCommand* cmd);
+
+void overlay_commands_ol_stack(const OverlayStackItem* items, int count);
+
+void overlay_commands_chat(const char* from_id, const char* from_name, const char* text);
+
+/* `pct` 0..100; NULL `label` keeps the overlay's current text. */
+void overlay_commands_progress(float pct, const char* label);
+
+/* Hand every pending record to JS; no-op when empty. Called once at the
+ * end of each main-loop tick. */
+void overlay_commands_flush(void);
+
+#endif /* CYBERIA_JS_OVERLAY_COMMANDS_H */
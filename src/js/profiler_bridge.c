@@ -0,0 +1,203 @@
+#include "profiler_bridge.h"
+
+#include "dynamic_resolution.h"
+#include "heap_memory.h"
+#include "network/net_telemetry.h"
+#include "profiler.h"
+
+#include <emscripten/emscripten.h>
+#include <stdarg.h>
+#include <stdio.h>
+
+/* Sized for PROFILER_LONG_FRAMES full records; a trace that would overflow
+ * it is cut at the last whole record and flagged "truncated". Both exports
+ * share it. */
+#define PROFILER_EXPORT_SIZE 16384
+
+static struct {
+    char   buf[PROFILER_EXPORT_SIZE];
+    size_t len;
+    bool   overflow;
+} g_export;
+
+/* Baseline for the heap diff; zero until the first mark. */
+static HeapMemSnapshot g_heap_mark;
+
+static void put(const char* fmt, ...) {
+    if (g_export.overflow) return;
+    va_list ap;
+    va_start(ap, fmt);
+    int n = vsnprintf(g_export.buf + g_export.len, sizeof(g_export.buf) - g_export.len, fmt, ap);
+    va_end(ap);
+    if (n < 0 || (size_t)n >= sizeof(g_export.buf) - g_export.len) {
+        g_export.overflow = true;
+        return;
+    }
+    g_export.len += (size_t)n;
+}
+
+static void put_long_frame(const ProfilerLongFrame* lf) {
+    put("{\"frame\":%u,\"atMs\":%.1f,\"frameMs\":%.2f,\"zones\":{",
+        (unsigned)lf->frame, lf->at_ms, lf->frame_ms);
+    for (int z = 0; z < PROF_ZONE_COUNT; z++) {
+        put("%s\"%s\":%.2f", z ? "," : "", profiler_zone_name((ProfilerZone)z), lf->zone_ms[z]);
+    }
+    put("},\"counts\":{");
+    for (int c = 0; c < PROF_COUNT_COUNT; c++) {
+        put("%s\"%s\":%d", c ? "," : "", profiler_counter_name((ProfilerCounter)c), lf->counts[c]);
+    }
+    put("},\"gauges\":{");
+    for (int g = 0; g < PROF_GAUGE_COUNT; g++) {
+        put("%s\"%s\":%d", g ? "," : "", profiler_gauge_name((ProfilerGauge)g), lf->gauges[g]);
+    }
+    put("}}");
+}
+
+EMSCRIPTEN_KEEPALIVE
+const char* c_profiler_export_json(void) {
+    g_export.len      = 0;
+    g_export.overflow = false;
+
+    uint32_t total = 0;
+    const uint32_t* hist = profiler_histogram(&total);
+    ProfilerZoneStats fs = profiler_frame_stats();
+    put("{\"frames\":%u,\"worldResolution\":%.2f,\"frameMs\":{\"p50\":%.2f,\"p95\":%.2f,\"p99\":%.2f},"
+        "\"histogram\":[", (unsigned)total, dynamic_resolution_factor(), fs.p50_ms, fs.p95_ms, fs.p99_ms);
+    for (int b = 0; b < PROFILER_BUCKET_COUNT; b++) {
+        float edge = profiler_bucket_edge_ms(b);
+        if (edge > 0.0f) put("%s{\"ltMs\":%.1f,\"n\":%u}", b ? "," : "", edge, (unsigned)hist[b]);
+        else             put("%s{\"ltMs\":null,\"n\":%u}", b ? "," : "", (unsigned)hist[b]);
+    }
+    put("],\"longFrameMs\":%.1f,\"longFramesTotal\":%u,\"longFrames\":[",
+        profiler_long_frame_ms(), (unsigned)profiler_long_frames_total());
+
+    /* Close the document after the last record that fit. */
+    size_t closed_len = g_export.len;
+    int n = profiler_long_frame_count();
+    bool truncated = false;
+    for (int i = 0; i < n; i++) {
+        if (i) put(",");
+        put_long_frame(profiler_long_frame(i));
+        if (g_export.overflow) { truncated = true; break; }
+        closed_len = g_export.len;
+    }
+    g_export.len      = closed_len;
+    g_export.overflow = false;
+    put("],\"truncated\":%s}", truncated ? "true" : "false");
+    g_export.buf[g_export.len] = '\0';
+    return g_export.buf;
+}
+
+static void put_msg_kinds(bool is_text, int count) {
+    bool first = true;
+    for (int k = 0; k < count; k++) {
+        const NetMsgStats* s = is_text ? net_telemetry_json(k) : net_telemetry_binary(k);
+        if (0 == s->count) continue;
+        put("%s\"%s\":{\"count\":%u,\"bytes\":%llu,\"decodeUs\":%.0f,\"maxDecodeUs\":%.0f}",
+            first ? "" : ",", net_telemetry_kind_name(is_text, k), (unsigned)s->count,
+            (unsigned long long)s->bytes, s->decode_us, s->max_decode_us);
+        first = false;
+    }
+}
+
+EMSCRIPTEN_KEEPALIVE
+const char* c_net_telemetry_export_json(void) {
+    g_export.len      = 0;
+    g_export.overflow = false;
+
+    put("{\"binary\":{");
+    put_msg_kinds(false, NET_TELEMETRY_BIN_KINDS);
+    put("},\"json\":{");
+    put_msg_kinds(true, NET_TELEMETRY_JSON_KINDS);
+
+    const NetSnapshotStats* s = net_telemetry_snapshots();
+    put("},\"snapshots\":{\"count\":%u,\"skipped\":%u,\"lastGapMs\":%.1f,\"meanGapMs\":%.1f,"
+        "\"maxGapMs\":%.1f,\"gapHistogram\":[", (unsigned)s->snapshots, (unsigned)s->skipped,
+        s->last_gap_ms, s->mean_gap_ms, s->max_gap_ms);
+    for (int b = 0; b < NET_TELEMETRY_GAP_BUCKETS; b++) {
+        float edge = net_telemetry_gap_edge_ms(b);
+        if (edge > 0.0f) put("%s{\"ltMs\":%.1f,\"n\":%u}", b ? "," : "", edge, (unsigned)s->gap_hist[b]);
+        else             put("%s{\"ltMs\":null,\"n\":%u}", b ? "," : "", (unsigned)s->gap_hist[b]);
+    }
+    put("],\"entities\":{\"players\":%d,\"bots\":%d,\"worldObjects\":%d,"
+        "\"maxPlayers\":%d,\"maxBots\":%d,\"maxWorldObjects\":%d}},",
+        s->players, s->bots, s->world_objects, s->max_players, s->max_bots, s->max_world_objects);
+    put("\"inputAck\":{\"sent\":%u,\"inFlight\":%u,\"lastMs\":%.1f,\"meanMs\":%.1f,\"maxMs\":%.1f},",
+        (unsigned)s->inputs_sent, (unsigned)s->inputs_in_flight, s->last_ack_ms, s->mean_ack_ms,
+        s->max_ack_ms);
+    const NetUplinkStats* u = net_telemetry_uplink();
+    put("\"uplink\":{\"depth\":%d,\"maxDepth\":%d,\"bufferedBytes\":%u,\"maxBufferedBytes\":%u,"
+        "\"heldFlushes\":%u,\"coalesced\":%u,\"dropped\":%u}}",
+        u->depth, u->max_depth, (unsigned)u->buffered_bytes, (unsigned)u->max_buffered_bytes,
+        (unsigned)u->held_flushes, (unsigned)u->coalesced, (unsigned)u->dropped);
+
+    /* A fixed number of kinds; the buffer cannot run out, but stay valid JSON if it did. */
+    if (g_export.overflow) {
+        g_export.len = 0;
+        g_export.overflow = false;
+        put("{\"truncated\":true}");
+    }
+    g_export.buf[g_export.len] = '\0';
+    return g_export.buf;
+}
+
+EMSCRIPTEN_KEEPALIVE
+const char* c_heap_memory_export_json(void) {
+    g_export.len      = 0;
+    g_export.overflow = false;
+
+    double wasm_heap = EM_ASM_DOUBLE({ return HEAPU8.length; });
+    put("{\"liveBytes\":%zu,\"peakBytes\":%zu,\"frameAllocs\":%u,\"wasmHeapBytes\":%.0f,"
+        "\"markAgeS\":%.1f,\"tags\":{", heap_memory_live_total(), heap_memory_peak_total(),
+        (unsigned)heap_memory_frame_allocs(), wasm_heap,
+        emscripten_get_now() / 1000.0 - g_heap_mark.at_s);
+    for (int t = 0; t < HEAP_MEM_TAG_COUNT; t++) {
+        HeapMemStats s = heap_memory_stats((HeapMemTag)t);
+        const HeapMemStats* m = &g_heap_mark.tags[t];
+        put("%s\"%s\":{\"liveBytes\":%zu,\"peakBytes\":%zu,\"blocks\":%u,\"allocs\":%llu,"
+            "\"frees\":%llu,\"frameAllocs\":%u,\"sinceMarkBytes\":%lld,\"sinceMarkBlocks\":%lld}",
+            t ? "," : "", heap_memory_tag_name((HeapMemTag)t), s.live_bytes, s.peak_bytes,
+            (unsigned)s.live_blocks, (unsigned long long)s.allocs, (unsigned long long)s.frees,
+            (unsigned)s.frame_allocs, (long long)s.live_bytes - (long long)m->live_bytes,
+            (long long)s.live_blocks - (long long)m->live_blocks);
+    }
+    put("}}");
+    g_export.buf[g_export.len] = '\0';
+    return g_export.buf;
+}
+
+EMSCRIPTEN_KEEPALIVE
+void c_heap_memory_mark(void) {
+    heap_memory_snapshot(&g_heap_mark, emscripten_get_now() / 1000.0);
+}
+
+EMSCRIPTEN_KEEPALIVE
+void c_heap_memory_log_diff(void) {
+    HeapMemSnapshot now;
+    heap_memory_snapshot(&now, emscripten_get_now() / 1000.0);
+    heap_memory_diff(&g_heap_mark, &now);
+}
+
+EMSCRIPTEN_KEEPALIVE
+void c_profiler_set_long_frame_ms(double threshold_ms) {
+    profiler_set_long_frame_ms((float)threshold_ms);
+}
+
+EMSCRIPTEN_KEEPALIVE
+void c_profiler_reset_traces(void) {
+    profiler_reset_traces();
+}
+
+void profiler_bridge_install(void) {
+    EM_ASM({
+        window.CyberiaProfiler = {
+            exportJson: function() { return UTF8ToString(Module._c_profiler_export_json()); },
+            exportNetJson: function() { return UTF8ToString(Module._c_net_telemetry_export_json()); },
+            setLongFrameMs: function(ms) { Module._c_profiler_set_long_frame_ms(ms); },
+            reset: function() { Module._c_profiler_reset_traces(); },
+            exportHeapJson: function() { return UTF8ToString(Module._c_heap_memory_export_json()); },
+            heapMark: function() { Module._c_heap_memory_mark(); },
+            heapDiff: function() { Module._c_heap_memory_log_diff(); },
+        };
+    });
+}
@@ -0,0 +1,44 @@
+#ifndef CYBERIA_JS_PROFILER_BRIDGE_H
+#define CYBERIA_JS_PROFILER_BRIDGE_H
+
+/* JS access to the frame profiler's field traces (profiler.h) and the
+ * downlink telemetry (network/net_telemetry.h).
+ *
+ * profiler_bridge_install() publishes window.CyberiaProfiler with
+ *   exportJson()          → the histogram and trapped long frames as JSON
+ *   exportNetJson()       → per-message-kind counters, snapshot cadence,
+ *                           entity counts and input ack latency as JSON
+ *   setLongFrameMs(ms)    → change the trap threshold (<= 0 disables it)
+ *   reset()               → clear the histogram and the long-frame ring
+ *   exportHeapJson()      → heap accounting per tag (heap_memory.h) as JSON,
+ *                           with the change since the last heapMark()
+ *   heapMark()            → remember the current heap as the diff baseline
+ *   heapDiff()            → log which tags grew since the mark, per minute
+ * so a tester can pull a trace from the browser console or a harness can
+ * post it. Each maps onto a c_* export below. The frame profiler reads
+ * zero unless CYBERIA_PROFILE is set; network telemetry and heap
+ * accounting are always live. */
+
+/* Install window.CyberiaProfiler. Call once after the runtime is up. */
+void profiler_bridge_install(void);
+
+/* ── C functions (EMSCRIPTEN_KEEPALIVE, called from JS as Module._xxx) ── */
+
+/* NUL-terminated JSON in a static buffer, valid until the next call. */
+const char* c_profiler_export_json(void);
+
+/* Same buffer contract, for network telemetry. */
+const char* c_net_telemetry_export_json(void);
+
+/* Same buffer contract, for heap accounting. */
+const char* c_heap_memory_export_json(void);
+
+void c_heap_memory_mark(void);
+
+void c_heap_memory_log_diff(void);
+
+void c_profiler_set_long_frame_ms(double threshold_ms);
+
+void c_profiler_reset_traces(void);
+
+#endif /* CYBERIA_JS_PROFILER_BRIDGE_H */
@@ -0,0 +1,68 @@
+#include "recorder_bridge.h"
+
+#include "network/session_recorder.h"
+
+#include <emscripten/emscripten.h>
+#include <stddef.h>
+
+EMSCRIPTEN_KEEPALIVE
+void c_recorder_start(int cap_mb) {
+    session_recorder_start(0 < cap_mb ? (size_t)cap_mb * 1024u * 1024u : 0);
+}
+
+EMSCRIPTEN_KEEPALIVE
+void c_recorder_stop(void) {
+    session_recorder_stop();
+}
+
+EMSCRIPTEN_KEEPALIVE
+const uint8_t* c_recorder_data(void) {
+    size_t size;
+    return session_recorder_data(&size);
+}
+
+EMSCRIPTEN_KEEPALIVE
+uint32_t c_recorder_size(void) {
+    size_t size;
+    session_recorder_data(&size);
+    return (uint32_t)size;
+}
+
+EMSCRIPTEN_KEEPALIVE
+uint32_t c_recorder_record_count(void) {
+    return session_recorder_record_count();
+}
+
+EMSCRIPTEN_KEEPALIVE
+int c_recorder_status_flags(void) {
+    return (session_recorder_active() ? 1 : 0) | (session_recorder_truncated() ? 2 : 0);
+}
+
+void recorder_bridge_install(void) {
+    EM_ASM({
+        window.CyberiaRecorder = {
+            start: function(capMb) { Module._c_recorder_start(capMb | 0); },
+            stop: function() { Module._c_recorder_stop(); },
+            status: function() {
+                var flags = Module._c_recorder_status_flags();
+                return { active: !!(flags & 1), truncated: !!(flags & 2),
+                         records: Module._c_recorder_record_count() >>> 0,
+                         bytes: Module._c_recorder_size() >>> 0 };
+            },
+            download: function(name) {
+                var ptr = Module._c_recorder_data(), len = Module._c_recorder_size() >>> 0;
+                if (!ptr || !len) return false;
+                var url = URL.createObjectURL(new Blob([HEAPU8.slice(ptr, ptr + len)],
+                                                       { type: 'application/octet-stream' }));
+                var a = document.createElement('a');
+                a.href = url;
+                a.download = name || ('cyberia-' + Date.now() + '.cyrec');
+                a.click();
+                setTimeout(function() { URL.revokeObjectURL(url); }, 0);
+                return true;
+            },
+        };
+        var mb = new URLSearchParams(window.location.search).get('record');
+        if (null !== mb) window.CyberiaRecorder.start(parseInt(mb, 10) || 0);
+    });
+}
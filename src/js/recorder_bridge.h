@@ -0,0 +1,33 @@
+#ifndef CYBERIA_JS_RECORDER_BRIDGE_H
+#define CYBERIA_JS_RECORDER_BRIDGE_H
+
+#include <stdint.h>
+
+/* JS control of the session recorder (network/session_recorder.h).
+ *
+ * recorder_bridge_install() publishes window.CyberiaRecorder with
+ *   start(capMb)    → drop any capture and start a new one (0: default cap)
+ *   stop()          → stop appending; the capture is kept
+ *   download(name)  → save the capture as a .cyrec file
+ *   status()        → { active, records, bytes, truncated }
+ * and starts recording at once when the page URL carries ?record=<MB>, so
+ * the capture opens before the socket does and includes INIT_DATA. */
+
+/* Install window.CyberiaRecorder. Call before connection_open(). */
+void recorder_bridge_install(void);
+
+/* ── C functions (EMSCRIPTEN_KEEPALIVE, called from JS as Module._xxx) ── */
+
+void c_recorder_start(int cap_mb);
+
+void c_recorder_stop(void);
+
+/* Capture bytes and their count; the pointer is valid until the next start. */
+const uint8_t* c_recorder_data(void);
+uint32_t       c_recorder_size(void);
+
+uint32_t c_recorder_record_count(void);
+
+int c_recorder_status_flags(void);   /* bit 0: active, bit 1: truncated */
+
+#endif /* CYBERIA_JS_RECORDER_BRIDGE_H */
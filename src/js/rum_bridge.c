@@ -0,0 +1,55 @@
+#include "rum_bridge.h"
+
+#include "rum.h"
+
+#include <emscripten/emscripten.h>
+
+EMSCRIPTEN_KEEPALIVE
+void c_rum_flush(void) {
+    rum_flush();
+}
+
+void rum_bridge_install(void) {
+    int sampled = EM_ASM_INT({
+        var forced = new URLSearchParams(self.location.search).get('rum');
+        var rate = 'number' === typeof self.CYBERIA_RUM_SAMPLE ? self.CYBERIA_RUM_SAMPLE : $0;
+        if (!(null !== forced ? '0' !== forced : Math.random() < rate)) return 0;
+
+        var cores = navigator.hardwareConcurrency || 0, mem = navigator.deviceMemory || 0;
+        var cls = !cores && !mem ? 'unknown'
+                : (mem && mem <= 2) || (cores && cores <= 2) ? 'low'
+                : mem >= 8 && cores >= 8 ? 'high' : 'mid';
+        var mobile = navigator.userAgentData ? !!navigator.userAgentData.mobile
+                                             : /Mobi|Android/i.test(navigator.userAgent);
+        window.CyberiaRum = {
+            session: self.crypto && crypto.randomUUID ? crypto.randomUUID()
+                                                      : Date.now().toString(36) + Math.random().toString(36).slice(2),
+            seq: 0,
+            device: { cls: cls, cores: cores, memGb: mem, dpr: self.devicePixelRatio || 1,
+                      width: screen.width, height: screen.height, mobile: mobile },
+        };
+        document.addEventListener('visibilitychange', function() {
+            if ('hidden' === document.visibilityState) Module._c_rum_flush();
+        });
+        window.addEventListener('pagehide', function() { Module._c_rum_flush(); });
+        return 1;
+    }, RUM_SAMPLE_RATE);
+    if (sampled) rum_start();
+}
+
+void rum_bridge_send(const char* url, const char* json) {
+    EM_ASM({
+        var rum = window.CyberiaRum;
+        if (!rum) return;
+        var url = UTF8ToString($0), body = JSON.parse(UTF8ToString($1));
+        body.session = rum.session;
+        body.seq = rum.seq++;
+        body.device = rum.device;
+        /* text/plain keeps the cross-origin beacon a simple request. */
+        var blob = new Blob([JSON.stringify(body)], { type: 'text/plain' });
+        if (!(navigator.sendBeacon && navigator.sendBeacon(url, blob))) {
+            fetch(url, { method: 'POST', body: blob, keepalive: true, mode: 'no-cors' })
+                .catch(function() {});
+        }
+    }, url, json);
+}
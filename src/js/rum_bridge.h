@@ -0,0 +1,25 @@
+#ifndef CYBERIA_JS_RUM_BRIDGE_H
+#define CYBERIA_JS_RUM_BRIDGE_H
+
+/* JS side of the field performance beacon (rum.h).
+ *
+ * rum_bridge_install() samples the session — ?rum=1 / ?rum=0 force it,
+ * else window.CYBERIA_RUM_SAMPLE or RUM_SAMPLE_RATE is the share kept —
+ * and, when it is in, publishes window.CyberiaRum { session, seq, device },
+ * starts rum.h and flushes it on visibilitychange to hidden and pagehide.
+ * `device` is { cls, cores, memGb, dpr, width, height, mobile }, `cls`
+ * one of low / mid / high / unknown from the cores and device memory. */
+
+/* Sample the session and start rum.h when it is in. Call after
+ * runtime_config_init(). */
+void rum_bridge_install(void);
+
+/* POST `json` to `url` via navigator.sendBeacon (fetch keepalive when the
+ * beacon is refused), with the session, sequence and device merged in. */
+void rum_bridge_send(const char* url, const char* json);
+
+/* ── C functions (EMSCRIPTEN_KEEPALIVE, called from JS as Module._xxx) ── */
+
+void c_rum_flush(void);
+
+#endif /* CYBERIA_JS_RUM_BRIDGE_H */
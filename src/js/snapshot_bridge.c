@@ -0,0 +1,82 @@
+#include "snapshot_bridge.h"
+
+#include "network/session_snapshot.h"
+#include "runtime_config.h"
+
+#include <emscripten/emscripten.h>
+#include <stddef.h>
+#include <stdlib.h>
+
+/* The loaded snapshot, freed once replayed. */
+static uint8_t* s_saved;
+static uint32_t s_saved_size;
+
+EMSCRIPTEN_KEEPALIVE
+const uint8_t* c_snapshot_data(void) {
+    size_t size;
+    return session_snapshot_data(&size);
+}
+
+EMSCRIPTEN_KEEPALIVE
+uint32_t c_snapshot_size(void) {
+    size_t size;
+    session_snapshot_data(&size);
+    return (uint32_t)size;
+}
+
+EMSCRIPTEN_KEEPALIVE
+uint8_t* c_snapshot_buffer(uint32_t size) {
+    free(s_saved);
+    s_saved      = malloc(size ? size : 1);
+    s_saved_size = s_saved ? size : 0;
+    return s_saved;
+}
+
+EMSCRIPTEN_KEEPALIVE
+void c_snapshot_loaded(uint32_t size) {
+    if (s_saved && size <= s_saved_size) session_snapshot_restore(s_saved, size);
+    free(s_saved);
+    s_saved      = NULL;
+    s_saved_size = 0;
+}
+
+void snapshot_bridge_install(void) {
+    EM_ASM({
+        if (!self.indexedDB) return;
+        var key = UTF8ToString($0), maxAge = $1;
+        function withStore(mode, fn) {
+            var open = indexedDB.open('cyberia-snapshot', 1);
+            open.onupgradeneeded = function() { open.result.createObjectStore('snapshots'); };
+            open.onsuccess = function() {
+                var db = open.result;
+                var tx = db.transaction('snapshots', mode);
+                tx.oncomplete = tx.onerror = function() { db.close(); };
+                fn(tx.objectStore('snapshots'));
+            };
+        }
+        function save() {
+            var len = Module._c_snapshot_size() >>> 0;
+            if (!len) return;
+            var ptr = Module._c_snapshot_data();
+            var bytes = HEAPU8.slice(ptr, ptr + len);
+            withStore('readwrite', function(store) {
+                store.put({ savedAt: Date.now(), bytes: bytes }, key);
+            });
+        }
+        document.addEventListener('visibilitychange', function() {
+            if ('hidden' === document.visibilityState) save();
+        });
+        window.addEventListener('pagehide', save);
+        withStore('readonly', function(store) {
+            var get = store.get(key);
+            get.onsuccess = function() {
+                var rec = get.result;
+                if (!rec || !(Date.now() - rec.savedAt < maxAge)) return;
+                var ptr = Module._c_snapshot_buffer(rec.bytes.byteLength);
+                if (!ptr) return;
+                HEAPU8.set(rec.bytes, ptr);
+                Module._c_snapshot_loaded(rec.bytes.byteLength);
+            };
+        });
+    }, runtime_config_instance_code(), SESSION_SNAPSHOT_MAX_AGE_MS);
+}
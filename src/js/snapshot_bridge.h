@@ -0,0 +1,32 @@
+#ifndef CYBERIA_JS_SNAPSHOT_BRIDGE_H
+#define CYBERIA_JS_SNAPSHOT_BRIDGE_H
+
+#include <stdint.h>
+
+/* IndexedDB side of the session snapshot (network/session_snapshot.h).
+ *
+ * snapshot_bridge_install() saves the snapshot on visibilitychange to
+ * hidden and on pagehide — the last events a mobile browser delivers
+ * before it discards the tab — into its own database ("cyberia-snapshot"),
+ * keyed by the instance code with the save time alongside. It also reads
+ * the instance's saved one back; if it is younger than
+ * SESSION_SNAPSHOT_MAX_AGE_MS it is copied into the heap and restored as
+ * the ghost world. */
+
+/* Call after runtime_config_init() and before connection_open(), so the
+ * restore usually runs before the first real frame; a late one is
+ * dropped. */
+void snapshot_bridge_install(void);
+
+/* ── C functions (EMSCRIPTEN_KEEPALIVE, called from JS as Module._xxx) ── */
+
+/* The snapshot to save, and its size (0: nothing worth saving yet). The
+ * pointer is valid until the next decoded frame. */
+const uint8_t* c_snapshot_data(void);
+uint32_t       c_snapshot_size(void);
+
+/* Heap buffer for a saved snapshot of `size` bytes, then its restore. */
+uint8_t* c_snapshot_buffer(uint32_t size);
+void     c_snapshot_loaded(uint32_t size);
+
+#endif /* CYBERIA_JS_SNAPSHOT_BRIDGE_H */
@@ -0,0 +1,177 @@
+#include "startup_bridge.h"
+
+#include "startup_trace.h"
+
+#include <emscripten/emscripten.h>
+#include <assert.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define STARTUP_TID_STAGES  1
+#define STARTUP_TID_FETCHES 2
+
+static const char* const CLASS_NAMES[FETCH_CLASS_COUNT] = {
+    [FETCH_CLASS_VISIBLE]  = "visible",
+    [FETCH_CLASS_UI]       = "ui",
+    [FETCH_CLASS_PREFETCH] = "prefetch",
+    [FETCH_CLASS_POLL]     = "poll",
+};
+
+static const char* const KIND_NAMES[] = {
+    [STARTUP_FETCH_SINGLE] = "single",
+    [STARTUP_FETCH_BULK]   = "bulk",
+    [STARTUP_FETCH_PROBE]  = "idb-probe",
+};
+
+/* Grows to fit: STARTUP_TRACE_MAX_FETCHES records run past 100 KB. */
+static struct {
+    char*  buf;
+    size_t len;
+    size_t cap;
+} g_out;
+
+static void put(const char* fmt, ...) {
+    for (;;) {
+        va_list ap;
+        va_start(ap, fmt);
+        int n = vsnprintf(g_out.buf + g_out.len, g_out.cap - g_out.len, fmt, ap);
+        va_end(ap);
+        assert(0 <= n);
+        if ((size_t)n < g_out.cap - g_out.len) {
+            g_out.len += (size_t)n;
+            return;
+        }
+        g_out.cap = g_out.cap * 2 + (size_t)n;
+        g_out.buf = realloc(g_out.buf, g_out.cap);
+        assert(g_out.buf);
+    }
+}
+
+/* Asset ids are URL paths; escape anyway so the document always parses. */
+static void put_string(const char* s) {
+    put("\"");
+    for (; *s; s++) {
+        if ('"' == *s || '\\' == *s)    put("\\%c", *s);
+        else if (0x20 > (unsigned char)*s) put("\\u%04x", (unsigned)*s);
+        else                             put("%c", *s);
+    }
+    put("\"");
+}
+
+static double us(double ms) { return ms * 1000.0; }
+
+/* Stage in progress at `t`: the first one not yet completed by then. */
+static const char* stage_at(double t) {
+    for (int i = 0; i < startup_trace_mark_count(); i++) {
+        const StartupMark* m = startup_trace_mark_at(i);
+        if (m->stage && m->at_ms >= t) return m->name;
+    }
+    return "gameplay";
+}
+
+static void put_stage(const StartupMark* m, double start_ms) {
+    /* The last fetch answered inside the stage held it open longest. */
+    const StartupFetch* tail = NULL;
+    int answered = 0;
+    for (int i = 0; i < startup_trace_fetch_count(); i++) {
+        const StartupFetch* f = startup_trace_fetch_at(i);
+        if (0.0 == f->done_ms || f->done_ms <= start_ms || f->done_ms > m->at_ms) continue;
+        answered++;
+        if (!tail || f->done_ms > tail->done_ms) tail = f;
+    }
+    put(",{\"name\":\"%s\",\"cat\":\"stage\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,"
+        "\"ts\":%.0f,\"dur\":%.0f,\"args\":{\"fetchesAnswered\":%d,\"lastFetch\":",
+        m->name, STARTUP_TID_STAGES, us(start_ms), us(m->at_ms - start_ms), answered);
+    if (tail) put_string(tail->id);
+    else      put("null");
+    put("}}");
+}
+
+static void put_fetch(int slot, const StartupFetch* f) {
+    put(",{\"name\":");
+    put_string(f->id);
+    put(",\"cat\":\"fetch\",\"ph\":\"b\",\"id\":%d,\"pid\":1,\"tid\":%d,\"ts\":%.0f,"
+        "\"args\":{\"kind\":\"%s\",\"class\":\"%s\",\"stage\":\"%s\",\"queueMs\":%.1f,",
+        slot, STARTUP_TID_FETCHES, us(f->queued_ms), KIND_NAMES[f->kind], CLASS_NAMES[f->cls],
+        stage_at(f->queued_ms), 0.0 < f->dispatched_ms ? f->dispatched_ms - f->queued_ms : 0.0);
+    if (0.0 == f->done_ms) {
+        put("\"pending\":true}}");
+        return;
+    }
+    put("\"bytes\":%u,\"ok\":%s}}", (unsigned)f->bytes, f->ok ? "true" : "false");
+    put(",{\"name\":");
+    put_string(f->id);
+    put(",\"cat\":\"fetch\",\"ph\":\"e\",\"id\":%d,\"pid\":1,\"tid\":%d,\"ts\":%.0f}",
+        slot, STARTUP_TID_FETCHES, us(f->done_ms));
+}
+
+EMSCRIPTEN_KEEPALIVE
+const char* c_startup_trace_export_json(void) {
+    if (!g_out.buf) {
+        g_out.cap = 64 * 1024;
+        g_out.buf = malloc(g_out.cap);
+        assert(g_out.buf);
+    }
+    g_out.len = 0;
+
+    put("{\"displayTimeUnit\":\"ms\",\"otherData\":{\"droppedFetches\":%u},\"traceEvents\":["
+        "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"cyberia-client\"}}"
+        ",{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"load stages\"}}"
+        ",{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"fetches\"}}"
+        ",{\"name\":\"main\",\"cat\":\"stage\",\"ph\":\"i\",\"s\":\"p\",\"pid\":1,\"tid\":%d,\"ts\":%.0f}",
+        (unsigned)startup_trace_dropped(), STARTUP_TID_STAGES, STARTUP_TID_FETCHES,
+        STARTUP_TID_STAGES, us(startup_trace_main_ms()));
+
+    double stage_start = startup_trace_main_ms();
+    for (int i = 0; i < startup_trace_mark_count(); i++) {
+        const StartupMark* m = startup_trace_mark_at(i);
+        if (m->stage) {
+            put_stage(m, stage_start);
+            stage_start = m->at_ms;
+        } else {
+            put(",{\"name\":\"%s\",\"cat\":\"stage\",\"ph\":\"i\",\"s\":\"p\",\"pid\":1,\"tid\":%d,"
+                "\"ts\":%.0f}", m->name, STARTUP_TID_STAGES, us(m->at_ms));
+        }
+    }
+    for (int i = 0; i < startup_trace_fetch_count(); i++) put_fetch(i, startup_trace_fetch_at(i));
+    put("]}");
+    return g_out.buf;
+}
+
+void startup_bridge_install(void) {
+    EM_ASM({
+        var startup = window.CyberiaStartup = window.CyberiaStartup || { marks: {} };
+        startup.exportTrace = function() {
+            var trace = JSON.parse(UTF8ToString(Module._c_startup_trace_export_json()));
+            var ev = trace.traceEvents, m = startup.marks || {};
+            var page = 3;
+            var span = function(name, from, to) {
+                if (undefined === from || undefined === to) return;
+                ev.push({ name: name, cat: 'page', ph: 'X', pid: 1, tid: page,
+                          ts: Math.round(from * 1000), dur: Math.round((to - from) * 1000) });
+            };
+            ev.push({ name: 'thread_name', ph: 'M', pid: 1, tid: page, args: { name: 'page' } });
+            if (undefined !== m.scriptStart) {
+                ev.push({ name: 'shell_script', cat: 'page', ph: 'i', s: 'p', pid: 1, tid: page,
+                          ts: Math.round(m.scriptStart * 1000) });
+            }
+            performance.getEntriesByType('resource').forEach(function(r) {
+                if (/\.(wasm|js|data)(\?|$)/.test(r.name) && r.startTime < (m.runtimeReady || Infinity)) {
+                    span('download ' + r.name.split('/').pop(), r.startTime, r.responseEnd);
+                }
+            });
+            span('wasm instantiate', m.instantiateStart, m.instantiateEnd);
+            span('runtime init', m.preRun, m.runtimeReady);
+            return JSON.stringify(trace);
+        };
+        startup.download = function(name) {
+            var url = URL.createObjectURL(new Blob([startup.exportTrace()], { type: 'application/json' }));
+            var a = document.createElement('a');
+            a.href = url;
+            a.download = name || ('cyberia-startup-' + Date.now() + '.json');
+            a.click();
+            setTimeout(function() { URL.revokeObjectURL(url); }, 0);
+        };
+    });
+}
@@ -0,0 +1,26 @@
+#ifndef CYBERIA_JS_STARTUP_BRIDGE_H
+#define CYBERIA_JS_STARTUP_BRIDGE_H
+
+/* JS export of the startup timeline (startup_trace.h).
+ *
+ * startup_bridge_install() extends window.CyberiaStartup, which shell.html
+ * creates with the page marks (script start, instantiation, runtime
+ * ready), with
+ *   exportTrace()   → Chrome trace-event JSON: LOAD_* stages, every fetch
+ *                     as an async span, the script and WASM downloads from
+ *                     Resource Timing, WASM instantiation and runtime init
+ *   download(name)  → save exportTrace() as a .json file
+ * Load it in chrome://tracing or https://ui.perfetto.dev. Each stage names
+ * the fetch that completed last before it ended, the network tail that
+ * held it open. */
+
+/* Install the CyberiaStartup exports. */
+void startup_bridge_install(void);
+
+/* ── C functions (EMSCRIPTEN_KEEPALIVE, called from JS as Module._xxx) ── */
+
+/* NUL-terminated JSON object {"traceEvents":[...]} of the C-side events,
+ * valid until the next call. */
+const char* c_startup_trace_export_json(void);
+
+#endif /* CYBERIA_JS_STARTUP_BRIDGE_H */
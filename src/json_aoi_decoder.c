@@ -0,0 +1,338 @@
+/**
+ * @file json_aoi_decoder.c
+ * @brief Streaming decoder for the JSON aoi_update message.
+ *
+ * Members may come in any order, so each entity is gathered into one
+ * static scratch record and committed once its object closes.
+ */
+
+#include "json_aoi_decoder.h"
+
+#include "binary_aoi_decoder.h"
+#include "domain/local_player.h"
+#include "domain/presentation_runtime.h"
+#include "game_state.h"
+#include "hash_table.h"
+#include "id_intern.h"
+#include "json_reader.h"
+#include "network/game_client.h"
+#include "profiler.h"
+#include "serial.h"
+#include "util/log.h"
+
+#include <assert.h>
+#include <raylib.h>
+#include <string.h>
+
+#define JSON_AOI_KEY_MAX 32
+
+typedef struct {
+    char             id[MAX_ID_LENGTH];
+    char             type[MAX_TYPE_LENGTH];
+    char             behavior[MAX_BEHAVIOR_LENGTH];
+    char             map_code[MAX_ID_LENGTH];
+    AoiKinematics    k;
+    bool             has_pos;
+    float            life;
+    float            max_life;
+    float            respawn_in;
+    ObjectLayerState layers[MAX_OBJECT_LAYERS];
+    int              layer_count;
+    /* Debug path; read only while dev_ui is on. */
+    bool             has_path;
+    Vector2          target_pos;
+    Vector2          path[MAX_PATH_POINTS];
+    int              path_count;
+} JsonEntity;
+
+/* One entity in flight at a time; kept off the stack. */
+static JsonEntity s_entity;
+
+/* ── Field readers ─────────────────────────────────────────────── */
+
+/* {"<kx>": n, "<ky>": n}; true when both were present. */
+static bool read_pair(JsonReader* r, const char* kx, const char* ky, Vector2* out) {
+    if (JR_OBJECT != jr_peek(r)) { jr_skip(r); return false; }
+    jr_object_begin(r);
+    bool has_x = false, has_y = false;
+    char key[JSON_AOI_KEY_MAX];
+    while (jr_object_next(r, key, sizeof(key))) {
+        if      (0 == strcmp(key, kx)) { out->x = (float)jr_number(r); has_x = true; }
+        else if (0 == strcmp(key, ky)) { out->y = (float)jr_number(r); has_y = true; }
+        else                           jr_skip(r);
+    }
+    return has_x && has_y;
+}
+
+/* Direction and mode arrive as numbers or as wire names. */
+static uint8_t read_direction(JsonReader* r) {
+    if (JR_STRING == jr_peek(r)) {
+        char name[16];
+        jr_string(r, name, sizeof(name));
+        return (uint8_t)serial_direction_from_name(name);
+    }
+    int v = (int)jr_number(r);
+    return (v >= 0 && v <= 8) ? (uint8_t)v : (uint8_t)DIRECTION_NONE;
+}
+
+static uint8_t read_mode(JsonReader* r) {
+    if (JR_STRING == jr_peek(r)) {
+        char name[16];
+        jr_string(r, name, sizeof(name));
+        return (uint8_t)serial_mode_from_name(name);
+    }
+    int v = (int)jr_number(r);
+    return (v >= 0 && v <= 2) ? (uint8_t)v : (uint8_t)MODE_IDLE;
+}
+
+/* [{"itemId", "active", "quantity"}, ...] */
+static int read_layers(JsonReader* r, ObjectLayerState* out) {
+    if (JR_ARRAY != jr_peek(r)) { jr_skip(r); return 0; }
+    jr_array_begin(r);
+    int n = 0;
+    while (jr_array_next(r)) {
+        if (n >= MAX_OBJECT_LAYERS || JR_OBJECT != jr_peek(r)) { jr_skip(r); continue; }
+        ObjectLayerState* l = &out[n];
+        *l = (ObjectLayerState){ .quantity = 1 };
+        jr_object_begin(r);
+        char key[JSON_AOI_KEY_MAX];
+        while (jr_object_next(r, key, sizeof(key))) {
+            if      (0 == strcmp(key, "itemId"))   jr_string(r, l->item_id, sizeof(l->item_id));
+            else if (0 == strcmp(key, "active"))   l->active   = jr_bool(r);
+            else if (0 == strcmp(key, "quantity")) l->quantity = (int)jr_number(r);
+            else                                   jr_skip(r);
+        }
+        l->item_handle = id_intern(l->item_id);
+        l->item_hash   = hash_table_hash(l->item_id);
+        n++;
+    }
+    return n;
+}
+
+static int read_path(JsonReader* r, Vector2* out) {
+    if (JR_ARRAY != jr_peek(r)) { jr_skip(r); return 0; }
+    jr_array_begin(r);
+    int n = 0;
+    while (jr_array_next(r)) {
+        if (n >= MAX_PATH_POINTS) { jr_skip(r); continue; }
+        if (read_pair(r, "X", "Y", &out[n])) n++;
+    }
+    return n;
+}
+
+/* Gather one entity object into s_entity. False when it is not an object
+ * or has no id. */
+static bool read_entity(JsonReader* r) {
+    if (JR_OBJECT != jr_peek(r)) { jr_skip(r); return false; }
+    JsonEntity* e = &s_entity;
+    e->id[0] = e->type[0] = e->behavior[0] = e->map_code[0] = '\0';
+    e->k           = (AoiKinematics){ 0 };
+    e->has_pos     = false;
+    e->life        = 100.0f;
+    e->max_life    = 100.0f;
+    e->respawn_in  = 0.0f;
+    e->layer_count = 0;
+    e->has_path    = false;
+    e->target_pos  = (Vector2){ -1.0f, -1.0f };
+    e->path_count  = 0;
+
+    jr_object_begin(r);
+    char key[JSON_AOI_KEY_MAX];
+    while (jr_object_next(r, key, sizeof(key))) {
+        if      (0 == strcmp(key, "id"))           jr_string(r, e->id, sizeof(e->id));
+        else if (0 == strcmp(key, "Type"))         jr_string(r, e->type, sizeof(e->type));
+        else if (0 == strcmp(key, "Pos"))          e->has_pos = read_pair(r, "X", "Y", &e->k.pos);
+        else if (0 == strcmp(key, "Dims"))         e->k.has_dims = read_pair(r, "Width", "Height", &e->k.dims);
+        else if (0 == strcmp(key, "direction"))    e->k.direction = read_direction(r);
+        else if (0 == strcmp(key, "mode"))         e->k.mode = read_mode(r);
+        else if (0 == strcmp(key, "life"))         e->life = (float)jr_number(r);
+        else if (0 == strcmp(key, "maxLife"))      e->max_life = (float)jr_number(r);
+        else if (0 == strcmp(key, "respawnIn"))    e->respawn_in = (float)jr_number(r);
+        else if (0 == strcmp(key, "objectLayers")) e->layer_count = read_layers(r, e->layers);
+        else if (0 == strcmp(key, "behavior"))     jr_string(r, e->behavior, sizeof(e->behavior));
+        else if (0 == strcmp(key, "MapCode"))      jr_string(r, e->map_code, sizeof(e->map_code));
+        else if (0 == strcmp(key, "targetPos") && presentation_runtime_dev_ui()) {
+            read_pair(r, "X", "Y", &e->target_pos);
+            e->has_path = true;
+        }
+        else if (0 == strcmp(key, "path") && presentation_runtime_dev_ui()) {
+            e->path_count = read_path(r, e->path);
+            e->has_path   = true;
+        }
+        else                                       jr_skip(r);
+    }
+    return '\0' != e->id[0];
+}
+
+/* ── Commit ────────────────────────────────────────────────────── */
+
+static void commit_common(EntityState* base) {
+    const JsonEntity* e = &s_entity;
+    base->life       = e->life;
+    base->max_life   = e->max_life;
+    base->respawn_in = e->respawn_in;
+    binary_aoi_store_layers(base->object_layers, &base->object_layer_count,
+                            &base->layers_version, e->layers, e->layer_count);
+}
+
+static void commit_remote_player(void) {
+    PlayerState* p = binary_aoi_place_player(s_entity.id, &s_entity.k);
+    if (p) commit_common(&p->base);
+}
+
+static void commit_bot(void) {
+    BotState* b = binary_aoi_place_bot(s_entity.id, &s_entity.k);
+    if (NULL == b) return;
+    commit_common(&b->base);
+    memcpy(b->behavior, s_entity.behavior, sizeof(b->behavior));
+}
+
+/* Appended unindexed; the grids are rebuilt once the frame is in. */
+static void commit_world_object(ObjectLayerType kind) {
+    const JsonEntity* e = &s_entity;
+    if (!e->has_pos || !e->k.has_dims) return;
+    WorldObject* o = game_state_append_world_object(kind, NULL);
+    if (NULL == o) return;
+    memcpy(o->id, e->id, sizeof(o->id));
+    o->handle    = id_intern(o->id);
+    o->pos       = e->k.pos;
+    o->dims      = e->k.dims;
+    memcpy(o->type, e->type, sizeof(o->type));
+    int n = (e->layer_count < MAX_OBJECT_LAYERS) ? e->layer_count : MAX_OBJECT_LAYERS;
+    o->object_layers = game_state_alloc_layers(n);
+    binary_aoi_store_layers(o->object_layers, &o->object_layer_count, &o->layers_version,
+                            e->layers, n);
+}
+
+static void commit_grid_object(void) {
+    const char* type = s_entity.type;
+    if      (0 == strcmp(type, "bot"))        commit_bot();
+    else if (0 == strcmp(type, "obstacle"))   commit_world_object(OBJECT_LAYER_TYPE_OBSTACLE);
+    else if (0 == strcmp(type, "foreground")) commit_world_object(OBJECT_LAYER_TYPE_FOREGROUND);
+    else if (0 == strcmp(type, "portal"))     commit_world_object(OBJECT_LAYER_TYPE_PORTAL);
+    else if (0 == strcmp(type, "floor"))      commit_world_object(OBJECT_LAYER_TYPE_FLOOR);
+}
+
+/* The local player is patched in place: interp_pos and the tap target are
+ * client-side and survive the snapshot. */
+static void commit_self_player(void) {
+    GameState*        gs = &g_game_state;
+    PlayerState*      p  = &gs->player;
+    const JsonEntity* e  = &s_entity;
+    bool first_update = ('\0' == gs->player_id[0]);
+
+    /* Clear the local tap target as soon as the server reports the player
+     * stopped — drives the on-tap arrow off when motion ends. */
+    if (!first_update) {
+        float sdx = e->k.pos.x - p->base.pos_server.x;
+        float sdy = e->k.pos.y - p->base.pos_server.y;
+        if (sdx * sdx + sdy * sdy < 0.0001f) p->has_tap_target = false;
+    }
+
+    memcpy(p->base.id, e->id, sizeof(p->base.id));
+    p->base.handle     = id_intern(p->base.id);
+    p->base.pos_prev   = first_update ? e->k.pos : p->base.pos_server;
+    p->base.pos_server = e->k.pos;
+    if (first_update) p->base.interp_pos = e->k.pos;
+    if (e->k.has_dims) p->base.dims = e->k.dims;
+    p->base.direction     = (Direction)e->k.direction;
+    p->base.mode          = (ObjectLayerMode)e->k.mode;
+    p->base.last_update   = gs->last_update_time;
+    p->base.snapshot_time = gs->last_update_time;
+    commit_common(&p->base);
+
+    memcpy(p->map_code, e->map_code, sizeof(p->map_code));
+    if (e->has_path) local_player_set_debug_path(e->path, e->path_count, e->target_pos);
+
+    if (first_update) memcpy(gs->player_id, p->base.id, sizeof(gs->player_id));
+}
+
+/* ── Message structure ─────────────────────────────────────────── */
+
+/* visiblePlayers is a map or an array; visibleGridObjects a map. */
+static void read_entity_list(JsonReader* r, void (*commit)(void)) {
+    JsonKind kind = jr_peek(r);
+    if (JR_OBJECT == kind) {
+        jr_object_begin(r);
+        char key[MAX_ID_LENGTH];
+        while (jr_object_next(r, key, sizeof(key))) {
+            if (read_entity(r)) commit();
+        }
+    } else if (JR_ARRAY == kind) {
+        jr_array_begin(r);
+        while (jr_array_next(r)) {
+            if (read_entity(r)) commit();
+        }
+    } else {
+        jr_skip(r);
+    }
+}
+
+/* A payload carrying either list is a full frame: whatever it leaves out
+ * is gone. One with only "player" just moves the local player. */
+static void read_payload(JsonReader* r) {
+    GameState* gs = &g_game_state;
+    if (JR_OBJECT != jr_peek(r)) { jr_skip(r); return; }
+    gs->last_update_time = network_message_time();
+
+    bool frame_started = false;
+    jr_object_begin(r);
+    char key[JSON_AOI_KEY_MAX];
+    while (jr_object_next(r, key, sizeof(key))) {
+        bool players = 0 == strcmp(key, "visiblePlayers");
+        bool objects = 0 == strcmp(key, "visibleGridObjects");
+        if ((players || objects) && !frame_started) {
+            binary_aoi_begin_full_frame();
+            frame_started = true;
+        }
+        if (players) {
+            read_entity_list(r, commit_remote_player);
+        } else if (objects) {
+            read_entity_list(r, commit_grid_object);
+        } else if (0 == strcmp(key, "player")) {
+            if (read_entity(r)) commit_self_player();
+        } else {
+            jr_skip(r);
+        }
+    }
+
+    if (frame_started) binary_aoi_end_full_frame();
+    /* Even a truncated frame may have touched slots — keep the hot sets
+     * and grids in step. */
+    game_state_refresh_hot();
+    if (frame_started) game_state_reindex_world_objects();
+    game_state_publish_entity_events();
+}
+
+bool json_aoi_is_update(const char* json, size_t length) {
+    assert(json);
+    JsonReader r;
+    jr_init(&r, json, length);
+    if (!jr_object_begin(&r)) return false;
+    char key[JSON_AOI_KEY_MAX];
+    while (jr_object_next(&r, key, sizeof(key))) {
+        if (0 != strcmp(key, "type")) { jr_skip(&r); continue; }
+        char type[32];
+        return jr_string(&r, type, sizeof(type)) && 0 == strcmp(type, "aoi_update");
+    }
+    return false;
+}
+
+int json_aoi_process(const char* json, size_t length) {
+    assert(json);
+    JsonReader r;
+    jr_init(&r, json, length);
+    if (!jr_object_begin(&r)) return -1;
+    PROFILE_BEGIN(PROF_ZONE_AOI_DECODE);
+    char key[JSON_AOI_KEY_MAX];
+    while (jr_object_next(&r, key, sizeof(key))) {
+        if (0 == strcmp(key, "payload")) read_payload(&r);
+        else                             jr_skip(&r);
+    }
+    PROFILE_END(PROF_ZONE_AOI_DECODE);
+    if (r.error) {
+        LOG_ERROR("[JSON_AOI] malformed aoi_update (%zu bytes)", length);
+        return -1;
+    }
+    return 0;
+}
@@ -0,0 +1,36 @@
+/**
+ * @file json_aoi_decoder.h
+ * @brief Streaming decoder for the JSON aoi_update message.
+ *
+ * Servers that predate the binary AOI protocol still send snapshots as
+ *   { "type": "aoi_update", "payload": { "player": {...},
+ *     "visiblePlayers": {...}, "visibleGridObjects": { id: {"Type": ...} } } }
+ * This decoder walks that text with json_reader — no cJSON tree — writing
+ * each field into g_game_state as it goes. Frames are rebuilt through the
+ * binary decoder's helpers, so a JSON snapshot interpolates, carries dims
+ * and versions layers exactly as a BIN_MSG_FULL_AOI frame would.
+ */
+
+#ifndef JSON_AOI_DECODER_H
+#define JSON_AOI_DECODER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * @brief True when the message's top-level "type" is "aoi_update".
+ *
+ * Scans top-level keys only; cheap when "type" comes first, as the server
+ * writes it.
+ */
+bool json_aoi_is_update(const char* json, size_t length);
+
+/**
+ * @brief Apply an aoi_update message (or a bare message whose payload
+ * carries the aoi_update fields).
+ *
+ * @return 0 on success, -1 on malformed input.
+ */
+int json_aoi_process(const char* json, size_t length);
+
+#endif /* JSON_AOI_DECODER_H */
@@ -0,0 +1,265 @@
+#include "json_reader.h"
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+void jr_init(JsonReader* r, const char* data, size_t len) {
+    assert(r);
+    assert(data || 0 == len);
+    *r = (JsonReader){ .data = data, .len = len };
+}
+
+static void fail(JsonReader* r) {
+    r->error = true;
+    r->pos   = r->len;
+}
+
+static void skip_ws(JsonReader* r) {
+    while (r->pos < r->len) {
+        char c = r->data[r->pos];
+        if (' ' != c && '\t' != c && '\n' != c && '\r' != c) return;
+        r->pos++;
+    }
+}
+
+/* Whitespace and the separators the caller doesn't track. */
+static void skip_ws_comma(JsonReader* r) {
+    skip_ws(r);
+    while (r->pos < r->len && ',' == r->data[r->pos]) {
+        r->pos++;
+        skip_ws(r);
+    }
+}
+
+static bool expect(JsonReader* r, char c) {
+    skip_ws(r);
+    if (r->pos >= r->len || c != r->data[r->pos]) { fail(r); return false; }
+    r->pos++;
+    return true;
+}
+
+JsonKind jr_peek(JsonReader* r) {
+    assert(r);
+    skip_ws(r);
+    if (r->error || r->pos >= r->len) return JR_NONE;
+    switch (r->data[r->pos]) {
+        case '{': return JR_OBJECT;
+        case '[': return JR_ARRAY;
+        case '"': return JR_STRING;
+        case 't':
+        case 'f': return JR_BOOL;
+        case 'n': return JR_NULL;
+        default:  return JR_NUMBER;
+    }
+}
+
+bool jr_object_begin(JsonReader* r) {
+    assert(r);
+    return !r->error && expect(r, '{');
+}
+
+bool jr_array_begin(JsonReader* r) {
+    assert(r);
+    return !r->error && expect(r, '[');
+}
+
+/* Append code point `cp` as UTF-8 while it fits. */
+static size_t put_utf8(char* dst, size_t n, size_t cap, uint32_t cp) {
+    char buf[4];
+    size_t len;
+    if (cp < 0x80)         { buf[0] = (char)cp; len = 1; }
+    else if (cp < 0x800)   { buf[0] = (char)(0xC0 | (cp >> 6));
+                             buf[1] = (char)(0x80 | (cp & 0x3F)); len = 2; }
+    else if (cp < 0x10000) { buf[0] = (char)(0xE0 | (cp >> 12));
+                             buf[1] = (char)(0x80 | ((cp >> 6) & 0x3F));
+                             buf[2] = (char)(0x80 | (cp & 0x3F)); len = 3; }
+    else                   { buf[0] = (char)(0xF0 | (cp >> 18));
+                             buf[1] = (char)(0x80 | ((cp >> 12) & 0x3F));
+                             buf[2] = (char)(0x80 | ((cp >> 6) & 0x3F));
+                             buf[3] = (char)(0x80 | (cp & 0x3F)); len = 4; }
+    if (n + len > cap) return n;
+    memcpy(dst + n, buf, len);
+    return n + len;
+}
+
+static int hex4(JsonReader* r) {
+    if (r->pos + 4 > r->len) return -1;
+    int v = 0;
+    for (int i = 0; i < 4; i++) {
+        char c = r->data[r->pos++];
+        v <<= 4;
+        if      (c >= '0' && c <= '9') v |= c - '0';
+        else if (c >= 'a' && c <= 'f') v |= c - 'a' + 10;
+        else if (c >= 'A' && c <= 'F') v |= c - 'A' + 10;
+        else return -1;
+    }
+    return v;
+}
+
+/* Read the string at the cursor (opening quote included) into dst, or
+ * just past it when dst is NULL. */
+static bool read_string(JsonReader* r, char* dst, size_t dst_size) {
+    if (!expect(r, '"')) return false;
+    size_t cap = dst ? dst_size - 1 : 0;
+    size_t n   = 0;
+    while (r->pos < r->len) {
+        char c = r->data[r->pos++];
+        if ('"' == c) {
+            if (dst) dst[n] = '\0';
+            return true;
+        }
+        if ('\\' != c) {
+            if (n < cap) dst[n++] = c;
+            continue;
+        }
+        if (r->pos >= r->len) break;
+        char e = r->data[r->pos++];
+        char plain = 0;
+        switch (e) {
+            case '"':  plain = '"';  break;
+            case '\\': plain = '\\'; break;
+            case '/':  plain = '/';  break;
+            case 'b':  plain = '\b'; break;
+            case 'f':  plain = '\f'; break;
+            case 'n':  plain = '\n'; break;
+            case 'r':  plain = '\r'; break;
+            case 't':  plain = '\t'; break;
+            case 'u': {
+                int hi = hex4(r);
+                if (hi < 0) { fail(r); return false; }
+                uint32_t cp = (uint32_t)hi;
+                if (cp >= 0xD800 && cp < 0xDC00 && r->pos + 6 <= r->len &&
+                    '\\' == r->data[r->pos] && 'u' == r->data[r->pos + 1]) {
+                    r->pos += 2;
+                    int lo = hex4(r);
+                    if (lo < 0) { fail(r); return false; }
+                    cp = 0x10000 + ((cp - 0xD800) << 10) + ((uint32_t)lo - 0xDC00);
+                }
+                if (dst) n = put_utf8(dst, n, cap, cp);
+                continue;
+            }
+            default: fail(r); return false;
+        }
+        if (n < cap) dst[n++] = plain;
+    }
+    fail(r);
+    return false;
+}
+
+bool jr_object_next(JsonReader* r, char* key, size_t key_size) {
+    assert(r);
+    assert(key && key_size > 0);
+    key[0] = '\0';
+    skip_ws_comma(r);
+    if (r->error || r->pos >= r->len) { fail(r); return false; }
+    if ('}' == r->data[r->pos]) {
+        r->pos++;
+        return false;
+    }
+    if (!read_string(r, key, key_size)) return false;
+    return expect(r, ':');
+}
+
+bool jr_array_next(JsonReader* r) {
+    assert(r);
+    skip_ws_comma(r);
+    if (r->error || r->pos >= r->len) { fail(r); return false; }
+    if (']' == r->data[r->pos]) {
+        r->pos++;
+        return false;
+    }
+    return true;
+}
+
+bool jr_string(JsonReader* r, char* dst, size_t dst_size) {
+    assert(r);
+    assert(dst && dst_size > 0);
+    dst[0] = '\0';
+    if (JR_STRING != jr_peek(r)) { jr_skip(r); return false; }
+    return read_string(r, dst, dst_size);
+}
+
+static bool is_number_char(char c) {
+    return (c >= '0' && c <= '9') || '-' == c || '+' == c || '.' == c || 'e' == c || 'E' == c;
+}
+
+double jr_number(JsonReader* r) {
+    assert(r);
+    if (JR_NUMBER != jr_peek(r)) { jr_skip(r); return 0.0; }
+    char buf[64];
+    size_t n = 0;
+    while (r->pos < r->len && is_number_char(r->data[r->pos])) {
+        if (n < sizeof(buf) - 1) buf[n++] = r->data[r->pos];
+        r->pos++;
+    }
+    if (0 == n) { fail(r); return 0.0; }
+    buf[n] = '\0';
+    return strtod(buf, NULL);
+}
+
+static bool match_word(JsonReader* r, const char* word) {
+    size_t n = strlen(word);
+    if (r->pos + n > r->len || 0 != memcmp(r->data + r->pos, word, n)) { fail(r); return false; }
+    r->pos += n;
+    return true;
+}
+
+bool jr_bool(JsonReader* r) {
+    assert(r);
+    if (JR_BOOL != jr_peek(r)) { jr_skip(r); return false; }
+    if ('t' == r->data[r->pos]) return match_word(r, "true");
+    match_word(r, "false");
+    return false;
+}
+
+void jr_skip(JsonReader* r) {
+    assert(r);
+    switch (jr_peek(r)) {
+        case JR_NONE:   fail(r); return;
+        case JR_STRING: read_string(r, NULL, 0); return;
+        case JR_NUMBER: jr_number(r); return;
+        case JR_BOOL:   jr_bool(r); return;
+        case JR_NULL:   match_word(r, "null"); return;
+        case JR_OBJECT:
+        case JR_ARRAY:  break;
+    }
+    /* Containers: count brackets, stepping over strings whole. */
+    int depth = 0;
+    while (r->pos < r->len) {
+        char c = r->data[r->pos];
+        if ('"' == c) {
+            if (!read_string(r, NULL, 0)) return;
+            continue;
+        }
+        r->pos++;
+        if ('{' == c || '[' == c) {
+            depth++;
+        } else if ('}' == c || ']' == c) {
+            if (0 == --depth) return;
+        }
+    }
+    fail(r);
+}
+
+const char* jr_value(JsonReader* r, size_t* len) {
+    assert(r && len);
+    *len = 0;
+    if (JR_NONE == jr_peek(r)) { fail(r); return NULL; }
+    size_t start = r->pos;
+    jr_skip(r);
+    if (r->error) return NULL;
+    *len = r->pos - start;
+    return r->data + start;
+}
+
+bool jr_object_find(JsonReader* r, const char* key) {
+    assert(r && key);
+    char name[64];
+    while (jr_object_next(r, name, sizeof(name))) {
+        if (0 == strcmp(name, key)) return true;
+        jr_skip(r);
+    }
+    return false;
+}
@@ -0,0 +1,85 @@
+#ifndef CYBERIA_JSON_READER_H
+#define CYBERIA_JSON_READER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/*
+ * Pull tokenizer over a JSON byte buffer.
+ *
+ * Walks a document in place with no tree and no allocation: the caller
+ * drives it key by key and copies each scalar straight to where it lives,
+ * the way BinReader walks the binary protocol. Built for the server's
+ * hot JSON messages, where a cJSON tree per message is pure overhead.
+ *
+ *     jr_object_begin(&r);
+ *     char key[32];
+ *     while (jr_object_next(&r, key, sizeof(key))) {
+ *         if      (0 == strcmp(key, "x")) x = (float)jr_number(&r);
+ *         else    jr_skip(&r);
+ *     }
+ *
+ * Every value a loop sees must be consumed (read or skipped) before the
+ * next jr_*_next call. Malformed input sets `error` and makes every later
+ * call return its empty result, so loops terminate; check it at the end.
+ * Commas are not checked for placement — the input is trusted server
+ * output, not user text.
+ *
+ * The reader holds no state beyond its cursor, so a walk over a large
+ * document can stop after any value and resume on a later frame: keep the
+ * JsonReader (and the buffer) alive in between.
+ */
+
+typedef enum {
+    JR_NONE = 0,    /* end of input or error */
+    JR_OBJECT,
+    JR_ARRAY,
+    JR_STRING,
+    JR_NUMBER,
+    JR_BOOL,
+    JR_NULL,
+} JsonKind;
+
+typedef struct {
+    const char* data;
+    size_t      len;
+    size_t      pos;
+    bool        error;
+} JsonReader;
+
+void     jr_init(JsonReader* r, const char* data, size_t len);
+
+/* Kind of the value at the cursor, without consuming it. */
+JsonKind jr_peek(JsonReader* r);
+
+/* Consume '{' / '['. False (and error set) when the value is another kind. */
+bool     jr_object_begin(JsonReader* r);
+bool     jr_array_begin(JsonReader* r);
+
+/* Advance to the next member: copies its key (truncated to key_size - 1)
+ * and leaves the cursor on its value. False once '}' is consumed. */
+bool     jr_object_next(JsonReader* r, char* key, size_t key_size);
+
+/* Advance to the next element. False once ']' is consumed. */
+bool     jr_array_next(JsonReader* r);
+
+/* Scalars. A value of another kind is skipped and the default returned:
+ * "" for strings, 0 for numbers, false for bools. jr_string unescapes
+ * (including \u, to UTF-8) and truncates to dst_size - 1. */
+bool     jr_string(JsonReader* r, char* dst, size_t dst_size);
+double   jr_number(JsonReader* r);
+bool     jr_bool(JsonReader* r);
+
+/* Consume the value at the cursor, whatever it is. */
+void     jr_skip(JsonReader* r);
+
+/* Consume the value at the cursor and return its bytes (`len` of them), to
+ * hand one element of a large document to another parser. NULL, len 0,
+ * on error. */
+const char* jr_value(JsonReader* r, size_t* len);
+
+/* Inside an object (after jr_object_begin): skip members up to `key` and
+ * leave the cursor on its value. False, the object consumed, when absent. */
+bool     jr_object_find(JsonReader* r, const char* key);
+
+#endif /* CYBERIA_JSON_READER_H */
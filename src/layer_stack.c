@@ -0,0 +1,108 @@
+#include "layer_stack.h"
+
+#include "hash_table.h"
+#include "util/log.h"
+
+#include <assert.h>
+#include <string.h>
+
+/* Table of slots at twice the stack count, open addressing over the
+ * stack's hash; items live back to back in one pool. */
+#define LAYER_STACK_SLOTS (2 * LAYER_STACK_MAX)
+#define LAYER_STACK_UNSHARED 0x80000000u
+
+static_assert(0 == (LAYER_STACK_SLOTS & (LAYER_STACK_SLOTS - 1)), "slot count must be a power of two");
+
+typedef struct {
+    uint64_t hash;
+    uint32_t id;       /* 0: empty slot */
+    uint32_t first;    /* pool index of the first item */
+    uint32_t active;   /* bit i: layer i active */
+    uint8_t  count;
+} StackSlot;
+
+static struct {
+    StackSlot slots[LAYER_STACK_SLOTS];
+    uint64_t  items[LAYER_STACK_POOL_ITEMS];   /* item_hash of each layer */
+    uint32_t  pool_used;
+    int       count;
+    uint32_t  next_id;
+    uint32_t  next_unshared;
+    unsigned  generation;
+    bool      full_logged;
+} g_stacks = { .next_id = 1, .next_unshared = LAYER_STACK_UNSHARED };
+
+static uint64_t item_key(const ObjectLayerState* l) {
+    return l->item_hash ? l->item_hash : hash_table_hash(l->item_id);
+}
+
+static bool same_stack(const StackSlot* s, const uint64_t* items, uint32_t active, int count) {
+    return count == s->count && active == s->active &&
+           0 == memcmp(&g_stacks.items[s->first], items, (size_t)count * sizeof(uint64_t));
+}
+
+uint32_t layer_stack_intern(const ObjectLayerState* layers, int count) {
+    static_assert(32 >= MAX_OBJECT_LAYERS, "active flags must fit 32 bits");
+    assert(layers || 0 == count);
+    assert(0 <= count && MAX_OBJECT_LAYERS >= count);
+
+    uint64_t items[MAX_OBJECT_LAYERS];
+    uint32_t active = 0;
+    uint64_t hash   = 14695981039346656037ull ^ (uint64_t)count;
+    for (int i = 0; i < count; i++) {
+        items[i] = item_key(&layers[i]);
+        if (layers[i].active) active |= 1u << i;
+        hash = (hash ^ items[i] ^ (layers[i].active ? 1u : 0u)) * 1099511628211ull;
+    }
+
+    uint32_t mask = LAYER_STACK_SLOTS - 1;
+    uint32_t i    = (uint32_t)(hash ^ (hash >> 32)) & mask;
+    for (; 0 != g_stacks.slots[i].id; i = (i + 1) & mask) {
+        const StackSlot* s = &g_stacks.slots[i];
+        if (hash == s->hash && same_stack(s, items, active, count)) return s->id;
+    }
+
+    if (LAYER_STACK_MAX <= g_stacks.count ||
+        LAYER_STACK_POOL_ITEMS < g_stacks.pool_used + (uint32_t)count) {
+        if (!g_stacks.full_logged) {
+            g_stacks.full_logged = true;
+            LOG_WARN("[LAYER_STACK] table full at %d stacks; new stacks are not shared", g_stacks.count);
+        }
+        uint32_t id = g_stacks.next_unshared++;
+        if (0 == g_stacks.next_unshared) g_stacks.next_unshared = LAYER_STACK_UNSHARED;
+        return id;
+    }
+
+    StackSlot* s = &g_stacks.slots[i];
+    *s = (StackSlot){
+        .hash   = hash,
+        .id     = g_stacks.next_id++,
+        .first  = g_stacks.pool_used,
+        .active = active,
+        .count  = (uint8_t)count,
+    };
+    memcpy(&g_stacks.items[s->first], items, (size_t)count * sizeof(uint64_t));
+    g_stacks.pool_used += (uint32_t)count;
+    g_stacks.count++;
+    return s->id;
+}
+
+bool layer_stack_shared(uint32_t id) {
+    return 0 != id && 0 == (id & LAYER_STACK_UNSHARED);
+}
+
+void layer_stack_reset(void) {
+    memset(g_stacks.slots, 0, sizeof(g_stacks.slots));
+    g_stacks.pool_used   = 0;
+    g_stacks.count       = 0;
+    g_stacks.full_logged = false;
+    g_stacks.generation++;
+}
+
+unsigned layer_stack_generation(void) {
+    return g_stacks.generation;
+}
+
+int layer_stack_count(void) {
+    return g_stacks.count;
+}
@@ -0,0 +1,39 @@
+#ifndef CYBERIA_LAYER_STACK_H
+#define CYBERIA_LAYER_STACK_H
+
+#include "world_types.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Intern table for object-layer stacks.
+ *
+ * A crowd of bots of one kind carries the same stack: the same items in
+ * the same order with the same active flags. Each distinct stack gets one
+ * id here, which decoders store as the record's layers_version, so every
+ * record wearing it shares the id and whatever is resolved from it (the
+ * render recipe: layer metadata, atlases, draw order) is worked out once
+ * per stack instead of once per entity. Quantities are not part of a
+ * stack.
+ *
+ * Ids are never 0 and never reused, also across layer_stack_reset(), so a
+ * record keeps meaning what it did. When the table is full a stack gets a
+ * fresh unshared id (layer_stack_shared() false), as each change got before. */
+
+#define LAYER_STACK_MAX        2048
+#define LAYER_STACK_POOL_ITEMS 16384
+
+/* Id of the stack in layers[0..count). */
+uint32_t layer_stack_intern(const ObjectLayerState* layers, int count);
+
+/* True when `id` names a stack other records may share. */
+bool     layer_stack_shared(uint32_t id);
+
+/* Forget every stack (a new session). Bumps layer_stack_generation(). */
+void     layer_stack_reset(void);
+unsigned layer_stack_generation(void);
+
+/* Distinct stacks held. */
+int      layer_stack_count(void);
+
+#endif /* CYBERIA_LAYER_STACK_H */
@@ -29,7 +29,7 @@ int layer_z_sort(const ObjectLayerState* layers, int count,
     for (int i = 0; i < count && n < out_cap; i++) {
         if (!layers[i].active || layers[i].item_id[0] == '\0') continue;
 
-        ObjectLayer* ol = lookup_cached_layer(layers[i].item_id);
+        ObjectLayer* ol = lookup_cached_layer_h(object_layer_state_key(&layers[i]));
         const char* type = (ol && ol->data.item.type[0] != '\0')
                            ? ol->data.item.type : NULL;
 
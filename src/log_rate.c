@@ -0,0 +1,41 @@
+#include "util/log.h"
+
+#include <raylib.h>
+
+/* Rate limiter behind LOG_WARN_HOT / LOG_ERROR_HOT (util/log.h). */
+
+static struct {
+    int      lines;          /* hot lines printed this frame */
+    uint32_t over_budget;    /* admitted by their site, refused by the budget */
+    double   summary_next;
+} g_log_rate;
+
+bool log_rate_admit(LogRateSite* site, uint32_t* suppressed) {
+    double now = GetTime();
+    if (now < site->next) {
+        site->suppressed++;
+        return false;
+    }
+    if (LOG_FRAME_BUDGET <= g_log_rate.lines) {
+        /* The site keeps its turn: it prints on the next frame with room. */
+        site->suppressed++;
+        g_log_rate.over_budget++;
+        return false;
+    }
+    g_log_rate.lines++;
+    site->next       = now + LOG_RATE_WINDOW_S;
+    *suppressed      = site->suppressed;
+    site->suppressed = 0;
+    return true;
+}
+
+void log_frame_mark(void) {
+    g_log_rate.lines = 0;
+    if (0 == g_log_rate.over_budget) return;
+    double now = GetTime();
+    if (now < g_log_rate.summary_next) return;
+    fprintf(stderr, "[WRN] log: %u hot-path lines over the %d-per-frame budget\n",
+            (unsigned)g_log_rate.over_budget, LOG_FRAME_BUDGET);
+    g_log_rate.over_budget  = 0;
+    g_log_rate.summary_next = now + LOG_RATE_WINDOW_S;
+}
@@ -4,10 +4,22 @@
 #include <assert.h>
 
 #include "input/input.h"
+#include "input/input_latency.h"
 #include "game_state.h"
+#include "client_context.h"
+#include "job_system.h"
+#include "spatial_grid.h"
+#include "dynamic_resolution.h"
+#include "fidelity.h"
+#include "frame_pacing.h"
+#include "frame_tasks.h"
 #include "render.h"
+#include "game_render.h"
+#include "static_world.h"
 #include "network/game_client.h"
 #include "network/replication.h"
+#include "network/net_telemetry.h"
+#include "network/session_snapshot.h"
 #include "config.h"
 #include "runtime_config.h"
 
@@ -16,7 +28,24 @@
 
 #include "js/interact_bridge.h"
 #include "js/loading_bridge.h"
+#include "js/overlay_commands.h"
+#include "js/profiler_bridge.h"
+#include "js/recorder_bridge.h"
+#include "js/crowd_bridge.h"
+#include "js/startup_bridge.h"
+#include "js/rum_bridge.h"
+#include "js/snapshot_bridge.h"
 #include "network/engine_client.h"
+#include "image_decoder.h"
+#include "startup_trace.h"
+#include "heap_memory.h"
+#include "frame_arena.h"
+#include "map_arena.h"
+#include "crowd_gen.h"
+#include "bench_scene.h"
+#include "rum.h"
+#include "profiler.h"
+#include "render_stats.h"
 
 #include "domain/camera.h"
 #include "domain/presentation_runtime.h"
@@ -27,113 +56,156 @@
 #include "ui/text.h"
 #include "domain/local_player.h"
 #include "domain/local_player_view.h"
+#include "util/fixed_step.h"
 
-static const double fixed_step = 1.0/(double)TICK_RATE_HZ;
-static double sim_acc = 0.0;
+/* Prediction runs one step per server tick, however fast frames come. */
+static FixedStep s_sim_clock = { .step = TICK_DURATION_S };
+
+/* Cells a bot may have moved since bot_grid was rebuilt from bot_hot. */
+#define TAP_GRID_SLACK_CELLS 2.0f
 
 /* True when the world-px tap position lands within a finger-sized radius of
- * a quest/action provider bot. */
+ * a quest/action provider bot. bot_grid narrows the candidates; the exact
+ * test reads the live packed position, and only bots in reach touch their
+ * record for the provider check. */
 static bool tap_hits_provider(Vector2 world_pos) {
     float cell = g_game_state.cell_size > 0.0f ? g_game_state.cell_size : 12.0f;
-    for (int i = 0; i < g_game_state.bot_count; i++) {
-        const BotState* bot = &g_game_state.bots[i];
-        if ('\0' == bot->action_code[0] && 0 == bot->quest_code_count) continue;
-        float half_w = bot->base.dims.x * 0.5f;
-        float half_h = bot->base.dims.y * 0.5f;
-        float cx = (bot->base.interp_pos.x + half_w) * cell;
-        float cy = (bot->base.interp_pos.y + half_h) * cell;
+    const EntityHotSet* hot = &g_game_state.bot_hot;
+    const SpatialGrid* grid = &g_game_state.bot_grid;
+    static int candidates[MAX_ENTITIES];
+    float half_max = 0.5f * (grid->max_w > grid->max_h ? grid->max_w : grid->max_h);
+    int n = spatial_grid_query_radius(grid, (Vector2){ world_pos.x / cell, world_pos.y / cell },
+                                      0.9f + half_max + TAP_GRID_SLACK_CELLS,
+                                      candidates, MAX_ENTITIES);
+    for (int c = 0; c < n; c++) {
+        int i = candidates[c];
+        float half_w = hot->w[i] * 0.5f;
+        float half_h = hot->h[i] * 0.5f;
+        float cx = (hot->x[i] + half_w) * cell;
+        float cy = (hot->y[i] + half_h) * cell;
         float reach = cell * (0.9f + (half_w > half_h ? half_w : half_h));
         float dx = world_pos.x - cx, dy = world_pos.y - cy;
-        if (dx * dx + dy * dy <= reach * reach) return true;
+        if (dx * dx + dy * dy > reach * reach) continue;
+        const BotState* bot = &g_game_state.bots[i];
+        if ('\0' != bot->action_code[0] || 0 != bot->quest_code_count) return true;
     }
     return false;
 }
+/* Set the rAF cadence of the loop just installed. emscripten ignores the
+ * timing call until a loop exists, so each loop applies it on its first
+ * frame. */
+static void pace_main_loop(bool* paced) {
+    if (*paced) return;
+    *paced = true;
+    emscripten_set_main_loop_timing(EM_TIMING_RAF, MAIN_LOOP_VSYNC_INTERVAL);
+}
+
+/* Hidden document: no frames, but the connection stays serviced. */
+static void hidden_tick(void) {
+    frame_arena_reset();
+    log_frame_mark();
+    game_client_on_tick();
+    game_state_commit();
+    map_arena_sync(g_game_state.player.map_code);
+    frame_tasks_run(FRAME_TASKS_BUDGET_MS);
+    network_uplink_flush();
+    overlay_commands_flush(); // one JS call for this tick's overlay state
+    game_state_frame_end();
+}
+
 static void gameloop(void) {
+    static bool paced = false;
+    pace_main_loop(&paced);
+    const double loop_start = emscripten_get_now();
+    PROFILE_FRAME_MARK();
+    heap_memory_frame_mark();
+    frame_arena_reset();
+    log_frame_mark();
     float frame_dt = GetFrameTime();
 #ifndef CYBERIA_DEBUG
     if ( frame_dt > 0.25 ) { frame_dt = 0.25; } // runnaway clamp
 #endif
-    sim_acc += (double)frame_dt;
 
+    presentation_runtime_poll(GetTime());
     text_font_sync();
+    PROFILE_BEGIN(PROF_ZONE_NETWORK);
     game_client_on_tick();
+    crowd_gen_tick();
+    bench_scene_tick();
+    static_world_update(game_render_get_camera_bounds());
+    PROFILE_END(PROF_ZONE_NETWORK);
+    game_state_commit();
+    map_arena_sync(g_game_state.player.map_code);
+    PROFILE_BEGIN(PROF_ZONE_FETCH_PUMP);
+    fetch_batch_pump();
+    image_decoder_pump();
+    PROFILE_END(PROF_ZONE_FETCH_PUMP);
     local_player_on_tick();
 
     // input capture in realtime
     input_queue_t frame_input = {0};
     input_queue_on_tick(&frame_input, frame_dt);
+    frame_pacing_on_frame((int)frame_input.count);
+    const bool traced = input_next(&frame_input, NULL, INPUT_TAP) &&
+                        input_latency_begin(emscripten_get_now(), g_game_state.player.base.interp_pos);
 
+    PROFILE_BEGIN(PROF_ZONE_UI_TICK);
     ui_on_tick(&frame_input, frame_dt);
+    PROFILE_END(PROF_ZONE_UI_TICK);
 
-    // TODO: collapse this into a function, this is temporary to remove input.c dependency
-    {
-        input_queue_t bkp_queue = { 0 };
-        input_event_t evt = { 0 };
-        while (input_pop(&frame_input, &evt)) {
-            bool consumed = false;
-            if(!consumed && INPUT_TAP == evt.type) {
-                /* FrozenInteractionState — server says we're frozen, drop the tap. */
-                if (local_player_is_frozen()) { consumed = true; }
-                if (g_game_state.player.base.respawn_in > 0.0f) { consumed = true; }
-            }
-            // unconsumed event back to the queue
-            if(!consumed) {
-                input_push(&bkp_queue, evt);
-                continue;
-            }
+    /* FrozenInteractionState: server says we're frozen (or dead), drop taps. */
+    if (local_player_is_frozen() || g_game_state.player.base.respawn_in > 0.0f) {
+        for (input_event_t* evt = NULL; (evt = input_next(&frame_input, evt, INPUT_TAP));) {
+            evt->consumed = true;
         }
-        // return unconsummed events to the original queue
-        input_event_t bkp_evt = { 0 };
-        while (input_pop(&bkp_queue, &bkp_evt)) { input_push(&frame_input, bkp_evt ); }
     }
 
-    replication_prepare_input(frame_input);
-
-    // TODO: collapse this into a function, this is temporary to remove input.c dependency
-    {
-        // Tap Effect
-        input_queue_t bkp_queue = { 0 };
-        input_event_t evt = { 0 };
-        while (input_pop(&frame_input, &evt)) {
-            bool consumed = false;
-            if(!consumed && INPUT_TAP == evt.type) {
-                FxTapParams fx = fx_tap_default_params();
-                fx.scale = 1.15f;
-                fx.duration = 0.70f;
-                fx.intensity = 1.25f;
-                fx_tap_spawn(evt.world_position, &fx);
-                /* A tap landing on a quest/action provider auto-opens the
-                 * collapsed bubble column so the interaction is reachable. */
-                if (interaction_bubble_is_collapsed() &&
-                    tap_hits_provider(evt.world_position)) {
-                    interaction_bubble_expand();
-                }
-                consumed = false; // TAP EFFECTS DON'T CONSUME THE INPUT, BUT ALSO SHOULDN'T HAPPEN BEFORE PROCESS
-            }
-             // unconsumed event back to the queue
-            if(!consumed) {
-                input_push(&bkp_queue, evt);
-                continue;
-            }
+    const bool tapped = NULL != input_next(&frame_input, NULL, INPUT_TAP);
+    if (traced && tapped) {
+        input_latency_mark(INPUT_LAT_DISPATCHED, emscripten_get_now());
+    } else if (traced) {
+        input_latency_cancel();
+    }
+
+    replication_prepare_input(&frame_input);
+    /* Low-latency mode: the tap goes out now instead of after render. */
+    const bool low_latency = runtime_config_low_latency();
+    if (tapped && low_latency) {
+        network_uplink_flush();
+        if (0 == net_telemetry_uplink()->depth) input_latency_mark(INPUT_LAT_SENT, emscripten_get_now());
+    }
+
+    /* Tap effects read the taps that reached the world but do not consume
+     * them; they run after replication so the effect marks the sent target. */
+    for (input_event_t* evt = NULL; (evt = input_next(&frame_input, evt, INPUT_TAP));) {
+        FxTapParams fx = fx_tap_default_params();
+        fx.scale = 1.15f;
+        fx.duration = 0.70f;
+        fx.intensity = 1.25f;
+        fx_tap_spawn(evt->world_position, &fx);
+        /* A tap landing on a quest/action provider auto-opens the
+         * collapsed bubble column so the interaction is reachable. */
+        if (interaction_bubble_is_collapsed() &&
+            tap_hits_provider(evt->world_position)) {
+            interaction_bubble_expand();
         }
-         // return unconsummed events to the original queue
-        input_event_t bkp_evt = { 0 };
-        while (input_pop(&bkp_queue, &bkp_evt)) { input_push(&frame_input, bkp_evt ); }
     }
 
     // fixed step simulation
-    while (sim_acc >= fixed_step)
-    {
-        // physics_update(frame_input, fixed_step); -> prev = curr; integrate(curr, curr_frame, fixed_step)
-        prediction_step(fixed_step);
-        sim_acc -= fixed_step;
+    PROFILE_BEGIN(PROF_ZONE_PREDICTION);
+    int steps = fixed_step_advance(&s_sim_clock, (double)frame_dt);
+    if (tapped && low_latency && 0 == steps) steps = fixed_step_borrow(&s_sim_clock);
+    if (0 < steps) input_latency_mark(INPUT_LAT_PREDICTED, emscripten_get_now());
+    for (; 0 < steps; steps--) {
+        prediction_step(s_sim_clock.step);
     }
     /* Presentation-only: advance the local player's visual state (spring
      * position, velocity-derived facing and walk/idle mode) toward the
-     * predicted/reconciled simulation position. Prediction itself is
-     * untouched — the outputs written back below feed rendering/camera only,
-     * keeping sprite motion, facing, and animation in lockstep instead of
-     * following the server's asynchronous snapshot cadence. */
+     * predicted/reconciled simulation position, in fixed substeps of its own
+     * on the same scheduler. Prediction itself is untouched — the outputs
+     * written back below feed rendering/camera only, keeping sprite motion,
+     * facing, and animation in lockstep instead of following the server's
+     * asynchronous snapshot cadence. */
     local_player_view_update(prediction_self_position(),
                              prediction_consume_correction(),
                              g_game_state.player.base.direction,
@@ -142,12 +214,36 @@ static void gameloop(void) {
     g_game_state.player.base.interp_pos = local_player_view_position();
     g_game_state.player.base.direction  = local_player_view_direction();
     g_game_state.player.base.mode       = local_player_view_mode();
+    PROFILE_END(PROF_ZONE_PREDICTION);
 
     /* Remote-entity render-time interpolation. */
+    PROFILE_BEGIN(PROF_ZONE_INTERPOLATION);
     interpolation_compute_view();
+    PROFILE_END(PROF_ZONE_INTERPOLATION);
 
     // render interpolated state
+    PROFILE_BEGIN(PROF_ZONE_RENDER);
+    const double render_start = emscripten_get_now();
     render_on_tick(frame_dt);
+    game_client_on_frame_cost(emscripten_get_now() - render_start);
+    frame_tasks_run(FRAME_TASKS_BUDGET_MS);
+    const float frame_ms = GetFrameTime() * 1000.0f / (float)frame_pacing_interval();
+    dynamic_resolution_on_frame(frame_ms);
+    fidelity_on_frame(frame_ms);
+    PROFILE_END(PROF_ZONE_RENDER);
+
+    network_uplink_flush();
+    if (0 == net_telemetry_uplink()->depth) input_latency_mark(INPUT_LAT_SENT, emscripten_get_now());
+    overlay_commands_flush();
+    input_latency_on_frame(emscripten_get_now(), g_game_state.player.base.interp_pos);
+    game_state_frame_end();
+    bench_scene_frame_end(emscripten_get_now() - loop_start);
+    rum_on_frame(GetFrameTime() * 1000.0f);
+
+    if (startup_trace_recording()) {
+        startup_trace_mark("first_playable_frame");
+        startup_trace_end();
+    }
 }
 
 /* ── Loading stages ──────────────────────────────────────────────────────
@@ -160,8 +256,8 @@ enum {
     LOAD_CONNECT,     /* WebSocket to the simulation server open            */
     LOAD_WORLD,       /* authoritative init_data received                   */
     LOAD_HINTS,       /* presentation client-hints fetched                  */
-    LOAD_ASSETS,      /* engine REST pipeline (atlas/OL/textures) went idle */
-    LOAD_STABLE,      /* sustained frames with zero outstanding fetches     */
+    LOAD_ASSETS,      /* critical (or every) engine REST fetch went idle    */
+    LOAD_STABLE,      /* sustained frames with those fetches still idle     */
     LOAD_STAGE_COUNT,
 };
 
@@ -175,6 +271,11 @@ static const char* LOAD_STAGE_LABEL[LOAD_STAGE_COUNT] = {
     "STABILIZING INSTANCE...",
 };
 
+/* Stage names on the startup trace (startup_trace.h). */
+static const char* LOAD_STAGE_NAME[LOAD_STAGE_COUNT] = {
+    "LOAD_RUNTIME", "LOAD_CONNECT", "LOAD_WORLD", "LOAD_HINTS", "LOAD_ASSETS", "LOAD_STABLE",
+};
+
 /* Share of the progress bar per stage (sums to 100). Asset streaming
  * dominates real load time, so it owns most of the bar and advances
  * continuously with the fetch completion ratio. */
@@ -183,8 +284,34 @@ static const float LOAD_STAGE_WEIGHT[LOAD_STAGE_COUNT] = {
 };
 
 /* The stabilization window: this many consecutive rendered frames with an
- * idle fetch pipeline before the world counts as visually stable. */
+ * idle fetch pipeline before the world counts as visually stable. A
+ * progressive start only waits out atlases the first renders discover. */
+#if LOAD_PROGRESSIVE_START
+#define LOAD_STABLE_FRAMES 8
+#else
 #define LOAD_STABLE_FRAMES 45
+#endif
+
+/* Requests the loading screen waits for: started so far and still open.
+ * A progressive start counts FETCH_CLASS_VISIBLE only, plus pending image
+ * decodes, since an atlas is not drawable until decoded. */
+static int load_fetch_started(void) {
+#if LOAD_PROGRESSIVE_START
+    FetchClassStats v = fetch_class_stats(FETCH_CLASS_VISIBLE);
+    return v.queued + v.in_flight + v.completed + v.failed + v.cancelled;
+#else
+    return fetch_total_started();
+#endif
+}
+
+static int load_fetch_pending(void) {
+#if LOAD_PROGRESSIVE_START
+    FetchClassStats v = fetch_class_stats(FETCH_CLASS_VISIBLE);
+    return v.queued + v.in_flight + image_decoder_pending();
+#else
+    return fetch_pending_count();
+#endif
+}
 
 static int  s_load_done      = 0;     /* stages completed so far            */
 static int  s_stable_frames  = 0;
@@ -194,13 +321,13 @@ static bool s_load_ready     = false; /* all stages done, awaiting the tap  */
 static bool load_stage_complete(int stage) {
     switch (stage) {
         case LOAD_RUNTIME: return true; /* main() finished all init calls   */
-        case LOAD_CONNECT: return connection_is_open();
-        case LOAD_WORLD:   return g_game_state.init_received;
+        case LOAD_CONNECT: return connection_is_open() || bench_scene_world_ready();
+        case LOAD_WORLD:   return g_game_state.init_received && !session_snapshot_ghost();
         case LOAD_HINTS:   return presentation_runtime_is_ready();
-        case LOAD_ASSETS:  return fetch_total_started() > 0 &&
-                                  0 == fetch_pending_count();
+        case LOAD_ASSETS:  return load_fetch_started() > 0 &&
+                                  0 == load_fetch_pending();
         case LOAD_STABLE:
-            if (0 == fetch_pending_count()) s_stable_frames++;
+            if (0 == load_fetch_pending()) s_stable_frames++;
             else                            s_stable_frames = 0;
             return LOAD_STABLE_FRAMES <= s_stable_frames;
     }
@@ -211,9 +338,11 @@ static bool load_stage_complete(int stage) {
 static float load_stage_fraction(int stage) {
     switch (stage) {
         case LOAD_ASSETS: {
-            int total = fetch_total_started();
+            int total = load_fetch_started();
             if (0 >= total) return 0.0f;
-            return (float)(total - fetch_pending_count()) / (float)total;
+            int pending = load_fetch_pending();
+            if (pending > total) pending = total;
+            return (float)(total - pending) / (float)total;
         }
         case LOAD_STABLE:
             return (float)s_stable_frames / (float)LOAD_STABLE_FRAMES;
@@ -247,47 +376,81 @@ static void report_loading_progress(void) {
 }
 
 static void preloading_loop(void) {
+    static bool paced = false;
+    pace_main_loop(&paced);
     const float frame_dt = GetFrameTime();
     text_font_sync();
     game_client_on_tick();
+    fetch_batch_pump();
+    image_decoder_pump();
+    game_state_commit();
+    map_arena_sync(g_game_state.player.map_code);
 
     /* Render the (still hidden) world every preload frame: this is what
      * drives the lazy atlas/ObjectLayer fetches and texture creation, so
      * LOAD_ASSETS / LOAD_STABLE measure genuine readiness. */
     render_on_tick(frame_dt);
+    frame_tasks_run(FRAME_TASKS_BUDGET_MS);
+    network_uplink_flush();
+    overlay_commands_flush();
+    game_state_frame_end();
 
     /* Stages complete strictly in order — each is gated on the previous. */
     while (!s_load_ready && load_stage_complete(s_load_done)) {
+        startup_trace_stage_done(LOAD_STAGE_NAME[s_load_done]);
         s_load_done++;
         if (LOAD_STAGE_COUNT <= s_load_done) {
             s_load_ready = true;
+            startup_trace_mark("tap_to_start_shown");
             loading_bridge_ready();
         }
     }
     if (!s_load_ready) report_loading_progress();
+    loading_bridge_ghost(session_snapshot_ghost());
 
-    /* Gameplay begins only on the player's explicit Tap-to-Start. */
-    if (s_load_ready && loading_bridge_start_requested()) {
+    /* Gameplay begins only on the player's explicit Tap-to-Start; a bench
+     * run starts on its own. */
+    if (s_load_ready && (loading_bridge_start_requested() || bench_scene_active())) {
+        startup_trace_mark("start_tapped");
         loading_bridge_hide();
-        client_confirm_loading_done(); /* release the server "loading" freeze */
+        if (!bench_scene_active()) client_confirm_loading_done(); /* release the server "loading" freeze */
         emscripten_cancel_main_loop();
+        frame_pacing_install(hidden_tick);
         emscripten_set_main_loop(gameloop, 0, 1);
     }
 }
 
 int main(void) {
+    startup_trace_begin();
+    // Initial images of the per-view module state, before anything writes it.
+    client_context_init();
     // init window
     const int vp_w = EM_ASM_INT({ return window.innerWidth; });
     const int vp_h = EM_ASM_INT({ return window.innerHeight; });
     InitWindow(vp_w, vp_h, NULL);
-    SetTargetFPS(TICK_RATE_HZ);
+    /* No SetTargetFPS: it makes EndDrawing wait out the frame budget, and
+     * on the browser main thread that wait is a busy spin inside the rAF
+     * callback. pace_main_loop() caps the rate instead. */
+    render_stats_install(); // WebGL draw / bind / vertex counters for dev_ui
 
     // Resolves the instance code and endpoint origins from the URL + injected
     // runtime config. Must precede any connection or engine API call.
     runtime_config_init();
 
-    // Connects to Game Server
-    connection_open();
+    job_system_init(); // parallel_for workers (pthreads builds; inline otherwise)
+
+    profiler_bridge_install(); // window.CyberiaProfiler: frame traces + network telemetry
+    recorder_bridge_install(); // window.CyberiaRecorder: session capture for host replay
+    startup_bridge_install(); // window.CyberiaStartup.exportTrace(): load timeline as Chrome trace JSON
+#ifdef CYBERIA_DEBUG
+    crowd_bridge_install(); // window.CyberiaCrowd: synthetic crowd load generator
+#endif
+
+    // Connects to Game Server, unless the page is a scripted ?bench= run
+    const bool bench = '\0' != runtime_config_bench()->scenario[0];
+    if (!bench) connection_open();
+    if (!bench) rum_bridge_install(); // sampled field performance beacon (opt-in)
+    if (!bench) snapshot_bridge_install(); // saved world drawn as a ghost until the real one arrives
 
     prediction_init(); // Note: this is just data, should be replaced by GameState
     render_init(vp_w, vp_h); // NOTE: if render is the window, then combine with it
@@ -299,8 +462,13 @@ int main(void) {
     // NOTE: Do not mix the start fetch loop with the running game loop
     // if need to be non blocking then wait in a loading screen before starting main_loop
     // all the initializations should be consolidated in related modules
+    fetch_asset_pack_load(ASSET_PACK_URL); // status icons + fonts in one request
     presentation_runtime_start_fetch(CYBERIA_CLIENT_HINTS_CODE);
 
+    // [bench] synthetic world in place of the server; an unknown scenario
+    // falls back to a normal session
+    if (bench && !bench_scene_start(runtime_config_bench())) connection_open();
+
     // [preload] it should handle the switch to gameloop on callback
     emscripten_set_main_loop(preloading_loop, 0, 1);
 
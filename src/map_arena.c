@@ -0,0 +1,104 @@
+#include "map_arena.h"
+
+#include "heap_memory.h"
+#include "util/log.h"
+#include "world_types.h"
+
+#include <assert.h>
+#include <stdint.h>
+#include <string.h>
+
+typedef struct MapChunk {
+    struct MapChunk* next;
+    size_t           size;
+    size_t           used;
+    max_align_t      data[];
+} MapChunk;
+
+static struct {
+    MapChunk*       head;
+    MapChunk*       cur;
+    size_t          used;
+    size_t          reserved;
+    uint32_t        generation;
+    char            map_code[MAX_ID_LENGTH];
+    MapArenaResetFn listeners[MAP_ARENA_MAX_LISTENERS];
+    int             listener_count;
+} g_map_arena;
+
+void* map_alloc(size_t size) {
+    const size_t align = _Alignof(max_align_t);
+    size = (size + align - 1) & ~(align - 1);
+
+    MapChunk* c = g_map_arena.cur;
+    while (c && c->used + size > c->size) c = c->next;
+    if (!c) {
+        size_t cap = (size > MAP_ARENA_CHUNK) ? size : MAP_ARENA_CHUNK;
+        c = heap_malloc(HEAP_MEM_MAP_ARENA, sizeof(MapChunk) + cap);
+        assert(c);
+        *c = (MapChunk){ .size = cap };
+        MapChunk** tail = &g_map_arena.head;
+        while (*tail) tail = &(*tail)->next;
+        *tail = c;
+        g_map_arena.reserved += cap;
+    }
+    g_map_arena.cur = c;
+    void* p = (char*)c->data + c->used;
+    c->used += size;
+    g_map_arena.used += size;
+    return p;
+}
+
+void* map_calloc(size_t count, size_t size) {
+    assert(0 == size || SIZE_MAX / size >= count);
+    void* p = map_alloc(count * size);
+    memset(p, 0, count * size);
+    return p;
+}
+
+void map_arena_on_reset(MapArenaResetFn fn) {
+    assert(fn);
+    for (int i = 0; i < g_map_arena.listener_count; i++) {
+        if (g_map_arena.listeners[i] == fn) return;
+    }
+    assert(MAP_ARENA_MAX_LISTENERS > g_map_arena.listener_count);
+    g_map_arena.listeners[g_map_arena.listener_count++] = fn;
+}
+
+static void arena_reset(void) {
+    size_t kept = 0;
+    MapChunk** link = &g_map_arena.head;
+    while (*link) {
+        MapChunk* c = *link;
+        if (kept + c->size > MAP_ARENA_KEEP) {
+            *link = c->next;
+            g_map_arena.reserved -= c->size;
+            heap_free(c);
+            continue;
+        }
+        kept   += c->size;
+        c->used = 0;
+        link    = &c->next;
+    }
+    g_map_arena.cur  = g_map_arena.head;
+    g_map_arena.used = 0;
+    g_map_arena.generation++;
+}
+
+void map_arena_sync(const char* map_code) {
+    assert(map_code);
+    if (0 == strncmp(map_code, g_map_arena.map_code, sizeof(g_map_arena.map_code))) return;
+    LOG_INFO("map arena: '%s' -> '%s', releasing %zu bytes", g_map_arena.map_code, map_code,
+             g_map_arena.used);
+    strncpy(g_map_arena.map_code, map_code, sizeof(g_map_arena.map_code) - 1);
+    for (int i = 0; i < g_map_arena.listener_count; i++) g_map_arena.listeners[i]();
+    arena_reset();
+}
+
+MapArenaStats map_arena_stats(void) {
+    return (MapArenaStats){
+        .used       = g_map_arena.used,
+        .reserved   = g_map_arena.reserved,
+        .generation = g_map_arena.generation,
+    };
+}
@@ -0,0 +1,50 @@
+#ifndef CYBERIA_MAP_ARENA_H
+#define CYBERIA_MAP_ARENA_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Map-lifetime storage, released in one shot when the player changes map.
+ *
+ * Data that only means something on the current map bump-allocates from
+ * here instead of being malloc'd and freed piece by piece: one reset on
+ * travel hands it all back. Modules whose per-map state lives in their own
+ * tables register a reset hook instead (map_arena_on_reset) and clear
+ * them there, in the same pass.
+ *
+ * The loop calls map_arena_sync() with the self player's map code after
+ * each game_state_commit(). When the code differs from the last one, it
+ * runs every hook, in registration order, and then resets the arena.
+ * Hooks must drop every pointer they hold into it. Chunks
+ * (HEAP_MEM_MAP_ARENA) are kept across resets up to MAP_ARENA_KEEP.
+ *
+ * Main thread only. Never free a block individually, and never keep one
+ * past a reset.
+ */
+
+#define MAP_ARENA_CHUNK         (256u * 1024u)
+#define MAP_ARENA_KEEP          (256u * 1024u)
+#define MAP_ARENA_MAX_LISTENERS 16
+
+typedef void (*MapArenaResetFn)(void);
+
+typedef struct {
+    size_t   used;         /* bytes handed out on the current map */
+    size_t   reserved;     /* chunk bytes held */
+    uint32_t generation;   /* bumped by every reset */
+} MapArenaStats;
+
+/* `size` bytes aligned for any type, until the next map change. Never NULL. */
+void* map_alloc(size_t size);
+void* map_calloc(size_t count, size_t size);
+
+/* Register a hook run on every map change (idempotent). */
+void  map_arena_on_reset(MapArenaResetFn fn);
+
+/* The self player is on `map_code`; a change runs the hooks and resets. */
+void  map_arena_sync(const char* map_code);
+
+MapArenaStats map_arena_stats(void);
+
+#endif /* CYBERIA_MAP_ARENA_H */
@@ -1,11 +1,16 @@
 #include "message_parser.h"
 #include "binary_aoi_decoder.h"
+#include "client_context.h"
 #include "config.h"
 #include "game_state.h"
+#include "id_intern.h"
+#include "layer_stack.h"
+#include "json_aoi_decoder.h"
 #include "serial.h"
 #include <cJSON.h>
 #include "object_layers_management.h"
 #include "js/interact_bridge.h"
+#include "js/overlay_commands.h"
 #include "notify_store.h"
 #include "domain/camera.h"
 #include "domain/presentation_runtime.h"
@@ -24,14 +29,13 @@
 static MessageType get_message_type(const cJSON* root);
 static int message_parser_parse_metadata(const cJSON* json_root);
 static int message_parser_parse_init_data(const cJSON* json_root);
-static int message_parser_parse_aoi_update(const cJSON* json_root);
 static int message_parser_parse_skill_item_ids(const cJSON* json_root);
 static int message_parser_parse_error(const cJSON* json_root);
-static int message_parser_parse_visible_players(const cJSON* players_json);
 static int message_parser_parse_dlg_ack(const cJSON* json_root);
 static void message_parser_upsert_quest_array(const cJSON* quests_json);
 
 static MessageParserInitHandler s_init_handler = NULL;
+static MessageType              s_last_type    = MSG_TYPE_UNKNOWN;
 
 void message_parser_set_init_handler(MessageParserInitHandler handler) {
     s_init_handler = handler;
@@ -41,15 +45,25 @@ void message_parser_set_init_handler(MessageParserInitHandler handler) {
  * Main Message Processing Entry Point
  * ============================================================================ */
 
-bool message_parser_parse(const char* json_str) {
-    assert(json_str);
-    cJSON* root = cJSON_Parse(json_str);
+bool message_parser_parse(const char* json, size_t length) {
+    assert(json);
+
+    /* AOI snapshots are the bulk of JSON traffic: decoded without a tree. */
+    if (json_aoi_is_update(json, length)) {
+        s_last_type = MSG_TYPE_AOI_UPDATE;
+        return 0 == json_aoi_process(json, length);
+    }
+
+    s_last_type = MSG_TYPE_UNKNOWN;
+
+    cJSON* root = serial_json_parse(json, length);
     if (!root) {
-        LOG_ERROR("[MESSAGE_PARSER] Failed to parse JSON (length: %zu bytes)\n", strlen(json_str));
+        LOG_ERROR("[MESSAGE_PARSER] Failed to parse JSON (length: %zu bytes)\n", length);
         return false;
     }
 
     MessageType msg_type = get_message_type(root);
+    s_last_type = msg_type;
 
     bool result = false;
     switch (msg_type) {
@@ -60,7 +74,8 @@ bool message_parser_parse(const char* json_str) {
             result = 0 == message_parser_parse_metadata(root);
             break;
         case MSG_TYPE_AOI_UPDATE:
-            result = 0 == message_parser_parse_aoi_update(root);
+            /* Only reached when "type" is not a plain string. */
+            result = 0 == json_aoi_process(json, length);
             break;
         case MSG_TYPE_SKILL_ITEM_IDS:
             result = 0 == message_parser_parse_skill_item_ids(root);
@@ -75,6 +90,17 @@ bool message_parser_parse(const char* json_str) {
         case MSG_TYPE_DLG_ACK:
             result = 0 == message_parser_parse_dlg_ack(root);
             break;
+        case MSG_TYPE_CLIENT_HINTS: {
+            /* Live-ops changed the presentation hints: refetch, apply the diff. */
+            cJSON* payload = serial_get_object(root, "payload");
+            cJSON* v = payload ? cJSON_GetObjectItem(payload, "version") : NULL;
+            char version[64] = {0};
+            if (v && cJSON_IsString(v))      snprintf(version, sizeof(version), "%s", v->valuestring);
+            else if (v && cJSON_IsNumber(v)) snprintf(version, sizeof(version), "%.17g", v->valuedouble);
+            presentation_runtime_notify_version(version);
+            result = true;
+            break;
+        }
         case MSG_TYPE_CHAT: {
             cJSON* payload = serial_get_object(root, "payload");
             if (payload) {
@@ -85,7 +111,7 @@ bool message_parser_parse(const char* json_str) {
                 if (from_id[0] && text[0]) {
                     notify_store_push(from_id, from_id, text);
                     notification_push(NOTIF_CHAT, from_id);
-                    js_interact_overlay_receive_chat(from_id, from_id, text);
+                    overlay_commands_chat(from_id, from_id, text);
                 }
             }
             result = true;
@@ -97,14 +123,17 @@ bool message_parser_parse(const char* json_str) {
             if (payload) {
                 // Check for init_data indicators
                 if (cJSON_HasObjectItem(payload, "gridW") && cJSON_HasObjectItem(payload, "gridH")) {
+                    s_last_type = MSG_TYPE_INIT_DATA;
                     result = 0 == message_parser_parse_init_data(root);
                 }
                 // Check for aoi_update indicators
                 else if (cJSON_HasObjectItem(payload, "player") && cJSON_HasObjectItem(payload, "playerID")) {
-                    result = 0 == message_parser_parse_aoi_update(root);
+                    s_last_type = MSG_TYPE_AOI_UPDATE;
+                    result = 0 == json_aoi_process(json, length);
                 }
                 // Check for skill_item_ids indicators
                 else if (cJSON_HasObjectItem(payload, "associatedItemIds")) {
+                    s_last_type = MSG_TYPE_SKILL_ITEM_IDS;
                     result = 0 == message_parser_parse_skill_item_ids(root);
                 }
             }
@@ -112,10 +141,14 @@ bool message_parser_parse(const char* json_str) {
         }
     }
 
-    cJSON_Delete(root);
+    serial_json_free(root);
     return result;
 }
 
+MessageType message_parser_last_type(void) {
+    return s_last_type;
+}
+
 /* ============================================================================
  * Init Data Message Parser
  * ============================================================================ */
@@ -132,10 +165,7 @@ static int message_parser_parse_init_data(const cJSON* json_root) {
     }
     LOG_INFO("[INIT_DATA] payload found, parsing grid/world config\n");
 
-    /* New session boundary — drop any stale prev-position snapshot from a
-     * prior server lifetime so post-restart UUIDs don't interpolate from
-     * origin. Cheap; safe to call on every init_data. */
-    binary_aoi_reset_prev_snapshots();
+    message_parser_begin_init_data();
 
     // Parse grid configuration — gameplay only (simulation contract).
     // cellSize / interpolationMs / cameraZoom are NOT here; the cyberia-server
@@ -147,12 +177,9 @@ static int message_parser_parse_init_data(const cJSON* json_root) {
 
     g_game_state.sum_stats_limit = serial_get_int_default(payload, "sumStatsLimit", 9999);
 
-    /* Skill map lives in ui_state — pure presentation lookup. */
-    ui_state_clear_skills();
     cJSON* skill_map_json = cJSON_GetObjectItem(payload, "skillMap");
 
     // Parse entity type defaults
-    g_game_state.entity_defaults_count = 0;
     cJSON* entity_defaults_json = cJSON_GetObjectItem(payload, "entityDefaults");
     if (entity_defaults_json && cJSON_IsArray(entity_defaults_json)) {
         cJSON* etd = NULL;
@@ -213,7 +240,6 @@ static int message_parser_parse_init_data(const cJSON* json_root) {
 
     /* Resolved dead-state (Fragmentation) ids — inventory labelling and
      * equip gating; the server rejects their activation regardless. */
-    g_game_state.dead_item_id_count = 0;
     cJSON* dead_ids_json = cJSON_GetObjectItem(payload, "deadItemIds");
     if (dead_ids_json && cJSON_IsArray(dead_ids_json)) {
         cJSON* item = NULL;
@@ -261,14 +287,36 @@ static int message_parser_parse_init_data(const cJSON* json_root) {
         }
     }
 
+    message_parser_upsert_quest_array(cJSON_GetObjectItem(payload, "quests"));
+
+    message_parser_finish_init_data();
+    return 0;
+}
+
+void message_parser_begin_init_data(void) {
+    /* New session boundary — drop any stale prev-position snapshot and
+     * interned ids from a prior server lifetime so post-restart UUIDs don't
+     * interpolate from origin. Cheap; safe to call on every init_data. */
+    binary_aoi_reset_prev_snapshots();
+    id_intern_reset();
+    layer_stack_reset();
+
+    /* Skill map lives in ui_state — pure presentation lookup. */
+    ui_state_clear_skills();
+    g_game_state.entity_defaults_count = 0;
+    g_game_state.dead_item_id_count    = 0;
+    g_game_state.id_index_size         = 0;   /* its handles died with the interner */
+
     /* Seed the Quest Journal store from the connect-time snapshot. Cleared
      * first so a reconnect repopulates cleanly. */
     quest_progress_store_reset();
-    message_parser_upsert_quest_array(cJSON_GetObjectItem(payload, "quests"));
+}
 
+void message_parser_finish_init_data(void) {
     LOG_INFO("init_data parsed gridW=%d gridH=%d aoiRadius=%.1f entityDefaults=%d skills=%d",
              g_game_state.grid_w, g_game_state.grid_h, g_game_state.aoi_radius,
              g_game_state.entity_defaults_count, ui_state_skill_count());
+    game_state_index_item_rules();
     g_game_state.init_received = true;
 
     /* Camera follows the presentation runtime's zoom; the underlying value
@@ -281,7 +329,15 @@ static int message_parser_parse_init_data(const cJSON* json_root) {
 
     /* Signal interested modules (network FSM) that the handshake completed. */
     if (s_init_handler) { s_init_handler(); }
-    return 0;
+}
+
+bool message_parser_parse_quests(const char* json, size_t length) {
+    assert(json);
+    cJSON* quests = serial_json_parse(json, length);
+    if (!quests) return false;
+    message_parser_upsert_quest_array(quests);
+    serial_json_free(quests);
+    return true;
 }
 
 /* ============================================================================
@@ -353,210 +409,13 @@ static int message_parser_parse_metadata(const cJSON* json_root) {
                g_game_state.equipment_rules.active_item_type_count,
                g_game_state.equipment_rules.one_per_type,
                g_game_state.equipment_rules.require_skin);
+        game_state_index_item_rules();
     }
 
     LOG_INFO("[METADATA] Cached %d ObjectLayers, scheduled %d atlas REST fetches\n", ol_count, ol_count);
     return 0;
 }
 
-/* ============================================================================
- * AOI Update Message Parser
- * ============================================================================ */
-
-static int message_parser_parse_visible_players(const cJSON* players_json) {
-    assert(players_json);
-
-    // Mark all existing players as not seen in this update
-    bool player_seen[MAX_ENTITIES] = {false};
-
-    // Parse all visible players from server
-    cJSON* player_obj = NULL;
-    cJSON_ArrayForEach(player_obj, players_json) {
-        PlayerState player = {0};
-
-        // Deserialize player as entity (VisiblePlayer is subset of PlayerState)
-        if (serial_deserialize_entity_state(player_obj, &player.base) == 0) {
-            // Update or add player - this preserves smooth interpolation for existing players
-            game_state_update_player(&player);
-
-            // Mark this player as seen
-            for (int i = 0; i < g_game_state.other_player_count; i++) {
-                if (strcmp(g_game_state.other_players[i].base.id, player.base.id) == 0) {
-                    player_seen[i] = true;
-                    break;
-                }
-            }
-        }
-    }
-
-    // Remove players that are no longer visible
-    for (int i = g_game_state.other_player_count - 1; i >= 0; i--) {
-        if (!player_seen[i]) {
-            game_state_remove_player(g_game_state.other_players[i].base.id);
-        }
-    }
-
-    return 0;
-}
-
-static int message_parser_parse_aoi_update(const cJSON* json_root) {
-    assert(json_root);
-
-    // Get payload object
-    cJSON* payload = serial_get_object(json_root, "payload");
-    if (!payload) {
-        return -1;
-    }
-
-    // Parse main player object
-    cJSON* player_obj = serial_get_object(payload, "player");
-    if (player_obj) {
-        PlayerState player = {0};
-
-        if (serial_deserialize_player_state(player_obj, &player) == 0) {
-            bool first_update = (g_game_state.player_id[0] == '\0');
-
-            Vector2 prev_interp_pos = g_game_state.player.base.interp_pos;
-            Vector2 prev_server_pos = g_game_state.player.base.pos_server;
-            Vector2 tap_target      = g_game_state.player.tap_target;
-            bool    has_tap_target  = g_game_state.player.has_tap_target;
-
-            /* Clear the local tap target as soon as the server reports the
-             * player stopped — drives the on-tap arrow off when motion ends. */
-            if (!first_update) {
-                float sdx = player.base.pos_server.x - prev_server_pos.x;
-                float sdy = player.base.pos_server.y - prev_server_pos.y;
-                if (sdx * sdx + sdy * sdy < 0.0001f) {
-                    has_tap_target = false;
-                }
-            }
-
-            memcpy(&g_game_state.player, &player, sizeof(PlayerState));
-
-            g_game_state.player.tap_target     = tap_target;
-            g_game_state.player.has_tap_target = has_tap_target;
-
-            if (!first_update) {
-                g_game_state.player.base.interp_pos = prev_interp_pos;
-            }
-
-            // Store player ID if not set
-            if (first_update) {
-                strncpy(g_game_state.player_id, player.base.id, sizeof(g_game_state.player_id) - 1);
-            }
-        }
-    }
-
-    // Parse visible players
-    cJSON* visible_players = serial_get_object(payload, "visiblePlayers");
-    if (visible_players) {
-        message_parser_parse_visible_players(visible_players);
-    }
-
-    // Parse visible grid objects - this is a FLAT dictionary where each object has a "Type" field
-    cJSON* visible_grid_objects = serial_get_object(payload, "visibleGridObjects");
-    if (visible_grid_objects) {
-        // Clear all grid object collections first (non-entity objects)
-        g_game_state.obstacle_count = 0;
-        g_game_state.portal_count = 0;
-        g_game_state.floor_count = 0;
-        g_game_state.foreground_count = 0;
-
-        // Note: bot_count is managed by game_state_update_bot() to preserve smooth interpolation
-        // Mark all existing bots as not seen in this update
-        bool bot_seen[MAX_ENTITIES] = {false};
-
-        // Iterate through all objects in the flat dictionary (it's an object, not an array)
-        // In cJSON, for {"id1": {...}, "id2": {...}}, child points to first key-value pair
-        // obj->string is the key (ID), obj itself is the value object
-        cJSON* obj = visible_grid_objects->child;
-        while (obj != NULL) {
-            // Get the Type field to determine what kind of object this is
-            cJSON* type_field = cJSON_GetObjectItemCaseSensitive(obj, "Type");
-            if (!type_field || !cJSON_IsString(type_field)) {
-                obj = obj->next;
-                continue;
-            }
-
-            const char* obj_type = type_field->valuestring;
-
-            // Dispatch based on type
-            if (strcmp(obj_type, "obstacle") == 0) {
-                if (g_game_state.obstacle_count < MAX_OBJECTS) {
-                    WorldObject* obstacle = &g_game_state.obstacles[g_game_state.obstacle_count];
-                    if (serial_deserialize_world_object(obj, obstacle) != 0) {
-                        obj = obj->next;
-                        continue;
-                    }
-                        g_game_state.obstacle_count++;
-                }
-            }
-            else if (strcmp(obj_type, "foreground") == 0) {
-                if (g_game_state.foreground_count < MAX_OBJECTS) {
-                    WorldObject* foreground = &g_game_state.foregrounds[g_game_state.foreground_count];
-                    if (serial_deserialize_world_object(obj, foreground) != 0) {
-                        obj = obj->next;
-                        continue;
-                    }
-                        g_game_state.foreground_count++;
-                }
-            }
-            else if (strcmp(obj_type, "portal") == 0) {
-                if (g_game_state.portal_count < MAX_OBJECTS) {
-                    WorldObject* portal = &g_game_state.portals[g_game_state.portal_count];
-                    if (serial_deserialize_world_object(obj, portal) != 0) {
-                        obj = obj->next;
-                        continue;
-                    }
-                        g_game_state.portal_count++;
-                }
-            }
-            else if (strcmp(obj_type, "floor") == 0) {
-                if (g_game_state.floor_count < MAX_OBJECTS) {
-                    WorldObject* floor = &g_game_state.floors[g_game_state.floor_count];
-                    if (serial_deserialize_world_object(obj, floor) != 0) {
-                        obj = obj->next;
-                        continue;
-                    }
-                        g_game_state.floor_count++;
-                }
-            }
-            else if (strcmp(obj_type, "bot") == 0) {
-                // Parse bot
-                BotState bot = {0};
-
-                if (serial_deserialize_bot_state(obj, &bot) == 0) {
-                    // Update or add bot - preserves smooth interpolation for existing bots
-                    game_state_update_bot(&bot);
-
-                    // Mark this bot as seen
-                    for (int i = 0; i < g_game_state.bot_count; i++) {
-                        if (strcmp(g_game_state.bots[i].base.id, bot.base.id) == 0) {
-                            bot_seen[i] = true;
-                            break;
-                        }
-                    }
-                }
-            }
-
-            // Move to next object in the dictionary
-            obj = obj->next;
-        }
-
-        // Remove bots that are no longer visible
-        for (int i = g_game_state.bot_count - 1; i >= 0; i--) {
-            if (!bot_seen[i]) {
-                game_state_remove_bot(g_game_state.bots[i].base.id);
-            }
-        }
-    }
-
-    // Update timestamp
-    g_game_state.last_update_time = GetTime();
-
-    return 0;
-}
-
 /* ============================================================================
  * Skill/Item IDs Message Parser
  * ============================================================================ */
@@ -633,6 +492,7 @@ static MessageType get_message_type(const cJSON* root) {
     if (0 == strcmp(type_str, "pong"))           return MSG_TYPE_PONG;
     if (0 == strcmp(type_str, "chat"))           return MSG_TYPE_CHAT;
     if (0 == strcmp(type_str, "dlg_ack"))        return MSG_TYPE_DLG_ACK;
+    if (0 == strcmp(type_str, "client_hints"))   return MSG_TYPE_CLIENT_HINTS;
 
     LOG_ERROR("[MESSAGE_PARSER] warning type unknown\n");
     return MSG_TYPE_UNKNOWN;
@@ -733,3 +593,7 @@ static int message_parser_parse_dlg_ack(const cJSON* json_root) {
         LOG_INFO("[DLG_ACK] objective progressed\n");
     return 0;
 }
+
+void message_parser_context_register(void) {
+    client_context_register(&s_last_type, sizeof(s_last_type), NULL);
+}
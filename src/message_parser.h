@@ -2,6 +2,7 @@
 #define MESSAGE_PARSER_H
 
 #include <stdbool.h>
+#include <stddef.h>
 
 /**
  * @brief Message types from server
@@ -16,7 +17,8 @@ typedef enum {
     MSG_TYPE_ERROR,
     MSG_TYPE_PING,
     MSG_TYPE_PONG,
-    MSG_TYPE_DLG_ACK
+    MSG_TYPE_DLG_ACK,
+    MSG_TYPE_CLIENT_HINTS
 } MessageType;
 
 /**
@@ -26,10 +28,16 @@ typedef enum {
  * It determines the message type and dispatches to the appropriate
  * parsing function, updating the game state accordingly.
  *
- * @param json_str Raw JSON message string from server
+ * @param json   Raw JSON bytes from the server, parsed in place (no NUL needed)
+ * @param length Number of bytes in json
  * @return true on success, false on parse error
  */
-bool message_parser_parse(const char* json_str);
+bool message_parser_parse(const char* json, size_t length);
+
+/* Type of the message last given to message_parser_parse, as dispatched
+ * (payload-sniffed types included); MSG_TYPE_UNKNOWN when it did not
+ * parse. For telemetry. */
+MessageType message_parser_last_type(void);
 
 /* Register a handler invoked when an init_data payload finishes parsing.
  * Keeps data flow pointing outward: the parser signals interested modules
@@ -37,4 +45,18 @@ bool message_parser_parse(const char* json_str);
 typedef void (*MessageParserInitHandler)(void);
 void message_parser_set_init_handler(MessageParserInitHandler handler);
 
+/* Shared by the JSON and binary (BIN_MSG_INIT_DATA) init paths.
+ * begin resets the per-session state every init repopulates: interned ids,
+ * interpolation snapshots, skills, entity defaults, dead item ids, quests.
+ * finish marks init received, sets up the camera and signals the handler. */
+void message_parser_begin_init_data(void);
+void message_parser_finish_init_data(void);
+
+/* Upsert an init_data "quests" array given as raw JSON (the binary init
+ * message carries it verbatim). False when it does not parse. */
+bool message_parser_parse_quests(const char* json, size_t length);
+
+/* Hand the parser's per-view state to client_context. */
+void message_parser_context_register(void);
+
 #endif // MESSAGE_PARSER_H
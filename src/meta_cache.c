@@ -0,0 +1,140 @@
+#include "meta_cache.h"
+
+#include "util/log.h"
+
+#include <assert.h>
+#include <raylib.h>
+#include <string.h>
+
+static void* slot_entry(const MetaCache* c, int slot) {
+    return (char*)c->entries + (size_t)slot * c->stride;
+}
+
+static int find_slot(const MetaCache* c, const char* key) {
+    assert(c && key);
+    return entity_index_find(&c->index, key, entity_index_hash(key));
+}
+
+/* Least recently used settled slot idle long enough to drop, or -1. */
+static int victim_slot(const MetaCache* c, double now) {
+    int victim = -1;
+    for (int i = 0; i < c->count; i++) {
+        const MetaCacheSlot* s = &c->slots[i];
+        if (META_CACHE_LOADING == s->state || s->refreshing) continue;
+        if (META_CACHE_MIN_IDLE_SECONDS > now - s->used_at) continue;
+        if (0 > victim || s->used_at < c->slots[victim].used_at) victim = i;
+    }
+    return victim;
+}
+
+static int acquire_slot(MetaCache* c, const char* key, double now) {
+    assert(META_CACHE_KEY_MAX > strlen(key));
+    int slot;
+    bool evicted = false;
+    if (c->count < c->capacity) {
+        slot = c->count++;
+    } else {
+        slot = victim_slot(c, now);
+        if (0 > slot) return -1;
+        LOG_DEBUG("[META_CACHE] %s: evicted '%s' for '%s'", c->name, c->slots[slot].key, key);
+        evicted = true;
+    }
+
+    c->slots[slot] = (MetaCacheSlot){ .used_at = now };
+    strncpy(c->slots[slot].key, key, META_CACHE_KEY_MAX - 1);
+    memset(slot_entry(c, slot), 0, c->stride);
+    if (evicted) {
+        entity_index_rebuild(&c->index, c->count);
+    } else {
+        entity_index_insert(&c->index, entity_index_hash(key), slot);
+    }
+    c->generation++;
+    return slot;
+}
+
+void meta_cache_reset(MetaCache* c) {
+    assert(c);
+    c->count = 0;
+    entity_index_clear(&c->index);
+    c->generation++;
+}
+
+void* meta_cache_get(MetaCache* c, const char* key) {
+    int slot = find_slot(c, key);
+    if (0 > slot) return NULL;
+    c->slots[slot].used_at = GetTime();
+    return slot_entry(c, slot);
+}
+
+MetaCacheState meta_cache_state(const MetaCache* c, const char* key) {
+    int slot = find_slot(c, key);
+    return 0 > slot ? META_CACHE_NONE : c->slots[slot].state;
+}
+
+void* meta_cache_begin_fetch(MetaCache* c, const char* key) {
+    assert(c && key && '\0' != key[0]);
+    assert(c->capacity <= ENTITY_INDEX_CAPACITY / 2);
+    double now = GetTime();
+    int slot = find_slot(c, key);
+    if (0 > slot) {
+        slot = acquire_slot(c, key, now);
+        if (0 > slot) return NULL;
+    }
+
+    MetaCacheSlot* s = &c->slots[slot];
+    s->used_at = now;
+    bool timed_out = META_CACHE_LOADING_TIMEOUT_SECONDS <= now - s->requested_at;
+    switch (s->state) {
+    case META_CACHE_NONE:
+        break;
+    case META_CACHE_ERROR:
+        if (c->error_ttl > now - s->settled_at) return NULL;
+        break;
+    case META_CACHE_READY:
+        if (s->refreshing && !timed_out) return NULL;
+        if (!s->refreshing &&
+            (0.0 >= c->refresh_ttl || c->refresh_ttl > now - s->settled_at)) {
+            return NULL;
+        }
+        s->refreshing   = true;
+        s->requested_at = now;
+        return slot_entry(c, slot);
+    case META_CACHE_LOADING:
+        if (!timed_out) return NULL;
+        LOG_WARN("[META_CACHE] %s: '%s' unanswered, requesting again", c->name, key);
+        break;
+    }
+
+    s->state        = META_CACHE_LOADING;
+    s->requested_at = now;
+    c->generation++;
+    return slot_entry(c, slot);
+}
+
+void* meta_cache_pending(MetaCache* c, const char* key) {
+    int slot = find_slot(c, key);
+    if (0 > slot) return NULL;
+    const MetaCacheSlot* s = &c->slots[slot];
+    if (META_CACHE_LOADING != s->state && !s->refreshing) return NULL;
+    return slot_entry(c, slot);
+}
+
+void meta_cache_settle(MetaCache* c, const char* key, bool ok) {
+    int slot = find_slot(c, key);
+    if (0 > slot) return;
+    MetaCacheSlot* s = &c->slots[slot];
+    assert(META_CACHE_LOADING == s->state || s->refreshing);
+    if (ok) {
+        s->state = META_CACHE_READY;
+    } else if (!s->refreshing) {
+        s->state = META_CACHE_ERROR;
+    }
+    s->refreshing = false;
+    s->settled_at = GetTime();
+    c->generation++;
+}
+
+unsigned meta_cache_generation(const MetaCache* c) {
+    assert(c);
+    return c->generation;
+}
@@ -0,0 +1,107 @@
+#ifndef CYBERIA_META_CACHE_H
+#define CYBERIA_META_CACHE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "entity_index.h"
+
+/*
+ * Bounded, hashed cache of REST metadata records keyed by code.
+ *
+ * The owner supplies two parallel arrays of `capacity` elements: the
+ * MetaCacheSlot bookkeeping and its own payload records (quest, action or
+ * dialogue metadata), `stride` bytes apart. The cache tracks each key's fetch
+ * state and decides when a fetch goes out; the owner issues the request and
+ * parses the response into the payload.
+ *
+ * - Lookups hash the key through an EntityIndex over the slots.
+ * - When every slot is taken, a miss evicts the least recently used settled
+ *   record idle for at least META_CACHE_MIN_IDLE_SECONDS. Records in flight
+ *   or read recently are never evicted; if nothing qualifies the miss is
+ *   refused and retried on a later request.
+ * - A failed fetch settles as ERROR and is retried only after `error_ttl`
+ *   seconds, so a missing record is not re-requested every frame.
+ * - A READY record older than `refresh_ttl` seconds (0 = never) is fetched
+ *   again in the background on its next request. It stays READY and keeps
+ *   serving its old payload until the response lands; a failed refresh
+ *   keeps the old payload too, so owners only write the payload once a
+ *   response has validated.
+ * - A request unanswered for META_CACHE_LOADING_TIMEOUT_SECONDS (a bulk
+ *   response that left the key out, say) may be sent again.
+ *
+ * Payload pointers are stable for as long as their key stays resident, which
+ * is at least until the next meta_cache_begin_fetch() on another key.
+ *
+ * Zero-initialised runtime fields are a valid empty cache, so a MetaCache is
+ * a static with only its configuration and .index.records/.stride set:
+ *
+ *   static MetaCacheSlot s_slots[CAP];
+ *   static Entry         s_entries[CAP];
+ *   static MetaCache     s_cache = {
+ *       .name = "quest", .slots = s_slots, .entries = s_entries,
+ *       .stride = sizeof(Entry), .capacity = CAP, .error_ttl = 30.0,
+ *       .index = { .records = s_slots, .stride = sizeof(MetaCacheSlot) },
+ *   };
+ */
+
+#define META_CACHE_KEY_MAX 128
+#define META_CACHE_MIN_IDLE_SECONDS 5.0
+#define META_CACHE_LOADING_TIMEOUT_SECONDS 20.0
+
+typedef enum {
+    META_CACHE_NONE = 0,
+    META_CACHE_LOADING,
+    META_CACHE_READY,
+    META_CACHE_ERROR,
+} MetaCacheState;
+
+typedef struct {
+    char           key[META_CACHE_KEY_MAX];   /* first: EntityIndex record id */
+    MetaCacheState state;
+    bool           refreshing;                /* READY, re-fetch in flight      */
+    double         requested_at;              /* GetTime() of the last fetch    */
+    double         settled_at;                /* GetTime() of the last response */
+    double         used_at;                   /* GetTime() of the last request  */
+} MetaCacheSlot;
+
+typedef struct {
+    const char*    name;          /* log tag; not owned */
+    MetaCacheSlot* slots;
+    void*          entries;
+    size_t         stride;
+    int            capacity;      /* at most ENTITY_INDEX_CAPACITY / 2 */
+    double         error_ttl;
+    double         refresh_ttl;
+
+    int            count;
+    unsigned       generation;
+    EntityIndex    index;
+} MetaCache;
+
+/* Forget every record. */
+void meta_cache_reset(MetaCache* c);
+
+/* Payload of `key` in any state, or NULL; counts as a use for LRU. */
+void* meta_cache_get(MetaCache* c, const char* key);
+
+MetaCacheState meta_cache_state(const MetaCache* c, const char* key);
+
+/* Called wherever the owner wants `key` loaded. Returns the payload when a
+ * request must go out now — a zeroed record for a new key, or the resident
+ * one for an error retry, background refresh or timed-out request —
+ * otherwise NULL (already settled, in flight, or no slot could be freed). */
+void* meta_cache_begin_fetch(MetaCache* c, const char* key);
+
+/* Payload awaiting a response for `key`, or NULL when the key was evicted or
+ * reset meanwhile (the response is then dropped). */
+void* meta_cache_pending(MetaCache* c, const char* key);
+
+/* Settle a pending `key`: READY when `ok`, else ERROR — unless it was a
+ * background refresh, which stays READY on its old payload. */
+void meta_cache_settle(MetaCache* c, const char* key, bool ok);
+
+/* Bumped on every insert, eviction, settle and reset. */
+unsigned meta_cache_generation(const MetaCache* c);
+
+#endif /* CYBERIA_META_CACHE_H */
@@ -0,0 +1,168 @@
+#include "msgpack_decode.h"
+
+#include <assert.h>
+#include <stdint.h>
+#include <string.h>
+
+typedef struct {
+    const uint8_t* p;
+    const uint8_t* end;
+    bool           error;
+} MpReader;
+
+/* Big-endian unsigned of `n` bytes; 0 and the error flag once past the end. */
+static uint64_t mp_uint(MpReader* r, int n) {
+    if (r->error || n > r->end - r->p) {
+        r->error = true;
+        return 0;
+    }
+    uint64_t v = 0;
+    for (int i = 0; i < n; i++) v = v << 8 | r->p[i];
+    r->p += n;
+    return v;
+}
+
+static double mp_float(MpReader* r, int n) {
+    uint64_t bits = mp_uint(r, n);
+    if (4 == n) {
+        uint32_t b32 = (uint32_t)bits;
+        float f;
+        memcpy(&f, &b32, sizeof(f));
+        return f;
+    }
+    double d;
+    memcpy(&d, &bits, sizeof(d));
+    return d;
+}
+
+/* `len` bytes at the cursor, or NULL once they run past the end. */
+static const char* mp_bytes(MpReader* r, uint64_t len) {
+    if (r->error || len > (uint64_t)(r->end - r->p)) {
+        r->error = true;
+        return NULL;
+    }
+    const char* s = (const char*)r->p;
+    r->p += len;
+    return s;
+}
+
+/* Length of the str at the cursor, consuming its header; -1 when the next
+ * value is not a str. */
+static int64_t mp_str_len(MpReader* r, uint8_t b) {
+    if (0xa0 == (b & 0xe0)) return b & 0x1f;
+    switch (b) {
+        case 0xd9: return (int64_t)mp_uint(r, 1);
+        case 0xda: return (int64_t)mp_uint(r, 2);
+        case 0xdb: return (int64_t)mp_uint(r, 4);
+        default:   return -1;
+    }
+}
+
+static cJSON* mp_value(MpReader* r, int depth);
+
+static cJSON* mp_string(MpReader* r, uint64_t len) {
+    const char* s = mp_bytes(r, len);
+    if (!s) return NULL;
+    char* copy = cJSON_malloc((size_t)len + 1);
+    cJSON* item = cJSON_CreateNull();
+    assert(copy && item);
+    memcpy(copy, s, (size_t)len);
+    copy[len]         = '\0';
+    item->type        = cJSON_String;
+    item->valuestring = copy;
+    return item;
+}
+
+static cJSON* mp_array(MpReader* r, uint64_t count, int depth) {
+    cJSON* arr = cJSON_CreateArray();
+    assert(arr);
+    for (uint64_t i = 0; i < count && !r->error; i++) {
+        cJSON* item = mp_value(r, depth + 1);
+        if (!item) break;
+        cJSON_AddItemToArray(arr, item);
+    }
+    if (!r->error) return arr;
+    cJSON_Delete(arr);
+    return NULL;
+}
+
+static cJSON* mp_map(MpReader* r, uint64_t count, int depth) {
+    cJSON* obj = cJSON_CreateObject();
+    assert(obj);
+    for (uint64_t i = 0; i < count && !r->error; i++) {
+        int64_t klen = mp_str_len(r, (uint8_t)mp_uint(r, 1));
+        const char* k = 0 <= klen && MSGPACK_MAX_KEY > klen ? mp_bytes(r, (uint64_t)klen) : NULL;
+        if (!k) {
+            r->error = true;
+            break;
+        }
+        char key[MSGPACK_MAX_KEY];
+        memcpy(key, k, (size_t)klen);
+        key[klen] = '\0';
+        cJSON* item = mp_value(r, depth + 1);
+        if (!item) break;
+        cJSON_AddItemToObject(obj, key, item);
+    }
+    if (!r->error) return obj;
+    cJSON_Delete(obj);
+    return NULL;
+}
+
+static cJSON* mp_value(MpReader* r, int depth) {
+    if (MSGPACK_MAX_DEPTH < depth) {
+        r->error = true;
+        return NULL;
+    }
+    uint8_t b = (uint8_t)mp_uint(r, 1);
+    if (r->error) return NULL;
+
+    if (0x80 > b) return cJSON_CreateNumber(b);
+    if (0xe0 <= b) return cJSON_CreateNumber((int8_t)b);
+    if (0x80 == (b & 0xf0)) return mp_map(r, b & 0x0f, depth);
+    if (0x90 == (b & 0xf0)) return mp_array(r, b & 0x0f, depth);
+    if (0xa0 == (b & 0xe0)) return mp_string(r, b & 0x1f);
+
+    switch (b) {
+        case 0xc0: return cJSON_CreateNull();
+        case 0xc2: return cJSON_CreateFalse();
+        case 0xc3: return cJSON_CreateTrue();
+        case 0xca: return cJSON_CreateNumber(mp_float(r, 4));
+        case 0xcb: return cJSON_CreateNumber(mp_float(r, 8));
+        case 0xcc: return cJSON_CreateNumber((double)mp_uint(r, 1));
+        case 0xcd: return cJSON_CreateNumber((double)mp_uint(r, 2));
+        case 0xce: return cJSON_CreateNumber((double)mp_uint(r, 4));
+        case 0xcf: return cJSON_CreateNumber((double)mp_uint(r, 8));
+        case 0xd0: return cJSON_CreateNumber((int8_t)mp_uint(r, 1));
+        case 0xd1: return cJSON_CreateNumber((int16_t)mp_uint(r, 2));
+        case 0xd2: return cJSON_CreateNumber((int32_t)mp_uint(r, 4));
+        case 0xd3: return cJSON_CreateNumber((double)(int64_t)mp_uint(r, 8));
+        case 0xd9: return mp_string(r, mp_uint(r, 1));
+        case 0xda: return mp_string(r, mp_uint(r, 2));
+        case 0xdb: return mp_string(r, mp_uint(r, 4));
+        case 0xdc: return mp_array(r, mp_uint(r, 2), depth);
+        case 0xdd: return mp_array(r, mp_uint(r, 4), depth);
+        case 0xde: return mp_map(r, mp_uint(r, 2), depth);
+        case 0xdf: return mp_map(r, mp_uint(r, 4), depth);
+        default:   /* bin, ext, never-used 0xc1 */
+            r->error = true;
+            return NULL;
+    }
+}
+
+bool msgpack_is(const void* data, size_t size) {
+    assert(data || 0 == size);
+    if (0 == size) return false;
+    uint8_t b = *(const uint8_t*)data;
+    return (0x80 <= b && 0x9f >= b) || (0xdc <= b && 0xdf >= b);
+}
+
+cJSON* msgpack_decode_tree(const void* data, size_t size) {
+    assert(data);
+    MpReader r = { .p = data, .end = (const uint8_t*)data + size };
+    cJSON* root = mp_value(&r, 0);
+    if (r.error || r.p != r.end) {
+        cJSON_Delete(root);
+        return NULL;
+    }
+    return root;
+}
@@ -0,0 +1,34 @@
+#ifndef CYBERIA_MSGPACK_DECODE_H
+#define CYBERIA_MSGPACK_DECODE_H
+
+#include <cJSON.h>
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/* MessagePack bodies from the engine REST API, decoded into the same
+ * cJSON tree the JSON document would have produced, so every metadata
+ * parser reads either encoding unchanged.
+ *
+ * engine_client asks for MessagePack first (FETCH_ACCEPT); an engine
+ * without it answers JSON, told apart by its first byte — a MessagePack
+ * document is a map or an array (0x80–0x9f, 0xdc–0xdf), which no JSON text
+ * starts with. Strings, numbers, booleans, nil, maps with string keys and
+ * arrays are supported; bin and ext values make the document malformed. */
+
+#ifndef MSGPACK_MAX_DEPTH
+#define MSGPACK_MAX_DEPTH 64
+#endif
+
+#ifndef MSGPACK_MAX_KEY
+#define MSGPACK_MAX_KEY 256
+#endif
+
+/* True when `data` starts like a MessagePack map or array. */
+bool msgpack_is(const void* data, size_t size);
+
+/* The tree, allocated through cJSON's hooks, or NULL when the document is
+ * malformed, truncated or has bytes past its end. */
+cJSON* msgpack_decode_tree(const void* data, size_t size);
+
+#endif /* CYBERIA_MSGPACK_DECODE_H */
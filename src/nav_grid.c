@@ -0,0 +1,190 @@
+#include "nav_grid.h"
+
+#include "game_state.h"
+#include "util/log.h"
+
+#include <assert.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NAV_SQRT2 1.41421356f
+
+/* blocked[] is the occupancy; the rest is A* scratch, reused across searches
+ * by stamping: a cell's g/parent are valid only when seen[c] == search. */
+static struct {
+    bool     built;
+    bool     indexed;
+    uint32_t world_revision;
+    int      w;
+    int      h;
+    uint8_t  blocked[NAV_GRID_MAX_CELLS];
+
+    uint32_t search;
+    uint32_t seen[NAV_GRID_MAX_CELLS];
+    uint32_t closed[NAV_GRID_MAX_CELLS];
+    float    g[NAV_GRID_MAX_CELLS];
+    int32_t  parent[NAV_GRID_MAX_CELLS];
+    /* Binary min-heap on f; stale duplicates are skipped when popped. */
+    int32_t  heap[NAV_GRID_MAX_CELLS];
+    float    heap_f[NAV_GRID_MAX_CELLS];
+    int      heap_n;
+} g_nav;
+
+static void grid_build(void) {
+    const GameState* gs = &g_game_state;
+    g_nav.built          = true;
+    g_nav.world_revision = gs->world_revision;
+    g_nav.w              = gs->grid_w;
+    g_nav.h              = gs->grid_h;
+    g_nav.indexed        = 0 < g_nav.w && 0 < g_nav.h && NAV_GRID_MAX_CELLS >= g_nav.w * g_nav.h;
+    if (!g_nav.indexed) {
+        LOG_WARN("[NAV] %dx%d map not indexed, predicting straight lines", g_nav.w, g_nav.h);
+        return;
+    }
+
+    memset(g_nav.blocked, 0, (size_t)(g_nav.w * g_nav.h));
+    for (int i = 0; i < gs->obstacle_count; i++) {
+        const WorldObject* o = &gs->obstacles[i];
+        int x0 = (int)floorf(o->pos.x), x1 = (int)ceilf(o->pos.x + o->dims.x);
+        int y0 = (int)floorf(o->pos.y), y1 = (int)ceilf(o->pos.y + o->dims.y);
+        if (x0 < 0) x0 = 0;
+        if (y0 < 0) y0 = 0;
+        if (x1 > g_nav.w) x1 = g_nav.w;
+        if (y1 > g_nav.h) y1 = g_nav.h;
+        for (int y = y0; y < y1; y++) {
+            memset(&g_nav.blocked[y * g_nav.w + x0], 1, (size_t)(x1 > x0 ? x1 - x0 : 0));
+        }
+    }
+}
+
+static void grid_sync(void) {
+    const GameState* gs = &g_game_state;
+    if (g_nav.built && gs->world_revision == g_nav.world_revision &&
+        gs->grid_w == g_nav.w && gs->grid_h == g_nav.h) {
+        return;
+    }
+    grid_build();
+}
+
+static bool cell_blocked(int x, int y) {
+    if (0 > x || 0 > y || g_nav.w <= x || g_nav.h <= y) return true;
+    return 0 != g_nav.blocked[y * g_nav.w + x];
+}
+
+bool nav_grid_blocked(int x, int y) {
+    grid_sync();
+    if (!g_nav.indexed) return false;
+    return cell_blocked(x, y);
+}
+
+static bool heap_push(int cell, float f) {
+    if (NAV_GRID_MAX_CELLS == g_nav.heap_n) return false;
+    int i = g_nav.heap_n++;
+    while (0 < i) {
+        int up = (i - 1) / 2;
+        if (g_nav.heap_f[up] <= f) break;
+        g_nav.heap[i]   = g_nav.heap[up];
+        g_nav.heap_f[i] = g_nav.heap_f[up];
+        i = up;
+    }
+    g_nav.heap[i]   = cell;
+    g_nav.heap_f[i] = f;
+    return true;
+}
+
+static int heap_pop(void) {
+    assert(0 < g_nav.heap_n);
+    int top = g_nav.heap[0];
+    int n = --g_nav.heap_n;
+    int last = g_nav.heap[n];
+    float last_f = g_nav.heap_f[n];
+    int i = 0;
+    for (;;) {
+        int child = 2 * i + 1;
+        if (child >= n) break;
+        if (child + 1 < n && g_nav.heap_f[child + 1] < g_nav.heap_f[child]) child++;
+        if (last_f <= g_nav.heap_f[child]) break;
+        g_nav.heap[i]   = g_nav.heap[child];
+        g_nav.heap_f[i] = g_nav.heap_f[child];
+        i = child;
+    }
+    g_nav.heap[i]   = last;
+    g_nav.heap_f[i] = last_f;
+    return top;
+}
+
+/* Octile distance: the exact cost of an unobstructed 8-connected walk. */
+static float heuristic(int x, int y, int gx, int gy) {
+    int dx = abs(x - gx), dy = abs(y - gy);
+    int lo = dx < dy ? dx : dy;
+    return (float)(dx + dy) + (NAV_SQRT2 - 2.0f) * (float)lo;
+}
+
+static int write_path(int goal, int start, Vector2* out, int max) {
+    int len = 0;
+    for (int c = goal; c != start; c = g_nav.parent[c]) len++;
+    int skip = len > max ? len - max : 0;
+    int n = len - skip;
+    int i = len;
+    for (int c = goal; c != start; c = g_nav.parent[c]) {
+        i--;
+        if (i < n) out[i] = (Vector2){ (float)(c % g_nav.w), (float)(c / g_nav.w) };
+    }
+    return n;
+}
+
+int nav_grid_find_path(Vector2 from, Vector2 to, Vector2* out, int max) {
+    assert(out && 0 < max);
+    grid_sync();
+    if (!g_nav.indexed) return -1;
+
+    int sx = (int)floorf(from.x), sy = (int)floorf(from.y);
+    int gx = (int)floorf(to.x),   gy = (int)floorf(to.y);
+    if (cell_blocked(gx, gy)) return -1;
+    if (sx == gx && sy == gy) return 0;
+    if (0 > sx || 0 > sy || g_nav.w <= sx || g_nav.h <= sy) return -1;
+
+    /* Stamps wrap after 2^32 searches; clear them rather than alias. */
+    if (0 == ++g_nav.search) {
+        memset(g_nav.seen, 0, sizeof(g_nav.seen));
+        memset(g_nav.closed, 0, sizeof(g_nav.closed));
+        g_nav.search = 1;
+    }
+    uint32_t stamp = g_nav.search;
+    int start = sy * g_nav.w + sx, goal = gy * g_nav.w + gx;
+    g_nav.heap_n        = 0;
+    g_nav.seen[start]   = stamp;
+    g_nav.g[start]      = 0.0f;
+    g_nav.parent[start] = start;
+    heap_push(start, heuristic(sx, sy, gx, gy));
+
+    for (int expansions = 0; 0 < g_nav.heap_n && NAV_GRID_MAX_EXPANSIONS > expansions;) {
+        int c = heap_pop();
+        if (stamp == g_nav.closed[c]) continue;
+        if (c == goal) return write_path(goal, start, out, max);
+        g_nav.closed[c] = stamp;
+        expansions++;
+
+        int cx = c % g_nav.w, cy = c / g_nav.w;
+        for (int dy = -1; dy <= 1; dy++) {
+            for (int dx = -1; dx <= 1; dx++) {
+                if (0 == dx && 0 == dy) continue;
+                int nx = cx + dx, ny = cy + dy;
+                if (cell_blocked(nx, ny)) continue;
+                /* Diagonals may not squeeze past a blocked corner. */
+                if (dx && dy && (cell_blocked(cx + dx, cy) || cell_blocked(cx, cy + dy))) continue;
+                int n = ny * g_nav.w + nx;
+                if (stamp == g_nav.closed[n]) continue;
+                float g = g_nav.g[c] + ((dx && dy) ? NAV_SQRT2 : 1.0f);
+                if (stamp == g_nav.seen[n] && g_nav.g[n] <= g) continue;
+                g_nav.seen[n]   = stamp;
+                g_nav.g[n]      = g;
+                g_nav.parent[n] = c;
+                if (!heap_push(n, g + heuristic(nx, ny, gx, gy))) return -1;
+            }
+        }
+    }
+    return -1;
+}
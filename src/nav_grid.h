@@ -0,0 +1,34 @@
+#ifndef NAV_GRID_H
+#define NAV_GRID_H
+
+#include <raylib.h>
+#include <stdbool.h>
+
+/* Occupancy grid over the instance's obstacles plus an A* path planner, so
+ * client-side prediction walks the route the server plans instead of a
+ * straight line through walls.
+ *
+ * A cell is blocked when any obstacle rectangle overlaps it. The grid is
+ * rebuilt lazily on the first query after the world objects change
+ * (GameState.world_revision), i.e. after a full frame. Paths are 8-connected
+ * over whole cells, never cutting a blocked corner, and come back as the
+ * cells to walk through in order, ending on the goal cell — the shape of the
+ * server's `path` array.
+ *
+ * Maps larger than NAV_GRID_MAX_CELLS are not indexed; queries then report
+ * no obstacles, which leaves prediction on straight lines. */
+
+#define NAV_GRID_MAX_CELLS      65536   /* 256 × 256 */
+/* Node expansions one search may spend before giving up. */
+#define NAV_GRID_MAX_EXPANSIONS 8192
+
+/* Whether cell (x, y) is off the map or covered by an obstacle. */
+bool nav_grid_blocked(int x, int y);
+
+/* Plan from the cell holding `from` to the cell holding `to`. Writes up to
+ * `max` cells (excluding the start cell) to `out` and returns the count;
+ * 0 when start and goal share a cell. Returns -1 when no route exists, the
+ * goal is blocked, or the search ran out of budget. */
+int nav_grid_find_path(Vector2 from, Vector2 to, Vector2* out, int max);
+
+#endif /* NAV_GRID_H */
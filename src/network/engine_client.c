@@ -1,21 +1,65 @@
 #include "engine_client.h"
 
+#include <emscripten/emscripten.h>
 #include <emscripten/fetch.h>
 
 #include <assert.h>
 #include <stdbool.h>
 #include <stdlib.h>
 #include <string.h>
+#include <strings.h>
 #include <stdio.h>
 
+#include "asset_pack.h"
 #include "config.h"
+#include "heap_memory.h"
+#include "network/session_recorder.h"
+#include "profiler.h"
 #include "runtime_config.h"
+#include "startup_trace.h"
+#include "util/log.h"
 
-typedef struct {
-    char*            asset_id;
-    FetchCompletedCb on_completed;
+/* Namespace of persisted responses in emscripten's IndexedDB store. */
+#define FETCH_PERSIST_PREFIX "cyberia-cache"
+
+/* Longest ETag kept as a validator; longer ones are not revalidated. */
+#define FETCH_ETAG_MAX 128
+
+/* One requester of a start_fetch request. Requests for the same URL and
+ * persistence key while one is live share it: the first (the primary,
+ * whose context rides on the QueuedFetch) holds the rest in `joiners` and
+ * sits on s_live until it settles, and every waiter is lent the same
+ * body. */
+typedef struct FetchContext {
+    char*                asset_id;
+    FetchCompletedCb     on_completed;
+    int                  trace;     /* startup_trace slot, or -1 */
+    struct FetchContext* next;      /* joiners: the next one; primary: next live */
+    /* Primary only. */
+    char*                key;       /* target URL + persistence key */
+    struct QueuedFetch*  owner;     /* outlives the context */
+    struct FetchContext* joiners;
 } FetchContext;
 
+static FetchContext* s_live = NULL;
+
+static FetchContext* live_find(const char* key) {
+    for (FetchContext* c = s_live; c; c = c->next) {
+        if (0 == strcmp(c->key, key)) return c;
+    }
+    return NULL;
+}
+
+static void live_remove(FetchContext* ctx) {
+    for (FetchContext** link = &s_live; *link; link = &(*link)->next) {
+        if (*link != ctx) continue;
+        *link = ctx->next;
+        break;
+    }
+    heap_free(ctx->key);
+    ctx->key = NULL;
+}
+
 static int  s_pending_count = 0;
 static int  s_total_started = 0;
 static char s_last_completed[96] = {0};
@@ -24,79 +68,920 @@ int fetch_pending_count(void) { return s_pending_count; }
 int fetch_total_started(void) { return s_total_started; }
 const char* fetch_last_completed_id(void) { return s_last_completed; }
 
+static void note_last_completed(const char* asset_id) {
+    strncpy(s_last_completed, asset_id, sizeof(s_last_completed) - 1);
+    s_last_completed[sizeof(s_last_completed) - 1] = '\0';
+}
+
 static void note_completed(const char* asset_id) {
     s_pending_count--;
-    if (asset_id) {
-        strncpy(s_last_completed, asset_id, sizeof(s_last_completed) - 1);
-        s_last_completed[sizeof(s_last_completed) - 1] = '\0';
-    }
+    PROFILE_COUNT(PROF_COUNT_FETCHES, 1);
+    if (asset_id) note_last_completed(asset_id);
 }
 
-static void on_fetch_success(emscripten_fetch_t* f) {
-    FetchContext* ctx = f->userData;
+/* Lend `size` bytes (none: failed) to one requester, then free its
+ * context. */
+static void answer_one(FetchContext* ctx, const void* data, size_t size) {
     note_completed(ctx->asset_id);
 
-    void*  buf = NULL;
-    size_t sz  = 0;
-    bool   ok  = f->numBytes > 0;
-
-    if (ok) {
-        sz = (size_t)f->numBytes;
-        buf = malloc(sz);
-        memcpy(buf, f->data, sz);
-    }
-
     FetchResponse response = (FetchResponse){
-        .success  = ok,
-        .data     = ok ? buf : NULL,
-        .size     = ok ? sz  : 0,
+        .success  = 0 < size,
+        .data     = 0 < size ? data : NULL,
+        .size     = size,
         .asset_id = ctx->asset_id,
     };
+    if (0 < size) session_recorder_on_fetch(ctx->asset_id, data, size);
+    startup_trace_fetch_end(ctx->trace, size, 0 < size);
     ctx->on_completed(&response);
 
-    free(ctx->asset_id);
-    free(ctx);
+    heap_free(ctx->asset_id);
+    heap_free(ctx);
+}
+
+/* Answer the primary and every joiner from the one body. Off s_live
+ * first, so a callback asking for the URL again starts a new request. */
+static void answer(FetchContext* ctx, const void* data, size_t size) {
+    live_remove(ctx);
+    FetchContext* joiners = ctx->joiners;
+    answer_one(ctx, data, size);
+    while (joiners) {
+        FetchContext* next = joiners->next;
+        answer_one(joiners, data, size);
+        joiners = next;
+    }
+}
+
+/* The fetch buffer is lent; emscripten_fetch_close releases it after. */
+static void on_fetch_success(emscripten_fetch_t* f) {
+    answer(f->userData, f->data, f->numBytes > 0 ? (size_t)f->numBytes : 0);
     emscripten_fetch_close(f);
 }
 
 static void on_fetch_error(emscripten_fetch_t* f) {
-    FetchContext* ctx = f->userData;
-    note_completed(ctx->asset_id);
+    answer(f->userData, NULL, 0);
+    emscripten_fetch_close(f);
+}
 
-    FetchResponse response = (FetchResponse){
-        .success  = false,
-        .data     = NULL,
-        .size     = 0,
-        .asset_id = ctx->asset_id,
+// ============================================================================
+// Scheduler
+// ============================================================================
+
+/* A network request waiting for (or holding) one of the FETCH_MAX_IN_FLIGHT
+ * slots. The owner's callbacks and context ride along; they see
+ * f->userData == user as if they had started the fetch themselves. */
+typedef struct QueuedFetch {
+    struct QueuedFetch* next;
+    FetchClass          cls;
+    char*               asset_id;     /* for fetch_cancel(); NULL: not cancellable */
+    char*               target_url;
+    char*               store_path;   /* PERSIST_FILE key, or NULL */
+    char*               pack_path;    /* URL to look up in the boot pack, or NULL */
+    void              (*onsuccess)(emscripten_fetch_t* f);
+    void              (*onerror)(emscripten_fetch_t* f);
+    void              (*oncancel)(void* user);
+    void*               user;
+    int                 trace;        /* startup_trace slot, or -1 */
+    bool                single_shot;  /* no timeout, no retry: the boot pack */
+    int                 attempts;     /* failed tries so far */
+    double              retry_at;     /* emscripten_get_now() of the next, backing off */
+    /* Revalidation (start_fetch requests only: user is a FetchContext). */
+    char*               record_path;  /* ETag + body record key, or NULL */
+    char*               etag;         /* sent as If-None-Match, or NULL */
+    void*               cached;       /* the body stored under etag */
+    size_t              cached_size;
+    const char*         headers[5];
+} QueuedFetch;
+
+static const unsigned long s_timeout_ms[FETCH_CLASS_COUNT] = FETCH_TIMEOUT_MS;
+
+static struct {
+    QueuedFetch*    head[FETCH_CLASS_COUNT];
+    QueuedFetch*    tail[FETCH_CLASS_COUNT];
+    QueuedFetch*    backoff;          /* failed, waiting for retry_at */
+    int             in_flight;
+    FetchClassStats stats[FETCH_CLASS_COUNT];
+} s_sched;
+
+static void free_queued(QueuedFetch* q) {
+    heap_free(q->asset_id);
+    heap_free(q->target_url);
+    heap_free(q->store_path);
+    heap_free(q->pack_path);
+    heap_free(q->record_path);
+    heap_free(q->etag);
+    heap_free(q->cached);
+    heap_free(q);
+}
+
+static void push_back(QueuedFetch** list, QueuedFetch* q) {
+    q->next = NULL;
+    while (*list) list = &(*list)->next;
+    *list = q;
+}
+
+/* Write `size` bytes under `path` in the store PERSIST_FILE reads from. */
+static void idb_store(const char* path, const void* data, size_t size);
+
+static void dispatch(QueuedFetch* q);
+static void schedule(QueuedFetch* q);
+
+static void pump_queue(void) {
+    for (int c = 0; c < FETCH_CLASS_COUNT && FETCH_MAX_IN_FLIGHT > s_sched.in_flight; c++) {
+        while (s_sched.head[c] && FETCH_MAX_IN_FLIGHT > s_sched.in_flight) {
+            QueuedFetch* q = s_sched.head[c];
+            s_sched.head[c] = q->next;
+            if (!s_sched.head[c]) s_sched.tail[c] = NULL;
+            s_sched.stats[c].queued--;
+            dispatch(q);
+        }
+    }
+}
+
+/* Worth another try: no response at all (network, timeout) or one that
+ * says to come back later. */
+static bool transient(const emscripten_fetch_t* f) {
+    return 0 == f->status || 408 == f->status || 429 == f->status || 500 <= f->status;
+}
+
+static void back_off(QueuedFetch* q, int status) {
+    double delay = FETCH_RETRY_BASE_MS * (double)(1u << q->attempts);
+    if (FETCH_RETRY_CAP_MS < delay) delay = FETCH_RETRY_CAP_MS;
+    delay *= 0.5 + 0.5 * (double)rand() / (double)RAND_MAX;
+    q->attempts++;
+    q->retry_at = emscripten_get_now() + delay;
+    s_sched.stats[q->cls].retried++;
+    s_sched.stats[q->cls].queued++;
+    push_back(&s_sched.backoff, q);
+    LOG_WARN("[FETCH] %s: status %d, retry %d/%d in %.0f ms", q->target_url, status,
+             q->attempts, FETCH_RETRY_MAX, delay);
+}
+
+static void release_backoffs(void) {
+    double now = emscripten_get_now();
+    QueuedFetch** link = &s_sched.backoff;
+    while (*link) {
+        QueuedFetch* q = *link;
+        if (now < q->retry_at) {
+            link = &q->next;
+            continue;
+        }
+        *link = q->next;
+        s_sched.stats[q->cls].queued--;
+        schedule(q);
+    }
+}
+
+/* The ETag response header into `out`; false without a usable one. */
+static bool response_etag(emscripten_fetch_t* f, char* out, size_t out_sz) {
+    size_t len = emscripten_fetch_get_response_headers_length(f);
+    if (0 == len) return false;
+    char* headers = heap_malloc(HEAP_MEM_FETCH, len + 1);
+    assert(headers);
+    emscripten_fetch_get_response_headers(f, headers, len + 1);
+    headers[len] = '\0';
+
+    bool found = false;
+    for (const char* line = headers; *line && !found; ) {
+        const char* end = strchr(line, '\n');
+        if (!end) end = line + strlen(line);
+        if (0 == strncasecmp(line, "etag:", 5)) {
+            const char* v = line + 5;
+            while (' ' == *v) v++;
+            size_t n = (size_t)(end - v);
+            while (0 < n && ('\r' == v[n - 1] || ' ' == v[n - 1])) n--;
+            if (0 < n && n < out_sz) {
+                memcpy(out, v, n);
+                out[n] = '\0';
+                found = true;
+            }
+        }
+        line = *end ? end + 1 : end;
+    }
+    heap_free(headers);
+    return found;
+}
+
+/* Keep a revalidatable response as one record, ETag '\0' body, so the
+ * validator can never outlive or predate the body it stands for. */
+static void store_record(const QueuedFetch* q, emscripten_fetch_t* f) {
+    char etag[FETCH_ETAG_MAX];
+    if (0 >= f->numBytes || !response_etag(f, etag, sizeof(etag))) return;
+    if (q->etag && 0 == strcmp(q->etag, etag)) return;
+
+    size_t tag_size = strlen(etag) + 1;
+    size_t size     = tag_size + (size_t)f->numBytes;
+    char*  record   = heap_malloc(HEAP_MEM_FETCH, size);
+    assert(record);
+    memcpy(record, etag, tag_size);
+    memcpy(record + tag_size, f->data, (size_t)f->numBytes);
+    idb_store(q->record_path, record, size);
+    heap_free(record);
+}
+
+static void settle(emscripten_fetch_t* f, bool ok) {
+    QueuedFetch* q = f->userData;
+    s_sched.in_flight--;
+    s_sched.stats[q->cls].in_flight--;
+
+    /* Not Modified: the stored copy is still current. */
+    if (q->cached && 304 == f->status) {
+        emscripten_fetch_close(f);
+        s_sched.stats[q->cls].completed++;
+        s_sched.stats[q->cls].revalidated++;
+        answer(q->user, q->cached, q->cached_size);
+        free_queued(q);
+        pump_queue();
+        return;
+    }
+    if (!ok && !q->single_shot && FETCH_RETRY_MAX > q->attempts && transient(f)) {
+        int status = (int)f->status;
+        emscripten_fetch_close(f);
+        back_off(q, status);
+        pump_queue();
+        return;
+    }
+    if (ok && q->record_path) store_record(q, f);
+
+    f->userData = q->user;
+    if (ok) s_sched.stats[q->cls].completed++;
+    else    s_sched.stats[q->cls].failed++;
+    (ok ? q->onsuccess : q->onerror)(f);   /* closes f */
+    free_queued(q);
+    pump_queue();
+}
+
+static void on_sched_success(emscripten_fetch_t* f) { settle(f, true); }
+static void on_sched_error(emscripten_fetch_t* f)   { settle(f, false); }
+
+static void dispatch(QueuedFetch* q) {
+    startup_trace_fetch_dispatched(q->trace);
+    s_sched.in_flight++;
+    s_sched.stats[q->cls].in_flight++;
+
+    emscripten_fetch_attr_t attr;
+    emscripten_fetch_attr_init(&attr);
+    strcpy(attr.requestMethod, "GET");
+    attr.attributes = EMSCRIPTEN_FETCH_LOAD_TO_MEMORY;
+    attr.onsuccess  = on_sched_success;
+    attr.onerror    = on_sched_error;
+    attr.userData   = q;
+    if (!q->single_shot) attr.timeoutMSecs = s_timeout_ms[q->cls];
+    q->headers[0] = "Accept";
+    q->headers[1] = FETCH_ACCEPT;
+    q->headers[2] = q->etag ? "If-None-Match" : NULL;
+    q->headers[3] = q->etag;
+    q->headers[4] = NULL;
+    attr.requestHeaders = q->headers;
+    /* PERSIST_FILE looks in IndexedDB first and only goes to the network
+     * on a miss, storing what it downloads. */
+    if (q->store_path) {
+        attr.attributes     |= EMSCRIPTEN_FETCH_PERSIST_FILE;
+        attr.destinationPath = q->store_path;
+    }
+    emscripten_fetch(&attr, q->target_url);
+}
+
+static void schedule(QueuedFetch* q) {
+    assert(0 <= q->cls && FETCH_CLASS_COUNT > q->cls);
+    q->next = NULL;
+    if (s_sched.tail[q->cls]) s_sched.tail[q->cls]->next = q;
+    else                      s_sched.head[q->cls] = q;
+    s_sched.tail[q->cls] = q;
+    s_sched.stats[q->cls].queued++;
+    pump_queue();
+}
+
+// ============================================================================
+// Boot asset pack
+// ============================================================================
+
+/* While the pack is downloading, requests in its scope are parked instead
+ * of scheduled; once it settles each one is answered from the pack or sent
+ * to the network as usual. Pack answers wait in `hits` until the next
+ * fetch_batch_pump(), so a callback never runs inside the call that asked.
+ * Both lists count as `queued` in the class stats. */
+typedef enum { PACK_NONE, PACK_LOADING, PACK_READY } PackState;
+
+static struct {
+    PackState           state;
+    emscripten_fetch_t* fetch;   /* kept open: the pack lives in its buffer */
+    AssetPack           pack;
+    QueuedFetch*        parked;
+    QueuedFetch*        hits;
+    int                 trace;
+} s_pack;
+
+static bool pack_has(const char* url) {
+    return PACK_READY == s_pack.state && asset_pack_find(&s_pack.pack, url, NULL);
+}
+
+/* True when the pack takes over `q` (a plain start_fetch request). */
+static bool pack_route(QueuedFetch* q, const char* url) {
+    bool in_scope = 0 == strncmp(url, ASSET_PACK_SCOPE, strlen(ASSET_PACK_SCOPE));
+    if (!in_scope || (PACK_LOADING != s_pack.state && !pack_has(url))) return false;
+    q->pack_path = heap_strdup(HEAP_MEM_FETCH, url);
+    s_sched.stats[q->cls].queued++;
+    push_back(PACK_LOADING == s_pack.state ? &s_pack.parked : &s_pack.hits, q);
+    return true;
+}
+
+static void release_parked(void) {
+    QueuedFetch* q = s_pack.parked;
+    s_pack.parked = NULL;
+    while (q) {
+        QueuedFetch* next = q->next;
+        if (pack_has(q->pack_path)) {
+            push_back(&s_pack.hits, q);
+        } else {
+            s_sched.stats[q->cls].queued--;
+            schedule(q);
+        }
+        q = next;
+    }
+}
+
+/* Answer pack hits the way on_fetch_success answers a download. */
+static void deliver_pack_hits(void) {
+    while (s_pack.hits) {
+        QueuedFetch* q = s_pack.hits;
+        s_pack.hits = q->next;
+        FetchContext* ctx = q->user;
+        size_t size = 0;
+        const void* data = asset_pack_find(&s_pack.pack, q->pack_path, &size);
+        s_sched.stats[q->cls].queued--;
+        s_sched.stats[q->cls].completed++;
+        startup_trace_fetch_dispatched(ctx->trace);
+        answer(ctx, data, size);
+        free_queued(q);
+    }
+}
+
+static void on_pack_settled(emscripten_fetch_t* f, bool ok) {
+    s_pending_count--;
+    size_t size = ok ? (size_t)f->numBytes : 0;
+    if (0 < size && asset_pack_open(&s_pack.pack, f->data, size)) {
+        s_pack.state = PACK_READY;
+        s_pack.fetch = f;
+        LOG_INFO("[FETCH] boot pack: %u files, %zu bytes", s_pack.pack.count, size);
+    } else {
+        s_pack.state = PACK_NONE;
+        emscripten_fetch_close(f);
+        LOG_WARN("[FETCH] boot pack unavailable, fetching its files one by one");
+    }
+    startup_trace_fetch_end(s_pack.trace, size, PACK_READY == s_pack.state);
+    release_parked();
+}
+
+static void on_pack_success(emscripten_fetch_t* f) { on_pack_settled(f, true); }
+static void on_pack_error(emscripten_fetch_t* f)   { on_pack_settled(f, false); }
+
+static char* target_url_for(const char* url);
+
+void fetch_asset_pack_load(const char* url) {
+    assert(url);
+    if (PACK_NONE != s_pack.state) return;
+    s_pack.state = PACK_LOADING;
+    s_pack.trace = startup_trace_fetch_begin("asset-pack", STARTUP_FETCH_SINGLE, FETCH_CLASS_VISIBLE);
+    s_pending_count++;
+    s_total_started++;
+
+    QueuedFetch* q = heap_malloc(HEAP_MEM_FETCH, sizeof(QueuedFetch));
+    assert(q);
+    *q = (QueuedFetch){
+        .cls         = FETCH_CLASS_VISIBLE,
+        .target_url  = target_url_for(url),
+        .onsuccess   = on_pack_success,
+        .onerror     = on_pack_error,
+        .trace       = s_pack.trace,
+        /* Large, and everything in it also exists one file at a time. */
+        .single_shot = true,
     };
-    ctx->on_completed(&response);
+    schedule(q);
+}
+
+static char* target_url_for(const char* url) {
+    char target_url[1024];
+    snprintf(target_url, sizeof(target_url), "%s%s", runtime_config_api_base_url(), url);
+    return heap_strdup(HEAP_MEM_FETCH, target_url);
+}
+
+static void on_fetch_cancelled(void* user) {
+    FetchContext* ctx = user;
+    live_remove(ctx);
+    s_pending_count--;
+    startup_trace_fetch_end(ctx->trace, 0, false);
+    heap_free(ctx->asset_id);
+    heap_free(ctx);
+}
+
+static void cancel_waiter(FetchContext* w, FetchClass cls) {
+    s_pending_count--;
+    s_sched.stats[cls].cancelled++;
+    startup_trace_fetch_end(w->trace, 0, false);
+    heap_free(w->asset_id);
+    heap_free(w);
+}
+
+/* Drop one waiter of a shared request and leave the request to the rest:
+ * a joiner is unlinked; a primary hands its place (and its QueuedFetch's
+ * asset_id) to its first joiner. False when `asset_id` waits on no request
+ * with joiners. */
+static bool cancel_shared(const char* asset_id) {
+    for (FetchContext* p = s_live; p; p = p->next) {
+        if (!p->joiners) continue;
+        QueuedFetch* q = p->owner;
+        if (0 == strcmp(p->asset_id, asset_id)) {
+            FetchContext* heir = p->joiners;
+            char* asset   = p->asset_id;
+            int   trace   = p->trace;
+            p->asset_id     = heir->asset_id;
+            p->on_completed = heir->on_completed;
+            p->trace        = heir->trace;
+            p->joiners      = heir->next;
+            heir->asset_id  = asset;
+            heir->trace     = trace;
+            cancel_waiter(heir, q->cls);
+            heap_free(q->asset_id);
+            q->asset_id = heap_strdup(HEAP_MEM_FETCH, p->asset_id);
+            q->trace    = p->trace;
+            return true;
+        }
+        for (FetchContext** link = &p->joiners; *link; link = &(*link)->next) {
+            FetchContext* j = *link;
+            if (0 != strcmp(j->asset_id, asset_id)) continue;
+            *link = j->next;
+            cancel_waiter(j, q->cls);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool fetch_cancel(const char* asset_id) {
+    assert(asset_id);
+    if (cancel_shared(asset_id)) return true;
+    for (int c = 0; c < FETCH_CLASS_COUNT; c++) {
+        QueuedFetch* prev = NULL;
+        for (QueuedFetch* q = s_sched.head[c]; q; prev = q, q = q->next) {
+            if (!q->asset_id || 0 != strcmp(q->asset_id, asset_id)) continue;
+            if (prev) prev->next = q->next;
+            else      s_sched.head[c] = q->next;
+            if (s_sched.tail[c] == q) s_sched.tail[c] = prev;
+            s_sched.stats[c].queued--;
+            s_sched.stats[c].cancelled++;
+            q->oncancel(q->user);
+            free_queued(q);
+            return true;
+        }
+    }
+    for (QueuedFetch** link = &s_sched.backoff; *link; link = &(*link)->next) {
+        QueuedFetch* q = *link;
+        if (!q->asset_id || 0 != strcmp(q->asset_id, asset_id)) continue;
+        *link = q->next;
+        s_sched.stats[q->cls].queued--;
+        s_sched.stats[q->cls].cancelled++;
+        q->oncancel(q->user);
+        free_queued(q);
+        return true;
+    }
+    return false;
+}
+
+bool fetch_reprioritize(const char* asset_id, FetchClass cls) {
+    assert(asset_id);
+    assert(0 <= cls && FETCH_CLASS_COUNT > cls);
+    /* A joiner moves the shared request, but only ever up. */
+    for (FetchContext* p = s_live; p; p = p->next) {
+        for (FetchContext* j = p->joiners; j; j = j->next) {
+            if (0 != strcmp(j->asset_id, asset_id)) continue;
+            return cls < p->owner->cls ? fetch_reprioritize(p->asset_id, cls) : true;
+        }
+    }
+    for (int c = 0; c < FETCH_CLASS_COUNT; c++) {
+        QueuedFetch* prev = NULL;
+        for (QueuedFetch* q = s_sched.head[c]; q; prev = q, q = q->next) {
+            if (!q->asset_id || 0 != strcmp(q->asset_id, asset_id)) continue;
+            if (c == (int)cls) return true;
+            if (prev) prev->next = q->next;
+            else      s_sched.head[c] = q->next;
+            if (s_sched.tail[c] == q) s_sched.tail[c] = prev;
+            s_sched.stats[c].queued--;
+            q->cls = cls;
+            schedule(q);
+            return true;
+        }
+    }
+    /* Backing off: keeps its retry time, retries in the new class. */
+    for (QueuedFetch* q = s_sched.backoff; q; q = q->next) {
+        if (!q->asset_id || 0 != strcmp(q->asset_id, asset_id)) continue;
+        s_sched.stats[q->cls].queued--;
+        s_sched.stats[cls].queued++;
+        q->cls = cls;
+        return true;
+    }
+    return false;
+}
+
+FetchClassStats fetch_class_stats(FetchClass cls) {
+    assert(0 <= cls && FETCH_CLASS_COUNT > cls);
+    return s_sched.stats[cls];
+}
+
+/* A stored ETag record: revalidate against it. */
+static void on_record_loaded(emscripten_fetch_t* f) {
+    QueuedFetch* q    = f->userData;
+    const char*  rec  = f->data;
+    size_t       size = f->numBytes > 0 ? (size_t)f->numBytes : 0;
+    const char*  sep  = 0 < size ? memchr(rec, '\0', size) : NULL;
+    if (sep && rec < sep && (size_t)(sep - rec) < FETCH_ETAG_MAX && sep + 1 < rec + size) {
+        q->etag        = heap_strdup(HEAP_MEM_FETCH, rec);
+        q->cached_size = size - (size_t)(sep + 1 - rec);
+        q->cached      = heap_malloc(HEAP_MEM_FETCH, q->cached_size);
+        assert(q->cached);
+        memcpy(q->cached, sep + 1, q->cached_size);
+    }
+    emscripten_fetch_close(f);
+    schedule(q);
+}
 
-    free(ctx->asset_id);
-    free(ctx);
+static void on_record_missing(emscripten_fetch_t* f) {
+    QueuedFetch* q = f->userData;
     emscripten_fetch_close(f);
+    schedule(q);
 }
 
-void fetch_request_start(const char* asset_id, const char* url, FetchCompletedCb on_completed) {
+/* Look for `q`'s record locally, then schedule it — conditional on a hit.
+ * Local only, so it skips the scheduler's network slots. */
+static void load_record(QueuedFetch* q) {
+    emscripten_fetch_attr_t attr;
+    emscripten_fetch_attr_init(&attr);
+    strcpy(attr.requestMethod, "GET");
+    attr.attributes      = EMSCRIPTEN_FETCH_LOAD_TO_MEMORY | EMSCRIPTEN_FETCH_PERSIST_FILE |
+                           EMSCRIPTEN_FETCH_NO_DOWNLOAD;
+    attr.destinationPath = q->record_path;
+    attr.onsuccess       = on_record_loaded;
+    attr.onerror         = on_record_missing;
+    attr.userData        = q;
+    emscripten_fetch(&attr, q->target_url);
+}
+
+/* `store_path` non-NULL: serve from / persist to IndexedDB under that key.
+ * `record_path` non-NULL: revalidate an ETag record kept under that key. */
+static void start_fetch(const char* asset_id, const char* url, const char* store_path,
+                        const char* record_path, FetchClass cls, FetchCompletedCb on_completed) {
     assert(asset_id);
     assert(url);
     assert(on_completed);
 
-    FetchContext* ctx = malloc(sizeof(FetchContext));
-    ctx->asset_id     = strdup(asset_id);
-    ctx->on_completed = on_completed;
+    char* target_url = target_url_for(url);
+    char  key[2048];
+    snprintf(key, sizeof(key), "%s|%s|%s", target_url,
+             store_path ? store_path : "", record_path ? record_path : "");
+
+    FetchContext* ctx = heap_malloc(HEAP_MEM_FETCH, sizeof(FetchContext));
+    assert(ctx);
+    *ctx = (FetchContext){
+        .asset_id     = heap_strdup(HEAP_MEM_FETCH, asset_id),
+        .on_completed = on_completed,
+        .trace        = startup_trace_fetch_begin(asset_id, STARTUP_FETCH_SINGLE, cls),
+    };
     s_pending_count++;
     s_total_started++;
 
+    /* Already on its way: wait on that request, moving it up if we are the
+     * more urgent caller. */
+    FetchContext* primary = live_find(key);
+    if (primary) {
+        heap_free(target_url);
+        FetchContext** tail = &primary->joiners;
+        while (*tail) tail = &(*tail)->next;
+        *tail = ctx;
+        s_sched.stats[cls].deduplicated++;
+        if (cls < primary->owner->cls) fetch_reprioritize(primary->asset_id, cls);
+        return;
+    }
+
+    QueuedFetch* q = heap_malloc(HEAP_MEM_FETCH, sizeof(QueuedFetch));
+    assert(q);
+    *q = (QueuedFetch){
+        .cls         = cls,
+        .asset_id    = heap_strdup(HEAP_MEM_FETCH, asset_id),
+        .target_url  = target_url,
+        .store_path  = store_path ? heap_strdup(HEAP_MEM_FETCH, store_path) : NULL,
+        .record_path = record_path ? heap_strdup(HEAP_MEM_FETCH, record_path) : NULL,
+        .onsuccess   = on_fetch_success,
+        .onerror     = on_fetch_error,
+        .oncancel    = on_fetch_cancelled,
+        .user        = ctx,
+        .trace       = ctx->trace,
+    };
+    ctx->key   = heap_strdup(HEAP_MEM_FETCH, key);
+    ctx->owner = q;
+    ctx->next  = s_live;
+    s_live     = ctx;
+    if (pack_route(q, url)) return;
+    if (q->record_path) {
+        load_record(q);
+        return;
+    }
+    schedule(q);
+}
+
+void fetch_request_start(const char* asset_id, const char* url, FetchClass cls,
+                         FetchCompletedCb on_completed) {
+    start_fetch(asset_id, url, NULL, NULL, cls, on_completed);
+}
+
+static bool has_version(const char* version) {
+    return version && '\0' != version[0];
+}
+
+static void persist_path(const char* url, const char* version, char* out, size_t out_sz) {
+    snprintf(out, out_sz, "%s%s@%s", FETCH_PERSIST_PREFIX, url, version);
+}
+
+void fetch_request_start_persistent(const char* asset_id, const char* url, const char* version,
+                                    FetchClass cls, FetchCompletedCb on_completed) {
+    char path[1024];
+    if (!has_version(version)) {
+        snprintf(path, sizeof(path), "%s%s#etag", FETCH_PERSIST_PREFIX, url);
+        start_fetch(asset_id, url, NULL, path, cls, on_completed);
+        return;
+    }
+    persist_path(url, version, path, sizeof(path));
+    start_fetch(asset_id, url, path, NULL, cls, on_completed);
+}
+
+static void on_store_done(emscripten_fetch_t* f) {
+    emscripten_fetch_close(f);
+}
+
+void fetch_persist_store(const char* url, const char* version, const void* data, size_t size) {
+    assert(url);
+    assert(data);
+    if (!has_version(version)) return;
+
+    char store_path[1024];
+    persist_path(url, version, store_path, sizeof(store_path));
+    idb_store(store_path, data, size);
+}
+
+static void idb_store(const char* path, const void* data, size_t size) {
+    /* EM_IDB_STORE writes requestData under the given path in the same
+     * store PERSIST_FILE reads from; the bytes are copied synchronously. */
     emscripten_fetch_attr_t attr;
     emscripten_fetch_attr_init(&attr);
-    strcpy(attr.requestMethod, "GET");
-    attr.attributes = EMSCRIPTEN_FETCH_LOAD_TO_MEMORY;
-    attr.onsuccess  = on_fetch_success;
-    attr.onerror    = on_fetch_error;
-    attr.userData   = ctx;
+    strcpy(attr.requestMethod, "EM_IDB_STORE");
+    attr.attributes      = EMSCRIPTEN_FETCH_REPLACE | EMSCRIPTEN_FETCH_PERSIST_FILE;
+    attr.requestData     = data;
+    attr.requestDataSize = size;
+    attr.onsuccess       = on_store_done;
+    attr.onerror         = on_store_done;
+    emscripten_fetch(&attr, path);
+}
 
+// ============================================================================
+// Coalesced requests
+// ============================================================================
 
-    static char target_url[1024];
-    snprintf(target_url, sizeof(target_url), "%s%s", runtime_config_api_base_url(), url);
+#define FETCH_MAX_BATCHES    4
+/* Leaves room for the API base URL in target_url_for's 1024-byte buffer. */
+#define FETCH_BATCH_URL_MAX  768
+
+struct FetchBatch {
+    FetchBatchConfig cfg;
+    bool             bulk_unavailable;
+    int              count;
+    size_t           url_len;          /* bulk URL length if flushed now */
+    double           first_queued_ms;
+    char*            keys[FETCH_BATCH_MAX_KEYS];
+    char*            versions[FETCH_BATCH_MAX_KEYS];   /* NULL: unversioned */
+};
+
+static FetchBatch s_batches[FETCH_MAX_BATCHES];
+static int        s_batch_count = 0;
+
+typedef struct {
+    FetchBatch* batch;
+    int         count;
+    char*       keys[FETCH_BATCH_MAX_KEYS];
+    char*       versions[FETCH_BATCH_MAX_KEYS];
+    int         trace;   /* startup_trace slot, or -1 */
+} BulkContext;
+
+typedef struct {
+    FetchBatch* batch;
+    char*       key;
+    char*       version;
+    int         trace;
+} ProbeContext;
+
+FetchBatch* fetch_batch_create(const FetchBatchConfig* cfg) {
+    assert(cfg);
+    assert(cfg->name && cfg->bulk_url && cfg->single_url);
+    assert(cfg->on_bulk && cfg->on_item);
+    assert(0 < cfg->max_keys && FETCH_BATCH_MAX_KEYS >= cfg->max_keys);
+    assert(FETCH_MAX_BATCHES > s_batch_count);
+
+    FetchBatch* b = &s_batches[s_batch_count++];
+    *b = (FetchBatch){ .cfg = *cfg };
+    b->url_len = strlen(cfg->bulk_url);
+    return b;
+}
+
+static void single_url(const FetchBatch* b, const char* key, char* out, size_t out_sz) {
+    snprintf(out, out_sz, b->cfg.single_url, key);
+}
+
+/* Per-key fallback: the plain route, persisted when versioned. */
+static void start_single(FetchBatch* b, const char* key, const char* version) {
+    char url[512];
+    single_url(b, key, url, sizeof(url));
+    fetch_request_start_persistent(key, url, version, b->cfg.fetch_class, b->cfg.on_item);
+}
+
+static void on_bulk_success(emscripten_fetch_t* f) {
+    BulkContext* ctx = f->userData;
+    s_pending_count -= ctx->count;
+
+    FetchResponse response = (FetchResponse){
+        .success  = f->numBytes > 0,
+        .data     = f->numBytes > 0 ? f->data : NULL,
+        .size     = (size_t)f->numBytes,
+        .asset_id = ctx->batch->cfg.name,
+    };
+    if (response.success) session_recorder_on_fetch_bulk(ctx->batch->cfg.name, f->data, response.size);
+    startup_trace_fetch_end(ctx->trace, response.size, response.success);
+    ctx->batch->cfg.on_bulk(&response);
+    note_last_completed(ctx->batch->cfg.name);
+
+    for (int i = 0; i < ctx->count; i++) {
+        heap_free(ctx->keys[i]);
+        heap_free(ctx->versions[i]);
+    }
+    heap_free(ctx);
+    emscripten_fetch_close(f);
+}
+
+/* 404 on an older engine or a failed round-trip alike: stop batching and
+ * send this batch — and every later key — down the per-key route. */
+static void on_bulk_error(emscripten_fetch_t* f) {
+    BulkContext* ctx = f->userData;
+    FetchBatch*  b   = ctx->batch;
+    s_pending_count -= ctx->count;
+    if (!b->bulk_unavailable) {
+        LOG_WARN("[FETCH] bulk route for %s failed (status %d); falling back to single requests",
+                 b->cfg.name, (int)f->status);
+    }
+    b->bulk_unavailable = true;
+    startup_trace_fetch_end(ctx->trace, 0, false);
+
+    for (int i = 0; i < ctx->count; i++) {
+        start_single(b, ctx->keys[i], ctx->versions[i]);
+        heap_free(ctx->keys[i]);
+        heap_free(ctx->versions[i]);
+    }
+    heap_free(ctx);
+    emscripten_fetch_close(f);
+}
+
+static void flush_batch(FetchBatch* b) {
+    if (0 == b->count) return;
+
+    BulkContext* ctx = heap_malloc(HEAP_MEM_FETCH, sizeof(BulkContext));
+    assert(ctx);
+    ctx->batch = b;
+    ctx->count = b->count;
+    ctx->trace = startup_trace_fetch_begin(b->cfg.name, STARTUP_FETCH_BULK, b->cfg.fetch_class);
+
+    char url[FETCH_BATCH_URL_MAX + 1];
+    size_t len = (size_t)snprintf(url, sizeof(url), "%s", b->cfg.bulk_url);
+    for (int i = 0; i < b->count; i++) {
+        len += (size_t)snprintf(url + len, sizeof(url) - len, "%s%s", i ? "," : "", b->keys[i]);
+        ctx->keys[i]     = b->keys[i];
+        ctx->versions[i] = b->versions[i];
+    }
+    b->count   = 0;
+    b->url_len = strlen(b->cfg.bulk_url);
+
+    QueuedFetch* q = heap_malloc(HEAP_MEM_FETCH, sizeof(QueuedFetch));
+    assert(q);
+    *q = (QueuedFetch){
+        .cls        = b->cfg.fetch_class,
+        .target_url = target_url_for(url),
+        .onsuccess  = on_bulk_success,
+        .onerror    = on_bulk_error,
+        .user       = ctx,
+        .trace      = ctx->trace,
+    };
+    schedule(q);
+}
+
+static void enqueue(FetchBatch* b, char* key, char* version) {
+    size_t add = strlen(key) + (b->count ? 1 : 0);
+    if (b->count == b->cfg.max_keys || b->url_len + add > FETCH_BATCH_URL_MAX) {
+        flush_batch(b);
+        add = strlen(key);
+    }
+    if (0 == b->count) b->first_queued_ms = emscripten_get_now();
+    b->keys[b->count]     = key;
+    b->versions[b->count] = version;
+    b->count++;
+    b->url_len += add;
+}
+
+static void on_probe_hit(emscripten_fetch_t* f) {
+    ProbeContext* ctx = f->userData;
+    note_completed(ctx->key);
+    FetchResponse response = (FetchResponse){
+        .success  = f->numBytes > 0,
+        .data     = f->numBytes > 0 ? f->data : NULL,
+        .size     = (size_t)f->numBytes,
+        .asset_id = ctx->key,
+    };
+    if (response.success) session_recorder_on_fetch(ctx->key, f->data, response.size);
+    startup_trace_fetch_end(ctx->trace, response.size, response.success);
+    ctx->batch->cfg.on_item(&response);
+
+    heap_free(ctx->key);
+    heap_free(ctx->version);
+    heap_free(ctx);
+    emscripten_fetch_close(f);
+}
+
+/* Not persisted yet: the key joins the next bulk request (still pending). */
+static void on_probe_miss(emscripten_fetch_t* f) {
+    ProbeContext* ctx = f->userData;
+    startup_trace_fetch_end(ctx->trace, 0, false);
+    if (ctx->batch->bulk_unavailable) {
+        s_pending_count--;
+        start_single(ctx->batch, ctx->key, ctx->version);
+        heap_free(ctx->key);
+        heap_free(ctx->version);
+    } else {
+        enqueue(ctx->batch, ctx->key, ctx->version);
+    }
+    heap_free(ctx);
+    emscripten_fetch_close(f);
+}
+
+void fetch_batch_request(FetchBatch* b, const char* key, const char* version) {
+    assert(b);
+    assert(key && '\0' != key[0]);
+    if (b->bulk_unavailable) {
+        start_single(b, key, version);
+        return;
+    }
+
+    /* Counted from here until answered, so the loading screen waits for
+     * keys sitting in the coalescing window too. */
+    s_pending_count++;
+    s_total_started++;
+
+    char* key_copy     = heap_strdup(HEAP_MEM_FETCH, key);
+    char* version_copy = has_version(version) ? heap_strdup(HEAP_MEM_FETCH, version) : NULL;
+    if (!version_copy) {
+        enqueue(b, key_copy, NULL);
+        return;
+    }
+
+    /* Versioned: a warm session has it in IndexedDB — look there first,
+     * without going to the network. */
+    ProbeContext* ctx = heap_malloc(HEAP_MEM_FETCH, sizeof(ProbeContext));
+    assert(ctx);
+    *ctx = (ProbeContext){
+        .batch   = b,
+        .key     = key_copy,
+        .version = version_copy,
+        .trace   = startup_trace_fetch_begin(key, STARTUP_FETCH_PROBE, b->cfg.fetch_class),
+    };
+
+    char url[512], store_path[1024];
+    single_url(b, key, url, sizeof(url));
+    persist_path(url, version, store_path, sizeof(store_path));
+
+    emscripten_fetch_attr_t attr;
+    emscripten_fetch_attr_init(&attr);
+    strcpy(attr.requestMethod, "GET");
+    attr.attributes      = EMSCRIPTEN_FETCH_LOAD_TO_MEMORY | EMSCRIPTEN_FETCH_PERSIST_FILE |
+                           EMSCRIPTEN_FETCH_NO_DOWNLOAD;
+    attr.destinationPath = store_path;
+    attr.onsuccess       = on_probe_hit;
+    attr.onerror         = on_probe_miss;
+    attr.userData        = ctx;
+
+    /* Local only, so it skips the scheduler's network slots. */
+    char* target_url = target_url_for(url);
     emscripten_fetch(&attr, target_url);
+    heap_free(target_url);
+}
+
+void fetch_batch_pump(void) {
+    deliver_pack_hits();
+    release_backoffs();
+    double now = emscripten_get_now();
+    for (int i = 0; i < s_batch_count; i++) {
+        FetchBatch* b = &s_batches[i];
+        if (b->count > 0 && now - b->first_queued_ms >= b->cfg.window_ms) flush_batch(b);
+    }
 }
@@ -6,22 +6,136 @@
 
 /*
  * Ownership:
- *   data     — callback OWNS, must free()
+ *   data     — borrowed from the fetch buffer, and the same buffer for
+ *              every caller sharing the request; valid only for callback
+ *              duration and read-only. Consume it in place, copy what must
+ *              outlive it.
  *   asset_id — engine_client owns; valid only for callback duration.
  *              Do not free. Do not stash the pointer past callback return.
  */
 typedef struct {
     const char* asset_id;
     bool        success;
-    void*       data;
+    const void* data;
     size_t      size;
 } FetchResponse;
 
 typedef void (*FetchCompletedCb)(const FetchResponse* response);
 
-void fetch_request_start(const char* asset_id, const char* url, FetchCompletedCb on_completed);
+/*
+ * Network requests are scheduled, not fired: at most FETCH_MAX_IN_FLIGHT
+ * run at once and the rest wait in one FIFO per class, higher classes
+ * first, so a burst of blobs can't hold the font or an on-screen atlas
+ * behind the browser's connection pool.
+ *
+ * Every request is a GET, so they are all safe to repeat: each gets its
+ * class's timeout, and transient failures (network, timeout, 408, 429,
+ * 5xx) back off and retry before the callback sees them (config.h,
+ * FETCH_RETRY_*). A request backing off counts as queued.
+ *
+ * A request for a URL already live (queued, backing off or in flight) with
+ * the same persistence — plain, ETag record or versioned key — joins it
+ * instead of going out again: each caller's callback runs, in request
+ * order, from the one response. A more urgent joiner moves the shared
+ * request up to its class; cancelling one caller leaves it to the rest.
+ */
+typedef enum {
+    FETCH_CLASS_VISIBLE,    /* needed to draw this frame: on-screen atlases, hints, font */
+    FETCH_CLASS_UI,         /* UI icons, quest / dialogue / action data */
+    FETCH_CLASS_PREFETCH,   /* wanted soon, not yet on screen */
+    FETCH_CLASS_POLL,       /* periodic refreshes of dynamic data */
+    FETCH_CLASS_COUNT
+} FetchClass;
+
+typedef struct {
+    int queued;
+    int in_flight;
+    int completed;
+    int failed;
+    int cancelled;
+    int retried;       /* attempts that failed and were tried again */
+    int revalidated;   /* answered from the local copy on 304 Not Modified */
+    int deduplicated;  /* joined a request already live for the same URL */
+} FetchClassStats;
+
+void fetch_request_start(const char* asset_id, const char* url, FetchClass cls,
+                         FetchCompletedCb on_completed);
+
+/* Download the boot asset pack (asset_pack.h) from `url`. Requests under
+ * ASSET_PACK_SCOPE wait for it, then are answered from the pack when it
+ * holds their URL and fetched as usual otherwise — also when the pack is
+ * missing or malformed. Call once, before the first such request. */
+void fetch_asset_pack_load(const char* url);
+
+/* Drop a request still waiting for a slot; its callback never runs. False
+ * when none is queued under `asset_id` (already in flight, or done). */
+bool fetch_cancel(const char* asset_id);
+
+/* Move a request still waiting for a slot to the back of `cls`'s queue.
+ * False when none is queued under `asset_id`. */
+bool fetch_reprioritize(const char* asset_id, FetchClass cls);
+
+FetchClassStats fetch_class_stats(FetchClass cls);
+
+/* Like fetch_request_start(), but the response persists in IndexedDB
+ * across sessions and later requests are served from there without a
+ * round-trip. `version` — a content hash such as a CID or sha256 — is part
+ * of the stored key, so a changed asset misses and is downloaded again.
+ * NULL or "" means the content can't be pinned: the response is kept
+ * with its ETag instead, and the next request sends that as If-None-Match
+ * — a 304 is answered from the stored copy without the body crossing the
+ * network. Without an ETag (or one the API doesn't expose to CORS) it is
+ * a plain fetch. */
+void fetch_request_start_persistent(const char* asset_id, const char* url, const char* version,
+                                    FetchClass cls, FetchCompletedCb on_completed);
+
+/* Write `data` into the persistent store under (url, version), as if a
+ * fetch_request_start_persistent() of it had downloaded it — for payloads
+ * that arrive some other way, e.g. split out of a bulk response. No-op
+ * without a version. */
+void fetch_persist_store(const char* url, const char* version, const void* data, size_t size);
+
+/*
+ * Coalesced requests: keys asked for within a short window go out as one
+ * bulk request instead of one round-trip each.
+ *
+ *   bulk_url   — prefix the comma-joined keys are appended to
+ *                ("/api/thing?keys=" → "/api/thing?keys=a,b,c")
+ *   single_url — printf format with one %s for a key; the per-key route
+ *   on_bulk    — the whole bulk body (asset_id = name), split by the owner
+ *   on_item    — one key's body (asset_id = the key)
+ *
+ * A versioned key is first looked up in the persistent store, locally, and
+ * answered through on_item on a hit. A batch flushes when its window
+ * elapses (fetch_batch_pump) or it fills up. If a bulk request fails — an
+ * engine without the route answers 404 — the batch degrades for the rest
+ * of the session: those keys and all later ones use single_url.
+ */
+#define FETCH_BATCH_MAX_KEYS 32
+
+typedef struct {
+    const char*      name;
+    const char*      bulk_url;
+    const char*      single_url;
+    int              max_keys;
+    double           window_ms;
+    FetchClass       fetch_class;
+    FetchCompletedCb on_bulk;
+    FetchCompletedCb on_item;
+} FetchBatchConfig;
+
+typedef struct FetchBatch FetchBatch;
+
+FetchBatch* fetch_batch_create(const FetchBatchConfig* cfg);
+
+/* Ask for `key`; `version` as for fetch_request_start_persistent(). */
+void fetch_batch_request(FetchBatch* batch, const char* key, const char* version);
+
+/* Flush batches whose window has elapsed and send retries whose backoff
+ * is over. Call once per frame. */
+void fetch_batch_pump(void);
 
-/* Requests currently in flight — 0 means the engine fetch pipeline is idle.
+/* Requests queued or in flight — 0 means the engine fetch pipeline is idle.
  * The loading screen uses this as a REAL readiness signal. */
 int fetch_pending_count(void);
 
@@ -0,0 +1,105 @@
+#include "network/frame_inbox.h"
+
+#include <assert.h>
+#include <stdalign.h>
+#include <stdatomic.h>
+#include <string.h>
+
+/* Records start on RECORD_ALIGN boundaries, so the space left before the
+ * ring's end always holds at least a header — or is zero. */
+#define RECORD_ALIGN 16u
+#define WRAP_MARKER  UINT32_MAX
+
+typedef struct {
+    uint32_t length;    /* payload bytes, or WRAP_MARKER: resume at offset 0 */
+    uint32_t is_text;
+    double   arrival;
+} RecordHeader;
+
+static_assert(RECORD_ALIGN == sizeof(RecordHeader), "header fills one alignment unit");
+static_assert(0 == (FRAME_INBOX_BYTES & (FRAME_INBOX_BYTES - 1)), "ring size must be a power of two");
+
+/* head/tail are free-running byte counters; offsets are taken mod the size.
+ * `release` is where head moves once the popped frame is done with. */
+static struct {
+    alignas(RECORD_ALIGN) uint8_t buf[FRAME_INBOX_BYTES];
+    _Atomic uint32_t head;
+    _Atomic uint32_t tail;
+    uint32_t         release;
+} g_inbox;
+
+static uint32_t record_size(uint32_t length) {
+    return (uint32_t)sizeof(RecordHeader) + ((length + RECORD_ALIGN - 1) & ~(RECORD_ALIGN - 1));
+}
+
+bool frame_inbox_push(const uint8_t* data, uint32_t length, bool is_text, double arrival) {
+    assert(data || 0 == length);
+    if (FRAME_INBOX_MAX_FRAME < length) return false;
+
+    uint32_t tail = atomic_load_explicit(&g_inbox.tail, memory_order_relaxed);
+    uint32_t head = atomic_load_explicit(&g_inbox.head, memory_order_acquire);
+    uint32_t offset = tail & (FRAME_INBOX_BYTES - 1);
+    uint32_t size = record_size(length);
+    uint32_t gap = FRAME_INBOX_BYTES - offset;
+    uint32_t need = (gap < size) ? gap + size : size;
+    if (FRAME_INBOX_BYTES - (tail - head) < need) return false;
+
+    if (gap < size) {
+        ((RecordHeader*)&g_inbox.buf[offset])->length = WRAP_MARKER;
+        tail  += gap;
+        offset = 0;
+    }
+    *(RecordHeader*)&g_inbox.buf[offset] = (RecordHeader){
+        .length  = length,
+        .is_text = is_text,
+        .arrival = arrival,
+    };
+    if (0 < length) memcpy(&g_inbox.buf[offset + sizeof(RecordHeader)], data, length);
+    atomic_store_explicit(&g_inbox.tail, tail + size, memory_order_release);
+    return true;
+}
+
+bool frame_inbox_pop(InboxFrame* out) {
+    assert(out);
+    atomic_store_explicit(&g_inbox.head, g_inbox.release, memory_order_release);
+
+    uint32_t head = g_inbox.release;
+    uint32_t tail = atomic_load_explicit(&g_inbox.tail, memory_order_acquire);
+    if (head == tail) return false;
+
+    const RecordHeader* h = (const RecordHeader*)&g_inbox.buf[head & (FRAME_INBOX_BYTES - 1)];
+    if (WRAP_MARKER == h->length) {
+        head += FRAME_INBOX_BYTES - (head & (FRAME_INBOX_BYTES - 1));
+        h = (const RecordHeader*)&g_inbox.buf[0];
+    }
+    *out = (InboxFrame){
+        .data    = (const uint8_t*)h + sizeof(RecordHeader),
+        .length  = h->length,
+        .is_text = 0 != h->is_text,
+        .arrival = h->arrival,
+    };
+    g_inbox.release = head + record_size(h->length);
+    return true;
+}
+
+int frame_inbox_find_last(InboxMatchFn match) {
+    assert(match);
+    uint32_t head = g_inbox.release;
+    uint32_t tail = atomic_load_explicit(&g_inbox.tail, memory_order_acquire);
+    int found = -1;
+    for (int i = 0; head != tail; i++) {
+        const RecordHeader* h = (const RecordHeader*)&g_inbox.buf[head & (FRAME_INBOX_BYTES - 1)];
+        if (WRAP_MARKER == h->length) {
+            head += FRAME_INBOX_BYTES - (head & (FRAME_INBOX_BYTES - 1));
+            h = (const RecordHeader*)&g_inbox.buf[0];
+        }
+        if (match((const uint8_t*)h + sizeof(RecordHeader), h->length, 0 != h->is_text)) found = i;
+        head += record_size(h->length);
+    }
+    return found;
+}
+
+void frame_inbox_clear(void) {
+    g_inbox.release = atomic_load_explicit(&g_inbox.tail, memory_order_acquire);
+    atomic_store_explicit(&g_inbox.head, g_inbox.release, memory_order_release);
+}
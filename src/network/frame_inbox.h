@@ -0,0 +1,46 @@
+#ifndef CYBERIA_NETWORK_FRAME_INBOX_H
+#define CYBERIA_NETWORK_FRAME_INBOX_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Single-producer / single-consumer queue of downlink frames.
+ *
+ * The socket callback copies each frame in with its arrival time; the main
+ * loop drains them at one fixed point per frame, so decoding never lands in
+ * the middle of a frame's simulation or rendering and every snapshot is
+ * applied as a whole before anything reads it. Head and tail are C11
+ * atomics with acquire/release ordering, so the producer may run on another
+ * thread (socket I/O on a worker in a -pthread build) without locks.
+ *
+ * Records are length-prefixed and contiguous in a fixed byte ring; a frame
+ * larger than FRAME_INBOX_MAX_FRAME, or one that finds the ring full, is
+ * refused and left to the caller. */
+
+#define FRAME_INBOX_BYTES     (1u << 20)
+#define FRAME_INBOX_MAX_FRAME (FRAME_INBOX_BYTES / 4)
+
+typedef struct {
+    const uint8_t* data;      /* valid until the next frame_inbox_pop() */
+    uint32_t       length;
+    bool           is_text;
+    double         arrival;   /* GetTime() when the frame was pushed */
+} InboxFrame;
+
+/* Producer: copy a frame in. False when it does not fit. */
+bool frame_inbox_push(const uint8_t* data, uint32_t length, bool is_text, double arrival);
+
+/* Consumer: the oldest frame, or false when empty. Releases the frame
+ * returned by the previous call. */
+bool frame_inbox_pop(InboxFrame* out);
+
+typedef bool (*InboxMatchFn)(const uint8_t* data, uint32_t length, bool is_text);
+
+/* Consumer: position of the newest queued frame `match` accepts, counted
+ * from the one the next pop returns (0), or -1 for none. Pops nothing. */
+int  frame_inbox_find_last(InboxMatchFn match);
+
+/* Consumer: drop every queued frame. */
+void frame_inbox_clear(void);
+
+#endif /* CYBERIA_NETWORK_FRAME_INBOX_H */
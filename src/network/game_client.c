@@ -1,47 +1,174 @@
 #include "game_client.h"
+#include "client_context.h"
 #include "network/socket.h"
+#include "network/frame_inbox.h"
+#include "network/wire_compress.h"
 #include "config.h"
 #include "runtime_config.h"
+#include "game_render.h"
 #include "game_state.h"
+#include "id_intern.h"
+#include "layer_stack.h"
 #include "message_parser.h"
+#include "network/net_telemetry.h"
+#include "network/session_recorder.h"
+#include "network/session_snapshot.h"
+#include "profiler.h"
+#include "rum.h"
 #include "binary_aoi_decoder.h"
 #include "serial.h"
 #include "replication.h"
+#include "static_world.h"
+#include "domain/equip_txn.h"
 #include "domain/local_player.h"
 #include "ui/ui_state.h"
 #include "util/log.h"
 
 #include <assert.h>
+#include <math.h>
 #include <stdbool.h>
 #include <stdint.h>
-#include <raylib.h>
-#include <stdlib.h>
+#include <stdio.h>
 #include <string.h>
+#include <raylib.h>
+#include <emscripten/emscripten.h>
 
 typedef struct {
     WebSocketClient ws_client;
     conn_stats      stats;
     double          status_entered_at;
-    double          last_reconnect_at;
+    double          next_reconnect_at;
+    double          reconnect_delay;   /* seconds; grows per failed attempt */
     int             heartbeat_frames;
+    bool            offline;           /* no server: never (re)connect */
 } ClientCtx;
 
-static ClientCtx g_client = {0};
+static ClientCtx g_client = { .reconnect_delay = RECONNECT_BASE_SECONDS };
+
+/* Session resume (WIRE_CAP_RESUME): the token of the last BIN_MSG_SESSION
+ * and, across a drop, whether the world was kept for UPLINK_RESUME. */
+static struct {
+    char   token[BIN_SESSION_TOKEN_MAX + 1];
+    bool   kept;         /* world state survived the last close */
+    bool   pending;      /* UPLINK_RESUME sent, BIN_MSG_SESSION not yet back */
+    double dropped_at;
+} g_resume;
+
+/* Uplink frames awaiting network_uplink_flush(). Control frames have their
+ * own list and go out first, even while the socket is congested; the rest
+ * wait until its bufferedAmount is back under UPLINK_BACKPRESSURE_BYTES.
+ * Movement keeps only the newest frame, since a later tap or input batch
+ * supersedes the queued one. Lists hold u16 len + frame records; `batch` is
+ * the UPLINK_BATCH message being built from them. */
+#define UPLINK_BATCH_BYTES 1024
+#define UPLINK_BATCH_HEADER 2
+static_assert(UPLINK_BATCH_BYTES >= UPLINK_BATCH_HEADER + 2 + UPLINK_FRAME_MAX,
+              "UPLINK_BATCH_BYTES must hold the largest frame");
+
+typedef struct {
+    uint8_t  buf[UPLINK_BATCH_BYTES - UPLINK_BATCH_HEADER];
+    uint16_t pos;
+    uint8_t  count;
+} UplinkList;
+
+static struct {
+    UplinkList control;
+    UplinkList bulk;
+    uint8_t    move[UPLINK_FRAME_MAX];
+    uint16_t   move_len;
+    uint8_t    batch[UPLINK_BATCH_BYTES];
+    uint16_t   batch_pos;    /* UPLINK_BATCH_HEADER when empty */
+    uint8_t    batch_count;
+} g_uplink = { .batch_pos = UPLINK_BATCH_HEADER };
 
+/* Frame cost (WIRE_CAP_EXT_CLIENT_BUDGET): snapshot decode and render time
+ * per frame, exponential 1/8. `over` is the decode throttle, with
+ * hysteresis between the budget and its clear level. */
+static struct {
+    double   frame_decode_ms;   /* snapshot decode so far this frame */
+    float    decode_ms;
+    float    render_ms;
+    bool     over;
+    uint32_t skipped;           /* since the last report */
+    double   next_report_at;
+} g_budget;
+
+/* Clock pings (WIRE_CAP_EXT_CLOCK_SYNC) sent on this connection. */
+static struct {
+    int    sent;
+    double next_at;
+} g_clock_ping;
+
+/* Arrival time of the downlink frame being handled; negative outside. */
+static double g_rx_arrival = -1.0;
+
+static void drain_inbox(void);
+static void uplink_clear(void);
 static void on_websocket_open(void* ctx);
 static void on_websocket_message(const uint8_t* data, uint32_t length, bool is_text, void* ctx);
 static void on_websocket_error(void* ctx);
 static void on_websocket_close(int code, const char* reason, void* ctx);
 
-static void client_reset_state(void) {
+/* Everything decoded from the downlink, down to an empty world. */
+static void client_reset_world(void) {
     game_state_reset();
     local_player_reset();
     ui_state_reset();
+    equip_txn_reset();
+    net_telemetry_reset();
     binary_aoi_reset_prev_snapshots();
+    static_world_release();
+    id_intern_reset();
+    layer_stack_reset();
     prediction_reset((Vector2){0.0f, 0.0f});
 }
 
+static void client_reset_state(void) {
+    frame_inbox_clear();
+    uplink_clear();
+    client_reset_world();
+    g_resume.kept    = false;
+    g_resume.pending = false;
+}
+
+/* A drop with a resume token: discard only what belonged to the socket —
+ * queued frames and the negotiated caps, which the next handshake
+ * renegotiates. Entities, snapshot baselines, interned ids, the item
+ * dictionary and the prediction ring stay for the resumed session. */
+static void client_keep_state(void) {
+    frame_inbox_clear();
+    uplink_clear();
+    g_game_state.wire_ack_caps     = 0;
+    g_game_state.wire_ack_caps_ext = 0;
+    g_resume.kept       = true;
+    g_resume.pending    = false;
+    g_resume.dropped_at = GetTime();
+}
+
+void game_client_on_session(const char* token, bool resumed) {
+    assert(token);
+    if (g_resume.pending && !resumed) {
+        LOG_INFO("session resume refused; rebuilding from init_data");
+        /* Decoded from drain_inbox(): the frames queued behind this one,
+         * init_data among them, stay in the inbox. */
+        uint8_t caps     = g_game_state.wire_ack_caps;
+        uint8_t caps_ext = g_game_state.wire_ack_caps_ext;
+        uplink_clear();
+        client_reset_world();
+        g_game_state.wire_ack_caps     = caps;
+        g_game_state.wire_ack_caps_ext = caps_ext;
+    } else if (g_resume.pending) {
+        LOG_INFO("session resumed at tick %u", (unsigned)session_last_server_tick());
+    }
+    g_resume.pending = false;
+    g_resume.kept    = false;
+    snprintf(g_resume.token, sizeof(g_resume.token), "%s", token);
+}
+
 bool connection_open(void) {
+    double jitter = 0.5 + 0.5 * (double)GetRandomValue(0, 1000) / 1000.0;
+    g_client.next_reconnect_at = GetTime() + g_client.reconnect_delay * jitter;
+    g_client.reconnect_delay   = fmin(g_client.reconnect_delay * 2.0, RECONNECT_MAX_SECONDS);
     message_parser_set_init_handler(client_on_init_received);
     WebSocketHandlers callbacks = {
         .on_open_cb    = on_websocket_open,
@@ -79,6 +206,8 @@ void client_confirm_loading_done(void) {
 
 void client_on_init_received(void) {
     LOG_INFO("init_data received");
+    g_resume.kept    = false;
+    g_resume.pending = false;
     /* Every fresh join spawns frozen under the server's "loading" protection.
      * On a reconnect the client is already loaded and playing, so release the
      * new session immediately; the first join instead waits for the player's
@@ -91,6 +220,7 @@ void client_on_init_received(void) {
 }
 
 void game_client_on_tick(void) {
+    drain_inbox();
     const double now = GetTime();
     g_client.heartbeat_frames++;
     if ((g_client.heartbeat_frames % 1800) == 0) { /* ~30 s @ 60 fps */
@@ -100,29 +230,162 @@ void game_client_on_tick(void) {
                   g_game_state.init_received ? 1 : 0);
     }
 
-    // This is a draft for a reconnection feature... there are better ways to handle this
-    if(!connection_is_open()) {
-        static const double retry_interval = 3.0;
-        if (now - g_client.last_reconnect_at >= retry_interval) {
-            g_client.last_reconnect_at = now;
-            LOG_INFO("reconnecting...");
-            if (!connection_open()) {
-                /* connection_open already logs the failure; stay
-                    * DISCONNECTED, retry on the next interval. */
-            }
+    /* connection_open() schedules the next attempt with exponential backoff
+     * and jitter; on_websocket_open resets the delay. An attempt still
+     * connecting when its wait ends is abandoned. */
+    if (!g_client.offline && !connection_is_open() && now >= g_client.next_reconnect_at) {
+        if (g_resume.kept && now - g_resume.dropped_at > RESUME_WINDOW_SECONDS) {
+            LOG_INFO("resume window elapsed; dropping kept session state");
+            client_reset_state();
         }
+        LOG_INFO("reconnecting...");
+        connection_close();
+        connection_open();  /* logs its own failure; the next wait retries */
+    }
+
+    if (connection_is_open() && now >= g_clock_ping.next_at &&
+        0 != (g_game_state.wire_ack_caps_ext & WIRE_CAP_EXT_CLOCK_SYNC)) {
+        BinWriter w;
+        uplink_clock_ping(&w, (uint32_t)(now * 1000.0));
+        if (network_send_binary(w.buf, w.pos)) g_clock_ping.sent++;
+        g_clock_ping.next_at = now + (g_clock_ping.sent < CLOCK_SYNC_BURST
+                                          ? CLOCK_SYNC_BURST_SECONDS
+                                          : CLOCK_SYNC_INTERVAL_SECONDS);
     }
 }
 
-bool network_send_binary(const uint8_t* data, uint16_t len) {
-    assert(data);
-    assert(len > 0);
-    if (!connection_is_open()) return false;
+static bool send_now(const uint8_t* data, uint16_t len) {
     bool ok = ws_send_binary(&g_client.ws_client, data, len);
     g_client.stats.bytes_up += ok ? len : 0;
     return ok;
 }
 
+static void uplink_clear(void) {
+    g_uplink.control.pos   = 0;
+    g_uplink.control.count = 0;
+    g_uplink.bulk.pos      = 0;
+    g_uplink.bulk.count    = 0;
+    g_uplink.move_len      = 0;
+    g_uplink.batch_pos     = UPLINK_BATCH_HEADER;
+    g_uplink.batch_count   = 0;
+}
+
+/* Session and acknowledgement frames, which gate the server's view of us,
+ * and clock pings, whose round trip must not include the bulk queue. */
+static bool uplink_is_control(uint8_t opcode) {
+    switch (opcode) {
+        case UPLINK_HANDSHAKE:
+        case UPLINK_RESUME:
+        case UPLINK_CLOCK_PING:
+        case UPLINK_FREEZE_START:
+        case UPLINK_FREEZE_END:
+        case UPLINK_DLG_START:
+        case UPLINK_DLG_COMPLETE:
+        case UPLINK_DLG_CANCEL:
+        case UPLINK_QUEST_ABANDON:
+        case UPLINK_QUEST_ACCEPT:
+            return true;
+        default:
+            return false;
+    }
+}
+
+static bool uplink_is_movement(uint8_t opcode) {
+    return UPLINK_PLAYER_ACTION == opcode || UPLINK_INPUT_BATCH == opcode;
+}
+
+static bool list_fits(const UplinkList* l, uint16_t len) {
+    return sizeof(l->buf) >= l->pos + 2u + len && UINT8_MAX > l->count;
+}
+
+bool network_send_binary(const uint8_t* data, uint16_t len) {
+    assert(data);
+    assert(len > 0 && UPLINK_FRAME_MAX >= len);
+    /* Secondary views (client_context.h) are fed locally and never send. */
+    if (!connection_is_open() || !client_context_is_primary()) return false;
+
+    if (uplink_is_movement(data[0])) {
+        if (0 < g_uplink.move_len) net_telemetry_on_uplink_coalesced();
+        memcpy(g_uplink.move, data, len);
+        g_uplink.move_len = len;
+        return true;
+    }
+    UplinkList* l = uplink_is_control(data[0]) ? &g_uplink.control : &g_uplink.bulk;
+    if (!list_fits(l, len)) network_uplink_flush();
+    if (!list_fits(l, len)) {
+        net_telemetry_on_uplink_dropped();
+        return false;
+    }
+    l->buf[l->pos++] = (uint8_t)(len);
+    l->buf[l->pos++] = (uint8_t)(len >> 8);
+    memcpy(l->buf + l->pos, data, len);
+    l->pos += len;
+    l->count++;
+    return true;
+}
+
+/* Send the UPLINK_BATCH being built; a lone frame goes out bare, since the
+ * container would only add bytes. */
+static void emit_batch(void) {
+    if (1 == g_uplink.batch_count) {
+        send_now(g_uplink.batch + UPLINK_BATCH_HEADER + 2,
+                 (uint16_t)(g_uplink.batch_pos - UPLINK_BATCH_HEADER - 2));
+    } else if (1 < g_uplink.batch_count) {
+        g_uplink.batch[0] = UPLINK_BATCH;
+        g_uplink.batch[1] = g_uplink.batch_count;
+        send_now(g_uplink.batch, g_uplink.batch_pos);
+    }
+    g_uplink.batch_pos   = UPLINK_BATCH_HEADER;
+    g_uplink.batch_count = 0;
+}
+
+/* Batch one frame, or send it bare until the server accepts
+ * WIRE_CAP_UPLINK_BATCH. */
+static void emit(const uint8_t* frame, uint16_t len) {
+    if (0 == (g_game_state.wire_ack_caps & WIRE_CAP_UPLINK_BATCH)) {
+        send_now(frame, len);
+        return;
+    }
+    if (UPLINK_BATCH_BYTES < g_uplink.batch_pos + 2u + len || UINT8_MAX == g_uplink.batch_count) {
+        emit_batch();
+    }
+    g_uplink.batch[g_uplink.batch_pos++] = (uint8_t)(len);
+    g_uplink.batch[g_uplink.batch_pos++] = (uint8_t)(len >> 8);
+    memcpy(g_uplink.batch + g_uplink.batch_pos, frame, len);
+    g_uplink.batch_pos += len;
+    g_uplink.batch_count++;
+}
+
+static void emit_list(UplinkList* l) {
+    for (uint16_t at = 0; at < l->pos;) {
+        uint16_t len = (uint16_t)(l->buf[at] | l->buf[at + 1] << 8);
+        emit(l->buf + at + 2, len);
+        at += 2 + len;
+    }
+    l->pos   = 0;
+    l->count = 0;
+}
+
+void network_uplink_flush(void) {
+    if (!connection_is_open()) {
+        uplink_clear();
+        return;
+    }
+    bool   pending  = 0 < g_uplink.bulk.count || 0 < g_uplink.move_len;
+    size_t buffered = pending ? ws_buffered_amount(&g_client.ws_client) : 0;
+    bool   held     = UPLINK_BACKPRESSURE_BYTES < buffered;
+
+    emit_list(&g_uplink.control);
+    if (!held) {
+        emit_list(&g_uplink.bulk);
+        if (0 < g_uplink.move_len) emit(g_uplink.move, g_uplink.move_len);
+        g_uplink.move_len = 0;
+    }
+    emit_batch();
+    net_telemetry_on_uplink_flush(g_uplink.bulk.count + (0 < g_uplink.move_len ? 1 : 0),
+                                  buffered, held);
+}
+
 bool network_send_chat(const char* to_id, const char* text) {
     assert(to_id);
     assert(text);
@@ -135,11 +398,142 @@ bool network_send_chat(const char* to_id, const char* text) {
 
 static void on_websocket_open(void* ctx) {
     BinWriter w;
-    uplink_handshake(&w, "cyberia-mmo", "1.0.0");
+    uplink_handshake(&w, "cyberia-mmo", "1.0.0",
+                     WIRE_CAP_QUANTIZED_POS | WIRE_CAP_BINARY_INIT | WIRE_CAP_UPLINK_BATCH |
+                     WIRE_CAP_INPUT_BATCH | WIRE_CAP_EVENT_BATCH | WIRE_CAP_LZ4 |
+                     WIRE_CAP_ITEM_DICT | WIRE_CAP_RESUME,
+                     WIRE_CAP_EXT_STATIC_WORLD | WIRE_CAP_EXT_CLIENT_BUDGET |
+                     WIRE_CAP_EXT_EQUIP_BATCH | WIRE_CAP_EXT_CLOCK_SYNC);
     network_send_binary(w.buf, w.pos);
-    LOG_INFO("WebSocket open");
+    g_client.reconnect_delay = RECONNECT_BASE_SECONDS;
+    g_clock_ping.sent    = 0;
+    g_clock_ping.next_at = 0.0;
+    session_clock_reset();
+    if (g_resume.kept) {
+        uplink_resume(&w, g_resume.token, session_last_server_tick());
+        network_send_binary(w.buf, w.pos);
+        g_resume.pending = true;
+    }
+    LOG_INFO("WebSocket open%s", g_resume.kept ? " (resuming session)" : "");
+}
+
+/* The inner frame of a BIN_MSG_COMPRESSED, or NULL when it is malformed.
+ * Points into wire_compress's buffer until the next call. */
+static const uint8_t* unwrap_compressed(const uint8_t* data, uint32_t* length, bool* is_text) {
+    if (6 > *length) return NULL;
+    uint8_t  flags   = data[1];
+    uint32_t raw_len = (uint32_t)data[2] | (uint32_t)data[3] << 8 | (uint32_t)data[4] << 16 |
+                       (uint32_t)data[5] << 24;
+    const uint8_t* raw = wire_decompress(data + 6, *length - 6, raw_len,
+                                         0 != (flags & BIN_COMPRESS_DICT));
+    if (!raw || 0 == raw_len) return NULL;
+    *length  = raw_len;
+    *is_text = 0 != (flags & BIN_COMPRESS_TEXT);
+    return raw;
 }
 
+static void process_message(const uint8_t* data, uint32_t length, bool is_text, double arrival) {
+    if (!is_text && BIN_MSG_COMPRESSED == data[0]) {
+        data = unwrap_compressed(data, &length, &is_text);
+        if (!data) {
+            LOG_ERROR("failed to decompress downlink frame");
+            return;
+        }
+    }
+    g_rx_arrival = arrival;
+    double start = emscripten_get_now();
+    int  kind;
+    bool snapshot;
+    if (is_text) {
+        if (!message_parser_parse((const char*)data, (size_t)length)) {
+            LOG_ERROR("failed to process WS text frame");
+        }
+        kind     = (int)message_parser_last_type();
+        snapshot = MSG_TYPE_AOI_UPDATE == kind;
+    } else {
+        PROFILE_BEGIN(PROF_ZONE_AOI_DECODE);
+        int rc = binary_aoi_process(data, (size_t)length);
+        PROFILE_END(PROF_ZONE_AOI_DECODE);
+        if (0 != rc) LOG_ERROR("failed to process binary AOI message");
+        kind     = data[0];
+        snapshot = BIN_MSG_AOI_UPDATE == kind || BIN_MSG_FULL_AOI == kind || BIN_MSG_AOI_DELTA == kind;
+    }
+    double decode_ms = emscripten_get_now() - start;
+    session_snapshot_on_frame(data, length, is_text, kind);
+    net_telemetry_on_message(is_text, kind, length, decode_ms * 1000.0);
+    if (snapshot) {
+        g_budget.frame_decode_ms += decode_ms;
+        rum_on_snapshot(decode_ms);
+        net_telemetry_on_snapshot(arrival * 1000.0, g_game_state.other_player_count,
+                                  g_game_state.bot_count, game_state_world_object_count());
+    }
+    g_rx_arrival = -1.0;
+}
+
+static bool is_binary_snapshot(const uint8_t* data, uint32_t length, bool is_text) {
+    if (is_text || 0 == length) return false;
+    return BIN_MSG_AOI_UPDATE == data[0] || BIN_MSG_FULL_AOI == data[0] ||
+           BIN_MSG_AOI_DELTA == data[0];
+}
+
+static bool is_full_snapshot(const uint8_t* data, uint32_t length, bool is_text) {
+    if (is_text || 0 == length) return false;
+    return BIN_MSG_AOI_UPDATE == data[0] || BIN_MSG_FULL_AOI == data[0];
+}
+
+/* Decode every frame received since the last call, oldest first. Over
+ * budget, snapshots queued ahead of a full frame are dropped: it replaces
+ * the whole AOI, deltas included. Compressed and JSON frames are opaque
+ * here and always decoded. The first one clears a restored ghost world. */
+static void drain_inbox(void) {
+    int supersede = g_budget.over ? frame_inbox_find_last(is_full_snapshot) : -1;
+    InboxFrame f;
+    for (int i = 0; frame_inbox_pop(&f); i++) {
+        if (session_snapshot_on_live()) client_reset_world();
+        if (i < supersede && is_binary_snapshot(f.data, f.length, f.is_text)) {
+            g_budget.skipped++;
+            net_telemetry_on_snapshot_skipped();
+            continue;
+        }
+        process_message(f.data, f.length, f.is_text, f.arrival);
+    }
+}
+
+/* Remote players and bots inside the camera bounds. */
+static int visible_entities(void) {
+    const GameState* gs = &g_game_state;
+    Rectangle view = game_render_get_camera_bounds();
+    int n = 0;
+    for (int i = 0; i < gs->other_player_count; i++) {
+        if (CheckCollisionPointRec(gs->other_players[i].base.interp_pos, view)) n++;
+    }
+    for (int i = 0; i < gs->bot_count; i++) {
+        if (CheckCollisionPointRec(gs->bots[i].base.interp_pos, view)) n++;
+    }
+    return n;
+}
+
+void game_client_on_frame_cost(double render_ms) {
+    g_budget.decode_ms += ((float)g_budget.frame_decode_ms - g_budget.decode_ms) / 8.0f;
+    g_budget.render_ms += ((float)render_ms - g_budget.render_ms) / 8.0f;
+    g_budget.frame_decode_ms = 0.0;
+    float cost = g_budget.decode_ms + g_budget.render_ms;
+    g_budget.over = cost > (g_budget.over ? CLIENT_FRAME_BUDGET_CLEAR_MS : CLIENT_FRAME_BUDGET_MS);
+
+    const double now = GetTime();
+    if (now < g_budget.next_report_at || !connection_is_open() ||
+        0 == (g_game_state.wire_ack_caps_ext & WIRE_CAP_EXT_CLIENT_BUDGET)) {
+        return;
+    }
+    g_budget.next_report_at = now + CLIENT_BUDGET_REPORT_SECONDS;
+    BinWriter w;
+    uplink_client_budget(&w, (uint32_t)(g_budget.decode_ms * 1000.0f),
+                         (uint32_t)(g_budget.render_ms * 1000.0f), (uint32_t)visible_entities(),
+                         g_budget.skipped, g_budget.over);
+    if (network_send_binary(w.buf, w.pos)) g_budget.skipped = 0;
+}
+
+/* Frames are only queued here and decoded by game_client_on_tick(). */
 static void on_websocket_message(const uint8_t* data, uint32_t length, bool is_text, void* ctx) {
     assert(data);
     assert(length > 0);
@@ -147,19 +541,28 @@ static void on_websocket_message(const uint8_t* data, uint32_t length, bool is_t
     ClientCtx* st = ctx;
 
     st->stats.bytes_down += length;
+    session_recorder_on_ws(data, length, is_text);
 
-    if (is_text) {
-        char* msg = malloc(length + 1);
-        assert(msg);
-        memcpy(msg, data, length);
-        msg[length] = '\0';
-        if (!message_parser_parse(msg)) {
-            LOG_ERROR("failed to process WS text frame");
-        }
-        free(msg);
-    } else if (0 != binary_aoi_process(data, (size_t)length)) {
-        LOG_ERROR("failed to process binary AOI message");
-    }
+    double arrival = GetTime();
+    if (frame_inbox_push(data, length, is_text, arrival)) return;
+    /* Oversized frame or a full inbox: keep the order by decoding what is
+     * queued first. Safe while the socket runs on the main thread. */
+    LOG_WARN("downlink frame of %u bytes bypasses the inbox", (unsigned)length);
+    drain_inbox();
+    process_message(data, length, is_text, arrival);
+}
+
+void game_client_set_offline(bool offline) {
+    g_client.offline = offline;
+}
+
+void game_client_inject_message(const uint8_t* data, uint32_t length, bool is_text) {
+    assert(data && 0 < length);
+    process_message(data, length, is_text, GetTime());
+}
+
+double network_message_time(void) {
+    return 0.0 <= g_rx_arrival ? g_rx_arrival : GetTime();
 }
 
 static void on_websocket_error(void* ctx) {
@@ -171,5 +574,12 @@ static void on_websocket_close(int code, const char* reason, void* ctx) {
         LOG_WARN("WebSocket closed unexpectedly code=%d reason='%s'",
                  code, reason ? reason : "none");
     }
-    client_reset_state();
+    /* A clean close ends the session; otherwise keep the world for a resume
+     * when the server issued a token. */
+    if (1000 != code && '\0' != g_resume.token[0]) {
+        client_keep_state();
+    } else {
+        client_reset_state();
+        g_resume.token[0] = '\0';
+    }
 }
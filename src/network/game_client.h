@@ -23,14 +23,52 @@ void game_client_on_tick(void);
  * graduates from AWAITING_INIT to RUNNING. */
 void client_on_init_received(void);
 
+/* BIN_MSG_SESSION arrived: keep `token` for the next reconnect. `resumed`
+ * reports whether the server accepted an UPLINK_RESUME; a refused resume
+ * drops the kept world so the init_data that follows rebuilds it. */
+void game_client_on_session(const char* token, bool resumed);
+
 /* The player tapped Start on the loading screen: release the server's
  * "loading" freeze. Reconnect joins re-release automatically. */
 void client_confirm_loading_done(void);
 
-/** Send a pre-built binary uplink frame (BinWriter output). */
+/** Queue a pre-built binary uplink frame (BinWriter output) for
+ *  network_uplink_flush(); true means queued on an open connection. A
+ *  movement frame (player_action, input_batch) replaces one still queued;
+ *  false when the queue is full. */
 bool network_send_binary(const uint8_t* data, uint16_t len);
 
+/** Send the queued frames, control frames (handshake, resume, freezes,
+ *  dialogue and quest acks) first. While the socket's bufferedAmount is over
+ *  UPLINK_BACKPRESSURE_BYTES only control frames go; the rest wait, so taps
+ *  never queue up behind a congested link. Once the server has accepted
+ *  WIRE_CAP_UPLINK_BATCH several frames travel as one UPLINK_BATCH message.
+ *  Call once per main_loop iteration after input, UI and replication have
+ *  run; frames still queued on a disconnect are dropped. */
+void network_uplink_flush(void);
+
+/* Close the frame's cost accounting with the time render_on_tick() took.
+ * Feeds the decode throttle and, once the server acks
+ * WIRE_CAP_EXT_CLIENT_BUDGET, the periodic UPLINK_CLIENT_BUDGET report.
+ * Call once per main_loop iteration after rendering. */
+void game_client_on_frame_cost(double render_ms);
+
 /** Convenience: chat — builds and sends UPLINK_CHAT. */
 bool network_send_chat(const char* to_id, const char* text);
 
+/* Handle a downlink frame as if the socket had delivered it. Lets the host
+ * bench replay a recorded session (network/session_recorder.h) and a
+ * reload rebuild its saved world (network/session_snapshot.h). Decodes
+ * immediately, bypassing the frame inbox. */
+void game_client_inject_message(const uint8_t* data, uint32_t length, bool is_text);
+
+/* Stop (or resume) connection attempts: a bench run (bench_scene.h) has no
+ * server and feeds every frame through game_client_inject_message(). */
+void game_client_set_offline(bool offline);
+
+/* GetTime() at which the downlink frame being decoded arrived — frames are
+ * queued on arrival and decoded later by game_client_on_tick(), so snapshot
+ * timestamps read this rather than the clock. Outside decoding, GetTime(). */
+double network_message_time(void);
+
 #endif // CLIENT_H
@@ -0,0 +1,190 @@
+#include "network/net_telemetry.h"
+
+#include "binary_aoi_decoder.h"
+#include "client_context.h"
+#include "message_parser.h"
+
+#include <emscripten/emscripten.h>
+
+#include <assert.h>
+#include <string.h>
+
+/* Inputs remembered for the round trip; older unacked ones are dropped. */
+#define NET_TELEMETRY_INPUT_RING 64
+
+static const float kGapEdges[NET_TELEMETRY_GAP_BUCKETS - 1] = NET_TELEMETRY_GAP_EDGES_MS;
+
+static const char* const kBinNames[NET_TELEMETRY_BIN_KINDS] = {
+    [BIN_MSG_AOI_UPDATE]   = "aoi_update",
+    [BIN_MSG_INIT_DATA]    = "init_data",
+    [BIN_MSG_FULL_AOI]     = "full_aoi",
+    [BIN_MSG_FCT]          = "fct",
+    [BIN_MSG_ITEM_FCT]     = "item_fct",
+    [BIN_MSG_DROP_COLLECT] = "drop_collect",
+    [BIN_MSG_DROP_SPAWN]   = "drop_spawn",
+    [BIN_MSG_AOI_DELTA]    = "aoi_delta",
+    [BIN_MSG_METADATA]     = "metadata",
+    [BIN_MSG_EVENT_BATCH]  = "event_batch",
+    [BIN_MSG_ITEM_DICT]    = "item_dict",
+    [BIN_MSG_SESSION]      = "session",
+    [BIN_MSG_STATIC_WORLD] = "static_world",
+    [BIN_MSG_CLOCK_PONG]   = "clock_pong",
+};
+
+static const char* const kJsonNames[NET_TELEMETRY_JSON_KINDS] = {
+    [MSG_TYPE_UNKNOWN]        = "unknown",
+    [MSG_TYPE_INIT_DATA]      = "init_data",
+    [MSG_TYPE_AOI_UPDATE]     = "aoi_update",
+    [MSG_TYPE_SKILL_ITEM_IDS] = "skill_item_ids",
+    [MSG_TYPE_METADATA]       = "metadata",
+    [MSG_TYPE_CHAT]           = "chat",
+    [MSG_TYPE_ERROR]          = "error",
+    [MSG_TYPE_PING]           = "ping",
+    [MSG_TYPE_PONG]           = "pong",
+    [MSG_TYPE_DLG_ACK]        = "dlg_ack",
+    [MSG_TYPE_CLIENT_HINTS]   = "client_hints",
+};
+
+typedef struct {
+    uint32_t sequence;
+    double   sent_ms;
+} SentInput;
+
+static struct {
+    NetMsgStats      bin[NET_TELEMETRY_BIN_KINDS];
+    NetMsgStats      json[NET_TELEMETRY_JSON_KINDS];
+    NetSnapshotStats snap;
+    NetUplinkStats   uplink;
+    double           last_snapshot_ms;
+
+    SentInput        inputs[NET_TELEMETRY_INPUT_RING];
+    uint32_t         last_sent;
+    uint32_t         last_acked;
+    uint32_t         timed_acks;
+} g_net_tm;
+
+static int clamp_kind(int kind, int count) {
+    return (kind < 0 || kind >= count) ? count - 1 : kind;
+}
+
+/* Exponential mean with a 1/8 gain, seeded by the first sample. */
+static float ema(float mean, float sample, uint32_t samples) {
+    return (samples <= 1) ? sample : mean + (sample - mean) / 8.0f;
+}
+
+void net_telemetry_reset(void) {
+    memset(&g_net_tm, 0, sizeof(g_net_tm));
+}
+
+void net_telemetry_on_message(bool is_text, int kind, size_t bytes, double decode_us) {
+    NetMsgStats* s = is_text ? &g_net_tm.json[clamp_kind(kind, NET_TELEMETRY_JSON_KINDS)]
+                             : &g_net_tm.bin[clamp_kind(kind, NET_TELEMETRY_BIN_KINDS)];
+    s->count++;
+    s->bytes     += bytes;
+    s->decode_us += decode_us;
+    if ((float)decode_us > s->max_decode_us) s->max_decode_us = (float)decode_us;
+}
+
+void net_telemetry_on_snapshot(double now_ms, int players, int bots, int world_objects) {
+    NetSnapshotStats* s = &g_net_tm.snap;
+    s->snapshots++;
+    if (g_net_tm.last_snapshot_ms > 0.0) {
+        float gap = (float)(now_ms - g_net_tm.last_snapshot_ms);
+        int b = 0;
+        while (b < NET_TELEMETRY_GAP_BUCKETS - 1 && gap >= kGapEdges[b]) b++;
+        s->gap_hist[b]++;
+        s->last_gap_ms = gap;
+        s->mean_gap_ms = ema(s->mean_gap_ms, gap, s->snapshots - 1);
+        if (gap > s->max_gap_ms) s->max_gap_ms = gap;
+    }
+    g_net_tm.last_snapshot_ms = now_ms;
+
+    s->players       = players;
+    s->bots          = bots;
+    s->world_objects = world_objects;
+    if (players > s->max_players)             s->max_players       = players;
+    if (bots > s->max_bots)                   s->max_bots          = bots;
+    if (world_objects > s->max_world_objects) s->max_world_objects = world_objects;
+}
+
+void net_telemetry_on_snapshot_skipped(void) {
+    g_net_tm.snap.skipped++;
+}
+
+void net_telemetry_on_input_sent(uint32_t sequence) {
+    SentInput* in = &g_net_tm.inputs[sequence % NET_TELEMETRY_INPUT_RING];
+    in->sequence = sequence;
+    in->sent_ms  = emscripten_get_now();
+    g_net_tm.last_sent = sequence;
+    g_net_tm.snap.inputs_sent++;
+    g_net_tm.snap.inputs_in_flight = g_net_tm.last_sent - g_net_tm.last_acked;
+}
+
+void net_telemetry_on_input_acked(uint32_t last_acked_sequence) {
+    if (last_acked_sequence <= g_net_tm.last_acked) return;
+    g_net_tm.last_acked = last_acked_sequence;
+
+    NetSnapshotStats* s = &g_net_tm.snap;
+    s->inputs_in_flight = (g_net_tm.last_sent > last_acked_sequence)
+                              ? g_net_tm.last_sent - last_acked_sequence : 0;
+
+    /* Only the newest acked input is timed; the ones it covers were acked
+     * by the same snapshot and would skew toward it. */
+    const SentInput* in = &g_net_tm.inputs[last_acked_sequence % NET_TELEMETRY_INPUT_RING];
+    if (in->sequence != last_acked_sequence) return;   /* sent before a reset or overwritten */
+    float rtt = (float)(emscripten_get_now() - in->sent_ms);
+    g_net_tm.timed_acks++;
+    s->last_ack_ms = rtt;
+    s->mean_ack_ms = ema(s->mean_ack_ms, rtt, g_net_tm.timed_acks);
+    if (rtt > s->max_ack_ms) s->max_ack_ms = rtt;
+}
+
+void net_telemetry_on_uplink_flush(int depth, size_t buffered_bytes, bool held) {
+    NetUplinkStats* u = &g_net_tm.uplink;
+    u->depth          = depth;
+    u->buffered_bytes = (uint32_t)buffered_bytes;
+    if (depth > u->max_depth)                     u->max_depth          = depth;
+    if (u->buffered_bytes > u->max_buffered_bytes) u->max_buffered_bytes = u->buffered_bytes;
+    if (held) u->held_flushes++;
+}
+
+void net_telemetry_on_uplink_coalesced(void) {
+    g_net_tm.uplink.coalesced++;
+}
+
+void net_telemetry_on_uplink_dropped(void) {
+    g_net_tm.uplink.dropped++;
+}
+
+const NetMsgStats* net_telemetry_binary(int kind) {
+    assert(0 <= kind && NET_TELEMETRY_BIN_KINDS > kind);
+    return &g_net_tm.bin[kind];
+}
+
+const NetMsgStats* net_telemetry_json(int kind) {
+    assert(0 <= kind && NET_TELEMETRY_JSON_KINDS > kind);
+    return &g_net_tm.json[kind];
+}
+
+const NetSnapshotStats* net_telemetry_snapshots(void) {
+    return &g_net_tm.snap;
+}
+
+const NetUplinkStats* net_telemetry_uplink(void) {
+    return &g_net_tm.uplink;
+}
+
+float net_telemetry_gap_edge_ms(int bucket) {
+    assert(0 <= bucket && NET_TELEMETRY_GAP_BUCKETS > bucket);
+    return (bucket < NET_TELEMETRY_GAP_BUCKETS - 1) ? kGapEdges[bucket] : 0.0f;
+}
+
+const char* net_telemetry_kind_name(bool is_text, int kind) {
+    const char* name = is_text ? kJsonNames[clamp_kind(kind, NET_TELEMETRY_JSON_KINDS)]
+                               : kBinNames[clamp_kind(kind, NET_TELEMETRY_BIN_KINDS)];
+    return name ? name : "other";
+}
+
+void net_telemetry_context_register(void) {
+    client_context_register(&g_net_tm, sizeof(g_net_tm), NULL);
+}
@@ -0,0 +1,101 @@
+#ifndef CYBERIA_NETWORK_NET_TELEMETRY_H
+#define CYBERIA_NETWORK_NET_TELEMETRY_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Downlink telemetry: what each message kind costs the client.
+ *
+ * game_client reports every WebSocket frame (wire kind, bytes and decode
+ * time); AOI snapshots additionally report their arrival and the entity
+ * counts they left in g_game_state. Replication reports each input sent and
+ * each ack the server echoes back, which gives the input round trip.
+ * game_client reports its uplink send queue after every flush.
+ *
+ * Always on — a few counters and a clock read per message — so field builds
+ * can be measured too. dev_ui shows a summary; js/profiler_bridge exports it.
+ * Everything resets with net_telemetry_reset() (on disconnect).
+ */
+
+/* Binary frames are keyed by their leading BIN_MSG_* byte; anything above
+ * this lands in the last slot. */
+#define NET_TELEMETRY_BIN_KINDS 24
+/* JSON frames by MessageType (message_parser.h). */
+#define NET_TELEMETRY_JSON_KINDS 16
+
+/* Snapshot inter-arrival histogram: bucket i holds gaps shorter than
+ * NET_TELEMETRY_GAP_EDGES_MS[i]; the last bucket is everything longer. */
+#define NET_TELEMETRY_GAP_BUCKETS 10
+#define NET_TELEMETRY_GAP_EDGES_MS { 10.0f, 20.0f, 33.3f, 50.0f, 66.7f, 100.0f, 150.0f, \
+                                     250.0f, 500.0f }
+
+typedef struct {
+    uint32_t count;
+    uint64_t bytes;
+    double   decode_us;      /* total */
+    float    max_decode_us;
+} NetMsgStats;
+
+typedef struct {
+    uint32_t snapshots;
+    uint32_t skipped;        /* superseded in the inbox by the decode throttle */
+    float    last_gap_ms;
+    float    mean_gap_ms;    /* exponential, 1/8 */
+    float    max_gap_ms;
+    uint32_t gap_hist[NET_TELEMETRY_GAP_BUCKETS];
+
+    /* Entities in g_game_state after the last snapshot, and the peak. */
+    int players, bots, world_objects;
+    int max_players, max_bots, max_world_objects;
+
+    /* Input round trip: send of `sequence` to the first snapshot acking it. */
+    float    last_ack_ms;
+    float    mean_ack_ms;    /* exponential, 1/8 */
+    float    max_ack_ms;
+    uint32_t inputs_sent;
+    uint32_t inputs_in_flight;  /* last sent - last acked */
+} NetSnapshotStats;
+
+/* Uplink send queue (network_uplink_flush in game_client.h). */
+typedef struct {
+    int      depth;              /* frames still queued after the last flush */
+    int      max_depth;
+    uint32_t buffered_bytes;     /* socket bufferedAmount seen by the last flush */
+    uint32_t max_buffered_bytes;
+    uint32_t held_flushes;       /* flushes that kept frames back for backpressure */
+    uint32_t coalesced;          /* movement frames superseded before sending */
+    uint32_t dropped;            /* frames refused on a full queue */
+} NetUplinkStats;
+
+void net_telemetry_reset(void);
+
+/* One downlink frame. `kind` is the BIN_MSG_* byte or the MessageType. */
+void net_telemetry_on_message(bool is_text, int kind, size_t bytes, double decode_us);
+
+/* An AOI snapshot was applied. `now_ms` is its arrival (emscripten_get_now). */
+void net_telemetry_on_snapshot(double now_ms, int players, int bots, int world_objects);
+/* An AOI snapshot was dropped undecoded (game_client's decode throttle). */
+void net_telemetry_on_snapshot_skipped(void);
+
+void net_telemetry_on_input_sent(uint32_t sequence);
+void net_telemetry_on_input_acked(uint32_t last_acked_sequence);
+
+void net_telemetry_on_uplink_flush(int depth, size_t buffered_bytes, bool held);
+void net_telemetry_on_uplink_coalesced(void);
+void net_telemetry_on_uplink_dropped(void);
+
+const NetMsgStats*      net_telemetry_binary(int kind);
+const NetMsgStats*      net_telemetry_json(int kind);
+const NetSnapshotStats* net_telemetry_snapshots(void);
+const NetUplinkStats*   net_telemetry_uplink(void);
+float                   net_telemetry_gap_edge_ms(int bucket);   /* upper edge; 0 for the last */
+
+/* Short label for a binary or JSON kind ("aoi_delta", "chat", ...). */
+const char* net_telemetry_kind_name(bool is_text, int kind);
+
+/* Each view keeps its own counters (client_context.h). */
+void net_telemetry_context_register(void);
+
+#endif /* CYBERIA_NETWORK_NET_TELEMETRY_H */
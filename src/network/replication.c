@@ -1,19 +1,28 @@
 #include "network/replication.h"
 
+#include "client_context.h"
 #include "game_state.h"
 #include "serial.h"
 #include "input/input_command.h"
 #include "input/input.h"
 #include "network/game_client.h"
+#include "network/net_telemetry.h"
+#include "nav_grid.h"
+#include "fidelity.h"
 #include "domain/local_player.h"
 #include "util/log.h"
+#include "util/ring.h"
+#include "util/vec_kernels.h"
+#include "job_system.h"
 #include "config.h"
 
 #include <raylib.h>
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
 #include <assert.h>
 #include <math.h>
+#include <string.h>
 
 static bool send_event_tap(Vector2 grid, uint32_t client_tick, uint32_t sequence) {
     BinWriter w;
@@ -21,21 +30,54 @@ static bool send_event_tap(Vector2 grid, uint32_t client_tick, uint32_t sequence
     return network_send_binary(w.buf, w.pos);
 }
 
-void replication_prepare_input(input_queue_t in_queue) {
-    // in_queue is a deep copy, safe to drain.
-    input_event_t evt = { 0 };
-    while (input_pop(&in_queue, &evt)) {
-        if (INPUT_TAP == evt.type) {
-            float cell = g_game_state.cell_size > 0.0f ? g_game_state.cell_size : 12.0f;
-            float gx = evt.world_position.x / cell;
-            float gy = evt.world_position.y / cell;
-            input_command_t cmd = input_command_build_tap(gx, gy);
-            prediction_enqueue_input(&cmd);
-            send_event_tap((Vector2){gx, gy}, cmd.client_tick, cmd.sequence);
-            g_game_state.player.tap_target     = (Vector2){gx, gy};
-            g_game_state.player.has_tap_target = true;
+/* Input batching state: when a batch last went out, and the newest sequence
+ * it carried (telemetry counts each sequence once, not per resend). */
+static struct {
+    double              sent_at;
+    cyberia_input_seq_t sent_sequence;
+} g_input_batch = {0};
+
+static void send_input_batch(bool fresh) {
+    double now = GetTime();
+    if (!fresh && INPUT_BATCH_RESEND_TICKS * TICK_DURATION_S > now - g_input_batch.sent_at) return;
+
+    input_command_t cmds[INPUT_BATCH_REDUNDANCY];
+    int count = prediction_unacked_tail(cmds, INPUT_BATCH_REDUNDANCY);
+    if (0 == count) return;
+
+    BinWriter w;
+    uplink_input_batch(&w, cmds, count);
+    if (!network_send_binary(w.buf, w.pos)) return;
+    g_input_batch.sent_at = now;
+    for (int i = 0; i < count; i++) {
+        if (cmds[i].sequence <= g_input_batch.sent_sequence) continue;
+        net_telemetry_on_input_sent(cmds[i].sequence);
+        g_input_batch.sent_sequence = cmds[i].sequence;
+    }
+}
+
+void replication_prepare_input(input_queue_t* in_queue) {
+    static_assert(INPUT_BATCH_REDUNDANCY <= UPLINK_INPUT_BATCH_MAX,
+                  "INPUT_BATCH_REDUNDANCY exceeds the UPLINK_INPUT_BATCH capacity");
+    bool batching = 0 != (g_game_state.wire_ack_caps & WIRE_CAP_INPUT_BATCH);
+    bool fresh    = false;
+
+    // Taps stay unconsumed: the tap effects read them after this stage.
+    for (input_event_t* evt = NULL; (evt = input_next(in_queue, evt, INPUT_TAP));) {
+        float cell = g_game_state.cell_size > 0.0f ? g_game_state.cell_size : 12.0f;
+        float gx = evt->world_position.x / cell;
+        float gy = evt->world_position.y / cell;
+        input_command_t cmd = input_command_build_tap(gx, gy);
+        prediction_enqueue_input(&cmd);
+        if (batching) {
+            fresh = true;
+        } else if (send_event_tap((Vector2){gx, gy}, cmd.client_tick, cmd.sequence)) {
+            net_telemetry_on_input_sent(cmd.sequence);
         }
+        g_game_state.player.tap_target     = (Vector2){gx, gy};
+        g_game_state.player.has_tap_target = true;
     }
+    if (batching) send_input_batch(fresh);
 }
 
 /* ── Session ───────────────────────────────────────────────────────────── */
@@ -44,22 +86,111 @@ void replication_prepare_input(input_queue_t in_queue) {
  * through the accessor functions in replication.h. */
 static struct {
     cyberia_tick_t       last_server_tick;
+    cyberia_tick_t       prev_server_tick;        /* tick of the snapshot before it */
     cyberia_input_seq_t  last_acked_input_sequence;
     cyberia_input_seq_t  next_input_sequence;
     double               last_snapshot_wall_time; /* GetTime() when snapshot arrived */
+    /* Inter-arrival estimator (EWMA, gain 1/8) and the window it drives. */
+    double               arrival_mean_ms;
+    double               arrival_var_ms2;
+    uint32_t             arrival_samples;
+    double               window_ms;
 } g_sess = {0};
 
+static double hinted_window_ms(void) {
+    int window_ms = g_game_state.interpolation_ms;
+    return (window_ms > 0) ? (double)window_ms : INTERP_TICKS * TICK_DURATION_S * 1000.0;
+}
+
+/* Fold one inter-arrival gap into the estimator and ease the window toward
+ * mean + K·stddev, so the render clock never jumps when the link changes. */
+static void session_track_arrival(double gap_ms) {
+    if (gap_ms > INTERP_WINDOW_MAX_MS) gap_ms = INTERP_WINDOW_MAX_MS; /* backgrounded tab */
+    if (0 == g_sess.arrival_samples) {
+        g_sess.arrival_mean_ms = gap_ms;
+        g_sess.window_ms       = hinted_window_ms();
+    }
+    double diff = gap_ms - g_sess.arrival_mean_ms;
+    g_sess.arrival_mean_ms += diff / 8.0;
+    g_sess.arrival_var_ms2  = (g_sess.arrival_var_ms2 + diff * diff / 8.0) * (7.0 / 8.0);
+    g_sess.arrival_samples++;
+    if (g_sess.arrival_samples < INTERP_ADAPT_MIN_SAMPLES) return;
+
+    double target = g_sess.arrival_mean_ms + INTERP_JITTER_K * sqrt(g_sess.arrival_var_ms2);
+    if (target < INTERP_WINDOW_MIN_MS) target = INTERP_WINDOW_MIN_MS;
+    if (target > INTERP_WINDOW_MAX_MS) target = INTERP_WINDOW_MAX_MS;
+    g_sess.window_ms += (target - g_sess.window_ms) / 16.0;
+}
+
 void session_on_snapshot(uint32_t snapshot_tick, uint32_t last_acked_sequence) {
     /* Monotonic by construction — drop out-of-order snapshots. The server
      * never decreases tick; UDP-like reordering could only matter on a
      * WebRTC fork. For WebSocket we still defend against bugs. */
     if (snapshot_tick >= g_sess.last_server_tick) {
+        double now = network_message_time();
+        if (snapshot_tick > g_sess.last_server_tick) {
+            if (0 != g_sess.last_server_tick) {
+                session_track_arrival((now - g_sess.last_snapshot_wall_time) * 1000.0);
+            }
+            g_sess.prev_server_tick = g_sess.last_server_tick;
+        }
         g_sess.last_server_tick        = snapshot_tick;
-        g_sess.last_snapshot_wall_time = GetTime();
+        g_sess.last_snapshot_wall_time = now;
     }
     if (last_acked_sequence > g_sess.last_acked_input_sequence) {
         g_sess.last_acked_input_sequence = last_acked_sequence;
+        net_telemetry_on_input_acked(last_acked_sequence);
+    }
+}
+
+/* Server clock offset from ping/pong (NTP-style): each pong gives the
+ * server tick at the midpoint of its round trip. The lowest-RTT sample of
+ * the window is the least skewed by queueing, so it sets the offset. */
+typedef struct {
+    double rtt_ms;
+    double offset;   /* server ticks minus local seconds × TICK_RATE_HZ */
+} ClockSample;
+
+static struct {
+    ClockSample samples[CLOCK_SYNC_SAMPLES];
+    int         count;
+    int         next;
+    bool        synced;
+    double      offset;
+    double      rtt_ms;
+} g_clock;
+
+void session_clock_reset(void) {
+    memset(&g_clock, 0, sizeof(g_clock));
+}
+
+void session_on_clock_pong(uint32_t client_ms, uint32_t server_tick, uint16_t tick_phase) {
+    double   now    = network_message_time();
+    uint32_t rtt_ms = (uint32_t)(now * 1000.0) - client_ms;   /* wraps with the clock */
+    if (CLOCK_SYNC_MAX_RTT_MS < rtt_ms) return;
+
+    double mid = now - (double)rtt_ms / 2000.0;
+    double server = (double)server_tick + (double)tick_phase / 65536.0;
+    g_clock.samples[g_clock.next] = (ClockSample){
+        .rtt_ms = (double)rtt_ms,
+        .offset = server - mid * (double)TICK_RATE_HZ,
+    };
+    g_clock.next = (g_clock.next + 1) % CLOCK_SYNC_SAMPLES;
+    if (CLOCK_SYNC_SAMPLES > g_clock.count) g_clock.count++;
+
+    const ClockSample* best = &g_clock.samples[0];
+    for (int i = 1; i < g_clock.count; i++) {
+        if (g_clock.samples[i].rtt_ms < best->rtt_ms) best = &g_clock.samples[i];
     }
+    double step = best->offset - g_clock.offset;
+    if (!g_clock.synced || fabs(step) > CLOCK_SYNC_STEP_TICKS) g_clock.offset = best->offset;
+    else                                                    g_clock.offset += step / 4.0;
+    g_clock.rtt_ms = best->rtt_ms;
+    g_clock.synced = true;
+}
+
+double session_clock_rtt_ms(void) {
+    return g_clock.synced ? g_clock.rtt_ms : -1.0;
 }
 
 cyberia_tick_t session_last_server_tick(void) {
@@ -70,27 +201,50 @@ cyberia_input_seq_t session_last_acked_input_sequence(void) {
     return g_sess.last_acked_input_sequence;
 }
 
-cyberia_tick_t session_server_tick_estimate(void) {
-    if (g_sess.last_server_tick == 0) return 0;
+/* Server clock in fractional ticks: from the clock offset once synced,
+ * otherwise extrapolated from the latest snapshot's arrival (which lags
+ * by the one-way latency and jumps with jitter). */
+static double server_time_estimate(void) {
+    if (g_clock.synced) return GetTime() * (double)TICK_RATE_HZ + g_clock.offset;
+    if (g_sess.last_server_tick == 0) return 0.0;
     double elapsed = GetTime() - g_sess.last_snapshot_wall_time;
     if (elapsed < 0.0) elapsed = 0.0;
-    uint32_t ticks_since = (uint32_t)(elapsed / TICK_DURATION_S);
-    return g_sess.last_server_tick + ticks_since;
+    return (double)g_sess.last_server_tick + elapsed / TICK_DURATION_S;
+}
+
+cyberia_tick_t session_server_tick_estimate(void) {
+    return (cyberia_tick_t)server_time_estimate();
+}
+
+static double window_ms_now(void) {
+    return (g_sess.arrival_samples < INTERP_ADAPT_MIN_SAMPLES) ? hinted_window_ms()
+                                                                : g_sess.window_ms;
+}
+
+int session_interp_window_ms(void) {
+    return (int)(window_ms_now() + 0.5);
+}
+
+double session_snapshot_jitter_ms(void) {
+    return sqrt(g_sess.arrival_var_ms2);
+}
+
+/* Render clock in fractional ticks: the server estimate minus the effective
+ * interpolation window expressed in ticks. Single source of truth with
+ * interpolation_compute_view, which samples entity histories at this time.
+ * Before the client-hints window is hydrated the hinted window is the
+ * compile-time INTERP_TICKS bootstrap. A synced clock reads the server's
+ * present, so half the round trip is taken off too: snapshots still need
+ * that long to get here. */
+static double render_time(void) {
+    double delay_ms = window_ms_now() + (g_clock.synced ? g_clock.rtt_ms / 2.0 : 0.0);
+    double offset   = delay_ms * (double)TICK_RATE_HZ / 1000.0;
+    double t = server_time_estimate() - offset;
+    return (t > 0.0) ? t : 0.0;
 }
 
 cyberia_tick_t session_render_tick(void) {
-    cyberia_tick_t est = session_server_tick_estimate();
-    /* Render-tick offset = the runtime interpolation window expressed in
-     * ticks. Single source of truth with interpolation_compute_view, which
-     * reads the same window in ms. Falls back to the compile-time bootstrap
-     * default until the client-hints window is hydrated. */
-    int window_ms = g_game_state.interpolation_ms;
-    uint32_t offset = (window_ms > 0)
-        ? (uint32_t)((window_ms * TICK_RATE_HZ + 500) / 1000)
-        : INTERP_TICKS;
-    if (0 == offset) { offset = INTERP_TICKS; }
-    if (est <= offset) { return 0; }
-    return est - offset;
+    return (cyberia_tick_t)render_time();
 }
 
 cyberia_input_seq_t session_next_input_sequence(void) {
@@ -114,45 +268,56 @@ cyberia_input_seq_t session_next_input_sequence(void) {
  * play (>1 s RTT at the tick rate leaves many commands in flight). */
 #define COMMAND_QUEUE_CAP 256
 
+/* Longest replay one reconcile runs (~2 s at 30 Hz); a prediction clock
+ * further ahead of the snapshot than this is re-anchored instead. */
+#define PREDICTION_MAX_REPLAY_TICKS 64
+
+/* Per-tick predicted positions kept for reconciliation; covers the longest
+ * replay. A snapshot within the epsilon (cells) of its checkpoint confirms
+ * the prediction and needs no replay. */
+#define PREDICTION_HISTORY_CAP 128
+#define PREDICTION_CHECKPOINT_EPSILON 1e-3f
+static_assert(PREDICTION_HISTORY_CAP > PREDICTION_MAX_REPLAY_TICKS,
+              "history must cover the longest replay");
+
+/* A command on the prediction timeline: it is the active movement target
+ * from start_tick until the next command's start_tick, so its simulated
+ * span is the gap between the two. Moves carry the route planned around
+ * obstacles from where the prediction stood when they were pushed. */
 typedef struct {
-    input_command_t items[PREDICTION_RING_CAP];
-    int head;
-    int count;
-} input_ring_t;
+    input_command_t cmd;
+    cyberia_tick_t  start_tick;
+    Vector2         origin;
+    Vector2         path[MAX_PATH_POINTS];
+    int             path_count;   /* -1: no route, walk straight at the target */
+} timeline_cmd_t;
 
 typedef struct {
-    input_command_t items[COMMAND_QUEUE_CAP];
-    int head;
-    int count;
-} command_queue_t;
+    cyberia_tick_t tick;
+    Vector2        pos;
+    bool           valid;
+} tick_checkpoint_t;
+
+RING_DEFINE(input_ring, timeline_cmd_t, PREDICTION_RING_CAP)
+RING_DEFINE(cmd_queue, input_command_t, COMMAND_QUEUE_CAP)
 
-static command_queue_t s_cmd_q = {0};
+static cmd_queue s_cmd_q = {0};
 
 void prediction_enqueue_input(const input_command_t* cmd) {
     assert(cmd);
-    if (s_cmd_q.count == COMMAND_QUEUE_CAP) {
-        LOG_WARN("input command queue full, dropping oldest");
-        s_cmd_q.head = (s_cmd_q.head + 1) % COMMAND_QUEUE_CAP;
-        s_cmd_q.count--;
+    if (cmd_queue_full(&s_cmd_q)) {
+        LOG_WARN_HOT("input command queue full, dropping oldest");
+        (void)cmd_queue_pop(&s_cmd_q);
     }
-    int idx = (s_cmd_q.head + s_cmd_q.count) % COMMAND_QUEUE_CAP;
-    s_cmd_q.items[idx] = *cmd;
-    s_cmd_q.count++;
+    *cmd_queue_push(&s_cmd_q) = *cmd;
 }
 
 static bool command_queue_pop(input_command_t* out) {
     if (0 == s_cmd_q.count) { return false; }
-    *out = s_cmd_q.items[s_cmd_q.head];
-    s_cmd_q.head = (s_cmd_q.head + 1) % COMMAND_QUEUE_CAP;
-    s_cmd_q.count--;
+    *out = cmd_queue_pop(&s_cmd_q);
     return true;
 }
 
-static void command_queue_clear(void) {
-    s_cmd_q.head  = 0;
-    s_cmd_q.count = 0;
-}
-
 static struct {
     Vector2       predicted_pos;
     Vector2       authoritative_pos;
@@ -161,59 +326,132 @@ static struct {
      * presentation layer so it can absorb corrections without breaking the
      * visual trajectory. Presentation-only; never read by the simulation. */
     Vector2       correction_accum;
-    input_ring_t  unacked;
+    /* Prediction clock in server ticks: the tick predicted_pos stands at.
+     * Advanced once per prediction_step, anchored to the snapshot ticks. */
+    cyberia_tick_t tick;
+    /* Newest acked command, still the active target until a newer one takes
+     * over — the server keeps walking toward it after the ack. */
+    timeline_cmd_t base;
+    bool           has_base;
+    input_ring  unacked;
+    /* Sequence of the command predicted_pos is walking and the index of its
+     * next waypoint. */
+    cyberia_input_seq_t walk_sequence;
+    int           walk_waypoint;
+    bool          walking;
+    /* predicted_pos at each recent tick, indexed by tick % CAP. */
+    tick_checkpoint_t history[PREDICTION_HISTORY_CAP];
     bool          initialised;
 } g_pred = {0};
 
-static void ring_clear(input_ring_t* r) {
-    r->head = 0;
-    r->count = 0;
+static void checkpoint_record(cyberia_tick_t tick, Vector2 pos) {
+    g_pred.history[tick % PREDICTION_HISTORY_CAP] =
+        (tick_checkpoint_t){ .tick = tick, .pos = pos, .valid = true };
+}
+
+/* Whether the prediction already stood at `pos` on `tick`. */
+static bool checkpoint_matches(cyberia_tick_t tick, Vector2 pos) {
+    const tick_checkpoint_t* ck = &g_pred.history[tick % PREDICTION_HISTORY_CAP];
+    if (!ck->valid || ck->tick != tick) return false;
+    return PREDICTION_CHECKPOINT_EPSILON >= fabsf(ck->pos.x - pos.x) &&
+           PREDICTION_CHECKPOINT_EPSILON >= fabsf(ck->pos.y - pos.y);
 }
 
-static void ring_push(input_ring_t* r, const input_command_t* cmd) {
-    if (r->count == PREDICTION_RING_CAP) {
-        LOG_WARN("prediction replay buffer overflow at %u — dropping oldest",
+static void ring_push(input_ring* r, const timeline_cmd_t* entry) {
+    if (input_ring_full(r)) {
+        LOG_WARN_HOT("prediction replay buffer overflow at %u — dropping oldest",
                  (unsigned)PREDICTION_RING_CAP);
-        r->head = (r->head + 1) % PREDICTION_RING_CAP;
-        r->count--;
+        g_pred.base     = input_ring_pop(r);
+        g_pred.has_base = true;
     }
-    int idx = (r->head + r->count) % PREDICTION_RING_CAP;
-    r->items[idx] = *cmd;
-    r->count++;
+    *input_ring_push(r) = *entry;
 }
 
-static void ring_drop_acked(input_ring_t* r, cyberia_input_seq_t ack) {
-    while (r->count > 0) {
-        if (r->items[r->head].sequence > ack) break;
-        r->head = (r->head + 1) % PREDICTION_RING_CAP;
-        r->count--;
+static const timeline_cmd_t* ring_at(input_ring* r, int i) {
+    return input_ring_at(r, i);
+}
+
+/* Drop acked commands; the newest of them becomes the timeline base. */
+static void ring_drop_acked(input_ring* r, cyberia_input_seq_t ack) {
+    while (r->count > 0 && input_ring_at(r, 0)->cmd.sequence <= ack) {
+        g_pred.base     = input_ring_pop(r);
+        g_pred.has_base = true;
     }
 }
 
-/* Step one tick toward the command target. Mirrors server's phaseMovement:
+/* Command active at the newest end of the timeline, or NULL. */
+static const timeline_cmd_t* active_entry(void) {
+    if (g_pred.unacked.count > 0) return ring_at(&g_pred.unacked, g_pred.unacked.count - 1);
+    return g_pred.has_base ? &g_pred.base : NULL;
+}
+
+/* Step one tick toward target. Mirrors server's phaseMovement:
  *
  *   step = move_speed * tickDuration            (cells per tick)
  *   if dist < step: snap; else: walk along direction
  *
  * Both client and server use double-precision sqrt so identical inputs
  * produce byte-identical positions. */
-static Vector2 sim_step_one(Vector2 pos, const input_command_t* cmd, double dt) {
-    if (cmd->kind != INPUT_KIND_PLAYER_ACTION) return pos;
-    double dx = (double)cmd->target_x - (double)pos.x;
-    double dy = (double)cmd->target_y - (double)pos.y;
+static Vector2 sim_step_toward(Vector2 pos, Vector2 target, double dt) {
+    double dx = (double)target.x - (double)pos.x;
+    double dy = (double)target.y - (double)pos.y;
     double dist = sqrt(dx * dx + dy * dy);
     if (dist < 1e-4) return pos;
     double speed = (double)local_player_move_speed();
     double step  = speed * dt;
-    if (step > dist) step = dist;
+    if (step > dist) return target;
     pos.x = (float)((double)pos.x + (dx / dist) * step);
     pos.y = (float)((double)pos.y + (dy / dist) * step);
     return pos;
 }
 
+static float segment_distance_sq(Vector2 p, Vector2 a, Vector2 b) {
+    float abx = b.x - a.x, aby = b.y - a.y;
+    float len_sq = abx * abx + aby * aby;
+    float t = 0.0f;
+    if (0.0f < len_sq) {
+        t = ((p.x - a.x) * abx + (p.y - a.y) * aby) / len_sq;
+        t = t < 0.0f ? 0.0f : (t > 1.0f ? 1.0f : t);
+    }
+    float dx = a.x + abx * t - p.x, dy = a.y + aby * t - p.y;
+    return dx * dx + dy * dy;
+}
+
+/* Waypoint to head for when `e` takes over at pos: the end of the route
+ * segment pos lies closest to. Replays start from the server position, not
+ * the route's origin, so the walk resumes where pos is along it. */
+static int path_resume(const timeline_cmd_t* e, Vector2 pos) {
+    int best = 0;
+    float best_d = INFINITY;
+    Vector2 from = e->origin;
+    for (int i = 0; i < e->path_count; i++) {
+        float d = segment_distance_sq(pos, from, e->path[i]);
+        if (d < best_d) {
+            best_d = d;
+            best   = i;
+        }
+        from = e->path[i];
+    }
+    return best;
+}
+
+/* One tick of `e`: along its route a waypoint at a time, else straight at
+ * its target. Non-move commands hold position. */
+static Vector2 sim_step_one(Vector2 pos, const timeline_cmd_t* e, int* waypoint, double dt) {
+    if (e->cmd.kind != INPUT_KIND_PLAYER_ACTION) return pos;
+    if (0 >= e->path_count) {
+        return sim_step_toward(pos, (Vector2){ e->cmd.target_x, e->cmd.target_y }, dt);
+    }
+    if (*waypoint >= e->path_count) return pos;
+    Vector2 target = e->path[*waypoint];
+    pos = sim_step_toward(pos, target, dt);
+    if (pos.x == target.x && pos.y == target.y) (*waypoint)++;
+    return pos;
+}
+
 void prediction_init(void) {
     if (g_pred.initialised) return;
-    ring_clear(&g_pred.unacked);
+    input_ring_clear(&g_pred.unacked);
     g_pred.initialised = true;
 }
 
@@ -221,46 +459,125 @@ void prediction_reset(Vector2 authoritative_pos) {
     g_pred.authoritative_pos = authoritative_pos;
     g_pred.predicted_pos     = authoritative_pos;
     g_pred.correction_accum  = (Vector2){ 0.0f, 0.0f };
-    ring_clear(&g_pred.unacked);
-    command_queue_clear();
+    g_pred.tick              = 0;
+    g_pred.has_base          = false;
+    g_pred.walking           = false;
+    memset(g_pred.history, 0, sizeof(g_pred.history));
+    input_ring_clear(&g_pred.unacked);
+    cmd_queue_clear(&s_cmd_q);
+}
+
+/* Put a command on the timeline, active from the next simulated tick. */
+static void timeline_push(const input_command_t* cmd) {
+    timeline_cmd_t entry = {
+        .cmd        = *cmd,
+        .start_tick = g_pred.tick + 1,
+        .origin     = g_pred.predicted_pos,
+        .path_count = -1,
+    };
+    if (INPUT_KIND_PLAYER_ACTION == cmd->kind) {
+        entry.path_count = nav_grid_find_path(g_pred.predicted_pos,
+                                              (Vector2){ cmd->target_x, cmd->target_y },
+                                              entry.path, MAX_PATH_POINTS);
+    }
+    ring_push(&g_pred.unacked, &entry);
 }
 
 bool prediction_apply(const input_command_t* cmd) {
     if (!cmd) return false;
-    ring_push(&g_pred.unacked, cmd);
-    g_pred.predicted_pos = sim_step_one(g_pred.predicted_pos, cmd, TICK_DURATION_S);
+    timeline_push(cmd);
     return true;
 }
 
 void prediction_step(double tick_dt) {
     /* Drain newly produced input commands. This is the single point where the
      * prediction module consumes input; the replication layer is the producer
-     * via prediction_enqueue_input(). */
+     * via prediction_enqueue_input(). Commands drained together all start on
+     * this tick, so only the newest of them moves the player. */
     input_command_t cmd;
     while (command_queue_pop(&cmd)) {
-        ring_push(&g_pred.unacked, &cmd);
-        g_pred.predicted_pos = sim_step_one(g_pred.predicted_pos, &cmd, TICK_DURATION_S);
+        timeline_push(&cmd);
     }
 
-    if (g_pred.unacked.count == 0) return;
-    int latest = (g_pred.unacked.head + g_pred.unacked.count - 1) % PREDICTION_RING_CAP;
-    g_pred.predicted_pos = sim_step_one(g_pred.predicted_pos, &g_pred.unacked.items[latest], tick_dt);
+    g_pred.tick++;
+    const timeline_cmd_t* active = active_entry();
+    if (active) {
+        if (!g_pred.walking || active->cmd.sequence != g_pred.walk_sequence) {
+            g_pred.walking       = true;
+            g_pred.walk_sequence = active->cmd.sequence;
+            g_pred.walk_waypoint = path_resume(active, g_pred.predicted_pos);
+        }
+        g_pred.predicted_pos = sim_step_one(g_pred.predicted_pos, active, &g_pred.walk_waypoint, tick_dt);
+    }
+    checkpoint_record(g_pred.tick, g_pred.predicted_pos);
 }
 
+/* Rebase on the snapshot and replay exactly the ticks between the snapshot
+ * tick and the prediction clock. Each tick walks toward the command active
+ * at that tick (the newest one that had started by then), so a command that
+ * was the target for n ticks is replayed for n ticks, not one.
+ *
+ * Snapshots that agree with the checkpoint recorded for their tick skip the
+ * replay: the ticks after it would walk the same path again. A diverging
+ * snapshot replays from its tick and rewrites the checkpoints after it. */
 void prediction_reconcile(void) {
     g_pred.authoritative_pos = g_game_state.player.base.pos_server;
     ring_drop_acked(&g_pred.unacked, session_last_acked_input_sequence());
 
+    cyberia_tick_t snapshot_tick = session_last_server_tick();
+    bool anchored = true;
+    if (g_pred.tick < snapshot_tick || g_pred.tick - snapshot_tick > PREDICTION_MAX_REPLAY_TICKS) {
+        anchored = false;
+        /* First snapshot, a stall, or a backgrounded tab: re-anchor. */
+        cyberia_tick_t estimate = session_server_tick_estimate();
+        g_pred.tick = estimate > snapshot_tick ? estimate : snapshot_tick;
+        if (g_pred.tick - snapshot_tick > PREDICTION_MAX_REPLAY_TICKS) {
+            g_pred.tick = snapshot_tick + PREDICTION_MAX_REPLAY_TICKS;
+        }
+    }
+
+    if (anchored && checkpoint_matches(snapshot_tick, g_pred.authoritative_pos)) return;
+
     Vector2 rebased = g_pred.authoritative_pos;
-    for (int i = 0; i < g_pred.unacked.count; i++) {
-        int idx = (g_pred.unacked.head + i) % PREDICTION_RING_CAP;
-        rebased = sim_step_one(rebased, &g_pred.unacked.items[idx], TICK_DURATION_S);
+    checkpoint_record(snapshot_tick, rebased);
+    const timeline_cmd_t* active = g_pred.has_base ? &g_pred.base : NULL;
+    int waypoint = active ? path_resume(active, rebased) : 0;
+    int next = 0;
+    for (cyberia_tick_t t = snapshot_tick + 1; t <= g_pred.tick; t++) {
+        while (next < g_pred.unacked.count && ring_at(&g_pred.unacked, next)->start_tick <= t) {
+            active   = ring_at(&g_pred.unacked, next);
+            waypoint = path_resume(active, rebased);
+            next++;
+        }
+        if (active) rebased = sim_step_one(rebased, active, &waypoint, TICK_DURATION_S);
+        checkpoint_record(t, rebased);
+    }
+    g_pred.walking = NULL != active;
+    if (active) {
+        g_pred.walk_sequence = active->cmd.sequence;
+        g_pred.walk_waypoint = waypoint;
     }
     g_pred.correction_accum.x += rebased.x - g_pred.predicted_pos.x;
     g_pred.correction_accum.y += rebased.y - g_pred.predicted_pos.y;
     g_pred.predicted_pos = rebased;
 }
 
+int prediction_unacked_tail(input_command_t* out, int k) {
+    assert(out);
+    assert(0 < k);
+    cyberia_input_seq_t ack = session_last_acked_input_sequence();
+    int total = g_pred.unacked.count + s_cmd_q.count;
+    int count = 0;
+    for (int i = total > k ? total - k : 0; i < total; i++) {
+        const input_command_t* cmd =
+            i < g_pred.unacked.count
+                ? &ring_at(&g_pred.unacked, i)->cmd
+                : cmd_queue_at(&s_cmd_q, i - g_pred.unacked.count);
+        if (cmd->sequence > ack) out[count++] = *cmd;
+    }
+    return count;
+}
+
 /* Raw predicted simulation position. Discrete at sim-tick granularity by
  * design — visual smoothing is the presentation layer's job
  * (domain/local_player_view). */
@@ -276,41 +593,213 @@ Vector2 prediction_consume_correction(void) {
 
 /* Render-time interpolation of remote entities (Gambetta Part III).
  *
- * Each entity carries `pos_prev`, `pos_server`, and `snapshot_time` —
- * the wall-clock instant the snapshot that produced pos_server arrived.
- * Interpolating per-entity instead of per-snapshot tolerates batched or
- * jittered AOI delivery without leaving stale positions in place.
+ * Each binary-decoded entity keeps a short history of server positions
+ * stamped with the AOI snapshot tick that carried them. The view samples
+ * that history at render_time() — the server clock minus the interpolation
+ * window — so the lerp runs on the server's timeline and bursty delivery
+ * only changes how far ahead of the render tick the history reaches, not
+ * the speed entities move at. Past the newest sample — a late snapshot —
+ * the entity dead-reckons along its last two samples for at most
+ * INTERP_EXTRAPOLATE_MS, then holds.
+ *
+ * Entities without history (JSON path) fall back to the per-entity
+ * wall-clock alpha:
  *
- *   t = (now - entity.snapshot_time) * 1000 / interpolation_ms
- *   clamped to [0, 1]
+ *   t = (now - entity.snapshot_time) * 1000 / session_interp_window_ms()
+ *   clamped to [0, 1 + INTERP_EXTRAPOLATE_MS / window]
  *
- * For entities that were teleported (mode == TELEPORTING in the decoder)
- * pos_prev was already snapped to the new server position, so the lerp
- * produces an immediate jump.
+ * When the snapshot that was late lands, the gap between the extrapolated
+ * and the freshly sampled position becomes interp_error, which is shown on
+ * top of the sample and decays with INTERP_ERROR_DECAY_MS, so the
+ * correction glides instead of snapping. Teleports reset the history to
+ * the landing sample and drop the error, so the jump is immediate.
  */
 
+static PosSample* history_newest(SnapshotHistory* h) {
+    return &h->samples[(h->head + h->count - 1) % SNAPSHOT_HISTORY_CAP];
+}
+
+static void history_push(SnapshotHistory* h, cyberia_tick_t tick, Vector2 pos) {
+    if (SNAPSHOT_HISTORY_CAP == h->count) {
+        h->head = (uint8_t)((h->head + 1) % SNAPSHOT_HISTORY_CAP);
+        h->count--;
+    }
+    h->samples[(h->head + h->count) % SNAPSHOT_HISTORY_CAP] = (PosSample){ .tick = tick, .pos = pos };
+    h->count++;
+}
+
+void interpolation_record_snapshot(EntityState* e, bool reset) {
+    assert(e);
+    SnapshotHistory* h = &e->history;
+    cyberia_tick_t tick = g_sess.last_server_tick;
+    if (reset) {
+        h->head  = 0;
+        h->count = 0;
+        e->interp_error         = (Vector2){ 0.0f, 0.0f };
+        e->interp_extrapolating = false;
+    }
+    if (h->count > 0) {
+        PosSample* newest = history_newest(h);
+        if (newest->tick >= tick) {
+            newest->pos = e->pos_server;
+            return;
+        }
+        /* Left out of the delta frames in between, so it stood still until
+         * the previous snapshot — hold there instead of drifting the gap. */
+        if (newest->tick < g_sess.prev_server_tick) {
+            history_push(h, g_sess.prev_server_tick, newest->pos);
+        }
+    }
+    history_push(h, tick, e->pos_server);
+}
+
+/* Samples bracketing fractional tick `t` (ticks strictly increase) and the
+ * lerp weight between them; clamped to the oldest sample. Past the newest
+ * the last two samples are returned with a weight above 1, so the lerp
+ * extrapolates, up to `horizon` ticks beyond the newest. */
+static float history_bracket(const SnapshotHistory* h, double t, double horizon,
+                             Vector2* from, Vector2* to) {
+    const PosSample* older = &h->samples[h->head];
+    *from = *to = older->pos;
+    if (t <= (double)older->tick) return 0.0f;
+    for (int i = 1; i < h->count; i++) {
+        const PosSample* newer = &h->samples[(h->head + i) % SNAPSHOT_HISTORY_CAP];
+        if (t < (double)newer->tick) {
+            *to = newer->pos;
+            return (float)((t - (double)older->tick) / (double)(newer->tick - older->tick));
+        }
+        older = newer;
+    }
+    *from = *to = older->pos;
+    if (2 > h->count) return 0.0f;
+    const PosSample* prev = &h->samples[(h->head + h->count - 2) % SNAPSHOT_HISTORY_CAP];
+    double newest = (double)older->tick;
+    if (t > newest + horizon) t = newest + horizon;
+    *from = prev->pos;
+    return (float)((t - (double)prev->tick) / (newest - (double)prev->tick));
+}
+
 static inline float compute_alpha_for(double now, double snapshot_time, int window_ms) {
     if (window_ms <= 0) return 1.0f;
-    double t = (now - snapshot_time) * 1000.0 / (double)window_ms;
+    double t   = (now - snapshot_time) * 1000.0 / (double)window_ms;
+    double max = 1.0 + (double)INTERP_EXTRAPOLATE_MS / (double)window_ms;
     if (t < 0.0) t = 0.0;
-    if (t > 1.0) t = 1.0;
+    if (t > max) t = max;
     return (float)t;
 }
 
-void interpolation_compute_view(void) {
-    const double now = GetTime();
-    const int window_ms = g_game_state.interpolation_ms;
-
-    for (int i = 0; i < g_game_state.other_player_count; i++) {
-        PlayerState* p = &g_game_state.other_players[i];
-        float t = compute_alpha_for(now, p->base.snapshot_time, window_ms);
-        p->base.interp_pos.x = p->base.pos_prev.x + (p->base.pos_server.x - p->base.pos_prev.x) * t;
-        p->base.interp_pos.y = p->base.pos_prev.y + (p->base.pos_server.y - p->base.pos_prev.y) * t;
+/* Entities per parallel_for chunk of interpolation. */
+#define INTERP_GRAIN 128
+
+typedef struct {
+    EntityHotSet* hot;
+    char*         records;   /* other_players / bots, for interp_pos */
+    size_t        stride;
+    double        now;
+    double        render_t;
+    double        horizon;   /* extrapolation bound, in ticks */
+    float         decay;     /* interp_error factor for this frame */
+    int           window_ms;
+    unsigned      parity;    /* far-tier entities of this parity skip the frame */
+} InterpJob;
+
+/* Interpolate hot entries [begin, end) in place. The per-entity part —
+ * picking the two endpoints and the weight — is branchy and stays scalar;
+ * the lerp itself runs as one vk_lerp pass per axis over the packed
+ * endpoints. Chunks touch disjoint indices of the shared scratch. Entities
+ * in the far fidelity tier are recomputed on alternate frames and hold
+ * their shown position in between. */
+static void interpolate_range(int begin, int end, void* ctx) {
+    static float from_x[MAX_ENTITIES], from_y[MAX_ENTITIES];
+    static float to_x[MAX_ENTITIES],   to_y[MAX_ENTITIES];
+    static float weight[MAX_ENTITIES];
+    static bool  held[MAX_ENTITIES];
+    const InterpJob* job = ctx;
+    EntityHotSet* hot = job->hot;
+
+    for (int i = begin; i < end; i++) {
+        held[i] = ((unsigned)i & 1u) == job->parity &&
+                  FIDELITY_FAR == fidelity_tier((Vector2){ hot->x[i], hot->y[i] },
+                                                (Vector2){ hot->w[i], hot->h[i] });
+        if (held[i]) {
+            weight[i] = 0.0f;
+            from_x[i] = to_x[i] = hot->x[i];
+            from_y[i] = to_y[i] = hot->y[i];
+        } else if (hot->history[i].count > 0) {
+            Vector2 from, to;
+            weight[i] = history_bracket(&hot->history[i], job->render_t, job->horizon,
+                                        &from, &to);
+            from_x[i] = from.x; from_y[i] = from.y;
+            to_x[i]   = to.x;   to_y[i]   = to.y;
+        } else {
+            weight[i] = compute_alpha_for(job->now, hot->snapshot_time[i], job->window_ms);
+            from_x[i] = hot->prev_x[i];   from_y[i] = hot->prev_y[i];
+            to_x[i]   = hot->server_x[i]; to_y[i]   = hot->server_y[i];
+        }
     }
-    for (int i = 0; i < g_game_state.bot_count; i++) {
-        BotState* b = &g_game_state.bots[i];
-        float t = compute_alpha_for(now, b->base.snapshot_time, window_ms);
-        b->base.interp_pos.x = b->base.pos_prev.x + (b->base.pos_server.x - b->base.pos_prev.x) * t;
-        b->base.interp_pos.y = b->base.pos_prev.y + (b->base.pos_server.y - b->base.pos_prev.y) * t;
+    int n = end - begin;
+    vk_lerp(hot->x + begin, from_x + begin, to_x + begin, weight + begin, n);
+    vk_lerp(hot->y + begin, from_y + begin, to_y + begin, weight + begin, n);
+    for (int i = begin; i < end; i++) {
+        EntityState* e = (EntityState*)(job->records + (size_t)i * job->stride);
+        e->interp_error.x *= job->decay;
+        e->interp_error.y *= job->decay;
+        if (held[i]) continue;
+        const SnapshotHistory* h = &hot->history[i];
+        double basis = (h->count > 0)
+            ? (double)h->samples[(h->head + h->count - 1) % SNAPSHOT_HISTORY_CAP].tick
+            : hot->snapshot_time[i];
+        if (basis != e->interp_basis) {
+            /* Fresh sample: keep showing where the guess put the entity. */
+            if (e->interp_extrapolating) {
+                e->interp_error = (Vector2){ e->interp_pos.x - hot->x[i],
+                                             e->interp_pos.y - hot->y[i] };
+            }
+            e->interp_basis = basis;
+        }
+        e->interp_extrapolating = weight[i] > 1.0f;
+        hot->x[i] += e->interp_error.x;
+        hot->y[i] += e->interp_error.y;
+        e->interp_pos = (Vector2){ hot->x[i], hot->y[i] };
     }
 }
+
+void interpolation_compute_view(void) {
+    EntityHotSet* players = &g_game_state.player_hot;
+    EntityHotSet* bots    = &g_game_state.bot_hot;
+    assert(players->count == g_game_state.other_player_count);
+    assert(bots->count == g_game_state.bot_count);
+    static_assert(0 == offsetof(PlayerState, base) && 0 == offsetof(BotState, base),
+                  "records start with their EntityState");
+
+    static double   s_last_view;
+    static unsigned s_frames;
+    double now = GetTime();
+    double dt  = (s_last_view > 0.0 && now > s_last_view) ? now - s_last_view : 0.0;
+    s_last_view = now;
+
+    InterpJob job = {
+        .hot       = players,
+        .records   = (char*)g_game_state.other_players,
+        .stride    = sizeof(PlayerState),
+        .now       = now,
+        .render_t  = render_time(),
+        .horizon   = INTERP_EXTRAPOLATE_MS * (double)TICK_RATE_HZ / 1000.0,
+        .decay     = (float)exp(-dt * 1000.0 / INTERP_ERROR_DECAY_MS),
+        .window_ms = session_interp_window_ms(),
+        .parity    = s_frames++ & 1u,
+    };
+    parallel_for(players->count, INTERP_GRAIN, interpolate_range, &job);
+    job.hot     = bots;
+    job.records = (char*)g_game_state.bots;
+    job.stride  = sizeof(BotState);
+    parallel_for(bots->count, INTERP_GRAIN, interpolate_range, &job);
+}
+
+void replication_context_register(void) {
+    client_context_register(&g_input_batch, sizeof(g_input_batch), NULL);
+    client_context_register(&g_sess,        sizeof(g_sess),        NULL);
+    client_context_register(&g_clock,       sizeof(g_clock),       NULL);
+    client_context_register(&s_cmd_q,       sizeof(s_cmd_q),       NULL);
+    client_context_register(&g_pred,        sizeof(g_pred),        NULL);
+}
@@ -3,6 +3,7 @@
 
 #include "input/input.h"
 #include "input/input_command.h"
+#include "world_types.h"
 
 #include <stdbool.h>
 #include <stdint.h>
@@ -11,15 +12,19 @@
 /*
  * Client→server input replication.
  *
- * Drains the per-frame input event queue, builds typed input commands, applies
+ * Reads the per-frame input event queue, builds typed input commands, applies
  * them to the prediction replay buffer, and ships them on the wire. This is the
  * single uplink path for player actions; it sits above the raw WebSocket I/O
  * owned by game_client and below the main loop that captures input.
  */
 
-/* Drain a (deep-copied) frame input queue: per tap, build the command, enqueue
- * it for prediction, send it to the server, and set the local on-tap target. */
-void replication_prepare_input(input_queue_t in_queue);
+/* Walk the frame's unconsumed taps, leaving them unconsumed: per tap, build the command, enqueue
+ * it for prediction, send it to the server, and set the local on-tap target.
+ * Once the server accepts WIRE_CAP_INPUT_BATCH, the frame's taps go out as
+ * one UPLINK_INPUT_BATCH carrying the newest unacked commands, resent on a
+ * short interval until acked, so a late or lost frame does not stall
+ * reconciliation. */
+void replication_prepare_input(input_queue_t* in_queue);
 
 
 // WIP
@@ -29,8 +34,15 @@ void prediction_init(void);
 void prediction_reset(Vector2 authoritative_pos);
 bool prediction_apply(const input_command_t* cmd);
 void prediction_enqueue_input(const input_command_t* cmd);
+/* Advance the prediction clock one server tick: new commands start on it and
+ * the active command (the newest one) is stepped exactly once. */
 void prediction_step(double tick_dt);
+/* Rebase on the snapshot and replay each tick since the snapshot's server
+ * tick toward the command active at that tick. */
 void prediction_reconcile(void);
+/* Newest (at most k) commands past the acked sequence — replay ring, then
+ * commands not yet stepped — oldest first. Returns how many were written. */
+int prediction_unacked_tail(input_command_t* out, int k);
 Vector2 prediction_self_position(void);
 /* Net reconciliation displacement since the last call (then zeroed). Consumed
  * once per render frame by the local-player presentation layer, which absorbs
@@ -40,6 +52,9 @@ Vector2 prediction_consume_correction(void);
 /* Interpolation — render-time smoothing of remote entities (sole writer of
  * EntityState.interp_pos; never the local player). */
 void interpolation_compute_view(void);
+/* Stamp e->pos_server into e->history at the latest snapshot tick. `reset`
+ * (first sighting, teleport) drops older samples so the jump is never lerped. */
+void interpolation_record_snapshot(EntityState* e, bool reset);
 
 /* Session — per-connection tick + acknowledgement bookkeeping (sole writer). */
 void session_on_snapshot(uint32_t snapshot_tick, uint32_t last_acked_sequence);
@@ -47,6 +62,25 @@ cyberia_tick_t session_last_server_tick(void);
 cyberia_input_seq_t session_last_acked_input_sequence(void);
 cyberia_tick_t session_server_tick_estimate(void);
 cyberia_tick_t session_render_tick(void);
+/* Effective interpolation window in ms, tuned per connection from snapshot
+ * inter-arrival statistics; the hinted interpolation_ms until enough arrivals
+ * were measured. */
+int session_interp_window_ms(void);
+/* Standard deviation of snapshot inter-arrival time in ms (dev overlay). */
+double session_snapshot_jitter_ms(void);
+/* Clock sync: feed one BIN_MSG_CLOCK_PONG (at network_message_time()).
+ * Once a pong was taken, the tick estimates run off the filtered server
+ * clock offset instead of the newest snapshot's arrival. */
+void session_on_clock_pong(uint32_t client_ms, uint32_t server_tick, uint16_t tick_phase);
+/* Drop the clock samples, e.g. for a new connection. */
+void session_clock_reset(void);
+/* Round trip of the sample the offset comes from, in ms; negative while
+ * the estimate still runs off snapshot arrivals. */
+double session_clock_rtt_ms(void);
 cyberia_input_seq_t session_next_input_sequence(void);
 
+/* Hand session, clock, prediction and command-queue state to
+ * client_context. */
+void replication_context_register(void);
+
 #endif /* CYBERIA_NETWORK_REPLICATION_H */
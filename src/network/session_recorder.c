@@ -0,0 +1,165 @@
+#include "network/session_recorder.h"
+
+#include "util/log.h"
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <emscripten/emscripten.h>
+
+static struct {
+    bool     active;
+    bool     truncated;
+    uint8_t* buf;
+    size_t   len;
+    size_t   cap;        /* allocated */
+    size_t   limit;      /* cap_bytes */
+    double   start_ms;
+    uint32_t records;
+} g_rec;
+
+static bool reserve(size_t n) {
+    if (g_rec.len + n > g_rec.limit) return false;
+    if (g_rec.len + n <= g_rec.cap) return true;
+    size_t cap = g_rec.cap ? g_rec.cap : 64 * 1024;
+    while (cap < g_rec.len + n) cap *= 2;
+    if (cap > g_rec.limit) cap = g_rec.limit;
+    uint8_t* grown = realloc(g_rec.buf, cap);
+    if (!grown) return false;
+    g_rec.buf = grown;
+    g_rec.cap = cap;
+    return true;
+}
+
+static void put(const void* src, size_t n) {
+    memcpy(g_rec.buf + g_rec.len, src, n);
+    g_rec.len += n;
+}
+
+static void put_u16(uint16_t v) {
+    uint8_t b[2] = { (uint8_t)v, (uint8_t)(v >> 8) };
+    put(b, sizeof(b));
+}
+
+static void put_u32(uint32_t v) {
+    uint8_t b[4] = { (uint8_t)v, (uint8_t)(v >> 8), (uint8_t)(v >> 16), (uint8_t)(v >> 24) };
+    put(b, sizeof(b));
+}
+
+static void put_f64(double d) {
+    uint64_t bits;
+    memcpy(&bits, &d, sizeof(bits));
+    put_u32((uint32_t)bits);
+    put_u32((uint32_t)(bits >> 32));
+}
+
+static void append(SessionRecordKind kind, const char* id, size_t id_len,
+                   const void* data, size_t size) {
+    if (!g_rec.active) return;
+    assert(UINT16_MAX >= id_len && UINT32_MAX >= size);
+    if (!reserve(SESSION_RECORD_HEADER + id_len + size)) {
+        LOG_WARN("session recording stopped at %zu bytes, %u records",
+                 g_rec.len, (unsigned)g_rec.records);
+        g_rec.truncated = true;
+        g_rec.active    = false;
+        return;
+    }
+    uint8_t k = (uint8_t)kind;
+    put(&k, 1);
+    put_f64(emscripten_get_now() - g_rec.start_ms);
+    put_u16((uint16_t)id_len);
+    put_u32((uint32_t)size);
+    if (id_len) put(id, id_len);
+    if (size)   put(data, size);
+    g_rec.records++;
+}
+
+void session_recorder_start(size_t cap_bytes) {
+    session_recorder_clear();
+    g_rec.limit    = cap_bytes ? cap_bytes : SESSION_RECORDER_DEFAULT_CAP;
+    g_rec.start_ms = emscripten_get_now();
+    g_rec.active   = reserve(SESSION_RECORD_MAGIC_LEN);
+    if (!g_rec.active) {
+        LOG_ERROR("session recording: cannot reserve %zu bytes", g_rec.limit);
+        return;
+    }
+    put(SESSION_RECORD_MAGIC, SESSION_RECORD_MAGIC_LEN);
+    LOG_INFO("session recording started (cap %zu KB)", g_rec.limit / 1024);
+}
+
+void session_recorder_stop(void) {
+    if (!g_rec.active) return;
+    g_rec.active = false;
+    LOG_INFO("session recording stopped: %zu bytes, %u records",
+             g_rec.len, (unsigned)g_rec.records);
+}
+
+bool session_recorder_active(void) { return g_rec.active; }
+
+void session_recorder_on_ws(const uint8_t* data, uint32_t length, bool is_text) {
+    append(is_text ? SESSION_RECORD_WS_TEXT : SESSION_RECORD_WS_BINARY, NULL, 0, data, length);
+}
+
+void session_recorder_on_fetch(const char* asset_id, const void* data, size_t size) {
+    assert(asset_id);
+    append(SESSION_RECORD_FETCH, asset_id, strlen(asset_id), data, size);
+}
+
+void session_recorder_on_fetch_bulk(const char* batch_name, const void* data, size_t size) {
+    assert(batch_name);
+    append(SESSION_RECORD_FETCH_BULK, batch_name, strlen(batch_name), data, size);
+}
+
+const uint8_t* session_recorder_data(size_t* size) {
+    assert(size);
+    *size = g_rec.len;
+    return g_rec.buf;
+}
+
+uint32_t session_recorder_record_count(void) { return g_rec.records; }
+
+bool session_recorder_truncated(void) { return g_rec.truncated; }
+
+void session_recorder_clear(void) {
+    free(g_rec.buf);
+    memset(&g_rec, 0, sizeof(g_rec));
+}
+
+/* ── Reader ──────────────────────────────────────────────────────────── */
+
+static uint16_t get_u16(const uint8_t* p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t get_u32(const uint8_t* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+bool session_reader_init(SessionReader* reader, const uint8_t* data, size_t size) {
+    assert(reader);
+    *reader = (SessionReader){ .data = data, .size = size, .pos = SESSION_RECORD_MAGIC_LEN };
+    return data && SESSION_RECORD_MAGIC_LEN <= size &&
+           0 == memcmp(data, SESSION_RECORD_MAGIC, SESSION_RECORD_MAGIC_LEN);
+}
+
+bool session_reader_next(SessionReader* reader, SessionRecord* out) {
+    assert(reader && out);
+    if (reader->size - reader->pos < SESSION_RECORD_HEADER) return false;
+    const uint8_t* p = reader->data + reader->pos;
+    uint64_t bits = (uint64_t)get_u32(p + 1) | ((uint64_t)get_u32(p + 5) << 32);
+    uint16_t id_len = get_u16(p + 9);
+    uint32_t length = get_u32(p + 11);
+    if (reader->size - reader->pos - SESSION_RECORD_HEADER < (size_t)id_len + length) return false;
+
+    *out = (SessionRecord){
+        .kind     = (SessionRecordKind)p[0],
+        .id_len   = id_len,
+        .asset_id = (const char*)(p + SESSION_RECORD_HEADER),
+        .data     = p + SESSION_RECORD_HEADER + id_len,
+        .length   = length,
+    };
+    memcpy(&out->t_ms, &bits, sizeof(out->t_ms));
+    reader->pos += SESSION_RECORD_HEADER + id_len + length;
+    return true;
+}
@@ -0,0 +1,87 @@
+#ifndef CYBERIA_NETWORK_SESSION_RECORDER_H
+#define CYBERIA_NETWORK_SESSION_RECORDER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Session capture for replay benchmarks.
+ *
+ * While recording, game_client appends every downlink WebSocket frame
+ * (binary AOI, FCT and drop messages, and JSON text) and engine_client
+ * every successful fetch body, single or bulk, each stamped with its
+ * arrival time. The capture lives in one growing buffer up to a byte cap;
+ * once full, recording stops by itself so a forgotten capture cannot eat
+ * the heap.
+ * js/recorder_bridge hands the buffer to the browser as a download; the
+ * host bench (`aoi_bench --replay`) feeds it back through the same entry
+ * points.
+ *
+ * File format, little-endian:
+ *   "CYBREC01"                          8-byte magic
+ *   then records until end of file:
+ *     u8  kind                          SessionRecordKind
+ *     f64 t_ms                          since session_recorder_start()
+ *     u16 id_len, u32 len
+ *     id_len bytes                      fetch asset id; empty for WS frames
+ *     len bytes                         frame or body
+ *
+ * Start before joining the world: a capture opened mid-session lacks the
+ * INIT_DATA frame and the fetches already made, and replays against an
+ * empty map.
+ */
+
+#define SESSION_RECORD_MAGIC     "CYBREC01"
+#define SESSION_RECORD_MAGIC_LEN 8
+#define SESSION_RECORD_HEADER    (1 + 8 + 2 + 4)   /* per-record fixed part */
+
+#define SESSION_RECORDER_DEFAULT_CAP (64u * 1024u * 1024u)
+
+typedef enum {
+    SESSION_RECORD_WS_BINARY  = 1,
+    SESSION_RECORD_WS_TEXT    = 2,
+    SESSION_RECORD_FETCH      = 3,   /* id: asset id */
+    SESSION_RECORD_FETCH_BULK = 4,   /* id: FetchBatchConfig.name */
+} SessionRecordKind;
+
+/* Drops any previous capture. cap_bytes 0 takes the default. */
+void        session_recorder_start(size_t cap_bytes);
+void        session_recorder_stop(void);
+bool        session_recorder_active(void);
+
+/* No-ops unless recording. */
+void        session_recorder_on_ws(const uint8_t* data, uint32_t length, bool is_text);
+void        session_recorder_on_fetch(const char* asset_id, const void* data, size_t size);
+void        session_recorder_on_fetch_bulk(const char* batch_name, const void* data, size_t size);
+
+/* The capture so far, magic included; valid until the next start or clear. */
+const uint8_t* session_recorder_data(size_t* size);
+uint32_t       session_recorder_record_count(void);
+bool           session_recorder_truncated(void);   /* cap reached */
+void           session_recorder_clear(void);
+
+/* ── Reading a capture back ─────────────────────────────────────────── */
+
+typedef struct {
+    SessionRecordKind kind;
+    double            t_ms;
+    const char*       asset_id;   /* not NUL-terminated; id_len bytes */
+    uint16_t          id_len;
+    const uint8_t*    data;       /* points into the capture */
+    uint32_t          length;
+} SessionRecord;
+
+typedef struct {
+    const uint8_t* data;
+    size_t         size;
+    size_t         pos;
+} SessionReader;
+
+/* False unless `data` starts with the magic. */
+bool session_reader_init(SessionReader* reader, const uint8_t* data, size_t size);
+
+/* Next record, or false at the end; a record cut short also ends it. */
+bool session_reader_next(SessionReader* reader, SessionRecord* out);
+
+#endif /* CYBERIA_NETWORK_SESSION_RECORDER_H */
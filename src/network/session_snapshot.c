@@ -0,0 +1,154 @@
+#include "network/session_snapshot.h"
+
+#include "binary_aoi_decoder.h"
+#include "game_state.h"
+#include "message_parser.h"
+#include "network/game_client.h"
+#include "network/session_recorder.h"
+#include "util/log.h"
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    uint8_t* buf;
+    size_t   len;
+    size_t   cap;
+    size_t   limit;
+    bool     full;   /* a frame did not fit; takes none until cleared */
+} SnapPart;
+
+static struct {
+    SnapPart prefix;   /* magic, then the world-defining frames */
+    SnapPart tail;     /* last full AOI frame, then its deltas */
+    bool     has_init;
+    uint8_t* out;
+    size_t   out_cap;
+    bool     ghost;
+    bool     live;     /* a socket frame has been decoded */
+} g_snap = {
+    .prefix = { .limit = SESSION_SNAPSHOT_PREFIX_CAP },
+    .tail   = { .limit = SESSION_SNAPSHOT_TAIL_CAP },
+};
+
+static bool part_reserve(SnapPart* p, size_t n) {
+    if (p->len + n > p->limit) return false;
+    if (p->len + n <= p->cap) return true;
+    size_t cap = p->cap ? p->cap : 16 * 1024;
+    while (cap < p->len + n) cap *= 2;
+    if (cap > p->limit) cap = p->limit;
+    uint8_t* grown = realloc(p->buf, cap);
+    if (!grown) return false;
+    p->buf = grown;
+    p->cap = cap;
+    return true;
+}
+
+static void part_put(SnapPart* p, const void* src, size_t n) {
+    memcpy(p->buf + p->len, src, n);
+    p->len += n;
+}
+
+/* One WS record, t_ms 0: a replay decodes the whole snapshot at once. */
+static void part_append(SnapPart* p, const uint8_t* data, uint32_t length, bool is_text) {
+    if (p->full) return;
+    if (!part_reserve(p, SESSION_RECORD_HEADER + length)) {
+        LOG_WARN("session snapshot part full at %zu bytes", p->len);
+        p->full = true;
+        return;
+    }
+    uint8_t head[SESSION_RECORD_HEADER] = {
+        (uint8_t)(is_text ? SESSION_RECORD_WS_TEXT : SESSION_RECORD_WS_BINARY),
+        [11] = (uint8_t)length, (uint8_t)(length >> 8), (uint8_t)(length >> 16),
+               (uint8_t)(length >> 24),
+    };
+    part_put(p, head, sizeof(head));
+    part_put(p, data, length);
+}
+
+static void part_clear(SnapPart* p) {
+    p->len  = 0;
+    p->full = false;
+}
+
+void session_snapshot_on_frame(const uint8_t* data, uint32_t length, bool is_text, int kind) {
+    assert(data);
+    bool init, prefix, full;
+    if (is_text) {
+        init   = MSG_TYPE_INIT_DATA == kind;
+        prefix = MSG_TYPE_METADATA == kind || MSG_TYPE_SKILL_ITEM_IDS == kind;
+        full   = MSG_TYPE_AOI_UPDATE == kind;
+    } else {
+        init   = BIN_MSG_INIT_DATA == kind;
+        prefix = BIN_MSG_WIRE_ACK == kind || BIN_MSG_METADATA == kind ||
+                 BIN_MSG_ITEM_DICT == kind || BIN_MSG_STATIC_WORLD == kind;
+        full   = BIN_MSG_AOI_UPDATE == kind || BIN_MSG_FULL_AOI == kind;
+    }
+
+    if (init) {
+        part_clear(&g_snap.prefix);
+        part_clear(&g_snap.tail);
+        g_snap.has_init = part_reserve(&g_snap.prefix, SESSION_RECORD_MAGIC_LEN);
+        if (g_snap.has_init) part_put(&g_snap.prefix, SESSION_RECORD_MAGIC, SESSION_RECORD_MAGIC_LEN);
+    }
+    if (!g_snap.has_init) return;
+    if (init || prefix) {
+        part_append(&g_snap.prefix, data, length, is_text);
+    } else if (full) {
+        part_clear(&g_snap.tail);
+        part_append(&g_snap.tail, data, length, is_text);
+    } else if (!is_text && BIN_MSG_AOI_DELTA == kind && 0 < g_snap.tail.len) {
+        part_append(&g_snap.tail, data, length, is_text);
+    }
+}
+
+const uint8_t* session_snapshot_data(size_t* size) {
+    assert(size);
+    *size = 0;
+    if (!g_snap.has_init || 0 == g_snap.tail.len) return NULL;
+    size_t n = g_snap.prefix.len + g_snap.tail.len;
+    if (n > g_snap.out_cap) {
+        uint8_t* grown = realloc(g_snap.out, n);
+        if (!grown) return NULL;
+        g_snap.out     = grown;
+        g_snap.out_cap = n;
+    }
+    memcpy(g_snap.out, g_snap.prefix.buf, g_snap.prefix.len);
+    memcpy(g_snap.out + g_snap.prefix.len, g_snap.tail.buf, g_snap.tail.len);
+    *size = n;
+    return g_snap.out;
+}
+
+bool session_snapshot_restore(const uint8_t* data, size_t size) {
+    SessionReader reader;
+    if (g_snap.live || !session_reader_init(&reader, data, size)) return false;
+    g_snap.ghost = true;
+    SessionRecord rec;
+    int frames = 0;
+    while (session_reader_next(&reader, &rec)) {
+        if (SESSION_RECORD_WS_BINARY != rec.kind && SESSION_RECORD_WS_TEXT != rec.kind) continue;
+        if (0 == rec.length) continue;
+        game_client_inject_message(rec.data, rec.length, SESSION_RECORD_WS_TEXT == rec.kind);
+        frames++;
+    }
+    /* The replayed WIRE_ACK spoke for the old socket; the handshake on the
+     * new one renegotiates. */
+    g_game_state.wire_ack_caps     = 0;
+    g_game_state.wire_ack_caps_ext = 0;
+    g_snap.ghost = 0 < frames;
+    LOG_INFO("session snapshot restored: %d frames, %zu bytes", frames, size);
+    return g_snap.ghost;
+}
+
+bool session_snapshot_ghost(void) {
+    return g_snap.ghost;
+}
+
+bool session_snapshot_on_live(void) {
+    g_snap.live = true;
+    if (!g_snap.ghost) return false;
+    g_snap.ghost = false;
+    LOG_INFO("session snapshot ghost replaced by the live session");
+    return true;
+}
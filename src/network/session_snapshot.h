@@ -0,0 +1,67 @@
+#ifndef CYBERIA_NETWORK_SESSION_SNAPSHOT_H
+#define CYBERIA_NETWORK_SESSION_SNAPSHOT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Snapshot of the joined world, for drawing it at once after a reload.
+ *
+ * game_client hands every decoded downlink frame to
+ * session_snapshot_on_frame(), which keeps the few that rebuild the world
+ * on replay: the prefix (init_data, WIRE_ACK, metadata, the item dictionary
+ * and the static layer) and the tail (the last full AOI frame and the
+ * deltas since). A new init_data starts over; a new full frame replaces the
+ * tail. Everything else — FCT, drops, chat, the session token — is momentary
+ * or belongs to the socket and is not kept.
+ *
+ * The snapshot is a session_recorder capture (same magic and records), so a
+ * saved one also replays in the host bench. js/snapshot_bridge writes it to
+ * IndexedDB when the page is hidden and hands it back on the next boot.
+ * ObjectLayer and atlas metadata are not in it: those fetches already
+ * persist in IndexedDB (engine_client's PERSIST_FILE store) and the ghost's
+ * render requests hit that store.
+ *
+ * Restored, the frames replay through game_client_inject_message() into a
+ * ghost world: drawn under the loading overlay, never played (LOAD_WORLD
+ * waits for the real init_data). The first frame off the real socket ends
+ * the ghost and resets the world before it is decoded.
+ */
+
+/* A part that would outgrow its cap stops taking frames: the prefix of a
+ * stream is still a consistent, older world. */
+#ifndef SESSION_SNAPSHOT_PREFIX_CAP
+#define SESSION_SNAPSHOT_PREFIX_CAP (1024u * 1024u)
+#endif
+
+#ifndef SESSION_SNAPSHOT_TAIL_CAP
+#define SESSION_SNAPSHOT_TAIL_CAP (512u * 1024u)
+#endif
+
+/* Older saves are dropped on load: the world has moved on too far for the
+ * ghost to pass for it. */
+#ifndef SESSION_SNAPSHOT_MAX_AGE_MS
+#define SESSION_SNAPSHOT_MAX_AGE_MS (30.0 * 60.0 * 1000.0)
+#endif
+
+/* A frame game_client just decoded; `kind` is its BIN_MSG_* type, or the
+ * MessageType of a text frame. */
+void session_snapshot_on_frame(const uint8_t* data, uint32_t length, bool is_text, int kind);
+
+/* The snapshot as a capture, or NULL (size 0) before the world has a full
+ * AOI frame. Valid until the next frame. */
+const uint8_t* session_snapshot_data(size_t* size);
+
+/* Replay a saved snapshot into a ghost world; false, leaving the world
+ * alone, when it is unreadable or a real frame has already been decoded. */
+bool session_snapshot_restore(const uint8_t* data, size_t size);
+
+/* True from a restore until the first real frame. */
+bool session_snapshot_ghost(void);
+
+/* A frame off the socket is about to be decoded. True when it ends the
+ * ghost — the caller clears the world first. */
+bool session_snapshot_on_live(void);
+
+#endif /* CYBERIA_NETWORK_SESSION_SNAPSHOT_H */
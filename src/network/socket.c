@@ -53,6 +53,16 @@ bool ws_open(WebSocketClient* ws_client, const char* url, void* user_ctx, WebSoc
     return true;
 }
 
+size_t ws_buffered_amount(const WebSocketClient* ws_client) {
+    assert(ws_client);
+    size_t amount = 0;
+    if (!ws_is_open(ws_client)) return 0;
+    if (EMSCRIPTEN_RESULT_SUCCESS != emscripten_websocket_get_buffered_amount(ws_client->socket, &amount)) {
+        return 0;
+    }
+    return amount;
+}
+
 // Send message through WebSocket
 bool ws_send_str(const WebSocketClient* ws_client, const char* data) {
     assert(ws_client);
@@ -30,6 +30,9 @@ bool ws_open(WebSocketClient* ws_client, const char* url, void* user_ctx, WebSoc
 void ws_close(WebSocketClient* ws_client);
 bool ws_is_open(const WebSocketClient* ws_client);
 
+/* Bytes the browser has queued on the socket but not yet sent. */
+size_t ws_buffered_amount(const WebSocketClient* ws_client);
+
 /**
  * Sends a text message to the server. The function returns immediately
  * after queuing the message for transmission.
@@ -0,0 +1,95 @@
+#include "network/wire_compress.h"
+
+#include "heap_memory.h"
+
+#include <assert.h>
+#include <string.h>
+
+#define LZ4_MIN_MATCH 4
+
+static struct {
+    uint8_t  dict[WIRE_DICT_BYTES];
+    size_t   dict_len;
+    uint8_t* buf;        /* [dictionary copy][output] */
+    size_t   buf_cap;
+} g_wire;
+
+void wire_dict_reset(void) {
+    g_wire.dict_len = 0;
+}
+
+void wire_dict_add(const char* s) {
+    assert(s);
+    size_t n = strlen(s) + 1;
+    if (WIRE_DICT_BYTES - g_wire.dict_len < n) return;
+    memcpy(&g_wire.dict[g_wire.dict_len], s, n);
+    g_wire.dict_len += n;
+}
+
+static bool reserve(size_t bytes) {
+    if (g_wire.buf_cap >= bytes) return true;
+    size_t cap = g_wire.buf_cap ? g_wire.buf_cap : 64u * 1024u;
+    while (cap < bytes) cap *= 2;
+    uint8_t* buf = heap_malloc(HEAP_MEM_WIRE, cap);
+    if (!buf) return false;
+    heap_free(g_wire.buf);
+    g_wire.buf     = buf;
+    g_wire.buf_cap = cap;
+    return true;
+}
+
+/* LZ4 length: the nibble, extended by bytes while they read 255. */
+static bool read_length(const uint8_t** ip, const uint8_t* end, size_t* len) {
+    if (15 != *len) return true;
+    uint8_t b;
+    do {
+        if (*ip >= end) return false;
+        b = *(*ip)++;
+        *len += b;
+    } while (255 == b);
+    return true;
+}
+
+/* Decode into [base + history, base + history + raw_len); matches may reach
+ * back into the history in front of it. */
+static bool lz4_block(const uint8_t* ip, size_t len, uint8_t* base, size_t history, size_t raw_len) {
+    const uint8_t* iend = ip + len;
+    uint8_t* op   = base + history;
+    uint8_t* oend = op + raw_len;
+    while (ip < iend) {
+        uint8_t token = *ip++;
+        size_t  lit   = token >> 4;
+        if (!read_length(&ip, iend, &lit)) return false;
+        if ((size_t)(iend - ip) < lit || (size_t)(oend - op) < lit) return false;
+        memcpy(op, ip, lit);
+        op += lit;
+        ip += lit;
+        if (ip == iend) break;   /* the last sequence is literals only */
+
+        if (2 > iend - ip) return false;
+        size_t offset = (size_t)ip[0] | (size_t)ip[1] << 8;
+        ip += 2;
+        if (0 == offset || (size_t)(op - base) < offset) return false;
+        size_t match = token & 15;
+        if (!read_length(&ip, iend, &match)) return false;
+        match += LZ4_MIN_MATCH;
+        if ((size_t)(oend - op) < match) return false;
+        /* Byte by byte: a match may overlap what it is writing. */
+        const uint8_t* from = op - offset;
+        for (size_t i = 0; i < match; i++) op[i] = from[i];
+        op += match;
+    }
+    return op == oend;
+}
+
+const uint8_t* wire_decompress(const uint8_t* src, size_t len, size_t raw_len, bool use_dict) {
+    assert(src || 0 == len);
+    if (WIRE_COMPRESS_MAX_RAW < raw_len) return NULL;
+    size_t history = use_dict ? g_wire.dict_len : 0;
+    if (!reserve(history + raw_len + 1)) return NULL;
+    memcpy(g_wire.buf, g_wire.dict, history);
+    if (!lz4_block(src, len, g_wire.buf, history, raw_len)) return NULL;
+    /* Text frames are handed on as C strings. */
+    g_wire.buf[history + raw_len] = '\0';
+    return g_wire.buf + history;
+}
@@ -0,0 +1,32 @@
+#ifndef CYBERIA_NETWORK_WIRE_COMPRESS_H
+#define CYBERIA_NETWORK_WIRE_COMPRESS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* Application-layer compression of downlink frames (BIN_MSG_COMPRESSED).
+ *
+ * The payload is one LZ4 block. With BIN_COMPRESS_DICT its history is
+ * primed with the session dictionary: the instanceCode and then every
+ * catalog itemId of the last BIN_MSG_METADATA, in wire order, each followed
+ * by a NUL — the strings that repeat across init_data, quest arrays and
+ * item lists. Both ends derive it from the same message, so nothing extra
+ * goes over the wire.
+ *
+ * Frames decompress into one grow-only buffer, valid until the next call.
+ * permessage-deflate needs nothing here: the browser's WebSocket offers it
+ * and inflates transparently when the server accepts. */
+
+#define WIRE_DICT_BYTES        (64u * 1024u)   /* LZ4's window */
+#define WIRE_COMPRESS_MAX_RAW  (16u * 1024u * 1024u)
+
+/* Dictionary: cleared when a metadata message starts, then fed its strings. */
+void wire_dict_reset(void);
+void wire_dict_add(const char* s);
+
+/* Decompress one LZ4 block of `raw_len` bytes. NULL on malformed input or a
+ * size past WIRE_COMPRESS_MAX_RAW. */
+const uint8_t* wire_decompress(const uint8_t* src, size_t len, size_t raw_len, bool use_dict);
+
+#endif /* CYBERIA_NETWORK_WIRE_COMPRESS_H */
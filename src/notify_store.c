@@ -8,6 +8,7 @@
 #include "util/log.h"
 
 #include <raylib.h>
+#include <stdbool.h>
 #include <stdio.h>
 #include <string.h>
 #include <time.h>
@@ -16,28 +17,51 @@
 
 static NotifyEntry s_entries[NS_MAX_ENTITIES];
 static int         s_count = 0;
+static EntityIndex s_index = { .records = s_entries, .stride = sizeof(NotifyEntry) };
 
 /* ── Helpers ──────────────────────────────────────────────────────────── */
 
+/* Slot of entity_id (compared as stored, truncated to NS_ENTITY_ID_LEN), or -1. */
+static int find_slot(const char* entity_id, char key[NS_ENTITY_ID_LEN]) {
+    strncpy(key, entity_id, NS_ENTITY_ID_LEN - 1);
+    key[NS_ENTITY_ID_LEN - 1] = '\0';
+    return entity_index_find(&s_index, key, entity_index_hash(key));
+}
+
+/* The conversation idle longest, to make room for a new one. */
+static int idle_slot(void) {
+    int victim = 0;
+    for (int i = 1; i < s_count; i++) {
+        if (s_entries[i].used_ms < s_entries[victim].used_ms) victim = i;
+    }
+    return victim;
+}
+
 static NotifyEntry* find_or_create(const char* entity_id) {
     if (!entity_id || entity_id[0] == '\0') return NULL;
 
-    /* Look for existing entry */
-    for (int i = 0; i < s_count; i++) {
-        if (strncmp(s_entries[i].entity_id, entity_id, NS_ENTITY_ID_LEN - 1) == 0) {
-            return &s_entries[i];
-        }
-    }
+    char key[NS_ENTITY_ID_LEN];
+    int slot = find_slot(entity_id, key);
+    if (0 <= slot) return &s_entries[slot];
 
-    /* Create new entry if space available */
-    if (s_count >= NS_MAX_ENTITIES) {
-        LOG_ERROR("[NOTIFY_STORE] Max entity slots reached, dropping entry for %s", entity_id);
-        return NULL;
+    bool evicted = s_count >= NS_MAX_ENTITIES;
+    if (evicted) {
+        slot = idle_slot();
+        LOG_DEBUG("[NOTIFY_STORE] Evicting idle conversation %s for %s",
+                  s_entries[slot].entity_id, key);
+    } else {
+        slot = s_count++;
     }
 
-    NotifyEntry* e = &s_entries[s_count++];
-    memset(e, 0, sizeof(*e));
-    strncpy(e->entity_id, entity_id, NS_ENTITY_ID_LEN - 1);
+    NotifyEntry* e = &s_entries[slot];
+    e->head  = 0;
+    e->count = 0;
+    memcpy(e->entity_id, key, NS_ENTITY_ID_LEN);
+    if (evicted) {
+        entity_index_rebuild(&s_index, s_count);
+    } else {
+        entity_index_insert(&s_index, entity_index_hash(key), slot);
+    }
     return e;
 }
 
@@ -47,25 +71,27 @@ void notify_store_push(const char* entity_id, const char* sender, const char* te
     NotifyEntry* e = find_or_create(entity_id);
     if (!e) return;
 
-    /* Ring-buffer: drop oldest when full */
-    if (e->count >= NS_MAX_MESSAGES) {
-        memmove(e->messages, e->messages + 1,
-                sizeof(NotifyMessage) * (NS_MAX_MESSAGES - 1));
-        e->count = NS_MAX_MESSAGES - 1;
+    /* Ring-buffer: a full conversation overwrites its oldest message */
+    NotifyMessage* m;
+    if (e->count < NS_MAX_MESSAGES) {
+        m = &e->messages[(e->head + e->count++) % NS_MAX_MESSAGES];
+    } else {
+        m = &e->messages[e->head];
+        e->head = (e->head + 1) % NS_MAX_MESSAGES;
     }
 
-    NotifyMessage* m = &e->messages[e->count++];
+    memset(m, 0, sizeof(*m));
     strncpy(m->sender, sender ? sender : "",  NS_SENDER_LEN - 1);
     strncpy(m->text,   text   ? text   : "",  NS_TEXT_LEN   - 1);
-    m->ts_ms = GetTime() * 1000.0;
+    m->ts_ms   = GetTime() * 1000.0;
+    e->used_ms = m->ts_ms;
 }
 
 const NotifyEntry* notify_store_get(const char* entity_id) {
     if (!entity_id) return NULL;
-    for (int i = 0; i < s_count; i++) {
-        if (strncmp(s_entries[i].entity_id, entity_id, NS_ENTITY_ID_LEN - 1) == 0) {
-            return &s_entries[i];
-        }
-    }
-    return NULL;
+    char key[NS_ENTITY_ID_LEN];
+    int slot = find_slot(entity_id, key);
+    if (0 > slot) return NULL;
+    s_entries[slot].used_ms = GetTime() * 1000.0;
+    return &s_entries[slot];
 }
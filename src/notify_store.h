@@ -5,6 +5,11 @@
  * Single source of truth for chat unread state. The interaction bubble reads
  * the last message for its informational chat bubble; the interaction modal's
  * Chat button reads/clears the unread count.
+ *
+ * Each conversation is a circular buffer of the last NS_MAX_MESSAGES
+ * messages, so a push never shifts the history. Conversations are found
+ * through a hashed id index; once NS_MAX_ENTITIES are held, a conversation
+ * with a new entity evicts the one idle longest (last pushed or read).
  */
 
 #ifndef NOTIFY_STORE_H
@@ -12,6 +17,8 @@
 
 #include <stddef.h>
 
+#include "entity_index.h"
+
 #define NS_MAX_ENTITIES        64
 #define NS_MAX_MESSAGES        100
 #define NS_ENTITY_ID_LEN       64
@@ -25,16 +32,29 @@ typedef struct {
 } NotifyMessage;
 
 typedef struct {
-    char          entity_id[NS_ENTITY_ID_LEN];
-    NotifyMessage messages[NS_MAX_MESSAGES];
+    char          entity_id[NS_ENTITY_ID_LEN];   /* first: EntityIndex record id */
+    NotifyMessage messages[NS_MAX_MESSAGES];     /* ring; oldest at `head`      */
+    int           head;
     int           count;
+    double        used_ms;                       /* last push or lookup          */
 } NotifyEntry;
 
 /** Append a chat message for entity_id. Counts live in the notification
  *  dispatcher (notification.h), not here. */
 void notify_store_push(const char* entity_id, const char* sender, const char* text);
 
-/** Return the NotifyEntry for entity_id, or NULL if not found. */
+/** Return the NotifyEntry for entity_id, or NULL if not found (or evicted).
+ *  Counts as a use, so conversations still being shown are not evicted. */
 const NotifyEntry* notify_store_get(const char* entity_id);
 
+/** Message i of e, oldest first; 0 <= i < e->count. */
+static inline const NotifyMessage* notify_store_message(const NotifyEntry* e, int i) {
+    return &e->messages[(e->head + i) % NS_MAX_MESSAGES];
+}
+
+/** Most recent message of e; e->count must be positive. */
+static inline const NotifyMessage* notify_store_last(const NotifyEntry* e) {
+    return notify_store_message(e, e->count - 1);
+}
+
 #endif /* NOTIFY_STORE_H */
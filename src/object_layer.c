@@ -15,11 +15,61 @@ void free_object_layer(ObjectLayer* layer) {
     free(layer);
 }
 
-AtlasSpriteSheetData* create_atlas_sprite_sheet_data(void) {
-    AtlasSpriteSheetData* data = (AtlasSpriteSheetData*)calloc(1, sizeof(AtlasSpriteSheetData));
+static const char* const ATLAS_ANIM_NAMES[ATLAS_ANIM_COUNT] = {
+    [ATLAS_ANIM_UP_IDLE]            = "up_idle",
+    [ATLAS_ANIM_DOWN_IDLE]          = "down_idle",
+    [ATLAS_ANIM_RIGHT_IDLE]         = "right_idle",
+    [ATLAS_ANIM_LEFT_IDLE]          = "left_idle",
+    [ATLAS_ANIM_UP_RIGHT_IDLE]      = "up_right_idle",
+    [ATLAS_ANIM_DOWN_RIGHT_IDLE]    = "down_right_idle",
+    [ATLAS_ANIM_UP_LEFT_IDLE]       = "up_left_idle",
+    [ATLAS_ANIM_DOWN_LEFT_IDLE]     = "down_left_idle",
+    [ATLAS_ANIM_DEFAULT_IDLE]       = "default_idle",
+    [ATLAS_ANIM_UP_WALKING]         = "up_walking",
+    [ATLAS_ANIM_DOWN_WALKING]       = "down_walking",
+    [ATLAS_ANIM_RIGHT_WALKING]      = "right_walking",
+    [ATLAS_ANIM_LEFT_WALKING]       = "left_walking",
+    [ATLAS_ANIM_UP_RIGHT_WALKING]   = "up_right_walking",
+    [ATLAS_ANIM_DOWN_RIGHT_WALKING] = "down_right_walking",
+    [ATLAS_ANIM_UP_LEFT_WALKING]    = "up_left_walking",
+    [ATLAS_ANIM_DOWN_LEFT_WALKING]  = "down_left_walking",
+    [ATLAS_ANIM_NONE_IDLE]          = "none_idle",
+};
+
+/* Per-direction idle / walking animation; DIRECTION_NONE faces down. */
+static const AtlasAnim DIRECTION_IDLE[DIRECTION_COUNT] = {
+    [DIRECTION_UP]         = ATLAS_ANIM_UP_IDLE,
+    [DIRECTION_UP_RIGHT]   = ATLAS_ANIM_UP_RIGHT_IDLE,
+    [DIRECTION_RIGHT]      = ATLAS_ANIM_RIGHT_IDLE,
+    [DIRECTION_DOWN_RIGHT] = ATLAS_ANIM_DOWN_RIGHT_IDLE,
+    [DIRECTION_DOWN]       = ATLAS_ANIM_DOWN_IDLE,
+    [DIRECTION_DOWN_LEFT]  = ATLAS_ANIM_DOWN_LEFT_IDLE,
+    [DIRECTION_LEFT]       = ATLAS_ANIM_LEFT_IDLE,
+    [DIRECTION_UP_LEFT]    = ATLAS_ANIM_UP_LEFT_IDLE,
+    [DIRECTION_NONE]       = ATLAS_ANIM_DOWN_IDLE,
+};
+
+static const AtlasAnim DIRECTION_WALKING[DIRECTION_COUNT] = {
+    [DIRECTION_UP]         = ATLAS_ANIM_UP_WALKING,
+    [DIRECTION_UP_RIGHT]   = ATLAS_ANIM_UP_RIGHT_WALKING,
+    [DIRECTION_RIGHT]      = ATLAS_ANIM_RIGHT_WALKING,
+    [DIRECTION_DOWN_RIGHT] = ATLAS_ANIM_DOWN_RIGHT_WALKING,
+    [DIRECTION_DOWN]       = ATLAS_ANIM_DOWN_WALKING,
+    [DIRECTION_DOWN_LEFT]  = ATLAS_ANIM_DOWN_LEFT_WALKING,
+    [DIRECTION_LEFT]       = ATLAS_ANIM_LEFT_WALKING,
+    [DIRECTION_UP_LEFT]    = ATLAS_ANIM_UP_LEFT_WALKING,
+    [DIRECTION_NONE]       = ATLAS_ANIM_DOWN_WALKING,
+};
+
+AtlasSpriteSheetData* create_atlas_sprite_sheet_data(int frame_count) {
+    assert(0 <= frame_count && UINT16_MAX >= frame_count);
+    AtlasSpriteSheetData* data = (AtlasSpriteSheetData*)calloc(
+        1, sizeof(AtlasSpriteSheetData) + (size_t)frame_count * sizeof(FrameMetadata));
     if (data) {
         data->cell_pixel_dim = 20; // Default from engine schema
         data->frame_duration = 100;
+        data->frame_count = frame_count;
+        atlas_build_frame_table(data);
     }
     return data;
 }
@@ -28,29 +78,64 @@ void free_atlas_sprite_sheet_data(AtlasSpriteSheetData* data) {
     free(data);
 }
 
-const DirectionFrameData* atlas_get_direction_frames(const AtlasSpriteSheetData* atlas, const char* dir_str) {
+DirectionFrameData atlas_get_direction_frames(const AtlasSpriteSheetData* atlas, const char* dir_str) {
     assert(atlas && dir_str);
 
-    if (strcmp(dir_str, "up_idle") == 0)              return &atlas->up_idle;
-    if (strcmp(dir_str, "down_idle") == 0)            return &atlas->down_idle;
-    if (strcmp(dir_str, "right_idle") == 0)           return &atlas->right_idle;
-    if (strcmp(dir_str, "left_idle") == 0)            return &atlas->left_idle;
-    if (strcmp(dir_str, "up_right_idle") == 0)        return &atlas->up_right_idle;
-    if (strcmp(dir_str, "down_right_idle") == 0)      return &atlas->down_right_idle;
-    if (strcmp(dir_str, "up_left_idle") == 0)         return &atlas->up_left_idle;
-    if (strcmp(dir_str, "down_left_idle") == 0)       return &atlas->down_left_idle;
-    if (strcmp(dir_str, "default_idle") == 0)         return &atlas->default_idle;
-    if (strcmp(dir_str, "up_walking") == 0)           return &atlas->up_walking;
-    if (strcmp(dir_str, "down_walking") == 0)         return &atlas->down_walking;
-    if (strcmp(dir_str, "right_walking") == 0)        return &atlas->right_walking;
-    if (strcmp(dir_str, "left_walking") == 0)         return &atlas->left_walking;
-    if (strcmp(dir_str, "up_right_walking") == 0)     return &atlas->up_right_walking;
-    if (strcmp(dir_str, "down_right_walking") == 0)   return &atlas->down_right_walking;
-    if (strcmp(dir_str, "up_left_walking") == 0)      return &atlas->up_left_walking;
-    if (strcmp(dir_str, "down_left_walking") == 0)    return &atlas->down_left_walking;
-    if (strcmp(dir_str, "none_idle") == 0)            return &atlas->none_idle;
-
-    return NULL;
+    for (int i = 0; i < ATLAS_ANIM_COUNT; i++) {
+        if (strcmp(dir_str, ATLAS_ANIM_NAMES[i]) == 0) return atlas_anim_frames(atlas, (AtlasAnim)i);
+    }
+    return (DirectionFrameData){ 0 };
+}
+
+const char* atlas_anim_name(AtlasAnim anim) {
+    assert(0 <= anim && ATLAS_ANIM_COUNT > anim);
+    return ATLAS_ANIM_NAMES[anim];
+}
+
+DirectionFrameData atlas_anim_frames(const AtlasSpriteSheetData* atlas, AtlasAnim anim) {
+    assert(atlas);
+    assert(0 <= anim && ATLAS_ANIM_COUNT > anim);
+    const AtlasAnimSpan* span = &atlas->anims[anim];
+    assert(span->offset + span->count <= atlas->frame_count);
+    return (DirectionFrameData){
+        .frames = &atlas->frame_pool[span->offset],
+        .count  = span->count,
+    };
+}
+
+void atlas_build_frame_table(AtlasSpriteSheetData* atlas) {
+    assert(atlas);
+
+    for (int d = 0; d < DIRECTION_COUNT; d++) {
+        for (int m = 0; m < MODE_COUNT; m++) {
+            AtlasAnim chain[5];
+            int n = 0;
+            if (MODE_WALKING == m) chain[n++] = DIRECTION_WALKING[d];
+            chain[n++] = DIRECTION_IDLE[d];
+            chain[n++] = ATLAS_ANIM_DOWN_IDLE;
+            chain[n++] = ATLAS_ANIM_NONE_IDLE;
+            chain[n++] = ATLAS_ANIM_DEFAULT_IDLE;
+
+            atlas->frame_table[d][m] = ATLAS_ANIM_MISSING;
+            for (int i = 0; i < n; i++) {
+                if (atlas->anims[chain[i]].count > 0) {
+                    atlas->frame_table[d][m] = (uint8_t)chain[i];
+                    break;
+                }
+            }
+        }
+    }
+}
+
+DirectionFrameData atlas_frames_for(const AtlasSpriteSheetData* atlas,
+                                    Direction direction, ObjectLayerMode mode) {
+    assert(atlas);
+    if ((unsigned)direction >= DIRECTION_COUNT) direction = DIRECTION_DOWN;
+    if ((unsigned)mode >= MODE_COUNT) mode = MODE_IDLE;
+
+    uint8_t anim = atlas->frame_table[direction][mode];
+    return ATLAS_ANIM_MISSING == anim ? (DirectionFrameData){ 0 }
+                                      : atlas_anim_frames(atlas, (AtlasAnim)anim);
 }
 
 LedgerType ledger_type_from_string(const char* type_str) {
@@ -63,3 +148,19 @@ LedgerType ledger_type_from_string(const char* type_str) {
     return LEDGER_TYPE_OFF_CHAIN;
 }
 
+ObjectLayerType object_layer_type_from_string(const char* type_str) {
+    assert(type_str);
+
+    if (strcmp(type_str, "floor") == 0)       return OBJECT_LAYER_TYPE_FLOOR;
+    if (strcmp(type_str, "obstacle") == 0)    return OBJECT_LAYER_TYPE_OBSTACLE;
+    if (strcmp(type_str, "portal") == 0)      return OBJECT_LAYER_TYPE_PORTAL;
+    if (strcmp(type_str, "foreground") == 0)  return OBJECT_LAYER_TYPE_FOREGROUND;
+    if (strcmp(type_str, "resource") == 0)    return OBJECT_LAYER_TYPE_RESOURCE;
+    if (strcmp(type_str, "skin") == 0)        return OBJECT_LAYER_TYPE_SKIN;
+    if (strcmp(type_str, "weapon") == 0)      return OBJECT_LAYER_TYPE_WEAPON;
+    if (strcmp(type_str, "icon") == 0)        return OBJECT_LAYER_TYPE_ICON;
+    if (strcmp(type_str, "coin") == 0)        return OBJECT_LAYER_TYPE_COIN;
+
+    return OBJECT_LAYER_TYPE_UNKNOWN;
+}
+
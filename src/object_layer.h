@@ -2,6 +2,7 @@
 #define OBJECT_LAYER_H
 
 #include <stdbool.h>
+#include <stdint.h>
 
 #define MAX_ITEM_ID_LENGTH 64
 #define MAX_TYPE_LENGTH 64
@@ -24,12 +25,16 @@ typedef enum {
     DIRECTION_NONE = 8
 } Direction;
 
+#define DIRECTION_COUNT 9
+
 typedef enum {
     MODE_IDLE = 0,
     MODE_WALKING = 1,
     MODE_TELEPORTING = 2
 } ObjectLayerMode;
 
+#define MODE_COUNT 3
+
 /**
  * @brief Typed enum for ObjectLayer item type discriminator.
  */
@@ -45,6 +50,7 @@ typedef enum {
     OBJECT_LAYER_TYPE_ICON       = 8,
     OBJECT_LAYER_TYPE_OTHER      = 9,
     OBJECT_LAYER_TYPE_STATIC     = 10,
+    OBJECT_LAYER_TYPE_COIN       = 11,
 } ObjectLayerType;
 
 /**
@@ -61,6 +67,8 @@ typedef enum {
 // Object layer state
 typedef struct {
     char item_id[MAX_ITEM_ID_LENGTH];
+    uint32_t item_handle;   /* id_intern(item_id); 0 until interned */
+    uint64_t item_hash;     /* hash_table_hash(item_id); 0 until hashed */
     bool active;
     int quantity;
 } ObjectLayerState;
@@ -85,27 +93,69 @@ typedef struct {
  * Corresponds to the FrameMetadataSchema in the engine's
  * AtlasSpriteSheetModel. Each frame stores its position and
  * dimensions inside the consolidated atlas PNG so the renderer
- * can clip (crop) the correct sub-region.
+ * can clip (crop) the correct sub-region. Frames are stored in
+ * animation order, so the schema's frameIndex is implicit.
+ *
+ * 16-bit fields: atlas PNGs stay far below 65536 px; the parser drops
+ * any frame that does not fit.
  */
 typedef struct {
-    int x;           /**< X position in the atlas (pixels) */
-    int y;           /**< Y position in the atlas (pixels) */
-    int width;       /**< Frame width (pixels) */
-    int height;      /**< Frame height (pixels) */
-    int frame_index; /**< Frame index in animation sequence */
+    uint16_t x;      /**< X position in the atlas (pixels) */
+    uint16_t y;      /**< Y position in the atlas (pixels) */
+    uint16_t width;  /**< Frame width (pixels) */
+    uint16_t height; /**< Frame height (pixels) */
 } FrameMetadata;
 
 /**
- * @brief Array of FrameMetadata for a single animation direction.
+ * @brief Frames of a single animation direction, as a view.
  *
  * Groups all frames belonging to one direction/mode combination
- * (e.g. "down_idle", "right_walking") together with a count.
+ * (e.g. "down_idle", "right_walking") together with a count. Points
+ * into the owning atlas's frame pool; valid while the atlas is.
  */
 typedef struct {
-    FrameMetadata frames[MAX_FRAMES_PER_DIRECTION];
+    const FrameMetadata* frames;
     int count;
 } DirectionFrameData;
 
+/**
+ * @brief Where one animation's frames sit in AtlasSpriteSheetData.frame_pool.
+ */
+typedef struct {
+    uint16_t offset;
+    uint16_t count;
+} AtlasAnimSpan;
+
+/**
+ * @brief Named animations of an atlas, in DirectionFramesSchema order.
+ *
+ * Indexes AtlasSpriteSheetData.anims; atlas_anim_name() gives the schema key.
+ */
+typedef enum {
+    ATLAS_ANIM_UP_IDLE = 0,
+    ATLAS_ANIM_DOWN_IDLE,
+    ATLAS_ANIM_RIGHT_IDLE,
+    ATLAS_ANIM_LEFT_IDLE,
+    ATLAS_ANIM_UP_RIGHT_IDLE,
+    ATLAS_ANIM_DOWN_RIGHT_IDLE,
+    ATLAS_ANIM_UP_LEFT_IDLE,
+    ATLAS_ANIM_DOWN_LEFT_IDLE,
+    ATLAS_ANIM_DEFAULT_IDLE,
+    ATLAS_ANIM_UP_WALKING,
+    ATLAS_ANIM_DOWN_WALKING,
+    ATLAS_ANIM_RIGHT_WALKING,
+    ATLAS_ANIM_LEFT_WALKING,
+    ATLAS_ANIM_UP_RIGHT_WALKING,
+    ATLAS_ANIM_DOWN_RIGHT_WALKING,
+    ATLAS_ANIM_UP_LEFT_WALKING,
+    ATLAS_ANIM_DOWN_LEFT_WALKING,
+    ATLAS_ANIM_NONE_IDLE,
+    ATLAS_ANIM_COUNT
+} AtlasAnim;
+
+/* frame_table entry for a (direction, mode) no animation can serve. */
+#define ATLAS_ANIM_MISSING 0xFF
+
 /**
  * @brief Consolidated atlas sprite sheet data for one object layer item.
  *
@@ -121,6 +171,11 @@ typedef struct {
  *  4. Load the single atlas image as a GPU texture
  *  5. On each render frame, use the DirectionFrameData source rects
  */
+/** Pre-transcoded GPU variants of the atlas blob, by textureFormats name. */
+#define ATLAS_VARIANT_KTX2_BC1 (1u << 0)   /**< "ktx2-bc1" */
+#define ATLAS_VARIANT_KTX2_BC3 (1u << 1)   /**< "ktx2-bc3" */
+#define ATLAS_VARIANT_PREVIEW  (1u << 2)   /**< "png-preview": reduced resolution, same layout */
+
 typedef struct {
     char item_key[MAX_ITEM_ID_LENGTH];     /**< Item identifier (metadata.itemKey) */
     char file_id[MAX_FILE_ID_LENGTH];      /**< MongoDB ObjectId hex of the atlas PNG file */
@@ -128,26 +183,22 @@ typedef struct {
     int atlas_height;                       /**< Total atlas height in pixels */
     int cell_pixel_dim;                     /**< Pixel dimension of each cell */
     int frame_duration;                     /**< ms per frame (from atlas metadata) */
+    unsigned texture_variants;              /**< ATLAS_VARIANT_* the engine offers (metadata.textureFormats) */
+
+    /* Per-direction frame spans into frame_pool (DirectionFramesSchema) */
+    AtlasAnimSpan anims[ATLAS_ANIM_COUNT];
 
-    /* Per-direction frame metadata arrays (DirectionFramesSchema) */
-    DirectionFrameData up_idle;
-    DirectionFrameData down_idle;
-    DirectionFrameData right_idle;
-    DirectionFrameData left_idle;
-    DirectionFrameData up_right_idle;
-    DirectionFrameData down_right_idle;
-    DirectionFrameData up_left_idle;
-    DirectionFrameData down_left_idle;
-    DirectionFrameData default_idle;
-    DirectionFrameData up_walking;
-    DirectionFrameData down_walking;
-    DirectionFrameData right_walking;
-    DirectionFrameData left_walking;
-    DirectionFrameData up_right_walking;
-    DirectionFrameData down_right_walking;
-    DirectionFrameData up_left_walking;
-    DirectionFrameData down_left_walking;
-    DirectionFrameData none_idle;
+    /* AtlasAnim drawn for each (Direction, ObjectLayerMode) once the render
+     * fallback chain is applied, or ATLAS_ANIM_MISSING. Built by
+     * atlas_build_frame_table() whenever anims changes. */
+    uint8_t frame_table[DIRECTION_COUNT][MODE_COUNT];
+
+    /** Resolved GPU placement, owned by the ObjectLayersManager
+     *  (obj_layers_mgr_atlas_region); NULL until first drawn. */
+    struct AtlasResidency* residency;
+
+    int frame_count;                        /**< Capacity of frame_pool */
+    FrameMetadata frame_pool[];             /**< Every animation's frames, back to back */
 } AtlasSpriteSheetData;
 
 // ============================================================================
@@ -247,9 +298,10 @@ void free_object_layer(ObjectLayer* layer);
 
 /**
  * @brief Create a new AtlasSpriteSheetData with default (zeroed) values
+ * @param frame_count Exact size of the frame pool (all animations' frames)
  * @return Pointer to new AtlasSpriteSheetData, or NULL on allocation failure
  */
-AtlasSpriteSheetData* create_atlas_sprite_sheet_data(void);
+AtlasSpriteSheetData* create_atlas_sprite_sheet_data(int frame_count);
 
 /**
  * @brief Free an AtlasSpriteSheetData and all its resources
@@ -261,19 +313,48 @@ void free_atlas_sprite_sheet_data(AtlasSpriteSheetData* data);
  * @brief Look up the DirectionFrameData for a given direction string.
  *
  * Maps animation state names (e.g. "down_idle", "right_walking",
- * "default_idle") to the corresponding DirectionFrameData inside
- * an AtlasSpriteSheetData struct.
+ * "default_idle") to the frames of that animation inside an
+ * AtlasSpriteSheetData struct.
  *
  * @param atlas   The atlas sprite sheet data to search
  * @param dir_str The direction/mode string (e.g. "down_idle")
- * @return Pointer to the matching DirectionFrameData, or NULL if
- *         atlas is NULL or dir_str is unrecognised
+ * @return The matching frames; count is 0 if dir_str is unrecognised
  */
-const DirectionFrameData* atlas_get_direction_frames(
+DirectionFrameData atlas_get_direction_frames(
     const AtlasSpriteSheetData* atlas,
     const char* dir_str
 );
 
+/**
+ * @brief DirectionFramesSchema key of an animation (e.g. "down_idle").
+ */
+const char* atlas_anim_name(AtlasAnim anim);
+
+/**
+ * @brief Frames of one animation of the atlas (count 0 when it has none).
+ */
+DirectionFrameData atlas_anim_frames(const AtlasSpriteSheetData* atlas, AtlasAnim anim);
+
+/**
+ * @brief Resolve frame_table from the parsed anims.
+ *
+ * Walking looks for "<dir>_walking", then "<dir>_idle"; other modes for
+ * "<dir>_idle" (DIRECTION_NONE reads as down). Both then fall back to
+ * down_idle, none_idle and default_idle; the first with frames wins.
+ */
+void atlas_build_frame_table(AtlasSpriteSheetData* atlas);
+
+/**
+ * @brief Frames drawn for a direction and mode; count 0 when none apply.
+ *
+ * Two table lookups; out-of-range values read as DIRECTION_DOWN / MODE_IDLE.
+ */
+DirectionFrameData atlas_frames_for(
+    const AtlasSpriteSheetData* atlas,
+    Direction direction,
+    ObjectLayerMode mode
+);
+
 /**
  * @brief Parse a LedgerType enum value from a JSON string.
  *
@@ -282,4 +363,13 @@ const DirectionFrameData* atlas_get_direction_frames(
  */
 LedgerType ledger_type_from_string(const char* type_str);
 
+/**
+ * @brief Parse an ObjectLayerType from an item type string.
+ *
+ * @param type_str  Item.type ("skin", "weapon", "coin", ...)
+ * @return The corresponding ObjectLayerType, OBJECT_LAYER_TYPE_UNKNOWN for
+ *         empty or unrecognised categories
+ */
+ObjectLayerType object_layer_type_from_string(const char* type_str);
+
 #endif // OBJECT_LAYER_H
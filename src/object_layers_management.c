@@ -1,8 +1,13 @@
 #include "object_layers_management.h"
+#include "atlas_meta_bin.h"
+#include "atlas_pages.h"
 #include "config.h"
+#include "domain/presentation_runtime.h"
 #include "hash_table.h"
+#include "image_decoder.h"
 #include "texture_cache.h"
 #include "network/engine_client.h"
+#include "serial.h"
 #include "util/log.h"
 #include <raylib.h>
 #include <cJSON.h>
@@ -12,16 +17,48 @@
 #include <stdint.h>
 #include <assert.h>
 
-/* forward declaration */
+/* forward declarations */
 static void parse_ws_direction_frames(cJSON* frames_json, AtlasSpriteSheetData* atlas);
+static void on_atlas_meta_fetched(const FetchResponse* r);
+static void on_atlas_meta_bulk_fetched(const FetchResponse* r);
+static bool ingest_atlas_bin(const void* data, size_t size, const char* item_key, bool fetch_blob);
+static void request_atlas_meta(const char* item_key);
 
 ObjectLayersManager* g_olm_singleton = NULL;
 
-/* Atlas metadata fetch set — value is sentinel; only key presence matters. */
+/* Atlas metadata fetch set — the value records who asked first: a draw,
+ * or the prefetcher (whose blob then stays at prefetch priority) — or that
+ * the request failed, in which case `meta_retry` says when to ask again.
+ * META_EMBEDDED: only the blob was asked for, expected to carry its
+ * descriptor (atlasEmbeddedMeta). */
 #define META_SENTINEL ((void*)1)
+#define META_PREFETCH ((void*)2)
+#define META_FAILED   ((void*)3)
+#define META_EMBEDDED ((void*)4)
+
+typedef struct {
+    double retry_at;   /* GetTime() from which a draw may ask again */
+    int    failures;
+} MetaRetry;
+
 static void noop_free(void* p) {}
 static void free_layer_value(void* p) { free_object_layer((ObjectLayer*)p); }
-static void free_atlas_value(void* p) { free_atlas_sprite_sheet_data((AtlasSpriteSheetData*)p); }
+static void free_atlas_value(void* p) {
+    AtlasSpriteSheetData* atlas = p;
+    free(atlas->residency);
+    free_atlas_sprite_sheet_data(atlas);
+}
+
+/* Where an atlas was last found on the GPU. Valid while the residency epoch
+ * (texture cache + pages) is unchanged: nothing can have loaded, moved or
+ * dropped it since. Remembers "not ready" too — readiness moves the epoch. */
+struct AtlasResidency {
+    unsigned           epoch;
+    unsigned           touch_frame;
+    AtlasRegion        region;
+    AtlasPageHandle    page;    /* exactly one of page / entry once ready */
+    TextureCacheHandle entry;
+};
 
 /* Atlas GPU textures are loaded/cached/LRU-evicted by a general-purpose
  * TextureCache. The manager itself owns only authoritative content: object
@@ -30,25 +67,164 @@ struct ObjectLayersManager {
     HashTable     layers;        // item_id  → ObjectLayer*
     HashTable     atlases;       // item_key → AtlasSpriteSheetData*
     HashTable     meta;          // item_key → META_SENTINEL
+    HashTable     meta_retry;    // item_key → MetaRetry*, for META_FAILED keys
+    HashTable     pinned;        // blob url → pin set generation it was last named in
+    unsigned      pin_generation;
     TextureCache* atlas_textures;
+    unsigned      catalog_generation;   /* bumped per layers / atlases insert */
+    unsigned      frame;                /* obj_layers_mgr_begin_frame() count */
+    double        last_cancel_scan;
+    float         px_per_cell;          /* drawn size of a world cell, target pixels */
 };
 
+#define ATLAS_BLOB_URL_PREFIX "/api/atlas-sprite-sheet/blob/"
+#define ATLAS_META_URL_FORMAT "/api/atlas-sprite-sheet/metadata/%s"
+
+/* Metadata requests of one frame go out together (fetch_batch_*). Created
+ * once; outlives manager re-creation like the engine_client batch slots. */
+static FetchBatch* s_meta_batch = NULL;
+
+static void atlas_meta_url(const char* item_key, char* out, size_t out_sz) {
+    snprintf(out, out_sz, ATLAS_META_URL_FORMAT, item_key);
+}
+
 static void atlas_blob_url(const char* item_key, char* out, size_t out_sz) {
-    snprintf(out, out_sz, "/api/atlas-sprite-sheet/blob/%s", item_key);
+    snprintf(out, out_sz, ATLAS_BLOB_URL_PREFIX "%s", item_key);
+}
+
+/* Content version of an item's atlas for the persistent fetch cache: the
+ * CID when the ObjectLayer names one, else the ObjectLayer's sha256. NULL
+ * until the ObjectLayer is known — such fetches are not persisted. */
+static const char* atlas_content_version(const char* item_key, bool metadata) {
+    const ObjectLayer* layer = hash_table_get(&g_olm_singleton->layers, item_key);
+    if (!layer) return NULL;
+    const char* cid = metadata ? layer->data.render.metadata_cid : layer->data.render.cid;
+    if ('\0' != cid[0]) return cid;
+    return '\0' != layer->sha256[0] ? layer->sha256 : NULL;
+}
+
+/* Smallest GPU-ready variant of the atlas the engine offers and the GPU
+ * takes: BC1 (4 bits a pixel) before BC3 (8 bits). */
+static const char* atlas_blob_variant(const char* url) {
+    assert(g_olm_singleton);
+    size_t n = strlen(ATLAS_BLOB_URL_PREFIX);
+    if (0 != strncmp(url, ATLAS_BLOB_URL_PREFIX, n)) return NULL;
+    const AtlasSpriteSheetData* atlas = hash_table_get(&g_olm_singleton->atlases, url + n);
+    if (!atlas || 0 == (image_decoder_gpu_formats() & IMAGE_GPU_S3TC)) return NULL;
+    if (atlas->texture_variants & ATLAS_VARIANT_KTX2_BC1) return "?format=ktx2-bc1";
+    if (atlas->texture_variants & ATLAS_VARIANT_KTX2_BC3) return "?format=ktx2-bc3";
+    return NULL;
+}
+
+/* Reduced-resolution copy of the atlas to draw while the full one streams
+ * in, when the engine offers one and the atlas size is known. */
+static const char* atlas_blob_preview(const char* url, int* full_w, int* full_h) {
+    assert(g_olm_singleton);
+    size_t n = strlen(ATLAS_BLOB_URL_PREFIX);
+    if (0 != strncmp(url, ATLAS_BLOB_URL_PREFIX, n)) return NULL;
+    const AtlasSpriteSheetData* atlas = hash_table_get(&g_olm_singleton->atlases, url + n);
+    if (!atlas || 0 == (atlas->texture_variants & ATLAS_VARIANT_PREVIEW)) return NULL;
+    *full_w = atlas->atlas_width;
+    *full_h = atlas->atlas_height;
+    return "?format=png-preview";
+}
+
+/* Screen pixels per atlas pixel, as a fraction of full resolution. */
+static float atlas_blob_detail(const char* url) {
+    assert(g_olm_singleton);
+    size_t n = strlen(ATLAS_BLOB_URL_PREFIX);
+    if (0 != strncmp(url, ATLAS_BLOB_URL_PREFIX, n)) return 1.0f;
+    const AtlasSpriteSheetData* atlas = hash_table_get(&g_olm_singleton->atlases, url + n);
+    if (!atlas || 0 >= atlas->cell_pixel_dim || 0.0f >= g_olm_singleton->px_per_cell) return 1.0f;
+    float detail = g_olm_singleton->px_per_cell / (float)atlas->cell_pixel_dim;
+    return 1.0f < detail ? 1.0f : detail;
+}
+
+static const char* atlas_blob_version(const char* url) {
+    assert(g_olm_singleton);
+    size_t n = strlen(ATLAS_BLOB_URL_PREFIX);
+    if (0 != strncmp(url, ATLAS_BLOB_URL_PREFIX, n)) return NULL;
+    return atlas_content_version(url + n, false);
+}
+
+/* An atlas PNG carrying its descriptor chunk brings its metadata along; one
+ * fetched for that (META_EMBEDDED) without it falls back to the metadata
+ * route. */
+static void ingest_embedded_meta(const FetchResponse* r) {
+    size_t n = strlen(ATLAS_BLOB_URL_PREFIX);
+    if (0 != strncmp(r->asset_id, ATLAS_BLOB_URL_PREFIX, n)) return;
+    const char* item_key = r->asset_id + n;
+    if (hash_table_contains(&g_olm_singleton->atlases, item_key)) return;
+
+    size_t size = 0;
+    const void* desc = r->success ? atlas_meta_png_chunk(r->data, r->size, &size) : NULL;
+    if (desc && ingest_atlas_bin(desc, size, item_key, false)) return;
+    if (META_EMBEDDED == hash_table_get(&g_olm_singleton->meta, item_key)) {
+        LOG_INFO("[ATLAS REST] %s: blob has no descriptor, asking the metadata route", item_key);
+        request_atlas_meta(item_key);
+    }
 }
 
 /* engine_client fetch trampoline → routes blob completions into the atlas cache. */
 static void on_atlas_blob_fetched(const FetchResponse* r) {
     assert(g_olm_singleton);
+    ingest_embedded_meta(r);
     texture_cache_on_blob_fetched(g_olm_singleton->atlas_textures, r);
 }
 
-static Texture2D load_or_poll_atlas_texture(const char* item_key) {
+static bool atlas_pinned(const char* url) {
+    return hash_table_contains(&g_olm_singleton->pinned, url);
+}
+
+/* Decoded atlases go into the shared pages when they fit; the cache keeps
+ * textures only for the ones that don't. */
+static bool adopt_atlas_image(const char* url, DecodedImage* image) {
+    if (!atlas_pages_insert(url, image)) return false;
+    if (atlas_pinned(url)) atlas_pages_set_pinned(url, true);
+    return true;
+}
+
+/* A page evicted an idle atlas: drop its cache entry so the next use
+ * refetches it. A pinned one only goes when a repack ran out of room;
+ * it is fetched back right away. */
+static void on_atlas_page_evicted(const char* url) {
+    assert(g_olm_singleton);
+    texture_cache_evict(g_olm_singleton->atlas_textures, url);
+    if (atlas_pinned(url)) {
+        texture_cache_warm(g_olm_singleton->atlas_textures, url, FETCH_CLASS_PREFETCH, TEX_RES_PINNED);
+    }
+}
+
+static AtlasRegion load_or_poll_atlas_texture(const char* item_key) {
     assert(item_key);
     assert(g_olm_singleton);
     char url[512];
     atlas_blob_url(item_key, url, sizeof(url));
-    return texture_cache_get(g_olm_singleton->atlas_textures, url);
+
+    AtlasRegion region = { 0 };
+    if (!atlas_pages_lookup(url, &region)) {
+        region.texture = texture_cache_get(g_olm_singleton->atlas_textures, url);
+    }
+    return region;
+}
+
+static unsigned residency_epoch(void) {
+    return texture_cache_epoch(g_olm_singleton->atlas_textures) + atlas_pages_epoch();
+}
+
+/* Slow path: resolve by URL (fetching on a miss) and remember the handle. */
+static void resolve_residency(const char* item_key, struct AtlasResidency* res) {
+    res->region = load_or_poll_atlas_texture(item_key);
+    res->epoch  = residency_epoch();
+    res->touch_frame = g_olm_singleton->frame;
+    res->page  = NULL;
+    res->entry = NULL;
+    if (0 == res->region.texture.id) return;
+
+    char url[512];
+    atlas_blob_url(item_key, url, sizeof(url));
+    res->page = atlas_pages_find(url);
+    if (!res->page) { res->entry = texture_cache_lookup(g_olm_singleton->atlas_textures, url); }
 }
 
 // --- JSON Parsing Helpers ---
@@ -130,6 +306,7 @@ static void parse_item(cJSON* item_json, Item* item) {
     strncpy(item->id, id, MAX_ITEM_ID_LENGTH - 1);
     strncpy(item->type, type, MAX_TYPE_LENGTH - 1);
     strncpy(item->description, desc, MAX_DESCRIPTION_LENGTH - 1);
+    item->type_kind = object_layer_type_from_string(item->type);
     item->activable = json_get_bool_safe(item_json, "activable", false);
 
     free(id);
@@ -149,34 +326,65 @@ static void parse_object_layer_data(cJSON* data_json, ObjectLayerData* data) {
 
 // --- Atlas Sprite Sheet JSON Parsing ---
 
-static void parse_direction_frame_data(cJSON* array_json, DirectionFrameData* dfd) {
-    assert(dfd);
-    assert(array_json);
-    dfd->count = 0;
+/* Frames a DirectionFramesSchema array contributes, capped per animation. */
+static int count_direction_frames(cJSON* array_json) {
+    if (!cJSON_IsArray(array_json)) return 0;
+    int n = cJSON_GetArraySize(array_json);
+    return n > MAX_FRAMES_PER_DIRECTION ? MAX_FRAMES_PER_DIRECTION : n;
+}
 
-    if (!cJSON_IsArray(array_json)) return;
+static int count_ws_direction_frames(cJSON* frames_json) {
+    int total = 0;
+    for (int i = 0; frames_json && i < ATLAS_ANIM_COUNT; i++) {
+        total += count_direction_frames(cJSON_GetObjectItem(frames_json, atlas_anim_name((AtlasAnim)i)));
+    }
+    return total;
+}
+
+static bool frame_field_u16(cJSON* frame_json, const char* key, uint16_t* out) {
+    int v = json_get_int_safe(frame_json, key, 0);
+    if (v < 0 || v > UINT16_MAX) return false;
+    *out = (uint16_t)v;
+    return true;
+}
 
-    int arr_size = cJSON_GetArraySize(array_json);
-    if (arr_size > MAX_FRAMES_PER_DIRECTION) arr_size = MAX_FRAMES_PER_DIRECTION;
+/* Append one animation's frames to the atlas pool at *cursor. */
+static void parse_direction_frame_data(cJSON* array_json, AtlasSpriteSheetData* atlas,
+                                       AtlasAnim anim, int* cursor) {
+    assert(atlas);
+    assert(cursor);
+    AtlasAnimSpan* span = &atlas->anims[anim];
+    span->offset = (uint16_t)*cursor;
+    span->count  = 0;
 
+    int arr_size = count_direction_frames(array_json);
     for (int i = 0; i < arr_size; i++) {
         cJSON* frame_json = cJSON_GetArrayItem(array_json, i);
         if (!frame_json) continue;
 
-        FrameMetadata* fm = &dfd->frames[dfd->count];
-        fm->x = json_get_int_safe(frame_json, "x", 0);
-        fm->y = json_get_int_safe(frame_json, "y", 0);
-        fm->width = json_get_int_safe(frame_json, "width", 0);
-        fm->height = json_get_int_safe(frame_json, "height", 0);
-        fm->frame_index = json_get_int_safe(frame_json, "frameIndex", i);
-        dfd->count++;
+        assert(*cursor < atlas->frame_count);
+        FrameMetadata* fm = &atlas->frame_pool[*cursor];
+        if (!frame_field_u16(frame_json, "x", &fm->x) ||
+            !frame_field_u16(frame_json, "y", &fm->y) ||
+            !frame_field_u16(frame_json, "width", &fm->width) ||
+            !frame_field_u16(frame_json, "height", &fm->height)) {
+            LOG_ERROR("[ATLAS REST] %s: %s frame %d out of 16-bit range", atlas->item_key,
+                      atlas_anim_name(anim), i);
+            continue;
+        }
+        (*cursor)++;
+        span->count++;
     }
 }
 
 ObjectLayer* lookup_cached_layer(const char* item_id) {
     assert(item_id);
+    return lookup_cached_layer_h(hash_key(item_id));
+}
+
+ObjectLayer* lookup_cached_layer_h(HashKey item_id) {
     assert(g_olm_singleton);
-    return (ObjectLayer*)hash_table_get(&g_olm_singleton->layers, item_id);
+    return (ObjectLayer*)hash_table_get_h(&g_olm_singleton->layers, item_id);
 }
 
 // ============================================================================
@@ -196,7 +404,35 @@ void create_object_layers_manager(void) {
     hash_table_init(&mgr->layers,   (size_t)MAX_LAYER_CACHE_SIZE,   free_layer_value, "ol_layers");
     hash_table_init(&mgr->atlases,  (size_t)MAX_ATLAS_CACHE_SIZE,   free_atlas_value, "ol_atlases");
     hash_table_init(&mgr->meta,     (size_t)MAX_ATLAS_CACHE_SIZE,   noop_free,        "ol_meta");
-    mgr->atlas_textures = texture_cache_create((int)MAX_TEXTURE_CACHE_SIZE, "ol_atlas_tex", on_atlas_blob_fetched);
+    hash_table_init(&mgr->meta_retry, 16,                           free,             "ol_meta_retry");
+    hash_table_init(&mgr->pinned,   (size_t)MAX_OBJECT_LAYERS * 2,  noop_free,        "ol_pinned");
+    mgr->pin_generation = 0;
+    mgr->atlas_textures = texture_cache_create((int)MAX_TEXTURE_CACHE_SIZE, "ol_atlas_tex", GPU_MEM_ATLAS_CACHE,
+                                               on_atlas_blob_fetched);
+    texture_cache_set_adopter(mgr->atlas_textures, adopt_atlas_image);
+    texture_cache_set_versioner(mgr->atlas_textures, atlas_blob_version);
+    texture_cache_set_variant(mgr->atlas_textures, atlas_blob_variant);
+    texture_cache_set_preview(mgr->atlas_textures, atlas_blob_preview);
+    texture_cache_set_detail(mgr->atlas_textures, atlas_blob_detail);
+    texture_cache_set_fetch_class(mgr->atlas_textures, FETCH_CLASS_VISIBLE);
+    if (!s_meta_batch) {
+        s_meta_batch = fetch_batch_create(&(FetchBatchConfig){
+            .name        = "atlas-metadata-bulk",
+            .bulk_url    = "/api/atlas-sprite-sheet/metadata?itemKeys=",
+            .single_url  = ATLAS_META_URL_FORMAT,
+            .max_keys    = ATLAS_META_BATCH_MAX_KEYS,
+            .window_ms   = ATLAS_META_BATCH_WINDOW_MS,
+            .fetch_class = FETCH_CLASS_VISIBLE,
+            .on_bulk     = on_atlas_meta_bulk_fetched,
+            .on_item     = on_atlas_meta_fetched,
+        });
+    }
+    texture_cache_set_byte_budget(mgr->atlas_textures, MAX_TEXTURE_CACHE_BYTES);
+    atlas_pages_init(on_atlas_page_evicted);
+    mgr->catalog_generation = 0;
+    mgr->frame              = 0;
+    mgr->last_cancel_scan   = 0.0;
+    mgr->px_per_cell        = 0.0f;
 
     g_olm_singleton = mgr;
 }
@@ -211,7 +447,10 @@ void destroy_object_layers_manager(void) {
     hash_table_destroy(&g_olm_singleton->layers);
     hash_table_destroy(&g_olm_singleton->atlases);
     hash_table_destroy(&g_olm_singleton->meta);
+    hash_table_destroy(&g_olm_singleton->meta_retry);
+    hash_table_destroy(&g_olm_singleton->pinned);
     texture_cache_destroy(g_olm_singleton->atlas_textures);
+    atlas_pages_release();
 
     free(g_olm_singleton);
     g_olm_singleton = NULL;
@@ -219,64 +458,181 @@ void destroy_object_layers_manager(void) {
 
 /* ── Callback for atlas metadata REST fetch (via engine_client pipeline) ─── */
 
-static void on_atlas_meta_fetched(const FetchResponse* r) {
-    if (!r->success) { free(r->data); return; }
-
-    assert(g_olm_singleton);
+/* Take ownership of a parsed atlas under its item key; with `fetch_blob`,
+ * kick off its PNG now that the metadata is known. */
+static void cache_atlas(AtlasSpriteSheetData* atlas, bool fetch_blob) {
+    const char* item_key = atlas->item_key;
+    hash_table_put(&g_olm_singleton->atlases, item_key, atlas);
+    hash_table_remove(&g_olm_singleton->meta_retry, item_key);
+    g_olm_singleton->catalog_generation++;
+    LOG_INFO("[ATLAS REST] Metadata cached via callback for: %s (%dx%d)", item_key, atlas->atlas_width, atlas->atlas_height);
+    if (!fetch_blob) return;
 
-    /* Parse REST response: { "data": { "metadata": { itemKey, atlasWidth, ... } } } */
-    cJSON* root = cJSON_ParseWithLength((const char*)r->data, r->size);
-    free(r->data);
-    if (!root) return;
+    char url[512];
+    atlas_blob_url(item_key, url, sizeof(url));
+    if (META_PREFETCH == hash_table_get(&g_olm_singleton->meta, item_key)) {
+        texture_cache_warm(g_olm_singleton->atlas_textures, url, FETCH_CLASS_PREFETCH, TEX_RES_COLD);
+    } else {
+        load_or_poll_atlas_texture(item_key);
+    }
+    if (atlas_pinned(url)) texture_cache_set_residency(g_olm_singleton->atlas_textures, url, TEX_RES_PINNED);
+}
 
-    cJSON* doc   = cJSON_GetObjectItem(root, "data");
+/* Cache one atlas document ({ metadata: { itemKey, atlasWidth, ... } }).
+ * Returns the item key it was cached under, or NULL if skipped. */
+static const char* ingest_atlas_doc(const cJSON* doc, char* item_key) {
     cJSON* rmeta = doc ? cJSON_GetObjectItem(doc, "metadata") : NULL;
-    if (!rmeta) { cJSON_Delete(root); return; }
+    if (!rmeta) return NULL;
 
-    char item_key[MAX_ITEM_ID_LENGTH];
-    memset(item_key, 0, sizeof(item_key));
+    memset(item_key, 0, MAX_ITEM_ID_LENGTH);
     {
         char* ik = json_get_string_safe(rmeta, "itemKey", "");
         strncpy(item_key, ik, MAX_ITEM_ID_LENGTH - 1);
         free(ik);
     }
     if (item_key[0] == '\0' || hash_table_contains(&g_olm_singleton->atlases, item_key)) {
-        cJSON_Delete(root);
-        return;
+        return NULL;
     }
 
-    AtlasSpriteSheetData* atlas = create_atlas_sprite_sheet_data();
-    if (!atlas) { cJSON_Delete(root); return; }
+    /* Pool sized exactly from the frames present. */
+    cJSON* frames = cJSON_GetObjectItem(rmeta, "frames");
+    AtlasSpriteSheetData* atlas = create_atlas_sprite_sheet_data(count_ws_direction_frames(frames));
+    if (!atlas) return NULL;
 
     strncpy(atlas->item_key, item_key, MAX_ITEM_ID_LENGTH - 1);
     atlas->atlas_width    = json_get_int_safe(rmeta, "atlasWidth",  0);
     atlas->atlas_height   = json_get_int_safe(rmeta, "atlasHeight", 0);
     atlas->cell_pixel_dim = json_get_int_safe(rmeta, "cellPixelDim", 20);
     atlas->frame_duration = json_get_int_safe(rmeta, "frame_duration", 100);
-    cJSON* frames = cJSON_GetObjectItem(rmeta, "frames");
+    {
+        const cJSON* fmt = NULL;
+        cJSON* formats = cJSON_GetObjectItem(rmeta, "textureFormats");
+        if (cJSON_IsArray(formats)) {
+            cJSON_ArrayForEach(fmt, formats) {
+                if (!cJSON_IsString(fmt)) continue;
+                if (0 == strcmp(fmt->valuestring, "ktx2-bc1")) atlas->texture_variants |= ATLAS_VARIANT_KTX2_BC1;
+                if (0 == strcmp(fmt->valuestring, "ktx2-bc3")) atlas->texture_variants |= ATLAS_VARIANT_KTX2_BC3;
+                if (0 == strcmp(fmt->valuestring, "png-preview")) atlas->texture_variants |= ATLAS_VARIANT_PREVIEW;
+            }
+        }
+    }
     if (frames) parse_ws_direction_frames(frames, atlas);
 
-    hash_table_put(&g_olm_singleton->atlases, item_key, atlas);
-    LOG_INFO("[ATLAS REST] Metadata cached via callback for: %s (%dx%d)", item_key, atlas->atlas_width, atlas->atlas_height);
+    cache_atlas(atlas, true);
+    return item_key;
+}
+
+/* A binary descriptor (atlas_meta_bin.h) for `item_key`; false when it is
+ * malformed or describes another item. */
+static bool ingest_atlas_bin(const void* data, size_t size, const char* item_key, bool fetch_blob) {
+    AtlasSpriteSheetData* atlas = atlas_meta_bin_parse(data, size);
+    if (!atlas || 0 != strcmp(atlas->item_key, item_key)) {
+        LOG_WARN("[ATLAS REST] %s: malformed atlas descriptor", item_key);
+        free_atlas_sprite_sheet_data(atlas);
+        return false;
+    }
+    if (hash_table_contains(&g_olm_singleton->atlases, item_key)) {
+        free_atlas_sprite_sheet_data(atlas);
+        return true;
+    }
+    cache_atlas(atlas, fetch_blob);
+    return true;
+}
 
-    /* Kick off PNG blob fetch now that metadata is cached */
-    load_or_poll_atlas_texture(item_key);
+/* The request gave up (engine_client already retried it): the item draws
+ * as a fallback until the backoff lets a draw ask again. */
+static void note_meta_failed(const char* item_key) {
+    if (hash_table_contains(&g_olm_singleton->atlases, item_key)) return;
+
+    MetaRetry* m = hash_table_get(&g_olm_singleton->meta_retry, item_key);
+    if (!m) {
+        m = calloc(1, sizeof(*m));
+        assert(m);
+        hash_table_put(&g_olm_singleton->meta_retry, item_key, m);
+    }
+    double wait = ATLAS_META_RETRY_SECONDS * (double)(1 << (m->failures < 8 ? m->failures : 8));
+    if (ATLAS_META_RETRY_MAX_SECONDS < wait) wait = ATLAS_META_RETRY_MAX_SECONDS;
+    m->failures++;
+    m->retry_at = GetTime() + wait;
+    hash_table_put(&g_olm_singleton->meta, item_key, META_FAILED);
+    LOG_WARN("[ATLAS REST] metadata for %s failed (%d); asking again in %.0f s",
+             item_key, m->failures, wait);
+}
+
+static void on_atlas_meta_fetched(const FetchResponse* r) {
+    assert(g_olm_singleton);
+    if (!r->success) {
+        note_meta_failed(r->asset_id);
+        return;
+    }
+
+    /* A binary descriptor, when the engine serves one. */
+    if (atlas_meta_bin_is(r->data, r->size)) {
+        if (!ingest_atlas_bin(r->data, r->size, r->asset_id, true)) note_meta_failed(r->asset_id);
+        return;
+    }
+
+    /* Parse REST response: { "data": { "metadata": { itemKey, atlasWidth, ... } } } */
+    cJSON* root = serial_json_parse((const char*)r->data, r->size);
+    char item_key[MAX_ITEM_ID_LENGTH];
+    if (!root || !ingest_atlas_doc(cJSON_GetObjectItem(root, "data"), item_key)) {
+        note_meta_failed(r->asset_id);
+    }
+    serial_json_free(root);
+}
+
+/* Bulk response: { "data": [ { metadata: {...} }, ... ] }. Each document
+ * is cached as if fetched alone, and persisted the way the single route's
+ * response would have been so the next session finds it locally. */
+static void on_atlas_meta_bulk_fetched(const FetchResponse* r) {
+    if (!r->success) { return; }
+
+    assert(g_olm_singleton);
 
-    cJSON_Delete(root);
+    cJSON* root = serial_json_parse((const char*)r->data, r->size);
+    if (!root) return;
+
+    cJSON* docs = cJSON_GetObjectItem(root, "data");
+    if (!cJSON_IsArray(docs)) { serial_json_free(root); return; }
+    hash_table_reserve(&g_olm_singleton->atlases,
+                       g_olm_singleton->atlases.count + (size_t)cJSON_GetArraySize(docs));
+    cJSON* doc = NULL;
+    cJSON_ArrayForEach(doc, docs) {
+        char item_key[MAX_ITEM_ID_LENGTH];
+        if (!ingest_atlas_doc(doc, item_key)) continue;
+
+        const char* version = atlas_content_version(item_key, true);
+        if (!version) continue;
+        cJSON* single = cJSON_CreateObject();
+        cJSON_AddItemReferenceToObject(single, "data", doc);
+        char* body = cJSON_PrintUnformatted(single);
+        if (body) {
+            char url[512];
+            atlas_meta_url(item_key, url, sizeof(url));
+            fetch_persist_store(url, version, body, strlen(body));
+            cJSON_free(body);
+        }
+        cJSON_Delete(single);
+    }
+    serial_json_free(root);
 }
 
 AtlasSpriteSheetData* get_or_fetch_atlas_data(const char* item_key) {
     assert(item_key);
+    return get_or_fetch_atlas_data_h(hash_key(item_key));
+}
+
+AtlasSpriteSheetData* get_or_fetch_atlas_data_h(HashKey item_key) {
     assert(g_olm_singleton);
 
-    AtlasSpriteSheetData* atlas = hash_table_get(&g_olm_singleton->atlases, item_key);
+    AtlasSpriteSheetData* atlas = hash_table_get_h(&g_olm_singleton->atlases, item_key);
     if (!atlas) {
-        get_atlas_texture(item_key);
+        get_atlas_texture(item_key.str);
     }
     return atlas;
 }
 
-Texture2D get_atlas_texture(const char* item_key) {
+AtlasRegion get_atlas_texture(const char* item_key) {
     assert(item_key);
     assert(g_olm_singleton);
 
@@ -284,10 +640,61 @@ Texture2D get_atlas_texture(const char* item_key) {
         return load_or_poll_atlas_texture(item_key);
     }
 
-    if (!hash_table_contains(&g_olm_singleton->meta, item_key)) {
-        obj_layers_mgr_schedule_atlas_fetch(item_key);
+    void* asked = hash_table_get(&g_olm_singleton->meta, item_key);
+    if (!asked || META_FAILED == asked) obj_layers_mgr_schedule_atlas_fetch(item_key);
+    return (AtlasRegion){0};
+}
+
+AtlasRegion obj_layers_mgr_atlas_region(AtlasSpriteSheetData* atlas) {
+    assert(atlas);
+    assert(g_olm_singleton);
+    if ('\0' == atlas->item_key[0]) return (AtlasRegion){0};
+
+    struct AtlasResidency* res = atlas->residency;
+    if (!res) {
+        res = calloc(1, sizeof(*res));
+        assert(res);
+        atlas->residency = res;
+        resolve_residency(atlas->item_key, res);
+    } else if (residency_epoch() != res->epoch ||
+               (0 == res->region.texture.id && g_olm_singleton->frame != res->touch_frame)) {
+        /* Still loading: ask once a frame, which also tells the cache the
+         * pending fetch is still wanted. */
+        resolve_residency(atlas->item_key, res);
+    } else if (g_olm_singleton->frame != res->touch_frame) {
+        /* Keep LRU / idle timers fresh, once per frame rather than per layer. */
+        res->touch_frame = g_olm_singleton->frame;
+        if (res->page) atlas_pages_touch(res->page);
+        if (res->entry) texture_cache_touch(g_olm_singleton->atlas_textures, res->entry);
+    }
+    return res->region;
+}
+
+void obj_layers_mgr_begin_frame(float px_per_cell) {
+    assert(g_olm_singleton);
+    g_olm_singleton->frame++;
+    g_olm_singleton->px_per_cell = px_per_cell;
+    atlas_pages_update_mipmaps();
+
+    /* Blobs no longer drawn (their entities left the AOI) give their queue
+     * place back to what is on screen now. */
+    double now = GetTime();
+    if (now - g_olm_singleton->last_cancel_scan >= ATLAS_FETCH_CANCEL_SCAN_SECONDS) {
+        g_olm_singleton->last_cancel_scan = now;
+        int n = texture_cache_cancel_unwanted(g_olm_singleton->atlas_textures,
+                                              ATLAS_FETCH_CANCEL_IDLE_SECONDS);
+        if (n > 0) LOG_INFO("[ATLAS REST] cancelled %d queued blob fetches no longer drawn", n);
     }
-    return (Texture2D){0};
+}
+
+unsigned obj_layers_mgr_atlas_generation(void) {
+    assert(g_olm_singleton);
+    return texture_cache_generation(g_olm_singleton->atlas_textures);
+}
+
+unsigned obj_layers_mgr_catalog_generation(void) {
+    assert(g_olm_singleton);
+    return g_olm_singleton->catalog_generation;
 }
 
 // ============================================================================
@@ -298,17 +705,109 @@ void obj_layers_mgr_schedule_atlas_fetch(const char* item_key) {
     assert(item_key);
     assert(g_olm_singleton);
 
-    if (hash_table_contains(&g_olm_singleton->meta, item_key)) return;
+    void* asked = hash_table_get(&g_olm_singleton->meta, item_key);
+    if (META_PREFETCH == asked) {
+        /* Drawn before the prefetched metadata landed: blob at full priority. */
+        hash_table_put(&g_olm_singleton->meta, item_key, META_SENTINEL);
+        return;
+    }
+    if (META_EMBEDDED == asked) {
+        /* Keeps the in-flight blob wanted, as a draw of a known atlas does. */
+        load_or_poll_atlas_texture(item_key);
+        return;
+    }
+    bool retry = META_FAILED == asked;
+    if (retry) {
+        const MetaRetry* m = hash_table_get(&g_olm_singleton->meta_retry, item_key);
+        if (m && GetTime() < m->retry_at) return;
+    } else if (asked) {
+        return;
+    }
     if (hash_table_contains(&g_olm_singleton->atlases, item_key)) return;
 
+    /* One fetch: the blob describes itself. Retries take the metadata route. */
+    if (!retry && presentation_runtime_atlas_embedded_meta()) {
+        hash_table_put(&g_olm_singleton->meta, item_key, META_EMBEDDED);
+        load_or_poll_atlas_texture(item_key);
+        LOG_INFO("[ATLAS REST] Blob with embedded descriptor scheduled: %s", item_key);
+        return;
+    }
+    request_atlas_meta(item_key);
+}
+
+static void request_atlas_meta(const char* item_key) {
     hash_table_put(&g_olm_singleton->meta, item_key, META_SENTINEL);
 
-    char url[512];
-    snprintf(url, sizeof(url), "/api/atlas-sprite-sheet/metadata/%s", item_key);
-    fetch_request_start(item_key, url, on_atlas_meta_fetched);
+    fetch_batch_request(s_meta_batch, item_key, atlas_content_version(item_key, true));
     LOG_INFO("[ATLAS REST] Fetch scheduled via engine_client: %s", item_key);
 }
 
+void obj_layers_mgr_prefetch_atlas(const char* item_key, TextureResidency res) {
+    assert(item_key);
+    assert(g_olm_singleton);
+    if ('\0' == item_key[0]) return;
+
+    if (hash_table_contains(&g_olm_singleton->atlases, item_key)) {
+        /* Paged blobs have left the cache; warming them would refetch. */
+        char url[512];
+        atlas_blob_url(item_key, url, sizeof(url));
+        if (atlas_pages_find(url)) return;
+        texture_cache_warm(g_olm_singleton->atlas_textures, url, FETCH_CLASS_PREFETCH, res);
+        return;
+    }
+    if (hash_table_contains(&g_olm_singleton->meta, item_key)) return;
+
+    if (presentation_runtime_atlas_embedded_meta()) {
+        char url[512];
+        atlas_blob_url(item_key, url, sizeof(url));
+        hash_table_put(&g_olm_singleton->meta, item_key, META_EMBEDDED);
+        texture_cache_warm(g_olm_singleton->atlas_textures, url, FETCH_CLASS_PREFETCH, res);
+        return;
+    }
+
+    /* Metadata is small and rides the shared batch; the prefetch class
+     * applies to the blob that follows it. */
+    hash_table_put(&g_olm_singleton->meta, item_key, META_PREFETCH);
+    fetch_batch_request(s_meta_batch, item_key, atlas_content_version(item_key, true));
+}
+
+static bool unpin_if_stale(const char* url, void* value, void* user_data) {
+    if ((uintptr_t)value == *(const unsigned*)user_data) return false;
+    atlas_pages_set_pinned(url, false);
+    texture_cache_set_residency(g_olm_singleton->atlas_textures, url, TEX_RES_WARM);
+    return true;
+}
+
+void obj_layers_mgr_pin_atlases(const char* const* item_keys, int count) {
+    assert(item_keys || 0 == count);
+    assert(g_olm_singleton);
+    /* Generation 0 never names a set, so every value stored is nonzero. */
+    unsigned gen = ++g_olm_singleton->pin_generation;
+    if (0 == gen) gen = ++g_olm_singleton->pin_generation;
+    hash_table_reserve(&g_olm_singleton->pinned, g_olm_singleton->pinned.count + (size_t)count);
+
+    for (int i = 0; i < count; i++) {
+        if ('\0' == item_keys[i][0]) continue;
+        char url[512];
+        atlas_blob_url(item_keys[i], url, sizeof(url));
+        bool was_pinned = atlas_pinned(url);
+        hash_table_put(&g_olm_singleton->pinned, url, (void*)(uintptr_t)gen);
+        if (was_pinned) continue;
+        /* Not cached yet: fetched now, and pinned as it lands (cache_atlas,
+         * the adopter). */
+        atlas_pages_set_pinned(url, true);
+        if (!texture_cache_set_residency(g_olm_singleton->atlas_textures, url, TEX_RES_PINNED)) {
+            obj_layers_mgr_prefetch_atlas(item_keys[i], TEX_RES_PINNED);
+        }
+    }
+    hash_table_remove_if(&g_olm_singleton->pinned, unpin_if_stale, &gen);
+}
+
+void obj_layers_mgr_atlas_residency(int out[TEX_RES_COUNT]) {
+    assert(g_olm_singleton);
+    texture_cache_residency_counts(g_olm_singleton->atlas_textures, out);
+}
+
 void populate_object_layer_from_json(const char* item_id, const cJSON* ol_json) {
     assert(ol_json);
     assert(item_id);
@@ -328,28 +827,25 @@ void populate_object_layer_from_json(const char* item_id, const cJSON* ol_json)
         strncpy(layer->data.item.id, item_id, MAX_ITEM_ID_LENGTH - 1);
     }
 
+    obj_layers_mgr_put_layer(item_id, layer);
+}
+
+void obj_layers_mgr_put_layer(const char* item_id, ObjectLayer* layer) {
+    assert(item_id);
+    assert(layer);
+    assert(g_olm_singleton);
+
     hash_table_put(&g_olm_singleton->layers, item_id, layer);
+    g_olm_singleton->catalog_generation++;
 }
 
 static void parse_ws_direction_frames(cJSON* frames_json, AtlasSpriteSheetData* atlas) {
     assert(frames_json);
     assert(atlas);
-    parse_direction_frame_data(cJSON_GetObjectItem(frames_json, "up_idle"), &atlas->up_idle);
-    parse_direction_frame_data(cJSON_GetObjectItem(frames_json, "down_idle"), &atlas->down_idle);
-    parse_direction_frame_data(cJSON_GetObjectItem(frames_json, "right_idle"), &atlas->right_idle);
-    parse_direction_frame_data(cJSON_GetObjectItem(frames_json, "left_idle"), &atlas->left_idle);
-    parse_direction_frame_data(cJSON_GetObjectItem(frames_json, "up_right_idle"), &atlas->up_right_idle);
-    parse_direction_frame_data(cJSON_GetObjectItem(frames_json, "down_right_idle"), &atlas->down_right_idle);
-    parse_direction_frame_data(cJSON_GetObjectItem(frames_json, "up_left_idle"), &atlas->up_left_idle);
-    parse_direction_frame_data(cJSON_GetObjectItem(frames_json, "down_left_idle"), &atlas->down_left_idle);
-    parse_direction_frame_data(cJSON_GetObjectItem(frames_json, "default_idle"), &atlas->default_idle);
-    parse_direction_frame_data(cJSON_GetObjectItem(frames_json, "up_walking"), &atlas->up_walking);
-    parse_direction_frame_data(cJSON_GetObjectItem(frames_json, "down_walking"), &atlas->down_walking);
-    parse_direction_frame_data(cJSON_GetObjectItem(frames_json, "right_walking"), &atlas->right_walking);
-    parse_direction_frame_data(cJSON_GetObjectItem(frames_json, "left_walking"), &atlas->left_walking);
-    parse_direction_frame_data(cJSON_GetObjectItem(frames_json, "up_right_walking"), &atlas->up_right_walking);
-    parse_direction_frame_data(cJSON_GetObjectItem(frames_json, "down_right_walking"), &atlas->down_right_walking);
-    parse_direction_frame_data(cJSON_GetObjectItem(frames_json, "up_left_walking"), &atlas->up_left_walking);
-    parse_direction_frame_data(cJSON_GetObjectItem(frames_json, "down_left_walking"), &atlas->down_left_walking);
-    parse_direction_frame_data(cJSON_GetObjectItem(frames_json, "none_idle"), &atlas->none_idle);
+    int cursor = 0;
+    for (int i = 0; i < ATLAS_ANIM_COUNT; i++) {
+        parse_direction_frame_data(cJSON_GetObjectItem(frames_json, atlas_anim_name((AtlasAnim)i)),
+                                   atlas, (AtlasAnim)i, &cursor);
+    }
+    atlas_build_frame_table(atlas);
 }
@@ -1,7 +1,10 @@
 #ifndef OBJECT_LAYERS_MANAGEMENT_H
 #define OBJECT_LAYERS_MANAGEMENT_H
 
+#include "atlas_pages.h"
+#include "hash_table.h"
 #include "object_layer.h"
+#include "texture_residency.h"
 #include <raylib.h>
 #include <cJSON.h>
 #include <stddef.h>
@@ -68,6 +71,20 @@ ObjectLayersManager* obj_layers_mgr_get(void);
 
 ObjectLayer* lookup_cached_layer(const char* item_id);
 
+/* Prehashed lookups for per-layer, per-frame callers; see
+ * object_layer_state_key(). */
+ObjectLayer*          lookup_cached_layer_h(HashKey item_id);
+AtlasSpriteSheetData* get_or_fetch_atlas_data_h(HashKey item_key);
+
+/* Lookup key of a layer's item id. Decoders hash it once per item change
+ * (item_hash); layers built elsewhere (UI previews, FX) hash per call. */
+static inline HashKey object_layer_state_key(const ObjectLayerState* state) {
+    return (HashKey){
+        .hash = state->item_hash ? state->item_hash : hash_table_hash(state->item_id),
+        .str  = state->item_id,
+    };
+}
+
 // ============================================================================
 // Public API - Atlas Sprite Sheet Fetching and Caching
 // ============================================================================
@@ -99,16 +116,59 @@ ObjectLayer* lookup_cached_layer(const char* item_id);
 AtlasSpriteSheetData* get_or_fetch_atlas_data(const char* item_key);
 
 /**
- * @brief Retrieves the cached atlas GPU texture for a given item key
+ * @brief Retrieves where the atlas of a given item key lives on the GPU
  *
- * Returns the Texture2D for the consolidated atlas PNG. The texture
- * is fetched asynchronously from the atlas-sprite-sheet blob API
- * using the item key and cached for subsequent calls.
+ * The consolidated atlas PNG is fetched asynchronously from the
+ * atlas-sprite-sheet blob API and, once decoded, copied into a shared
+ * atlas page (atlas_pages.h) or, when too large, kept as a texture of its
+ * own. Frame rects from the atlas metadata are offset by the region's
+ * (x, y). Pages compact and move regions, so don't keep the result across
+ * frames; per-draw callers holding the atlas use obj_layers_mgr_atlas_region().
  *
  * @param item_key The item identifier key (e.g., "anon", "lain")
- * @return The atlas Texture2D. Returns empty texture (id=0) if not found or not loaded.
+ * @return The atlas region. texture.id is 0 if not found or not loaded.
+ */
+AtlasRegion get_atlas_texture(const char* item_key);
+
+/**
+ * @brief Retrieves where an already-cached atlas lives on the GPU
+ *
+ * Same result as get_atlas_texture(atlas->item_key), without the per-call
+ * URL formatting and hash lookups: the region is remembered on the atlas
+ * and re-resolved only after an atlas texture loads, moves or is evicted.
+ * The backing texture's LRU timestamp is refreshed once per frame.
+ *
+ * @param atlas Atlas metadata from get_or_fetch_atlas_data()
+ * @return The atlas region. texture.id is 0 if not loaded yet.
+ */
+AtlasRegion obj_layers_mgr_atlas_region(AtlasSpriteSheetData* atlas);
+
+/**
+ * @brief Advance the frame counter behind obj_layers_mgr_atlas_region()'s
+ *        once-per-frame LRU touch. Call once at the start of each frame.
+ * @param px_per_cell Pixels one world cell covers where the world is drawn
+ *        (camera zoom × cell size, per world target texel). Atlases whose
+ *        cells cover fewer pixels than their cellPixelDim keep a preview
+ *        tier instead of streaming the full image; 0 always streams it.
+ */
+void obj_layers_mgr_begin_frame(float px_per_cell);
+
+/**
+ * @brief Generation of the atlas texture cache.
+ *
+ * Changes whenever an atlas texture finishes loading, so render caches
+ * baked from atlases know a previously-missing layer may now be drawable.
+ */
+unsigned obj_layers_mgr_atlas_generation(void);
+
+/**
+ * @brief Generation of the ObjectLayer / atlas metadata tables.
+ *
+ * Changes whenever an entry is inserted or replaced, which may free the
+ * previous ObjectLayer* / AtlasSpriteSheetData*; holders of those pointers
+ * re-resolve when it moves.
  */
-Texture2D get_atlas_texture(const char* item_key);
+unsigned obj_layers_mgr_catalog_generation(void);
 
 // ============================================================================
 // Public API - Cache Population from WebSocket Metadata
@@ -125,6 +185,14 @@ Texture2D get_atlas_texture(const char* item_key);
  */
 void populate_object_layer_from_json(const char* item_id, const cJSON* ol_json);
 
+/**
+ * @brief Cache an ObjectLayer built by the caller (binary metadata path).
+ *
+ * Takes ownership of `layer` (from create_object_layer) and replaces any
+ * entry under `item_id`.
+ */
+void obj_layers_mgr_put_layer(const char* item_id, ObjectLayer* layer);
+
 /* Dead — no external callers. Atlas population flows through
  * obj_layers_mgr_schedule_atlas_fetch + on_atlas_meta_fetched (REST path).
  *
@@ -141,10 +209,50 @@ void populate_object_layer_from_json(const char* item_id, const cJSON* ol_json);
  * After metadata is received, get_atlas_texture() automatically fetches
  * and caches the PNG blob on the next call.
  *
+ * When the item's ObjectLayer is already cached, both the metadata and the
+ * blob persist in IndexedDB keyed by its render CIDs (or sha256), so warm
+ * sessions load them without touching the network.
+ *
+ * The route may answer with the binary descriptor of atlas_meta_bin.h
+ * instead of JSON. With the atlasEmbeddedMeta hint only the blob is
+ * fetched, its PNG carrying the descriptor as a chunk; the metadata route
+ * is asked only when the chunk is missing.
+ *
  * Safe to call multiple times — repeated calls for the same item_key are no-ops.
  *
  * @param item_key The item identifier key (= metadata.itemKey from the atlas doc)
  */
 void obj_layers_mgr_schedule_atlas_fetch(const char* item_key);
 
+/**
+ * @brief Fetch an atlas that is likely to be drawn soon, at prefetch priority.
+ *
+ * Metadata rides the shared batch; the blob queues behind everything
+ * visible. Calling it again keeps a pending blob fetch wanted, and a draw
+ * of the same atlas raises it to full priority. No-op once paged.
+ *
+ * @param item_key The item identifier key
+ * @param res      Residency the cached blob gets (or is raised to):
+ *                 TEX_RES_WARM for what is in the AOI, TEX_RES_COLD for
+ *                 speculative warm-ups. Blobs that wait for metadata first
+ *                 start cold; the next call raises them.
+ */
+void obj_layers_mgr_prefetch_atlas(const char* item_key, TextureResidency res);
+
+/**
+ * @brief Replace the set of pinned atlases.
+ *
+ * Pinned blobs are never evicted for capacity, budget, memory pressure or
+ * idleness — neither from the texture cache nor from the atlas pages — and
+ * are fetched if absent. Keys dropped from the set since the last call are
+ * unpinned and age out like any nearby atlas.
+ *
+ * @param item_keys Item keys to keep resident (empty strings are skipped)
+ * @param count     Number of keys
+ */
+void obj_layers_mgr_pin_atlases(const char* const* item_keys, int count);
+
+/** @brief Settled atlas cache entries per residency class (dev overlay). */
+void obj_layers_mgr_atlas_residency(int out[TEX_RES_COUNT]);
+
 #endif // OBJECT_LAYERS_MANAGEMENT_H
@@ -13,6 +13,7 @@
  */
 
 #include "ol_as_animated_ico.h"
+#include "render_stats.h"
 #include <raylib.h>
 #include <string.h>
 #include <assert.h>
@@ -26,38 +27,32 @@ static void fallback_circle(int x, int y, int icon_size) {
 }
 
 /* get_frames_with_fallback tries dir_str, then "down_idle", then "default_idle". */
-static const DirectionFrameData* get_frames_with_fallback(
+static DirectionFrameData get_frames_with_fallback(
         const AtlasSpriteSheetData* atlas, const char* dir_str) {
-    const DirectionFrameData* dfd = NULL;
+    DirectionFrameData dfd = { 0 };
 
     if (dir_str && dir_str[0] != '\0') {
         dfd = atlas_get_direction_frames(atlas, dir_str);
-        if (dfd && dfd->count > 0) return dfd;
+        if (dfd.count > 0) return dfd;
     }
 
     /* Fallback 1: down_idle */
     dfd = atlas_get_direction_frames(atlas, "down_idle");
-    if (dfd && dfd->count > 0) return dfd;
+    if (dfd.count > 0) return dfd;
 
     /* Fallback 2: default_idle */
-    dfd = atlas_get_direction_frames(atlas, "default_idle");
-    if (dfd && dfd->count > 0) return dfd;
-
-    return NULL;
+    return atlas_get_direction_frames(atlas, "default_idle");
 }
 
 /* ── Public API ────────────────────────────────────────────────────────── */
 
-void ol_as_ico_draw(ObjectLayersManager* mgr,
-                    const char* item_key,
-                    int x, int y, int icon_size,
-                    const char* dir_str,
-                    int frame_ms,
-                    Color tint) {
-    if (!mgr || !item_key || item_key[0] == '\0') {
-        fallback_circle(x, y, icon_size);
-        return;
-    }
+bool ol_as_ico_frame(ObjectLayersManager* mgr,
+                     const char* item_key,
+                     const char* dir_str,
+                     int frame_ms,
+                     IconLayer* out) {
+    assert(out);
+    if (!mgr || !item_key || item_key[0] == '\0') return false;
 
     AtlasSpriteSheetData* atlas = get_or_fetch_atlas_data(item_key);
     if (!atlas) {
@@ -66,31 +61,41 @@ void ol_as_ico_draw(ObjectLayersManager* mgr,
          * Once metadata arrives, get_atlas_texture will automatically kick off
          * the PNG blob fetch on the next frame. */
         get_atlas_texture(item_key);
-        fallback_circle(x, y, icon_size);
-        return;
+        return false;
     }
 
-    Texture2D tex = get_atlas_texture(item_key);
-    if (tex.id == 0) {
-        fallback_circle(x, y, icon_size);
-        return;
-    }
+    AtlasRegion region = obj_layers_mgr_atlas_region(atlas);
+    if (region.texture.id == 0) return false;
+
+    DirectionFrameData dfd = get_frames_with_fallback(atlas, dir_str);
+    if (dfd.count == 0) return false;
 
-    const DirectionFrameData* dfd = get_frames_with_fallback(atlas, dir_str);
-    if (!dfd || dfd->count == 0) {
+    int ms_per_frame = (frame_ms > 0) ? frame_ms : OL_ICO_DEFAULT_FRAME_MS;
+    int frame_idx    = (int)(GetTime() * 1000.0 / ms_per_frame) % dfd.count;
+    const FrameMetadata* fm = &dfd.frames[frame_idx];
+
+    *out = (IconLayer){
+        .texture = region.texture,
+        .src     = { (float)(region.x + fm->x), (float)(region.y + fm->y),
+                     (float)fm->width, (float)fm->height },
+    };
+    return true;
+}
+
+void ol_as_ico_draw(ObjectLayersManager* mgr,
+                    const char* item_key,
+                    int x, int y, int icon_size,
+                    const char* dir_str,
+                    int frame_ms,
+                    Color tint) {
+    IconLayer layer;
+    if (!ol_as_ico_frame(mgr, item_key, dir_str, frame_ms, &layer)) {
         fallback_circle(x, y, icon_size);
         return;
     }
-
-    int ms_per_frame = (frame_ms > 0) ? frame_ms : OL_ICO_DEFAULT_FRAME_MS;
-    int frame_idx    = (int)(GetTime() * 1000.0 / ms_per_frame) % dfd->count;
-    const FrameMetadata* fm = &dfd->frames[frame_idx];
-
-    Rectangle src = { (float)fm->x, (float)fm->y,
-                      (float)fm->width, (float)fm->height };
-    Rectangle dst = { (float)x, (float)y,
-                      (float)icon_size, (float)icon_size };
-    DrawTexturePro(tex, src, dst, (Vector2){0.0f, 0.0f}, 0.0f, tint);
+    int cell = icon_atlas_find(&layer, 1, icon_size);
+    if (0 <= cell) icon_atlas_blit(cell, x, y, tint);
+    else           icon_atlas_draw_live(&layer, 1, x, y, icon_size, tint);
 }
 
 void ol_as_ico_draw_safe(ObjectLayersManager* mgr,
@@ -18,6 +18,9 @@
  *     "down_walking", "up_walking", "left_walking", "right_walking",
  *     "default_idle", etc.
  *
+ * Frames are drawn through the shared UI icon page (ui/icon_atlas.h): once
+ * baked, an icon is one quad from one texture whatever atlas it came from.
+ *
  * Dependencies: object_layers_management.h, object_layer.h, raylib.h
  */
 
@@ -26,6 +29,7 @@
 
 #include "object_layers_management.h"
 #include "object_layer.h"
+#include "ui/icon_atlas.h"
 #include <raylib.h>
 
 /* ── Default animation parameters ────────────────────────────────────── */
@@ -36,6 +40,21 @@
 /** Default frame duration in milliseconds (matches in-world entity render). */
 #define OL_ICO_DEFAULT_FRAME_MS 100
 
+/**
+ * @brief Resolve the current animation frame of @p item_key.
+ *
+ * Same atlas lookup, direction fallback and GetTime()-driven frame choice as
+ * ol_as_ico_draw, without drawing.  Kicks off the atlas fetch when it is not
+ * cached yet.
+ *
+ * @return false while the atlas or its texture is unavailable.
+ */
+bool ol_as_ico_frame(ObjectLayersManager* mgr,
+                     const char* item_key,
+                     const char* dir_str,
+                     int frame_ms,
+                     IconLayer* out);
+
 /**
  * @brief Draw an animated ObjectLayer icon.
  *
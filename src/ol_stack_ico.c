@@ -2,9 +2,10 @@
  * @file ol_stack_ico.c
  * @brief Centralized OL-stack-as-icon renderer implementation.
  *
- * Draws active layers sorted by the canonical z-order (skin first,
- * weapon on top) via layer_z_sort(), then composites each layer
- * with ol_as_ico_draw at the same (x,y).
+ * Resolves the active layers sorted by the canonical z-order (skin first,
+ * weapon on top) via layer_z_sort() and draws the composite through the
+ * UI icon page as one quad. While any layer is still loading, each layer
+ * goes through ol_as_ico_draw instead, grey placeholder included.
  */
 
 #include "ol_stack_ico.h"
@@ -28,9 +29,22 @@ void ol_stack_ico_draw(ObjectLayersManager* mgr,
     LayerZEntry sorted[OL_STACK_ICO_MAX_LAYERS];
     int n = layer_z_sort(layers, count, sorted, OL_STACK_ICO_MAX_LAYERS, facing_up);
 
-    for (int i = 0; i < n; i++) {
-        const ObjectLayerState* s = &layers[sorted[i].index];
-        ol_as_ico_draw(mgr, s->item_id, x, y, icon_size,
-                       dir_str, frame_ms, tint);
+    IconLayer frames[OL_STACK_ICO_MAX_LAYERS];
+    int resolved = 0;
+    while (resolved < n && ol_as_ico_frame(mgr, layers[sorted[resolved].index].item_id, dir_str,
+                                           frame_ms, &frames[resolved])) {
+        resolved++;
     }
+    if (resolved < n) {
+        for (int i = 0; i < n; i++) {
+            const ObjectLayerState* s = &layers[sorted[i].index];
+            ol_as_ico_draw(mgr, s->item_id, x, y, icon_size,
+                           dir_str, frame_ms, tint);
+        }
+        return;
+    }
+
+    int cell = icon_atlas_find(frames, n, icon_size);
+    if (0 <= cell) icon_atlas_blit(cell, x, y, tint);
+    else           icon_atlas_draw_live(frames, n, x, y, icon_size, tint);
 }
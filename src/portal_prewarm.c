@@ -0,0 +1,67 @@
+#include "portal_prewarm.h"
+
+#include "config.h"
+#include "domain/local_player.h"
+#include "game_state.h"
+#include "object_layers_management.h"
+#include "serial.h"
+#include "static_world.h"
+
+#include <raylib.h>
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+/* `map_code` is the destination being warmed, "" for none; item_count is
+ * -1 until its static layer was here to be read. */
+static struct {
+    char   map_code[MAX_ID_LENGTH];
+    char   items[PORTAL_PREWARM_ITEMS][MAX_ITEM_ID_LENGTH];
+    int    item_count;
+    double next_ask;
+} g_prewarm;
+
+/* The portal under the local player's centre, or NULL. */
+static const WorldObject* held_portal(void) {
+    const GameState*   gs   = &g_game_state;
+    const EntityState* self = &gs->player.base;
+    Vector2 center = { self->interp_pos.x + self->dims.x * 0.5f,
+                       self->interp_pos.y + self->dims.y * 0.5f };
+    for (int i = 0; i < gs->portal_count; i++) {
+        const WorldObject* p = &gs->portals[i];
+        Rectangle r = { p->pos.x, p->pos.y, p->dims.x, p->dims.y };
+        if (CheckCollisionPointRec(center, r)) return p;
+    }
+    return NULL;
+}
+
+void portal_prewarm_update(void) {
+    if (!local_player_on_portal() ||
+        PORTAL_PREWARM_PROGRESS > local_player_portal_hold_progress()) {
+        g_prewarm.map_code[0] = '\0';
+        return;
+    }
+    const WorldObject* portal = held_portal();
+    if (!portal || '\0' == portal->target_map_code[0] ||
+        0 == strcmp(portal->target_map_code, g_game_state.player.map_code)) {
+        return;
+    }
+    if (0 != strcmp(g_prewarm.map_code, portal->target_map_code)) {
+        snprintf(g_prewarm.map_code, sizeof(g_prewarm.map_code), "%s", portal->target_map_code);
+        g_prewarm.item_count = -1;
+        g_prewarm.next_ask   = 0.0;
+        if (0 != (g_game_state.wire_ack_caps_ext & WIRE_CAP_EXT_STATIC_WORLD)) {
+            static_world_prewarm(g_prewarm.map_code);
+        }
+    }
+    if (0 > g_prewarm.item_count) {
+        g_prewarm.item_count = static_world_item_ids(g_prewarm.map_code, g_prewarm.items,
+                                                     PORTAL_PREWARM_ITEMS);
+        if (0 > g_prewarm.item_count) return;
+    }
+    double now = GetTime();
+    if (now < g_prewarm.next_ask) return;
+    g_prewarm.next_ask = now + ATLAS_PREFETCH_SCAN_SECONDS;
+    for (int i = 0; i < g_prewarm.item_count; i++) obj_layers_mgr_prefetch_atlas(g_prewarm.items[i], TEX_RES_COLD);
+}
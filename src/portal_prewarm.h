@@ -0,0 +1,27 @@
+#ifndef CYBERIA_PORTAL_PREWARM_H
+#define CYBERIA_PORTAL_PREWARM_H
+
+/*
+ * Portal transition prewarm.
+ *
+ * A teleport otherwise lands on an empty map: the static layer is fetched
+ * only once the server announces it, and its atlases only once they are
+ * drawn. While the local player holds a portal past
+ * PORTAL_PREWARM_PROGRESS, the portal's target_map_code is warmed instead:
+ * static_world_prewarm fetches its blob (on a server that acked
+ * WIRE_CAP_EXT_STATIC_WORLD), and once it (or a layer of the map
+ * kept from an earlier visit) is here the atlases it draws are asked for
+ * through obj_layers_mgr_prefetch_atlas every ATLAS_PREFETCH_SCAN_SECONDS,
+ * so the queued blobs are not cancelled before arrival. Everything queues
+ * at FETCH_CLASS_PREFETCH, behind what the current map draws, and is cached
+ * cold: evicted before anything the current map uses.
+ *
+ * Entity-type defaults are session-wide and already swept by
+ * atlas_prefetch.h. Leaving the portal stops the atlas requests; a blob
+ * already fetched stays for a later hold of the same portal.
+ */
+
+/* Call once per frame after atlas_prefetch_update(). */
+void portal_prewarm_update(void);
+
+#endif /* CYBERIA_PORTAL_PREWARM_H */
@@ -0,0 +1,263 @@
+#include "profiler.h"
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <emscripten/emscripten.h>
+
+/* Recompute percentiles this many frames apart at most. */
+#define PROFILER_STATS_REFRESH 15
+
+static const char* const kZoneNames[PROF_ZONE_COUNT] = {
+    [PROF_ZONE_NETWORK]         = "network",
+    [PROF_ZONE_AOI_DECODE]      = "aoi decode",
+    [PROF_ZONE_FETCH_PUMP]      = "fetch pump",
+    [PROF_ZONE_UI_TICK]         = "ui tick",
+    [PROF_ZONE_PREDICTION]      = "prediction",
+    [PROF_ZONE_INTERPOLATION]   = "interpolation",
+    [PROF_ZONE_RENDER]          = "render",
+    [PROF_ZONE_RENDER_ENTITIES] = "render entities",
+    [PROF_ZONE_TEXTURE_UPLOAD]  = "texture upload",
+};
+
+static const char* const kCounterNames[PROF_COUNT_COUNT] = {
+    [PROF_COUNT_AOI_FRAMES]      = "aoi_frames",
+    [PROF_COUNT_FETCHES]         = "fetches",
+    [PROF_COUNT_IMAGE_DECODES]   = "image_decodes",
+    [PROF_COUNT_TEXTURE_UPLOADS] = "texture_uploads",
+    [PROF_COUNT_HASH_RESIZES]    = "hash_resizes",
+};
+
+static const char* const kGaugeNames[PROF_GAUGE_COUNT] = {
+    [PROF_GAUGE_PLAYERS]       = "players",
+    [PROF_GAUGE_BOTS]          = "bots",
+    [PROF_GAUGE_WORLD_OBJECTS] = "world_objects",
+};
+
+static const float kBucketEdges[PROFILER_BUCKET_COUNT - 1] = PROFILER_BUCKET_EDGES_MS;
+
+typedef struct {
+    float zone_ms[PROF_ZONE_COUNT];
+    float frame_ms;
+} FrameSample;
+
+static struct {
+    double       frame_start;
+    ProfilerSpan current[PROF_ZONE_COUNT];
+    ProfilerSpan last[PROF_ZONE_COUNT];
+    float        last_frame_ms;
+
+    /* Open zones, innermost last. */
+    ProfilerZone stack[PROFILER_MAX_DEPTH];
+    double       stack_start[PROFILER_MAX_DEPTH];
+    int          depth;
+
+    FrameSample  ring[PROFILER_HISTORY];
+    int          head;
+    int          filled;
+
+    ProfilerZoneStats zone_stats[PROF_ZONE_COUNT];
+    ProfilerZoneStats frame_stats;
+    int          frames_since_stats;
+    bool         stats_valid;
+
+    int          counts[PROF_COUNT_COUNT];
+    int          gauges[PROF_GAUGE_COUNT];
+    uint32_t     frame_index;
+
+    uint32_t     histogram[PROFILER_BUCKET_COUNT];
+    uint32_t     histogram_total;
+
+    float             long_frame_ms;
+    ProfilerLongFrame long_frames[PROFILER_LONG_FRAMES];
+    int               long_head;
+    int               long_filled;
+    uint32_t          long_total;
+} g_prof = {
+    .long_frame_ms = PROFILER_LONG_FRAME_MS,
+};
+
+static int bucket_of(float ms) {
+    for (int i = 0; i < PROFILER_BUCKET_COUNT - 1; i++) {
+        if (ms < kBucketEdges[i]) return i;
+    }
+    return PROFILER_BUCKET_COUNT - 1;
+}
+
+static void trap_long_frame(const FrameSample* s, double now) {
+    ProfilerLongFrame* lf = &g_prof.long_frames[g_prof.long_head];
+    lf->frame    = g_prof.frame_index;
+    lf->at_ms    = now;
+    lf->frame_ms = s->frame_ms;
+    memcpy(lf->zone_ms, s->zone_ms, sizeof(lf->zone_ms));
+    memcpy(lf->counts, g_prof.counts, sizeof(lf->counts));
+    memcpy(lf->gauges, g_prof.gauges, sizeof(lf->gauges));
+    g_prof.long_head = (g_prof.long_head + 1) % PROFILER_LONG_FRAMES;
+    if (g_prof.long_filled < PROFILER_LONG_FRAMES) g_prof.long_filled++;
+    g_prof.long_total++;
+}
+
+void profiler_frame_mark(void) {
+    double now = emscripten_get_now();
+    if (g_prof.frame_start > 0.0) {
+        FrameSample* s = &g_prof.ring[g_prof.head];
+        for (int z = 0; z < PROF_ZONE_COUNT; z++) s->zone_ms[z] = g_prof.current[z].total_ms;
+        s->frame_ms = (float)(now - g_prof.frame_start);
+        g_prof.head = (g_prof.head + 1) % PROFILER_HISTORY;
+        if (g_prof.filled < PROFILER_HISTORY) g_prof.filled++;
+
+        memcpy(g_prof.last, g_prof.current, sizeof(g_prof.last));
+        g_prof.last_frame_ms = s->frame_ms;
+        g_prof.frames_since_stats++;
+
+        g_prof.histogram[bucket_of(s->frame_ms)]++;
+        g_prof.histogram_total++;
+        if (g_prof.long_frame_ms > 0.0f && s->frame_ms >= g_prof.long_frame_ms) {
+            trap_long_frame(s, now);
+        }
+        g_prof.frame_index++;
+    }
+    memset(g_prof.current, 0, sizeof(g_prof.current));
+    memset(g_prof.counts, 0, sizeof(g_prof.counts));
+    g_prof.frame_start = now;
+    /* Zones still open straddle the mark; their time lands in the new frame. */
+    for (int i = 0; i < g_prof.depth; i++) g_prof.stack_start[i] = now;
+}
+
+void profiler_zone_begin(ProfilerZone zone) {
+    assert(0 <= zone && PROF_ZONE_COUNT > zone);
+    if (g_prof.depth >= PROFILER_MAX_DEPTH) return;
+    double now = emscripten_get_now();
+    ProfilerSpan* span = &g_prof.current[zone];
+    if (0 == span->calls) {
+        span->start_ms = (g_prof.frame_start > 0.0) ? (float)(now - g_prof.frame_start) : 0.0f;
+        span->depth    = (uint8_t)g_prof.depth;
+    }
+    g_prof.stack[g_prof.depth]       = zone;
+    g_prof.stack_start[g_prof.depth] = now;
+    g_prof.depth++;
+}
+
+void profiler_zone_end(ProfilerZone zone) {
+    assert(0 <= zone && PROF_ZONE_COUNT > zone);
+    if (0 == g_prof.depth) return;
+    int top = g_prof.depth - 1;
+    /* Unbalanced begin/end is a call-site bug; drop the sample. */
+    assert(g_prof.stack[top] == zone);
+    if (g_prof.stack[top] != zone) return;
+    ProfilerSpan* span = &g_prof.current[zone];
+    span->total_ms += (float)(emscripten_get_now() - g_prof.stack_start[top]);
+    if (span->calls < UINT8_MAX) span->calls++;
+    g_prof.depth = top;
+}
+
+void profiler_count(ProfilerCounter counter, int n) {
+    assert(0 <= counter && PROF_COUNT_COUNT > counter);
+    g_prof.counts[counter] += n;
+}
+
+void profiler_gauge(ProfilerGauge gauge, int value) {
+    assert(0 <= gauge && PROF_GAUGE_COUNT > gauge);
+    g_prof.gauges[gauge] = value;
+}
+
+const char* profiler_zone_name(ProfilerZone zone) {
+    assert(0 <= zone && PROF_ZONE_COUNT > zone);
+    return kZoneNames[zone];
+}
+
+const char* profiler_counter_name(ProfilerCounter counter) {
+    assert(0 <= counter && PROF_COUNT_COUNT > counter);
+    return kCounterNames[counter];
+}
+
+const char* profiler_gauge_name(ProfilerGauge gauge) {
+    assert(0 <= gauge && PROF_GAUGE_COUNT > gauge);
+    return kGaugeNames[gauge];
+}
+
+const ProfilerSpan* profiler_last_frame(float* frame_ms) {
+    if (frame_ms) *frame_ms = g_prof.last_frame_ms;
+    return g_prof.last;
+}
+
+static int compare_floats(const void* a, const void* b) {
+    float fa = *(const float*)a, fb = *(const float*)b;
+    return (fa > fb) - (fa < fb);
+}
+
+static float percentile(const float* sorted, int n, float p) {
+    int i = (int)(p * (float)(n - 1) + 0.5f);
+    return sorted[i];
+}
+
+static ProfilerZoneStats summarize(float* values, int n, float last) {
+    ProfilerZoneStats st = { .last_ms = last };
+    if (0 == n) return st;
+    qsort(values, (size_t)n, sizeof(float), compare_floats);
+    st.p50_ms = percentile(values, n, 0.50f);
+    st.p95_ms = percentile(values, n, 0.95f);
+    st.p99_ms = percentile(values, n, 0.99f);
+    return st;
+}
+
+static void refresh_stats(void) {
+    if (g_prof.stats_valid && g_prof.frames_since_stats < PROFILER_STATS_REFRESH) return;
+    float values[PROFILER_HISTORY];
+    int n = g_prof.filled;
+    for (int z = 0; z < PROF_ZONE_COUNT; z++) {
+        for (int i = 0; i < n; i++) values[i] = g_prof.ring[i].zone_ms[z];
+        g_prof.zone_stats[z] = summarize(values, n, g_prof.last[z].total_ms);
+    }
+    for (int i = 0; i < n; i++) values[i] = g_prof.ring[i].frame_ms;
+    g_prof.frame_stats = summarize(values, n, g_prof.last_frame_ms);
+    g_prof.frames_since_stats = 0;
+    g_prof.stats_valid = true;
+}
+
+ProfilerZoneStats profiler_zone_stats(ProfilerZone zone) {
+    assert(0 <= zone && PROF_ZONE_COUNT > zone);
+    refresh_stats();
+    ProfilerZoneStats st = g_prof.zone_stats[zone];
+    st.last_ms = g_prof.last[zone].total_ms;
+    return st;
+}
+
+ProfilerZoneStats profiler_frame_stats(void) {
+    refresh_stats();
+    ProfilerZoneStats st = g_prof.frame_stats;
+    st.last_ms = g_prof.last_frame_ms;
+    return st;
+}
+
+const uint32_t* profiler_histogram(uint32_t* total_frames) {
+    if (total_frames) *total_frames = g_prof.histogram_total;
+    return g_prof.histogram;
+}
+
+float profiler_bucket_edge_ms(int bucket) {
+    assert(0 <= bucket && PROFILER_BUCKET_COUNT > bucket);
+    return (bucket < PROFILER_BUCKET_COUNT - 1) ? kBucketEdges[bucket] : 0.0f;
+}
+
+int profiler_long_frame_count(void) { return g_prof.long_filled; }
+
+const ProfilerLongFrame* profiler_long_frame(int i) {
+    assert(0 <= i && g_prof.long_filled > i);
+    int oldest = (g_prof.long_head - g_prof.long_filled + PROFILER_LONG_FRAMES) % PROFILER_LONG_FRAMES;
+    return &g_prof.long_frames[(oldest + i) % PROFILER_LONG_FRAMES];
+}
+
+uint32_t profiler_long_frames_total(void) { return g_prof.long_total; }
+
+void  profiler_set_long_frame_ms(float threshold_ms) { g_prof.long_frame_ms = threshold_ms; }
+float profiler_long_frame_ms(void)                   { return g_prof.long_frame_ms; }
+
+void profiler_reset_traces(void) {
+    memset(g_prof.histogram, 0, sizeof(g_prof.histogram));
+    g_prof.histogram_total = 0;
+    g_prof.long_head   = 0;
+    g_prof.long_filled = 0;
+    g_prof.long_total  = 0;
+}
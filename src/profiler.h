@@ -0,0 +1,159 @@
+#ifndef CYBERIA_PROFILER_H
+#define CYBERIA_PROFILER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * Scoped hot-path profiler.
+ *
+ * Call sites bracket a hot path with PROFILE_BEGIN(zone) / PROFILE_END(zone).
+ * Zones nest (depth is kept for the flame bar) and may run several times a
+ * frame; their time adds up. profiler_frame_mark() once at the top of the
+ * game loop closes the frame that just ran and opens the next, so work done
+ * between loop iterations — WebSocket and fetch callbacks — is charged to
+ * the frame that follows it.
+ *
+ * The last PROFILER_HISTORY frames are kept in a ring; per-zone p50/p95/p99
+ * are computed over it on demand. Timing is emscripten_get_now().
+ *
+ * Every frame also lands in a frame-time histogram, and any frame longer
+ * than the long-frame threshold is trapped: its zone breakdown, the event
+ * counters it accumulated (PROFILE_COUNT — AOI frames, fetch completions,
+ * image decodes, hash-table resizes...) and the entity gauges
+ * (PROFILE_GAUGE) are copied into a small ring that dev_ui shows and
+ * js/profiler_bridge exports for field traces.
+ *
+ * The macros are live when CYBERIA_PROFILE is non-zero, which defaults to
+ * debug builds (CYBERIA_DEBUG). Otherwise they expand to nothing, so RELEASE
+ * call sites cost nothing and every stat below stays zero.
+ */
+
+#ifndef CYBERIA_PROFILE
+#  ifdef CYBERIA_DEBUG
+#    define CYBERIA_PROFILE 1
+#  else
+#    define CYBERIA_PROFILE 0
+#  endif
+#endif
+
+typedef enum {
+    PROF_ZONE_NETWORK,          /* game_client_on_tick */
+    PROF_ZONE_AOI_DECODE,       /* binary_aoi_process / json_aoi_process */
+    PROF_ZONE_FETCH_PUMP,       /* fetch_batch_pump + image_decoder_pump */
+    PROF_ZONE_UI_TICK,          /* ui_on_tick + per-frame UI updates */
+    PROF_ZONE_PREDICTION,       /* fixed-step prediction + local view */
+    PROF_ZONE_INTERPOLATION,    /* interpolation_compute_view */
+    PROF_ZONE_RENDER,           /* render_on_tick */
+    PROF_ZONE_RENDER_ENTITIES,  /* game_render_entities */
+    PROF_ZONE_TEXTURE_UPLOAD,   /* texture creation and page writes */
+    PROF_ZONE_COUNT
+} ProfilerZone;
+
+/* Per-frame event counts, zeroed at each frame mark. */
+typedef enum {
+    PROF_COUNT_AOI_FRAMES,      /* AOI snapshots applied */
+    PROF_COUNT_FETCHES,         /* engine fetch completions */
+    PROF_COUNT_IMAGE_DECODES,   /* synchronous LoadImageFromMemory */
+    PROF_COUNT_TEXTURE_UPLOADS,
+    PROF_COUNT_HASH_RESIZES,
+    PROF_COUNT_COUNT
+} ProfilerCounter;
+
+/* Levels sampled when set, carried across frames. */
+typedef enum {
+    PROF_GAUGE_PLAYERS,         /* remote players in AOI */
+    PROF_GAUGE_BOTS,
+    PROF_GAUGE_WORLD_OBJECTS,   /* obstacles + foregrounds + statics + resources + portals + floors */
+    PROF_GAUGE_COUNT
+} ProfilerGauge;
+
+#define PROFILER_HISTORY   256  /* frames */
+#define PROFILER_MAX_DEPTH 8
+
+/* Frame-time histogram: bucket i holds frames shorter than
+ * PROFILER_BUCKET_EDGES_MS[i]; the last bucket is everything longer. */
+#define PROFILER_BUCKET_COUNT 12
+#define PROFILER_BUCKET_EDGES_MS { 4.0f, 8.0f, 12.0f, 16.7f, 20.0f, 25.0f, 33.3f, \
+                                   50.0f, 66.7f, 100.0f, 250.0f }
+
+#define PROFILER_LONG_FRAME_MS   50.0f   /* default trap threshold */
+#define PROFILER_LONG_FRAMES     16      /* trapped frames kept */
+
+/* One zone in the most recent complete frame. start_ms is the first entry,
+ * relative to the frame mark; total_ms sums every entry. */
+typedef struct {
+    float   start_ms;
+    float   total_ms;
+    uint8_t depth;
+    uint8_t calls;
+} ProfilerSpan;
+
+typedef struct {
+    float last_ms;
+    float p50_ms;
+    float p95_ms;
+    float p99_ms;
+} ProfilerZoneStats;
+
+typedef struct {
+    uint32_t frame;           /* frame index since start */
+    double   at_ms;           /* emscripten_get_now() at the closing mark */
+    float    frame_ms;
+    float    zone_ms[PROF_ZONE_COUNT];
+    int      counts[PROF_COUNT_COUNT];
+    int      gauges[PROF_GAUGE_COUNT];
+} ProfilerLongFrame;
+
+#if CYBERIA_PROFILE
+#  define PROFILE_BEGIN(zone)        profiler_zone_begin(zone)
+#  define PROFILE_END(zone)          profiler_zone_end(zone)
+#  define PROFILE_FRAME_MARK()       profiler_frame_mark()
+#  define PROFILE_COUNT(counter, n)  profiler_count(counter, n)
+#  define PROFILE_GAUGE(gauge, v)    profiler_gauge(gauge, v)
+#else
+#  define PROFILE_BEGIN(zone)        ((void)0)
+#  define PROFILE_END(zone)          ((void)0)
+#  define PROFILE_FRAME_MARK()       ((void)0)
+#  define PROFILE_COUNT(counter, n)  ((void)0)
+#  define PROFILE_GAUGE(gauge, v)    ((void)0)
+#endif
+
+void        profiler_frame_mark(void);
+void        profiler_zone_begin(ProfilerZone zone);
+void        profiler_zone_end(ProfilerZone zone);
+void        profiler_count(ProfilerCounter counter, int n);
+void        profiler_gauge(ProfilerGauge gauge, int value);
+
+const char* profiler_zone_name(ProfilerZone zone);
+const char* profiler_counter_name(ProfilerCounter counter);
+const char* profiler_gauge_name(ProfilerGauge gauge);
+
+/* Spans of the last complete frame (PROF_ZONE_COUNT entries; calls == 0
+ * for zones that did not run) and that frame's mark-to-mark length. */
+const ProfilerSpan* profiler_last_frame(float* frame_ms);
+
+/* Percentiles over the history ring; frames where the zone did not run
+ * count as 0. Cached, recomputed at most every few frames. */
+ProfilerZoneStats   profiler_zone_stats(ProfilerZone zone);
+
+/* Same, over whole-frame lengths. */
+ProfilerZoneStats   profiler_frame_stats(void);
+
+/* Histogram counts since start or the last profiler_reset_traces();
+ * PROFILER_BUCKET_COUNT entries. */
+const uint32_t*     profiler_histogram(uint32_t* total_frames);
+float               profiler_bucket_edge_ms(int bucket);   /* upper edge; 0 for the last */
+
+/* Trapped frames, oldest first: `i` in [0, profiler_long_frame_count()). */
+int                      profiler_long_frame_count(void);
+const ProfilerLongFrame* profiler_long_frame(int i);
+uint32_t                 profiler_long_frames_total(void);   /* including overwritten */
+
+void  profiler_set_long_frame_ms(float threshold_ms);
+float profiler_long_frame_ms(void);
+
+/* Clear the histogram and the long-frame ring. */
+void  profiler_reset_traces(void);
+
+#endif /* CYBERIA_PROFILER_H */
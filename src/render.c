@@ -3,12 +3,15 @@
 
 #include "dialogue_data.h"
 #include "domain/camera.h"
+#include "domain/presentation_runtime.h"
 #include "game_render.h"
+#include "gpu_memory.h"
 #include "object_layers_management.h"
 #include "ui/dev_ui.h"
 #include "ui/floating_combat_text.h"
 #include "ui/interaction_bubble.h"
 #include "ui/loot_fx.h"
+#include "ui/fx_particles.h"
 #include "ui/fx_reward.h"
 #include "ui/inventory_bar.h"
 #include "ui/inventory_modal.h"
@@ -22,6 +25,7 @@
 #include "ui/ui_icon.h"
 #include "network/engine_client.h"
 #include "util/log.h"
+#include "render_stats.h"
 
 #include <assert.h>
 #include <raylib.h>
@@ -52,22 +56,19 @@ static EM_BOOL on_window_resize(int eventType, const EmscriptenUiEvent* uiEvent,
 
 void render_init(int width, int height) {
     render_state.splash_texture = LoadTexture("splash.png");
+    gpu_memory_add(GPU_MEM_SPLASH, gpu_memory_texture_bytes(render_state.splash_texture));
 
     emscripten_set_resize_callback(EMSCRIPTEN_EVENT_TARGET_WINDOW, NULL, EM_FALSE, on_window_resize);
 
     game_render_init(width, height);
 
-    if (0 != dev_ui_init()) {
-        LOG_WARN("dev_ui_init failed");
-    }
+    /* The toolbar readout is always on screen. dev_ui, the instance map,
+     * fx_tap and fx_reward initialise on first use. */
     if (0 != modal_map_init()) {
         LOG_WARN("modal_map_init failed");
     }
-    modal_instance_map_init();
-
-    fx_tap_init();
     loot_fx_reset();
-    fx_reward_init();
+    fx_particles_reset();
     camera_init(width, height);
 }
 
@@ -77,9 +78,16 @@ void render_on_tick(float delta_time) {
 
     camera_on_tick(delta_time);
 
+    float budget_mb = presentation_runtime_gpu_budget_mb();
+    float idle_s    = presentation_runtime_gpu_downsample_idle();
+    gpu_memory_set_budget(budget_mb > 0.0f ? (size_t)(budget_mb * 1024.0f * 1024.0f) : 0);
+    gpu_memory_set_downsample_idle(idle_s > 0.0f ? idle_s : 0.0);
+    gpu_memory_update();
+
     game_render_update_effects(delta_time);
     fct_update(delta_time);
     loot_fx_update(delta_time);
+    fx_particles_update(delta_time);
     fx_tap_update(delta_time);
 
     inventory_bar_update(delta_time);
@@ -91,9 +99,9 @@ void render_on_tick(float delta_time) {
     fx_reward_update(delta_time);
 
     interaction_bubble_update();
-    dev_ui_on_tick(delta_time);
+    if (presentation_runtime_dev_ui())   dev_ui_on_tick(delta_time);
     modal_map_update(delta_time);
-    modal_instance_map_update(delta_time);
+    if (modal_instance_map_is_open())    modal_instance_map_update(delta_time);
 
     if (g_game_state.init_received) {
         game_render_frame();
@@ -123,6 +131,7 @@ void render_fallback(int width, int height) {
 }
 
 void render_cleanup(void) {
+    gpu_memory_sub(GPU_MEM_SPLASH, gpu_memory_texture_bytes(render_state.splash_texture));
     UnloadTexture(render_state.splash_texture);
     fx_tap_reset();
     game_render_cleanup();
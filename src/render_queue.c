@@ -0,0 +1,165 @@
+#include "render_queue.h"
+#include "entity_fx.h"
+#include "render_stats.h"
+#include "sprite_instancing.h"
+
+#include <assert.h>
+#include <stdint.h>
+#include <string.h>
+
+static_assert(SPRITE_INSTANCING_MAX >= RENDER_QUEUE_MAX_QUADS, "a full queue must fit one instanced flush");
+
+typedef struct {
+    Texture2D texture;
+    Rectangle src;
+    Rectangle dst;
+    Color     tint;
+} QueuedQuad;
+
+typedef struct {
+    uint64_t key;
+    int      index;   /* into quads[] */
+} SortItem;
+
+static struct {
+    bool             open;
+    RenderLayer      layer;
+    uint32_t         depth_bits;
+    int              count;
+    QueuedQuad       quads[RENDER_QUEUE_MAX_QUADS];
+    SortItem         order[RENDER_QUEUE_MAX_QUADS];
+    SortItem         scratch[RENDER_QUEUE_MAX_QUADS];
+    RenderQueueStats stats;
+} g_render_queue;
+
+/* Float depth as an unsigned key with the same order: flip every bit of a
+ * negative, only the sign bit of a positive. */
+static uint32_t depth_key(float depth) {
+    uint32_t bits;
+    memcpy(&bits, &depth, sizeof(bits));
+    return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+}
+
+static uint64_t sort_key(RenderLayer layer, uint32_t depth_bits, int slot, unsigned int texture) {
+    assert(0 <= slot && 0xff >= slot);
+    return ((uint64_t)layer << 60) | ((uint64_t)depth_bits << 28) |
+           ((uint64_t)(slot & 0xff) << 20) | (uint64_t)(texture & 0xfffffu);
+}
+
+/* Stable LSD radix sort of order[0..n) by key, a byte per pass. Passes
+ * where every key shares the byte are skipped, which is most of them:
+ * one frame rarely spans more than a couple of layers or depth exponents. */
+static void radix_sort(int n) {
+    SortItem* src = g_render_queue.order;
+    SortItem* dst = g_render_queue.scratch;
+    for (int shift = 0; shift < 64; shift += 8) {
+        int count[256] = { 0 };
+        for (int i = 0; i < n; i++) count[(src[i].key >> shift) & 0xff]++;
+        if (n == count[(src[0].key >> shift) & 0xff]) continue;
+        int offset = 0;
+        for (int b = 0; b < 256; b++) {
+            int c    = count[b];
+            count[b] = offset;
+            offset  += c;
+        }
+        for (int i = 0; i < n; i++) dst[count[(src[i].key >> shift) & 0xff]++] = src[i];
+        SortItem* t = src;
+        src = dst;
+        dst = t;
+    }
+    if (src != g_render_queue.order) memcpy(g_render_queue.order, src, (size_t)n * sizeof(SortItem));
+}
+
+static int count_texture_runs(bool sorted) {
+    int runs = 0;
+    unsigned int last = 0;
+    for (int i = 0; i < g_render_queue.count; i++) {
+        int q = sorted ? g_render_queue.order[i].index : i;
+        unsigned int id = g_render_queue.quads[q].texture.id;
+        if (0 == i || id != last) runs++;
+        last = id;
+    }
+    return runs;
+}
+
+void render_queue_begin_frame(void) {
+    assert(!g_render_queue.open);
+    g_render_queue.stats = (RenderQueueStats){ 0 };
+}
+
+void render_queue_begin(void) {
+    assert(!g_render_queue.open);
+    g_render_queue.open       = true;
+    g_render_queue.layer      = RENDER_LAYER_FLOOR;
+    g_render_queue.depth_bits = depth_key(0.0f);
+    g_render_queue.count      = 0;
+}
+
+void render_queue_end(void) {
+    render_queue_flush();
+    g_render_queue.open = false;
+}
+
+bool render_queue_is_open(void) {
+    return g_render_queue.open;
+}
+
+void render_queue_set_layer(RenderLayer layer) {
+    assert(0 <= (int)layer && RENDER_LAYER_COUNT > layer);
+    g_render_queue.layer      = layer;
+    g_render_queue.depth_bits = depth_key(0.0f);
+}
+
+void render_queue_set_depth(float depth) {
+    g_render_queue.depth_bits = depth_key(depth);
+}
+
+void render_queue_push(Texture2D texture, Rectangle src, Rectangle dst,
+                       Color tint, int slot) {
+    assert(g_render_queue.open);
+    if (RENDER_QUEUE_MAX_QUADS == g_render_queue.count) render_queue_flush();
+
+    int n = g_render_queue.count++;
+    g_render_queue.quads[n] = (QueuedQuad){
+        .texture = texture,
+        .src     = src,
+        .dst     = dst,
+        .tint    = tint,
+    };
+    g_render_queue.order[n] = (SortItem){
+        .key   = sort_key(g_render_queue.layer, g_render_queue.depth_bits, slot, texture.id),
+        .index = n,
+    };
+    g_render_queue.stats.layer_quads[g_render_queue.layer]++;
+}
+
+void render_queue_push_rect(Rectangle dst, Color color, int slot) {
+    render_queue_push(GetShapesTexture(), GetShapesTextureRectangle(), dst, color, slot);
+}
+
+void render_queue_flush(void) {
+    int n = g_render_queue.count;
+    if (0 == n) return;
+
+    g_render_queue.stats.unsorted_draw_calls += count_texture_runs(false);
+    radix_sort(n);
+    g_render_queue.stats.draw_calls += count_texture_runs(true);
+    g_render_queue.stats.quads      += n;
+
+    /* Effect blocks bind their own shader; their quads stay on the batch. */
+    bool instanced = !entity_fx_active() && sprite_instancing_begin(n);
+    for (int i = 0; i < n; i++) {
+        const QueuedQuad* q = &g_render_queue.quads[g_render_queue.order[i].index];
+        if (instanced) sprite_instancing_push(q->texture, q->src, q->dst, q->tint);
+        else DrawTexturePro(q->texture, q->src, q->dst, (Vector2){ 0.0f, 0.0f }, 0.0f, q->tint);
+    }
+    if (instanced) {
+        sprite_instancing_end();
+        g_render_queue.stats.instanced_quads += n;
+    }
+    g_render_queue.count = 0;
+}
+
+RenderQueueStats render_queue_stats(void) {
+    return g_render_queue.stats;
+}
@@ -0,0 +1,81 @@
+#ifndef RENDER_QUEUE_H
+#define RENDER_QUEUE_H
+
+#include <raylib.h>
+#include <stdbool.h>
+
+/* Deferred textured quads for the world pass, drawn in sort-key order.
+ *
+ * rlgl flushes its batch whenever the bound texture changes, so drawing
+ * each layer as it is resolved interleaves item atlases and costs a draw
+ * call per switch. While the queue is open, producers push their quads
+ * here instead; render_queue_flush() radix-sorts them by one 64-bit key
+ *
+ *     layer:4 | depth:32 | slot:8 | texture:20
+ *
+ * and submits them in that order. The layer is the world pass a quad
+ * belongs to (RenderLayer, render_queue_set_layer), so game_render_world
+ * keeps one queue open from the floors to the foregrounds and each pass
+ * only declares where it sits. Depth orders actors within a layer, the
+ * slot orders the quads of one entity (its z-sorted layer slot), and quads
+ * that tie on all three — flat floor tiles, world objects on one row —
+ * share a draw call per atlas. The sort is stable: full ties keep their
+ * push order. Large flushes under the default shader go out as instanced
+ * draws (sprite_instancing.h) where the context supports it.
+ *
+ * Callers choose what ties: render_queue_set_depth() sets the depth of the
+ * quads pushed next, and anything drawn immediately (text, debug lines)
+ * must flush first so it lands on top of what was queued before it. A
+ * full queue flushes itself. */
+
+typedef enum {
+    RENDER_LAYER_FLOOR,          /* floor tiles the chunk cache does not cover */
+    RENDER_LAYER_WORLD_OBJECT,   /* portals */
+    RENDER_LAYER_ENTITY,         /* depth-sorted obstacles, statics and actors */
+    RENDER_LAYER_FOREGROUND,     /* always above the entities */
+    RENDER_LAYER_COUNT
+} RenderLayer;
+
+#define RENDER_QUEUE_MAX_QUADS 8192
+
+typedef struct {
+    int quads;                /* quads emitted */
+    int draw_calls;           /* texture runs emitted, i.e. batch breaks */
+    int unsorted_draw_calls;  /* texture runs had they kept push order */
+    int instanced_quads;      /* of quads, drawn through sprite_instancing.h */
+    int layer_quads[RENDER_LAYER_COUNT];
+} RenderQueueStats;
+
+/* Zero the frame stats; call once per frame before the first pass. */
+void render_queue_begin_frame(void);
+
+/* Start deferring quads, at RENDER_LAYER_FLOOR and depth 0. Nesting is not
+ * supported. */
+void render_queue_begin(void);
+
+/* Flush and stop deferring. */
+void render_queue_end(void);
+
+bool render_queue_is_open(void);
+
+/* World layer of the quads pushed after this call; resets the depth. */
+void render_queue_set_layer(RenderLayer layer);
+
+/* Depth of the quads pushed after this call; lower draws first. */
+void render_queue_set_depth(float depth);
+
+/* Queue one quad at the current layer and depth. `slot` orders the quads
+ * of one entity (its z-sorted layer slot, 0..255); lower draws first. */
+void render_queue_push(Texture2D texture, Rectangle src, Rectangle dst,
+                       Color tint, int slot);
+
+/* Queue a solid rectangle, drawn through raylib's shapes texture. */
+void render_queue_push_rect(Rectangle dst, Color color, int slot);
+
+/* Emit everything queued so far. No-op when empty. */
+void render_queue_flush(void);
+
+/* Totals since render_queue_begin_frame(). */
+RenderQueueStats render_queue_stats(void);
+
+#endif /* RENDER_QUEUE_H */
@@ -0,0 +1,128 @@
+#include "render_stats.h"
+
+#include <assert.h>
+#include <string.h>
+
+#include <emscripten/emscripten.h>
+#include <rlgl.h>
+
+#define RENDER_STATS_VALUES (RENDER_CALL_KIND_COUNT + RENDER_GPU_COUNTER_COUNT)
+
+uint32_t g_render_call_counts[RENDER_CALL_KIND_COUNT];
+
+/* Running totals the JS instrumentation bumps through HEAPU32. */
+static uint32_t s_gpu_counts[RENDER_GPU_COUNTER_COUNT];
+
+static struct {
+    int      pass;                                   /* open pass, or -1 */
+    uint32_t pass_at[RENDER_STATS_VALUES];           /* totals at pass begin */
+    uint32_t frame_at[RENDER_STATS_VALUES];          /* totals at frame start */
+    uint32_t frame[RENDER_PASS_COUNT][RENDER_STATS_VALUES];
+    uint32_t ring[RENDER_STATS_WINDOW][RENDER_PASS_COUNT][RENDER_STATS_VALUES];
+    uint32_t sum[RENDER_PASS_COUNT][RENDER_STATS_VALUES];
+    int      head;
+    int      filled;
+} g_render_stats = { .pass = -1 };
+
+static void read_totals(uint32_t out[RENDER_STATS_VALUES]) {
+    memcpy(out, g_render_call_counts, sizeof(g_render_call_counts));
+    memcpy(out + RENDER_CALL_KIND_COUNT, s_gpu_counts, sizeof(s_gpu_counts));
+}
+
+void render_stats_install(void) {
+    EM_ASM({
+        var gl = GLctx;
+        if (!gl || gl.__cyberiaStats) return;
+        gl.__cyberiaStats = true;
+        var base = $0 >> 2;
+        var bound = null;
+        var draw = function(vertices) {
+            HEAPU32[base + 0]++;
+            HEAPU32[base + 2] += vertices;
+        };
+        var drawElements = gl.drawElements, drawArrays = gl.drawArrays;
+        var bindTexture = gl.bindTexture, useProgram = gl.useProgram;
+        gl.drawElements = function(mode, count, type, offset) {
+            draw(mode === gl.TRIANGLES ? (count / 6 * 4) | 0 : count);
+            return drawElements.call(gl, mode, count, type, offset);
+        };
+        gl.drawArrays = function(mode, first, count) {
+            draw(count);
+            return drawArrays.call(gl, mode, first, count);
+        };
+        var drawArraysInstanced = gl.drawArraysInstanced;
+        if (drawArraysInstanced) {
+            gl.drawArraysInstanced = function(mode, first, count, instances) {
+                draw((mode === gl.TRIANGLES ? (count / 6 * 4) | 0 : count) * instances);
+                return drawArraysInstanced.call(gl, mode, first, count, instances);
+            };
+        }
+        gl.bindTexture = function(target, texture) {
+            if (target === gl.TEXTURE_2D && texture !== bound) {
+                bound = texture;
+                HEAPU32[base + 1]++;
+            }
+            return bindTexture.call(gl, target, texture);
+        };
+        gl.useProgram = function(program) {
+            HEAPU32[base + 3]++;
+            return useProgram.call(gl, program);
+        };
+    }, s_gpu_counts);
+}
+
+void render_stats_pass_begin(RenderPass pass) {
+    assert(0 <= pass && RENDER_PASS_OTHER > pass);
+    assert(0 > g_render_stats.pass);
+    rlDrawRenderBatchActive();
+    g_render_stats.pass = pass;
+    read_totals(g_render_stats.pass_at);
+}
+
+void render_stats_pass_end(void) {
+    assert(0 <= g_render_stats.pass);
+    rlDrawRenderBatchActive();
+    uint32_t now[RENDER_STATS_VALUES];
+    read_totals(now);
+    for (int v = 0; v < RENDER_STATS_VALUES; v++) {
+        g_render_stats.frame[g_render_stats.pass][v] += now[v] - g_render_stats.pass_at[v];
+    }
+    g_render_stats.pass = -1;
+}
+
+void render_stats_frame_end(void) {
+    assert(0 > g_render_stats.pass);
+    uint32_t now[RENDER_STATS_VALUES];
+    read_totals(now);
+    uint32_t (*frame)[RENDER_STATS_VALUES] = g_render_stats.frame;
+    for (int v = 0; v < RENDER_STATS_VALUES; v++) {
+        frame[RENDER_PASS_OTHER][v] = now[v] - g_render_stats.frame_at[v]
+                                    - frame[RENDER_PASS_WORLD][v] - frame[RENDER_PASS_UI][v];
+    }
+
+    uint32_t (*slot)[RENDER_STATS_VALUES] = g_render_stats.ring[g_render_stats.head];
+    for (int p = 0; p < RENDER_PASS_COUNT; p++) {
+        for (int v = 0; v < RENDER_STATS_VALUES; v++) {
+            g_render_stats.sum[p][v] += frame[p][v] - slot[p][v];
+        }
+    }
+    memcpy(slot, frame, sizeof(g_render_stats.frame));
+    memset(frame, 0, sizeof(g_render_stats.frame));
+    memcpy(g_render_stats.frame_at, now, sizeof(now));
+    g_render_stats.head = (g_render_stats.head + 1) % RENDER_STATS_WINDOW;
+    if (RENDER_STATS_WINDOW > g_render_stats.filled) g_render_stats.filled++;
+}
+
+RenderPassStats render_stats_pass(RenderPass pass) {
+    assert(0 <= pass && RENDER_PASS_COUNT > pass);
+    RenderPassStats out = {0};
+    if (0 == g_render_stats.filled) return out;
+    float n = (float)g_render_stats.filled;
+    for (int k = 0; k < RENDER_CALL_KIND_COUNT; k++) {
+        out.calls[k] = (float)g_render_stats.sum[pass][k] / n;
+    }
+    for (int g = 0; g < RENDER_GPU_COUNTER_COUNT; g++) {
+        out.gpu[g] = (float)g_render_stats.sum[pass][RENDER_CALL_KIND_COUNT + g] / n;
+    }
+    return out;
+}
@@ -0,0 +1,97 @@
+#ifndef CYBERIA_RENDER_STATS_H
+#define CYBERIA_RENDER_STATS_H
+
+#include <raylib.h>
+#include <stdint.h>
+
+/*
+ * Per-pass draw accounting, averaged over the last RENDER_STATS_WINDOW
+ * frames.
+ *
+ * Two sources. Including this header counts the drawing raylib calls of
+ * that file: the macros below bump a per-kind counter and then call the
+ * real function, which a macro cannot re-expand. Under the browser, the
+ * WebGL context is instrumented from JS (render_stats_install) and counts
+ * what rlgl actually submits:
+ *   - draw calls: drawElements / drawArrays / drawArraysInstanced
+ *   - texture switches: bindTexture to a texture other than the bound one
+ *   - vertices: quads drawn through the element buffer count 4 per 6
+ *     indices, instanced quads 4 per instance
+ *   - batch flushes: non-empty rlDrawRenderBatch runs, one useProgram each
+ * The GPU numbers read zero in the host build.
+ *
+ * Each pass of game_render_frame() is bracketed by begin and end. Both
+ * flush the rlgl batch so each pass owns its draw calls, which costs at
+ * most one extra draw call per boundary. Whatever lands outside a pass is
+ * reported as RENDER_PASS_OTHER.
+ *
+ * Include after raylib.h or instead of it, never before it: the macros
+ * would rewrite raylib's own prototypes.
+ */
+
+#define RENDER_STATS_WINDOW 60
+
+typedef enum {
+    RENDER_PASS_WORLD,   /* game_render_world under the camera */
+    RENDER_PASS_UI,      /* game_render_ui in screen space */
+    RENDER_PASS_OTHER,   /* overlays, floor-cache bakes, the final flush */
+    RENDER_PASS_COUNT
+} RenderPass;
+
+typedef enum {
+    RENDER_CALL_TEXTURE,   /* DrawTexture* */
+    RENDER_CALL_RECT,      /* DrawRectangle* */
+    RENDER_CALL_TEXT,      /* DrawTextEx; ui/text.h routes DrawText there */
+    RENDER_CALL_SHAPE,     /* DrawCircle*, DrawLine* */
+    RENDER_CALL_KIND_COUNT
+} RenderCallKind;
+
+typedef enum {
+    RENDER_GPU_DRAW_CALLS,
+    RENDER_GPU_TEXTURE_SWITCHES,
+    RENDER_GPU_VERTICES,
+    RENDER_GPU_FLUSHES,
+    RENDER_GPU_COUNTER_COUNT
+} RenderGpuCounter;
+
+/* Per-frame averages over the window. */
+typedef struct {
+    float calls[RENDER_CALL_KIND_COUNT];
+    float gpu[RENDER_GPU_COUNTER_COUNT];
+} RenderPassStats;
+
+/* Running totals, bumped by the macros. */
+extern uint32_t g_render_call_counts[RENDER_CALL_KIND_COUNT];
+
+static inline void render_stats_count(RenderCallKind kind) {
+    g_render_call_counts[kind]++;
+}
+
+/* Instrument the WebGL context; call once after InitWindow(). */
+void render_stats_install(void);
+
+void render_stats_pass_begin(RenderPass pass);
+void render_stats_pass_end(void);
+
+/* Close the frame after EndDrawing(). */
+void render_stats_frame_end(void);
+
+RenderPassStats render_stats_pass(RenderPass pass);
+
+/* ── Call counting ─────────────────────────────────────────────────── */
+
+#define DrawTexture(...)                 (render_stats_count(RENDER_CALL_TEXTURE), DrawTexture(__VA_ARGS__))
+#define DrawTextureRec(...)              (render_stats_count(RENDER_CALL_TEXTURE), DrawTextureRec(__VA_ARGS__))
+#define DrawTexturePro(...)              (render_stats_count(RENDER_CALL_TEXTURE), DrawTexturePro(__VA_ARGS__))
+#define DrawRectangle(...)               (render_stats_count(RENDER_CALL_RECT), DrawRectangle(__VA_ARGS__))
+#define DrawRectangleRec(...)            (render_stats_count(RENDER_CALL_RECT), DrawRectangleRec(__VA_ARGS__))
+#define DrawRectangleLinesEx(...)        (render_stats_count(RENDER_CALL_RECT), DrawRectangleLinesEx(__VA_ARGS__))
+#define DrawRectangleRounded(...)        (render_stats_count(RENDER_CALL_RECT), DrawRectangleRounded(__VA_ARGS__))
+#define DrawRectangleRoundedLinesEx(...) (render_stats_count(RENDER_CALL_RECT), DrawRectangleRoundedLinesEx(__VA_ARGS__))
+#define DrawTextEx(...)                  (render_stats_count(RENDER_CALL_TEXT), DrawTextEx(__VA_ARGS__))
+#define DrawCircle(...)                  (render_stats_count(RENDER_CALL_SHAPE), DrawCircle(__VA_ARGS__))
+#define DrawCircleLines(...)             (render_stats_count(RENDER_CALL_SHAPE), DrawCircleLines(__VA_ARGS__))
+#define DrawLine(...)                    (render_stats_count(RENDER_CALL_SHAPE), DrawLine(__VA_ARGS__))
+#define DrawLineEx(...)                  (render_stats_count(RENDER_CALL_SHAPE), DrawLineEx(__VA_ARGS__))
+
+#endif /* CYBERIA_RENDER_STATS_H */
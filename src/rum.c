@@ -0,0 +1,151 @@
+#include "rum.h"
+
+#include "game_state.h"
+#include "gpu_memory.h"
+#include "heap_memory.h"
+#include "profiler.h"
+#include "runtime_config.h"
+#include "startup_trace.h"
+#include "js/rum_bridge.h"
+#include "util/log.h"
+
+#include <cJSON.h>
+#include <raylib.h>
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define RUM_URL_MAX 512
+
+static const float kBucketEdges[PROFILER_BUCKET_COUNT - 1] = PROFILER_BUCKET_EDGES_MS;
+
+/* One reporting window; everything below `window_at` restarts per send. */
+static struct {
+    bool     active;
+    bool     load_sent;
+    char     url[RUM_URL_MAX];
+    double   window_at;
+    uint32_t frames;
+    uint32_t hist[PROFILER_BUCKET_COUNT];
+    uint32_t long_frames;
+    double   frame_ms_sum;
+    float    worst_ms;
+    uint32_t snapshots;
+    double   decode_ms_sum;
+    float    decode_max_ms;
+    int      max_players, max_bots, max_objects;
+    size_t   gpu_peak;
+} g_rum;
+
+static void window_reset(void) {
+    bool   load_sent = g_rum.load_sent;
+    char   url[RUM_URL_MAX];
+    memcpy(url, g_rum.url, sizeof(url));
+    memset(&g_rum, 0, sizeof(g_rum));
+    g_rum.active    = true;
+    g_rum.load_sent = load_sent;
+    memcpy(g_rum.url, url, sizeof(url));
+    g_rum.window_at = GetTime();
+}
+
+void rum_start(void) {
+    if (g_rum.active) return;
+    snprintf(g_rum.url, sizeof(g_rum.url), "%s%s", runtime_config_api_base_url(), RUM_BEACON_PATH);
+    window_reset();
+    LOG_INFO("[RUM] session sampled; reporting to %s every %.0fs", g_rum.url, RUM_REPORT_SECONDS);
+}
+
+bool rum_active(void) { return g_rum.active; }
+
+static int bucket_of(float ms) {
+    for (int i = 0; i < PROFILER_BUCKET_COUNT - 1; i++) {
+        if (ms < kBucketEdges[i]) return i;
+    }
+    return PROFILER_BUCKET_COUNT - 1;
+}
+
+void rum_on_frame(float frame_ms) {
+    if (!g_rum.active) return;
+    if (0.0f < frame_ms && RUM_MAX_FRAME_MS > frame_ms) {
+        g_rum.frames++;
+        g_rum.hist[bucket_of(frame_ms)]++;
+        g_rum.frame_ms_sum += frame_ms;
+        if (PROFILER_LONG_FRAME_MS < frame_ms) g_rum.long_frames++;
+        if (g_rum.worst_ms < frame_ms) g_rum.worst_ms = frame_ms;
+    }
+
+    const GameState* gs = &g_game_state;
+    int objects = game_state_world_object_count();
+    if (g_rum.max_players < gs->other_player_count) g_rum.max_players = gs->other_player_count;
+    if (g_rum.max_bots < gs->bot_count) g_rum.max_bots = gs->bot_count;
+    if (g_rum.max_objects < objects) g_rum.max_objects = objects;
+    size_t gpu = gpu_memory_used();
+    if (g_rum.gpu_peak < gpu) g_rum.gpu_peak = gpu;
+
+    if (GetTime() - g_rum.window_at >= RUM_REPORT_SECONDS) rum_flush();
+}
+
+void rum_on_snapshot(double decode_ms) {
+    if (!g_rum.active) return;
+    g_rum.snapshots++;
+    g_rum.decode_ms_sum += decode_ms;
+    if (g_rum.decode_max_ms < (float)decode_ms) g_rum.decode_max_ms = (float)decode_ms;
+}
+
+/* Stage completions and marks, once the startup trace has closed. */
+static void add_load(cJSON* summary) {
+    if (g_rum.load_sent || startup_trace_recording() || 0 == startup_trace_mark_count()) return;
+    cJSON* load = cJSON_AddObjectToObject(summary, "load");
+    for (int i = 0; i < startup_trace_mark_count(); i++) {
+        const StartupMark* m = startup_trace_mark_at(i);
+        cJSON_AddNumberToObject(load, m->name, (double)(int64_t)m->at_ms);
+    }
+    cJSON* edges = cJSON_AddArrayToObject(summary, "edges");
+    for (int i = 0; i < PROFILER_BUCKET_COUNT - 1; i++) {
+        cJSON_AddItemToArray(edges, cJSON_CreateNumber(kBucketEdges[i]));
+    }
+    g_rum.load_sent = true;
+}
+
+void rum_flush(void) {
+    if (!g_rum.active || (0 == g_rum.frames && 0 == g_rum.snapshots)) return;
+
+    cJSON* summary = cJSON_CreateObject();
+    cJSON_AddNumberToObject(summary, "v", 1);
+    cJSON_AddStringToObject(summary, "instance", runtime_config_instance_code());
+    cJSON_AddNumberToObject(summary, "uptime", (double)(int64_t)GetTime());
+    cJSON_AddNumberToObject(summary, "window", (double)(int64_t)(GetTime() - g_rum.window_at));
+    cJSON_AddNumberToObject(summary, "frames", g_rum.frames);
+    cJSON_AddNumberToObject(summary, "meanMs",
+                            g_rum.frames ? g_rum.frame_ms_sum / g_rum.frames : 0.0);
+    cJSON_AddNumberToObject(summary, "worstMs", g_rum.worst_ms);
+    cJSON_AddNumberToObject(summary, "longFrames", g_rum.long_frames);
+    cJSON* hist = cJSON_AddArrayToObject(summary, "hist");
+    for (int i = 0; i < PROFILER_BUCKET_COUNT; i++) {
+        cJSON_AddItemToArray(hist, cJSON_CreateNumber(g_rum.hist[i]));
+    }
+
+    cJSON* decode = cJSON_AddObjectToObject(summary, "decode");
+    cJSON_AddNumberToObject(decode, "snapshots", g_rum.snapshots);
+    cJSON_AddNumberToObject(decode, "meanMs",
+                            g_rum.snapshots ? g_rum.decode_ms_sum / g_rum.snapshots : 0.0);
+    cJSON_AddNumberToObject(decode, "maxMs", g_rum.decode_max_ms);
+
+    cJSON* aoi = cJSON_AddObjectToObject(summary, "aoi");
+    cJSON_AddNumberToObject(aoi, "radius", g_game_state.aoi_radius);
+    cJSON_AddNumberToObject(aoi, "players", g_rum.max_players);
+    cJSON_AddNumberToObject(aoi, "bots", g_rum.max_bots);
+    cJSON_AddNumberToObject(aoi, "objects", g_rum.max_objects);
+
+    cJSON_AddNumberToObject(summary, "heapPeak", (double)heap_memory_peak_total());
+    cJSON_AddNumberToObject(summary, "gpuPeak", (double)g_rum.gpu_peak);
+    add_load(summary);
+
+    char* json = cJSON_PrintUnformatted(summary);
+    if (json) rum_bridge_send(g_rum.url, json);
+    free(json);
+    cJSON_Delete(summary);
+    window_reset();
+}
@@ -0,0 +1,61 @@
+#ifndef CYBERIA_RUM_H
+#define CYBERIA_RUM_H
+
+#include <stdbool.h>
+
+/* rum — opt-in real-user performance monitoring.
+ *
+ * dev_ui and the profiler only help on a developer's machine; this module
+ * aggregates what field sessions need to line client frame budgets up with
+ * the server's AOI settings:
+ *   - frame-time histogram (PROFILER_BUCKET_EDGES_MS) and long-frame count
+ *     (over PROFILER_LONG_FRAME_MS), gameplay frames only
+ *   - decode cost per AOI snapshot: count, mean and max
+ *   - heap and GPU memory high-water
+ *   - the AOI radius and the peak players / bots / world objects it held
+ *   - once per session, the time-to-playable of every LOAD_* stage and
+ *     startup mark (startup_trace.h), ms since navigation start
+ * Every RUM_REPORT_SECONDS, and when the page is hidden, the window so far
+ * goes out as one compact JSON summary via navigator.sendBeacon to the
+ * engine API's RUM_BEACON_PATH (js/rum_bridge.h adds the session id,
+ * sequence number and device class) and the window restarts.
+ *
+ * Sessions are sampled once at startup: RUM_SAMPLE_RATE, overridden by the
+ * page's window.CYBERIA_RUM_SAMPLE, decides the share that report; ?rum=1
+ * forces a session in, ?rum=0 out. Unsampled sessions pay one branch per
+ * frame. */
+
+#ifndef RUM_SAMPLE_RATE
+#define RUM_SAMPLE_RATE 0.0
+#endif
+
+#ifndef RUM_REPORT_SECONDS
+#define RUM_REPORT_SECONDS 60.0
+#endif
+
+#ifndef RUM_BEACON_PATH
+#define RUM_BEACON_PATH "/api/cyberia-client-rum"
+#endif
+
+/* Frames longer than this are a hidden or suspended page, not a slow one,
+ * and are left out. */
+#ifndef RUM_MAX_FRAME_MS
+#define RUM_MAX_FRAME_MS 1000.0f
+#endif
+
+/* Start aggregating; the session was sampled in. Call after
+ * runtime_config_init(). */
+void rum_start(void);
+bool rum_active(void);
+
+/* One gameplay frame, `frame_ms` since the previous one. Sends the summary
+ * when RUM_REPORT_SECONDS have passed. */
+void rum_on_frame(float frame_ms);
+
+/* One AOI snapshot decoded in `decode_ms`. */
+void rum_on_snapshot(double decode_ms);
+
+/* Send the window now (page hidden or closing); no-op while empty. */
+void rum_flush(void);
+
+#endif /* CYBERIA_RUM_H */
@@ -16,6 +16,8 @@
 static char s_instance_code[RC_CODE_MAX];
 static char s_ws_url[RC_URL_MAX];
 static char s_api_base_url[RC_URL_MAX];
+static RuntimeBenchConfig s_bench;
+static bool s_low_latency = false;
 static bool s_initialized = false;
 
 /* Copies a JS-side string allocated with allocateUTF8 into out, freeing it. */
@@ -25,6 +27,30 @@ static void adopt_js_string(char* js_string, char* out, size_t out_size) {
     free(js_string);
 }
 
+/* The page URL's query value for `key`, "" when absent. */
+static void query_param(const char* key, char* out, size_t out_size) {
+    adopt_js_string((char*)EM_ASM_PTR({
+                        var search = self.location && self.location.search ? self.location.search : "";
+                        return allocateUTF8(new URLSearchParams(search).get(UTF8ToString($0)) || "");
+                    }, key),
+                    out, out_size);
+}
+
+static void bench_config_init(void) {
+    char number[32];
+    query_param("bench", s_bench.scenario, sizeof(s_bench.scenario));
+    if ('\0' == s_bench.scenario[0]) return;
+    query_param("n", number, sizeof(number));
+    s_bench.count = atoi(number);
+    query_param("seconds", number, sizeof(number));
+    s_bench.seconds = (float)atof(number);
+    query_param("items", s_bench.items, sizeof(s_bench.items));
+    query_param("capture", s_bench.capture_url, sizeof(s_bench.capture_url));
+    query_param("report", s_bench.report_url, sizeof(s_bench.report_url));
+    LOG_INFO("runtime config bench=%s n=%d seconds=%.1f", s_bench.scenario, s_bench.count,
+             s_bench.seconds);
+}
+
 void runtime_config_init(void) {
     if (s_initialized) return;
     s_initialized = true;
@@ -73,7 +99,13 @@ void runtime_config_init(void) {
                     sizeof(s_api_base_url));
     if ('\0' == s_api_base_url[0]) snprintf(s_api_base_url, sizeof(s_api_base_url), "%s", API_BASE_URL);
 
-    LOG_INFO("runtime config instance=%s ws=%s api=%s", s_instance_code, s_ws_url, s_api_base_url);
+    char latency[16];
+    query_param("latency", latency, sizeof(latency));
+    s_low_latency = 0 == strcmp(latency, "low");
+
+    LOG_INFO("runtime config instance=%s ws=%s api=%s%s", s_instance_code, s_ws_url, s_api_base_url,
+             s_low_latency ? " latency=low" : "");
+    bench_config_init();
 }
 
 const char* runtime_config_instance_code(void) {
@@ -87,3 +119,11 @@ const char* runtime_config_ws_url(void) {
 const char* runtime_config_api_base_url(void) {
     return s_api_base_url;
 }
+
+bool runtime_config_low_latency(void) {
+    return s_low_latency;
+}
+
+const RuntimeBenchConfig* runtime_config_bench(void) {
+    return &s_bench;
+}
@@ -1,6 +1,8 @@
 #ifndef RUNTIME_CONFIG_H
 #define RUNTIME_CONFIG_H
 
+#include <stdbool.h>
+
 /* One WASM binary serves every world instance. The instance code is the first
  * segment of window.location.pathname; an empty segment (root) is the default
  * instance and yields a prefix-free "<origin>/ws" so the server's `/` route
@@ -9,9 +11,27 @@
  * constants are the fallback for local builds. Call runtime_config_init()
  * before connection_open() or any engine fetch. */
 
+/* `?bench=<scenario>` opens the page as a scripted, server-less benchmark
+ * run (bench_scene.h) instead of a session; the other keys tune it.
+ * `scenario` is empty on a normal page load. */
+typedef struct {
+    char  scenario[16];
+    int   count;              /* ?n=        scenario size; 0 = its default   */
+    float seconds;            /* ?seconds=  measured window; 0 = default     */
+    char  items[256];         /* ?items=    comma-separated item ids         */
+    char  capture_url[512];   /* ?capture=  session capture for "replay"     */
+    char  report_url[512];    /* ?report=   endpoint the JSON report POSTs to */
+} RuntimeBenchConfig;
+
+/* `?latency=low`: gameloop sends a tap's uplink before the frame's fx and
+ * render work and runs its first prediction step in the frame it lands,
+ * borrowing it from the fixed-step clock when no step is due. */
+bool        runtime_config_low_latency(void);
+
 void        runtime_config_init(void);
 const char* runtime_config_instance_code(void);
 const char* runtime_config_ws_url(void);
 const char* runtime_config_api_base_url(void);
+const RuntimeBenchConfig* runtime_config_bench(void);
 
 #endif // RUNTIME_CONFIG_H
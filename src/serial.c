@@ -1,10 +1,109 @@
 #include "serial.h"
+#include "hash_table.h"
+#include "heap_memory.h"
+#include "id_intern.h"
+#include "msgpack_decode.h"
 #include "world_types.h"
 #include <string.h>
 #include <assert.h>
+#include <stddef.h>
 #include <stdint.h>
+#include <stdlib.h>
 #include <raylib.h>
 
+/* ============================================================================
+ * Arena-backed Parsing
+ * ============================================================================ */
+
+#define JSON_ARENA_CHUNK  (64u * 1024u)
+/* Chunks kept across resets; a one-off huge payload gives the rest back. */
+#define JSON_ARENA_KEEP   (256u * 1024u)
+
+typedef struct JsonChunk {
+    struct JsonChunk* next;
+    size_t            size;
+    size_t            used;
+    max_align_t       data[];
+} JsonChunk;
+
+static struct {
+    JsonChunk* head;
+    JsonChunk* cur;
+    int        depth;   /* live trees; hooks are swapped while > 0 */
+} g_json_arena;
+
+static void* json_arena_alloc(size_t size) {
+    const size_t align = _Alignof(max_align_t);
+    size = (size + align - 1) & ~(align - 1);
+
+    JsonChunk* c = g_json_arena.cur;
+    while (c && c->used + size > c->size) c = c->next;
+    if (!c) {
+        size_t cap = (size > JSON_ARENA_CHUNK) ? size : JSON_ARENA_CHUNK;
+        c = heap_malloc(HEAP_MEM_JSON, sizeof(JsonChunk) + cap);
+        if (!c) return NULL;
+        *c = (JsonChunk){ .size = cap };
+        JsonChunk** tail = &g_json_arena.head;
+        while (*tail) tail = &(*tail)->next;
+        *tail = c;
+    }
+    g_json_arena.cur = c;
+    void* p = (char*)c->data + c->used;
+    c->used += size;
+    return p;
+}
+
+/* Arena memory goes with the reset. Blocks from before the swap (a tree
+ * built with the default hooks and deleted in the window) are real heap. */
+static void json_arena_release(void* p) {
+    for (const JsonChunk* c = g_json_arena.head; c; c = c->next) {
+        const char* base = (const char*)c->data;
+        if ((const char*)p >= base && (const char*)p < base + c->size) return;
+    }
+    free(p);
+}
+
+static void json_arena_reset(void) {
+    size_t kept = 0;
+    JsonChunk** link = &g_json_arena.head;
+    while (*link) {
+        JsonChunk* c = *link;
+        if (kept + c->size > JSON_ARENA_KEEP) {
+            *link = c->next;
+            heap_free(c);
+            continue;
+        }
+        kept   += c->size;
+        c->used = 0;
+        link    = &c->next;
+    }
+    g_json_arena.cur = g_json_arena.head;
+}
+
+static void json_arena_leave(void) {
+    assert(g_json_arena.depth > 0);
+    if (0 != --g_json_arena.depth) return;
+    cJSON_InitHooks(NULL);
+    json_arena_reset();
+}
+
+cJSON* serial_json_parse(const char* json, size_t length) {
+    assert(json);
+    if (0 == g_json_arena.depth++) {
+        cJSON_InitHooks(&(cJSON_Hooks){ .malloc_fn = json_arena_alloc,
+                                        .free_fn   = json_arena_release });
+    }
+    cJSON* root = msgpack_is(json, length) ? msgpack_decode_tree(json, length)
+                                           : cJSON_ParseWithLength(json, length);
+    if (!root) json_arena_leave();
+    return root;
+}
+
+void serial_json_free(cJSON* root) {
+    if (!root) return;
+    json_arena_leave();
+}
+
 /* ============================================================================
  * Helper Utilities Implementation
  * ============================================================================ */
@@ -144,47 +243,27 @@ int serial_deserialize_dimensions(const cJSON* json, Vector2* out) {
     return 0;
 }
 
-Direction serial_deserialize_direction(const cJSON* json) {
-    assert(json);
+Direction serial_direction_from_name(const char* name) {
+    assert(name);
 
-    if (cJSON_IsNumber(json)) {
-        int val = json->valueint;
-        if (val >= 0 && val <= 8) {
-            return (Direction)val;
-        }
-    } else if (cJSON_IsString(json)) {
-        const char* str = cJSON_GetStringValue(json);
-        if (str) {
-            if (strcmp(str, "up") == 0) return DIRECTION_UP;
-            if (strcmp(str, "down") == 0) return DIRECTION_DOWN;
-            if (strcmp(str, "left") == 0) return DIRECTION_LEFT;
-            if (strcmp(str, "right") == 0) return DIRECTION_RIGHT;
-            if (strcmp(str, "up_left") == 0) return DIRECTION_UP_LEFT;
-            if (strcmp(str, "up_right") == 0) return DIRECTION_UP_RIGHT;
-            if (strcmp(str, "down_left") == 0) return DIRECTION_DOWN_LEFT;
-            if (strcmp(str, "down_right") == 0) return DIRECTION_DOWN_RIGHT;
-        }
-    }
+    if (strcmp(name, "up") == 0) return DIRECTION_UP;
+    if (strcmp(name, "down") == 0) return DIRECTION_DOWN;
+    if (strcmp(name, "left") == 0) return DIRECTION_LEFT;
+    if (strcmp(name, "right") == 0) return DIRECTION_RIGHT;
+    if (strcmp(name, "up_left") == 0) return DIRECTION_UP_LEFT;
+    if (strcmp(name, "up_right") == 0) return DIRECTION_UP_RIGHT;
+    if (strcmp(name, "down_left") == 0) return DIRECTION_DOWN_LEFT;
+    if (strcmp(name, "down_right") == 0) return DIRECTION_DOWN_RIGHT;
 
     return DIRECTION_NONE;
 }
 
-ObjectLayerMode serial_deserialize_mode(const cJSON* json) {
-    assert(json);
+ObjectLayerMode serial_mode_from_name(const char* name) {
+    assert(name);
 
-    if (cJSON_IsNumber(json)) {
-        int val = json->valueint;
-        if (val >= 0 && val <= 2) {
-            return (ObjectLayerMode)val;
-        }
-    } else if (cJSON_IsString(json)) {
-        const char* str = cJSON_GetStringValue(json);
-        if (str) {
-            if (strcmp(str, "idle") == 0) return MODE_IDLE;
-            if (strcmp(str, "walking") == 0) return MODE_WALKING;
-            if (strcmp(str, "teleporting") == 0) return MODE_TELEPORTING;
-        }
-    }
+    if (strcmp(name, "idle") == 0) return MODE_IDLE;
+    if (strcmp(name, "walking") == 0) return MODE_WALKING;
+    if (strcmp(name, "teleporting") == 0) return MODE_TELEPORTING;
 
     return MODE_IDLE;
 }
@@ -201,216 +280,14 @@ int serial_deserialize_object_layer_state(const cJSON* json, ObjectLayerState* o
     out->quantity = 1;
 
     serial_get_string_default(json, "itemId", out->item_id, sizeof(out->item_id), "");
+    out->item_handle = id_intern(out->item_id);
+    out->item_hash   = hash_table_hash(out->item_id);
     out->active = serial_get_bool_default(json, "active", false);
     out->quantity = serial_get_int_default(json, "quantity", 1);
 
     return 0;
 }
 
-int serial_deserialize_object_layer_array(const cJSON* json, ObjectLayerState* out, int max_count) {
-    if (!json || !out || max_count <= 0) return -1;
-    if (!cJSON_IsArray(json)) return -1;
-
-    int count = 0;
-    const cJSON* item = NULL;
-
-    cJSON_ArrayForEach(item, json) {
-        if (count >= max_count) break;
-
-        if (serial_deserialize_object_layer_state(item, &out[count]) == 0) {
-            count++;
-        }
-    }
-
-    return count;
-}
-
-/* ============================================================================
- * Path Serialization/Deserialization
- * ============================================================================ */
-
-int serial_deserialize_path(const cJSON* json, Vector2* out, int max_points) {
-    if (!json || !out || max_points <= 0) return -1;
-    if (!cJSON_IsArray(json)) return -1;
-
-    int count = 0;
-    const cJSON* item = NULL;
-
-    cJSON_ArrayForEach(item, json) {
-        if (count >= max_points) break;
-
-        // Path points can be either {X, Y} or simple coordinate objects
-        if (serial_deserialize_point(item, &out[count]) == 0) {
-            count++;
-        }
-    }
-
-    return count;
-}
-
-/* ============================================================================
- * EntityState Serialization/Deserialization
- * ============================================================================ */
-
-int serial_deserialize_entity_state(const cJSON* json, EntityState* out) {
-    assert(json && out);
-
-    // Initialize
-    memset(out, 0, sizeof(EntityState));
-
-    // Required fields
-    if (serial_get_string(json, "id", out->id, sizeof(out->id)) != 0) {
-        return -1;
-    }
-
-    // Position
-    cJSON* pos_obj = serial_get_object(json, "Pos");
-    if (pos_obj) {
-        serial_deserialize_point(pos_obj, &out->pos_server);
-        out->pos_prev = out->pos_server;
-        out->interp_pos = out->pos_server;
-    }
-
-    // Dimensions
-    cJSON* dims_obj = serial_get_object(json, "Dims");
-    if (dims_obj) {
-        serial_deserialize_dimensions(dims_obj, &out->dims);
-    }
-
-    // Direction and mode
-    cJSON* dir_obj = cJSON_GetObjectItemCaseSensitive(json, "direction");
-    if (dir_obj) {
-        out->direction = serial_deserialize_direction(dir_obj);
-    }
-
-    cJSON* mode_obj = cJSON_GetObjectItemCaseSensitive(json, "mode");
-    if (mode_obj) {
-        out->mode = serial_deserialize_mode(mode_obj);
-    }
-
-    // Life and max life
-    out->life = serial_get_float_default(json, "life", 100.0f);
-    out->max_life = serial_get_float_default(json, "maxLife", 100.0f);
-
-    // Respawn
-    cJSON* respawn_obj = cJSON_GetObjectItemCaseSensitive(json, "respawnIn");
-    if (respawn_obj && cJSON_IsNumber(respawn_obj)) {
-        out->respawn_in = (float)respawn_obj->valuedouble;
-    } else {
-        out->respawn_in = -1.0f; // No respawn
-    }
-
-    // Object layers
-    cJSON* layers_obj = serial_get_array(json, "objectLayers");
-    if (layers_obj) {
-        out->object_layer_count = serial_deserialize_object_layer_array(
-            layers_obj, out->object_layers, MAX_OBJECT_LAYERS
-        );
-        if (out->object_layer_count < 0) {
-            out->object_layer_count = 0;
-        }
-    }
-
-    out->last_update = GetTime();
-
-    return 0;
-}
-
-/* ============================================================================
- * PlayerState Serialization/Deserialization
- * ============================================================================ */
-
-int serial_deserialize_player_state(const cJSON* json, PlayerState* out) {
-    assert(json && out);
-
-    // Deserialize base entity
-    if (serial_deserialize_entity_state(json, &out->base) != 0) {
-        return -1;
-    }
-
-    serial_get_string_default(json, "MapCode", out->map_code, sizeof(out->map_code), "");
-
-    // Target position
-    cJSON* target_obj = serial_get_object(json, "targetPos");
-    if (target_obj) {
-        serial_deserialize_point(target_obj, &out->target_pos);
-    }
-
-    // Path
-    cJSON* path_obj = serial_get_array(json, "path");
-    if (path_obj) {
-        out->path_count = serial_deserialize_path(path_obj, out->path, MAX_PATH_POINTS);
-        if (out->path_count < 0) {
-            out->path_count = 0;
-        }
-    } else {
-        out->path_count = 0;
-    }
-
-    return 0;
-}
-
-/* ============================================================================
- * BotState Serialization/Deserialization
- * ============================================================================ */
-
-int serial_deserialize_bot_state(const cJSON* json, BotState* out) {
-    assert(json && out);
-
-    // Deserialize base entity
-    if (serial_deserialize_entity_state(json, &out->base) != 0) {
-        return -1;
-    }
-
-    // Behavior
-    serial_get_string_default(json, "behavior", out->behavior, sizeof(out->behavior), "");
-
-    return 0;
-}
-
-/* ============================================================================
- * WorldObject Serialization/Deserialization
- * ============================================================================ */
-
-int serial_deserialize_world_object(const cJSON* json, WorldObject* out) {
-    assert(json && out);
-
-    // Initialize
-    memset(out, 0, sizeof(WorldObject));
-
-    // Required fields
-    if (serial_get_string(json, "id", out->id, sizeof(out->id)) != 0) {
-        return -1;
-    }
-
-    serial_get_string_default(json, "Type", out->type, sizeof(out->type), "");
-
-    // Position
-    cJSON* pos_obj = serial_get_object(json, "Pos");
-    if (!pos_obj || serial_deserialize_point(pos_obj, &out->pos) != 0) {
-        return -1;
-    }
-
-    // Dimensions
-    cJSON* dims_obj = serial_get_object(json, "Dims");
-    if (!dims_obj || serial_deserialize_dimensions(dims_obj, &out->dims) != 0) {
-        return -1;
-    }
-
-    // Object layers
-    cJSON* layers_obj = serial_get_array(json, "objectLayers");
-    if (layers_obj) {
-        out->object_layer_count = serial_deserialize_object_layer_array(
-            layers_obj, out->object_layers, MAX_OBJECT_LAYERS
-        );
-        if (out->object_layer_count < 0) {
-            out->object_layer_count = 0;
-        }
-    }
-
-    return 0;
-}
-
 /* ============================================================================
  * Uplink Binary Writer
  * ============================================================================ */
@@ -425,6 +302,10 @@ void bw_u8(BinWriter* w, uint8_t v) {
     w->buf[w->pos++] = v;
 }
 
+void bw_bool(BinWriter* w, bool v) {
+    bw_u8(w, v ? 1 : 0);
+}
+
 void bw_f32(BinWriter* w, float v) {
     if (w->pos + 4 > sizeof(w->buf)) return;
     uint32_t bits;
@@ -453,75 +334,41 @@ void bw_str(BinWriter* w, const char* s) {
     w->pos += (uint16_t)len;
 }
 
-void uplink_handshake(BinWriter* w, const char* client_name, const char* version) {
-    bw_init(w, UPLINK_HANDSHAKE);
-    bw_str(w, client_name ? client_name : "cyberia-mmo");
-    bw_str(w, version     ? version     : "1.0.0");
-}
-
-void uplink_player_action(BinWriter* w, float target_x, float target_y,
-                          uint32_t client_tick, uint32_t sequence) {
-    bw_init(w, UPLINK_PLAYER_ACTION);
-    bw_f32(w, target_x);
-    bw_f32(w, target_y);
-    bw_u32(w, client_tick);
-    bw_u32(w, sequence);
-}
-
-void uplink_item_activation(BinWriter* w, const char* item_id, bool active) {
-    assert(item_id);
-    bw_init(w, UPLINK_ITEM_ACTIVATION);
-    bw_str(w, item_id);
-    bw_u8(w, active ? 1 : 0);
-}
-
-void uplink_freeze_start(BinWriter* w, const char* reason) {
-    bw_init(w, UPLINK_FREEZE_START);
-    bw_str(w, reason ? reason : "");
-}
-
-void uplink_freeze_end(BinWriter* w, const char* reason) {
-    bw_init(w, UPLINK_FREEZE_END);
-    bw_str(w, reason ? reason : "");
-}
-
-void uplink_chat(BinWriter* w, const char* to_id, const char* text) {
-    bw_init(w, UPLINK_CHAT);
-    bw_str(w, to_id ? to_id : "");
-    bw_str(w, text  ? text  : "");
-}
-
-void uplink_get_items_ids(BinWriter* w, const char* item_id) {
-    assert(item_id);
-    bw_init(w, UPLINK_GET_ITEMS_IDS);
-    bw_str(w, item_id);
-}
-
-void uplink_dlg_start(BinWriter* w, const char* entity_id, const char* item_id) {
-    bw_init(w, UPLINK_DLG_START);
-    bw_str(w, entity_id ? entity_id : "");
-    bw_str(w, item_id   ? item_id   : "");
-}
-
-void uplink_dlg_complete(BinWriter* w, const char* entity_id, const char* item_id,
-                         const char* dialog_code) {
-    bw_init(w, UPLINK_DLG_COMPLETE);
-    bw_str(w, entity_id   ? entity_id   : "");
-    bw_str(w, item_id     ? item_id     : "");
-    bw_str(w, dialog_code ? dialog_code : "");
+/* One encoder per UPLINK_MESSAGES entry: the opcode, then each field in
+ * table order through its bw_<kind> writer. */
+#define UPLINK_WRITE_(kind, name) bw_##kind(w, name);
+#define UPLINK_ENCODER_(name, NAME, op)                                     \
+    void uplink_##name(BinWriter* w UPLINK_##NAME##_FIELDS(UPLINK_PARAM_)) { \
+        bw_init(w, UPLINK_##NAME);                                          \
+        UPLINK_##NAME##_FIELDS(UPLINK_WRITE_)                               \
+        assert(UPLINK_MAX_##NAME >= w->pos);                                \
+    }
+UPLINK_MESSAGES(UPLINK_ENCODER_)
+#undef UPLINK_ENCODER_
+#undef UPLINK_WRITE_
+
+void uplink_input_batch(BinWriter* w, const input_command_t* cmds, int count) {
+    assert(cmds);
+    assert(0 < count && UPLINK_INPUT_BATCH_MAX >= count);
+    bw_init(w, UPLINK_INPUT_BATCH);
+    bw_u8(w, (uint8_t)count);
+    for (int i = 0; i < count; i++) {
+        bw_f32(w, cmds[i].target_x);
+        bw_f32(w, cmds[i].target_y);
+        bw_u32(w, cmds[i].client_tick);
+        bw_u32(w, cmds[i].sequence);
+    }
 }
 
-void uplink_dlg_cancel(BinWriter* w, const char* entity_id, const char* item_id) {
-    bw_init(w, UPLINK_DLG_CANCEL);
-    bw_str(w, entity_id ? entity_id : "");
-    bw_str(w, item_id   ? item_id   : "");
-}
-void uplink_quest_abandon(BinWriter* w, const char* quest_code) {
-    bw_init(w, UPLINK_QUEST_ABANDON);
-    bw_str(w, quest_code ? quest_code : "");
-}
-void uplink_quest_accept(BinWriter* w, const char* entity_id, const char* quest_code) {
-    bw_init(w, UPLINK_QUEST_ACCEPT);
-    bw_str(w, entity_id  ? entity_id  : "");
-    bw_str(w, quest_code ? quest_code : "");
+void uplink_item_activation_batch(BinWriter* w, const char* const* item_ids,
+                                  const bool* active, int count) {
+    assert(item_ids && active);
+    assert(0 < count && UPLINK_ITEM_ACTIVATION_BATCH_MAX >= count);
+    bw_init(w, UPLINK_ITEM_ACTIVATION_BATCH);
+    bw_u8(w, (uint8_t)count);
+    for (int i = 0; i < count; i++) {
+        assert(64 > strlen(item_ids[i]));
+        bw_str(w, item_ids[i]);
+        bw_bool(w, active[i]);
+    }
 }
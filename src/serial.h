@@ -8,9 +8,39 @@
 #include <raylib.h>
 
 #include "world_types.h"
+#include "input/input_command.h"
 
 #include "object_layer.h"
 
+/* ============================================================================
+ * Arena-backed Parsing
+ * ============================================================================ */
+
+/**
+ * @brief Parse JSON with every node bump-allocated from a shared arena
+ *
+ * While a tree from serial_json_parse() is live, cJSON's hooks point at the
+ * arena, so nodes and strings cost a pointer bump and serial_json_free()
+ * drops the whole tree with one reset instead of a free per node. Anything
+ * cJSON allocates in that window (created nodes, printed strings) lives in
+ * the arena too and must not outlive the tree; copy what you keep. Parses
+ * nest: the arena resets when the outermost tree is freed.
+ *
+ * A MessagePack body (msgpack_decode.h) yields the tree its JSON form
+ * would, so callers read engine payloads in either encoding.
+ *
+ * @param json   JSON or MessagePack bytes (no NUL needed)
+ * @param length Number of bytes in json
+ * @return Root of the tree, or NULL on a parse error
+ */
+cJSON* serial_json_parse(const char* json, size_t length);
+
+/**
+ * @brief Release a tree from serial_json_parse()
+ * @param root Root of the tree (NULL is a no-op)
+ */
+void serial_json_free(cJSON* root);
+
 /* ============================================================================
  * Core Serialization/Deserialization Functions
  * ============================================================================ */
@@ -27,30 +57,14 @@ int serial_deserialize_point(const cJSON* json, Vector2* out);
 
 int serial_deserialize_dimensions(const cJSON* json, Vector2* out);
 
-Direction serial_deserialize_direction(const cJSON* json);
+/* Wire names ("up_left", "walking", ...) of the enums; unknown names map
+ * to DIRECTION_NONE / MODE_IDLE. */
+Direction serial_direction_from_name(const char* name);
 
-ObjectLayerMode serial_deserialize_mode(const cJSON* json);
+ObjectLayerMode serial_mode_from_name(const char* name);
 
 int serial_deserialize_object_layer_state(const cJSON* json, ObjectLayerState* out);
 
-int serial_deserialize_object_layer_array(const cJSON* json, ObjectLayerState* out, int max_count);
-
-int serial_deserialize_entity_state(const cJSON* json, EntityState* out);
-
-/**
- * @brief Deserialize JSON object to PlayerState (player object)
- * @param json cJSON object with player data
- * @param out Output PlayerState structure
- * @return 0 on success, -1 on failure
- */
-int serial_deserialize_player_state(const cJSON* json, PlayerState* out);
-
-int serial_deserialize_bot_state(const cJSON* json, BotState* out);
-
-int serial_deserialize_world_object(const cJSON* json, WorldObject* out);
-
-int serial_deserialize_path(const cJSON* json, Vector2* out, int max_points);
-
 /* ============================================================================
  * Helper Utilities
  * ============================================================================ */
@@ -163,73 +177,210 @@ bool serial_get_bool_default(const cJSON* json, const char* key, bool default_va
  * All client→server messages are little-endian binary frames.
  * msgType byte 0 discriminates the message:
  *
- *   0x10  handshake       u8 nameLen + str name, u8 verLen + str version
- *   0x11  player_action   f32 targetX, f32 targetY
+ *   0x10  handshake       u8 nameLen + str name, u8 verLen + str version,
+ *                         u8 wireCaps (WIRE_CAP_* the client can decode),
+ *                         u8 wireCapsExt (WIRE_CAP_EXT_*; servers that
+ *                         predate it stop reading after wireCaps)
+ *   0x11  player_action   f32 targetX, f32 targetY, u32 clientTick, u32 sequence
  *   0x12  item_activation u8 idLen + str itemId, u8 active (0|1)
  *   0x13  freeze_start    u8 reasonLen + str reason
  *   0x14  freeze_end      u8 reasonLen + str reason
  *   0x15  chat            u8 toIdLen + str toId, u8 textLen + str text
  *   0x16  get_items_ids   u8 idLen + str itemId
+ *   0x1C  imap_subscribe  u8 codeLen + str instanceCode — start pushing
+ *                         BIN_MSG_IMAP_PRESENCE for that instance
+ *   0x1D  imap_unsubscribe  (no payload)
+ *   0x1E  batch           u8 count, then count × (u16 len + one frame above)
+ *                         — see network_uplink_flush() in game_client.h
+ *   0x1F  input_batch     u8 count, then count × (f32 targetX, f32 targetY,
+ *                         u32 clientTick, u32 sequence), oldest first: the
+ *                         newest unacked taps, resent until acked; the
+ *                         server applies each sequence once
+ *   0x20  resume          u8 tokenLen + str token, u32 lastTick — sent right
+ *                         after the handshake of a reconnect, with the token
+ *                         of BIN_MSG_SESSION and the newest snapshot tick
+ *                         applied; answered by a BIN_MSG_SESSION
+ *   0x21  client_budget   u32 decodeUs, u32 renderUs, u32 visibleEntities,
+ *                         u32 skippedSnapshots, bool overBudget — every
+ *                         CLIENT_BUDGET_REPORT_SECONDS once the server acks
+ *                         WIRE_CAP_EXT_CLIENT_BUDGET, so it can lower this
+ *                         client's snapshot rate or AOI radius
+ *   0x22  item_activation_batch  u8 count, then count × (u8 idLen + str
+ *                         itemId, u8 active) — one equip transaction
+ *                         (domain/equip_txn.h), applied by the server in
+ *                         one tick once it acks WIRE_CAP_EXT_EQUIP_BATCH
+ *   0x23  clock_ping      u32 clientMs — the client's clock, echoed back in
+ *                         BIN_MSG_CLOCK_PONG; sent on the cadence of
+ *                         CLOCK_SYNC_* once the server acks
+ *                         WIRE_CAP_EXT_CLOCK_SYNC
+ *
+ * The frames are declared once, in UPLINK_MESSAGES below. Each entry
+ * X(name, NAME, opcode) has a UPLINK_<NAME>_FIELDS(F) list of F(kind, param)
+ * in wire order, where kind is one of
+ *
+ *   str   u8 len + bytes, at most 255 (const char*, NULL writes "")
+ *   u8    uint8_t          u32   uint32_t, little-endian
+ *   bool  u8 0|1           f32   float, little-endian
+ *
+ * From that table come the UPLINK_<NAME> opcodes, one
+ * void uplink_<name>(BinWriter* w, params...) encoder per frame, and
+ * UPLINK_MAX_<NAME>, the frame's worst-case size in bytes.
  */
 
-#define UPLINK_HANDSHAKE       0x10
-#define UPLINK_PLAYER_ACTION   0x11
-#define UPLINK_ITEM_ACTIVATION 0x12
-#define UPLINK_FREEZE_START    0x13
-#define UPLINK_FREEZE_END      0x14
-#define UPLINK_CHAT            0x15
-#define UPLINK_GET_ITEMS_IDS   0x16
-#define UPLINK_DLG_START       0x17
-#define UPLINK_DLG_COMPLETE    0x18
-#define UPLINK_DLG_CANCEL      0x19
-#define UPLINK_QUEST_ABANDON   0x1A
-#define UPLINK_QUEST_ACCEPT    0x1B
+/* uplink_player_action — TAP event.
+ *
+ * client_tick + sequence let the server echo back lastAckedSequence in
+ * every snapshot header, which the client's prediction module uses to
+ * drain its replay buffer.  Without them the buffer would grow unbounded
+ * and prediction_reconcile would replay every historical tap on every
+ * snapshot — the cause of the "tap → freeze / oscillation" symptom.
+ *
+ * Dialogue interaction frames: the server resolves the bound action and
+ * quest from its own cache; the client only reports which entity it talked
+ * to and (on complete) which dialogue group it finished reading.
+ * quest_abandon moves an active quest to the failed section; quest_accept
+ * is the only path to start a mission. imap_subscribe is held while the
+ * Instance Map modal is open. */
+#define UPLINK_MESSAGES(X)                                  \
+    X(handshake,        HANDSHAKE,        0x10)             \
+    X(player_action,    PLAYER_ACTION,    0x11)             \
+    X(item_activation,  ITEM_ACTIVATION,  0x12)             \
+    X(freeze_start,     FREEZE_START,     0x13)             \
+    X(freeze_end,       FREEZE_END,       0x14)             \
+    X(chat,             CHAT,             0x15)             \
+    X(get_items_ids,    GET_ITEMS_IDS,    0x16)             \
+    X(dlg_start,        DLG_START,        0x17)             \
+    X(dlg_complete,     DLG_COMPLETE,     0x18)             \
+    X(dlg_cancel,       DLG_CANCEL,       0x19)             \
+    X(quest_abandon,    QUEST_ABANDON,    0x1A)             \
+    X(quest_accept,     QUEST_ACCEPT,     0x1B)             \
+    X(imap_subscribe,   IMAP_SUBSCRIBE,   0x1C)             \
+    X(imap_unsubscribe, IMAP_UNSUBSCRIBE, 0x1D)             \
+    X(resume,           RESUME,           0x20)             \
+    X(client_budget,    CLIENT_BUDGET,    0x21)             \
+    X(clock_ping,       CLOCK_PING,       0x23)
+
+#define UPLINK_HANDSHAKE_FIELDS(F)        F(str, client_name) F(str, version) F(u8, wire_caps) \
+                                          F(u8, wire_caps_ext)
+#define UPLINK_PLAYER_ACTION_FIELDS(F)    F(f32, target_x) F(f32, target_y) \
+                                          F(u32, client_tick) F(u32, sequence)
+#define UPLINK_ITEM_ACTIVATION_FIELDS(F)  F(str, item_id) F(bool, active)
+#define UPLINK_FREEZE_START_FIELDS(F)     F(str, reason)
+#define UPLINK_FREEZE_END_FIELDS(F)       F(str, reason)
+#define UPLINK_CHAT_FIELDS(F)             F(str, to_id) F(str, text)
+#define UPLINK_GET_ITEMS_IDS_FIELDS(F)    F(str, item_id)
+#define UPLINK_DLG_START_FIELDS(F)        F(str, entity_id) F(str, item_id)
+#define UPLINK_DLG_COMPLETE_FIELDS(F)     F(str, entity_id) F(str, item_id) F(str, dialog_code)
+#define UPLINK_DLG_CANCEL_FIELDS(F)       F(str, entity_id) F(str, item_id)
+#define UPLINK_QUEST_ABANDON_FIELDS(F)    F(str, quest_code)
+#define UPLINK_QUEST_ACCEPT_FIELDS(F)     F(str, entity_id) F(str, quest_code)
+#define UPLINK_IMAP_SUBSCRIBE_FIELDS(F)   F(str, instance_code)
+#define UPLINK_IMAP_UNSUBSCRIBE_FIELDS(F)
+#define UPLINK_RESUME_FIELDS(F)           F(str, token) F(u32, last_tick)
+#define UPLINK_CLIENT_BUDGET_FIELDS(F)    F(u32, decode_us) F(u32, render_us) \
+                                          F(u32, visible_entities) F(u32, skipped_snapshots) \
+                                          F(bool, over_budget)
+#define UPLINK_CLOCK_PING_FIELDS(F)       F(u32, client_ms)
+
+/* Variable-length frames, encoded by hand rather than from the table. */
+#define UPLINK_BATCH         0x1E
+#define UPLINK_INPUT_BATCH   0x1F
+#define UPLINK_INPUT_BATCH_MAX 8
+#define UPLINK_ITEM_ACTIVATION_BATCH     0x22
+#define UPLINK_ITEM_ACTIVATION_BATCH_MAX 8
+
+#define UPLINK_CTYPE_str     const char*
+#define UPLINK_CTYPE_u8      uint8_t
+#define UPLINK_CTYPE_bool    bool
+#define UPLINK_CTYPE_u32     uint32_t
+#define UPLINK_CTYPE_f32     float
+
+#define UPLINK_BOUND_str     256
+#define UPLINK_BOUND_u8      1
+#define UPLINK_BOUND_bool    1
+#define UPLINK_BOUND_u32     4
+#define UPLINK_BOUND_f32     4
+
+#define UPLINK_PARAM_(kind, name) , UPLINK_CTYPE_##kind name
+#define UPLINK_BOUND_(kind, name) + UPLINK_BOUND_##kind
+
+#define UPLINK_OPCODE_(name, NAME, op) UPLINK_##NAME = op,
+enum { UPLINK_MESSAGES(UPLINK_OPCODE_) };
+#undef UPLINK_OPCODE_
+
+#define UPLINK_MAX_(name, NAME, op) UPLINK_MAX_##NAME = 1 UPLINK_##NAME##_FIELDS(UPLINK_BOUND_),
+enum { UPLINK_MESSAGES(UPLINK_MAX_) };
+#undef UPLINK_MAX_
+
+/* Largest frame any encoder can produce. */
+#define UPLINK_BOUNDS_(name, NAME, op) uint8_t name[UPLINK_MAX_##NAME];
+typedef union { UPLINK_MESSAGES(UPLINK_BOUNDS_) } UplinkFrameBounds;
+#undef UPLINK_BOUNDS_
+#define UPLINK_FRAME_MAX sizeof(UplinkFrameBounds)
+
+/* Downlink encodings the client advertises in the handshake; the server may
+ * then use them per block (see BIN_FLAG_QUANTIZED in binary_aoi_decoder.h). */
+#define WIRE_CAP_QUANTIZED_POS 0x01
+/* init_data and metadata as BIN_MSG_INIT_DATA / BIN_MSG_METADATA; servers
+ * that don't know it keep sending JSON, which stays fully supported. */
+#define WIRE_CAP_BINARY_INIT   0x02
+/* The client can wrap several uplink frames in one UPLINK_BATCH message. It
+ * only does so once the server lists this bit in BIN_MSG_WIRE_ACK; until
+ * then every frame goes out on its own. */
+#define WIRE_CAP_UPLINK_BATCH  0x04
+/* Taps travel as UPLINK_INPUT_BATCH instead of one player_action each, once
+ * the server lists this bit in BIN_MSG_WIRE_ACK. */
+#define WIRE_CAP_INPUT_BATCH   0x08
+/* Combat and loot events may arrive packed in BIN_MSG_EVENT_BATCH frames. */
+#define WIRE_CAP_EVENT_BATCH   0x10
+/* Any downlink frame may arrive LZ4-wrapped in BIN_MSG_COMPRESSED. */
+#define WIRE_CAP_LZ4           0x20
+/* Entity layer lists as u16 BIN_MSG_ITEM_DICT indices, once acked. */
+#define WIRE_CAP_ITEM_DICT     0x40
+/* The server hands out a resume token (BIN_MSG_SESSION) and honours
+ * UPLINK_RESUME on the next connection, once acked. */
+#define WIRE_CAP_RESUME        0x80
+
+/* Second caps byte (handshake wireCapsExt, BIN_MSG_WIRE_ACK's optional
+ * second byte), once the first ran out of bits. */
+/* AOI frames leave floors, obstacles, portals and foregrounds out; the
+ * map's static layer comes from BIN_MSG_STATIC_WORLD (static_world.h). */
+#define WIRE_CAP_EXT_STATIC_WORLD 0x01
+/* The client reports its frame cost in UPLINK_CLIENT_BUDGET, once acked. */
+#define WIRE_CAP_EXT_CLIENT_BUDGET 0x02
+/* An equip transaction travels as one UPLINK_ITEM_ACTIVATION_BATCH, once
+ * acked; until then as one item_activation frame per item. */
+#define WIRE_CAP_EXT_EQUIP_BATCH   0x04
+/* The server answers UPLINK_CLOCK_PING with BIN_MSG_CLOCK_PONG, once acked;
+ * until then the tick estimate runs off snapshot arrivals. */
+#define WIRE_CAP_EXT_CLOCK_SYNC    0x08
 
 typedef struct {
-    uint8_t  buf[256];
+    uint8_t  buf[UPLINK_FRAME_MAX];
     uint16_t pos;
 } BinWriter;
 
 void bw_init(BinWriter* w, uint8_t msg_type);
 void bw_u8(BinWriter* w, uint8_t v);
+void bw_bool(BinWriter* w, bool v);
 void bw_u32(BinWriter* w, uint32_t v);
 void bw_f32(BinWriter* w, float v);
 /* Write a length-prefixed string (1-byte length prefix, max 255 chars). */
 void bw_str(BinWriter* w, const char* s);
 
 /* ── Message builders ── */
-void uplink_handshake(BinWriter* w, const char* client_name, const char* version);
-
-/* uplink_player_action — TAP event.
- *
- * Wire layout:  [u8 kind][f32 x][f32 y][u32 clientTick][u32 sequence]
- *
- * client_tick + sequence let the server echo back lastAckedSequence in
- * every snapshot header, which the client's prediction module uses to
- * drain its replay buffer.  Without them the buffer would grow unbounded
- * and prediction_reconcile would replay every historical tap on every
- * snapshot — the cause of the "tap → freeze / oscillation" symptom. */
-void uplink_player_action(BinWriter* w, float target_x, float target_y,
-                          uint32_t client_tick, uint32_t sequence);
-
-void uplink_item_activation(BinWriter* w, const char* item_id, bool active);
-void uplink_freeze_start(BinWriter* w, const char* reason);
-void uplink_freeze_end(BinWriter* w, const char* reason);
-void uplink_chat(BinWriter* w, const char* to_id, const char* text);
-void uplink_get_items_ids(BinWriter* w, const char* item_id);
-
-/* Dialogue interaction frames. The server resolves the bound action and
- * quest from its own cache; the client only reports which entity it talked
- * to and (on complete) which dialogue group it finished reading. */
-void uplink_dlg_start(BinWriter* w, const char* entity_id, const char* item_id);
-void uplink_dlg_complete(BinWriter* w, const char* entity_id, const char* item_id,
-                         const char* dialog_code);
-void uplink_dlg_cancel(BinWriter* w, const char* entity_id, const char* item_id);
-
-/* Abandon an active quest by code — server moves it to the failed section. */
-void uplink_quest_abandon(BinWriter* w, const char* quest_code);
-
-/* Accept the quest the entity offers — the only path to start a mission. */
-void uplink_quest_accept(BinWriter* w, const char* entity_id, const char* quest_code);
+#define UPLINK_ENCODER_(name, NAME, op) \
+    void uplink_##name(BinWriter* w UPLINK_##NAME##_FIELDS(UPLINK_PARAM_));
+UPLINK_MESSAGES(UPLINK_ENCODER_)
+#undef UPLINK_ENCODER_
+
+/* UPLINK_INPUT_BATCH of cmds[0..count), oldest first;
+ * count <= UPLINK_INPUT_BATCH_MAX. */
+void uplink_input_batch(BinWriter* w, const input_command_t* cmds, int count);
+
+/* UPLINK_ITEM_ACTIVATION_BATCH of item_ids[i] → active[i];
+ * count <= UPLINK_ITEM_ACTIVATION_BATCH_MAX, ids shorter than 64 bytes. */
+void uplink_item_activation_batch(BinWriter* w, const char* const* item_ids,
+                                  const bool* active, int count);
 
 #endif // SERIAL_H
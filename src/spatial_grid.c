@@ -0,0 +1,96 @@
+#include "spatial_grid.h"
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+static int clampi(int v, int lo, int hi) {
+    return (v < lo) ? lo : (v > hi) ? hi : v;
+}
+
+static int bucket_col(const SpatialGrid* g, float x) {
+    return clampi((int)(x / g->bucket_size), 0, g->cols - 1);
+}
+
+static int bucket_row(const SpatialGrid* g, float y) {
+    return clampi((int)(y / g->bucket_size), 0, g->rows - 1);
+}
+
+static int compare_items(const void* a, const void* b) {
+    return *(const int*)a - *(const int*)b;
+}
+
+void spatial_grid_reset(SpatialGrid* g, int grid_w, int grid_h) {
+    assert(g);
+    int w = (grid_w > 0) ? grid_w : 1;
+    int h = (grid_h > 0) ? grid_h : 1;
+    int size = SPATIAL_GRID_BUCKET_CELLS;
+    while (((w + size - 1) / size) * ((h + size - 1) / size) > SPATIAL_GRID_MAX_BUCKETS) {
+        size *= 2;
+    }
+    g->cols        = (w + size - 1) / size;
+    g->rows        = (h + size - 1) / size;
+    g->bucket_size = (float)size;
+    g->max_w       = 0.0f;
+    g->max_h       = 0.0f;
+    memset(g->head, 0, sizeof(g->head[0]) * (size_t)(g->cols * g->rows));
+}
+
+void spatial_grid_insert(SpatialGrid* g, int item, Rectangle r) {
+    assert(g);
+    assert(0 < g->cols);
+    assert(0 <= item && SPATIAL_GRID_MAX_ITEMS > item);
+    g->x[item] = r.x;
+    g->y[item] = r.y;
+    g->w[item] = r.width;
+    g->h[item] = r.height;
+    if (r.width  > g->max_w) g->max_w = r.width;
+    if (r.height > g->max_h) g->max_h = r.height;
+
+    int b = bucket_row(g, r.y) * g->cols + bucket_col(g, r.x);
+    g->next[item] = g->head[b];
+    g->head[b]    = item + 1;
+}
+
+int spatial_grid_query_rect(const SpatialGrid* g, Rectangle r, int* out, int max) {
+    assert(g);
+    assert(out);
+    if (0 == g->cols) return 0;
+
+    int c0 = bucket_col(g, r.x - g->max_w), c1 = bucket_col(g, r.x + r.width);
+    int r0 = bucket_row(g, r.y - g->max_h), r1 = bucket_row(g, r.y + r.height);
+    float right = r.x + r.width, bottom = r.y + r.height;
+
+    int n = 0;
+    for (int row = r0; row <= r1 && n < max; row++) {
+        for (int col = c0; col <= c1 && n < max; col++) {
+            for (int32_t k = g->head[row * g->cols + col]; 0 != k && n < max; k = g->next[k - 1]) {
+                int i = k - 1;
+                if (g->x[i] > right || g->x[i] + g->w[i] < r.x) continue;
+                if (g->y[i] > bottom || g->y[i] + g->h[i] < r.y) continue;
+                out[n++] = i;
+            }
+        }
+    }
+    qsort(out, (size_t)n, sizeof(int), compare_items);
+    return n;
+}
+
+int spatial_grid_query_radius(const SpatialGrid* g, Vector2 center, float radius,
+                              int* out, int max) {
+    Rectangle box = { center.x - radius, center.y - radius, 2.0f * radius, 2.0f * radius };
+    int n = spatial_grid_query_rect(g, box, out, max);
+
+    /* Keep items whose nearest point is inside the circle; order survives. */
+    int kept = 0;
+    for (int j = 0; j < n; j++) {
+        int i = out[j];
+        float nx = (center.x < g->x[i]) ? g->x[i]
+                 : (center.x > g->x[i] + g->w[i]) ? g->x[i] + g->w[i] : center.x;
+        float ny = (center.y < g->y[i]) ? g->y[i]
+                 : (center.y > g->y[i] + g->h[i]) ? g->y[i] + g->h[i] : center.y;
+        float dx = center.x - nx, dy = center.y - ny;
+        if (dx * dx + dy * dy <= radius * radius) out[kept++] = i;
+    }
+    return kept;
+}
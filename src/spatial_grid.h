@@ -0,0 +1,55 @@
+#ifndef SPATIAL_GRID_H
+#define SPATIAL_GRID_H
+
+#include <raylib.h>
+#include <stdint.h>
+
+/* Uniform cell-bucket index over axis-aligned rectangles in grid units.
+ *
+ * Each item (an index into the caller's array) is bucketed once, by its
+ * top-left corner; queries widen their rectangle left/up by the largest
+ * item extent seen, so items spanning several buckets are still found
+ * without storing duplicates. Items keep their rectangle here, so a query
+ * returns exact hits. Results come back in ascending item order, i.e. the
+ * order the caller inserted (and draws) them.
+ *
+ * The buckets cover [0, grid_w) × [0, grid_h); positions outside clamp to
+ * the border buckets. Storage is fixed: a zeroed SpatialGrid reset with
+ * spatial_grid_reset() is ready for use. */
+
+/* Grid cells per bucket edge; grows for maps wider than
+ * SPATIAL_GRID_MAX_BUCKETS allows. */
+#define SPATIAL_GRID_BUCKET_CELLS 8
+#define SPATIAL_GRID_MAX_BUCKETS  4096
+/* Item capacity — MAX_OBJECTS, the largest array indexed. */
+#define SPATIAL_GRID_MAX_ITEMS    5000
+
+typedef struct {
+    int      cols;
+    int      rows;
+    float    bucket_size;                       /* grid cells per bucket edge */
+    float    max_w;                             /* largest item extent */
+    float    max_h;
+    int32_t  head[SPATIAL_GRID_MAX_BUCKETS];    /* item + 1 of the bucket's newest; 0 = empty */
+    int32_t  next[SPATIAL_GRID_MAX_ITEMS];      /* item + 1 of the next in bucket; 0 = end */
+    float    x[SPATIAL_GRID_MAX_ITEMS];
+    float    y[SPATIAL_GRID_MAX_ITEMS];
+    float    w[SPATIAL_GRID_MAX_ITEMS];
+    float    h[SPATIAL_GRID_MAX_ITEMS];
+} SpatialGrid;
+
+/* Empty the grid and size its buckets for a grid_w × grid_h map. */
+void spatial_grid_reset(SpatialGrid* g, int grid_w, int grid_h);
+
+/* Index `item` under rectangle r. Each item is inserted at most once. */
+void spatial_grid_insert(SpatialGrid* g, int item, Rectangle r);
+
+/* Items whose rectangle overlaps r, ascending; returns how many were
+ * written to out (at most max). */
+int  spatial_grid_query_rect(const SpatialGrid* g, Rectangle r, int* out, int max);
+
+/* Items whose rectangle lies within `radius` of `center`, ascending. */
+int  spatial_grid_query_radius(const SpatialGrid* g, Vector2 center, float radius,
+                               int* out, int max);
+
+#endif /* SPATIAL_GRID_H */
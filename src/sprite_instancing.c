@@ -0,0 +1,217 @@
+#include "sprite_instancing.h"
+
+#include "util/log.h"
+
+#include <assert.h>
+#include <emscripten/emscripten.h>
+#include <math.h>
+#include <raymath.h>
+#include <rlgl.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+typedef struct {
+    float   dst[4];
+    float   src[4];   /* u, v, du, dv: negative extents flip */
+    uint8_t tint[4];
+} SpriteInstance;
+
+static_assert(36 == sizeof(SpriteInstance), "instance layout is fixed by the vertex attributes");
+
+typedef struct {
+    unsigned int texture;
+    int          start;
+    int          count;
+} SpriteRun;
+
+static const char *const SPRITE_VERTEX_SHADER =
+    "#version 100\n"
+    "attribute vec2 vertexPosition;\n"
+    "attribute vec4 instanceDst;\n"
+    "attribute vec4 instanceSrc;\n"
+    "attribute vec4 instanceTint;\n"
+    "uniform mat4 mvp;\n"
+    "varying vec2 fragTexCoord;\n"
+    "varying vec4 fragColor;\n"
+    "void main() {\n"
+    "    fragTexCoord = instanceSrc.xy + vertexPosition * instanceSrc.zw;\n"
+    "    fragColor = instanceTint;\n"
+    "    gl_Position = mvp * vec4(instanceDst.xy + vertexPosition * instanceDst.zw, 0.0, 1.0);\n"
+    "}\n";
+
+static const char *const SPRITE_FRAGMENT_SHADER =
+    "#version 100\n"
+    "precision mediump float;\n"
+    "varying vec2 fragTexCoord;\n"
+    "varying vec4 fragColor;\n"
+    "uniform sampler2D texture0;\n"
+    "void main() {\n"
+    "    gl_FragColor = texture2D(texture0, fragTexCoord) * fragColor;\n"
+    "}\n";
+
+/* Two triangles over the unit square, in DrawTexturePro's corner order. */
+static const float kUnitQuad[12] = {
+    0.0f, 0.0f,  0.0f, 1.0f,  1.0f, 1.0f,
+    0.0f, 0.0f,  1.0f, 1.0f,  1.0f, 0.0f,
+};
+
+static struct {
+    bool           tried;
+    bool           ready;
+    Shader         shader;
+    int            loc_mvp;
+    int            loc_dst;
+    int            loc_src;
+    int            loc_tint;
+    unsigned int   vao;
+    unsigned int   quad_vbo;
+    unsigned int   instance_vbo;
+    bool           open;
+    int            count;
+    int            runs;
+    SpriteInstance records[SPRITE_INSTANCING_MAX];
+    SpriteRun      run[SPRITE_INSTANCING_MAX];
+} g_si;
+
+/* Instanced arrays and vertex array objects, core in WebGL 2. */
+static bool instancing_supported(void) {
+    return 0 != EM_ASM_INT({
+        if (typeof GLctx === 'undefined' || !GLctx) return 0;
+        if (typeof WebGL2RenderingContext !== 'undefined' && GLctx instanceof WebGL2RenderingContext) return 1;
+        return GLctx.getExtension('ANGLE_instanced_arrays') && GLctx.getExtension('OES_vertex_array_object') ? 1 : 0;
+    });
+}
+
+static void point_instance_attributes(int first) {
+    size_t base = (size_t)first * sizeof(SpriteInstance);
+    rlSetVertexAttribute((unsigned)g_si.loc_dst, 4, RL_FLOAT, false, (int)sizeof(SpriteInstance),
+                         (int)(base + offsetof(SpriteInstance, dst)));
+    rlSetVertexAttribute((unsigned)g_si.loc_src, 4, RL_FLOAT, false, (int)sizeof(SpriteInstance),
+                         (int)(base + offsetof(SpriteInstance, src)));
+    rlSetVertexAttribute((unsigned)g_si.loc_tint, 4, RL_UNSIGNED_BYTE, true, (int)sizeof(SpriteInstance),
+                         (int)(base + offsetof(SpriteInstance, tint)));
+}
+
+static bool instancing_ready(void) {
+    if (g_si.tried) return g_si.ready;
+    g_si.tried = true;
+    if (!instancing_supported()) return false;
+
+    g_si.shader = LoadShaderFromMemory(SPRITE_VERTEX_SHADER, SPRITE_FRAGMENT_SHADER);
+    if (g_si.shader.id == rlGetShaderIdDefault()) {
+        LOG_WARN("[sprite_instancing] shader unavailable, drawing through the batch");
+        return false;
+    }
+    g_si.loc_mvp  = GetShaderLocation(g_si.shader, "mvp");
+    g_si.loc_dst  = GetShaderLocationAttrib(g_si.shader, "instanceDst");
+    g_si.loc_src  = GetShaderLocationAttrib(g_si.shader, "instanceSrc");
+    g_si.loc_tint = GetShaderLocationAttrib(g_si.shader, "instanceTint");
+    int loc_corner = GetShaderLocationAttrib(g_si.shader, "vertexPosition");
+    g_si.vao = rlLoadVertexArray();
+    if (0 == g_si.vao || 0 > g_si.loc_dst || 0 > g_si.loc_src || 0 > g_si.loc_tint || 0 > loc_corner) {
+        LOG_WARN("[sprite_instancing] vertex arrays unavailable, drawing through the batch");
+        if (0 != g_si.vao) rlUnloadVertexArray(g_si.vao);
+        UnloadShader(g_si.shader);
+        memset(&g_si, 0, sizeof(g_si));
+        g_si.tried = true;
+        return false;
+    }
+
+    rlEnableVertexArray(g_si.vao);
+    g_si.quad_vbo = rlLoadVertexBuffer(kUnitQuad, (int)sizeof(kUnitQuad), false);
+    rlSetVertexAttribute((unsigned)loc_corner, 2, RL_FLOAT, false, 0, 0);
+    rlEnableVertexAttribute((unsigned)loc_corner);
+
+    g_si.instance_vbo = rlLoadVertexBuffer(NULL, (int)sizeof(g_si.records), true);
+    point_instance_attributes(0);
+    rlEnableVertexAttribute((unsigned)g_si.loc_dst);
+    rlEnableVertexAttribute((unsigned)g_si.loc_src);
+    rlEnableVertexAttribute((unsigned)g_si.loc_tint);
+    rlSetVertexAttributeDivisor((unsigned)g_si.loc_dst, 1);
+    rlSetVertexAttributeDivisor((unsigned)g_si.loc_src, 1);
+    rlSetVertexAttributeDivisor((unsigned)g_si.loc_tint, 1);
+    rlDisableVertexArray();
+    rlDisableVertexBuffer();
+
+    g_si.ready = true;
+    LOG_INFO("[sprite_instancing] instanced quads on");
+    return true;
+}
+
+bool sprite_instancing_begin(int count) {
+    assert(!g_si.open);
+    if (SPRITE_INSTANCING_MIN > count || SPRITE_INSTANCING_MAX < count) return false;
+    if (!instancing_ready()) return false;
+    g_si.open  = true;
+    g_si.count = 0;
+    g_si.runs  = 0;
+    return true;
+}
+
+void sprite_instancing_push(Texture2D texture, Rectangle src, Rectangle dst, Color tint) {
+    assert(g_si.open);
+    assert(SPRITE_INSTANCING_MAX > g_si.count);
+    if (0 == texture.id) return;
+
+    /* DrawTexturePro: a negative src extent starts the span at the far
+     * edge; negative dst extents are taken as positive. */
+    float w = (float)texture.width;
+    float h = (float)texture.height;
+    float u = src.x + (0.0f > src.width ? -src.width : 0.0f);
+    float v = src.y + (0.0f > src.height ? -src.height : 0.0f);
+    int i = g_si.count++;
+    g_si.records[i] = (SpriteInstance){
+        .dst  = { dst.x, dst.y, fabsf(dst.width), fabsf(dst.height) },
+        .src  = { u / w, v / h, src.width / w, src.height / h },
+        .tint = { tint.r, tint.g, tint.b, tint.a },
+    };
+    SpriteRun* last = g_si.runs ? &g_si.run[g_si.runs - 1] : NULL;
+    if (last && last->texture == texture.id) {
+        last->count++;
+    } else {
+        g_si.run[g_si.runs++] = (SpriteRun){ .texture = texture.id, .start = i, .count = 1 };
+    }
+}
+
+void sprite_instancing_end(void) {
+    assert(g_si.open);
+    g_si.open = false;
+    if (0 == g_si.count) return;
+
+    /* What the batch holds was pushed before these quads. */
+    rlDrawRenderBatchActive();
+    Matrix mvp = MatrixMultiply(MatrixMultiply(rlGetMatrixTransform(), rlGetMatrixModelview()),
+                                rlGetMatrixProjection());
+
+    rlEnableShader(g_si.shader.id);
+    rlSetUniformMatrix(g_si.loc_mvp, mvp);
+    rlEnableVertexArray(g_si.vao);
+    rlUpdateVertexBuffer(g_si.instance_vbo, g_si.records,
+                         (int)((size_t)g_si.count * sizeof(SpriteInstance)), 0);
+    rlActiveTextureSlot(0);
+    for (int r = 0; r < g_si.runs; r++) {
+        const SpriteRun* run = &g_si.run[r];
+        /* No base-instance in GLES: the run starts where the attributes
+         * point. */
+        rlEnableVertexBuffer(g_si.instance_vbo);
+        point_instance_attributes(run->start);
+        rlEnableTexture(run->texture);
+        rlDrawVertexArrayInstanced(0, 6, run->count);
+    }
+    rlDisableTexture();
+    rlDisableVertexArray();
+    rlDisableVertexBuffer();
+    rlDisableShader();
+}
+
+void sprite_instancing_release(void) {
+    assert(!g_si.open);
+    if (g_si.ready) {
+        rlUnloadVertexBuffer(g_si.quad_vbo);
+        rlUnloadVertexBuffer(g_si.instance_vbo);
+        rlUnloadVertexArray(g_si.vao);
+        UnloadShader(g_si.shader);
+    }
+    memset(&g_si, 0, sizeof(g_si));
+}
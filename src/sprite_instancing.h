@@ -0,0 +1,43 @@
+#ifndef CYBERIA_SPRITE_INSTANCING_H
+#define CYBERIA_SPRITE_INSTANCING_H
+
+#include <raylib.h>
+#include <stdbool.h>
+
+/* Instanced quads for render_queue_flush().
+ *
+ * Through rlgl's batch every DrawTexturePro builds four vertices on the
+ * CPU (position, texcoord, colour, normal each) before the batch is
+ * uploaded. Here a quad is one 36-byte instance record
+ *
+ *     dst rect (4 × f32) | src rect in texture space (4 × f32) | tint (4 × u8)
+ *
+ * all records of a flush go up in one buffer update, and each run of
+ * quads sharing a texture is one instanced draw of a unit quad. Draw order
+ * is record order, which is the queue's sort order, so the depth the queue
+ * sorted by needs no field of its own.
+ *
+ * Available on WebGL 2, and on WebGL 1 contexts with ANGLE_instanced_arrays
+ * and OES_vertex_array_object: the shader is GLSL 100 either way. Where
+ * neither holds (and in the host build) sprite_instancing_begin() returns
+ * false and the queue draws through rlgl as before. Callers only take this
+ * path under the default shader: records carry no effect codes. */
+
+#define SPRITE_INSTANCING_MAX 8192   /* records per flush */
+#define SPRITE_INSTANCING_MIN 64     /* smaller flushes stay on the rlgl batch */
+
+/* Start a flush of `count` quads; false when instancing is unavailable or
+ * `count` is outside [SPRITE_INSTANCING_MIN, SPRITE_INSTANCING_MAX]. */
+bool sprite_instancing_begin(int count);
+
+/* Append one quad, as DrawTexturePro(texture, src, dst, {0, 0}, 0, tint)
+ * would draw it (negative src extents flip). */
+void sprite_instancing_push(Texture2D texture, Rectangle src, Rectangle dst, Color tint);
+
+/* Upload the records and draw them, one instanced draw per texture run. */
+void sprite_instancing_end(void);
+
+/* Unload the buffers and the shader. */
+void sprite_instancing_release(void);
+
+#endif /* CYBERIA_SPRITE_INSTANCING_H */
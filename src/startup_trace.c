@@ -0,0 +1,86 @@
+#include "startup_trace.h"
+
+#include <assert.h>
+#include <stdio.h>
+
+#include <emscripten/emscripten.h>
+
+static struct {
+    bool         recording;
+    double       main_ms;
+    StartupMark  marks[STARTUP_TRACE_MAX_MARKS];
+    int          mark_count;
+    StartupFetch fetches[STARTUP_TRACE_MAX_FETCHES];
+    int          fetch_count;
+    uint32_t     dropped;
+} g_startup;
+
+void startup_trace_begin(void) {
+    g_startup.recording = true;
+    g_startup.main_ms   = emscripten_get_now();
+}
+
+static void add_mark(const char* name, bool stage) {
+    assert(name);
+    if (!g_startup.recording || STARTUP_TRACE_MAX_MARKS <= g_startup.mark_count) return;
+    g_startup.marks[g_startup.mark_count++] = (StartupMark){
+        .name  = name,
+        .at_ms = emscripten_get_now(),
+        .stage = stage,
+    };
+}
+
+void startup_trace_stage_done(const char* name) { add_mark(name, true); }
+
+void startup_trace_mark(const char* name) { add_mark(name, false); }
+
+void startup_trace_end(void) { g_startup.recording = false; }
+
+bool startup_trace_recording(void) { return g_startup.recording; }
+
+int startup_trace_fetch_begin(const char* id, StartupFetchKind kind, FetchClass cls) {
+    assert(id);
+    if (!g_startup.recording) return -1;
+    if (STARTUP_TRACE_MAX_FETCHES <= g_startup.fetch_count) {
+        g_startup.dropped++;
+        return -1;
+    }
+    int slot = g_startup.fetch_count++;
+    StartupFetch* f = &g_startup.fetches[slot];
+    *f = (StartupFetch){ .kind = kind, .cls = cls, .queued_ms = emscripten_get_now() };
+    snprintf(f->id, sizeof(f->id), "%s", id);
+    return slot;
+}
+
+void startup_trace_fetch_dispatched(int slot) {
+    if (0 > slot) return;
+    assert(g_startup.fetch_count > slot);
+    g_startup.fetches[slot].dispatched_ms = emscripten_get_now();
+}
+
+void startup_trace_fetch_end(int slot, size_t bytes, bool ok) {
+    if (0 > slot) return;
+    assert(g_startup.fetch_count > slot);
+    StartupFetch* f = &g_startup.fetches[slot];
+    f->done_ms = emscripten_get_now();
+    f->bytes   = UINT32_MAX < bytes ? UINT32_MAX : (uint32_t)bytes;
+    f->ok      = ok;
+}
+
+double startup_trace_main_ms(void) { return g_startup.main_ms; }
+
+int startup_trace_mark_count(void) { return g_startup.mark_count; }
+
+const StartupMark* startup_trace_mark_at(int i) {
+    assert(0 <= i && g_startup.mark_count > i);
+    return &g_startup.marks[i];
+}
+
+int startup_trace_fetch_count(void) { return g_startup.fetch_count; }
+
+const StartupFetch* startup_trace_fetch_at(int i) {
+    assert(0 <= i && g_startup.fetch_count > i);
+    return &g_startup.fetches[i];
+}
+
+uint32_t startup_trace_dropped(void) { return g_startup.dropped; }
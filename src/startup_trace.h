@@ -0,0 +1,69 @@
+#ifndef CYBERIA_STARTUP_TRACE_H
+#define CYBERIA_STARTUP_TRACE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "network/engine_client.h"
+
+/*
+ * Startup timeline: when each LOAD_* stage of main.c completed and every
+ * fetch started, left the scheduler queue and finished, from main() entry
+ * to the first gameplay frame. Times are emscripten_get_now() ms, the
+ * performance.now() clock the page marks in shell.html use, so
+ * js/startup_bridge can lay both on one Chrome trace.
+ *
+ * Recording closes at startup_trace_end(); fetches begun before then
+ * still record their completion. Past STARTUP_TRACE_MAX_FETCHES the rest
+ * go uncounted and startup_trace_dropped() says how many.
+ */
+
+#define STARTUP_TRACE_MAX_FETCHES 512
+#define STARTUP_TRACE_MAX_MARKS   16
+#define STARTUP_TRACE_ID_LEN      96
+
+typedef enum {
+    STARTUP_FETCH_SINGLE,   /* fetch_request_start / _persistent */
+    STARTUP_FETCH_BULK,     /* one coalesced fetch_batch request */
+    STARTUP_FETCH_PROBE,    /* IndexedDB lookup ahead of a batch */
+} StartupFetchKind;
+
+typedef struct {
+    char             id[STARTUP_TRACE_ID_LEN];   /* asset id or batch name */
+    StartupFetchKind kind;
+    FetchClass       cls;
+    double           queued_ms;
+    double           dispatched_ms;   /* 0 until it leaves the queue */
+    double           done_ms;         /* 0 until answered */
+    uint32_t         bytes;
+    bool             ok;
+} StartupFetch;
+
+typedef struct {
+    const char* name;    /* static string */
+    double      at_ms;
+    bool        stage;   /* stage completion; else an instant */
+} StartupMark;
+
+/* Call first thing in main(). */
+void startup_trace_begin(void);
+/* `name` must outlive the trace (a literal). */
+void startup_trace_stage_done(const char* name);
+void startup_trace_mark(const char* name);
+void startup_trace_end(void);
+bool startup_trace_recording(void);
+
+/* Slot for the other fetch calls, or -1 once closed or full. */
+int  startup_trace_fetch_begin(const char* id, StartupFetchKind kind, FetchClass cls);
+void startup_trace_fetch_dispatched(int slot);   /* -1 is a no-op */
+void startup_trace_fetch_end(int slot, size_t bytes, bool ok);
+
+double              startup_trace_main_ms(void);
+int                 startup_trace_mark_count(void);
+const StartupMark*  startup_trace_mark_at(int i);
+int                 startup_trace_fetch_count(void);
+const StartupFetch* startup_trace_fetch_at(int i);
+uint32_t            startup_trace_dropped(void);
+
+#endif /* CYBERIA_STARTUP_TRACE_H */
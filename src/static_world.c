@@ -0,0 +1,387 @@
+#include "static_world.h"
+
+#include "binary_aoi_decoder.h"
+#include "config.h"
+#include "game_state.h"
+#include "heap_memory.h"
+#include "network/engine_client.h"
+#include "util/log.h"
+
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* One map's layer: the objects as decoded, with their layer stacks packed
+ * into one block they point into. Objects are sorted by chunk, then kind,
+ * then y and x; chunk c owns objects [chunk_first[c], chunk_first[c + 1]).
+ * last_used 0 marks a free slot. */
+typedef struct {
+    char              map_code[MAX_ID_LENGTH];
+    char              version[STATIC_WORLD_VERSION_MAX];
+    WorldObject*      objects;
+    int               count;
+    ObjectLayerState* layers;
+    int*              chunk_first;
+    int               chunk_cols;
+    int               chunk_rows;
+    uint32_t          last_used;
+} StaticMap;
+
+/* Inclusive chunk range paged into game_state. */
+typedef struct {
+    int x0, y0, x1, y1;
+} ChunkRect;
+
+/* `applied` is the maps[] slot held in game_state, -1 for none, and
+ * `generation` moves with it; want_* is the announced layer whose blob is
+ * on its way. `resident` is valid only while `paged` is set. */
+static struct {
+    StaticMap maps[STATIC_WORLD_MAPS];
+    uint32_t  clock;
+    uint32_t  generation;
+    int       applied;
+    bool      paged;
+    ChunkRect resident;
+    char      want_map[MAX_ID_LENGTH];
+    char      want_version[STATIC_WORLD_VERSION_MAX];
+} g_static = { .applied = -1 };
+
+/* A destination's blob fetched ahead of its announce (static_world_prewarm);
+ * data stays NULL until it lands. */
+static struct {
+    char     map_code[MAX_ID_LENGTH];
+    uint8_t* data;
+    size_t   size;
+} g_prewarm;
+
+static int s_sort_cols;   /* chunk_cols of the map being sorted */
+
+static int chunk_coord(float cells) {
+    return 0.0f < cells ? (int)cells / STATIC_CHUNK_CELLS : 0;
+}
+
+static int chunk_of(const WorldObject* o, int cols) {
+    return chunk_coord(o->pos.y) * cols + chunk_coord(o->pos.x);
+}
+
+static int cmp_chunk_order(const void* a, const void* b) {
+    const WorldObject* l = a;
+    const WorldObject* r = b;
+    int lc = chunk_of(l, s_sort_cols), rc = chunk_of(r, s_sort_cols);
+    if (lc != rc) return lc < rc ? -1 : 1;
+    if (l->type_kind != r->type_kind) return l->type_kind < r->type_kind ? -1 : 1;
+    if (l->pos.y != r->pos.y) return l->pos.y < r->pos.y ? -1 : 1;
+    if (l->pos.x != r->pos.x) return l->pos.x < r->pos.x ? -1 : 1;
+    return 0;
+}
+
+/* Sort a captured map into chunk order and build its chunk index. */
+static void index_chunks(StaticMap* m) {
+    int max_cx = 0, max_cy = 0;
+    for (int k = 0; k < m->count; k++) {
+        int cx = chunk_coord(m->objects[k].pos.x), cy = chunk_coord(m->objects[k].pos.y);
+        if (cx > max_cx) max_cx = cx;
+        if (cy > max_cy) max_cy = cy;
+    }
+    m->chunk_cols = max_cx + 1;
+    m->chunk_rows = max_cy + 1;
+    int chunks    = m->chunk_cols * m->chunk_rows;
+    s_sort_cols   = m->chunk_cols;
+    qsort(m->objects, (size_t)m->count, sizeof(WorldObject), cmp_chunk_order);
+
+    m->chunk_first = heap_malloc(HEAP_MEM_STATIC_WORLD, (size_t)(chunks + 1) * sizeof(int));
+    assert(m->chunk_first);
+    int k = 0;
+    for (int c = 0; c <= chunks; c++) {
+        while (k < m->count && chunk_of(&m->objects[k], m->chunk_cols) < c) k++;
+        m->chunk_first[c] = k;
+    }
+}
+
+static int find_map(const char* map_code, const char* version) {
+    for (int i = 0; i < STATIC_WORLD_MAPS; i++) {
+        const StaticMap* m = &g_static.maps[i];
+        if (0 != m->last_used && 0 == strcmp(m->map_code, map_code) &&
+            0 == strcmp(m->version, version)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/* Most recently applied kept layer of `map_code`, any version. */
+static int find_map_code(const char* map_code) {
+    int pick = -1;
+    for (int i = 0; i < STATIC_WORLD_MAPS; i++) {
+        const StaticMap* m = &g_static.maps[i];
+        if (0 == m->last_used || 0 != strcmp(m->map_code, map_code)) continue;
+        if (0 > pick || m->last_used > g_static.maps[pick].last_used) pick = i;
+    }
+    return pick;
+}
+
+/* A free slot, else the least recently applied one other than the held. */
+static int evict_slot(void) {
+    int pick = -1;
+    for (int i = 0; i < STATIC_WORLD_MAPS; i++) {
+        const StaticMap* m = &g_static.maps[i];
+        if (i == g_static.applied) continue;
+        if (0 == m->last_used) return i;
+        if (0 > pick || m->last_used < g_static.maps[pick].last_used) pick = i;
+    }
+    StaticMap* m = &g_static.maps[pick];
+    heap_free(m->objects);
+    heap_free(m->layers);
+    heap_free(m->chunk_first);
+    memset(m, 0, sizeof(*m));
+    return pick;
+}
+
+/* Copy the static arrays just decoded into a kept slot. */
+static int capture(const char* map_code, const char* version) {
+    const GameState* gs = &g_game_state;
+    const WorldObject* arrays[] = { gs->floors, gs->obstacles, gs->portals, gs->foregrounds };
+    const int counts[] = { gs->floor_count, gs->obstacle_count, gs->portal_count,
+                           gs->foreground_count };
+    int total = 0, layers = 0;
+    for (int a = 0; a < 4; a++) {
+        total += counts[a];
+        for (int k = 0; k < counts[a]; k++) layers += arrays[a][k].object_layer_count;
+    }
+
+    int i = evict_slot();
+    StaticMap* m = &g_static.maps[i];
+    m->objects = heap_malloc(HEAP_MEM_STATIC_WORLD, (size_t)(total ? total : 1) * sizeof(WorldObject));
+    m->layers  = heap_malloc(HEAP_MEM_STATIC_WORLD,
+                             (size_t)(layers ? layers : 1) * sizeof(ObjectLayerState));
+    assert(m->objects && m->layers);
+    int l = 0;
+    for (int a = 0; a < 4; a++) {
+        for (int k = 0; k < counts[a]; k++) {
+            WorldObject* o = &m->objects[m->count++];
+            *o = arrays[a][k];
+            memcpy(&m->layers[l], o->object_layers, (size_t)o->object_layer_count * sizeof(ObjectLayerState));
+            o->object_layers = &m->layers[l];
+            l += o->object_layer_count;
+        }
+    }
+    index_chunks(m);
+    snprintf(m->map_code, sizeof(m->map_code), "%s", map_code);
+    snprintf(m->version, sizeof(m->version), "%s", version);
+    m->last_used = ++g_static.clock;
+    return i;
+}
+
+/* Replace the held layer with the chunks in `r`. */
+static void page_in(const StaticMap* m, ChunkRect r) {
+    game_state_hold_static_layer(false);
+    game_state_clear_static_layer();
+    int paged = 0;
+    for (int cy = r.y0; cy <= r.y1; cy++) {
+        const int* first = &m->chunk_first[cy * m->chunk_cols];
+        for (int k = first[r.x0]; k < first[r.x1 + 1]; k++) {
+            WorldObject* o = game_state_append_world_object(m->objects[k].type_kind, NULL);
+            if (NULL == o) continue;   /* that kind's pool is at its bound */
+            *o = m->objects[k];
+            paged++;
+        }
+    }
+    game_state_reindex_world_objects();
+    game_state_hold_static_layer(true);
+    g_static.resident = r;
+    g_static.paged    = true;
+    LOG_DEBUG("[STATIC_WORLD] chunks %d,%d..%d,%d: %d of %d objects", r.x0, r.y0, r.x1, r.y1,
+              paged, m->count);
+}
+
+/* Chunks overlapping `view` grown by `margin` chunks, clamped to the map. */
+static ChunkRect chunks_around(const StaticMap* m, Rectangle view, int margin) {
+    ChunkRect r = {
+        .x0 = chunk_coord(view.x) - margin,
+        .y0 = chunk_coord(view.y) - margin,
+        .x1 = chunk_coord(view.x + view.width) + margin,
+        .y1 = chunk_coord(view.y + view.height) + margin,
+    };
+    if (0 > r.x0) r.x0 = 0;
+    if (0 > r.y0) r.y0 = 0;
+    if (m->chunk_cols <= r.x1) r.x1 = m->chunk_cols - 1;
+    if (m->chunk_rows <= r.y1) r.y1 = m->chunk_rows - 1;
+    if (r.x0 > r.x1) r.x0 = r.x1;
+    if (r.y0 > r.y1) r.y0 = r.y1;
+    return r;
+}
+
+static bool rect_contains(ChunkRect outer, ChunkRect inner) {
+    return outer.x0 <= inner.x0 && outer.y0 <= inner.y0 && outer.x1 >= inner.x1 &&
+           outer.y1 >= inner.y1;
+}
+
+/* Hold the map's layer; the first static_world_update pages its chunks in. */
+static void apply(int i) {
+    game_state_hold_static_layer(false);
+    game_state_clear_static_layer();
+    game_state_hold_static_layer(true);
+    g_static.maps[i].last_used = ++g_static.clock;
+    g_static.applied     = i;
+    g_static.generation++;
+    g_static.paged       = false;
+    g_static.want_map[0] = '\0';
+    LOG_INFO("[STATIC_WORLD] %s@%s: %d objects in %dx%d chunks", g_static.maps[i].map_code,
+             g_static.maps[i].version, g_static.maps[i].count, g_static.maps[i].chunk_cols,
+             g_static.maps[i].chunk_rows);
+}
+
+/* Decode the wanted layer's blob into game_state and keep it; false (and
+ * nothing wanted any more) when it is malformed. */
+static bool land(const uint8_t* data, size_t size) {
+    game_state_hold_static_layer(false);
+    game_state_clear_static_layer();
+    if (0 != binary_aoi_decode_static_world(data, size)) {
+        LOG_ERROR("[STATIC_WORLD] %s: malformed blob (%zu bytes)", g_static.want_map, size);
+        game_state_clear_static_layer();
+        game_state_hold_static_layer(true);
+        g_static.want_map[0] = '\0';
+        return false;
+    }
+    apply(capture(g_static.want_map, g_static.want_version));
+    return true;
+}
+
+static void on_blob(const FetchResponse* r) {
+    char expect[MAX_ID_LENGTH + 16];
+    snprintf(expect, sizeof(expect), "static-world:%s", g_static.want_map);
+    if ('\0' == g_static.want_map[0] || 0 != strcmp(r->asset_id, expect)) return;   /* superseded */
+    if (!r->success) {
+        LOG_WARN("[STATIC_WORLD] %s: blob fetch failed", g_static.want_map);
+        g_static.want_map[0] = '\0';
+        return;
+    }
+    land(r->data, r->size);
+}
+
+static void prewarm_drop(void) {
+    heap_free(g_prewarm.data);
+    g_prewarm.data        = NULL;
+    g_prewarm.size        = 0;
+    g_prewarm.map_code[0] = '\0';
+}
+
+static void on_prewarm_blob(const FetchResponse* r) {
+    char expect[MAX_ID_LENGTH + 24];
+    snprintf(expect, sizeof(expect), "static-world-prewarm:%s", g_prewarm.map_code);
+    if ('\0' == g_prewarm.map_code[0] || 0 != strcmp(r->asset_id, expect)) return;
+    if (!r->success || 0 == r->size) {
+        LOG_WARN("[STATIC_WORLD] %s: prewarm fetch failed", g_prewarm.map_code);
+        prewarm_drop();
+        return;
+    }
+    g_prewarm.data = heap_malloc(HEAP_MEM_STATIC_WORLD, r->size);
+    memcpy(g_prewarm.data, r->data, r->size);
+    g_prewarm.size = r->size;
+}
+
+void static_world_on_announce(const char* map_code, const char* version) {
+    assert(map_code && version);
+    int i = find_map(map_code, version);
+    if (0 <= i) {
+        if (i != g_static.applied) apply(i);
+        return;
+    }
+    /* Drop the previous map's layer now; hold the empty one so stray
+     * static blocks in AOI frames stay out until the blob lands. */
+    game_state_hold_static_layer(false);
+    game_state_clear_static_layer();
+    game_state_hold_static_layer(true);
+    g_static.applied = -1;
+    g_static.generation++;
+    g_static.paged   = false;
+    snprintf(g_static.want_map, sizeof(g_static.want_map), "%s", map_code);
+    snprintf(g_static.want_version, sizeof(g_static.want_version), "%s", version);
+
+    char asset_id[MAX_ID_LENGTH + 16];
+    char url[160];
+    snprintf(asset_id, sizeof(asset_id), "static-world:%s", map_code);
+    snprintf(url, sizeof(url), STATIC_WORLD_URL_FMT, map_code);
+    if (g_prewarm.data && 0 == strcmp(g_prewarm.map_code, map_code)) {
+        /* Fetched during the portal hold: land it now and store it under
+         * the announced version, as the persistent fetch would have. */
+        bool landed = land(g_prewarm.data, g_prewarm.size);
+        if (landed) fetch_persist_store(url, version, g_prewarm.data, g_prewarm.size);
+        prewarm_drop();
+        if (landed) return;
+        snprintf(g_static.want_map, sizeof(g_static.want_map), "%s", map_code);
+    }
+    fetch_request_start_persistent(asset_id, url, version, FETCH_CLASS_VISIBLE, on_blob);
+}
+
+void static_world_prewarm(const char* map_code) {
+    assert(map_code);
+    if ('\0' == map_code[0] || 0 == strcmp(g_prewarm.map_code, map_code)) return;
+    if (0 <= find_map_code(map_code)) return;
+    prewarm_drop();
+    snprintf(g_prewarm.map_code, sizeof(g_prewarm.map_code), "%s", map_code);
+
+    char asset_id[MAX_ID_LENGTH + 24];
+    char url[160];
+    snprintf(asset_id, sizeof(asset_id), "static-world-prewarm:%s", map_code);
+    snprintf(url, sizeof(url), STATIC_WORLD_URL_FMT, map_code);
+    fetch_request_start_persistent(asset_id, url, NULL, FETCH_CLASS_PREFETCH, on_prewarm_blob);
+}
+
+int static_world_item_ids(const char* map_code, char (*out)[MAX_ITEM_ID_LENGTH], int cap) {
+    assert(map_code && out);
+    int i = find_map_code(map_code);
+    if (0 > i) {
+        if (!g_prewarm.data || 0 != strcmp(g_prewarm.map_code, map_code)) return -1;
+        int n = binary_aoi_static_world_items(g_prewarm.data, g_prewarm.size, out, cap);
+        return 0 > n ? 0 : n;
+    }
+    const StaticMap* m = &g_static.maps[i];
+    int found = 0;
+    for (int o = 0; o < m->count; o++) {
+        const WorldObject* obj = &m->objects[o];
+        for (int j = 0; j < obj->object_layer_count && found < cap; j++) {
+            const char* id = obj->object_layers[j].item_id;
+            if ('\0' == id[0]) continue;
+            int k = 0;
+            while (k < found && 0 != strcmp(out[k], id)) k++;
+            if (k == found) memcpy(out[found++], id, MAX_ITEM_ID_LENGTH);
+        }
+    }
+    return found;
+}
+
+void static_world_update(Rectangle view) {
+    if (0 > g_static.applied) return;
+    const StaticMap* m = &g_static.maps[g_static.applied];
+    if (!isfinite(view.x) || !isfinite(view.y) || 0.0f >= view.width) return;
+    ChunkRect want = chunks_around(m, view, STATIC_CHUNK_LOAD_MARGIN);
+    ChunkRect keep = chunks_around(m, view, STATIC_CHUNK_UNLOAD_MARGIN);
+    if (g_static.paged && rect_contains(g_static.resident, want) &&
+        rect_contains(keep, g_static.resident)) {
+        return;
+    }
+    page_in(m, want);
+}
+
+int static_world_objects(const WorldObject** out) {
+    assert(out);
+    *out = NULL;
+    if (0 > g_static.applied) return 0;
+    *out = g_static.maps[g_static.applied].objects;
+    return g_static.maps[g_static.applied].count;
+}
+
+uint32_t static_world_generation(void) {
+    return g_static.generation;
+}
+
+void static_world_release(void) {
+    game_state_hold_static_layer(false);
+    g_static.applied     = -1;
+    g_static.generation++;
+    g_static.paged       = false;
+    g_static.want_map[0] = '\0';
+}
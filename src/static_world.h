@@ -0,0 +1,64 @@
+#ifndef CYBERIA_STATIC_WORLD_H
+#define CYBERIA_STATIC_WORLD_H
+
+/* Static world layer per map (WIRE_CAP_EXT_STATIC_WORLD).
+ *
+ * Floors, obstacles, portals and foregrounds never change within a map, so
+ * a server that accepts the cap leaves them out of AOI frames and announces
+ * the map's code and a version hash on each map entry (BIN_MSG_STATIC_WORLD).
+ * The decoded layer is kept per (map, version) for the last
+ * STATIC_WORLD_MAPS maps, so travelling back through a portal re-applies it
+ * from memory. Otherwise the blob is fetched from STATIC_WORLD_URL_FMT
+ * through the persistent fetch path, so a warm session reads it from
+ * IndexedDB instead of the network.
+ *
+ * The applied layer is held in game_state (game_state_hold_static_layer):
+ * full AOI frames only rebuild statics and resources around it.
+ *
+ * Large maps are paged: each kept layer is sorted into STATIC_CHUNK_CELLS
+ * square chunks, and only the chunks around the camera are held in
+ * game_state, so its pools, spatial grids and floor bakes scale with the
+ * view rather than the map. Chunks load STATIC_CHUNK_LOAD_MARGIN beyond the
+ * view and are dropped only past STATIC_CHUNK_UNLOAD_MARGIN, so walking
+ * along a chunk edge does not page back and forth. Objects belong to the
+ * chunk under their origin cell. */
+
+#include <raylib.h>
+
+#include "object_layer.h"
+#include "world_types.h"
+
+#define STATIC_WORLD_VERSION_MAX 72
+
+/* BIN_MSG_STATIC_WORLD: switch to `map_code`'s layer at `version`. */
+void static_world_on_announce(const char* map_code, const char* version);
+
+/* Page the held layer to the chunks around `view` (camera bounds in
+ * cells). Once per frame, before game_state_commit. */
+void static_world_update(Rectangle view);
+
+/* Fetch `map_code`'s blob ahead of its announce (portal_prewarm.h), at
+ * FETCH_CLASS_PREFETCH and revalidated by ETag since its version is not
+ * known yet; no-op when a layer of it is kept. The blob is held until that
+ * map is announced, which then lands it without a round trip and stores it
+ * under the announced version. Only the newest prewarm is held. */
+void static_world_prewarm(const char* map_code);
+
+/* Distinct item ids `map_code`'s static layer draws, at most `cap`, from a
+ * kept layer or the prewarmed blob; -1 while neither is here. */
+int static_world_item_ids(const char* map_code, char (*out)[MAX_ITEM_ID_LENGTH], int cap);
+
+/* Every object of the applied map's layer — the whole map, not only the
+ * chunks paged into game_state — for whole-map readers (ui/minimap.h).
+ * Sets *out and returns the count; 0 while no layer is applied. The array
+ * stays valid until static_world_generation() moves. */
+int static_world_objects(const WorldObject** out);
+
+/* Bumped whenever the applied layer changes or is dropped. */
+uint32_t static_world_generation(void);
+
+/* Hand the static layer back to AOI frames (session reset, or a server
+ * without the cap). Kept layers stay for a later announce. */
+void static_world_release(void);
+
+#endif /* CYBERIA_STATIC_WORLD_H */
@@ -1,72 +1,293 @@
 #include "texture_cache.h"
 
+#include "gpu_memory.h"
 #include "hash_table.h"
+#include "heap_memory.h"
+#include "image_decoder.h"
+#include "profiler.h"
 #include "util/log.h"
 
 #include <assert.h>
+#include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 typedef enum {
     TEX_LOADING,
     TEX_READY,
+    TEX_ADOPTED,    /* pixels handed to the adopter; no texture here */
     TEX_ERROR
 } TexState;
 
+/* Settled entries sit on the intrusive LRU list of their residency class,
+ * most recent at the head. Entries mid-fetch stay off them: their slot is
+ * needed by the pending callback, so they are never eviction candidates.
+ *
+ * A downsampled entry holds a half-resolution texture (or a preview) but
+ * reports the original width/height in `texture`: raylib derives UVs from
+ * those, so callers' source rects stay in full-resolution pixels. */
+struct TexEntry {
+    Texture2D        texture;
+    TexState         state;
+    double           last_access_time; /* wall-clock seconds */
+    size_t           bytes;            /* GPU bytes actually held */
+    char*            url;              /* own copy of the key, for eviction */
+    bool             downsampled;
+    float            scale;            /* downsampled: held / full resolution */
+    bool             restoring;        /* full-resolution refetch in flight */
+    FetchClass       fetch_class;      /* class the LOADING fetch is queued under */
+    bool             variant;          /* the pending fetch asked for the variant */
+    bool             variant_failed;   /* fetch the plain image from now on */
+    bool             preview;          /* the pending fetch is the preview */
+    int              full_w;           /* preview: the full image's size */
+    int              full_h;
+    int              fit_side;         /* fit: side the last decode was fitted to, 0 unbounded */
+    TextureResidency residency;
+    bool             linked;
+    struct TexEntry* prev;
+    struct TexEntry* next;
+};
+typedef struct TexEntry TexEntry;
+
 typedef struct {
-    Texture2D texture;
-    TexState  state;
-    double    last_access_time; /* wall-clock seconds for LRU eviction */
-} TexEntry;
+    TexEntry* head;
+    TexEntry* tail;
+    int       count;
+} TexList;
 
 struct TextureCache {
     HashTable        entries;   /* url → TexEntry* */
     int              capacity;
+    size_t           byte_budget; /* 0: entry count only */
+    size_t           bytes;       /* estimated GPU bytes of ready entries */
+    GpuMemPool       pool;
+    TexList          lru[TEX_RES_COUNT];
+    unsigned         generation; /* bumped per texture turned ready */
+    unsigned         epoch;      /* bumped per entry settled or removed */
     FetchCompletedCb on_blob;
+    TextureImageAdopter adopter;
+    TextureVersionFn    versioner;
+    TextureVariantFn    variant;
+    TexturePreviewFn    preview;
+    TextureDetailFn     detail;
+    TextureFitFn        fit;
+    FetchClass          fetch_class;
 };
 
 static void free_entry(void* p) {
     TexEntry* e = p;
     if (e->texture.id > 0) { UnloadTexture(e->texture); }
-    free(e);
+    heap_free(e->url);
+    heap_free(e);
 }
 
-TextureCache* texture_cache_create(int capacity, const char* debug_name, FetchCompletedCb on_blob) {
+static size_t relieve_cb(void* user, size_t want, double min_idle);
+static size_t downsample_cb(void* user, double min_idle);
+
+TextureCache* texture_cache_create(int capacity, const char* debug_name, GpuMemPool pool,
+                                   FetchCompletedCb on_blob) {
     assert(capacity > 0);
     assert(debug_name);
     assert(on_blob);
-    TextureCache* tc = malloc(sizeof(TextureCache));
+    TextureCache* tc = heap_malloc(HEAP_MEM_TEXTURE_CACHE, sizeof(TextureCache));
     assert(tc);
     hash_table_init(&tc->entries, (size_t)capacity, free_entry, debug_name);
-    tc->capacity = capacity;
-    tc->on_blob  = on_blob;
+    tc->capacity   = capacity;
+    tc->byte_budget = 0;
+    tc->bytes      = 0;
+    tc->pool       = pool;
+    memset(tc->lru, 0, sizeof(tc->lru));
+    tc->generation = 0;
+    tc->epoch      = 0;
+    tc->on_blob    = on_blob;
+    tc->adopter    = NULL;
+    tc->versioner  = NULL;
+    tc->variant    = NULL;
+    tc->preview    = NULL;
+    tc->detail     = NULL;
+    tc->fit        = NULL;
+    tc->fetch_class = FETCH_CLASS_UI;
+    gpu_memory_add_client((GpuMemClient){ .relieve = relieve_cb, .downsample = downsample_cb, .user = tc });
     return tc;
 }
 
 void texture_cache_destroy(TextureCache* tc) {
     if (!tc) { return; }
+    gpu_memory_remove_client(tc);
+    image_decoder_forget(tc);
+    gpu_memory_sub(tc->pool, tc->bytes);
     hash_table_destroy(&tc->entries);
-    free(tc);
-}
-
-/* Evict the least-recently-accessed ready entry when at capacity. Entries
- * still mid-fetch are skipped — their slot is needed by the pending callback. */
-static void evict_oldest(TextureCache* tc) {
-    HashTable* t = &tc->entries;
-    if (t->count < (size_t)tc->capacity) { return; }
-
-    const char* oldest_key = NULL;
-    double      oldest_at   = 1e18;
-    for (size_t i = 0; i < t->capacity; i++) {
-        HashSlot* s = &t->slots[i];
-        if (SLOT_OCCUPIED != s->state || !s->value) { continue; }
-        TexEntry* e = s->value;
-        if (TEX_LOADING == e->state) { continue; }
-        if (e->last_access_time < oldest_at) {
-            oldest_at  = e->last_access_time;
-            oldest_key = s->key;
+    heap_free(tc);
+}
+
+/* asset_id == url so the completion routes back to this same key; the
+ * variant, when asked for, changes only what is fetched. */
+static void start_entry_fetch(TextureCache* tc, TexEntry* e, FetchClass cls) {
+    const char* suffix = (tc->variant && !e->variant_failed) ? tc->variant(e->url) : NULL;
+    if (e->preview) suffix = tc->preview(e->url, &e->full_w, &e->full_h);
+    char        fetch_url[1024];
+    snprintf(fetch_url, sizeof(fetch_url), "%s%s", e->url, suffix ? suffix : "");
+    e->variant = !e->preview && NULL != suffix;
+    if (tc->versioner) {
+        fetch_request_start_persistent(e->url, fetch_url, tc->versioner(e->url), cls, tc->on_blob);
+    } else {
+        fetch_request_start(e->url, fetch_url, cls, tc->on_blob);
+    }
+}
+
+/* Swap the GPU texture an entry holds, keeping both byte tallies. */
+static void set_entry_texture(TextureCache* tc, TexEntry* e, Texture2D texture, size_t bytes) {
+    if (e->texture.id > 0) { UnloadTexture(e->texture); }
+    tc->bytes -= e->bytes;
+    gpu_memory_sub(tc->pool, e->bytes);
+    e->texture = texture;
+    e->bytes   = bytes;
+    tc->bytes += bytes;
+    gpu_memory_add(tc->pool, bytes);
+}
+
+static void lru_unlink(TextureCache* tc, TexEntry* e) {
+    if (!e->linked) { return; }
+    TexList* l = &tc->lru[e->residency];
+    if (e->prev) { e->prev->next = e->next; } else { l->head = e->next; }
+    if (e->next) { e->next->prev = e->prev; } else { l->tail = e->prev; }
+    e->prev   = NULL;
+    e->next   = NULL;
+    e->linked = false;
+    l->count--;
+}
+
+/* Link into its class's list behind every entry used more recently; an
+ * entry used just now goes to the head without a walk. */
+static void lru_insert(TextureCache* tc, TexEntry* e) {
+    TexList*  l     = &tc->lru[e->residency];
+    TexEntry* after = NULL;
+    for (TexEntry* it = l->head; it && it->last_access_time > e->last_access_time; it = it->next) {
+        after = it;
+    }
+    e->prev = after;
+    e->next = after ? after->next : l->head;
+    if (e->next) { e->next->prev = e; } else { l->tail = e; }
+    if (after) { after->next = e; } else { l->head = e; }
+    e->linked = true;
+    l->count++;
+}
+
+static void set_residency(TextureCache* tc, TexEntry* e, TextureResidency res) {
+    if (res == e->residency) { return; }
+    bool linked = e->linked;
+    lru_unlink(tc, e);
+    e->residency = res;
+    if (linked) { lru_insert(tc, e); }
+}
+
+/* Move unpinned entries unused past their class's time one class colder.
+ * Each list's tail is its stalest entry, so this stops at the first fresh
+ * one. */
+static void decay(TextureCache* tc) {
+    double now = GetTime();
+    const double after[TEX_RES_COUNT] = {
+        [TEX_RES_HOT]  = TEXTURE_CACHE_HOT_SECONDS,
+        [TEX_RES_WARM] = TEXTURE_CACHE_WARM_SECONDS,
+    };
+    for (int r = TEX_RES_HOT; r < TEX_RES_COLD; r++) {
+        TexList* l = &tc->lru[r];
+        while (l->tail && now - l->tail->last_access_time >= after[r]) {
+            set_residency(tc, l->tail, (TextureResidency)(r + 1));
+        }
+    }
+}
+
+/* True when a downsampled entry's reduced copy is too coarse for how
+ * large it is drawn now. */
+static bool wants_restore(const TextureCache* tc, const TexEntry* e) {
+    return !tc->detail || e->scale < tc->detail(e->url);
+}
+
+/* Power-of-two side `url` should decode to, 0 when unbounded. Rounding
+ * up keeps a slow zoom from refetching at every step. */
+static int fit_side(const TextureCache* tc, const char* url) {
+    int want = tc->fit ? tc->fit(url) : 0;
+    if (0 >= want) return 0;
+    int side = 1;
+    while (side < want && side < (1 << 14)) side <<= 1;
+    return side;
+}
+
+/* True when a fitted texture was reduced and is now drawn larger than it. */
+static bool wants_refit(const TextureCache* tc, const TexEntry* e) {
+    if (TEX_READY != e->state || 0 == e->fit_side) return false;
+    int held = e->texture.width > e->texture.height ? e->texture.width : e->texture.height;
+    if (held < e->fit_side) return false;   /* the source was smaller: nothing to gain */
+    int want = fit_side(tc, e->url);
+    return 0 == want || want > e->fit_side;
+}
+
+/* Mark used now and raise to `res` unless already at least as protected. */
+static void touch_entry(TextureCache* tc, TexEntry* e, TextureResidency res) {
+    e->last_access_time = GetTime();
+    /* Seen again: bring back full resolution once the view needs it; the
+     * reduced copy serves until it lands. */
+    if (e->downsampled && !e->restoring && wants_restore(tc, e)) {
+        e->restoring = true;
+        start_entry_fetch(tc, e, tc->fetch_class);
+    } else if (!e->downsampled && !e->restoring && wants_refit(tc, e)) {
+        e->restoring = true;
+        start_entry_fetch(tc, e, tc->fetch_class);
+    }
+    if (res < e->residency) {
+        set_residency(tc, e, res);
+    } else if (e->linked && tc->lru[e->residency].head != e) {
+        lru_unlink(tc, e);
+        lru_insert(tc, e);
+    }
+}
+
+/* Unlink, unaccount and drop one entry (unloads its texture). */
+static void remove_entry(TextureCache* tc, TexEntry* e) {
+    lru_unlink(tc, e);
+    tc->bytes -= e->bytes;
+    gpu_memory_sub(tc->pool, e->bytes);
+    hash_table_remove(&tc->entries, e->url);
+    tc->epoch++;
+}
+
+/* Evict least-recently-used settled entries, coldest class first, while
+ * over the entry capacity (making room for one more) or the byte budget.
+ * `keep` and pinned entries are never evicted. */
+static void evict_lru(TextureCache* tc, const TexEntry* keep) {
+    decay(tc);
+    for (int r = TEX_RES_COLD; r > TEX_RES_PINNED; r--) {
+        TexList* l = &tc->lru[r];
+        while (l->tail && l->tail != keep) {
+            bool over_count = tc->entries.count >= (size_t)tc->capacity;
+            bool over_bytes = tc->byte_budget > 0 && tc->bytes > tc->byte_budget;
+            if (!over_count && !over_bytes) { return; }
+            remove_entry(tc, l->tail);
         }
     }
-    if (oldest_key) { hash_table_remove(t, oldest_key); }
+}
+
+/* New LOADING entry for `url` at residency `res`, its fetch queued under
+ * `cls`. */
+static void add_entry(TextureCache* tc, const char* url, FetchClass cls, TextureResidency res) {
+    evict_lru(tc, NULL);
+
+    TexEntry* e = heap_malloc(HEAP_MEM_TEXTURE_CACHE, sizeof(TexEntry));
+    assert(e);
+    *e = (TexEntry){
+        .state            = TEX_LOADING,
+        .last_access_time = GetTime(),
+        .url              = heap_strdup(HEAP_MEM_TEXTURE_CACHE, url),
+        .fetch_class      = cls,
+        .residency        = res,
+    };
+    assert(e->url);
+    hash_table_put(&tc->entries, url, e);
+
+    e->preview = tc->preview && tc->preview(url, &e->full_w, &e->full_h) &&
+                 0 < e->full_w && 0 < e->full_h;
+    start_entry_fetch(tc, e, cls);
 }
 
 Texture2D texture_cache_get(TextureCache* tc, const char* url) {
@@ -75,20 +296,197 @@ Texture2D texture_cache_get(TextureCache* tc, const char* url) {
 
     TexEntry* e = hash_table_get(&tc->entries, url);
     if (e) {
-        e->last_access_time = GetTime();
+        touch_entry(tc, e, TEX_RES_HOT);
+        /* Wanted now: a warm-up still queued at a lower class moves up. */
+        if (TEX_LOADING == e->state && tc->fetch_class < e->fetch_class &&
+            fetch_reprioritize(url, tc->fetch_class)) {
+            e->fetch_class = tc->fetch_class;
+        }
         return TEX_READY == e->state ? e->texture : (Texture2D){0};
     }
 
-    evict_oldest(tc);
+    add_entry(tc, url, tc->fetch_class, TEX_RES_HOT);
+    return (Texture2D){0};
+}
 
-    e = malloc(sizeof(TexEntry));
-    assert(e);
-    *e = (TexEntry){ .state = TEX_LOADING, .last_access_time = GetTime() };
-    hash_table_put(&tc->entries, url, e);
+void texture_cache_warm(TextureCache* tc, const char* url, FetchClass cls,
+                        TextureResidency res) {
+    assert(tc);
+    assert(url);
+    assert(TEX_RES_COUNT > res);
 
-    /* asset_id == url so the completion routes back to this same key. */
-    fetch_request_start(url, url, tc->on_blob);
-    return (Texture2D){0};
+    TexEntry* e = hash_table_get(&tc->entries, url);
+    if (e) {
+        touch_entry(tc, e, res);
+        return;
+    }
+    add_entry(tc, url, cls, res);
+}
+
+bool texture_cache_set_residency(TextureCache* tc, const char* url, TextureResidency res) {
+    assert(tc);
+    assert(url);
+    assert(TEX_RES_COUNT > res);
+    TexEntry* e = hash_table_get(&tc->entries, url);
+    if (!e) { return false; }
+    set_residency(tc, e, res);
+    return true;
+}
+
+void texture_cache_residency_counts(TextureCache* tc, int out[TEX_RES_COUNT]) {
+    assert(tc);
+    assert(out);
+    decay(tc);
+    for (int r = 0; r < TEX_RES_COUNT; r++) { out[r] = tc->lru[r].count; }
+}
+
+/* Full-resolution (re)fetch of a downsampled or preview entry. On failure
+ * the reduced copy stays; the next touch tries again, without the variant.
+ * The adopter gets first refusal, as on a first load. */
+static void restore_entry(TextureCache* tc, TexEntry* e, DecodedImage* image) {
+    e->restoring = false;
+    if (!image_decoder_ok(image)) {
+        LOG_ERROR("[TEXCACHE] restore failed: %s", e->url);
+        if (e->variant) e->variant_failed = true;
+        image_decoder_release(image);
+        return;
+    }
+    PROFILE_BEGIN(PROF_ZONE_TEXTURE_UPLOAD);
+    bool adopted = tc->adopter && tc->adopter(e->url, image);
+    PROFILE_END(PROF_ZONE_TEXTURE_UPLOAD);
+    if (adopted) {
+        image_decoder_release(image);
+        set_entry_texture(tc, e, (Texture2D){ 0 }, 0);
+        e->downsampled = false;
+        e->state       = TEX_ADOPTED;
+        tc->generation++;
+        tc->epoch++;
+        return;
+    }
+    PROFILE_BEGIN(PROF_ZONE_TEXTURE_UPLOAD);
+    Texture2D texture = image_decoder_upload(image);
+    PROFILE_END(PROF_ZONE_TEXTURE_UPLOAD);
+    PROFILE_COUNT(PROF_COUNT_TEXTURE_UPLOADS, 1);
+    image_decoder_release(image);
+    set_entry_texture(tc, e, texture, gpu_memory_texture_bytes(texture));
+    e->downsampled = false;
+    tc->epoch++;
+}
+
+/* The preview did not arrive usable: fetch the full image in its place. */
+static void skip_preview(TextureCache* tc, TexEntry* e) {
+    LOG_WARN("[TEXCACHE] preview unusable, fetching full image: %s", e->url);
+    e->preview = false;
+    start_entry_fetch(tc, e, e->fetch_class);
+}
+
+/* The variant did not arrive usable (missing, unparsable, refused by the
+ * GPU): fetch the plain image instead, for good. */
+static void fall_back_to_plain(TextureCache* tc, TexEntry* e) {
+    LOG_WARN("[TEXCACHE] variant unusable, fetching plain image: %s", e->url);
+    e->variant_failed = true;
+    start_entry_fetch(tc, e, e->fetch_class);
+}
+
+/* The preview is ready: serve it at full-size UVs and fetch the full image
+ * behind it. */
+static void settle_preview(TextureCache* tc, TexEntry* e, DecodedImage* image) {
+    PROFILE_BEGIN(PROF_ZONE_TEXTURE_UPLOAD);
+    Texture2D texture = image_decoder_upload(image);
+    PROFILE_END(PROF_ZONE_TEXTURE_UPLOAD);
+    PROFILE_COUNT(PROF_COUNT_TEXTURE_UPLOADS, 1);
+    image_decoder_release(image);
+    e->preview = false;
+    if (0 == texture.id) {
+        start_entry_fetch(tc, e, e->fetch_class);
+        return;
+    }
+    size_t bytes = gpu_memory_texture_bytes(texture);
+    e->scale       = (float)texture.width / (float)e->full_w;
+    texture.width  = e->full_w;
+    texture.height = e->full_h;
+    lru_insert(tc, e);
+    set_entry_texture(tc, e, texture, bytes);
+    e->state       = TEX_READY;
+    e->downsampled = true;
+    tc->generation++;
+    tc->epoch++;
+    LOG_INFO("[TEXCACHE] preview: %s", e->url);
+    /* Zoomed out far enough, the preview is all the view can show. */
+    if (wants_restore(tc, e)) {
+        e->restoring = true;
+        start_entry_fetch(tc, e, FETCH_CLASS_PREFETCH);
+    }
+    evict_lru(tc, e);
+}
+
+/* Decoded pixels back from image_decoder_pump(), under the frame's upload
+ * budget. The entry may have gone, or settled, while it decoded. */
+static void on_image_decoded(void* user, const char* url, DecodedImage image) {
+    TextureCache* tc = user;
+    TexEntry*     e  = hash_table_get(&tc->entries, url);
+    if (e && e->restoring) {
+        restore_entry(tc, e, &image);
+        return;
+    }
+    if (!e || TEX_LOADING != e->state) {
+        image_decoder_release(&image);
+        return;
+    }
+    bool ok = image_decoder_ok(&image);
+    if (e->preview) {
+        if (ok) {
+            settle_preview(tc, e, &image);
+            return;
+        }
+        image_decoder_release(&image);
+        skip_preview(tc, e);
+        return;
+    }
+    if (!ok && e->variant) {
+        image_decoder_release(&image);
+        fall_back_to_plain(tc, e);
+        return;
+    }
+    lru_insert(tc, e);
+
+    if (!ok) {
+        image_decoder_release(&image);
+        e->state = TEX_ERROR;
+        tc->epoch++;
+        LOG_ERROR("[TEXCACHE] PNG decode failed: %s", url);
+        return;
+    }
+
+    PROFILE_BEGIN(PROF_ZONE_TEXTURE_UPLOAD);
+    bool adopted = tc->adopter && tc->adopter(url, &image);
+    PROFILE_END(PROF_ZONE_TEXTURE_UPLOAD);
+    if (adopted) {
+        image_decoder_release(&image);
+        e->state = TEX_ADOPTED;
+        tc->generation++;
+        tc->epoch++;
+        LOG_INFO("[TEXCACHE] adopted: %s", url);
+        return;
+    }
+
+    PROFILE_BEGIN(PROF_ZONE_TEXTURE_UPLOAD);
+    Texture2D texture = image_decoder_upload(&image);
+    PROFILE_END(PROF_ZONE_TEXTURE_UPLOAD);
+    PROFILE_COUNT(PROF_COUNT_TEXTURE_UPLOADS, 1);
+    image_decoder_release(&image);
+    if (0 == texture.id && e->variant) {
+        /* The driver refused the block format after all. */
+        lru_unlink(tc, e);
+        fall_back_to_plain(tc, e);
+        return;
+    }
+    set_entry_texture(tc, e, texture, gpu_memory_texture_bytes(texture));
+    e->state = TEX_READY;
+    tc->generation++;
+    tc->epoch++;
+    LOG_INFO("[TEXCACHE] loaded: %s (%dx%d)", url, e->texture.width, e->texture.height);
+    evict_lru(tc, e);
 }
 
 void texture_cache_on_blob_fetched(TextureCache* tc, const FetchResponse* r) {
@@ -96,31 +494,205 @@ void texture_cache_on_blob_fetched(TextureCache* tc, const FetchResponse* r) {
     assert(r);
 
     TexEntry* e = hash_table_get(&tc->entries, r->asset_id);
-    if (!e) { free(r->data); return; }
+    if (!e) { return; }
+    if (!e->restoring && TEX_LOADING != e->state) { return; }
 
     if (!r->success || !r->data || 0 == r->size) {
+        if (e->restoring) {
+            restore_entry(tc, e, &(DecodedImage){ 0 });
+            return;
+        }
+        if (e->preview) {
+            skip_preview(tc, e);
+            return;
+        }
+        if (e->variant) {
+            fall_back_to_plain(tc, e);
+            return;
+        }
+        lru_insert(tc, e);
         e->state = TEX_ERROR;
+        tc->epoch++;
         LOG_ERROR("[TEXCACHE] fetch failed: %s", r->asset_id);
-        free(r->data);
         return;
     }
 
-    Image image = LoadImageFromMemory(".png", r->data, (int)r->size);
-    free(r->data);
-    if (NULL == image.data) {
-        e->state = TEX_ERROR;
-        LOG_ERROR("[TEXCACHE] PNG decode failed: %s", r->asset_id);
-        return;
-    }
+    e->fit_side = fit_side(tc, e->url);
+    image_decoder_submit_fit(r->asset_id, r->data, r->size, e->fit_side, on_image_decoded, tc);
+}
 
-    e->texture = LoadTextureFromImage(image);
-    UnloadImage(image);
-    e->state = TEX_READY;
-    LOG_INFO("[TEXCACHE] loaded: %s (%dx%d)", r->asset_id, e->texture.width, e->texture.height);
+void texture_cache_set_adopter(TextureCache* tc, TextureImageAdopter adopter) {
+    assert(tc);
+    tc->adopter = adopter;
+}
+
+void texture_cache_set_versioner(TextureCache* tc, TextureVersionFn versioner) {
+    assert(tc);
+    tc->versioner = versioner;
+}
+
+void texture_cache_set_variant(TextureCache* tc, TextureVariantFn variant) {
+    assert(tc);
+    tc->variant = variant;
+}
+
+void texture_cache_set_preview(TextureCache* tc, TexturePreviewFn preview) {
+    assert(tc);
+    tc->preview = preview;
+}
+
+void texture_cache_set_detail(TextureCache* tc, TextureDetailFn detail) {
+    assert(tc);
+    tc->detail = detail;
+}
+
+void texture_cache_set_fit(TextureCache* tc, TextureFitFn fit) {
+    assert(tc);
+    tc->fit = fit;
+}
+
+void texture_cache_set_fetch_class(TextureCache* tc, FetchClass cls) {
+    assert(tc);
+    tc->fetch_class = cls;
+}
+
+typedef struct {
+    double now;
+    double max_idle;
+} CancelScan;
+
+static bool cancel_if_unwanted(const char* key, void* value, void* user_data) {
+    const TexEntry*   e    = value;
+    const CancelScan* scan = user_data;
+    if (TEX_LOADING != e->state || TEX_RES_PINNED == e->residency) { return false; }
+    if (scan->now - e->last_access_time < scan->max_idle) { return false; }
+    return fetch_cancel(key);
+}
+
+int texture_cache_cancel_unwanted(TextureCache* tc, double max_idle) {
+    assert(tc);
+    CancelScan scan = { .now = GetTime(), .max_idle = max_idle };
+    size_t n = hash_table_remove_if(&tc->entries, cancel_if_unwanted, &scan);
+    if (n > 0) { tc->epoch++; }
+    return (int)n;
+}
+
+unsigned texture_cache_generation(const TextureCache* tc) {
+    assert(tc);
+    return tc->generation;
 }
 
 void texture_cache_evict(TextureCache* tc, const char* url) {
     assert(tc);
     assert(url);
-    hash_table_remove(&tc->entries, url);
+    TexEntry* e = hash_table_get(&tc->entries, url);
+    if (e) { remove_entry(tc, e); }
+}
+
+static bool drop_loading(const char* key, void* value, void* user_data) {
+    const TexEntry* e = value;
+    if (TEX_LOADING != e->state) { return false; }
+    fetch_cancel(key);
+    return true;
+}
+
+void texture_cache_clear(TextureCache* tc) {
+    assert(tc);
+    for (int r = 0; r < TEX_RES_COUNT; r++) {
+        while (tc->lru[r].tail) { remove_entry(tc, tc->lru[r].tail); }
+    }
+    hash_table_remove_if(&tc->entries, drop_loading, NULL);
+    image_decoder_forget(tc);
+    tc->epoch++;
+}
+
+void texture_cache_set_byte_budget(TextureCache* tc, size_t bytes) {
+    assert(tc);
+    tc->byte_budget = bytes;
+    evict_lru(tc, NULL);
+}
+
+size_t texture_cache_bytes(const TextureCache* tc) {
+    assert(tc);
+    return tc->bytes;
+}
+
+unsigned texture_cache_epoch(const TextureCache* tc) {
+    assert(tc);
+    return tc->epoch;
+}
+
+TextureCacheHandle texture_cache_lookup(const TextureCache* tc, const char* url) {
+    assert(tc);
+    assert(url);
+    TexEntry* e = hash_table_get(&tc->entries, url);
+    return (e && TEX_READY == e->state) ? e : NULL;
+}
+
+Texture2D texture_cache_handle_texture(TextureCacheHandle h) {
+    assert(h);
+    return h->texture;
+}
+
+void texture_cache_touch(TextureCache* tc, TextureCacheHandle h) {
+    assert(tc);
+    assert(h);
+    touch_entry(tc, h, TEX_RES_HOT);
+}
+
+/* GpuMemClient: drop unpinned settled entries idle for at least
+ * `min_idle`, coldest class first and oldest first within it. Each list is
+ * in recency order, so its first fresh entry ends it. */
+static size_t relieve_cb(void* user, size_t want, double min_idle) {
+    TextureCache* tc = user;
+    double now   = GetTime();
+    size_t freed = 0;
+    decay(tc);
+    for (int r = TEX_RES_COLD; r > TEX_RES_PINNED && freed < want; r--) {
+        TexList* l = &tc->lru[r];
+        while (freed < want && l->tail && now - l->tail->last_access_time >= min_idle) {
+            freed += l->tail->bytes;
+            remove_entry(tc, l->tail);
+        }
+    }
+    return freed;
+}
+
+/* Swap one ready texture for a half-resolution copy; bytes freed. */
+static size_t downsample_entry(TextureCache* tc, TexEntry* e) {
+    if (TEX_READY != e->state || e->downsampled || e->restoring) { return 0; }
+    if (e->texture.width < 2 || e->texture.height < 2) { return 0; }
+    /* Block-compressed textures can't be read back, and are small already. */
+    if (e->texture.format >= PIXELFORMAT_COMPRESSED_DXT1_RGB) { return 0; }
+
+    Image image = LoadImageFromTexture(e->texture);
+    if (NULL == image.data) { return 0; }
+    ImageResize(&image, e->texture.width / 2, e->texture.height / 2);
+    Texture2D half = LoadTextureFromImage(image);
+    UnloadImage(image);
+
+    size_t before = e->bytes;
+    size_t bytes  = gpu_memory_texture_bytes(half);
+    half.width  = e->texture.width;    /* keep UVs in full-size pixels */
+    half.height = e->texture.height;
+    set_entry_texture(tc, e, half, bytes);
+    e->downsampled = true;
+    e->scale       = 0.5f;
+    tc->epoch++;
+    return before - bytes;
+}
+
+/* GpuMemClient: replace idle unpinned ready textures with half-resolution
+ * copies, coldest class first. */
+static size_t downsample_cb(void* user, double min_idle) {
+    TextureCache* tc = user;
+    double now   = GetTime();
+    size_t freed = 0;
+    decay(tc);
+    for (int r = TEX_RES_COLD; r > TEX_RES_PINNED; r--) {
+        for (TexEntry* e = tc->lru[r].tail; e && now - e->last_access_time >= min_idle; e = e->prev) {
+            freed += downsample_entry(tc, e);
+        }
+    }
+    return freed;
 }
@@ -2,17 +2,31 @@
 #define CYBERIA_TEXTURE_CACHE_H
 
 #include <raylib.h>
+#include <stdbool.h>
+#include <stddef.h>
 
+#include "gpu_memory.h"
+#include "image_decoder.h"
 #include "network/engine_client.h"
+#include "texture_residency.h"
 
 /*
  * General-purpose async texture cache.
  *
- * Loads PNGs over the engine_client fetch pipeline, decodes + uploads to the
- * GPU on completion, caches the result keyed by URL, and LRU-evicts down to a
- * fixed capacity. Standalone: depends only on raylib, hash_table, and the
+ * Loads PNGs over the engine_client fetch pipeline, decodes them off the
+ * fetch callback and uploads them under the per-frame budget (both through
+ * image_decoder.h), caches the result keyed by URL, and LRU-evicts down to a
+ * fixed capacity and, optionally, a byte budget, coldest residency class
+ * first. Touch and evict are O(1): settled entries are threaded on one
+ * intrusive recency list per class. Standalone:
+ * depends only on raylib, hash_table, the image decoder and the
  * engine_client fetch API — no domain or render modules.
  *
+ * Ready textures are reported to the global accountant (gpu_memory.h) under
+ * the cache's pool; under memory pressure the cache drops its coldest
+ * entries, and when the downsample tier is on it swaps idle textures for
+ * half-resolution copies, refetching the full image on next use.
+ *
  * Multiple independent caches may coexist (atlas textures, UI icons, …). Each
  * is a distinct authority over its own URLs; they never share state.
  *
@@ -29,7 +43,8 @@ typedef struct TextureCache TextureCache;
  *         texture_cache_on_blob_fetched(<this cache>, r);
  *     }
  */
-TextureCache* texture_cache_create(int capacity, const char* debug_name, FetchCompletedCb on_blob);
+TextureCache* texture_cache_create(int capacity, const char* debug_name, GpuMemPool pool,
+                                   FetchCompletedCb on_blob);
 void          texture_cache_destroy(TextureCache* tc);
 
 /* Ready Texture2D, or {.id = 0} while loading or on error. The first call for
@@ -37,10 +52,117 @@ void          texture_cache_destroy(TextureCache* tc);
  * refresh the entry's LRU timestamp. */
 Texture2D     texture_cache_get(TextureCache* tc, const char* url);
 
+/* Like texture_cache_get() without wanting the result yet: starts the fetch
+ * under `cls` (typically FETCH_CLASS_PREFETCH) at residency `res` if
+ * absent, else marks the entry used and raises it to `res` when it sits
+ * colder (never lowers it). A texture_cache_get() while the warm-up is
+ * still queued moves it up to the cache's own class. */
+void          texture_cache_warm(TextureCache* tc, const char* url, FetchClass cls,
+                                 TextureResidency res);
+
+/* Move `url`'s entry, loading or settled, to `res` — TEX_RES_PINNED to
+ * pin it, any other class to unpin (it then decays from there). False
+ * when absent. */
+bool          texture_cache_set_residency(TextureCache* tc, const char* url, TextureResidency res);
+
+/* Settled entries per residency class, after applying due decay. */
+void          texture_cache_residency_counts(TextureCache* tc, int out[TEX_RES_COUNT]);
+
 /* Route an engine_client fetch completion into the cache (keyed by URL). */
 void          texture_cache_on_blob_fetched(TextureCache* tc, const FetchResponse* r);
 
+/* Count of textures that have turned ready so far; a change means some
+ * texture_cache_get() that returned {.id = 0} may now succeed. */
+unsigned      texture_cache_generation(const TextureCache* tc);
+
+/* Offered each decoded image before it is uploaded. Returning true means the
+ * adopter took the pixels (e.g. uploaded them into a shared page): the entry
+ * counts as loaded but holds no texture of its own, so texture_cache_get()
+ * keeps returning {.id = 0} for it and the adopter serves it instead. The
+ * image is released by the cache either way. */
+typedef bool (*TextureImageAdopter)(const char* url, DecodedImage* image);
+
+void          texture_cache_set_adopter(TextureCache* tc, TextureImageAdopter adopter);
+
+/* Content version of `url` (a CID, a hash) or NULL when unknown. With a
+ * versioner set, fetches go through fetch_request_start_persistent(), so
+ * a warm session loads known versions from IndexedDB instead of the
+ * network. */
+typedef const char* (*TextureVersionFn)(const char* url);
+
+void          texture_cache_set_versioner(TextureCache* tc, TextureVersionFn versioner);
+
+/* Query suffix (e.g. "?format=ktx2-bc3") selecting a GPU-ready variant of
+ * `url`, or NULL for the plain image. The entry stays keyed by `url`. A
+ * variant that fails to fetch, parse or upload is replaced by the plain
+ * image, which is what that entry fetches from then on. */
+typedef const char* (*TextureVariantFn)(const char* url);
+
+void          texture_cache_set_variant(TextureCache* tc, TextureVariantFn variant);
+
+/* Query suffix (e.g. "?format=png-preview") selecting a reduced-resolution
+ * copy of `url` with the same layout, or NULL for none; `full_w`/`full_h`
+ * get the full image's size. With a preview set, a new entry fetches the
+ * preview first under its class and serves it as soon as it is ready, then
+ * fetches the full image under FETCH_CLASS_PREFETCH (once the view needs
+ * it, see texture_cache_set_detail) and swaps it in (or hands it to the
+ * adopter) on arrival. A preview that fails is skipped. */
+typedef const char* (*TexturePreviewFn)(const char* url, int* full_w, int* full_h);
+
+void          texture_cache_set_preview(TextureCache* tc, TexturePreviewFn preview);
+
+/* Fraction of full resolution `url` needs at the size it is drawn now
+ * (1: every texel shows). With a detail function set, a preview or
+ * downsampled entry fetches its full image only once the held copy is
+ * coarser than that, so a zoomed-out view keeps the small copies. */
+typedef float (*TextureDetailFn)(const char* url);
+
+void          texture_cache_set_detail(TextureCache* tc, TextureDetailFn detail);
+
+/* Largest side, in pixels, `url` is drawn at now; 0 or less for no limit.
+ * With a fit function set, images decode straight to that size rounded up
+ * to a power of two (image_decoder_submit_fit), so a thumbnail never holds
+ * its source's full resolution; the texture reports the reduced size. An
+ * entry drawn larger than its fitted copy later refetches at the new size
+ * and swaps it in, the old copy serving until then. */
+typedef int (*TextureFitFn)(const char* url);
+
+void          texture_cache_set_fit(TextureCache* tc, TextureFitFn fit);
+
+/* Scheduler class of this cache's fetches (default FETCH_CLASS_UI). */
+void          texture_cache_set_fetch_class(TextureCache* tc, FetchClass cls);
+
+/* Cancel fetches still waiting for a network slot whose URL nobody asked
+ * for in `max_idle` seconds — e.g. atlases of entities that left the AOI.
+ * Pinned entries keep theirs. A later texture_cache_get() starts over. Returns how many were dropped. */
+int           texture_cache_cancel_unwanted(TextureCache* tc, double max_idle);
+
+/* Also evict while the estimated GPU memory of ready textures (width ×
+ * height × 4 each) exceeds `bytes`; 0 turns the budget off. Adopted
+ * entries cost nothing here — the adopter owns their pixels. */
+void          texture_cache_set_byte_budget(TextureCache* tc, size_t bytes);
+size_t        texture_cache_bytes(const TextureCache* tc);
+
 /* Drop a cached entry and unload its GPU texture. No-op if absent. */
 void          texture_cache_evict(TextureCache* tc, const char* url);
 
+/* Drop every entry: unload the textures, cancel fetches still queued and
+ * ignore the ones already in flight. */
+void          texture_cache_clear(TextureCache* tc);
+
+/* Count of entries that settled (ready, adopted, failed) or were removed.
+ * A TextureCacheHandle stays valid while this is unchanged. */
+unsigned      texture_cache_epoch(const TextureCache* tc);
+
+/* Direct reference to a ready entry, so a holder can skip the URL lookup
+ * on every use. Check texture_cache_epoch() before reusing one. */
+typedef struct TexEntry* TextureCacheHandle;
+
+/* Handle of the ready entry for `url`, or NULL. Never fetches or touches. */
+TextureCacheHandle texture_cache_lookup(const TextureCache* tc, const char* url);
+Texture2D     texture_cache_handle_texture(TextureCacheHandle h);
+
+/* Mark the entry most recently used, as texture_cache_get() does. */
+void          texture_cache_touch(TextureCache* tc, TextureCacheHandle h);
+
 #endif /* CYBERIA_TEXTURE_CACHE_H */
@@ -0,0 +1,31 @@
+#ifndef CYBERIA_TEXTURE_RESIDENCY_H
+#define CYBERIA_TEXTURE_RESIDENCY_H
+
+/* Kept apart from texture_cache.h so modules that only name a class (the
+ * object layers manager's API) need not pull in the cache. */
+
+/* Residency class of an entry, most protected first. Eviction (entry
+ * capacity, byte budget, memory pressure) and the downsample tier take the
+ * coldest class first, least recently used first within it; pinned entries
+ * are never taken, only texture_cache_evict()/clear() drop them.
+ *
+ * texture_cache_get() and texture_cache_touch() make an entry HOT (drawn
+ * now); a warm-up starts it at the class it asks for. Unpinned entries
+ * decay on their own: HOT to WARM after TEXTURE_CACHE_HOT_SECONDS unused,
+ * WARM to COLD after TEXTURE_CACHE_WARM_SECONDS. */
+typedef enum {
+    TEX_RES_PINNED, /* must stay: e.g. the local player's own items */
+    TEX_RES_HOT,    /* on screen */
+    TEX_RES_WARM,   /* nearby, likely drawn soon */
+    TEX_RES_COLD,   /* speculative prefetch */
+    TEX_RES_COUNT
+} TextureResidency;
+
+#ifndef TEXTURE_CACHE_HOT_SECONDS
+#define TEXTURE_CACHE_HOT_SECONDS  1.0
+#endif
+#ifndef TEXTURE_CACHE_WARM_SECONDS
+#define TEXTURE_CACHE_WARM_SECONDS 5.0
+#endif
+
+#endif /* CYBERIA_TEXTURE_RESIDENCY_H */
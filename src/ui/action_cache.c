@@ -4,37 +4,31 @@
 
 #include "action_cache.h"
 
+#include "config.h"
+#include "ui/meta_bulk.h"
 #include "network/engine_client.h"
+#include "serial.h"
 #include "util/log.h"
 
 #include <cJSON.h>
 #include <stdio.h>
-#include <stdlib.h>
 #include <string.h>
 
-static ActionMetadataEntry s_cache[ACTION_CACHE_CAP];
-static int             s_count = 0;
-
-static ActionMetadataEntry* find_by_code(const char* code) {
-    if (!code) return NULL;
-    for (int i = 0; i < s_count; ++i) {
-        if (0 == strcmp(s_cache[i].code, code)) return &s_cache[i];
-    }
-    return NULL;
-}
-
-static ActionMetadataEntry* find_or_create(const char* code) {
-    ActionMetadataEntry* e = find_by_code(code);
-    if (e) return e;
-    if (s_count >= ACTION_CACHE_CAP) return NULL;
-    e = &s_cache[s_count++];
-    memset(e, 0, sizeof(ActionMetadataEntry));
-    strncpy(e->code, code, ACTION_CACHE_CODE_MAX - 1);
-    return e;
-}
+static MetaCacheSlot       s_slots[ACTION_CACHE_CAP];
+static ActionMetadataEntry s_entries[ACTION_CACHE_CAP];
+static MetaCache           s_cache = {
+    .name        = "action",
+    .slots       = s_slots,
+    .entries     = s_entries,
+    .stride      = sizeof(ActionMetadataEntry),
+    .capacity    = ACTION_CACHE_CAP,
+    .error_ttl   = ACTION_CACHE_ERROR_TTL,
+    .refresh_ttl = ACTION_CACHE_REFRESH_TTL,
+    .index       = { .records = s_slots, .stride = sizeof(MetaCacheSlot) },
+};
 
 void action_cache_reset(void) {
-    s_count = 0;
+    meta_cache_reset(&s_cache);
 }
 
 static void copy_str(char* dst, size_t cap, const char* src) {
@@ -45,7 +39,7 @@ static void copy_str(char* dst, size_t cap, const char* src) {
 
 const ActionMetadataEntry* action_cache_get(const char* code) {
     if (!code) return NULL;
-    return find_by_code(code);
+    return meta_cache_get(&s_cache, code);
 }
 
 static void ingest_doc(ActionMetadataEntry* e, const cJSON* doc) {
@@ -82,39 +76,90 @@ static void ingest_doc(ActionMetadataEntry* e, const cJSON* doc) {
     }
 }
 
+/* Settle the pending entry; a failed refresh keeps it READY. */
+static void settle(ActionMetadataEntry* e, const char* code, bool ok) {
+    meta_cache_settle(&s_cache, code, ok);
+    e->state = (ActionCacheState)meta_cache_state(&s_cache, code);
+}
+
+/* Replace the pending entry with the parsed action doc. */
+static void store_doc(ActionMetadataEntry* e, const char* code, const cJSON* doc) {
+    memset(e, 0, sizeof(*e));
+    copy_str(e->code, ACTION_CACHE_CODE_MAX, code);
+    ingest_doc(e, doc);
+    settle(e, code, true);
+}
+
 static void on_action_fetched(const FetchResponse* r) {
-    ActionMetadataEntry* e = find_by_code(r->asset_id);
-    if (!e) { free(r->data); return; }
+    ActionMetadataEntry* e = meta_cache_pending(&s_cache, r->asset_id);
+    if (!e) { return; }
 
     if (!r->success) {
-        e->state = ACTION_CACHE_ERROR;
+        settle(e, r->asset_id, false);
         LOG_WARN("action metadata fetch failed for %s", r->asset_id);
-        free(r->data);
         return;
     }
 
-    cJSON* root = cJSON_ParseWithLength((const char*)r->data, r->size);
+    cJSON* root = serial_json_parse((const char*)r->data, r->size);
     const cJSON* status = root ? cJSON_GetObjectItemCaseSensitive(root, "status") : NULL;
     const cJSON* doc = root ? cJSON_GetObjectItemCaseSensitive(root, "data") : NULL;
     if (!cJSON_IsString(status) || 0 != strcmp(status->valuestring, "success") || !cJSON_IsObject(doc)) {
-        e->state = ACTION_CACHE_ERROR;
+        settle(e, r->asset_id, false);
     } else {
-        ingest_doc(e, doc);
-        e->state = ACTION_CACHE_READY;
+        store_doc(e, r->asset_id, doc);
     }
-    cJSON_Delete(root);
-    free(r->data);
+    serial_json_free(root);
 }
 
-void action_cache_fetch(const char* code) {
-    if (!code || '\0' == code[0]) return;
+static void store_bulk_doc(const char* code, const cJSON* doc) {
+    ActionMetadataEntry* e = meta_cache_pending(&s_cache, code);
+    if (e) store_doc(e, code, doc);
+}
 
-    ActionMetadataEntry* e = find_or_create(code);
-    if (!e) return;
-    if (ACTION_CACHE_READY == e->state || ACTION_CACHE_LOADING == e->state) return;
+/* Bulk envelope: `data` is an array of action docs, each naming its `code`,
+ * ingested in a frame task (meta_bulk.h). A code the engine left out stays
+ * LOADING until meta_cache times it out. */
+static void on_action_bulk_fetched(const FetchResponse* r) {
+    meta_bulk_defer(r, store_bulk_doc);
+}
+
+#define ACTION_URL_FORMAT "/api/cyberia-action/code/%s"
+
+static FetchBatch* s_prefetch_batch = NULL;
+
+/* Claim `code` for a request, or NULL when none is due. */
+static ActionMetadataEntry* begin_fetch(const char* code) {
+    if (!code || '\0' == code[0]) return NULL;
+
+    ActionMetadataEntry* e = meta_cache_begin_fetch(&s_cache, code);
+    if (!e) return NULL;
+    if ('\0' == e->code[0]) copy_str(e->code, ACTION_CACHE_CODE_MAX, code);
+    e->state = (ActionCacheState)meta_cache_state(&s_cache, code);
+    return e;
+}
+
+void action_cache_fetch(const char* code) {
+    if (!begin_fetch(code)) return;
 
-    e->state = ACTION_CACHE_LOADING;
     char url[512];
-    snprintf(url, sizeof url, "/api/cyberia-action/code/%s", code);
-    fetch_request_start(code, url, on_action_fetched);
+    snprintf(url, sizeof url, ACTION_URL_FORMAT, code);
+    fetch_request_start(code, url, FETCH_CLASS_UI, on_action_fetched);
+}
+
+void action_cache_prefetch(const char* code) {
+    if (!begin_fetch(code)) return;
+
+    if (!s_prefetch_batch) {
+        s_prefetch_batch = fetch_batch_create(&(FetchBatchConfig){
+            .name        = "action-metadata-bulk",
+            .bulk_url    = "/api/cyberia-action/codes?codes=",
+            .single_url  = ACTION_URL_FORMAT,
+            .max_keys    = META_PREFETCH_BATCH_MAX_KEYS,
+            .window_ms   = META_PREFETCH_BATCH_WINDOW_MS,
+            .fetch_class = FETCH_CLASS_PREFETCH,
+            .on_bulk     = on_action_bulk_fetched,
+            .on_item     = on_action_fetched,
+        });
+    }
+    fetch_batch_request(s_prefetch_batch, code, NULL);
 }
@@ -4,8 +4,9 @@
  * The Go server sends only the bot's action CODE over AOI. The presentation
  * metadata — overhead label, greeting, and the per-quest dialogue map that
  * names which quests the NPC handles — is fetched lazily from
- * GET /api/cyberia-action/code/:code and cached here. Immutable, so each code
- * is fetched at most once per session.
+ * GET /api/cyberia-action/code/:code and cached here in a meta_cache (hashed,
+ * LRU-evicting, failed fetches retried after ACTION_CACHE_ERROR_TTL, READY
+ * actions refreshed in the background after ACTION_CACHE_REFRESH_TTL).
  */
 
 #ifndef ACTION_CACHE_H
@@ -13,16 +14,20 @@
 
 #include <stdbool.h>
 
+#include "meta_cache.h"
+
 #define ACTION_CACHE_CODE_MAX   64
 #define ACTION_CACHE_LABEL_MAX  64
 #define ACTION_CACHE_QUEST_MAX  8
 #define ACTION_CACHE_CAP  32
+#define ACTION_CACHE_ERROR_TTL   30.0   /* seconds */
+#define ACTION_CACHE_REFRESH_TTL 600.0  /* seconds */
 
 typedef enum {
-    ACTION_CACHE_NONE = 0,
-    ACTION_CACHE_LOADING,
-    ACTION_CACHE_READY,
-    ACTION_CACHE_ERROR,
+    ACTION_CACHE_NONE    = META_CACHE_NONE,
+    ACTION_CACHE_LOADING = META_CACHE_LOADING,
+    ACTION_CACHE_READY   = META_CACHE_READY,
+    ACTION_CACHE_ERROR   = META_CACHE_ERROR,
 } ActionCacheState;
 
 typedef struct {
@@ -44,10 +49,17 @@ typedef struct {
 
 void action_cache_reset(void);
 
-/* Schedule an async REST fetch if not cached/loading. */
+/* Schedule an async REST fetch if not cached/loading, or when a failed or
+ * aging entry is due for a retry or background refresh. */
 void action_cache_fetch(const char* code);
 
-/* Cached action by code, or NULL. */
+/* action_cache_fetch() at FETCH_CLASS_PREFETCH, coalesced with other
+ * prefetches into one GET /api/cyberia-action/codes?codes=a,b,c (falling
+ * back to the per-code route on an engine without it). */
+void action_cache_prefetch(const char* code);
+
+/* Cached action by code, or NULL. Valid at least until the next
+ * action_cache_fetch() of another code. */
 const ActionMetadataEntry* action_cache_get(const char* code);
 
 #endif /* ACTION_CACHE_H */
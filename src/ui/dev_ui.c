@@ -1,12 +1,27 @@
 #include "dev_ui.h"
 #include "text.h"
 
+#include "input/input_latency.h"
 #include "network/game_client.h"
+#include "network/net_telemetry.h"
+#include "network/replication.h"
 #include "game_render.h"
 #include "game_state.h"
+#include "render_queue.h"
+#include "gpu_memory.h"
+#include "fidelity.h"
+#include "layer_stack.h"
+#include "object_layers_management.h"
+#include "heap_memory.h"
+#include "frame_arena.h"
+#include "profiler.h"
+#include "network/engine_client.h"
+#include "domain/local_player.h"
 #include "domain/presentation_runtime.h"
 #include "inventory_bar.h"
 #include "util/log.h"
+#include "render_stats.h"
+#include "runtime_config.h"
 
 #include <assert.h>
 #include <stdio.h>
@@ -46,7 +61,7 @@ int dev_ui_init(void) {
 
     // Set default dimensions
     g_dev_ui.dev_ui_width = 450;
-    g_dev_ui.dev_ui_height = 280;
+    g_dev_ui.dev_ui_height = 470; // 21 text lines + FPS title
     g_dev_ui.background_alpha = 0.4f;
 
     // Set default colors
@@ -71,6 +86,7 @@ int dev_ui_init(void) {
     g_dev_ui.show_player_stats = true;
     g_dev_ui.show_game_stats = true;
     g_dev_ui.show_error_section = true;
+    g_dev_ui.ready = true;
 
     LOG_INFO("[DEV_UI] Development UI initialized\n");
     return 0;
@@ -82,6 +98,7 @@ void dev_ui_cleanup(void) {
 }
 
 void dev_ui_on_tick(float delta_time) {
+    if (!g_dev_ui.ready) dev_ui_init();
     // Update FPS tracking
     double current_time = GetTime();
     if (current_time - g_dev_ui.last_fps_update >= 0.1) {
@@ -161,10 +178,184 @@ int dev_ui_get_active_item_count(const char* player_id) {
     return active_count;
 }
 
+#if CYBERIA_PROFILE
+/* Flame bar of the last frame (one row per nesting depth, scaled so the bar
+ * spans two 60 Hz frames), a per-zone p50/p95/p99 table, the frame-time
+ * histogram and the most recent long frame, drawn as its own panel directly
+ * above the stats panel. Debug-overlay colours, like the
+ * path overlay: not part of the engine palette. */
+#define PROF_BAR_SPAN_MS 33.3f
+#define PROF_ROW_H       10
+#define PROF_ROWS        3
+#define PROF_LINE_H      13
+#define PROF_FONT        10
+#define PROF_HIST_H      24
+
+static const Color kZoneColors[PROF_ZONE_COUNT] = {
+    [PROF_ZONE_NETWORK]         = {  90, 160, 230, 255 },
+    [PROF_ZONE_AOI_DECODE]      = { 230, 140,  60, 255 },
+    [PROF_ZONE_FETCH_PUMP]      = { 160, 110, 220, 255 },
+    [PROF_ZONE_UI_TICK]         = {  90, 200, 130, 255 },
+    [PROF_ZONE_PREDICTION]      = { 200, 200,  90, 255 },
+    [PROF_ZONE_INTERPOLATION]   = {  80, 210, 210, 255 },
+    [PROF_ZONE_RENDER]          = { 120, 120, 130, 255 },
+    [PROF_ZONE_RENDER_ENTITIES] = { 230,  90, 120, 255 },
+    [PROF_ZONE_TEXTURE_UPLOAD]  = { 240,  60,  60, 255 },
+};
+
+static void draw_profiler_overlay(int x, int bottom_y, int width) {
+    int height = 8 + PROF_LINE_H + PROF_ROWS * PROF_ROW_H + 6 + (PROF_ZONE_COUNT + 1) * PROF_LINE_H +
+                 6 + PROF_HIST_H + 3 * PROF_LINE_H;
+    int y = bottom_y - height;
+    if (y < 0) y = 0;
+    DrawRectangle(x, y, width, height, g_dev_ui.background_color);
+
+    int inner_x = x + 10;
+    int inner_w = width - 20;
+    int cy      = y + 4;
+
+    float frame_ms = 0.0f;
+    const ProfilerSpan* spans = profiler_last_frame(&frame_ms);
+    ProfilerZoneStats fs = profiler_frame_stats();
+    char line[128];
+    snprintf(line, sizeof(line), "frame %.1f ms   p50 %.1f  p95 %.1f  p99 %.1f",
+             frame_ms, fs.p50_ms, fs.p95_ms, fs.p99_ms);
+    DrawText(line, inner_x, cy, PROF_FONT, g_dev_ui.text_color);
+    cy += PROF_LINE_H;
+
+    float px_per_ms = (float)inner_w / PROF_BAR_SPAN_MS;
+    DrawRectangle(inner_x, cy, inner_w, PROF_ROWS * PROF_ROW_H, (Color){ 0, 0, 0, 120 });
+    for (int z = 0; z < PROF_ZONE_COUNT; z++) {
+        const ProfilerSpan* s = &spans[z];
+        if (0 == s->calls || s->depth >= PROF_ROWS) continue;
+        float x0 = s->start_ms * px_per_ms;
+        float w  = s->total_ms * px_per_ms;
+        if (x0 >= (float)inner_w) continue;
+        if (x0 + w > (float)inner_w) w = (float)inner_w - x0;
+        if (w < 1.0f) w = 1.0f;
+        DrawRectangle(inner_x + (int)x0, cy + s->depth * PROF_ROW_H, (int)w, PROF_ROW_H - 1,
+                      kZoneColors[z]);
+    }
+    /* 60 Hz budget marker */
+    int budget_x = inner_x + (int)(16.7f * px_per_ms);
+    DrawLine(budget_x, cy - 2, budget_x, cy + PROF_ROWS * PROF_ROW_H + 2, g_dev_ui.error_text_color);
+    cy += PROF_ROWS * PROF_ROW_H + 6;
+
+    DrawText("zone              last    p50    p95    p99", inner_x, cy, PROF_FONT,
+             g_dev_ui.debug_text_color);
+    cy += PROF_LINE_H;
+    for (int z = 0; z < PROF_ZONE_COUNT; z++) {
+        ProfilerZoneStats st = profiler_zone_stats((ProfilerZone)z);
+        DrawRectangle(inner_x, cy + 2, 6, 6, kZoneColors[z]);
+        snprintf(line, sizeof(line), "%-16s %6.2f %6.2f %6.2f %6.2f", profiler_zone_name((ProfilerZone)z),
+                 st.last_ms, st.p50_ms, st.p95_ms, st.p99_ms);
+        DrawText(line, inner_x + 10, cy, PROF_FONT, g_dev_ui.text_color);
+        cy += PROF_LINE_H;
+    }
+    cy += 6;
+
+    /* Histogram: one column per bucket, scaled to the fullest; buckets past
+     * the 60 Hz budget in the error colour. */
+    uint32_t total = 0;
+    const uint32_t* hist = profiler_histogram(&total);
+    uint32_t peak = 1;
+    for (int b = 0; b < PROFILER_BUCKET_COUNT; b++) {
+        if (hist[b] > peak) peak = hist[b];
+    }
+    int col_w = inner_w / PROFILER_BUCKET_COUNT;
+    DrawRectangle(inner_x, cy, inner_w, PROF_HIST_H, (Color){ 0, 0, 0, 120 });
+    for (int b = 0; b < PROFILER_BUCKET_COUNT; b++) {
+        int h = (int)((float)PROF_HIST_H * (float)hist[b] / (float)peak);
+        if (hist[b] > 0 && h < 1) h = 1;
+        float edge = profiler_bucket_edge_ms(b);
+        bool over = 0.0f == edge || edge > 16.7f;
+        DrawRectangle(inner_x + b * col_w + 1, cy + PROF_HIST_H - h, col_w - 2, h,
+                      over ? g_dev_ui.error_text_color : g_dev_ui.debug_text_color);
+    }
+    cy += PROF_HIST_H + 2;
+    snprintf(line, sizeof(line), "0-4 ... >250 ms   %u frames", (unsigned)total);
+    DrawText(line, inner_x, cy, PROF_FONT, g_dev_ui.debug_text_color);
+    cy += PROF_LINE_H;
+
+    int n_long = profiler_long_frame_count();
+    snprintf(line, sizeof(line), "long frames (>= %.0f ms): %u", profiler_long_frame_ms(),
+             (unsigned)profiler_long_frames_total());
+    DrawText(line, inner_x, cy, PROF_FONT, g_dev_ui.text_color);
+    cy += PROF_LINE_H;
+    if (n_long > 0) {
+        const ProfilerLongFrame* lf = profiler_long_frame(n_long - 1);
+        int worst = 0;
+        for (int z = 1; z < PROF_ZONE_COUNT; z++) {
+            if (lf->zone_ms[z] > lf->zone_ms[worst]) worst = z;
+        }
+        snprintf(line, sizeof(line), "#%u %.1f ms: %s %.1f, aoi %d, fetch %d, decode %d",
+                 (unsigned)lf->frame, lf->frame_ms, profiler_zone_name((ProfilerZone)worst),
+                 lf->zone_ms[worst], lf->counts[PROF_COUNT_AOI_FRAMES],
+                 lf->counts[PROF_COUNT_FETCHES], lf->counts[PROF_COUNT_IMAGE_DECODES]);
+        DrawText(line, inner_x, cy, PROF_FONT, g_dev_ui.error_text_color);
+    }
+}
+#endif /* CYBERIA_PROFILE */
+
+/* Per-message-kind downlink table (kinds seen so far), drawn to the left of
+ * the stats panel with its bottom edge on `bottom_y`. */
+#define NET_PANEL_W      300
+#define NET_LINE_H       13
+#define NET_FONT         10
+#define NET_MAX_ROWS     (NET_TELEMETRY_BIN_KINDS + NET_TELEMETRY_JSON_KINDS)
+
+typedef struct {
+    bool               is_text;
+    int                kind;
+    const NetMsgStats* s;
+} NetPanelRow;
+
+static void draw_net_telemetry_panel(int right_x, int bottom_y) {
+    NetPanelRow rows[NET_MAX_ROWS];
+    int n = 0;
+    for (int k = 0; k < NET_TELEMETRY_BIN_KINDS; k++) {
+        const NetMsgStats* s = net_telemetry_binary(k);
+        if (s->count > 0) rows[n++] = (NetPanelRow){ .is_text = false, .kind = k, .s = s };
+    }
+    for (int k = 0; k < NET_TELEMETRY_JSON_KINDS; k++) {
+        const NetMsgStats* s = net_telemetry_json(k);
+        if (s->count > 0) rows[n++] = (NetPanelRow){ .is_text = true, .kind = k, .s = s };
+    }
+    if (0 == n) return;
+
+    int height = 8 + (n + 1) * NET_LINE_H;
+    int x = right_x - NET_PANEL_W - 4;
+    int y = bottom_y - height;
+    if (x < 0) x = 0;
+    if (y < 0) y = 0;
+    DrawRectangle(x, y, NET_PANEL_W, height, g_dev_ui.background_color);
+
+    int cy = y + 4;
+    DrawText("msg               count      KB  us/msg    max", x + 8, cy, NET_FONT,
+             g_dev_ui.debug_text_color);
+    cy += NET_LINE_H;
+    char line[128];
+    for (int i = 0; i < n; i++) {
+        const NetMsgStats* s = rows[i].s;
+        snprintf(line, sizeof(line), "%s%-14s %7u %7.0f %7.0f %6.0f", rows[i].is_text ? "j:" : "b:",
+                 net_telemetry_kind_name(rows[i].is_text, rows[i].kind), (unsigned)s->count,
+                 (double)s->bytes / 1024.0, s->decode_us / (double)s->count, s->max_decode_us);
+        DrawText(line, x + 8, cy, NET_FONT, g_dev_ui.text_color);
+        cy += NET_LINE_H;
+    }
+}
+
+/* A line that changes only with one int, formatted when it does. */
+static const char* memo_int(TextMemo* memo, const char* fmt, int value) {
+    if (text_memo_changed(memo, value)) snprintf(memo->text, sizeof(memo->text), fmt, value);
+    return memo->text;
+}
+
 void dev_ui_draw(int screen_width, int screen_height, int hud_occupied) {
     if (!presentation_runtime_dev_ui()) {
         return;
     }
+    if (!g_dev_ui.ready) dev_ui_init();
 
     // Calculate dev UI height based on HUD occupation
     int dev_ui_height = g_dev_ui.dev_ui_height;
@@ -197,9 +388,9 @@ void dev_ui_draw(int screen_width, int screen_height, int hud_occupied) {
     int line_spacing = 20;
 
     // Draw FPS at the top (replacing "DEV UI" label from Python version)
-    char fps_text[32];
-    snprintf(fps_text, sizeof(fps_text), "%d FPS", g_dev_ui.last_fps);
-    DrawText(fps_text, x_margin, y_offset, font_size_title, g_dev_ui.debug_text_color);
+    static TextMemo s_fps_text;
+    DrawText(memo_int(&s_fps_text, "%d FPS", g_dev_ui.last_fps),
+             x_margin, y_offset, font_size_title, g_dev_ui.debug_text_color);
     y_offset += font_size_title + 10;
 
     // Get player information
@@ -208,7 +399,7 @@ void dev_ui_draw(int screen_width, int screen_height, int hud_occupied) {
     const char* mode_str = mode_to_string(g_game_state.player.base.mode);
     const char* dir_str = direction_to_string(g_game_state.player.base.direction);
     Vector2 player_pos = g_game_state.player.base.interp_pos;
-    Vector2 target_pos = g_game_state.player.target_pos;
+    Vector2 target_pos = local_player_debug_path()->target;
     int sum_stats_limit = g_game_state.sum_stats_limit;
     const char* error_msg = game_render_get_error_message();
 
@@ -217,19 +408,91 @@ void dev_ui_draw(int screen_width, int screen_height, int hud_occupied) {
     int active_item_count = dev_ui_get_active_item_count(player_id);
 
     // Prepare text lines
-    char text_lines[9][128];
+    const char* text_lines[24];
     int line_count = 0;
 
-    snprintf(text_lines[line_count++], 128, "Player ID: %s", player_id);
-    snprintf(text_lines[line_count++], 128, "Map: %s", map_code);
-    snprintf(text_lines[line_count++], 128, "Mode: %s | Direction: %s", mode_str, dir_str);
-    snprintf(text_lines[line_count++], 128, "Pos: (%.2f, %.2f)", player_pos.x, player_pos.y);
-    snprintf(text_lines[line_count++], 128, "Target: (%.0f, %.0f)", target_pos.x, target_pos.y);
-    snprintf(text_lines[line_count++], 128, "Download: %.2f kbps | Upload: %.2f kbps",
+    text_lines[line_count++] = frame_printf("Player ID: %s", player_id);
+    text_lines[line_count++] = frame_printf("Map: %s", map_code);
+    text_lines[line_count++] = frame_printf("Mode: %s | Direction: %s", mode_str, dir_str);
+    text_lines[line_count++] = frame_printf("Pos: (%.2f, %.2f)", player_pos.x, player_pos.y);
+    text_lines[line_count++] = frame_printf("Target: (%.0f, %.0f)", target_pos.x, target_pos.y);
+    text_lines[line_count++] = frame_printf("Download: %.2f kbps | Upload: %.2f kbps",
              g_dev_ui.download_kbps, g_dev_ui.upload_kbps);
-    snprintf(text_lines[line_count++], 128, "SumStatsLimit: %d", sum_stats_limit);
-    snprintf(text_lines[line_count++], 128, "ActiveStatsSum: %d", active_stats_sum);
-    snprintf(text_lines[line_count++], 128, "ActiveItems: %d", active_item_count);
+    double clock_rtt = session_clock_rtt_ms();
+    text_lines[line_count++] = 0.0 <= clock_rtt
+        ? frame_printf("Interp: %d ms | Jitter: %.1f ms | Clock: synced, %.0f ms RTT",
+                       session_interp_window_ms(), session_snapshot_jitter_ms(), clock_rtt)
+        : frame_printf("Interp: %d ms | Jitter: %.1f ms | Clock: snapshot arrival",
+                       session_interp_window_ms(), session_snapshot_jitter_ms());
+    const NetSnapshotStats* snap = net_telemetry_snapshots();
+    text_lines[line_count++] = frame_printf("Snapshots: %.0f ms avg, %.0f max | P %d B %d W %d",
+             snap->mean_gap_ms, snap->max_gap_ms, snap->players, snap->bots, snap->world_objects);
+    const NetUplinkStats* up = net_telemetry_uplink();
+    text_lines[line_count++] = frame_printf(
+             "Input ack: %.0f ms avg, %.0f max | %u in flight | uplink q %d, %u B buffered",
+             snap->mean_ack_ms, snap->max_ack_ms, (unsigned)snap->inputs_in_flight, up->depth,
+             (unsigned)up->buffered_bytes);
+    InputLatencyStats lat = input_latency_stats();
+    text_lines[line_count++] = frame_printf(
+             "Tap latency%s: visible %.0f / %.0f ms (p50/p95, %d taps) | sent %.0f / %.0f | predicted %.0f / %.0f",
+             runtime_config_low_latency() ? " [low]" : "",
+             lat.p50_ms[INPUT_LAT_VISIBLE], lat.p95_ms[INPUT_LAT_VISIBLE], lat.samples,
+             lat.p50_ms[INPUT_LAT_SENT], lat.p95_ms[INPUT_LAT_SENT],
+             lat.p50_ms[INPUT_LAT_PREDICTED], lat.p95_ms[INPUT_LAT_PREDICTED]);
+    GameRenderCullStats cull = game_render_cull_stats();
+    text_lines[line_count++] = frame_printf("Objects: %d drawn | %d culled | fidelity x%.2f | %d stacks",
+             cull.drawn, cull.culled, fidelity_scale(), layer_stack_count());
+    RenderQueueStats rq = render_queue_stats();
+    text_lines[line_count++] = frame_printf(
+             "Draw calls: %d queued (%d unsorted) | %d quads (%d instanced): floor %d obj %d ent %d fg %d",
+             rq.draw_calls, rq.unsorted_draw_calls, rq.quads, rq.instanced_quads,
+             rq.layer_quads[RENDER_LAYER_FLOOR], rq.layer_quads[RENDER_LAYER_WORLD_OBJECT],
+             rq.layer_quads[RENDER_LAYER_ENTITY], rq.layer_quads[RENDER_LAYER_FOREGROUND]);
+    static const char* const PASS_LABELS[] = { "World", "UI" };
+    for (int p = RENDER_PASS_WORLD; p <= RENDER_PASS_UI; p++) {
+        RenderPassStats rs = render_stats_pass(p);
+        text_lines[line_count++] = frame_printf(
+                 "%s: %.0f draws %.0f binds %.0f verts %.0f flush | tex %.0f rect %.0f text %.0f shape %.0f",
+                 PASS_LABELS[p], rs.gpu[RENDER_GPU_DRAW_CALLS], rs.gpu[RENDER_GPU_TEXTURE_SWITCHES],
+                 rs.gpu[RENDER_GPU_VERTICES], rs.gpu[RENDER_GPU_FLUSHES],
+                 rs.calls[RENDER_CALL_TEXTURE], rs.calls[RENDER_CALL_RECT],
+                 rs.calls[RENDER_CALL_TEXT], rs.calls[RENDER_CALL_SHAPE]);
+    }
+    FetchClassStats fv = fetch_class_stats(FETCH_CLASS_VISIBLE);
+    FetchClassStats fu = fetch_class_stats(FETCH_CLASS_UI);
+    FetchClassStats fp = fetch_class_stats(FETCH_CLASS_PREFETCH);
+    FetchClassStats fo = fetch_class_stats(FETCH_CLASS_POLL);
+    text_lines[line_count++] = frame_printf(
+             "Fetch q/f: vis %d/%d ui %d/%d pre %d/%d poll %d/%d | %d cancelled %d retried %d 304 %d shared",
+             fv.queued, fv.in_flight, fu.queued, fu.in_flight, fp.queued, fp.in_flight,
+             fo.queued, fo.in_flight, fv.cancelled + fu.cancelled + fp.cancelled + fo.cancelled,
+             fv.retried + fu.retried + fp.retried + fo.retried,
+             fv.revalidated + fu.revalidated + fp.revalidated + fo.revalidated,
+             fv.deduplicated + fu.deduplicated + fp.deduplicated + fo.deduplicated);
+    int res[TEX_RES_COUNT];
+    obj_layers_mgr_atlas_residency(res);
+    text_lines[line_count++] = frame_printf(
+             "Textures: %zu / %zu MB (atlas %zu + pages %zu) | atlas pin %d hot %d warm %d cold %d",
+             gpu_memory_used() >> 20, gpu_memory_budget() >> 20,
+             gpu_memory_pool_bytes(GPU_MEM_ATLAS_CACHE) >> 20,
+             gpu_memory_pool_bytes(GPU_MEM_ATLAS_PAGES) >> 20,
+             res[TEX_RES_PINNED], res[TEX_RES_HOT], res[TEX_RES_WARM], res[TEX_RES_COLD]);
+    FrameArenaStats fa = frame_arena_stats();
+    text_lines[line_count++] = frame_printf("Heap: %zu KB live, %zu KB peak | %u allocs/frame | "
+             "frame %zu / %zu KB peak",
+             heap_memory_live_total() >> 10, heap_memory_peak_total() >> 10,
+             (unsigned)heap_memory_frame_allocs(), fa.used >> 10, fa.peak >> 10);
+    text_lines[line_count++] = frame_printf("  hash %zu tex %zu fetch %zu anim %zu json %zu text %zu KB",
+             heap_memory_stats(HEAP_MEM_HASH_TABLE).live_bytes >> 10,
+             heap_memory_stats(HEAP_MEM_TEXTURE_CACHE).live_bytes >> 10,
+             heap_memory_stats(HEAP_MEM_FETCH).live_bytes >> 10,
+             heap_memory_stats(HEAP_MEM_ANIM_POOL).live_bytes >> 10,
+             heap_memory_stats(HEAP_MEM_JSON).live_bytes >> 10,
+             heap_memory_stats(HEAP_MEM_TEXT_LAYOUT).live_bytes >> 10);
+    static TextMemo s_stat_text[3];
+    text_lines[line_count++] = memo_int(&s_stat_text[0], "SumStatsLimit: %d", sum_stats_limit);
+    text_lines[line_count++] = memo_int(&s_stat_text[1], "ActiveStatsSum: %d", active_stats_sum);
+    text_lines[line_count++] = memo_int(&s_stat_text[2], "ActiveItems: %d", active_item_count);
 
     // Draw all text lines
     for (int i = 0; i < line_count; i++) {
@@ -237,6 +500,11 @@ void dev_ui_draw(int screen_width, int screen_height, int hud_occupied) {
         y_offset += line_spacing;
     }
 
+    draw_net_telemetry_panel(panel_x, panel_y + dev_ui_height);
+#if CYBERIA_PROFILE
+    draw_profiler_overlay(panel_x, panel_y - 4, g_dev_ui.dev_ui_width);
+#endif
+
     // Draw error message at the bottom of the panel if present
     if (g_dev_ui.show_error_section && error_msg[0] != '\0') {
         int error_y = panel_y + dev_ui_height - 30;
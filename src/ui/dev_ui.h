@@ -46,7 +46,8 @@ typedef struct {
     bool show_player_stats;
     bool show_game_stats;
     bool show_error_section;
-    
+
+    bool ready;   /* dev_ui_init() ran; the first tick or draw runs it */
 } DevUI;
 
 // Global dev UI instance
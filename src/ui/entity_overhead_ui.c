@@ -14,17 +14,21 @@
  * The three pill rows (HP bar, nameplate, capability bar) share one background,
  * height, padding, and rounding, and are sized in fixed screen pixels so they
  * are uniform for every entity regardless of its world size. Only the vertical
- * anchor above the entity tracks world space. Stateless — call per entity per
- * frame inside BeginMode2D.
+ * anchor above the entity tracks world space. Reads no state beyond its
+ * inputs; the text labels are drawn from the ui/overhead_labels atlas once
+ * baked. Call per entity per frame inside BeginMode2D.
  */
 
 #include "entity_overhead_ui.h"
 #include "text.h"
 
 #include "domain/presentation_runtime.h"
+#include "ui/overhead_labels.h"
 #include "ui_icon.h"
 #include "world_types.h"
+#include "render_stats.h"
 
+#include <assert.h>
 #include <raylib.h>
 #include <stdio.h>
 
@@ -86,38 +90,68 @@ static Rectangle draw_pill(float cx, float top_y, float content_w, float height)
     return (Rectangle){ cx - content_w * 0.5f, top_y, content_w, height };
 }
 
-/* Centre `label` (with shadow) vertically inside a row of height `row_h` whose
+/* ── Labels ──────────────────────────────────────────────────────────── */
+
+/* Text labels of the entity being drawn. They are emitted after its pills
+ * and icons, which they never overlap, so the baked ones (ui/overhead_labels)
+ * share one premultiplied blend block per entity. */
+#define EOHUD_MAX_LABELS 4
+
+typedef struct {
+    char  text[OVERHEAD_LABEL_TEXT_LEN];
+    int   size;
+    Color fg;
+    Color edge;
+    int   rings;
+    int   x;
+    int   y;
+} QueuedLabel;
+
+static QueuedLabel s_labels[EOHUD_MAX_LABELS];
+static int         s_label_count;
+
+/* Queue `text` at (x, y) top-left: drop-shadowed in `edge` when rings is 0,
+ * else wrapped in a gapless `rings`-deep outline (Σ-stats value, death
+ * countdown) so it stays legible over any background. */
+static void queue_label(const char *text, int x, int y, int fs, Color fg, Color edge, int rings) {
+    assert(EOHUD_MAX_LABELS > s_label_count);
+    QueuedLabel *q = &s_labels[s_label_count++];
+    snprintf(q->text, sizeof(q->text), "%s", text);
+    q->size  = fs;
+    q->fg    = fg;
+    q->edge  = edge;
+    q->rings = rings;
+    q->x     = x;
+    q->y     = y;
+}
+
+/* Centre `label`, `tw` wide, vertically inside a row of height `row_h` whose
  * top is top_y. */
-static void draw_centered_label(const char *label, float cx, float top_y, int fs,
-                                Color fg, Color shadow, float row_h) {
-    int tw = MeasureText(label, fs);
+static void queue_centered_label(const char *label, int tw, float cx, float top_y, int fs,
+                                 Color fg, Color edge, int rings, float row_h) {
     int tx = (int)(cx - tw * 0.5f);
     int ty = (int)(top_y + (row_h - fs) * 0.5f);
-    DrawText(label, tx + 1, ty + 1, fs, shadow);
-    DrawText(label, tx, ty, fs, fg);
-}
-
-/* Gapless text outline: `rings` concentric 8-direction passes of `outline`
- * behind `fg`, at (x, y) top-left. Used where a label must stay legible over
- * any background (Σ-stats value, death countdown). */
-static void draw_outlined_text(const char *text, int x, int y, int fs,
-                               Color fg, Color outline, int rings) {
-    for (int o = 1; o <= rings; o++)
-        for (int dy = -1; dy <= 1; dy++)
-            for (int dx = -1; dx <= 1; dx++)
-                if (dx || dy)
-                    DrawText(text, x + dx * o, y + dy * o, fs, outline);
-    DrawText(text, x, y, fs, fg);
+    queue_label(label, tx, ty, fs, fg, edge, rings);
 }
 
-/* Centre `label` with a gapless outline (see draw_outlined_text) vertically
- * inside a row of height `row_h` whose top is top_y. */
-static void draw_centered_outlined_label(const char *label, float cx, float top_y, int fs,
-                                         Color fg, Color outline, int rings, float row_h) {
-    int tw = MeasureText(label, fs);
-    int tx = (int)(cx - tw * 0.5f);
-    int ty = (int)(top_y + (row_h - fs) * 0.5f);
-    draw_outlined_text(label, tx, ty, fs, fg, outline, rings);
+static void flush_labels(void) {
+    int cells[EOHUD_MAX_LABELS];
+    bool baked = false;
+    for (int i = 0; i < s_label_count; i++) {
+        const QueuedLabel *q = &s_labels[i];
+        OverheadLabel l = { .text = q->text, .size = q->size, .fg = q->fg, .edge = q->edge, .rings = q->rings };
+        cells[i] = overhead_labels_find(&l);
+        if (0 > cells[i]) overhead_labels_draw_live(&l, q->x, q->y);
+        else baked = true;
+    }
+    if (baked) {
+        BeginBlendMode(BLEND_ALPHA_PREMULTIPLY);
+        for (int i = 0; i < s_label_count; i++) {
+            if (0 <= cells[i]) overhead_labels_blit(cells[i], s_labels[i].x, s_labels[i].y);
+        }
+        EndBlendMode();
+    }
+    s_label_count = 0;
 }
 
 /* ── Rows ────────────────────────────────────────────────────────────── */
@@ -143,16 +177,16 @@ static void draw_hp_bar(float cx, float top_y, float life, float max_life) {
     DrawRectangleRoundedLinesEx(bar, EOHUD_PILL_ROUND, 8, 1.0f, C_HP_BORDER);
 
     int ilif = (int)(life + 0.5f), imaxl = (int)(max_life + 0.5f);
-    char label[32];
-    snprintf(label, sizeof(label), "HP %d / %d", ilif, imaxl);
-    draw_centered_label(label, cx, top_y, EOHUD_HP_LABEL_FONT_SIZE, C_LABEL, C_LABEL_SHADOW, (float)EOHUD_BAR_H);
+    TextValue label = text_value_ints("HP %d / %d", ilif, imaxl, EOHUD_HP_LABEL_FONT_SIZE);
+    queue_centered_label(label.text, label.width, cx, top_y, EOHUD_HP_LABEL_FONT_SIZE,
+                         C_LABEL, C_LABEL_SHADOW, 0, (float)EOHUD_BAR_H);
 }
 
-static void draw_nameplate(const char *name, float cx, float top_y) {
+static void draw_nameplate(const char *name, int tw, float cx, float top_y) {
     if (!name || name[0] == '\0') return;
-    int tw = MeasureText(name, EOHUD_NAME_FONT_SIZE);
+    if (0 >= tw) tw = MeasureText(name, EOHUD_NAME_FONT_SIZE);
     draw_pill(cx, top_y, (float)tw, (float)EOHUD_BAR_H);
-    draw_centered_label(name, cx, top_y, EOHUD_NAME_FONT_SIZE, C_NAME_TEXT, C_NAME_SHADOW, (float)EOHUD_BAR_H);
+    queue_centered_label(name, tw, cx, top_y, EOHUD_NAME_FONT_SIZE, C_NAME_TEXT, C_NAME_SHADOW, 0, (float)EOHUD_BAR_H);
 }
 
 /** Capability bar: an optional leading 'stats' icon + outlined sum-of-stats value
@@ -169,12 +203,9 @@ static void draw_capability_bar(float cx, float top_y, int stats_sum,
         icons[icon_n++] = presentation_runtime_status_icon(STATUS_ICON_QUEST_PROVIDER);
 
     int fs = EOHUD_STATS_FONT_SIZE;
-    char num[16];
-    int tw = 0;
-    if (show_value) {
-        snprintf(num, sizeof(num), "%d", stats_sum);
-        tw = MeasureText(num, fs);
-    }
+    TextValue num = { .width = 0 };
+    if (show_value) num = text_value_ints("%d", stats_sum, 0, fs);
+    int tw = num.width;
 
     /* Total width: optional Σ-stats lead (icon + value) plus one icon per
      * capability flag, each element separated by EOHUD_ITEM_GAP. */
@@ -202,7 +233,7 @@ static void draw_capability_bar(float cx, float top_y, int stats_sum,
 
         int nx = (int)x;
         int ny = (int)(row_cy - fs * 0.5f);
-        draw_outlined_text(num, nx, ny, fs, C_LABEL, C_STAT_SHADOW, EOHUD_STAT_OUTLINE_RINGS);
+        queue_label(num.text, nx, ny, fs, C_LABEL, C_STAT_SHADOW, EOHUD_STAT_OUTLINE_RINGS);
         x += (float)tw;
         drew = true;
     }
@@ -248,7 +279,7 @@ void entity_overhead_ui_draw(
 
     if (p->show_name) {
         cursor_px -= EOHUD_BAR_H;
-        draw_nameplate(p->name, entity_cx_px, cursor_px);
+        draw_nameplate(p->name, p->name_width, entity_cx_px, cursor_px);
         cursor_px -= EOHUD_ROW_GAP;
     }
 
@@ -264,13 +295,11 @@ void entity_overhead_ui_draw(
      * shared-size white rows above. */
     if (p->respawn_seconds > 0) {
         cursor_px -= EOHUD_RESPAWN_BAR_H;
-        char rbuf[16];
-        snprintf(rbuf, sizeof(rbuf), "%ds", p->respawn_seconds);
-        int tw = MeasureText(rbuf, EOHUD_RESPAWN_FONT_SIZE);
-        draw_pill(entity_cx_px, cursor_px, (float)tw, (float)EOHUD_RESPAWN_BAR_H);
-        draw_centered_outlined_label(rbuf, entity_cx_px, cursor_px, EOHUD_RESPAWN_FONT_SIZE,
-                                     C_RESPAWN_TEXT, C_RESPAWN_OUTLINE, EOHUD_RESPAWN_OUTLINE_RINGS,
-                                     (float)EOHUD_RESPAWN_BAR_H);
+        TextValue rbuf = text_value_ints("%ds", p->respawn_seconds, 0, EOHUD_RESPAWN_FONT_SIZE);
+        draw_pill(entity_cx_px, cursor_px, (float)rbuf.width, (float)EOHUD_RESPAWN_BAR_H);
+        queue_centered_label(rbuf.text, rbuf.width, entity_cx_px, cursor_px, EOHUD_RESPAWN_FONT_SIZE,
+                             C_RESPAWN_TEXT, C_RESPAWN_OUTLINE, EOHUD_RESPAWN_OUTLINE_RINGS,
+                             (float)EOHUD_RESPAWN_BAR_H);
         cursor_px -= EOHUD_ROW_GAP;
     }
 
@@ -284,4 +313,6 @@ void entity_overhead_ui_draw(
                          EOHUD_PRESENCE_SIZE, true, phase);
         }
     }
+
+    flush_labels();
 }
@@ -69,13 +69,18 @@
  * @struct EntityOverheadParams
  * @brief All inputs needed to render the overhead UI for one entity.
  *
- * Fill this struct each frame from entity state; the module is stateless and
- * performs no caching — the caller owns the data lifetime.
+ * Fill this struct each frame from entity state; nothing in it is kept past
+ * the call — the caller owns the data lifetime. Text labels are cached by
+ * value in ui/overhead_labels.
  */
 typedef struct {
     /** Display label (e.g. entity ID or human-readable nickname). */
     const char *name;
 
+    /** Width of `name` at EOHUD_NAME_FONT_SIZE when the caller already has
+     *  it (text_value_*); 0 measures it here. */
+    int name_width;
+
     /** Sum of the entity's active stats (capped at sum_stats_limit); shown in
      *  the capability bar's leading circle. */
     int stats_sum;
@@ -122,8 +127,9 @@ typedef struct {
  * @brief Draw the overhead UI stack above a single entity.
  *
  * Must be called inside a BeginMode2D / EndMode2D block.
- * The function is stateless — safe to call in any order, for any number of
- * entities per frame.
+ * Safe to call in any order, for any number of entities per frame. Text
+ * labels missing from the ui/overhead_labels atlas draw live and bake in the
+ * next overhead_labels_prepare().
  *
  * @param p          Filled EntityOverheadParams (all inputs).
  * @param world_x    Entity left edge in world (grid) coordinates.
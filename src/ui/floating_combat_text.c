@@ -17,10 +17,20 @@
  *   Phase 3 — Fade  [FCT_FADE_START, FCT_TOTAL_LIFETIME):
  *       Velocity decelerates (×(1−dt×5) each frame); alpha decays to 0.
  *
- * Rendering — 6 DrawText calls per active entry:
- *   1. Black drop-shadow at (+1, +2).
- *   2–5. Black outline at the 4 cardinal offsets (±1 px).
- *   6. Main colored text.
+ * Aggregation: a hit landing within FCT_MERGE_RADIUS of a number of the
+ * same type (and item) spawned less than FCT_MERGE_WINDOW ago is added to
+ * that number, which re-pops in place instead of stacking a new entry.
+ * With the pool full, the least important entry is recycled: anything on
+ * the local player outranks other damage, then regen, then economy; ties
+ * go to the oldest.
+ *
+ * Rendering — numbers come from a digit strip ("0-9+-") baked per size
+ * tier into one render texture by fct_prepare(): an edge cell (black
+ * drop-shadow at (+1, +2) plus the 4 cardinal ±1 px outline) and a white
+ * fill cell per glyph, premultiplied. Each glyph is then two textured
+ * quads from one texture, drawn in a single premultiplied batch. Item
+ * labels ("+45 wood") fall back to 6 DrawText calls: shadow, 4 outline
+ * offsets, main colored text.
  *
  * Screen overlay (fct_draw_overlay(), called in screen space after EndMode2D):
  *   Damage → brief red   vignette (max alpha 0.28, decays in ~0.45 s).
@@ -42,11 +52,16 @@
 
 #include "domain/local_player.h"
 #include "game_state.h"
+#include "gpu_memory.h"
+#include "object_layer.h"
 #include "world_types.h"
+#include "render_stats.h"
+#include "util/pool.h"
 
 #include <assert.h>
 #include <math.h>
 #include <raylib.h>
+#include <rlgl.h>
 #include <stdio.h>
 #include <string.h>
 
@@ -82,6 +97,24 @@
 #define FCT_LOG_DIV_REGEN    7.0f   /* log2(128) ≈ 7  → regen 129 = full   */
 #define FCT_LOG_DIV_COIN     6.0f   /* log2(64)  ≈ 6  → coins  65 = full   */
 
+/* ── Aggregation ───────────────────────────────────────────────────────── */
+
+#define FCT_MERGE_WINDOW     0.45f  /* seconds after first spawn a number still absorbs hits */
+#define FCT_MERGE_RADIUS     0.75f  /* world units between spawn anchors          */
+
+/* ── Digit strip ───────────────────────────────────────────────────────── */
+
+#define FCT_STRIP_GLYPHS     "0123456789+-"
+#define FCT_STRIP_GLYPH_COUNT 12
+#define FCT_STRIP_TIER_COUNT 5
+#define FCT_STRIP_W          1024
+#define FCT_STRIP_H          512
+#define FCT_STRIP_PAD        3      /* px around each glyph: outline + shadow  */
+
+/* Baked font sizes; a number draws from the smallest tier at least its size,
+ * so glyphs are only ever scaled down (largest pop: 44 px × 1.70). */
+static const int s_strip_sizes[FCT_STRIP_TIER_COUNT] = { 16, 24, 32, 48, 80 };
+
 /* ── Screen-overlay vignette ───────────────────────────────────────────── */
 
 #define FCT_OVERLAY_DMG_ALPHA  0.28f  /* peak red-flash alpha               */
@@ -103,19 +136,54 @@ static const Color s_color_fallback  = {190, 190, 190, 255};  /* grey         */
 
 typedef struct {
     float   x, y;                    /* current world position (moves each frame)    */
+    float   sx, sy;                  /* spawn anchor, matched by later hits          */
     float   vx, vy;                  /* velocity in world units / second             */
-    float   age;                     /* seconds elapsed since spawn                  */
+    float   age;                     /* seconds since spawn or the last merged hit   */
+    float   span;                    /* seconds since the first hit                  */
+    uint32_t value;                  /* accumulated magnitude                        */
     int     font_px;                 /* base font size in pixels (fixed at spawn)    */
     float   pop_overshoot;           /* peak scale during pop-in (type + value)      */
-    char    text[32];                /* formatted string: "+42 wood", "-1337", etc.  */
+    TextMemo label;                  /* "+42 wood", "-1337", etc.; keyed by value    */
+    char    item_id[MAX_ITEM_ID_LENGTH]; /* empty for numeric entries                */
     Color   base_color;              /* colour before alpha is applied               */
     uint8_t type;                    /* FCT_TYPE_* — for draw-time differentiation   */
-    bool    active;
+    bool    on_self;                 /* landed on the local player                   */
 } FCTEntry;
 
-static FCTEntry s_pool[FCT_MAX_ENTRIES];
+/* Per-type motion, sizing and colour. */
+typedef struct {
+    float rise_speed;
+    float drift_max;
+    float log_div;
+    int   font_max;
+    Color base_color;
+    float base_overshoot;
+} FCTTuning;
+
+/* One baked size of the digit strip. */
+typedef struct {
+    bool      usable;                       /* every cell fit the texture        */
+    int       size;
+    float     gap;                          /* spacing between glyphs            */
+    float     adv[FCT_STRIP_GLYPH_COUNT];   /* glyph advances                    */
+    Rectangle edge[FCT_STRIP_GLYPH_COUNT];  /* shadow + outline cells            */
+    Rectangle fill[FCT_STRIP_GLYPH_COUNT];  /* white glyph cells                 */
+} FCTStripTier;
+
+POOL_DEFINE(fct_pool, FCTEntry, FCT_MAX_ENTRIES)
+
+static fct_pool s_pool;
 static bool     s_init = false;
 
+static struct {
+    bool            loaded;
+    bool            baked;
+    uint32_t        font_gen;   /* text_font_generation() at the bake */
+    float           factor;     /* text_font_factor() at the bake     */
+    RenderTexture2D rt;
+    FCTStripTier    tiers[FCT_STRIP_TIER_COUNT];
+} s_strip;
+
 /* Screen-overlay alphas: updated by fct_spawn/fct_update, read by fct_draw_overlay. */
 static float s_damage_overlay = 0.0f;
 static float s_regen_overlay  = 0.0f;
@@ -137,163 +205,179 @@ static bool fct_event_on_self(float wx, float wy) {
         && wy >= self->interp_pos.y && wy <= self->interp_pos.y + self->dims.y;
 }
 
-/* ── Public API ─────────────────────────────────────────────────────────── */
-
-void fct_init(void) {
-    memset(s_pool, 0, sizeof(s_pool));
-    s_damage_overlay = 0.0f;
-    s_regen_overlay  = 0.0f;
-    s_init = true;
-}
-
-void fct_spawn(float world_x, float world_y, uint32_t value, uint8_t type) {
-    if (!s_init) fct_init();
-
-    /* Find a free slot; evict the oldest active entry if the pool is full. */
-    FCTEntry *slot      = NULL;
-    float     oldest   = -1.0f;
-    int       oldest_i = 0;
-    for (int i = 0; i < FCT_MAX_ENTRIES; i++) {
-        if (!s_pool[i].active) { slot = &s_pool[i]; break; }
-        if (s_pool[i].age > oldest) { oldest = s_pool[i].age; oldest_i = i; }
-    }
-    if (!slot) slot = &s_pool[oldest_i];
-
-    /* ── Format text ─────────────────────────────────────────────────── */
-    if (type == FCT_TYPE_REGEN || type == FCT_TYPE_COIN_GAIN)
-        snprintf(slot->text, sizeof(slot->text), "+%u", value);
-    else
-        snprintf(slot->text, sizeof(slot->text), "-%u", value);
-
-    /* ── Per-type tuning ──────────────────────────────────────────────── */
-    float rise_speed, drift_max, log_div, base_overshoot;
-    int   font_max;
-    Color base_color;
-
+static FCTTuning fct_tuning(uint8_t type) {
+    FCTTuning economy = {
+        .rise_speed     = FCT_RISE_COIN,
+        .drift_max      = FCT_DRIFT_COIN,
+        .log_div        = FCT_LOG_DIV_COIN,
+        .font_max       = FCT_FONT_MAX_COIN,
+        .base_color     = s_color_fallback,
+        .base_overshoot = 1.20f,
+    };
     switch (type) {
-        /* Damage/regen are broadcast to every AOI viewer; the screen vignette
-         * is personal — only when the event lands on the local player. */
         case FCT_TYPE_DAMAGE:
-            rise_speed     = FCT_RISE_DAMAGE;
-            drift_max      = FCT_DRIFT_DAMAGE;
-            log_div        = FCT_LOG_DIV_DAMAGE;
-            font_max       = FCT_FONT_MAX_DAMAGE;
-            base_color     = s_color_damage;
-            base_overshoot = 1.45f;
-            if (fct_event_on_self(world_x, world_y))
-                s_damage_overlay = FCT_OVERLAY_DMG_ALPHA;
-            break;
+            return (FCTTuning){
+                .rise_speed     = FCT_RISE_DAMAGE,
+                .drift_max      = FCT_DRIFT_DAMAGE,
+                .log_div        = FCT_LOG_DIV_DAMAGE,
+                .font_max       = FCT_FONT_MAX_DAMAGE,
+                .base_color     = s_color_damage,
+                .base_overshoot = 1.45f,
+            };
         case FCT_TYPE_REGEN:
-            rise_speed     = FCT_RISE_REGEN;
-            drift_max      = FCT_DRIFT_REGEN;
-            log_div        = FCT_LOG_DIV_REGEN;
-            font_max       = FCT_FONT_MAX_REGEN;
-            base_color     = s_color_regen;
-            base_overshoot = 1.20f;
-            if (fct_event_on_self(world_x, world_y))
-                s_regen_overlay = FCT_OVERLAY_RGN_ALPHA;
-            break;
+            return (FCTTuning){
+                .rise_speed     = FCT_RISE_REGEN,
+                .drift_max      = FCT_DRIFT_REGEN,
+                .log_div        = FCT_LOG_DIV_REGEN,
+                .font_max       = FCT_FONT_MAX_REGEN,
+                .base_color     = s_color_regen,
+                .base_overshoot = 1.20f,
+            };
         case FCT_TYPE_COIN_GAIN:
-            rise_speed     = FCT_RISE_COIN;
-            drift_max      = FCT_DRIFT_COIN;
-            log_div        = FCT_LOG_DIV_COIN;
-            font_max       = FCT_FONT_MAX_COIN;
-            base_color     = s_color_coin_gain;
-            base_overshoot = 1.25f;
-            break;
+            economy.base_color     = s_color_coin_gain;
+            economy.base_overshoot = 1.25f;
+            return economy;
         case FCT_TYPE_COIN_LOSS:
-            rise_speed     = FCT_RISE_COIN;
-            drift_max      = FCT_DRIFT_COIN;
-            log_div        = FCT_LOG_DIV_COIN;
-            font_max       = FCT_FONT_MAX_COIN;
-            base_color     = s_color_coin_loss;
-            base_overshoot = 1.25f;
-            break;
+            economy.base_color     = s_color_coin_loss;
+            economy.base_overshoot = 1.25f;
+            return economy;
         case FCT_TYPE_ITEM_GAIN:
-            rise_speed     = FCT_RISE_COIN;
-            drift_max      = FCT_DRIFT_COIN;
-            log_div        = FCT_LOG_DIV_COIN;
-            font_max       = FCT_FONT_MAX_COIN;
-            base_color     = s_color_item_gain;
-            base_overshoot = 1.20f;
-            break;
+            economy.base_color = s_color_item_gain;
+            return economy;
         case FCT_TYPE_ITEM_LOSS:
-            rise_speed     = FCT_RISE_COIN;
-            drift_max      = FCT_DRIFT_COIN;
-            log_div        = FCT_LOG_DIV_COIN;
-            font_max       = FCT_FONT_MAX_COIN;
-            base_color     = s_color_item_loss;
-            base_overshoot = 1.20f;
-            break;
+            economy.base_color = s_color_item_loss;
+            return economy;
         default:
-            rise_speed     = FCT_RISE_COIN;
-            drift_max      = FCT_DRIFT_COIN;
-            log_div        = FCT_LOG_DIV_COIN;
-            font_max       = FCT_FONT_MAX_COIN;
-            base_color     = s_color_fallback;
-            base_overshoot = 1.20f;
-            break;
+            return economy;
+    }
+}
+
+/* Text, font size and pop strength all follow the accumulated value. */
+static void fct_apply_value(FCTEntry* e, const FCTTuning* tuning) {
+    bool gain = e->type == FCT_TYPE_REGEN || e->type == FCT_TYPE_COIN_GAIN ||
+                e->type == FCT_TYPE_ITEM_GAIN;
+    if (text_memo_changed(&e->label, e->value)) {
+        if (e->item_id[0] != '\0')
+            snprintf(e->label.text, sizeof(e->label.text), "%s%u %s", gain ? "+" : "-", e->value, e->item_id);
+        else
+            snprintf(e->label.text, sizeof(e->label.text), "%s%u", gain ? "+" : "-", e->value);
     }
 
     /* ── Font size — log₂ scale, per-type grow rate ─────────────────── */
-    float log_v  = (value > 0) ? (float)log2((double)value + 1.0) : 1.0f;
+    float log_v  = (e->value > 0) ? (float)log2((double)e->value + 1.0) : 1.0f;
     float size_f = (float)FCT_FONT_MIN
-                 + (float)(font_max - FCT_FONT_MIN) * (log_v / log_div);
-    if (size_f < (float)FCT_FONT_MIN) size_f = (float)FCT_FONT_MIN;
-    if (size_f > (float)font_max)     size_f = (float)font_max;
-    slot->font_px = (int)(size_f + 0.5f);
+                 + (float)(tuning->font_max - FCT_FONT_MIN) * (log_v / tuning->log_div);
+    if (size_f < (float)FCT_FONT_MIN)      size_f = (float)FCT_FONT_MIN;
+    if (size_f > (float)tuning->font_max)  size_f = (float)tuning->font_max;
+    e->font_px = (int)(size_f + 0.5f);
 
     /* ── Pop overshoot — scales with hit magnitude ────────────────────── */
-    float t_norm = log_v / log_div;
+    float t_norm = log_v / tuning->log_div;
     if (t_norm > 1.0f) t_norm = 1.0f;
-    slot->pop_overshoot = base_overshoot + 0.25f * t_norm;
+    e->pop_overshoot = tuning->base_overshoot + 0.25f * t_norm;
+}
 
-    /* ── Colour / type ────────────────────────────────────────────────── */
-    slot->base_color = base_color;
-    slot->type       = type;
+/* A live number this hit should join: same type and item, anchored nearby,
+ * and still young enough to absorb it. */
+static FCTEntry* fct_find_merge(float wx, float wy, uint8_t type, const char* item_id) {
+    for (int i = 0; i < fct_pool_extent(&s_pool); i++) {
+        if (!fct_pool_used(&s_pool, i)) continue;
+        FCTEntry* e = fct_pool_at(&s_pool, i);
+        if (e->type != type || e->span >= FCT_MERGE_WINDOW) continue;
+        if (fabsf(e->sx - wx) > FCT_MERGE_RADIUS || fabsf(e->sy - wy) > FCT_MERGE_RADIUS) continue;
+        if (0 != strcmp(e->item_id, item_id)) continue;
+        return e;
+    }
+    return NULL;
+}
+
+/* Hits on the local player read first, then other damage, then regen, then
+ * economy. */
+static int fct_priority(const FCTEntry* e) {
+    if (e->on_self) return 3;
+    if (e->type == FCT_TYPE_DAMAGE) return 2;
+    if (e->type == FCT_TYPE_REGEN) return 1;
+    return 0;
+}
+
+/* A free slot, else the least important entry, oldest first on ties. */
+static FCTEntry* fct_claim(void) {
+    FCTEntry* victim = fct_pool_alloc(&s_pool);
+    if (victim) return victim;
+    for (int i = 0; i < fct_pool_extent(&s_pool); i++) {
+        FCTEntry* e = fct_pool_at(&s_pool, i);
+        if (!victim) { victim = e; continue; }
+        int pe = fct_priority(e);
+        int pv = fct_priority(victim);
+        if (pe < pv || (pe == pv && e->age > victim->age)) victim = e;
+    }
+    return victim;
+}
+
+static void fct_emit(float world_x, float world_y, uint32_t value, uint8_t type,
+                     const char* item_id) {
+    if (!s_init) fct_init();
+
+    /* Damage/regen are broadcast to every AOI viewer; the screen vignette
+     * is personal — only when the event lands on the local player. */
+    bool on_self = false;
+    if (type == FCT_TYPE_DAMAGE || type == FCT_TYPE_REGEN) {
+        on_self = fct_event_on_self(world_x, world_y);
+        if (on_self && type == FCT_TYPE_DAMAGE) s_damage_overlay = FCT_OVERLAY_DMG_ALPHA;
+        if (on_self && type == FCT_TYPE_REGEN)  s_regen_overlay  = FCT_OVERLAY_RGN_ALPHA;
+    }
+
+    FCTTuning tuning = fct_tuning(type);
+
+    FCTEntry* merged = fct_find_merge(world_x, world_y, type, item_id);
+    if (merged) {
+        merged->value = (UINT32_MAX - merged->value < value) ? UINT32_MAX : merged->value + value;
+        merged->on_self |= on_self;
+        merged->age = 0.0f;   /* re-pop in place */
+        fct_apply_value(merged, &tuning);
+        return;
+    }
+
+    FCTEntry* slot = fct_claim();
+    *slot = (FCTEntry){
+        .x          = world_x,
+        .y          = world_y,
+        .sx         = world_x,
+        .sy         = world_y,
+        .value      = value,
+        .base_color = tuning.base_color,
+        .type       = type,
+        .on_self    = on_self,
+    };
+    strncpy(slot->item_id, item_id, MAX_ITEM_ID_LENGTH - 1);
+    fct_apply_value(slot, &tuning);
 
     /* ── Velocity — random drift direction ────────────────────────────── */
-    float drift = FCT_DRIFT_MIN + lcg_f01() * (drift_max - FCT_DRIFT_MIN);
+    float drift = FCT_DRIFT_MIN + lcg_f01() * (tuning.drift_max - FCT_DRIFT_MIN);
     if (lcg_f01() < 0.5f) drift = -drift;
+    slot->vx = drift;
+    slot->vy = -tuning.rise_speed;
+}
 
-    slot->x      = world_x;
-    slot->y      = world_y;
-    slot->vx     = drift;
-    slot->vy     = -rise_speed;
-    slot->age    = 0.0f;
-    slot->active = true;
+/* ── Public API ─────────────────────────────────────────────────────────── */
+
+void fct_init(void) {
+    fct_pool_clear(&s_pool);
+    s_damage_overlay = 0.0f;
+    s_regen_overlay  = 0.0f;
+    s_init = true;
+}
+
+void fct_spawn(float world_x, float world_y, uint32_t value, uint8_t type) {
+    fct_emit(world_x, world_y, value, type, "");
 }
 
 // fct_spawn_item spawns a labeled FCT for item quantity changes.
 // The label is formatted as "+N itemId" or "-N itemId".
 void fct_spawn_item(float world_x, float world_y, uint32_t quantity,
                     uint8_t type, const char* item_id) {
-    if (!s_init) fct_init();
     if (quantity == 0) return;
-
-    /* Reuse fct_spawn's slot-finding logic by calling it directly, then
-     * patch the text with the item label. Use ITEM_GAIN/LOSS types so the
-     * colour switch in fct_spawn picks the right palette. */
-    fct_spawn(world_x, world_y, quantity, type);
-
-    /* fct_spawn wrote to the most recently activated slot — find it. */
-    FCTEntry* slot = NULL;
-    float latest = -1.0f;
-    for (int i = 0; i < FCT_MAX_ENTRIES; i++) {
-        if (s_pool[i].active && s_pool[i].age <= 0.001f) {
-            if (s_pool[i].age >= latest) {
-                latest = s_pool[i].age;
-                slot = &s_pool[i];
-            }
-        }
-    }
-    if (!slot) return;
-
-    /* Overwrite text with labeled form: "+45 wood" or "-30 stone". */
-    if (item_id && item_id[0] != '\0') {
-        const char* sign = (type == FCT_TYPE_ITEM_GAIN) ? "+" : "-";
-        snprintf(slot->text, sizeof(slot->text), "%s%u %s", sign, quantity, item_id);
-    }
+    fct_emit(world_x, world_y, quantity, type, item_id ? item_id : "");
 }
 
 void fct_update(float dt) {
@@ -321,12 +405,13 @@ void fct_update(float dt) {
         if (s_regen_overlay < 0.0f) s_regen_overlay = 0.0f;
     }
 
-    for (int i = 0; i < FCT_MAX_ENTRIES; i++) {
-        FCTEntry *e = &s_pool[i];
-        if (!e->active) continue;
+    for (int i = 0; i < fct_pool_extent(&s_pool); i++) {
+        if (!fct_pool_used(&s_pool, i)) continue;
+        FCTEntry *e = fct_pool_at(&s_pool, i);
 
-        e->age += dt;
-        if (e->age >= FCT_TOTAL_LIFETIME) { e->active = false; continue; }
+        e->age  += dt;
+        e->span += dt;
+        if (e->age >= FCT_TOTAL_LIFETIME) { fct_pool_free(&s_pool, e); continue; }
 
         /* Fade phase: decelerate to a floating stop. */
         if (e->age > FCT_FADE_START) {
@@ -341,64 +426,224 @@ void fct_update(float dt) {
     }
 }
 
+/* ── Digit strip ───────────────────────────────────────────────────────── */
+
+static int strip_glyph(char c) {
+    const char* at = strchr(FCT_STRIP_GLYPHS, c);
+    return (c != '\0' && at) ? (int)(at - FCT_STRIP_GLYPHS) : -1;
+}
+
+/* Shelf packer over the strip texture; false once it is full. */
+typedef struct {
+    int x, y, shelf_h;
+} StripCursor;
+
+static bool strip_place(StripCursor* cur, int w, int h, Rectangle* out) {
+    if (cur->x + w > FCT_STRIP_W) {
+        cur->y += cur->shelf_h + 1;
+        cur->x = 0;
+        cur->shelf_h = 0;
+    }
+    if (cur->y + h > FCT_STRIP_H) return false;
+    *out = (Rectangle){ (float)cur->x, (float)cur->y, (float)w, (float)h };
+    cur->x += w + 1;
+    if (h > cur->shelf_h) cur->shelf_h = h;
+    return true;
+}
+
+static void strip_bake_tier(FCTStripTier* tier, int size, StripCursor* cur) {
+    *tier = (FCTStripTier){ .size = size };
+    tier->gap = (float)(MeasureText("00", size) - 2 * MeasureText("0", size));
+    int h = (int)ceilf((float)size * text_font_factor()) + 2 * FCT_STRIP_PAD;
+
+    for (int g = 0; g < FCT_STRIP_GLYPH_COUNT; g++) {
+        char s[2] = { FCT_STRIP_GLYPHS[g], '\0' };
+        int adv = MeasureText(s, size);
+        int w   = adv + 2 * FCT_STRIP_PAD;
+        tier->adv[g] = (float)adv;
+        if (!strip_place(cur, w, h, &tier->edge[g])) return;
+        if (!strip_place(cur, w, h, &tier->fill[g])) return;
+
+        int ex = (int)tier->edge[g].x + FCT_STRIP_PAD;
+        int ey = (int)tier->edge[g].y + FCT_STRIP_PAD;
+        DrawText(s, ex + 1, ey + 2, size, (Color){0, 0, 0, 180});
+        Color outline = {0, 0, 0, 220};
+        DrawText(s, ex - 1, ey,     size, outline);
+        DrawText(s, ex + 1, ey,     size, outline);
+        DrawText(s, ex,     ey - 1, size, outline);
+        DrawText(s, ex,     ey + 1, size, outline);
+        DrawText(s, (int)tier->fill[g].x + FCT_STRIP_PAD, (int)tier->fill[g].y + FCT_STRIP_PAD,
+                 size, WHITE);
+    }
+    tier->usable = true;
+}
+
+void fct_prepare(void) {
+    if (s_strip.baked && s_strip.font_gen == text_font_generation() &&
+        s_strip.factor == text_font_factor()) {
+        return;
+    }
+    if (!s_strip.loaded) {
+        s_strip.rt = LoadRenderTexture(FCT_STRIP_W, FCT_STRIP_H);
+        SetTextureFilter(s_strip.rt.texture, TEXTURE_FILTER_BILINEAR);
+        gpu_memory_add(GPU_MEM_FCT_DIGITS, gpu_memory_texture_bytes(s_strip.rt.texture));
+        s_strip.loaded = true;
+    }
+
+    /* Straight-alpha draws onto a cleared target leave premultiplied colour
+     * and a correctly accumulated alpha behind. */
+    BeginTextureMode(s_strip.rt);
+    ClearBackground(BLANK);
+    rlSetBlendFactorsSeparate(RL_SRC_ALPHA, RL_ONE_MINUS_SRC_ALPHA, RL_ONE, RL_ONE_MINUS_SRC_ALPHA,
+                              RL_FUNC_ADD, RL_FUNC_ADD);
+    BeginBlendMode(BLEND_CUSTOM_SEPARATE);
+    StripCursor cur = { 0 };
+    for (int t = 0; t < FCT_STRIP_TIER_COUNT; t++) {
+        strip_bake_tier(&s_strip.tiers[t], s_strip_sizes[t], &cur);
+    }
+    EndBlendMode();
+    EndTextureMode();
+
+    s_strip.baked    = true;
+    s_strip.font_gen = text_font_generation();
+    s_strip.factor   = text_font_factor();
+}
+
+void fct_release(void) {
+    if (s_strip.loaded) {
+        gpu_memory_sub(GPU_MEM_FCT_DIGITS, gpu_memory_texture_bytes(s_strip.rt.texture));
+        UnloadRenderTexture(s_strip.rt);
+    }
+    memset(&s_strip, 0, sizeof(s_strip));
+}
+
+/* Smallest usable tier at least `font_px`, else the largest usable one. */
+static const FCTStripTier* strip_tier_for(int font_px) {
+    if (!s_strip.baked) return NULL;
+    const FCTStripTier* best = NULL;
+    for (int t = 0; t < FCT_STRIP_TIER_COUNT; t++) {
+        const FCTStripTier* tier = &s_strip.tiers[t];
+        if (!tier->usable) continue;
+        best = tier;
+        if (tier->size >= font_px) break;
+    }
+    return best;
+}
+
+static void strip_quad(Rectangle cell, float x, float y, float scale, Color tint) {
+    /* Render textures are stored bottom-up. */
+    Rectangle src = { cell.x, (float)FCT_STRIP_H - cell.y - cell.height, cell.width, -cell.height };
+    Rectangle dst = { x, y, cell.width * scale, cell.height * scale };
+    DrawTexturePro(s_strip.rt.texture, src, dst, (Vector2){ 0.0f, 0.0f }, 0.0f, tint);
+}
+
+/* Edge then fill per glyph, centred on cx. Tints are premultiplied. */
+static void strip_draw(const FCTStripTier* tier, const char* text, float cx, float y,
+                       int font_px, float alpha, Color fill) {
+    float scale = (float)font_px / (float)tier->size;
+    float w = 0.0f;
+    int   n = 0;
+    for (const char* c = text; *c; c++, n++) w += tier->adv[strip_glyph(*c)];
+    w = (w + tier->gap * (float)(n - 1)) * scale;
+
+    unsigned char a = (unsigned char)(alpha * 255.0f + 0.5f);
+    Color edge = { a, a, a, a };
+    Color body = {
+        (unsigned char)((float)fill.r * alpha + 0.5f),
+        (unsigned char)((float)fill.g * alpha + 0.5f),
+        (unsigned char)((float)fill.b * alpha + 0.5f),
+        a,
+    };
+    float pad = (float)FCT_STRIP_PAD * scale;
+    float pen = cx - w * 0.5f;
+    for (const char* c = text; *c; c++) {
+        int g = strip_glyph(*c);
+        strip_quad(tier->edge[g], pen - pad, y - pad, scale, edge);
+        strip_quad(tier->fill[g], pen - pad, y - pad, scale, body);
+        pen += (tier->adv[g] + tier->gap) * scale;
+    }
+}
+
+static void fct_draw_text(FCTEntry* e, int font_px, float alpha, float cell_size) {
+    const char* text = e->label.text;
+    int tw = text_memo_width(&e->label, font_px);
+    int tx = (int)(e->x * cell_size - tw * 0.5f);
+    int ty = (int)(e->y * cell_size);
+
+    unsigned char a_main   = (unsigned char)(alpha * 255.0f + 0.5f);
+    unsigned char a_shadow = (unsigned char)(alpha * 180.0f + 0.5f);
+    unsigned char a_outln  = (unsigned char)(alpha * 220.0f + 0.5f);
+
+    /* ── 1. Drop shadow ──────────────────────────────────────────── */
+    DrawText(text, tx + 1, ty + 2, font_px, (Color){0, 0, 0, a_shadow});
+
+    /* ── 2. Outline — 4 cardinal offsets, black ──────────────────── */
+    Color outline = {0, 0, 0, a_outln};
+    DrawText(text, tx - 1, ty,     font_px, outline);
+    DrawText(text, tx + 1, ty,     font_px, outline);
+    DrawText(text, tx,     ty - 1, font_px, outline);
+    DrawText(text, tx,     ty + 1, font_px, outline);
+
+    /* ── 3. Main colored text ────────────────────────────────────── */
+    Color c = e->base_color;
+    c.a = a_main;
+    DrawText(text, tx, ty, font_px, c);
+}
+
+static float fct_alpha(const FCTEntry* e) {
+    float alpha;
+    if (e->age < FCT_POP_DURATION) {
+        alpha = 0.2f + 0.8f * (e->age / FCT_POP_DURATION);
+    } else if (e->age >= FCT_FADE_START) {
+        float frac = (e->age - FCT_FADE_START) / (FCT_TOTAL_LIFETIME - FCT_FADE_START);
+        alpha = 1.0f - frac;
+    } else {
+        alpha = 1.0f;
+    }
+    if (alpha < 0.0f) alpha = 0.0f;
+    if (alpha > 1.0f) alpha = 1.0f;
+    return alpha;
+}
+
+/* Pop scale: blast up to overshoot, then snap to 1.0. */
+static int fct_font_px(const FCTEntry* e) {
+    if (e->age >= FCT_POP_DURATION) return e->font_px;
+    float t = e->age / FCT_POP_DURATION;
+    float scale;
+    if (t < 0.6f) {
+        scale = 0.4f + (t / 0.6f) * (e->pop_overshoot - 0.4f);
+    } else {
+        scale = e->pop_overshoot
+              - ((t - 0.6f) / 0.4f) * (e->pop_overshoot - 1.0f);
+    }
+    int font_px = (int)((float)e->font_px * scale + 0.5f);
+    return font_px < 4 ? 4 : font_px;
+}
+
 void fct_draw(void) {
     float cell_size = (g_game_state.cell_size > 0.0f) ? g_game_state.cell_size : 12.0f;
 
-    for (int i = 0; i < FCT_MAX_ENTRIES; i++) {
-        FCTEntry *e = &s_pool[i];
-        if (!e->active) continue;
-
-        /* ── Alpha ───────────────────────────────────────────────────── */
-        float alpha;
-        if (e->age < FCT_POP_DURATION) {
-            alpha = 0.2f + 0.8f * (e->age / FCT_POP_DURATION);
-        } else if (e->age >= FCT_FADE_START) {
-            float frac = (e->age - FCT_FADE_START) / (FCT_TOTAL_LIFETIME - FCT_FADE_START);
-            alpha = 1.0f - frac;
-        } else {
-            alpha = 1.0f;
-        }
-        if (alpha < 0.0f) alpha = 0.0f;
-        if (alpha > 1.0f) alpha = 1.0f;
-
-        /* ── Pop scale: blast up to overshoot, then snap to 1.0 ──────── */
-        int font_px = e->font_px;
-        if (e->age < FCT_POP_DURATION) {
-            float t = e->age / FCT_POP_DURATION;
-            float scale;
-            if (t < 0.6f) {
-                scale = 0.4f + (t / 0.6f) * (e->pop_overshoot - 0.4f);
-            } else {
-                scale = e->pop_overshoot
-                      - ((t - 0.6f) / 0.4f) * (e->pop_overshoot - 1.0f);
-            }
-            font_px = (int)((float)e->font_px * scale + 0.5f);
-            if (font_px < 4) font_px = 4;
-        }
-
-        /* ── Screen position (text centered on world origin) ─────────── */
-        int tw = MeasureText(e->text, font_px);
-        int tx = (int)(e->x * cell_size - tw * 0.5f);
-        int ty = (int)(e->y * cell_size);
-
-        unsigned char a_main   = (unsigned char)(alpha * 255.0f + 0.5f);
-        unsigned char a_shadow = (unsigned char)(alpha * 180.0f + 0.5f);
-        unsigned char a_outln  = (unsigned char)(alpha * 220.0f + 0.5f);
-
-        /* ── 1. Drop shadow ──────────────────────────────────────────── */
-        DrawText(e->text, tx + 1, ty + 2, font_px, (Color){0, 0, 0, a_shadow});
-
-        /* ── 2. Outline — 4 cardinal offsets, black ──────────────────── */
-        Color outline = {0, 0, 0, a_outln};
-        DrawText(e->text, tx - 1, ty,     font_px, outline);
-        DrawText(e->text, tx + 1, ty,     font_px, outline);
-        DrawText(e->text, tx,     ty - 1, font_px, outline);
-        DrawText(e->text, tx,     ty + 1, font_px, outline);
-
-        /* ── 3. Main colored text ────────────────────────────────────── */
-        Color c = e->base_color;
-        c.a = a_main;
-        DrawText(e->text, tx, ty, font_px, c);
+    /* Numbers: one premultiplied batch from the strip texture. */
+    BeginBlendMode(BLEND_ALPHA_PREMULTIPLY);
+    for (int i = 0; i < fct_pool_extent(&s_pool); i++) {
+        if (!fct_pool_used(&s_pool, i)) continue;
+        const FCTEntry *e = fct_pool_at(&s_pool, i);
+        if (e->item_id[0] != '\0') continue;
+        int font_px = fct_font_px(e);
+        const FCTStripTier* tier = strip_tier_for(font_px);
+        if (!tier) continue;
+        strip_draw(tier, e->label.text, e->x * cell_size, (float)(int)(e->y * cell_size),
+                   font_px, fct_alpha(e), e->base_color);
+    }
+    EndBlendMode();
+
+    /* Labels, and numbers before the strip is baked. */
+    for (int i = 0; i < fct_pool_extent(&s_pool); i++) {
+        if (!fct_pool_used(&s_pool, i)) continue;
+        FCTEntry *e = fct_pool_at(&s_pool, i);
+        int font_px = fct_font_px(e);
+        if (e->item_id[0] == '\0' && strip_tier_for(font_px)) continue;
+        fct_draw_text(e, font_px, fct_alpha(e), cell_size);
     }
 }
 
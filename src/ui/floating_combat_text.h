@@ -23,6 +23,7 @@
  *
  * Typical integration:
  *   render_on_tick():   fct_update(delta_time);
+ *   game_render_frame()  (before BeginMode2D): fct_prepare();
  *   game_render_world()  (inside BeginMode2D): fct_draw();
  *   on server event:   fct_spawn(world_x, world_y, value, type);
  *
@@ -54,7 +55,8 @@
 #define FCT_TYPE_ITEM_GAIN 0x04   /* item qty in  — cyan   "+N ItemID"     */
 #define FCT_TYPE_ITEM_LOSS 0x05   /* item qty out — purple "-N ItemID"     */
 
-/** Maximum number of concurrently active FCT entries. */
+/** Maximum number of concurrently active FCT entries; past it the least
+ *  important entry is recycled. */
 #define FCT_MAX_ENTRIES 64
 
 /* ── Public API ──────────────────────────────────────────────────────── */
@@ -102,6 +104,16 @@ void fct_update(float dt);
  */
 void fct_draw(void);
 
+/**
+ * @brief Bake the digit strip the numbers are drawn from.
+ * Call every frame outside any texture mode, before BeginMode2D; it rebakes
+ * only when the font or its scale changes.
+ */
+void fct_prepare(void);
+
+/** @brief Free the digit strip texture (renderer teardown). */
+void fct_release(void);
+
 /**
  * @brief Draw screen-space vignette overlays for damage and regen events.
  * Must be called OUTSIDE BeginMode2D (in screen space), after EndMode2D.
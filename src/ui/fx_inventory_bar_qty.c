@@ -5,6 +5,7 @@
 #include "loot_fx.h"
 #include "object_layer.h"
 #include "text.h"
+#include "render_stats.h"
 
 #include <math.h>
 #include <raylib.h>
@@ -279,14 +280,8 @@ static void draw_popup(const FqEntry* e, Rectangle slot) {
     /* Solid, opaque black border — concentric 8-direction rings at a capped
      * thickness (no translucent drop shadow, no size-dependent distortion). */
     Color outline = { 0, 0, 0, a };
-    for (int o = 1; o <= border; o++)
-        for (int dy = -1; dy <= 1; dy++)
-            for (int dx = -1; dx <= 1; dx++)
-                if (dx || dy)
-                    DrawText(buf, cx + dx * o, cy + dy * o, fs, outline);
-
     body.a = a;
-    DrawText(buf, cx, cy, fs, body);
+    text_draw_outlined(buf, cx, cy, fs, body, outline, border);
 }
 
 void fx_inventory_bar_qty_draw(Rectangle slot, const char* item_id) {
@@ -0,0 +1,124 @@
+#include "ui/fx_particles.h"
+
+#include "ui/fx_shapes.h"
+
+#include <assert.h>
+#include <stdint.h>
+
+/* One column per field. The ballistic pass runs over whole columns with no
+ * per-particle branching, so the compiler is free to vectorise it. */
+static struct {
+    int     count;
+    float   x[FX_PARTICLE_MAX];
+    float   y[FX_PARTICLE_MAX];
+    float   vx[FX_PARTICLE_MAX];
+    float   vy[FX_PARTICLE_MAX];
+    float   gravity[FX_PARTICLE_MAX];
+    float   sx[FX_PARTICLE_MAX];        /* arc start */
+    float   sy[FX_PARTICLE_MAX];
+    float   tx[FX_PARTICLE_MAX];
+    float   ty[FX_PARTICLE_MAX];
+    float   arc[FX_PARTICLE_MAX];
+    float   age[FX_PARTICLE_MAX];
+    float   ttl[FX_PARTICLE_MAX];
+    float   size[FX_PARTICLE_MAX];
+    Color   color[FX_PARTICLE_MAX];
+    uint8_t space[FX_PARTICLE_MAX];
+    uint8_t motion[FX_PARTICLE_MAX];
+    uint8_t fade[FX_PARTICLE_MAX];
+} g_fx_particles;
+
+void fx_particles_reset(void) {
+    g_fx_particles.count = 0;
+}
+
+bool fx_particles_spawn(const FxParticle* p) {
+    assert(p && 0.0f < p->ttl);
+    if (FX_PARTICLE_MAX <= g_fx_particles.count) return false;
+
+    int  i   = g_fx_particles.count++;
+    bool arc = FX_MOTION_ARC == p->motion;
+    g_fx_particles.x[i]       = p->x;
+    g_fx_particles.y[i]       = p->y;
+    /* Arc particles are placed outright each frame; zero velocity keeps the
+     * shared ballistic pass from moving them. */
+    g_fx_particles.vx[i]      = arc ? 0.0f : p->vx;
+    g_fx_particles.vy[i]      = arc ? 0.0f : p->vy;
+    g_fx_particles.gravity[i] = arc ? 0.0f : p->gravity;
+    g_fx_particles.sx[i]      = p->x;
+    g_fx_particles.sy[i]      = p->y;
+    g_fx_particles.tx[i]      = p->tx;
+    g_fx_particles.ty[i]      = p->ty;
+    g_fx_particles.arc[i]     = p->arc;
+    g_fx_particles.age[i]     = 0.0f;
+    g_fx_particles.ttl[i]     = p->ttl;
+    g_fx_particles.size[i]    = p->size;
+    g_fx_particles.color[i]   = p->color;
+    g_fx_particles.space[i]   = (uint8_t)p->space;
+    g_fx_particles.motion[i]  = (uint8_t)p->motion;
+    g_fx_particles.fade[i]    = p->fade;
+    return true;
+}
+
+static void particle_move(int to, int from) {
+    g_fx_particles.x[to]       = g_fx_particles.x[from];
+    g_fx_particles.y[to]       = g_fx_particles.y[from];
+    g_fx_particles.vx[to]      = g_fx_particles.vx[from];
+    g_fx_particles.vy[to]      = g_fx_particles.vy[from];
+    g_fx_particles.gravity[to] = g_fx_particles.gravity[from];
+    g_fx_particles.sx[to]      = g_fx_particles.sx[from];
+    g_fx_particles.sy[to]      = g_fx_particles.sy[from];
+    g_fx_particles.tx[to]      = g_fx_particles.tx[from];
+    g_fx_particles.ty[to]      = g_fx_particles.ty[from];
+    g_fx_particles.arc[to]     = g_fx_particles.arc[from];
+    g_fx_particles.age[to]     = g_fx_particles.age[from];
+    g_fx_particles.ttl[to]     = g_fx_particles.ttl[from];
+    g_fx_particles.size[to]    = g_fx_particles.size[from];
+    g_fx_particles.color[to]   = g_fx_particles.color[from];
+    g_fx_particles.space[to]   = g_fx_particles.space[from];
+    g_fx_particles.motion[to]  = g_fx_particles.motion[from];
+    g_fx_particles.fade[to]    = g_fx_particles.fade[from];
+}
+
+void fx_particles_update(float dt) {
+    int n = g_fx_particles.count;
+
+    /* Retire first: an expired particle is never moved again. The last
+     * particle fills the hole and is checked in its place. */
+    for (int i = 0; i < n;) {
+        g_fx_particles.age[i] += dt;
+        if (g_fx_particles.age[i] < g_fx_particles.ttl[i]) { i++; continue; }
+        particle_move(i, --n);
+    }
+    g_fx_particles.count = n;
+
+    for (int i = 0; i < n; i++) {
+        g_fx_particles.vy[i] += g_fx_particles.gravity[i] * dt;
+        g_fx_particles.x[i]  += g_fx_particles.vx[i] * dt;
+        g_fx_particles.y[i]  += g_fx_particles.vy[i] * dt;
+    }
+
+    for (int i = 0; i < n; i++) {
+        if (FX_MOTION_ARC != g_fx_particles.motion[i]) continue;
+        float t  = g_fx_particles.age[i] / g_fx_particles.ttl[i];
+        float sx = g_fx_particles.sx[i];
+        float sy = g_fx_particles.sy[i];
+        g_fx_particles.x[i] = sx + (g_fx_particles.tx[i] - sx) * t;
+        g_fx_particles.y[i] = sy + (g_fx_particles.ty[i] - sy) * t
+                            - 4.0f * g_fx_particles.arc[i] * t * (1.0f - t);
+    }
+}
+
+void fx_particles_draw(FxSpace space, float scale) {
+    for (int i = 0; i < g_fx_particles.count; i++) {
+        if ((uint8_t)space != g_fx_particles.space[i]) continue;
+        float alpha = 1.0f;
+        if (g_fx_particles.fade[i]) alpha = 1.0f - g_fx_particles.age[i] / g_fx_particles.ttl[i];
+        fx_shape_spark(g_fx_particles.x[i] * scale, g_fx_particles.y[i] * scale,
+                       g_fx_particles.size[i] * scale, g_fx_particles.color[i], alpha);
+    }
+}
+
+int fx_particles_count(void) {
+    return g_fx_particles.count;
+}
@@ -0,0 +1,64 @@
+#ifndef CYBERIA_UI_FX_PARTICLES_H
+#define CYBERIA_UI_FX_PARTICLES_H
+
+#include <raylib.h>
+#include <stdbool.h>
+
+/* Shared particle runtime for the square-spark effects (fx_shapes look).
+ *
+ * Effects are emitters: they fill in an FxParticle and spawn it, then forget
+ * it. The store keeps every live particle in one structure-of-arrays pool,
+ * packed at [0, count), advanced by a single fx_particles_update() per frame
+ * and drawn per space in one run, so a burst of any size costs one
+ * shapes-texture batch.
+ *
+ * Two motions:
+ *   - ballistic: velocity integrated under a constant downward gravity;
+ *   - arc:       constant-speed travel from (x, y) to (tx, ty) under a
+ *                parabola `arc` units high, landing as the life ends.
+ * World particles are in grid units and scaled by the caller's cell size at
+ * draw time; screen particles are in pixels. Spawns past FX_PARTICLE_MAX
+ * are dropped. */
+
+#define FX_PARTICLE_MAX 1024
+
+typedef enum {
+    FX_SPACE_WORLD,    /* grid units, drawn under the camera */
+    FX_SPACE_SCREEN,   /* screen pixels */
+} FxSpace;
+
+typedef enum {
+    FX_MOTION_BALLISTIC,
+    FX_MOTION_ARC,
+} FxMotion;
+
+typedef struct {
+    FxSpace  space;
+    FxMotion motion;
+    float    x, y;           /* spawn center */
+    float    vx, vy;         /* ballistic: units/s */
+    float    gravity;        /* ballistic: units/s^2, positive is down */
+    float    tx, ty;         /* arc: landing center */
+    float    arc;            /* arc: peak height above the straight path */
+    float    ttl;            /* seconds, > 0 */
+    float    size;           /* square side */
+    Color    color;          /* body; the border is black */
+    bool     fade;           /* alpha falls from 1 to 0 over the life */
+} FxParticle;
+
+void fx_particles_reset(void);
+
+/* False when the store is full and the particle was dropped. */
+bool fx_particles_spawn(const FxParticle* p);
+
+/* Age, move and retire every particle. Call once per frame. */
+void fx_particles_update(float dt);
+
+/* Draw the particles of `space`, positions and sizes multiplied by
+ * `scale`. Every spark shares the shapes texture, so the run lands in one
+ * rlgl batch; inside an open render queue it is queued instead. */
+void fx_particles_draw(FxSpace space, float scale);
+
+int fx_particles_count(void);
+
+#endif /* CYBERIA_UI_FX_PARTICLES_H */
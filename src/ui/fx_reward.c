@@ -121,6 +121,7 @@ static Rectangle s_bounds     = { 0, 0, 0, 0 };
 static float     s_intensity  = 0.0f;
 static double    s_clock      = 0.0;
 static bool      s_requested  = false;
+static bool      s_ready      = false;   /* fx_reward_init() ran */
 
 /* Deterministic LCG — avoids perturbing the global rand() state. */
 static uint32_t s_lcg = 0xA1330Du;
@@ -247,6 +248,7 @@ void fx_reward_init(void) {
     s_intensity = 0.0f;
     s_clock     = 0.0;
     s_requested = false;
+    s_ready     = true;
 
     for (int i = 0; i < RFX_STAR_COUNT; i++) {
         RfxAnchorLayout a = make_anchor_layout(i, RFX_STAR_COUNT);
@@ -275,11 +277,13 @@ void fx_reward_reset(void) {
 }
 
 void fx_reward_show(Rectangle modal_bounds) {
+    if (!s_ready) fx_reward_init();
     s_bounds    = modal_bounds;
     s_requested = true;
 }
 
 void fx_reward_trigger(Rectangle modal_bounds) {
+    if (!s_ready) fx_reward_init();
     s_bounds    = modal_bounds;
     s_requested = true; /* ensure the celebration is up when the wave lands */
 
@@ -315,6 +319,7 @@ static void trail_push(Vector2* trail, int* head, Vector2 pos) {
 }
 
 void fx_reward_update(float dt) {
+    if (!s_ready) return;
     s_clock += dt;
 
     /* Fade toward the requested state. */
@@ -392,15 +397,28 @@ static void draw_particle(Vector2 pos, float size, float alpha, bool is_star, fl
     }
 }
 
-void fx_reward_draw(void) {
-    if (s_intensity <= 0.001f) return;
-
-    float grow = 0.55f + 0.45f * s_intensity; /* anchors scale in on show */
+/* Arrival opacity, faded during the final stretch of its settle. */
+static float arrival_alpha(const RfxArrival* a) {
+    float t = a->age - a->delay;
+    float alpha = s_intensity;
+    if (t >= a->travel_dur) {
+        float st = (t - a->travel_dur) / a->settle_dur;
+        float fade_from = 1.0f - RFX_ARRIVAL_FADE;
+        if (st > fade_from) alpha *= 1.0f - (st - fade_from) / (1.0f - fade_from);
+    }
+    return alpha;
+}
 
+/* The small particles in two passes split by texture: square sparks and
+ * every arrival trail first (the shapes texture), then the tiny star icons.
+ * Drawn interleaved, each alternation between the two would break the
+ * batch. */
+static void draw_small_particles(bool stars, float grow) {
     /* Small ambient particles — anchored on one of the 3 rings, bobbing and
      * pulsing in place. */
     for (int i = 0; i < RFX_SPARK_COUNT; i++) {
         const RfxSpark* p = &s_sparks[i];
+        if (p->is_star != stars) continue;
         Vector2 at = ring_pos_u_at(p->u, p->radius_jitter, p->layer);
         float bob = sinf((float)s_clock * RFX_FLOAT_FREQ + p->phase) * RFX_FLOAT_AMP;
         float pulse = 0.80f + 0.20f * sinf((float)s_clock * RFX_PULSE_FREQ + p->phase * 1.7f);
@@ -408,21 +426,25 @@ void fx_reward_draw(void) {
         draw_particle((Vector2){ at.x, at.y + bob }, size, s_intensity, p->is_star, p->rot);
     }
 
-    /* Arrival wave — the one-shot flourish, faded during its final stretch. */
+    /* Arrival wave — the one-shot flourish. */
     for (int i = 0; i < RFX_ARRIVAL_MAX; i++) {
         const RfxArrival* a = &s_arrivals[i];
         if (!a->active) continue;
         if (a->age < a->delay) continue; /* still waiting its turn to glide in */
-        float t = a->age - a->delay;
-        float alpha = s_intensity;
-        if (t >= a->travel_dur) {
-            float st = (t - a->travel_dur) / a->settle_dur;
-            float fade_from = 1.0f - RFX_ARRIVAL_FADE;
-            if (st > fade_from) alpha *= 1.0f - (st - fade_from) / (1.0f - fade_from);
-        }
-        draw_trail(a->trail, a->trail_head, a->size, alpha);
+        float alpha = arrival_alpha(a);
+        if (!stars) draw_trail(a->trail, a->trail_head, a->size, alpha);
+        if (a->is_star != stars) continue;
         draw_particle((Vector2){ a->x, a->y }, a->size, alpha, a->is_star, a->age * RFX_ARRIVAL_STAR_SPIN);
     }
+}
+
+void fx_reward_draw(void) {
+    if (s_intensity <= 0.001f) return;
+
+    float grow = 0.55f + 0.45f * s_intensity; /* anchors scale in on show */
+
+    draw_small_particles(false, grow);
+    draw_small_particles(true, grow);
 
     /* Large ambient stars — anchored on one of the 3 rings, over the small
      * particles so the halo reads foreground-to-background. */
@@ -24,6 +24,7 @@
  *      covering its text.
  * Skipping fx_reward_show for a frame begins the fade-out automatically. */
 
+/* Runs on the first fx_reward_show / fx_reward_trigger. */
 void fx_reward_init(void);
 void fx_reward_reset(void);
 
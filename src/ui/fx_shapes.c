@@ -1,14 +1,26 @@
 #include "ui/fx_shapes.h"
+#include "render_queue.h"
+#include "render_stats.h"
 
 #include <raylib.h>
 
 const Color FX_SPARK_GOLD = { 255, 226, 20, 255 };
 const Color FX_SPARK_GRAY = { 168, 168, 168, 255 };
 
+/* Joins the render queue when it is open, so sparks drawn inside a pass
+ * group with the rest of the shapes-texture quads. */
+static void fill_rect(int x, int y, int w, int h, Color color) {
+    if (render_queue_is_open()) {
+        render_queue_push_rect((Rectangle){ (float)x, (float)y, (float)w, (float)h }, color, 0);
+        return;
+    }
+    DrawRectangle(x, y, w, h, color);
+}
+
 void fx_shape_bar(float x, float y, float w, float h, float border, Color body) {
-    DrawRectangle((int)(x - border), (int)(y - border),
-                  (int)(w + border * 2.0f), (int)(h + border * 2.0f), BLACK);
-    DrawRectangle((int)x, (int)y, (int)w, (int)h, body);
+    fill_rect((int)(x - border), (int)(y - border),
+              (int)(w + border * 2.0f), (int)(h + border * 2.0f), BLACK);
+    fill_rect((int)x, (int)y, (int)w, (int)h, body);
 }
 
 void fx_shape_spark(float cx, float cy, float size_px, Color body, float alpha) {
@@ -27,6 +39,6 @@ void fx_shape_spark(float cx, float cy, float size_px, Color body, float alpha)
     unsigned char a = (unsigned char)(255.0f * alpha + 0.5f);
     body.a = a;
 
-    DrawRectangle(x - b, y - b, s + b * 2, s + b * 2, (Color){ 0, 0, 0, a });
-    DrawRectangle(x, y, s, s, body);
+    fill_rect(x - b, y - b, s + b * 2, s + b * 2, (Color){ 0, 0, 0, a });
+    fill_rect(x, y, s, s, body);
 }
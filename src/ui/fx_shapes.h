@@ -5,7 +5,8 @@
 
 /* Shared FX shape primitives — the yellow, black-bordered particle look used by
  * the tap effect, loot drops, and reward celebration. Pure drawing, no state,
- * screen/world agnostic (caller supplies pixel coordinates). */
+ * screen/world agnostic (caller supplies pixel coordinates). Inside an open
+ * render queue the rectangles are queued rather than drawn. */
 
 extern const Color FX_SPARK_GOLD;   /* golden yellow — loot the player may collect */
 extern const Color FX_SPARK_GRAY;   /* neutral gray — another player's loot */
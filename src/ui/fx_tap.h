@@ -5,7 +5,7 @@
 // Owns a small fixed pool of short-lived crosses. No input handling here.
 //
 // Integration pattern:
-//   init:    fx_tap_init();
+//   init:    fx_tap_init(), or implicitly by the first fx_tap_spawn();
 //   update:  fx_tap_update(delta_time);
 //   draw:    fx_tap_draw();   // outside BeginMode2D (converts internally)
 
@@ -0,0 +1,232 @@
+#include "glyph_cache.h"
+
+#include "gpu_memory.h"
+#include "heap_memory.h"
+#include "util/log.h"
+
+#include <assert.h>
+#include <rlgl.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define GLYPH_GUTTER 1
+#define GLYPH_SLOTS  (2 * GLYPH_CACHE_MAX)   /* open-addressed, a power of two */
+
+static const int BUCKETS[] = GLYPH_CACHE_BUCKETS;
+#define BUCKET_COUNT ((int)(sizeof(BUCKETS) / sizeof(BUCKETS[0])))
+
+typedef struct {
+    int         codepoint;
+    int8_t      bucket;     /* -1 marks an empty slot */
+    bool        none;       /* neither the codepoint nor '?' exists */
+    CachedGlyph glyph;
+} GlyphSlot;
+
+static struct {
+    unsigned char* ttf;
+    size_t         ttf_size;
+    bool           loaded;     /* page texture up */
+    Texture2D      page;
+    GlyphSlot      slots[GLYPH_SLOTS];
+    int16_t        ascii[BUCKET_COUNT][128];   /* slot of each ASCII glyph, or -1 */
+    int            count;
+    int            shelf_x, shelf_y, shelf_h;
+} g_glyphs;
+
+/* ── Page ────────────────────────────────────────────────────────────── */
+
+static void table_clear(void) {
+    for (int i = 0; i < GLYPH_SLOTS; i++) g_glyphs.slots[i].bucket = -1;
+    memset(g_glyphs.ascii, 0xff, sizeof(g_glyphs.ascii));
+    g_glyphs.count   = 0;
+    g_glyphs.shelf_x = g_glyphs.shelf_y = g_glyphs.shelf_h = 0;
+}
+
+static bool page_ensure(void) {
+    if (g_glyphs.loaded) return true;
+    Image blank = {
+        .data    = calloc((size_t)GLYPH_CACHE_PAGE_PX * GLYPH_CACHE_PAGE_PX, 2),
+        .width   = GLYPH_CACHE_PAGE_PX,
+        .height  = GLYPH_CACHE_PAGE_PX,
+        .mipmaps = 1,
+        .format  = PIXELFORMAT_UNCOMPRESSED_GRAY_ALPHA,
+    };
+    assert(blank.data);
+    g_glyphs.page = LoadTextureFromImage(blank);
+    UnloadImage(blank);
+    if (0 == g_glyphs.page.id) return false;
+    SetTextureFilter(g_glyphs.page, TEXTURE_FILTER_BILINEAR);
+    gpu_memory_add(GPU_MEM_FONTS, gpu_memory_texture_bytes(g_glyphs.page));
+    g_glyphs.loaded = true;
+    return true;
+}
+
+static void page_reset(void) {
+    /* Quads already batched still sample the old glyphs. */
+    rlDrawRenderBatchActive();
+    LOG_INFO("[glyph_cache] page full at %d glyphs, refilling", g_glyphs.count);
+    table_clear();
+}
+
+static bool page_place(int w, int h, Rectangle* out) {
+    if (GLYPH_CACHE_PAGE_PX < g_glyphs.shelf_x + w) {
+        g_glyphs.shelf_y += g_glyphs.shelf_h;
+        g_glyphs.shelf_x  = 0;
+        g_glyphs.shelf_h  = 0;
+    }
+    if (GLYPH_CACHE_PAGE_PX < g_glyphs.shelf_y + h || GLYPH_CACHE_PAGE_PX < w) return false;
+    *out = (Rectangle){ (float)g_glyphs.shelf_x, (float)g_glyphs.shelf_y, (float)w, (float)h };
+    g_glyphs.shelf_x += w;
+    if (h > g_glyphs.shelf_h) g_glyphs.shelf_h = h;
+    return true;
+}
+
+/* Grey coverage → white texels with that alpha, in a transparent gutter. */
+static void upload(const Image* coverage, Rectangle cell) {
+    int w = (int)cell.width, h = (int)cell.height;
+    unsigned char* px = calloc((size_t)w * h, 2);
+    assert(px);
+    const unsigned char* src = coverage->data;
+    for (int y = 0; y < coverage->height; y++) {
+        unsigned char* row = px + ((size_t)(y + GLYPH_GUTTER) * w + GLYPH_GUTTER) * 2;
+        for (int x = 0; x < coverage->width; x++) {
+            row[x * 2]     = 255;
+            row[x * 2 + 1] = src[y * coverage->width + x];
+        }
+    }
+    UpdateTextureRec(g_glyphs.page, cell, px);
+    free(px);
+}
+
+/* ── Table ───────────────────────────────────────────────────────────── */
+
+static uint32_t slot_of(int bucket, int codepoint) {
+    return ((uint32_t)codepoint * 2654435761u ^ (uint32_t)bucket * 40503u) & (GLYPH_SLOTS - 1);
+}
+
+static GlyphSlot* find(int bucket, int codepoint) {
+    if (0 <= codepoint && 128 > codepoint) {
+        int16_t s = g_glyphs.ascii[bucket][codepoint];
+        return 0 <= s ? &g_glyphs.slots[s] : NULL;
+    }
+    for (uint32_t i = slot_of(bucket, codepoint);; i = (i + 1) & (GLYPH_SLOTS - 1)) {
+        GlyphSlot* s = &g_glyphs.slots[i];
+        if (0 > s->bucket) return NULL;
+        if (bucket == s->bucket && codepoint == s->codepoint) return s;
+    }
+}
+
+static GlyphSlot* insert(int bucket, int codepoint) {
+    uint32_t i = slot_of(bucket, codepoint);
+    while (0 <= g_glyphs.slots[i].bucket) i = (i + 1) & (GLYPH_SLOTS - 1);
+    GlyphSlot* s = &g_glyphs.slots[i];
+    *s = (GlyphSlot){ .codepoint = codepoint, .bucket = (int8_t)bucket };
+    if (0 <= codepoint && 128 > codepoint) g_glyphs.ascii[bucket][codepoint] = (int16_t)i;
+    g_glyphs.count++;
+    return s;
+}
+
+/* Rasterize one glyph as LoadFontData would at the bucket size. False when
+ * the font has no glyph for it. */
+static bool rasterize(int bucket, int codepoint, CachedGlyph* out) {
+    int count = 0;
+    GlyphInfo* info = LoadFontData(g_glyphs.ttf, (int)g_glyphs.ttf_size, BUCKETS[bucket],
+                                   &codepoint, 1, FONT_DEFAULT, &count);
+    if (!info || 0 == count) {
+        UnloadFontData(info, count);
+        return false;
+    }
+    const GlyphInfo* gi = &info[0];
+    /* Spaces come back as blank images; they are never drawn. */
+    bool ink = gi->image.data && 0 < gi->image.width && 0 < gi->image.height &&
+               0x20 != codepoint && 0x3000 != codepoint;
+
+    Rectangle cell = { 0 };
+    if (ink) {
+        int w = gi->image.width + 2 * GLYPH_GUTTER, h = gi->image.height + 2 * GLYPH_GUTTER;
+        if (!page_place(w, h, &cell)) {
+            page_reset();
+            if (!page_place(w, h, &cell)) {
+                UnloadFontData(info, count);
+                return false;
+            }
+        }
+        upload(&gi->image, cell);
+    }
+    *out = (CachedGlyph){
+        .src      = cell,
+        .offset_x = (float)(gi->offsetX - GLYPH_GUTTER),
+        .offset_y = (float)(gi->offsetY - GLYPH_GUTTER),
+        .advance  = 0 < gi->advanceX ? (float)gi->advanceX : (float)gi->image.width,
+    };
+    UnloadFontData(info, count);
+    return true;
+}
+
+/* ── Public API ──────────────────────────────────────────────────────── */
+
+void glyph_cache_set_font(const unsigned char* ttf, size_t size) {
+    rlDrawRenderBatchActive();
+    heap_free(g_glyphs.ttf);
+    g_glyphs.ttf      = NULL;
+    g_glyphs.ttf_size = 0;
+    table_clear();
+    if (!ttf || 0 == size) return;
+
+    g_glyphs.ttf = heap_malloc(HEAP_MEM_TEXT_LAYOUT, size);
+    assert(g_glyphs.ttf);
+    memcpy(g_glyphs.ttf, ttf, size);
+    g_glyphs.ttf_size = size;
+}
+
+bool glyph_cache_ready(void) {
+    return NULL != g_glyphs.ttf;
+}
+
+int glyph_cache_bucket(float font_size) {
+    for (int b = 0; b < BUCKET_COUNT; b++) {
+        if ((float)BUCKETS[b] >= font_size) return b;
+    }
+    return BUCKET_COUNT - 1;
+}
+
+float glyph_cache_bucket_px(int bucket) {
+    assert(0 <= bucket && BUCKET_COUNT > bucket);
+    return (float)BUCKETS[bucket];
+}
+
+const CachedGlyph* glyph_cache_get(int bucket, int codepoint) {
+    assert(0 <= bucket && BUCKET_COUNT > bucket);
+    if (!g_glyphs.ttf) return NULL;
+    GlyphSlot* s = find(bucket, codepoint);
+    if (s) return s->none ? NULL : &s->glyph;
+    if (!page_ensure()) return NULL;
+    if (GLYPH_CACHE_MAX <= g_glyphs.count) page_reset();
+
+    CachedGlyph glyph = { 0 };
+    bool none = false;
+    if (!rasterize(bucket, codepoint, &glyph)) {
+        const CachedGlyph* fallback = '?' != codepoint ? glyph_cache_get(bucket, '?') : NULL;
+        if (fallback) glyph = *fallback;
+        else          none = true;
+    }
+    s = insert(bucket, codepoint);
+    s->none  = none;
+    s->glyph = glyph;
+    return none ? NULL : &s->glyph;
+}
+
+Texture2D glyph_cache_texture(void) {
+    return g_glyphs.page;
+}
+
+void glyph_cache_release(void) {
+    if (g_glyphs.loaded) {
+        gpu_memory_sub(GPU_MEM_FONTS, gpu_memory_texture_bytes(g_glyphs.page));
+        UnloadTexture(g_glyphs.page);
+    }
+    heap_free(g_glyphs.ttf);
+    memset(&g_glyphs, 0, sizeof g_glyphs);
+    table_clear();
+}
@@ -0,0 +1,55 @@
+#ifndef CYBERIA_UI_GLYPH_CACHE_H
+#define CYBERIA_UI_GLYPH_CACHE_H
+
+#include <raylib.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/* On-demand glyph rasterization for the main UI font (ui/text.c).
+ *
+ * Loading a TTF the raylib way rasterizes a fixed glyph set (ASCII) at one
+ * size, and every other size scales that bitmap; anything outside the set
+ * draws as '?'. This cache keeps the TTF bytes instead and rasterizes a
+ * glyph the first time it is drawn or measured at a size bucket — the
+ * smallest of GLYPH_CACHE_BUCKETS at least as large as the requested size,
+ * so text only ever scales down, and by less than one bucket step. Glyphs
+ * of every bucket share one GLYPH_CACHE_PAGE_PX² grey-alpha page, shelf
+ * packed; a full page (or table) is refilled from scratch after flushing
+ * the batch, so memory stays at one page whatever the text.
+ *
+ * Metrics match raylib's LoadFontData at the bucket size, so text drawn and
+ * measured through the cache lines up the way DrawTextEx/MeasureTextEx
+ * would for a font loaded at that size. A codepoint the font lacks takes
+ * its '?' glyph, as GetGlyphIndex does. */
+
+#define GLYPH_CACHE_BUCKETS  { 12, 16, 20, 24, 32, 48, 64 }
+#define GLYPH_CACHE_PAGE_PX  1024
+#define GLYPH_CACHE_MAX      1024
+
+typedef struct {
+    Rectangle src;        /* on the page, gutter included */
+    float     offset_x;   /* dst offset of src from the pen, bucket pixels */
+    float     offset_y;
+    float     advance;    /* bucket pixels */
+} CachedGlyph;
+
+/* Rasterize from `ttf` (copied) from now on; NULL unloads. Every cached
+ * glyph is dropped. */
+void  glyph_cache_set_font(const unsigned char* ttf, size_t size);
+bool  glyph_cache_ready(void);
+
+/* Bucket to draw `font_size`-pixel text from, and its size in pixels. */
+int   glyph_cache_bucket(float font_size);
+float glyph_cache_bucket_px(int bucket);
+
+/* Glyph of `codepoint` at `bucket`, rasterized on a miss. NULL when neither
+ * it nor '?' exists in the font, or the page can't hold it. The pointer is
+ * valid until the next glyph_cache_get(). */
+const CachedGlyph* glyph_cache_get(int bucket, int codepoint);
+
+Texture2D glyph_cache_texture(void);
+
+/* Unload the page and the font bytes. */
+void  glyph_cache_release(void);
+
+#endif /* CYBERIA_UI_GLYPH_CACHE_H */
@@ -0,0 +1,192 @@
+#include "ui/icon_atlas.h"
+
+#include "gpu_memory.h"
+#include "object_layers_management.h"
+#include "render_stats.h"
+
+#include <assert.h>
+#include <rlgl.h>
+#include <string.h>
+
+#define CELL_COLS  (ICON_ATLAS_PX / ICON_ATLAS_CELL_PX)
+#define CELL_COUNT (CELL_COLS * CELL_COLS)
+
+typedef struct {
+    uint64_t  hash;
+    int       size;
+    int       count;
+    IconLayer layers[ICON_ATLAS_MAX_LAYERS];
+} IconKey;
+
+typedef struct {
+    bool     used;
+    IconKey  key;
+    uint32_t last_seen;   /* frame the icon was last drawn */
+} IconCell;
+
+static struct {
+    bool            loaded;
+    RenderTexture2D page;
+    IconCell        cells[CELL_COUNT];
+    IconKey         queue[ICON_ATLAS_QUEUE];
+    int             queued;
+    uint32_t        frame;
+    unsigned        atlas_generation;
+} g_icon_atlas;
+
+static bool layer_eq(const IconLayer* a, const IconLayer* b) {
+    return a->texture.id == b->texture.id && a->src.x == b->src.x && a->src.y == b->src.y &&
+           a->src.width == b->src.width && a->src.height == b->src.height;
+}
+
+static bool key_eq(const IconKey* a, const IconKey* b) {
+    if (a->hash != b->hash || a->size != b->size || a->count != b->count) return false;
+    for (int i = 0; i < a->count; i++) {
+        if (!layer_eq(&a->layers[i], &b->layers[i])) return false;
+    }
+    return true;
+}
+
+static void key_make(IconKey* out, const IconLayer* layers, int count, int size) {
+    *out = (IconKey){ .size = size, .count = count };
+    uint64_t h = 14695981039346656037ull ^ (uint64_t)(uint32_t)size;
+    for (int i = 0; i < count; i++) {
+        out->layers[i] = layers[i];
+        const float r[4] = { layers[i].src.x, layers[i].src.y, layers[i].src.width,
+                             layers[i].src.height };
+        uint32_t bits[4];
+        memcpy(bits, r, sizeof(bits));
+        h = (h ^ layers[i].texture.id) * 1099511628211ull;
+        for (int k = 0; k < 4; k++) h = (h ^ bits[k]) * 1099511628211ull;
+    }
+    out->hash = h;
+}
+
+static Rectangle cell_rect(int cell) {
+    return (Rectangle){
+        (float)(cell % CELL_COLS * ICON_ATLAS_CELL_PX),
+        (float)(cell / CELL_COLS * ICON_ATLAS_CELL_PX),
+        (float)ICON_ATLAS_CELL_PX,
+        (float)ICON_ATLAS_CELL_PX,
+    };
+}
+
+void icon_atlas_draw_live(const IconLayer* layers, int count, int x, int y, int size, Color tint) {
+    assert(layers || 0 == count);
+    Rectangle dst = { (float)x, (float)y, (float)size, (float)size };
+    for (int i = 0; i < count; i++) {
+        DrawTexturePro(layers[i].texture, layers[i].src, dst, (Vector2){ 0.0f, 0.0f }, 0.0f, tint);
+    }
+}
+
+/* A free cell, else the one drawn longest ago and not in the last frame. */
+static int cell_claim(void) {
+    int best = -1;
+    for (int i = 0; i < CELL_COUNT; i++) {
+        const IconCell* c = &g_icon_atlas.cells[i];
+        if (!c->used) return i;
+        if (c->last_seen + 1 >= g_icon_atlas.frame) continue;
+        if (best < 0 || c->last_seen < g_icon_atlas.cells[best].last_seen) best = i;
+    }
+    return best;
+}
+
+static int cell_find(const IconKey* key) {
+    for (int i = 0; i < CELL_COUNT; i++) {
+        const IconCell* c = &g_icon_atlas.cells[i];
+        if (c->used && key_eq(&c->key, key)) return i;
+    }
+    return -1;
+}
+
+static void cell_bake(int cell, const IconKey* key) {
+    g_icon_atlas.cells[cell] = (IconCell){
+        .used      = true,
+        .key       = *key,
+        .last_seen = g_icon_atlas.frame,
+    };
+    Rectangle r = cell_rect(cell);
+    BeginScissorMode((int)r.x, (int)r.y, (int)r.width, (int)r.height);
+    ClearBackground(BLANK);
+    EndScissorMode();
+    icon_atlas_draw_live(key->layers, key->count, (int)r.x, (int)r.y, key->size, WHITE);
+}
+
+void icon_atlas_prepare(void) {
+    g_icon_atlas.frame++;
+    unsigned generation = obj_layers_mgr_atlas_generation();
+    if (generation != g_icon_atlas.atlas_generation) {
+        g_icon_atlas.atlas_generation = generation;
+        memset(g_icon_atlas.cells, 0, sizeof(g_icon_atlas.cells));
+        g_icon_atlas.queued = 0;
+        return;
+    }
+    if (0 == g_icon_atlas.queued) return;
+    if (!g_icon_atlas.loaded) {
+        g_icon_atlas.page = LoadRenderTexture(ICON_ATLAS_PX, ICON_ATLAS_PX);
+        gpu_memory_add(GPU_MEM_UI_ICONS, gpu_memory_texture_bytes(g_icon_atlas.page.texture));
+        g_icon_atlas.loaded = true;
+        BeginTextureMode(g_icon_atlas.page);
+        ClearBackground(BLANK);
+        EndTextureMode();
+    }
+
+    /* Alpha accumulates over the cleared cell, so stacked layers keep the
+     * coverage they would have on screen. Colour is left premultiplied and
+     * blitted with plain alpha, which only darkens partly transparent edge
+     * pixels; the sprites are pixel art and rarely have any. */
+    BeginTextureMode(g_icon_atlas.page);
+    rlSetBlendFactorsSeparate(RL_SRC_ALPHA, RL_ONE_MINUS_SRC_ALPHA, RL_ONE, RL_ONE_MINUS_SRC_ALPHA,
+                              RL_FUNC_ADD, RL_FUNC_ADD);
+    BeginBlendMode(BLEND_CUSTOM_SEPARATE);
+    int baked = 0;
+    for (int q = 0; q < g_icon_atlas.queued && ICON_ATLAS_BAKES_PER_FRAME > baked; q++) {
+        const IconKey* key = &g_icon_atlas.queue[q];
+        if (0 <= cell_find(key)) continue;
+        int cell = cell_claim();
+        if (0 > cell) break;
+        cell_bake(cell, key);
+        baked++;
+    }
+    EndBlendMode();
+    EndTextureMode();
+    /* Icons left over are queued again by their next miss. */
+    g_icon_atlas.queued = 0;
+}
+
+int icon_atlas_find(const IconLayer* layers, int count, int size) {
+    assert(layers || 0 == count);
+    if (0 >= count || ICON_ATLAS_MAX_LAYERS < count || 0 >= size || ICON_ATLAS_CELL_PX < size) {
+        return -1;
+    }
+    IconKey key;
+    key_make(&key, layers, count, size);
+    int cell = cell_find(&key);
+    if (0 <= cell) {
+        g_icon_atlas.cells[cell].last_seen = g_icon_atlas.frame;
+        return cell;
+    }
+    for (int q = 0; q < g_icon_atlas.queued; q++) {
+        if (key_eq(&g_icon_atlas.queue[q], &key)) return -1;
+    }
+    if (ICON_ATLAS_QUEUE > g_icon_atlas.queued) g_icon_atlas.queue[g_icon_atlas.queued++] = key;
+    return -1;
+}
+
+void icon_atlas_blit(int cell, int x, int y, Color tint) {
+    assert(0 <= cell && CELL_COUNT > cell && g_icon_atlas.cells[cell].used);
+    float size = (float)g_icon_atlas.cells[cell].key.size;
+    Rectangle r = cell_rect(cell);
+    /* Render textures are stored bottom-up. */
+    Rectangle src = { r.x, (float)ICON_ATLAS_PX - r.y - size, size, -size };
+    Rectangle dst = { (float)x, (float)y, size, size };
+    DrawTexturePro(g_icon_atlas.page.texture, src, dst, (Vector2){ 0.0f, 0.0f }, 0.0f, tint);
+}
+
+void icon_atlas_release(void) {
+    if (g_icon_atlas.loaded) {
+        gpu_memory_sub(GPU_MEM_UI_ICONS, gpu_memory_texture_bytes(g_icon_atlas.page.texture));
+        UnloadRenderTexture(g_icon_atlas.page);
+    }
+    memset(&g_icon_atlas, 0, sizeof(g_icon_atlas));
+}
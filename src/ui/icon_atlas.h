@@ -0,0 +1,53 @@
+#ifndef CYBERIA_UI_ICON_ATLAS_H
+#define CYBERIA_UI_ICON_ATLAS_H
+
+#include <raylib.h>
+#include <stdbool.h>
+
+/* UI item icons pre-composited into one shared page.
+ *
+ * ol_as_ico_draw and ol_stack_ico_draw resolve an atlas, a direction and a
+ * frame, then draw one DrawTexturePro per layer, each possibly from its own
+ * atlas texture. An icon frame (its layers' source rects, in z-order, at one
+ * size) is instead composited once into a cell of a render-texture page at
+ * exactly the drawn size and blitted afterwards as a single quad, so every
+ * baked icon on screen batches into one texture.
+ *
+ * A frame not baked yet is drawn live and queued; the queue bakes in
+ * icon_atlas_prepare(), at most ICON_ATLAS_BAKES_PER_FRAME a frame. Cells
+ * are LRU-recycled, never while their frame was drawn in the last frame.
+ * Icons larger than a cell, or with more than ICON_ATLAS_MAX_LAYERS layers,
+ * always draw live. A texture landing in the atlas cache
+ * (obj_layers_mgr_atlas_generation) retires every cell, since source
+ * textures may have moved. */
+
+#define ICON_ATLAS_PX              1024
+#define ICON_ATLAS_CELL_PX         64
+#define ICON_ATLAS_MAX_LAYERS      8
+#define ICON_ATLAS_QUEUE           64
+#define ICON_ATLAS_BAKES_PER_FRAME 24
+
+/* One layer of an icon frame: the source rect in its atlas texture. */
+typedef struct {
+    Texture2D texture;
+    Rectangle src;
+} IconLayer;
+
+/* Bake the queued frames. Must run outside BeginMode2D — baking switches
+ * the render target. */
+void icon_atlas_prepare(void);
+
+/* Baked cell of layers[0..count) drawn at size × size, bottom layer first,
+ * or -1 after queueing it for a bake. */
+int  icon_atlas_find(const IconLayer* layers, int count, int size);
+
+/* Draw baked `cell` with its top-left at (x, y). */
+void icon_atlas_blit(int cell, int x, int y, Color tint);
+
+/* Draw layers[0..count) live at (x, y), as the bake does. */
+void icon_atlas_draw_live(const IconLayer* layers, int count, int x, int y, int size, Color tint);
+
+/* Unload the page and forget every cell. */
+void icon_atlas_release(void);
+
+#endif /* CYBERIA_UI_ICON_ATLAS_H */
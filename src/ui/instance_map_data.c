@@ -1,7 +1,13 @@
 #include "instance_map_data.h"
 
+#include "frame_tasks.h"
 #include "game_state.h"
+#include "heap_memory.h"
+#include "json_reader.h"
+#include "msgpack_decode.h"
 #include "network/engine_client.h"
+#include "network/game_client.h"
+#include "serial.h"
 #include "util/log.h"
 
 #include <cJSON.h>
@@ -11,6 +17,7 @@
 #include <string.h>
 
 #define IMAP_POLL_INTERVAL_S 1.0f
+#define IMAP_PARSE_ELEMENTS_PER_SLICE 16
 
 static ImapGraph     s_graph;
 static ImapDataState s_state       = IMAP_DATA_IDLE;
@@ -18,6 +25,8 @@ static bool          s_open        = false;
 static int           s_generation  = 0;
 static float         s_poll_timer  = 0.0f;
 static bool          s_poll_inflight = false;
+static bool          s_subscribed  = false;   /* subscribe frame sent this session  */
+static bool          s_push_live   = false;   /* a push arrived; polling has stopped */
 
 /* Session guard: bumped on every open/close so responses that complete after
  * a close (or across a reopen) are recognised as stale and dropped. */
@@ -130,31 +139,88 @@ static void refresh_node_capability_counts(void) {
     }
 }
 
-static void parse_presence_pois(const cJSON* doc) {
-    const cJSON* pois = cJSON_GetObjectItemCaseSensitive(doc, "presencePois");
-    if (!cJSON_IsArray(pois)) return;
+/* One element of each static array; false once its table is full. */
+static bool parse_node(const cJSON* nd) {
+    if (s_graph.node_count >= IMAP_MAX_NODES) return false;
+    ImapNode* node = &s_graph.nodes[s_graph.node_count++];
+    memset(node, 0, sizeof(*node));
+    copy_str(node->map_code, IMAP_CODE_MAX, json_str(nd, "mapCode"));
+    const char* name = json_str(nd, "name");
+    copy_str(node->name, IMAP_NAME_MAX, name ? name : node->map_code);
+    copy_str(node->preview_url, IMAP_URL_MAX, json_str(nd, "previewUrl"));
+    node->grid_x = json_int(nd, "gridX", 16);
+    node->grid_y = json_int(nd, "gridY", 16);
+    return true;
+}
 
-    const cJSON* poi_doc = NULL;
-    cJSON_ArrayForEach(poi_doc, pois) {
-        int node = instance_map_data_find_node(json_str(poi_doc, "mapCode"));
-        int cell_x = json_int(poi_doc, "cellX", -1);
-        int cell_y = json_int(poi_doc, "cellY", -1);
-        ImapPresenceStatus presence = presence_status_from_string(json_str(poi_doc, "presenceStatus"));
-        if (node < 0 || cell_x < 0 || cell_y < 0 || IMAP_PRESENCE_NONE == presence)
-            continue;
+static bool parse_presence_poi(const cJSON* poi_doc) {
+    int node = instance_map_data_find_node(json_str(poi_doc, "mapCode"));
+    int cell_x = json_int(poi_doc, "cellX", -1);
+    int cell_y = json_int(poi_doc, "cellY", -1);
+    ImapPresenceStatus presence = presence_status_from_string(json_str(poi_doc, "presenceStatus"));
+    if (node < 0 || cell_x < 0 || cell_y < 0 || IMAP_PRESENCE_NONE == presence)
+        return true;
+
+    ImapPresencePoi* poi = find_presence_poi(node, cell_x, cell_y);
+    if (NULL == poi) {
+        if (s_graph.presence_poi_count >= IMAP_MAX_PRESENCE_POIS) return false;
+        poi = &s_graph.presence_pois[s_graph.presence_poi_count++];
+        *poi = (ImapPresencePoi){ .node = node, .cell_x = cell_x, .cell_y = cell_y };
+    }
+    poi->presence_status = presence;
+    poi->stats_sum = json_int(poi_doc, "statsSum", 0);
+    poi->show_stats_value = json_bool(poi_doc, "showStatsValue", false);
+    poi->capabilities |= parse_capabilities(poi_doc);
+    return true;
+}
 
-        ImapPresencePoi* poi = find_presence_poi(node, cell_x, cell_y);
-        if (NULL == poi) {
-            if (s_graph.presence_poi_count >= IMAP_MAX_PRESENCE_POIS) break;
-            poi = &s_graph.presence_pois[s_graph.presence_poi_count++];
-            *poi = (ImapPresencePoi){ .node = node, .cell_x = cell_x, .cell_y = cell_y };
-        }
-        poi->presence_status = presence;
-        poi->stats_sum = json_int(poi_doc, "statsSum", 0);
-        poi->show_stats_value = json_bool(poi_doc, "showStatsValue", false);
-        poi->capabilities |= parse_capabilities(poi_doc);
+static bool parse_edge(const cJSON* ed) {
+    if (s_graph.edge_count >= IMAP_MAX_EDGES) return false;
+    int src = instance_map_data_find_node(json_str(ed, "sourceMapCode"));
+    int tgt = instance_map_data_find_node(json_str(ed, "targetMapCode"));
+    if (src < 0 || tgt < 0) return true;
+    ImapEdge* e = &s_graph.edges[s_graph.edge_count++];
+    memset(e, 0, sizeof(*e));
+    e->source_node   = src;
+    e->target_node   = tgt;
+    e->intra         = (src == tgt);
+    copy_str(e->portal_mode, sizeof(e->portal_mode), json_str(ed, "portalMode"));
+    e->source_cell_x = json_int(ed, "sourceCellX", -1);
+    e->source_cell_y = json_int(ed, "sourceCellY", -1);
+    e->target_cell_x = json_int(ed, "targetCellX", -1);
+    e->target_cell_y = json_int(ed, "targetCellY", -1);
+    s_graph.nodes[src].portal_count++;
+    if (tgt != src) s_graph.nodes[tgt].portal_count++;
+    return true;
+}
+
+/* Nodes first: POIs and edges name their maps by code. */
+typedef enum {
+    IMAP_PARSE_NODES,
+    IMAP_PARSE_POIS,
+    IMAP_PARSE_EDGES,
+    IMAP_PARSE_PHASES
+} ImapParsePhase;
+
+static bool (*const k_phase_parse[IMAP_PARSE_PHASES])(const cJSON*) = {
+    [IMAP_PARSE_NODES] = parse_node,
+    [IMAP_PARSE_POIS]  = parse_presence_poi,
+    [IMAP_PARSE_EDGES] = parse_edge,
+};
+
+static const char* const k_phase_key[IMAP_PARSE_PHASES] = {
+    [IMAP_PARSE_NODES] = "nodes",
+    [IMAP_PARSE_POIS]  = "presencePois",
+    [IMAP_PARSE_EDGES] = "edges",
+};
+
+static void parse_array(const cJSON* doc, ImapParsePhase phase) {
+    const cJSON* arr = cJSON_GetObjectItemCaseSensitive(doc, k_phase_key[phase]);
+    if (!cJSON_IsArray(arr)) return;
+    const cJSON* el = NULL;
+    cJSON_ArrayForEach(el, arr) {
+        if (!k_phase_parse[phase](el)) break;
     }
-    refresh_node_capability_counts();
 }
 
 static bool parse_static_doc(const cJSON* doc) {
@@ -162,73 +228,171 @@ static bool parse_static_doc(const cJSON* doc) {
     copy_str(s_graph.instance_code, IMAP_CODE_MAX, json_str(doc, "instanceCode"));
     copy_str(s_graph.name, IMAP_NAME_MAX, json_str(doc, "name"));
 
-    const cJSON* nodes = cJSON_GetObjectItemCaseSensitive(doc, "nodes");
-    if (!cJSON_IsArray(nodes)) return false;
-    const cJSON* nd = NULL;
-    cJSON_ArrayForEach(nd, nodes) {
-        if (s_graph.node_count >= IMAP_MAX_NODES) break;
-        ImapNode* node = &s_graph.nodes[s_graph.node_count++];
-        memset(node, 0, sizeof(*node));
-        copy_str(node->map_code, IMAP_CODE_MAX, json_str(nd, "mapCode"));
-        const char* name = json_str(nd, "name");
-        copy_str(node->name, IMAP_NAME_MAX, name ? name : node->map_code);
-        copy_str(node->preview_url, IMAP_URL_MAX, json_str(nd, "previewUrl"));
-        node->grid_x = json_int(nd, "gridX", 16);
-        node->grid_y = json_int(nd, "gridY", 16);
+    if (!cJSON_IsArray(cJSON_GetObjectItemCaseSensitive(doc, "nodes"))) return false;
+    for (int phase = 0; phase < IMAP_PARSE_PHASES; phase++) parse_array(doc, phase);
+    refresh_node_capability_counts();
+    layout_graph();
+    return s_graph.node_count > 0;
+}
+
+/* ── Presence subscription ──────────────────────────────────────────────── */
+
+static void subscribe(void) {
+    BinWriter w;
+    uplink_imap_subscribe(&w, g_game_state.instance_code);
+    s_subscribed = network_send_binary(w.buf, w.pos);
+}
+
+static void unsubscribe(void) {
+    if (!s_subscribed) return;
+    BinWriter w;
+    uplink_imap_unsubscribe(&w);
+    network_send_binary(w.buf, w.pos);
+    s_subscribed = false;
+}
+
+/* The graph is complete (or failed): only now does it become READY. */
+static void finish_static(bool ok) {
+    if (ok) {
+        s_state = IMAP_DATA_READY;
+        s_generation++;
+        subscribe();
+        /* With a subscription out the server's first push is expected well
+         * within one interval; without one, poll immediately. */
+        s_poll_timer = s_subscribed ? 0.0f : IMAP_POLL_INTERVAL_S;
+    } else {
+        s_state = IMAP_DATA_ERROR;
+        LOG_WARN("instance map static parse failed");
+    }
+}
+
+/* ── Static payload, parsed over frames ─────────────────────────────────── */
+
+typedef struct {
+    int        session;
+    bool       scanned;
+    int        phase;
+    bool       in_array;
+    size_t     at[IMAP_PARSE_PHASES];   /* offset of each array, 0 = absent */
+    JsonReader reader;
+    size_t     size;
+    char       body[];
+} ImapStaticParse;
+
+/* Envelope and `data` members, arrays stepped over and their offsets kept
+ * (the phases need nodes first, whatever the key order). */
+static bool scan_static(ImapStaticParse* p) {
+    JsonReader* r = &p->reader;
+    bool success = false, data = false;
+    char key[32];
+    memset(&s_graph, 0, sizeof(s_graph));
+    if (!jr_object_begin(r)) return false;
+    while (jr_object_next(r, key, sizeof(key))) {
+        if (0 == strcmp(key, "status")) {
+            char status[16];
+            success = jr_string(r, status, sizeof(status)) && 0 == strcmp(status, "success");
+        } else if (0 == strcmp(key, "data") && JR_OBJECT == jr_peek(r)) {
+            data = jr_object_begin(r);
+            while (jr_object_next(r, key, sizeof(key))) {
+                if (0 == strcmp(key, "instanceCode")) {
+                    jr_string(r, s_graph.instance_code, IMAP_CODE_MAX);
+                    continue;
+                }
+                if (0 == strcmp(key, "name")) {
+                    jr_string(r, s_graph.name, IMAP_NAME_MAX);
+                    continue;
+                }
+                for (int phase = 0; phase < IMAP_PARSE_PHASES; phase++) {
+                    if (0 == strcmp(key, k_phase_key[phase]) && JR_ARRAY == jr_peek(r)) p->at[phase] = r->pos;
+                }
+                jr_skip(r);
+            }
+        } else {
+            jr_skip(r);
+        }
     }
-    parse_presence_pois(doc);
-
-    const cJSON* edges = cJSON_GetObjectItemCaseSensitive(doc, "edges");
-    if (cJSON_IsArray(edges)) {
-        const cJSON* ed = NULL;
-        cJSON_ArrayForEach(ed, edges) {
-            if (s_graph.edge_count >= IMAP_MAX_EDGES) break;
-            int src = instance_map_data_find_node(json_str(ed, "sourceMapCode"));
-            int tgt = instance_map_data_find_node(json_str(ed, "targetMapCode"));
-            if (src < 0 || tgt < 0) continue;
-            ImapEdge* e = &s_graph.edges[s_graph.edge_count++];
-            memset(e, 0, sizeof(*e));
-            e->source_node   = src;
-            e->target_node   = tgt;
-            e->intra         = (src == tgt);
-            copy_str(e->portal_mode, sizeof(e->portal_mode), json_str(ed, "portalMode"));
-            e->source_cell_x = json_int(ed, "sourceCellX", -1);
-            e->source_cell_y = json_int(ed, "sourceCellY", -1);
-            e->target_cell_x = json_int(ed, "targetCellX", -1);
-            e->target_cell_y = json_int(ed, "targetCellY", -1);
-            s_graph.nodes[src].portal_count++;
-            if (tgt != src) s_graph.nodes[tgt].portal_count++;
+    return !r->error && success && data && 0 != p->at[IMAP_PARSE_NODES];
+}
+
+/* Up to IMAP_PARSE_ELEMENTS_PER_SLICE elements of the current array, each
+ * parsed on its own; false on malformed input. */
+static bool parse_static_elements(ImapStaticParse* p) {
+    JsonReader* r = &p->reader;
+    if (!p->in_array) {
+        jr_init(r, p->body, p->size);
+        r->pos = p->at[p->phase];
+        if (!jr_array_begin(r)) return false;
+        p->in_array = true;
+    }
+    for (int n = 0; n < IMAP_PARSE_ELEMENTS_PER_SLICE; n++) {
+        bool more = jr_array_next(r);
+        size_t len = 0;
+        const char* el = more ? jr_value(r, &len) : NULL;
+        if (r->error) return false;
+        cJSON* tree = el ? serial_json_parse(el, len) : NULL;
+        more = more && (!tree || k_phase_parse[p->phase](tree));
+        serial_json_free(tree);
+        if (!more) {
+            p->phase++;
+            p->in_array = false;
+            return true;
         }
     }
+    return true;
+}
 
-    layout_graph();
-    return s_graph.node_count > 0;
+static bool parse_static_slice(void* ctx) {
+    ImapStaticParse* p = ctx;
+    /* Closed or reopened meanwhile: the graph belongs to another session. */
+    if (!s_open || p->session != s_session) {
+        heap_free(p);
+        return true;
+    }
+    bool done = true;
+    if (msgpack_is(p->body, p->size)) {
+        /* No cheap element boundaries: the whole tree in one slice. */
+        cJSON* root = serial_json_parse(p->body, p->size);
+        const cJSON* doc = envelope_success_doc(root);
+        finish_static(doc && parse_static_doc(doc));
+        serial_json_free(root);
+    } else if (!p->scanned) {
+        p->scanned = true;
+        done = !scan_static(p);
+        if (done) finish_static(false);
+    } else {
+        while (p->phase < IMAP_PARSE_PHASES && 0 == p->at[p->phase]) p->phase++;
+        if (p->phase < IMAP_PARSE_PHASES) {
+            done = !parse_static_elements(p);
+            if (done) finish_static(false);
+        } else {
+            refresh_node_capability_counts();
+            layout_graph();
+            finish_static(s_graph.node_count > 0);
+        }
+    }
+    if (done) heap_free(p);
+    return done;
 }
 
 static void on_static_fetched(const FetchResponse* r) {
     /* asset_id carries the session stamp — drop stale/closed sessions. */
     if (!s_open || atoi(r->asset_id + strlen("imap-static-")) != s_session) {
-        free(r->data);
         return;
     }
-    if (!r->success) {
+    if (!r->success || !r->data || 0 == r->size) {
         s_state = IMAP_DATA_ERROR;
         LOG_WARN("instance map static fetch failed");
-        free(r->data);
         return;
     }
-    cJSON* root = cJSON_ParseWithLength((const char*)r->data, r->size);
-    const cJSON* doc = envelope_success_doc(root);
-    if (doc && parse_static_doc(doc)) {
-        s_state = IMAP_DATA_READY;
-        s_generation++;
-        s_poll_timer = IMAP_POLL_INTERVAL_S; /* first dynamic poll immediately */
-    } else {
+    ImapStaticParse* p = heap_malloc(HEAP_MEM_FETCH, sizeof(ImapStaticParse) + r->size);
+    if (!p) {
         s_state = IMAP_DATA_ERROR;
-        LOG_WARN("instance map static parse failed");
+        return;
     }
-    cJSON_Delete(root);
-    free(r->data);
+    *p = (ImapStaticParse){ .session = s_session, .size = r->size };
+    memcpy(p->body, r->data, r->size);
+    jr_init(&p->reader, p->body, p->size);
+    frame_tasks_submit(FRAME_TASK_NORMAL, parse_static_slice, p);
 }
 
 /* ── Dynamic payload ────────────────────────────────────────────────────── */
@@ -264,21 +428,20 @@ static void apply_dynamic_capabilities(const cJSON* doc, const char* key, bool q
 static void on_dynamic_fetched(const FetchResponse* r) {
     if (!s_open || atoi(r->asset_id + strlen("imap-dyn-")) != s_session) {
         s_poll_inflight = false;
-        free(r->data);
         return;
     }
     s_poll_inflight = false;
-    if (!r->success) { free(r->data); return; }
+    /* Pushed state is newer than any poll still in flight. */
+    if (!r->success || s_push_live) { return; }
 
-    cJSON* root = cJSON_ParseWithLength((const char*)r->data, r->size);
+    cJSON* root = serial_json_parse((const char*)r->data, r->size);
     const cJSON* doc = envelope_success_doc(root);
     if (doc && IMAP_DATA_READY == s_state) {
         clear_dynamic_capabilities();
         apply_dynamic_capabilities(doc, "questProviders", true);
         apply_dynamic_capabilities(doc, "actionProviders", false);
     }
-    cJSON_Delete(root);
-    free(r->data);
+    serial_json_free(root);
 }
 
 static void start_dynamic_poll(void) {
@@ -288,7 +451,24 @@ static void start_dynamic_poll(void) {
     snprintf(url, sizeof(url), "/api/cyberia-instance/instance-map/%s/dynamic?playerId=%s",
              g_game_state.instance_code, g_game_state.player_id);
     s_poll_inflight = true;
-    fetch_request_start(asset_id, url, on_dynamic_fetched);
+    fetch_request_start(asset_id, url, FETCH_CLASS_POLL, on_dynamic_fetched);
+}
+
+void instance_map_data_presence_reset(void) {
+    if (!s_open || IMAP_DATA_READY != s_state) return;
+    s_push_live = true;
+    clear_dynamic_capabilities();
+}
+
+void instance_map_data_presence_set(int node, int cell_x, int cell_y, bool action_active,
+                                    bool quest_active, bool quest_acceptable) {
+    if (!s_open || IMAP_DATA_READY != s_state) return;
+    s_push_live = true;
+    ImapPresencePoi* poi = find_presence_poi(node, cell_x, cell_y);
+    if (NULL == poi) return;
+    poi->action_active    = action_active && (poi->capabilities & IMAP_CAPABILITY_ACTION);
+    poi->quest_active     = quest_active && (poi->capabilities & IMAP_CAPABILITY_QUEST);
+    poi->quest_acceptable = poi->quest_active && quest_acceptable;
 }
 
 /* ── Lifecycle ──────────────────────────────────────────────────────────── */
@@ -298,6 +478,8 @@ void instance_map_data_open(void) {
     s_open       = true;
     s_poll_timer = 0.0f;
     s_poll_inflight = false;
+    s_push_live  = false;
+    unsubscribe();
 
     if ('\0' == g_game_state.instance_code[0]) {
         s_state = IMAP_DATA_ERROR;
@@ -311,7 +493,7 @@ void instance_map_data_open(void) {
     char url[256];
     snprintf(url, sizeof(url), "/api/cyberia-instance/instance-map/%s/static",
              g_game_state.instance_code);
-    fetch_request_start(asset_id, url, on_static_fetched);
+    fetch_request_start(asset_id, url, FETCH_CLASS_UI, on_static_fetched);
 }
 
 void instance_map_data_close(void) {
@@ -319,10 +501,12 @@ void instance_map_data_close(void) {
     s_open        = false;
     s_state       = IMAP_DATA_IDLE;
     s_poll_inflight = false;
+    s_push_live   = false;
+    unsubscribe();
 }
 
 void instance_map_data_update(float dt) {
-    if (!s_open || IMAP_DATA_READY != s_state) return;
+    if (!s_open || IMAP_DATA_READY != s_state || s_push_live) return;
     s_poll_timer += dt;
     if (s_poll_timer >= IMAP_POLL_INTERVAL_S && !s_poll_inflight) {
         s_poll_timer = 0.0f;
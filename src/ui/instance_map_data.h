@@ -6,12 +6,22 @@
 
 /* instance_map_data — data layer for the expanded Instance Map modal.
  *
- * Independent from the gameplay AOI stream: talks only to the engine-cyberia
- * Instance Map REST endpoints through network/engine_client.
+ * The static graph comes from the engine-cyberia Instance Map REST endpoint
+ * through network/engine_client; live provider state is pushed on the game
+ * socket while the modal is open.
  *
  *   open  → GET /api/cyberia-instance/instance-map/:code/static   (once)
- *   open  → GET /api/cyberia-instance/instance-map/:code/dynamic  (~1/s)
- *   close → polling stops immediately; late responses are discarded.
+ *   ready → UPLINK_IMAP_SUBSCRIBE; the server answers with a full
+ *           BIN_MSG_IMAP_PRESENCE and then pushes only changed POIs
+ *   close → UPLINK_IMAP_UNSUBSCRIBE; late responses are discarded.
+ *
+ * Until the first push arrives (a server without the subscription, or a
+ * socket that is down) GET .../:code/dynamic is polled ~1/s instead.
+ *
+ * A large instance's static graph is parsed over several frames as a
+ * frame task (frame_tasks.h): a JsonReader scan locates the node, POI and
+ * edge arrays, then each slice parses a few of their elements straight
+ * into the graph. The state stays LOADING until the last element lands.
  *
  * Static POIs carry authored presence, baseline ObjectLayer stats, and
  * capability membership. Live player position and stats remain client-side.
@@ -41,7 +51,7 @@ typedef enum {
 typedef enum {
     IMAP_DATA_IDLE = 0,     /* modal closed, nothing fetched          */
     IMAP_DATA_LOADING,      /* static fetch in flight                 */
-    IMAP_DATA_READY,        /* static graph parsed; polling dynamic   */
+    IMAP_DATA_READY,        /* static graph parsed; presence live     */
     IMAP_DATA_ERROR,        /* static fetch/parse failed              */
 } ImapDataState;
 
@@ -103,9 +113,15 @@ void instance_map_data_open(void);
 /* Stop polling immediately. In-flight responses are discarded on arrival. */
 void instance_map_data_close(void);
 
-/* Drive the ~1/s dynamic poll while open. Call once per frame. */
+/* Drive the ~1/s fallback poll while open. Call once per frame. */
 void instance_map_data_update(float dt);
 
+/* BIN_MSG_IMAP_PRESENCE: clear every POI's live state, then set one POI's.
+ * Ignored unless the graph is ready; unknown nodes/cells are dropped. */
+void instance_map_data_presence_reset(void);
+void instance_map_data_presence_set(int node, int cell_x, int cell_y, bool action_active,
+                                    bool quest_active, bool quest_acceptable);
+
 ImapDataState    instance_map_data_state(void);
 const ImapGraph* instance_map_data_graph(void);
 
@@ -19,8 +19,9 @@
 #include "dialogue_data.h"
 #include "entity_render.h"
 #include "game_state.h"
+#include "map_arena.h"
 #include "world_types.h"
-#include "js/interact_bridge.h"
+#include "js/overlay_commands.h"
 #include "modal_interact.h"
 #include "notification.h"
 #include "toolbar.h"
@@ -37,6 +38,7 @@
 #include "ol_stack_ico.h"
 #include "ui_icon.h"
 #include "util/log.h"
+#include "render_stats.h"
 
 #include <assert.h>
 #include <math.h>
@@ -48,6 +50,7 @@
 
 static InteractionBubbleSlot s_slots[IBUBBLE_MAX_SLOTS];
 static int                   s_slot_count = 0;
+static bool                  s_slots_overflow = false; /* an entity found no free slot */
 static int                   s_border_color_dbg = 0;
 
 /* Collapsible column: a left-edge toggle slides the bubbles in/out. Slots
@@ -168,7 +171,7 @@ static const Color C_SLOT_HOVER     = {  35,  45,  75, 230 };
  * presentation table. Neither path consults the server.
  */
 static Color status_border_color(const InteractionBubbleSlot* slot, bool is_self) {
-    if (is_self) return presentation_runtime_palette("SELF_BORDER");
+    if (is_self) return presentation_runtime_palette_slot(PALETTE_SELF_BORDER);
     Color c = presentation_runtime_status_border(slot->status_icon);
     if (s_border_color_dbg < 12) {
         LOG_INFO("[BORDER] entity=%s status_icon=%d border=(%d,%d,%d,%d)\n",
@@ -220,7 +223,10 @@ static InteractionBubbleSlot* upsert_slot(const char* entity_id) {
         slot->active = true;
         return slot;
     }
-    if (s_slot_count >= IBUBBLE_MAX_SLOTS) return NULL;
+    if (s_slot_count >= IBUBBLE_MAX_SLOTS) {
+        s_slots_overflow = true;
+        return NULL;
+    }
 
     slot = &s_slots[s_slot_count];
     memset(slot, 0, sizeof(InteractionBubbleSlot));
@@ -307,8 +313,8 @@ static void scan_entity(const char* entity_id, const EntityState* base,
 
     /* Resolve the solid-colour fallback from the client-owned presentation
      * table by entity_type. The server does not ship colour data. */
-    const char* etype = is_player ? "player" : "bot";
-    slot->fallback_color = presentation_runtime_entity_fallback_color(etype);
+    slot->fallback_color = presentation_runtime_entity_color(is_player ? ENTITY_COLOR_PLAYER
+                                                                       : ENTITY_COLOR_BOT);
 
     /* Always snapshot current layers (dead or alive) into layers[]. */
     snapshot_layers(slot, base->object_layers, base->object_layer_count,
@@ -349,11 +355,88 @@ static void scan_entity(const char* entity_id, const EntityState* base,
     }
 }
 
+/* Slots follow the world mirror through game_state's entity events; only a
+ * catalog or dialogue-data change (both alter what scan_entity resolves), or
+ * room freeing up after an entity was turned away, rescans every entity. */
+static bool     s_scan_valid = false;
+static unsigned s_scan_catalog_gen;
+static unsigned s_scan_dialogue_gen;
+
+static void release_slot(const char* entity_id) {
+    InteractionBubbleSlot* slot = find_slot(entity_id);
+    if (slot) slot->active = false;
+}
+
+static void track_entity(const char* entity_id, const EntityState* base, bool is_player,
+                         const BotState* bot) {
+    if (bot && '\0' != bot->caster_id[0]) {
+        release_slot(entity_id);
+        return;
+    }
+    scan_entity(entity_id, base, is_player, bot ? bot->behavior : NULL,
+                bot ? bot->interaction_flags : 0);
+}
+
+static void on_entity_event(const GameStateEntityEvent* ev) {
+    if (GAME_STATE_ENTITY_LEAVE == ev->type) {
+        release_slot(ev->id);
+        return;
+    }
+    /* Until the first rescan every entity is picked up there, self first. */
+    if (s_scan_valid) track_entity(ev->id, ev->base, ev->is_player, ev->bot);
+}
+
+static void rescan_all(void) {
+    for (int i = 0; i < s_slot_count; i++)
+        s_slots[i].active = false;
+
+    /* Self-player is always scanned first → occupies slot 0. */
+    if (g_game_state.player_id[0] != '\0') {
+        track_entity(g_game_state.player_id, &g_game_state.player.base, true, NULL);
+    }
+    for (int i = 0; i < g_game_state.other_player_count; i++) {
+        const PlayerState* p = &g_game_state.other_players[i];
+        track_entity(p->base.id, &p->base, true, NULL);
+    }
+    for (int i = 0; i < g_game_state.bot_count; i++) {
+        const BotState* bot = &g_game_state.bots[i];
+        track_entity(bot->base.id, &bot->base, false, bot);
+    }
+}
+
+static void sync_slots(void) {
+    unsigned catalog  = obj_layers_mgr_catalog_generation();
+    unsigned dialogue = dialogue_data_generation();
+    bool room = s_slots_overflow && IBUBBLE_MAX_SLOTS > s_slot_count;
+    if (s_scan_valid && catalog == s_scan_catalog_gen && dialogue == s_scan_dialogue_gen &&
+        !room) {
+        return;
+    }
+    s_scan_valid        = true;
+    s_slots_overflow    = false;
+    s_scan_catalog_gen  = catalog;
+    s_scan_dialogue_gen = dialogue;
+    rescan_all();
+}
+
+/* Map change: drop every slot, released ones included; the next update
+ * rescans the new map, self first. */
+static void on_map_change(void) {
+    s_slot_count = 0;
+    memset(s_slots, 0, sizeof(s_slots));
+    s_slots_overflow = false;
+    s_scan_valid = false;
+}
+
 /* ── Public API ──────────────────────────────────────────────────────── */
 
 void interaction_bubble_init(void) {
     s_slot_count = 0;
     memset(s_slots, 0, sizeof(s_slots));
+    s_slots_overflow = false;
+    s_scan_valid = false;
+    game_state_add_entity_listener(on_entity_event);
+    map_arena_on_reset(on_map_change);
     s_col_init = false;
     s_col_reach = IBUBBLE_SLIDE_REACH_MIN;
     ui_scroll_reset(&s_col_scroll);
@@ -371,28 +454,7 @@ void interaction_bubble_update(void) {
     float ease = s_col_slide_t * s_col_slide_t * (3.0f - 2.0f * s_col_slide_t);
     s_col_offset = -column_slide_width() * (1.0f - ease);
 
-    for (int i = 0; i < s_slot_count; i++)
-        s_slots[i].active = false;
-
-    /* Self-player is always scanned first → occupies slot 0. */
-    if (g_game_state.player_id[0] != '\0') {
-        scan_entity(g_game_state.player_id,
-                    &g_game_state.player.base, true, NULL, 0);
-    }
-
-    for (int i = 0; i < g_game_state.other_player_count; i++) {
-        scan_entity(
-            g_game_state.other_players[i].base.id,
-            &g_game_state.other_players[i].base,
-            true, NULL, 0
-        );
-    }
-
-    for (int i = 0; i < g_game_state.bot_count; i++) {
-        const BotState* bot = &g_game_state.bots[i];
-        if (bot->caster_id[0] != '\0') continue;
-        scan_entity(bot->base.id, &bot->base, false, bot->behavior, bot->interaction_flags);
-    }
+    sync_slots();
 
     double now = GetTime();
     int write = 0;
@@ -597,8 +659,8 @@ void interaction_bubble_draw(void) {
          * button) clears the count and hides this. Never intercepts taps. */
         const NotifyEntry* ne = notify_store_get(slot->entity_id);
         int notif = notification_target_total(slot->entity_id);
-        if (notif > 0 && ne && ne->count > 0 && ne->messages[ne->count - 1].text[0] != '\0') {
-            const NotifyMessage* last = &ne->messages[ne->count - 1];
+        if (notif > 0 && ne && ne->count > 0 && notify_store_last(ne)->text[0] != '\0') {
+            const NotifyMessage* last = notify_store_last(ne);
             int mfs = 11;
             char buf[48];
             strncpy(buf, last->text, sizeof(buf) - 1);
@@ -710,15 +772,16 @@ bool interaction_bubble_handle_wheel(float wheel_delta) {
 static void open_js_overlay_for_slot(InteractionBubbleSlot* slot, int initial_tab) {
     bool is_self = (strcmp(slot->entity_id, g_game_state.player_id) == 0);
     Color bc = status_border_color(slot, is_self);
-    js_interact_overlay_open(slot->entity_id,
-                             slot->display_name,
-                             slot->dialogue_item_id,
-                             slot->interact_flags,
-                             slot->is_player ? 1 : 0,
-                             is_self ? 1 : 0,
-                             (int)bc.r, (int)bc.g,
-                             (int)bc.b, (int)bc.a,
-                             initial_tab);
+    overlay_commands_open(&(OverlayOpenCommand){
+        .entity_id        = slot->entity_id,
+        .display_name     = slot->display_name,
+        .dialogue_item_id = slot->dialogue_item_id,
+        .interact_flags   = slot->interact_flags,
+        .is_player        = slot->is_player,
+        .is_self          = is_self,
+        .border           = { bc.r, bc.g, bc.b, bc.a },
+        .initial_tab      = initial_tab,
+    });
 
     int icon_lc = slot->alive_layer_count > 0
         ? slot->alive_layer_count : slot->layer_count;
@@ -728,10 +791,7 @@ static void open_js_overlay_for_slot(InteractionBubbleSlot* slot, int initial_ta
     LayerZEntry z_sorted[32];
     int z_count = layer_z_sort(icon_layers, icon_lc, z_sorted, 32, false);
 
-    char json[4096];
-    int off = 0;
-    json[off++] = '[';
-
+    OverlayStackItem items[32];
     for (int j = 0; j < z_count; j++) {
         const ObjectLayerState* ls = &icon_layers[z_sorted[j].index];
 
@@ -740,21 +800,13 @@ static void open_js_overlay_for_slot(InteractionBubbleSlot* slot, int initial_ta
         if (ol_data && ol_data->data.item.type[0] != '\0')
             item_type = ol_data->data.item.type;
 
-        bool has_dlg = dialogue_data_available(ls->item_id);
-
-        int wrote = snprintf(json + off, sizeof(json) - off,
-            "%s{\"itemId\":\"%s\",\"type\":\"%s\",\"hasDialogue\":%s}",
-            off > 1 ? "," : "",
-            ls->item_id,
-            item_type,
-            has_dlg ? "true" : "false");
-        if (wrote > 0 && off + wrote < (int)sizeof(json) - 2)
-            off += wrote;
+        items[j] = (OverlayStackItem){
+            .item_id      = ls->item_id,
+            .type         = item_type,
+            .has_dialogue = dialogue_data_available(ls->item_id),
+        };
     }
-
-    json[off++] = ']';
-    json[off] = '\0';
-    js_interact_overlay_set_ol_stack(json);
+    overlay_commands_ol_stack(items, z_count);
 }
 
 void interaction_bubble_open_js_overlay(const char* entity_id, int initial_tab) {
@@ -26,10 +26,13 @@
 #include "fx_inventory_bar_qty.h"
 #include "game_state.h"
 #include "item_slot.h"
+#include "ui/inventory_view.h"
 #include "object_layers_management.h"
 #include "ol_as_animated_ico.h"
 #include "ui_button.h"
+#include "ui_hit.h"
 #include "ui_toggle.h"
+#include "render_stats.h"
 
 #include <assert.h>
 #include <math.h>
@@ -110,45 +113,30 @@ static bool bar_slots_settled(void) {
  * (the world-drop pickup bot's default skin), or NULL. This is ONLY a
  * fallback icon for the pinned slot before any coin entry has arrived in
  * full_inventory (e.g. a fresh session with a zero balance) — it must never
- * be used for matching, see is_coin_item_id(). */
+ * be used for matching, see inventory_view.h. */
 static const char* coin_item_key(void) {
     const EntityTypeDefault* def = game_state_get_entity_default("coin");
     if (def && def->live_item_id_count > 0) return def->live_item_ids[0];
     return NULL;
 }
 
-/* is_coin_item_id classifies an inventory entry as currency via the item's
- * OWN type metadata (ObjectLayer.data.item.type == "coin") — the same
- * authoritative field layer_z_order.c uses to tell "skin" from "weapon".
- * This is deliberately independent of entity_defaults: the "coin" entity
- * type there describes the default sprite for world coin-pickup bots, not
- * the currency item's classification, so matching against it (as this used
- * to) missed real coin entries whenever their id wasn't also the pickup
- * bot's first registered skin — letting the coin fall through into the
- * scrollable list as an ordinary item. */
-static bool is_coin_item_id(const char* item_id) {
-    if (!item_id || item_id[0] == '\0') return false;
-    ObjectLayer* ol = lookup_cached_layer(item_id);
-    return ol && 0 == strcmp(ol->data.item.type, "coin");
-}
-
 /* find_coin_slot returns the index of the coin slot in full_inventory, or -1. */
 static int find_coin_slot(void) {
-    for (int i = 0; i < g_game_state.full_inventory_count; i++) {
-        if (is_coin_item_id(g_game_state.full_inventory[i].item_id)) return i;
-    }
-    return -1;
+    return inventory_view_coin_slot();
 }
 
 /* build_scroll_map fills `map` (vis index → full_inventory index) with the
- * scrollable slots: everything except the pinned coin slot and — unless
- * `include_hidden` — first-copy slots still awaiting their pickup flight.
- * Delivery targeting passes include_hidden=true so the flight aims at the
- * cell where the slot will reveal. Returns the slot count. */
-static int build_scroll_map(int coin_idx, int map[MAX_OBJECT_LAYERS], bool include_hidden) {
+ * scrollable slots: the inventory view's list (everything except the pinned
+ * coin slot) less — unless `include_hidden` — first-copy slots still
+ * awaiting their pickup flight. Delivery targeting passes include_hidden=true
+ * so the flight aims at the cell where the slot will reveal. Returns the slot
+ * count. */
+static int build_scroll_map(int map[MAX_OBJECT_LAYERS], bool include_hidden) {
+    const int* list = NULL;
+    int count = inventory_view_list(&list);
     int n = 0;
-    for (int i = 0; i < g_game_state.full_inventory_count && n < MAX_OBJECT_LAYERS; i++) {
-        if (i == coin_idx) continue;
+    for (int k = 0; k < count; k++) {
+        int i = list[k];
         if (!include_hidden &&
             !fx_inventory_bar_qty_slot_visible(g_game_state.full_inventory[i].item_id)) {
             continue;
@@ -208,7 +196,7 @@ static Rectangle coin_slot_rect(int screen_w, float bar_top) {
 /* Hold the offset inside range, killing any glide that runs into an edge. */
 static void clamp_scroll(void) {
     int map[MAX_OBJECT_LAYERS];
-    int count = build_scroll_map(find_coin_slot(), map, false);
+    int count = build_scroll_map(map, false);
     float max = max_scroll_px(GetScreenWidth(), count);
     if (s_scroll_px < 0.0f) { s_scroll_px = 0.0f; s_scroll_vel = 0.0f; }
     if (s_scroll_px > max)  { s_scroll_px = max;  s_scroll_vel = 0.0f; }
@@ -259,23 +247,26 @@ static void draw_coin_slot(Rectangle r, int coin_idx, ObjectLayersManager* mgr)
     }
 
     /* Coin balance from fast flat field */
+    static TextMemo s_coin_text;
     int balance = game_state_get_player_coins();
-    char buf[24];
-    if (balance >= 1000000)
-        snprintf(buf, sizeof(buf), "%.1fM", balance / 1000000.0f);
-    else if (balance >= 1000)
-        snprintf(buf, sizeof(buf), "%.1fk", balance / 1000.0f);
-    else
-        snprintf(buf, sizeof(buf), "%d", balance);
+    if (text_memo_changed(&s_coin_text, balance)) {
+        char* buf = s_coin_text.text;
+        if (balance >= 1000000)
+            snprintf(buf, sizeof(s_coin_text.text), "%.1fM", balance / 1000000.0f);
+        else if (balance >= 1000)
+            snprintf(buf, sizeof(s_coin_text.text), "%.1fk", balance / 1000.0f);
+        else
+            snprintf(buf, sizeof(s_coin_text.text), "%d", balance);
+    }
 
     /* Match the scrollable item slots' badge font size. */
     int fs = (int)(bar_slot_size() * 0.26f);
     if (fs < 13) fs = 13;
-    int tw = MeasureText(buf, fs);
+    int tw = text_memo_width(&s_coin_text, fs);
     int bx = (int)(r.x + r.width - tw - 3);
     int by = (int)(r.y + r.height - fs - 2);
     DrawRectangle(bx - 1, by - 1, tw + 2, fs + 2, (Color){0, 0, 0, 200});
-    DrawText(buf, bx, by, fs, C_COIN_QTY_TEXT);
+    DrawText(s_coin_text.text, bx, by, fs, C_COIN_QTY_TEXT);
 
     /* Small "lock" — coins are non-activable */
     int lfs = bar_qty_font() - 1;
@@ -395,7 +386,7 @@ void inventory_bar_draw(void) {
         int coin_idx = find_coin_slot();
         int vis      = visible_slot_count(screen_w);
         int scroll_map[MAX_OBJECT_LAYERS];
-        int scroll_count = build_scroll_map(coin_idx, scroll_map, false);
+        int scroll_count = build_scroll_map(scroll_map, false);
         float left  = strip_left();
         float right = strip_right(screen_w);
 
@@ -405,6 +396,7 @@ void inventory_bar_draw(void) {
             if (r.x >= right)          break;
 
             int inv_idx = scroll_map[si];
+            ui_hit_add(UI_HIT_BAR_SLOT, inv_idx, r);
             ObjectLayerState ol = g_game_state.full_inventory[inv_idx];
             ol.quantity = fx_inventory_bar_qty_display(ol.item_id, ol.quantity);
             /* During the arrival pulse the sprite renders in full colour. */
@@ -415,7 +407,9 @@ void inventory_bar_draw(void) {
                 fx_inventory_bar_qty_draw(r, g_game_state.full_inventory[inv_idx].item_id);
         }
 
+        /* Coin slot registers last: it sits above any strip slot under it. */
         Rectangle cr = coin_slot_rect(screen_w, current_bar_top);
+        ui_hit_add(UI_HIT_BAR_SLOT, coin_idx, cr);
         const char* coin_key = (coin_idx >= 0) ? g_game_state.full_inventory[coin_idx].item_id : coin_item_key();
         draw_coin_slot(scale_rect(cr, fx_inventory_bar_qty_slot_scale(coin_key)), coin_idx, s_ol_manager);
         if (bar_slots_settled()) fx_inventory_bar_qty_draw(cr, coin_key);
@@ -477,36 +471,10 @@ bool inventory_bar_point_covered(int mx, int my) {
 int inventory_bar_get_tapped_slot(int mx, int my) {
     ensure_bar_toggle();
     if (!s_bar_toggle.expanded) return -1;
-    int screen_w = GetScreenWidth();
-    int screen_h = GetScreenHeight();
-    float current_bar_top = bar_top(screen_h);
-
-    if ((float)my < current_bar_top || my > screen_h) return -1;
-
-    int coin_idx = find_coin_slot();
-
-    /* Coin slot: return coin idx so modal can show it */
-    Rectangle cr = coin_slot_rect(screen_w, current_bar_top);
-    if ((float)mx >= cr.x && (float)mx < cr.x + cr.width &&
-        (float)my >= cr.y && (float)my < cr.y + cr.height) {
-        return (coin_idx >= 0) ? coin_idx : -1;
-    }
-
-    int scroll_map[MAX_OBJECT_LAYERS];
-    int scroll_count = build_scroll_map(coin_idx, scroll_map, false);
-    float left  = strip_left();
-    float right = strip_right(screen_w);
-
-    for (int si = 0; si < scroll_count; si++) {
-        Rectangle r = slot_rect(si, current_bar_top);
-        if (r.x + r.width <= left) continue;
-        if (r.x >= right)          break;
-        if ((float)mx >= r.x && (float)mx < r.x + r.width &&
-            (float)my >= r.y && (float)my < r.y + r.height) {
-            return scroll_map[si];
-        }
-    }
-    return -1;
+    /* Slots and the coin slot as last drawn (ui_hit.h). */
+    UiHit hit;
+    if (!ui_hit_query((Vector2){ (float)mx, (float)my }, UI_HIT_BAR_SLOT, &hit)) return -1;
+    return hit.index;
 }
 
 bool inventory_bar_item_slot_center(const char* item_id, Vector2* out) {
@@ -542,7 +510,7 @@ bool inventory_bar_item_slot_center(const char* item_id, Vector2* out) {
      * the slot will reveal. */
     if (inv_idx >= 0) {
         int scroll_map[MAX_OBJECT_LAYERS];
-        int scroll_count = build_scroll_map(coin_idx, scroll_map, true);
+        int scroll_count = build_scroll_map(scroll_map, true);
         int si = -1;
         for (int k = 0; k < scroll_count; k++) {
             if (scroll_map[k] == inv_idx) { si = k; break; }
@@ -4,12 +4,13 @@
  *
  * Architecture notes:
  *   - The modal is purely a UI layer: it reads game state and sends intents.
- *   - Item metadata (description, stats) is fetched lazily via
- *     lookup_cached_layer() which caches results in the OL manager.
- *   - Activation intent is sent via network_send() as a JSON string
- *     matching the server's existing "item_activation" handler in
- *     handlers.go.  The server validates, swaps if needed, and pushes
- *     the updated state back in the next AOI frame.
+ *   - Item metadata (description, stats) of owned items comes from the
+ *     inventory view model, rebuilt only when the inventory or the OL
+ *     catalog changes; external items look it up via lookup_cached_layer().
+ *   - Activation intent is sent as an equip transaction (equip_txn.h),
+ *     which shows it in full_inventory at once.  The server validates,
+ *     swaps if needed, and pushes the updated state back in the next AOI
+ *     frame, settling the transaction.
  *   - The sprite preview uses ol_as_animated_ico so it plays the live
  *     animation for the selected direction/mode pair.
  *   - Direction (up/down/left/right) and mode (idle/walking) buttons let
@@ -20,6 +21,7 @@
 #include "inventory_modal.h"
 #include "text.h"
 
+#include "domain/equip_txn.h"
 #include "domain/local_player.h"
 #include "domain/viewport.h"
 #include "network/game_client.h"
@@ -39,7 +41,9 @@
 #include "ui_button.h"
 #include "ui_scroll.h"
 #include "ui_state.h"
+#include "ui/inventory_view.h"
 #include "world_types.h"
+#include "render_stats.h"
 
 #include <assert.h>
 #include <math.h>
@@ -283,10 +287,11 @@ static int modal_sprite_size(float card_w, float card_h) {
     return s;
 }
 
+/* One-item equip transaction: shown at once, settled by the echo. */
 static void send_activation(const char* item_id, bool active) {
-    BinWriter w;
-    uplink_item_activation(&w, item_id, active);
-    network_send_binary(w.buf, w.pos);
+    equip_txn_begin();
+    equip_txn_set(item_id, active);
+    equip_txn_commit();
 }
 
 static void send_freeze(bool start) {
@@ -329,8 +334,7 @@ static bool dir_has_frames(AtlasSpriteSheetData* atlas,
     if (!atlas) return false;
     char full[48];
     snprintf(full, sizeof(full), "%s_%s", dir, mode);
-    const DirectionFrameData* dfd = atlas_get_direction_frames(atlas, full);
-    return (dfd && dfd->count > 0);
+    return atlas_get_direction_frames(atlas, full).count > 0;
 }
 
 /* resolve_summoned_item_id resolves the summonedEntityItemId for display.
@@ -341,17 +345,12 @@ static const char* resolve_summoned_item_id(const char* raw_id) {
     static char s_resolved[MAX_ID_LENGTH];
     if (strcmp(raw_id, "$active_skin") != 0) return raw_id;
 
-    /* Walk the player's full inventory to find the first active skin. */
-    for (int i = 0; i < g_game_state.full_inventory_count; i++) {
-        const ObjectLayerState* ol = &g_game_state.full_inventory[i];
-        if (!ol->active || ol->item_id[0] == '\0') continue;
-        if (!s_ol_manager) continue;
-        ObjectLayer* data = lookup_cached_layer(ol->item_id);
-        if (data && strcmp(data->data.item.type, "skin") == 0) {
-            strncpy(s_resolved, ol->item_id, MAX_ID_LENGTH - 1);
-            s_resolved[MAX_ID_LENGTH - 1] = '\0';
-            return s_resolved;
-        }
+    /* The inventory view tracks the first active skin. */
+    int skin = s_ol_manager ? inventory_view_active_skin() : -1;
+    if (skin >= 0) {
+        strncpy(s_resolved, g_game_state.full_inventory[skin].item_id, MAX_ID_LENGTH - 1);
+        s_resolved[MAX_ID_LENGTH - 1] = '\0';
+        return s_resolved;
     }
     /* Fallback if no active skin found */
     strncpy(s_resolved, raw_id, MAX_ID_LENGTH - 1);
@@ -378,6 +377,14 @@ static const ObjectLayerState* current_ols(void) {
     return NULL;
 }
 
+/* Metadata of the shown item: prepared by the inventory view for an owned
+ * slot, looked up for an external one. NULL until it arrives. */
+static ObjectLayer* current_layer(const ObjectLayerState* ols) {
+    if (!s_ol_manager) return NULL;
+    if (s_is_external) return lookup_cached_layer(ols->item_id);
+    return inventory_view_item(s_inv_idx)->layer;
+}
+
 static void reset_view_state(void) {
     s_age = 0.0f;
     strncpy(s_dir,  "down", sizeof(s_dir)  - 1);
@@ -690,12 +697,14 @@ void inventory_modal_draw(void) {
     int st_effect = 0, st_resist = 0, st_agility = 0;
     int st_range  = 0, st_intel  = 0, st_utility  = 0;
     bool activable = true;
+    ObjectLayerType item_kind = OBJECT_LAYER_TYPE_UNKNOWN;
 
-    if (s_ol_manager) {
-        ObjectLayer* ol_data = lookup_cached_layer(ols->item_id);
+    {
+        ObjectLayer* ol_data = current_layer(ols);
         if (ol_data) {
             if (ol_data->data.item.id[0] != '\0') item_name = ol_data->data.item.id;
             item_type   = ol_data->data.item.type;
+            item_kind   = ol_data->data.item.type_kind;
             item_desc   = ol_data->data.item.description;
             activable   = ol_data->data.item.activable;
             st_effect   = ol_data->data.stats.effect;
@@ -817,14 +826,15 @@ void inventory_modal_draw(void) {
     s_skill_arrows_visible = false;
     s_skill_total = 0;
     if (ols->item_id[0] != '\0') {
-        /* First pass: count matching skills */
+        /* First pass: this item's skills that summon something */
         int match_indices[UI_STATE_MAX_SKILL_ENTRIES];
         int match_count = 0;
-        int total = ui_state_skill_count();
-        for (int si = 0; si < total; si++) {
+        const int* item_skills = NULL;
+        int total = ui_state_skills_for_item(ols->item_id, &item_skills);
+        for (int k = 0; k < total; k++) {
+            int si = item_skills[k];
             const UiSkillEntry* se = ui_state_skill_at(si);
-            if (!se || strcmp(se->trigger_item_id, ols->item_id) != 0) continue;
-            if (se->summoned_entity_item_id[0] == '\0') continue;
+            if (!se || se->summoned_entity_item_id[0] == '\0') continue;
             if (match_count < UI_STATE_MAX_SKILL_ENTRIES)
                 match_indices[match_count++] = si;
         }
@@ -1004,7 +1014,7 @@ void inventory_modal_draw(void) {
             /* Active skins cannot be deactivated when requireSkin is set.
              * Fragments are exempt: the server swaps in the hidden default
              * dead skin, so the rule is never violated. */
-            if (currently_active && !is_fragment && strcmp(item_type, "skin") == 0
+            if (currently_active && !is_fragment && OBJECT_LAYER_TYPE_SKIN == item_kind
                 && g_game_state.equipment_rules.require_skin)
                 btn_enabled = false;
         }
@@ -1082,12 +1092,12 @@ bool inventory_modal_handle_click(int mx, int my) {
         const ObjectLayerState* ols = &g_game_state.full_inventory[s_inv_idx];
         bool activable = true;
         const char* item_type = "";
-        if (s_ol_manager) {
-            ObjectLayer* ol_data = lookup_cached_layer(ols->item_id);
-            if (ol_data) {
-                activable = ol_data->data.item.activable;
-                item_type = ol_data->data.item.type;
-            }
+        ObjectLayerType item_kind = OBJECT_LAYER_TYPE_UNKNOWN;
+        const InventoryViewItem* view = inventory_view_item(s_inv_idx);
+        if (s_ol_manager && view->layer) {
+            activable = 0 != (view->flags & INVENTORY_VIEW_ACTIVABLE);
+            item_type = view->layer->data.item.type;
+            item_kind = view->type;
         }
         bool is_fragment = game_state_is_dead_item(ols->item_id);
         bool btn_enabled = activable &&
@@ -1095,7 +1105,7 @@ bool inventory_modal_handle_click(int mx, int my) {
         if (btn_enabled && item_type[0] != '\0') {
             if (!game_state_is_active_item_type(item_type))
                 btn_enabled = false;
-            if (ols->active && !is_fragment && strcmp(item_type, "skin") == 0
+            if (ols->active && !is_fragment && OBJECT_LAYER_TYPE_SKIN == item_kind
                 && g_game_state.equipment_rules.require_skin)
                 btn_enabled = false;
         }
@@ -25,13 +25,13 @@
  *
  * Interaction model:
  *   1. Caller opens the modal by providing the full_inventory index.
- *   2. User taps Activate / Deactivate → modal calls network_send() with
- *      a JSON "item_activation" message and closes itself.
+ *   2. User taps Activate / Deactivate → modal commits a one-item equip
+ *      transaction (domain/equip_txn.h) and closes itself.
  *   3. User taps X or outside the card → modal closes with no action.
  *   4. Server responds with the next AOI frame reflecting the change.
  *
- * The modal never mutates local game state — it sends an intent to the
- * server and the updated state arrives on the next AOI push.
+ * The modal itself never mutates game state; the transaction shows the
+ * new flag optimistically until the AOI push confirms or reverts it.
  *
  * Call sequence (each frame while modal is open):
  *   inventory_modal_update(dt);    — advance animation
@@ -0,0 +1,81 @@
+#include "ui/inventory_view.h"
+
+#include "game_state.h"
+#include "object_layers_management.h"
+
+#include <assert.h>
+#include <stdbool.h>
+
+static struct {
+    bool              built;
+    uint32_t          inventory_version;
+    unsigned          catalog_generation;
+    InventoryViewItem items[MAX_OBJECT_LAYERS];
+    int               list[MAX_OBJECT_LAYERS];
+    int               list_count;
+    int               coin_slot;
+    int               active_skin;
+} g_inventory_view;
+
+static void view_rebuild(void) {
+    g_inventory_view.list_count  = 0;
+    g_inventory_view.coin_slot   = -1;
+    g_inventory_view.active_skin = -1;
+
+    for (int i = 0; i < g_game_state.full_inventory_count; i++) {
+        const ObjectLayerState* slot = &g_game_state.full_inventory[i];
+        InventoryViewItem* item = &g_inventory_view.items[i];
+        *item = (InventoryViewItem){ .type = OBJECT_LAYER_TYPE_UNKNOWN };
+        if ('\0' != slot->item_id[0]) item->layer = lookup_cached_layer(slot->item_id);
+        if (item->layer) {
+            item->type = item->layer->data.item.type_kind;
+            if (item->layer->data.item.activable) item->flags |= INVENTORY_VIEW_ACTIVABLE;
+        }
+
+        if (OBJECT_LAYER_TYPE_COIN == item->type && 0 > g_inventory_view.coin_slot) {
+            g_inventory_view.coin_slot = i;
+            continue;
+        }
+        if (OBJECT_LAYER_TYPE_SKIN == item->type && slot->active &&
+            0 > g_inventory_view.active_skin) {
+            g_inventory_view.active_skin = i;
+        }
+        g_inventory_view.list[g_inventory_view.list_count++] = i;
+    }
+}
+
+static void view_sync(void) {
+    uint32_t version = g_game_state.inventory_version;
+    unsigned catalog = obj_layers_mgr_catalog_generation();
+    if (g_inventory_view.built && version == g_inventory_view.inventory_version &&
+        catalog == g_inventory_view.catalog_generation) {
+        return;
+    }
+    view_rebuild();
+    g_inventory_view.built              = true;
+    g_inventory_view.inventory_version  = version;
+    g_inventory_view.catalog_generation = catalog;
+}
+
+const InventoryViewItem* inventory_view_item(int inv_idx) {
+    assert(0 <= inv_idx && g_game_state.full_inventory_count > inv_idx);
+    view_sync();
+    return &g_inventory_view.items[inv_idx];
+}
+
+int inventory_view_coin_slot(void) {
+    view_sync();
+    return g_inventory_view.coin_slot;
+}
+
+int inventory_view_active_skin(void) {
+    view_sync();
+    return g_inventory_view.active_skin;
+}
+
+int inventory_view_list(const int** out) {
+    assert(out);
+    view_sync();
+    *out = g_inventory_view.list;
+    return g_inventory_view.list_count;
+}
@@ -0,0 +1,44 @@
+#ifndef CYBERIA_UI_INVENTORY_VIEW_H
+#define CYBERIA_UI_INVENTORY_VIEW_H
+
+#include <stdint.h>
+
+#include "object_layer.h"
+
+/* inventory_view — the self-player's inventory prepared for the UIs.
+ *
+ * One entry per g_game_state.full_inventory slot, holding the resolved
+ * ObjectLayer and its parsed item type, plus the slot groups the inventory
+ * bar lays out: the pinned coin slot, the remaining slots in inventory order
+ * and the active skin. Rebuilt on the first read after full_inventory
+ * changes (GameState.inventory_version) or the layer catalog does
+ * (obj_layers_mgr_catalog_generation, which also frees old layer pointers),
+ * so the bar and the item modal read prepared arrays instead of resolving
+ * and string-matching every slot each frame.
+ *
+ * Currency is classified by the item's OWN type metadata (Item.type "coin")
+ * — never by entity_defaults, whose "coin" entry describes the world
+ * pickup bot's sprite, not the currency item. */
+
+#define INVENTORY_VIEW_ACTIVABLE 0x01u   /* metadata allows activation */
+
+typedef struct {
+    ObjectLayer*    layer;   /* NULL until the item's metadata arrives */
+    ObjectLayerType type;    /* OBJECT_LAYER_TYPE_UNKNOWN without metadata */
+    uint8_t         flags;   /* INVENTORY_VIEW_* */
+} InventoryViewItem;
+
+/* Entry for full_inventory[inv_idx]; inv_idx must be a live slot. */
+const InventoryViewItem* inventory_view_item(int inv_idx);
+
+/* full_inventory index of the coin slot, or -1. */
+int inventory_view_coin_slot(void);
+
+/* full_inventory index of the first active skin, or -1. */
+int inventory_view_active_skin(void);
+
+/* Every slot but the coin slot, as full_inventory indices in inventory
+ * order. Valid until the next inventory_view_* call after a change. */
+int inventory_view_list(const int** out);
+
+#endif /* CYBERIA_UI_INVENTORY_VIEW_H */
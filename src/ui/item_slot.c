@@ -6,6 +6,7 @@
 #include "ol_as_animated_ico.h"
 #include "world_types.h"
 #include "ui_button.h"
+#include "render_stats.h"
 
 #include <stdio.h>
 
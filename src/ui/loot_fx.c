@@ -1,8 +1,12 @@
 #include "ui/loot_fx.h"
 
+#include "entity_index.h"
 #include "game_render.h"
 #include "game_state.h"
+#include "map_arena.h"
+#include "ui/fx_particles.h"
 #include "ui/fx_inventory_bar_qty.h"
+#include "ui/fx_shapes.h"
 #include "ui/inventory_bar.h"
 #include "world_types.h"
 
@@ -14,8 +18,6 @@
 
 #define LOOT_FX_MAX          64      /* concurrent vacuum flights               */
 #define LOOT_DROP_MAX        128     /* concurrent in-world drop animations     */
-#define LOOT_PARTICLE_MAX    512     /* pooled world-space burst particles      */
-#define LOOT_SCR_PARTICLE_MAX 256    /* pooled screen-space delivery particles  */
 #define LOOT_PENDING_MAX     32      /* scheduled slot-arrival bursts           */
 
 /* Stage 3 — vacuum flight (ground → player). The token pops larger the moment
@@ -116,11 +118,10 @@ typedef struct {
     bool  have_target;
     float age;
     float cur_x, cur_y, size, alpha;
-    bool  active;
 } VacFlight;
 
 typedef struct {
-    char   drop_id[MAX_ID_LENGTH];
+    char   drop_id[MAX_ID_LENGTH];   /* first: s_drop_index reads it         */
     float  origin_x, origin_y;   /* launch start (corpse center)              */
     float  landing_x, landing_y; /* launch end / idle anchor                  */
     double launch_start;         /* s_clock at launch                          */
@@ -130,35 +131,13 @@ typedef struct {
     double next_emit;            /* s_clock at which the next ambient spark fires */
     bool   collected;            /* in-world render yields to vacuum flight    */
     bool   eligible;             /* local player may collect (AOI per-viewer flag) */
-    bool   active;
 } DropAnim;
 
-typedef struct {
-    float   x, y, vx, vy;
-    float   age, ttl;
-    float   size;
-    uint8_t tint;
-    bool    active;
-} Particle;
-
-/* Screen-space particle: homing (avatar → slot) or ballistic burst (at slot). */
-typedef struct {
-    uint8_t mode;          /* 0 = homing, 1 = burst                            */
-    float   x, y;          /* current screen px                                */
-    float   sx, sy, tx, ty;/* homing endpoints                                 */
-    float   vx, vy;        /* burst velocity, px/s                             */
-    float   age, ttl;
-    float   size;          /* px                                              */
-    uint8_t tint;
-    bool    active;
-} ScrParticle;
-
 /* A slot-arrival burst scheduled to fire when a delivery stream lands. */
 typedef struct {
     float  tx, ty;
     char   item_id[MAX_ITEM_ID_LENGTH];
     double fire_at;
-    bool   active;
 } PendingArrival;
 
 /* The item icon flying with a delivery stream (screen space). */
@@ -166,16 +145,25 @@ typedef struct {
     char  item_id[MAX_ITEM_ID_LENGTH];
     float sx, sy, tx, ty;
     float age, ttl;
-    bool  active;
 } DeliveryToken;
 
+/* Every pool keeps its live entries packed at [0, count): spawns append and
+ * expiry moves the last entry into the hole, so the update pass and the
+ * renderer bridges only ever touch live effects. Drops are looked up by id
+ * through s_drop_index, rebuilt whenever entries move. Sparks are emitted
+ * into the shared fx_particles store. */
 static VacFlight      s_flights[LOOT_FX_MAX];
 static DropAnim       s_drops[LOOT_DROP_MAX];
-static Particle       s_particles[LOOT_PARTICLE_MAX];
-static ScrParticle    s_scr[LOOT_SCR_PARTICLE_MAX];
 static PendingArrival s_pending[LOOT_PENDING_MAX];
 static DeliveryToken  s_tokens[TOKEN_MAX];
 
+static int s_flight_count;
+static int s_drop_count;
+static int s_pending_count;
+static int s_token_count;
+
+static EntityIndex s_drop_index = { .records = s_drops, .stride = sizeof(DropAnim) };
+
 /* Presentation clock, advanced only by loot_fx_update — keeps launch/idle
  * timing independent of the raylib frame clock and of message arrival time. */
 static double s_clock = 0.0;
@@ -199,40 +187,51 @@ static void spawn_ambient(float wx, float wy, uint8_t tint);
 
 /* ── Lifecycle ──────────────────────────────────────────────────────────── */
 
+/* Map change: the world-space drops and flights belong to the old map.
+ * Screen-space deliveries and arrivals finish. */
+static void on_map_change(void) {
+    s_flight_count = 0;
+    s_drop_count   = 0;
+    entity_index_clear(&s_drop_index);
+}
+
 void loot_fx_reset(void) {
-    memset(s_flights, 0, sizeof(s_flights));
-    memset(s_drops, 0, sizeof(s_drops));
-    memset(s_particles, 0, sizeof(s_particles));
-    memset(s_scr, 0, sizeof(s_scr));
-    memset(s_pending, 0, sizeof(s_pending));
-    memset(s_tokens, 0, sizeof(s_tokens));
+    map_arena_on_reset(on_map_change);
+    s_flight_count   = 0;
+    s_drop_count     = 0;
+    s_pending_count  = 0;
+    s_token_count    = 0;
+    entity_index_clear(&s_drop_index);
     s_clock = 0.0;
 }
 
 /* ── Drop animation registry (stages 1–2) ──────────────────────────────── */
 
 static DropAnim* drop_find(const char* drop_id) {
-    for (int i = 0; i < LOOT_DROP_MAX; i++) {
-        if (s_drops[i].active && 0 == strcmp(s_drops[i].drop_id, drop_id))
-            return &s_drops[i];
-    }
-    return NULL;
+    int i = entity_index_find(&s_drop_index, drop_id, entity_index_hash(drop_id));
+    return (0 <= i) ? &s_drops[i] : NULL;
 }
 
+/* Appends while there is room; a full registry recycles the drop seen
+ * longest ago. */
 static DropAnim* drop_alloc(const char* drop_id) {
-    DropAnim* slot = NULL;
-    double oldest = 1e18;
-    int    oldest_i = 0;
-    for (int i = 0; i < LOOT_DROP_MAX; i++) {
-        if (!s_drops[i].active) { slot = &s_drops[i]; break; }
-        if (s_drops[i].last_seen < oldest) { oldest = s_drops[i].last_seen; oldest_i = i; }
+    bool evicted = LOOT_DROP_MAX <= s_drop_count;
+    int  i = s_drop_count;
+    if (evicted) {
+        i = 0;
+        for (int j = 1; j < LOOT_DROP_MAX; j++) {
+            if (s_drops[j].last_seen < s_drops[i].last_seen) i = j;
+        }
+    } else {
+        s_drop_count++;
     }
-    if (!slot) slot = &s_drops[oldest_i];
+    DropAnim* slot = &s_drops[i];
     memset(slot, 0, sizeof(*slot));
     strncpy(slot->drop_id, drop_id, MAX_ID_LENGTH - 1);
     slot->phase     = id_phase(drop_id);
     slot->last_seen = s_clock;
-    slot->active    = true;
+    if (evicted) entity_index_rebuild(&s_drop_index, s_drop_count);
+    else entity_index_insert(&s_drop_index, entity_index_hash(slot->drop_id), i);
     return slot;
 }
 
@@ -325,85 +324,85 @@ bool loot_fx_drop_render_pos(const char* drop_id,
 
 /* ── Particle burst (stage 3) ──────────────────────────────────────────── */
 
-static Particle* particle_alloc(void) {
-    for (int i = 0; i < LOOT_PARTICLE_MAX; i++) {
-        if (!s_particles[i].active) return &s_particles[i];
-    }
-    return NULL;
+static Color tint_color(uint8_t tint) {
+    return (LOOT_FX_TINT_GRAY == tint) ? FX_SPARK_GRAY : FX_SPARK_GOLD;
 }
 
 /* Big treasure burst fired the moment the drop is taken. */
 static void spawn_burst(float wx, float wy, uint8_t tint) {
     for (int n = 0; n < BURST_COUNT; n++) {
-        Particle* p = particle_alloc();
-        if (!p) return;
-        p->x    = wx;
-        p->y    = wy;
-        p->vx   = lcg_range(-BURST_SPREAD, BURST_SPREAD);
-        p->vy   = -lcg_range(BURST_UP_MIN, BURST_UP_MAX);
-        p->age  = 0.0f;
-        p->ttl  = lcg_range(BURST_TTL_MIN, BURST_TTL_MAX);
-        p->size = lcg_range(BURST_SIZE_MIN, BURST_SIZE_MAX);
-        p->tint = tint;
-        p->active = true;
+        float vx = lcg_range(-BURST_SPREAD, BURST_SPREAD);
+        float vy = -lcg_range(BURST_UP_MIN, BURST_UP_MAX);
+        float ttl = lcg_range(BURST_TTL_MIN, BURST_TTL_MAX);
+        bool spawned = fx_particles_spawn(&(FxParticle){
+            .space   = FX_SPACE_WORLD,
+            .motion  = FX_MOTION_BALLISTIC,
+            .x       = wx,
+            .y       = wy,
+            .vx      = vx,
+            .vy      = vy,
+            .gravity = PART_GRAVITY,
+            .ttl     = ttl,
+            .size    = lcg_range(BURST_SIZE_MIN, BURST_SIZE_MAX),
+            .color   = tint_color(tint),
+        });
+        if (!spawned) return;
     }
 }
 
 /* One gentle ambient spark drifting off the idle floating token. */
 static void spawn_ambient(float wx, float wy, uint8_t tint) {
-    Particle* p = particle_alloc();
-    if (!p) return;
-    p->x    = wx + lcg_range(-AMBIENT_OFFSET, AMBIENT_OFFSET);
-    p->y    = wy + lcg_range(-AMBIENT_OFFSET, AMBIENT_OFFSET);
-    p->vx   = lcg_range(-AMBIENT_SPREAD, AMBIENT_SPREAD);
-    p->vy   = -lcg_range(AMBIENT_UP_MIN, AMBIENT_UP_MAX);
-    p->age  = 0.0f;
-    p->ttl  = lcg_range(AMBIENT_TTL_MIN, AMBIENT_TTL_MAX);
-    p->size = lcg_range(AMBIENT_SIZE_MIN, AMBIENT_SIZE_MAX);
-    p->tint = tint;
-    p->active = true;
+    float x   = wx + lcg_range(-AMBIENT_OFFSET, AMBIENT_OFFSET);
+    float y   = wy + lcg_range(-AMBIENT_OFFSET, AMBIENT_OFFSET);
+    float vx  = lcg_range(-AMBIENT_SPREAD, AMBIENT_SPREAD);
+    float vy  = -lcg_range(AMBIENT_UP_MIN, AMBIENT_UP_MAX);
+    float ttl = lcg_range(AMBIENT_TTL_MIN, AMBIENT_TTL_MAX);
+    fx_particles_spawn(&(FxParticle){
+        .space   = FX_SPACE_WORLD,
+        .motion  = FX_MOTION_BALLISTIC,
+        .x       = x,
+        .y       = y,
+        .vx      = vx,
+        .vy      = vy,
+        .gravity = PART_GRAVITY,
+        .ttl     = ttl,
+        .size    = lcg_range(AMBIENT_SIZE_MIN, AMBIENT_SIZE_MAX),
+        .color   = tint_color(tint),
+    });
 }
 
 /* ── Screen-space slot delivery (stage 4) ──────────────────────────────── */
 
-static ScrParticle* scr_alloc(void) {
-    for (int i = 0; i < LOOT_SCR_PARTICLE_MAX; i++) {
-        if (!s_scr[i].active) return &s_scr[i];
-    }
-    return NULL;
-}
-
 /* Burst of screen particles popping outward at the destination slot. */
 static void spawn_slot_arrival(float sx, float sy) {
     for (int n = 0; n < ARRIVAL_COUNT; n++) {
-        ScrParticle* p = scr_alloc();
-        if (!p) return;
         float ang = lcg_range(0.0f, 6.2831853f);
         float spd = lcg_range(ARRIVAL_SPEED_MIN, ARRIVAL_SPEED_MAX);
-        *p = (ScrParticle){
-            .mode   = 1,
-            .x      = sx,
-            .y      = sy,
-            .vx     = cosf(ang) * spd,
-            .vy     = sinf(ang) * spd - ARRIVAL_UP_BIAS,
-            .ttl    = ARRIVAL_TTL * lcg_range(0.8f, 1.2f),
-            .size   = lcg_range(ARRIVAL_SIZE_MIN, ARRIVAL_SIZE_MAX),
-            .tint   = LOOT_FX_TINT_GOLD,
-            .active = true,
-        };
+        float ttl = ARRIVAL_TTL * lcg_range(0.8f, 1.2f);
+        bool spawned = fx_particles_spawn(&(FxParticle){
+            .space   = FX_SPACE_SCREEN,
+            .motion  = FX_MOTION_BALLISTIC,
+            .x       = sx,
+            .y       = sy,
+            .vx      = cosf(ang) * spd,
+            .vy      = sinf(ang) * spd - ARRIVAL_UP_BIAS,
+            .gravity = ARRIVAL_GRAVITY,
+            .ttl     = ttl,
+            .size    = lcg_range(ARRIVAL_SIZE_MIN, ARRIVAL_SIZE_MAX),
+            .color   = FX_SPARK_GOLD,
+            .fade    = true,
+        });
+        if (!spawned) return;
     }
 }
 
 /* The item icon riding a stream, drawn above the particles. */
 static void spawn_delivery_token(float from_x, float from_y, float to_x, float to_y,
                                  const char* item_id, float ttl) {
-    DeliveryToken* t = NULL;
-    for (int i = 0; i < TOKEN_MAX; i++) {
-        if (!s_tokens[i].active) { t = &s_tokens[i]; break; }
-    }
-    if (!t) return;
+    if (TOKEN_MAX <= s_token_count) return;
+    DeliveryToken* t = &s_tokens[s_token_count++];
     *t = (DeliveryToken){ .sx = from_x, .sy = from_y, .tx = to_x, .ty = to_y,
-                          .ttl = ttl, .active = true };
+                          .ttl = ttl };
     if (item_id) strncpy(t->item_id, item_id, MAX_ITEM_ID_LENGTH - 1);
 }
 
@@ -412,37 +411,37 @@ static void spawn_delivery_token(float from_x, float from_y, float to_x, float t
 static void spawn_slot_delivery(float from_x, float from_y, float to_x, float to_y,
                                 const char* item_id) {
     spawn_delivery_token(from_x, from_y, to_x, to_y, item_id, DELIVER_TTL);
+    /* Constant-speed horizontal travel with a vertical parabolic arc, so each
+     * spark tosses up and settles into the slot rather than darting in. */
     for (int n = 0; n < DELIVER_COUNT; n++) {
-        ScrParticle* p = scr_alloc();
-        if (!p) break;
-        float sx = from_x + lcg_range(-DELIVER_START_SPREAD, DELIVER_START_SPREAD);
-        float sy = from_y + lcg_range(-DELIVER_START_SPREAD, DELIVER_START_SPREAD);
-        *p = (ScrParticle){
-            .mode   = 0,
+        float sx  = from_x + lcg_range(-DELIVER_START_SPREAD, DELIVER_START_SPREAD);
+        float sy  = from_y + lcg_range(-DELIVER_START_SPREAD, DELIVER_START_SPREAD);
+        float tx  = to_x + lcg_range(-DELIVER_TARGET_JIT, DELIVER_TARGET_JIT);
+        float ty  = to_y + lcg_range(-DELIVER_TARGET_JIT, DELIVER_TARGET_JIT);
+        float ttl = DELIVER_TTL * lcg_range(0.85f, 1.15f);
+        bool spawned = fx_particles_spawn(&(FxParticle){
+            .space  = FX_SPACE_SCREEN,
+            .motion = FX_MOTION_ARC,
             .x      = sx,
             .y      = sy,
-            .sx     = sx,
-            .sy     = sy,
-            .tx     = to_x + lcg_range(-DELIVER_TARGET_JIT, DELIVER_TARGET_JIT),
-            .ty     = to_y + lcg_range(-DELIVER_TARGET_JIT, DELIVER_TARGET_JIT),
-            .ttl    = DELIVER_TTL * lcg_range(0.85f, 1.15f),
+            .tx     = tx,
+            .ty     = ty,
+            .arc    = DELIVER_ARC_PX,
+            .ttl    = ttl,
             .size   = lcg_range(DELIVER_SIZE_MIN, DELIVER_SIZE_MAX),
-            .tint   = LOOT_FX_TINT_GOLD,
-            .active = true,
-        };
+            .color  = FX_SPARK_GOLD,
+            .fade   = true,
+        });
+        if (!spawned) break;
     }
 
-    for (int i = 0; i < LOOT_PENDING_MAX; i++) {
-        if (!s_pending[i].active) {
-            s_pending[i] = (PendingArrival){
-                .tx = to_x, .ty = to_y,
-                .fire_at = s_clock + DELIVER_TTL,
-                .active = true,
-            };
-            if (item_id) strncpy(s_pending[i].item_id, item_id, MAX_ITEM_ID_LENGTH - 1);
-            break;
-        }
-    }
+    if (LOOT_PENDING_MAX <= s_pending_count) return;
+    PendingArrival* a = &s_pending[s_pending_count++];
+    *a = (PendingArrival){
+        .tx = to_x, .ty = to_y,
+        .fire_at = s_clock + DELIVER_TTL,
+    };
+    if (item_id) strncpy(a->item_id, item_id, MAX_ITEM_ID_LENGTH - 1);
 }
 
 /* On a local-player vacuum landing, hand off to the inventory slot: convert the
@@ -488,23 +487,23 @@ void loot_fx_slot_expend_at(const char* item_id, float from_x, float from_y) {
     spawn_delivery_token(from_x, from_y, ttx, tty, item_id, EXPEND_TTL);
 
     for (int n = 0; n < EXPEND_COUNT; n++) {
-        ScrParticle* p = scr_alloc();
-        if (!p) break;
         float tx, ty;
         expend_target(from_x, from_y, &tx, &ty);
-        *p = (ScrParticle){
-            .mode   = 0,
+        float ttl = EXPEND_TTL * lcg_range(0.9f, 1.1f);
+        bool spawned = fx_particles_spawn(&(FxParticle){
+            .space  = FX_SPACE_SCREEN,
+            .motion = FX_MOTION_ARC,
             .x      = from_x,
             .y      = from_y,
-            .sx     = from_x,
-            .sy     = from_y,
             .tx     = tx,
             .ty     = ty,
-            .ttl    = EXPEND_TTL * lcg_range(0.9f, 1.1f),
+            .arc    = DELIVER_ARC_PX,
+            .ttl    = ttl,
             .size   = lcg_range(EXPEND_SIZE_MIN, EXPEND_SIZE_MAX),
-            .tint   = LOOT_FX_TINT_GOLD,
-            .active = true,
-        };
+            .color  = FX_SPARK_GOLD,
+            .fade   = true,
+        });
+        if (!spawned) break;
     }
 }
 
@@ -542,14 +541,16 @@ void loot_fx_push(const char* drop_id, const char* collector_id,
                 eligible ? LOOT_FX_TINT_GOLD : LOOT_FX_TINT_GRAY);
 
     /* Arm the detached vacuum flight. */
-    VacFlight* slot = NULL;
-    float oldest = -1.0f;
-    int   oldest_i = 0;
-    for (int i = 0; i < LOOT_FX_MAX; i++) {
-        if (!s_flights[i].active) { slot = &s_flights[i]; break; }
-        if (s_flights[i].age > oldest) { oldest = s_flights[i].age; oldest_i = i; }
+    int i = s_flight_count;
+    if (LOOT_FX_MAX <= s_flight_count) {
+        i = 0;
+        for (int j = 1; j < LOOT_FX_MAX; j++) {
+            if (s_flights[j].age > s_flights[i].age) i = j;
+        }
+    } else {
+        s_flight_count++;
     }
-    if (!slot) slot = &s_flights[oldest_i];
+    VacFlight* slot = &s_flights[i];
 
     memset(slot, 0, sizeof(*slot));
     strncpy(slot->item_id, item_id, MAX_ITEM_ID_LENGTH - 1);
@@ -560,20 +561,19 @@ void loot_fx_push(const char* drop_id, const char* collector_id,
     slot->cur_y   = world_y;
     slot->size    = VAC_BASE_SIZE;
     slot->alpha   = 1.0f;
-    slot->active  = true;
 }
 
 bool loot_fx_inbound_to_inventory(const char* item_id) {
     if (!item_id || item_id[0] == '\0') return false;
-    for (int i = 0; i < LOOT_FX_MAX; i++) {
+    for (int i = 0; i < s_flight_count; i++) {
         const VacFlight* f = &s_flights[i];
-        if (f->active && 0 == strcmp(f->item_id, item_id) &&
+        if (0 == strcmp(f->item_id, item_id) &&
             0 == strcmp(f->collector_id, g_game_state.player_id)) {
             return true;
         }
     }
-    for (int i = 0; i < LOOT_PENDING_MAX; i++) {
-        if (s_pending[i].active && 0 == strcmp(s_pending[i].item_id, item_id)) {
+    for (int i = 0; i < s_pending_count; i++) {
+        if (0 == strcmp(s_pending[i].item_id, item_id)) {
             return true;
         }
     }
@@ -588,15 +588,11 @@ static bool resolve_collector_center(const char* collector_id, float* cx, float*
         *cy = gs->player.base.interp_pos.y + gs->player.base.dims.y * 0.5f;
         return true;
     }
-    for (int i = 0; i < gs->other_player_count; i++) {
-        const PlayerState* p = &gs->other_players[i];
-        if (0 == strcmp(p->base.id, collector_id)) {
-            *cx = p->base.interp_pos.x + p->base.dims.x * 0.5f;
-            *cy = p->base.interp_pos.y + p->base.dims.y * 0.5f;
-            return true;
-        }
-    }
-    return false;
+    const PlayerState* p = game_state_find_player(collector_id);
+    if (!p) return false;
+    *cx = p->base.interp_pos.x + p->base.dims.x * 0.5f;
+    *cy = p->base.interp_pos.y + p->base.dims.y * 0.5f;
+    return true;
 }
 
 /* ── Per-frame integration ─────────────────────────────────────────────── */
@@ -605,15 +601,14 @@ void loot_fx_update(float dt) {
     s_clock += dt;
 
     /* Vacuum flights. */
-    for (int i = 0; i < LOOT_FX_MAX; i++) {
+    for (int i = 0; i < s_flight_count;) {
         VacFlight* f = &s_flights[i];
-        if (!f->active) continue;
 
         f->age += dt;
         float t = f->age / VAC_DURATION;
         if (t >= 1.0f) {
-            f->active = false;
             trigger_slot_delivery(f); /* hand the item off into its slot */
+            *f = s_flights[--s_flight_count];
             continue;
         }
 
@@ -640,75 +635,45 @@ void loot_fx_update(float dt) {
                    ? 1.0f
                    : 1.0f - (t - VAC_FADE_FROM) / (1.0f - VAC_FADE_FROM);
         if (f->alpha < 0.0f) f->alpha = 0.0f;
-    }
-
-    /* Particles. */
-    for (int i = 0; i < LOOT_PARTICLE_MAX; i++) {
-        Particle* p = &s_particles[i];
-        if (!p->active) continue;
-        p->age += dt;
-        if (p->age >= p->ttl) { p->active = false; continue; }
-        p->vy += PART_GRAVITY * dt;
-        p->x  += p->vx * dt;
-        p->y  += p->vy * dt;
+        i++;
     }
 
     /* Fire scheduled slot-arrival bursts. */
-    for (int i = 0; i < LOOT_PENDING_MAX; i++) {
-        if (!s_pending[i].active) continue;
-        if (s_clock >= s_pending[i].fire_at) {
-            spawn_slot_arrival(s_pending[i].tx, s_pending[i].ty);
-            /* The quantity change becomes visible exactly as the item lands. */
-            fx_inventory_bar_qty_notify_arrival(s_pending[i].item_id);
-            s_pending[i].active = false;
-        }
-    }
-
-    /* Screen-space delivery + arrival particles. */
-    for (int i = 0; i < LOOT_SCR_PARTICLE_MAX; i++) {
-        ScrParticle* p = &s_scr[i];
-        if (!p->active) continue;
-        p->age += dt;
-        if (p->age >= p->ttl) { p->active = false; continue; }
-        if (p->mode == 0) {
-            /* Constant-speed horizontal travel with a vertical parabolic arc, so
-             * the spark tosses up and settles into the slot rather than darting
-             * straight in. */
-            float t = p->age / p->ttl;
-            p->x = p->sx + (p->tx - p->sx) * t;
-            p->y = p->sy + (p->ty - p->sy) * t
-                 - 4.0f * DELIVER_ARC_PX * t * (1.0f - t);
-        } else {
-            p->vy += ARRIVAL_GRAVITY * dt;
-            p->x  += p->vx * dt;
-            p->y  += p->vy * dt;
-        }
+    for (int i = 0; i < s_pending_count;) {
+        PendingArrival* a = &s_pending[i];
+        if (s_clock < a->fire_at) { i++; continue; }
+        spawn_slot_arrival(a->tx, a->ty);
+        /* The quantity change becomes visible exactly as the item lands. */
+        fx_inventory_bar_qty_notify_arrival(a->item_id);
+        *a = s_pending[--s_pending_count];
     }
 
     /* Delivery tokens age out with their stream. */
-    for (int i = 0; i < TOKEN_MAX; i++) {
+    for (int i = 0; i < s_token_count;) {
         DeliveryToken* t = &s_tokens[i];
-        if (!t->active) continue;
         t->age += dt;
-        if (t->age >= t->ttl) t->active = false;
+        if (t->age >= t->ttl) { *t = s_tokens[--s_token_count]; continue; }
+        i++;
     }
 
     /* Evict drop animations for tokens no longer being rendered. */
-    for (int i = 0; i < LOOT_DROP_MAX; i++) {
+    bool moved = false;
+    for (int i = 0; i < s_drop_count;) {
         DropAnim* a = &s_drops[i];
-        if (!a->active) continue;
-        if ((s_clock - a->last_seen) > DROP_ANIM_EVICT_SEC) a->active = false;
+        if ((s_clock - a->last_seen) <= DROP_ANIM_EVICT_SEC) { i++; continue; }
+        *a = s_drops[--s_drop_count];
+        moved = true;
     }
+    if (moved) entity_index_rebuild(&s_drop_index, s_drop_count);
 }
 
 /* ── Renderer bridges ──────────────────────────────────────────────────── */
 
-int loot_fx_slot_count(void) { return LOOT_FX_MAX; }
+int loot_fx_slot_count(void) { return s_flight_count; }
 
 bool loot_fx_render_at(int i, LootFxRender* out) {
-    if (i < 0 || i >= LOOT_FX_MAX || !out) return false;
+    if (i < 0 || i >= s_flight_count || !out) return false;
     const VacFlight* f = &s_flights[i];
-    if (!f->active) return false;
 
     strncpy(out->item_id, f->item_id, MAX_ITEM_ID_LENGTH - 1);
     out->item_id[MAX_ITEM_ID_LENGTH - 1] = '\0';
@@ -719,28 +684,11 @@ bool loot_fx_render_at(int i, LootFxRender* out) {
     return true;
 }
 
-int loot_fx_particle_slot_count(void) { return LOOT_PARTICLE_MAX; }
-
-bool loot_fx_particle_at(int i, LootFxParticle* out) {
-    if (i < 0 || i >= LOOT_PARTICLE_MAX || !out) return false;
-    const Particle* p = &s_particles[i];
-    if (!p->active) return false;
-
-    out->x     = p->x;
-    out->y     = p->y;
-    out->size  = p->size;
-    out->tint  = p->tint;
-    out->alpha = 1.0f - p->age / p->ttl;
-    if (out->alpha < 0.0f) out->alpha = 0.0f;
-    return true;
-}
-
-int loot_fx_delivery_token_slot_count(void) { return TOKEN_MAX; }
+int loot_fx_delivery_token_slot_count(void) { return s_token_count; }
 
 bool loot_fx_delivery_token_at(int i, LootFxDeliveryToken* out) {
-    if (i < 0 || i >= TOKEN_MAX || !out) return false;
+    if (i < 0 || i >= s_token_count || !out) return false;
     const DeliveryToken* t = &s_tokens[i];
-    if (!t->active) return false;
 
     /* Same constant-speed horizontal + parabolic arc as the homing stream,
      * lifted above it; the lift eases out so the token lands on the slot. */
@@ -757,19 +705,3 @@ bool loot_fx_delivery_token_at(int i, LootFxDeliveryToken* out) {
     out->item_id[MAX_ITEM_ID_LENGTH - 1] = '\0';
     return true;
 }
-
-int loot_fx_screen_particle_slot_count(void) { return LOOT_SCR_PARTICLE_MAX; }
-
-bool loot_fx_screen_particle_at(int i, LootFxScreenParticle* out) {
-    if (i < 0 || i >= LOOT_SCR_PARTICLE_MAX || !out) return false;
-    const ScrParticle* p = &s_scr[i];
-    if (!p->active) return false;
-
-    out->x     = p->x;
-    out->y     = p->y;
-    out->size  = p->size;
-    out->tint  = p->tint;
-    out->alpha = 1.0f - p->age / p->ttl;
-    if (out->alpha < 0.0f) out->alpha = 0.0f;
-    return true;
-}
@@ -24,8 +24,9 @@
  *      is erased.
  *
  * Stages 1–2 drive the render position of the drop bot that lives in the world
- * mirror (loot_fx_drop_render_pos). Stage 3 owns detached flight tokens and the
- * particle field, painted through the renderer bridge below. */
+ * mirror (loot_fx_drop_render_pos). Stage 3 owns detached flight tokens,
+ * painted through the renderer bridge below; every spark is emitted into the
+ * shared fx_particles store. */
 
 typedef struct {
     char  item_id[MAX_ITEM_ID_LENGTH];
@@ -41,14 +42,9 @@ enum {
     LOOT_FX_TINT_GRAY = 1,
 };
 
-typedef struct {
-    float   x, y;    /* center, grid units                        */
-    float   size;    /* square side, grid units                   */
-    float   alpha;   /* 0..1                                       */
-    uint8_t tint;    /* LOOT_FX_TINT_*                             */
-} LootFxParticle;
-
-/* Reset all flights, drop animations, and particles (call on world reset). */
+/* Reset all flights and drop animations (call on world reset). The sparks
+ * live in the shared fx_particles store, drawn as FX_SPACE_WORLD (bursts,
+ * ambient) and FX_SPACE_SCREEN (slot delivery, arrival, expend). */
 void loot_fx_reset(void);
 
 /* MsgTypeDropSpawn: register a corpse→cell launch for an in-world drop token.
@@ -62,7 +58,7 @@ void loot_fx_note_spawn(const char* drop_id, float origin_x, float origin_y,
 void loot_fx_push(const char* drop_id, const char* collector_id,
                   const char* item_id, float world_x, float world_y);
 
-/* Advance every flight, drop animation, and particle by dt seconds. */
+/* Advance every flight, drop animation, and pending arrival by dt seconds. */
 void loot_fx_update(float dt);
 
 /* In-world drop render hook. Given the token's authoritative AOI rect (top-left
@@ -83,25 +79,13 @@ bool loot_fx_drop_render_pos(const char* drop_id,
  * first-copy slot until this turns false. */
 bool loot_fx_inbound_to_inventory(const char* item_id);
 
+/* Renderer bridges: each *_slot_count() is the number of live entries, valid
+ * as indices until the next loot_fx_update or spawn. */
+
 /* Renderer bridge: detached vacuum tokens. */
 int  loot_fx_slot_count(void);
 bool loot_fx_render_at(int i, LootFxRender* out);
 
-/* Renderer bridge: collection-burst particles (world-space). */
-int  loot_fx_particle_slot_count(void);
-bool loot_fx_particle_at(int i, LootFxParticle* out);
-
-/* Renderer bridge: screen-space delivery particles (inventory slot arrival). */
-typedef struct {
-    float   x, y;    /* center, screen pixels                    */
-    float   size;    /* square side, screen pixels               */
-    float   alpha;   /* 0..1                                     */
-    uint8_t tint;    /* LOOT_FX_TINT_* (always gold: local-only)  */
-} LootFxScreenParticle;
-
-int  loot_fx_screen_particle_slot_count(void);
-bool loot_fx_screen_particle_at(int i, LootFxScreenParticle* out);
-
 /* Renderer bridge: the delivery token — the picked item's ObjectLayer icon
  * riding the same avatar→slot arc as the delivery stream, slightly above the
  * particles, so the item itself is seen entering the inventory. */
@@ -0,0 +1,73 @@
+#include "ui/meta_bulk.h"
+
+#include "frame_tasks.h"
+#include "heap_memory.h"
+#include "json_reader.h"
+#include "msgpack_decode.h"
+#include "serial.h"
+
+#include <assert.h>
+#include <string.h>
+
+typedef struct {
+    MetaBulkStoreFn store;
+    bool            started;   /* reader is inside the `data` array */
+    JsonReader      reader;
+    size_t          size;
+    char            body[];
+} MetaBulkTask;
+
+static void store_doc(const MetaBulkTask* task, const cJSON* doc) {
+    const cJSON* code = cJSON_GetObjectItemCaseSensitive(doc, "code");
+    if (cJSON_IsString(code)) task->store(code->valuestring, doc);
+}
+
+/* A MessagePack body has no cheap element boundaries: the whole tree in
+ * one slice. */
+static void ingest_tree(const MetaBulkTask* task) {
+    cJSON* root = serial_json_parse(task->body, task->size);
+    const cJSON* docs = root ? cJSON_GetObjectItemCaseSensitive(root, "data") : NULL;
+    if (cJSON_IsArray(docs)) {
+        const cJSON* doc = NULL;
+        cJSON_ArrayForEach(doc, docs) store_doc(task, doc);
+    }
+    serial_json_free(root);
+}
+
+/* One slice: up to META_BULK_DOCS_PER_SLICE docs, each parsed on its own
+ * so no tree outlives the slice. */
+static bool ingest_slice(void* ctx) {
+    MetaBulkTask* task = ctx;
+    JsonReader* r = &task->reader;
+    bool done = false;
+    if (msgpack_is(task->body, task->size)) {
+        ingest_tree(task);
+        done = true;
+    } else if (!task->started) {
+        task->started = true;
+        done = !jr_object_begin(r) || !jr_object_find(r, "data") || !jr_array_begin(r);
+    } else {
+        for (int n = 0; n < META_BULK_DOCS_PER_SLICE && !done; n++) {
+            if (!jr_array_next(r)) { done = true; break; }
+            size_t len;
+            const char* doc = jr_value(r, &len);
+            if (!doc) { done = true; break; }
+            cJSON* tree = serial_json_parse(doc, len);
+            if (tree) store_doc(task, tree);
+            serial_json_free(tree);
+        }
+    }
+    if (done) heap_free(task);
+    return done;
+}
+
+void meta_bulk_defer(const FetchResponse* r, MetaBulkStoreFn store) {
+    assert(r && store);
+    if (!r->success || !r->data || 0 == r->size) return;
+    MetaBulkTask* task = heap_malloc(HEAP_MEM_FETCH, sizeof(MetaBulkTask) + r->size);
+    if (!task) return;
+    *task = (MetaBulkTask){ .store = store, .size = r->size };
+    memcpy(task->body, r->data, r->size);
+    jr_init(&task->reader, task->body, task->size);
+    frame_tasks_submit(FRAME_TASK_LOW, ingest_slice, task);
+}
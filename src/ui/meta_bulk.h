@@ -0,0 +1,33 @@
+#ifndef CYBERIA_UI_META_BULK_H
+#define CYBERIA_UI_META_BULK_H
+
+#include "network/engine_client.h"
+
+#include <cJSON.h>
+
+/*
+ * Bulk metadata envelopes, ingested off the fetch callback.
+ *
+ * A bulk response (`{ data: [ { code, ... }, ... ] }`) can carry a whole
+ * window of quest or action docs. Parsing it and upserting every doc
+ * inline landed all of that on whichever frame the fetch completed.
+ * meta_bulk_defer() copies the body and queues it as a FRAME_TASK_LOW
+ * task (frame_tasks.h) that walks `data` with a JsonReader across slices,
+ * META_BULK_DOCS_PER_SLICE docs at a time, each doc parsed and stored on
+ * its own. No tree outlives its slice, since serial_json_parse() trees
+ * share one arena; a MessagePack body is decoded whole in one slice. Keys
+ * reset or evicted meanwhile are dropped by the store function's
+ * meta_cache_pending() lookup, as a late response would be.
+ */
+
+#ifndef META_BULK_DOCS_PER_SLICE
+#define META_BULK_DOCS_PER_SLICE 8
+#endif
+
+/* Store one doc of the envelope under its `code`. */
+typedef void (*MetaBulkStoreFn)(const char* code, const cJSON* doc);
+
+/* Queue a successful bulk response; a failed one is ignored. */
+void meta_bulk_defer(const FetchResponse* r, MetaBulkStoreFn store);
+
+#endif /* CYBERIA_UI_META_BULK_H */
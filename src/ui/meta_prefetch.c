@@ -0,0 +1,27 @@
+#include "ui/meta_prefetch.h"
+
+#include "dialogue_data.h"
+#include "game_state.h"
+#include "ui/action_cache.h"
+#include "ui/quest_cache.h"
+
+#include <assert.h>
+
+static void on_entity_event(const GameStateEntityEvent* ev) {
+    if (GAME_STATE_ENTITY_ENTER != ev->type && GAME_STATE_ENTITY_FLAGS != ev->type) return;
+    const BotState* bot = ev->bot;
+    if (NULL == bot) return;
+
+    if ('\0' != bot->action_code[0]) action_cache_prefetch(bot->action_code);
+    assert(BOT_QUEST_CODES_MAX >= bot->quest_code_count);
+    for (int i = 0; i < bot->quest_code_count; i++) {
+        quest_cache_prefetch(bot->quest_codes[i]);
+        if ('\0' != bot->quest_talk_dialog_codes[i][0]) {
+            dialogue_data_prefetch_code(bot->quest_talk_dialog_codes[i]);
+        }
+    }
+}
+
+void meta_prefetch_init(void) {
+    game_state_add_entity_listener(on_entity_event);
+}
@@ -0,0 +1,21 @@
+#ifndef CYBERIA_UI_META_PREFETCH_H
+#define CYBERIA_UI_META_PREFETCH_H
+
+/*
+ * AOI-driven warm-up of NPC interaction metadata.
+ *
+ * The interact modal otherwise asks for an NPC's action, quest and
+ * quest-talk dialogue records the moment it opens, so the player watches
+ * a round-trip before anything renders. This listens to the entity events
+ * game_state publishes: when a bot enters the AOI, or its per-player
+ * interaction state changes, its action code, quest codes and pending
+ * quest-talk dialogue codes are handed to the caches' *_prefetch entry
+ * points. Each cache coalesces a window of codes into one bulk request at
+ * FETCH_CLASS_PREFETCH, behind anything visible, and skips codes already
+ * cached or in flight.
+ */
+
+/* Register the entity listener. Call once during renderer init. */
+void meta_prefetch_init(void);
+
+#endif /* CYBERIA_UI_META_PREFETCH_H */
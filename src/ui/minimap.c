@@ -0,0 +1,179 @@
+#include "minimap.h"
+
+#include "game_render.h"
+#include "game_state.h"
+#include "gpu_memory.h"
+#include "static_world.h"
+
+#include <math.h>
+#include <string.h>
+
+#define MINIMAP_COLOR_VOID     ((Color){ 0, 0, 0, 0 })
+#define MINIMAP_COLOR_FLOOR    ((Color){ 58, 66, 84, 255 })
+#define MINIMAP_COLOR_OBSTACLE ((Color){ 150, 150, 164, 255 })
+#define MINIMAP_COLOR_PORTAL   ((Color){ 240, 200, 80, 255 })
+#define MINIMAP_COLOR_SELF     ((Color){ 255, 255, 255, 255 })
+#define MINIMAP_COLOR_PLAYER   ((Color){ 90, 170, 255, 255 })
+#define MINIMAP_COLOR_BOT      ((Color){ 230, 90, 80, 255 })
+#define MINIMAP_COLOR_VIEW     ((Color){ 255, 255, 255, 140 })
+
+/* What the baked texture shows; a re-bake happens when any of it moves.
+ * `from_static` bakes key on the static generation alone, AOI-sourced
+ * ones also on world_revision (throttled). */
+static struct {
+    Texture2D texture;
+    bool      loaded;
+    int       cells_per_texel;
+    int       grid_w, grid_h;
+    uint32_t  map_version;
+    bool      from_static;
+    uint32_t  static_generation;
+    uint32_t  world_revision;
+    double    baked_at;
+} g_minimap;
+
+static void fill_cells(Image* img, int scale, const WorldObject* o, Color c) {
+    int x0 = (int)floorf(o->pos.x) / scale;
+    int y0 = (int)floorf(o->pos.y) / scale;
+    int x1 = (int)ceilf(o->pos.x + (0.0f < o->dims.x ? o->dims.x : 1.0f)) - 1;
+    int y1 = (int)ceilf(o->pos.y + (0.0f < o->dims.y ? o->dims.y : 1.0f)) - 1;
+    x1 /= scale;
+    y1 /= scale;
+    ImageDrawRectangle(img, x0, y0, x1 - x0 + 1, y1 - y0 + 1, c);
+}
+
+/* Floors first, then obstacles and portals over them. */
+static void rasterize(Image* img, int scale, const WorldObject* objects, int count) {
+    const struct { ObjectLayerType kind; Color color; } passes[] = {
+        { OBJECT_LAYER_TYPE_FLOOR,    MINIMAP_COLOR_FLOOR    },
+        { OBJECT_LAYER_TYPE_OBSTACLE, MINIMAP_COLOR_OBSTACLE },
+        { OBJECT_LAYER_TYPE_PORTAL,   MINIMAP_COLOR_PORTAL   },
+    };
+    for (size_t p = 0; p < sizeof(passes) / sizeof(passes[0]); p++) {
+        for (int i = 0; i < count; i++) {
+            if (passes[p].kind == objects[i].type_kind) {
+                fill_cells(img, scale, &objects[i], passes[p].color);
+            }
+        }
+    }
+}
+
+static void unload(void) {
+    if (g_minimap.loaded) {
+        gpu_memory_sub(GPU_MEM_MINIMAP, gpu_memory_texture_bytes(g_minimap.texture));
+        UnloadTexture(g_minimap.texture);
+    }
+    g_minimap.loaded  = false;
+    g_minimap.texture = (Texture2D){ 0 };
+}
+
+static void bake(const WorldObject* statics, int static_count) {
+    const GameState* gs = &g_game_state;
+    int longest = gs->grid_w > gs->grid_h ? gs->grid_w : gs->grid_h;
+    int scale   = (longest + MINIMAP_MAX_DIM - 1) / MINIMAP_MAX_DIM;
+    if (1 > scale) scale = 1;
+    int w = (gs->grid_w + scale - 1) / scale;
+    int h = (gs->grid_h + scale - 1) / scale;
+
+    Image img = GenImageColor(w, h, MINIMAP_COLOR_VOID);
+    if (0 < static_count) {
+        rasterize(&img, scale, statics, static_count);
+    } else {
+        rasterize(&img, scale, gs->floors, gs->floor_count);
+        rasterize(&img, scale, gs->obstacles, gs->obstacle_count);
+        rasterize(&img, scale, gs->portals, gs->portal_count);
+    }
+
+    if (g_minimap.loaded && w == g_minimap.texture.width && h == g_minimap.texture.height) {
+        UpdateTexture(g_minimap.texture, img.data);
+    } else {
+        unload();
+        g_minimap.texture = LoadTextureFromImage(img);
+        g_minimap.loaded  = 0 != g_minimap.texture.id;
+        if (g_minimap.loaded) {
+            SetTextureFilter(g_minimap.texture, TEXTURE_FILTER_POINT);
+            gpu_memory_add(GPU_MEM_MINIMAP, gpu_memory_texture_bytes(g_minimap.texture));
+        }
+    }
+    UnloadImage(img);
+    g_minimap.cells_per_texel = scale;
+}
+
+/* Re-bake when the map, its static layer or (AOI-sourced, throttled) the
+ * world objects changed. */
+static void refresh(void) {
+    const GameState* gs = &g_game_state;
+    const WorldObject* statics = NULL;
+    int static_count = static_world_objects(&statics);
+    bool from_static = 0 < static_count;
+    uint32_t generation = static_world_generation();
+
+    bool stale = !g_minimap.loaded || gs->grid_w != g_minimap.grid_w ||
+                 gs->grid_h != g_minimap.grid_h || gs->map_version != g_minimap.map_version ||
+                 from_static != g_minimap.from_static ||
+                 generation != g_minimap.static_generation;
+    double now = GetTime();
+    if (!stale && !from_static && gs->world_revision != g_minimap.world_revision) {
+        stale = now - g_minimap.baked_at >= MINIMAP_AOI_REBAKE_S;
+    }
+    if (!stale) return;
+
+    bake(statics, static_count);
+    g_minimap.grid_w            = gs->grid_w;
+    g_minimap.grid_h            = gs->grid_h;
+    g_minimap.map_version       = gs->map_version;
+    g_minimap.from_static       = from_static;
+    g_minimap.static_generation = generation;
+    g_minimap.world_revision    = gs->world_revision;
+    g_minimap.baked_at          = now;
+}
+
+static void draw_dots(const EntityHotSet* hot, Rectangle r, float fit, Color c) {
+    for (int i = 0; i < hot->count; i++) {
+        DrawRectangle((int)(r.x + hot->x[i] * fit) - 1, (int)(r.y + hot->y[i] * fit) - 1, 2, 2, c);
+    }
+}
+
+static Color faded(Color c, float alpha) {
+    c.a = (unsigned char)((float)c.a * alpha);
+    return c;
+}
+
+Rectangle minimap_fit(Rectangle box) {
+    const GameState* gs = &g_game_state;
+    if (!gs->init_received || 0 >= gs->grid_w || 0 >= gs->grid_h) return (Rectangle){ 0 };
+    refresh();
+    if (!g_minimap.loaded) return (Rectangle){ 0 };
+    float fit = fminf(box.width / (float)gs->grid_w, box.height / (float)gs->grid_h);
+    return (Rectangle){ box.x, box.y, (float)gs->grid_w * fit, (float)gs->grid_h * fit };
+}
+
+void minimap_draw(Rectangle r, float alpha) {
+    const GameState* gs = &g_game_state;
+    if (!g_minimap.loaded || 0 >= gs->grid_w || 0.0f >= r.width) return;
+    float fit = r.width / (float)gs->grid_w;
+    Rectangle src = { 0, 0, (float)gs->grid_w / (float)g_minimap.cells_per_texel,
+                      (float)gs->grid_h / (float)g_minimap.cells_per_texel };
+    DrawTexturePro(g_minimap.texture, src, r, (Vector2){ 0 }, 0.0f, faded(WHITE, alpha));
+
+    Rectangle view = game_render_get_camera_bounds();
+    if (isfinite(view.x) && isfinite(view.y) && 0.0f < view.width) {
+        view = GetCollisionRec(view, (Rectangle){ 0, 0, (float)gs->grid_w, (float)gs->grid_h });
+    }
+    if (0.0f < view.width && 0.0f < view.height) {
+        DrawRectangleLinesEx((Rectangle){ r.x + view.x * fit, r.y + view.y * fit,
+                                          view.width * fit, view.height * fit },
+                             1.0f, faded(MINIMAP_COLOR_VIEW, alpha));
+    }
+
+    draw_dots(&gs->bot_hot, r, fit, faded(MINIMAP_COLOR_BOT, alpha));
+    draw_dots(&gs->player_hot, r, fit, faded(MINIMAP_COLOR_PLAYER, alpha));
+    Vector2 self = gs->player.base.interp_pos;
+    DrawRectangle((int)(r.x + self.x * fit) - 1, (int)(r.y + self.y * fit) - 1, 3, 3,
+                  faded(MINIMAP_COLOR_SELF, alpha));
+}
+
+void minimap_release(void) {
+    unload();
+    memset(&g_minimap, 0, sizeof(g_minimap));
+}
@@ -0,0 +1,41 @@
+#ifndef CYBERIA_UI_MINIMAP_H
+#define CYBERIA_UI_MINIMAP_H
+
+#include <raylib.h>
+#include <stdbool.h>
+
+/* minimap — a baked overview of the current map.
+ *
+ * Floors, obstacles and portals are rasterized into a small texture, one
+ * texel per cell (or per MINIMAP_MAX_DIM-fitting block of cells on large
+ * maps), only when the map or its static layer changes. The source is the
+ * applied static layer (static_world_objects), which covers the whole map
+ * even while game_state holds only the chunks around the camera; without
+ * one it falls back to the world objects the AOI frames carried, re-baked
+ * at most every MINIMAP_AOI_REBAKE_S as they change.
+ *
+ * Each frame only the texture quad, the camera frame and one dot per
+ * entity from the hot sets are drawn, so the cost does not grow with the
+ * number of floors. */
+
+#ifndef MINIMAP_MAX_DIM
+#define MINIMAP_MAX_DIM 256
+#endif
+
+#ifndef MINIMAP_AOI_REBAKE_S
+#define MINIMAP_AOI_REBAKE_S 1.0
+#endif
+
+/* The rect the map occupies fitted inside `box` (screen pixels, aspect
+ * kept, anchored top-left), re-baking first if its source changed;
+ * zero-sized while there is no map to show. */
+Rectangle minimap_fit(Rectangle box);
+
+/* Draw the baked map into `r` (a minimap_fit result) at `alpha`, with the
+ * camera frame and live entity dots over it. */
+void minimap_draw(Rectangle r, float alpha);
+
+/* Unload the baked texture. */
+void minimap_release(void);
+
+#endif /* CYBERIA_UI_MINIMAP_H */
@@ -1,5 +1,6 @@
 #include "modal.h"
 #include "text.h"
+#include "render_stats.h"
 #include <math.h>
 #include <stdio.h>
 #include <string.h>
@@ -28,6 +28,7 @@
 #include "ui_button.h"
 #include "ui_icon.h"
 #include "util/log.h"
+#include "render_stats.h"
 
 #include <assert.h>
 #include <math.h>
@@ -70,6 +71,28 @@ static float s_char_timer    = 0.0f;
 static int   s_chars_visible = 0;
 static bool  s_line_complete = false;
 
+/* The displayed line word-wrapped once into rows of its own bytes, so the
+ * typewriter only decides how much of each row to draw. Rebuilt when the
+ * line, the lines themselves, the wrap width or the font changes. */
+#define DLG_MAX_ROWS (DIALOGUE_MAX_TEXT / 2)
+
+typedef struct {
+    int start;   /* byte offset into the line's text */
+    int len;
+} DlgRow;
+
+static struct {
+    int      lines_rev;
+    int      line;
+    int      maxw;
+    int      fs;
+    float    factor;
+    uint32_t font_gen;
+    DlgRow   rows[DLG_MAX_ROWS];
+    int      row_count;
+} s_layout = { .line = -1 };
+static int s_lines_rev = 0;   /* bumped whenever s_lines is replaced */
+
 /* One-shot close callback (cleared after firing) */
 static ModalDialogueOnClose s_on_close = NULL;
 
@@ -251,6 +274,51 @@ static void draw_dialogue_sprite(int icon_x, int icon_y, int icon_sz) {
     }
 }
 
+/* Greedy word wrap of `text` into `maxw` pixels: a word goes on the row
+ * while the row, measured up to and including it, still fits. */
+static void layout_line(const char* text, int maxw, int fs) {
+    s_layout.row_count = 0;
+    char probe[DIALOGUE_MAX_TEXT];
+    int  row_start = -1, row_end = 0;
+    int  i = 0;
+    while (text[i] && DLG_MAX_ROWS > s_layout.row_count) {
+        while (' ' == text[i]) i++;
+        if ('\0' == text[i]) break;
+        int word = i;
+        while (text[i] && ' ' != text[i]) i++;
+        if (0 > row_start) {
+            row_start = word;
+            row_end   = i;
+            continue;
+        }
+        int n = i - row_start;
+        memcpy(probe, text + row_start, (size_t)n);
+        probe[n] = '\0';
+        if (MeasureText(probe, fs) > maxw) {
+            s_layout.rows[s_layout.row_count++] = (DlgRow){ row_start, row_end - row_start };
+            row_start = word;
+        }
+        row_end = i;
+    }
+    if (0 <= row_start && DLG_MAX_ROWS > s_layout.row_count)
+        s_layout.rows[s_layout.row_count++] = (DlgRow){ row_start, row_end - row_start };
+}
+
+static void layout_sync(int maxw, int fs) {
+    float    factor = text_font_factor();
+    uint32_t gen    = text_font_generation();
+    if (s_layout.lines_rev == s_lines_rev && s_layout.line == s_current &&
+        s_layout.maxw == maxw && s_layout.fs == fs &&
+        s_layout.factor == factor && s_layout.font_gen == gen) return;
+    s_layout.lines_rev = s_lines_rev;
+    s_layout.line      = s_current;
+    s_layout.maxw      = maxw;
+    s_layout.fs        = fs;
+    s_layout.factor    = factor;
+    s_layout.font_gen  = gen;
+    layout_line(s_lines[s_current].text, maxw, fs);
+}
+
 /* ── Public API ──────────────────────────────────────────────────────── */
 
 void modal_dialogue_init(void) {
@@ -270,6 +338,7 @@ void modal_dialogue_open(const char* entity_id, const char* item_id,
 
     s_line_count = n;
     s_current    = 0;
+    s_lines_rev++;
     s_render     = render;
     s_auto_dismiss = (MODAL_DIALOGUE_RENDER_ITEM == render);
 
@@ -363,6 +432,8 @@ void modal_dialogue_set_on_close(ModalDialogueOnClose cb) {
 
 bool modal_dialogue_is_open(void) { return s_open; }
 
+const char* modal_dialogue_entity_id(void) { return s_entity_id; }
+
 void modal_dialogue_update(float dt) {
     if (!s_open) return;
     if (dlg_hidden()) return;
@@ -526,39 +597,21 @@ void modal_dialogue_draw(void) {
     /* ── Dialogue text (typewriter, word-wrapped) ──────────────────── */
     int fs = DLG_FONT_TEXT;
 
-    char partial[DIALOGUE_MAX_TEXT];
-    int len = s_chars_visible;
-    if (len > (int)sizeof(partial) - 1) len = (int)sizeof(partial) - 1;
-    if (len > (int)strlen(line->text))  len = (int)strlen(line->text);
-    memcpy(partial, line->text, len);
-    partial[len] = '\0';
-
+    /* Each row is drawn up to the typewriter's reveal index, so a word
+     * being typed already sits on the row it ends on. */
+    layout_sync((int)txt_max, fs);
     {
-        char copy[DIALOGUE_MAX_TEXT];
-        strncpy(copy, partial, sizeof(copy) - 1);
-        copy[sizeof(copy) - 1] = '\0';
-
-        char line_buf[512] = {0};
+        char  row_buf[DIALOGUE_MAX_TEXT];
         float cur_y = text_y;
-        char* tok = strtok(copy, " ");
-        while (tok) {
-            char test[512];
-            if (line_buf[0] == '\0')
-                snprintf(test, sizeof(test), "%s", tok);
-            else
-                snprintf(test, sizeof(test), "%s %s", line_buf, tok);
-
-            if (MeasureText(test, fs) > (int)txt_max && line_buf[0] != '\0') {
-                DrawText(line_buf, (int)txt_x, (int)cur_y, fs, C_TEXT);
-                cur_y += fs + 4;
-                snprintf(line_buf, sizeof(line_buf), "%s", tok);
-            } else {
-                snprintf(line_buf, sizeof(line_buf), "%s", test);
-            }
-            tok = strtok(NULL, " ");
-        }
-        if (line_buf[0] != '\0') {
-            DrawText(line_buf, (int)txt_x, (int)cur_y, fs, C_TEXT);
+        for (int r = 0; r < s_layout.row_count; r++) {
+            const DlgRow* row = &s_layout.rows[r];
+            int n = s_chars_visible - row->start;
+            if (n <= 0) break;
+            if (n > row->len) n = row->len;
+            memcpy(row_buf, line->text + row->start, (size_t)n);
+            row_buf[n] = '\0';
+            DrawText(row_buf, (int)txt_x, (int)cur_y, fs, C_TEXT);
+            cur_y += fs + 4;
         }
     }
 
@@ -107,6 +107,9 @@ void modal_dialogue_set_on_close(ModalDialogueOnClose cb);
  */
 bool modal_dialogue_is_open(void);
 
+/* Entity the dialogue was opened with; "" when none. */
+const char* modal_dialogue_entity_id(void);
+
 /* True while an inventory-lore dialogue (opened from the inventory modal's
  * Dialog button) is up. */
 bool modal_dialogue_is_item_lore(void);
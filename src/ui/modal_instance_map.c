@@ -4,13 +4,17 @@
 #include "modal_map.h"
 #include "text.h"
 #include "toolbar.h"
+#include "ui_hit.h"
 #include "ui_icon.h"
+#include "ui_mesh.h"
+#include "ui_skin.h"
 
 #include "domain/presentation_runtime.h"
 #include "game_state.h"
 #include "input/input.h"
 #include "texture_cache.h"
 #include "world_types.h"
+#include "render_stats.h"
 
 #include <assert.h>
 #include <limits.h>
@@ -30,6 +34,7 @@
 #define IMAP_DRAG_SLOP_PX   9.0f
 #define IMAP_CAM_LAMBDA     11.0f   /* exp smoothing rate for pan/zoom      */
 #define IMAP_ROTATE_DURATION 0.42f
+#define IMAP_PREVIEW_UNWANTED_S 0.5 /* queued preview fetches off-screen this long are dropped */
 
 static const Color IMAP_BG        = { 6, 10, 22, 205 };
 static const Color IMAP_GRID_LINE = { 60, 140, 190, 26 };
@@ -43,6 +48,10 @@ static const Color IMAP_QUEST     = { 250, 205, 70, 255 };
 static const Color IMAP_ACTION    = { 90, 230, 235, 255 };
 static const Color IMAP_TEXT      = { 205, 225, 245, 235 };
 static const Color IMAP_TEXT_DIM  = { 130, 150, 180, 190 };
+static const Color IMAP_BORDER_LIGHT = { 110, 140, 180, 220 };
+static const Color IMAP_BORDER_SHADE = { 2, 4, 10, 255 };
+static const Color IMAP_LINK_SHADOW  = { 0, 0, 0, 215 };
+static const Color IMAP_LINK_LIGHT   = { 225, 245, 255, 210 };
 
 typedef struct {
     bool  open;
@@ -66,6 +75,7 @@ typedef struct {
     Vector2 pinch_mid;
 
     int selected_node;    /* -1 = none                      */
+    int hovered_node;     /* under the pointer at the last draw; -1 = none */
     int layout_generation;
 } ModalInstanceMap;
 
@@ -81,28 +91,41 @@ static Rectangle s_rotate_left_btn, s_rotate_right_btn;
 
 /* Node preview backgrounds: each map's auto-captured Object Layer render,
  * fetched lazily from the server-supplied previewUrl through the engine
- * fetch pipeline (File blob for persisted maps, cached render for fallback). */
+ * fetch pipeline (File blob for persisted maps, cached render for fallback).
+ * Only cards inside the panel ask for theirs, at prefetch priority; each
+ * decodes to the on-screen card side, and the cache empties on close. */
 static TextureCache* s_preview_cache = NULL;
 
 static void on_preview_blob(const FetchResponse* r) {
     texture_cache_on_blob_fetched(s_preview_cache, r);
 }
 
+/* Every card is drawn at the same side. */
+static int preview_fit(const char* url) {
+    return (int)ceilf(IMAP_NODE_SIDE * s_m.zoom_target);
+}
+
 /* ── Lifecycle ──────────────────────────────────────────────────────────── */
 
 void modal_instance_map_init(void) {
     memset(&s_m, 0, sizeof(s_m));
     s_m.zoom = s_m.zoom_target = IMAP_ZOOM_INIT;
     s_m.selected_node = -1;
+    s_m.hovered_node  = -1;
     s_grid_rotation = 0;
     s_rotation_from = 0;
     s_rotation_to = 0;
     s_rotation_step = 0;
     s_rotation_age = IMAP_ROTATE_DURATION;
-    s_preview_cache = texture_cache_create(IMAP_MAX_NODES, "imap-preview", on_preview_blob);
+    s_preview_cache = texture_cache_create(IMAP_MAX_NODES, "imap-preview", GPU_MEM_PREVIEWS, on_preview_blob);
+    texture_cache_set_fetch_class(s_preview_cache, FETCH_CLASS_PREFETCH);
+    texture_cache_set_fit(s_preview_cache, preview_fit);
 }
 
+static void scene_release(void);
+
 void modal_instance_map_cleanup(void) {
+    scene_release();
     if (s_m.open) {
         instance_map_data_close();
         input_gestures_set_blocked(false);
@@ -123,6 +146,7 @@ static void reset_camera(void) {
 
 void modal_instance_map_toggle(void) {
     if (s_m.open) { modal_instance_map_close(); return; }
+    if (!s_preview_cache) modal_instance_map_init();
     s_m.open = true;
     s_m.selected_node = -1;
     s_m.pressed = s_m.dragging = s_m.pinching = false;
@@ -140,6 +164,8 @@ void modal_instance_map_close(void) {
     if (!s_m.open) return;
     s_m.open = false;
     instance_map_data_close();      /* stops dynamic polling immediately */
+    scene_release();
+    if (s_preview_cache) texture_cache_clear(s_preview_cache);
     modal_map_set_expanded(false);  /* container retracts to the readout */
     input_gestures_set_blocked(false);
 }
@@ -204,21 +230,30 @@ static Rectangle node_rect(const ImapNode* n) {
     return (Rectangle){ p.x - h, p.y - h, h * 2.0f, h * 2.0f };
 }
 
+/* Node rects as drawn last, from the UI hit registry; of overlapping cards
+ * (mid-rotation) the nearest centre wins. */
 static int node_at_point(float x, float y) {
-    const ImapGraph* gr = instance_map_data_graph();
-    int hit = -1;
-    float best = 1e9f;
-    for (int i = 0; i < gr->node_count; ++i) {
-        Vector2 p = node_center(&gr->nodes[i]);
-        Rectangle r = node_rect(&gr->nodes[i]);
-        if (!CheckCollisionPointRec((Vector2){ x, y }, r)) continue;
-        float dx = x - p.x, dy = y - p.y;
+    UiHit hits[IMAP_MAX_NODES];
+    int   count = ui_hit_query_all((Vector2){ x, y }, UI_HIT_IMAP_NODE, hits, IMAP_MAX_NODES);
+    int   hit   = -1;
+    float best  = 1e9f;
+    for (int i = 0; i < count; ++i) {
+        float dx = x - (hits[i].rect.x + hits[i].rect.width * 0.5f);
+        float dy = y - (hits[i].rect.y + hits[i].rect.height * 0.5f);
         float d2 = dx * dx + dy * dy;
-        if (d2 < best) { best = d2; hit = i; }
+        if (d2 < best) { best = d2; hit = hits[i].index; }
     }
     return hit;
 }
 
+/* Once per drawn frame, before the cards: register them and resolve hover. */
+static void register_nodes(void) {
+    const ImapGraph* gr = instance_map_data_graph();
+    for (int i = 0; i < gr->node_count; ++i) ui_hit_add(UI_HIT_IMAP_NODE, i, node_rect(&gr->nodes[i]));
+    Vector2 mp = GetMousePosition();
+    s_m.hovered_node = grid_rotation_animating() ? -1 : node_at_point(mp.x, mp.y);
+}
+
 /* ── Camera controls ────────────────────────────────────────────────────── */
 
 static float clampf(float v, float lo, float hi) {
@@ -251,6 +286,13 @@ bool modal_instance_map_handle_wheel(float wheel_delta) {
     return true;
 }
 
+void modal_instance_map_nudge(Vector2 pan_px, float zoom_factor) {
+    if (!s_m.open) return;
+    s_m.pan_target.x += pan_px.x;
+    s_m.pan_target.y += pan_px.y;
+    if (1.0f != zoom_factor) zoom_about(zoom_factor, panel_center());
+}
+
 static void begin_grid_rotation(int step) {
     if (grid_rotation_animating()) return;
     s_rotation_from = s_grid_rotation;
@@ -356,6 +398,9 @@ void modal_instance_map_update(float dt) {
     s_m.zoom  += (s_m.zoom_target - s_m.zoom) * a;
     s_m.pan.x += (s_m.pan_target.x - s_m.pan.x) * a;
     s_m.pan.y += (s_m.pan_target.y - s_m.pan.y) * a;
+
+    /* Cards panned or zoomed off the panel stop waiting for a slot. */
+    if (s_preview_cache) texture_cache_cancel_unwanted(s_preview_cache, IMAP_PREVIEW_UNWANTED_S);
 }
 
 /* ── Input dispatch glue ────────────────────────────────────────────────── */
@@ -399,14 +444,26 @@ static Rectangle pixel_inner(Rectangle bounds, float inset) {
                         bounds.width - 2.0f * inset, bounds.height - 2.0f * inset };
 }
 
+/* Card chrome as one nine-slice (ui_skin.h); the rects below draw it
+ * directly when no skin cell is available. */
+static bool draw_pixel_skin(UiSkinKind kind, Rectangle bounds, Color fill, Color accent,
+                            bool focused, float fade) {
+    UiSkin skin = { .kind = kind, .fill = fill, .accent = accent, .focused = focused,
+                    .light = focused ? WHITE : IMAP_BORDER_LIGHT, .shade = IMAP_BORDER_SHADE };
+    Rectangle dest = { (float)(int)bounds.x, (float)(int)bounds.y,
+                       (float)(int)bounds.width, (float)(int)bounds.height };
+    return ui_skin_draw(&skin, dest, fade_c(WHITE, fade));
+}
+
 static void draw_pixel_border(Rectangle bounds, Color accent, bool focused, float fade) {
     if (bounds.width < 8.0f || bounds.height < 8.0f) {
         DrawRectangleRec(bounds, fade_c(accent, fade));
         return;
     }
+    if (draw_pixel_skin(UI_SKIN_PIXEL_BORDER, bounds, BLANK, accent, focused, fade)) return;
     Color dark = fade_c((Color){ 4, 8, 16, 255 }, fade);
-    Color light = fade_c(focused ? WHITE : (Color){ 110, 140, 180, 220 }, fade);
-    Color shade = fade_c((Color){ 2, 4, 10, 255 }, fade);
+    Color light = fade_c(focused ? WHITE : IMAP_BORDER_LIGHT, fade);
+    Color shade = fade_c(IMAP_BORDER_SHADE, fade);
     Color edge = fade_c(accent, fade);
     int width = (int)bounds.width;
     int height = (int)bounds.height;
@@ -431,6 +488,8 @@ static void draw_pixel_panel(Rectangle bounds, Color fill, Color accent, bool fo
         DrawRectangleRec(bounds, fade_c(fill, fade));
         return;
     }
+    if (8.0f <= bounds.width && 8.0f <= bounds.height &&
+        draw_pixel_skin(UI_SKIN_PIXEL_PANEL, bounds, fill, accent, focused, fade)) return;
     DrawRectangleRec(bounds, fade_c(BLACK, fade));
     Rectangle inner = pixel_inner(bounds, 2.0f);
     DrawRectangleRec(inner, fade_c(fill, fade));
@@ -525,9 +584,9 @@ static void draw_pixel_diagonal(Vector2 a, Vector2 b, Color color, float fade) {
     float dy = b.y - a.y;
     int steps = (int)(fmaxf(fabsf(dx), fabsf(dy)) / 4.0f) + 1;
     if (steps > 384) steps = 384;
-    Color shadow = fade_c((Color){ 0, 0, 0, 215 }, fade);
+    Color shadow = fade_c(IMAP_LINK_SHADOW, fade);
     Color core = fade_c(color, fade);
-    Color light = fade_c((Color){ 225, 245, 255, 210 }, fade);
+    Color light = fade_c(IMAP_LINK_LIGHT, fade);
     DrawLineEx(a, b, 7.0f, shadow);
     DrawLineEx(a, b, 3.0f, core);
     DrawLineEx(a, b, 1.0f, light);
@@ -554,18 +613,49 @@ static Vector2 pixel_path_point(Vector2 a, Vector2 b, float progress) {
     return point;
 }
 
-/* Direct diagonal pixel connection with a thicker travelling energy block. */
-static void draw_edge(const ImapEdge* e, int idx, float fade, double t) {
-    const ImapGraph* gr = instance_map_data_graph();
-    Color base = e->intra ? IMAP_EDGE_INTRA : IMAP_EDGE;
+static Color edge_color(const ImapEdge* e) {
+    return e->intra ? IMAP_EDGE_INTRA : IMAP_EDGE;
+}
+
+/* Both ends on known cells: the link itself never moves on the graph. */
+static bool edge_is_fixed(const ImapEdge* e) {
+    return 0 <= e->source_cell_x && 0 <= e->source_cell_y &&
+           0 <= e->target_cell_x && 0 <= e->target_cell_y;
+}
 
-    Vector2 a = edge_endpoint(&gr->nodes[e->source_node], e->source_cell_x, e->source_cell_y,
-                              t, idx * 2);
-    Vector2 b = edge_endpoint(&gr->nodes[e->target_node], e->target_cell_x, e->target_cell_y,
-                              t, idx * 2 + 1);
+/* Endpoints closer than this many pixels collapse into a single block. */
+#define IMAP_EDGE_MIN_LEN2 16.0f
+
+static void edge_points(const ImapEdge* e, int idx, double t, Vector2* a, Vector2* b) {
+    const ImapGraph* gr = instance_map_data_graph();
+    *a = edge_endpoint(&gr->nodes[e->source_node], e->source_cell_x, e->source_cell_y,
+                       t, idx * 2);
+    *b = edge_endpoint(&gr->nodes[e->target_node], e->target_cell_x, e->target_cell_y,
+                       t, idx * 2 + 1);
+}
 
+static bool edge_is_short(Vector2 a, Vector2 b) {
     float dx = b.x - a.x, dy = b.y - a.y;
-    if (dx * dx + dy * dy < 16.0f) {
+    return dx * dx + dy * dy < IMAP_EDGE_MIN_LEN2;
+}
+
+static void draw_edge_pulse(Vector2 a, Vector2 b, Color base, int idx, float fade, double t) {
+    float phase = (float)fmod(t * 0.55 + idx * 0.19, 1.0);
+    Vector2 pulse = pixel_path_point(a, b, phase);
+    int px = (int)pulse.x;
+    int py = (int)pulse.y;
+    DrawRectangle(px - 7, py - 7, 15, 15, fade_c(BLACK, fade));
+    DrawRectangle(px - 5, py - 5, 11, 11, fade_c(base, fade));
+    DrawRectangle(px - 2, py - 2, 5, 5, unfiltered_icon_color(fade));
+}
+
+/* Direct diagonal pixel connection with a thicker travelling energy block. */
+static void draw_edge(const ImapEdge* e, int idx, float fade, double t) {
+    Color base = edge_color(e);
+    Vector2 a, b;
+    edge_points(e, idx, t, &a, &b);
+
+    if (edge_is_short(a, b)) {
         int px = (int)roundf(a.x);
         int py = (int)roundf(a.y);
         DrawRectangle(px - 8, py - 8, 17, 17, fade_c(BLACK, fade));
@@ -575,14 +665,7 @@ static void draw_edge(const ImapEdge* e, int idx, float fade, double t) {
     }
 
     draw_pixel_diagonal(a, b, base, fade);
-
-    float phase = (float)fmod(t * 0.55 + idx * 0.19, 1.0);
-    Vector2 pulse = pixel_path_point(a, b, phase);
-    int px = (int)pulse.x;
-    int py = (int)pulse.y;
-    DrawRectangle(px - 7, py - 7, 15, 15, fade_c(BLACK, fade));
-    DrawRectangle(px - 5, py - 5, 11, 11, fade_c(base, fade));
-    DrawRectangle(px - 2, py - 2, 5, 5, unfiltered_icon_color(fade));
+    draw_edge_pulse(a, b, base, idx, fade, t);
 }
 
 /* Map cell → screen position inside the node card (the preview capture and
@@ -727,6 +810,20 @@ static void draw_zoomed_capability_tab(Vector2 at, const char* status_icon,
     }
 }
 
+static bool node_hovered(int idx) {
+    return idx == s_m.hovered_node;
+}
+
+static void draw_node_preview(const ImapNode* n, Rectangle card, float fade) {
+    if ('\0' == n->preview_url[0]) return;
+    if (!CheckCollisionRecs(card, s_m.panel)) return;   /* off-panel: never fetched */
+    Texture2D tex = texture_cache_get(s_preview_cache, n->preview_url);
+    if (0 == tex.id) return;
+    Rectangle src  = { 0, 0, (float)tex.width, (float)tex.height };
+    Rectangle dest = pixel_inner(card, 4.0f);
+    DrawTexturePro(tex, src, dest, (Vector2){ 0, 0 }, 0.0f, unfiltered_icon_color(fade));
+}
+
 /* Card pass runs before edges so links land on the map surface. */
 static void draw_node_card(int idx, float fade, double time) {
     const ImapGraph* gr = instance_map_data_graph();
@@ -734,23 +831,14 @@ static void draw_node_card(int idx, float fade, double time) {
     Rectangle card = node_rect(n);
 
     bool selected = idx == s_m.selected_node;
-    bool hovered = !grid_rotation_animating() &&
-        CheckCollisionPointRec(GetMousePosition(), card);
+    bool hovered = node_hovered(idx);
     Color accent = selected ? IMAP_SELECTED : hovered ? (Color){ 120, 220, 255, 255 } : IMAP_NODE_LINE;
     Color fill = selected ? (Color){ 55, 44, 24, 245 }
                : hovered ? (Color){ 32, 48, 74, 245 }
                          : IMAP_NODE_FILL;
     draw_pixel_panel(card, fill, accent, selected || hovered, fade);
     if (selected) draw_pixel_active_pulse(card, IMAP_SELECTED, fade, time);
-    if ('\0' != n->preview_url[0]) {
-        Texture2D tex = texture_cache_get(s_preview_cache, n->preview_url);
-        if (0 != tex.id) {
-            Rectangle src  = { 0, 0, (float)tex.width, (float)tex.height };
-            Rectangle dest = pixel_inner(card, 4.0f);
-            DrawTexturePro(tex, src, dest, (Vector2){ 0, 0 }, 0.0f,
-                           unfiltered_icon_color(fade));
-        }
-    }
+    draw_node_preview(n, card, fade);
     draw_pixel_border(card, accent, selected || hovered, fade);
     if (selected || hovered) {
         Color spark = fade_c(selected ? IMAP_SELECTED : WHITE, fade);
@@ -1025,6 +1113,172 @@ static Rectangle lerp_rect(Rectangle a, Rectangle b, float t) {
     };
 }
 
+/* ── Retained scene ─────────────────────────────────────────────────────────
+ *
+ * The settled graph — card shells and borders, and every link between fixed
+ * cells — tessellated in graph units (one unit = one card side, origin at
+ * the grid centre) and drawn with the camera as a single transform. Focused
+ * cards, previews, roaming links, pulses and POIs stay immediate-mode. Pixel
+ * widths are sized for the zoom of the last build, redone once a zoom
+ * settles. */
+
+#define IMAP_SCENE_ZOOM_SETTLE 0.005f   /* relative zoom drift that rebuilds */
+
+static struct {
+    bool   valid;
+    int    generation;
+    int    rotation;
+    float  zoom;
+    UIMesh cards;     /* shells under the previews */
+    UIMesh borders;   /* borders over the previews */
+    UIMesh edges;     /* links between fixed cells */
+} s_scene;
+
+static void scene_release(void) {
+    ui_mesh_release(&s_scene.cards);
+    ui_mesh_release(&s_scene.borders);
+    ui_mesh_release(&s_scene.edges);
+    s_scene.valid = false;
+}
+
+static Rectangle scene_card(const ImapNode* n, float angle) {
+    Vector2 o = node_grid_offset(n, angle);
+    return (Rectangle){ o.x - 0.5f, o.y - 0.5f, 1.0f, 1.0f };
+}
+
+/* Rectangle in build pixels, relative to the graph origin. */
+static void scene_px_rect(UIMesh* m, float px, float x, float y, float w, float h, Color c) {
+    ui_mesh_rect(m, (Rectangle){ x * px, y * px, w * px, h * px }, c);
+}
+
+/* Unfocused draw_pixel_panel + draw_pixel_border, `px` units per pixel. */
+static void scene_add_card(Rectangle card, float px) {
+    float t = 2.0f * px;
+    ui_mesh_rect(&s_scene.cards, card, BLACK);
+    ui_mesh_rect(&s_scene.cards, (Rectangle){ card.x + t, card.y + t, card.width - 2.0f * t,
+                                               card.height - 2.0f * t }, IMAP_NODE_FILL);
+
+    UIMesh* m = &s_scene.borders;
+    ui_mesh_rect(m, (Rectangle){ card.x, card.y, card.width, t }, IMAP_BORDER_LIGHT);
+    ui_mesh_rect(m, (Rectangle){ card.x, card.y, t, card.height }, IMAP_BORDER_LIGHT);
+    ui_mesh_rect(m, (Rectangle){ card.x, card.y + card.height - t, card.width, t },
+                 IMAP_BORDER_SHADE);
+    ui_mesh_rect(m, (Rectangle){ card.x + card.width - t, card.y, t, card.height },
+                 IMAP_BORDER_SHADE);
+    ui_mesh_rect(m, (Rectangle){ card.x, card.y + 4.0f * px, t, card.height - 8.0f * px },
+                 IMAP_NODE_LINE);
+}
+
+/* draw_edge without the pulse, for a link between fixed cells. */
+static void scene_add_edge(const ImapEdge* e, float angle, float px) {
+    const ImapGraph* gr  = instance_map_data_graph();
+    const ImapNode*  src = &gr->nodes[e->source_node];
+    const ImapNode*  tgt = &gr->nodes[e->target_node];
+    Vector2 a = cell_to_card(scene_card(src, angle), src, (float)e->source_cell_x + 0.5f,
+                             (float)e->source_cell_y + 0.5f);
+    Vector2 b = cell_to_card(scene_card(tgt, angle), tgt, (float)e->target_cell_x + 0.5f,
+                             (float)e->target_cell_y + 0.5f);
+    Vector2 pa = { a.x / px, a.y / px };
+    Vector2 pb = { b.x / px, b.y / px };
+    Color base = edge_color(e);
+    UIMesh* m = &s_scene.edges;
+
+    if (edge_is_short(pa, pb)) {
+        float x = roundf(pa.x), y = roundf(pa.y);
+        scene_px_rect(m, px, x - 8.0f, y - 8.0f, 17.0f, 17.0f, BLACK);
+        scene_px_rect(m, px, x - 5.0f, y - 5.0f, 11.0f, 11.0f, base);
+        scene_px_rect(m, px, x - 2.0f, y - 2.0f, 5.0f, 5.0f, WHITE);
+        return;
+    }
+
+    ui_mesh_line(m, a, b, 7.0f * px, IMAP_LINK_SHADOW);
+    ui_mesh_line(m, a, b, 3.0f * px, base);
+    ui_mesh_line(m, a, b, 1.0f * px, IMAP_LINK_LIGHT);
+    float dx = pb.x - pa.x;
+    float dy = pb.y - pa.y;
+    int steps = (int)(fmaxf(fabsf(dx), fabsf(dy)) / 4.0f) + 1;
+    if (steps > 384) steps = 384;
+    float last_x = -1e9f, last_y = -1e9f;
+    for (int i = 0; i <= steps; i++) {
+        float progress = (float)i / (float)steps;
+        float x = roundf(pa.x + dx * progress);
+        float y = roundf(pa.y + dy * progress);
+        if (x == last_x && y == last_y) continue;
+        scene_px_rect(m, px, x - 3.0f, y - 3.0f, 7.0f, 7.0f, IMAP_LINK_SHADOW);
+        scene_px_rect(m, px, x - 1.0f, y - 1.0f, 3.0f, 3.0f, base);
+        scene_px_rect(m, px, x - 1.0f, y - 1.0f, 1.0f, 1.0f, IMAP_LINK_LIGHT);
+        last_x = x;
+        last_y = y;
+    }
+}
+
+static void scene_sync(void) {
+    int   generation = instance_map_data_generation();
+    bool  settled = fabsf(s_m.zoom - s_m.zoom_target) <= s_m.zoom_target * IMAP_SCENE_ZOOM_SETTLE;
+    bool  rezoom  = settled &&
+                    fabsf(s_m.zoom - s_scene.zoom) > s_scene.zoom * IMAP_SCENE_ZOOM_SETTLE;
+    if (s_scene.valid && generation == s_scene.generation &&
+        s_grid_rotation == s_scene.rotation && !rezoom) {
+        return;
+    }
+
+    s_scene.valid      = true;
+    s_scene.generation = generation;
+    s_scene.rotation   = s_grid_rotation;
+    s_scene.zoom       = s_m.zoom;
+    ui_mesh_clear(&s_scene.cards);
+    ui_mesh_clear(&s_scene.borders);
+    ui_mesh_clear(&s_scene.edges);
+
+    const ImapGraph* gr = instance_map_data_graph();
+    float angle = grid_rotation_angle();
+    float px    = 1.0f / node_screen_side();
+    for (int i = 0; i < gr->node_count; ++i) scene_add_card(scene_card(&gr->nodes[i], angle), px);
+    for (int e = 0; e < gr->edge_count; ++e) {
+        if (edge_is_fixed(&gr->edges[e])) scene_add_edge(&gr->edges[e], angle, px);
+    }
+    ui_mesh_upload(&s_scene.cards);
+    ui_mesh_upload(&s_scene.borders);
+    ui_mesh_upload(&s_scene.edges);
+}
+
+static bool node_focused(int idx) {
+    return idx == s_m.selected_node || node_hovered(idx);
+}
+
+/* Same painter order as the live pass: cards → edges → overlays. */
+static void draw_graph_retained(double t) {
+    const ImapGraph* gr = instance_map_data_graph();
+    scene_sync();
+    Vector2 c      = panel_center();
+    Vector2 origin = { c.x + s_m.pan.x, c.y + s_m.pan.y };
+    float   side   = node_screen_side();
+
+    ui_mesh_draw(&s_scene.cards, origin, side);
+    for (int i = 0; i < gr->node_count; ++i) {
+        Rectangle card = node_rect(&gr->nodes[i]);
+        if (!node_focused(i)) draw_node_preview(&gr->nodes[i], card, 1.0f);
+    }
+    ui_mesh_draw(&s_scene.borders, origin, side);
+    for (int i = 0; i < gr->node_count; ++i) {
+        if (node_focused(i)) draw_node_card(i, 1.0f, t);
+    }
+
+    ui_mesh_draw(&s_scene.edges, origin, side);
+    for (int e = 0; e < gr->edge_count; ++e) {
+        const ImapEdge* edge = &gr->edges[e];
+        if (!edge_is_fixed(edge)) {
+            draw_edge(edge, e, 1.0f, t);
+            continue;
+        }
+        Vector2 a, b;
+        edge_points(edge, e, t, &a, &b);
+        if (!edge_is_short(a, b)) draw_edge_pulse(a, b, edge_color(edge), e, 1.0f, t);
+    }
+
+    for (int i = 0; i < gr->node_count; ++i) draw_node_overlay(i, 1.0f, t);
+}
+
 void modal_instance_map_draw(int screen_width, int screen_height) {
     /* The container morph (modal_map_expand_progress) doubles as the
      * open/close transition: keep drawing during the retract until the
@@ -1052,13 +1306,19 @@ void modal_instance_map_draw(int screen_width, int screen_height) {
     draw_backdrop(chrome);
 
     const ImapGraph* gr = instance_map_data_graph();
+    if (content > 0.0f && IMAP_DATA_READY == instance_map_data_state()) register_nodes();
     if (content > 0.0f) {
-        if (IMAP_DATA_READY == instance_map_data_state()) {
+        if (IMAP_DATA_READY == instance_map_data_state() && 1.0f <= content &&
+            !grid_rotation_animating()) {
+            draw_graph_retained(t);
+            draw_info_panel(content);
+        } else if (IMAP_DATA_READY == instance_map_data_state()) {
             int order[IMAP_MAX_NODES];
             sorted_node_order(order, gr->node_count);
 
             /* Cards → edges → overlays: link lines land on the map surfaces
-             * and the POI icons plug into them from above. */
+             * and the POI icons plug into them from above. Fading in or
+             * rotating, the graph is drawn live. */
             for (int i = 0; i < gr->node_count; ++i) draw_node_card(order[i], content, t);
             for (int e = 0; e < gr->edge_count; ++e) draw_edge(&gr->edges[e], e, content, t);
             for (int i = 0; i < gr->node_count; ++i) draw_node_overlay(order[i], content, t);
@@ -1,6 +1,7 @@
 #ifndef CYBERIA_UI_MODAL_INSTANCE_MAP_H
 #define CYBERIA_UI_MODAL_INSTANCE_MAP_H
 
+#include <raylib.h>
 #include <stdbool.h>
 
 /* modal_instance_map — expanded Instance Intelligence Map content.
@@ -22,6 +23,7 @@
  * polling; closing stops polling immediately.
  */
 
+/* Runs on first open; cleanup returns the modal to that state. */
 void modal_instance_map_init(void);
 void modal_instance_map_cleanup(void);
 
@@ -40,6 +42,10 @@ bool modal_instance_map_handle_click(int mx, int my);
 /* Wheel zoom while the pointer hovers the panel. */
 bool modal_instance_map_handle_wheel(float wheel_delta);
 
+/* Scripted camera move (bench runs): pan by `pan_px` screen pixels, then
+ * zoom by `zoom_factor` about the panel centre. No-op while closed. */
+void modal_instance_map_nudge(Vector2 pan_px, float zoom_factor);
+
 /* True when the pixel is covered by the open panel (input guard). */
 bool modal_instance_map_covers_point(int mx, int my);
 
@@ -20,9 +20,11 @@
 #include "quest_progress_store.h"
 #include "quest_cache.h"
 #include "ui_button.h"
+#include "ui_retained.h"
 #include "ui_scroll.h"
 #include "ui_icon.h"
 #include "util/log.h"
+#include "render_stats.h"
 
 #include <raylib.h>
 #include <stdio.h>
@@ -42,6 +44,7 @@ static float s_age  = 0.0f;
 static int   s_tab  = MI_TAB_STACK;
 
 static char  s_entity_id[64]    = {0};
+static EntityHandle s_entity_ref = ENTITY_HANDLE_NONE;   /* bot behind s_entity_id, once found */
 static char  s_display_name[64] = {0};
 static char  s_dlg_item[128]    = {0};
 static bool  s_has_dialogue = false;
@@ -68,6 +71,23 @@ static int  s_talk_sel = -1;
 static char  s_quest_codes[BOT_QUEST_CODES_MAX][64];
 static int   s_quest_code_count = 0;
 
+/* Moves when a quest on the grid (or every quest, on a store reset)
+ * changes: store updates for other quests leave the grid rows alone. */
+static unsigned s_quests_rev = 0;
+
+static void on_quest_changed(const char* code, unsigned dirty, void* user) {
+    if (!code) {
+        s_quests_rev++;
+        return;
+    }
+    for (int i = 0; i < s_quest_code_count; i++) {
+        if (0 == strcmp(s_quest_codes[i], code)) {
+            s_quests_rev++;
+            return;
+        }
+    }
+}
+
 /* True while this modal holds a server interaction context (dlg_start sent on
  * open, freezing the player and binding the entity); released on close. */
 static bool  s_dlg_context = false;
@@ -91,6 +111,7 @@ static int       s_q_btn_kind[MI_QUEST_MAX]; /* 0 none, 1 accept, 2 abandon */
 static char      s_q_btn_code[MI_QUEST_MAX][64];
 static int       s_q_count = 0;
 static UIScroll  s_q_scroll;
+static UIScrollRows s_q_rows;                /* grid row heights, row = slot / 2 */
 static float     s_q_content_height = 0.0f;
 
 /* Reward icon hit-boxes captured across all visible cards during the draw, so
@@ -167,6 +188,7 @@ static void es_pop(void) {
     s_es_depth--;
     const EpsSessionFrame* f = &s_es_stack[s_es_depth];
     strncpy(s_entity_id, f->entity_id, sizeof(s_entity_id) - 1);
+    s_entity_ref = ENTITY_HANDLE_NONE;
     strncpy(s_display_name, f->display_name, sizeof(s_display_name) - 1);
     strncpy(s_dlg_item, f->dlg_item, sizeof(s_dlg_item) - 1);
     memcpy(s_talk_quest_codes, f->talk_quest_codes, sizeof(s_talk_quest_codes));
@@ -282,8 +304,13 @@ static bool quest_tab_visible(void) {
  * changed. The selected quest-talk is re-resolved by quest code, so it survives
  * the set growing or shrinking around it. */
 static bool refresh_bot_snapshot(void) {
-    const BotState* bot = game_state_find_bot(s_entity_id);
-    if (!bot) return false;
+    const BotState* bot = game_state_bot_by_handle(s_entity_ref);
+    if (!bot) {
+        /* First refresh, or the bot left and came back as a new record. */
+        bot = game_state_find_bot(s_entity_id);
+        if (!bot) return false;
+        s_entity_ref = bot->base.ref;
+    }
 
     char prev_sel[64] = {0};
     if (0 <= s_talk_sel && s_talk_sel < s_talk_count) {
@@ -614,10 +641,13 @@ void modal_interact_discard_stack(void) {
 /* ── Public API ───────────────────────────────────────────────────────── */
 
 void modal_interact_init(void) {
+    static bool subscribed = false;
+    if (!subscribed) subscribed = quest_progress_store_subscribe(on_quest_changed, NULL);
     s_open = false;
     s_overlay_open = false;
     s_dialogue_open_requested = false;
     ui_scroll_reset(&s_q_scroll);
+    ui_scroll_rows_sync(&s_q_rows, 0);
     s_q_content_height = 0.0f;
     s_q_expanded = -1;
     s_q_expand_age = MODAL_POP_DURATION;
@@ -646,6 +676,7 @@ void modal_interact_open(const char* entity_id, const char* display_name,
 
     strncpy(s_entity_id, entity_id ? entity_id : "", sizeof(s_entity_id) - 1);
     s_entity_id[sizeof(s_entity_id) - 1] = '\0';
+    s_entity_ref = ENTITY_HANDLE_NONE;
     strncpy(s_display_name, display_name ? display_name : "", sizeof(s_display_name) - 1);
     s_display_name[sizeof(s_display_name) - 1] = '\0';
     strncpy(s_dlg_item, dialogue_item_id ? dialogue_item_id : "", sizeof(s_dlg_item) - 1);
@@ -661,6 +692,7 @@ void modal_interact_open(const char* entity_id, const char* display_name,
     s_open               = true;
     s_tab                = MI_TAB_STACK;
     ui_scroll_reset(&s_q_scroll);
+    ui_scroll_rows_sync(&s_q_rows, 0);
     s_q_content_height = 0.0f;
     s_q_expanded = -1;
     s_q_expand_age = MODAL_POP_DURATION;
@@ -1274,6 +1306,44 @@ static void draw_quest_detail(int slot, const char* code, float x, float w,
     *y += 4;
 }
 
+/* What the grid row heights follow: the titles (progress store and quest
+ * cache), the code list, the column width and font. */
+static uint64_t quest_grid_rows_key(float column_width, int font) {
+    uint64_t key = ui_retained_key_seed();
+    key = ui_retained_mix(key, s_quests_rev);
+    key = ui_retained_mix(key, quest_cache_generation());
+    key = ui_retained_mix(key, (uint64_t)(uint32_t)s_q_count << 8 | (uint32_t)font);
+    key = ui_retained_mix(key, viewport_is_mobile());
+    key = ui_retained_mix_float(key, column_width);
+    for (int i = 0; i < s_q_count; i++) {
+        for (const char* c = s_quest_codes[i]; *c; c++) key = ui_retained_mix(key, (uint8_t)*c);
+    }
+    return key;
+}
+
+/* Height of the grid row starting at `first_slot`: its taller card. */
+static float quest_grid_row_height(int first_slot, float column_width, int font) {
+    int row = first_slot / 2;
+    float h = ui_scroll_rows_get(&s_q_rows, row);
+    if (0.0f <= h) return h;
+    h = quest_grid_button_height(quest_card_info(s_quest_codes[first_slot]).title,
+                                 column_width, font);
+    if (first_slot + 1 < s_q_count) {
+        float right = quest_grid_button_height(quest_card_info(s_quest_codes[first_slot + 1]).title,
+                                               column_width, font);
+        if (right > h) h = right;
+    }
+    ui_scroll_rows_set(&s_q_rows, row, h);
+    return h;
+}
+
+static void quest_grid_clear_slot(int slot) {
+    s_q_grid_header[slot]      = (Rectangle){ 0 };
+    s_q_grid_btn[slot]         = (Rectangle){ 0 };
+    s_q_grid_action_btn[slot]  = (Rectangle){ 0 };
+    s_q_grid_action_kind[slot] = 0;
+}
+
 /* Quest tab: mission codes the server authoritatively says this NPC provides
  * to the player (from AOI; metadata fetched by code). Grid mode shows one
  * content-fit card button per mission; tapping one switches to that
@@ -1305,16 +1375,21 @@ static void draw_quest_tab(Rectangle content, int mx, int my) {
     } else {
         int qfont = quest_grid_font();
         float column_width = (content.width - MI_Q_GRID_GAP) * 0.5f;
+        ui_scroll_rows_sync(&s_q_rows, quest_grid_rows_key(column_width, qfont));
         for (int first_slot = 0; first_slot < s_q_count; first_slot += 2) {
-            QuestCardInfo left = quest_card_info(s_quest_codes[first_slot]);
-            float row_height = quest_grid_button_height(left.title, column_width, qfont);
-            QuestCardInfo right = { 0 };
             bool has_right = first_slot + 1 < s_q_count;
-            if (has_right) {
-                right = quest_card_info(s_quest_codes[first_slot + 1]);
-                float right_height = quest_grid_button_height(right.title, column_width, qfont);
-                if (right_height > row_height) row_height = right_height;
+            float row_height = quest_grid_row_height(first_slot, column_width, qfont);
+            if (!ui_scroll_row_visible(&s_q_scroll, y, row_height)) {
+                /* Off-view rows keep no stale hit rects from an earlier scroll. */
+                quest_grid_clear_slot(first_slot);
+                if (has_right) quest_grid_clear_slot(first_slot + 1);
+                y += row_height;
+                if (first_slot + 2 < s_q_count) y += MI_Q_GRID_GAP;
+                continue;
             }
+            QuestCardInfo left = quest_card_info(s_quest_codes[first_slot]);
+            QuestCardInfo right = { 0 };
+            if (has_right) right = quest_card_info(s_quest_codes[first_slot + 1]);
 
             Rectangle left_button = { content.x, y, column_width, row_height };
             draw_quest_grid_button(left_button, &left, first_slot, qfont, mx, my);
@@ -1,9 +1,11 @@
 #include "modal_map.h"
+#include "minimap.h"
 #include "text.h"
 #include "toolbar.h"
 
 #include "network/game_client.h"
 #include "game_state.h"
+#include "render_stats.h"
 
 #include <assert.h>
 #include <math.h>
@@ -14,6 +16,11 @@
 /* Container expand/retract transition length, seconds. */
 #define MODAL_MAP_EXPAND_DURATION 0.28f
 
+/* Minimap under the compact readout: largest side, gap and frame, pixels. */
+#define MODAL_MAP_MINIMAP_PX  112
+#define MODAL_MAP_MINIMAP_GAP 4
+#define MODAL_MAP_MINIMAP_PAD 3
+
 /* Global instance */
 ModalMap g_modal_map = {0};
 
@@ -31,6 +38,7 @@ int modal_map_init(void) {
 }
 
 void modal_map_cleanup(void) {
+    minimap_release();
     memset(&g_modal_map, 0, sizeof(ModalMap));
 }
 
@@ -141,6 +149,21 @@ void modal_map_draw(int screen_width, int screen_height) {
         Color line2_c = { 180, 195, 220, 210 };
         line2_c.a = (unsigned char)((float)line2_c.a * fade);
         shadow_text(line2, bx + pad, by + pad + lsp, fs, line2_c);
+
+        /* ── Minimap below the readout, hidden while expanded ─────────── */
+        float mini_fade = fade * (1.0f - modal_map_expand_progress());
+        if (g_modal_map.show_map && mini_fade > 0.01f) {
+            int mp = MODAL_MAP_MINIMAP_PAD;
+            Rectangle box = { (float)(bx + mp), (float)(by + box_h + MODAL_MAP_MINIMAP_GAP + mp),
+                              MODAL_MAP_MINIMAP_PX, MODAL_MAP_MINIMAP_PX };
+            Rectangle fit = minimap_fit(box);
+            if (0.0f < fit.width) {
+                DrawRectangleRounded((Rectangle){ fit.x - mp, fit.y - mp,
+                                                  fit.width + 2 * mp, fit.height + 2 * mp },
+                                     0.12f, 6, (Color){ 0, 0, 0, (unsigned char)(130.0f * mini_fade) });
+                minimap_draw(fit, mini_fade);
+            }
+        }
     }
 }
 
@@ -25,6 +25,7 @@
 #include "object_layers_management.h"
 #include "fx_reward.h"
 #include "ui_button.h"
+#include "render_stats.h"
 
 #include <raylib.h>
 #include <math.h>
@@ -77,18 +77,14 @@ void nameplate_resolve(const char *entity_id,
     if (dev) snprintf(out, (size_t)out_size, "%.8s", entity_id);
 }
 
-void nameplate_resolve_portal(const char *target_map_code,
-                              int target_cell_x,
-                              int target_cell_y,
-                              char *out,
-                              int out_size) {
-    if (!out || out_size <= 0) return;
-    out[0] = '\0';
-    if (!target_map_code || target_map_code[0] == '\0') return;
+TextValue nameplate_resolve_portal(const char *target_map_code,
+                                   int target_cell_x,
+                                   int target_cell_y,
+                                   int font_size) {
+    if (!target_map_code || target_map_code[0] == '\0') return (TextValue){ .width = 0 };
     /* Random portals (negative target cell) name only the map — the destination
      * cell is chosen at teleport time, so coordinates would be meaningless. */
     if (target_cell_x < 0 || target_cell_y < 0)
-        snprintf(out, (size_t)out_size, "%s", target_map_code);
-    else
-        snprintf(out, (size_t)out_size, "%s %d,%d", target_map_code, target_cell_x, target_cell_y);
+        return text_value_str("%s", target_map_code, 0, 0, font_size);
+    return text_value_str("%s %d,%d", target_map_code, target_cell_x, target_cell_y, font_size);
 }
@@ -18,6 +18,7 @@
 
 #include "object_layer.h"
 #include "object_layers_management.h"
+#include "ui/text.h"
 
 #include <stdbool.h>
 
@@ -43,12 +44,12 @@ void nameplate_resolve(const char *entity_id,
                        int out_size);
 
 /* Resolve a portal nameplate: "<target_map_code> <x>,<y>" for a fixed target, or
- * just "<target_map_code>" for a random target (negative cell). Empty when
- * target_map_code is empty. */
-void nameplate_resolve_portal(const char *target_map_code,
-                              int target_cell_x,
-                              int target_cell_y,
-                              char *out,
-                              int out_size);
+ * just "<target_map_code>" for a random target (negative cell), with its width
+ * at `font_size`. Empty when target_map_code is empty. Formatted and measured
+ * once per destination (ui/text.h text_value_str), not per portal per frame. */
+TextValue nameplate_resolve_portal(const char *target_map_code,
+                                   int target_cell_x,
+                                   int target_cell_y,
+                                   int font_size);
 
 #endif /* NAMEPLATE_H */
@@ -0,0 +1,222 @@
+#include "ui/overhead_labels.h"
+
+#include "gpu_memory.h"
+#include "hash_table.h"
+#include "ui/text.h"
+#include "render_stats.h"
+
+#include <assert.h>
+#include <math.h>
+#include <rlgl.h>
+#include <string.h>
+
+#define CELL_COLS  (OVERHEAD_LABEL_ATLAS_PX / OVERHEAD_LABEL_CELL_W)
+#define CELL_ROWS  (OVERHEAD_LABEL_ATLAS_PX / OVERHEAD_LABEL_CELL_H)
+#define CELL_COUNT (CELL_COLS * CELL_ROWS)
+
+/* A label with its text held inline, plus what else keys its pixels. */
+typedef struct {
+    uint64_t hash;
+    char     text[OVERHEAD_LABEL_TEXT_LEN];
+    int      size;
+    Color    fg;
+    Color    edge;
+    int      rings;
+    float    factor;     /* text_font_factor() */
+    uint32_t font_gen;   /* text_font_generation() */
+} LabelKey;
+
+typedef struct {
+    bool     used;
+    bool     fits;        /* false: too large, always drawn live */
+    LabelKey key;
+    int      w;           /* baked extent, edge padding included */
+    int      h;
+    uint32_t last_seen;   /* frame the label was last drawn */
+} LabelCell;
+
+static struct {
+    bool            loaded;
+    RenderTexture2D atlas;
+    LabelCell       cells[CELL_COUNT];
+    LabelKey        queue[OVERHEAD_LABEL_QUEUE];
+    int             queued;
+    uint32_t        frame;
+} g_overhead_labels;
+
+static int edge_pad(int rings) {
+    return rings > 0 ? rings : 1;
+}
+
+static uint32_t color_bits(Color c) {
+    return (uint32_t)c.r << 24 | (uint32_t)c.g << 16 | (uint32_t)c.b << 8 | c.a;
+}
+
+static bool color_eq(Color a, Color b) {
+    return color_bits(a) == color_bits(b);
+}
+
+static bool key_eq(const LabelKey* a, const LabelKey* b) {
+    return a->hash == b->hash && a->size == b->size && a->rings == b->rings &&
+           a->factor == b->factor && a->font_gen == b->font_gen &&
+           color_eq(a->fg, b->fg) && color_eq(a->edge, b->edge) &&
+           0 == strcmp(a->text, b->text);
+}
+
+/* False when the text does not fit the inline key. */
+static bool key_make(LabelKey* out, const OverheadLabel* label) {
+    size_t len = strlen(label->text);
+    if (OVERHEAD_LABEL_TEXT_LEN <= len) return false;
+    *out = (LabelKey){
+        .size     = label->size,
+        .fg       = label->fg,
+        .edge     = label->edge,
+        .rings    = label->rings,
+        .factor   = text_font_factor(),
+        .font_gen = text_font_generation(),
+    };
+    memcpy(out->text, label->text, len + 1);
+    uint64_t h = hash_table_hash(out->text);
+    h ^= ((uint64_t)(uint32_t)label->size << 32) | (uint32_t)label->rings;
+    h *= 1099511628211ull;
+    h ^= (uint64_t)color_bits(label->fg) << 32 | color_bits(label->edge);
+    h *= 1099511628211ull;
+    out->hash = h ^ out->font_gen;
+    return true;
+}
+
+static Rectangle cell_rect(int cell) {
+    return (Rectangle){
+        (float)(cell % CELL_COLS * OVERHEAD_LABEL_CELL_W),
+        (float)(cell / CELL_COLS * OVERHEAD_LABEL_CELL_H),
+        (float)OVERHEAD_LABEL_CELL_W,
+        (float)OVERHEAD_LABEL_CELL_H,
+    };
+}
+
+static void draw_label(const char* text, int size, Color fg, Color edge, int rings, int x, int y) {
+    if (0 < rings) {
+        text_draw_outlined(text, x, y, size, fg, edge, rings);
+        return;
+    }
+    DrawText(text, x + 1, y + 1, size, edge);
+    DrawText(text, x, y, size, fg);
+}
+
+void overhead_labels_draw_live(const OverheadLabel* label, int x, int y) {
+    assert(label && label->text);
+    draw_label(label->text, label->size, label->fg, label->edge, label->rings, x, y);
+}
+
+/* A free cell, else the one drawn longest ago and not in the last frame. */
+static int cell_claim(void) {
+    int best = -1;
+    for (int i = 0; i < CELL_COUNT; i++) {
+        const LabelCell* c = &g_overhead_labels.cells[i];
+        if (!c->used) return i;
+        if (c->last_seen + 1 >= g_overhead_labels.frame) continue;
+        if (best < 0 || c->last_seen < g_overhead_labels.cells[best].last_seen) best = i;
+    }
+    return best;
+}
+
+static int cell_find(const LabelKey* key) {
+    for (int i = 0; i < CELL_COUNT; i++) {
+        const LabelCell* c = &g_overhead_labels.cells[i];
+        if (c->used && key_eq(&c->key, key)) return i;
+    }
+    return -1;
+}
+
+static void cell_bake(int cell, const LabelKey* key) {
+    LabelCell* c = &g_overhead_labels.cells[cell];
+    int pad = edge_pad(key->rings);
+    *c = (LabelCell){
+        .used      = true,
+        .key       = *key,
+        .w         = MeasureText(key->text, key->size) + 2 * pad + 2,
+        .h         = (int)ceilf((float)key->size * key->factor) + 2 * pad + 2,
+        .last_seen = g_overhead_labels.frame,
+    };
+    c->fits = OVERHEAD_LABEL_CELL_W >= c->w && OVERHEAD_LABEL_CELL_H >= c->h;
+    if (!c->fits) return;
+
+    Rectangle r = cell_rect(cell);
+    BeginScissorMode((int)r.x, (int)r.y, (int)r.width, (int)r.height);
+    ClearBackground(BLANK);
+    EndScissorMode();
+    draw_label(key->text, key->size, key->fg, key->edge, key->rings,
+               (int)r.x + pad, (int)r.y + pad);
+}
+
+void overhead_labels_prepare(void) {
+    g_overhead_labels.frame++;
+    if (0 == g_overhead_labels.queued) return;
+    if (!g_overhead_labels.loaded) {
+        g_overhead_labels.atlas = LoadRenderTexture(OVERHEAD_LABEL_ATLAS_PX, OVERHEAD_LABEL_ATLAS_PX);
+        SetTextureFilter(g_overhead_labels.atlas.texture, TEXTURE_FILTER_BILINEAR);
+        gpu_memory_add(GPU_MEM_LABELS, gpu_memory_texture_bytes(g_overhead_labels.atlas.texture));
+        g_overhead_labels.loaded = true;
+        BeginTextureMode(g_overhead_labels.atlas);
+        ClearBackground(BLANK);
+        EndTextureMode();
+    }
+
+    /* Straight-alpha draws onto a cleared cell leave premultiplied colour
+     * and a correctly accumulated alpha behind. */
+    BeginTextureMode(g_overhead_labels.atlas);
+    rlSetBlendFactorsSeparate(RL_SRC_ALPHA, RL_ONE_MINUS_SRC_ALPHA, RL_ONE, RL_ONE_MINUS_SRC_ALPHA,
+                              RL_FUNC_ADD, RL_FUNC_ADD);
+    BeginBlendMode(BLEND_CUSTOM_SEPARATE);
+    int baked = 0;
+    for (int q = 0; q < g_overhead_labels.queued && OVERHEAD_LABEL_BAKES_PER_FRAME > baked; q++) {
+        const LabelKey* key = &g_overhead_labels.queue[q];
+        if (0 <= cell_find(key)) continue;
+        int cell = cell_claim();
+        if (0 > cell) break;
+        cell_bake(cell, key);
+        baked++;
+    }
+    EndBlendMode();
+    EndTextureMode();
+    /* Labels left over are queued again by their next miss. */
+    g_overhead_labels.queued = 0;
+}
+
+int overhead_labels_find(const OverheadLabel* label) {
+    assert(label && label->text);
+    LabelKey key;
+    if (!key_make(&key, label)) return -1;
+    int cell = cell_find(&key);
+    if (0 <= cell) {
+        LabelCell* c = &g_overhead_labels.cells[cell];
+        c->last_seen = g_overhead_labels.frame;
+        return c->fits ? cell : -1;
+    }
+    for (int q = 0; q < g_overhead_labels.queued; q++) {
+        if (key_eq(&g_overhead_labels.queue[q], &key)) return -1;
+    }
+    if (OVERHEAD_LABEL_QUEUE > g_overhead_labels.queued) {
+        g_overhead_labels.queue[g_overhead_labels.queued++] = key;
+    }
+    return -1;
+}
+
+void overhead_labels_blit(int cell, int x, int y) {
+    assert(0 <= cell && CELL_COUNT > cell && g_overhead_labels.cells[cell].fits);
+    const LabelCell* c = &g_overhead_labels.cells[cell];
+    Rectangle r = cell_rect(cell);
+    int pad = edge_pad(c->key.rings);
+    /* Render textures are stored bottom-up. */
+    Rectangle src = { r.x, (float)OVERHEAD_LABEL_ATLAS_PX - r.y - (float)c->h, (float)c->w, -(float)c->h };
+    Rectangle dst = { (float)(x - pad), (float)(y - pad), (float)c->w, (float)c->h };
+    DrawTexturePro(g_overhead_labels.atlas.texture, src, dst, (Vector2){ 0, 0 }, 0.0f, WHITE);
+}
+
+void overhead_labels_release(void) {
+    if (g_overhead_labels.loaded) {
+        gpu_memory_sub(GPU_MEM_LABELS, gpu_memory_texture_bytes(g_overhead_labels.atlas.texture));
+        UnloadRenderTexture(g_overhead_labels.atlas);
+    }
+    memset(&g_overhead_labels, 0, sizeof(g_overhead_labels));
+}
@@ -0,0 +1,54 @@
+#ifndef CYBERIA_UI_OVERHEAD_LABELS_H
+#define CYBERIA_UI_OVERHEAD_LABELS_H
+
+#include <raylib.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Overhead text labels pre-rendered into one shared atlas.
+ *
+ * The nameplate, HP, Σ-stats and countdown labels carry a drop shadow or a
+ * gapless outline, up to 17 DrawText passes a label, for every entity every
+ * frame. Each distinct label (text, size, colours, edge, font) is baked once
+ * into a cell of a render-texture atlas and drawn afterwards as a single
+ * quad. The atlas holds premultiplied colour, so baked labels are drawn
+ * under BLEND_ALPHA_PREMULTIPLY.
+ *
+ * A label that is not baked yet is drawn live and queued; the queue bakes in
+ * overhead_labels_prepare(), at most OVERHEAD_LABEL_BAKES_PER_FRAME a frame.
+ * Cells are LRU-recycled, never while their label was drawn in the last
+ * frame; a label too large for a cell always draws live. */
+
+#define OVERHEAD_LABEL_ATLAS_PX        1024
+#define OVERHEAD_LABEL_CELL_W          256
+#define OVERHEAD_LABEL_CELL_H          32
+#define OVERHEAD_LABEL_TEXT_LEN        80
+#define OVERHEAD_LABEL_QUEUE           64
+#define OVERHEAD_LABEL_BAKES_PER_FRAME 24
+
+typedef struct {
+    const char* text;
+    int         size;    /* DrawText size, before the font factor */
+    Color       fg;
+    Color       edge;
+    int         rings;   /* outline rings; 0 draws a drop shadow at (+1, +1) */
+} OverheadLabel;
+
+/* Bake the queued labels. Must run outside BeginMode2D — baking switches the
+ * render target. */
+void overhead_labels_prepare(void);
+
+/* Baked cell of `label`, or -1 after queueing it for a bake. */
+int  overhead_labels_find(const OverheadLabel* label);
+
+/* Draw baked `cell` with its text's top-left at (x, y), where DrawText would
+ * put it. Call under BLEND_ALPHA_PREMULTIPLY. */
+void overhead_labels_blit(int cell, int x, int y);
+
+/* Draw `label` live at (x, y), as the bake does. */
+void overhead_labels_draw_live(const OverheadLabel* label, int x, int y);
+
+/* Unload the atlas and forget every cell. */
+void overhead_labels_release(void);
+
+#endif /* CYBERIA_UI_OVERHEAD_LABELS_H */
@@ -5,44 +5,42 @@
  * status, progress).  All presentation metadata (title, description, steps,
  * rewards) is fetched lazily from the engine REST endpoint
  * GET /api/cyberia-quest/code/:code and cached here so the quest journal and
- * action tab can render rich details without blocking.  Metadata is immutable,
- * so each code is fetched at most once per session.
+ * action tab can render rich details without blocking.  Storage, eviction and
+ * retry timing live in meta_cache; this file owns the URL and the parse.
  */
 
 #include "quest_cache.h"
 #include "quest_progress_store.h"
+#include "ui/meta_bulk.h"
 
+#include "config.h"
 #include "network/engine_client.h"
+#include "serial.h"
 #include "util/log.h"
 
 #include <cJSON.h>
 #include <stdio.h>
-#include <stdlib.h>
 #include <string.h>
 
-static QuestMetadataEntry s_cache[QUEST_CACHE_CAP];
-static int                s_count = 0;
+static MetaCacheSlot      s_slots[QUEST_CACHE_CAP];
+static QuestMetadataEntry s_entries[QUEST_CACHE_CAP];
+static MetaCache          s_cache = {
+    .name        = "quest",
+    .slots       = s_slots,
+    .entries     = s_entries,
+    .stride      = sizeof(QuestMetadataEntry),
+    .capacity    = QUEST_CACHE_CAP,
+    .error_ttl   = QUEST_CACHE_ERROR_TTL,
+    .refresh_ttl = QUEST_CACHE_REFRESH_TTL,
+    .index       = { .records = s_slots, .stride = sizeof(MetaCacheSlot) },
+};
 
-static QuestMetadataEntry* find_by_code(const char* code) {
-    if (!code) return NULL;
-    for (int i = 0; i < s_count; ++i) {
-        if (0 == strcmp(s_cache[i].code, code)) return &s_cache[i];
-    }
-    return NULL;
+void quest_cache_reset(void) {
+    meta_cache_reset(&s_cache);
 }
 
-static QuestMetadataEntry* find_or_create(const char* code) {
-    QuestMetadataEntry* e = find_by_code(code);
-    if (e) return e;
-    if (s_count >= QUEST_CACHE_CAP) return NULL;
-    e = &s_cache[s_count++];
-    memset(e, 0, sizeof(QuestMetadataEntry));
-    strncpy(e->code, code, QUEST_CACHE_CODE_MAX - 1);
-    return e;
-}
-
-void quest_cache_reset(void) {
-    s_count = 0;
+unsigned quest_cache_generation(void) {
+    return meta_cache_generation(&s_cache);
 }
 
 static void copy_str(char* dst, size_t cap, const char* src) {
@@ -53,29 +51,56 @@ static void copy_str(char* dst, size_t cap, const char* src) {
 
 const QuestMetadataEntry* quest_cache_get(const char* code) {
     if (!code) return NULL;
-    return find_by_code(code);
+    return meta_cache_get(&s_cache, code);
 }
 
 QuestCacheState quest_cache_state(const char* code) {
-    const QuestMetadataEntry* e = quest_cache_get(code);
-    if (!e) return QUEST_CACHE_NONE;
-    return e->state;
+    if (!code) return QUEST_CACHE_NONE;
+    return (QuestCacheState)meta_cache_state(&s_cache, code);
 }
 
+#define QUEST_URL_FORMAT "/api/cyberia-quest/code/%s"
+
 static void on_quest_fetched(const FetchResponse* r);
+static void on_quest_bulk_fetched(const FetchResponse* r);
 
-void quest_cache_fetch(const char* code) {
-    if (!code || '\0' == code[0]) return;
+static FetchBatch* s_prefetch_batch = NULL;
 
-    QuestMetadataEntry* e = find_or_create(code);
-    if (!e) return;
-    if (QUEST_CACHE_READY == e->state || QUEST_CACHE_LOADING == e->state) return;
+/* Claim `code` for a request, or NULL when none is due. */
+static QuestMetadataEntry* begin_fetch(const char* code) {
+    if (!code || '\0' == code[0]) return NULL;
+
+    QuestMetadataEntry* e = meta_cache_begin_fetch(&s_cache, code);
+    if (!e) return NULL;
+    if ('\0' == e->code[0]) copy_str(e->code, QUEST_CACHE_CODE_MAX, code);
+    e->state = quest_cache_state(code);
+    return e;
+}
 
-    e->state = QUEST_CACHE_LOADING;
+void quest_cache_fetch(const char* code) {
+    if (!begin_fetch(code)) return;
 
     char url[512];
-    snprintf(url, sizeof url, "/api/cyberia-quest/code/%s", code);
-    fetch_request_start(code, url, on_quest_fetched);
+    snprintf(url, sizeof url, QUEST_URL_FORMAT, code);
+    fetch_request_start(code, url, FETCH_CLASS_UI, on_quest_fetched);
+}
+
+void quest_cache_prefetch(const char* code) {
+    if (!begin_fetch(code)) return;
+
+    if (!s_prefetch_batch) {
+        s_prefetch_batch = fetch_batch_create(&(FetchBatchConfig){
+            .name        = "quest-metadata-bulk",
+            .bulk_url    = "/api/cyberia-quest/codes?codes=",
+            .single_url  = QUEST_URL_FORMAT,
+            .max_keys    = META_PREFETCH_BATCH_MAX_KEYS,
+            .window_ms   = META_PREFETCH_BATCH_WINDOW_MS,
+            .fetch_class = FETCH_CLASS_PREFETCH,
+            .on_bulk     = on_quest_bulk_fetched,
+            .on_item     = on_quest_fetched,
+        });
+    }
+    fetch_batch_request(s_prefetch_batch, code, NULL);
 }
 
 /* Parse the quest doc (`data` object of the engine envelope) into entry. */
@@ -154,19 +179,20 @@ static void ingest_quest_doc(QuestMetadataEntry* e, const cJSON* doc) {
     }
 }
 
-/* Cache the parsed quest doc under `code` and mirror title/description into
- * quest_progress_store so the journal and action tab render without polling. */
-static void store_quest_doc(const char* code, const cJSON* doc) {
-    QuestMetadataEntry* e = find_or_create(code);
-    if (!e) return;
+/* Replace the pending entry with the parsed quest doc and mirror
+ * title/description into quest_progress_store so the journal and action tab
+ * render without polling. */
+static void store_quest_doc(QuestMetadataEntry* e, const char* code, const cJSON* doc) {
+    memset(e, 0, sizeof(*e));
     copy_str(e->code, QUEST_CACHE_CODE_MAX, code);
     ingest_quest_doc(e, doc);
+    meta_cache_settle(&s_cache, code, true);
     e->state = QUEST_CACHE_READY;
     quest_progress_store_set_meta(code, e->title, e->description);
 }
 
 /* Returns the envelope's `data` object on success, else NULL. Caller owns
- * `root` and must cJSON_Delete it regardless of the return value. */
+ * `root` and must serial_json_free it regardless of the return value. */
 static const cJSON* envelope_success_doc(const cJSON* root) {
     if (!root) return NULL;
     const cJSON* status = cJSON_GetObjectItemCaseSensitive(root, "status");
@@ -178,24 +204,40 @@ static const cJSON* envelope_success_doc(const cJSON* root) {
     return doc;
 }
 
+/* Settle a failed fetch; a failed refresh keeps the entry READY. */
+static void fail_quest_fetch(QuestMetadataEntry* e, const char* code) {
+    meta_cache_settle(&s_cache, code, false);
+    e->state = quest_cache_state(code);
+}
+
 static void on_quest_fetched(const FetchResponse* r) {
-    QuestMetadataEntry* e = find_by_code(r->asset_id);
-    if (!e) { free(r->data); return; }
+    QuestMetadataEntry* e = meta_cache_pending(&s_cache, r->asset_id);
+    if (!e) { return; }
 
     if (!r->success) {
-        e->state = QUEST_CACHE_ERROR;
+        fail_quest_fetch(e, r->asset_id);
         LOG_WARN("quest metadata fetch failed for %s", r->asset_id);
-        free(r->data);
         return;
     }
 
-    cJSON* root = cJSON_ParseWithLength((const char*)r->data, r->size);
+    cJSON* root = serial_json_parse((const char*)r->data, r->size);
     const cJSON* doc = envelope_success_doc(root);
     if (!doc) {
-        e->state = QUEST_CACHE_ERROR;
+        fail_quest_fetch(e, r->asset_id);
     } else {
-        store_quest_doc(r->asset_id, doc);
+        store_quest_doc(e, r->asset_id, doc);
     }
-    cJSON_Delete(root);
-    free(r->data);
+    serial_json_free(root);
+}
+
+static void store_bulk_doc(const char* code, const cJSON* doc) {
+    QuestMetadataEntry* e = meta_cache_pending(&s_cache, code);
+    if (e) store_quest_doc(e, code, doc);
+}
+
+/* Bulk envelope: `data` is an array of quest docs, each naming its `code`,
+ * ingested in a frame task (meta_bulk.h). A code the engine left out stays
+ * LOADING until meta_cache times it out. */
+static void on_quest_bulk_fetched(const FetchResponse* r) {
+    meta_bulk_defer(r, store_bulk_doc);
 }
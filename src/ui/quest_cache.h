@@ -5,6 +5,10 @@
  * status, progress).  All presentation metadata (title, description, steps,
  * rewards) is fetched lazily from the engine REST endpoint
  * GET /api/cyberia-quest/:code.
+ *
+ * Backed by a meta_cache: hashed lookup, LRU eviction once QUEST_CACHE_CAP
+ * codes are resident, failed fetches retried after QUEST_CACHE_ERROR_TTL and
+ * READY quests refreshed in the background after QUEST_CACHE_REFRESH_TTL.
  */
 
 #ifndef QUEST_CACHE_H
@@ -12,6 +16,8 @@
 
 #include <stdbool.h>
 
+#include "meta_cache.h"
+
 #define QUEST_CACHE_CODE_MAX   64
 #define QUEST_CACHE_TITLE_MAX  96
 #define QUEST_CACHE_DESC_MAX   256
@@ -22,12 +28,14 @@
 #define QUEST_CACHE_OBJ_MAX    4
 #define QUEST_CACHE_STEPDESC_MAX 160
 #define QUEST_CACHE_CAP 64
+#define QUEST_CACHE_ERROR_TTL   30.0   /* seconds */
+#define QUEST_CACHE_REFRESH_TTL 600.0  /* seconds */
 
 typedef enum {
-    QUEST_CACHE_NONE = 0,
-    QUEST_CACHE_LOADING,
-    QUEST_CACHE_READY,
-    QUEST_CACHE_ERROR,
+    QUEST_CACHE_NONE    = META_CACHE_NONE,
+    QUEST_CACHE_LOADING = META_CACHE_LOADING,
+    QUEST_CACHE_READY   = META_CACHE_READY,
+    QUEST_CACHE_ERROR   = META_CACHE_ERROR,
 } QuestCacheState;
 
 typedef struct {
@@ -66,15 +74,25 @@ typedef struct {
 
 void quest_cache_reset(void);
 
-/* Look up cached metadata by code. Returns NULL if not present. */
+/* Changes whenever an entry is created or its fetch state moves. */
+unsigned quest_cache_generation(void);
+
+/* Look up cached metadata by code. Returns NULL if not present. The entry
+ * stays valid at least until the next quest_cache_fetch() of another code. */
 const QuestMetadataEntry* quest_cache_get(const char* code);
 
 /* Return the fetch state for a quest code. */
 QuestCacheState quest_cache_state(const char* code);
 
 /* Schedule an async REST fetch (GET /api/cyberia-quest/code/:code) via
- * engine_client if not already cached/loading. Parses the
+ * engine_client if not already cached/loading, or when a failed or aging
+ * entry is due for a retry or background refresh. Parses the
  * `{ status, data: <quest doc> }` envelope on completion. */
 void quest_cache_fetch(const char* code);
 
+/* quest_cache_fetch() at FETCH_CLASS_PREFETCH, coalesced with other
+ * prefetches into one GET /api/cyberia-quest/codes?codes=a,b,c (falling
+ * back to the per-code route on an engine without it). */
+void quest_cache_prefetch(const char* code);
+
 #endif /* QUEST_CACHE_H */
@@ -10,8 +10,11 @@
 #include "ui_icon.h"
 #include "ui_scroll.h"
 #include "ui_toggle.h"
+#include "ui/ui_retained.h"
+#include "render_stats.h"
 
 #include <raylib.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <string.h>
 
@@ -70,8 +73,10 @@ static float    s_header_h  = QJ_HEADER_H; /* fixed header height (never scrolls
 static float    s_content_h = 0.0f;  /* full section height below the header      */
 static Rectangle s_view     = { 0 };  /* scroll viewport captured for update       */
 static UIScroll s_scroll;             /* clips + scrolls the section content       */
+static UIScrollRows s_rows;           /* card heights, row = section·page size + i */
 static UIToggle s_section[QUEST_STATUS_COUNT];
 static int      s_page[QUEST_STATUS_COUNT]   = { 0, 0, 0 };
+static UIRetained s_retained;         /* the settled panel, composited as one quad */
 
 static int page_count(int count) {
     if (count <= 0) return 1;
@@ -94,6 +99,14 @@ static bool hit(int mx, int my, Rectangle r) {
             (float)my >= r.y && (float)my < r.y + r.height);
 }
 
+/* Every quest has a card, so any change counts; the journal never rescans
+ * on its own. */
+static unsigned s_quests_rev = 0;
+
+static void on_quest_changed(const char* code, unsigned dirty, void* user) {
+    s_quests_rev++;
+}
+
 static void ensure_init(void) {
     if (s_init) return;
     Rectangle z = { 0, 0, QJ_CHEVRON, QJ_CHEVRON };
@@ -101,6 +114,7 @@ static void ensure_init(void) {
         ui_toggle_init(&s_section[i], z, i == QUEST_ACTIVE, UI_TOGGLE_CHEVRON_DOWN);
     }
     ui_scroll_reset(&s_scroll);
+    ui_scroll_rows_sync(&s_rows, 0);
     s_init = true;
 }
 
@@ -161,6 +175,16 @@ static int quest_card_layout(bool draw, const QuestProgressEntry* e, QuestStatus
     return (cy - y) + QJ_CARD_PAD;
 }
 
+/* Card height, wrapped once per row while the rows key holds. */
+static float quest_card_height(int row, const QuestProgressEntry* e, QuestStatus sec, int w) {
+    float h = ui_scroll_rows_get(&s_rows, row);
+    if (0.0f > h) {
+        h = (float)quest_card_layout(false, e, sec, 0, 0, w);
+        ui_scroll_rows_set(&s_rows, row, h);
+    }
+    return h;
+}
+
 /* ── Layout walks (single source of truth) ────────────────────────────── */
 /* JW_DRAW renders, JW_CLICK hit-tests + applies actions, JW_MEASURE only
  * advances the y cursor to size the region. The header is fixed; the sections
@@ -219,10 +243,10 @@ static float sections_walk(int mode, int mx, int my, float x, float y0, float w)
             const QuestProgressEntry* e = quest_progress_store_get((QuestStatus)sec, i);
             if (!e) continue;
 
-            int ch = quest_card_layout(false, e, (QuestStatus)sec,
-                                       (int)(x + QJ_CARD_MX), (int)y, (int)(w - 2 * QJ_CARD_MX));
-            if (JW_DRAW == mode) {
-                Rectangle card = { x + QJ_CARD_MX, y, w - 2 * QJ_CARD_MX, (float)ch };
+            int row = sec * QUEST_JOURNAL_PAGE_SIZE + (i - start);
+            float ch = quest_card_height(row, e, (QuestStatus)sec, (int)(w - 2 * QJ_CARD_MX));
+            if (JW_DRAW == mode && ui_scroll_row_visible(&s_scroll, y, ch)) {
+                Rectangle card = { x + QJ_CARD_MX, y, w - 2 * QJ_CARD_MX, ch };
                 DrawRectangleRounded(card, 0.16f, 4, C_CARD);
                 quest_card_layout(true, e, (QuestStatus)sec,
                                   (int)(x + QJ_CARD_MX), (int)y, (int)(w - 2 * QJ_CARD_MX));
@@ -266,6 +290,8 @@ static float sections_walk(int mode, int mx, int my, float x, float y0, float w)
 /* ── Public API ───────────────────────────────────────────────────────── */
 
 void quest_journal_init(void) {
+    static bool subscribed = false;
+    if (!subscribed) subscribed = quest_progress_store_subscribe(on_quest_changed, NULL);
     s_init    = false;
     s_visible = false;
     s_age     = 0.0f;
@@ -308,7 +334,16 @@ void quest_journal_update(float dt) {
     /* Ensure every tracked quest has its metadata — the store seeds from the
      * authoritative snapshot (codes + progress only), so titles/descriptions
      * for quests we never opened (e.g. seeded on reconnect, completed, failed)
-     * would otherwise render blank. The cache no-ops once a code is resolved. */
+     * would otherwise render blank. The cache no-ops once a code is resolved.
+     * Walked when a quest or a fetch moved, and every error TTL so failed
+     * fetches still get their retry. */
+    static unsigned scanned_rev = 0, scanned_cache = 0;
+    static double   next_scan = 0.0;
+    double now = GetTime();
+    if (scanned_rev == s_quests_rev && scanned_cache == quest_cache_generation() && now < next_scan) return;
+    scanned_rev   = s_quests_rev;
+    scanned_cache = quest_cache_generation();
+    next_scan     = now + QUEST_CACHE_ERROR_TTL;
     for (int sec = 0; sec < QUEST_STATUS_COUNT; ++sec) {
         int n = quest_progress_store_count((QuestStatus)sec);
         for (int i = 0; i < n; ++i) {
@@ -318,13 +353,25 @@ void quest_journal_update(float dt) {
     }
 }
 
-void quest_journal_draw(void) {
-    if (!s_visible) return;
-    ensure_init();
+/* What the cached card heights follow: the quest text, the width and the
+ * page each section shows. */
+static uint64_t rows_key(float width) {
+    uint64_t key = ui_retained_key_seed();
+    key = ui_retained_mix(key, s_quests_rev);
+    key = ui_retained_mix(key, quest_cache_generation());
+    key = ui_retained_mix_float(key, width);
+    for (int i = 0; i < QUEST_STATUS_COUNT; ++i) key = ui_retained_mix(key, (uint64_t)(uint32_t)s_page[i]);
+    return key;
+}
+
+/* Measure the fixed header and the full (unclipped) section height, then
+ * size the scroll viewport and the panel from them. */
+static void journal_layout(void) {
     Rectangle panel = panel_rect();
     float x = panel.x, w = panel.width, y = panel.y;
 
-    /* Measure: fixed header, then the full (unclipped) section height. */
+    ui_scroll_rows_sync(&s_rows, rows_key(w));
+
     s_header_h = header_walk(JW_MEASURE, 0, 0, x, y, w);
     s_content_h = sections_walk(JW_MEASURE, 0, 0, x, y + s_header_h, w) - (y + s_header_h);
 
@@ -335,6 +382,11 @@ void quest_journal_draw(void) {
     float view_h = s_content_h < view_h_avail ? s_content_h : view_h_avail;
     s_view = (Rectangle){ x, y + s_header_h, w, view_h };
     s_panel_h = s_header_h + view_h;
+}
+
+static void journal_paint(void) {
+    Rectangle panel = panel_rect();
+    float x = panel.x, w = panel.width, y = panel.y;
 
     /* Translucent fill so the grid reads through the journal, plus the shared
      * border and fade-in. */
@@ -349,13 +401,65 @@ void quest_journal_draw(void) {
 
     header_walk(JW_DRAW, 0, 0, x, y, w);
 
-    if (view_h > 0.0f) {
+    if (s_view.height > 0.0f) {
         ui_scroll_begin(&s_scroll);
         sections_walk(JW_DRAW, 0, 0, x, y + s_header_h - ui_scroll_offset(&s_scroll), w);
         ui_scroll_end(&s_scroll);
     }
 }
 
+/* Everything the journal's pixels follow, besides the animations that keep
+ * it live (journal_animating). */
+static uint64_t journal_key(void) {
+    uint64_t key = ui_retained_key_seed();
+    key = ui_retained_mix(key, s_quests_rev);
+    key = ui_retained_mix(key, quest_cache_generation());
+    key = ui_retained_mix_float(key, panel_top());
+    key = ui_retained_mix_float(key, available_height());
+    key = ui_retained_mix_float(key, ui_scroll_offset(&s_scroll));
+    for (int i = 0; i < QUEST_STATUS_COUNT; ++i) {
+        key = ui_retained_mix(key, (uint64_t)(uint32_t)s_page[i] << 1 | s_section[i].expanded);
+    }
+    return key;
+}
+
+/* Pop-in, a chevron turning, a drag or glide, or the scrollbar fading. */
+static bool journal_animating(void) {
+    if (s_age < MODAL_POP_DURATION) return true;
+    if (s_scroll.pressed || 0.0f != s_scroll.vel || 0.0f < s_scroll.bar_alpha) return true;
+    for (int i = 0; i < QUEST_STATUS_COUNT; ++i) {
+        if (s_section[i].anim_t != (s_section[i].expanded ? 1.0f : 0.0f)) return true;
+    }
+    return false;
+}
+
+void quest_journal_draw(void) {
+    if (!s_visible) {
+        ui_retained_release(&s_retained);
+        return;
+    }
+    ensure_init();
+
+    if (journal_animating()) {
+        journal_layout();
+        journal_paint();
+        return;
+    }
+
+    /* Settled: redraw into the retained texture only when an input moved. */
+    uint64_t key = journal_key();
+    if (ui_retained_stale(&s_retained, key)) {
+        journal_layout();
+        Rectangle panel = panel_rect();
+        panel.height = s_panel_h;
+        if (ui_retained_begin(&s_retained, panel, key)) {
+            journal_paint();
+            ui_retained_end(&s_retained);
+        }
+    }
+    ui_retained_draw(&s_retained);
+}
+
 bool quest_journal_handle_click(int mx, int my) {
     if (!s_visible) return false;
     Rectangle panel = panel_rect();
@@ -1,12 +1,56 @@
 #include "quest_progress_store.h"
 
+#include "hash_table.h"
+
+#include <ctype.h>
+#include <stdint.h>
+#include <stdlib.h>
 #include <string.h>
 
+typedef struct {
+    QuestChangeFn fn;
+    void*         user;
+} QuestSubscriber;
+
 static QuestProgressEntry s_entries[QUEST_PROGRESS_STORE_CAP];
 static int        s_count = 0;
+static unsigned   s_generation = 0;
+static HashTable  s_index;                /* code → entry index + 1 */
+static bool       s_index_ready = false;
+
+/* Entry indices per section, in insertion order; rebuilt after a status
+ * change or reset. */
+static int        s_section[QUEST_STATUS_COUNT][QUEST_PROGRESS_STORE_CAP];
+static int        s_section_count[QUEST_STATUS_COUNT];
+static bool       s_sections_dirty = true;
+
+static QuestSubscriber s_subscribers[QUEST_SUBSCRIBERS_MAX];
+static int             s_subscriber_count = 0;
+
+static void notify(const char* code, unsigned dirty) {
+    s_generation++;
+    for (int i = 0; i < s_subscriber_count; ++i) {
+        s_subscribers[i].fn(code, dirty, s_subscribers[i].user);
+    }
+}
 
 void quest_progress_store_reset(void) {
     s_count = 0;
+    if (s_index_ready) hash_table_destroy(&s_index);
+    hash_table_init(&s_index, 64, NULL, "quest_progress");
+    s_index_ready    = true;
+    s_sections_dirty = true;
+    notify(NULL, QUEST_DIRTY_ALL);
+}
+
+unsigned quest_progress_store_generation(void) {
+    return s_generation;
+}
+
+bool quest_progress_store_subscribe(QuestChangeFn fn, void* user) {
+    if (!fn || s_subscriber_count >= QUEST_SUBSCRIBERS_MAX) return false;
+    s_subscribers[s_subscriber_count++] = (QuestSubscriber){ .fn = fn, .user = user };
+    return true;
 }
 
 QuestStatus quest_progress_store_parse_status(const char* status_str) {
@@ -17,56 +61,96 @@ QuestStatus quest_progress_store_parse_status(const char* status_str) {
     return QUEST_ACTIVE;
 }
 
-static void copy_field(char* dst, size_t cap, const char* src) {
-    if (!src) { dst[0] = '\0'; return; }
+/* Copy `src` into `dst`; true when that changed `dst`. */
+static bool copy_field(char* dst, size_t cap, const char* src) {
+    if (!src) src = "";
+    if (0 == strncmp(dst, src, cap - 1)) return false;
     strncpy(dst, src, cap - 1);
     dst[cap - 1] = '\0';
+    return true;
 }
 
-static QuestProgressEntry* find_by_code(const char* code) {
-    for (int i = 0; i < s_count; ++i) {
-        if (0 == strcmp(s_entries[i].code, code)) return &s_entries[i];
+/* Every "done/required" pair in the objectives text, in order. */
+static int parse_counters(const char* text, QuestCounter* out) {
+    int n = 0;
+    for (const char* p = text; *p && QUEST_COUNTERS_MAX > n; ++p) {
+        if (!isdigit((unsigned char)*p) || (p > text && isdigit((unsigned char)p[-1]))) continue;
+        char* end = NULL;
+        long done = strtol(p, &end, 10);
+        if ('/' != *end || !isdigit((unsigned char)end[1])) continue;
+        long required = strtol(end + 1, &end, 10);
+        out[n++] = (QuestCounter){ .done = (int)done, .required = (int)required };
+        p = end - 1;
     }
-    return NULL;
+    return n;
+}
+
+static QuestProgressEntry* find_by_code(const char* code) {
+    if (!s_index_ready) return NULL;
+    intptr_t slot = (intptr_t)hash_table_get(&s_index, code);
+    return slot ? &s_entries[slot - 1] : NULL;
 }
 
 bool quest_progress_store_upsert(const char* code, const char* title, const char* description,
                         const char* status_str, const char* active_step,
                         const char* objectives) {
     if (!code || '\0' == code[0]) return false;
+    if (!s_index_ready) quest_progress_store_reset();
 
     bool        added = false;
+    unsigned    dirty = 0;
     QuestProgressEntry* e     = find_by_code(code);
     if (NULL == e) {
         if (s_count >= QUEST_PROGRESS_STORE_CAP) return false;
         e = &s_entries[s_count++];
+        *e = (QuestProgressEntry){ 0 };
         copy_field(e->code, QUEST_CODE_MAX, code);
+        hash_table_put(&s_index, e->code, (void*)(intptr_t)s_count);
+        s_sections_dirty = true;
         added = true;
+        dirty |= QUEST_DIRTY_ADDED;
+    }
+    if (title && copy_field(e->title, QUEST_TITLE_MAX, title))                   dirty |= QUEST_DIRTY_META;
+    if (description && copy_field(e->description, QUEST_DESC_MAX, description)) dirty |= QUEST_DIRTY_META;
+    if (copy_field(e->active_step, QUEST_STEP_MAX, active_step))                 dirty |= QUEST_DIRTY_STEP;
+    if (copy_field(e->objectives,  QUEST_OBJECTIVES_MAX, objectives)) {
+        e->counter_count = parse_counters(e->objectives, e->counters);
+        dirty |= QUEST_DIRTY_PROGRESS;
+    }
+    QuestStatus status = quest_progress_store_parse_status(status_str);
+    if (added || status != e->status) {
+        e->status = status;
+        s_sections_dirty = true;
+        dirty |= QUEST_DIRTY_STATUS;
+    }
+    if (dirty) {
+        e->revision = s_generation + 1;
+        notify(e->code, dirty);
     }
-    if (title) copy_field(e->title, QUEST_TITLE_MAX, title);
-    if (description) copy_field(e->description, QUEST_DESC_MAX, description);
-    copy_field(e->active_step, QUEST_STEP_MAX, active_step);
-    copy_field(e->objectives,  QUEST_OBJECTIVES_MAX, objectives);
-    e->status = quest_progress_store_parse_status(status_str);
     return added;
 }
 
-int quest_progress_store_count(QuestStatus status) {
-    int n = 0;
+static void sections_sync(void) {
+    if (!s_sections_dirty) return;
+    memset(s_section_count, 0, sizeof(s_section_count));
     for (int i = 0; i < s_count; ++i) {
-        if (s_entries[i].status == status) ++n;
+        QuestStatus st = s_entries[i].status;
+        s_section[st][s_section_count[st]++] = i;
     }
-    return n;
+    s_sections_dirty = false;
+}
+
+int quest_progress_store_count(QuestStatus status) {
+    if (status < 0 || status >= QUEST_STATUS_COUNT) return 0;
+    sections_sync();
+    return s_section_count[status];
 }
 
 const QuestProgressEntry* quest_progress_store_get(QuestStatus status, int index) {
-    int seen = 0;
-    for (int i = 0; i < s_count; ++i) {
-        if (s_entries[i].status != status) continue;
-        if (seen == index) return &s_entries[i];
-        ++seen;
-    }
-    return NULL;
+    if (status < 0 || status >= QUEST_STATUS_COUNT) return NULL;
+    sections_sync();
+    if (index < 0 || index >= s_section_count[status]) return NULL;
+    return &s_entries[s_section[status][index]];
 }
 
 const QuestProgressEntry* quest_progress_store_find(const char* code) {
@@ -82,9 +166,15 @@ bool quest_progress_store_is_completed(const char* code) {
 
 bool quest_progress_store_set_meta(const char* code, const char* title,
                           const char* description) {
+    if (!code) return false;
     QuestProgressEntry* e = find_by_code(code);
     if (!e) return false;
-    if (title) copy_field(e->title, QUEST_TITLE_MAX, title);
-    if (description) copy_field(e->description, QUEST_DESC_MAX, description);
+    bool changed = false;
+    if (title) changed |= copy_field(e->title, QUEST_TITLE_MAX, title);
+    if (description) changed |= copy_field(e->description, QUEST_DESC_MAX, description);
+    if (changed) {
+        e->revision = s_generation + 1;
+        notify(e->code, QUEST_DIRTY_META);
+    }
     return true;
 }
@@ -9,6 +9,13 @@
  * GET /api/cyberia-quest/:code.
  *
  * Cleared and repopulated on reconnect.
+ *
+ * Entries are hashed by code and listed per section, so lookups and the
+ * journal's section walks are O(1) per entry. An upsert that changes
+ * nothing is not a change: the generation only moves, and subscribers are
+ * only called, when a field actually differs. Kill quests re-send the same
+ * quest on every counter tick, so views subscribe and recompute only when a
+ * quest they show changed, and how (QUEST_DIRTY_*).
  */
 
 #ifndef QUEST_PROGRESS_STORE_H
@@ -22,6 +29,8 @@
 #define QUEST_STEP_MAX        160
 #define QUEST_OBJECTIVES_MAX  160
 #define QUEST_PROGRESS_STORE_CAP       256
+#define QUEST_COUNTERS_MAX    4
+#define QUEST_SUBSCRIBERS_MAX 8
 
 typedef enum {
     QUEST_ACTIVE = 0,
@@ -30,6 +39,12 @@ typedef enum {
     QUEST_STATUS_COUNT,
 } QuestStatus;
 
+/* One "done/required" pair of the objectives text ("Wolves 3/10"). */
+typedef struct {
+    int done;
+    int required;
+} QuestCounter;
+
 typedef struct {
     char        code[QUEST_CODE_MAX];
     char        title[QUEST_TITLE_MAX];
@@ -37,10 +52,34 @@ typedef struct {
     char        active_step[QUEST_STEP_MAX];
     char        objectives[QUEST_OBJECTIVES_MAX];
     QuestStatus status;
+    QuestCounter counters[QUEST_COUNTERS_MAX];   /* parsed from objectives */
+    int         counter_count;
+    unsigned    revision;   /* generation of the entry's last change */
 } QuestProgressEntry;
 
+/* What changed in a quest, as passed to subscribers. */
+enum {
+    QUEST_DIRTY_ADDED    = 1u << 0,
+    QUEST_DIRTY_STATUS   = 1u << 1,
+    QUEST_DIRTY_STEP     = 1u << 2,
+    QUEST_DIRTY_PROGRESS = 1u << 3,   /* objectives text / counters */
+    QUEST_DIRTY_META     = 1u << 4,   /* title, description */
+    QUEST_DIRTY_ALL      = 0x1fu,
+};
+
+/* Called after each change, with the quest's code, or NULL after a reset
+ * (every quest gone). Runs inside the store update: read, don't upsert. */
+typedef void (*QuestChangeFn)(const char* code, unsigned dirty, void* user);
+
+/* Register for change calls; false once QUEST_SUBSCRIBERS_MAX are taken.
+ * Subscriptions survive resets. */
+bool quest_progress_store_subscribe(QuestChangeFn fn, void* user);
+
 void quest_progress_store_reset(void);
 
+/* Changes whenever any entry is added, moved or edited, or on reset. */
+unsigned quest_progress_store_generation(void);
+
 /* Insert or update by code. `status_str` is "active" | "completed" | "failed";
  * unknown values default to active. Returns true if a new entry was added. */
 bool quest_progress_store_upsert(const char* code, const char* title, const char* description,
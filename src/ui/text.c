@@ -1,56 +1,195 @@
-/* This TU defines the compat shims, so it must call the real raylib DrawTextEx /
- * MeasureTextEx — suppress the macro overrides for itself. */
+/* This TU defines the compat shims, so it must call the real raylib DrawTextEx
+ * and measure without the MeasureText override — suppress the macros for
+ * itself. */
 #define CYBERIA_TEXT_NO_OVERRIDE
 #include "text.h"
 
 #include "domain/presentation_runtime.h"
 #include "domain/viewport.h"
+#include "glyph_cache.h"
+#include "gpu_memory.h"
+#include "hash_table.h"
+#include "heap_memory.h"
 #include "network/engine_client.h"
 #include "util/log.h"
+#include "render_stats.h"
 
+#include <assert.h>
+#include <math.h>
 #include <raylib.h>
-#include <stdlib.h>
+#include <rlgl.h>
+#include <stdint.h>
+#include <stdio.h>
 #include <string.h>
 
-/* Glyph atlas base size — generous so the font stays crisp when scaled up. */
-#define TEXT_FONT_BASE_SIZE 64
+/* A font file is taken once it rasterizes this glyph at this size. */
+#define TEXT_FONT_PROBE_GLYPH 'A'
+#define TEXT_FONT_PROBE_PX    16
+
+/* raylib's default textLineSpacing: DrawTextEx's extra gap per '\n'. */
+#define TEXT_RAYLIB_LINE_SPACING 2
 
 /* Responsive scaling: on a mobile viewport (see domain/viewport.h) the global
  * font multiplier is reduced so HUD/UI text is proportionally smaller on
  * phones. Desktop is unaffected. */
 #define TEXT_MOBILE_FONT_SCALE 0.88f
 
+/* The main font is drawn through the glyph cache (glyph_cache.h), which
+ * rasterizes each glyph at a size bucket on first use; under the fontSdf
+ * hint it is one SDF atlas (s_font) instead. With the fontSubset hint the
+ * small subset file is fetched first, at FETCH_CLASS_VISIBLE, and drawn
+ * until the whole family — fetched alongside at FETCH_CLASS_PREFETCH —
+ * replaces it. */
 static Font  s_font;
-static bool  s_loaded;
-static bool  s_fetching;
+static bool  s_loaded;           /* s_font holds the SDF main font */
+static bool  s_glyphs;           /* the main font is in the glyph cache */
+static bool  s_full;             /* the whole family (not only its subset) is in */
+static int   s_fetching;         /* font requests in flight */
 static char  s_family[128];      /* family currently loaded or already attempted */
 static float s_factor = 1.0f;
+static uint32_t s_font_gen;      /* bumped whenever the active font changes */
 
-static void on_font_fetched(const FetchResponse *r) {
-    s_fetching = false;
+/* ── SDF mode ─────────────────────────────────────────────────────────
+ * With the fontSdf hint the main font is rasterized once as signed distance
+ * fields (LoadFontData FONT_SDF) and drawn through s_sdf_shader, which
+ * thresholds the distance per pixel: edges stay sharp at any size, camera
+ * zoom or mobile scale from one small atlas, and an outline is a second
+ * threshold in the same pass. Each string drawn ends its own shader block,
+ * i.e. one batch flush per string — the price of the crisp path.
+ *
+ * raylib generates the fields with a spread of 2 atlas pixels (edge value
+ * 128, 64 per pixel), so one-pass
+ * outlines reach TEXT_SDF_MAX_OUTLINE atlas pixels; wider ones fall back to
+ * the ring loop. */
+
+#define TEXT_SDF_BASE_SIZE   16
+#define TEXT_SDF_MAX_OUTLINE 1.5f
+#define TEXT_SDF_DIST_SCALE  64.0f   /* raylib's FONT_SDF_PIXEL_DIST_SCALE */
+
+static const char *const SDF_FRAGMENT_SHADER =
+    "#version 100\n"
+    "#extension GL_OES_standard_derivatives : enable\n"
+    "precision mediump float;\n"
+    "varying vec2 fragTexCoord;\n"
+    "varying vec4 fragColor;\n"
+    "uniform sampler2D texture0;\n"
+    "uniform vec4 colDiffuse;\n"
+    "uniform vec4 outlineColor;\n"
+    "uniform float outlineWidth;\n"
+    "void main() {\n"
+    "    float d = texture2D(texture0, fragTexCoord).a - 0.5;\n"
+    "    float w = length(vec2(dFdx(d), dFdy(d)));\n"
+    "    float fill = smoothstep(-w, w, d);\n"
+    "    vec4 col = fragColor;\n"
+    "    if (outlineWidth > 0.0) {\n"
+    "        float edge = smoothstep(-w, w, d + outlineWidth);\n"
+    "        col = vec4(mix(outlineColor.rgb, fragColor.rgb, fill),\n"
+    "                   mix(outlineColor.a, fragColor.a, fill) * edge);\n"
+    "    } else {\n"
+    "        col.a *= fill;\n"
+    "    }\n"
+    "    gl_FragColor = col * colDiffuse;\n"
+    "}\n";
+
+static bool   s_sdf;             /* s_font holds distance fields */
+static bool   s_sdf_tried;
+static Shader s_sdf_shader;
+static int    s_sdf_loc_color;
+static int    s_sdf_loc_width;
+
+/* False when the shader does not compile here (no standard derivatives). */
+static bool sdf_shader_ready(void) {
+    if (!s_sdf_tried) {
+        s_sdf_tried = true;
+        s_sdf_shader = LoadShaderFromMemory(NULL, SDF_FRAGMENT_SHADER);
+        if (s_sdf_shader.id == rlGetShaderIdDefault()) {
+            LOG_WARN("[text] SDF shader unavailable, keeping bitmap glyphs");
+            s_sdf_shader.id = 0;
+        } else {
+            s_sdf_loc_color = GetShaderLocation(s_sdf_shader, "outlineColor");
+            s_sdf_loc_width = GetShaderLocation(s_sdf_shader, "outlineWidth");
+        }
+    }
+    return 0 != s_sdf_shader.id;
+}
+
+static Font load_sdf_font(const unsigned char *data, int size) {
+    Font f = { .baseSize = TEXT_SDF_BASE_SIZE };
+    f.glyphs = LoadFontData(data, size, TEXT_SDF_BASE_SIZE, NULL, 0, FONT_SDF, &f.glyphCount);
+    if (NULL == f.glyphs) return (Font){ 0 };
+    Image atlas = GenImageFontAtlas(f.glyphs, &f.recs, f.glyphCount, TEXT_SDF_BASE_SIZE, 0, 1);
+    f.texture = LoadTextureFromImage(atlas);
+    UnloadImage(atlas);
+    return f;
+}
+
+/* Open the shader block for one string; `width` in atlas pixels, 0 for none. */
+static void sdf_begin(Color outline, float width) {
+    BeginShaderMode(s_sdf_shader);
+    float color[4] = { outline.r / 255.0f, outline.g / 255.0f, outline.b / 255.0f, outline.a / 255.0f };
+    float w = width * TEXT_SDF_DIST_SCALE / 255.0f;
+    SetShaderValue(s_sdf_shader, s_sdf_loc_color, color, SHADER_UNIFORM_VEC4);
+    SetShaderValue(s_sdf_shader, s_sdf_loc_width, &w, SHADER_UNIFORM_FLOAT);
+}
+
+static bool font_file_valid(const unsigned char *data, int size) {
+    int codepoint = TEXT_FONT_PROBE_GLYPH, count = 0;
+    GlyphInfo *probe = LoadFontData(data, size, TEXT_FONT_PROBE_PX, &codepoint, 1, FONT_DEFAULT, &count);
+    UnloadFontData(probe, count);
+    return 0 < count;
+}
+
+/* Make the fetched file the main font. `what` names it in the log. */
+static bool load_main_font(const FetchResponse *r, const char *what) {
     if (!r->success || NULL == r->data || 0 == r->size) {
-        LOG_ERROR("[text] main font fetch failed for '%s'", s_family);
-        free(r->data);
-        return;
+        LOG_ERROR("[text] %s fetch failed for '%s'", what, s_family);
+        return false;
     }
-    Font f = LoadFontFromMemory(".ttf", (const unsigned char *)r->data, (int)r->size,
-                                TEXT_FONT_BASE_SIZE, NULL, 0);
-    free(r->data);
-    if (!IsFontValid(f)) {
-        LOG_ERROR("[text] LoadFontFromMemory failed for '%s'", s_family);
-        return;
+    const unsigned char *data = (const unsigned char *)r->data;
+    bool sdf = presentation_runtime_font_sdf() && sdf_shader_ready();
+    if (sdf) {
+        Font f = load_sdf_font(data, (int)r->size);
+        if (!IsFontValid(f)) {
+            LOG_ERROR("[text] SDF font load failed for %s '%s'", what, s_family);
+            return false;
+        }
+        SetTextureFilter(f.texture, TEXTURE_FILTER_BILINEAR);
+        text_font_unload();
+        gpu_memory_add(GPU_MEM_FONTS, gpu_memory_texture_bytes(f.texture));
+        s_font   = f;
+        s_loaded = true;
+        s_sdf    = true;
+    } else {
+        if (!font_file_valid(data, (int)r->size)) {
+            LOG_ERROR("[text] %s '%s' is not a usable TTF", what, s_family);
+            return false;
+        }
+        text_font_unload();
+        glyph_cache_set_font(data, r->size);
+        s_glyphs = true;
     }
-    SetTextureFilter(f.texture, TEXTURE_FILTER_BILINEAR);
-    if (s_loaded) UnloadFont(s_font);
-    s_font = f;
-    s_loaded = true;
-    LOG_INFO("[text] main font '%s' loaded (%d glyphs)", s_family, f.glyphCount);
+    s_font_gen++;
+    LOG_INFO("[text] %s '%s' loaded (%zu bytes%s)", what, s_family, r->size, sdf ? ", SDF" : "");
+    return true;
+}
+
+static void on_font_fetched(const FetchResponse *r) {
+    s_fetching--;
+    if (load_main_font(r, "main font")) s_full = true;
+}
+
+/* Too late once the whole family is in. */
+static void on_font_subset_fetched(const FetchResponse *r) {
+    s_fetching--;
+    if (!s_full) load_main_font(r, "font subset");
 }
 
 void text_font_init(void) {
     s_font = GetFontDefault();
     s_loaded = false;
-    s_fetching = false;
+    s_glyphs = false;
+    s_full = false;
+    s_fetching = 0;
     s_family[0] = '\0';
     s_factor = 1.0f;
 }
@@ -61,7 +200,7 @@ void text_font_sync(void) {
 
     const char *family = presentation_runtime_font_family();
     if (NULL == family || '\0' == family[0]) return;
-    if (s_fetching) return;
+    if (0 < s_fetching) return;
     /* s_family records the family we last loaded or attempted; only (re)fetch when
      * the hint names a different one — this also stops a retry loop on failure. */
     if (0 == strcmp(family, s_family)) return;
@@ -69,17 +208,36 @@ void text_font_sync(void) {
     strncpy(s_family, family, sizeof(s_family) - 1);
     s_family[sizeof(s_family) - 1] = '\0';
 
+    s_full = false;
+
     char url[256];
+    const char *subset = presentation_runtime_font_subset();
+    bool staged = NULL != subset && '\0' != subset[0] && 0 != strcmp(subset, s_family);
+    if (staged) {
+        snprintf(url, sizeof(url), "/assets/fonts/%s", subset);
+        s_fetching++;
+        fetch_request_start("cyberia-main-font-subset", url, FETCH_CLASS_VISIBLE, on_font_subset_fetched);
+        LOG_INFO("[text] fetching font subset %s", url);
+    }
     snprintf(url, sizeof(url), "/assets/fonts/%s", s_family);
-    s_fetching = true;
-    fetch_request_start("cyberia-main-font", url, on_font_fetched);
+    s_fetching++;
+    fetch_request_start("cyberia-main-font", url, staged ? FETCH_CLASS_PREFETCH : FETCH_CLASS_VISIBLE,
+                        on_font_fetched);
     LOG_INFO("[text] fetching main font %s", url);
 }
 
 void text_font_unload(void) {
     if (s_loaded) {
+        gpu_memory_sub(GPU_MEM_FONTS, gpu_memory_texture_bytes(s_font.texture));
         UnloadFont(s_font);
         s_loaded = false;
+        s_sdf = false;
+        s_font_gen++;
+    }
+    if (s_glyphs) {
+        glyph_cache_release();
+        s_glyphs = false;
+        s_font_gen++;
     }
 }
 
@@ -87,6 +245,10 @@ Font text_active_font(void) {
     return s_loaded ? s_font : GetFontDefault();
 }
 
+uint32_t text_font_generation(void) {
+    return s_font_gen;
+}
+
 /* Effective multiplier: the hint-derived factor times a live responsive
  * reduction below the mobile breakpoint. Evaluated per call (not cached in
  * s_factor) so it tracks viewport width even in loops that never re-sync. */
@@ -100,18 +262,208 @@ float text_font_factor(void) {
     return effective_factor();
 }
 
+/* ── Glyph advances ───────────────────────────────────────────────────
+ * MeasureTextEx decodes UTF-8 and, for every codepoint, walks the font's
+ * glyph array (GetGlyphIndex). The active font's advances are tabled once
+ * per font generation: direct-indexed for ASCII, open-addressed for the
+ * rest. measure_run() reproduces MeasureTextEx's arithmetic exactly, so
+ * measure and draw still agree. */
+
+typedef struct {
+    int   codepoint;   /* 0 marks an empty slot */
+    float advance;
+} GlyphAdvance;
+
+static struct {
+    bool          built;
+    uint32_t      font_gen;
+    float         base_size;
+    float         ascii[128];
+    GlyphAdvance *extra;
+    uint32_t      extra_mask;
+    float         fallback;    /* GetGlyphIndex's '?' for missing glyphs */
+} s_adv;
+
+static float glyph_advance(Font font, int index) {
+    const GlyphInfo *g = &font.glyphs[index];
+    return g->advanceX > 0 ? (float)g->advanceX : font.recs[index].width + (float)g->offsetX;
+}
+
+static uint32_t codepoint_slot(int codepoint) {
+    return (uint32_t)codepoint * 2654435761u;
+}
+
+/* False while no font texture is up: MeasureTextEx measures 0 then too. */
+static bool advances_sync(void) {
+    if (s_adv.built && s_font_gen == s_adv.font_gen) return true;
+    Font font = text_active_font();
+    if (0 == font.texture.id) return false;
+
+    for (int c = 0; c < 128; c++) s_adv.ascii[c] = glyph_advance(font, GetGlyphIndex(font, c));
+    s_adv.fallback = glyph_advance(font, GetGlyphIndex(font, -1));
+
+    uint32_t cap = 16;
+    while (cap < 2u * (uint32_t)font.glyphCount) cap <<= 1;
+    heap_free(s_adv.extra);
+    s_adv.extra = heap_calloc(HEAP_MEM_TEXT_LAYOUT, cap, sizeof(GlyphAdvance));
+    assert(s_adv.extra);
+    s_adv.extra_mask = cap - 1;
+    for (int i = 0; i < font.glyphCount; i++) {
+        int cp = font.glyphs[i].value;
+        if (128 > cp) continue;
+        uint32_t slot = codepoint_slot(cp) & s_adv.extra_mask;
+        while (0 != s_adv.extra[slot].codepoint && cp != s_adv.extra[slot].codepoint) {
+            slot = (slot + 1) & s_adv.extra_mask;
+        }
+        /* First match wins, as in GetGlyphIndex. */
+        if (0 == s_adv.extra[slot].codepoint) {
+            s_adv.extra[slot] = (GlyphAdvance){ .codepoint = cp, .advance = glyph_advance(font, i) };
+        }
+    }
+
+    s_adv.base_size = (float)font.baseSize;
+    s_adv.font_gen  = s_font_gen;
+    s_adv.built     = true;
+    return true;
+}
+
+static float extra_advance(int codepoint) {
+    for (uint32_t slot = codepoint_slot(codepoint) & s_adv.extra_mask;;
+         slot = (slot + 1) & s_adv.extra_mask) {
+        const GlyphAdvance *a = &s_adv.extra[slot];
+        if (codepoint == a->codepoint) return a->advance;
+        if (0 == a->codepoint) return s_adv.fallback;
+    }
+}
+
+/* Next codepoint of `*p`, advancing it; ASCII without the decoder. */
+static int next_codepoint(const char **p) {
+    unsigned char c = (unsigned char)**p;
+    if (0x80 > c) {
+        (*p)++;
+        return c;
+    }
+    int bytes = 0;
+    int codepoint = GetCodepointNext(*p, &bytes);
+    *p += bytes;
+    return codepoint;
+}
+
+/* MeasureTextEx over glyph-cache advances at fs's bucket. */
+static float glyph_measure_run(const char *text, float fs, float spacing) {
+    int   bucket = glyph_cache_bucket(fs);
+    float width = 0.0f, widest = 0.0f;
+    int   glyphs = 0, most = 0;
+    const char *p = text;
+    while ('\0' != *p) {
+        int codepoint = next_codepoint(&p);
+        if ('\n' == codepoint) {
+            if (widest < width) widest = width;
+            width  = 0.0f;
+            glyphs = 0;
+            continue;
+        }
+        const CachedGlyph *g = glyph_cache_get(bucket, codepoint);
+        if (g) width += g->advance;
+        if (most < ++glyphs) most = glyphs;
+    }
+    if (widest < width) widest = width;
+    return widest * (fs / glyph_cache_bucket_px(bucket)) + (float)((most - 1) * spacing);
+}
+
+/* DrawTextEx's layout over glyph-cache glyphs at fs's bucket. */
+static void glyph_draw_run(const char *text, Vector2 pos, float fs, float spacing, Color tint) {
+    int   bucket = glyph_cache_bucket(fs);
+    float scale  = fs / glyph_cache_bucket_px(bucket);
+    float x = 0.0f, y = 0.0f;
+    const char *p = text;
+    while ('\0' != *p) {
+        int codepoint = next_codepoint(&p);
+        if ('\n' == codepoint) {
+            y += fs + TEXT_RAYLIB_LINE_SPACING;
+            x  = 0.0f;
+            continue;
+        }
+        const CachedGlyph *g = glyph_cache_get(bucket, codepoint);
+        if (!g) continue;
+        if (' ' != codepoint && '\t' != codepoint && 0.0f < g->src.width) {
+            Rectangle dst = { pos.x + x + g->offset_x * scale, pos.y + y + g->offset_y * scale,
+                              g->src.width * scale, g->src.height * scale };
+            DrawTexturePro(glyph_cache_texture(), g->src, dst, (Vector2){ 0.0f, 0.0f }, 0.0f, tint);
+        }
+        x += g->advance * scale + spacing;
+    }
+}
+
+/* MeasureTextEx(text_active_font(), text, fs, spacing).x */
+static float measure_run(const char *text, float fs, float spacing) {
+    if ('\0' == text[0]) return 0.0f;
+    if (s_glyphs) return glyph_measure_run(text, fs, spacing);
+    if (!advances_sync()) return 0.0f;
+    float width = 0.0f, widest = 0.0f;
+    int   glyphs = 0, most = 0;
+    const char *p = text;
+    while ('\0' != *p) {
+        unsigned char c = (unsigned char)*p;
+        if ('\n' == c) {
+            if (widest < width) widest = width;
+            width  = 0.0f;
+            glyphs = 0;
+            p++;
+            continue;
+        }
+        if (0x80 > c) {
+            width += s_adv.ascii[c];
+            p++;
+        } else {
+            int bytes = 0;
+            int codepoint = GetCodepointNext(p, &bytes);
+            width += extra_advance(codepoint);
+            p += bytes;
+        }
+        if (most < ++glyphs) most = glyphs;
+    }
+    if (widest < width) widest = width;
+    return widest * (fs / s_adv.base_size) + (float)((most - 1) * spacing);
+}
+
 void text_draw_compat(const char *text, int x, int y, int size, Color color) {
     float fs = (float)size * effective_factor();
     if (fs < 1.0f) fs = 1.0f;
     float spacing = (float)((int)fs / 10);
+    if (s_glyphs) {
+        glyph_draw_run(text, (Vector2){ (float)x, (float)y }, fs, spacing, color);
+        return;
+    }
+    if (s_sdf) sdf_begin(BLANK, 0.0f);
     DrawTextEx(text_active_font(), text, (Vector2){ (float)x, (float)y }, fs, spacing, color);
+    if (s_sdf) EndShaderMode();
+}
+
+void text_draw_outlined(const char *text, int x, int y, int size, Color fg, Color outline, int px) {
+    float fs = (float)size * effective_factor();
+    if (fs < 1.0f) fs = 1.0f;
+    float atlas_px = (float)px * (float)TEXT_SDF_BASE_SIZE / fs;
+    if (s_sdf && TEXT_SDF_MAX_OUTLINE >= atlas_px) {
+        float spacing = (float)((int)fs / 10);
+        sdf_begin(outline, atlas_px);
+        DrawTextEx(s_font, text, (Vector2){ (float)x, (float)y }, fs, spacing, fg);
+        EndShaderMode();
+        return;
+    }
+    for (int o = 1; o <= px; o++)
+        for (int dy = -1; dy <= 1; dy++)
+            for (int dx = -1; dx <= 1; dx++)
+                if (dx || dy)
+                    text_draw_compat(text, x + dx * o, y + dy * o, size, outline);
+    text_draw_compat(text, x, y, size, fg);
 }
 
 int text_measure_compat(const char *text, int size) {
     float fs = (float)size * effective_factor();
     if (fs < 1.0f) fs = 1.0f;
     float spacing = (float)((int)fs / 10);
-    return (int)MeasureTextEx(text_active_font(), text, fs, spacing).x;
+    return (int)measure_run(text, fs, spacing);
 }
 
 #define TEXT_LINE_GAP 3
@@ -122,39 +474,241 @@ int text_line_height(int size) {
     return fs + TEXT_LINE_GAP;
 }
 
-int text_wrap(const char *text, int x, int y, int maxw, int size, Color col, bool center, bool draw) {
-    if (NULL == text || '\0' == text[0]) return 0;
-    char buf[512];
-    strncpy(buf, text, sizeof(buf) - 1);
-    buf[sizeof(buf) - 1] = '\0';
+/* ── Wrap layout cache ─────────────────────────────────────────────────
+ * Dialogue, journal and modal blocks wrap the same strings every frame, often
+ * twice (measure, then draw). A layout keyed by the text, size, width and the
+ * font in use keeps each line's NUL-terminated text and pixel width, so a hit
+ * only hashes and compares the string. Least recently used slots are evicted. */
 
-    int line_h = text_line_height(size);
-    int cy = y;
-    char line[512] = { 0 };
-    char test[512];
-
-    char *tok = strtok(buf, " ");
-    while (tok) {
-        if ('\0' == line[0]) snprintf(test, sizeof(test), "%s", tok);
-        else                 snprintf(test, sizeof(test), "%s %s", line, tok);
-        if (text_measure_compat(test, size) > maxw && '\0' != line[0]) {
-            if (draw) {
-                int lx = center ? x + (maxw - text_measure_compat(line, size)) / 2 : x;
-                text_draw_compat(line, lx, cy, size, col);
-            }
-            cy += line_h;
-            snprintf(line, sizeof(line), "%s", tok);
+#define TEXT_LAYOUT_SLOTS 64
+
+typedef struct {
+    uint32_t offset;   /* into TextLayout.buf */
+    int      width;
+} TextLine;
+
+typedef struct {
+    uint64_t  hash;
+    size_t    len;
+    int       size;
+    int       maxw;
+    float     fs;           /* effective font size: tracks factor + viewport */
+    uint32_t  font_gen;
+    uint32_t  used;         /* LRU stamp; 0 marks an empty slot */
+    char     *src;          /* copy of the keyed text */
+    char     *buf;          /* line texts, NUL-separated */
+    TextLine *lines;
+    int       line_count;
+} TextLayout;
+
+static TextLayout s_layouts[TEXT_LAYOUT_SLOTS];
+static uint32_t   s_layout_stamp;
+static TextLine  *s_layout_scratch;
+static int        s_layout_scratch_cap;
+
+static void layout_push(int count, size_t offset, float width) {
+    if (count == s_layout_scratch_cap) {
+        int cap = s_layout_scratch_cap ? s_layout_scratch_cap * 2 : 32;
+        TextLine *grown = heap_malloc(HEAP_MEM_TEXT_LAYOUT, (size_t)cap * sizeof(TextLine));
+        assert(grown);
+        if (s_layout_scratch) memcpy(grown, s_layout_scratch, (size_t)count * sizeof(TextLine));
+        heap_free(s_layout_scratch);
+        s_layout_scratch = grown;
+        s_layout_scratch_cap = cap;
+    }
+    s_layout_scratch[count] = (TextLine){ .offset = (uint32_t)offset, .width = (int)width };
+}
+
+/* Greedy word wrap on single spaces, as the strtok version did: runs of spaces
+ * collapse and a word wider than maxw gets a line to itself. Widths add up
+ * word by word (raylib puts `spacing` between every glyph), so each glyph is
+ * measured about twice per build: once in its word, once in its finished
+ * line. A line holding a '\n', or a sum within rounding of the limit, is
+ * re-measured whole. */
+static void layout_build(TextLayout *e, const char *text, float fs, int maxw) {
+    float spacing = (float)((int)fs / 10);
+    float space_w = measure_run(" ", fs, spacing);
+    char *o = e->buf;
+    size_t n = 0, line_start = 0;
+    float line_w  = 0.0f;
+    bool  empty   = true;
+    bool  line_nl = false;
+    int   count   = 0;
+
+    const char *p = text;
+    for (;;) {
+        while (' ' == *p) p++;
+        if ('\0' == *p) break;
+        const char *q = p;
+        while ('\0' != *q && ' ' != *q) q++;
+        size_t wl = (size_t)(q - p);
+        bool word_nl = NULL != memchr(p, '\n', wl);
+
+        size_t at = empty ? n : n + 1;
+        memcpy(o + at, p, wl);
+        o[at + wl] = '\0';
+        float word_w = measure_run(o + at, fs, spacing);
+        if (empty) {
+            line_w  = word_w;
+            line_nl = word_nl;
+            empty   = false;
         } else {
-            snprintf(line, sizeof(line), "%s", test);
+            o[n] = ' ';
+            float test_w = line_w + space_w + word_w + 2.0f * spacing;
+            if (line_nl || word_nl || fabsf(test_w - (float)(maxw + 1)) < 0.5f) {
+                test_w = measure_run(o + line_start, fs, spacing);
+            }
+            if ((int)test_w > maxw) {
+                o[n] = '\0';
+                layout_push(count++, line_start, measure_run(o + line_start, fs, spacing));
+                line_start = at;
+                line_w     = word_w;
+                line_nl    = word_nl;
+            } else {
+                line_w   = test_w;
+                line_nl |= word_nl;
+            }
         }
-        tok = strtok(NULL, " ");
+        n = at + wl;
+        p = q;
     }
-    if ('\0' != line[0]) {
-        if (draw) {
-            int lx = center ? x + (maxw - text_measure_compat(line, size)) / 2 : x;
-            text_draw_compat(line, lx, cy, size, col);
+    if (!empty) layout_push(count++, line_start, measure_run(o + line_start, fs, spacing));
+
+    e->line_count = count;
+    e->lines = heap_malloc(HEAP_MEM_TEXT_LAYOUT, (size_t)(count ? count : 1) * sizeof(TextLine));
+    assert(e->lines);
+    memcpy(e->lines, s_layout_scratch, (size_t)count * sizeof(TextLine));
+}
+
+static void layout_release(TextLayout *e) {
+    heap_free(e->src);
+    heap_free(e->buf);
+    heap_free(e->lines);
+    *e = (TextLayout){0};
+}
+
+static const TextLayout *layout_get(const char *text, int size, int maxw) {
+    float fs = (float)size * effective_factor();
+    if (fs < 1.0f) fs = 1.0f;
+    uint64_t hash = hash_table_hash(text);
+    size_t len = strlen(text);
+
+    TextLayout *victim = &s_layouts[0];
+    for (int i = 0; i < TEXT_LAYOUT_SLOTS; i++) {
+        TextLayout *e = &s_layouts[i];
+        if (0 != e->used && hash == e->hash && len == e->len && size == e->size &&
+            maxw == e->maxw && fs == e->fs && s_font_gen == e->font_gen &&
+            0 == memcmp(text, e->src, len)) {
+            e->used = ++s_layout_stamp;
+            return e;
+        }
+        if (e->used < victim->used) victim = e;
+    }
+
+    layout_release(victim);
+    *victim = (TextLayout){
+        .hash     = hash,
+        .len      = len,
+        .size     = size,
+        .maxw     = maxw,
+        .fs       = fs,
+        .font_gen = s_font_gen,
+        .used     = ++s_layout_stamp,
+        .src      = heap_malloc(HEAP_MEM_TEXT_LAYOUT, len + 1),
+        .buf      = heap_malloc(HEAP_MEM_TEXT_LAYOUT, len + 1),
+    };
+    assert(victim->src && victim->buf);
+    memcpy(victim->src, text, len + 1);
+    layout_build(victim, text, fs, maxw);
+    return victim;
+}
+
+int text_wrap(const char *text, int x, int y, int maxw, int size, Color col, bool center, bool draw) {
+    if (NULL == text || '\0' == text[0]) return 0;
+    const TextLayout *l = layout_get(text, size, maxw);
+    int line_h = text_line_height(size);
+    if (draw) {
+        for (int i = 0; i < l->line_count; i++) {
+            const TextLine *line = &l->lines[i];
+            int lx = center ? x + (maxw - line->width) / 2 : x;
+            text_draw_compat(l->buf + line->offset, lx, y + i * line_h, size, col);
         }
-        cy += line_h;
     }
-    return cy - y;
+    return l->line_count * line_h;
+}
+
+/* ── Formatted values ──────────────────────────────────────────────── */
+
+#define TEXT_VALUE_SLOTS 128   /* power of two: direct-mapped by key hash */
+
+typedef struct {
+    const char *fmt;       /* NULL marks an empty slot */
+    int         a;
+    int         b;
+    char        s[TEXT_VALUE_LEN];
+    TextMemo    memo;
+} TextValueSlot;
+
+static TextValueSlot s_values[TEXT_VALUE_SLOTS];
+
+bool text_memo_changed(TextMemo *memo, int64_t key) {
+    assert(memo);
+    if (memo->valid && key == memo->key) return false;
+    memo->valid = true;
+    memo->key   = key;
+    memo->width = -1;
+    return true;
+}
+
+int text_memo_width(TextMemo *memo, int size) {
+    assert(memo && memo->valid);
+    float fs = (float)size * effective_factor();
+    if (0 > memo->width || size != memo->width_size || fs != memo->width_fs ||
+        s_font_gen != memo->width_gen) {
+        memo->width      = text_measure_compat(memo->text, size);
+        memo->width_size = size;
+        memo->width_fs   = fs;
+        memo->width_gen  = s_font_gen;
+    }
+    return memo->width;
+}
+
+static TextValue value_of(TextMemo *memo, int size) {
+    TextValue v = { .width = text_memo_width(memo, size) };
+    memcpy(v.text, memo->text, sizeof(v.text));
+    return v;
+}
+
+TextValue text_value_ints(const char *fmt, int a, int b, int size) {
+    assert(fmt);
+    uint64_t h = ((uint64_t)(uintptr_t)fmt * 0x9E3779B97F4A7C15ull) ^
+                 ((uint64_t)(uint32_t)a << 32 | (uint32_t)b) * 0xC2B2AE3D27D4EB4Full;
+    TextValueSlot *e = &s_values[(h >> 32) & (TEXT_VALUE_SLOTS - 1)];
+    if (fmt != e->fmt || a != e->a || b != e->b || '\0' != e->s[0]) {
+        *e = (TextValueSlot){ .fmt = fmt, .a = a, .b = b };
+        text_memo_changed(&e->memo, 0);
+        snprintf(e->memo.text, sizeof(e->memo.text), fmt, a, b);
+    }
+    return value_of(&e->memo, size);
+}
+
+TextValue text_value_str(const char *fmt, const char *s, int a, int b, int size) {
+    assert(fmt && s);
+    size_t len = strlen(s);
+    if (TEXT_VALUE_LEN <= len) {
+        TextValue v;
+        snprintf(v.text, sizeof(v.text), fmt, s, a, b);
+        v.width = text_measure_compat(v.text, size);
+        return v;
+    }
+    uint64_t h = (hash_table_hash(s) ^ (uint64_t)(uintptr_t)fmt * 0x9E3779B97F4A7C15ull) ^
+                 ((uint64_t)(uint32_t)a << 32 | (uint32_t)b) * 0xC2B2AE3D27D4EB4Full;
+    TextValueSlot *e = &s_values[(h >> 32) & (TEXT_VALUE_SLOTS - 1)];
+    if (fmt != e->fmt || a != e->a || b != e->b || 0 != memcmp(s, e->s, len + 1)) {
+        *e = (TextValueSlot){ .fmt = fmt, .a = a, .b = b };
+        memcpy(e->s, s, len + 1);
+        text_memo_changed(&e->memo, 0);
+        snprintf(e->memo.text, sizeof(e->memo.text), fmt, s, a, b);
+    }
+    return value_of(&e->memo, size);
 }
@@ -5,7 +5,9 @@
  * fontFactorSize). The TTF is fetched async from /assets/fonts/<fontFamily> and,
  * once loaded, becomes the default font for every DrawText / MeasureText call via
  * the shims below; raylib's built-in font is used until then. fontFactorSize
- * scales every text size uniformly.
+ * scales every text size uniformly. Glyphs are rasterized per size bucket on
+ * first use (glyph_cache.h) unless fontSdf bakes one distance-field atlas. A
+ * fontSubset hint names a small subset file drawn until the family arrives.
  *
  * raylib.h is included first so the DrawText / MeasureText macro overrides are
  * defined only AFTER raylib's own declarations — inclusion order in consumers is
@@ -13,18 +15,25 @@
 
 #include <raylib.h>
 #include <stdbool.h>
+#include <stdint.h>
 
 void  text_font_init(void);    /* after InitWindow: seed defaults (built-in font) */
 void  text_font_sync(void);    /* per frame: kick the async fetch once hints name a font */
 void  text_font_unload(void);
-Font  text_active_font(void);  /* loaded main font, or GetFontDefault() until ready */
+Font  text_active_font(void);  /* SDF main font, else GetFontDefault() (glyph cache draws apart) */
 float text_font_factor(void);
+uint32_t text_font_generation(void);   /* changes whenever the drawn font does */
 
 /* DrawText / MeasureText routed through the active font + size factor, mirroring
  * raylib's built-in spacing (fontSize/10) so measure and draw stay consistent. */
 void text_draw_compat(const char *text, int x, int y, int size, Color color);
 int  text_measure_compat(const char *text, int size);
 
+/* `text` wrapped in a gapless `px`-deep outline, legible over any background.
+ * One pass under an SDF font (fontSdf hint) when the outline fits the field,
+ * else `px` concentric 8-direction rings of DrawText behind `fg`. */
+void text_draw_outlined(const char *text, int x, int y, int size, Color fg, Color outline, int px);
+
 /* Line advance for `size`-point text, including the active font factor + a small
  * inter-line gap. Use it to advance y past one drawn line so layouts scale when
  * the font size / family changes. */
@@ -33,9 +42,50 @@ int  text_line_height(int size);
 /* Word-wrap `text` into `maxw` pixels at `size` (active font + factor applied),
  * left-aligned at x or horizontally centred within [x, x+maxw] when `center`.
  * Renders when `draw` is true, else only measures. Returns the total pixel height
- * consumed — the single source of truth for text-driven dynamic layout height. */
+ * consumed — the single source of truth for text-driven dynamic layout height.
+ * Line breaks are cached per (text, size, maxw, font), so repeat calls only draw. */
 int  text_wrap(const char *text, int x, int y, int maxw, int size, Color col, bool center, bool draw);
 
+/* ── Formatted values ──────────────────────────────────────────────────
+ * HUD counters and overhead rows show the same few numbers frame after
+ * frame. A TextMemo is one call site's line: the caller formats into it
+ * only when its key (the value shown) changes, and its width is measured
+ * only when the text, size or drawn font does. Call sites drawn once per
+ * entity share text_value_*(), a small cache keyed by the format and its
+ * arguments, so two entities at the same HP cost one format between them. */
+
+#define TEXT_VALUE_LEN 64
+
+typedef struct {
+    bool     valid;
+    int64_t  key;
+    char     text[TEXT_VALUE_LEN];
+    int      width;        /* at width_size, width_fs, width_gen; -1: stale */
+    int      width_size;
+    float    width_fs;
+    uint32_t width_gen;
+} TextMemo;
+
+/* True when `key` differs from the last call's (always on the first): the
+ * caller then formats into memo->text. */
+bool text_memo_changed(TextMemo *memo, int64_t key);
+
+/* MeasureText(memo->text, size), measured again only after a change. */
+int  text_memo_width(TextMemo *memo, int size);
+
+typedef struct {
+    char text[TEXT_VALUE_LEN];
+    int  width;            /* MeasureText(text, size) */
+} TextValue;
+
+/* snprintf(fmt, a, b) and its width at `size`; `fmt` must be a string
+ * literal (its address is part of the key) taking up to two ints. */
+TextValue text_value_ints(const char *fmt, int a, int b, int size);
+
+/* snprintf(fmt, s, a, b), likewise, for a short string and up to two ints
+ * after it. A string too long to key is formatted every call. */
+TextValue text_value_str(const char *fmt, const char *s, int a, int b, int size);
+
 /* Variadic so a compound-literal Color argument — `(Color){ r, g, b, a }` — is
  * passed through as raw tokens and parsed by the C compiler, not split on its
  * inner commas by the preprocessor. */
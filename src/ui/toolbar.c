@@ -9,6 +9,7 @@
 #include "ui_icon.h"
 
 #include "js/fullscreen_bridge.h"
+#include "render_stats.h"
 
 #include <math.h>
 #include <raylib.h>
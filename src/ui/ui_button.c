@@ -1,7 +1,10 @@
 #include "ui_button.h"
 #include "text.h"
 #include "ui_icon.h"
+#include "ui_skin.h"
+#include "render_stats.h"
 
+#include <math.h>
 #include <stddef.h>
 
 /* Toggle-derived baseline chrome. */
@@ -138,19 +141,26 @@ void ui_button_pixel_retro_draw(Rectangle r, const UIButtonPixelRetroStyle* styl
 
     Rectangle inner = { r.x + 2.0f, r.y + 2.0f, r.width - 4.0f, r.height - 4.0f };
 
+    bool ring = style->selected || active_hover;
+    /* Chrome as one nine-slice from the shared skin page; the outline corner
+     * radius (0.18 roundness) is kept to half a pixel so buttons of a height
+     * share a cell. */
+    float min_side = r.width < r.height ? r.width : r.height;
+    UiSkin skin = { .kind = UI_SKIN_RETRO_BUTTON, .fill = fill, .light = highlight,
+                    .shade = shadow, .focused = ring,
+                    .radius = roundf(min_side * 0.09f * 2.0f) * 0.5f };
+
     if (style->flat) {
         /* Clean icon button: no fill, no black border, no bevel edges.
          * Only the icon is drawn, with an optional hover/selected outline. */
-    } else {
+        if (ring) DrawRectangleRoundedLinesEx(r, 0.18f, 6, 1.0f, WHITE);
+    } else if (!ui_skin_draw(&skin, r, WHITE)) {
         DrawRectangleRounded(inner, 0.18f, 6, fill);
         DrawRectangle((int)(inner.x + 4.0f), (int)inner.y, (int)(inner.width - 8.0f), 2, highlight);
         DrawRectangle((int)(inner.x + 4.0f), (int)(inner.y + inner.height - 2.0f),
                       (int)(inner.width - 8.0f), 2, shadow);
         DrawRectangleRoundedLinesEx(r, 0.18f, 6, 2.0f, BLACK);
-    }
-    if (style->selected || active_hover) {
-        Rectangle outline = style->flat ? r : inner;
-        DrawRectangleRoundedLinesEx(outline, 0.18f, 6, 1.0f, WHITE);
+        if (ring) DrawRectangleRoundedLinesEx(inner, 0.18f, 6, 1.0f, WHITE);
     }
 
     bool has_icon  = style->icon_id && '\0' != style->icon_id[0];
@@ -24,14 +24,16 @@
  *   ui_dispatch_tap          true  → UI absorbed the tap, world should ignore
  *   ui_dispatch_covers_point true  → screen pixel is currently covered by UI
  *                                    (used by the world hit-test guard)
+ *
+ * The walk decides which surface owns the tap; item-level targets inside a
+ * surface (instance map nodes, bar slots) resolve through the per-frame
+ * registry in ui_hit.h rather than re-walking their layout.
  */
 
 bool ui_dispatch_tap(int screen_x, int screen_y);
 bool ui_dispatch_covers_point(int screen_x, int screen_y);
 
 static void ui_on_tick(input_queue_t* input_queue, double dt) {
-    input_queue_t bkp_queue = { 0 };
-
     /* Inventory-bar slots activate on a clean release, so a horizontal drag
      * scrolls the strip instead of opening a modal. A standalone dialogue keeps
      * the slots read-only. */
@@ -55,51 +57,34 @@ static void ui_on_tick(input_queue_t* input_queue, double dt) {
         else if (!modal_dialogue_is_open())  inventory_modal_open(inv_tap);
     }
 
-    input_event_t evt = { 0 };
-    while (input_pop(input_queue, &evt)) {
-        bool consumed = false;
-        if(!consumed && INPUT_TAP == evt.type) {
-            int mx = (int)evt.screen_position.x;
-            int my = (int)evt.screen_position.y;
-            if (!consumed && ui_dispatch_tap(mx, my)) { consumed = true; }
-            if (!consumed && ui_dispatch_covers_point(mx, my)) { consumed = true; }
-        }
-        if(!consumed && INPUT_KEY_DEBUG == evt.type) {
-            presentation_runtime_toggle_dev_ui();
-            consumed = true;
-        }
+    for (input_event_t* evt = NULL; (evt = input_next(input_queue, evt, INPUT_TAP));) {
+        int mx = (int)evt->screen_position.x;
+        int my = (int)evt->screen_position.y;
+        if (ui_dispatch_tap(mx, my) || ui_dispatch_covers_point(mx, my)) { evt->consumed = true; }
+    }
 
-        if(!consumed && INPUT_ZOOM == evt.type) {
-            if (inventory_modal_handle_wheel(evt.wheel_delta)) { consumed = true; }
-        }
-        if(!consumed && INPUT_ZOOM == evt.type) {
-            if (modal_instance_map_handle_wheel(evt.wheel_delta)) { consumed = true; }
-        }
-        if(!consumed && INPUT_ZOOM == evt.type) {
-            if (modal_interact_handle_wheel(evt.wheel_delta)) { consumed = true; }
-        }
-        if(!consumed && INPUT_ZOOM == evt.type) {
-            if (quest_journal_handle_wheel(evt.wheel_delta)) { consumed = true; }
-        }
-        if(!consumed && INPUT_ZOOM == evt.type) {
-            if (!modal_interact_is_open() &&
-                interaction_bubble_handle_wheel(evt.wheel_delta)) { consumed = true; }
-        }
-        if(!consumed && INPUT_ZOOM == evt.type) {
-            if(evt.zoom_in) { camera_zoom_by(1.1); } else { camera_zoom_by(0.9); }
-            consumed = true;
-        }
+    for (input_event_t* evt = NULL; (evt = input_next(input_queue, evt, INPUT_KEY_DEBUG));) {
+        presentation_runtime_toggle_dev_ui();
+        evt->consumed = true;
+    }
 
-        // unconsumed event back to the queue
-        if(!consumed) {
-            input_push(&bkp_queue, evt );
-            continue;
+    for (input_event_t* evt = NULL; (evt = input_next(input_queue, evt, INPUT_ZOOM));) {
+        /* A scrolling surface takes the wheel part; the pinch part, if any,
+         * still zooms the camera. */
+        if (0.0f != evt->wheel_delta &&
+            (inventory_modal_handle_wheel(evt->wheel_delta) ||
+             modal_instance_map_handle_wheel(evt->wheel_delta) ||
+             modal_interact_handle_wheel(evt->wheel_delta) ||
+             quest_journal_handle_wheel(evt->wheel_delta) ||
+             (!modal_interact_is_open() &&
+              interaction_bubble_handle_wheel(evt->wheel_delta)))) {
+            evt->wheel_delta = 0.0f;
         }
+        float scale = evt->pinch_scale;
+        if (0.0f != evt->wheel_delta) { scale *= evt->zoom_in ? 1.1f : 0.9f; }
+        if (1.0f != scale) { camera_zoom_by(scale); }
+        evt->consumed = true;
     }
-
-    // return unconsummed events to the original queue
-    input_event_t bkp_evt = { 0 };
-    while (input_pop(&bkp_queue, &bkp_evt)) { input_push(input_queue, bkp_evt ); }
 }
 
 #endif /* CYBERIA_UI_DISPATCH_H */
@@ -0,0 +1,85 @@
+#include "ui_hit.h"
+
+#include <assert.h>
+#include <stdint.h>
+#include <string.h>
+
+#define UI_HIT_CELLS     (UI_HIT_GRID * UI_HIT_GRID)
+#define UI_HIT_MAX_LINKS (UI_HIT_MAX * 4)
+#define NO_LINK          (-1)
+
+/* Cell lists are singly linked, newest first, so a walk visits targets
+ * top-down. The wide list is one more head merged into every query. */
+static struct {
+    UiHit   hits[UI_HIT_MAX];
+    int     count;
+    struct { int16_t hit, next; } links[UI_HIT_MAX_LINKS];
+    int     link_count;
+    int16_t cell_head[UI_HIT_CELLS];
+    int16_t wide_head;
+    float   cell_w, cell_h;
+} g_hit = { .wide_head = NO_LINK, .cell_w = 1.0f, .cell_h = 1.0f };
+
+static int cell_of(float v, float cell) {
+    int c = (int)(v / cell);
+    return c < 0 ? 0 : (c >= UI_HIT_GRID ? UI_HIT_GRID - 1 : c);
+}
+
+static bool link(int16_t* head, int hit) {
+    if (UI_HIT_MAX_LINKS <= g_hit.link_count) return false;
+    int16_t l = (int16_t)g_hit.link_count++;
+    g_hit.links[l].hit  = (int16_t)hit;
+    g_hit.links[l].next = *head;
+    *head = l;
+    return true;
+}
+
+void ui_hit_begin_frame(int screen_width, int screen_height) {
+    g_hit.count      = 0;
+    g_hit.link_count = 0;
+    g_hit.wide_head  = NO_LINK;
+    memset(g_hit.cell_head, 0xff, sizeof g_hit.cell_head);     /* NO_LINK */
+    g_hit.cell_w = screen_width  > 0 ? (float)screen_width  / UI_HIT_GRID : 1.0f;
+    g_hit.cell_h = screen_height > 0 ? (float)screen_height / UI_HIT_GRID : 1.0f;
+}
+
+void ui_hit_add(UiHitOwner owner, int index, Rectangle rect) {
+    if (UI_HIT_MAX <= g_hit.count || 0.0f >= rect.width || 0.0f >= rect.height) return;
+    int hit = g_hit.count++;
+    g_hit.hits[hit] = (UiHit){ .owner = owner, .index = index, .rect = rect };
+
+    int c0 = cell_of(rect.x, g_hit.cell_w), c1 = cell_of(rect.x + rect.width,  g_hit.cell_w);
+    int r0 = cell_of(rect.y, g_hit.cell_h), r1 = cell_of(rect.y + rect.height, g_hit.cell_h);
+    if ((c1 - c0 + 1) * (r1 - r0 + 1) > UI_HIT_WIDE_CELLS) {
+        link(&g_hit.wide_head, hit);
+        return;
+    }
+    for (int r = r0; r <= r1; r++) {
+        for (int c = c0; c <= c1; c++) link(&g_hit.cell_head[r * UI_HIT_GRID + c], hit);
+    }
+}
+
+int ui_hit_query_all(Vector2 at, int owner, UiHit* out, int max) {
+    assert(out || 0 == max);
+    int16_t a = g_hit.cell_head[cell_of(at.y, g_hit.cell_h) * UI_HIT_GRID + cell_of(at.x, g_hit.cell_w)];
+    int16_t b = g_hit.wide_head;
+    int n = 0;
+    /* Both lists run newest first: merge on the hit index. */
+    while (n < max && (NO_LINK != a || NO_LINK != b)) {
+        int16_t* take = NO_LINK == b ? &a
+                      : NO_LINK == a ? &b
+                      : g_hit.links[a].hit > g_hit.links[b].hit ? &a : &b;
+        const UiHit* h = &g_hit.hits[g_hit.links[*take].hit];
+        *take = g_hit.links[*take].next;
+        if (UI_HIT_ANY != owner && (int)h->owner != owner) continue;
+        if (CheckCollisionPointRec(at, h->rect)) out[n++] = *h;
+    }
+    return n;
+}
+
+bool ui_hit_query(Vector2 at, int owner, UiHit* out) {
+    UiHit hit;
+    if (0 == ui_hit_query_all(at, owner, &hit, 1)) return false;
+    if (out) *out = hit;
+    return true;
+}
@@ -0,0 +1,47 @@
+#ifndef CYBERIA_UI_HIT_H
+#define CYBERIA_UI_HIT_H
+
+#include <raylib.h>
+#include <stdbool.h>
+
+/* ui_hit — per-frame registry of UI tap targets.
+ *
+ * Widgets register the rect of every target they draw, in draw order, and
+ * hit-testing becomes one query for the topmost (last drawn) target under a
+ * point instead of each module re-deriving its layout and walking its items.
+ * Rects are bucketed into a UI_HIT_GRID² screen grid; a rect spanning more
+ * than UI_HIT_WIDE_CELLS cells goes to a shared list every query walks.
+ *
+ * The registry is rebuilt at the start of the UI pass (ui_hit_begin_frame),
+ * so input handled on the next frame tests against exactly what was drawn. A
+ * target that was not drawn — a closed modal, a collapsed bar — has no rect
+ * and never hits. Targets past UI_HIT_MAX in one frame are dropped. */
+
+#define UI_HIT_MAX         256
+#define UI_HIT_GRID        16
+#define UI_HIT_WIDE_CELLS  16
+#define UI_HIT_ANY         (-1)
+
+typedef enum {
+    UI_HIT_IMAP_NODE,    /* index: instance map node */
+    UI_HIT_BAR_SLOT,     /* index: full_inventory slot, -1 for an empty coin slot */
+} UiHitOwner;
+
+typedef struct {
+    UiHitOwner owner;
+    int        index;
+    Rectangle  rect;
+} UiHit;
+
+/* Start the UI pass: drop last frame's targets. */
+void ui_hit_begin_frame(int screen_width, int screen_height);
+
+void ui_hit_add(UiHitOwner owner, int index, Rectangle rect);
+
+/* Topmost target of `owner` (UI_HIT_ANY for any) containing `at`. */
+bool ui_hit_query(Vector2 at, int owner, UiHit* out);
+
+/* Up to `max` such targets, topmost first; returns the count. */
+int  ui_hit_query_all(Vector2 at, int owner, UiHit* out, int max);
+
+#endif /* CYBERIA_UI_HIT_H */
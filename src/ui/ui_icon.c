@@ -1,11 +1,11 @@
 #include "ui_icon.h"
 
 #include "texture_cache.h"
+#include "render_stats.h"
 
 #include <assert.h>
 #include <math.h>
 #include <stdio.h>
-#include <stdlib.h>
 #include <string.h>
 
 /* ui_icon owns its own texture cache — decorative, presentation-only icons
@@ -17,12 +17,11 @@ static TextureCache* s_icon_cache = NULL;
 
 static void icon_blob_cb(const FetchResponse* r) {
     if (s_icon_cache) { texture_cache_on_blob_fetched(s_icon_cache, r); }
-    else              { free(r->data); }
 }
 
 void ui_icon_init(int capacity) {
     if (s_icon_cache) { return; }
-    s_icon_cache = texture_cache_create(capacity, "ui_icon", icon_blob_cb);
+    s_icon_cache = texture_cache_create(capacity, "ui_icon", GPU_MEM_UI_ICONS, icon_blob_cb);
 }
 
 void ui_icon_cleanup(void) {
@@ -79,3 +78,8 @@ void ui_icon_draw_ex(const char* icon_id, float cx, float cy, float size,
     DrawTexturePro(tex, src, dst, (Vector2){ size * 0.5f, size * 0.5f },
                    rotation_deg, tint);
 }
+
+unsigned ui_icon_generation(void) {
+    assert(s_icon_cache);
+    return texture_cache_generation(s_icon_cache);
+}
@@ -98,4 +98,8 @@ void ui_icon_draw(const char* icon_id, float cx, float cy, int size, bool bounce
 void ui_icon_draw_ex(const char* icon_id, float cx, float cy, float size,
                      float rotation_deg, Color tint);
 
+/* Changes whenever an icon finishes loading, so a panel baked while one was
+ * still a placeholder knows to redraw. */
+unsigned ui_icon_generation(void);
+
 #endif /* UI_ICON_H */
@@ -0,0 +1,129 @@
+#include "ui/ui_mesh.h"
+
+#include "gpu_memory.h"
+
+#include <assert.h>
+#include <math.h>
+#include <raymath.h>
+#include <rlgl.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Position, texcoord and colour streams per vertex. */
+#define UI_MESH_VERTEX_BYTES (3 * sizeof(float) + 2 * sizeof(float) + 4)
+
+/* Default material: the white texture and the vertex-colour shader. */
+static struct {
+    bool     loaded;
+    Material material;
+} g_ui_mesh;
+
+static void unload_gpu(UIMesh* m) {
+    if (!m->uploaded) return;
+    gpu_memory_sub(GPU_MEM_UI_MESHES, (size_t)m->mesh.vertexCount * UI_MESH_VERTEX_BYTES);
+    UnloadMesh(m->mesh);
+    m->mesh     = (Mesh){ 0 };
+    m->uploaded = false;
+}
+
+void ui_mesh_clear(UIMesh* m) {
+    assert(m);
+    unload_gpu(m);
+    m->count = 0;
+}
+
+static void push_vertex(UIMesh* m, float x, float y, Color c) {
+    if (m->count == m->capacity) {
+        int cap = m->capacity ? m->capacity * 2 : 1024;
+        m->vertices = realloc(m->vertices, (size_t)cap * 3 * sizeof(float));
+        m->colors   = realloc(m->colors, (size_t)cap * 4);
+        assert(m->vertices && m->colors);
+        m->capacity = cap;
+    }
+    float*         v   = &m->vertices[m->count * 3];
+    unsigned char* rgba = &m->colors[m->count * 4];
+    v[0] = x;
+    v[1] = y;
+    v[2] = 0.0f;
+    rgba[0] = c.r;
+    rgba[1] = c.g;
+    rgba[2] = c.b;
+    rgba[3] = c.a;
+    m->count++;
+}
+
+static void push_quad(UIMesh* m, Vector2 p0, Vector2 p1, Vector2 p2, Vector2 p3, Color c) {
+    push_vertex(m, p0.x, p0.y, c);
+    push_vertex(m, p1.x, p1.y, c);
+    push_vertex(m, p2.x, p2.y, c);
+    push_vertex(m, p0.x, p0.y, c);
+    push_vertex(m, p2.x, p2.y, c);
+    push_vertex(m, p3.x, p3.y, c);
+}
+
+void ui_mesh_rect(UIMesh* m, Rectangle r, Color c) {
+    assert(m && !m->uploaded);
+    if (0.0f >= r.width || 0.0f >= r.height) return;
+    push_quad(m, (Vector2){ r.x, r.y }, (Vector2){ r.x, r.y + r.height },
+              (Vector2){ r.x + r.width, r.y + r.height }, (Vector2){ r.x + r.width, r.y }, c);
+}
+
+void ui_mesh_line(UIMesh* m, Vector2 a, Vector2 b, float thick, Color c) {
+    assert(m && !m->uploaded);
+    float dx = b.x - a.x;
+    float dy = b.y - a.y;
+    float len = sqrtf(dx * dx + dy * dy);
+    if (0.0f >= len) return;
+    float nx = -dy / len * thick * 0.5f;
+    float ny =  dx / len * thick * 0.5f;
+    push_quad(m, (Vector2){ a.x + nx, a.y + ny }, (Vector2){ b.x + nx, b.y + ny },
+              (Vector2){ b.x - nx, b.y - ny }, (Vector2){ a.x - nx, a.y - ny }, c);
+}
+
+void ui_mesh_upload(UIMesh* m) {
+    assert(m && !m->uploaded);
+    if (0 == m->count) return;
+
+    float* texcoords = calloc((size_t)m->count * 2, sizeof(float));
+    assert(texcoords);
+    m->mesh = (Mesh){
+        .vertexCount   = m->count,
+        .triangleCount = m->count / 3,
+        .vertices      = m->vertices,
+        .texcoords     = texcoords,
+        .colors        = m->colors,
+    };
+    UploadMesh(&m->mesh, false);
+    free(texcoords);
+    /* The buffers now live on the GPU; the CPU arrays stay with the builder. */
+    m->mesh.vertices  = NULL;
+    m->mesh.texcoords = NULL;
+    m->mesh.colors    = NULL;
+    m->uploaded = true;
+    gpu_memory_add(GPU_MEM_UI_MESHES, (size_t)m->count * UI_MESH_VERTEX_BYTES);
+}
+
+void ui_mesh_draw(const UIMesh* m, Vector2 origin, float scale) {
+    assert(m);
+    if (!m->uploaded) return;
+    if (!g_ui_mesh.loaded) {
+        g_ui_mesh.material = LoadMaterialDefault();
+        g_ui_mesh.loaded   = true;
+    }
+    /* Flush the batch so the mesh lands in painter order, and draw both
+     * windings: 2D screen space flips y. */
+    rlDrawRenderBatchActive();
+    rlDisableBackfaceCulling();
+    Matrix transform = MatrixMultiply(MatrixScale(scale, scale, 1.0f),
+                                      MatrixTranslate(origin.x, origin.y, 0.0f));
+    DrawMesh(m->mesh, g_ui_mesh.material, transform);
+    rlEnableBackfaceCulling();
+}
+
+void ui_mesh_release(UIMesh* m) {
+    assert(m);
+    unload_gpu(m);
+    free(m->vertices);
+    free(m->colors);
+    *m = (UIMesh){ 0 };
+}
@@ -0,0 +1,47 @@
+#ifndef CYBERIA_UI_MESH_H
+#define CYBERIA_UI_MESH_H
+
+#include <raylib.h>
+#include <stdbool.h>
+
+/* ui_mesh — static 2D geometry uploaded once to a vertex buffer and drawn
+ * under a single translate + uniform scale per frame.
+ *
+ * The host fills the mesh in its own model space (rectangles and thick
+ * lines, flat vertex colours), uploads it, and then composites it each frame
+ * with one draw call while the camera pans or zooms:
+ *
+ *   ui_mesh_clear(&m);
+ *   ...ui_mesh_rect / ui_mesh_line in model units...
+ *   ui_mesh_upload(&m);
+ *   ...every frame...
+ *   ui_mesh_draw(&m, origin, scale);   screen = origin + model * scale
+ *
+ * Geometry drawn under a scale grows with it, pixel widths included, so
+ * hosts rebuild once the zoom settles. */
+
+typedef struct {
+    float*         vertices;   /* xyz per vertex while building */
+    unsigned char* colors;     /* rgba per vertex               */
+    int            count;
+    int            capacity;
+    bool           uploaded;
+    Mesh           mesh;
+} UIMesh;
+
+/* Drop the uploaded buffer and start an empty build. */
+void ui_mesh_clear(UIMesh* m);
+
+void ui_mesh_rect(UIMesh* m, Rectangle r, Color c);
+void ui_mesh_line(UIMesh* m, Vector2 a, Vector2 b, float thick, Color c);
+
+/* Upload what was built; the CPU copy is kept for the next clear. An empty
+ * build uploads nothing and draws nothing. */
+void ui_mesh_upload(UIMesh* m);
+
+void ui_mesh_draw(const UIMesh* m, Vector2 origin, float scale);
+
+/* Free the GPU buffer and the CPU copy. Safe on an empty mesh. */
+void ui_mesh_release(UIMesh* m);
+
+#endif /* CYBERIA_UI_MESH_H */
@@ -0,0 +1,123 @@
+#include "ui/ui_retained.h"
+
+#include "gpu_memory.h"
+#include "ui/text.h"
+#include "ui/ui_icon.h"
+
+#include <assert.h>
+#include <math.h>
+#include <rlgl.h>
+#include <string.h>
+
+/* The bake in progress, whose origin scissor rects are shifted by. */
+static struct {
+    bool  baking;
+    float origin_x;
+    float origin_y;
+} g_ui_retained;
+
+uint64_t ui_retained_mix(uint64_t key, uint64_t value) {
+    for (int i = 0; i < 8; i++) {
+        key ^= (value >> (i * 8)) & 0xFFu;
+        key *= 1099511628211ull;
+    }
+    return key;
+}
+
+uint64_t ui_retained_mix_float(uint64_t key, float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return ui_retained_mix(key, bits);
+}
+
+uint64_t ui_retained_key_seed(void) {
+    uint64_t key = 14695981039346656037ull;
+    key = ui_retained_mix(key, (uint64_t)(uint32_t)GetScreenWidth() << 32 |
+                               (uint32_t)GetScreenHeight());
+    key = ui_retained_mix(key, text_font_generation());
+    return ui_retained_mix(key, ui_icon_generation());
+}
+
+/* Whole pixels, so the composite is a 1:1 copy. */
+static Rectangle align_bounds(Rectangle b) {
+    float x0 = floorf(b.x);
+    float y0 = floorf(b.y);
+    return (Rectangle){ x0, y0, ceilf(b.x + b.width) - x0, ceilf(b.y + b.height) - y0 };
+}
+
+static void texture_fit(UIRetained* r, int w, int h) {
+    if (r->loaded && r->rt.texture.width == w && r->rt.texture.height == h) return;
+    ui_retained_release(r);
+    r->rt = LoadRenderTexture(w, h);
+    gpu_memory_add(GPU_MEM_UI_PANELS, gpu_memory_texture_bytes(r->rt.texture));
+    r->loaded = true;
+}
+
+bool ui_retained_stale(const UIRetained* r, uint64_t key) {
+    assert(r);
+    return !r->valid || r->key != key;
+}
+
+bool ui_retained_begin(UIRetained* r, Rectangle bounds, uint64_t key) {
+    assert(r && !g_ui_retained.baking);
+    Rectangle b = align_bounds(bounds);
+    if (1.0f > b.width || 1.0f > b.height) {
+        r->valid = false;
+        return false;
+    }
+
+    texture_fit(r, (int)b.width, (int)b.height);
+    r->bounds = b;
+    r->key    = key;
+    r->valid  = true;
+
+    g_ui_retained.baking   = true;
+    g_ui_retained.origin_x = b.x;
+    g_ui_retained.origin_y = b.y;
+
+    /* Straight-alpha draws onto a cleared target leave premultiplied colour
+     * and a correctly accumulated alpha behind. */
+    BeginTextureMode(r->rt);
+    ClearBackground(BLANK);
+    rlPushMatrix();
+    rlTranslatef(-b.x, -b.y, 0.0f);
+    rlSetBlendFactorsSeparate(RL_SRC_ALPHA, RL_ONE_MINUS_SRC_ALPHA, RL_ONE, RL_ONE_MINUS_SRC_ALPHA,
+                              RL_FUNC_ADD, RL_FUNC_ADD);
+    BeginBlendMode(BLEND_CUSTOM_SEPARATE);
+    return true;
+}
+
+void ui_retained_end(UIRetained* r) {
+    assert(r && g_ui_retained.baking);
+    EndBlendMode();
+    rlPopMatrix();
+    EndTextureMode();
+    g_ui_retained.baking = false;
+}
+
+void ui_retained_draw(const UIRetained* r) {
+    assert(r && !g_ui_retained.baking);
+    if (!r->valid) return;
+    /* Render textures are stored bottom-up. */
+    Rectangle src = { 0.0f, 0.0f, r->bounds.width, -r->bounds.height };
+    BeginBlendMode(BLEND_ALPHA_PREMULTIPLY);
+    DrawTexturePro(r->rt.texture, src, r->bounds, (Vector2){ 0.0f, 0.0f }, 0.0f, WHITE);
+    EndBlendMode();
+}
+
+void ui_retained_scissor_begin(int x, int y, int width, int height) {
+    if (g_ui_retained.baking) {
+        x -= (int)g_ui_retained.origin_x;
+        y -= (int)g_ui_retained.origin_y;
+    }
+    BeginScissorMode(x, y, width, height);
+}
+
+void ui_retained_release(UIRetained* r) {
+    assert(r);
+    if (r->loaded) {
+        gpu_memory_sub(GPU_MEM_UI_PANELS, gpu_memory_texture_bytes(r->rt.texture));
+        UnloadRenderTexture(r->rt);
+    }
+    *r = (UIRetained){ 0 };
+}
@@ -0,0 +1,65 @@
+#ifndef CYBERIA_UI_RETAINED_H
+#define CYBERIA_UI_RETAINED_H
+
+#include <raylib.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/* ui_retained — a panel drawn once into a render texture and composited
+ * every frame after that.
+ *
+ * The host folds everything its pixels depend on (store generations, scroll
+ * offset, toggle state, screen size, font and icon generations) into a key.
+ * While the key holds, a frame costs one quad; when it moves, the panel is
+ * redrawn into the texture with its usual immediate-mode code:
+ *
+ *   if (ui_retained_stale(&r, key)) {
+ *       ...lay the panel out...
+ *       if (ui_retained_begin(&r, bounds, key)) {
+ *           ...draw the panel exactly as before, in screen coordinates...
+ *           ui_retained_end(&r);
+ *       }
+ *   }
+ *   ui_retained_draw(&r);
+ *
+ * Anything animating (pop-in, expand, a scroll glide) should be drawn live
+ * instead until it settles. Scissor clips inside a bake go through
+ * ui_retained_scissor_begin() so they land in texture space. */
+
+typedef struct {
+    bool            loaded;
+    bool            valid;     /* texture holds the panel for `key`        */
+    uint64_t        key;
+    Rectangle       bounds;    /* pixel-aligned screen rect of the texture */
+    RenderTexture2D rt;
+} UIRetained;
+
+/* Fold one input into a key (FNV-1a over its bytes). */
+uint64_t ui_retained_mix(uint64_t key, uint64_t value);
+uint64_t ui_retained_mix_float(uint64_t key, float value);
+
+/* Seed for ui_retained_mix: the screen size plus the font and UI icon
+ * generations every panel depends on. */
+uint64_t ui_retained_key_seed(void);
+
+/* True when the texture does not hold the panel for `key`. */
+bool ui_retained_stale(const UIRetained* r, uint64_t key);
+
+/* Bind the texture, sized to `bounds`, for a bake of `key`; the caller draws
+ * the panel and calls ui_retained_end(). False, with nothing bound, when
+ * the bounds are empty. Must run outside BeginMode2D and any other texture
+ * mode. */
+bool ui_retained_begin(UIRetained* r, Rectangle bounds, uint64_t key);
+void ui_retained_end(UIRetained* r);
+
+/* Composite the baked panel at its bounds. */
+void ui_retained_draw(const UIRetained* r);
+
+/* BeginScissorMode in whichever space is being drawn: screen space, or the
+ * texture of the bake in progress. */
+void ui_retained_scissor_begin(int x, int y, int width, int height);
+
+/* Free the texture (panel hidden). Safe on an unloaded panel. */
+void ui_retained_release(UIRetained* r);
+
+#endif /* CYBERIA_UI_RETAINED_H */
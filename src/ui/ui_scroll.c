@@ -1,4 +1,6 @@
 #include "ui_scroll.h"
+#include "render_stats.h"
+#include "ui/ui_retained.h"
 
 #include <math.h>
 
@@ -193,8 +195,8 @@ float ui_scroll_offset(const UIScroll* s) {
 
 void ui_scroll_begin(const UIScroll* s) {
     if (!s) return;
-    BeginScissorMode((int)s->view.x, (int)s->view.y,
-                     (int)s->view.width, (int)s->view.height);
+    ui_retained_scissor_begin((int)s->view.x, (int)s->view.y,
+                              (int)s->view.width, (int)s->view.height);
 }
 
 void ui_scroll_end(const UIScroll* s) {
@@ -216,4 +218,24 @@ void ui_scroll_end(const UIScroll* s) {
     Color thumb = { 220, 230, 245, (unsigned char)(190.0f * s->bar_alpha) };
     DrawRectangleRounded((Rectangle){ thumb_x, thumb_y, UI_SCROLL_BAR_W, thumb_h },
                          1.0f, 4, thumb);
-}
\ No newline at end of file
+}
+void ui_scroll_rows_sync(UIScrollRows* r, uint64_t key) {
+    if (!r || (r->key == key && 0 != key)) return;
+    r->key = key;
+    for (int i = 0; i < UI_SCROLL_ROWS_MAX; i++) r->height[i] = -1.0f;
+}
+
+float ui_scroll_rows_get(const UIScrollRows* r, int i) {
+    if (!r || 0 > i || UI_SCROLL_ROWS_MAX <= i) return -1.0f;
+    return r->height[i];
+}
+
+void ui_scroll_rows_set(UIScrollRows* r, int i, float height) {
+    if (!r || 0 > i || UI_SCROLL_ROWS_MAX <= i) return;
+    r->height[i] = height;
+}
+
+bool ui_scroll_row_visible(const UIScroll* s, float y, float height) {
+    if (!s) return true;
+    return y < s->view.y + s->view.height && y + height > s->view.y;
+}
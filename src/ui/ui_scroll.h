@@ -3,6 +3,7 @@
 
 #include <raylib.h>
 #include <stdbool.h>
+#include <stdint.h>
 
 /* ui_scroll — reusable invisible scroll container for UI panels.
  *
@@ -30,6 +31,12 @@
  * and in the panel's tap handler, for presses inside the view:
  *   ui_scroll_on_press(&s, mx, my);
  * Route wheel deltas from the UI input dispatcher through ui_scroll_on_wheel().
+ *
+ * Virtualized lists: a host whose content is a run of rows keeps a
+ * UIScrollRows beside the container. Each row's height is measured once and
+ * reused while the host's key (content generation, width, page) holds, so
+ * sizing the content never re-wraps text; the draw pass advances past rows
+ * that fail ui_scroll_row_visible() without laying them out.
  */
 
 typedef struct {
@@ -53,6 +60,23 @@ typedef struct {
     float     bar_alpha;
 } UIScroll;
 
+#define UI_SCROLL_ROWS_MAX 64
+
+typedef struct {
+    uint64_t key;
+    float    height[UI_SCROLL_ROWS_MAX]; /* < 0: not measured under this key */
+} UIScrollRows;
+
+/* Forget every cached height when `key` differs from the last sync. */
+void  ui_scroll_rows_sync(UIScrollRows* r, uint64_t key);
+
+/* Cached height of row `i`, or < 0 when not measured (or past the cache). */
+float ui_scroll_rows_get(const UIScrollRows* r, int i);
+void  ui_scroll_rows_set(UIScrollRows* r, int i, float height);
+
+/* True when the on-screen band [y, y + height) meets the view. */
+bool  ui_scroll_row_visible(const UIScroll* s, float y, float height);
+
 /* Zero the container (fresh panel session: offset, glide, gesture, bar). */
 void ui_scroll_reset(UIScroll* s);
 
@@ -0,0 +1,217 @@
+#include "ui_skin.h"
+
+#include "gpu_memory.h"
+#include "util/log.h"
+
+#include <math.h>
+#include <rlgl.h>
+#include <string.h>
+
+#define SKIN_GUTTER 1
+
+typedef struct {
+    UiSkin    skin;
+    Rectangle cell;
+    int       slice;   /* border width of all four sides */
+} SkinCell;
+
+static struct {
+    bool      loaded;
+    Texture2D page;
+    SkinCell  cells[UI_SKIN_MAX];
+    int       count;
+    int       shelf_x, shelf_y, shelf_h;
+} g_skin;
+
+/* ── Rasterization ───────────────────────────────────────────────────── */
+
+static Color over(Color dst, Color src) {
+    float sa = src.a / 255.0f, da = dst.a / 255.0f;
+    float oa = sa + da * (1.0f - sa);
+    if (0.0f >= oa) return BLANK;
+    float k = da * (1.0f - sa);
+    return (Color){ (unsigned char)((src.r * sa + dst.r * k) / oa + 0.5f),
+                    (unsigned char)((src.g * sa + dst.g * k) / oa + 0.5f),
+                    (unsigned char)((src.b * sa + dst.b * k) / oa + 0.5f),
+                    (unsigned char)(oa * 255.0f + 0.5f) };
+}
+
+/* Share of pixel (x, y) inside the rounded square [lo, hi)² with corner
+ * radius `r`, from 4×4 samples. */
+static float rounded_cover(int x, int y, float lo, float hi, float r) {
+    int in = 0;
+    for (int sy = 0; sy < 4; sy++) {
+        for (int sx = 0; sx < 4; sx++) {
+            float px = (float)x + (sx + 0.5f) / 4.0f;
+            float py = (float)y + (sy + 0.5f) / 4.0f;
+            if (px < lo || px >= hi || py < lo || py >= hi) continue;
+            float cx = fminf(fmaxf(px, lo + r), hi - r);
+            float cy = fminf(fmaxf(py, lo + r), hi - r);
+            if ((px - cx) * (px - cx) + (py - cy) * (py - cy) <= r * r) in++;
+        }
+    }
+    return (float)in / 16.0f;
+}
+
+static Color covered(Color c, float cover) {
+    c.a = (unsigned char)(c.a * cover + 0.5f);
+    return c;
+}
+
+static bool band(int v, int lo, int hi) {
+    return v >= lo && v < hi;
+}
+
+/* Tile coordinates are the destination's: the bounds span [2, size - 2). */
+static Color retro_texel(const UiSkin* s, int x, int y, int size) {
+    float fr  = s->radius;
+    float fin = fmaxf(fr - 0.36f, 0.0f);          /* fill radius: 0.18 of a 4 px smaller rect */
+    float far = (float)size;
+    Color px  = BLANK;
+
+    float fill = rounded_cover(x, y, 4.0f, far - 4.0f, fin);
+    if (0.0f < fill) px = over(px, covered(s->fill, fill));
+    bool bevel_x = band(x, 8, size - 8);
+    if (bevel_x && band(y, 4, 6))               px = over(px, s->light);
+    if (bevel_x && band(y, size - 6, size - 4)) px = over(px, s->shade);
+
+    float ring = rounded_cover(x, y, 0.0f, far, fr + 2.0f) - rounded_cover(x, y, 2.0f, far - 2.0f, fr);
+    if (0.0f < ring) px = over(px, covered(BLACK, ring));
+    if (s->focused) {
+        float hover = rounded_cover(x, y, 3.0f, far - 3.0f, fin + 1.0f) - fill;
+        if (0.0f < hover) px = over(px, covered(WHITE, hover));
+    }
+    return px;
+}
+
+static Color panel_texel(const UiSkin* s, int x, int y, int size) {
+    Color px = BLANK;
+    int   e  = size - 2;
+    if (UI_SKIN_PIXEL_PANEL == s->kind) {
+        px = BLACK;
+        if (band(x, 2, e) && band(y, 2, e)) px = over(px, s->fill);
+    }
+    if (2 > y || 2 > x)                 px = over(px, s->light);
+    if (e <= y || e <= x)               px = over(px, s->shade);
+    if (2 > x && band(y, 4, size - 4))  px = over(px, s->accent);
+    if (s->focused) {
+        if (0 == x || 0 == y || size - 1 == x || size - 1 == y) px = over(px, WHITE);
+        bool corner_x = 4 > x || size - 4 <= x;
+        bool corner_y = 4 > y || size - 4 <= y;
+        if (corner_x && corner_y) px = over(px, (Color){ 4, 8, 16, 255 });
+    }
+    return px;
+}
+
+static int skin_slice(const UiSkin* s) {
+    if (UI_SKIN_RETRO_BUTTON != s->kind) return 4;
+    int slice = (int)ceilf(s->radius) + 3;
+    return 8 > slice ? 8 : slice;
+}
+
+/* ── Page ────────────────────────────────────────────────────────────── */
+
+static bool page_ensure(void) {
+    if (g_skin.loaded) return true;
+    Image blank = GenImageColor(UI_SKIN_PAGE_PX, UI_SKIN_PAGE_PX, BLANK);
+    g_skin.page = LoadTextureFromImage(blank);
+    UnloadImage(blank);
+    if (0 == g_skin.page.id) return false;
+    gpu_memory_add(GPU_MEM_UI_SKINS, gpu_memory_texture_bytes(g_skin.page));
+    g_skin.loaded = true;
+    return true;
+}
+
+static void page_reset(void) {
+    /* Quads already batched still sample the old cells. */
+    rlDrawRenderBatchActive();
+    g_skin.count   = 0;
+    g_skin.shelf_x = g_skin.shelf_y = g_skin.shelf_h = 0;
+}
+
+static bool page_place(int size, Rectangle* out) {
+    int w = size + SKIN_GUTTER;
+    if (UI_SKIN_PAGE_PX < g_skin.shelf_x + w) {
+        g_skin.shelf_y += g_skin.shelf_h;
+        g_skin.shelf_x  = 0;
+        g_skin.shelf_h  = 0;
+    }
+    if (UI_SKIN_PAGE_PX < g_skin.shelf_y + w || UI_SKIN_PAGE_PX < w) return false;
+    *out = (Rectangle){ (float)g_skin.shelf_x, (float)g_skin.shelf_y, (float)size, (float)size };
+    g_skin.shelf_x += w;
+    if (w > g_skin.shelf_h) g_skin.shelf_h = w;
+    return true;
+}
+
+static bool color_eq(Color a, Color b) {
+    return a.r == b.r && a.g == b.g && a.b == b.b && a.a == b.a;
+}
+
+static bool skin_eq(const UiSkin* a, const UiSkin* b) {
+    return a->kind == b->kind && a->focused == b->focused && a->radius == b->radius &&
+           color_eq(a->fill, b->fill) && color_eq(a->light, b->light) &&
+           color_eq(a->shade, b->shade) && color_eq(a->accent, b->accent);
+}
+
+static const SkinCell* skin_cell(const UiSkin* skin) {
+    for (int i = 0; i < g_skin.count; i++) {
+        if (skin_eq(&g_skin.cells[i].skin, skin)) return &g_skin.cells[i];
+    }
+    if (!page_ensure()) return NULL;
+
+    int slice = skin_slice(skin);
+    int size  = slice * 2 + 1;
+    Rectangle cell;
+    if (UI_SKIN_MAX <= g_skin.count || !page_place(size, &cell)) {
+        LOG_INFO("[ui_skin] page full at %d skins, refilling", g_skin.count);
+        page_reset();
+        if (!page_place(size, &cell)) return NULL;
+    }
+
+    Image tile = GenImageColor(size, size, BLANK);
+    Color* px  = (Color*)tile.data;
+    for (int y = 0; y < size; y++) {
+        for (int x = 0; x < size; x++) {
+            px[y * size + x] = UI_SKIN_RETRO_BUTTON == skin->kind ? retro_texel(skin, x, y, size)
+                                                                  : panel_texel(skin, x, y, size);
+        }
+    }
+    UpdateTextureRec(g_skin.page, cell, tile.data);
+    UnloadImage(tile);
+
+    SkinCell* c = &g_skin.cells[g_skin.count++];
+    *c = (SkinCell){ .skin = *skin, .cell = cell, .slice = slice };
+    return c;
+}
+
+/* ── Public API ──────────────────────────────────────────────────────── */
+
+bool ui_skin_draw(const UiSkin* skin, Rectangle bounds, Color tint) {
+    UiSkin key = *skin;
+    if (UI_SKIN_RETRO_BUTTON == key.kind) key.accent = BLANK;
+    else                                  key.radius = 0.0f;
+    if (UI_SKIN_PIXEL_BORDER == key.kind) key.fill   = BLANK;
+
+    Rectangle dest = bounds;
+    if (UI_SKIN_RETRO_BUTTON == key.kind) {
+        dest = (Rectangle){ bounds.x - 2.0f, bounds.y - 2.0f, bounds.width + 4.0f, bounds.height + 4.0f };
+    }
+    /* Below two corners' worth the patch would squash them. */
+    float span = (float)(skin_slice(&key) * 2 + 1);
+    if (dest.width < span || dest.height < span) return false;
+
+    const SkinCell* c = skin_cell(&key);
+    if (!c) return false;
+    NPatchInfo patch = { .source = c->cell, .left = c->slice, .top = c->slice,
+                         .right = c->slice, .bottom = c->slice, .layout = NPATCH_NINE_PATCH };
+    DrawTextureNPatch(g_skin.page, patch, dest, (Vector2){ 0.0f, 0.0f }, 0.0f, tint);
+    return true;
+}
+
+void ui_skin_release(void) {
+    if (g_skin.loaded) {
+        gpu_memory_sub(GPU_MEM_UI_SKINS, gpu_memory_texture_bytes(g_skin.page));
+        UnloadTexture(g_skin.page);
+    }
+    memset(&g_skin, 0, sizeof g_skin);
+}
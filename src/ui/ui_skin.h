@@ -0,0 +1,53 @@
+#ifndef CYBERIA_UI_SKIN_H
+#define CYBERIA_UI_SKIN_H
+
+#include <raylib.h>
+#include <stdbool.h>
+
+/* Nine-slice skins for procedural UI chrome.
+ *
+ * Bevelled buttons and pixel panels were drawn as a stack of rects, rounded
+ * fills and line strips per widget per frame. All of their detail sits a
+ * fixed number of pixels from an edge, so each style and colour set is
+ * rasterized once, at the smallest size that holds its corners, into a cell
+ * of one shared UI_SKIN_PAGE_PX page, and each widget draws as one
+ * DrawTextureNPatch: nine quads from the same texture, so consecutive
+ * chrome batches regardless of colour.
+ *
+ * Cells are shelf-packed and never evicted; a full page is cleared and
+ * refilled as skins come back into use. Fading and tinting go through the
+ * draw tint, not the cache key. */
+
+#define UI_SKIN_PAGE_PX    256
+#define UI_SKIN_MAX        96
+
+typedef enum {
+    /* ui_button_pixel_retro chrome: black rounded outline two pixels outside
+     * the bounds, rounded fill inset two, top highlight and bottom shadow. */
+    UI_SKIN_RETRO_BUTTON,
+    /* Instance map card: black frame, inset fill, light top/left, shade
+     * bottom/right and an accent strip down the left edge. */
+    UI_SKIN_PIXEL_PANEL,
+    /* The panel's bevel and strip alone, over content drawn inside it. */
+    UI_SKIN_PIXEL_BORDER,
+} UiSkinKind;
+
+typedef struct {
+    UiSkinKind kind;
+    Color      fill;
+    Color      light;      /* retro: highlight; panel: top/left bevel */
+    Color      shade;      /* retro: shadow;    panel: bottom/right bevel */
+    Color      accent;     /* panel: left strip */
+    bool       focused;    /* retro: white hover ring; panel: white frame + dark corners */
+    float      radius;     /* retro: outline corner radius, px */
+} UiSkin;
+
+/* Draw `skin` over `bounds` (retro: the outline lands two pixels outside)
+ * multiplied by `tint`. False when no cell could be made — the caller draws
+ * the chrome directly. */
+bool ui_skin_draw(const UiSkin* skin, Rectangle bounds, Color tint);
+
+/* Unload the page and forget every skin. */
+void ui_skin_release(void);
+
+#endif /* CYBERIA_UI_SKIN_H */
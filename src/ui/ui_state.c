@@ -1,20 +1,51 @@
 #include "ui_state.h"
 
+#include "hash_table.h"
+
+#include <stdint.h>
 #include <string.h>
 
+/* One trigger item's skills, in push order. */
+typedef struct {
+    int count;
+    int skills[UI_STATE_MAX_SKILL_ENTRIES];
+} SkillList;
+
 static struct {
     char         associated_items[UI_STATE_MAX_ITEM_IDS][MAX_ITEM_ID_LENGTH];
     int          associated_item_count;
+    HashTable    associated_index;   /* item id → index + 1 */
     UiSkillEntry skills[UI_STATE_MAX_SKILL_ENTRIES];
     int          skill_count;
+    SkillList    skill_lists[UI_STATE_MAX_SKILL_ENTRIES];
+    int          skill_list_count;
+    HashTable    skill_index;        /* trigger item id → skill_lists index + 1 */
+    bool         indexed;
 } g_ui = {0};
 
+static void index_ensure(void) {
+    if (g_ui.indexed) return;
+    hash_table_init(&g_ui.associated_index, 256, NULL, "ui_associated_items");
+    hash_table_init(&g_ui.skill_index, 64, NULL, "ui_skill_map");
+    g_ui.indexed = true;
+}
+
+static void index_reset(HashTable* t, size_t capacity, const char* name) {
+    if (!g_ui.indexed) return;
+    hash_table_destroy(t);
+    hash_table_init(t, capacity, NULL, name);
+}
+
 void ui_state_reset(void) {
+    ui_state_clear_associated_items();
+    ui_state_clear_skills();
+}
+
+void ui_state_clear_associated_items(void) {
     g_ui.associated_item_count = 0;
-    g_ui.skill_count           = 0;
+    index_reset(&g_ui.associated_index, 256, "ui_associated_items");
 }
 
-void ui_state_clear_associated_items(void) { g_ui.associated_item_count = 0; }
 int  ui_state_associated_item_count(void)  { return g_ui.associated_item_count; }
 
 const char* ui_state_associated_item_at(int idx) {
@@ -22,15 +53,29 @@ const char* ui_state_associated_item_at(int idx) {
     return g_ui.associated_items[idx];
 }
 
+bool ui_state_has_associated_item(const char* item_id) {
+    return item_id && g_ui.indexed && hash_table_contains(&g_ui.associated_index, item_id);
+}
+
 int ui_state_push_associated_item(const char* item_id) {
-    if (!item_id || g_ui.associated_item_count >= UI_STATE_MAX_ITEM_IDS) return -1;
-    strncpy(g_ui.associated_items[g_ui.associated_item_count],
-            item_id, MAX_ITEM_ID_LENGTH - 1);
-    g_ui.associated_items[g_ui.associated_item_count][MAX_ITEM_ID_LENGTH - 1] = '\0';
+    if (!item_id) return -1;
+    index_ensure();
+    intptr_t known = (intptr_t)hash_table_get(&g_ui.associated_index, item_id);
+    if (known) return (int)known - 1;
+    if (g_ui.associated_item_count >= UI_STATE_MAX_ITEM_IDS) return -1;
+    char* dst = g_ui.associated_items[g_ui.associated_item_count];
+    strncpy(dst, item_id, MAX_ITEM_ID_LENGTH - 1);
+    dst[MAX_ITEM_ID_LENGTH - 1] = '\0';
+    hash_table_put(&g_ui.associated_index, dst, (void*)(intptr_t)(g_ui.associated_item_count + 1));
     return g_ui.associated_item_count++;
 }
 
-void ui_state_clear_skills(void)            { g_ui.skill_count = 0; }
+void ui_state_clear_skills(void) {
+    g_ui.skill_count      = 0;
+    g_ui.skill_list_count = 0;
+    index_reset(&g_ui.skill_index, 64, "ui_skill_map");
+}
+
 int  ui_state_skill_count(void)             { return g_ui.skill_count; }
 
 const UiSkillEntry* ui_state_skill_at(int idx) {
@@ -38,8 +83,31 @@ const UiSkillEntry* ui_state_skill_at(int idx) {
     return &g_ui.skills[idx];
 }
 
+int ui_state_skills_for_item(const char* item_id, const int** indices) {
+    *indices = NULL;
+    if (!item_id || !g_ui.indexed) return 0;
+    intptr_t list = (intptr_t)hash_table_get(&g_ui.skill_index, item_id);
+    if (!list) return 0;
+    const SkillList* l = &g_ui.skill_lists[list - 1];
+    *indices = l->skills;
+    return l->count;
+}
+
 int ui_state_push_skill(const UiSkillEntry* entry) {
     if (!entry || g_ui.skill_count >= UI_STATE_MAX_SKILL_ENTRIES) return -1;
-    g_ui.skills[g_ui.skill_count] = *entry;
-    return g_ui.skill_count++;
+    index_ensure();
+    int idx = g_ui.skill_count++;
+    g_ui.skills[idx] = *entry;
+
+    const char* trigger = g_ui.skills[idx].trigger_item_id;
+    intptr_t list = (intptr_t)hash_table_get(&g_ui.skill_index, trigger);
+    if (!list) {
+        /* Never more lists than skills, so this always has room. */
+        list = ++g_ui.skill_list_count;
+        g_ui.skill_lists[list - 1].count = 0;
+        hash_table_put(&g_ui.skill_index, trigger, (void*)list);
+    }
+    SkillList* l = &g_ui.skill_lists[list - 1];
+    l->skills[l->count++] = idx;
+    return idx;
 }
@@ -1,6 +1,7 @@
 #ifndef CYBERIA_UI_STATE_H
 #define CYBERIA_UI_STATE_H
 
+#include <stdbool.h>
 #include <stddef.h>
 
 #include "object_layer.h"
@@ -13,7 +14,8 @@
  *     server's init_data so the client can render the right skill labels.
  *
  * Both are pure presentation lookup tables and never participate in
- * gameplay simulation, which is why they live outside GameState.
+ * gameplay simulation, which is why they live outside GameState. Each is
+ * hashed as it is pushed: membership and an item's skills are one lookup.
  */
 
 #define UI_STATE_MAX_ITEM_IDS    1024
@@ -32,11 +34,16 @@ void ui_state_reset(void);
 void   ui_state_clear_associated_items(void);
 int    ui_state_associated_item_count(void);
 const char* ui_state_associated_item_at(int idx);
-int    ui_state_push_associated_item(const char* item_id);
+int    ui_state_push_associated_item(const char* item_id);   /* a repeat returns its index */
+bool   ui_state_has_associated_item(const char* item_id);
 
 void   ui_state_clear_skills(void);
 int    ui_state_skill_count(void);
 const UiSkillEntry* ui_state_skill_at(int idx);
 int    ui_state_push_skill(const UiSkillEntry* entry);
 
+/* Skills triggered by `item_id`: count, with their ui_state_skill_at()
+ * indices in push order at `*indices` (valid until the next push or clear). */
+int    ui_state_skills_for_item(const char* item_id, const int** indices);
+
 #endif /* CYBERIA_UI_STATE_H */
@@ -2,6 +2,7 @@
 #include "ui_button.h"
 #include "ui_icon.h"
 #include "text.h"
+#include "render_stats.h"
 
 #define UI_TOGGLE_ANIM_SPEED 6.667f /* ~150 ms 0..1 */
 
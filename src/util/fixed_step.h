@@ -0,0 +1,47 @@
+#ifndef CYBERIA_UTIL_FIXED_STEP_H
+#define CYBERIA_UTIL_FIXED_STEP_H
+
+/* Fixed-substep scheduler: turns variable frame intervals into whole steps
+ * of `step` seconds plus a remainder, so an integrator stepped through it
+ * behaves the same at any display refresh rate. fixed_step_alpha() is how
+ * far the remainder reaches into the next step, for interpolating the
+ * output between the last two steps.
+ *
+ * `max_steps` caps the steps one advance may run (0 = no cap); time beyond
+ * the cap is dropped rather than carried, so a long hitch costs a bounded
+ * amount of work instead of a burst of catch-up steps. */
+
+#include <math.h>
+
+typedef struct {
+    double step;
+    double acc;
+    int    max_steps;
+} FixedStep;
+
+/* Bank `dt` seconds and return how many steps to run now. */
+static inline int fixed_step_advance(FixedStep* s, double dt) {
+    s->acc += dt;
+    int n = 0;
+    while (s->acc >= s->step && (0 >= s->max_steps || n < s->max_steps)) {
+        s->acc -= s->step;
+        n++;
+    }
+    if (s->acc >= s->step) s->acc = fmod(s->acc, s->step);
+    return n;
+}
+
+/* Run one step ahead of the clock, now: it comes out of the time banked
+ * next, so the step rate over time is unchanged. Returns the 1 step to run. */
+static inline int fixed_step_borrow(FixedStep* s) {
+    s->acc -= s->step;
+    return 1;
+}
+
+/* Remainder as a fraction of one step, in [0, 1); below 0 while a
+ * borrowed step is being repaid. */
+static inline float fixed_step_alpha(const FixedStep* s) {
+    return (float)(s->acc / s->step);
+}
+
+#endif /* CYBERIA_UTIL_FIXED_STEP_H */
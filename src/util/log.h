@@ -13,6 +13,8 @@
  * release builds and DEBUG when NDEBUG is undefined.
  */
 
+#include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 
 #define LOG_LEVEL_NONE   0
@@ -53,4 +55,59 @@
 #  define LOG_ERROR(fmt, ...) ((void)0)
 #endif
 
+/* Hot-path logging: LOG_WARN_HOT / LOG_ERROR_HOT for conditions that can
+ * recur every frame under load (table growth, full queues, ring overflow).
+ * Each call site prints at most once per LOG_RATE_WINDOW_S and tags its next
+ * line with the repeats it swallowed, "(+N suppressed)"; all hot sites
+ * together get LOG_FRAME_BUDGET lines per frame (log_frame_mark), the
+ * overflow summarised once per window. Under emscripten every line crosses
+ * into the JS console, so an overload must not become a log storm.
+ *
+ * -DCYBERIA_LOG_HOT=0 elides them completely; the default under NDEBUG. */
+#ifndef CYBERIA_LOG_HOT
+#  ifdef NDEBUG
+#    define CYBERIA_LOG_HOT 0
+#  else
+#    define CYBERIA_LOG_HOT 1
+#  endif
+#endif
+
+#define LOG_RATE_WINDOW_S 1.0
+#define LOG_FRAME_BUDGET  8
+
+typedef struct {
+    double   next;         /* earliest time the site may print again */
+    uint32_t suppressed;   /* calls swallowed since its last line */
+} LogRateSite;
+
+/* True when `site` may print now; *suppressed then takes its swallowed
+ * count. Implemented in src/log_rate.c, main thread only. */
+bool log_rate_admit(LogRateSite* site, uint32_t* suppressed);
+
+/* Open a new frame's line budget. */
+void log_frame_mark(void);
+
+#define LOG_HOT_(tag, fmt, ...)                                                    \
+    do {                                                                           \
+        static LogRateSite log_site_;                                              \
+        uint32_t log_suppressed_;                                                  \
+        if (log_rate_admit(&log_site_, &log_suppressed_)) {                        \
+            if (0 == log_suppressed_) fprintf(stderr, tag fmt "\n", ##__VA_ARGS__); \
+            else fprintf(stderr, tag fmt " (+%u suppressed)\n", ##__VA_ARGS__,       \
+                         (unsigned)log_suppressed_);                               \
+        }                                                                          \
+    } while (0)
+
+#if CYBERIA_LOG_HOT && CYBERIA_LOG_LEVEL >= LOG_LEVEL_WARN
+#  define LOG_WARN_HOT(fmt, ...)  LOG_HOT_("[WRN] ", fmt, ##__VA_ARGS__)
+#else
+#  define LOG_WARN_HOT(fmt, ...)  ((void)0)
+#endif
+
+#if CYBERIA_LOG_HOT && CYBERIA_LOG_LEVEL >= LOG_LEVEL_ERROR
+#  define LOG_ERROR_HOT(fmt, ...) LOG_HOT_("[ERR] ", fmt, ##__VA_ARGS__)
+#else
+#  define LOG_ERROR_HOT(fmt, ...) ((void)0)
+#endif
+
 #endif /* CYBERIA_UTIL_LOG_H */
@@ -0,0 +1,66 @@
+#ifndef CYBERIA_UTIL_POOL_H
+#define CYBERIA_UTIL_POOL_H
+
+/* Typed fixed-capacity object pool with an O(1) free list.
+ *
+ *     POOL_DEFINE(fct_pool, FCTEntry, 64)
+ *
+ * declares `fct_pool` (items inline, zero-initialised is empty) and static
+ * inline fct_pool_alloc / _free / _clear / _used / _at / _extent. Slots
+ * never handed out are taken in order; freed slots are threaded through
+ * next_free (as index + 1, so zero means "none") and reused first. _alloc
+ * returns NULL when every slot is live and never clears the item.
+ *
+ * Iterate with `for (i = 0; i < name_extent(p); i++) if (name_used(p, i))`:
+ * the extent only covers slots ever handed out since the last clear. */
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+#define POOL_DEFINE(name, T, cap)                                                  \
+    typedef struct {                                                               \
+        T    items[cap];                                                           \
+        int  next_free[cap];                                                       \
+        bool used[cap];                                                            \
+        int  free_head;    /* index + 1 of the first freed slot, 0 for none */     \
+        int  fresh;        /* slots handed out at least once */                    \
+        int  count;                                                                \
+    } name;                                                                        \
+    static inline T* name##_alloc(name* p) {                                       \
+        int i;                                                                     \
+        if (0 != p->free_head) {                                                   \
+            i            = p->free_head - 1;                                       \
+            p->free_head = p->next_free[i];                                        \
+        } else if ((cap) > p->fresh) {                                             \
+            i = p->fresh++;                                                        \
+        } else {                                                                   \
+            return NULL;                                                           \
+        }                                                                          \
+        p->used[i] = true;                                                         \
+        p->count++;                                                                \
+        return &p->items[i];                                                       \
+    }                                                                              \
+    static inline void name##_free(name* p, T* item) {                             \
+        ptrdiff_t i = item - p->items;                                             \
+        assert(0 <= i && (cap) > i && p->used[i]);                                 \
+        p->used[i]      = false;                                                   \
+        p->next_free[i] = p->free_head;                                            \
+        p->free_head    = (int)i + 1;                                              \
+        p->count--;                                                                \
+    }                                                                              \
+    static inline void name##_clear(name* p) {                                     \
+        memset(p->used, 0, sizeof(p->used));                                       \
+        p->free_head = 0;                                                          \
+        p->fresh     = 0;                                                          \
+        p->count     = 0;                                                          \
+    }                                                                              \
+    static inline int  name##_extent(const name* p) { return p->fresh; }           \
+    static inline bool name##_used(const name* p, int i) { return p->used[i]; }    \
+    static inline T*   name##_at(name* p, int i) {                                 \
+        assert(0 <= i && p->fresh > i);                                            \
+        return &p->items[i];                                                       \
+    }
+
+#endif /* CYBERIA_UTIL_POOL_H */
@@ -0,0 +1,46 @@
+#ifndef CYBERIA_UTIL_RING_H
+#define CYBERIA_UTIL_RING_H
+
+/* Typed fixed-capacity FIFO ring.
+ *
+ *     RING_DEFINE(cmd_ring, input_command_t, 256)
+ *
+ * declares `cmd_ring` (items inline, zero-initialised is empty) and static
+ * inline cmd_ring_clear / _full / _push / _pop / _at. The capacity must be a
+ * power of two so wrapping is a mask. _push returns the new back slot for
+ * the caller to fill; _pop and _at index from the front. Neither checks for
+ * you beyond asserts: test _full before pushing and count before popping. */
+
+#include <assert.h>
+#include <stdbool.h>
+
+#define RING_DEFINE(name, T, cap)                                                  \
+    static_assert(0 < (cap) && 0 == ((cap) & ((cap) - 1)),                         \
+                  #name " capacity must be a power of two");                       \
+    typedef struct {                                                               \
+        T   items[cap];                                                            \
+        int head;                                                                  \
+        int count;                                                                 \
+    } name;                                                                        \
+    static inline void name##_clear(name* r) {                                     \
+        r->head  = 0;                                                              \
+        r->count = 0;                                                              \
+    }                                                                              \
+    static inline bool name##_full(const name* r) { return (cap) == r->count; }    \
+    static inline T* name##_at(name* r, int i) {                                   \
+        assert(0 <= i && i < r->count);                                            \
+        return &r->items[(r->head + i) & ((cap) - 1)];                             \
+    }                                                                              \
+    static inline T* name##_push(name* r) {                                        \
+        assert((cap) > r->count);                                                  \
+        return &r->items[(r->head + r->count++) & ((cap) - 1)];                    \
+    }                                                                              \
+    static inline T name##_pop(name* r) {                                          \
+        assert(0 < r->count);                                                      \
+        T v = r->items[r->head];                                                   \
+        r->head = (r->head + 1) & ((cap) - 1);                                     \
+        r->count--;                                                                \
+        return v;                                                                  \
+    }
+
+#endif /* CYBERIA_UTIL_RING_H */
@@ -0,0 +1,71 @@
+#ifndef CYBERIA_UTIL_SLOT_MAP_H
+#define CYBERIA_UTIL_SLOT_MAP_H
+
+/* Typed fixed-capacity generational slot map: O(1) insert, lookup and
+ * remove by handle, with stale handles detected.
+ *
+ *     SLOT_MAP_DEFINE(job_map, DecodeJob*, 256)
+ *
+ * declares `job_map` (zero-initialised is empty) and static inline
+ * job_map_insert / _get / _remove. A handle packs the slot index + 1 in its
+ * low 16 bits and the slot's generation (15 bits) above, so it is always a
+ * positive int — safe to hand across the JS bridge — and never 0, which
+ * callers may use as "none". Removing a slot bumps its generation: the old
+ * handle then misses instead of aliasing whatever reuses the slot. */
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#define SLOT_MAP_GEN_MASK 0x7fff
+
+#define SLOT_MAP_DEFINE(name, T, cap)                                              \
+    static_assert(0 < (cap) && 0xffff > (cap), #name " capacity must fit 16 bits"); \
+    typedef struct {                                                               \
+        T        items[cap];                                                       \
+        uint16_t gen[cap];                                                         \
+        int      next_free[cap];                                                   \
+        bool     used[cap];                                                        \
+        int      free_head;    /* index + 1, 0 for none */                         \
+        int      fresh;                                                            \
+        int      count;                                                            \
+    } name;                                                                        \
+    /* Handle of the new slot holding `value`, or 0 when full. */                  \
+    static inline int name##_insert(name* m, T value) {                            \
+        int i;                                                                     \
+        if (0 != m->free_head) {                                                   \
+            i            = m->free_head - 1;                                       \
+            m->free_head = m->next_free[i];                                        \
+        } else if ((cap) > m->fresh) {                                             \
+            i = m->fresh++;                                                        \
+        } else {                                                                   \
+            return 0;                                                              \
+        }                                                                          \
+        m->items[i] = value;                                                       \
+        m->used[i]  = true;                                                        \
+        m->count++;                                                                \
+        return (int)((uint32_t)(m->gen[i] & SLOT_MAP_GEN_MASK) << 16) | (i + 1);   \
+    }                                                                              \
+    static inline int name##_index(const name* m, int handle) {                    \
+        int i = (handle & 0xffff) - 1;                                             \
+        if (0 > i || m->fresh <= i || !m->used[i]) return -1;                      \
+        return ((handle >> 16) & SLOT_MAP_GEN_MASK) == (m->gen[i] & SLOT_MAP_GEN_MASK) \
+                   ? i : -1;                                                       \
+    }                                                                              \
+    /* Slot of `handle`, or NULL once it was removed. */                           \
+    static inline T* name##_get(name* m, int handle) {                             \
+        int i = name##_index(m, handle);                                           \
+        return 0 <= i ? &m->items[i] : NULL;                                       \
+    }                                                                              \
+    static inline bool name##_remove(name* m, int handle) {                        \
+        int i = name##_index(m, handle);                                           \
+        if (0 > i) return false;                                                   \
+        m->used[i]      = false;                                                   \
+        m->gen[i]++;                                                               \
+        m->next_free[i] = m->free_head;                                            \
+        m->free_head    = i + 1;                                                   \
+        m->count--;                                                                \
+        return true;                                                               \
+    }
+
+#endif /* CYBERIA_UTIL_SLOT_MAP_H */
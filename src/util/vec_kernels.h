@@ -0,0 +1,40 @@
+#ifndef CYBERIA_UTIL_VEC_KERNELS_H
+#define CYBERIA_UTIL_VEC_KERNELS_H
+
+/* Float-array kernels over the packed hot sets (game_state.h EntityHotSet).
+ *
+ * Built with -msimd128 the bodies run four lanes per step through
+ * wasm_simd128.h; otherwise (or for the n % 4 tail) a scalar loop produces
+ * the same result. Arrays may be unaligned; outputs must not alias inputs
+ * other than element-for-element.
+ */
+
+#ifdef __wasm_simd128__
+#include <wasm_simd128.h>
+#endif
+
+/* out[i] = a[i] + b[i] */
+static inline void vk_add(float* out, const float* a, const float* b, int n) {
+    int i = 0;
+#ifdef __wasm_simd128__
+    for (; i + 4 <= n; i += 4) {
+        wasm_v128_store(out + i, wasm_f32x4_add(wasm_v128_load(a + i), wasm_v128_load(b + i)));
+    }
+#endif
+    for (; i < n; i++) { out[i] = a[i] + b[i]; }
+}
+
+/* out[i] = a[i] + (b[i] - a[i]) * t[i] */
+static inline void vk_lerp(float* out, const float* a, const float* b, const float* t, int n) {
+    int i = 0;
+#ifdef __wasm_simd128__
+    for (; i + 4 <= n; i += 4) {
+        v128_t va = wasm_v128_load(a + i);
+        v128_t d  = wasm_f32x4_sub(wasm_v128_load(b + i), va);
+        wasm_v128_store(out + i, wasm_f32x4_add(va, wasm_f32x4_mul(d, wasm_v128_load(t + i))));
+    }
+#endif
+    for (; i < n; i++) { out[i] = a[i] + (b[i] - a[i]) * t[i]; }
+}
+
+#endif /* CYBERIA_UTIL_VEC_KERNELS_H */
@@ -0,0 +1,168 @@
+#include "world_target.h"
+
+#include "domain/camera.h"
+#include "domain/presentation_runtime.h"
+#include "gpu_memory.h"
+
+#include <assert.h>
+#include <math.h>
+#include <rlgl.h>
+#include <stdbool.h>
+
+typedef struct {
+    int scale;    /* screen pixels per target texel */
+    int texels;   /* target texels per cell */
+} TargetFit;
+
+static struct {
+    bool            loaded;
+    RenderTexture2D rt;
+    int             filter;
+    float           resolution;
+    bool            open;
+    bool            on;
+    float           upscale;
+    Camera2D        view;   /* camera the open pass draws under */
+    Rectangle       dest;   /* screen rect of the whole target */
+} g_wt = { .resolution = 1.0f, .upscale = 1.0f };
+
+static bool target_fit(float zoom, float cell_size, TargetFit* out) {
+    float per_cell = presentation_runtime_world_texels_per_cell();
+    if (0.0f >= per_cell || 0.0f >= cell_size || 0.0f >= zoom) return false;
+    per_cell *= g_wt.resolution;
+    float px = cell_size * zoom;
+    int scale = (int)floorf(px / per_cell);
+    if (1 > scale) scale = 1;
+    if (WORLD_TARGET_MAX_SCALE < scale) scale = WORLD_TARGET_MAX_SCALE;
+    int texels = (int)lroundf(px / (float)scale);
+    *out = (TargetFit){ .scale = scale, .texels = 1 > texels ? 1 : texels };
+    return true;
+}
+
+static void target_unload(void) {
+    if (g_wt.loaded) {
+        gpu_memory_sub(GPU_MEM_WORLD_TARGET, gpu_memory_texture_bytes(g_wt.rt.texture));
+        UnloadRenderTexture(g_wt.rt);
+    }
+    g_wt.loaded = false;
+    g_wt.rt     = (RenderTexture2D){ 0 };
+}
+
+static void target_ensure(int w, int h, int filter) {
+    if (!g_wt.loaded || g_wt.rt.texture.width != w || g_wt.rt.texture.height != h) {
+        target_unload();
+        g_wt.rt = LoadRenderTexture(w, h);
+        gpu_memory_add(GPU_MEM_WORLD_TARGET, gpu_memory_texture_bytes(g_wt.rt.texture));
+        g_wt.loaded = true;
+        g_wt.filter = -1;
+    }
+    if (filter != g_wt.filter) {
+        SetTextureFilter(g_wt.rt.texture, filter);
+        g_wt.filter = filter;
+    }
+}
+
+float world_target_snap_zoom(float zoom, float cell_size) {
+    TargetFit fit;
+    if (!target_fit(zoom, cell_size, &fit)) return zoom;
+    return (float)(fit.scale * fit.texels) / cell_size;
+}
+
+void world_target_begin(Camera2D camera, int screen_width, int screen_height,
+                        float cell_size, Color clear) {
+    assert(!g_wt.open);
+    g_wt.open = true;
+    Camera2D inner;
+
+    /* Fit from the requested zoom: the snapped one can round into the next
+     * scale step. */
+    TargetFit fit;
+    if (target_fit(camera_zoom(), cell_size, &fit)) {
+        /* One spare texel each side absorbs the sub-texel blit shift. */
+        int s = fit.scale;
+        int w = screen_width / s + 2;
+        int h = screen_height / s + 2;
+        target_ensure(w, h, TEXTURE_FILTER_POINT);
+
+        float zoom = (float)fit.texels / cell_size;
+        float tx = camera.target.x * zoom;
+        float ty = camera.target.y * zoom;
+        inner = (Camera2D){
+            .offset   = { (float)(w / 2), (float)(h / 2) },
+            .target   = { floorf(tx) / zoom, floorf(ty) / zoom },
+            .rotation = 0.0f,
+            .zoom     = zoom,
+        };
+        g_wt.upscale = (float)s;
+        g_wt.dest = (Rectangle){
+            camera.offset.x - (float)s * ((float)(w / 2) + (tx - floorf(tx))),
+            camera.offset.y - (float)s * ((float)(h / 2) + (ty - floorf(ty))),
+            (float)(w * s),
+            (float)(h * s),
+        };
+    } else if (1.0f > g_wt.resolution) {
+        /* Fractional target: same view, fewer texels, filtered upscale. */
+        float f = g_wt.resolution;
+        int w = (int)ceilf((float)screen_width * f);
+        int h = (int)ceilf((float)screen_height * f);
+        target_ensure(w, h, TEXTURE_FILTER_BILINEAR);
+
+        inner = camera;
+        inner.offset = (Vector2){ camera.offset.x * f, camera.offset.y * f };
+        inner.zoom   = camera.zoom * f;
+        g_wt.upscale = 1.0f / f;
+        g_wt.dest    = (Rectangle){ 0.0f, 0.0f, (float)w / f, (float)h / f };
+    } else {
+        target_unload();
+        g_wt.on      = false;
+        g_wt.upscale = 1.0f;
+        g_wt.view    = camera;
+        BeginMode2D(camera);
+        return;
+    }
+
+    g_wt.on   = true;
+    g_wt.view = inner;
+    BeginTextureMode(g_wt.rt);
+    ClearBackground(clear);
+    BeginMode2D(inner);
+}
+
+void world_target_end(void) {
+    assert(g_wt.open);
+    g_wt.open = false;
+    EndMode2D();
+    if (!g_wt.on) return;
+    EndTextureMode();
+
+    /* A straight copy of the colour; the backbuffer keeps its own alpha.
+     * Render textures are stored bottom-up. */
+    Rectangle src = {
+        0.0f, 0.0f, (float)g_wt.rt.texture.width, -(float)g_wt.rt.texture.height,
+    };
+    rlSetBlendFactorsSeparate(RL_ONE, RL_ZERO, RL_ZERO, RL_ONE, RL_FUNC_ADD, RL_FUNC_ADD);
+    BeginBlendMode(BLEND_CUSTOM_SEPARATE);
+    DrawTexturePro(g_wt.rt.texture, src, g_wt.dest, (Vector2){ 0.0f, 0.0f }, 0.0f, WHITE);
+    EndBlendMode();
+}
+
+void world_target_set_resolution(float factor) {
+    assert(!g_wt.open);
+    g_wt.resolution = (0.0f < factor && 1.0f > factor) ? factor : 1.0f;
+}
+
+bool world_target_view(Camera2D* camera, RenderTexture2D* target) {
+    if (!g_wt.open) return false;
+    *camera = g_wt.view;
+    *target = g_wt.on ? g_wt.rt : (RenderTexture2D){ 0 };
+    return true;
+}
+
+float world_target_upscale(void) {
+    return g_wt.upscale;
+}
+
+void world_target_release(void) {
+    assert(!g_wt.open);
+    target_unload();
+}
@@ -0,0 +1,60 @@
+#ifndef CYBERIA_WORLD_TARGET_H
+#define CYBERIA_WORLD_TARGET_H
+
+#include <raylib.h>
+
+/* Integer-scaled render target for the world pass.
+ *
+ * Drawn straight to the backbuffer at a fractional zoom, every sprite
+ * resamples its texels on its own and edges shimmer as the camera moves.
+ * With the worldTexelsPerCell hint set, the world is drawn into a
+ * low-resolution target instead and upscaled once to the screen by a whole
+ * factor `scale`:
+ *
+ *   scale  = ⌊cell_size · zoom / worldTexelsPerCell⌋, 1..WORLD_TARGET_MAX_SCALE
+ *   texels = round(cell_size · zoom / scale) per cell in the target
+ *
+ * so a cell covers whole target texels and each texel whole screen pixels;
+ * fill cost drops by scale². The on-screen zoom this reproduces is
+ * world_target_snap_zoom(), which camera_get() returns, so input and
+ * culling see the view actually drawn. The target camera is snapped to the
+ * texel grid and the remainder shifts the upscaled blit, so scrolling stays
+ * smooth while the world's texel grid holds still.
+ *
+ * world_target_set_resolution() scales the target down further (dynamic
+ * resolution): with the hint it divides the texels per cell, so the whole
+ * upscale grows; without it the world draws into a fractional-size target
+ * with a filtered upscale, and directly again once back at 1. UI always
+ * draws at native resolution after the pass.
+ *
+ * Without the hint, at resolution 1, the pass draws directly, as before. */
+
+#define WORLD_TARGET_MAX_SCALE 6
+
+/* Zoom drawn for the requested `zoom`; `zoom` itself when off. */
+float world_target_snap_zoom(float zoom, float cell_size);
+
+/* Open the world pass under `camera` (from camera_get()): into the target,
+ * cleared to `clear`, when on, else straight BeginMode2D. */
+void  world_target_begin(Camera2D camera, int screen_width, int screen_height,
+                         float cell_size, Color clear);
+
+/* Close the pass; when on, upscale the target onto the screen. */
+void  world_target_end(void);
+
+/* Fraction of the texels the pass would otherwise use, in (0, 1]. */
+void  world_target_set_resolution(float factor);
+
+/* Camera of the open pass and the texture it draws into (id 0 when it
+ * draws straight to the screen), for passes that detour through a target
+ * of their own and come back. False outside a pass. */
+bool  world_target_view(Camera2D* camera, RenderTexture2D* target);
+
+/* Screen pixels per target texel of the open or last pass; 1 when drawn
+ * directly. */
+float world_target_upscale(void);
+
+/* Unload the target. */
+void  world_target_release(void);
+
+#endif /* CYBERIA_WORLD_TARGET_H */
@@ -21,12 +21,42 @@
 #define MAX_ID_LENGTH       64
 #define MAX_BEHAVIOR_LENGTH 32
 
+/* Interned id handle (id_intern.h); equal handles ⇔ equal id strings within
+ * a session. */
+typedef uint32_t IdHandle;
+#define ID_HANDLE_NONE 0u
+
+/* Stable reference to a remote player or bot record (game_state.h). Stays
+ * valid while the record lives, however the arrays compact around it, and
+ * is never reused for another record. */
+typedef int EntityHandle;
+#define ENTITY_HANDLE_NONE 0
+
+/* Server positions of one entity keyed by the AOI snapshot tick that carried
+ * them, oldest first from `head`. Written by the decoders through
+ * interpolation_record_snapshot(); sampled at the render tick by
+ * interpolation_compute_view(). */
+#define SNAPSHOT_HISTORY_CAP 8
+
+typedef struct {
+    uint32_t tick;
+    Vector2  pos;
+} PosSample;
+
+typedef struct {
+    PosSample samples[SNAPSHOT_HISTORY_CAP];
+    uint8_t   head;
+    uint8_t   count;
+} SnapshotHistory;
+
 typedef struct EntityState EntityState;
 typedef struct PlayerState PlayerState;
 typedef struct BotState BotState;
 
 struct EntityState {
     char id[MAX_ID_LENGTH];
+    IdHandle handle;        /* interned `id` */
+    EntityHandle ref;       /* remote players and bots only; owned by game_state.c */
     Vector2 pos_server;
     Vector2 pos_prev;
     Vector2 interp_pos;
@@ -35,13 +65,21 @@ struct EntityState {
     ObjectLayerMode mode;
     ObjectLayerState object_layers[MAX_OBJECT_LAYERS];
     int object_layer_count;
+    uint32_t layers_version; /* layer_stack id of object_layers: changes with it,
+                              * shared by records wearing the same stack */
     float life;
     float max_life;
     float respawn_in;
     double last_update;     /* wall-clock time the entity was last touched */
     double snapshot_time;   /* wall-clock time of the snapshot that produced
-                             * pos_server. Used by interpolation to compute
-                             * a per-entity alpha instead of a global one. */
+                             * pos_server. Fallback alpha for entities with
+                             * no tick history (JSON path). */
+    SnapshotHistory history; /* tick-stamped server positions */
+    Vector2 interp_error;   /* shown minus sampled position, decaying to zero
+                             * after a late snapshot corrects an extrapolation */
+    double interp_basis;    /* newest history tick (or snapshot_time) last sampled */
+    bool interp_extrapolating;
+    uint32_t seen_generation; /* last full frame that listed it (game_state_begin_entity_sweep) */
     int stats_sum;          /* sum of active stats, capped at sum_stats_limit */
     uint8_t status_icon;
 };
@@ -49,9 +87,8 @@ struct EntityState {
 struct PlayerState {
     EntityState base;
     char map_code[MAX_ID_LENGTH];
-    Vector2 path[MAX_PATH_POINTS]; /* debug only */
-    int path_count;                /* debug only */
-    Vector2 target_pos;            /* debug only */
+    /* The server's planned path and target cell are debug-overlay data for
+     * the local player only: see local_player_debug_path(). */
 
     Vector2 tap_target;
     bool    has_tap_target;
@@ -88,6 +125,7 @@ struct BotState {
     EntityState base;
     char behavior[MAX_BEHAVIOR_LENGTH];
     char caster_id[MAX_ID_LENGTH];
+    IdHandle caster_handle; /* interned `caster_id`; NONE when uncast */
     /* Bound cyberia-action code; "" for ordinary bots. The client fetches the
      * action metadata (label, dialogue map) by this code via REST.
      * Position-independent, so a wandering NPC keeps it. */
@@ -106,6 +144,7 @@ struct BotState {
 
 typedef struct WorldObject {
     char             id[MAX_ID_LENGTH];
+    IdHandle         handle;   /* interned `id` */
     Vector2          pos;
     Vector2          dims;
     ObjectLayerType  type_kind;
@@ -116,8 +155,12 @@ typedef struct WorldObject {
     char             target_map_code[MAX_ID_LENGTH];
     int              target_cell_x;
     int              target_cell_y;
-    ObjectLayerState object_layers[MAX_OBJECT_LAYERS];
+    /* object_layer_count entries carved from the frame's shared layer pool
+     * (game_state_alloc_layers); world objects are rebuilt every full frame,
+     * so the stack lives exactly as long as the record. */
+    ObjectLayerState* object_layers;
     int              object_layer_count;
+    uint32_t         layers_version;   /* layer_stack id of object_layers */
 } WorldObject;
 
 #endif /* WORLD_TYPES_H */